@@ -106,6 +106,9 @@ void QuickTimeAudioDecoder::init() {
 
 	// Initialize all the audio streams
 	// But ignore any streams we don't support
+	if (_headerOnly)
+		return;
+
 	for (uint32 i = 0; i < _tracks.size(); i++)
 		if (_tracks[i]->codecType == CODEC_TYPE_AUDIO && ((AudioSampleDesc *)_tracks[i]->sampleDescs[0])->isAudioCodecSupported())
 			_audioTracks.push_back(new QuickTimeAudioTrack(this, _tracks[i]));
@@ -168,6 +171,9 @@ QuickTimeAudioDecoder::QuickTimeAudioTrack::QuickTimeAudioTrack(QuickTimeAudioDe
 	_queue = createStream();
 	_samplesQueued = 0;
 
+	// The edit parser below needs the chunk layout
+	_decoder->loadSampleTables(_parentTrack);
+
 	AudioSampleDesc *entry = (AudioSampleDesc *)_parentTrack->sampleDescs[0];
 
 	if (entry->getCodecTag() == MKTAG('r', 'a', 'w', ' ') || entry->getCodecTag() == MKTAG('t', 'w', 'o', 's'))
@@ -257,6 +257,18 @@ public:
 	 */
 	virtual bool isReady(int8 source = -1) { return true; }
 
+	/**
+	 * Tells the driver that the events which are sent from now on are due
+	 * the specified time after the start of the current timer callback.
+	 * A MIDI parser sets this while it sends the events of a callback, and
+	 * resets it to 0 afterwards. Drivers which render the music themselves
+	 * can use it to play the events at the right sample instead of at the
+	 * start of the callback interval; other drivers can ignore it.
+	 *
+	 * @param delay The delay in microseconds.
+	 */
+	virtual void setEventDelay(uint32 delay) { }
+
 protected:
 
 	/**
@@ -50,9 +50,11 @@ _activeTrack(255),
 _abortParse(false),
 _jumpingToTick(false),
 _doParse(true),
-_pause(false) {
+_pause(false),
+_nextToken(0) {
 	memset(_activeNotes, 0, sizeof(_activeNotes));
 	memset(_tracks, 0, sizeof(_tracks));
+	memset(_trackTokens, 0, sizeof(_trackTokens));
 	_nextEvent.start = nullptr;
 	_nextEvent.delta = 0;
 	_nextEvent.event = 0;
@@ -122,6 +124,70 @@ uint32 MidiParser::readVLQ(byte * &data) {
 	return value;
 }
 
+void MidiParser::tokenizeTracks(byte *const *trackEnds) {
+	// Enough for the delta, the command and the parameters of any event.
+	// Closer to the end of the track, decoding might read past it.
+	const int kMaxShortEventSize = 8;
+
+	_eventTokens.clear();
+	for (int i = 0; i < _numTracks; ++i) {
+		_trackTokens[i] = _eventTokens.size();
+
+		_position.clear();
+		_position._playPos = _tracks[i];
+		while (trackEnds[i] - _position._playPos >= kMaxShortEventSize) {
+			EventToken token;
+			token.runningStatusBefore = _position._runningStatus;
+			decodeNextEvent(token.info);
+			if (_position._playPos > trackEnds[i] || _position._playPos <= token.info.start)
+				break;
+
+			token.next = _position._playPos;
+			token.runningStatusAfter = _position._runningStatus;
+			_eventTokens.push_back(token);
+
+			if (token.info.event == 0xFF && token.info.ext.type == 0x2F)
+				break;
+		}
+	}
+	_trackTokens[_numTracks] = _eventTokens.size();
+	_nextToken = 0;
+	_position.clear();
+}
+
+bool MidiParser::readEventToken(EventInfo &info) {
+	if (_activeTrack >= _numTracks)
+		return false;
+
+	uint32 first = _trackTokens[_activeTrack];
+	uint32 last = _trackTokens[_activeTrack + 1];
+	uint32 index = _nextToken;
+	if (index < first || index >= last || _eventTokens[index].info.start != _position._playPos) {
+		// The position has been changed by a jump or a loop, so look up
+		// the event in the track.
+		while (first < last) {
+			uint32 middle = first + (last - first) / 2;
+			if (_eventTokens[middle].info.start < _position._playPos)
+				first = middle + 1;
+			else
+				last = middle;
+		}
+		index = first;
+		if (index >= _trackTokens[_activeTrack + 1] || _eventTokens[index].info.start != _position._playPos)
+			return false;
+	}
+
+	const EventToken &token = _eventTokens[index];
+	if (token.runningStatusBefore != _position._runningStatus)
+		return false;
+
+	info = token.info;
+	_position._playPos = token.next;
+	_position._runningStatus = token.runningStatusAfter;
+	_nextToken = index + 1;
+	return true;
+}
+
 void MidiParser::activeNote(byte channel, byte note, bool active) {
 	if (note >= 128 || channel >= 16)
 		return;
@@ -232,9 +298,12 @@ void MidiParser::onTimer() {
 			if (info.event < 0x80) {
 				warning("Bad command or running status %02X", info.event);
 				_position._playPos = nullptr;
+				_driver->setEventDelay(0);
 				return;
 			}
 
+			_driver->setEventDelay(eventTime > _position._playTime ? eventTime - _position._playTime : 0);
+
 			if (info.command() == 0x8) {
 				activeNote(info.channel(), info.basic.param1, false);
 			} else if (info.command() == 0x9) {
@@ -246,9 +315,12 @@ void MidiParser::onTimer() {
 
 			// Player::metaEvent() in SCUMM will delete the parser object,
 			// so return immediately if that might have happened.
+			MidiDriver_BASE *driver = _driver;
 			bool ret = processEvent(info);
-			if (!ret)
+			if (!ret) {
+				driver->setEventDelay(0);
 				return;
+			}
 		}
 
 		loopEvent |= info.loop;
@@ -260,6 +332,8 @@ void MidiParser::onTimer() {
 		}
 	}
 
+	_driver->setEventDelay(0);
+
 	if (!_abortParse) {
 		_position._playTime = endTime;
 		_position._playTick = (_position._playTime - _position._lastEventTime) / _psecPerTick + _position._lastEventTick;
@@ -536,6 +610,9 @@ void MidiParser::unloadMusic() {
 
 	stopPlaying();
 	_numTracks = 0;
+	_eventTokens.clear();
+	memset(_trackTokens, 0, sizeof(_trackTokens));
+	_nextToken = 0;
 	_activeTrack = 255;
 	_abortParse = true;
 
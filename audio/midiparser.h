@@ -25,6 +25,7 @@
 #define AUDIO_MIDIPARSER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/endian.h"
 #include "common/stream.h"
 
@@ -290,6 +291,16 @@ class MidiParser {
 protected:
 	static const uint8 MAXIMUM_TRACKS = 120;
 
+	/**
+	 * An event of a loaded track, decoded in advance by tokenizeTracks().
+	 */
+	struct EventToken {
+		EventInfo info;           ///< The decoded event.
+		byte *next;               ///< Position of the event that follows it in the track.
+		byte runningStatusBefore; ///< Running status the event was decoded with.
+		byte runningStatusAfter;  ///< Running status after the event.
+	};
+
 	uint16    _activeNotes[128];   ///< Each uint16 is a bit mask for channels that have that note on.
 	NoteTimer _hangingNotes[32];   ///< Maintains expiration info for up to 32 notes.
 	                                ///< Used for "Smart Jump" and MIDI formats that do not include explicit Note Off events.
@@ -329,11 +340,45 @@ protected:
 	 */
 	int8   _source;
 
+	Common::Array<EventToken> _eventTokens; ///< The pre-decoded events of all tracks, in track order.
+	uint32 _trackTokens[MAXIMUM_TRACKS + 1]; ///< Index of the first token of each track in _eventTokens.
+	uint32 _nextToken;     ///< Index of the token which is expected to be read next.
+
 protected:
 	static uint32 readVLQ(byte * &data);
 	virtual void resetTracking();
 	virtual void allNotesOff();
 	virtual void parseNextEvent(EventInfo &info) = 0;
+
+	/**
+	 * Decodes the event at the current position into @p info and
+	 * advances the position, like parseNextEvent(). This must not have
+	 * any other side effects, as it is used by tokenizeTracks() to decode
+	 * events in advance. The default implementation does nothing; formats
+	 * which call tokenizeTracks() have to implement it.
+	 */
+	virtual void decodeNextEvent(EventInfo &info) { }
+
+	/**
+	 * Decodes all events of the loaded tracks once, so that parseNextEvent()
+	 * can look them up with readEventToken() instead of decoding them from
+	 * the MIDI data again on every playback, loop and jump. Events in the
+	 * last few bytes of a track and after its End Of Track event are not
+	 * tokenized and have to be decoded as before.
+	 *
+	 * @param trackEnds The end of the data of each of the _numTracks tracks.
+	 */
+	void tokenizeTracks(byte *const *trackEnds);
+
+	/**
+	 * Looks up the event at the current position of the active track
+	 * among the tokenized events. If there is one, it is copied into
+	 * @p info and the position is advanced past it, exactly like
+	 * decodeNextEvent() would have done.
+	 *
+	 * @return True if the event was found, false if it has to be decoded.
+	 */
+	bool readEventToken(EventInfo &info);
 	virtual bool processEvent(const EventInfo &info, bool fireEvents = true);
 
 	void activeNote(byte channel, byte note, bool active);
@@ -39,6 +39,11 @@ MidiParser_SMF::~MidiParser_SMF() {
 }
 
 void MidiParser_SMF::parseNextEvent(EventInfo &info) {
+	if (!readEventToken(info))
+		decodeNextEvent(info);
+}
+
+void MidiParser_SMF::decodeNextEvent(EventInfo &info) {
 	info.start = _position._playPos;
 	info.delta = readVLQ(_position._playPos);
 
@@ -110,7 +115,7 @@ void MidiParser_SMF::parseNextEvent(EventInfo &info) {
 			break;
 
 		default:
-			warning("MidiParser_SMF::parseNextEvent: Unsupported event code %x", info.event);
+			warning("MidiParser_SMF::decodeNextEvent: Unsupported event code %x", info.event);
 			break;
 		}
 		break;
@@ -163,6 +168,7 @@ bool MidiParser_SMF::loadMusic(byte *data, uint32 size) {
 		return false;
 	}
 
+	byte *trackEnds[MAXIMUM_TRACKS];
 	int tracksRead = 0;
 	while (tracksRead < _numTracks) {
 		if (memcmp(pos, "MTrk", 4)) {
@@ -176,6 +182,7 @@ bool MidiParser_SMF::loadMusic(byte *data, uint32 size) {
 		pos += 4;
 		len = read4high(pos);
 		pos += len;
+		trackEnds[tracksRead] = pos;
 		++tracksRead;
 	}
 
@@ -189,11 +196,14 @@ bool MidiParser_SMF::loadMusic(byte *data, uint32 size) {
 		// Inherit the Earth MIDIs. Jamieson630 said something about a
 		// better fix, but this will have to do in the meantime.
 		_buffer = (byte *)malloc(size * 2);
-		compressToType0(_tracks, _numTracks, _buffer, false);
+		uint32 compressedSize = compressToType0(_tracks, _numTracks, _buffer, false);
 		_numTracks = 1;
 		_tracks[0] = _buffer;
+		trackEnds[0] = _buffer + compressedSize;
 	}
 
+	tokenizeTracks(trackEnds);
+
 	// Note that we assume the original data passed in
 	// will persist beyond this call, i.e. we do NOT
 	// copy the data to our own buffer. Take warning....
@@ -46,6 +46,7 @@ protected:
 	 */
 	uint32 compressToType0(byte *tracks[], byte numTracks, byte *buffer, bool malformedPitchBends = false);
 	void parseNextEvent(EventInfo &info) override;
+	void decodeNextEvent(EventInfo &info) override;
 
 public:
 	MidiParser_SMF(int8 source = -1);
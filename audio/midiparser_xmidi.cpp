@@ -73,6 +73,7 @@ protected:
 	uint32 read4low(byte *&data);
 
 	void parseNextEvent(EventInfo &info) override;
+	void decodeNextEvent(EventInfo &info) override;
 
 	void resetTracking() override {
 		MidiParser::resetTracking();
@@ -153,6 +154,86 @@ bool MidiParser_XMIDI::jumpToIndex(uint8 index, bool stopNotes) {
 }
 
 void MidiParser_XMIDI::parseNextEvent(EventInfo &info) {
+	if (!readEventToken(info))
+		decodeNextEvent(info);
+	if (info.command() != 0xB)
+		return;
+
+	// This isn't a full XMIDI implementation, but it should
+	// hopefully be "good enough" for most things.
+
+	switch (info.basic.param1) {
+	// Simplified XMIDI looping.
+	case 0x74: {	// XMIDI_CONTROLLER_FOR_LOOP
+			byte *pos = _position._playPos;
+			if (_loopCount < ARRAYSIZE(_loop) - 1)
+				_loopCount++;
+			else
+				warning("XMIDI: Exceeding maximum loop count %d", ARRAYSIZE(_loop));
+
+			_loop[_loopCount].pos = pos;
+			_loop[_loopCount].repeat = info.basic.param2;
+			break;
+		}
+
+	case 0x75:	// XMIDI_CONTROLLER_NEXT_BREAK
+		if (_loopCount >= 0) {
+			if (info.basic.param2 < 64) {
+				// End the current loop.
+				_loopCount--;
+			} else {
+				// Repeat 0 means "loop forever".
+				if (_loop[_loopCount].repeat) {
+					if (--_loop[_loopCount].repeat == 0) {
+						_loopCount--;
+					} else {
+						_position._playPos = _loop[_loopCount].pos;
+						info.loop = true;
+					}
+				} else {
+					_position._playPos = _loop[_loopCount].pos;
+					info.loop = true;
+				}
+			}
+		}
+		break;
+
+	case 0x77:	// XMIDI_CONTROLLER_CALLBACK_TRIG
+		if (_callbackProc)
+			_callbackProc(info.basic.param2, _callbackData);
+		break;
+
+	case 0x78:	// XMIDI_CONTROLLER_SEQ_BRANCH_INDEX
+		// This controller marks a branch point. It is converted
+		// to an entry in the RBRN header by the XMIDI conversion
+		// tool. For playback it is unnecessary.
+		break;
+
+	case 0x6e:	// XMIDI_CONTROLLER_CHAN_LOCK
+	case 0x6f:	// XMIDI_CONTROLLER_CHAN_LOCK_PROT
+	case 0x70:	// XMIDI_CONTROLLER_VOICE_PROT
+	case 0x71:	// XMIDI_CONTROLLER_TIMBRE_PROT
+	case 0x72:	// XMIDI_CONTROLLER_BANK_CHANGE
+		// These controllers are handled in the Miles drivers
+		break;
+
+	case 0x73:	// XMIDI_CONTROLLER_IND_CTRL_PREFIX
+	case 0x76:	// XMIDI_CONTROLLER_CLEAR_BB_COUNT
+	default:
+		if (info.basic.param1 >= 0x73 && info.basic.param1 <= 0x76) {
+			warning("Unsupported XMIDI controller %d (0x%2x)",
+				info.basic.param1, info.basic.param1);
+		}
+		break;
+	}
+
+	// Should we really keep passing the XMIDI controller events to
+	// the MIDI driver, or should we turn them into some kind of
+	// NOP events? (Dummy meta events, perhaps?) Ah well, it has
+	// worked so far, so it shouldn't cause any damage...
+}
+
+void MidiParser_XMIDI::decodeNextEvent(EventInfo &info) {
 	info.start = _position._playPos;
 	info.delta = readVLQ2(_position._playPos);
 	info.loop = false;
@@ -194,80 +275,7 @@ void MidiParser_XMIDI::parseNextEvent(EventInfo &info) {
 	case 0xB:
 		info.basic.param1 = *(_position._playPos++);
 		info.basic.param2 = *(_position._playPos++);
-
-		// This isn't a full XMIDI implementation, but it should
-		// hopefully be "good enough" for most things.
-
-		switch (info.basic.param1) {
-		// Simplified XMIDI looping.
-		case 0x74: {	// XMIDI_CONTROLLER_FOR_LOOP
-				byte *pos = _position._playPos;
-				if (_loopCount < ARRAYSIZE(_loop) - 1)
-					_loopCount++;
-				else
-					warning("XMIDI: Exceeding maximum loop count %d", ARRAYSIZE(_loop));
-
-				_loop[_loopCount].pos = pos;
-				_loop[_loopCount].repeat = info.basic.param2;
-				break;
-			}
-
-		case 0x75:	// XMIDI_CONTROLLER_NEXT_BREAK
-			if (_loopCount >= 0) {
-				if (info.basic.param2 < 64) {
-					// End the current loop.
-					_loopCount--;
-				} else {
-					// Repeat 0 means "loop forever".
-					if (_loop[_loopCount].repeat) {
-						if (--_loop[_loopCount].repeat == 0) {
-							_loopCount--;
-						} else {
-							_position._playPos = _loop[_loopCount].pos;
-							info.loop = true;
-						}
-					} else {
-						_position._playPos = _loop[_loopCount].pos;
-						info.loop = true;
-					}
-				}
-			}
-			break;
-
-		case 0x77:	// XMIDI_CONTROLLER_CALLBACK_TRIG
-			if (_callbackProc)
-				_callbackProc(info.basic.param2, _callbackData);
-			break;
-
-		case 0x78:	// XMIDI_CONTROLLER_SEQ_BRANCH_INDEX
-			// This controller marks a branch point. It is converted
-			// to an entry in the RBRN header by the XMIDI conversion
-			// tool. For playback it is unnecessary.
-			break;
-
-		case 0x6e:	// XMIDI_CONTROLLER_CHAN_LOCK
-		case 0x6f:	// XMIDI_CONTROLLER_CHAN_LOCK_PROT
-		case 0x70:	// XMIDI_CONTROLLER_VOICE_PROT
-		case 0x71:	// XMIDI_CONTROLLER_TIMBRE_PROT
-		case 0x72:	// XMIDI_CONTROLLER_BANK_CHANGE
-			// These controllers are handled in the Miles drivers
-			break;
-
-		case 0x73:	// XMIDI_CONTROLLER_IND_CTRL_PREFIX
-		case 0x76:	// XMIDI_CONTROLLER_CLEAR_BB_COUNT
-		default:
-			if (info.basic.param1 >= 0x73 && info.basic.param1 <= 0x76) {
-				warning("Unsupported XMIDI controller %d (0x%2x)",
-					info.basic.param1, info.basic.param1);
-			}
-			break;
-		}
-
-		// Should we really keep passing the XMIDI controller events to
-		// the MIDI driver, or should we turn them into some kind of
-		// NOP events? (Dummy meta events, perhaps?) Ah well, it has
-		// worked so far, so it shouldn't cause any damage...
-
+		// The XMIDI controllers are handled by parseNextEvent()
 		break;
 
 	case 0xF: // Meta or SysEx event
@@ -311,7 +319,7 @@ void MidiParser_XMIDI::parseNextEvent(EventInfo &info) {
 			break;
 
 		default:
-			warning("MidiParser_XMIDI::parseNextEvent: Unsupported event code %x", info.event);
+			warning("MidiParser_XMIDI::decodeNextEvent: Unsupported event code %x", info.event);
 			break;
 		}
 		break;
@@ -427,6 +435,7 @@ bool MidiParser_XMIDI::loadMusic(byte *data, uint32 size) {
 			return false;
 		}
 
+		byte *trackEnds[MAXIMUM_TRACKS];
 		int tracksRead = 0;
 		uint32 branchOffsets[128];
 		memset(branchOffsets, 0, sizeof(branchOffsets));
@@ -458,6 +467,7 @@ bool MidiParser_XMIDI::loadMusic(byte *data, uint32 size) {
 				pos += 4;
 				len = read4high(pos);
 				pos += (len + 1) & ~1;
+				trackEnds[tracksRead] = _tracks[tracksRead] + len;
 				// Calculate branch index positions using the track position we just found
 				for (int j = 0; j < MAXIMUM_TRACK_BRANCHES; ++j) {
 					if (branchOffsets[j] != 0) {
@@ -504,6 +514,7 @@ bool MidiParser_XMIDI::loadMusic(byte *data, uint32 size) {
 		// will persist beyond this call, i.e. we do NOT
 		// copy the data to our own buffer. Take warning....
 		_ppqn = 60;
+		tokenizeTracks(trackEnds);
 		resetTracking();
 		setTempo(500000);
 
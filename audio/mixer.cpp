@@ -21,10 +21,15 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/config-manager.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
+#include "common/jobsystem.h"
+#include "common/profiler.h"
+
 #include "audio/mixer_intern.h"
+#include "audio/prefetchingstream.h"
 #include "audio/rate.h"
 #include "audio/audiostream.h"
 #include "audio/timestamp.h"
@@ -167,6 +172,29 @@ public:
 	 */
 	SoundHandle getHandle() const { return _handle; }
 
+	/**
+	 * Adds a mix call to the channel's profiling counters.
+	 *
+	 * @param micros  time spent in mix()
+	 * @param starved whether the stream ran out of data before its end
+	 */
+	void addMixStats(uint64 micros, bool starved) {
+		_mixCalls++;
+		_mixMicros += micros;
+		if (starved)
+			_starved++;
+	}
+
+	/**
+	 * Fills in the channel's profiling counters.
+	 */
+	void getStats(Mixer::ChannelStats &stats) const;
+
+	/**
+	 * Resets the channel's profiling counters.
+	 */
+	void resetStats() { _mixCalls = 0; _mixMicros = 0; _starved = 0; }
+
 private:
 	const Mixer::SoundType _type;
 	SoundHandle _handle;
@@ -190,6 +218,10 @@ private:
 
 	RateConverter *_converter;
 	Common::DisposablePtr<AudioStream> _stream;
+
+	uint32 _mixCalls;
+	uint64 _mixMicros;
+	uint32 _starved;
 };
 
 #pragma mark -
@@ -197,7 +229,8 @@ private:
 #pragma mark -
 
 MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
-	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _profiling(false), _stats() {
 
 	assert(sampleRate > 0);
 
@@ -291,6 +324,14 @@ void MixerImpl::playStream(
 	reverseStereo = !reverseStereo;
 #endif
 
+	// Decode music ahead on a worker thread, so that slow decoding doesn't
+	// hold up the mixer callback
+	const int prefetchMs = ConfMan.getInt("audio_prefetch_ms");
+	if (type == kMusicSoundType && prefetchMs > 0 && g_system->getJobSystem()->getWorkerCount() > 0) {
+		stream = new PrefetchingAudioStream(stream, prefetchMs, autofreeStream);
+		autofreeStream = DisposeAfterUse::YES;
+	}
+
 	// Create the channel
 	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
 	chan->setVolume(volume);
@@ -301,6 +342,8 @@ void MixerImpl::playStream(
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
+	Common::ProfilerZone profilerZone("Audio", Common::Profiler::kThreadAudio);
+
 	Common::StackLock lock(_mutex);
 
 	int16 *buf = (int16 *)samples;
@@ -308,6 +351,8 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	// Since the mixer callback has been called, the mixer must be ready...
 	_mixerReady = true;
 
+	applyCommands();
+
 	//  zero the buf
 	memset(buf, 0, len);
 
@@ -320,6 +365,8 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 		len >>= 1;
 	}
 
+	const uint64 callbackStart = _profiling ? g_system->getMicros() : 0;
+
 	// mix all channels
 	int res = 0, tmp;
 	for (int i = 0; i != NUM_CHANNELS; i++)
@@ -328,16 +375,78 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 				delete _channels[i];
 				_channels[i] = nullptr;
 			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
+				if (_profiling) {
+					const uint64 mixStart = g_system->getMicros();
+					tmp = _channels[i]->mix(buf, len);
+					const uint64 mixTime = g_system->getMicros() - mixStart;
+
+					_channels[i]->addMixStats(mixTime, (uint)tmp < len && !_channels[i]->isFinished());
+					_stats.typeMicros[_channels[i]->getType()] += mixTime;
+				} else {
+					tmp = _channels[i]->mix(buf, len);
+				}
 
 				if (tmp > res)
 					res = tmp;
 			}
 		}
 
+	if (_profiling)
+		addCallbackStats(g_system->getMicros() - callbackStart, len);
+
 	return res;
 }
 
+void MixerImpl::addCallbackStats(uint64 micros, uint len) {
+	_stats.callbacks++;
+	_stats.callbackMicros += micros;
+	_stats.maxCallbackMicros = MAX<uint32>(_stats.maxCallbackMicros, (uint32)MIN<uint64>(micros, 0xFFFFFFFF));
+
+	// Compare against the time it takes to play the mixed samples
+	const uint64 budget = (uint64)len * 1000000 / _sampleRate;
+	static const uint percentages[Stats::kHistogramBuckets - 1] = { 10, 25, 50, 75, 100 };
+	int bucket = 0;
+	while (bucket < Stats::kHistogramBuckets - 1 && micros * 100 >= budget * percentages[bucket])
+		bucket++;
+	_stats.histogram[bucket]++;
+
+	if (bucket == Stats::kHistogramBuckets - 1)
+		_stats.underruns++;
+}
+
+void MixerImpl::setProfiling(bool enable) {
+	Common::StackLock lock(_mutex);
+	_profiling = enable;
+}
+
+bool MixerImpl::isProfiling() const {
+	return _profiling;
+}
+
+void MixerImpl::getStats(Stats &stats) {
+	Common::StackLock lock(_mutex);
+
+	stats = _stats;
+	stats.channels.clear();
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		if (_channels[i]) {
+			ChannelStats channelStats;
+			_channels[i]->getStats(channelStats);
+			stats.channels.push_back(channelStats);
+		}
+	}
+}
+
+void MixerImpl::resetStats() {
+	Common::StackLock lock(_mutex);
+
+	_stats = Stats();
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		if (_channels[i])
+			_channels[i]->resetStats();
+	}
+}
+
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
@@ -385,14 +494,69 @@ bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 	return _soundTypeSettings[type].mute;
 }
 
-void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
+void MixerImpl::postCommand(ChannelCommand::Type type, SoundHandle handle, int value) {
+	ChannelCommand command;
+	command.type = type;
+	command.handle = handle._val;
+	command.value = value;
+
+	{
+		Common::StackLock lock(_commandMutex);
+
+		// The requested settings follow the order of the queue
+		if (_commands.push(command)) {
+			updateRequested(command);
+			return;
+		}
+	}
+
+	// The mixer isn't keeping up (or isn't running), so apply everything
+	// the slow way, in order. _mutex goes first, as engines may post
+	// commands while holding it.
 	Common::StackLock lock(_mutex);
+	Common::StackLock commandLock(_commandMutex);
+	applyCommands();
+	updateRequested(command);
+	applyCommand(command);
+}
+
+void MixerImpl::updateRequested(const ChannelCommand &command) {
+	const int index = command.handle % NUM_CHANNELS;
+	RequestedSettings &requested = _requested[index];
+	if (requested.handle != command.handle) {
+		requested = RequestedSettings();
+		requested.handle = command.handle;
+	}
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	if (command.type == ChannelCommand::kSetVolume) {
+		requested.hasVolume = true;
+		requested.volume = (byte)command.value;
+	} else {
+		requested.hasBalance = true;
+		requested.balance = (int8)command.value;
+	}
+}
+
+void MixerImpl::applyCommand(const ChannelCommand &command) {
+	// Ignore updates for sounds that terminated in the meantime
+	const int index = command.handle % NUM_CHANNELS;
+	if (!_channels[index] || _channels[index]->getHandle()._val != command.handle)
 		return;
 
-	_channels[index]->setVolume(volume);
+	if (command.type == ChannelCommand::kSetVolume)
+		_channels[index]->setVolume((byte)command.value);
+	else
+		_channels[index]->setBalance((int8)command.value);
+}
+
+void MixerImpl::applyCommands() {
+	ChannelCommand command;
+	while (_commands.pop(command))
+		applyCommand(command);
+}
+
+void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
+	postCommand(ChannelCommand::kSetVolume, handle, volume);
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
@@ -400,17 +564,19 @@ byte MixerImpl::getChannelVolume(SoundHandle handle) {
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return 0;
 
+	{
+		Common::StackLock lock(_commandMutex);
+
+		const RequestedSettings &requested = _requested[index];
+		if (requested.handle == handle._val && requested.hasVolume)
+			return requested.volume;
+	}
+
 	return _channels[index]->getVolume();
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setBalance(balance);
+	postCommand(ChannelCommand::kSetBalance, handle, balance);
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
@@ -418,6 +584,14 @@ int8 MixerImpl::getChannelBalance(SoundHandle handle) {
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return 0;
 
+	{
+		Common::StackLock lock(_commandMutex);
+
+		const RequestedSettings &requested = _requested[index];
+		if (requested.handle == handle._val && requested.hasBalance)
+			return requested.balance;
+	}
+
 	return _channels[index]->getBalance();
 }
 
@@ -577,12 +751,13 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
 	: _type(type), _mixer(mixer), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
 	  _balance(0), _pauseLevel(0), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
 	  _pauseStartTime(0), _pauseTime(0), _converter(nullptr), _volL(0), _volR(0),
-	  _stream(stream, autofreeStream) {
+	  _stream(stream, autofreeStream), _mixCalls(0), _mixMicros(0), _starved(0) {
 	assert(mixer);
 	assert(stream);
 
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo);
+	const RateConverterType converterType = (ConfMan.get("audio_resampler") == "sinc") ? kRateConverterSinc : kRateConverterDefault;
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo, converterType);
 }
 
 Channel::~Channel() {
@@ -707,6 +882,17 @@ void Channel::loop() {
 	}
 }
 
+void Channel::getStats(Mixer::ChannelStats &stats) const {
+	stats.handle = _handle;
+	stats.type = _type;
+	stats.id = _id;
+	stats.rate = _converter->getInputRate();
+	stats.stereo = _stream->isStereo();
+	stats.mixCalls = _mixCalls;
+	stats.mixMicros = _mixMicros;
+	stats.starved = _starved;
+}
+
 int Channel::mix(int16 *data, uint len) {
 	assert(_stream);
 	assert(_converter);
@@ -22,6 +22,7 @@
 #ifndef AUDIO_MIXER_H
 #define AUDIO_MIXER_H
 
+#include "common/array.h"
 #include "common/mutex.h"
 #include "common/types.h"
 #include "common/noncopyable.h"
@@ -341,6 +342,58 @@ public:
 	 * @return The number of samples processed at each audio callback.
 	 */
 	virtual uint getOutputBufSize() const = 0;
+
+	/** Profiling counters of a single channel. */
+	struct ChannelStats {
+		SoundHandle handle;
+		SoundType type;
+		int id;
+		uint rate;          ///< Sample rate of the stream
+		bool stereo;
+		uint32 mixCalls;    ///< Number of times the channel was mixed
+		uint64 mixMicros;   ///< Time spent decoding, converting and mixing
+		uint32 starved;     ///< Mix calls where the stream ran dry before its end
+	};
+
+	/** Profiling counters of the mixer, see getStats(). */
+	struct Stats {
+		enum {
+			/**
+			 * The callback duration histogram buckets: the callback took less
+			 * than 10%, 25%, 50%, 75% and 100% of the time the produced audio
+			 * lasts, and the last bucket counts late callbacks.
+			 */
+			kHistogramBuckets = 6
+		};
+
+		uint32 callbacks;
+		uint64 callbackMicros;
+		uint32 maxCallbackMicros;
+		uint32 histogram[kHistogramBuckets];
+		/** Callbacks which took longer than the audio they produced lasts. */
+		uint32 underruns;
+		/** Time spent on each sound type, including channels which have finished. */
+		uint64 typeMicros[4];
+		Common::Array<ChannelStats> channels;
+	};
+
+	/**
+	 * Enable or disable the collection of profiling counters. This is off
+	 * by default, as measuring adds some overhead to each callback.
+	 */
+	virtual void setProfiling(bool enable) = 0;
+
+	/** Check whether profiling counters are being collected. */
+	virtual bool isProfiling() const = 0;
+
+	/**
+	 * Return the profiling counters gathered since profiling was enabled
+	 * or the counters were last reset.
+	 */
+	virtual void getStats(Stats &stats) = 0;
+
+	/** Reset all profiling counters to zero. */
+	virtual void resetStats() = 0;
 };
 
 /** @} */
@@ -24,6 +24,7 @@
 
 #include "common/scummsys.h"
 #include "common/mutex.h"
+#include "common/spsc-queue.h"
 #include "audio/mixer.h"
 
 namespace Audio {
@@ -79,6 +80,53 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	/**
+	 * A channel update which is applied by the next mixCallback(), so that
+	 * the frequent volume changes of fades don't have to wait for mixing
+	 * to finish.
+	 */
+	struct ChannelCommand {
+		enum Type {
+			kSetVolume,
+			kSetBalance
+		};
+
+		Type type;
+		uint32 handle;
+		int value;
+	};
+
+	enum {
+		COMMAND_QUEUE_SIZE = 256
+	};
+
+	Common::SPSCQueue<ChannelCommand, COMMAND_QUEUE_SIZE> _commands;
+
+	/**
+	 * Serializes the threads posting commands, and guards _requested. Never
+	 * taken by mixCallback(). When both are needed, _mutex is locked first.
+	 */
+	Common::Mutex _commandMutex;
+
+	/**
+	 * The last volume and balance requested for each channel slot, so that
+	 * getChannelVolume() and getChannelBalance() report them even before
+	 * the commands are applied.
+	 */
+	struct RequestedSettings {
+		RequestedSettings() : handle(0xffffffff), hasVolume(false), hasBalance(false), volume(0), balance(0) {}
+
+		uint32 handle;
+		bool hasVolume, hasBalance;
+		byte volume;
+		int8 balance;
+	};
+
+	RequestedSettings _requested[NUM_CHANNELS];
+
+	bool _profiling;
+	Stats _stats;
+
 
 public:
 
@@ -136,9 +184,29 @@ public:
 	virtual bool getOutputStereo() const;
 	virtual uint getOutputBufSize() const;
 
+	virtual void setProfiling(bool enable);
+	virtual bool isProfiling() const;
+	virtual void getStats(Stats &stats);
+	virtual void resetStats();
+
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
 
+	/** Queue a channel update, applying it at once if the queue is full. */
+	void postCommand(ChannelCommand::Type type, SoundHandle handle, int value);
+
+	/** Record a channel update in _requested. Must be called with _commandMutex held. */
+	void updateRequested(const ChannelCommand &command);
+
+	/** Apply a single channel update. Must be called with _mutex held. */
+	void applyCommand(const ChannelCommand &command);
+
+	/** Apply all queued channel updates. Must be called with _mutex held. */
+	void applyCommands();
+
+	/** Add a mixCallback() run which produced @p len samples to the counters. */
+	void addCallbackStats(uint64 micros, uint len);
+
 public:
 	/**
 	 * The mixer callback function, to be called at regular intervals by
@@ -21,6 +21,7 @@ MODULE_OBJS := \
 	mt32gm.o \
 	musicplugin.o \
 	null.o \
+	prefetchingstream.o \
 	rate.o \
 	timestamp.o \
 	decoders/3do.o \
@@ -109,5 +110,16 @@ MODULE_OBJS += \
 	rwopl3.o
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	rate_neon.o
+$(MODULE)/rate_neon.o: CXXFLAGS += $(NEON_CXXFLAGS)
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	rate_sse2.o
+$(MODULE)/rate_sse2.o: CXXFLAGS += -msse2
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
@@ -0,0 +1,139 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/prefetchingstream.h"
+
+#include "common/system.h"
+#include "common/util.h"
+
+namespace Audio {
+
+PrefetchingAudioStream::PrefetchingAudioStream(AudioStream *stream, uint msecs, DisposeAfterUse::Flag disposeAfterUse) :
+	_stream(stream, disposeAfterUse),
+	_stereo(stream->isStereo()),
+	_rate(stream->getRate()),
+	_readPos(0),
+	_writePos(0),
+	_streamEndOfStream(stream->endOfStream()),
+	_jobSystem(g_system->getJobSystem()),
+	_fillPending(false) {
+
+	const uint32 samples = (uint32)((uint64)_rate * (_stereo ? 2 : 1) * msecs / 1000);
+	_size = 1024;
+	while (_size < samples)
+		_size <<= 1;
+	_buffer = new int16[_size];
+
+	requestFill();
+}
+
+PrefetchingAudioStream::~PrefetchingAudioStream() {
+	waitForFill();
+	delete[] _buffer;
+}
+
+void PrefetchingAudioStream::fillProc(void *refCon) {
+	((PrefetchingAudioStream *)refCon)->fill();
+}
+
+void PrefetchingAudioStream::fill() {
+	uint32 writePos = _writePos.load(std::memory_order_relaxed);
+
+	for (;;) {
+		const uint32 space = _size - (writePos - _readPos.load(std::memory_order_acquire));
+		const uint32 offset = writePos & (_size - 1);
+		// Both are even, so stereo frames are never split
+		const int len = (int)MIN<uint32>(space, _size - offset);
+		if (len == 0)
+			break;
+
+		const int read = _stream->readBuffer(_buffer + offset, len);
+		if (read > 0) {
+			writePos += read;
+			_writePos.store(writePos, std::memory_order_release);
+		}
+		if (read < len)
+			break;
+	}
+
+	_streamEndOfStream.store(_stream->endOfStream(), std::memory_order_release);
+}
+
+void PrefetchingAudioStream::requestFill() {
+	if (_fillPending) {
+		if (!_jobSystem->isDone(_group))
+			return;
+		_fillPending = false;
+	}
+
+	if (_streamEndOfStream.load(std::memory_order_acquire))
+		return;
+
+	_fillPending = true;
+	_jobSystem->submit(_group, fillProc, this);
+}
+
+void PrefetchingAudioStream::waitForFill() {
+	if (_fillPending) {
+		// This may run on the mixer thread, which must not pick up other jobs
+		_jobSystem->waitWithoutHelping(_group);
+		_fillPending = false;
+	}
+}
+
+int PrefetchingAudioStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samples = 0;
+
+	while (samples < numSamples) {
+		uint32 avail = available();
+		if (avail == 0) {
+			// Never block the mixer thread on the worker: return what we
+			// have, and let the mixer pad the rest with silence. Without
+			// workers, the refill runs right away.
+			requestFill();
+
+			avail = available();
+			if (avail == 0)
+				break;
+		}
+
+		const uint32 readPos = _readPos.load(std::memory_order_relaxed);
+		const uint32 offset = readPos & (_size - 1);
+		const uint32 len = MIN<uint32>(MIN<uint32>(avail, _size - offset), numSamples - samples);
+		memcpy(buffer + samples, _buffer + offset, len * sizeof(int16));
+
+		_readPos.store(readPos + len, std::memory_order_release);
+		samples += len;
+	}
+
+	if (available() <= _size / 2)
+		requestFill();
+
+	return samples;
+}
+
+bool PrefetchingAudioStream::endOfStream() const {
+	// Read the flag first: it's published after the samples it covers
+	const bool streamEndOfStream = _streamEndOfStream.load(std::memory_order_acquire);
+	return streamEndOfStream && available() == 0;
+}
+
+} // End of namespace Audio
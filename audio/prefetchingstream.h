@@ -0,0 +1,118 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_PREFETCHINGSTREAM_H
+#define AUDIO_PREFETCHINGSTREAM_H
+
+#include "common/jobsystem.h"
+#include "common/ptr.h"
+#include "common/types.h"
+
+#include "audio/audiostream.h"
+
+#include <atomic>
+
+namespace Audio {
+
+/**
+ * @defgroup audio_prefetchingstream Prefetching stream
+ * @ingroup audio
+ *
+ * @brief Wrapper decoding an audio stream ahead of time.
+ * @{
+ */
+
+/**
+ * Wraps an audio stream and decodes it ahead on a job system worker, so
+ * that slow decoding or file access doesn't stall the mixer.
+ *
+ * The decoded samples are kept in a ring buffer which is refilled in the
+ * background whenever it is half empty. If the buffer runs dry, readBuffer()
+ * returns the samples it has rather than waiting for the worker, so an
+ * underrun is heard as a short gap instead of stalling the mixer.
+ *
+ * The wrapped stream is read from another thread, so it must not be
+ * accessed by anyone else while it is wrapped.
+ */
+class PrefetchingAudioStream : public AudioStream {
+public:
+	/**
+	 * @param stream           The stream to decode ahead.
+	 * @param msecs            How far to decode ahead, in milliseconds.
+	 * @param disposeAfterUse  Whether to delete @p stream together with this stream.
+	 */
+	PrefetchingAudioStream(AudioStream *stream, uint msecs, DisposeAfterUse::Flag disposeAfterUse);
+	~PrefetchingAudioStream();
+
+	int readBuffer(int16 *buffer, const int numSamples) override;
+
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+
+	/**
+	 * A wrapped stream which merely ran out of data for now, like a
+	 * QueuingAudioStream, has to be polled again. Mixer channels only do
+	 * that while endOfData() returns false, so this is the same as
+	 * endOfStream().
+	 */
+	bool endOfData() const override { return endOfStream(); }
+	bool endOfStream() const override;
+
+private:
+	static void fillProc(void *refCon);
+
+	/** Decode into the free part of the ring buffer. */
+	void fill();
+
+	/** Start a background refill, unless one is already running. */
+	void requestFill();
+
+	/** Wait for the background refill to finish, if there is one. */
+	void waitForFill();
+
+	/** Number of samples in the ring buffer. */
+	uint32 available() const {
+		return _writePos.load(std::memory_order_acquire) - _readPos.load(std::memory_order_relaxed);
+	}
+
+	Common::DisposablePtr<AudioStream> _stream;
+	const bool _stereo;
+	const int _rate;
+
+	/** The ring buffer. Its size is a power of two. */
+	int16 *_buffer;
+	uint32 _size;
+
+	/** Total samples read and written; the positions are taken modulo _size. */
+	std::atomic<uint32> _readPos, _writePos;
+
+	/** Whether the wrapped stream had ended after the last refill. */
+	std::atomic<bool> _streamEndOfStream;
+
+	Common::JobSystem *_jobSystem;
+	Common::JobGroup _group;
+	bool _fillPending;
+};
+
+/** @} */
+} // End of namespace Audio
+
+#endif
@@ -29,7 +29,14 @@
 
 #include "audio/audiostream.h"
 #include "audio/rate.h"
+#include "audio/rate_intern.h"
 #include "audio/mixer.h"
+#include "common/array.h"
+#include "common/math.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/singleton.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace Audio {
@@ -45,6 +52,27 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+/**
+ * Pick the fastest kernel the CPU supports for mixing frames into the
+ * output buffer.
+ */
+template<bool inStereo, bool outStereo, bool reverseStereo>
+static MixFramesFunc getMixFramesFunc() {
+	MixFramesFunc func = mixFramesGeneric<inStereo, outStereo, reverseStereo>;
+	// The kernels don't implement the unsigned output variant of clampedAdd
+#ifndef OUTPUT_UNSIGNED_AUDIO
+	if (g_system) {
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) func = mixFramesNEON<inStereo, outStereo, reverseStereo>;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) func = mixFramesSSE2<inStereo, outStereo, reverseStereo>;
+#endif
+	}
+#endif
+	return func;
+}
+
 template<bool inStereo, bool outStereo, bool reverseStereo>
 class RateConverter_Impl : public RateConverter {
 private:
@@ -76,6 +104,15 @@ private:
 	/** Current sample(s) in the input stream (left/right channel) */
 	st_sample_t _inCurL, _inCurR;
 
+	/**
+	 * Resampled frames waiting to be mixed into the output buffer. They are
+	 * mixed in blocks so that the mixing kernel can work on whole vectors.
+	 */
+	st_sample_t _mixBuffer[512];
+
+	/** The kernel used to mix frames into the output buffer */
+	MixFramesFunc _mixFrames;
+
 	int copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
 	int simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
 	int interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
@@ -112,30 +149,18 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 				return (outBuffer - outStart) / (outStereo ? 2 : 1);
 		}
 
-		// Mix the data into the output buffer
-		st_sample_t inL, inR;
-		inL = *_bufferPos++;
-		inR = (inStereo ? *_bufferPos++ : inL);
-		_bufferSize -= (inStereo ? 2 : 1);
-
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// Output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// Output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-			outBuffer += 2;
-		} else {
-			// Output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-			outBuffer += 1;
+		// Mix as much of the buffer as fits into the output buffer
+		uint frames = MIN<uint>(_bufferSize / (inStereo ? 2 : 1), (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		if (frames == 0) {
+			// Drop an incomplete trailing frame
+			_bufferSize = 0;
+			continue;
 		}
+
+		_mixFrames(outBuffer, _bufferPos, frames, volL, volR);
+		_bufferPos += frames * (inStereo ? 2 : 1);
+		_bufferSize -= frames * (inStereo ? 2 : 1);
+		outBuffer += frames * (outStereo ? 2 : 1);
 	}
 
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
@@ -151,51 +176,49 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
-	while (outBuffer < outEnd) {
-		// Read enough input samples so that _outPos >= 0
-		do {
-			// Check if we have to refill the buffer
-			if (_bufferSize == 0) {
-				_bufferPos = _buffer;
-				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
-
-				if (_bufferSize <= 0)
-					return (outBuffer - outStart) / (outStereo ? 2 : 1);
-			}
-
-			_bufferSize -= (inStereo ? 2 : 1);
-			_outPos--;
-
-			if (_outPos >= 0) {
-				_bufferPos += (inStereo ? 2 : 1);
-			}
-		} while (_outPos >= 0);
+	bool endOfInput = false;
+	while (outBuffer < outEnd && !endOfInput) {
+		// Resample a block of frames, then mix it in one go
+		const uint maxFrames = MIN<uint>(ARRAYSIZE(_mixBuffer) / 2, (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		st_sample_t *mixPos = _mixBuffer;
+		st_sample_t *mixEnd = _mixBuffer + maxFrames * (inStereo ? 2 : 1);
+
+		while (mixPos < mixEnd) {
+			// Read enough input samples so that _outPos >= 0
+			do {
+				// Check if we have to refill the buffer
+				if (_bufferSize == 0) {
+					_bufferPos = _buffer;
+					_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+					if (_bufferSize <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+
+				_bufferSize -= (inStereo ? 2 : 1);
+				_outPos--;
+
+				if (_outPos >= 0) {
+					_bufferPos += (inStereo ? 2 : 1);
+				}
+			} while (_outPos >= 0);
+
+			if (endOfInput)
+				break;
+
+			*mixPos++ = *_bufferPos++;
+			if (inStereo)
+				*mixPos++ = *_bufferPos++;
 
-		st_sample_t inL, inR;
-		inL = *_bufferPos++;
-		inR = (inStereo ? *_bufferPos++ : inL);
-
-		// Increment output position
-		_outPos += outPos_inc;
-
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-			outBuffer += 2;
-		} else {
-			// output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-			outBuffer += 1;
+			// Increment output position
+			_outPos += outPos_inc;
 		}
+
+		const uint frames = (mixPos - _mixBuffer) / (inStereo ? 2 : 1);
+		_mixFrames(outBuffer, _mixBuffer, frames, volL, volR);
+		outBuffer += frames * (outStereo ? 2 : 1);
 	}
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
 }
@@ -209,62 +232,58 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
-	while (outBuffer < outEnd) {
-		// Read enough input samples so that _outPosFrac < 0
-		while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
-			// Check if we have to refill the buffer
-			if (_bufferSize == 0) {
-				_bufferPos = _buffer;
-				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
-
-				if (_bufferSize <= 0)
-					return (outBuffer - outStart) / (outStereo ? 2 : 1);
+	bool endOfInput = false;
+	while (outBuffer < outEnd && !endOfInput) {
+		// Resample a block of frames, then mix it in one go
+		const uint maxFrames = MIN<uint>(ARRAYSIZE(_mixBuffer) / 2, (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		st_sample_t *mixPos = _mixBuffer;
+		st_sample_t *mixEnd = _mixBuffer + maxFrames * (inStereo ? 2 : 1);
+
+		while (mixPos < mixEnd) {
+			// Read enough input samples so that _outPosFrac < 0
+			while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
+				// Check if we have to refill the buffer
+				if (_bufferSize == 0) {
+					_bufferPos = _buffer;
+					_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+					if (_bufferSize <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+
+				_bufferSize -= (inStereo ? 2 : 1);
+				_inLastL = _inCurL;
+				_inCurL = *_bufferPos++;
+
+				if (inStereo) {
+					_inLastR = _inCurR;
+					_inCurR = *_bufferPos++;
+				}
+
+				_outPosFrac -= FRAC_ONE_LOW;
 			}
 
-			_bufferSize -= (inStereo ? 2 : 1);
-			_inLastL = _inCurL;
-			_inCurL = *_bufferPos++;
+			if (endOfInput)
+				break;
 
-			if (inStereo) {
-				_inLastR = _inCurR;
-				_inCurR = *_bufferPos++;
-			}
+			// Loop as long as the _outPos trails behind, and as long as there is
+			// still space in the output buffer.
+			while (_outPosFrac < (frac_t)FRAC_ONE_LOW && mixPos < mixEnd) {
+				// Interpolate
+				*mixPos++ = (st_sample_t)(_inLastL + (((_inCurL - _inLastL) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+				if (inStereo)
+					*mixPos++ = (st_sample_t)(_inLastR + (((_inCurR - _inLastR) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
 
-			_outPosFrac -= FRAC_ONE_LOW;
-		}
-
-		// Loop as long as the _outPos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && outBuffer < outEnd) {
-			// Interpolate
-			st_sample_t inL, inR;
-			inL = (st_sample_t)(_inLastL + (((_inCurL - _inLastL) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
-			inR = (inStereo ?
-						(st_sample_t)(_inLastR + (((_inCurR - _inLastR) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
-						inL);
-
-			st_sample_t outL, outR;
-			outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-			outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-			if (outStereo) {
-				// Output left channel
-				clampedAdd(outBuffer[reverseStereo    ], outL);
-
-				// Output right channel
-				clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-				outBuffer += 2;
-			} else {
-				// Output mono channel
-				clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-				outBuffer += 1;
+				// Increment output position
+				_outPosFrac += outPos_inc;
 			}
-
-			// Increment output position
-			_outPosFrac += outPos_inc;
 		}
+
+		const uint frames = (mixPos - _mixBuffer) / (inStereo ? 2 : 1);
+		_mixFrames(outBuffer, _mixBuffer, frames, volL, volR);
+		outBuffer += frames * (outStereo ? 2 : 1);
 	}
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
 }
@@ -280,7 +299,8 @@ RateConverter_Impl<inStereo, outStereo, reverseStereo>::RateConverter_Impl(st_ra
 	_inCurL(0),
 	_inCurR(0),
 	_bufferSize(0),
-	_bufferPos(nullptr) {}
+	_bufferPos(nullptr),
+	_mixFrames(getMixFramesFunc<inStereo, outStereo, reverseStereo>()) {}
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
 int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
@@ -297,21 +317,311 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream
 	}
 }
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
+/**
+ * Zeroth order modified Bessel function of the first kind, used for the
+ * Kaiser window.
+ */
+static double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; k++) {
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+		if (term < sum * 1e-12)
+			break;
+	}
+	return sum;
+}
+
+SincFilter::SincFilter(st_rate_t inRate, st_rate_t outRate) {
+	// Output positions repeat every outRate / gcd samples; beyond the cap
+	// the nearest phase is used, which is inaudible at this resolution.
+	_numPhases = MIN<uint>(outRate / Common::gcd(inRate, outRate), kMaxPhases);
+
+	// Leave a transition band below the Nyquist frequency of the lower rate
+	// and pass samples through unchanged if there is nothing to convert.
+	const double cutoff = (inRate == outRate) ? 1.0 : 0.9 * MIN<double>(1.0, (double)outRate / inRate);
+	const double beta = 6.0;
+	const double halfWidth = kTaps / 2;
+
+	_coeffs = new int16[(_numPhases + 1) * kTaps];
+
+	for (uint p = 0; p <= _numPhases; p++) {
+		const double frac = (double)p / _numPhases;
+		double taps[kTaps];
+		double sum = 0.0;
+
+		for (int k = 0; k < kTaps; k++) {
+			const double t = k - (kTaps / 2 - 1) - frac;
+			const double x = t / halfWidth;
+			const double window = (x * x < 1.0) ? besselI0(beta * sqrt(1.0 - x * x)) / besselI0(beta) : 0.0;
+			const double sinc = (t == 0.0) ? 1.0 : sin(M_PI * cutoff * t) / (M_PI * cutoff * t);
+			taps[k] = cutoff * sinc * window;
+			sum += taps[k];
+		}
+
+		// Normalize the gain so that DC passes through unchanged, and put
+		// the rounding error onto the largest tap
+		int16 *coeffs = _coeffs + p * kTaps;
+		int total = 0, peak = 0;
+		for (int k = 0; k < kTaps; k++) {
+			coeffs[k] = (int16)floor(taps[k] / sum * (1 << kCoeffBits) + 0.5);
+			total += coeffs[k];
+			if (coeffs[k] > coeffs[peak])
+				peak = k;
+		}
+		coeffs[peak] += (1 << kCoeffBits) - total;
+	}
+}
+
+/**
+ * Keeps the filters of the rate pairs currently in use, so that channels
+ * playing at the same rate don't each have to compute their own table.
+ */
+class SincFilterCache : public Common::Singleton<SincFilterCache> {
+public:
+	Common::SharedPtr<const SincFilter> getFilter(st_rate_t inRate, st_rate_t outRate) {
+		Common::StackLock lock(_mutex);
+
+		for (uint i = 0; i < _entries.size(); i++) {
+			if (_entries[i].inRate == inRate && _entries[i].outRate == outRate)
+				return _entries[i].filter;
+		}
+
+		// Forget the filters nobody uses anymore
+		if (_entries.size() >= kMaxUnused) {
+			for (uint i = 0; i < _entries.size(); ) {
+				if (_entries[i].filter.unique())
+					_entries.remove_at(i);
+				else
+					i++;
+			}
+		}
+
+		Entry entry;
+		entry.inRate = inRate;
+		entry.outRate = outRate;
+		entry.filter = Common::SharedPtr<const SincFilter>(new SincFilter(inRate, outRate));
+		_entries.push_back(entry);
+		return entry.filter;
+	}
+
+private:
+	friend class Common::Singleton<SincFilterCache>;
+	SincFilterCache() {}
+
+	enum {
+		kMaxUnused = 16
+	};
+
+	struct Entry {
+		st_rate_t inRate, outRate;
+		Common::SharedPtr<const SincFilter> filter;
+	};
+
+	Common::Mutex _mutex;
+	Common::Array<Entry> _entries;
+};
+
+/** Pick the fastest kernel the CPU supports for the sinc filter. */
+static SincFilterFunc getSincFilterFunc() {
+	SincFilterFunc func = sincFilterGeneric;
+	if (g_system) {
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) func = sincFilterNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) func = sincFilterSSE2;
+#endif
+	}
+	return func;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+class SincRateConverter_Impl : public RateConverter {
+private:
+	enum {
+		kChannels = inStereo ? 2 : 1,
+		kHistorySize = 512 + SincFilter::kTaps
+	};
+
+	/** Input and output rates */
+	st_rate_t _inRate, _outRate;
+
+	/**
+	 * The filter for the current rates. It is built when the rates are set,
+	 * so that the mixer thread doesn't have to.
+	 */
+	Common::SharedPtr<const SincFilter> _filter;
+
+	/** Position of the next output frame in the history, as 32.32 fixed point */
+	uint64 _pos;
+
+	/** Distance between two output frames, as 32.32 fixed point */
+	uint64 _step;
+
+	/** Interleaved samples read from the input stream */
+	st_sample_t _buffer[512];
+
+	/** The last input samples of each channel, as needed by the filter */
+	st_sample_t _history[kChannels][kHistorySize];
+
+	/** Number of samples of each channel in the history */
+	uint _historySize;
+
+	/** Has the end of the input been padded with silence? */
+	bool _endPadded;
+
+	/** Filtered frames waiting to be mixed into the output buffer */
+	st_sample_t _mixBuffer[512];
+
+	/** The kernels used to filter and to mix frames into the output buffer */
+	SincFilterFunc _filterFunc;
+	MixFramesFunc _mixFrames;
+
+	void resetStep() {
+		_step = ((uint64)_inRate << 32) / _outRate;
+		_filter = SincFilterCache::instance().getFilter(_inRate, _outRate);
+	}
+
+	/** Number of frames which can be filtered with the current history. */
+	uint availableFrames() const {
+		if (_historySize < SincFilter::kTaps)
+			return 0;
+
+		const uint64 last = ((uint64)(_historySize - SincFilter::kTaps) << 32) | 0xFFFFFFFF;
+		if (_pos > last)
+			return 0;
+		return (uint)MIN<uint64>((last - _pos) / _step + 1, kHistorySize);
+	}
+
+	bool fillHistory(AudioStream &input);
+
+public:
+	SincRateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate);
+	virtual ~SincRateConverter_Impl() {}
+
+	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
+
+	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; resetStep(); }
+	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; resetStep(); }
+
+	st_rate_t getInputRate() const override { return _inRate; }
+	st_rate_t getOutputRate() const override { return _outRate; }
+
+	bool needsDraining() const override {
+		if (!_endPadded)
+			return _historySize > (uint)(_pos >> 32) + SincFilter::kTaps / 2 - 1;
+		return availableFrames() != 0;
+	}
+};
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+SincRateConverter_Impl<inStereo, outStereo, reverseStereo>::SincRateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate) :
+	_inRate(inputRate),
+	_outRate(outputRate),
+	_pos(0),
+	_step(0),
+	_historySize(SincFilter::kTaps / 2 - 1),
+	_endPadded(false),
+	_filterFunc(getSincFilterFunc()),
+	_mixFrames(getMixFramesFunc<inStereo, outStereo, reverseStereo>()) {
+	resetStep();
+
+	// Start with silence before the first sample, so that the first output
+	// frame lines up with the first input frame
+	for (int c = 0; c < kChannels; c++)
+		memset(_history[c], 0, sizeof(_history[c]));
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+bool SincRateConverter_Impl<inStereo, outStereo, reverseStereo>::fillHistory(AudioStream &input) {
+	// Drop the samples the filter won't look at again
+	const uint consumed = (uint)MIN<uint64>(_pos >> 32, _historySize);
+	if (consumed) {
+		for (int c = 0; c < kChannels; c++)
+			memmove(_history[c], _history[c] + consumed, (_historySize - consumed) * sizeof(st_sample_t));
+		_historySize -= consumed;
+		_pos -= (uint64)consumed << 32;
+	}
+
+	const uint space = MIN<uint>(kHistorySize - _historySize, ARRAYSIZE(_buffer) / kChannels);
+	const int read = input.readBuffer(_buffer, space * kChannels);
+	const uint frames = read > 0 ? read / kChannels : 0;
+
+	if (frames == 0) {
+		// Flush the samples still inside the filter once the input is done
+		if (read > 0 || _endPadded || !input.endOfData())
+			return read > 0;
+
+		const uint padding = MIN<uint>(SincFilter::kTaps / 2, kHistorySize - _historySize);
+		for (int c = 0; c < kChannels; c++)
+			memset(_history[c] + _historySize, 0, padding * sizeof(st_sample_t));
+		_historySize += padding;
+		_endPadded = true;
+		return true;
+	}
+
+	for (uint i = 0; i < frames; i++) {
+		for (int c = 0; c < kChannels; c++)
+			_history[c][_historySize + i] = _buffer[i * kChannels + c];
+	}
+	_historySize += frames;
+	_endPadded = false;
+	return true;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+int SincRateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	assert(input.isStereo() == inStereo);
+
+	st_sample_t *outStart = outBuffer;
+	st_sample_t *outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+
+	while (outBuffer < outEnd) {
+		const uint frames = MIN<uint>(availableFrames(), MIN<uint>(ARRAYSIZE(_mixBuffer) / 2, (outEnd - outBuffer) / (outStereo ? 2 : 1)));
+		if (frames == 0) {
+			if (!fillHistory(input))
+				break;
+			continue;
+		}
+
+		for (int c = 0; c < kChannels; c++)
+			_filterFunc(_mixBuffer + c, kChannels, _history[c], frames, _pos, _step, *_filter);
+		_pos += _step * frames;
+
+		_mixFrames(outBuffer, _mixBuffer, frames, volL, volR);
+		outBuffer += frames * (outStereo ? 2 : 1);
+	}
+
+	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+static RateConverter *makeRateConverterType(st_rate_t inRate, st_rate_t outRate, RateConverterType type) {
+	if (type == kRateConverterSinc)
+		return new SincRateConverter_Impl<inStereo, outStereo, reverseStereo>(inRate, outRate);
+	return new RateConverter_Impl<inStereo, outStereo, reverseStereo>(inRate, outRate);
+}
+
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, RateConverterType type) {
 	if (inStereo) {
 		if (outStereo) {
 			if (reverseStereo)
-				return new RateConverter_Impl<true, true, true>(inRate, outRate);
+				return makeRateConverterType<true, true, true>(inRate, outRate, type);
 			else
-				return new RateConverter_Impl<true, true, false>(inRate, outRate);
+				return makeRateConverterType<true, true, false>(inRate, outRate, type);
 		} else
-			return new RateConverter_Impl<true, false, false>(inRate, outRate);
+			return makeRateConverterType<true, false, false>(inRate, outRate, type);
 	} else {
 		if (outStereo) {
-			return new RateConverter_Impl<false, true, false>(inRate, outRate);
+			return makeRateConverterType<false, true, false>(inRate, outRate, type);
 		} else
-			return new RateConverter_Impl<false, false, false>(inRate, outRate);
+			return makeRateConverterType<false, false, false>(inRate, outRate, type);
 	}
 }
 
 } // End of namespace Audio
+
+namespace Common {
+DECLARE_SINGLETON(Audio::SincFilterCache);
+}
@@ -104,7 +104,22 @@ public:
 	virtual bool needsDraining() const = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo);
+/** Resampling algorithms which makeRateConverter() can use. */
+enum RateConverterType {
+	/**
+	 * Copy, nearest neighbour or linear interpolation, depending on the
+	 * input and output rate.
+	 */
+	kRateConverterDefault,
+
+	/**
+	 * Polyphase windowed-sinc filter. Slower, but with much less aliasing
+	 * and imaging when upsampling low rate assets.
+	 */
+	kRateConverterSinc
+};
+
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, RateConverterType type = kRateConverterDefault);
 
 /** @} */
 } // End of namespace Audio
@@ -0,0 +1,170 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_RATE_INTERN_H
+#define AUDIO_RATE_INTERN_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+#include "common/util.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+namespace Audio {
+
+/**
+ * @defgroup audio_rate_intern Sample mixing kernels
+ * @ingroup audio
+ *
+ * @brief Kernels used by the rate converters to mix resampled frames.
+ * @{
+ */
+
+/**
+ * Scale a block of frames by the channel volumes and add them to the
+ * output buffer with clamping.
+ *
+ * @param out		The output buffer, holding @p frames frames.
+ * @param in		The input frames.
+ * @param frames	The number of frames to mix.
+ * @param volL		Volume for left channel.
+ * @param volR		Volume for right channel.
+ */
+typedef void (*MixFramesFunc)(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+
+/**
+ * The reference mixing code, which the vectorized kernels must match bit
+ * for bit. They use it for the frames which don't fill a whole vector.
+ */
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void mixFramesGeneric(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR) {
+	for (uint i = 0; i < frames; i++) {
+		st_sample_t inL, inR;
+		inL = *in++;
+		inR = (inStereo ? *in++ : inL);
+
+		st_sample_t outL, outR;
+		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
+		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+
+		if (outStereo) {
+			// Output left channel
+			clampedAdd(out[reverseStereo    ], outL);
+
+			// Output right channel
+			clampedAdd(out[reverseStereo ^ 1], outR);
+
+			out += 2;
+		} else {
+			// Output mono channel
+			clampedAdd(out[0], (outL + outR) / 2);
+
+			out += 1;
+		}
+	}
+}
+
+// The vectorized kernels divide by kMaxMixerVolume with a shift, and fall
+// back to mixFramesGeneric for volumes above it.
+#ifdef SCUMMVM_NEON
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void mixFramesNEON(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+#endif
+#ifdef SCUMMVM_SSE2
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void mixFramesSSE2(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+#endif
+
+/**
+ * Polyphase windowed-sinc filter coefficients for one input/output rate
+ * pair. Filters are immutable once built, so converters using the same
+ * rates share them.
+ */
+struct SincFilter : Common::NonCopyable {
+	enum {
+		kTaps = 16,         ///< Input samples used for each output sample
+		kCoeffBits = 14,    ///< Fractional bits of the coefficients
+		kMaxPhases = 512    ///< Upper limit for the number of phases
+	};
+
+	SincFilter(st_rate_t inRate, st_rate_t outRate);
+	~SincFilter() { delete[] _coeffs; }
+
+	/**
+	 * Return the kTaps coefficients for an output sample which lies
+	 * @p frac (in units of 1/2^32) after an input sample.
+	 */
+	inline const int16 *getCoeffs(uint32 frac) const {
+		const uint phase = (uint)(((uint64)frac * _numPhases + 0x80000000U) >> 32);
+		return _coeffs + phase * kTaps;
+	}
+
+private:
+	/** Number of phases per input sample; the table holds one extra phase. */
+	uint _numPhases;
+	int16 *_coeffs;
+};
+
+/**
+ * Filter @p count samples of one channel.
+ *
+ * Output sample n is computed from in[p .. p + kTaps), p being the
+ * integer part of the 32.32 fixed point position @p pos + n * @p step.
+ * Its position lies between in[p + kTaps / 2 - 1] and in[p + kTaps / 2].
+ *
+ * @param out		The output buffer, samples are @p outStride apart.
+ * @param outStride	Distance between two output samples.
+ * @param in		The input samples.
+ * @param count		The number of samples to filter.
+ * @param pos		Position of the first output sample.
+ * @param step		Distance between two output samples, in input samples.
+ * @param filter	The filter to use.
+ */
+typedef void (*SincFilterFunc)(st_sample_t *out, uint outStride, const st_sample_t *in, uint count, uint64 pos, uint64 step, const SincFilter &filter);
+
+inline void sincFilterGeneric(st_sample_t *out, uint outStride, const st_sample_t *in, uint count, uint64 pos, uint64 step, const SincFilter &filter) {
+	for (uint i = 0; i < count; i++) {
+		const st_sample_t *src = in + (pos >> 32);
+		const int16 *coeffs = filter.getCoeffs((uint32)pos);
+
+		int acc = 0;
+		for (int k = 0; k < SincFilter::kTaps; k++)
+			acc += src[k] * coeffs[k];
+
+		acc = (acc + (1 << (SincFilter::kCoeffBits - 1))) >> SincFilter::kCoeffBits;
+		*out = (st_sample_t)CLIP<int>(acc, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+
+		out += outStride;
+		pos += step;
+	}
+}
+
+#ifdef SCUMMVM_NEON
+void sincFilterNEON(st_sample_t *out, uint outStride, const st_sample_t *in, uint count, uint64 pos, uint64 step, const SincFilter &filter);
+#endif
+#ifdef SCUMMVM_SSE2
+void sincFilterSSE2(st_sample_t *out, uint outStride, const st_sample_t *in, uint count, uint64 pos, uint64 step, const SincFilter &filter);
+#endif
+
+/** @} */
+} // End of namespace Audio
+
+#endif
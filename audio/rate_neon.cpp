@@ -0,0 +1,148 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+#include <arm_neon.h>
+
+#include "audio/rate_intern.h"
+
+namespace Audio {
+
+STATIC_ASSERT(Mixer::kMaxMixerVolume == 256, Unexpected_mixer_volume);
+
+namespace {
+
+/** Divide four 32-bit values by 2^shift, rounding toward zero. */
+template<int shift>
+static inline int32x4_t divide(int32x4_t x) {
+	const int32x4_t bias = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(x, 31)), 32 - shift));
+	return vshrq_n_s32(vaddq_s32(x, bias), shift);
+}
+
+/** Multiply eight samples by a volume and divide by 256, rounding toward zero. */
+static inline int16x8_t scaleSamples(int16x8_t samples, int16x8_t vol) {
+	const int32x4_t p0 = divide<8>(vmull_s16(vget_low_s16(samples), vget_low_s16(vol)));
+	const int32x4_t p1 = divide<8>(vmull_s16(vget_high_s16(samples), vget_high_s16(vol)));
+	// The volume is at most 256, so the results fit into 16 bits
+	return vcombine_s16(vmovn_s32(p0), vmovn_s32(p1));
+}
+
+/** Average the left and right channel of four stereo frames. */
+static inline int32x4_t downmix(int16x8_t samples) {
+	return divide<1>(vpaddlq_s16(samples));
+}
+
+static inline void mixInto(st_sample_t *out, int16x8_t samples) {
+	vst1q_s16(out, vqaddq_s16(vld1q_s16(out), samples));
+}
+
+} // End of anonymous namespace
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void mixFramesNEON(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR) {
+	if (volL > Mixer::kMaxMixerVolume || volR > Mixer::kMaxMixerVolume) {
+		mixFramesGeneric<inStereo, outStereo, reverseStereo>(out, in, frames, volL, volR);
+		return;
+	}
+
+	const int16 volumes[8] = { (int16)volL, (int16)volR, (int16)volL, (int16)volR, (int16)volL, (int16)volR, (int16)volL, (int16)volR };
+	const int16x8_t volLR = vld1q_s16(volumes);
+	uint i = 0;
+
+	if (inStereo && outStereo) {
+		for (; i + 4 <= frames; i += 4) {
+			int16x8_t samples = scaleSamples(vld1q_s16(in), volLR);
+			if (reverseStereo)
+				samples = vrev32q_s16(samples);
+			mixInto(out, samples);
+			in += 8;
+			out += 8;
+		}
+	} else if (inStereo) {
+		for (; i + 8 <= frames; i += 8) {
+			const int32x4_t lo = downmix(scaleSamples(vld1q_s16(in), volLR));
+			const int32x4_t hi = downmix(scaleSamples(vld1q_s16(in + 8), volLR));
+			mixInto(out, vcombine_s16(vmovn_s32(lo), vmovn_s32(hi)));
+			in += 16;
+			out += 8;
+		}
+	} else if (outStereo) {
+		for (; i + 8 <= frames; i += 8) {
+			const int16x8_t samples = vld1q_s16(in);
+			const int16x8x2_t pairs = vzipq_s16(samples, samples);
+			mixInto(out, scaleSamples(pairs.val[0], volLR));
+			mixInto(out + 8, scaleSamples(pairs.val[1], volLR));
+			in += 8;
+			out += 16;
+		}
+	} else {
+		const int16x8_t vl = vdupq_n_s16(volL);
+		const int16x8_t vr = vdupq_n_s16(volR);
+		for (; i + 8 <= frames; i += 8) {
+			const int16x8_t samples = vld1q_s16(in);
+			const int16x8_t l = scaleSamples(samples, vl);
+			const int16x8_t r = scaleSamples(samples, vr);
+			const int32x4_t lo = divide<1>(vaddl_s16(vget_low_s16(l), vget_low_s16(r)));
+			const int32x4_t hi = divide<1>(vaddl_s16(vget_high_s16(l), vget_high_s16(r)));
+			mixInto(out, vcombine_s16(vmovn_s32(lo), vmovn_s32(hi)));
+			in += 8;
+			out += 8;
+		}
+	}
+
+	mixFramesGeneric<inStereo, outStereo, reverseStereo>(out, in, frames - i, volL, volR);
+}
+
+template void mixFramesNEON<true, true, true>(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+template void mixFramesNEON<true, true, false>(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+template void mixFramesNEON<true, false, false>(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+template void mixFramesNEON<false, true, false>(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+template void mixFramesNEON<false, false, false>(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+
+STATIC_ASSERT(SincFilter::kTaps == 16, Unexpected_sinc_filter_size);
+
+void sincFilterNEON(st_sample_t *out, uint outStride, const st_sample_t *in, uint count, uint64 pos, uint64 step, const SincFilter &filter) {
+	for (uint i = 0; i < count; i++) {
+		const st_sample_t *src = in + (pos >> 32);
+		const int16 *coeffs = filter.getCoeffs((uint32)pos);
+
+		const int16x8_t s0 = vld1q_s16(src), s1 = vld1q_s16(src + 8);
+		const int16x8_t c0 = vld1q_s16(coeffs), c1 = vld1q_s16(coeffs + 8);
+		int32x4_t acc = vmull_s16(vget_low_s16(s0), vget_low_s16(c0));
+		acc = vmlal_s16(acc, vget_high_s16(s0), vget_high_s16(c0));
+		acc = vmlal_s16(acc, vget_low_s16(s1), vget_low_s16(c1));
+		acc = vmlal_s16(acc, vget_high_s16(s1), vget_high_s16(c1));
+
+		int32x2_t sum = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+		sum = vpadd_s32(sum, sum);
+		// Round, shift and clamp to the sample range in one go
+		const int16x4_t sample = vqrshrn_n_s32(vcombine_s32(sum, sum), SincFilter::kCoeffBits);
+		*out = vget_lane_s16(sample, 0);
+
+		out += outStride;
+		pos += step;
+	}
+}
+
+} // End of namespace Audio
+#endif // SCUMMVM_NEON
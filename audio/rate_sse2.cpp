@@ -0,0 +1,162 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include <immintrin.h>
+
+#include "audio/rate_intern.h"
+
+namespace Audio {
+
+STATIC_ASSERT(Mixer::kMaxMixerVolume == 256, Unexpected_mixer_volume);
+
+namespace {
+
+/** Multiply eight samples by a volume and divide by 256, rounding toward zero. */
+static inline __m128i scaleSamples(__m128i samples, __m128i vol) {
+	const __m128i lo = _mm_mullo_epi16(samples, vol);
+	const __m128i hi = _mm_mulhi_epi16(samples, vol);
+	__m128i p0 = _mm_unpacklo_epi16(lo, hi);
+	__m128i p1 = _mm_unpackhi_epi16(lo, hi);
+	p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_srli_epi32(_mm_srai_epi32(p0, 31), 24)), 8);
+	p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_srli_epi32(_mm_srai_epi32(p1, 31), 24)), 8);
+	// The volume is at most 256, so this can't saturate
+	return _mm_packs_epi32(p0, p1);
+}
+
+/** Divide four 32-bit values by two, rounding toward zero. */
+static inline __m128i halve(__m128i x) {
+	return _mm_srai_epi32(_mm_add_epi32(x, _mm_srli_epi32(x, 31)), 1);
+}
+
+/** Average the left and right channel of four stereo frames. */
+static inline __m128i downmix(__m128i samples) {
+	return halve(_mm_madd_epi16(samples, _mm_set1_epi16(1)));
+}
+
+static inline void mixInto(st_sample_t *out, __m128i samples) {
+	const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+	_mm_storeu_si128((__m128i *)out, _mm_adds_epi16(dst, samples));
+}
+
+} // End of anonymous namespace
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void mixFramesSSE2(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR) {
+	if (volL > Mixer::kMaxMixerVolume || volR > Mixer::kMaxMixerVolume) {
+		mixFramesGeneric<inStereo, outStereo, reverseStereo>(out, in, frames, volL, volR);
+		return;
+	}
+
+	const __m128i volLR = _mm_set_epi16(volR, volL, volR, volL, volR, volL, volR, volL);
+	uint i = 0;
+
+	if (inStereo && outStereo) {
+		for (; i + 4 <= frames; i += 4) {
+			__m128i samples = scaleSamples(_mm_loadu_si128((const __m128i *)in), volLR);
+			if (reverseStereo) {
+				samples = _mm_shufflelo_epi16(samples, _MM_SHUFFLE(2, 3, 0, 1));
+				samples = _mm_shufflehi_epi16(samples, _MM_SHUFFLE(2, 3, 0, 1));
+			}
+			mixInto(out, samples);
+			in += 8;
+			out += 8;
+		}
+	} else if (inStereo) {
+		for (; i + 8 <= frames; i += 8) {
+			const __m128i lo = downmix(scaleSamples(_mm_loadu_si128((const __m128i *)in), volLR));
+			const __m128i hi = downmix(scaleSamples(_mm_loadu_si128((const __m128i *)(in + 8)), volLR));
+			mixInto(out, _mm_packs_epi32(lo, hi));
+			in += 16;
+			out += 8;
+		}
+	} else if (outStereo) {
+		for (; i + 8 <= frames; i += 8) {
+			const __m128i samples = _mm_loadu_si128((const __m128i *)in);
+			mixInto(out, scaleSamples(_mm_unpacklo_epi16(samples, samples), volLR));
+			mixInto(out + 8, scaleSamples(_mm_unpackhi_epi16(samples, samples), volLR));
+			in += 8;
+			out += 16;
+		}
+	} else {
+		const __m128i vl = _mm_set1_epi16(volL);
+		const __m128i vr = _mm_set1_epi16(volR);
+		for (; i + 8 <= frames; i += 8) {
+			const __m128i samples = _mm_loadu_si128((const __m128i *)in);
+			const __m128i l = scaleSamples(samples, vl);
+			const __m128i r = scaleSamples(samples, vr);
+			// Sign extend to 32 bits before adding both channels
+			const __m128i lo = halve(_mm_add_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(l, l), 16), _mm_srai_epi32(_mm_unpacklo_epi16(r, r), 16)));
+			const __m128i hi = halve(_mm_add_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(l, l), 16), _mm_srai_epi32(_mm_unpackhi_epi16(r, r), 16)));
+			mixInto(out, _mm_packs_epi32(lo, hi));
+			in += 8;
+			out += 8;
+		}
+	}
+
+	mixFramesGeneric<inStereo, outStereo, reverseStereo>(out, in, frames - i, volL, volR);
+}
+
+template void mixFramesSSE2<true, true, true>(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+template void mixFramesSSE2<true, true, false>(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+template void mixFramesSSE2<true, false, false>(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+template void mixFramesSSE2<false, true, false>(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+template void mixFramesSSE2<false, false, false>(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR);
+
+STATIC_ASSERT(SincFilter::kTaps == 16, Unexpected_sinc_filter_size);
+
+/** Multiply one window of input samples with the filter coefficients. */
+static inline __m128i sincProducts(const st_sample_t *src, const int16 *coeffs) {
+	const __m128i lo = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)src), _mm_loadu_si128((const __m128i *)coeffs));
+	const __m128i hi = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(src + 8)), _mm_loadu_si128((const __m128i *)(coeffs + 8)));
+	return _mm_add_epi32(lo, hi);
+}
+
+void sincFilterSSE2(st_sample_t *out, uint outStride, const st_sample_t *in, uint count, uint64 pos, uint64 step, const SincFilter &filter) {
+	const __m128i round = _mm_set1_epi32(1 << (SincFilter::kCoeffBits - 1));
+	uint i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		__m128i p[4];
+		for (int j = 0; j < 4; j++) {
+			p[j] = sincProducts(in + (pos >> 32), filter.getCoeffs((uint32)pos));
+			pos += step;
+		}
+
+		// Add up the products of each sample, giving one sum per lane
+		const __m128i t0 = _mm_add_epi32(_mm_unpacklo_epi32(p[0], p[1]), _mm_unpackhi_epi32(p[0], p[1]));
+		const __m128i t1 = _mm_add_epi32(_mm_unpacklo_epi32(p[2], p[3]), _mm_unpackhi_epi32(p[2], p[3]));
+		__m128i sum = _mm_add_epi32(_mm_unpacklo_epi64(t0, t1), _mm_unpackhi_epi64(t0, t1));
+		sum = _mm_srai_epi32(_mm_add_epi32(sum, round), SincFilter::kCoeffBits);
+
+		// Packing clamps the results to the sample range
+		const __m128i samples = _mm_packs_epi32(sum, sum);
+		out[0]             = (st_sample_t)_mm_extract_epi16(samples, 0);
+		out[outStride]     = (st_sample_t)_mm_extract_epi16(samples, 1);
+		out[outStride * 2] = (st_sample_t)_mm_extract_epi16(samples, 2);
+		out[outStride * 3] = (st_sample_t)_mm_extract_epi16(samples, 3);
+		out += outStride * 4;
+	}
+
+	sincFilterGeneric(out, outStride, in, count - i, pos, step, filter);
+}
+
+} // End of namespace Audio
@@ -43,12 +43,24 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	uint32 _eventDelay;
+
 protected:
 	int _baseFreq;
 
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
+	/**
+	 * Returns the number of samples after the current output position at
+	 * which an event which is sent now is due, as set by setEventDelay().
+	 * The timer callback is made right before the samples of its interval
+	 * are generated, so this is where the event should start to sound.
+	 */
+	uint32 getEventSampleDelay() const {
+		return (uint64)_eventDelay * getRate() / 1000000;
+	}
+
 public:
 	MidiDriver_Emulated(Audio::Mixer *mixer) :
 		_mixer(mixer),
@@ -57,6 +69,7 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_eventDelay(0),
 		_baseFreq(250) {
 	}
 
@@ -86,6 +99,10 @@ public:
 		return 1000000 / _baseFreq;
 	}
 
+	virtual void setEventDelay(uint32 delay) {
+		_eventDelay = delay;
+	}
+
 	// AudioStream API
 	virtual int readBuffer(int16 *data, const int numSamples) {
 		const int stereoFactor = isStereo() ? 2 : 1;
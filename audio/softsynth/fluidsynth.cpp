@@ -38,8 +38,10 @@
 #endif
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/config-manager.h"
 #include "common/error.h"
+#include "common/mutex.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/archive.h"
@@ -93,6 +95,32 @@ static void logHandler(int level, char *message, void *data)
 	}
 }
 
+// Loading a large SoundFont takes seconds and plenty of memory. So, when a
+// driver using a SoundFont file is closed, its synth is kept loaded, and the
+// next driver opened with the same SoundFont reuses it. This way, returning
+// to the launcher and starting another game doesn't load the SoundFont again.
+struct FluidSynthCache {
+	Common::String soundFontPath;
+	int outputRate;
+	bool dynamicSampleLoading;
+	fluid_settings_t *settings;
+	fluid_synth_t *synth;
+	int soundFont;
+};
+
+static FluidSynthCache *g_fluidSynthCache = nullptr;
+
+static void freeFluidSynthCache() {
+	if (!g_fluidSynthCache)
+		return;
+
+	fluid_synth_sfunload(g_fluidSynthCache->synth, g_fluidSynthCache->soundFont, 1);
+	delete_fluid_synth(g_fluidSynthCache->synth);
+	delete_fluid_settings(g_fluidSynthCache->settings);
+	delete g_fluidSynthCache;
+	g_fluidSynthCache = nullptr;
+}
+
 class MidiDriver_FluidSynth : public MidiDriver_Emulated {
 private:
 	MidiChannel_MPU401 _midiChannels[16];
@@ -100,7 +128,20 @@ private:
 	fluid_synth_t *_synth;
 	int _soundFont;
 	int _outputRate;
+	bool _dynamicSampleLoading;
 	Common::SeekableReadStream *_engineSoundFontData;
+	Common::String _soundFontPath; // Empty when using in-memory SoundFont data, which can't be cached
+
+	// Events which were sent with a delay, in the order in which they are
+	// due. The delays are in samples from the current output position.
+	struct DelayedEvent {
+		uint32 b;
+		uint32 delay;
+	};
+	Common::Array<DelayedEvent> _delayedEvents;
+	Common::Mutex _delayedEventsMutex;
+
+	void playEvent(uint32 b);
 
 protected:
 	// Because GCC complains about casting from const to non-const...
@@ -133,7 +174,7 @@ public:
 // MidiDriver method implementations
 
 MidiDriver_FluidSynth::MidiDriver_FluidSynth(Audio::Mixer *mixer)
-	: MidiDriver_Emulated(mixer), _engineSoundFontData(nullptr) {
+	: MidiDriver_Emulated(mixer), _settings(nullptr), _synth(nullptr), _soundFont(-1), _dynamicSampleLoading(false), _engineSoundFontData(nullptr) {
 
 	for (int i = 0; i < ARRAYSIZE(_midiChannels); i++) {
 		_midiChannels[i].init(this, i);
@@ -351,8 +392,6 @@ int MidiDriver_FluidSynth::open() {
 	}
 #endif
 
-	_settings = new_fluid_settings();
-
 	// The default gain setting is ridiculously low - at least for me. This
 	// cannot be fixed by ScummVM's volume settings because they can only
 	// soften the sound, not amplify it, so instead we add an option to
@@ -360,10 +399,42 @@ int MidiDriver_FluidSynth::open() {
 
 	double gain = (double)ConfMan.getInt("midi_gain") / 100.0;
 
-	setNum("synth.gain", gain);
-	setNum("synth.sample-rate", _outputRate);
+	_soundFontPath.clear();
+	if (!isUsingInMemorySoundFontData)
+		_soundFontPath = getSoundFontPath().toString(Common::Path::kNativeSeparator);
+#if !defined(USE_FLUIDLITE) && FS_API_VERSION >= 0x0201
+	_dynamicSampleLoading = ConfMan.getBool("fluidsynth_dynamic_sample_loading");
+#else
+	_dynamicSampleLoading = false;
+#endif
+
+	if (g_fluidSynthCache && !_soundFontPath.empty() &&
+			g_fluidSynthCache->soundFontPath == _soundFontPath &&
+			g_fluidSynthCache->outputRate == _outputRate &&
+			g_fluidSynthCache->dynamicSampleLoading == _dynamicSampleLoading) {
+		_settings = g_fluidSynthCache->settings;
+		_synth = g_fluidSynthCache->synth;
+		_soundFont = g_fluidSynthCache->soundFont;
+		delete g_fluidSynthCache;
+		g_fluidSynthCache = nullptr;
+
+		fluid_synth_set_gain(_synth, gain);
+	} else {
+		// Don't keep two SoundFonts in memory
+		freeFluidSynthCache();
+
+		_settings = new_fluid_settings();
 
-	_synth = new_fluid_synth(_settings);
+		setNum("synth.gain", gain);
+		setNum("synth.sample-rate", _outputRate);
+#if !defined(USE_FLUIDLITE) && FS_API_VERSION >= 0x0201
+		// Only load the samples of the presets which are actually used
+		setInt("synth.dynamic-sample-loading", _dynamicSampleLoading ? 1 : 0);
+#endif
+
+		_synth = new_fluid_synth(_settings);
+		_soundFont = -1;
+	}
 
 	if (ConfMan.getBool("fluidsynth_chorus_activate")) {
 #if FS_API_VERSION >= 0x0202
@@ -445,46 +516,49 @@ int MidiDriver_FluidSynth::open() {
 
 	fluid_synth_set_interp_method(_synth, -1, interpMethod);
 
-	Common::String soundfont;
+	// A cached synth has the SoundFont loaded already
+	if (_soundFont == -1) {
+		Common::String soundfont;
 
 #if defined(FS_HAS_STREAM_SUPPORT)
-	if (isUsingInMemorySoundFontData) {
+		if (isUsingInMemorySoundFontData) {
 #if defined(USE_FLUIDLITE)
-		fluidlite_stream_holder *holder = new fluidlite_stream_holder;
-		holder->stream = _engineSoundFontData;
-		holder->openCounter = 0;
+			fluidlite_stream_holder *holder = new fluidlite_stream_holder;
+			holder->stream = _engineSoundFontData;
+			holder->openCounter = 0;
 
-		fluid_sfloader_t *soundFontMemoryLoader = new_fluid_defsfloader();
-		soundFontMemoryLoader->fileapi = const_cast<fluid_fileapi_t *>(&SoundFontMemLoader_callbacks);
-		fluid_synth_add_sfloader(_synth, soundFontMemoryLoader);
+			fluid_sfloader_t *soundFontMemoryLoader = new_fluid_defsfloader();
+			soundFontMemoryLoader->fileapi = const_cast<fluid_fileapi_t *>(&SoundFontMemLoader_callbacks);
+			fluid_synth_add_sfloader(_synth, soundFontMemoryLoader);
 
-		soundfont = Common::String::format("&%p", (void *)holder);
+			soundfont = Common::String::format("&%p", (void *)holder);
 #else
-		// Fluidsynth 2.0+
-		fluid_sfloader_t *soundFontMemoryLoader = new_fluid_defsfloader(_settings);
-		fluid_sfloader_set_callbacks(soundFontMemoryLoader,
-									 SoundFontMemLoader_open,
-									 SoundFontMemLoader_read,
-									 SoundFontMemLoader_seek,
-									 SoundFontMemLoader_tell,
-									 SoundFontMemLoader_close);
-		fluid_synth_add_sfloader(_synth, soundFontMemoryLoader);
-
-		soundfont = Common::String::format("&%p", (void *)_engineSoundFontData);
+			// Fluidsynth 2.0+
+			fluid_sfloader_t *soundFontMemoryLoader = new_fluid_defsfloader(_settings);
+			fluid_sfloader_set_callbacks(soundFontMemoryLoader,
+										 SoundFontMemLoader_open,
+										 SoundFontMemLoader_read,
+										 SoundFontMemLoader_seek,
+										 SoundFontMemLoader_tell,
+										 SoundFontMemLoader_close);
+			fluid_synth_add_sfloader(_synth, soundFontMemoryLoader);
+
+			soundfont = Common::String::format("&%p", (void *)_engineSoundFontData);
 #endif
-	} else
+		} else
 #endif // FS_HAS_STREAM_SUPPORT
-	{
-//		soundfont = ConfMan.get("soundfont");
-		soundfont = getSoundFontPath().toString(Common::Path::kNativeSeparator);
-	}
+		{
+//			soundfont = ConfMan.get("soundfont");
+			soundfont = _soundFontPath;
+		}
 
-	_soundFont = fluid_synth_sfload(_synth, soundfont.c_str(), 1);
+		_soundFont = fluid_synth_sfload(_synth, soundfont.c_str(), 1);
 
-	if (_soundFont == -1) {
-		GUI::MessageDialog dialog(Common::U32String::format(_("FluidSynth: Failed loading custom SoundFont '%s'. Music is off."), soundfont.c_str()));
-		dialog.runModal();
-		return MERR_DEVICE_NOT_AVAILABLE;
+		if (_soundFont == -1) {
+			GUI::MessageDialog dialog(Common::U32String::format(_("FluidSynth: Failed loading custom SoundFont '%s'. Music is off."), soundfont.c_str()));
+			dialog.runModal();
+			return MERR_DEVICE_NOT_AVAILABLE;
+		}
 	}
 
 	MidiDriver_Emulated::open();
@@ -500,6 +574,22 @@ void MidiDriver_FluidSynth::close() {
 	_isOpen = false;
 
 	_mixer->stopHandle(_mixerSoundHandle);
+	_delayedEvents.clear();
+
+	if (_soundFont != -1 && !_soundFontPath.empty()) {
+		// Silence the synth and keep it for the next driver, see FluidSynthCache
+		fluid_synth_system_reset(_synth);
+
+		freeFluidSynthCache();
+		g_fluidSynthCache = new FluidSynthCache();
+		g_fluidSynthCache->soundFontPath = _soundFontPath;
+		g_fluidSynthCache->outputRate = _outputRate;
+		g_fluidSynthCache->dynamicSampleLoading = _dynamicSampleLoading;
+		g_fluidSynthCache->settings = _settings;
+		g_fluidSynthCache->synth = _synth;
+		g_fluidSynthCache->soundFont = _soundFont;
+		return;
+	}
 
 	if (_soundFont != -1)
 		fluid_synth_sfunload(_synth, _soundFont, 1);
@@ -514,6 +604,23 @@ void MidiDriver_FluidSynth::send(uint32 b) {
 
 	midiDriverCommonSend(b);
 
+	const uint32 delay = getEventSampleDelay();
+	Common::StackLock lock(_delayedEventsMutex);
+	if (delay || !_delayedEvents.empty()) {
+		// Queue the event for generateSamples(), behind the events which
+		// are due at the same time or earlier
+		DelayedEvent event = { b, delay };
+		uint i = _delayedEvents.size();
+		while (i > 0 && _delayedEvents[i - 1].delay > delay)
+			i--;
+		_delayedEvents.insert_at(i, event);
+		return;
+	}
+
+	playEvent(b);
+}
+
+void MidiDriver_FluidSynth::playEvent(uint32 b) {
 	//byte param3 = (byte) ((b >> 24) & 0xFF);
 	uint param2 = (byte) ((b >> 16) & 0xFF);
 	uint param1 = (byte) ((b >>  8) & 0xFF);
@@ -564,7 +671,27 @@ MidiChannel *MidiDriver_FluidSynth::getPercussionChannel() {
 }
 
 void MidiDriver_FluidSynth::generateSamples(int16 *data, int len) {
-	fluid_synth_write_s16(_synth, len, data, 0, 2, data, 1, 2);
+	Common::StackLock lock(_delayedEventsMutex);
+
+	// Play the delayed events when they are due, rendering the samples
+	// in between
+	uint played = 0;
+	while (len > 0) {
+		while (played < _delayedEvents.size() && _delayedEvents[played].delay == 0)
+			playEvent(_delayedEvents[played++].b);
+
+		int step = len;
+		if (played < _delayedEvents.size() && _delayedEvents[played].delay < (uint32)step)
+			step = _delayedEvents[played].delay;
+
+		fluid_synth_write_s16(_synth, step, data, 0, 2, data, 1, 2);
+		for (uint i = played; i < _delayedEvents.size(); i++)
+			_delayedEvents[i].delay -= step;
+
+		data += step * 2;
+		len -= step;
+	}
+	_delayedEvents.erase(_delayedEvents.begin(), _delayedEvents.begin() + played);
 }
 
 void MidiDriver_FluidSynth::setEngineSoundFont(Common::SeekableReadStream *soundFontData) {
@@ -583,6 +710,10 @@ bool MidiDriver_FluidSynth::acceptsSoundFontData() {
 
 class FluidSynthMusicPlugin : public MusicPluginObject {
 public:
+	~FluidSynthMusicPlugin() override {
+		freeFluidSynthCache();
+	}
+
 	const char *getName() const override {
 		return "FluidSynth";
 	}
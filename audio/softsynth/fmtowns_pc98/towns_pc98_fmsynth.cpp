@@ -36,7 +36,8 @@ public:
 	void frequencyLo(uint8 frqL);
 	void updatePhaseIncrement();
 	void recalculateRates();
-	void generateOutput(int32 phasebuf, int32 *feedbuf, int32 &out);
+	inline void generateOutput(int32 phasebuf, int32 *feedbuf, int32 &out);
+	bool isReady() const { return _state == kEnvReady; }
 
 	void feedbackLevel(int32 level);
 	void detune(int value);
@@ -182,7 +183,7 @@ void TownsPC98_FmSynthOperator::recalculateRates() {
 	fs_r.shift = _rshiftTbl[r + k];
 }
 
-void TownsPC98_FmSynthOperator::generateOutput(int32 phasebuf, int32 *feed, int32 &out) {
+inline void TownsPC98_FmSynthOperator::generateOutput(int32 phasebuf, int32 *feed, int32 &out) {
 	if (_state == kEnvReady)
 		return;
 
@@ -1588,90 +1589,137 @@ void TownsPC98_FmSynth::nextTick(int32 *buffer, uint32 bufferSize) {
 				o[ii]->updatePhaseIncrement();
 		}
 
-		for (uint32 ii = 0; ii < bufferSize ; ii++) {
-			int32 phbuf1, phbuf2, output;
-			phbuf1 = phbuf2 = output = 0;
-
-			int32 *leftSample = &buffer[ii * 2];
-			int32 *rightSample = &buffer[ii * 2 + 1];
-			int32 *del = &_chanInternal[i].feedbuf[2];
-			int32 *feed = _chanInternal[i].feedbuf;
-
-			switch (_chanInternal[i].algorithm) {
-			case 0:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(*del, nullptr, phbuf2);
-				*del = 0;
-				o[1]->generateOutput(phbuf1, nullptr, *del);
-				o[3]->generateOutput(phbuf2, nullptr, output);
-				break;
-			case 1:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(*del, nullptr, phbuf2);
-				o[1]->generateOutput(0, nullptr, phbuf1);
-				o[3]->generateOutput(phbuf2, nullptr, output);
-				*del = phbuf1;
-				break;
-			case 2:
-				o[0]->generateOutput(0, feed, phbuf2);
-				o[2]->generateOutput(*del, nullptr, phbuf2);
-				o[1]->generateOutput(0, nullptr, phbuf1);
-				o[3]->generateOutput(phbuf2, nullptr, output);
-				*del = phbuf1;
-				break;
-			case 3:
-				o[0]->generateOutput(0, feed, phbuf2);
-				o[2]->generateOutput(0, nullptr, *del);
-				o[1]->generateOutput(phbuf2, nullptr, phbuf1);
-				o[3]->generateOutput(*del, nullptr, output);
-				*del = phbuf1;
-				break;
-			case 4:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(0, nullptr, phbuf2);
-				o[1]->generateOutput(phbuf1, nullptr, output);
-				o[3]->generateOutput(phbuf2, nullptr, output);
-				*del = 0;
-				break;
-			case 5:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(*del, nullptr, output);
-				o[1]->generateOutput(phbuf1, nullptr, output);
-				o[3]->generateOutput(phbuf1, nullptr, output);
-				*del = phbuf1;
-				break;
-			case 6:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(0, nullptr, output);
-				o[1]->generateOutput(phbuf1, nullptr, output);
-				o[3]->generateOutput(0, nullptr, output);
-				*del = 0;
-				break;
-			case 7:
-				o[0]->generateOutput(0, feed, output);
-				o[2]->generateOutput(0, nullptr, output);
-				o[1]->generateOutput(0, nullptr, output);
-				o[3]->generateOutput(0, nullptr, output);
-				*del = 0;
-				break;
-			default:
-				break;
-			};
+		// Operators which are not playing don't change any state or produce
+		// output, so a channel without any playing operators only has to
+		// clear its delay buffer, like the first sample would.
+		if (o[0]->isReady() && o[1]->isReady() && o[2]->isReady() && o[3]->isReady()) {
+			_chanInternal[i].feedbuf[2] = 0;
+			continue;
+		}
 
-			int32 finOut = (output << 2) / ((_numChan + _numSSG - 3) / 3);
+		// Select the algorithm once per block, so that the operators can be
+		// inlined into the sample loop
+		switch (_chanInternal[i].algorithm) {
+		case 0:
+			nextTickChannel<0>(i, buffer, bufferSize);
+			break;
+		case 1:
+			nextTickChannel<1>(i, buffer, bufferSize);
+			break;
+		case 2:
+			nextTickChannel<2>(i, buffer, bufferSize);
+			break;
+		case 3:
+			nextTickChannel<3>(i, buffer, bufferSize);
+			break;
+		case 4:
+			nextTickChannel<4>(i, buffer, bufferSize);
+			break;
+		case 5:
+			nextTickChannel<5>(i, buffer, bufferSize);
+			break;
+		case 6:
+			nextTickChannel<6>(i, buffer, bufferSize);
+			break;
+		case 7:
+			nextTickChannel<7>(i, buffer, bufferSize);
+			break;
+		default:
+			break;
+		}
+	}
+}
 
-			if ((1 << i) & _volMaskA)
-				finOut = (finOut * _volumeA) / Audio::Mixer::kMaxMixerVolume;
+template<int algorithm>
+void TownsPC98_FmSynth::nextTickChannel(int chan, int32 *buffer, uint32 bufferSize) {
+	ChanInternal &c = _chanInternal[chan];
+	TownsPC98_FmSynthOperator *const *o = c.opr;
+	int32 *del = &c.feedbuf[2];
+	int32 *feed = c.feedbuf;
+
+	const int32 divisor = (_numChan + _numSSG - 3) / 3;
+	const bool applyVolumeA = (1 << chan) & _volMaskA;
+	const bool applyVolumeB = (1 << chan) & _volMaskB;
+	int32 *leftSample = c.enableLeft ? &buffer[0] : nullptr;
+	int32 *rightSample = c.enableRight ? &buffer[1] : nullptr;
+
+	for (uint32 ii = 0; ii < bufferSize ; ii++) {
+		int32 phbuf1, phbuf2, output;
+		phbuf1 = phbuf2 = output = 0;
+
+		switch (algorithm) {
+		case 0:
+			o[0]->generateOutput(0, feed, phbuf1);
+			o[2]->generateOutput(*del, nullptr, phbuf2);
+			*del = 0;
+			o[1]->generateOutput(phbuf1, nullptr, *del);
+			o[3]->generateOutput(phbuf2, nullptr, output);
+			break;
+		case 1:
+			o[0]->generateOutput(0, feed, phbuf1);
+			o[2]->generateOutput(*del, nullptr, phbuf2);
+			o[1]->generateOutput(0, nullptr, phbuf1);
+			o[3]->generateOutput(phbuf2, nullptr, output);
+			*del = phbuf1;
+			break;
+		case 2:
+			o[0]->generateOutput(0, feed, phbuf2);
+			o[2]->generateOutput(*del, nullptr, phbuf2);
+			o[1]->generateOutput(0, nullptr, phbuf1);
+			o[3]->generateOutput(phbuf2, nullptr, output);
+			*del = phbuf1;
+			break;
+		case 3:
+			o[0]->generateOutput(0, feed, phbuf2);
+			o[2]->generateOutput(0, nullptr, *del);
+			o[1]->generateOutput(phbuf2, nullptr, phbuf1);
+			o[3]->generateOutput(*del, nullptr, output);
+			*del = phbuf1;
+			break;
+		case 4:
+			o[0]->generateOutput(0, feed, phbuf1);
+			o[2]->generateOutput(0, nullptr, phbuf2);
+			o[1]->generateOutput(phbuf1, nullptr, output);
+			o[3]->generateOutput(phbuf2, nullptr, output);
+			*del = 0;
+			break;
+		case 5:
+			o[0]->generateOutput(0, feed, phbuf1);
+			o[2]->generateOutput(*del, nullptr, output);
+			o[1]->generateOutput(phbuf1, nullptr, output);
+			o[3]->generateOutput(phbuf1, nullptr, output);
+			*del = phbuf1;
+			break;
+		case 6:
+			o[0]->generateOutput(0, feed, phbuf1);
+			o[2]->generateOutput(0, nullptr, output);
+			o[1]->generateOutput(phbuf1, nullptr, output);
+			o[3]->generateOutput(0, nullptr, output);
+			*del = 0;
+			break;
+		case 7:
+		default:
+			o[0]->generateOutput(0, feed, output);
+			o[2]->generateOutput(0, nullptr, output);
+			o[1]->generateOutput(0, nullptr, output);
+			o[3]->generateOutput(0, nullptr, output);
+			*del = 0;
+			break;
+		};
+
+		int32 finOut = (output << 2) / divisor;
+
+		if (applyVolumeA)
+			finOut = (finOut * _volumeA) / Audio::Mixer::kMaxMixerVolume;
 
-			if ((1 << i) & _volMaskB)
-				finOut = (finOut * _volumeB) / Audio::Mixer::kMaxMixerVolume;
+		if (applyVolumeB)
+			finOut = (finOut * _volumeB) / Audio::Mixer::kMaxMixerVolume;
 
-			if (_chanInternal[i].enableLeft)
-				*leftSample += finOut;
+		if (leftSample)
+			leftSample[ii * 2] += finOut;
 
-			if (_chanInternal[i].enableRight)
-				*rightSample += finOut;
-		}
+		if (rightSample)
+			rightSample[ii * 2] += finOut;
 	}
 }
 
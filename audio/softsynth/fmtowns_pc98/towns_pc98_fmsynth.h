@@ -118,6 +118,8 @@ protected:
 private:
 	void generateTables();
 	void writeRegInternal(uint8 part, uint8 regAddress, uint8 value);
+	template<int algorithm>
+	void nextTickChannel(int chan, int32 *buffer, uint32 bufferSize);
 	void nextTick(int32 *buffer, uint32 bufferSize);
 
 #ifdef ENABLE_SNDTOWNS98_WAITCYCLES
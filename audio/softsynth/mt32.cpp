@@ -101,6 +101,42 @@ public:
 	virtual ~ScummVMReportHandler() {}
 };
 
+// MUNT tells the ROMs apart by their SHA1 digest, which takes a while to
+// compute on slow devices. The digests are remembered for the rest of the
+// session, keyed by the name and size of the ROM file, so that launching
+// another game doesn't need to compute them again.
+struct ROMDigest {
+	char name[32];
+	uint32 size;
+	mt32emu_sha1_digest digest;
+};
+
+static ROMDigest romDigests[4];
+static uint nextROMDigest = 0;
+
+static const mt32emu_sha1_digest *getROMDigest(Service &service, const Common::File &file, const byte *data) {
+	const char *name = file.getName();
+	const uint32 size = file.size();
+	for (uint i = 0; i < ARRAYSIZE(romDigests); i++) {
+		if (romDigests[i].size == size && !strcmp(romDigests[i].name, name))
+			return &romDigests[i].digest;
+	}
+
+	mt32emu_rom_info romInfo;
+	if (service.identifyROMData(&romInfo, data, size, nullptr) != MT32EMU_RC_OK)
+		return nullptr;
+	const char *digest = romInfo.control_rom_sha1_digest != nullptr ? romInfo.control_rom_sha1_digest : romInfo.pcm_rom_sha1_digest;
+	if (digest == nullptr || strlen(name) >= sizeof(romDigests[0].name))
+		return nullptr;
+
+	ROMDigest &entry = romDigests[nextROMDigest];
+	nextROMDigest = (nextROMDigest + 1) % ARRAYSIZE(romDigests);
+	Common::strlcpy(entry.name, name, sizeof(entry.name));
+	entry.size = size;
+	Common::strlcpy(entry.digest, digest, sizeof(entry.digest));
+	return &entry.digest;
+}
+
 }	// end of namespace MT32Emu
 
 class MidiChannel_MT32 : public MidiChannel_MPU401 {
@@ -183,13 +219,13 @@ int MidiDriver_MT32::open() {
 
 	_service.createContext(_reportHandler);
 
-	if (_service.addROMData(_controlData, controlFile.size()) != MT32EMU_RC_ADDED_CONTROL_ROM) {
+	if (_service.addROMData(_controlData, controlFile.size(), MT32Emu::getROMDigest(_service, controlFile, _controlData)) != MT32EMU_RC_ADDED_CONTROL_ROM) {
 		error("Adding control ROM failed. Check that your control ROM is valid");
 	}
 
 	controlFile.close();
 
-	if (_service.addROMData(_pcmData, pcmFile.size()) != MT32EMU_RC_ADDED_PCM_ROM) {
+	if (_service.addROMData(_pcmData, pcmFile.size(), MT32Emu::getROMDigest(_service, pcmFile, _pcmData)) != MT32EMU_RC_ADDED_PCM_ROM) {
 		error("Adding PCM ROM failed. Check that your PCM ROM is valid");
 	}
 
@@ -224,7 +260,11 @@ void MidiDriver_MT32::send(uint32 b) {
 	midiDriverCommonSend(b);
 
 	Common::StackLock lock(_mutex);
-	_service.playMsg(b);
+	const uint32 delay = getEventSampleDelay();
+	if (delay)
+		_service.playMsgAt(b, _service.getInternalRenderedSampleCount() + _service.convertOutputToSynthTimestamp(delay));
+	else
+		_service.playMsg(b);
 }
 
 // Indiana Jones and the Fate of Atlantis (including the demo) uses
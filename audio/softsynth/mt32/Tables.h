@@ -25,7 +25,7 @@ namespace MT32Emu {
 
 class Tables {
 private:
-	Tables();
+	Tables() {}
 	Tables(Tables &);
 	~Tables() {}
 
@@ -40,21 +40,21 @@ public:
 	// - PartialParam.tva.level
 	// - expression
 	// It's used to determine how much to subtract from the amp envelope's target value
-	Bit8u levelToAmpSubtraction[101];
+	static const Bit8u levelToAmpSubtraction[101];
 
 	// CONFIRMED: ...
-	Bit8u envLogarithmicTime[256];
+	static const Bit8u envLogarithmicTime[256];
 
 	// CONFIRMED: ...
-	Bit8u masterVolToAmpSubtraction[101];
+	static const Bit8u masterVolToAmpSubtraction[101];
 
 	// CONFIRMED:
-	Bit8u pulseWidth100To255[101];
+	static const Bit8u pulseWidth100To255[101];
 
-	Bit16u exp9[512];
-	Bit16u logsin9[512];
+	static const Bit16u exp9[512];
+	static const Bit16u logsin9[512];
 
-	const Bit8u *resAmpDecayFactor;
+	static const Bit8u resAmpDecayFactor[8];
 }; // class Tables
 
 } // namespace MT32Emu
@@ -429,16 +429,21 @@ Bits Operator::TemplateVolume(  ) {
 	return vol;
 }
 
-static const VolumeHandler VolumeHandlerTable[5] = {
-	&Operator::TemplateVolume< Operator::OFF >,
-	&Operator::TemplateVolume< Operator::RELEASE >,
-	&Operator::TemplateVolume< Operator::SUSTAIN >,
-	&Operator::TemplateVolume< Operator::DECAY >,
-	&Operator::TemplateVolume< Operator::ATTACK >
-};
-
 INLINE Bitu Operator::ForwardVolume() {
-	return currentLevel + (this->*volHandler)();
+	//Switch on the state instead of calling a handler through a pointer,
+	//so that the envelope code gets inlined into the sample loops
+	switch ( state ) {
+	case OFF:
+		return currentLevel + TemplateVolume< OFF >();
+	case RELEASE:
+		return currentLevel + TemplateVolume< RELEASE >();
+	case SUSTAIN:
+		return currentLevel + TemplateVolume< SUSTAIN >();
+	case DECAY:
+		return currentLevel + TemplateVolume< DECAY >();
+	default:
+		return currentLevel + TemplateVolume< ATTACK >();
+	}
 }
 
 
@@ -521,7 +526,6 @@ void Operator::WriteE0( const Chip* chip, Bit8u val ) {
 
 INLINE void Operator::SetState( Bit8u s ) {
 	state = s;
-	volHandler = VolumeHandlerTable[ s ];
 }
 
 INLINE bool Operator::Silent() const {
@@ -29,6 +29,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "audio/mixer.h"
+#include "common/config-manager.h"
 #include "common/system.h"
 #include "common/scummsys.h"
 #include "nuked.h"
@@ -1399,11 +1400,15 @@ void OPL3_GenerateStream(opl3_chip *chip, Bit16s *sndptr, Bit32u numsamples)
     }
 }
 
-OPL::OPL(Config::OplType type) : _type(type), _rate(0) {
+OPL::OPL(Config::OplType type) : _type(type), _rate(0), _ahead(nullptr), _aheadSize(0),
+		_aheadReadPos(0), _aheadWritePos(0), _jobSystem(g_system->getJobSystem()), _renderPending(false) {
 }
 
 OPL::~OPL() {
 	stop();
+	if (_renderPending)
+		_jobSystem->waitWithoutHelping(_renderGroup);
+	delete[] _ahead;
 }
 
 bool OPL::init() {
@@ -1414,19 +1419,106 @@ bool OPL::init() {
 		OPL3_WriteReg(&chip, 0x105, 0x01);
 	}
 
+	ConfMan.registerDefault("opl_render_ahead_ms", 0);
+	const uint latency = (uint)CLIP(ConfMan.getInt("opl_render_ahead_ms"), 0, 1000) * _rate / 1000;
+	if (!_ahead && latency > 0 && _jobSystem->getWorkerCount() > 0) {
+		// Room for the latency and the samples of one request, in stereo
+		_aheadSize = 1024;
+		while (_aheadSize < (latency + kMaxGenerateFrames) * 2)
+			_aheadSize <<= 1;
+		_ahead = new int16[_aheadSize];
+		memset(_ahead, 0, _aheadSize * sizeof(int16));
+		_aheadReadPos = 0;
+		_aheadWritePos.store(latency * 2, std::memory_order_release);
+	}
+
 	return true;
 }
 
 void OPL::reset() {
+	Common::StackLock lock(_commandsMutex);
+
+	if (_ahead) {
+		// Render what was requested so far, so that no samples go missing
+		finishRender();
+		render();
+	}
+
 	OPL3_Reset(&chip, _rate);
 }
 
+void OPL::renderProc(void *refCon) {
+	((OPL *)refCon)->render();
+}
+
+void OPL::render() {
+	Command command;
+	while (_commands.pop(command)) {
+		if (command.reg != kGenerate) {
+			OPL3_WriteRegBuffered(&chip, command.reg, (Bit8u)command.value);
+			continue;
+		}
+
+		uint32 writePos = _aheadWritePos.load(std::memory_order_relaxed);
+		uint32 frames = command.value;
+		while (frames > 0) {
+			// The size and the positions are even, so frames are never split
+			const uint32 offset = writePos & (_aheadSize - 1);
+			const uint32 len = MIN<uint32>(frames, (_aheadSize - offset) / 2);
+			OPL3_GenerateStream(&chip, _ahead + offset, len);
+			writePos += len * 2;
+			frames -= len;
+		}
+		_aheadWritePos.store(writePos, std::memory_order_release);
+	}
+}
+
+void OPL::requestRender() {
+	if (_renderPending) {
+		if (!_jobSystem->isDone(_renderGroup))
+			return;
+		_renderPending = false;
+	}
+
+	_renderPending = true;
+	_jobSystem->submit(_renderGroup, renderProc, this);
+}
+
+void OPL::finishRender() {
+	while (_renderPending && !_jobSystem->isDone(_renderGroup)) {
+		// Let the other threads queue commands in the meantime. This may be
+		// the mixer thread, so it must not pick up unrelated jobs either.
+		_commandsMutex.unlock();
+		_jobSystem->waitWithoutHelping(_renderGroup);
+		_commandsMutex.lock();
+	}
+	_renderPending = false;
+}
+
+void OPL::queueCommand(uint16 reg, uint16 value) {
+	Command command = { reg, value };
+	while (!_commands.push(command)) {
+		// The render job is not keeping up, help it out
+		finishRender();
+		render();
+	}
+}
+
+void OPL::writeRegBuffered(uint16 reg, uint8 val) {
+	if (_ahead) {
+		Common::StackLock lock(_commandsMutex);
+		queueCommand(reg, val);
+	} else {
+		OPL3_WriteRegBuffered(&chip, reg, val);
+	}
+}
+
 void OPL::write(int port, int val) {
 	if (port & 1) {
 		switch (_type) {
 		case Config::kOpl2:
 		case Config::kOpl3:
-			OPL3_WriteRegBuffered(&chip, (Bit16u)address[0], (Bit8u)val);
+			writeRegBuffered((Bit16u)address[0], (Bit8u)val);
 			break;
 		case Config::kDualOpl2:
 			// Not a 0x??8 port, then write to a specific port
@@ -1470,7 +1562,7 @@ void OPL::write(int port, int val) {
 
 
 void OPL::writeReg(int r, int v) {
-	OPL3_WriteRegBuffered(&chip, (Bit16u)r, (Bit8u)v);
+	writeRegBuffered((Bit16u)r, (Bit8u)v);
 }
 
 void OPL::dualWrite(uint8 index, uint8 reg, uint8 val) {
@@ -1490,7 +1582,7 @@ void OPL::dualWrite(uint8 index, uint8 reg, uint8 val) {
 	}
 
 	uint32 fullReg = reg + (index ? 0x100 : 0);
-	OPL3_WriteRegBuffered(&chip, (Bit16u)fullReg, (Bit8u)val);
+	writeRegBuffered((Bit16u)fullReg, (Bit8u)val);
 }
 
 byte OPL::read(int port) {
@@ -1498,7 +1590,36 @@ byte OPL::read(int port) {
 }
 
 void OPL::generateSamples(int16*buffer, int length) {
-	OPL3_GenerateStream(&chip, (Bit16s*)buffer, (Bit16u)length / 2);
+	if (!_ahead) {
+		OPL3_GenerateStream(&chip, (Bit16s*)buffer, (Bit16u)length / 2);
+		return;
+	}
+
+	while (length > 0) {
+		const uint32 frames = MIN<uint32>(length / 2, kMaxGenerateFrames);
+		{
+			Common::StackLock lock(_commandsMutex);
+			queueCommand(kGenerate, frames);
+			requestRender();
+		}
+
+		// Play samples that were requested earlier. These are ready, unless
+		// the latency is shorter than the buffers of the mixer, in which
+		// case the missing ones are rendered here.
+		const uint32 readPos = _aheadReadPos;
+		if (_aheadWritePos.load(std::memory_order_acquire) - readPos < frames * 2) {
+			Common::StackLock lock(_commandsMutex);
+			finishRender();
+			render();
+		}
+
+		for (uint32 i = 0; i < frames * 2; i++)
+			buffer[i] = _ahead[(readPos + i) & (_aheadSize - 1)];
+		_aheadReadPos = readPos + frames * 2;
+
+		buffer += frames * 2;
+		length -= frames * 2;
+	}
 }
 
 }
@@ -30,8 +30,13 @@
 #define AUDIO_SOFTSYNTH_OPL_NUKED_H
 
 #include "common/scummsys.h"
+#include "common/jobsystem.h"
+#include "common/mutex.h"
+#include "common/spsc-queue.h"
 #include "audio/fmopl.h"
 
+#include <atomic>
+
 #ifndef DISABLE_NUKED_OPL
 
 #define OPL_WRITEBUF_SIZE   1024
@@ -162,6 +167,55 @@ private:
 	uint address[2];
 	void dualWrite(uint8 index, uint8 reg, uint8 val);
 
+	/**
+	 * When rendering ahead, the register writes and the requests for samples
+	 * are queued in the order they are made, which keeps the writes at the
+	 * right sample positions. A job then renders the samples into a ring
+	 * buffer. The ring starts with the configured latency worth of silence,
+	 * so the mixer plays samples that were rendered while it was busy
+	 * with earlier buffers.
+	 */
+	struct Command {
+		uint16 reg;   ///< Register to write, or kGenerate
+		uint16 value; ///< Value to write, or number of frames to render
+	};
+
+	enum {
+		kGenerate = 0xffff,
+		kMaxGenerateFrames = 1024
+	};
+
+	Common::SPSCQueue<Command, 4096> _commands;
+	Common::Mutex _commandsMutex; ///< Serializes the threads writing registers and requesting samples
+
+	int16 *_ahead;  ///< The ring buffer of rendered samples, or nullptr when not rendering ahead
+	uint32 _aheadSize;
+	uint32 _aheadReadPos;                 ///< Only used by the mixer thread
+	std::atomic<uint32> _aheadWritePos;   ///< Advanced by the render job
+
+	Common::JobSystem *_jobSystem;
+	Common::JobGroup _renderGroup;
+	bool _renderPending;
+
+	static void renderProc(void *refCon);
+
+	/** Process the queued commands. Only called from the render job, or after finishRender(). */
+	void render();
+
+	/** Start a render job, unless one is already running. Must be called with _commandsMutex locked. */
+	void requestRender();
+
+	/**
+	 * Wait for the render job to finish, if there is one. Must be called with
+	 * _commandsMutex locked, which is released while waiting.
+	 */
+	void finishRender();
+
+	/** Queue a command, making room when the queue is full. Must be called with _commandsMutex locked. */
+	void queueCommand(uint16 reg, uint16 value);
+
+	void writeRegBuffered(uint16 reg, uint8 val);
+
 public:
 	OPL(Config::OplType type);
 	~OPL();
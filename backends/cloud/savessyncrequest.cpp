@@ -35,9 +35,47 @@
 
 namespace Cloud {
 
+class SavesSyncRequest::Transfer {
+	SavesSyncRequest *_parent;
+
+public:
+	StorageFile file; //the file being downloaded, if any
+	Common::String name;
+	Request *request;
+
+	Transfer(SavesSyncRequest *parent, const StorageFile &f, const Common::String &n):
+		_parent(parent), file(f), name(n), request(nullptr) {}
+
+	bool isDownload() const { return file.name() != ""; }
+
+	// These might delete the transfer, so they must be the last thing done here
+
+	void downloadedCallback(const Storage::BoolResponse &response) {
+		request = nullptr;
+		if (!_parent->_ignoreCallback)
+			_parent->fileDownloaded(this, response.value);
+	}
+
+	void uploadedCallback(const Storage::UploadResponse &response) {
+		request = nullptr;
+		if (!_parent->_ignoreCallback)
+			_parent->fileUploaded(this, response.value.timestamp());
+	}
+
+	void errorCallback(const Networking::ErrorResponse &error) {
+		request = nullptr;
+		if (!_parent->_ignoreCallback)
+			_parent->transferFailed(this, error);
+	}
+};
+
 SavesSyncRequest::SavesSyncRequest(Storage *storage, Storage::BoolCallback callback, Networking::ErrorCallback ecb):
-	Request(nullptr, ecb), _storage(storage), _boolCallback(callback),
+	Request(nullptr, ecb), _storage(storage), _boolCallback(callback), _maxTransfers(DEFAULT_TRANSFERS),
 	_workingRequest(nullptr), _ignoreCallback(false), _bytesToDownload(0), _bytesDownloaded(0) {
+	// Each transfer is a connection of its own, so slow networks might
+	// want less of them
+	if (ConfMan.hasKey("sync_transfers", ConfMan.kCloudDomain))
+		_maxTransfers = MAX(ConfMan.getInt("sync_transfers", ConfMan.kCloudDomain), 1);
 	start();
 }
 
@@ -45,6 +83,7 @@ SavesSyncRequest::~SavesSyncRequest() {
 	_ignoreCallback = true;
 	if (_workingRequest)
 		_workingRequest->finish();
+	stopTransfers();
 	delete _boolCallback;
 }
 
@@ -53,8 +92,7 @@ void SavesSyncRequest::start() {
 	_ignoreCallback = true;
 	if (_workingRequest)
 		_workingRequest->finish();
-	_currentDownloadingFile = StorageFile();
-	_currentUploadingFile = "";
+	stopTransfers();
 	_filesToDownload.clear();
 	_filesToUpload.clear();
 	_localFilesTimestamps.clear();
@@ -162,12 +200,8 @@ void SavesSyncRequest::directoryListedCallback(const Storage::ListDirectoryRespo
 	}
 	_totalFilesToHandle = _filesToDownload.size() + _filesToUpload.size();
 
-	//start downloading files
-	if (!_filesToDownload.empty()) {
-		downloadNextFile();
-	} else {
-		uploadNextFile();
-	}
+	//start transferring files, downloads first
+	startTransfers();
 }
 
 void SavesSyncRequest::directoryListedErrorCallback(const Networking::ErrorResponse &error) {
@@ -271,106 +305,130 @@ void SavesSyncRequest::directoryCreatedErrorCallback(const Networking::ErrorResp
 	finishError(error);
 }
 
-void SavesSyncRequest::downloadNextFile() {
-	if (_filesToDownload.empty()) {
-		_currentDownloadingFile = StorageFile("", 0, 0, false); //so getFilesToDownload() would return an empty array
-		uploadNextFile();
-		return;
+void SavesSyncRequest::startTransfers() {
+	while (_state == Networking::PROCESSING && _transfers.size() < _maxTransfers) {
+		if (!_filesToDownload.empty()) {
+			StorageFile file = _filesToDownload.back();
+			_filesToDownload.pop_back();
+			if (!startDownload(file))
+				return;
+		} else if (!_filesToUpload.empty()) {
+			Common::String name = _filesToUpload.back();
+			_filesToUpload.pop_back();
+			if (!startUpload(name))
+				return;
+		} else {
+			break;
+		}
 	}
 
-	_currentDownloadingFile = _filesToDownload.back();
-	_filesToDownload.pop_back();
+	if (_state == Networking::PROCESSING && _transfers.empty())
+		finishSync(true);
+}
+
+bool SavesSyncRequest::startDownload(const StorageFile &file) {
+	Transfer *transfer = new Transfer(this, file, file.name());
+	_transfers.push_back(transfer);
 
-	debug(9, "\nSavesSyncRequest: downloading %s (%d %%)", _currentDownloadingFile.name().c_str(), (int)(getProgress() * 100));
-	_workingRequest = _storage->downloadById(
-		_currentDownloadingFile.id(),
-		DefaultSaveFileManager::concatWithSavesPath(_currentDownloadingFile.name()),
-		new Common::Callback<SavesSyncRequest, const Storage::BoolResponse &>(this, &SavesSyncRequest::fileDownloadedCallback),
-		new Common::Callback<SavesSyncRequest, const Networking::ErrorResponse &>(this, &SavesSyncRequest::fileDownloadedErrorCallback)
+	debug(9, "\nSavesSyncRequest: downloading %s (%d %%)", file.name().c_str(), (int)(getProgress() * 100));
+	transfer->request = _storage->downloadById(
+		file.id(),
+		DefaultSaveFileManager::concatWithSavesPath(file.name()),
+		new Common::Callback<Transfer, const Storage::BoolResponse &>(transfer, &Transfer::downloadedCallback),
+		new Common::Callback<Transfer, const Networking::ErrorResponse &>(transfer, &Transfer::errorCallback)
 	);
-	if (!_workingRequest)
-		finishError(Networking::ErrorResponse(this, "SavesSyncRequest::downloadNextFile: Storage couldn't create Request to download a file"));
+	if (!transfer->request) {
+		finishError(Networking::ErrorResponse(this, "SavesSyncRequest::startDownload: Storage couldn't create Request to download a file"));
+		return false;
+	}
+	return true;
 }
 
-void SavesSyncRequest::fileDownloadedCallback(const Storage::BoolResponse &response) {
-	_workingRequest = nullptr;
-	if (_ignoreCallback)
-		return;
+bool SavesSyncRequest::startUpload(const Common::String &name) {
+	Transfer *transfer = new Transfer(this, StorageFile(), name);
+	_transfers.push_back(transfer);
+
+	debug(9, "\nSavesSyncRequest: uploading %s (%d %%)", name.c_str(), (int)(getProgress() * 100));
+	if (_storage->uploadStreamSupported()) {
+		transfer->request = _storage->upload(
+			_storage->savesDirectoryPath() + name,
+			g_system->getSavefileManager()->openRawFile(name),
+			new Common::Callback<Transfer, const Storage::UploadResponse &>(transfer, &Transfer::uploadedCallback),
+			new Common::Callback<Transfer, const Networking::ErrorResponse &>(transfer, &Transfer::errorCallback)
+		);
+	} else {
+		transfer->request = _storage->upload(
+			_storage->savesDirectoryPath() + name,
+			DefaultSaveFileManager::concatWithSavesPath(name),
+			new Common::Callback<Transfer, const Storage::UploadResponse &>(transfer, &Transfer::uploadedCallback),
+			new Common::Callback<Transfer, const Networking::ErrorResponse &>(transfer, &Transfer::errorCallback)
+		);
+	}
+	if (!transfer->request) {
+		finishError(Networking::ErrorResponse(this, "SavesSyncRequest::startUpload: Storage couldn't create Request to upload a file"));
+		return false;
+	}
+	return true;
+}
 
+void SavesSyncRequest::fileDownloaded(Transfer *transfer, bool success) {
 	//stop syncing if download failed
-	if (!response.value) {
-		//delete the incomplete file
-		g_system->getSavefileManager()->removeSavefile(_currentDownloadingFile.name());
-		finishError(Networking::ErrorResponse(this, false, true, "SavesSyncRequest::fileDownloadedCallback: failed to download a file", -1));
+	if (!success) {
+		finishError(Networking::ErrorResponse(this, false, true, "SavesSyncRequest::fileDownloaded: failed to download a file", -1));
 		return;
 	}
 
 	//update local timestamp for downloaded file
-	_localFilesTimestamps[_currentDownloadingFile.name()] = _currentDownloadingFile.timestamp();
+	_localFilesTimestamps[transfer->name] = transfer->file.timestamp();
 	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
-	_bytesDownloaded += _currentDownloadingFile.size();
+	_bytesDownloaded += transfer->file.size();
 
-	//continue downloading files
-	downloadNextFile();
+	//continue transferring files
+	removeTransfer(transfer);
+	startTransfers();
 }
 
-void SavesSyncRequest::fileDownloadedErrorCallback(const Networking::ErrorResponse &error) {
-	_workingRequest = nullptr;
-	if (_ignoreCallback)
-		return;
+void SavesSyncRequest::fileUploaded(Transfer *transfer, uint32 timestamp) {
+	//update local timestamp for the uploaded file
+	_localFilesTimestamps[transfer->name] = timestamp;
+	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
 
-	//stop syncing if download failed
-	finishError(error);
+	//continue transferring files
+	removeTransfer(transfer);
+	startTransfers();
 }
 
-void SavesSyncRequest::uploadNextFile() {
-	if (_filesToUpload.empty()) {
-		finishSync(true);
-		return;
-	}
-
-	_currentUploadingFile = _filesToUpload.back();
-	_filesToUpload.pop_back();
+void SavesSyncRequest::transferFailed(Transfer *transfer, const Networking::ErrorResponse &error) {
+	//stop syncing if a transfer failed
+	finishError(error);
+}
 
-	debug(9, "\nSavesSyncRequest: uploading %s (%d %%)", _currentUploadingFile.c_str(), (int)(getProgress() * 100));
-	if (_storage->uploadStreamSupported()) {
-		_workingRequest = _storage->upload(
-			_storage->savesDirectoryPath() + _currentUploadingFile,
-			g_system->getSavefileManager()->openRawFile(_currentUploadingFile),
-			new Common::Callback<SavesSyncRequest, const Storage::UploadResponse &>(this, &SavesSyncRequest::fileUploadedCallback),
-			new Common::Callback<SavesSyncRequest, const Networking::ErrorResponse &>(this, &SavesSyncRequest::fileUploadedErrorCallback)
-		);
-	} else {
-		_workingRequest = _storage->upload(
-			_storage->savesDirectoryPath() + _currentUploadingFile,
-			DefaultSaveFileManager::concatWithSavesPath(_currentUploadingFile),
-			new Common::Callback<SavesSyncRequest, const Storage::UploadResponse &>(this, &SavesSyncRequest::fileUploadedCallback),
-			new Common::Callback<SavesSyncRequest, const Networking::ErrorResponse &>(this, &SavesSyncRequest::fileUploadedErrorCallback)
-		);
+void SavesSyncRequest::removeTransfer(Transfer *transfer) {
+	for (uint32 i = 0; i < _transfers.size(); ++i) {
+		if (_transfers[i] == transfer) {
+			_transfers.remove_at(i);
+			break;
+		}
 	}
-	if (!_workingRequest) finishError(Networking::ErrorResponse(this, "SavesSyncRequest::uploadNextFile: Storage couldn't create Request to upload a file"));
+	delete transfer;
 }
 
-void SavesSyncRequest::fileUploadedCallback(const Storage::UploadResponse &response) {
-	_workingRequest = nullptr;
-	if (_ignoreCallback)
-		return;
+void SavesSyncRequest::stopTransfers() {
+	//make the Requests close() the files being downloaded, so we can delete them
+	Common::Array<Transfer *> transfers = _transfers;
+	_transfers.clear();
 
-	//update local timestamp for the uploaded file
-	_localFilesTimestamps[_currentUploadingFile] = response.value.timestamp();
-	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
-
-	//continue uploading files
-	uploadNextFile();
-}
-
-void SavesSyncRequest::fileUploadedErrorCallback(const Networking::ErrorResponse &error) {
-	_workingRequest = nullptr;
-	if (_ignoreCallback)
-		return;
+	for (uint32 i = 0; i < transfers.size(); ++i) {
+		if (transfers[i]->request)
+			transfers[i]->request->finish();
+	}
 
-	//stop syncing if upload failed
-	finishError(error);
+	//delete the incomplete files
+	for (uint32 i = 0; i < transfers.size(); ++i) {
+		if (transfers[i]->isDownload())
+			g_system->getSavefileManager()->removeSavefile(transfers[i]->name);
+		delete transfers[i];
+	}
 }
 
 void SavesSyncRequest::handle() {}
@@ -393,7 +451,7 @@ double SavesSyncRequest::getDownloadingProgress() const {
 	}
 
 	uint32 totalFilesToDownload = _totalFilesToHandle - _filesToUpload.size();
-	uint32 filesLeftToDownload = _filesToDownload.size() + (_currentDownloadingFile.name() != "" ? 1 : 0);
+	uint32 filesLeftToDownload = _filesToDownload.size() + getRunningDownloads();
 	if (filesLeftToDownload > totalFilesToDownload)
 		filesLeftToDownload = totalFilesToDownload;
 	return (double)(totalFilesToDownload - filesLeftToDownload) / (double)(totalFilesToDownload);
@@ -404,7 +462,7 @@ void SavesSyncRequest::getDownloadingInfo(Storage::SyncDownloadingInfo &info) co
 	info.bytesToDownload = getBytesToDownload();
 
 	uint32 totalFilesToDownload = _totalFilesToHandle - _filesToUpload.size();
-	uint32 filesLeftToDownload = _filesToDownload.size() + (_currentDownloadingFile.name() != "" ? 1 : 0);
+	uint32 filesLeftToDownload = _filesToDownload.size() + getRunningDownloads();
 	if (filesLeftToDownload > totalFilesToDownload)
 		filesLeftToDownload = totalFilesToDownload;
 	info.filesDownloaded = totalFilesToDownload - filesLeftToDownload;
@@ -427,19 +485,38 @@ Common::Array<Common::String> SavesSyncRequest::getFilesToDownload() {
 	Common::Array<Common::String> result;
 	for (uint32 i = 0; i < _filesToDownload.size(); ++i)
 		result.push_back(_filesToDownload[i].name());
-	if (_currentDownloadingFile.name() != "")
-		result.push_back(_currentDownloadingFile.name());
+	for (uint32 i = 0; i < _transfers.size(); ++i) {
+		if (_transfers[i]->isDownload())
+			result.push_back(_transfers[i]->name);
+	}
 	return result;
 }
 
+uint32 SavesSyncRequest::getRunningDownloads() const {
+	uint32 count = 0;
+	for (uint32 i = 0; i < _transfers.size(); ++i) {
+		if (_transfers[i]->isDownload())
+			++count;
+	}
+	return count;
+}
+
 uint32 SavesSyncRequest::getDownloadedBytes() const {
-	double currentFileProgress = 0;
-	if (const DownloadRequest *downloadRequest = dynamic_cast<DownloadRequest *>(_workingRequest))
-		currentFileProgress = downloadRequest->getProgress();
-	else if (const Id::IdDownloadRequest *idDownloadRequest = dynamic_cast<Id::IdDownloadRequest *>(_workingRequest))
-		currentFileProgress = idDownloadRequest->getProgress();
+	double runningBytes = 0;
+	for (uint32 i = 0; i < _transfers.size(); ++i) {
+		const Transfer *transfer = _transfers[i];
+		if (!transfer->isDownload())
+			continue;
 
-	return _bytesDownloaded + currentFileProgress * _currentDownloadingFile.size();
+		double fileProgress = 0;
+		if (const DownloadRequest *downloadRequest = dynamic_cast<DownloadRequest *>(transfer->request))
+			fileProgress = downloadRequest->getProgress();
+		else if (const Id::IdDownloadRequest *idDownloadRequest = dynamic_cast<Id::IdDownloadRequest *>(transfer->request))
+			fileProgress = idDownloadRequest->getProgress();
+		runningBytes += fileProgress * transfer->file.size();
+	}
+
+	return _bytesDownloaded + runningBytes;
 }
 
 uint32 SavesSyncRequest::getBytesToDownload() const {
@@ -448,21 +525,15 @@ uint32 SavesSyncRequest::getBytesToDownload() const {
 
 void SavesSyncRequest::finishError(const Networking::ErrorResponse &error, Networking::RequestState state) {
 	debug(9, "SavesSync::finishError");
-	//if we were downloading a file - remember the name
-	//and make the Request close() it, so we can delete it
-	Common::String name = _currentDownloadingFile.name();
+	_ignoreCallback = true;
 	if (_workingRequest) {
-		_ignoreCallback = true;
 		_workingRequest->finish();
 		_workingRequest = nullptr;
-		_ignoreCallback = false;
 	}
 	//unlock all the files by making getFilesToDownload() return empty array
-	_currentDownloadingFile = StorageFile();
 	_filesToDownload.clear();
-	//delete the incomplete file
-	if (name != "")
-		g_system->getSavefileManager()->removeSavefile(name);
+	stopTransfers();
+	_ignoreCallback = false;
 	Request::finishError(error);
 }
 
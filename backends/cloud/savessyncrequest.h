@@ -30,13 +30,19 @@
 namespace Cloud {
 
 class SavesSyncRequest: public Networking::Request {
+	/** A file being downloaded or uploaded. */
+	class Transfer;
+
+	/** Number of transfers running at the same time, unless configured otherwise. */
+	static const int DEFAULT_TRANSFERS = 4;
+
 	Storage *_storage;
 	Storage::BoolCallback _boolCallback;
 	Common::HashMap<Common::String, uint32> _localFilesTimestamps;
 	Common::Array<StorageFile> _filesToDownload;
 	Common::Array<Common::String> _filesToUpload;
-	StorageFile _currentDownloadingFile;
-	Common::String _currentUploadingFile;
+	Common::Array<Transfer *> _transfers;
+	uint32 _maxTransfers;
 	Request *_workingRequest;
 	bool _ignoreCallback;
 	uint32 _totalFilesToHandle;
@@ -48,15 +54,20 @@ class SavesSyncRequest: public Networking::Request {
 	void directoryListedErrorCallback(const Networking::ErrorResponse &error);
 	void directoryCreatedCallback(const Storage::BoolResponse &response);
 	void directoryCreatedErrorCallback(const Networking::ErrorResponse &error);
-	void fileDownloadedCallback(const Storage::BoolResponse &response);
-	void fileDownloadedErrorCallback(const Networking::ErrorResponse &error);
-	void fileUploadedCallback(const Storage::UploadResponse &response);
-	void fileUploadedErrorCallback(const Networking::ErrorResponse &error);
-	void downloadNextFile();
-	void uploadNextFile();
+	void fileDownloaded(Transfer *transfer, bool success);
+	void fileUploaded(Transfer *transfer, uint32 timestamp);
+	void transferFailed(Transfer *transfer, const Networking::ErrorResponse &error);
+	void removeTransfer(Transfer *transfer);
+	void stopTransfers();
+	void startTransfers();
+	bool startDownload(const StorageFile &file);
+	bool startUpload(const Common::String &name);
 	void finishError(const Networking::ErrorResponse &error, Networking::RequestState state = Networking::FINISHED) override;
 	void finishSync(bool success);
 
+	/** Returns the number of files being downloaded right now. */
+	uint32 getRunningDownloads() const;
+
 	uint32 getDownloadedBytes() const;
 	uint32 getBytesToDownload() const;
 
@@ -46,6 +46,7 @@ public:
 	Common::String extra;
 	Common::String engineid;
 	Common::String guioptions;
+	Common::String md5; // checksum of the zip, if known
 	uint32 size = 0;
 	uint32 idx = 0;
 	State state = State::kAvailable;
@@ -31,9 +31,11 @@
 #include "common/punycode.h"
 #include "common/config-manager.h"
 #include "common/formats/json.h"
+#include "common/md5.h"
 
 #include "gui/gui-manager.h"
 
+#include "backends/networking/curl/networkreadstream.h"
 #include "backends/networking/curl/sessionrequest.h"
 #include "backends/dlc/scummvmcloud.h"
 #include "backends/dlc/dlcmanager.h"
@@ -68,6 +70,8 @@ void ScummVMCloud::jsonCallbackGetAllDLCs(Networking::JsonResponse response) {
 			dlc->extra = item.getVal("extra")->asString();
 			dlc->engineid = item.getVal("engineid")->asString();
 			dlc->guioptions = item.getVal("guioptions")->asString();
+			if (item.contains("md5"))
+				dlc->md5 = item.getVal("md5")->asString();
 			if (item.getVal("size")->isString()) {
 				dlc->size = item.getVal("size")->asString().asUint64();
 			} else {
@@ -95,76 +99,366 @@ void ScummVMCloud::getAllDLCs() {
 	request->execute();
 }
 
-void ScummVMCloud::downloadFileCallback(Networking::DataResponse r) {
+class ScummVMCloud::Chunk {
+	ScummVMCloud *_store;
+
+public:
+	Networking::SessionRequest *request;
+	Range range;
+	uint32 downloaded;
+	bool ranged, failed;
+
+	Chunk(ScummVMCloud *store, const Range &r, bool rangedRequest) :
+		_store(store), request(nullptr), range(r), downloaded(0), ranged(rangedRequest), failed(false) {}
+
+	// These might delete the chunk, so they must be the last thing done here
+
+	void dataCallback(const Networking::DataResponse &response) {
+		_store->chunkDataCallback(this, response);
+	}
+
+	void errorCallback(const Networking::ErrorResponse &error) {
+		if (!request) {
+			// the request failed to open its file while being created
+			failed = true;
+			return;
+		}
+		_store->chunkErrorCallback(this, error);
+	}
+};
+
+ScummVMCloud::~ScummVMCloud() {
+	stopChunks();
+}
+
+Common::String ScummVMCloud::getPartName(const Common::String &id, uint32 start) const {
+	return Common::String::format("%s.part.%u", id.c_str(), start);
+}
+
+void ScummVMCloud::startDownloadAsync(const Common::String &id, const Common::String &url) {
+	_rangesSupported = true;
+	_retries = 0;
+	prepareDownload();
+}
+
+void ScummVMCloud::prepareDownload() {
+	DLC::DLCDesc *dlc = DLCMan._queuedDownloadTasks.front();
+	_ranges.clear();
+
+	if (!_rangesSupported)
+		removeParts(dlc->id);
+
+	// The parts left by an interrupted download are named after the offset
+	// they start at, so whatever is missing in between can be found again
+	Common::Array<Range> parts;
+	Common::FSNode dir(Common::Path(ConfMan.get("dlcspath")));
+	Common::FSList files;
+	Common::String prefix = dlc->id + ".part.";
+	if (dir.getChildren(files, Common::FSNode::kListFilesOnly)) {
+		for (Common::FSList::const_iterator i = files.begin(); i != files.end(); ++i) {
+			Common::String name = i->getFileName();
+			if (!name.hasPrefix(prefix))
+				continue;
+			Common::SeekableReadStream *stream = i->createReadStream();
+			if (!stream)
+				continue;
+			uint32 start = Common::String(name.c_str() + prefix.size()).asUint64();
+			uint32 size = stream->size();
+			delete stream;
+			if (size == 0 || getPartName(dlc->id, start) != name)
+				continue;
+
+			uint j = 0;
+			while (j < parts.size() && parts[j].start < start)
+				++j;
+			parts.insert_at(j, Range(start, start + size));
+		}
+	}
+
+	uint32 position = 0, covered = 0;
+	for (uint i = 0; i < parts.size(); ++i) {
+		if (parts[i].start > position)
+			_ranges.push_back(Range(position, parts[i].start));
+		if (parts[i].end > position) {
+			covered += parts[i].end - MAX(position, parts[i].start);
+			position = parts[i].end;
+		}
+	}
+
+	if (dlc->size && position > dlc->size) {
+		// the parts don't belong to this version of the DLC
+		removeParts(dlc->id);
+		_ranges.clear();
+		position = covered = 0;
+	}
+	if (!dlc->size || position < dlc->size)
+		_ranges.push_back(Range(position, dlc->size));
+
+	DLCMan._currentDownloadedSize = covered;
+
+	// Split the missing ranges, so that the chunks could be downloaded in parallel
+	uint32 maxChunks = DEFAULT_CHUNKS;
+	if (ConfMan.hasKey("dlc_chunks"))
+		maxChunks = MAX(ConfMan.getInt("dlc_chunks"), 1);
+	if (dlc->size && _rangesSupported) {
+		uint32 chunkSize = MAX((dlc->size - covered) / maxChunks + 1, MIN_CHUNK_SIZE);
+		Common::Array<Range> ranges;
+		for (uint i = 0; i < _ranges.size(); ++i) {
+			for (uint32 start = _ranges[i].start; start < _ranges[i].end; start += chunkSize)
+				ranges.push_back(Range(start, MIN(start + chunkSize, _ranges[i].end)));
+		}
+		_ranges = ranges;
+	}
+
+	startChunks();
+}
+
+void ScummVMCloud::startChunks() {
+	uint32 maxChunks = DEFAULT_CHUNKS;
+	if (ConfMan.hasKey("dlc_chunks"))
+		maxChunks = MAX(ConfMan.getInt("dlc_chunks"), 1);
+	if (!_rangesSupported)
+		maxChunks = 1;
+
+	while (_chunks.size() < maxChunks && !_ranges.empty()) {
+		Range range = _ranges.front();
+		_ranges.remove_at(0);
+		if (!startChunk(range))
+			return;
+	}
+
+	if (_chunks.empty())
+		finishDownload();
+}
+
+bool ScummVMCloud::startChunk(const Range &range) {
+	DLC::DLCDesc *dlc = DLCMan._queuedDownloadTasks.front();
+	Common::Path localFile = Common::Path(ConfMan.get("dlcspath")).join(getPartName(dlc->id, range.start));
+
+	Chunk *chunk = new Chunk(this, range, range.start != 0 || (range.end && range.end != dlc->size));
+	_chunks.push_back(chunk);
+	Networking::SessionRequest *request = new Networking::SessionRequest(dlc->url, localFile,
+		new Common::Callback<Chunk, const Networking::DataResponse &>(chunk, &Chunk::dataCallback),
+		new Common::Callback<Chunk, const Networking::ErrorResponse &>(chunk, &Chunk::errorCallback));
+	chunk->request = request;
+
+	if (chunk->failed) {
+		failDownload("Unable to create the download cache file");
+		return false;
+	}
+
+	if (chunk->ranged) {
+		if (range.end)
+			request->addHeader(Common::String::format("Range: bytes=%u-%u", range.start, range.end - 1));
+		else
+			request->addHeader(Common::String::format("Range: bytes=%u-", range.start));
+	}
+	debug(1, "Downloading %s from %u", dlc->name.c_str(), range.start);
+	request->start();
+	return true;
+}
+
+void ScummVMCloud::chunkDataCallback(Chunk *chunk, const Networking::DataResponse &r) {
+	if (DLCMan._interruptCurrentDownload) {
+		cancelDownload();
+		return;
+	}
+
+	if (chunk->ranged && chunk->request->getNetworkReadStream()->httpResponseCode() == 200) {
+		// the server doesn't support ranges, so the whole file is sent
+		// to every chunk - start over with a single one
+		warning("ScummVMCloud: Server sent the whole file instead of a range, downloading it at once");
+		stopChunks();
+		_rangesSupported = false;
+		prepareDownload();
+		return;
+	}
+
 	Networking::SessionFileResponse *response = static_cast<Networking::SessionFileResponse *>(r.value);
+	chunk->downloaded += response->len;
 	DLCMan._currentDownloadedSize += response->len;
+
+	if (!response->eos)
+		return;
+
+	Range range = chunk->range;
+	uint32 downloaded = chunk->downloaded;
+	removeChunk(chunk);
+	if (range.end && downloaded < range.end - range.start) {
+		// the connection was closed early, continue where it stopped
+		if (++_retries > MAX_RETRIES) {
+			failDownload("Downloading failed, retry to resume the download");
+			return;
+		}
+		_ranges.insert_at(0, Range(range.start + downloaded, range.end));
+	}
+	startChunks();
+}
+
+void ScummVMCloud::chunkErrorCallback(Chunk *chunk, const Networking::ErrorResponse &error) {
+	warning("ScummVMCloud: Failed to download a chunk: %s", error.response.c_str());
+
+	// The part file keeps what was downloaded so far, and the rest of
+	// the range goes into a new part
+	Range range(chunk->range.start + chunk->downloaded, chunk->range.end);
+	removeChunk(chunk);
+
 	if (DLCMan._interruptCurrentDownload) {
-		_rq->close();
-		DLCMan._interruptCurrentDownload = false;
-		// delete the download cache (the incomplete .zip)
-		Common::Path relativeFilePath = Common::Path(DLCMan._queuedDownloadTasks.front()->id);
-		removeCacheFile(relativeFilePath);
+		cancelDownload();
+		return;
+	}
+
+	if (++_retries > MAX_RETRIES) {
+		failDownload("Downloading failed, retry to resume the download");
+		return;
+	}
+
+	_ranges.insert_at(0, range);
+	startChunks();
+}
+
+void ScummVMCloud::removeChunk(Chunk *chunk) {
+	for (uint i = 0; i < _chunks.size(); ++i) {
+		if (_chunks[i] == chunk) {
+			_chunks.remove_at(i);
+			break;
+		}
+	}
+	// the request is deleted by ConnMan once it's closed
+	chunk->request->close();
+	delete chunk;
+}
+
+void ScummVMCloud::stopChunks() {
+	while (!_chunks.empty())
+		removeChunk(_chunks.back());
+	_ranges.clear();
+}
 
-		DLCMan._queuedDownloadTasks.front()->state = DLCDesc::kCancelled;
-		DLCMan.refreshDLCList();
+void ScummVMCloud::removeParts(const Common::String &id) {
+	Common::FSNode dir(Common::Path(ConfMan.get("dlcspath")));
+	Common::FSList files;
+	if (!dir.getChildren(files, Common::FSNode::kListFilesOnly))
+		return;
 
-		// handle next download
-		DLCMan._queuedDownloadTasks.pop();
-		DLCMan._dlcsInProgress.remove_at(0);
-		DLCMan.processDownloadQueue();
+	Common::String prefix = id + ".part.";
+	for (Common::FSList::const_iterator i = files.begin(); i != files.end(); ++i) {
+		if (i->getFileName().hasPrefix(prefix))
+			removeCacheFile(Common::Path(i->getFileName()));
 	}
-	if (response->eos) {
-		DLC::DLCDesc *dlc = DLCMan._queuedDownloadTasks.front();
-		debug(1, "Downloaded: %s", dlc->name.c_str());
+}
+
+void ScummVMCloud::cancelDownload() {
+	DLC::DLCDesc *dlc = DLCMan._queuedDownloadTasks.front();
+	stopChunks();
+	DLCMan._interruptCurrentDownload = false;
 
-		_rq->close(); // delete request
+	// delete the download cache (the incomplete .zip)
+	removeParts(dlc->id);
+	removeCacheFile(Common::Path(dlc->id));
 
-		Common::Path relativeFilePath = Common::Path(dlc->id);
+	dlc->state = DLCDesc::kCancelled;
+	DLCMan.refreshDLCList();
+
+	nextDownload();
+}
+
+void ScummVMCloud::failDownload(const Common::String &message) {
+	// the parts are kept, so that downloading it again resumes
+	stopChunks();
+	DLC::DLCDesc *dlc = DLCMan._queuedDownloadTasks.front();
+	dlc->state = DLCDesc::kErrorDownloading;
+	DLCMan._errorText = message;
+	DLCMan.refreshDLCList();
 
+	nextDownload();
+}
+
+void ScummVMCloud::finishDownload() {
+	DLC::DLCDesc *dlc = DLCMan._queuedDownloadTasks.front();
+	debug(1, "Downloaded: %s", dlc->name.c_str());
+
+	Common::Path relativeFilePath = Common::Path(dlc->id);
+	Common::Error error = joinParts(dlc, relativeFilePath);
+
+	if (error.getCode() == Common::kNoError) {
 		// extract the downloaded zip
 		Common::String gameDir = Common::punycode_encodefilename(dlc->name);
 		Common::Path destPath = Common::Path(ConfMan.get("dlcspath")).appendComponent(gameDir);
-		Common::Error error = extractZip(relativeFilePath, destPath);
-
-		// remove cache (the downloaded .zip)
-		removeCacheFile(relativeFilePath);
+		error = extractZip(relativeFilePath, destPath);
 
 		if (error.getCode() == Common::kNoError) {
 			// add downloaded game entry in scummvm configuration file
 			addEntryToConfig(destPath);
-			dlc->state = DLCDesc::kDownloaded;
-			DLCMan._errorText = "";
-		} else {
-			// if there is any error in extraction
-			dlc->state = DLCDesc::kErrorDownloading;
-			DLCMan._errorText = error.getDesc();
 		}
+	}
 
-		DLCMan.refreshDLCList();
+	// remove cache (the downloaded .zip)
+	removeCacheFile(relativeFilePath);
 
-		// handle next download
-		DLCMan._queuedDownloadTasks.pop();
-		DLCMan._dlcsInProgress.remove_at(0);
-		DLCMan.processDownloadQueue();
+	if (error.getCode() == Common::kNoError) {
+		dlc->state = DLCDesc::kDownloaded;
+		DLCMan._errorText = "";
+	} else {
+		// if there is any error in extraction
+		dlc->state = DLCDesc::kErrorDownloading;
+		DLCMan._errorText = error.getDesc();
 	}
-}
 
-void ScummVMCloud::errorCallback(Networking::ErrorResponse error) {
-	// error downloading - start next download in queue
-	DLCMan._queuedDownloadTasks.front()->state = DLCDesc::kErrorDownloading;
-	DLCMan._queuedDownloadTasks.pop();
-	DLCMan._dlcsInProgress.remove_at(0);
-	DLCMan.processDownloadQueue();
+	DLCMan.refreshDLCList();
+
+	nextDownload();
 }
 
-void ScummVMCloud::startDownloadAsync(const Common::String &id, const Common::String &url) {
-	Common::String localFile = normalizePath(ConfMan.get("dlcspath") + "/" + id, '/');
+Common::Error ScummVMCloud::joinParts(DLC::DLCDesc *dlc, const Common::Path &file) {
+	Common::Path dlcPath = Common::Path(ConfMan.get("dlcspath"));
+	Common::DumpFile out;
+	if (!out.open(dlcPath.join(file))) {
+		removeParts(dlc->id);
+		return Common::Error(Common::kCreatingFileFailed, dlc->name + ": Unable to create the archive");
+	}
+
+	// The parts don't overlap, so they just follow each other
+	uint32 size = 0;
+	bool missing = false;
+	byte *buffer = new byte[CURL_SESSION_REQUEST_BUFFER_SIZE];
+	while (!missing) {
+		Common::FSNode node(dlcPath.join(getPartName(dlc->id, size)));
+		Common::SeekableReadStream *stream = node.exists() ? node.createReadStream() : nullptr;
+		if (!stream)
+			break;
+		uint32 partSize = 0;
+		while (uint32 bytes = stream->read(buffer, CURL_SESSION_REQUEST_BUFFER_SIZE)) {
+			out.write(buffer, bytes);
+			partSize += bytes;
+		}
+		missing = stream->err() || partSize == 0;
+		delete stream;
+		removeCacheFile(Common::Path(getPartName(dlc->id, size)));
+		size += partSize;
+	}
+	delete[] buffer;
+	out.finalize();
+	bool writeError = out.err();
+	out.close();
+	removeParts(dlc->id);
+
+	if (missing || writeError || (dlc->size && size != dlc->size))
+		return Common::Error(Common::kCreatingFileFailed, dlc->name + ": Archive is incomplete, please re-download");
+
+	if (!dlc->md5.empty()) {
+		Common::File zip;
+		if (!zip.open(Common::FSNode(dlcPath.join(file))) || !Common::computeStreamMD5AsString(zip).equalsIgnoreCase(dlc->md5))
+			return Common::Error(Common::kCreatingFileFailed, dlc->name + ": Archive is broken, please re-download");
+	}
 
-	_rq = new Networking::SessionRequest(url, localFile,
-		new Common::Callback<ScummVMCloud, Networking::DataResponse>(this, &ScummVMCloud::downloadFileCallback),
-		new Common::Callback<ScummVMCloud, Networking::ErrorResponse>(this, &ScummVMCloud::errorCallback));
+	return Common::kNoError;
+}
 
-	_rq->start();
+void ScummVMCloud::nextDownload() {
+	DLCMan._queuedDownloadTasks.pop();
+	DLCMan._dlcsInProgress.remove_at(0);
+	DLCMan.processDownloadQueue();
 }
 
 Common::Error ScummVMCloud::extractZip(const Common::Path &file, const Common::Path &destPath) {
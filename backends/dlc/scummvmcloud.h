@@ -22,6 +22,7 @@
 #ifndef BACKENDS_DLC_SCUMMVMCLOUD_H
 #define BACKENDS_DLC_SCUMMVMCLOUD_H
 
+#include "common/array.h"
 #include "common/queue.h"
 
 #include "backends/dlc/store.h"
@@ -37,11 +38,50 @@ namespace ScummVMCloud {
 
 class ScummVMCloud : public DLC::Store {
 
-	Networking::SessionRequest *_rq;
+	/** A range of the DLC being downloaded into a part file of its own. */
+	class Chunk;
+
+	/** A range of the DLC which is not downloaded yet. */
+	struct Range {
+		uint32 start, end; // end is 0 if the size of the DLC is unknown
+
+		Range(uint32 s = 0, uint32 e = 0) : start(s), end(e) {}
+	};
+
+	/** Number of chunks downloaded at the same time, unless configured otherwise. */
+	static const int DEFAULT_CHUNKS = 4;
+	/** Ranges are not split into chunks smaller than this. */
+	static const uint32 MIN_CHUNK_SIZE = 4 * 1024 * 1024;
+	/** Number of times the chunks of a DLC are retried before giving up. */
+	static const uint MAX_RETRIES = 5;
+
+	Common::Array<Chunk *> _chunks;
+	Common::Array<Range> _ranges;
+	bool _rangesSupported;
+	uint _retries;
+
+	Common::String getPartName(const Common::String &id, uint32 start) const;
+	void prepareDownload();
+	void startChunks();
+	bool startChunk(const Range &range);
+	void stopChunks();
+	void removeParts(const Common::String &id);
+	void removeChunk(Chunk *chunk);
+	void chunkDataCallback(Chunk *chunk, const Networking::DataResponse &response);
+	void chunkErrorCallback(Chunk *chunk, const Networking::ErrorResponse &error);
+	void cancelDownload();
+	void finishDownload();
+	void failDownload(const Common::String &message);
+
+	// joins the downloaded parts into the zip and checks its size and checksum
+	Common::Error joinParts(DLC::DLCDesc *dlc, const Common::Path &file);
+
+	// handles the next download in queue
+	void nextDownload();
 
 public:	
-	ScummVMCloud() {}
-	virtual ~ScummVMCloud() {}
+	ScummVMCloud() : _rangesSupported(true), _retries(0) {}
+	virtual ~ScummVMCloud();
 
 	virtual void getAllDLCs() override;
 
@@ -58,10 +98,6 @@ public:
 	void jsonCallbackGetAllDLCs(Networking::JsonResponse response);
 
 	void errorCallbackGetAllDLCs(Networking::ErrorResponse error);
-
-	void downloadFileCallback(Networking::DataResponse response);
-
-	void errorCallback(Networking::ErrorResponse error);
 };
 
 } // End of namespace ScummVMCloud
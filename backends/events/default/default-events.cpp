@@ -25,6 +25,7 @@
 
 #include "common/system.h"
 #include "common/config-manager.h"
+#include "common/profiler.h"
 #include "common/translation.h"
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/action.h"
@@ -80,6 +81,8 @@ void DefaultEventManager::init() {
 }
 
 bool DefaultEventManager::pollEvent(Common::Event &event) {
+	PROFILE_ZONE("Events");
+
 	_dispatcher.dispatch();
 
 	if (g_engine)
@@ -223,6 +226,11 @@ bool DefaultEventManager::pollEvent(Common::Event &event) {
 		}
 		break;
 
+	case Common::EVENT_PROFILER:
+		ProfMan.toggleOverlay();
+		forwardEvent = false;
+		break;
+
 	case Common::EVENT_DEBUGGER: {
 		GUI::Debugger *debugger = g_engine ? g_engine->getOrCreateDebugger() : nullptr;
 		if (debugger && !debugger->isActive()) {
@@ -382,6 +390,11 @@ Common::Keymap *DefaultEventManager::getGlobalKeymap() {
 	act->setEvent(EVENT_DEBUGGER);
 	globalKeymap->addAction(act);
 
+	act = new Action("PROFILER", _("Toggle frame profiler"));
+	act->addDefaultInputMapping("C+A+p");
+	act->setEvent(EVENT_PROFILER);
+	globalKeymap->addAction(act);
+
 	_virtualMouse->addActionsToKeymap(globalKeymap);
 
 	return globalKeymap;
@@ -172,6 +172,16 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Retrieves the size and the last modification time of the file
+	 * referred by this node, without opening it. The default
+	 * implementation, used by backends which cannot do this cheaply,
+	 * returns false.
+	 *
+	 * @return true if the file stats were retrieved, false otherwise
+	 */
+	virtual bool getFileStats(int64 &size, int64 &modificationTime) const { return false; }
+
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -192,6 +202,17 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStreamForAltStream(Common::AltStreamType altStreamType);
 
+	/**
+	 * Creates a SeekableReadStream instance reading the file referred by
+	 * this node directly from a read-only memory mapping, without copying
+	 * it. This assumes that the node actually refers to a readable file.
+	 * The default implementation, used by backends without memory mapped
+	 * files, returns 0.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::SeekableReadStream *createMappedReadStream();
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -207,6 +228,12 @@ public:
 	* @return true if the directory is created successfully
 	*/
 	virtual bool createDirectory() = 0;
+
+	/**
+	 * Drops any listing of this directory cached by the backend, so that
+	 * the next call to getChildren() reads it again.
+	 */
+	virtual void invalidateListing() const {}
 };
 
 
@@ -34,6 +34,10 @@
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/posix/posix-iostream.h"
 #include "common/algorithm.h"
+#include "common/hash-str.h"
+#include "common/memstream.h"
+#include "common/mutex.h"
+#include "common/system.h"
 
 #include <sys/param.h>
 #include <sys/stat.h>
@@ -49,6 +53,12 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <atomic>
+
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#include <sys/mman.h>
+#define POSIX_FS_HAS_MMAP
+#endif
 
 #ifdef __OS2__
 #define INCL_DOS
@@ -137,37 +147,110 @@ AbstractFSNode *POSIXFilesystemNode::getChild(const Common::String &n) const {
 	return makeNode(newPath);
 }
 
-bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, bool hidden) const {
-	assert(_isDirectory);
+namespace Posix {
 
-#ifdef __OS2__
-	if (_path == "/") {
-		// Special case for the root dir: List all DOS drives
-		ULONG ulDrvNum;
-		ULONG ulDrvMap;
+/** An entry of a directory, as cached between calls to getChildren(). */
+struct DirectoryEntry {
+	Common::String name;
+	bool isDirectory;
+};
 
-		DosQueryCurrentDisk(&ulDrvNum, &ulDrvMap);
+} // End of namespace Posix
 
-		for (int i = 0; i < 26; i++) {
-			if (ulDrvMap & 1) {
-				char drive_root[] = "A:/";
-				drive_root[0] += i;
+namespace {
 
-				POSIXFilesystemNode *entry = new POSIXFilesystemNode();
-				entry->_isDirectory = true;
-				entry->_isValid = true;
-				entry->_path = drive_root;
-				entry->_displayName = "[" + Common::String(drive_root, 2) + "]";
-				myList.push_back(entry);
-			}
+typedef Common::Array<Posix::DirectoryEntry> DirectoryEntries;
 
-			ulDrvMap >>= 1;
-		}
+/**
+ * Listings of the directories read during this session, shared by all nodes.
+ *
+ * A listing is reused as long as the modification time of its directory
+ * stays the same. On network shares this replaces reading the directory and
+ * checking each entry by a single stat() call.
+ */
+class DirectoryCache {
+public:
+	static DirectoryCache &instance() {
+		static DirectoryCache cache;
+		return cache;
+	}
+
+	~DirectoryCache() {
+		delete _mutex.load(std::memory_order_relaxed);
+	}
+
+	bool lookup(const Common::String &path, time_t mtime, DirectoryEntries &entries) {
+		Common::Mutex *mutex = getMutex();
+		if (!mutex)
+			return false;
 
+		Common::StackLock lock(*mutex);
+		Listings::const_iterator i = _listings.find(path);
+		if (i == _listings.end() || i->_value.mtime != mtime)
+			return false;
+
+		entries = i->_value.entries;
 		return true;
 	}
-#endif
 
+	void store(const Common::String &path, time_t mtime, const DirectoryEntries &entries) {
+		Common::Mutex *mutex = getMutex();
+		if (!mutex)
+			return;
+
+		Common::StackLock lock(*mutex);
+		if (_listings.size() >= kMaxListings)
+			_listings.clear();
+
+		Listing &listing = _listings[path];
+		listing.mtime = mtime;
+		listing.entries = entries;
+	}
+
+	void invalidate(const Common::String &path) {
+		Common::Mutex *mutex = getMutex();
+		if (!mutex)
+			return;
+
+		Common::StackLock lock(*mutex);
+		_listings.erase(path);
+	}
+
+private:
+	enum {
+		kMaxListings = 4096
+	};
+
+	struct Listing {
+		time_t mtime;
+		DirectoryEntries entries;
+	};
+
+	typedef Common::HashMap<Common::String, Listing, Common::CaseSensitiveString_Hash, Common::CaseSensitiveString_EqualTo> Listings;
+
+	DirectoryCache() : _mutex(nullptr) {}
+
+	// The mutex is created on first use, as the cache may be reached before
+	// the OSystem exists. Until then, nothing gets cached.
+	Common::Mutex *getMutex() {
+		Common::Mutex *mutex = _mutex.load(std::memory_order_acquire);
+		if (!mutex && g_system) {
+			Common::Mutex *created = new Common::Mutex();
+			if (_mutex.compare_exchange_strong(mutex, created, std::memory_order_acq_rel))
+				mutex = created;
+			else
+				delete created;
+		}
+		return mutex;
+	}
+
+	std::atomic<Common::Mutex *> _mutex;
+	Listings _listings;
+};
+
+} // End of anonymous namespace
+
+bool POSIXFilesystemNode::readDirectory(DirectoryEntries &entries) const {
 	DIR *dirp = opendir(_path.c_str());
 	struct dirent *dp;
 
@@ -176,10 +259,6 @@ bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, boo
 
 	// loop over dir entries using readdir
 	while ((dp = readdir(dirp)) != NULL) {
-		// Skip 'invisible' files if necessary
-		if (dp->d_name[0] == '.' && !hidden) {
-			continue;
-		}
 		// Skip '.' and '..' to avoid cycles
 		if ((dp->d_name[0] == '.' && dp->d_name[1] == 0) || (dp->d_name[0] == '.' && dp->d_name[1] == '.')) {
 			continue;
@@ -224,18 +303,101 @@ bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, boo
 		if (!entry._isValid)
 			continue;
 
+		Posix::DirectoryEntry dirEntry;
+		dirEntry.name = entry._displayName;
+		dirEntry.isDirectory = entry._isDirectory;
+		entries.push_back(dirEntry);
+	}
+	closedir(dirp);
+
+	return true;
+}
+
+void POSIXFilesystemNode::invalidateListing() const {
+	DirectoryCache::instance().invalidate(_path);
+}
+
+bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, bool hidden) const {
+	assert(_isDirectory);
+
+#ifdef __OS2__
+	if (_path == "/") {
+		// Special case for the root dir: List all DOS drives
+		ULONG ulDrvNum;
+		ULONG ulDrvMap;
+
+		DosQueryCurrentDisk(&ulDrvNum, &ulDrvMap);
+
+		for (int i = 0; i < 26; i++) {
+			if (ulDrvMap & 1) {
+				char drive_root[] = "A:/";
+				drive_root[0] += i;
+
+				POSIXFilesystemNode *entry = new POSIXFilesystemNode();
+				entry->_isDirectory = true;
+				entry->_isValid = true;
+				entry->_path = drive_root;
+				entry->_displayName = "[" + Common::String(drive_root, 2) + "]";
+				myList.push_back(entry);
+			}
+
+			ulDrvMap >>= 1;
+		}
+
+		return true;
+	}
+#endif
+
+	// Reuse the listing from an earlier call if the directory did not change
+	DirectoryCache &cache = DirectoryCache::instance();
+	DirectoryEntries entries;
+	struct stat st;
+	const bool haveTime = (stat(_path.c_str(), &st) == 0);
+	if (!haveTime || !cache.lookup(_path, st.st_mtime, entries)) {
+		if (!readDirectory(entries))
+			return false;
+
+		// Only keep the listing if the directory did not change while it
+		// was read
+		struct stat after;
+		if (haveTime && stat(_path.c_str(), &after) == 0 && after.st_mtime == st.st_mtime)
+			cache.store(_path, st.st_mtime, entries);
+	}
+
+	for (DirectoryEntries::const_iterator i = entries.begin(); i != entries.end(); ++i) {
+		// Skip 'invisible' files if necessary
+		if (i->name[0] == '.' && !hidden) {
+			continue;
+		}
+
 		// Honor the chosen mode
-		if ((mode == Common::FSNode::kListFilesOnly && entry._isDirectory) ||
-			(mode == Common::FSNode::kListDirectoriesOnly && !entry._isDirectory))
+		if ((mode == Common::FSNode::kListFilesOnly && i->isDirectory) ||
+			(mode == Common::FSNode::kListDirectoriesOnly && !i->isDirectory))
 			continue;
 
-		myList.push_back(new POSIXFilesystemNode(entry));
+		// Start with a clone of this node, with the correct path set
+		POSIXFilesystemNode *entry = new POSIXFilesystemNode(*this);
+		entry->_displayName = i->name;
+		if (_path.lastChar() != '/')
+			entry->_path += '/';
+		entry->_path += entry->_displayName;
+		entry->_isValid = true;
+		entry->_isDirectory = i->isDirectory;
+
+		myList.push_back(entry);
 	}
-	closedir(dirp);
 
 	return true;
 }
 
+void POSIXFilesystemNode::invalidateParentListing() const {
+	AbstractFSNode *parent = getParent();
+	if (parent) {
+		parent->invalidateListing();
+		delete parent;
+	}
+}
+
 AbstractFSNode *POSIXFilesystemNode::getParent() const {
 	if (_path == "/")
 		return 0;	// The filesystem root has no parent
@@ -269,6 +431,58 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 	return PosixIoStream::makeFromPath(getPath(), false);
 }
 
+#ifdef POSIX_FS_HAS_MMAP
+namespace {
+
+/**
+ * Unmaps a file mapping once the last stream sharing it is gone.
+ */
+struct MunmapDeleter {
+	size_t _size;
+	explicit MunmapDeleter(size_t size) : _size(size) {}
+	void operator()(byte *mapping) { munmap(mapping, _size); }
+};
+
+} // End of anonymous namespace
+#endif
+
+Common::SeekableReadStream *POSIXFilesystemNode::createMappedReadStream() {
+#ifdef POSIX_FS_HAS_MMAP
+	const int fd = open(_path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	// Empty files cannot be mapped, and MemoryReadStream sizes are 32-bit
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0 || (uint64)st.st_size > 0xFFFFFFFFULL) {
+		close(fd);
+		return nullptr;
+	}
+
+	const uint32 size = (uint32)st.st_size;
+	void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping stays valid after closing the descriptor
+	close(fd);
+	if (mapping == MAP_FAILED)
+		return nullptr;
+
+	// Share the mapping, so that slices of it can outlive the stream
+	return new Common::MemoryReadStream(Common::SharedPtr<byte>((byte *)mapping, MunmapDeleter(size)), size);
+#else
+	return nullptr;
+#endif
+}
+
+bool POSIXFilesystemNode::getFileStats(int64 &size, int64 &modificationTime) const {
+	struct stat st;
+	if (stat(_path.c_str(), &st) != 0)
+		return false;
+
+	size = st.st_size;
+	modificationTime = st.st_mtime;
+	return true;
+}
+
 Common::SeekableReadStream *POSIXFilesystemNode::createReadStreamForAltStream(Common::AltStreamType altStreamType) {
 #ifdef MACOSX
 	if (altStreamType == Common::AltStreamType::MacResourceFork) {
@@ -281,12 +495,16 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStreamForAltStream(Co
 }
 
 Common::SeekableWriteStream *POSIXFilesystemNode::createWriteStream() {
+	// The file may be new, so forget the listing of its directory
+	invalidateParentListing();
 	return PosixIoStream::makeFromPath(getPath(), true);
 }
 
 bool POSIXFilesystemNode::createDirectory() {
-	if (mkdir(_path.c_str(), 0755) == 0)
+	if (mkdir(_path.c_str(), 0755) == 0) {
+		invalidateParentListing();
 		setFlags();
+	}
 
 	return _isValid && _isDirectory;
 }
@@ -24,6 +24,10 @@
 
 #include "backends/fs/abstract-fs.h"
 
+namespace Posix {
+struct DirectoryEntry;
+}
+
 /**
  * Implementation of the ScummVM file system API based on POSIX.
  *
@@ -66,15 +70,29 @@ public:
 	AbstractFSNode *getParent() const override;
 
 	Common::SeekableReadStream *createReadStream() override;
+	Common::SeekableReadStream *createMappedReadStream() override;
+	bool getFileStats(int64 &size, int64 &modificationTime) const override;
 	Common::SeekableReadStream *createReadStreamForAltStream(Common::AltStreamType altStreamType) override;
 	Common::SeekableWriteStream *createWriteStream() override;
 	bool createDirectory() override;
+	void invalidateListing() const override;
 
 protected:
 	/**
 	 * Tests and sets the _isValid and _isDirectory flags, using the stat() function.
 	 */
 	virtual void setFlags();
+
+private:
+	/**
+	 * Reads all entries of the directory, including hidden ones.
+	 */
+	bool readDirectory(Common::Array<Posix::DirectoryEntry> &entries) const;
+
+	/**
+	 * Drops the cached listing of the directory containing this node.
+	 */
+	void invalidateParentListing() const;
 };
 
 namespace Posix {
@@ -26,6 +26,7 @@
 
 #include "backends/fs/windows/windows-fs.h"
 #include "backends/fs/stdiostream.h"
+#include "common/memstream.h"
 
 bool WindowsFilesystemNode::exists() const {
 	// Check whether the file actually exists
@@ -223,6 +224,55 @@ Common::SeekableReadStream *WindowsFilesystemNode::createReadStream() {
 	return StdioStream::makeFromPath(getPath(), false);
 }
 
+namespace {
+
+/**
+ * Unmaps a view of a file once the last stream sharing it is gone.
+ */
+struct UnmapViewDeleter {
+	void operator()(byte *view) { UnmapViewOfFile(view); }
+};
+
+} // End of anonymous namespace
+
+Common::SeekableReadStream *WindowsFilesystemNode::createMappedReadStream() {
+	HANDLE file = CreateFile(charToTchar(_path.c_str()), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	// Empty files cannot be mapped, and MemoryReadStream sizes are 32-bit
+	DWORD sizeHigh = 0;
+	const DWORD sizeLow = GetFileSize(file, &sizeHigh);
+	if (sizeLow == INVALID_FILE_SIZE || sizeHigh != 0 || sizeLow == 0) {
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	HANDLE mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+		return nullptr;
+
+	// The view keeps the mapping object alive after closing its handle
+	void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!view)
+		return nullptr;
+
+	// Share the view, so that slices of it can outlive the stream
+	return new Common::MemoryReadStream(Common::SharedPtr<byte>((byte *)view, UnmapViewDeleter()), sizeLow);
+}
+
+bool WindowsFilesystemNode::getFileStats(int64 &size, int64 &modificationTime) const {
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesEx(charToTchar(_path.c_str()), GetFileExInfoStandard, &data))
+		return false;
+
+	size = ((int64)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+	modificationTime = ((int64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+	return true;
+}
+
 Common::SeekableWriteStream *WindowsFilesystemNode::createWriteStream() {
 	return StdioStream::makeFromPath(getPath(), true);
 }
@@ -78,6 +78,8 @@ public:
 	AbstractFSNode *getParent() const override;
 
 	Common::SeekableReadStream *createReadStream() override;
+	Common::SeekableReadStream *createMappedReadStream() override;
+	bool getFileStats(int64 &size, int64 &modificationTime) const override;
 	Common::SeekableWriteStream *createWriteStream() override;
 	bool createDirectory() override;
 
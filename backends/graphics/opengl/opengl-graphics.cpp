@@ -371,6 +371,8 @@ bool OpenGLGraphicsManager::loadShader(const Common::Path &fileName) {
 			warning("Failed to load shader %s", fileName.toString().c_str());
 			return false;
 		}
+
+		_libretroPipeline->enableHalfRate(ConfMan.hasKey("shader_half_rate") && ConfMan.getBool("shader_half_rate"));
 	} else {
 		_libretroPipeline->close();
 	}
@@ -589,6 +591,10 @@ void OpenGLGraphicsManager::copyRectToScreen(const void *buf, int pitch, int x,
 	_gameScreen->copyRectToTexture(x, y, w, h, buf, pitch);
 }
 
+void OpenGLGraphicsManager::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) {
+	_gameScreen->copyRectsToTexture(rects, count, buf, pitch);
+}
+
 void OpenGLGraphicsManager::fillScreen(uint32 col) {
 	_gameScreen->fill(col);
 }
@@ -652,6 +658,13 @@ void OpenGLGraphicsManager::updateScreen() {
 	if (debugger)
 		debugger->onFrame();
 
+#if !USE_FORCED_GLES
+	// The libretro passes only need to run again when anything they scale
+	// changed, the texture updates below clear this state.
+	const bool scaledInputChanged = _forceRedraw || _cursorNeedsRedraw || _gameScreen->isDirty()
+	    || (_cursorVisible && ((_cursor && _cursor->isDirty()) || (_cursorMask && _cursorMask->isDirty())));
+#endif
+
 	// We only update the screen when there actually have been any changes.
 	if (   !_forceRedraw
 		&& !_cursorNeedsRedraw
@@ -680,7 +693,7 @@ void OpenGLGraphicsManager::updateScreen() {
 
 #if !USE_FORCED_GLES
 	if (_libretroPipeline) {
-		_libretroPipeline->beginScaling();
+		_libretroPipeline->beginScaling(scaledInputChanged);
 	}
 #endif
 
@@ -100,6 +100,7 @@ public:
 	int16 getHeight() const override;
 
 	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override;
+	void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) override;
 	void fillScreen(uint32 col) override;
 	void fillScreen(const Common::Rect &r, uint32 col) override;
 
@@ -204,7 +204,8 @@ LibRetroPipeline::LibRetroPipeline()
 	  _outputPipeline(ShaderMan.query(ShaderManager::kDefault)),
 	  _needsScaling(false), _shaderPreset(nullptr), _linearFiltering(false),
 	  _currentTarget(uint(-1)), _inputWidth(0), _inputHeight(0),
-	  _isAnimated(false), _frameCount(0) {
+	  _isAnimated(false), _frameCount(0), _outputValid(false), _reuseOutput(false),
+	  _reusedLastFrame(false), _halfRate(false) {
 }
 
 LibRetroPipeline::~LibRetroPipeline() {
@@ -234,6 +235,11 @@ void LibRetroPipeline::drawTextureInternal(const GLTexture &texture, const GLflo
 		return;
 	}
 
+	// The scaled output of the last frame is used again, no need to draw its input.
+	if (_reuseOutput) {
+		return;
+	}
+
 	// Disable linear filtering: we apply it after merging all to be scaled surfaces
 	setLinearFiltering(texture.getGLTexture(), false);
 
@@ -254,10 +260,28 @@ void LibRetroPipeline::drawTextureInternal(const GLTexture &texture, const GLflo
 	}
 }
 
-void LibRetroPipeline::beginScaling() {
+void LibRetroPipeline::enableLinearFiltering(bool enabled) {
+	if (_linearFiltering != enabled) {
+		_linearFiltering = enabled;
+		_outputValid = false;
+	}
+}
+
+void LibRetroPipeline::beginScaling(bool inputChanged) {
 	if (_shaderPreset != nullptr) {
 		_needsScaling = true;
 		_inputTargets[_currentTarget].getTexture()->enableLinearFiltering(_linearFiltering);
+
+		// Static presets give the same result for the same input. Animated ones
+		// need to run every frame, unless we are allowed to halve their rate.
+		if (!_outputValid || inputChanged) {
+			_reuseOutput = false;
+		} else if (!_isAnimated) {
+			_reuseOutput = true;
+		} else {
+			_reuseOutput = _halfRate && !_reusedLastFrame;
+		}
+		_reusedLastFrame = _reuseOutput;
 	}
 }
 
@@ -269,19 +293,23 @@ void LibRetroPipeline::finishScaling() {
 	/* As we have now finished to render everything in the input pipeline
 	 * we can do the render through all libretro passes */
 
-	// Now we can actually draw the texture with the setup passes.
-	for (PassArray::const_iterator i = _passes.begin(), end = _passes.end(); i != end; ++i) {
-		renderPass(*i);
-	}
+	if (!_reuseOutput) {
+		// Now we can actually draw the texture with the setup passes.
+		for (PassArray::const_iterator i = _passes.begin(), end = _passes.end(); i != end; ++i) {
+			renderPass(*i);
+		}
 
-	// Prepare for the next frame
-	_frameCount++;
+		// Prepare for the next frame
+		_frameCount++;
 
-	_currentTarget++;
-	if (_currentTarget >= _inputTargets.size()) {
-		_currentTarget = 0;
+		_currentTarget++;
+		if (_currentTarget >= _inputTargets.size()) {
+			_currentTarget = 0;
+		}
+		_passes[0].inputTexture = _inputTargets[_currentTarget].getTexture();
+
+		_outputValid = true;
 	}
-	_passes[0].inputTexture = _inputTargets[_currentTarget].getTexture();
 
 	// Clear the output buffer.
 	_activeFramebuffer->activate(this);
@@ -312,6 +340,7 @@ void LibRetroPipeline::finishScaling() {
 	_outputPipeline.drawTexture(*_passes[_passes.size() - 1].target->getTexture(), coordinates);
 
 	_needsScaling = false;
+	_reuseOutput = false;
 }
 
 void LibRetroPipeline::setDisplaySizes(uint inputWidth, uint inputHeight, const Common::Rect &outputRect) {
@@ -388,6 +417,9 @@ void LibRetroPipeline::close() {
 
 	_isAnimated = false;
 	_needsScaling = false;
+	_outputValid = false;
+	_reuseOutput = false;
+	_reusedLastFrame = false;
 
 	_inputTargets.resize(0);
 	_currentTarget = uint(-1);
@@ -632,6 +664,9 @@ bool LibRetroPipeline::loadPasses(Common::SearchSet &archSet) {
 }
 
 void LibRetroPipeline::setPipelineState() {
+	// The pass targets get resized, any previous result is gone.
+	_outputValid = false;
+
 	// Setup FBO sizes, we require this to be able to set all uniform values.
 	setupFBOs();
 
@@ -59,11 +59,16 @@ public:
 	void close();
 
 	/* Called by OpenGLGraphicsManager */
-	void enableLinearFiltering(bool enabled) { _linearFiltering = enabled; }
+	void enableLinearFiltering(bool enabled);
+	/* Called by OpenGLGraphicsManager to only evaluate animated presets every other frame
+	 * as long as the input stays the same. This saves power on slow devices. */
+	void enableHalfRate(bool enabled) { _halfRate = enabled; }
 	/* Called by OpenGLGraphicsManager to setup the internal objects sizes */
 	void setDisplaySizes(uint inputWidth, uint inputHeight, const Common::Rect &outputRect);
-	/* Called by OpenGLGraphicsManager to indicate that next draws need to be scaled. */
-	void beginScaling();
+	/* Called by OpenGLGraphicsManager to indicate that next draws need to be scaled.
+	 * When inputChanged is false, the result of the previous frame may be reused
+	 * and all passes skipped. */
+	void beginScaling(bool inputChanged = true);
 	/* Called by OpenGLGraphicsManager to indicate that next draws don't need to be scaled.
 	 * This must be called to execute scaling. */
 	void finishScaling();
@@ -106,6 +111,13 @@ private:
 	bool _isAnimated;
 	uint _frameCount;
 
+	/* Whether the last pass target holds a valid result, whether it is reused
+	 * for the current frame and whether it was reused for the previous one */
+	bool _outputValid;
+	bool _reuseOutput;
+	bool _reusedLastFrame;
+	bool _halfRate;
+
 	Common::Array<LibRetroTextureTarget> _inputTargets;
 	uint _currentTarget;
 
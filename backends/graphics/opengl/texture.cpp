@@ -29,6 +29,7 @@
 #include "common/algorithm.h"
 #include "common/endian.h"
 #include "common/rect.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 
 #include "graphics/blit.h"
@@ -39,16 +40,32 @@
 
 namespace OpenGL {
 
+#ifdef USE_GLAD
+// glBufferStorage is not part of the bundled GLAD loader.
+typedef void (GLAD_API_PTR *BufferStorageProc)(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+static BufferStorageProc bufferStorage = nullptr;
+#endif
+
 GLTexture::GLTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType)
 	: _glIntFormat(glIntFormat), _glFormat(glFormat), _glType(glType),
 	  _width(0), _height(0), _logicalWidth(0), _logicalHeight(0),
 	  _texCoords(), _glFilter(GL_NEAREST),
-	  _glTexture(0) {
+	  _glTexture(0), _glPixelBuffers(), _curPixelBuffer(0)
+#ifdef USE_GLAD
+	  , _pixelBufferMappings(), _pixelBufferFences(), _pixelBufferCapacity(0),
+	  _pixelBufferStreaming(true)
+#endif
+	  {
 	create();
 }
 
 GLTexture::~GLTexture() {
 	GL_CALL_SAFE(glDeleteTextures, (1, &_glTexture));
+#ifdef USE_GLAD
+	if (OpenGLContext.type != kContextNone) {
+		destroyPixelBuffers();
+	}
+#endif
 }
 
 void GLTexture::enableLinearFiltering(bool enable) {
@@ -113,6 +130,11 @@ void GLTexture::setWrapMode(WrapMode wrapMode) {
 void GLTexture::destroy() {
 	GL_CALL(glDeleteTextures(1, &_glTexture));
 	_glTexture = 0;
+
+#ifdef USE_GLAD
+	destroyPixelBuffers();
+	_pixelBufferStreaming = true;
+#endif
 }
 
 void GLTexture::create() {
@@ -196,37 +218,190 @@ bool GLTexture::setSize(uint width, uint height) {
 }
 
 void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &src) {
+	updateAreas(Common::Array<Common::Rect>(1, area), src);
+}
+
+void GLTexture::updateAreas(const Common::Array<Common::Rect> &areas, const Graphics::Surface &src) {
 	// Set the texture on the active texture unit.
 	bind();
 
+#ifdef USE_GLAD
+	if (OpenGLContext.bufferStorageSupported && _pixelBufferStreaming && streamAreas(areas, src)) {
+		return;
+	}
+#endif
+
 	// Update the actual texture.
-	// Although we have the area of the texture buffer we want to update we
-	// cannot take advantage of the left/right boundaries here because it is
-	// not possible to specify a pitch to glTexSubImage2D. To be precise, with
-	// plain OpenGL we could set GL_UNPACK_ROW_LENGTH to achieve this. However,
-	// OpenGL ES 1.0 does not support GL_UNPACK_ROW_LENGTH. Thus, we are left
-	// with the following options:
-	//
-	// 1) (As we do right now) Simply always update the whole texture lines of
-	//    rect changed. This is simplest to implement. In case performance is
-	//    really an issue we can think of switching to another method.
-	//
-	// 2) Copy the dirty rect to a temporary buffer and upload that by using
-	//    glTexSubImage2D. This is what the Android backend does. It is more
-	//    complicated though.
-	//
-	// 3) Use glTexSubImage2D per line changed. This is what the old OpenGL
-	//    graphics manager did but it is much slower! Thus, we do not use it.
-	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, area.top, src.w, area.height(),
-	                       _glFormat, _glType, src.getBasePtr(0, area.top)));
+	// When the context lets us specify a pitch with GL_UNPACK_ROW_LENGTH we
+	// upload exactly the area requested. OpenGL ES 1.0 and plain OpenGL ES 2.0
+	// do not support GL_UNPACK_ROW_LENGTH though. In that case we always
+	// update the whole texture lines of the area. Copying the area to a
+	// temporary buffer or uploading it line by line would be the
+	// alternatives, but both turned out slower.
+	const uint bytesPerPixel = src.format.bytesPerPixel;
+
+	for (uint i = 0; i < areas.size(); ++i) {
+		const Common::Rect &area = areas[i];
+
+		if (OpenGLContext.unpackSubImageSupported && area.width() != src.w) {
+			GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, src.pitch / bytesPerPixel));
+			uploadPixels(area.left, area.top, area.width(), area.height(), src.getBasePtr(area.left, area.top),
+			             (area.height() - 1) * src.pitch + area.width() * bytesPerPixel);
+			GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+		} else {
+			uploadPixels(0, area.top, src.w, area.height(), src.getBasePtr(0, area.top),
+			             area.height() * src.w * bytesPerPixel);
+		}
+	}
+}
+
+void GLTexture::uploadPixels(uint x, uint y, uint w, uint h, const void *pixels, uint size) {
+#ifdef USE_GLAD
+	if (OpenGLContext.pixelBufferObjectSupported) {
+		if (!_glPixelBuffers[0]) {
+			GL_CALL(glGenBuffers(kPixelBufferCount, _glPixelBuffers));
+		}
+
+		// Respecifying the buffer storage on every upload lets the driver
+		// hand us fresh memory instead of waiting for the previous transfer,
+		// and the texture update itself then happens asynchronously.
+		GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _glPixelBuffers[_curPixelBuffer]));
+		GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, pixels, GL_STREAM_DRAW));
+		GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, _glFormat, _glType, nullptr));
+		GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+		_curPixelBuffer = (_curPixelBuffer + 1) % kPixelBufferCount;
+		return;
+	}
+#endif
+
+	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, _glFormat, _glType, pixels));
+}
+
+#ifdef USE_GLAD
+bool GLTexture::streamAreas(const Common::Array<Common::Rect> &areas, const Graphics::Surface &src) {
+	// All areas are packed tightly into one persistently mapped buffer,
+	// which can hold the whole surface. Overlapping areas might not fit,
+	// those take the regular path.
+	const uint bytesPerPixel = src.format.bytesPerPixel;
+	const uint capacity = src.h * src.pitch;
+
+	uint size = 0;
+	for (uint i = 0; i < areas.size(); ++i) {
+		size += areas[i].width() * areas[i].height() * bytesPerPixel;
+	}
+
+	if (size > capacity) {
+		return false;
+	}
+
+	if (capacity != _pixelBufferCapacity && !createPixelBuffers(capacity)) {
+		// Don't try again until the context is recreated.
+		_pixelBufferStreaming = false;
+		return false;
+	}
+
+	// The buffer was last used kPixelBufferCount uploads ago, so this
+	// normally doesn't need to wait at all.
+	const uint index = _curPixelBuffer;
+	_curPixelBuffer = (_curPixelBuffer + 1) % kPixelBufferCount;
+
+	if (_pixelBufferFences[index]) {
+		GLenum result;
+		do {
+			GL_ASSIGN(result, glClientWaitSync(_pixelBufferFences[index], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000));
+		} while (result == GL_TIMEOUT_EXPIRED);
+
+		GL_CALL(glDeleteSync(_pixelBufferFences[index]));
+		_pixelBufferFences[index] = nullptr;
+	}
+
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _glPixelBuffers[index]));
+
+	byte *mapping = (byte *)_pixelBufferMappings[index];
+	uintptr offset = 0;
+
+	for (uint i = 0; i < areas.size(); ++i) {
+		const Common::Rect &area = areas[i];
+		const uint lineSize = area.width() * bytesPerPixel;
+
+		const byte *srcLine = (const byte *)src.getBasePtr(area.left, area.top);
+		byte *dstLine = mapping + offset;
+
+		for (int y = area.top; y < area.bottom; ++y) {
+			memcpy(dstLine, srcLine, lineSize);
+			srcLine += src.pitch;
+			dstLine += lineSize;
+		}
+
+		GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.top, area.width(), area.height(),
+		                        _glFormat, _glType, (const void *)offset));
+		offset += lineSize * area.height();
+	}
+
+	GL_ASSIGN(_pixelBufferFences[index], glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+	return true;
+}
+
+bool GLTexture::createPixelBuffers(uint capacity) {
+	destroyPixelBuffers();
+
+	if (!bufferStorage) {
+		bufferStorage = (BufferStorageProc)g_system->getOpenGLProcAddress("glBufferStorage");
+		if (!bufferStorage) {
+			return false;
+		}
+	}
+
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	GL_CALL(glGenBuffers(kPixelBufferCount, _glPixelBuffers));
+	for (uint i = 0; i < kPixelBufferCount; ++i) {
+		GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _glPixelBuffers[i]));
+		GL_CALL(bufferStorage(GL_PIXEL_UNPACK_BUFFER, capacity, nullptr, flags));
+		GL_ASSIGN(_pixelBufferMappings[i], glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, capacity, flags));
+
+		if (!_pixelBufferMappings[i]) {
+			GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+			destroyPixelBuffers();
+			return false;
+		}
+	}
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+	_pixelBufferCapacity = capacity;
+	return true;
 }
 
+void GLTexture::destroyPixelBuffers() {
+	for (uint i = 0; i < kPixelBufferCount; ++i) {
+		if (_pixelBufferFences[i]) {
+			GL_CALL(glDeleteSync(_pixelBufferFences[i]));
+			_pixelBufferFences[i] = nullptr;
+		}
+
+		// Deleting the buffers unmaps them as well.
+		_pixelBufferMappings[i] = nullptr;
+	}
+
+	if (_glPixelBuffers[0]) {
+		GL_CALL(glDeleteBuffers(kPixelBufferCount, _glPixelBuffers));
+		memset(_glPixelBuffers, 0, sizeof(_glPixelBuffers));
+	}
+
+	_curPixelBuffer = 0;
+	_pixelBufferCapacity = 0;
+}
+#endif
+
 //
 // Surface
 //
 
 Surface::Surface()
-	: _allDirty(false), _dirtyArea() {
+	: _allDirty(false), _dirtyRects() {
 }
 
 void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcPtr, uint srcPitch) {
@@ -252,6 +427,34 @@ void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcP
 	}
 }
 
+void Surface::copyRectsToTexture(const Common::Rect *rects, uint count, const void *srcPtr, uint srcPitch) {
+	Graphics::Surface *dstSurf = getSurface();
+	const uint pitch = dstSurf->pitch;
+	const uint bytesPerPixel = dstSurf->format.bytesPerPixel;
+
+	for (uint i = 0; i < count; ++i) {
+		const Common::Rect &r = rects[i];
+		assert(r.right <= dstSurf->w);
+		assert(r.bottom <= dstSurf->h);
+
+		addDirtyArea(r);
+
+		const byte *src = (const byte *)srcPtr + r.top * srcPitch + r.left * bytesPerPixel;
+		byte *dst = (byte *)dstSurf->getBasePtr(r.left, r.top);
+		uint h = r.height();
+
+		if (srcPitch == pitch && r.left == 0 && r.width() == dstSurf->w) {
+			memcpy(dst, src, h * pitch);
+		} else {
+			while (h-- > 0) {
+				memcpy(dst, src, r.width() * bytesPerPixel);
+				dst += pitch;
+				src += srcPitch;
+			}
+		}
+	}
+}
+
 void Surface::fill(uint32 color) {
 	Graphics::Surface *dst = getSurface();
 	dst->fillRect(Common::Rect(dst->w, dst->h), color);
@@ -266,23 +469,62 @@ void Surface::fill(const Common::Rect &r, uint32 color) {
 	addDirtyArea(r);
 }
 
+static inline uint rectArea(const Common::Rect &r) {
+	return r.width() * r.height();
+}
+
 void Surface::addDirtyArea(const Common::Rect &r) {
 	// *sigh* Common::Rect::extend behaves unexpected whenever one of the two
-	// parameters is an empty rect. Thus, we check whether the current dirty
-	// area is valid. In case it is not we simply use the parameters as new
-	// dirty area. Otherwise, we simply call extend.
-	if (_dirtyArea.isEmpty()) {
-		_dirtyArea = r;
-	} else {
-		_dirtyArea.extend(r);
+	// parameters is an empty rect. Thus, we never store empty rects.
+	if (r.isEmpty() || _allDirty) {
+		return;
+	}
+
+	// Merge the new area with every dirty rect for which the bounding box
+	// covers no more than both rects on their own. This joins overlapping
+	// and adjacent updates while keeping distant ones apart.
+	Common::Rect area = r;
+	for (uint i = 0; i < _dirtyRects.size();) {
+		Common::Rect merged = area;
+		merged.extend(_dirtyRects[i]);
+
+		if (rectArea(merged) <= rectArea(area) + rectArea(_dirtyRects[i])) {
+			area = merged;
+			_dirtyRects.remove_at(i);
+			// The grown area might touch rects we already checked.
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+
+	if (_dirtyRects.size() < kMaxDirtyRects) {
+		_dirtyRects.push_back(area);
+		return;
 	}
+
+	// Without a free slot, grow the rect which needs to grow the least.
+	uint best = 0;
+	uint bestGrowth = (uint)-1;
+	for (uint i = 0; i < _dirtyRects.size(); ++i) {
+		Common::Rect merged = _dirtyRects[i];
+		merged.extend(area);
+
+		const uint growth = rectArea(merged) - rectArea(_dirtyRects[i]);
+		if (growth < bestGrowth) {
+			best = i;
+			bestGrowth = growth;
+		}
+	}
+
+	_dirtyRects[best].extend(area);
 }
 
-Common::Rect Surface::getDirtyArea() const {
+Common::Array<Common::Rect> Surface::getDirtyRects() const {
 	if (_allDirty) {
-		return Common::Rect(getWidth(), getHeight());
+		return Common::Array<Common::Rect>(1, Common::Rect(getWidth(), getHeight()));
 	} else {
-		return _dirtyArea;
+		return _dirtyRects;
 	}
 }
 
@@ -343,15 +585,20 @@ void Texture::updateGLTexture() {
 		return;
 	}
 
-	Common::Rect dirtyArea = getDirtyArea();
+	Common::Array<Common::Rect> dirtyRects = getDirtyRects();
 
-	updateGLTexture(dirtyArea);
+	updateGLTexture(dirtyRects);
+
+	// We should have handled everything, thus not dirty anymore.
+	clearDirty();
 }
 
-void Texture::updateGLTexture(Common::Rect &dirtyArea) {
+void Texture::updateGLTexture(Common::Array<Common::Rect> &dirtyRects) {
 	// In case we use linear filtering we might need to duplicate the last
 	// pixel row/column to avoid glitches with filtering.
-	if (_glTexture.isLinearFilteringEnabled()) {
+	for (uint i = 0; _glTexture.isLinearFilteringEnabled() && i < dirtyRects.size(); ++i) {
+		Common::Rect &dirtyArea = dirtyRects[i];
+
 		if (dirtyArea.right == _userPixelData.w && _userPixelData.w != _textureData.w) {
 			uint height = dirtyArea.height();
 
@@ -378,10 +625,7 @@ void Texture::updateGLTexture(Common::Rect &dirtyArea) {
 		}
 	}
 
-	_glTexture.updateArea(dirtyArea, _textureData);
-
-	// We should have handled everything, thus not dirty anymore.
-	clearDirty();
+	_glTexture.updateAreas(dirtyRects, _textureData);
 }
 
 FakeTexture::FakeTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType, const Graphics::PixelFormat &format, const Graphics::PixelFormat &fakeFormat)
@@ -449,7 +693,15 @@ void FakeTexture::setPalette(uint start, uint colors, const byte *palData) {
 	if (!_palette)
 		return;
 
-	Graphics::convertPaletteToMap(_palette + start, palData, colors, _format);
+	uint32 newColors[256];
+	Graphics::convertPaletteToMap(newColors, palData, colors, _format);
+
+	// Engines often set the whole palette again although nothing changed,
+	// there is no need to convert the whole surface again in that case.
+	if (memcmp(_palette + start, newColors, colors * sizeof(uint32)) == 0)
+		return;
+
+	memcpy(_palette + start, newColors, colors * sizeof(uint32));
 
 	// A palette changes means we need to refresh the whole surface.
 	flagDirty();
@@ -463,12 +715,16 @@ void FakeTexture::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyRects = getDirtyRects();
 
-	byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+	for (uint i = 0; i < dirtyRects.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyRects[i];
 
-	applyPaletteAndMask(dst, src, outSurf->pitch, _rgbData.pitch, _rgbData.w, dirtyArea, outSurf->format, _rgbData.format);
+		byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+
+		applyPaletteAndMask(dst, src, outSurf->pitch, _rgbData.pitch, _rgbData.w, dirtyArea, outSurf->format, _rgbData.format);
+	}
 
 	// Do generic handling of updating the texture.
 	Texture::updateGLTexture();
@@ -520,25 +776,29 @@ void TextureRGB555::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyRects = getDirtyRects();
 
-	uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
+	for (uint i = 0; i < dirtyRects.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyRects[i];
 
-	const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
+		uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint16 color = *src++;
+		const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
 
-			*dst++ =   ((color & 0x7C00) << 1)                             // R
-			         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
-			         | (color & 0x001F);                                   // B
-		}
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint16 color = *src++;
 
-		src = (const uint16 *)((const byte *)src + srcAdd);
-		dst = (uint16 *)((byte *)dst + dstAdd);
+				*dst++ =   ((color & 0x7C00) << 1)                             // R
+				         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
+				         | (color & 0x001F);                                   // B
+			}
+
+			src = (const uint16 *)((const byte *)src + srcAdd);
+			dst = (uint16 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -562,23 +822,27 @@ void TextureRGBA8888Swap::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyRects = getDirtyRects();
 
-	uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
+	for (uint i = 0; i < dirtyRects.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyRects[i];
 
-	const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
+		uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint32 color = *src++;
+		const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
 
-			*dst++ = SWAP_BYTES_32(color);
-		}
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint32 color = *src++;
 
-		src = (const uint32 *)((const byte *)src + srcAdd);
-		dst = (uint32 *)((byte *)dst + dstAdd);
+				*dst++ = SWAP_BYTES_32(color);
+			}
+
+			src = (const uint32 *)((const byte *)src + srcAdd);
+			dst = (uint32 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -629,46 +893,52 @@ void ScaledTexture::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	Common::Rect dirtyArea = getDirtyArea();
+	Common::Array<Common::Rect> dirtyRects = getDirtyRects();
 
-	// Extend the dirty region for scalers
-	// that "smear" the screen, e.g. 2xSAI
-	dirtyArea.grow(_extraPixels);
-	dirtyArea.clip(Common::Rect(0, 0, _rgbData.w, _rgbData.h));
+	for (uint i = 0; i < dirtyRects.size(); ++i) {
+		Common::Rect &dirtyArea = dirtyRects[i];
 
-	const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	uint srcPitch = _rgbData.pitch;
-	byte *dst;
-	uint dstPitch;
+		// Extend the dirty region for scalers
+		// that "smear" the screen, e.g. 2xSAI
+		dirtyArea.grow(_extraPixels);
+		dirtyArea.clip(Common::Rect(0, 0, _rgbData.w, _rgbData.h));
 
-	if (_convData) {
-		dst = (byte *)_convData->getBasePtr(dirtyArea.left + _extraPixels, dirtyArea.top + _extraPixels);
-		dstPitch = _convData->pitch;
+		const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		uint srcPitch = _rgbData.pitch;
+		byte *dst;
+		uint dstPitch;
 
-		applyPaletteAndMask(dst, src, dstPitch, srcPitch, _rgbData.w, dirtyArea, _convData->format, _rgbData.format);
+		if (_convData) {
+			dst = (byte *)_convData->getBasePtr(dirtyArea.left + _extraPixels, dirtyArea.top + _extraPixels);
+			dstPitch = _convData->pitch;
 
-		src = dst;
-		srcPitch = dstPitch;
-	}
+			applyPaletteAndMask(dst, src, dstPitch, srcPitch, _rgbData.w, dirtyArea, _convData->format, _rgbData.format);
 
-	dst = (byte *)outSurf->getBasePtr(dirtyArea.left * _scaleFactor, dirtyArea.top * _scaleFactor);
-	dstPitch = outSurf->pitch;
+			src = dst;
+			srcPitch = dstPitch;
+		}
 
-	if (_scaler && (uint)dirtyArea.height() >= _extraPixels) {
-		_scaler->scale(src, srcPitch, dst, dstPitch, dirtyArea.width(), dirtyArea.height(), dirtyArea.left, dirtyArea.top);
-	} else {
-		Graphics::scaleBlit(dst, src, dstPitch, srcPitch,
-		                    dirtyArea.width() * _scaleFactor, dirtyArea.height() * _scaleFactor,
-		                    dirtyArea.width(), dirtyArea.height(), outSurf->format);
-	}
+		dst = (byte *)outSurf->getBasePtr(dirtyArea.left * _scaleFactor, dirtyArea.top * _scaleFactor);
+		dstPitch = outSurf->pitch;
 
-	dirtyArea.left   *= _scaleFactor;
-	dirtyArea.right  *= _scaleFactor;
-	dirtyArea.top    *= _scaleFactor;
-	dirtyArea.bottom *= _scaleFactor;
+		if (_scaler && (uint)dirtyArea.height() >= _extraPixels) {
+			_scaler->scale(src, srcPitch, dst, dstPitch, dirtyArea.width(), dirtyArea.height(), dirtyArea.left, dirtyArea.top);
+		} else {
+			Graphics::scaleBlit(dst, src, dstPitch, srcPitch,
+			                    dirtyArea.width() * _scaleFactor, dirtyArea.height() * _scaleFactor,
+			                    dirtyArea.width(), dirtyArea.height(), outSurf->format);
+		}
+
+		dirtyArea.left   *= _scaleFactor;
+		dirtyArea.right  *= _scaleFactor;
+		dirtyArea.top    *= _scaleFactor;
+		dirtyArea.bottom *= _scaleFactor;
+	}
 
 	// Do generic handling of updating the texture.
-	Texture::updateGLTexture(dirtyArea);
+	Texture::updateGLTexture(dirtyRects);
+
+	clearDirty();
 }
 
 void ScaledTexture::setScaler(uint scalerIndex, int scaleFactor) {
@@ -704,7 +974,7 @@ TextureCLUT8GPU::TextureCLUT8GPU()
 	  _paletteTexture(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE),
 	  _target(new TextureTarget()), _clut8Pipeline(new CLUT8LookUpPipeline()),
 	  _clut8Vertices(), _clut8Data(), _userPixelData(), _palette(),
-	  _paletteDirty(false) {
+	  _paletteDirtyStart(0), _paletteDirtyEnd(256) {
 	// Allocate space for 256 colors.
 	_paletteTexture.setSize(256, 1);
 
@@ -737,9 +1007,11 @@ void TextureCLUT8GPU::recreate() {
 	// time.
 	if (_clut8Data.getPixels()) {
 		flagDirty();
-		_paletteDirty = true;
 	}
 
+	// The palette texture lost its contents as well.
+	flagPaletteDirty(0, 256);
+
 	if (_clut8Pipeline == nullptr) {
 		_clut8Pipeline = new CLUT8LookUpPipeline();
 		// Setup pipeline.
@@ -802,21 +1074,44 @@ void TextureCLUT8GPU::setColorKey(uint colorKey) {
 	_palette[colorKey * 4 + 2] = 0x00;
 	_palette[colorKey * 4 + 3] = 0x00;
 
-	_paletteDirty = true;
+	flagPaletteDirty(colorKey, colorKey + 1);
 }
 
 void TextureCLUT8GPU::setPalette(uint start, uint colors, const byte *palData) {
 	byte *dst = _palette + start * 4;
 
-	while (colors-- > 0) {
-		memcpy(dst, palData, 3);
-		dst[3] = 0xFF;
+	// Only entries which actually change need to be uploaded. Many engines
+	// set the full palette even though just a few colors are cycled.
+	uint changedStart = start + colors, changedEnd = start;
+
+	for (uint i = start; i < start + colors; ++i) {
+		if (memcmp(dst, palData, 3) != 0 || dst[3] != 0xFF) {
+			memcpy(dst, palData, 3);
+			dst[3] = 0xFF;
+
+			changedStart = MIN(changedStart, i);
+			changedEnd = i + 1;
+		}
 
 		dst += 4;
 		palData += 3;
 	}
 
-	_paletteDirty = true;
+	flagPaletteDirty(changedStart, changedEnd);
+}
+
+void TextureCLUT8GPU::flagPaletteDirty(uint start, uint end) {
+	if (start >= end) {
+		return;
+	}
+
+	if (isPaletteDirty()) {
+		_paletteDirtyStart = MIN(_paletteDirtyStart, start);
+		_paletteDirtyEnd = MAX(_paletteDirtyEnd, end);
+	} else {
+		_paletteDirtyStart = start;
+		_paletteDirtyEnd = end;
+	}
 }
 
 const GLTexture &TextureCLUT8GPU::getGLTexture() const {
@@ -824,16 +1119,16 @@ const GLTexture &TextureCLUT8GPU::getGLTexture() const {
 }
 
 void TextureCLUT8GPU::updateGLTexture() {
-	const bool needLookUp = Surface::isDirty() || _paletteDirty;
+	const bool needLookUp = Surface::isDirty() || isPaletteDirty();
 
 	// Update CLUT8 texture if necessary.
 	if (Surface::isDirty()) {
-		_clut8Texture.updateArea(getDirtyArea(), _clut8Data);
+		_clut8Texture.updateAreas(getDirtyRects(), _clut8Data);
 		clearDirty();
 	}
 
 	// Update palette if necessary.
-	if (_paletteDirty) {
+	if (isPaletteDirty()) {
 		Graphics::Surface palSurface;
 		palSurface.init(256, 1, 256, _palette,
 #ifdef SCUMM_LITTLE_ENDIAN
@@ -843,8 +1138,8 @@ void TextureCLUT8GPU::updateGLTexture() {
 #endif
 		               );
 
-		_paletteTexture.updateArea(Common::Rect(256, 1), palSurface);
-		_paletteDirty = false;
+		_paletteTexture.updateArea(Common::Rect(_paletteDirtyStart, 0, _paletteDirtyEnd, 1), palSurface);
+		_paletteDirtyStart = _paletteDirtyEnd = 0;
 	}
 
 	// In case any data changed, do color look up and store result in _target.
@@ -28,6 +28,8 @@
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
+#include "common/array.h"
+
 #include "common/rect.h"
 
 class Scaler;
@@ -110,10 +112,24 @@ public:
 	 * @param area     The area to update.
 	 * @param src      Surface for the whole texture containing the pixel data
 	 *                 to upload. Only the area described by area will be
-	 *                 uploaded.
+	 *                 uploaded, or the full lines it covers when the context
+	 *                 cannot upload with a pitch.
 	 */
 	void updateArea(const Common::Rect &area, const Graphics::Surface &src);
 
+	/**
+	 * Copy several areas of image data to the texture at once.
+	 *
+	 * With persistently mapped buffers all areas of one call share a
+	 * streaming buffer, so this should be preferred over calling
+	 * updateArea() for each of them.
+	 *
+	 * @param areas    The areas to update.
+	 * @param src      Surface for the whole texture containing the pixel data
+	 *                 to upload.
+	 */
+	void updateAreas(const Common::Array<Common::Rect> &areas, const Graphics::Surface &src);
+
 	/**
 	 * Query the GL texture's width.
 	 */
@@ -147,6 +163,13 @@ public:
 	 */
 	GLuint getGLTexture() const { return _glTexture; }
 private:
+	void uploadPixels(uint x, uint y, uint w, uint h, const void *pixels, uint size);
+#ifdef USE_GLAD
+	bool streamAreas(const Common::Array<Common::Rect> &areas, const Graphics::Surface &src);
+	bool createPixelBuffers(uint capacity);
+	void destroyPixelBuffers();
+#endif
+
 	const GLenum _glIntFormat;
 	const GLenum _glFormat;
 	const GLenum _glType;
@@ -158,6 +181,24 @@ private:
 	GLint _glFilter;
 
 	GLuint _glTexture;
+
+	// Uploads cycle through these so that a new one never has to wait
+	// for the GPU to finish reading the previous ones.
+	enum {
+		kPixelBufferCount = 3
+	};
+
+	GLuint _glPixelBuffers[kPixelBufferCount];
+	uint _curPixelBuffer;
+
+#ifdef USE_GLAD
+	// Persistent mappings of the pixel buffers and the fences of the
+	// uploads using them, see streamAreas().
+	void *_pixelBufferMappings[kPixelBufferCount];
+	GLsync _pixelBufferFences[kPixelBufferCount];
+	uint _pixelBufferCapacity;
+	bool _pixelBufferStreaming;
+#endif
 };
 
 /**
@@ -215,6 +256,17 @@ public:
 	 */
 	void copyRectToTexture(uint x, uint y, uint w, uint h, const void *src, uint srcPitch);
 
+	/**
+	 * Copy several areas of a full surface sized buffer into the texture.
+	 *
+	 * @param rects    Areas to copy; each is read from and written to the
+	 *                 same position.
+	 * @param count    Number of areas in rects.
+	 * @param src      Start of the source buffer, at position (0,0).
+	 * @param srcPitch Pitch of the source buffer.
+	 */
+	void copyRectsToTexture(const Common::Rect *rects, uint count, const void *src, uint srcPitch);
+
 	/**
 	 * Fill the surface with a fixed color.
 	 *
@@ -224,7 +276,7 @@ public:
 	void fill(const Common::Rect &r, uint32 color);
 
 	void flagDirty() { _allDirty = true; }
-	virtual bool isDirty() const { return _allDirty || !_dirtyArea.isEmpty(); }
+	virtual bool isDirty() const { return _allDirty || !_dirtyRects.empty(); }
 
 	virtual uint getWidth() const = 0;
 	virtual uint getHeight() const = 0;
@@ -264,13 +316,22 @@ public:
 	 */
 	virtual const GLTexture &getGLTexture() const = 0;
 protected:
-	void clearDirty() { _allDirty = false; _dirtyArea = Common::Rect(); }
+	void clearDirty() { _allDirty = false; _dirtyRects.clear(); }
 
 	void addDirtyArea(const Common::Rect &r);
-	Common::Rect getDirtyArea() const;
+
+	/**
+	 * Obtain the areas changed since the last clearDirty(). They might
+	 * overlap, but there are never more than kMaxDirtyRects of them.
+	 */
+	Common::Array<Common::Rect> getDirtyRects() const;
 private:
+	enum {
+		kMaxDirtyRects = 8
+	};
+
 	bool _allDirty;
-	Common::Rect _dirtyArea;
+	Common::Array<Common::Rect> _dirtyRects;
 };
 
 /**
@@ -314,7 +375,11 @@ public:
 protected:
 	const Graphics::PixelFormat _format;
 
-	void updateGLTexture(Common::Rect &dirtyArea);
+	/**
+	 * Upload areas of the texture data. This does not clear the dirty
+	 * state. The areas are extended when edge pixels are duplicated.
+	 */
+	void updateGLTexture(Common::Array<Common::Rect> &dirtyRects);
 
 private:
 	GLTexture _glTexture;
@@ -413,7 +478,7 @@ public:
 
 	void allocate(uint width, uint height) override;
 
-	bool isDirty() const override { return _paletteDirty || Surface::isDirty(); }
+	bool isDirty() const override { return isPaletteDirty() || Surface::isDirty(); }
 
 	uint getWidth() const override { return _userPixelData.w; }
 	uint getHeight() const override { return _userPixelData.h; }
@@ -439,6 +504,9 @@ public:
 private:
 	void lookUpColors();
 
+	bool isPaletteDirty() const { return _paletteDirtyStart < _paletteDirtyEnd; }
+	void flagPaletteDirty(uint start, uint end);
+
 	GLTexture _clut8Texture;
 	GLTexture _paletteTexture;
 
@@ -451,7 +519,13 @@ private:
 	Graphics::Surface _userPixelData;
 
 	byte _palette[4 * 256];
-	bool _paletteDirty;
+
+	/**
+	 * Range of palette entries which need to be uploaded. Only that part of
+	 * the palette texture is updated, so palette cycling does not need to
+	 * touch the game screen data at all.
+	 */
+	uint _paletteDirtyStart, _paletteDirtyEnd;
 };
 #endif // !USE_FORCED_GLES
 
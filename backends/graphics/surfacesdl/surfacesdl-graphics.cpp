@@ -137,6 +137,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_transactionMode(kTransactionNone),
 	_scalerPlugins(ScalerMan.getPlugins()), _scalerPlugin(nullptr), _scaler(nullptr),
 	_needRestoreAfterOverlay(false), _isInOverlayPalette(false), _isDoubleBuf(false), _prevForceRedraw(false), _numPrevDirtyRects(0),
+	_scalerSrcPitch(0), _scalerDstPitch(0),
 	_prevCursorNeedsRedraw(false),
 	_mouseKeyColor(0) {
 
@@ -1169,6 +1170,16 @@ void SurfaceSdlGraphicsManager::updateScreen() {
 	internUpdateScreen();
 }
 
+void SurfaceSdlGraphicsManager::scaleBandsProc(uint32 begin, uint32 end, void *refCon) {
+	SurfaceSdlGraphicsManager *manager = (SurfaceSdlGraphicsManager *)refCon;
+
+	for (uint32 i = begin; i < end; ++i) {
+		const ScalerBand &band = manager->_scalerBands[i];
+		manager->_scaler->scale(band.src, manager->_scalerSrcPitch, band.dst, manager->_scalerDstPitch,
+		                        band.width, band.height, band.x, band.y);
+	}
+}
+
 void SurfaceSdlGraphicsManager::updateScreen(SDL_Rect *dirtyRectList, int actualDirtyRects) {
 	SDL_UpdateRects(_hwScreen, actualDirtyRects, dirtyRectList);
 }
@@ -1355,6 +1366,16 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		srcPitch = srcSurf->pitch;
 		dstPitch = _hwScreen->pitch;
 
+		// Scalers only read the source around each pixel, so the dirty rects
+		// can be cut into bands and scaled in parallel with the same result.
+		// The old source tracking of SourceScaler and the aspect ratio stretch
+		// depend on the order in which the rects are drawn, so keep those serial.
+		Common::JobSystem *jobSystem = g_system->getJobSystem();
+		bool parallelScale = jobSystem->getWorkerCount() > 0 &&
+			(!_useOldSrc || scale1 == 1) &&
+			!(_videoMode.aspectRatioCorrection && !_overlayInGUI);
+		_scalerBands.clear();
+
 		for (r = _dirtyRectList; r != lastRect; ++r) {
 			int src_x = r->x;
 			int src_y = r->y;
@@ -1399,8 +1420,22 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				if (_videoMode.aspectRatioCorrection && !_overlayInGUI)
 					dst_y = real2Aspect(dst_y);
 
-				_scaler->scale((byte *)srcSurf->pixels + (src_x + _maxExtraPixels) * bpp + (src_y + _maxExtraPixels) * srcPitch, srcPitch,
-						(byte *)_hwScreen->pixels + dst_x * bpp + dst_y * dstPitch, dstPitch, dst_w, dst_h, src_x, src_y);
+				const byte *scaleSrc = (byte *)srcSurf->pixels + (src_x + _maxExtraPixels) * bpp + (src_y + _maxExtraPixels) * srcPitch;
+				byte *scaleDst = (byte *)_hwScreen->pixels + dst_x * bpp + dst_y * dstPitch;
+				if (parallelScale) {
+					for (int bandY = 0; bandY < dst_h; bandY += kScalerBandHeight) {
+						ScalerBand band;
+						band.src = scaleSrc + bandY * srcPitch;
+						band.dst = scaleDst + bandY * scale1 * dstPitch;
+						band.width = dst_w;
+						band.height = MIN<int>(kScalerBandHeight, dst_h - bandY);
+						band.x = src_x;
+						band.y = src_y + bandY;
+						_scalerBands.push_back(band);
+					}
+				} else {
+					_scaler->scale(scaleSrc, srcPitch, scaleDst, dstPitch, dst_w, dst_h, src_x, src_y);
+				}
 
 				r->x = dst_x;
 				r->y = dst_y;
@@ -1413,6 +1448,13 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 #endif
 			}
 		}
+
+		if (!_scalerBands.empty()) {
+			_scalerSrcPitch = srcPitch;
+			_scalerDstPitch = dstPitch;
+			jobSystem->parallelFor(_scalerBands.size(), scaleBandsProc, this);
+		}
+
 		SDL_UnlockSurface(srcSurf);
 		SDL_UnlockSurface(_hwScreen);
 
@@ -1669,6 +1711,50 @@ void SurfaceSdlGraphicsManager::copyRectToScreen(const void *buf, int pitch, int
 	SDL_UnlockSurface(_screen);
 }
 
+void SurfaceSdlGraphicsManager::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) {
+	assert(_transactionMode == kTransactionNone);
+	assert(buf);
+
+	if (_screen == nullptr) {
+		warning("SurfaceSdlGraphicsManager::copyRectsToScreen: _screen == NULL");
+		return;
+	}
+
+	Common::StackLock lock(_graphicsMutex);	// Lock the mutex until this function ends
+
+	// Try to lock the screen surface once for the whole batch
+	if (SDL_LockSurface(_screen) == -1)
+		error("SDL_LockSurface failed: %s", SDL_GetError());
+
+	const uint bytesPerPixel = _screenFormat.bytesPerPixel;
+	for (uint i = 0; i < count; ++i) {
+		const Common::Rect &r = rects[i];
+		int h = r.height();
+
+		assert(r.left >= 0 && r.left < _videoMode.screenWidth);
+		assert(r.top >= 0 && r.top < _videoMode.screenHeight);
+		assert(h > 0 && r.bottom <= _videoMode.screenHeight);
+		assert(r.width() > 0 && r.right <= _videoMode.screenWidth);
+
+		addDirtyRect(r.left, r.top, r.width(), h, false);
+
+		const byte *src = (const byte *)buf + r.top * pitch + r.left * bytesPerPixel;
+		byte *dst = (byte *)_screen->pixels + r.top * _screen->pitch + r.left * bytesPerPixel;
+		if (_videoMode.screenWidth == r.width() && pitch == _screen->pitch) {
+			memcpy(dst, src, h * pitch);
+		} else {
+			do {
+				memcpy(dst, src, r.width() * bytesPerPixel);
+				src += pitch;
+				dst += _screen->pitch;
+			} while (--h);
+		}
+	}
+
+	// Unlock the screen surface
+	SDL_UnlockSurface(_screen);
+}
+
 Graphics::Surface *SurfaceSdlGraphicsManager::lockScreen() {
 	assert(_transactionMode == kTransactionNone);
 
@@ -28,6 +28,7 @@
 #include "graphics/scaler.h"
 #include "graphics/scalerplugin.h"
 #include "common/events.h"
+#include "common/jobsystem.h"
 #include "common/mutex.h"
 
 #include "backends/events/sdl/sdl-events.h"
@@ -98,6 +99,7 @@ protected:
 	Graphics::PixelFormat convertSDLPixelFormat(SDL_PixelFormat *in) const;
 public:
 	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override;
+	void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) override;
 	Graphics::Surface *lockScreen() override;
 	void unlockScreen() override;
 	void fillScreen(uint32 col) override;
@@ -356,6 +358,23 @@ protected:
 	SDL_Rect _prevDirtyRectList[NUM_DIRTY_RECT];
 	int _numPrevDirtyRects;
 
+	enum {
+		kScalerBandHeight = 16
+	};
+
+	// Parts of the dirty rects scaled in parallel by internUpdateScreen()
+	struct ScalerBand {
+		const byte *src;
+		byte *dst;
+		int width, height;
+		int x, y;
+	};
+
+	Common::Array<ScalerBand> _scalerBands;
+	uint32 _scalerSrcPitch, _scalerDstPitch;
+
+	static void scaleBandsProc(uint32 begin, uint32 end, void *refCon);
+
 	struct MousePos {
 		// The size and hotspot of the original cursor image.
 		int16 w, h;
@@ -0,0 +1,199 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "backends/jobs/default/default-jobs.h"
+
+#include "common/textconsole.h"
+
+namespace {
+
+struct RangeJob {
+	Common::JobSystem::RangeProc proc;
+	void *refCon;
+	uint32 begin;
+	uint32 end;
+};
+
+void runRangeJob(void *refCon) {
+	RangeJob *job = (RangeJob *)refCon;
+	job->proc(job->begin, job->end, job->refCon);
+}
+
+} // End of anonymous namespace
+
+DefaultJobSystem::DefaultJobSystem() : _workerCount(0), _nextQueue(0), _quit(false) {
+}
+
+DefaultJobSystem::~DefaultJobSystem() {
+	assert(_workerCount == 0);
+}
+
+void DefaultJobSystem::startWorkers(uint count) {
+	assert(_workerCount == 0);
+
+	_queues.resize(count);
+	for (uint i = 0; i < count; ++i) {
+		if (!createWorkerThread(i)) {
+			warning("DefaultJobSystem: Could only start %d of %d worker threads", i, count);
+			break;
+		}
+		_workerCount++;
+	}
+	_queues.resize(_workerCount);
+}
+
+void DefaultJobSystem::stopWorkers() {
+	if (_workerCount == 0)
+		return;
+
+	lock();
+	_quit = true;
+	wakeAll();
+	unlock();
+
+	joinWorkerThreads();
+
+	// Workers drain their queues before quitting, so nothing can be left
+	for (uint i = 0; i < _queues.size(); ++i)
+		assert(_queues[i].empty());
+
+	_queues.clear();
+	_workerCount = 0;
+}
+
+void DefaultJobSystem::workerMain(uint index) {
+	lock();
+	for (;;) {
+		Job job;
+		if (popJob(index, job))
+			runJob(job);
+		else if (_quit)
+			break;
+		else
+			sleep();
+	}
+	unlock();
+}
+
+bool DefaultJobSystem::popJob(int index, Job &job) {
+	if (_queues.empty())
+		return false;
+
+	if (index >= 0 && !_queues[index].empty()) {
+		job = _queues[index].back();
+		_queues[index].pop_back();
+		return true;
+	}
+
+	uint start = (index >= 0) ? index + 1 : _nextQueue;
+	for (uint i = 0; i < _queues.size(); ++i) {
+		JobQueue &victim = _queues[(start + i) % _queues.size()];
+		if (!victim.empty()) {
+			job = victim.front();
+			victim.pop_front();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void DefaultJobSystem::runJob(const Job &job) {
+	unlock();
+	job.proc(job.refCon);
+	lock();
+
+	if (--pendingJobs(*job.group) == 0)
+		wakeAll();
+}
+
+void DefaultJobSystem::submit(Common::JobGroup &group, JobProc proc, void *refCon) {
+	if (_workerCount == 0) {
+		proc(refCon);
+		return;
+	}
+
+	Job job;
+	job.proc = proc;
+	job.refCon = refCon;
+	job.group = &group;
+
+	lock();
+	pendingJobs(group)++;
+	_queues[_nextQueue].push_back(job);
+	_nextQueue = (_nextQueue + 1) % _workerCount;
+	wakeOne();
+	unlock();
+}
+
+void DefaultJobSystem::wait(Common::JobGroup &group) {
+	lock();
+	while (pendingJobs(group) != 0) {
+		Job job;
+		if (popJob(-1, job))
+			runJob(job);
+		else
+			sleep();
+	}
+	unlock();
+}
+
+void DefaultJobSystem::waitWithoutHelping(Common::JobGroup &group) {
+	lock();
+	while (pendingJobs(group) != 0)
+		sleep();
+	unlock();
+}
+
+bool DefaultJobSystem::isDone(Common::JobGroup &group) {
+	lock();
+	bool done = (pendingJobs(group) == 0);
+	unlock();
+	return done;
+}
+
+void DefaultJobSystem::parallelFor(uint32 count, RangeProc proc, void *refCon, uint32 grain) {
+	if (grain == 0)
+		grain = 1;
+
+	uint32 slices = MIN<uint32>(_workerCount + 1, (count + grain - 1) / grain);
+	if (slices <= 1) {
+		if (count)
+			proc(0, count, refCon);
+		return;
+	}
+
+	Common::Array<RangeJob> jobs(slices);
+	for (uint32 i = 0; i < slices; ++i) {
+		jobs[i].proc = proc;
+		jobs[i].refCon = refCon;
+		jobs[i].begin = (uint32)((uint64)count * i / slices);
+		jobs[i].end = (uint32)((uint64)count * (i + 1) / slices);
+	}
+
+	// The calling thread takes the first slice itself
+	Common::JobGroup group;
+	for (uint32 i = 1; i < slices; ++i)
+		submit(group, runRangeJob, &jobs[i]);
+
+	runRangeJob(&jobs[0]);
+	wait(group);
+}
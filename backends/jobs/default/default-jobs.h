@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_JOBS_DEFAULT_H
+#define BACKENDS_JOBS_DEFAULT_H
+
+#include "common/array.h"
+#include "common/jobsystem.h"
+#include "common/list.h"
+
+/**
+ * Work-stealing thread pool built on a handful of threading primitives
+ * supplied by the backend.
+ *
+ * Every worker owns a queue. Jobs are dealt to the queues in turn; a worker
+ * takes the most recent job of its own queue and, once that runs dry,
+ * steals the oldest job of another worker. Threads waiting on a group
+ * steal as well, so the caller is never idle while its jobs are pending.
+ */
+class DefaultJobSystem : public Common::JobSystem {
+public:
+	DefaultJobSystem();
+	~DefaultJobSystem() override;
+
+	uint getWorkerCount() const override { return _workerCount; }
+
+	void submit(Common::JobGroup &group, JobProc proc, void *refCon) override;
+	void wait(Common::JobGroup &group) override;
+	void waitWithoutHelping(Common::JobGroup &group) override;
+	bool isDone(Common::JobGroup &group) override;
+	void parallelFor(uint32 count, RangeProc proc, void *refCon, uint32 grain = 1) override;
+
+protected:
+	/**
+	 * Spawn @p count worker threads. To be called by the subclass
+	 * constructor once its primitives are set up.
+	 */
+	void startWorkers(uint count);
+
+	/**
+	 * Ask all workers to quit and join them. Must be called by the subclass
+	 * destructor, before its primitives are torn down.
+	 */
+	void stopWorkers();
+
+	/**
+	 * Body of the worker threads; @p index goes from 0 to count - 1.
+	 */
+	void workerMain(uint index);
+
+	/** Create a thread which calls workerMain(index). */
+	virtual bool createWorkerThread(uint index) = 0;
+	/** Wait for all threads started by createWorkerThread() to exit. */
+	virtual void joinWorkerThreads() = 0;
+
+	virtual void lock() = 0;
+	virtual void unlock() = 0;
+	/** Release the lock, sleep until woken up, and reacquire the lock. */
+	virtual void sleep() = 0;
+	virtual void wakeOne() = 0;
+	virtual void wakeAll() = 0;
+
+private:
+	struct Job {
+		JobProc proc;
+		void *refCon;
+		Common::JobGroup *group;
+	};
+
+	typedef Common::List<Job> JobQueue;
+
+	Common::Array<JobQueue> _queues;
+	uint _workerCount;
+	uint _nextQueue;
+	bool _quit;
+
+	/** Grab a job for worker @p index, or for a waiting thread if it is -1. Lock must be held. */
+	bool popJob(int index, Job &job);
+	/** Run a job popped with popJob(). Lock must be held, and is released while running. */
+	void runJob(const Job &job);
+};
+
+#endif
@@ -0,0 +1,110 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/jobs/sdl/sdl-jobs.h"
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+#include <SDL_cpuinfo.h>
+#endif
+
+// Leave some headroom for the audio and timer threads on many-core hosts
+static const int kMaxWorkerThreads = 15;
+
+SdlJobSystem::SdlJobSystem() {
+	_mutex = SDL_CreateMutex();
+	_cond = SDL_CreateCond();
+
+	int cores = 1;
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	cores = SDL_GetCPUCount();
+#endif
+	if (!_mutex || !_cond || cores <= 1)
+		return;
+
+	// One worker per extra core, the calling thread is the last one
+	uint count = MIN(cores - 1, kMaxWorkerThreads);
+	_threads.resize(count);
+	for (uint i = 0; i < count; ++i)
+		_threads[i].thread = nullptr;
+
+	startWorkers(count);
+}
+
+SdlJobSystem::~SdlJobSystem() {
+	stopWorkers();
+
+	if (_cond)
+		SDL_DestroyCond(_cond);
+	if (_mutex)
+		SDL_DestroyMutex(_mutex);
+}
+
+int SDLCALL SdlJobSystem::workerThreadFunc(void *data) {
+	WorkerThread *worker = (WorkerThread *)data;
+	worker->system->workerMain(worker->index);
+	return 0;
+}
+
+bool SdlJobSystem::createWorkerThread(uint index) {
+	WorkerThread &worker = _threads[index];
+	worker.system = this;
+	worker.index = index;
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	worker.thread = SDL_CreateThread(workerThreadFunc, "ScummVM worker", &worker);
+#else
+	worker.thread = SDL_CreateThread(workerThreadFunc, &worker);
+#endif
+	return worker.thread != nullptr;
+}
+
+void SdlJobSystem::joinWorkerThreads() {
+	for (uint i = 0; i < _threads.size(); ++i) {
+		if (_threads[i].thread)
+			SDL_WaitThread(_threads[i].thread, nullptr);
+	}
+	_threads.clear();
+}
+
+void SdlJobSystem::lock() {
+	SDL_mutexP(_mutex);
+}
+
+void SdlJobSystem::unlock() {
+	SDL_mutexV(_mutex);
+}
+
+void SdlJobSystem::sleep() {
+	SDL_CondWait(_cond, _mutex);
+}
+
+void SdlJobSystem::wakeOne() {
+	SDL_CondSignal(_cond);
+}
+
+void SdlJobSystem::wakeAll() {
+	SDL_CondBroadcast(_cond);
+}
+
+#endif
@@ -0,0 +1,60 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_JOBS_SDL_H
+#define BACKENDS_JOBS_SDL_H
+
+#include "backends/jobs/default/default-jobs.h"
+#include "backends/platform/sdl/sdl-sys.h"
+
+/**
+ * SDL job system, running one worker per extra CPU core.
+ */
+class SdlJobSystem final : public DefaultJobSystem {
+public:
+	SdlJobSystem();
+	~SdlJobSystem() override;
+
+protected:
+	bool createWorkerThread(uint index) override;
+	void joinWorkerThreads() override;
+
+	void lock() override;
+	void unlock() override;
+	void sleep() override;
+	void wakeOne() override;
+	void wakeAll() override;
+
+private:
+	struct WorkerThread {
+		SdlJobSystem *system;
+		uint index;
+		SDL_Thread *thread;
+	};
+
+	SDL_mutex *_mutex;
+	SDL_cond *_cond;
+	Common::Array<WorkerThread> _threads;
+
+	static int SDLCALL workerThreadFunc(void *data);
+};
+
+#endif
@@ -26,6 +26,7 @@
 #include "backends/mixer/mixer.h"
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/timer.h"
 #include "graphics/pixelformat.h"
 
@@ -161,6 +162,10 @@ void ModularGraphicsBackend::copyRectToScreen(const void *buf, int pitch, int x,
 	_graphicsManager->copyRectToScreen(buf, pitch, x, y, w, h);
 }
 
+void ModularGraphicsBackend::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) {
+	_graphicsManager->copyRectsToScreen(buf, pitch, rects, count);
+}
+
 Graphics::Surface *ModularGraphicsBackend::lockScreen() {
 	return _graphicsManager->lockScreen();
 }
@@ -184,11 +189,17 @@ void ModularGraphicsBackend::updateScreen() {
 	g_eventRec.preDrawOverlayGui();
 #endif
 
-	_graphicsManager->updateScreen();
+	{
+		PROFILE_ZONE("Present");
+		_graphicsManager->updateScreen();
+	}
 
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.postDrawOverlayGui();
 #endif
+
+	if (Common::Profiler::isEnabled())
+		ProfMan.endFrame();
 }
 
 void ModularGraphicsBackend::setShakePos(int shakeXOffset, int shakeYOffset) {
@@ -93,6 +93,7 @@ public:
 	int16 getWidth() override final;
 	PaletteManager *getPaletteManager() override final;
 	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override final;
+	void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) override final;
 	Graphics::Surface *lockScreen() override final;
 	void unlockScreen() override final;
 	void fillScreen(uint32 col) override final;
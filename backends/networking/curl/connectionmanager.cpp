@@ -41,9 +41,39 @@ DECLARE_SINGLETON(Networking::ConnectionManager);
 
 namespace Networking {
 
-ConnectionManager::ConnectionManager(): _multi(nullptr), _timerStarted(false), _frame(0) {
+static void lockShare(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr) {
+	((Common::Mutex *)userptr)->lock();
+}
+
+static void unlockShare(CURL *handle, curl_lock_data data, void *userptr) {
+	((Common::Mutex *)userptr)->unlock();
+}
+
+ConnectionManager::ConnectionManager(): _multi(nullptr), _share(nullptr), _timerStarted(false), _frame(0) {
 	curl_global_init(CURL_GLOBAL_ALL);
 	_multi = curl_multi_init();
+
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// Added in libcurl 7.43.0, and the default since 7.62.0
+	curl_multi_setopt(_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
+
+	// The multi handle keeps the connections of its transfers alive for
+	// reuse, but TLS sessions are only resumed by other transfers when
+	// they are in a share handle. The easy handles might be cleaned up
+	// on other threads than the one running the transfers, so the share
+	// is locked. Common::Mutex is recursive, so a single one is enough.
+	_share = curl_share_init();
+	if (_share) {
+		curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, lockShare);
+		curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+		curl_share_setopt(_share, CURLSHOPT_USERDATA, &_shareMutex);
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+#if LIBCURL_VERSION_NUM >= 0x071700
+		// Implemented in libcurl 7.23.0
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#endif
+	}
 }
 
 ConnectionManager::~ConnectionManager() {
@@ -82,12 +112,25 @@ ConnectionManager::~ConnectionManager() {
 
 	//cleanup
 	curl_multi_cleanup(_multi);
+	if (_share)
+		curl_share_cleanup(_share);
 	curl_global_cleanup();
 	_multi = nullptr;
+	_share = nullptr;
 	_handleMutex.unlock();
 }
 
 void ConnectionManager::registerEasyHandle(CURL *easy) const {
+	if (_share)
+		curl_easy_setopt(easy, CURLOPT_SHARE, _share);
+#if LIBCURL_VERSION_NUM >= 0x072F00
+	// Added in libcurl 7.47.0, and the default since 7.62.0
+	curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// Added in libcurl 7.43.0: wait for a connection to multiplex on instead of opening another one
+	curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+#endif
 	curl_multi_add_handle(_multi, easy);
 }
 
@@ -229,6 +272,19 @@ void ConnectionManager::interateRequests() {
 void ConnectionManager::processTransfers() {
 	if (!_multi) return;
 
+#if LIBCURL_VERSION_NUM >= 0x071C00
+	// Only let libcurl do its work when one of its sockets has something
+	// to do or one of its timeouts has expired. Waiting for the sockets is
+	// left to the next frame, as the timer thread must not block.
+	long timeout = -1;
+	curl_multi_timeout(_multi, &timeout);
+	if (timeout != 0) {
+		int socketsReady = 0;
+		if (curl_multi_wait(_multi, nullptr, 0, 0, &socketsReady) == CURLM_OK && socketsReady == 0)
+			return;
+	}
+#endif
+
 	//check libcurl's transfers and notify requests of messages from queue (transfer completion or failure)
 	int transfersRunning;
 	curl_multi_perform(_multi, &transfersRunning);
@@ -30,6 +30,7 @@
 
 typedef void CURL;
 typedef void CURLM;
+typedef void CURLSH;
 struct curl_slist;
 
 namespace Networking {
@@ -75,9 +76,10 @@ class ConnectionManager : public Common::Singleton<ConnectionManager> {
 	};
 
 	CURLM *_multi;
+	CURLSH *_share;
 	bool _timerStarted;
 	Common::Array<RequestWithCallback> _requests, _addedRequests;
-	Common::Mutex _handleMutex, _addedRequestsMutex;
+	Common::Mutex _handleMutex, _addedRequestsMutex, _shareMutex;
 	uint32 _frame;
 
 	void startTimer(int interval = TIMER_INTERVAL);
@@ -95,6 +97,10 @@ public:
 	 * All libcurl transfers are going through this ConnectionManager.
 	 * So, if you want to start any libcurl transfer, you must create
 	 * an easy handle and register it using this method.
+	 *
+	 * The handle is made to share the DNS and TLS session caches
+	 * with the other transfers, and to multiplex its requests over
+	 * HTTP/2 connections to the same host, where possible.
 	 */
 	void registerEasyHandle(CURL *easy) const;
 
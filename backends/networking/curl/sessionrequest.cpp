@@ -45,6 +45,7 @@ SessionRequest::SessionRequest(const Common::String &url, const Common::Path &lo
 }
 
 SessionRequest::~SessionRequest() {
+	delete _localFile;
 	delete[] _buffer;
 }
 
@@ -99,6 +100,14 @@ char *SessionRequest::getPreparedContents() {
 void SessionRequest::finishError(const ErrorResponse &error, RequestState state) {
 	_complete = true;
 	_success = false;
+
+	// keep what was downloaded so far, so that it could be resumed
+	if (_localFile) {
+		_localFile->close();
+		delete _localFile;
+		_localFile = nullptr;
+	}
+
 	CurlRequest::finishError(error, PAUSED);
 }
 
@@ -158,7 +167,8 @@ void SessionRequest::handle() {
 	if (!_stream) _stream = makeStream();
 
 	if (_stream) {
-		if (_stream->httpResponseCode() != 200 && _stream->httpResponseCode() != 0) {
+		// 206 Partial Content is the answer to requests with a Range header
+		if (_stream->httpResponseCode() != 200 && _stream->httpResponseCode() != 206 && _stream->httpResponseCode() != 0) {
 			warning("SessionRequest: HTTP response code is not 200 OK (it's %ld)", _stream->httpResponseCode());
 			ErrorResponse error(this, false, true, "HTTP response code is not 200 OK", _stream->httpResponseCode());
 			finishError(error);
@@ -182,6 +192,10 @@ void SessionRequest::handle() {
 
 				if (_callback)
 					(*_callback)(DataResponse(this, &_response));
+
+				// the callback might have closed the request
+				if (_state == FINISHED)
+					return;
 			}
 		}
 
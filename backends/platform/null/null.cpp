@@ -84,8 +84,16 @@ public:
 
 	virtual bool pollEvent(Common::Event &event);
 
+#ifdef NULL_DRIVER_USE_FOR_TEST
+	virtual bool hasFeature(Feature f);
+
+	/** Replace the job system, for testing code which runs jobs. */
+	void setJobSystem(Common::JobSystem *jobSystem);
+#endif
+
 	virtual Common::MutexInternal *createMutex();
 	virtual uint32 getMillis(bool skipRecord = false);
+	virtual uint64 getMicros();
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &td, bool skipRecord = false) const;
 
@@ -205,6 +213,18 @@ uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #endif
 }
 
+uint64 OSystem_NULL::getMicros() {
+#ifdef POSIX
+	timeval curTime;
+
+	gettimeofday(&curTime, 0);
+
+	return (uint64)curTime.tv_sec * 1000000 + curTime.tv_usec;
+#else
+	return OSystem::getMicros();
+#endif
+}
+
 void OSystem_NULL::delayMillis(uint msecs) {
 #ifdef POSIX
 	usleep(msecs * 1000);
@@ -45,6 +45,7 @@
 #include "backends/events/default/default-events.h"
 #include "backends/events/sdl/legacy-sdl-events.h"
 #include "backends/keymapper/hardware-input.h"
+#include "backends/jobs/sdl/sdl-jobs.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
@@ -130,6 +131,8 @@ OSystem_SDL::~OSystem_SDL() {
 	_audiocdManager = nullptr;
 	delete _mixerManager;
 	_mixerManager = nullptr;
+	delete _jobSystem;
+	_jobSystem = nullptr;
 
 #ifdef ENABLE_EVENTRECORDER
 	// HACK HACK HACK
@@ -322,6 +325,9 @@ void OSystem_SDL::initBackend() {
 		_timerManager = new SdlTimerManager();
 #endif
 
+	if (_jobSystem == nullptr)
+		_jobSystem = new SdlJobSystem();
+
 	_audiocdManager = createAudioCDManager();
 
 	// Setup a custom program icon.
@@ -734,6 +740,16 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+uint64 OSystem_SDL::getMicros() {
+	static const uint64 frequency = SDL_GetPerformanceFrequency();
+	const uint64 counter = SDL_GetPerformanceCounter();
+
+	// Split the conversion so that it doesn't overflow
+	return (counter / frequency) * 1000000 + (counter % frequency) * 1000000 / frequency;
+}
+#endif
+
 void OSystem_SDL::delayMillis(uint msecs) {
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processDelayMillis())
@@ -741,6 +757,19 @@ void OSystem_SDL::delayMillis(uint msecs) {
 		SDL_Delay(msecs);
 }
 
+void OSystem_SDL::waitForEvent(uint msecs) {
+#ifdef ENABLE_EVENTRECORDER
+	if (g_eventRec.processDelayMillis())
+		return;
+#endif
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	// Leaves the event in the queue for the event source
+	SDL_WaitEventTimeout(nullptr, msecs);
+#else
+	SDL_Delay(msecs);
+#endif
+}
+
 void OSystem_SDL::getTimeAndDate(TimeDate &td, bool skipRecord) const {
 	time_t curTime = time(nullptr);
 	struct tm t = *localtime(&curTime);
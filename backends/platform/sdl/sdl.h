@@ -84,7 +84,11 @@ public:
 	void addSysArchivesToSearchSet(Common::SearchSet &s, int priority = 0) override;
 	Common::MutexInternal *createMutex() override;
 	uint32 getMillis(bool skipRecord = false) override;
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	uint64 getMicros() override;
+#endif
 	void delayMillis(uint msecs) override;
+	void waitForEvent(uint msecs) override;
 	void getTimeAndDate(TimeDate &td, bool skipRecord = false) const override;
 	MixerManager *getMixerManager() override;
 	Common::TimerManager *getTimerManager() override;
@@ -37,6 +37,8 @@
 #include "common/archive.h"
 #include "common/config-manager.h"
 #include "common/compression/deflate.h"
+#include "common/memstream.h"
+#include "common/textconsole.h"
 
 #include <errno.h>	// for removeSavefile()
 
@@ -44,13 +46,55 @@
 const char *const DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+const char *const DefaultSaveFileManager::INDEX_FILENAME = ".saveindex";
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _metaDataLoaded(false), _metaDataChanged(false) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) : _metaDataLoaded(false), _metaDataChanged(false) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	if (!_pendingSaves.empty())
+		checkPendingSaves(true);
+
+	saveMetaDataIndex();
+}
+
+/**
+ * Save file which keeps the data in memory, and passes it to the
+ * DefaultSaveFileManager to be written in the background once finalized.
+ */
+class AsyncSaveFile : public Common::OutSaveFile {
+public:
+	AsyncSaveFile(DefaultSaveFileManager *manager, const Common::String &filename, const Common::FSNode &fileNode, bool compress) :
+		Common::OutSaveFile(new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO)),
+		_manager(manager), _filename(filename), _fileNode(fileNode), _compress(compress), _finalized(false) {}
+
+	~AsyncSaveFile() override {
+		if (!_finalized)
+			free(getStream()->getData());
+	}
+
+	void finalize() override {
+		if (_finalized)
+			return;
+
+		_finalized = true;
+		_manager->queueSave(_filename, _fileNode, getStream()->getData(), getStream()->size(), _compress);
+	}
+
+private:
+	Common::MemoryWriteStreamDynamic *getStream() const { return (Common::MemoryWriteStreamDynamic *)_wrapped; }
+
+	DefaultSaveFileManager *_manager;
+	Common::String _filename;
+	Common::FSNode _fileNode;
+	bool _compress;
+	bool _finalized;
+};
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -69,6 +113,10 @@ void DefaultSaveFileManager::updateSavefilesList(Common::StringArray &lockedFile
 
 	//remember the locked files list because some of these files don't exist yet
 	_lockedFiles = lockedFiles;
+
+	//these files are being downloaded, so their metadata is about to change
+	for (Common::StringArray::const_iterator i = _lockedFiles.begin(), end = _lockedFiles.end(); i != end; ++i)
+		dropMetaData(*i);
 }
 
 Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &pattern) {
@@ -92,6 +140,8 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &filename) {
+	waitForPendingSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -108,6 +158,8 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	waitForPendingSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -129,16 +181,19 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 	}
 }
 
-Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+bool DefaultSaveFileManager::getNodeForSaving(const Common::String &filename, Common::FSNode &fileNode) {
+	waitForPendingSave(filename);
+	dropMetaData(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	const Common::Path savePathName = getSavePath();
 	assureCached(savePathName);
 	if (getError().getCode() != Common::kNoError)
-		return nullptr;
+		return false;
 
 	for (Common::StringArray::const_iterator i = _lockedFiles.begin(), end = _lockedFiles.end(); i != end; ++i) {
 		if (filename == *i) {
-			return nullptr; //file is locked, no saving available
+			return false; //file is locked, no saving available
 		}
 	}
 
@@ -151,7 +206,6 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 
 	// Obtain node.
 	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
-	Common::FSNode fileNode;
 
 	// If the file did not exist before, we add it to the cache.
 	if (file == _saveFileCache.end()) {
@@ -161,6 +215,14 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 		fileNode = file->_value;
 	}
 
+	return true;
+}
+
+Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	Common::FSNode fileNode;
+	if (!getNodeForSaving(filename, fileNode))
+		return nullptr;
+
 	// Open the file for saving.
 	Common::SeekableWriteStream *const sf = fileNode.createWriteStream();
 	if (!sf)
@@ -173,7 +235,96 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	return result;
 }
 
+Common::OutSaveFile *DefaultSaveFileManager::openForSavingAsync(const Common::String &filename, bool compress) {
+	Common::FSNode fileNode;
+	if (!getNodeForSaving(filename, fileNode))
+		return nullptr;
+
+	// The file is only created once the data has been collected, but it
+	// has to be listed right away
+	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
+
+	return new AsyncSaveFile(this, filename, fileNode, compress);
+}
+
+void DefaultSaveFileManager::queueSave(const Common::String &filename, const Common::FSNode &fileNode, byte *data, uint32 size, bool compress) {
+	waitForPendingSave(filename);
+
+	// The old file could have been listed since it was opened
+	dropMetaData(filename);
+
+	PendingSave *save = new PendingSave();
+	save->name = filename;
+	save->node = fileNode;
+	save->data = data;
+	save->size = size;
+	save->compress = compress;
+	save->success = false;
+	_pendingSaves.push_back(save);
+
+	g_system->getJobSystem()->submit(save->group, writePendingSave, save);
+}
+
+void DefaultSaveFileManager::writePendingSave(void *refCon) {
+	PendingSave *save = (PendingSave *)refCon;
+
+	Common::SeekableWriteStream *const sf = save->node.createWriteStream();
+	if (sf) {
+		Common::WriteStream *stream = save->compress ? Common::wrapCompressedWriteStream(sf) : sf;
+		stream->write(save->data, save->size);
+		stream->finalize();
+		save->success = !stream->err();
+		delete stream;
+	}
+
+	free(save->data);
+	save->data = nullptr;
+}
+
+void DefaultSaveFileManager::waitForPendingSave(const Common::String &filename) {
+	for (uint i = 0; i < _pendingSaves.size(); i++) {
+		if (_pendingSaves[i]->name.equalsIgnoreCase(filename))
+			g_system->getJobSystem()->wait(_pendingSaves[i]->group);
+	}
+}
+
+bool DefaultSaveFileManager::checkPendingSaves(bool wait) {
+	if (_pendingSaves.empty())
+		return true;
+
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	bool success = true;
+
+	for (uint i = 0; i < _pendingSaves.size();) {
+		PendingSave *save = _pendingSaves[i];
+		if (wait) {
+			jobSystem->wait(save->group);
+		} else if (!jobSystem->isDone(save->group)) {
+			i++;
+			continue;
+		}
+
+		if (save->success) {
+#if defined(USE_CLOUD) && defined(USE_LIBCURL)
+			CloudMan.syncSaves();
+#endif
+		} else {
+			warning("Failed to write savefile '%s'", save->name.c_str());
+			setError(Common::kWritingFailed, "Failed to write savefile '" + save->name + "'");
+			success = false;
+		}
+
+		delete save;
+		_pendingSaves.remove_at(i);
+	}
+
+	return success;
+}
+
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	waitForPendingSave(filename);
+	dropMetaData(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -233,6 +384,90 @@ bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	return _saveFileCache.contains(filename);
 }
 
+bool DefaultSaveFileManager::getMetaData(const Common::String &filename, Common::Array<byte> &data) {
+	loadMetaDataIndex();
+
+	MetaDataIndex::const_iterator entry = _metaDataIndex.find(filename);
+	if (entry == _metaDataIndex.end())
+		return false;
+
+	data = entry->_value;
+	return true;
+}
+
+void DefaultSaveFileManager::setMetaData(const Common::String &filename, const byte *data, uint32 size) {
+	loadMetaDataIndex();
+
+	// The index is written when the save directory changes or when the
+	// manager is destroyed, a missing entry only costs a look at the file
+	_metaDataIndex[filename] = Common::Array<byte>(data, size);
+	_metaDataChanged = true;
+}
+
+void DefaultSaveFileManager::dropMetaData(const Common::String &filename) {
+	loadMetaDataIndex();
+
+	// A stale entry would describe the wrong save, so the index is written
+	// right away
+	MetaDataIndex::iterator entry = _metaDataIndex.find(filename);
+	if (entry != _metaDataIndex.end()) {
+		_metaDataIndex.erase(entry);
+		_metaDataChanged = true;
+		saveMetaDataIndex();
+	}
+}
+
+void DefaultSaveFileManager::loadMetaDataIndex() {
+	const Common::Path savePathName = getSavePath();
+	if (_metaDataLoaded && _metaDataDirectory == savePathName)
+		return;
+
+	saveMetaDataIndex();
+	_metaDataIndex.clear();
+	_metaDataDirectory = savePathName;
+	_metaDataLoaded = true;
+
+	Common::ScopedPtr<Common::SeekableReadStream> file(Common::FSNode(savePathName).getChild(INDEX_FILENAME).createReadStream());
+	if (!file || file->readUint32BE() != MKTAG('S', 'V', 'M', 'I') || file->readUint32LE() != 1)
+		return;
+
+	const uint32 count = file->readUint32LE();
+	for (uint32 i = 0; i < count && !file->eos() && !file->err(); i++) {
+		const Common::String filename = file->readString(0, file->readUint32LE());
+		Common::Array<byte> data;
+		data.resize(file->readUint32LE());
+		if (!data.empty())
+			file->read(&data[0], data.size());
+		if (file->eos() || file->err())
+			break;
+		_metaDataIndex[filename] = data;
+	}
+}
+
+void DefaultSaveFileManager::saveMetaDataIndex() {
+	if (!_metaDataChanged)
+		return;
+
+	_metaDataChanged = false;
+	Common::ScopedPtr<Common::SeekableWriteStream> file(Common::FSNode(_metaDataDirectory).getChild(INDEX_FILENAME).createWriteStream());
+	if (!file) {
+		warning("DefaultSaveFileManager: failed to write the save index '%s'", INDEX_FILENAME);
+		return;
+	}
+
+	file->writeUint32BE(MKTAG('S', 'V', 'M', 'I'));
+	file->writeUint32LE(1);
+	file->writeUint32LE(_metaDataIndex.size());
+	for (MetaDataIndex::const_iterator entry = _metaDataIndex.begin(); entry != _metaDataIndex.end(); ++entry) {
+		file->writeUint32LE(entry->_key.size());
+		file->writeString(entry->_key);
+		file->writeUint32LE(entry->_value.size());
+		if (!entry->_value.empty())
+			file->write(&entry->_value[0], entry->_value.size());
+	}
+	file->finalize();
+}
+
 Common::Path DefaultSaveFileManager::getSavePath() const {
 
 	Common::Path dir;
@@ -284,6 +519,10 @@ void DefaultSaveFileManager::assureCached(const Common::Path &savePathName) {
 
 	// Build the savefile name cache.
 	for (Common::FSList::const_iterator file = children.begin(), end = children.end(); file != end; ++file) {
+		// The metadata index is not a save file
+		if (file->getName() == INDEX_FILENAME)
+			continue;
+
 		if (_saveFileCache.contains(file->getName())) {
 			warning("DefaultSaveFileManager::assureCached: Name clash when building cache, ignoring file '%s'", file->getName().c_str());
 		} else {
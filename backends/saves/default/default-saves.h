@@ -23,6 +23,8 @@
 #define BACKEND_SAVES_DEFAULT_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/jobsystem.h"
 #include "common/savefile.h"
 #include "common/str.h"
 #include "common/fs.h"
@@ -35,14 +37,21 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::Path &defaultSavepath);
+	~DefaultSaveFileManager() override;
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
 	Common::InSaveFile *openRawFile(const Common::String &filename) override;
 	Common::InSaveFile *openForLoading(const Common::String &filename) override;
 	Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true) override;
+	Common::OutSaveFile *openForSavingAsync(const Common::String &filename, bool compress = true) override;
+	bool checkPendingSaves(bool wait = false) override;
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
+	bool getMetaData(const Common::String &filename, Common::Array<byte> &data) override;
+	void setMetaData(const Common::String &filename, const byte *data, uint32 size) override;
+
+	static const char *const INDEX_FILENAME;
 
 #ifdef USE_LIBCURL
 
@@ -82,6 +91,24 @@ protected:
 	 */
 	void assureCached(const Common::Path &savePathName);
 
+	/**
+	 * Get the node to write the given save file to, after checking that
+	 * it may be written.
+	 *
+	 * @return False if the save file cannot be saved.
+	 */
+	bool getNodeForSaving(const Common::String &filename, Common::FSNode &fileNode);
+
+	/**
+	 * Wait until the given save file is not being written in the background.
+	 */
+	void waitForPendingSave(const Common::String &filename);
+
+	/**
+	 * Drop the metadata of the given save file, because it is changing.
+	 */
+	void dropMetaData(const Common::String &filename);
+
 	typedef Common::HashMap<Common::String, Common::FSNode, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveFileCache;
 
 	/**
@@ -100,6 +127,56 @@ protected:
 	Common::StringArray _lockedFiles;
 
 private:
+	friend class AsyncSaveFile;
+
+	/**
+	 * Save file which is compressed and written on a worker thread.
+	 */
+	struct PendingSave {
+		Common::String name;
+		Common::FSNode node;
+		byte *data;
+		uint32 size;
+		bool compress;
+		bool success;
+		Common::JobGroup group;
+	};
+
+	static void writePendingSave(void *refCon);
+
+	/**
+	 * Start writing the data of a finalized AsyncSaveFile. This takes
+	 * ownership of the data.
+	 */
+	void queueSave(const Common::String &filename, const Common::FSNode &fileNode, byte *data, uint32 size, bool compress);
+
+	/**
+	 * The save files being written in the background.
+	 */
+	Common::Array<PendingSave *> _pendingSaves;
+
+	typedef Common::HashMap<Common::String, Common::Array<byte>, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> MetaDataIndex;
+
+	/**
+	 * Load the metadata index of the current save directory, after writing
+	 * the one of the previous directory if it changed.
+	 */
+	void loadMetaDataIndex();
+
+	/**
+	 * Write the metadata index to its save directory if it changed.
+	 */
+	void saveMetaDataIndex();
+
+	/**
+	 * Metadata of the save files in _metaDataDirectory, which is kept in the
+	 * INDEX_FILENAME file in that directory.
+	 */
+	MetaDataIndex _metaDataIndex;
+	Common::Path _metaDataDirectory;
+	bool _metaDataLoaded;
+	bool _metaDataChanged;
+
 	/**
 	 * The currently cached directory.
 	 */
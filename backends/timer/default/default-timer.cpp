@@ -32,51 +32,78 @@ struct TimerSlot {
 
 	uint32 nextFireTime;	// in milliseconds
 	uint32 nextFireTimeMicro;	// microseconds part of nextFire
+	uint32 wheelTime;	// the millisecond it's handled in, not before the next one to handle
 
 	TimerSlot *next;
 
-	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0), next(nullptr) {}
+	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0), wheelTime(0), next(nullptr) {}
 };
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
+static void appendSlot(TimerSlot *&head, TimerSlot *&tail, TimerSlot *slot) {
+	// The slots due in the same millisecond fire in the order they were scheduled
+	slot->next = nullptr;
+	if (tail)
+		tail->next = slot;
+	else
+		head = slot;
+	tail = slot;
+}
 
-	const uint32 nextFireTime = newSlot->nextFireTime;
+static void removeSlots(TimerSlot *&head, TimerSlot *&tail, Common::TimerManager::TimerProc callback) {
+	TimerSlot *prev = nullptr;
 	TimerSlot *slot = head;
-	newSlot->next = nullptr;
-
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == nullptr || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
+	while (slot) {
+		TimerSlot *next = slot->next;
+		if (slot->callback == callback) {
+			if (prev)
+				prev->next = next;
+			else
+				head = next;
+			if (tail == slot)
+				tail = prev;
+			delete slot;
+		} else {
+			prev = slot;
 		}
-		slot = slot->next;
+		slot = next;
 	}
 }
 
 
 DefaultTimerManager::DefaultTimerManager() :
 	_timerCallbackNext(0),
-	_head(nullptr) {
-
-	_head = new TimerSlot();
+	_wheel(nullptr),
+	_nextTick(g_system ? g_system->getMillis(true) : 0),
+	_numSlots(0) {
+
+	_wheel = new SlotList[kWheelSize];
+	for (uint32 i = 0; i < kWheelSize; i++)
+		_wheel[i].head = _wheel[i].tail = nullptr;
+	_firing.head = _firing.tail = nullptr;
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
+	for (uint32 i = 0; i <= kWheelSize; i++) {
+		TimerSlot *slot = (i < kWheelSize) ? _wheel[i].head : _firing.head;
+		while (slot) {
+			TimerSlot *next = slot->next;
+			delete slot;
+			slot = next;
+		}
 	}
-	_head = nullptr;
+	delete[] _wheel;
+	_wheel = nullptr;
+}
+
+void DefaultTimerManager::schedule(TimerSlot *slot) {
+	// Timers which are already due are handled in the next millisecond
+	// to handle, which might be the one being handled right now
+	slot->wheelTime = ((int32)(slot->nextFireTime - _nextTick) < 0) ? _nextTick : slot->nextFireTime;
+
+	SlotList &bucket = _wheel[slot->wheelTime & (kWheelSize - 1)];
+	appendSlot(bucket.head, bucket.tail, slot);
 }
 
 void DefaultTimerManager::handler() {
@@ -85,33 +112,57 @@ void DefaultTimerManager::handler() {
 	uint32 curTime = g_system->getMillis(true);
 
 	// On slow systems this could still be run after destructor
-	if (!_head)
+	if (!_wheel)
 		return;
 
-	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
-
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
-		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
+	// Handle each millisecond up to the current one, in which the timers
+	// scheduled after a whole revolution of the wheel stay in the bucket
+	while (_numSlots && (int32)(curTime - _nextTick) > 0) {
+		SlotList &bucket = _wheel[_nextTick & (kWheelSize - 1)];
+
+		bool due = true;
+		while (due) {
+			_firing = bucket;
+			bucket.head = bucket.tail = nullptr;
+
+			while (_firing.head) {
+				TimerSlot *slot = _firing.head;
+				_firing.head = slot->next;
+				if (!_firing.head)
+					_firing.tail = nullptr;
+
+				if (slot->wheelTime != _nextTick) {
+					appendSlot(bucket.head, bucket.tail, slot);
+					continue;
+				}
+
+				// Update the fire time and reschedule the TimerSlot.
+				assert(slot->interval > 0);
+				slot->nextFireTime += (slot->interval / 1000);
+				slot->nextFireTimeMicro += (slot->interval % 1000);
+				if (slot->nextFireTimeMicro > 1000) {
+					slot->nextFireTime += slot->nextFireTimeMicro / 1000;
+					slot->nextFireTimeMicro %= 1000;
+				}
+				schedule(slot);
+
+				// Invoke the timer callback
+				assert(slot->callback);
+				slot->callback(slot->refCon);
+			}
+
+			// The timers which are still due fire again, after the other ones
+			due = false;
+			for (TimerSlot *slot = bucket.head; slot && !due; slot = slot->next)
+				due = (slot->wheelTime == _nextTick);
 		}
-		insertPrioQueue(_head, slot);
 
-		// Invoke the timer callback
-		assert(slot->callback);
-		slot->callback(slot->refCon);
-
-		// Look at the next scheduled timer
-		slot = _head->next;
+		++_nextTick;
 	}
+
+	// Without timers, there's nothing to catch up with
+	if (!_numSlots)
+		_nextTick = curTime;
 }
 
 void DefaultTimerManager::checkTimers(uint32 interval) {
@@ -151,7 +202,8 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	slot->nextFireTimeMicro = interval % 1000;
 	slot->next = nullptr;
 
-	insertPrioQueue(_head, slot);
+	schedule(slot);
+	_numSlots++;
 
 	return true;
 }
@@ -159,16 +211,14 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
+	for (uint32 i = 0; i < kWheelSize; i++)
+		removeSlots(_wheel[i].head, _wheel[i].tail, callback);
+	removeSlots(_firing.head, _firing.tail, callback);
 
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
-		} else {
-			slot = slot->next;
-		}
+	_numSlots = 0;
+	for (uint32 i = 0; i <= kWheelSize; i++) {
+		for (TimerSlot *slot = (i < kWheelSize) ? _wheel[i].head : _firing.head; slot; slot = slot->next)
+			_numSlots++;
 	}
 
 	// We need to remove all names referencing the timer proc here.
@@ -29,16 +29,33 @@
 
 struct TimerSlot;
 
+/**
+ * The timer slots are kept in a timer wheel with a bucket for each
+ * millisecond, so that installing a timer is cheap, and firing them
+ * only looks at the timers due in the elapsed milliseconds.
+ */
 class DefaultTimerManager : public Common::TimerManager {
 private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
+	/** Number of buckets in the wheel, must be a power of two. */
+	static const uint32 kWheelSize = 256;
+
+	struct SlotList {
+		TimerSlot *head, *tail;
+	};
+
 	Common::Mutex _mutex;
-	TimerSlot *_head;
+	SlotList *_wheel;
+	SlotList _firing; // the due timers of the millisecond being handled
+	uint32 _nextTick; // the next millisecond to handle
+	uint32 _numSlots;
 	TimerSlotMap _callbacks;
 
 	uint32 _timerCallbackNext;
 
+	void schedule(TimerSlot *slot);
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
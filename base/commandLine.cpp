@@ -152,6 +152,7 @@ static const char HELP_STRING4[] =
 	"  --debugflags=FLAGS       Enable engine specific debug flags\n"
 	"                           (separated by commas)\n"
 	"  --debug-channels-only    Show only the specified debug channels\n"
+	"  --debug-async            Write the debug output from a background thread\n"
 	"  -u, --dump-scripts       Enable script dumping if a directory called 'dumps'\n"
 	"                           exists in the current directory\n"
 	"\n"
@@ -194,7 +195,7 @@ static const char HELP_STRING4[] =
 	"                           atari, macintosh, macintoshbw)\n"
 #ifdef ENABLE_EVENTRECORDER
 	"  --record-mode=MODE       Specify record mode for event recorder (record, playback,\n"
-	"                           info, update, passthrough [default])\n"
+	"                           benchmark, info, update, passthrough [default])\n"
 	"  --record-file-name=FILE  Specify record file name\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
@@ -316,6 +317,9 @@ void registerDefaults() {
 	ConfMan.registerDefault("multi_midi", false);
 	ConfMan.registerDefault("native_mt32", false);
 	ConfMan.registerDefault("dump_midi", false);
+
+	ConfMan.registerDefault("audio_resampler", "default");
+	ConfMan.registerDefault("audio_prefetch_ms", 0);
 	ConfMan.registerDefault("enable_gs", false);
 	ConfMan.registerDefault("midi_gain", 100);
 
@@ -386,6 +390,9 @@ void registerDefaults() {
 	// If number of game entries in scummvm.ini exceeds the specified
 	// number, then skip scanning. -1 = scan always
 	ConfMan.registerDefault("gui_list_max_scan_entries", -1);
+	// Write the rasterized theme SVG images to cache files, so that they
+	// don't need to be rasterized again on the next start
+	ConfMan.registerDefault("gui_svg_cache_files", false);
 	ConfMan.registerDefault("game", "");
 
 #ifdef USE_FLUIDSYNTH
@@ -406,6 +413,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("fluidsynth_reverb_level", 90);
 
 	ConfMan.registerDefault("fluidsynth_misc_interpolation", "4th");
+	ConfMan.registerDefault("fluidsynth_dynamic_sample_loading", false);
 #endif
 #ifdef USE_DISCORD
 	ConfMan.registerDefault("discord_rpc", true);
@@ -694,6 +702,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION_BOOL("debug-channels-only")
 			END_OPTION
 
+			DO_LONG_OPTION_BOOL("debug-async")
+			END_OPTION
+
 			DO_OPTION('e', "music-driver")
 			END_OPTION
 
@@ -512,6 +512,10 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 			DebugMan.enableDebugChannel(token);
 	}
 
+	// Bound the memory used to keep decompressed archive members around
+	if (ConfMan.hasKey("archive_cache_size"))
+		ArchiveMemberCacheMan.setBudget((uint32)MAX(ConfMan.getInt("archive_cache_size"), 0) * 1024);
+
 	ConfMan.registerDefault("always_run_fallback_detection_extern", true);
 	PluginManager::instance().init();
  	PluginManager::instance().loadAllPlugins(); // load plugins for cached plugin manager
@@ -572,6 +576,11 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	// the command line params) was read.
 	system.initBackend();
 
+	// Write the debug output from a background thread if requested. This
+	// needs the timer manager of the backend.
+	if (settings.contains("debug-async"))
+		DebugMan.enableAsyncLog(true);
+
 	// If we received an invalid graphics mode parameter via command line
 	// we check this here. We can't do it until after the backend is inited,
 	// or there won't be a graphics manager to ask for the supported modes.
@@ -791,6 +800,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderUpdate);
 			} else if (recordMode == "playback") {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback);
+			} else if (recordMode == "benchmark") {
+				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback, true);
 			} else if ((recordMode == "info") && (!recordFileName.empty())) {
 				Common::PlaybackFile record;
 				record.openRead(recordFileName);
@@ -443,23 +443,47 @@ bool PluginManagerUncached::loadPluginByFileName(const Common::Path &filename) {
 }
 
 /**
- * Update the config manager with a plugin file name that we found can handle
- * the engine.
+ * Remember in the ConfigManager which file the engine plugin was loaded from.
+ * Every plugin loaded while scanning is recorded, so that a single scan is
+ * enough to find any engine directly afterwards.
  **/
-void PluginManagerUncached::updateConfigWithFileName(const Common::String &engineId) {
-	// Check if we have a filename for the current plugin
-	if (!(*_currentPlugin)->getFileName().empty()) {
-		if (!ConfMan.hasMiscDomain("engine_plugin_files"))
-			ConfMan.addMiscDomain("engine_plugin_files");
+void PluginManagerUncached::recordPluginFileName(const Plugin *plugin) {
+	const Common::Path &filename = plugin->getFileName();
+	if (filename.empty() || plugin->getType() != PLUGIN_TYPE_ENGINE)
+		return;
+
+	if (!ConfMan.hasMiscDomain("engine_plugin_files"))
+		ConfMan.addMiscDomain("engine_plugin_files");
 
-		Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_files");
-		assert(domain);
-		(*domain).setVal(engineId, (*_currentPlugin)->getFileName().toConfig());
+	Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_files");
+	assert(domain);
+
+	const Common::String engineId = plugin->getName();
+	const Common::String value = filename.toConfig();
+	if (!domain->contains(engineId) || (*domain)[engineId] != value) {
+		domain->setVal(engineId, value);
+		_pluginFileNamesChanged = true;
+	}
+}
 
+void PluginManagerUncached::flushPluginFileNames() {
+	if (_pluginFileNamesChanged) {
 		ConfMan.flushToDisk();
+		_pluginFileNamesChanged = false;
 	}
 }
 
+/**
+ * Update the config manager with a plugin file name that we found can handle
+ * the engine.
+ **/
+void PluginManagerUncached::updateConfigWithFileName(const Common::String &engineId) {
+	// The current plugin was found by its engine ID, so it is recorded under it
+	assert(engineId == (*_currentPlugin)->getName());
+	recordPluginFileName(*_currentPlugin);
+	flushPluginFileNames();
+}
+
 #ifndef DETECTION_STATIC
 void PluginManagerUncached::loadDetectionPlugin() {
 	bool linkMetaEngines = false;
@@ -511,6 +535,7 @@ void PluginManagerUncached::loadFirstPlugin() {
 	for (_currentPlugin = _allEnginePlugins.begin(); _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
 		if ((*_currentPlugin)->loadPlugin()) {
 			addToPluginsInMemList(*_currentPlugin);
+			recordPluginFileName(*_currentPlugin);
 			break;
 		}
 	}
@@ -525,9 +550,13 @@ bool PluginManagerUncached::loadNextPlugin() {
 	for (++_currentPlugin; _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
 		if ((*_currentPlugin)->loadPlugin()) {
 			addToPluginsInMemList(*_currentPlugin);
+			recordPluginFileName(*_currentPlugin);
 			return true;
 		}
 	}
+
+	// The whole list was scanned, save what was learned about the plugins
+	flushPluginFileNames();
 	return false; // no more in list
 }
 
@@ -743,6 +772,7 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32
 
 	// Close all archives that were opened during detection
 	ADCacheMan.clearArchives();
+	ADCacheMan.savePersistentCache();
 
 	return DetectionResults(candidates);
 }
@@ -361,9 +361,12 @@ protected:
 	PluginList::iterator _currentPlugin;
 
 	bool _isDetectionLoaded;
+	bool _pluginFileNamesChanged;
 
-	PluginManagerUncached() : _isDetectionLoaded(false), _detectionPlugin(nullptr) {}
+	PluginManagerUncached() : _isDetectionLoaded(false), _pluginFileNamesChanged(false), _detectionPlugin(nullptr) {}
 	bool loadPluginByFileName(const Common::Path &filename);
+	void recordPluginFileName(const Plugin *plugin);
+	void flushPluginFileNames();
 
 public:
 	void init() override;
@@ -176,6 +176,11 @@ char Archive::getPathSeparator() const {
 	return '/';
 }
 
+MemcachingCaseInsensitiveArchive::~MemcachingCaseInsensitiveArchive() {
+	if (ArchiveMemberCache::hasInstance())
+		ArchiveMemberCacheMan.removeArchive(this);
+}
+
 SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMember(const Path &path) const {
 	return createReadStreamForMemberImpl(path, false, Common::AltStreamType::Invalid);
 }
@@ -204,6 +209,7 @@ SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMemberI
 		isNew = true;
 	}
 
+	ArchiveMemberCache &sharedCache = ArchiveMemberCacheMan;
 	SharedArchiveContents* entry = &_cache[cacheKey];
 
 	// Errors and missing files. Just return nullptr,
@@ -227,12 +233,18 @@ SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMemberI
 	if (entry->isFileMissing())
 		return nullptr;
 
+	if (isNew)
+		sharedCache._stats.misses++;
+	else
+		sharedCache._stats.hits++;
+
 	// Now we have a valid contents reference. Make stream for it.
 	Common::MemoryReadStream *memStream = new Common::MemoryReadStream(entry->getContents(), entry->getSize());
 
-	// If the entry was just created and it's too big for strong caching,
-	// mark the copy in cache as weak
-	if (isNew && entry->getSize() > _maxStronglyCachedSize) {
+	// If the entry is too big for strong caching, mark the copy in cache
+	// as weak, and leave it to the shared cache to keep it around
+	if (entry->getSize() > _maxStronglyCachedSize) {
+		sharedCache.use(this, entry->getContents(), entry->getSize());
 		entry->makeWeak();
 	}
 
@@ -254,19 +266,102 @@ uint MemcachingCaseInsensitiveArchive::CacheKey_Hash::operator()(const CacheKey
 	return static_cast<uint>(x.path.hashIgnoreCase() * 1000003u) ^ static_cast<uint>(x.altStreamType);
 };
 
+ArchiveMemberCache::ArchiveMemberCache() : _budget(kDefaultBudget), _cachedSize(0), _memoryCounter("Archive member cache") {
+	resetStats();
+}
+
+void ArchiveMemberCache::setBudget(uint32 budget) {
+	_budget = budget;
+	shrink(_budget);
+}
+
+void ArchiveMemberCache::resetStats() {
+	_stats.hits = 0;
+	_stats.misses = 0;
+	_stats.evictions = 0;
+}
+
+void ArchiveMemberCache::clear() {
+	_entries.clear();
+	_entryMap.clear();
+	_cachedSize = 0;
+	_memoryCounter.set(0);
+}
+
+void ArchiveMemberCache::use(const MemcachingCaseInsensitiveArchive *archive, const SharedPtr<byte> &contents, uint32 size) {
+	if (size > _budget)
+		return;
+
+	// Move the entry to the front of the list
+	EntryList::iterator it = _entries.begin();
+	if (_entryMap.tryGetVal(contents.get(), it)) {
+		if (it != _entries.begin()) {
+			_entries.push_front(*it);
+			_entries.erase(it);
+			_entryMap[contents.get()] = _entries.begin();
+		}
+		return;
+	}
+
+	shrink(_budget - size);
+
+	Entry entry;
+	entry.contents = contents;
+	entry.size = size;
+	entry.archive = archive;
+	_entries.push_front(entry);
+	_entryMap[contents.get()] = _entries.begin();
+	_cachedSize += size;
+	_memoryCounter.set(_cachedSize);
+}
+
+void ArchiveMemberCache::removeArchive(const MemcachingCaseInsensitiveArchive *archive) {
+	EntryList::iterator it = _entries.begin();
+	while (it != _entries.end()) {
+		if (it->archive == archive) {
+			_cachedSize -= it->size;
+			_entryMap.erase(it->contents.get());
+			it = _entries.erase(it);
+		} else {
+			++it;
+		}
+	}
+	_memoryCounter.set(_cachedSize);
+}
+
+void ArchiveMemberCache::shrink(uint32 budget) {
+	while (_cachedSize > budget) {
+		Entry &entry = _entries.back();
+		_cachedSize -= entry.size;
+		_entryMap.erase(entry.contents.get());
+		_entries.pop_back();
+		_stats.evictions++;
+	}
+	_memoryCounter.set(_cachedSize);
+}
+
 SearchSet::ArchiveNodeList::iterator SearchSet::find(const String &name) {
+	// A name which was never interned cannot belong to any archive
+	InternedString atom;
+	if (!InternedString::tryGet(name, atom))
+		return _list.end();
+
 	ArchiveNodeList::iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
-		if (it->_name == name)
+		if (it->_name == atom)
 			break;
 	}
 	return it;
 }
 
 SearchSet::ArchiveNodeList::const_iterator SearchSet::find(const String &name) const {
+	InternedString atom;
+	if (!InternedString::tryGet(name, atom))
+		return _list.end();
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
-		if (it->_name == name)
+		if (it->_name == atom)
 			break;
 	}
 	return it;
@@ -288,8 +383,10 @@ void SearchSet::insert(const Node &node) {
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
 	if (find(name) == _list.end()) {
-		Node node(priority, name, archive, autoFree);
+		Node node(priority, InternedString(name), archive, autoFree);
 		insert(node);
+		if (_indexValid)
+			addToIndex(*find(name));
 	} else {
 		if (autoFree)
 			delete archive;
@@ -374,6 +471,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		invalidateMemberIndex();
 	}
 }
 
@@ -397,6 +495,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	invalidateMemberIndex();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -413,19 +512,96 @@ void SearchSet::setPriority(const String &name, int priority) {
 	_list.erase(it);
 	node._priority = priority;
 	insert(node);
+	invalidateMemberIndex();
 }
 
-bool SearchSet::hasFile(const Path &path) const {
-	if (path.empty())
-		return false;
+void SearchSet::setUseMemberIndex(bool useIndex) {
+	_useIndex = useIndex;
+	invalidateMemberIndex();
+}
+
+void SearchSet::invalidateMemberIndex() const {
+	_indexValid = false;
+	_index.clear(true);
+	for (ArchiveNodeList::const_iterator it = _list.begin(); it != _list.end(); ++it)
+		it->_indexed = false;
+}
+
+void SearchSet::addToIndex(const Node &node) const {
+	// Nested sets can change without us noticing
+	node._indexed = false;
+	if (dynamic_cast<const SearchSet *>(node._arc))
+		return;
+
+	ArchiveMemberList members;
+	if (node._arc->listMembers(members) == 0)
+		return;
+
+	node._indexed = true;
+	for (ArchiveMemberList::const_iterator i = members.begin(); i != members.end(); ++i) {
+		const Path path = (*i)->getPathInArchive();
+
+		// Archives are sorted by descending priority, and insertion order
+		// breaks ties, so an earlier entry only loses to a higher priority
+		MemberIndex::iterator entry = _index.find(path);
+		if (entry != _index.end() && entry->_value._priority >= node._priority)
+			continue;
+
+		IndexEntry &e = _index[path];
+		e._arc = node._arc;
+		e._priority = node._priority;
+	}
+}
+
+void SearchSet::buildIndex() const {
+	_index.clear();
+	for (ArchiveNodeList::const_iterator it = _list.begin(); it != _list.end(); ++it)
+		addToIndex(*it);
+	_indexValid = true;
+}
+
+Archive *SearchSet::findArchive(const Path &path) const {
+	if (_useIndex) {
+		if (!_indexValid)
+			buildIndex();
+
+		MemberIndex::const_iterator entry = _index.find(path);
+		Archive *indexed = (entry != _index.end()) ? entry->_value._arc : nullptr;
+
+		// Only archives which are not indexed are searched, until the
+		// indexed archive containing the file is reached
+		ArchiveNodeList::const_iterator it = _list.begin();
+		for (; it != _list.end(); ++it) {
+			if (it->_arc == indexed) {
+				if (indexed->hasFile(path))
+					return indexed;
+
+				// The index is out of date, so search all archives
+				break;
+			}
+
+			if (!it->_indexed && it->_arc->hasFile(path))
+				return it->_arc;
+		}
+
+		if (it == _list.end())
+			return nullptr;
+	}
 
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		if (it->_arc->hasFile(path))
-			return true;
+			return it->_arc;
 	}
 
-	return false;
+	return nullptr;
+}
+
+bool SearchSet::hasFile(const Path &path) const {
+	if (path.empty())
+		return false;
+
+	return findArchive(path) != nullptr;
 }
 
 bool SearchSet::isPathDirectory(const Path &path) const {
@@ -469,7 +645,7 @@ int SearchSet::listMatchingMembers(ArchiveMemberDetailsList &list, const Path &p
 		List<ArchiveMemberPtr> matchingMembers;
 		matches += it->_arc->listMatchingMembers(matchingMembers, pattern, matchPathComponents);
 		for (ArchiveMemberPtr &member : matchingMembers)
-			list.push_back(ArchiveMemberDetails(member, it->_name));
+			list.push_back(ArchiveMemberDetails(member, it->_name.toString()));
 	}
 
 	return matches;
@@ -489,17 +665,14 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path, Archive **containe
 	if (path.empty())
 		return ArchiveMemberPtr();
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(path)) {
-			if (container) {
-				*container = it->_arc;
-			}
-			return it->_arc->getMember(path);
-		}
-	}
+	Archive *arc = findArchive(path);
+	if (!arc)
+		return ArchiveMemberPtr();
 
-	return ArchiveMemberPtr();
+	if (container) {
+		*container = arc;
+	}
+	return arc->getMember(path);
 }
 
 const ArchiveMemberPtr SearchSet::getMember(const Path &path) const {
@@ -510,6 +683,19 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const
 	if (path.empty())
 		return nullptr;
 
+	if (_useIndex) {
+		Archive *arc = findArchive(path);
+		if (!arc)
+			return nullptr;
+
+		SeekableReadStream *stream = arc->createReadStreamForMember(path);
+		if (stream)
+			return stream;
+
+		// Let the following archives have a go, as the linear search does
+		return createReadStreamForMemberNext(path, arc);
+	}
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		SeekableReadStream *stream = it->_arc->createReadStreamForMember(path);
@@ -554,6 +740,8 @@ SeekableReadStream *SearchSet::createReadStreamForMemberNext(const Path &path, c
 }
 
 SearchManager::SearchManager() {
+	// Engines add lots of archives here, so look files up in one go
+	setUseMemberIndex(true);
 	clear(); // Force a reset
 }
 
@@ -575,5 +763,6 @@ void SearchManager::clear() {
 }
 
 DECLARE_SINGLETON(SearchManager);
+DECLARE_SINGLETON(ArchiveMemberCache);
 
 } // namespace Common
@@ -24,8 +24,11 @@
 
 #include "common/error.h"
 #include "common/hashmap.h"
+#include "common/hash-ptr.h"
 #include "common/hash-str.h"
+#include "common/intern-str.h"
 #include "common/list.h"
+#include "common/memusage.h"
 #include "common/path.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
@@ -265,10 +268,16 @@ private:
 
 /**
  * An archive that caches the resulting contents.
+ *
+ * Contents up to maxStronglyCachedSize bytes are kept for the lifetime of
+ * the archive. Bigger ones are shared by the streams reading them, and
+ * kept in the ArchiveMemberCache while they fit in its budget.
  */
 class MemcachingCaseInsensitiveArchive : public Archive {
 public:
 	MemcachingCaseInsensitiveArchive(uint32 maxStronglyCachedSize = 512) : _maxStronglyCachedSize(maxStronglyCachedSize) {}
+	~MemcachingCaseInsensitiveArchive() override;
+
 	SeekableReadStream *createReadStreamForMember(const Path &path) const;
 	SeekableReadStream *createReadStreamForMemberAltStream(const Path &path, Common::AltStreamType altStreamType) const;
 
@@ -301,6 +310,71 @@ private:
 	uint32 _maxStronglyCachedSize;
 };
 
+/**
+ * Process-wide cache of the archive members decompressed by all the
+ * MemcachingCaseInsensitiveArchive instances.
+ *
+ * Recently used members are kept in memory after their last stream is
+ * closed, so that opening them again does not decompress them again. Once
+ * the cached members exceed the budget, the least recently used ones are
+ * dropped.
+ */
+class ArchiveMemberCache : public Singleton<ArchiveMemberCache> {
+public:
+	/** Default budget, in bytes. */
+	static const uint32 kDefaultBudget = 16 * 1024 * 1024;
+
+	struct Stats {
+		uint32 hits;      ///< Members found in memory.
+		uint32 misses;    ///< Members which had to be decompressed.
+		uint32 evictions; ///< Members dropped to stay within the budget.
+	};
+
+	/**
+	 * Change the maximum total size of the cached members, in bytes.
+	 * A budget of 0 disables the cache.
+	 */
+	void setBudget(uint32 budget);
+	uint32 getBudget() const { return _budget; }
+
+	/** Return the total size of the cached members, in bytes. */
+	uint32 getCachedSize() const { return _cachedSize; }
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
+	/** Drop all cached members. Streams reading them keep working. */
+	void clear();
+
+private:
+	friend class Singleton<ArchiveMemberCache>;
+	friend class MemcachingCaseInsensitiveArchive;
+
+	ArchiveMemberCache();
+
+	struct Entry {
+		SharedPtr<byte> contents;
+		uint32 size;
+		const MemcachingCaseInsensitiveArchive *archive;
+	};
+
+	typedef List<Entry> EntryList;
+
+	void use(const MemcachingCaseInsensitiveArchive *archive, const SharedPtr<byte> &contents, uint32 size);
+	void removeArchive(const MemcachingCaseInsensitiveArchive *archive);
+	void shrink(uint32 budget);
+
+	EntryList _entries; ///< Most recently used first
+	HashMap<const byte *, EntryList::iterator> _entryMap;
+	uint32 _budget;
+	uint32 _cachedSize;
+	Stats _stats;
+	MemoryCounter _memoryCounter;
+};
+
+/** Shortcut for accessing the archive member cache. */
+#define ArchiveMemberCacheMan		Common::ArchiveMemberCache::instance()
+
 /**
  * The SearchSet class enables access to a group of Archives through the Archive interface.
  *
@@ -312,16 +386,31 @@ private:
 class SearchSet : public Archive {
 	struct Node {
 		int		_priority;
-		String	_name;
+		InternedString	_name;	//!< Interned, so that looking up archives by name only compares pointers.
 		Archive	*_arc;
 		bool	_autoFree;
-		Node(int priority, const String &name, Archive *arc, bool autoFree)
-			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree) {
+		mutable bool	_indexed;	//!< Whether the members of the archive are in the member index.
+		Node(int priority, const InternedString &name, Archive *arc, bool autoFree)
+			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree), _indexed(false) {
 		}
 	};
 	typedef List<Node> ArchiveNodeList;
 	ArchiveNodeList _list;
 
+	struct IndexEntry {
+		Archive	*_arc;
+		int		_priority;
+	};
+	typedef HashMap<Path, IndexEntry, Path::IgnoreCaseAndMac_Hash, Path::IgnoreCaseAndMac_EqualTo> MemberIndex;
+
+	bool _useIndex;
+	mutable bool _indexValid;
+	mutable MemberIndex _index; //!< Maps each member to the first archive listing it.
+
+	void addToIndex(const Node &node) const;
+	void buildIndex() const;
+	Archive *findArchive(const Path &path) const; //!< Find the first archive containing the given file.
+
 	ArchiveNodeList::iterator find(const String &name);
 	ArchiveNodeList::const_iterator find(const String &name) const;
 
@@ -330,7 +419,7 @@ class SearchSet : public Archive {
 	bool _ignoreClashes;
 
 public:
-	SearchSet() : _ignoreClashes(false) { }
+	SearchSet() : _ignoreClashes(false), _useIndex(false), _indexValid(false) { }
 	virtual ~SearchSet() { clear(); }
 
 	/**
@@ -455,6 +544,23 @@ public:
 	 * in @ref FSDirectory documentation.
 	 */
 	void setIgnoreClashes(bool ignoreClashes) { _ignoreClashes = ignoreClashes; }
+
+	/**
+	 * Look up files in a combined index of the members of all archives,
+	 * instead of asking each archive in turn.
+	 *
+	 * The index is built on the first lookup and kept up to date when
+	 * archives are added or removed. An archive listing no members, or
+	 * being a SearchSet itself, is not indexed and still asked on each
+	 * lookup. If the content of an indexed archive changes behind the back
+	 * of the SearchSet, call invalidateMemberIndex().
+	 */
+	void setUseMemberIndex(bool useIndex);
+
+	/**
+	 * Drop the member index, so that it gets rebuilt on the next lookup.
+	 */
+	void invalidateMemberIndex() const;
 };
 
 
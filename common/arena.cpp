@@ -0,0 +1,134 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/arena.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+Arena::Arena(size_t blockSize) : _blockSize(blockSize), _current(0), _offset(0) {
+	assert(blockSize > 0);
+}
+
+Arena::~Arena() {
+	freeMemory();
+}
+
+void *Arena::allocateSlow(size_t size, size_t alignment) {
+	const uint next = _blocks.empty() ? 0 : _current + 1;
+
+	// Reuse a block released by rewind() or reset() if the allocation fits
+	for (uint i = next; i < _blocks.size(); ++i) {
+		const size_t offset = alignOffset(_blocks[i], 0, alignment);
+		if (offset + size <= _blocks[i].size) {
+			_current = i;
+			_offset = offset + size;
+			return fresh(_blocks[i].start + offset, size);
+		}
+	}
+
+	// Otherwise get a new block, big enough for oversized allocations
+	Block block;
+	block.size = MAX(_blockSize, size + alignment - 1);
+	block.start = (byte *)malloc(block.size);
+	if (!block.start)
+		error("Arena::allocate: Out of memory allocating %u bytes", (uint)block.size);
+
+	_blocks.insert_at(next, block);
+	_current = next;
+
+	const size_t offset = alignOffset(block, 0, alignment);
+	_offset = offset + size;
+	return fresh(block.start + offset, size);
+}
+
+char *Arena::copyString(const char *str) {
+	const size_t size = strlen(str) + 1;
+	char *copy = (char *)allocate(size, 1);
+	memcpy(copy, str, size);
+	return copy;
+}
+
+Arena::Marker Arena::mark() const {
+	Marker marker;
+	marker.block = _current;
+	marker.offset = _offset;
+	return marker;
+}
+
+void Arena::rewind(const Marker &marker) {
+	assert(marker.block < _current || (marker.block == _current && marker.offset <= _offset));
+
+	poison(marker);
+	_current = marker.block;
+	_offset = marker.offset;
+}
+
+void Arena::reset() {
+	Marker start;
+	start.block = 0;
+	start.offset = 0;
+	rewind(start);
+}
+
+void Arena::freeMemory() {
+	for (uint i = 0; i < _blocks.size(); ++i)
+		free(_blocks[i].start);
+
+	_blocks.clear();
+	_current = 0;
+	_offset = 0;
+}
+
+size_t Arena::getUsedSize() const {
+	if (_blocks.empty())
+		return 0;
+
+	size_t used = _offset;
+	for (uint i = 0; i < _current; ++i)
+		used += _blocks[i].size;
+	return used;
+}
+
+size_t Arena::getCapacity() const {
+	size_t capacity = 0;
+	for (uint i = 0; i < _blocks.size(); ++i)
+		capacity += _blocks[i].size;
+	return capacity;
+}
+
+void Arena::poison(const Marker &from) {
+#ifndef RELEASE_BUILD
+	if (_blocks.empty())
+		return;
+
+	for (uint i = from.block; i <= _current; ++i) {
+		const size_t start = (i == from.block) ? from.offset : 0;
+		const size_t end = (i == _current) ? _offset : _blocks[i].size;
+		if (end > start)
+			memset(_blocks[i].start + start, 0xDD, end - start);
+	}
+#else
+	(void)from;
+#endif
+}
+
+} // End of namespace Common
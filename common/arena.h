@@ -0,0 +1,180 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ARENA_H
+#define COMMON_ARENA_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/noncopyable.h"
+#include "common/util.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_arena Arena allocator
+ * @ingroup common
+ *
+ * @brief API for the arena (bump) allocator.
+ *
+ * @{
+ */
+
+/**
+ * A bump allocator for short-lived objects of varying size which are all
+ * released together, like the temporaries created while parsing a frame or
+ * loading a room.
+ *
+ * Memory is carved linearly out of large blocks obtained via malloc. There
+ * is no way to free a single allocation; instead, rewind() releases
+ * everything allocated since a marker and reset() releases everything.
+ * Released blocks are kept and reused by later allocations. Use
+ * Arena::Scope to rewind automatically at the end of a scope.
+ *
+ * Destructors of objects created in the arena are never called, so only
+ * place objects there which do not own other resources.
+ *
+ * In non-release builds, freshly allocated memory is filled with 0xCD and
+ * released memory with 0xDD, to make use of uninitialized or stale data
+ * easier to spot.
+ */
+class Arena : NonCopyable {
+public:
+	/** Position in the arena, as returned by mark(). */
+	struct Marker {
+		uint block;
+		size_t offset;
+	};
+
+	/**
+	 * Rewinds the given arena to where it was when the scope was created.
+	 */
+	class Scope : NonCopyable {
+	public:
+		explicit Scope(Arena &arena) : _arena(arena), _marker(arena.mark()) {}
+		~Scope() { _arena.rewind(_marker); }
+
+	private:
+		Arena &_arena;
+		const Marker _marker;
+	};
+
+	/**
+	 * Construct an empty arena. No memory is allocated until the first
+	 * allocation.
+	 *
+	 * @param blockSize  Size of the blocks requested from the system.
+	 *                   Larger allocations get a block of their own.
+	 */
+	explicit Arena(size_t blockSize = 16384);
+	~Arena();
+
+	/**
+	 * Allocate @p size bytes aligned to @p alignment, which must be a power
+	 * of two. The memory is not initialized.
+	 */
+	void *allocate(size_t size, size_t alignment = sizeof(void *)) {
+		assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+		if (_current < _blocks.size()) {
+			const Block &block = _blocks[_current];
+			const size_t offset = alignOffset(block, _offset, alignment);
+			if (offset + size <= block.size) {
+				_offset = offset + size;
+				return fresh(block.start + offset, size);
+			}
+		}
+
+		return allocateSlow(size, alignment);
+	}
+
+	/** Allocate an uninitialized array of @p count objects of type T. */
+	template<class T>
+	T *allocateArray(size_t count) {
+		return (T *)allocate(count * sizeof(T), alignof(T));
+	}
+
+	/**
+	 * Construct an object of type T in the arena. Its destructor will not
+	 * be called.
+	 */
+	template<class T, class... TArgs>
+	T *create(TArgs &&...args) {
+		return new (allocate(sizeof(T), alignof(T))) T(Common::forward<TArgs>(args)...);
+	}
+
+	/** Copy a NUL terminated string into the arena. */
+	char *copyString(const char *str);
+
+	/** Return the current position, to be passed to rewind() later. */
+	Marker mark() const;
+
+	/**
+	 * Release all memory allocated after @p marker was obtained. Pointers
+	 * to that memory become invalid.
+	 */
+	void rewind(const Marker &marker);
+
+	/** Release all allocations, keeping the blocks for reuse. */
+	void reset();
+
+	/** Release all allocations and return the blocks to the system. */
+	void freeMemory();
+
+	/** Number of bytes currently handed out, including alignment padding. */
+	size_t getUsedSize() const;
+
+	/** Number of bytes obtained from the system. */
+	size_t getCapacity() const;
+
+private:
+	struct Block {
+		byte *start;
+		size_t size;
+	};
+
+	const size_t _blockSize;
+	Array<Block> _blocks;
+	uint _current;   ///< Index of the block allocations are taken from.
+	size_t _offset;  ///< Offset of the first free byte in the current block.
+
+	/** Round @p offset in @p block up so that the address is aligned. */
+	static size_t alignOffset(const Block &block, size_t offset, size_t alignment) {
+		const uintptr addr = (uintptr)block.start + offset;
+		return offset + (size_t)((alignment - (addr & (alignment - 1))) & (alignment - 1));
+	}
+
+	static void *fresh(byte *ptr, size_t size) {
+#ifndef RELEASE_BUILD
+		memset(ptr, 0xCD, size);
+#endif
+		return ptr;
+	}
+
+	void *allocateSlow(size_t size, size_t alignment);
+	void poison(const Marker &from);
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
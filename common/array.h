@@ -146,6 +146,33 @@ public:
 			insert_aux(end(), &element, &element + 1);
 	}
 
+	/** Append an element to the end of the array, moving it into the array. */
+	void push_back(T &&element) {
+		emplace_back(Common::move(element));
+	}
+
+	/**
+	 * Construct an element at the end of the array from the given
+	 * arguments, and return a reference to it.
+	 */
+	template<class... TArgs>
+	T &emplace_back(TArgs &&...args) {
+		if (_size < _capacity) {
+			new ((void *)&_storage[_size]) T(Common::forward<TArgs>(args)...);
+		} else {
+			T *const oldStorage = _storage;
+			allocCapacity(roundUpCapacity(_size + 1));
+
+			// Construct the new element first, as the arguments may
+			// refer to elements of the old storage
+			new ((void *)&_storage[_size]) T(Common::forward<TArgs>(args)...);
+			Common::uninitialized_move(oldStorage, oldStorage + _size, _storage);
+			freeStorage(oldStorage, _size);
+		}
+
+		return _storage[_size++];
+	}
+
 	/** Append an element to the end of the array. */
 	void push_back(const Array<T> &array) {
 		if (_size + array.size() <= _capacity) {
@@ -220,7 +247,7 @@ public:
 	T remove_at(size_type idx) {
 		assert(idx < _size);
 		T tmp = _storage[idx];
-		copy(_storage + idx + 1, _storage + _size, _storage + idx);
+		Common::move(_storage + idx + 1, _storage + _size, _storage + idx);
 		_size--;
 		// We also need to destroy the last object properly here.
 		_storage[_size].~T();
@@ -286,7 +313,7 @@ public:
 
 	/** Erase the element at @p pos position and return an iterator pointing to the next element in the array. */
 	iterator erase(iterator pos) {
-		copy(pos + 1, _storage + _size, pos);
+		Common::move(pos + 1, _storage + _size, pos);
 		_size--;
 		// We also need to destroy the last object properly here.
 		_storage[_size].~T();
@@ -295,7 +322,7 @@ public:
 
 	/** Erase the elements from @p first to @p last and return an iterator pointing to the next element in the array. */
 	iterator erase(iterator first, iterator last) {
-		copy(last, _storage + _size, first);
+		Common::move(last, _storage + _size, first);
 
 		int count = (last - first);
 		_size -= count;
@@ -361,15 +388,15 @@ public:
 		allocCapacity(newCapacity);
 
 		if (oldStorage) {
-			// Copy old data
-			uninitialized_copy(oldStorage, oldStorage + _size, _storage);
+			// Move old data
+			Common::uninitialized_move(oldStorage, oldStorage + _size, _storage);
 			freeStorage(oldStorage, _size);
 		}
 	}
 
 	/** Change the size of the array. */
 	void resize(size_type newSize) {
-		reserve(newSize);
+		growCapacity(newSize);
 
 		T *storage = _storage;
 
@@ -384,7 +411,7 @@ public:
 	/** Change the size of the array and initialize new elements that exceed the
 	 *  current array's size with copies of value. */
 	void resize(size_type newSize, const T value) {
-		reserve(newSize);
+		growCapacity(newSize);
 
 		T *storage = _storage;
 
@@ -423,6 +450,17 @@ protected:
 		return capa;
 	}
 
+	/**
+	 * Make room for at least @p newSize elements when growing the array a
+	 * bit at a time, for example by resizing it to size() + 1 repeatedly.
+	 * Unlike reserve(), the capacity is at least doubled, so that the
+	 * elements are not relocated on every call.
+	 */
+	void growCapacity(size_type newSize) {
+		if (newSize > _capacity)
+			reserve(_size ? MAX(newSize, _capacity * 2) : newSize);
+	}
+
 	/** Allocate a specific capacity for the array. */
 	void allocCapacity(size_type capacity) {
 		_capacity = capacity;
@@ -469,30 +507,31 @@ protected:
 				// storage to avoid conflicts.
 				allocCapacity(roundUpCapacity(_size + n));
 
-				// Copy the data from the old storage till the position where
-				// we insert new data
-				uninitialized_copy(oldStorage, oldStorage + idx, _storage);
-				// Copy the data we insert
+				// Copy the data we insert first, as it may come from the
+				// old storage
 				uninitialized_copy(first, last, _storage + idx);
-				// Afterwards, copy the old data from the position where we
+				// Move the data from the old storage till the position where
+				// we insert new data
+				Common::uninitialized_move(oldStorage, oldStorage + idx, _storage);
+				// Afterwards, move the old data from the position where we
 				// insert.
-				uninitialized_copy(oldStorage + idx, oldStorage + _size, _storage + idx + n);
+				Common::uninitialized_move(oldStorage + idx, oldStorage + _size, _storage + idx + n);
 
 				freeStorage(oldStorage, _size);
 			} else if (idx + n <= _size) {
 				// Make room for the new elements by shifting back
 				// existing ones.
 				// 1. Move a part of the data to the uninitialized area
-				uninitialized_copy(_storage + _size - n, _storage + _size, _storage + _size);
+				Common::uninitialized_move(_storage + _size - n, _storage + _size, _storage + _size);
 				// 2. Move a part of the data to the initialized area
-				copy_backward(pos, _storage + _size - n, _storage + _size);
+				Common::move_backward(pos, _storage + _size - n, _storage + _size);
 
 				// Insert the new elements.
 				copy(first, last, pos);
 			} else {
-				// Copy the old data from the position till the end to the new
+				// Move the old data from the position till the end to the new
 				// place.
-				uninitialized_copy(pos, _storage + _size, _storage + idx + n);
+				Common::uninitialized_move(pos, _storage + _size, _storage + idx + n);
 
 				// Copy a part of the new data to the position inside the
 				// initialized space.
@@ -555,6 +594,9 @@ private:
 
 	void push_back(const Array<T> &array);
 
+	template<class... TArgs>
+	T &emplace_back(TArgs &&...args);
+
 	// Based on code Copyright (C) 2008-2009 Ksplice, Inc.
 	// Author: Tim Abbott <tabbott@ksplice.com>
 	// Licensed under GPLv2+
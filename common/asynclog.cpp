@@ -0,0 +1,129 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/asynclog.h"
+#include "common/timer.h"
+
+namespace Common {
+
+STATIC_ASSERT((AsyncLog::kSlotCount & (AsyncLog::kSlotCount - 1)) == 0, AsyncLog_slot_count_must_be_a_power_of_two);
+
+AsyncLog::AsyncLog() : _head(0), _tail(0), _dropped(0), _reportedDropped(0), _writerStarted(false) {
+	for (uint i = 0; i < kSlotCount; i++)
+		_slots[i].ready.store(0, std::memory_order_relaxed);
+}
+
+AsyncLog::~AsyncLog() {
+	stopWriter();
+}
+
+bool AsyncLog::post(LogMessageType::Type type, const char *message) {
+	uint32 length = strlen(message);
+	uint32 count = MAX<uint32>(1, (length + kSlotTextSize - 1) / kSlotTextSize);
+	if (count > kMaxMessageSlots) {
+		count = kMaxMessageSlots;
+		length = kMaxMessageSlots * kSlotTextSize;
+	}
+
+	// Reserve consecutive slots. The difference is signed, as the tail
+	// may already be past a stale head.
+	uint32 head = _head.load(std::memory_order_relaxed);
+	do {
+		if ((int32)(head + count - _tail.load(std::memory_order_acquire)) > (int32)kSlotCount) {
+			_dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+	} while (!_head.compare_exchange_weak(head, head + count, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+	for (uint32 i = 0; i < count; i++) {
+		Slot &slot = _slots[(head + i) % kSlotCount];
+		const uint32 size = MIN<uint32>(length, kSlotTextSize);
+
+		slot.type = type;
+		slot.more = (i + 1 < count);
+		slot.length = size;
+		memcpy(slot.text, message, size);
+
+		message += size;
+		length -= size;
+
+		slot.ready.store(head + i + 1, std::memory_order_release);
+	}
+
+	return true;
+}
+
+void AsyncLog::flush() {
+	StackLock lock(_flushMutex);
+
+	uint32 tail = _tail.load(std::memory_order_relaxed);
+	for (;;) {
+		Slot &slot = _slots[tail % kSlotCount];
+		if (slot.ready.load(std::memory_order_acquire) != tail + 1)
+			break;
+
+		const LogMessageType::Type type = (LogMessageType::Type)slot.type;
+		const bool more = slot.more;
+		_pending += String(slot.text, slot.length);
+
+		// The slot may be reused as soon as the tail moves past it
+		_tail.store(++tail, std::memory_order_release);
+
+		if (!more) {
+			write(type, _pending.c_str());
+			_pending.clear();
+		}
+	}
+
+	const uint32 dropped = getDroppedCount();
+	if (dropped != _reportedDropped) {
+		write(LogMessageType::kWarning, String::format("%u log messages were dropped\n", dropped - _reportedDropped).c_str());
+		_reportedDropped = dropped;
+	}
+}
+
+void AsyncLog::startWriter(int32 interval) {
+	if (_writerStarted)
+		return;
+
+	_writerStarted = g_system->getTimerManager()->installTimerProc(timerProc, interval, this, "AsyncLog");
+}
+
+void AsyncLog::stopWriter() {
+	if (_writerStarted) {
+		// Once removed, the timer proc is no longer running
+		g_system->getTimerManager()->removeTimerProc(timerProc);
+		_writerStarted = false;
+	}
+
+	flush();
+}
+
+void AsyncLog::write(LogMessageType::Type type, const char *message) {
+	if (g_system)
+		g_system->logMessage(type, message);
+}
+
+void AsyncLog::timerProc(void *refCon) {
+	((AsyncLog *)refCon)->flush();
+}
+
+} // End of namespace Common
@@ -0,0 +1,120 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ASYNCLOG_H
+#define COMMON_ASYNCLOG_H
+
+#include "common/scummsys.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+#include "common/system.h"
+
+#include <atomic>
+
+namespace Common {
+
+/**
+ * @defgroup common_asynclog Asynchronous log
+ * @ingroup common
+ *
+ * @brief Log sink that writes messages out from a background thread.
+ *
+ * @{
+ */
+
+/**
+ * Lock-free log sink for chatty debug output.
+ *
+ * post() only copies the already formatted message into a fixed ring of
+ * slots, without locking or allocating, so it can be called from any
+ * thread, including the audio thread. The messages are written out in
+ * order by flush(), which a timer proc calls in the background once
+ * startWriter() has been called.
+ *
+ * When the ring is full, messages are dropped rather than waiting for the
+ * writer. The number of dropped messages is reported with the next flush.
+ */
+class AsyncLog : NonCopyable {
+public:
+	static const uint kSlotCount = 1024;  /*!< Number of slots in the ring. Must be a power of two. */
+	static const uint kSlotTextSize = 120; /*!< Number of characters of a message held by a slot. */
+	static const uint kMaxMessageSlots = kSlotCount / 8; /*!< Longer messages are truncated. */
+
+	AsyncLog();
+	virtual ~AsyncLog();
+
+	/**
+	 * Queue a message. It may be split over several slots.
+	 *
+	 * @return False if the ring is full, in which case the message is dropped.
+	 */
+	bool post(LogMessageType::Type type, const char *message);
+
+	/**
+	 * Write out all complete messages queued so far.
+	 * Calls from several threads are serialized.
+	 */
+	void flush();
+
+	/**
+	 * Flush the queued messages every @p interval microseconds from the
+	 * timer thread, until stopWriter() is called.
+	 */
+	void startWriter(int32 interval = 10000);
+
+	/** Stop flushing in the background, and write out the queued messages. */
+	void stopWriter();
+
+	/** Return the number of messages dropped since the log was created. */
+	uint32 getDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+protected:
+	/** Write a single message out. Called by flush(). */
+	virtual void write(LogMessageType::Type type, const char *message);
+
+private:
+	struct Slot {
+		std::atomic<uint32> ready; ///< Position of the slot plus one, once its text is written.
+		byte type;                 ///< LogMessageType::Type of the message.
+		bool more;                 ///< The message continues in the next slot.
+		byte length;               ///< Number of characters in text.
+		char text[kSlotTextSize];
+	};
+
+	static void timerProc(void *refCon);
+
+	Slot _slots[kSlotCount];
+	std::atomic<uint32> _head; ///< Position of the next slot to reserve.
+	std::atomic<uint32> _tail; ///< Position of the next slot to write out, advanced by flush() only.
+	std::atomic<uint32> _dropped;
+
+	Mutex _flushMutex;
+	String _pending;           ///< Start of a message whose next slots are not written yet.
+	uint32 _reportedDropped;
+	bool _writerStarted;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
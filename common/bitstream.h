@@ -41,6 +41,162 @@ namespace Common {
  * @{
  */
 
+/**
+ * A cut-down version of MemoryReadStream specifically for use with BitStream.
+ * It removes the virtual call overhead for reading bytes from a memory buffer,
+ * and allows directly inlining this access.
+ *
+ * The code duplication with MemoryReadStream is not ideal.
+ * It might be possible to avoid this by making this a final subclass of
+ * MemoryReadStream, but that is a C++11 feature.
+ */
+class BitStreamMemoryStream {
+private:
+	const byte * const _ptrOrig;
+	const byte *_ptr;
+	const uint32 _size;
+	uint32 _pos;
+	DisposeAfterUse::Flag _disposeMemory;
+	bool _eos;
+/** @overload */
+public:
+	BitStreamMemoryStream(const byte *dataPtr, uint32 dataSize, DisposeAfterUse::Flag disposeMemory = DisposeAfterUse::NO) :
+		_ptrOrig(dataPtr),
+		_ptr(dataPtr),
+		_size(dataSize),
+		_pos(0),
+		_disposeMemory(disposeMemory),
+		_eos(false) {}
+
+	~BitStreamMemoryStream() {
+		if (_disposeMemory)
+			free(const_cast<byte *>(_ptrOrig));
+	}
+
+	bool eos() const {
+		return _eos;
+	}
+
+	bool err() const {
+		return false;
+	}
+
+	uint32 pos() const {
+		return _pos;
+	}
+
+	uint32 size() const {
+		return _size;
+	}
+
+	bool seek(uint32 offset) {
+		assert(offset <= _size);
+
+		_eos = false;
+		_pos = offset;
+		_ptr = _ptrOrig + _pos;
+		return true;
+	}
+
+	byte readByte() {
+		if (_pos >= _size) {
+			_eos = true;
+			return 0;
+		}
+
+		_pos++;
+		return *_ptr++;
+	}
+
+	uint16 readUint16LE() {
+		if (_pos + 2 > _size) {
+			_eos = true;
+			if (_pos < _size) {
+				_pos++;
+				return *_ptr++;
+			} else {
+				return 0;
+			}
+		}
+
+		uint16 val = READ_LE_UINT16(_ptr);
+
+		_pos += 2;
+		_ptr += 2;
+
+		return val;
+	}
+
+	uint16 readUint16BE() {
+		if (_pos + 2 > _size) {
+			_eos = true;
+			if (_pos < _size) {
+				_pos++;
+				return (*_ptr++) << 8;
+			} else {
+				return 0;
+			}
+		}
+
+		uint16 val = READ_BE_UINT16(_ptr);
+
+		_pos += 2;
+		_ptr += 2;
+
+		return val;
+	}
+
+	uint32 readUint32LE() {
+		if (_pos + 4 > _size) {
+			uint32 val = readByte();
+			val |= (uint32)readByte() << 8;
+			val |= (uint32)readByte() << 16;
+			val |= (uint32)readByte() << 24;
+
+			return val;
+		}
+
+		uint32 val = READ_LE_UINT32(_ptr);
+
+		_pos += 4;
+		_ptr += 4;
+
+		return val;
+	}
+
+	uint32 readUint32BE() {
+		if (_pos + 4 > _size) {
+			uint32 val = (uint32)readByte() << 24;
+			val |= (uint32)readByte() << 16;
+			val |= (uint32)readByte() << 8;
+			val |= (uint32)readByte();
+
+			return val;
+		}
+
+		uint32 val = READ_BE_UINT32(_ptr);
+
+		_pos += 4;
+		_ptr += 4;
+
+		return val;
+	}
+
+	/** Return the data at the current position. */
+	const byte *getData() const {
+		return _ptr;
+	}
+
+	/** Skip @p n bytes, which have to be available. */
+	void skipBytes(uint32 n) {
+		assert(_pos + n <= _size);
+
+		_pos += n;
+		_ptr += n;
+	}
+};
+
+
 /**
  * A template implementing a bit stream for different data memory layouts.
  *
@@ -86,6 +242,13 @@ private:
 
 	/** Fill the container with at least @p min bits. */
 	FORCEINLINE void fillContainer(size_t min) {
+		if (_bitsLeft < min)
+			refill(_stream, min);
+	}
+
+	/** Fill the container with at least @p min bits, reading one data value at a time. */
+	template<class S>
+	void refill(S *, size_t min) {
 		while (_bitsLeft < min) {
 
 			CONTAINER data;
@@ -108,7 +271,50 @@ private:
 
 			_bitsLeft += valueBits;
 		}
-}
+	}
+
+	/**
+	 * Fill the container from memory with as many data values as fit, using
+	 * a single 64-bit read. Near the end of the data, the values are read one
+	 * at a time, as for any other stream.
+	 */
+	FORCEINLINE void refill(BitStreamMemoryStream *stream, size_t min) {
+		const uint32 bits = (64 - _bitsLeft) / valueBits * valueBits;
+		if (sizeof(CONTAINER) != 8 || _pos + _bitsLeft + bits > _size || stream->pos() + 8 > stream->size()) {
+			refill<BitStreamMemoryStream>(stream, min);
+			return;
+		}
+
+		// Read the values in the order they are handed out, starting with the
+		// most significant bits when MSB2LSB, and with the least significant
+		// ones otherwise
+		const byte *ptr = stream->getData();
+		uint64 data;
+		if (valueBits == 8)
+			data = MSB2LSB ? READ_BE_UINT64(ptr) : READ_LE_UINT64(ptr);
+		else if (isLE != MSB2LSB)
+			data = isLE ? READ_LE_UINT64(ptr) : READ_BE_UINT64(ptr);
+		else
+			data = swapValues(isLE ? READ_LE_UINT64(ptr) : READ_BE_UINT64(ptr));
+
+		if (MSB2LSB)
+			_bitContainer |= (CONTAINER)((data & (~(uint64)0 << (64 - bits))) >> _bitsLeft);
+		else if (bits < 64)
+			_bitContainer |= (CONTAINER)((data & (((uint64)1 << bits) - 1)) << _bitsLeft);
+		else
+			_bitContainer = (CONTAINER)data;
+
+		_bitsLeft += bits;
+		stream->skipBytes(bits / 8);
+	}
+
+	/** Reverse the order of the 16-bit or 32-bit data values in a 64-bit word. */
+	FORCEINLINE static uint64 swapValues(uint64 data) {
+		data = (data >> 32) | (data << 32);
+		if (valueBits == 16)
+			data = ((data >> 16) & 0x0000FFFF0000FFFFULL) | ((data & 0x0000FFFF0000FFFFULL) << 16);
+		return data;
+	}
 
 	/** Get @p n bits from the bit container. */
 	FORCEINLINE static uint32 getNBits(CONTAINER value, size_t n) {
@@ -323,151 +529,6 @@ public:
 	}
 };
 
-
-
-/**
- * A cut-down version of MemoryReadStream specifically for use with BitStream.
- * It removes the virtual call overhead for reading bytes from a memory buffer,
- * and allows directly inlining this access.
- *
- * The code duplication with MemoryReadStream is not ideal.
- * It might be possible to avoid this by making this a final subclass of
- * MemoryReadStream, but that is a C++11 feature.
- */
-class BitStreamMemoryStream {
-private:
-	const byte * const _ptrOrig;
-	const byte *_ptr;
-	const uint32 _size;
-	uint32 _pos;
-	DisposeAfterUse::Flag _disposeMemory;
-	bool _eos;
-/** @overload */
-public:
-	BitStreamMemoryStream(const byte *dataPtr, uint32 dataSize, DisposeAfterUse::Flag disposeMemory = DisposeAfterUse::NO) :
-		_ptrOrig(dataPtr),
-		_ptr(dataPtr),
-		_size(dataSize),
-		_pos(0),
-		_disposeMemory(disposeMemory),
-		_eos(false) {}
-
-	~BitStreamMemoryStream() {
-		if (_disposeMemory)
-			free(const_cast<byte *>(_ptrOrig));
-	}
-
-	bool eos() const {
-		return _eos;
-	}
-
-	bool err() const {
-		return false;
-	}
-
-	uint32 pos() const {
-		return _pos;
-	}
-
-	uint32 size() const {
-		return _size;
-	}
-
-	bool seek(uint32 offset) {
-		assert(offset <= _size);
-
-		_eos = false;
-		_pos = offset;
-		_ptr = _ptrOrig + _pos;
-		return true;
-	}
-
-	byte readByte() {
-		if (_pos >= _size) {
-			_eos = true;
-			return 0;
-		}
-
-		_pos++;
-		return *_ptr++;
-	}
-
-	uint16 readUint16LE() {
-		if (_pos + 2 > _size) {
-			_eos = true;
-			if (_pos < _size) {
-				_pos++;
-				return *_ptr++;
-			} else {
-				return 0;
-			}
-		}
-
-		uint16 val = READ_LE_UINT16(_ptr);
-
-		_pos += 2;
-		_ptr += 2;
-
-		return val;
-	}
-
-	uint16 readUint16BE() {
-		if (_pos + 2 > _size) {
-			_eos = true;
-			if (_pos < _size) {
-				_pos++;
-				return (*_ptr++) << 8;
-			} else {
-				return 0;
-			}
-		}
-
-		uint16 val = READ_LE_UINT16(_ptr);
-
-		_pos += 2;
-		_ptr += 2;
-
-		return val;
-	}
-
-	uint32 readUint32LE() {
-		if (_pos + 4 > _size) {
-			uint32 val = readByte();
-			val |= (uint32)readByte() << 8;
-			val |= (uint32)readByte() << 16;
-			val |= (uint32)readByte() << 24;
-
-			return val;
-		}
-
-		uint32 val = READ_LE_UINT32(_ptr);
-
-		_pos += 4;
-		_ptr += 4;
-
-		return val;
-	}
-
-	uint32 readUint32BE() {
-		if (_pos + 4 > _size) {
-			uint32 val = (uint32)readByte() << 24;
-			val |= (uint32)readByte() << 16;
-			val |= (uint32)readByte() << 8;
-			val |= (uint32)readByte();
-
-			return val;
-		}
-
-		uint32 val = READ_BE_UINT32(_ptr);
-
-		_pos += 4;
-		_ptr += 4;
-
-		return val;
-	}
-
-};
-
 /**
  * @name Typedefs for various memory layouts
  * @{
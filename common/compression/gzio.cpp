@@ -34,6 +34,7 @@
    comments to that effect with your name and the date.  Thank you.
  */
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/endian.h"
 #include "common/stream.h"
@@ -256,6 +257,32 @@ private:
 	static const int WSIZE = 0x8000;
 	static const int INBUFSIZ = 0x2000;
 
+  /*
+   *  Seek points
+   *
+   *  The decompression state is saved at block boundaries about every
+   *  SEEK_POINT_SPAN bytes, so that seeking does not have to decompress
+   *  the whole stream from its start again.
+   */
+
+	static const int SEEK_POINT_SPAN = 0x100000;
+
+	struct SeekPoint {
+		/* The position in the uncompressed data.  */
+		int64 pos;
+		/* The offset of the window holding pos.  */
+		int64 windowOffset;
+		/* The offset of the next byte after the bit buffer in the underlying file.  */
+		int64 inputOffset;
+		/* The bit buffer and the bits in it.  */
+		unsigned long bb;
+		unsigned bk;
+		/* The sliding window.  */
+		Common::Array<uint8> slide;
+	};
+
+	Common::Array<SeekPoint> _seekPoints;
+
 	/* If input is in memory following fields are used instead of file.  */
 	Common::DisposablePtr<Common::SeekableReadStream> _input;
 	/* The offset at which the data starts in the underlying file.  */
@@ -302,6 +329,9 @@ private:
 	bool _eos;
 
 	void inflate_window();
+	void resume_window();
+	void add_seek_point();
+	bool restore_seek_point(int64 offset);
 	void get_new_block();
 	byte parentGetByte();
 	void parentSeek(int64 off);
@@ -1022,6 +1052,13 @@ GzioReadStream::inflate_window ()
   /* initialize window */
   _wp = 0;
 
+  resume_window ();
+}
+
+
+void
+GzioReadStream::resume_window ()
+{
   /*
    *  Main decompression loop.
    */
@@ -1040,6 +1077,9 @@ GzioReadStream::inflate_window ()
 	      break;
 	    }
 
+	  if (_seekPoints.empty () || _savedOffset + _wp >= _seekPoints.back ().pos + SEEK_POINT_SPAN)
+	    add_seek_point ();
+
 	  get_new_block ();
 	}
 
@@ -1088,6 +1128,61 @@ GzioReadStream::inflate_window ()
 }
 
 
+void
+GzioReadStream::add_seek_point ()
+{
+  /* Nothing to gain before the first window is full */
+  if (_savedOffset + _wp < SEEK_POINT_SPAN)
+    return;
+
+  SeekPoint point;
+  point.pos = _savedOffset + _wp;
+  point.windowOffset = _savedOffset;
+  point.inputOffset = _input->pos () - (_inbufSize - _inbufD);
+  point.bb = _bb;
+  point.bk = _bk;
+  point.slide = Common::Array<uint8> (_slide, WSIZE);
+  _seekPoints.push_back (point);
+}
+
+
+/*
+ *  Resume the decompression from the closest seek point preceding offset,
+ *  if that is any closer than the current window.
+ */
+
+bool
+GzioReadStream::restore_seek_point (int64 offset)
+{
+  const SeekPoint *point = nullptr;
+  for (uint i = _seekPoints.size (); i-- > 0;)
+    if (_seekPoints[i].pos <= offset)
+      {
+	point = &_seekPoints[i];
+	break;
+      }
+
+  if (! point || (point->windowOffset < _savedOffset && _savedOffset <= offset + WSIZE))
+    return false;
+
+  parentSeek (point->inputOffset);
+  _bb = point->bb;
+  _bk = point->bk;
+  _lastBlock = 0;
+  _blockLen = 0;
+  huft_free (_tl);
+  huft_free (_td);
+  _tl = NULL;
+  _td = NULL;
+
+  memcpy (_slide, point->slide.data (), WSIZE);
+  _wp = point->pos - point->windowOffset;
+  _savedOffset = point->windowOffset;
+  resume_window ();
+  return true;
+}
+
+
 void
 GzioReadStream::initialize_tables()
 {
@@ -1240,8 +1335,9 @@ GzioReadStream::readAtOffset (int64 offset, byte *buf, uint32 len)
 {
   int32 ret = 0;
 
-  /* Do we reset decompression to the beginning of the file?  */
-  if (_savedOffset > offset + WSIZE)
+  /* Do we resume decompression from a seek point, or reset it to the
+     beginning of the file?  */
+  if (!restore_seek_point (offset) && _savedOffset > offset + WSIZE)
     initialize_tables();
 
   /*
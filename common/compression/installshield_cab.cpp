@@ -83,6 +83,121 @@ bool inflateZlibInstallShield(byte *dst, uint dstLen, const byte *src, uint srcL
 	return true;
 }
 
+// Compressed files at least this big are decompressed while they are read
+const uint32 kStreamedFileSize = 512 * 1024;
+
+/**
+ * Stream decompressing files stored in the custom InstallShield format,
+ * where each chunk of deflate data is preceded by its 16-bit size.
+ * Seeking backwards restarts the decompression from the first chunk.
+ */
+class ChunkedInflateReadStream : public SeekableReadStream {
+public:
+	ChunkedInflateReadStream(SeekableReadStream *parent, uint32 begin, uint32 end, uint32 size) :
+		_parent(parent), _begin(begin), _end(end), _size(size), _pos(0), _nextChunk(begin), _eos(false), _err(false) {}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override;
+	bool seek(int64 offset, int whence = SEEK_SET) override;
+
+	bool eos() const override { return _eos; }
+	bool err() const override { return _err; }
+	void clearErr() override { _eos = false; _err = false; }
+
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _size; }
+
+private:
+	bool openNextChunk();
+
+	ScopedPtr<SeekableReadStream> _parent;
+	ScopedPtr<SeekableReadStream> _chunk;
+	uint32 _begin;
+	uint32 _end;
+	uint32 _size;
+	uint32 _pos;
+	uint32 _nextChunk;
+	bool _eos;
+	bool _err;
+};
+
+bool ChunkedInflateReadStream::openNextChunk() {
+	if (_nextChunk + 2 > _end)
+		return false;
+
+	_parent->seek(_nextChunk);
+	const uint32 chunkBegin = _nextChunk + 2;
+	const uint32 chunkEnd = chunkBegin + _parent->readUint16LE();
+	if (chunkEnd > _end)
+		return false;
+
+	_nextChunk = chunkEnd;
+	_chunk.reset(wrapDeflateReadStream(new SeekableSubReadStream(_parent.get(), chunkBegin, chunkEnd), DisposeAfterUse::YES));
+	return _chunk;
+}
+
+uint32 ChunkedInflateReadStream::read(void *dataPtr, uint32 dataSize) {
+	if (dataSize > _size - _pos) {
+		dataSize = _size - _pos;
+		_eos = true;
+	}
+
+	byte *dst = (byte *)dataPtr;
+	uint32 total = 0;
+	while (total < dataSize) {
+		const bool newChunk = !_chunk;
+		if (newChunk && !openNextChunk()) {
+			_err = true;
+			break;
+		}
+
+		const uint32 wanted = dataSize - total;
+		const uint32 got = _chunk->read(dst + total, wanted);
+		total += got;
+
+		// Chunks end when their deflate data runs out
+		if (got < wanted) {
+			_chunk.reset();
+			if (newChunk && got == 0) {
+				_err = true;
+				break;
+			}
+		}
+	}
+
+	_pos += total;
+	return total;
+}
+
+bool ChunkedInflateReadStream::seek(int64 offset, int whence) {
+	switch (whence) {
+	case SEEK_END:
+		offset += _size;
+		break;
+	case SEEK_CUR:
+		offset += _pos;
+		break;
+	case SEEK_SET:
+	default:
+		break;
+	}
+
+	if (offset < 0 || offset > _size)
+		return false;
+
+	if ((uint32)offset < _pos) {
+		_chunk.reset();
+		_nextChunk = _begin;
+		_pos = 0;
+	}
+
+	byte buffer[1024];
+	while (_pos < (uint32)offset && !_err)
+		read(buffer, MIN<uint32>(sizeof(buffer), offset - _pos));
+
+	_eos = false;
+	return !_err;
+}
+
 class InstallShieldCabinet : public Archive {
 public:
 	InstallShieldCabinet();
@@ -410,13 +525,28 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const Path &
 	if (!(entry.flags & kCompressed)) {
 		if (src == nullptr) {
 			// File not split, return a substream
-			return new SeekableSubReadStream(stream.release(), entry.offset, entry.offset + entry.uncompressedSize, DisposeAfterUse::YES);
+			return createSliceReadStream(stream.release(), entry.offset, entry.offset + entry.uncompressedSize, DisposeAfterUse::YES);
 		} else {
 			// File split, return the assembled data
 			return new MemoryReadStream(src, entry.uncompressedSize, DisposeAfterUse::YES);
 		}		
 	}
 
+	// Big files are decompressed on demand, as engines often only read parts
+	// of them, like the header of a movie
+	if (!src && entry.uncompressedSize >= kStreamedFileSize && entry.compressedSize >= 4) {
+		const uint32 end = entry.offset + entry.compressedSize;
+		stream->seek(end - 4);
+		if (stream->readUint32BE() == 0xFFFF) {
+			// A single deflate stream. Reads past the end of the file
+			// are cut, as it does not need to have a final block.
+			SeekableReadStream *inflated = wrapDeflateReadStream(createSliceReadStream(stream.release(), entry.offset, end, DisposeAfterUse::YES), DisposeAfterUse::YES, entry.uncompressedSize);
+			return inflated ? new SeekableSubReadStream(inflated, 0, entry.uncompressedSize, DisposeAfterUse::YES) : nullptr;
+		}
+
+		return new ChunkedInflateReadStream(stream.release(), entry.offset, end, entry.uncompressedSize);
+	}
+
 	byte *dst = (byte *)malloc(entry.uncompressedSize);
 
 	if (!src) {
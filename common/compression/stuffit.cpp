@@ -101,6 +101,9 @@ private:
 	Common::SharedArchiveContents readContentsForPathFork(const Common::Path &translatedPath, bool isResFork) const;
 };
 
+// Uncompressed forks at least this big are not loaded into memory
+static const uint32 kStreamedForkSize = 512 * 1024;
+
 StuffItArchive::StuffItArchive() : Common::MemcachingCaseInsensitiveArchive(), _flattenTree(false) {
 	_stream = nullptr;
 }
@@ -335,6 +338,11 @@ Common::SharedArchiveContents StuffItArchive::readContentsForPathFork(const Comm
 	if (entryFork.compression & 0xF0)
 		error("Unhandled StuffIt encryption");
 
+	// Big uncompressed forks, like movies, are read straight from the
+	// archive instead of being loaded into memory. Their CRC is not checked.
+	if (entryFork.compression == 0 && entryFork.uncompressedSize >= kStreamedForkSize)
+		return Common::SharedArchiveContents::bypass(new Common::SafeSeekableSubReadStream(_stream, entryFork.offset, entryFork.offset + entryFork.uncompressedSize));
+
 	Common::SeekableSubReadStream subStream(_stream, entryFork.offset, entryFork.offset + entryFork.compressedSize);
 
 	byte *uncompressedBlock = new byte[entryFork.uncompressedSize];
@@ -33,6 +33,7 @@
 
 #include "common/compression/deflate.h"
 
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -87,15 +88,34 @@ bool inflateZlibHeaderless(byte *dst, uint *dstLen, const byte *src, uint srcLen
 static bool _shownBackwardSeekingWarning = false;
 #endif
 
+// Seek points need inflateGetDictionary(), added in zlib 1.2.7.1
+#if ZLIB_VERNUM >= 0x1271
+#define GZIP_HAS_SEEK_POINTS
+#endif
+
 /**
  * A simple wrapper class which can be used to wrap around an arbitrary
  * other SeekableReadStream and will then provide on-the-fly decompression support.
  * Assumes the compressed data to be in gzip format.
+ *
+ * While decompressing, the state of the decompressor is saved at deflate
+ * block boundaries about every SEEK_POINT_SPAN bytes. Seeking resumes from
+ * the closest of these seek points, instead of having to decompress all of
+ * the data from the start again.
  */
 class GZipReadStream : public SeekableReadStream {
 protected:
 	enum {
-		BUFSIZE = 16384		// 1 << MAX_WBITS
+		BUFSIZE = 16384,		// 1 << MAX_WBITS
+		WINDOWSIZE = 32768,		// 1 << MAX_WBITS
+		SEEK_POINT_SPAN = 1 << 20
+	};
+
+	struct SeekPoint {
+		uint32 pos;			///< Position in the decompressed data
+		int64 parentPos;	///< Position of the first input byte not fully consumed
+		int bits;			///< Number of bits of the previous input byte not consumed yet
+		Array<byte> window;	///< The decompressed data preceding pos
 	};
 
 	byte	_buf[BUFSIZE];
@@ -103,10 +123,56 @@ protected:
 	DisposablePtr<SeekableReadStream> _wrapped;
 	z_stream _stream;
 	int _zlibErr;
+	int _windowBits;
 	uint64 _parentPos;
 	uint32 _pos;
 	uint32 _origSize;
 	bool _eos;
+	Array<SeekPoint> _seekPoints;
+
+	void addSeekPoint(uint32 pos) {
+#ifdef GZIP_HAS_SEEK_POINTS
+		SeekPoint point;
+		point.pos = pos;
+		point.parentPos = _wrapped->pos() - _stream.avail_in;
+		point.bits = _stream.data_type & 7;
+		point.window.resize(WINDOWSIZE);
+
+		uInt windowSize = WINDOWSIZE;
+		if (inflateGetDictionary(&_stream, point.window.data(), &windowSize) != Z_OK)
+			return;
+
+		point.window.resize(windowSize);
+		_seekPoints.push_back(point);
+#endif
+	}
+
+	bool restoreSeekPoint(const SeekPoint &point) {
+#ifdef GZIP_HAS_SEEK_POINTS
+		// The deflate stream is resumed on its own, without any header
+		_zlibErr = inflateReset2(&_stream, -MAX_WBITS);
+		if (_zlibErr != Z_OK)
+			return false;
+
+		_wrapped->seek(point.parentPos - (point.bits ? 1 : 0), SEEK_SET);
+		if (point.bits) {
+			_zlibErr = inflatePrime(&_stream, point.bits, _wrapped->readByte() >> (8 - point.bits));
+			if (_zlibErr != Z_OK)
+				return false;
+		}
+
+		_zlibErr = inflateSetDictionary(&_stream, const_cast<byte *>(point.window.data()), point.window.size());
+		if (_zlibErr != Z_OK)
+			return false;
+
+		_pos = point.pos;
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+		return true;
+#else
+		return false;
+#endif
+	}
 
 public:
 
@@ -137,7 +203,8 @@ public:
 		// the compressed file. This feature was added in zlib 1.2.0.4,
 		// released 10 August 2003.
 		// Note: This is *crucial* for savegame compatibility, do *not* remove!
-		_zlibErr = inflateInit2(&_stream, MAX_WBITS + 32);
+		_windowBits = MAX_WBITS + 32;
+		_zlibErr = inflateInit2(&_stream, _windowBits);
 		if (_zlibErr != Z_OK)
 			return;
 
@@ -157,7 +224,8 @@ public:
 		_pos = 0;
 		_eos = false;
 
-		_zlibErr = inflateInit2(&_stream, -MAX_WBITS);
+		_windowBits = -MAX_WBITS;
+		_zlibErr = inflateInit2(&_stream, _windowBits);
 		if (_zlibErr != Z_OK)
 			return;
 
@@ -194,7 +262,20 @@ public:
 				_stream.next_in = _buf;
 				_stream.avail_in = _wrapped->read(_buf, BUFSIZE);
 			}
+#ifdef GZIP_HAS_SEEK_POINTS
+			// Stop at block boundaries, which are the only places where
+			// the decompression can be resumed from
+			_zlibErr = inflate(&_stream, Z_BLOCK);
+
+			// Bit 7 of data_type tells that a block just ended, bit 6 that
+			// it was the last one
+			const uint32 pos = _pos + dataSize - _stream.avail_out;
+			const uint32 lastPos = _seekPoints.empty() ? 0 : _seekPoints.back().pos;
+			if (_zlibErr == Z_OK && (_stream.data_type & 192) == 128 && pos >= lastPos + SEEK_POINT_SPAN)
+				addSeekPoint(pos);
+#else
 			_zlibErr = inflate(&_stream, Z_NO_FLUSH);
+#endif
 		}
 
 		// Update the position counter
@@ -234,7 +315,19 @@ public:
 
 		assert(newPos >= 0);
 
-		if ((uint32)newPos < _pos) {
+		// Find the closest seek point preceding the new position
+		const SeekPoint *point = nullptr;
+		for (uint i = _seekPoints.size(); i-- > 0;) {
+			if (_seekPoints[i].pos <= (uint32)newPos) {
+				point = &_seekPoints[i];
+				break;
+			}
+		}
+
+		if (point && (point->pos > _pos || (uint32)newPos < _pos)) {
+			if (!restoreSeekPoint(*point))
+				return false;
+		} else if ((uint32)newPos < _pos) {
 			// To search backward, we have to restart the whole decompression
 			// from the start of the file. A rather wasteful operation, best
 			// to avoid it. :/
@@ -251,7 +344,12 @@ public:
 
 			_pos = 0;
 			_wrapped->seek(_parentPos, SEEK_SET);
+#ifdef GZIP_HAS_SEEK_POINTS
+			// Seek points switch the stream to raw deflate, so restore the format
+			_zlibErr = inflateReset2(&_stream, _windowBits);
+#else
 			_zlibErr = inflateReset(&_stream);
+#endif
 			if (_zlibErr != Z_OK)
 				return false; // FIXME: STREAM REWRITE
 			_stream.next_in = _buf;
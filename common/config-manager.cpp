@@ -23,6 +23,8 @@
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/md5.h"
+#include "common/memstream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -50,7 +52,7 @@ char const *const ConfigManager::kCloudDomain = "cloud";
 #pragma mark -
 
 
-ConfigManager::ConfigManager() : _activeDomain(nullptr) {
+ConfigManager::ConfigManager() : _activeDomain(nullptr), _hasFileDigest(false) {
 }
 
 void ConfigManager::defragment() {
@@ -75,6 +77,8 @@ void ConfigManager::copyFrom(ConfigManager &source) {
 	_activeDomainName = source._activeDomainName;
 	_activeDomain = &_gameDomains[_activeDomainName];
 	_filename = source._filename;
+	memcpy(_fileDigest, source._fileDigest, sizeof(_fileDigest));
+	_hasFileDigest = source._hasFileDigest;
 }
 
 
@@ -83,6 +87,7 @@ bool ConfigManager::loadDefaultConfigFile(const Path &fallbackFilename) {
 	assert(g_system);
 	SeekableReadStream *stream = g_system->createConfigReadStream();
 	_filename.clear(); // clear the filename to indicate that we are using the default config file
+	_hasFileDigest = false;
 
 	bool loadResult = false;
 	// ... load it, if available ...
@@ -105,6 +110,7 @@ bool ConfigManager::loadDefaultConfigFile(const Path &fallbackFilename) {
 
 bool ConfigManager::loadConfigFile(const Path &filename, const Path &fallbackFilename) {
 	_filename = filename;
+	_hasFileDigest = false;
 
 	FSNode node(filename);
 	File cfg_file;
@@ -128,6 +134,9 @@ bool ConfigManager::loadFallbackConfigFile(const Path &filename) {
 
 	debug("Using initial configuration file: %s", filename.toString(Common::Path::kNativeSeparator).c_str());
 	loadFromStream(fallbackFile);
+
+	// The actual configuration file still has to be written
+	_hasFileDigest = false;
 	return true;
 }
 
@@ -171,7 +180,29 @@ void ConfigManager::addDomain(const String &domainName, const ConfigManager::Dom
 
 
 bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
+	// Reading the whole file at once and splitting it into lines in memory
+	// is much faster than reading it line by line
+	Array<char> data;
+	const int64 size = stream.size() - stream.pos();
+	if (size > 0) {
+		data.resize(size);
+		data.resize(stream.read(data.begin(), size));
+	}
+	if (stream.err()) {
+		warning("Config file could not be read");
+		return false;
+	}
+
+	MemoryReadStream digestStream((const byte *)data.begin(), data.size());
+	computeStreamMD5(digestStream, _fileDigest);
+	_hasFileDigest = true;
+
+	return parseConfig(data.begin(), data.size());
+}
+
+bool ConfigManager::parseConfig(const char *data, uint32 size) {
 	static const byte UTF8_BOM[] = {0xEF, 0xBB, 0xBF};
+	const char *const dataEnd = data + size;
 	String domainName;
 	String comment;
 	Domain domain;
@@ -189,19 +220,29 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 	_cloudDomain.clear();
 #endif
 
+	// Skip UTF-8 byte-order mark if added by a text editor.
+	if (size >= 3 && memcmp(data, UTF8_BOM, 3) == 0)
+		data += 3;
+
 	// TODO: Detect if a domain occurs multiple times (or likewise, if
 	// a key occurs multiple times inside one domain).
 
-	while (!stream.eos() && !stream.err()) {
+	while (data < dataEnd) {
 		lineno++;
 
-		// Read a line
-		String line = stream.readLine();
+		// Find the end of the line. Like SeekableReadStream::readLine(),
+		// this accepts LF, CR/LF and CR line breaks.
+		const char *lineEnd = data;
+		while (lineEnd < dataEnd && *lineEnd != '\n' && *lineEnd != '\r')
+			lineEnd++;
 
-		// Skip UTF-8 byte-order mark if added by a text editor.
-		if (lineno == 1 && memcmp(line.c_str(), UTF8_BOM, 3) == 0) {
-			line.erase(0, 3);
-		}
+		String line(data, lineEnd);
+
+		data = lineEnd;
+		if (data < dataEnd && *data == '\r')
+			data++;
+		if (data < dataEnd && *data == '\n')
+			data++;
 
 		if (line.size() == 0) {
 			// Do nothing
@@ -285,58 +326,80 @@ bool ConfigManager::loadFromStream(SeekableReadStream &stream) {
 
 void ConfigManager::flushToDisk() {
 #ifndef __DC__
-	WriteStream *stream;
-
-	if (_filename.empty()) {
-		// Write to the default config file
-		assert(g_system);
-		stream = g_system->createConfigWriteStream();
-		if (!stream)    // If writing to the config file is not possible, do nothing
-			return;
-	} else {
-		DumpFile *dump = new DumpFile();
-		assert(dump);
-
-		if (!dump->open(_filename)) {
-			warning("Unable to write configuration file: %s", _filename.toString(Common::Path::kNativeSeparator).c_str());
-			delete dump;
-			return;
-		}
-
-		stream = dump;
-	}
+	// Build the whole file in memory first. This allows skipping the write
+	// if nothing changed, and writes the file in one go otherwise.
+	MemoryWriteStreamDynamic config(DisposeAfterUse::YES);
 
 	// Write the application domain
-	writeDomain(*stream, kApplicationDomain, _appDomain);
+	writeDomain(config, kApplicationDomain, _appDomain);
 
 	// Write the keymapper domain
-	writeDomain(*stream, kKeymapperDomain, _keymapperDomain);
+	writeDomain(config, kKeymapperDomain, _keymapperDomain);
 #ifdef USE_CLOUD
 	// Write the cloud domain
-	writeDomain(*stream, kCloudDomain, _cloudDomain);
+	writeDomain(config, kCloudDomain, _cloudDomain);
 #endif
 
 	DomainMap::const_iterator d;
 
 	// Write the miscellaneous domains next
 	for (d = _miscDomains.begin(); d != _miscDomains.end(); ++d) {
-		writeDomain(*stream, d->_key, d->_value);
+		writeDomain(config, d->_key, d->_value);
 	}
 
 	// First write the domains in _domainSaveOrder, in that order.
 	// Note: It's possible for _domainSaveOrder to list domains which
 	// are not present anymore, so we validate each name.
+	HashMap<String, bool> written;
 	Array<String>::const_iterator i;
 	for (i = _domainSaveOrder.begin(); i != _domainSaveOrder.end(); ++i) {
-		if (_gameDomains.contains(*i)) {
-			writeDomain(*stream, *i, _gameDomains[*i]);
+		if (_gameDomains.contains(*i) && !written.contains(*i)) {
+			writeDomain(config, *i, _gameDomains[*i]);
+			written[*i] = true;
 		}
 	}
 
 	// Now write the domains which haven't been written yet
 	for (d = _gameDomains.begin(); d != _gameDomains.end(); ++d) {
-		if (find(_domainSaveOrder.begin(), _domainSaveOrder.end(), d->_key) == _domainSaveOrder.end())
-			writeDomain(*stream, d->_key, d->_value);
+		if (!written.contains(d->_key))
+			writeDomain(config, d->_key, d->_value);
+	}
+
+	uint8 digest[16];
+	MemoryReadStream digestStream(config.getData(), config.size());
+	computeStreamMD5(digestStream, digest);
+	if (_hasFileDigest && !memcmp(digest, _fileDigest, sizeof(digest)))
+		return;
+
+	WriteStream *stream;
+
+	if (_filename.empty()) {
+		// Write to the default config file
+		assert(g_system);
+		stream = g_system->createConfigWriteStream();
+		if (!stream)    // If writing to the config file is not possible, do nothing
+			return;
+	} else {
+		DumpFile *dump = new DumpFile();
+		assert(dump);
+
+		if (!dump->open(_filename)) {
+			warning("Unable to write configuration file: %s", _filename.toString(Common::Path::kNativeSeparator).c_str());
+			delete dump;
+			return;
+		}
+
+		stream = dump;
+	}
+
+	stream->write(config.getData(), config.size());
+	stream->finalize();
+	if (stream->err()) {
+		warning("Unable to write configuration file");
+		_hasFileDigest = false;
+	} else {
+		memcpy(_fileDigest, digest, sizeof(digest));
+		_hasFileDigest = true;
 	}
 
 	delete stream;
@@ -233,6 +233,7 @@ private:
 
 	bool			loadFallbackConfigFile(const Path &filename);
 	bool			loadFromStream(SeekableReadStream &stream);
+	bool			parseConfig(const char *data, uint32 size);
 	void			addDomain(const String &domainName, const Domain &domain);
 	void			writeDomain(WriteStream &stream, const String &name, const Domain &domain);
 	void			renameDomain(const String &oldName, const String &newName, DomainMap &map);
@@ -257,6 +258,14 @@ private:
 	Domain *		_activeDomain;
 
 	Path			_filename;
+
+	/**
+	 * MD5 checksum of the configuration file as it was last read or written.
+	 * flushToDisk() does not write the file again when its contents are
+	 * unchanged.
+	 */
+	uint8			_fileDigest[16];
+	bool			_hasFileDigest;
 };
 
 /** @} */
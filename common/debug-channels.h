@@ -32,8 +32,12 @@
 
 #include "engines/metaengine.h"
 
+#include <atomic>
+
 namespace Common {
 
+class AsyncLog;
+
 /**
  * @defgroup common_debug_channels Debug channels
  * @ingroup common
@@ -150,6 +154,23 @@ public:
 	 */
 	bool isDebugChannelEnabled(uint32 channel, bool enforce = false);
 
+	/**
+	 * Write the debug output from a background thread through an AsyncLog,
+	 * instead of writing it out while the debug functions are called.
+	 *
+	 * This keeps chatty debug channels from changing the timing of the
+	 * code being traced. The output of other log functions, like warning(),
+	 * is still written out immediately, so it may appear out of order with
+	 * the debug output.
+	 */
+	void enableAsyncLog(bool enable);
+
+	/**
+	 * Return the log the debug output is queued to, or nullptr when it is
+	 * written out immediately.
+	 */
+	AsyncLog *getAsyncLog() const { return _asyncLog.load(std::memory_order_acquire); }
+
 private:
 	typedef HashMap<String, DebugChannel, IgnoreCase_Hash, IgnoreCase_EqualTo> DebugChannelMap;
 	typedef HashMap<uint32, bool> EnabledChannelsMap;
@@ -157,10 +178,13 @@ private:
 	DebugChannelMap _debugChannels;
 	EnabledChannelsMap _debugChannelsEnabled;
 	uint32 _globalChannelsMask;
+	std::atomic<AsyncLog *> _asyncLog; ///< Log the debug output goes to, or nullptr.
+	AsyncLog *_asyncLogRing;           ///< Kept once created, as posters may still use it.
 
 	friend class Singleton<SingletonBaseType>;
 
 	DebugManager();
+	~DebugManager();
 
 	/**
 	 * Internal method for adding an array of debug channels.
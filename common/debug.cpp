@@ -21,6 +21,7 @@
 
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/asynclog.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/algorithm.h"
@@ -52,7 +53,7 @@ struct DebugLevelComperator {
 
 } // end of anonymous namespace
 
-DebugManager::DebugManager() {
+DebugManager::DebugManager() : _asyncLog(nullptr), _asyncLogRing(nullptr) {
 	addDebugChannels(gDebugChannels);
 
 	// Create global debug channels mask
@@ -62,6 +63,28 @@ DebugManager::DebugManager() {
 	}
 }
 
+DebugManager::~DebugManager() {
+	// The debug functions are not called anymore at this point, so the
+	// ring can go. Its destructor writes out the messages posted late.
+	enableAsyncLog(false);
+	delete _asyncLogRing;
+}
+
+void DebugManager::enableAsyncLog(bool enable) {
+	if (enable && !_asyncLog.load(std::memory_order_relaxed)) {
+		if (!_asyncLogRing)
+			_asyncLogRing = new AsyncLog();
+		_asyncLogRing->startWriter();
+		_asyncLog.store(_asyncLogRing, std::memory_order_release);
+	} else if (!enable && _asyncLog.load(std::memory_order_relaxed)) {
+		// Another thread may still be posting through the pointer it got
+		// before, so the ring is kept until shutdown. Anything posted after
+		// the flush below is written out when the ring is flushed again.
+		_asyncLog.store(nullptr, std::memory_order_release);
+		_asyncLogRing->stopWriter();
+	}
+}
+
 bool DebugManager::addDebugChannel(uint32 channel, const String &name, const String &description) {
 	if (name.equalsIgnoreCase("all")) {
 		warning("Debug channel 'all' is reserved for internal use");
@@ -185,12 +208,35 @@ bool debugChannelSet(int level, uint32 debugChannels) {
 #ifndef DISABLE_TEXT_CONSOLE
 
 static void debugHelper(const char *s, va_list va, bool caret = true) {
+	Common::AsyncLog *asyncLog = Common::DebugManager::hasInstance() ? DebugMan.getAsyncLog() : nullptr;
+
+	if (asyncLog) {
+		// Format into the stack when possible, as this may run on the
+		// audio thread
+		char buf[256];
+		va_list vaCopy;
+		scumm_va_copy(vaCopy, va);
+		int len = vsnprintf(buf, sizeof(buf) - 1, s, vaCopy);
+		va_end(vaCopy);
+
+		if (len >= 0 && len < (int)sizeof(buf) - 1) {
+			if (caret) {
+				buf[len] = '\n';
+				buf[len + 1] = '\0';
+			}
+			asyncLog->post(LogMessageType::kDebug, buf);
+			return;
+		}
+	}
+
 	Common::String buf = Common::String::vformat(s, va);
 
 	if (caret)
 		buf += '\n';
 
-	if (g_system)
+	if (asyncLog)
+		asyncLog->post(LogMessageType::kDebug, buf.c_str());
+	else if (g_system)
 		g_system->logMessage(LogMessageType::kDebug, buf.c_str());
 	// TODO: Think of a good fallback in case we do not have
 	// any OSystem yet.
@@ -114,7 +114,10 @@ enum EventType {
 
 	/** ScummVM has gained or lost focus. */
 	EVENT_FOCUS_GAINED = 36,
-	EVENT_FOCUS_LOST = 37
+	EVENT_FOCUS_LOST = 37,
+
+	/** Show or hide the frame profiler, see Common::Profiler. */
+	EVENT_PROFILER = 38
 };
 
 const int16 JOYAXIS_MIN = -32768;
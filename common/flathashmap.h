@@ -0,0 +1,591 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+#include "common/hashmap.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_flathashmap Flat hash table (FlatHashMap)
+ * @ingroup common
+ *
+ * @brief API for operations on a hash table with flat storage.
+ *
+ * @{
+ */
+
+/**
+ * FlatHashMap<Key,Val> is a drop-in alternative to HashMap for hot lookup
+ * tables. It has the same interface, but stores the nodes directly in the
+ * table using Robin Hood hashing with linear probing. Each slot also keeps
+ * the hash of its key and its distance from the home slot in separate
+ * arrays, so most mismatches are rejected without touching the nodes, and
+ * erasing doesn't leave tombstones behind.
+ *
+ * In exchange, the nodes move around: inserting or erasing an element
+ * invalidates all references to values and all iterators. Code which keeps
+ * pointers into the map, or erases while iterating, must stay on HashMap.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+	struct Node {
+		Val _value;
+		const Key _key;
+		explicit Node(const Key &key) : _value(), _key(key) {}
+		Node(Node &&node) : _value(Common::move(node._value)), _key(node._key) {}
+		Node(const Node &node) : _value(node._value), _key(node._key) {}
+	};
+
+private:
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	enum {
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// Robin Hood hashing keeps probe sequences short even when the
+		// table is quite full.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 7,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 8,
+
+		/** Longest probe distance which fits into a slot's distance. */
+		FLATHASHMAP_MAX_DISTANCE = 0xFFFF
+	};
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	Node *_nodes;        ///< Raw storage; only slots with a non-zero distance hold a node.
+	uint16 *_distances;  ///< Distance of each slot's node from its home slot plus one; 0 means empty.
+	uint *_hashes;       ///< Hash of each slot's key.
+	size_type _mask;     ///< Capacity of the map minus one; the capacity is a power of two.
+	size_type _size;
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	bool insertNode(Node &&node, uint hash, size_type *pos);
+	void eraseAt(size_type pos);
+	void expandStorage(size_type newCapacity);
+
+	/** Move the node in slot @p from to the empty slot @p to. */
+	void moveSlot(size_type from, size_type to) {
+		new (&_nodes[to]) Node(Common::move(_nodes[from]));
+		_nodes[from].~Node();
+		_hashes[to] = _hashes[from];
+	}
+
+	template<class T> friend class IteratorImpl;
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(_hashmap->_distances[_idx] != 0);
+			return &_hashmap->_nodes[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			do {
+				_idx++;
+			} while (_idx <= _hashmap->_mask && _hashmap->_distances[_idx] == 0);
+			if (_idx > _hashmap->_mask)
+				_idx = (size_type)-1;
+
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getOrCreateVal(const Key &key);
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getValOrDefault(const Key &key) const;
+	const Val &getValOrDefault(const Key &key, const Val &defaultVal) const;
+	bool tryGetVal(const Key &key, Val &out) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (_distances[ctr])
+				return iterator(ctr, this);
+		}
+		return end();
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (_distances[ctr])
+				return const_iterator(ctr, this);
+		}
+		return end();
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	iterator	find(const Key &key) {
+		return iterator(lookup(key), this);
+	}
+
+	const_iterator	find(const Key &key) const {
+		return const_iterator(lookup(key), this);
+	}
+
+	/** Return true if hashmap is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+}
+
+/**
+ * Copy constructor, creates a full copy of the given hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	freeStorage();
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	_mask = capacity - 1;
+	_size = 0;
+	_nodes = (Node *)malloc(capacity * sizeof(Node));
+	_distances = new uint16[capacity];
+	_hashes = new uint[capacity];
+	assert(_nodes != nullptr);
+	memset(_distances, 0, capacity * sizeof(uint16));
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (_distances[ctr])
+			_nodes[ctr].~Node();
+	}
+
+	free(_nodes);
+	delete[] _distances;
+	delete[] _hashes;
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note The previous storage is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// The layout only depends on the hashes, so copy it slot by slot
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		_distances[ctr] = map._distances[ctr];
+		if (_distances[ctr]) {
+			new (&_nodes[ctr]) Node(map._nodes[ctr]);
+			_hashes[ctr] = map._hashes[ctr];
+		}
+	}
+	_size = map._size;
+}
+
+/**
+ * Clear all values in the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+		return;
+	}
+
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (_distances[ctr]) {
+			_nodes[ctr].~Node();
+			_distances[ctr] = 0;
+		}
+	}
+	_size = 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::expandStorage(size_type newCapacity) {
+	assert(newCapacity > _mask + 1);
+
+	const size_type oldMask = _mask;
+	const size_type oldSize = _size;
+	Node *oldNodes = _nodes;
+	uint16 *oldDistances = _distances;
+	uint *oldHashes = _hashes;
+
+	allocStorage(newCapacity);
+
+	// Rehash all the old elements. Since no key exists twice in the old
+	// table, this can be done without calling _equal().
+	for (size_type ctr = 0; ctr <= oldMask; ++ctr) {
+		if (!oldDistances[ctr])
+			continue;
+
+		const bool inserted = insertNode(Common::move(oldNodes[ctr]), oldHashes[ctr], nullptr);
+		assert(inserted);
+		(void)inserted;
+		oldNodes[ctr].~Node();
+	}
+
+	// Perform a sanity check: Old number of elements should match the new one!
+	assert(_size == oldSize);
+	(void)oldSize;
+
+	free(oldNodes);
+	delete[] oldDistances;
+	delete[] oldHashes;
+}
+
+/**
+ * Insert a node for a key which isn't contained in the map yet.
+ *
+ * The node is placed at the first slot whose node is closer to its home
+ * slot than the new one would be, and the nodes from there up to the next
+ * empty slot are shifted by one.
+ *
+ * @return False if a probe distance would become too large, in which case
+ *         nothing is changed and the storage has to be expanded.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::insertNode(Node &&node, uint hash, size_type *pos) {
+	size_type ctr = hash & _mask;
+	uint distance = 1;
+	while (_distances[ctr] >= distance) {
+		ctr = (ctr + 1) & _mask;
+		distance++;
+	}
+
+	// Find the end of the run of nodes which have to be shifted
+	if (distance > FLATHASHMAP_MAX_DISTANCE)
+		return false;
+	size_type last = ctr;
+	while (_distances[last]) {
+		if (_distances[last] == FLATHASHMAP_MAX_DISTANCE)
+			return false;
+		last = (last + 1) & _mask;
+	}
+
+	for (size_type ctr2 = last; ctr2 != ctr; ) {
+		const size_type prev = (ctr2 - 1) & _mask;
+		moveSlot(prev, ctr2);
+		_distances[ctr2] = _distances[prev] + 1;
+		ctr2 = prev;
+	}
+
+	new (&_nodes[ctr]) Node(Common::move(node));
+	_hashes[ctr] = hash;
+	_distances[ctr] = (uint16)distance;
+	_size++;
+
+	if (pos)
+		*pos = ctr;
+	return true;
+}
+
+/**
+ * Remove the node in the given slot, shifting back the nodes which follow
+ * it in their probe sequence.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseAt(size_type pos) {
+	assert(pos <= _mask && _distances[pos] != 0);
+
+	_nodes[pos].~Node();
+	size_type next = (pos + 1) & _mask;
+	while (_distances[next] > 1) {
+		moveSlot(next, pos);
+		_distances[pos] = _distances[next] - 1;
+		pos = next;
+		next = (next + 1) & _mask;
+	}
+	_distances[pos] = 0;
+	_size--;
+}
+
+/**
+ * Return the slot holding @p key, or (size_type)-1 (the end() index) if
+ * there is none.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	const uint hash = _hash(key);
+	size_type ctr = hash & _mask;
+
+	// Nodes are ordered by their home slot, so the search can stop as soon
+	// as it finds a node closer to its home than the key would be
+	for (uint distance = 1; _distances[ctr] >= distance; distance++) {
+		if (_hashes[ctr] == hash && _equal(_nodes[ctr]._key, key))
+			return ctr;
+		ctr = (ctr + 1) & _mask;
+	}
+
+	return (size_type)-1;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return ctr;
+
+	// Keep the load factor below a certain threshold.
+	if ((_size + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > (_mask + 1) * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+		expandStorage((_mask + 1) * 2);
+
+	const uint hash = _hash(key);
+	while (!insertNode(Node(key), hash, &ctr))
+		expandStorage((_mask + 1) * 2);
+
+	return ctr;
+}
+
+/**
+ * Check whether the hashmap contains the given key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key) != (size_type)-1;
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getOrCreateVal(key);
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+/**
+ * Get a value from the hashmap, creating it if it doesn't exist yet.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getOrCreateVal(const Key &key) {
+	// Look up first, inserting may reallocate _nodes.
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	return _nodes[ctr]._value;
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _nodes[ctr]._value;
+	else
+		// See the comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _nodes[ctr]._value;
+	else
+		// See the comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key) const {
+	return getValOrDefault(key, _defaultVal);
+}
+
+/**
+ * Get a value from the hashmap. If the key is not present, then return @p defaultVal.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _nodes[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::tryGetVal(const Key &key, Val &out) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1) {
+		out = _nodes[ctr]._value;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * Assign an element specified by @p key to a value @p val.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	_nodes[ctr]._value = val;
+}
+
+/**
+ * Erase an element referred to by an iterator.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	eraseAt(entry._idx);
+}
+
+/**
+ * Erase an element specified by a key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		eraseAt(ctr);
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -50,6 +50,9 @@ QuickTimeParser::QuickTimeParser() {
 	_resFork = new MacResManager();
 	_disposeFileHandle = DisposeAfterUse::YES;
 	_timeScale = 1;
+	_lazySampleTables = false;
+	_headerOnly = false;
+	_deferSampleTables = false;
 
 	initParseTable();
 }
@@ -75,6 +78,8 @@ bool QuickTimeParser::parseFile(const Path &filename) {
 		if (!idArray.empty())
 			_fd = _resFork->getResource(MKTAG('m', 'o', 'o', 'v'), idArray[0]);
 
+		_deferSampleTables = false;
+
 		if (_fd) {
 			atom.size = _fd->size();
 			if (readDefault(atom) < 0 || !_foundMOOV)
@@ -88,6 +93,7 @@ bool QuickTimeParser::parseFile(const Path &filename) {
 	if (!_fd)
 		return false;
 	atom.size = _fd->size();
+	_deferSampleTables = _lazySampleTables;
 
 	if (readDefault(atom) < 0 || !_foundMOOV)
 		return false;
@@ -100,6 +106,7 @@ bool QuickTimeParser::parseStream(SeekableReadStream *stream, DisposeAfterUse::F
 	_fd = stream;
 	_foundMOOV = false;
 	_disposeFileHandle = disposeFileHandle;
+	_deferSampleTables = _lazySampleTables;
 
 	Atom atom = { 0, 0, 0xffffffff };
 
@@ -152,11 +159,11 @@ void QuickTimeParser::initParseTable() {
 		{ &QuickTimeParser::readMVHD,    MKTAG('m', 'v', 'h', 'd') },
 		{ &QuickTimeParser::readLeaf,    MKTAG('s', 'm', 'h', 'd') },
 		{ &QuickTimeParser::readDefault, MKTAG('s', 't', 'b', 'l') },
-		{ &QuickTimeParser::readSTCO,    MKTAG('s', 't', 'c', 'o') },
-		{ &QuickTimeParser::readSTSC,    MKTAG('s', 't', 's', 'c') },
+		{ &QuickTimeParser::readSampleTable, MKTAG('s', 't', 'c', 'o') },
+		{ &QuickTimeParser::readSampleTable, MKTAG('s', 't', 's', 'c') },
 		{ &QuickTimeParser::readSTSD,    MKTAG('s', 't', 's', 'd') },
-		{ &QuickTimeParser::readSTSS,    MKTAG('s', 't', 's', 's') },
-		{ &QuickTimeParser::readSTSZ,    MKTAG('s', 't', 's', 'z') },
+		{ &QuickTimeParser::readSampleTable, MKTAG('s', 't', 's', 's') },
+		{ &QuickTimeParser::readSampleTable, MKTAG('s', 't', 's', 'z') },
 		{ &QuickTimeParser::readSTTS,    MKTAG('s', 't', 't', 's') },
 		{ &QuickTimeParser::readTKHD,    MKTAG('t', 'k', 'h', 'd') },
 		{ &QuickTimeParser::readTRAK,    MKTAG('t', 'r', 'a', 'k') },
@@ -306,6 +313,10 @@ int QuickTimeParser::readCMOV(Atom atom) {
 	SeekableReadStream *oldStream = _fd;
 	_fd = new MemoryReadStream(uncompressedData, uncompressedSize, DisposeAfterUse::YES);
 
+	// The uncompressed data doesn't outlive parsing, so don't defer anything
+	bool deferSampleTables = _deferSampleTables;
+	_deferSampleTables = false;
+
 	// Read the contents of the uncompressed data
 	Atom a = { MKTAG('m', 'o', 'o', 'v'), 0, uncompressedSize };
 	int err = readDefault(a);
@@ -314,6 +325,7 @@ int QuickTimeParser::readCMOV(Atom atom) {
 	free(compressedData);
 	delete _fd;
 	_fd = oldStream;
+	_deferSampleTables = deferSampleTables;
 
 	return err;
 }
@@ -562,15 +574,69 @@ int QuickTimeParser::readSTSD(Atom atom) {
 	return 0;
 }
 
-int QuickTimeParser::readSTSC(Atom atom) {
+int QuickTimeParser::readSampleTable(Atom atom) {
+	if (_headerOnly)
+		return 0;
+
 	Track *track = _tracks.back();
 
+	if (_deferSampleTables) {
+		// Remember where the atom header starts and read it in loadSampleTables()
+		track->lazySampleTables.push_back(_fd->pos() - 8);
+		return 0;
+	}
+
+	return readSampleTable(track, atom.type);
+}
+
+int QuickTimeParser::readSampleTable(Track *track, uint32 type) {
+	switch (type) {
+	case MKTAG('s', 't', 'c', 'o'):
+		return readSTCO(track);
+	case MKTAG('s', 't', 's', 'c'):
+		return readSTSC(track);
+	case MKTAG('s', 't', 's', 's'):
+		return readSTSS(track);
+	case MKTAG('s', 't', 's', 'z'):
+		return readSTSZ(track);
+	default:
+		warning("Unknown QuickTime sample table '%s'", tag2str(type));
+		return -1;
+	}
+}
+
+bool QuickTimeParser::loadSampleTables(Track *track) {
+	if (_headerOnly)
+		return false;
+
+	if (track->lazySampleTables.empty())
+		return true;
+
+	int64 pos = _fd->pos();
+	int err = 0;
+
+	for (uint32 i = 0; i < track->lazySampleTables.size() && !err; i++) {
+		_fd->seek(track->lazySampleTables[i]);
+		_fd->readUint32BE(); // size
+		err = readSampleTable(track, _fd->readUint32BE());
+
+		if (!err && (_fd->eos() || _fd->err()))
+			err = -1;
+	}
+
+	track->lazySampleTables.clear();
+	_fd->seek(pos);
+
+	return err == 0;
+}
+
+int QuickTimeParser::readSTSC(Track *track) {
 	_fd->readByte(); // version
 	_fd->readByte(); _fd->readByte(); _fd->readByte(); // flags
 
 	track->sampleToChunkCount = _fd->readUint32BE();
 
-	debug(0, "track[%i].stsc.entries = %i", _tracks.size() - 1, track->sampleToChunkCount);
+	debug(0, "stsc.entries = %i", track->sampleToChunkCount);
 
 	track->sampleToChunk = new SampleToChunkEntry[track->sampleToChunkCount];
 
@@ -587,9 +653,7 @@ int QuickTimeParser::readSTSC(Atom atom) {
 	return 0;
 }
 
-int QuickTimeParser::readSTSS(Atom atom) {
-	Track *track = _tracks.back();
-
+int QuickTimeParser::readSTSS(Track *track) {
 	_fd->readByte(); // version
 	_fd->readByte(); _fd->readByte(); _fd->readByte(); // flags
 
@@ -610,9 +674,7 @@ int QuickTimeParser::readSTSS(Atom atom) {
 	return 0;
 }
 
-int QuickTimeParser::readSTSZ(Atom atom) {
-	Track *track = _tracks.back();
-
+int QuickTimeParser::readSTSZ(Track *track) {
 	_fd->readByte(); // version
 	_fd->readByte(); _fd->readByte(); _fd->readByte(); // flags
 
@@ -662,9 +724,7 @@ int QuickTimeParser::readSTTS(Atom atom) {
 	return 0;
 }
 
-int QuickTimeParser::readSTCO(Atom atom) {
-	Track *track = _tracks.back();
-
+int QuickTimeParser::readSTCO(Track *track) {
 	_fd->readByte(); // version
 	_fd->readByte(); _fd->readByte(); _fd->readByte(); // flags
 
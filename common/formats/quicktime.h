@@ -90,6 +90,22 @@ public:
 	 */
 	void setChunkBeginOffset(uint32 offset) { _beginOffset = offset; }
 
+	/**
+	 * Defer reading the stco, stsc, stss and stsz sample tables of a track
+	 * until loadSampleTables() is called for it. Must be set before parsing.
+	 * Tables inside compressed or resource fork 'moov' atoms are still read
+	 * right away, since their stream is gone once parsing is done.
+	 */
+	void setLazySampleTables(bool lazy) { _lazySampleTables = lazy; }
+
+	/**
+	 * Only parse the movie and track headers and skip the sample tables
+	 * altogether. Meant for metadata queries such as the duration, the
+	 * dimensions or the alias path; no samples can be read afterwards.
+	 * Must be set before parsing.
+	 */
+	void setHeaderOnly(bool headerOnly) { _headerOnly = headerOnly; }
+
 	/**
 	 * Returns the movie time scale
 	 */
@@ -181,6 +197,8 @@ protected:
 		Common::String directory;
 		int16 nlvlFrom;
 		int16 nlvlTo;
+
+		Array<uint32> lazySampleTables; // offsets of the sample table atoms not read yet
 	};
 
 	virtual SampleDesc *readSampleDesc(Track *track, uint32 format, uint32 descSize) = 0;
@@ -190,9 +208,18 @@ protected:
 	Rational _scaleFactorX;
 	Rational _scaleFactorY;
 	Array<Track *> _tracks;
+	bool _lazySampleTables;
+	bool _headerOnly;
 
 	void init();
 
+	/**
+	 * Read the sample tables of a track which were deferred during parsing.
+	 * Returns false if they could not be read or were skipped because of
+	 * setHeaderOnly().
+	 */
+	bool loadSampleTables(Track *track);
+
 private:
 	struct Atom {
 		uint32 type;
@@ -210,6 +237,7 @@ private:
 	uint32 _beginOffset;
 	MacResManager *_resFork;
 	bool _foundMOOV;
+	bool _deferSampleTables;
 
 	void initParseTable();
 
@@ -223,11 +251,13 @@ private:
 	int readMVHD(Atom atom);
 	int readTKHD(Atom atom);
 	int readTRAK(Atom atom);
-	int readSTCO(Atom atom);
-	int readSTSC(Atom atom);
+	int readSampleTable(Atom atom);
+	int readSampleTable(Track *track, uint32 type);
+	int readSTCO(Track *track);
+	int readSTSC(Track *track);
 	int readSTSD(Atom atom);
-	int readSTSS(Atom atom);
-	int readSTSZ(Atom atom);
+	int readSTSS(Track *track);
+	int readSTSZ(Track *track);
 	int readSTTS(Atom atom);
 	int readCMOV(Atom atom);
 	int readWAVE(Atom atom);
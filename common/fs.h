@@ -148,6 +148,16 @@ public:
 	 */
 	bool getChildren(FSList &fslist, ListMode mode = kListDirectoriesOnly, bool hidden = true) const;
 
+	/**
+	 * Drop the listing of this directory node if the backend caches it, so
+	 * that the next call to getChildren() reads the directory again.
+	 *
+	 * Backends notice changes of the directory on their own, but may miss
+	 * them on file systems with unreliable modification times, like network
+	 * shares whose clock is off.
+	 */
+	void invalidateListing() const;
+
 	/**
 	 * Return a human-readable string for this node, usable for display (e.g.
 	 * in the GUI code). Do *not* rely on it being usable for anything else,
@@ -252,6 +262,17 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Retrieve the size and the last modification time of the file referred
+	 * by this node, without opening it.
+	 *
+	 * The modification time is only meant to be compared with other values
+	 * returned by this method, its unit and epoch depend on the backend.
+	 *
+	 * @return True if the backend could provide them, false otherwise.
+	 */
+	bool getFileStats(int64 &size, int64 &modificationTime) const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -271,6 +292,22 @@ public:
 	 */
 	SeekableReadStream *createReadStreamForAltStream(AltStreamType altStreamType) const override;
 
+	/**
+	 * Create a SeekableReadStream instance corresponding to the file
+	 * referred by this node, reading it from a read-only memory mapping
+	 * where the backend supports it. This avoids copying large data files
+	 * into heap buffers: the returned stream is a MemoryReadStream sharing
+	 * the mapped file, so createSliceReadStream() can hand out members of
+	 * an archive without copying them.
+	 *
+	 * If the file cannot be mapped, for example because the backend has no
+	 * memory mapped files or the file is too large for the address space,
+	 * this falls back to createReadStream().
+	 *
+	 * @return Pointer to the stream object, nullptr in case of a failure.
+	 */
+	SeekableReadStream *createMappedReadStream() const;
+
 	/**
 	 * Create a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -25,7 +25,6 @@
 #define COMMON_HUFFMAN_H
 
 #include "common/array.h"
-#include "common/list.h"
 #include "common/types.h"
 
 namespace Common {
@@ -54,6 +53,10 @@ inline uint32 REVERSEBITS(uint32 x) {
 /**
  * Huffman bit stream decoding.
  *
+ * The codes are decoded with lookup tables. The first table is indexed by
+ * up to the first 9 bits of a code. Longer codes continue in a subtable of
+ * up to 14 bits, so that codes of up to 23 bits are decoded with at most
+ * two lookups.
  */
 template<class BITSTREAM>
 class Huffman {
@@ -72,29 +75,40 @@ public:
 	uint32 getSymbol(BITSTREAM &bits) const;
 
 private:
-	struct Symbol {
-		uint32 code;
-		uint32 symbol;
-
-		Symbol(uint32 c, uint32 s) : code(c), symbol(s) {}
+	enum {
+		kTableBits = 9,        ///< Maximal number of bits of the first lookup table
+		kSubTableBits = 14,    ///< Maximal number of bits of the subtables
+		kLengthLink = 0,       ///< Length of an entry linking to a subtable
+		kLengthInvalid = 0xFF  ///< Length of an entry no code starts with
 	};
 
-	typedef List<Symbol> CodeList;
-	typedef Array<CodeList> CodeLists;
+	/** An entry of the lookup tables. */
+	struct TableEntry {
+		uint32 symbol;  ///< The symbol, or the offset of the subtable for links.
+		uint8  length;  ///< The number of bits of the code left in this table.
+		uint8  subBits; ///< The number of bits of the subtable for links.
+
+		TableEntry() : symbol(0), length(kLengthInvalid), subBits(0) {}
+	};
 
-	/** Lists of codes and their symbols, sorted by code length. */
-	CodeLists _codes;
+	/**
+	 * Fill the table at @p offset for the codes with the given indices, which
+	 * all start with the same @p prefixBits bits, and create its subtables.
+	 */
+	void buildTable(uint32 offset, uint8 tableBits, uint8 prefixBits, const Array<uint32> &indices,
+	                const uint32 *codes, const uint8 *lengths, const uint32 *symbols);
 
-	/** Prefix lookup table used to speed up the decoding of short codes. */
-	struct PrefixEntry {
-		uint32 symbol;
-		uint8  length;
+	/**
+	 * Return the @p n bits of a code following its first @p prefixBits bits,
+	 * in the order they are peeked from the bit stream.
+	 */
+	static uint32 getCodeBits(uint32 code, uint8 length, uint8 prefixBits, uint8 n);
 
-		PrefixEntry() : length(0xFF) {}
-	};
+	/** All lookup tables, starting with the first one. */
+	Array<TableEntry> _table;
 
-	static const uint8 _prefixTableBits = 8;
-	PrefixEntry _prefixTable[1 << _prefixTableBits];
+	/** The number of bits of the first lookup table. */
+	uint8 _tableBits;
 };
 
 template <class BITSTREAM>
@@ -110,62 +124,105 @@ Huffman<BITSTREAM>::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *cod
 
 	assert(maxLength <= 32);
 
-	// Codes that do not fit in the prefix table are stored in the _codes array.
-	_codes.resize(MAX(maxLength - _prefixTableBits, 0));
+	// Codes with a length of 0 are unused
+	Array<uint32> indices;
+	indices.reserve(codeCount);
+	for (uint32 i = 0; i < codeCount; i++)
+		if (lengths[i] > 0)
+			indices.push_back(i);
 
-	for (uint i = 0; i < codeCount; i++) {
-		uint8 length = lengths[i];
+	_tableBits = MIN<uint8>(maxLength, kTableBits);
+	_table.resize(1 << _tableBits);
 
-		// The symbol. If none was specified, assume it is identical to the code index.
-		uint32 symbol = symbols ? symbols[i] : i;
-
-		if (length <= _prefixTableBits) {
-			// Short codes go in the prefix lookup table. Set all the entries in the table
-			// with an index starting with the code to the symbol value.
-			uint32 startIndex;
-			if (BITSTREAM::isMSB2LSB()) {
-				startIndex = codes[i] << (_prefixTableBits - length);
-			} else {
-				startIndex = REVERSEBITS(codes[i]) >> (32 - _prefixTableBits);
-			}
+	buildTable(0, _tableBits, 0, indices, codes, lengths, symbols);
+}
 
-			uint32 endIndex = startIndex | ((1 << (_prefixTableBits - length)) - 1);
+template <class BITSTREAM>
+void Huffman<BITSTREAM>::buildTable(uint32 offset, uint8 tableBits, uint8 prefixBits, const Array<uint32> &indices,
+                                    const uint32 *codes, const uint8 *lengths, const uint32 *symbols) {
+	// Codes ending in this table. Set all the entries with an index starting
+	// with the rest of the code to the symbol value. If none was specified,
+	// assume it is identical to the code index.
+	for (uint32 i = 0; i < indices.size(); i++) {
+		const uint32 c = indices[i];
+		const uint8 length = lengths[c] - prefixBits;
+		if (length > tableBits)
+			continue;
+
+		const uint32 bits = getCodeBits(codes[c], lengths[c], prefixBits, length);
+		const uint8 freeBits = tableBits - length;
+
+		for (uint32 j = 0; j < (1u << freeBits); j++) {
+			uint32 index = BITSTREAM::isMSB2LSB() ? ((bits << freeBits) | j) : (bits | (j << length));
+			TableEntry &entry = _table[offset + index];
+			entry.symbol = symbols ? symbols[c] : c;
+			entry.length = length;
+		}
+	}
 
-			for (uint32 j = startIndex; j <= endIndex; j++) {
-				uint32 index = BITSTREAM::isMSB2LSB() ? j : REVERSEBITS(j) >> (32 - _prefixTableBits);
-				_prefixTable[index].symbol = symbol;
-				_prefixTable[index].length = length;
+	// Longer codes continue in a subtable, shared by all the codes starting
+	// with the same bits. It is large enough for the longest of them, up to
+	// kSubTableBits.
+	for (uint32 i = 0; i < indices.size(); i++) {
+		const uint32 c = indices[i];
+		if (lengths[c] - prefixBits <= tableBits)
+			continue;
+
+		const uint32 index = getCodeBits(codes[c], lengths[c], prefixBits, tableBits);
+		if (_table[offset + index].length == kLengthLink)
+			continue;
+
+		Array<uint32> subIndices;
+		uint8 maxLength = 0;
+		for (uint32 j = i; j < indices.size(); j++) {
+			const uint32 d = indices[j];
+			if (lengths[d] - prefixBits > tableBits && getCodeBits(codes[d], lengths[d], prefixBits, tableBits) == index) {
+				subIndices.push_back(d);
+				maxLength = MAX(maxLength, lengths[d]);
 			}
-		} else {
-			// Put the code and symbol into the correct list for the length.
-			_codes[lengths[i] - 1 - _prefixTableBits].push_back(Symbol(codes[i], symbol));
 		}
+
+		const uint8 subBits = MIN<uint8>(maxLength - prefixBits - tableBits, kSubTableBits);
+		const uint32 subOffset = _table.size();
+		_table.resize(subOffset + (1 << subBits));
+
+		TableEntry &link = _table[offset + index];
+		link.symbol = subOffset;
+		link.length = kLengthLink;
+		link.subBits = subBits;
+
+		buildTable(subOffset, subBits, prefixBits + tableBits, subIndices, codes, lengths, symbols);
 	}
 }
 
 template <class BITSTREAM>
-uint32 Huffman<BITSTREAM>::getSymbol(BITSTREAM &bits) const {
-	uint32 code = bits.peekBits(_prefixTableBits);
-
-	uint8 length = _prefixTable[code].length;
+uint32 Huffman<BITSTREAM>::getCodeBits(uint32 code, uint8 length, uint8 prefixBits, uint8 n) {
+	// The codes of MSB2LSB streams start with their most significant bit,
+	// the ones of LSB2MSB streams with their least significant bit
+	const uint32 mask = (1u << n) - 1;
+	if (BITSTREAM::isMSB2LSB())
+		return (code >> (length - prefixBits - n)) & mask;
+	else
+		return (code >> prefixBits) & mask;
+}
 
-	if (length != 0xFF) {
-		bits.skip(length);
-		return _prefixTable[code].symbol;
-	} else {
-		bits.skip(_prefixTableBits);
+template <class BITSTREAM>
+uint32 Huffman<BITSTREAM>::getSymbol(BITSTREAM &bits) const {
+	uint8 tableBits = _tableBits;
+	const TableEntry *entry = &_table[bits.peekBits(tableBits)];
 
-		for (uint32 i = 0; i < _codes.size(); i++) {
-			bits.addBit(code, i + _prefixTableBits);
+	while (entry->length == kLengthLink) {
+		bits.skip(tableBits);
 
-			for (typename CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
-				if (code == cCode->code)
-					return cCode->symbol;
-		}
+		tableBits = entry->subBits;
+		entry = &_table[entry->symbol + bits.peekBits(tableBits)];
 	}
 
-	error("Unknown Huffman code");
-	return 0;
+	if (entry->length == kLengthInvalid)
+		error("Unknown Huffman code");
+
+	bits.skip(entry->length);
+	return entry->symbol;
 }
 
 /** @} */
@@ -0,0 +1,127 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/intern-str.h"
+#include "common/mutex.h"
+#include "common/system.h"
+
+#include <atomic>
+
+namespace Common {
+
+namespace {
+
+/**
+ * Lock for the atom table, which SearchSet lookups reach from the worker
+ * threads. The mutex needs g_system, so it is created the first time the
+ * table is used once the backend is up. Strings interned before that come
+ * from static initializers, which run before any other thread exists.
+ */
+class TableLock {
+public:
+	TableLock() : _mutex(getMutex()) {
+		if (_mutex)
+			_mutex->lock();
+	}
+
+	~TableLock() {
+		if (_mutex)
+			_mutex->unlock();
+	}
+
+private:
+	static Mutex *getMutex() {
+		static std::atomic<Mutex *> mutex(nullptr);
+
+		Mutex *m = mutex.load(std::memory_order_acquire);
+		if (!m && g_system) {
+			Mutex *created = new Mutex();
+			if (mutex.compare_exchange_strong(m, created, std::memory_order_acq_rel))
+				m = created;
+			else
+				delete created;
+		}
+		return m;
+	}
+
+	Mutex *_mutex;
+};
+
+} // End of anonymous namespace
+
+InternedString::Table &InternedString::table() {
+	// Constructed on first use, so strings can be interned from static
+	// initializers too.
+	static Table atoms;
+	return atoms;
+}
+
+const String &InternedString::emptyString() {
+	static const String empty;
+	return empty;
+}
+
+uint InternedString::emptyHash() {
+	static const uint hash = emptyString().hash();
+	return hash;
+}
+
+InternedString::InternedString(const String &str) : _node(nullptr) {
+	if (str.empty())
+		return;
+
+	TableLock lock;
+	Table &atoms = table();
+	Table::iterator i = atoms.find(str);
+	if (i == atoms.end()) {
+		atoms[str] = str.hash();
+		i = atoms.find(str);
+	}
+
+	// HashMap nodes never move, so the node address identifies the string.
+	_node = &*i;
+}
+
+InternedString::InternedString(const char *str) : InternedString(String(str)) {
+}
+
+bool InternedString::tryGet(const String &str, InternedString &out) {
+	if (str.empty()) {
+		out = InternedString();
+		return true;
+	}
+
+	TableLock lock;
+	Table &atoms = table();
+	Table::const_iterator i = atoms.find(str);
+	if (i == atoms.end())
+		return false;
+
+	out = InternedString(&*i);
+	return true;
+}
+
+uint InternedString::tableSize() {
+	TableLock lock;
+	return table().size();
+}
+
+} // End of namespace Common
@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_INTERN_STR_H
+#define COMMON_INTERN_STR_H
+
+#include "common/hash-str.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_intern_str Interned strings
+ * @ingroup common
+ *
+ * @brief API for interned strings.
+ *
+ * @{
+ */
+
+/**
+ * A handle to a string stored once in a global atom table.
+ *
+ * Interning the same contents twice yields handles pointing to the same
+ * table entry, so comparing two interned strings is a pointer comparison
+ * and their hash is computed only once, when the string gets interned.
+ *
+ * This is meant for names which are created rarely but compared often,
+ * like archive names or symbol names. Entries are never removed from the
+ * table, so do not intern arbitrary or unbounded data.
+ *
+ * The atom table is guarded by a lock, so strings may be interned and
+ * looked up from any thread. The handles themselves are immutable.
+ */
+class InternedString {
+public:
+	/** Construct the empty interned string. */
+	InternedString() : _node(nullptr) {}
+
+	/** Intern @p str, adding it to the atom table if needed. */
+	explicit InternedString(const String &str);
+	explicit InternedString(const char *str);
+
+	/**
+	 * Look up @p str in the atom table without adding it.
+	 *
+	 * @return True if @p str was interned before, in which case its handle
+	 *         is stored in @p out.
+	 */
+	static bool tryGet(const String &str, InternedString &out);
+
+	/** Number of strings in the atom table. */
+	static uint tableSize();
+
+	const String &toString() const { return _node ? _node->_key : emptyString(); }
+	const char *c_str() const { return toString().c_str(); }
+	uint size() const { return toString().size(); }
+	bool empty() const { return _node == nullptr; }
+
+	/** Case sensitive hash of the string, computed when it was interned. */
+	uint hash() const { return _node ? _node->_value : emptyHash(); }
+
+	bool operator==(const InternedString &x) const { return _node == x._node; }
+	bool operator!=(const InternedString &x) const { return _node != x._node; }
+
+	bool operator==(const String &x) const { return toString().equals(x); }
+	bool operator!=(const String &x) const { return !toString().equals(x); }
+
+private:
+	/** The atom table maps each string to its hash. */
+	typedef HashMap<String, uint> Table;
+
+	const Table::Node *_node;
+
+	explicit InternedString(const Table::Node *node) : _node(node) {}
+
+	static Table &table();
+	static const String &emptyString();
+	static uint emptyHash();
+};
+
+// Specalization of the Hash functor for InternedString objects.
+template<>
+struct Hash<InternedString> {
+	uint operator()(const InternedString &s) const {
+		return s.hash();
+	}
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,134 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_JOBSYSTEM_H
+#define COMMON_JOBSYSTEM_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_jobsystem Job system
+ * @ingroup common
+ *
+ * @brief API for running work on the backend's worker threads.
+ *
+ * @{
+ */
+
+class JobSystem;
+
+/**
+ * A set of jobs submitted to a JobSystem that can be waited on as a whole.
+ *
+ * A group must outlive all the jobs submitted to it, so it is usually
+ * placed on the stack of the function that calls JobSystem::wait().
+ */
+class JobGroup : NonCopyable {
+	friend class JobSystem;
+
+	uint32 _pending;
+
+public:
+	JobGroup() : _pending(0) {}
+};
+
+/**
+ * Pool of worker threads shared by all the code that wants to split work
+ * across several cores: scalers, decoders, renderers and so on.
+ *
+ * This base class is the single-threaded fallback used by ports without
+ * thread support: every job is run immediately on the calling thread.
+ * Backends with threads provide a subclass and set OSystem::_jobSystem.
+ *
+ * Jobs may run on any thread, so they must not call into OSystem or touch
+ * state shared with other jobs without their own locking. The calling
+ * thread always takes part in the work while it waits, so waiting from
+ * inside a job is safe.
+ */
+class JobSystem : NonCopyable {
+public:
+	typedef void (*JobProc)(void *refCon); /*!< Callback running a single job. */
+	typedef void (*RangeProc)(uint32 begin, uint32 end, void *refCon); /*!< Callback running the items [begin, end) of a parallelFor(). */
+
+	virtual ~JobSystem() {}
+
+	/**
+	 * Return the number of worker threads, not counting the calling thread.
+	 *
+	 * A value of 0 means that jobs are run inline on the calling thread.
+	 */
+	virtual uint getWorkerCount() const { return 0; }
+
+	/**
+	 * Queue a job and return immediately.
+	 *
+	 * @param group   Group the job is accounted to.
+	 * @param proc    Callback running the job.
+	 * @param refCon  Arbitrary void pointer passed to the callback.
+	 */
+	virtual void submit(JobGroup &group, JobProc proc, void *refCon);
+
+	/**
+	 * Block until every job submitted to @p group has finished.
+	 * The calling thread runs queued jobs while it waits.
+	 */
+	virtual void wait(JobGroup &group);
+
+	/**
+	 * Block until every job submitted to @p group has finished, without
+	 * running any queued job on the calling thread.
+	 *
+	 * Meant for threads with tight deadlines, like the audio mixer thread,
+	 * which must not get caught up in unrelated jobs. Must not be called
+	 * from inside a job.
+	 */
+	virtual void waitWithoutHelping(JobGroup &group);
+
+	/**
+	 * Check whether every job submitted to @p group has finished,
+	 * without blocking.
+	 */
+	virtual bool isDone(JobGroup &group);
+
+	/**
+	 * Split the items [0, count) into contiguous slices, run them on the
+	 * workers and the calling thread, and return when all have finished.
+	 *
+	 * @param count   Number of items.
+	 * @param proc    Callback running one slice.
+	 * @param refCon  Arbitrary void pointer passed to the callback.
+	 * @param grain   Minimum number of items per slice.
+	 */
+	virtual void parallelFor(uint32 count, RangeProc proc, void *refCon, uint32 grain = 1);
+
+protected:
+	/** Access to the pending job counter of a group for implementations. */
+	static uint32 &pendingJobs(JobGroup &group) { return group._pending; }
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
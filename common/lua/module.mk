@@ -33,6 +33,7 @@ MODULE_OBJS := \
 	lua_unpersist.o \
 	lvm.o \
 	lzio.o \
+	scummvm_alloc.o \
 	scummvm_file.o
 endif
 
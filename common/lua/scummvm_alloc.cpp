@@ -0,0 +1,151 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/debug.h"
+#include "common/memorypool.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "common/lua/lua.h"
+#include "common/lua/scummvm_alloc.h"
+
+namespace Lua {
+
+// Lua 5.1 always passes the old size of a block, so the pool it came from is
+// known without a header in front of each block
+const size_t LuaAllocator::kPoolSizes[kNumPools] = { 16, 32, 48, 64, 96, 128, 192, 256 };
+
+// The amount of work, in kilobytes, requested from each collection step
+static const int kGCStepSize = 4;
+
+static int panic(lua_State *L) {
+	warning("PANIC: unprotected error in call to Lua API (%s)", lua_tostring(L, -1));
+	return 0;
+}
+
+LuaAllocator::LuaAllocator() {
+	for (uint i = 0; i < kNumPools; i++)
+		_pools[i] = new Common::MemoryPool(kPoolSizes[i]);
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+LuaAllocator::~LuaAllocator() {
+	for (uint i = 0; i < kNumPools; i++)
+		delete _pools[i];
+}
+
+lua_State *LuaAllocator::newState() {
+	lua_State *L = lua_newstate(alloc, this);
+	if (L)
+		lua_atpanic(L, &panic);
+	return L;
+}
+
+int LuaAllocator::getPoolIndex(size_t size) {
+	if (size == 0 || size > kMaxPooledSize)
+		return -1;
+	for (uint i = 0; i < kNumPools; i++) {
+		if (size <= kPoolSizes[i])
+			return i;
+	}
+	return -1;
+}
+
+void *LuaAllocator::alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
+	return static_cast<LuaAllocator *>(ud)->reallocate(ptr, osize, nsize);
+}
+
+void LuaAllocator::release(void *ptr, size_t size) {
+	const int pool = getPoolIndex(size);
+	if (pool >= 0)
+		_pools[pool]->freeChunk(ptr);
+	else
+		free(ptr);
+}
+
+void *LuaAllocator::reallocate(void *ptr, size_t osize, size_t nsize) {
+	if (!ptr)
+		osize = 0;
+
+	if (nsize == 0) {
+		if (ptr) {
+			release(ptr, osize);
+			_stats.bytesInUse -= osize;
+		}
+		return nullptr;
+	}
+
+	const int oldPool = ptr ? getPoolIndex(osize) : -1;
+	const int newPool = getPoolIndex(nsize);
+	void *block;
+
+	if (ptr && oldPool >= 0 && oldPool == newPool) {
+		// Still fits in the same size class
+		block = ptr;
+	} else if (oldPool < 0 && newPool < 0) {
+		block = realloc(ptr, nsize);
+		if (!block)
+			return nullptr;
+	} else {
+		// Moving between pools, or between a pool and the heap
+		block = newPool >= 0 ? _pools[newPool]->allocChunk() : malloc(nsize);
+		if (!block)
+			return nullptr;
+		if (ptr) {
+			memcpy(block, ptr, MIN(osize, nsize));
+			release(ptr, osize);
+		}
+	}
+
+	_stats.allocations++;
+	if (newPool >= 0)
+		_stats.pooledAllocations++;
+	_stats.bytesInUse += nsize - osize;
+	_stats.peakBytesInUse = MAX(_stats.peakBytesInUse, _stats.bytesInUse);
+	return block;
+}
+
+bool LuaAllocator::stepGarbageCollector(lua_State *L, uint32 budgetMicros) {
+	const uint64 start = g_system->getMicros();
+	uint64 elapsed;
+	bool finished = false;
+
+	do {
+		if (lua_gc(L, LUA_GCSTEP, kGCStepSize)) {
+			_stats.gcCycles++;
+			finished = true;
+		}
+		elapsed = g_system->getMicros() - start;
+	} while (!finished && elapsed < budgetMicros);
+
+	_stats.gcMicros += elapsed;
+	return finished;
+}
+
+void LuaAllocator::printReport(lua_State *L, const char *name) const {
+	const uint32 pooledPercent = _stats.allocations ? (uint32)((uint64)_stats.pooledAllocations * 100 / _stats.allocations) : 0;
+
+	debug(1, "Lua state %s: %d KB in use, %u KB peak, %u allocations (%u%% pooled), %u collection cycles in %u ms",
+		name, L ? lua_gc(L, LUA_GCCOUNT, 0) : 0, (uint32)(_stats.peakBytesInUse / 1024),
+		_stats.allocations, pooledPercent, _stats.gcCycles, (uint32)(_stats.gcMicros / 1000));
+}
+
+} // End of namespace Lua
@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LUA_SCUMMVM_ALLOC_H
+#define LUA_SCUMMVM_ALLOC_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+struct lua_State;
+
+namespace Common {
+class MemoryPool;
+}
+
+namespace Lua {
+
+/**
+ * Memory allocator for a Lua state. Most Lua objects (strings, tables, closures,
+ * upvalues) are small and short-lived, so blocks of up to kMaxPooledSize bytes
+ * are taken from size class pools instead of the heap. Larger blocks still go to
+ * malloc.
+ *
+ * The allocator also keeps statistics on the memory used by the state and on the
+ * time spent in stepGarbageCollector(). Each state needs its own allocator, which
+ * must outlive it.
+ */
+class LuaAllocator : Common::NonCopyable {
+public:
+	struct Stats {
+		size_t bytesInUse;        ///< Memory currently allocated by the state
+		size_t peakBytesInUse;    ///< Highest value of bytesInUse
+		uint32 allocations;       ///< Number of blocks allocated or resized
+		uint32 pooledAllocations; ///< Number of those served by the pools
+		uint32 gcCycles;          ///< Collection cycles finished in stepGarbageCollector()
+		uint64 gcMicros;          ///< Time spent in stepGarbageCollector()
+	};
+
+	static const size_t kMaxPooledSize = 256;
+
+	LuaAllocator();
+	~LuaAllocator();
+
+	/**
+	 * Create a Lua state using this allocator, like luaL_newstate() does with
+	 * the standard allocator.
+	 */
+	lua_State *newState();
+
+	/**
+	 * Run incremental garbage collection steps on @p L for at most about
+	 * @p budgetMicros. Calling this once per frame lets the collector work when
+	 * the engine has time to spare, instead of in the middle of a script.
+	 *
+	 * @return true if a collection cycle was finished
+	 */
+	bool stepGarbageCollector(lua_State *L, uint32 budgetMicros);
+
+	const Stats &getStats() const { return _stats; }
+
+	/** Print the statistics of the state @p L, called @p name, as a debug message. */
+	void printReport(lua_State *L, const char *name) const;
+
+	/** The lua_Alloc function, with the allocator as user data. */
+	static void *alloc(void *ud, void *ptr, size_t osize, size_t nsize);
+
+private:
+	static const uint kNumPools = 8;
+	static const size_t kPoolSizes[kNumPools];
+
+	/** Index of the pool for blocks of @p size bytes, or -1 for heap blocks. */
+	static int getPoolIndex(size_t size);
+
+	void *reallocate(void *ptr, size_t osize, size_t nsize);
+	void release(void *ptr, size_t size);
+
+	Common::MemoryPool *_pools[kNumPools];
+	Stats _stats;
+};
+
+} // End of namespace Lua
+
+#endif
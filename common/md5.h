@@ -62,6 +62,18 @@ bool computeStreamMD5(ReadStream &stream, uint8 digest[16], uint32 length = 0);
  */
 String computeStreamMD5AsString(ReadStream &stream, uint32 length = 0);
 
+/**
+ * Compute the MD5 checksums of several streams, as computeStreamMD5AsString()
+ * does for each of them. When the backend has worker threads, the streams
+ * are hashed concurrently, so they must not share any state, like separately
+ * opened files do.
+ * @param[in] streams	the streams of whose data the MD5s are computed; null streams are skipped
+ * @param[out] md5s	the MD5s as hex strings, or empty strings for the skipped streams
+ * @param[in] count	the number of streams
+ * @param[in] length	the number of bytes of each stream for which to compute the checksum; 0 means all
+ */
+void computeStreamsMD5AsString(ReadStream *const *streams, String *md5s, uint32 count, uint32 length = 0);
+
 /** @} */
 
 } // End of namespace Common
@@ -23,6 +23,7 @@
 #define COMMON_MEMORY_H
 
 #include "common/scummsys.h"
+#include "common/util.h"
 
 namespace Common {
 
@@ -62,6 +63,18 @@ Type *uninitialized_copy(In first, In last, Type *dst) {
 	return dst;
 }
 
+/**
+ * Moves data from the range [first, last) to [dst, dst + (last - first)).
+ * It requires the range [dst, dst + (last - first)) to be valid and
+ * uninitialized. The source elements are left in a moved-from state.
+ */
+template<class In, class Type>
+Type *uninitialized_move(In first, In last, Type *dst) {
+	while (first != last)
+		new ((void *)dst++) Type(Common::move(*first++));
+	return dst;
+}
+
 /**
  * Initializes the memory [first, first + (last - first)) with the value x.
  * It requires the range [first, first + (last - first)) to be valid and
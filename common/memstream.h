@@ -84,6 +84,28 @@ public:
 		_pos(0),
 		_eos(false) {}
 
+	/**
+	 * This constructor wraps @p dataSize bytes starting at @p offset of a
+	 * shared buffer, which is kept alive as long as the stream exists.
+	 */
+	MemoryReadStream(SharedPtr<const byte> dataPtr, uint32 offset, uint32 dataSize) :
+		_ptrOrig(dataPtr),
+		_ptr(dataPtr.get() + offset),
+		_size(dataSize),
+		_pos(0),
+		_eos(false) {}
+
+	/**
+	 * Create a stream over the bytes from @p begin to @p end of this stream,
+	 * without copying them.
+	 *
+	 * This is only possible if the stream was created with a SharedPtr: the
+	 * slice then shares ownership of the buffer and may outlive this stream.
+	 *
+	 * @return The new stream, or nullptr if the buffer is not shared.
+	 */
+	MemoryReadStream *createSlice(uint32 begin, uint32 end) const;
+
 	uint32 read(void *dataPtr, uint32 dataSize);
 
 	bool eos() const { return _eos; }
@@ -0,0 +1,106 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/memusage.h"
+#include "common/algorithm.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(MemoryUsage);
+
+MemoryCounter::MemoryCounter(const char *name) : _name(name), _bytes(0), _peak(0) {
+	MemUsageMan.registerCounter(this);
+}
+
+MemoryCounter::~MemoryCounter() {
+	if (MemoryUsage::hasInstance())
+		MemUsageMan.unregisterCounter(this);
+}
+
+void MemoryUsage::registerCounter(MemoryCounter *counter) {
+	StackLock lock(_mutex);
+	_counters.push_back(counter);
+}
+
+void MemoryUsage::unregisterCounter(MemoryCounter *counter) {
+	StackLock lock(_mutex);
+	for (uint i = 0; i < _counters.size(); i++) {
+		if (_counters[i] == counter) {
+			_counters.remove_at(i);
+			return;
+		}
+	}
+}
+
+void MemoryUsage::getEntries(Array<Entry> &entries) const {
+	entries.clear();
+
+	{
+		StackLock lock(_mutex);
+		for (uint i = 0; i < _counters.size(); i++) {
+			const MemoryCounter *counter = _counters[i];
+
+			// The names are usually string literals, so comparing the
+			// pointers is enough most of the time
+			uint j;
+			for (j = 0; j < entries.size(); j++) {
+				if (entries[j].name == counter->getName() || !strcmp(entries[j].name, counter->getName()))
+					break;
+			}
+			if (j == entries.size()) {
+				Entry entry = { counter->getName(), 0, 0, 0 };
+				entries.push_back(entry);
+			}
+
+			entries[j].bytes += counter->get();
+			entries[j].peak += counter->getPeak();
+			entries[j].counters++;
+		}
+	}
+
+	Common::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+		return a.bytes > b.bytes;
+	});
+}
+
+size_t MemoryUsage::getTotal() const {
+	StackLock lock(_mutex);
+	size_t total = 0;
+	for (uint i = 0; i < _counters.size(); i++)
+		total += _counters[i]->get();
+	return total;
+}
+
+void MemoryUsage::resetPeaks() {
+	StackLock lock(_mutex);
+	for (uint i = 0; i < _counters.size(); i++)
+		_counters[i]->resetPeak();
+}
+
+String MemoryUsage::formatSize(size_t bytes) {
+	if (bytes < 1024)
+		return String::format("%u B", (uint)bytes);
+	if (bytes < 1024 * 1024)
+		return String::format("%.1f KB", bytes / 1024.0);
+	return String::format("%.2f MB", bytes / (1024.0 * 1024.0));
+}
+
+} // End of namespace Common
@@ -0,0 +1,147 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_MEMUSAGE_H
+#define COMMON_MEMUSAGE_H
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+#include <atomic>
+
+namespace Common {
+
+/**
+ * @defgroup common_memusage Memory usage accounting
+ * @ingroup common
+ *
+ * @brief API for keeping track of the memory held by caches and pools.
+ *
+ * @{
+ */
+
+/**
+ * Number of bytes held by a cache, a pool or any other subsystem.
+ *
+ * The owner updates the counter whenever it allocates or frees memory it
+ * accounts for. A counter is registered with MemoryUsage for its whole
+ * lifetime. Counters sharing a name are reported together, so that every
+ * instance of a cache can have a counter of its own.
+ *
+ * The counter may be updated from any thread.
+ */
+class MemoryCounter : NonCopyable {
+public:
+	/**
+	 * @param name A string literal naming the counter, e.g. "SCI resources".
+	 */
+	explicit MemoryCounter(const char *name);
+	~MemoryCounter();
+
+	const char *getName() const { return _name; }
+
+	/** Account for @p bytes more. */
+	void add(size_t bytes) {
+		updatePeak(_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+	}
+
+	/** Account for @p bytes less. */
+	void remove(size_t bytes) {
+		_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+	}
+
+	/** Replace the number of bytes accounted for. */
+	void set(size_t bytes) {
+		_bytes.store(bytes, std::memory_order_relaxed);
+		updatePeak(bytes);
+	}
+
+	/** Return the number of bytes currently accounted for. */
+	size_t get() const { return _bytes.load(std::memory_order_relaxed); }
+
+	/** Return the highest number of bytes accounted for since the last reset. */
+	size_t getPeak() const { return _peak.load(std::memory_order_relaxed); }
+
+	/** Set the peak back to the current number of bytes. */
+	void resetPeak() { _peak.store(get(), std::memory_order_relaxed); }
+
+private:
+	void updatePeak(size_t bytes) {
+		size_t peak = _peak.load(std::memory_order_relaxed);
+		while (bytes > peak && !_peak.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+		}
+	}
+
+	const char *_name;
+	std::atomic<size_t> _bytes;
+	std::atomic<size_t> _peak;
+};
+
+/**
+ * Registry of all the memory counters, which sums them up for the
+ * "mem_usage" debugger command and the frame profiler overlay.
+ */
+class MemoryUsage : public Singleton<MemoryUsage> {
+public:
+	/** Usage of all the counters sharing a name. */
+	struct Entry {
+		const char *name;
+		size_t bytes;   ///< Bytes currently held.
+		size_t peak;    ///< Sum of the peaks of the counters.
+		uint counters;  ///< Number of counters with that name.
+	};
+
+	/** Get the usage per counter name, sorted by decreasing size. */
+	void getEntries(Array<Entry> &entries) const;
+
+	/** Return the number of bytes held by all the counters. */
+	size_t getTotal() const;
+
+	/** Set the peak of every counter back to its current value. */
+	void resetPeaks();
+
+	/** Format a number of bytes for display, e.g. "1.50 MB". */
+	static String formatSize(size_t bytes);
+
+private:
+	friend class Singleton<MemoryUsage>;
+	friend class MemoryCounter;
+
+	MemoryUsage() {}
+
+	void registerCounter(MemoryCounter *counter);
+	void unregisterCounter(MemoryCounter *counter);
+
+	mutable Mutex _mutex;
+	Array<MemoryCounter *> _counters;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+/** Shortcut for accessing the memory usage registry. */
+#define MemUsageMan		Common::MemoryUsage::instance()
+
+#endif
@@ -2,6 +2,8 @@ MODULE := common
 
 MODULE_OBJS := \
 	archive.o \
+	arena.o \
+	asynclog.o \
 	concatstream.o \
 	config-manager.o \
 	coroutines.o \
@@ -13,16 +15,20 @@ MODULE_OBJS := \
 	fs.o \
 	gui_options.o \
 	hashmap.o \
+	intern-str.o \
+	jobsystem.o \
 	language.o \
 	localization.o \
 	macresman.o \
 	memory.o \
 	memorypool.o \
+	memusage.o \
 	md5.o \
 	mutex.o \
 	osd_message_queue.o \
 	path.o \
 	platform.o \
+	profiler.o \
 	punycode.o \
 	random.o \
 	rational.o \
@@ -42,6 +48,7 @@ MODULE_OBJS := \
 	ustr.o \
 	util.o \
 	xpfloat.o \
+	xxhash.o \
 	zip-set.o
 
 ifdef ENABLE_EVENTRECORDER
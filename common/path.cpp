@@ -406,6 +406,7 @@ Path &Path::appendInPlace(const Path &x) {
 	if (x._str.empty()) {
 		return *this;
 	}
+	invalidateCache();
 
 	if (_str.empty()) {
 		_str = x._str;
@@ -456,6 +457,7 @@ Path &Path::appendInPlace(const char *str, char separator) {
 	if (!*str) {
 		return *this;
 	}
+	invalidateCache();
 	if (_str.empty()) {
 		set(str, separator);
 		return *this;
@@ -512,6 +514,7 @@ Path Path::appendComponent(const char *str) const {
 	if (isEscaped()) {
 		// We are escaped, escape str as well
 		Path ret(*this);
+		ret.invalidateCache();
 		if (addSeparator) {
 			ret._str += SEPARATOR;
 		}
@@ -532,6 +535,7 @@ Path Path::appendComponent(const char *str) const {
 	} else {
 		// No need to escape anything
 		Path ret(*this);
+		ret.invalidateCache();
 		if (addSeparator) {
 			ret._str += SEPARATOR;
 		}
@@ -544,6 +548,7 @@ Path &Path::joinInPlace(const Path &x) {
 	if (x.empty()) {
 		return *this;
 	}
+	invalidateCache();
 	if (_str.empty()) {
 		_str = x._str;
 		return *this;
@@ -567,6 +572,7 @@ Path &Path::joinInPlace(const char *str, char separator) {
 	if (*str == '\0') {
 		return *this;
 	}
+	invalidateCache();
 	if (_str.empty()) {
 		set(str, separator);
 		return *this;
@@ -582,6 +588,7 @@ Path &Path::joinInPlace(const char *str, char separator) {
 Path &Path::removeTrailingSeparators() {
 	while (_str.size() > 1 && _str.lastChar() == SEPARATOR) {
 		_str.deleteLastChar();
+		invalidateCache();
 	}
 	return *this;
 }
@@ -685,6 +692,11 @@ Path Path::normalize() const {
 		return Path();
 	}
 
+	// Normalizing is idempotent: don't do the work twice
+	if (_cacheFlags & kCachedNormalized) {
+		return *this;
+	}
+
 	const char *cur = _str.c_str();
 
 	bool hasLeadingSeparator = false;
@@ -740,6 +752,7 @@ Path Path::normalize() const {
 		if (hasLeadingSeparator) {
 			result._str += SEPARATOR;
 		}
+		result._cacheFlags |= kCachedNormalized;
 		return result;
 	}
 
@@ -794,6 +807,7 @@ Path Path::normalize() const {
 		}
 	}
 
+	result._cacheFlags |= kCachedNormalized;
 	return result;
 }
 
@@ -1021,6 +1035,10 @@ struct hasher {
 };
 
 uint Path::hash() const {
+	if (_cacheFlags & kCachedHash) {
+		return _hashCache;
+	}
+
 	hasher v = { 0x345678, 1000003 };
 	reduceComponents<hasher &>(
 		+[](hasher &value, const String &in, bool last) -> hasher & {
@@ -1030,10 +1048,17 @@ uint Path::hash() const {
 			value.mult = (value.mult * 69069);
 			return value;
 		}, v);
+
+	_hashCache = v.result;
+	_cacheFlags |= kCachedHash;
 	return v.result;
 }
 
 uint Path::hashIgnoreCase() const {
+	if (_cacheFlags & kCachedHashIgnoreCase) {
+		return _hashIgnoreCaseCache;
+	}
+
 	hasher v = { 0x345678, 1000003 };
 	reduceComponents<hasher &>(
 		+[](hasher &value, const String &in, bool last) -> hasher & {
@@ -1043,20 +1068,50 @@ uint Path::hashIgnoreCase() const {
 			value.mult = (value.mult * 69069);
 			return value;
 		}, v);
+
+	_hashIgnoreCaseCache = v.result;
+	_cacheFlags |= kCachedHashIgnoreCase;
 	return v.result;
 }
 
-uint Path::hashIgnoreCaseAndMac() const {
-	hasher v = { 0x345678, 1000003 };
-	reduceComponents<hasher &>(
-		+[](hasher &value, const String &in, bool last) -> hasher & {
-			uint hash = hashit_lower(getIdentifierComponent(in));
+struct foldedKeyBuilder {
+	String key;
+	hasher hash;
+};
 
-			value.result = (value.result + hash) * value.mult;
-			value.mult = (value.mult * 69069);
+void Path::cacheFoldedKey() const {
+	if (_cacheFlags & kCachedFoldedKey) {
+		return;
+	}
+
+	// The key is built from the same components as the hash, so that
+	// comparing keys matches comparing the components one by one
+	foldedKeyBuilder v = { String(), { 0x345678, 1000003 } };
+	reduceComponents<foldedKeyBuilder &>(
+		+[](foldedKeyBuilder &value, const String &in, bool last) -> foldedKeyBuilder & {
+			String part = getIdentifierComponent(in);
+			part.toLowercase();
+			uint hash = hashit(part.c_str());
+
+			value.hash.result = (value.hash.result + hash) * value.hash.mult;
+			value.hash.mult = (value.hash.mult * 69069);
+
+			// Components can't contain SEPARATOR anymore after getIdentifierComponent
+			value.key += part;
+			if (!last) {
+				value.key += SEPARATOR;
+			}
 			return value;
 		}, v);
-	return v.result;
+
+	_foldedKey = v.key;
+	_hashIgnoreCaseAndMacCache = v.hash.result;
+	_cacheFlags |= kCachedFoldedKey;
+}
+
+uint Path::hashIgnoreCaseAndMac() const {
+	cacheFoldedKey();
+	return _hashIgnoreCaseAndMacCache;
 }
 
 bool Path::matchPattern(const Path &pattern) const {
@@ -1067,6 +1122,16 @@ bool Path::matchPattern(const Path &pattern) const {
 }
 
 bool Path::equalsIgnoreCase(const Path &other) const {
+	// Lookups in case insensitive maps mostly compare identical paths:
+	// avoid splitting them into components in that case.
+	if (_str.equals(other._str))
+		return true;
+
+	// Different hashes already computed by a lookup tell the paths apart
+	if ((_cacheFlags & other._cacheFlags & kCachedHashIgnoreCase) &&
+	        _hashIgnoreCaseCache != other._hashIgnoreCaseCache)
+		return false;
+
 	return compareComponents(
 		+[](const String &x, const String &y) {
 			return x.equalsIgnoreCase(y);
@@ -1074,10 +1139,18 @@ bool Path::equalsIgnoreCase(const Path &other) const {
 }
 
 bool Path::equalsIgnoreCaseAndMac(const Path &other) const {
-	return compareComponents(
-		+[](const String &x, const String &y) {
-			return getIdentifierComponent(x).equalsIgnoreCase(getIdentifierComponent(y));
-		}, other);
+	// Identical paths are equal without decoding each component
+	if (_str.equals(other._str))
+		return true;
+
+	if (_str.empty() || other._str.empty())
+		return false;
+
+	// Compare the cached folded keys, so that each path gets decoded only once
+	cacheFoldedKey();
+	other.cacheFoldedKey();
+	return _hashIgnoreCaseAndMacCache == other._hashIgnoreCaseAndMacCache &&
+	       _foldedKey.equals(other._foldedKey);
 }
 
 bool Path::operator<(const Path &x) const {
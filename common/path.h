@@ -70,6 +70,33 @@ private:
 
 	String _str;
 
+	// Flags telling which of the cached values below are valid
+	enum {
+		kCachedHash            = 1 << 0,
+		kCachedHashIgnoreCase  = 1 << 1,
+		kCachedFoldedKey       = 1 << 2,
+		kCachedNormalized      = 1 << 3
+	};
+
+	/**
+	 * Values derived from _str, computed on first use and kept until the
+	 * path gets modified. This makes repeated lookups with the same Path
+	 * object cheap. As they are filled in by const methods, a Path must not
+	 * be shared between threads without synchronization.
+	 */
+	mutable byte _cacheFlags = 0;
+	mutable uint _hashCache = 0;
+	mutable uint _hashIgnoreCaseCache = 0;
+	mutable uint _hashIgnoreCaseAndMacCache = 0;
+	// Lowercase, punycode decoded path with '/' in components replaced by ':'
+	mutable String _foldedKey;
+
+	/** Forget the cached values: to be called whenever _str changes. */
+	void invalidateCache() { _cacheFlags = 0; }
+
+	/** Compute the folded key and its hash if they are not cached yet. */
+	void cacheFoldedKey() const;
+
 	/**
 	 * Escapes a path:
 	 * - all ESCAPE are encoded to ESCAPE ESCAPED_ESCAPE
@@ -240,7 +267,9 @@ public:
 	Path() {}
 
 	/** Construct a copy of the given path. */
-	Path(const Path &path) : _str(path._str) { }
+	Path(const Path &path) : _str(path._str), _cacheFlags(path._cacheFlags),
+		_hashCache(path._hashCache), _hashIgnoreCaseCache(path._hashIgnoreCaseCache),
+		_hashIgnoreCaseAndMacCache(path._hashIgnoreCaseAndMacCache), _foldedKey(path._foldedKey) { }
 
 	/**
 	 * Construct a new path from the given NULL-terminated C string.
@@ -279,7 +308,10 @@ public:
 	/**
 	 * Clears the path object
 	 */
-	void clear() { _str.clear(); }
+	void clear() {
+		_str.clear();
+		invalidateCache();
+	}
 
 	/**
 	 * Returns the Path for the parent directory of this path.
@@ -355,6 +387,11 @@ public:
 	/** Assign a given path to this path. */
 	Path &operator=(const Path &path) {
 		_str = path._str;
+		_cacheFlags = path._cacheFlags;
+		_hashCache = path._hashCache;
+		_hashIgnoreCaseCache = path._hashIgnoreCaseCache;
+		_hashIgnoreCaseAndMacCache = path._hashIgnoreCaseAndMacCache;
+		_foldedKey = path._foldedKey;
 		return *this;
 	}
 
@@ -376,6 +413,7 @@ public:
 		} else {
 			_str = str;
 		}
+		invalidateCache();
 	}
 
 	/**
@@ -502,6 +540,7 @@ public:
 	void toLowercase() {
 		// Escapism is not changed by changing case
 		_str.toLowercase();
+		invalidateCache();
 	}
 
 	/**
@@ -513,6 +552,7 @@ public:
 	void toUppercase() {
 		// Escapism is not changed by changing case
 		_str.toUppercase();
+		invalidateCache();
 	}
 
 	/**
@@ -0,0 +1,194 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/profiler.h"
+#include "common/config-manager.h"
+#include "common/file.h"
+#include "common/memusage.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+#include "common/translation.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+bool Profiler::_enabled = false;
+
+static const char *const threadNames[] = { "Main", "Audio" };
+
+Profiler::Profiler() : _numZones(0), _overlayShown(false), _reportStart(0), _frames(0),
+	_trace(nullptr), _traceStart(0) {
+}
+
+Profiler::~Profiler() {
+	_enabled = false;
+	stopTrace();
+}
+
+uint64 Profiler::getTime() {
+	return g_system->getMicros();
+}
+
+void Profiler::toggleOverlay() {
+	if (_overlayShown) {
+		_enabled = false;
+
+		StackLock lock(_mutex);
+		stopTrace();
+		_overlayShown = false;
+		g_system->displayMessageOnOSD(_("Frame profiler disabled"));
+		return;
+	}
+
+	{
+		StackLock lock(_mutex);
+		_numZones = 0;
+		_frames = 0;
+		_reportStart = getTime();
+		_overlayShown = true;
+
+		if (ConfMan.hasKey("profiler_trace"))
+			startTrace(ConfMan.getPath("profiler_trace"));
+	}
+
+	_enabled = true;
+	g_system->displayMessageOnOSD(_("Frame profiler enabled"));
+}
+
+void Profiler::addZone(const char *name, Thread thread, uint64 start, uint64 end) {
+	StackLock lock(_mutex);
+	if (!_enabled)
+		return;
+
+	// The zone names are usually string literals, so comparing the pointers
+	// is enough most of the time
+	uint i;
+	for (i = 0; i < _numZones; i++) {
+		if (_zones[i].thread == thread && (_zones[i].name == name || !strcmp(_zones[i].name, name)))
+			break;
+	}
+	if (i == _numZones) {
+		if (_numZones == kMaxZones)
+			return;
+
+		_zones[i].name = name;
+		_zones[i].thread = thread;
+		_zones[i].micros = 0;
+		_numZones++;
+	}
+
+	const uint64 duration = end > start ? end - start : 0;
+	_zones[i].micros += duration;
+
+	if (_trace)
+		writeTraceEvent(name, thread, start, duration);
+}
+
+void Profiler::endFrame() {
+	StackLock lock(_mutex);
+	if (!_enabled)
+		return;
+
+	const uint64 now = getTime();
+	_frames++;
+
+	if (_trace) {
+		_trace->writeString(String::format(",\n{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"p\",\"pid\":1,\"tid\":%d,\"ts\":%.0f}",
+			kThreadMain, (double)(now - _traceStart)));
+	}
+
+	if (now - _reportStart >= kReportInterval * 1000)
+		report(now);
+}
+
+void Profiler::report(uint64 now) {
+	const double frameMicros = (double)(now - _reportStart) / _frames;
+
+	// The main thread spends the time outside of the zones in the engine
+	double engineMicros = frameMicros;
+	for (uint i = 0; i < _numZones; i++) {
+		if (_zones[i].thread == kThreadMain)
+			engineMicros -= (double)_zones[i].micros / _frames;
+	}
+
+	String message = String::format("Frame: %.2f ms (%.1f fps)\nEngine: %.2f ms", frameMicros / 1000, 1000000 / frameMicros, MAX(engineMicros, 0.0) / 1000);
+	for (uint i = 0; i < _numZones; i++) {
+		message += String::format("\n%s: %.2f ms", _zones[i].name, (double)_zones[i].micros / _frames / 1000);
+		_zones[i].micros = 0;
+	}
+
+	// Add the largest memory counters, if any subsystem keeps some
+	if (MemoryUsage::hasInstance()) {
+		Array<MemoryUsage::Entry> entries;
+		MemUsageMan.getEntries(entries);
+		if (!entries.empty()) {
+			message += String::format("\nMemory: %s", MemoryUsage::formatSize(MemUsageMan.getTotal()).c_str());
+			for (uint i = 0; i < entries.size() && i < kMaxMemoryLines; i++)
+				message += String::format("\n%s: %s", entries[i].name, MemoryUsage::formatSize(entries[i].bytes).c_str());
+		}
+	}
+
+	_frames = 0;
+	_reportStart = now;
+
+	g_system->displayMessageOnOSD(U32String(message));
+}
+
+bool Profiler::startTrace(const Path &filename) {
+	DumpFile *trace = new DumpFile();
+	if (!trace->open(filename, true)) {
+		warning("Profiler: Could not open trace file '%s'", filename.toString(Path::kNativeSeparator).c_str());
+		delete trace;
+		return false;
+	}
+
+	_trace = trace;
+	_traceStart = getTime();
+
+	// Name the tracks of the threads
+	_trace->writeString("{\"traceEvents\":[\n");
+	for (uint i = 0; i < ARRAYSIZE(threadNames); i++) {
+		_trace->writeString(String::format("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+			i ? ",\n" : "", i, threadNames[i]));
+	}
+	return true;
+}
+
+void Profiler::stopTrace() {
+	if (!_trace)
+		return;
+
+	_trace->writeString("\n]}\n");
+	_trace->finalize();
+	if (_trace->err())
+		warning("Profiler: Could not write the trace file");
+
+	delete _trace;
+	_trace = nullptr;
+}
+
+void Profiler::writeTraceEvent(const char *name, Thread thread, uint64 start, uint64 duration) {
+	_trace->writeString(String::format(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.0f,\"dur\":%.0f}",
+		name, thread, start > _traceStart ? (double)(start - _traceStart) : 0.0, (double)duration));
+}
+
+} // End of namespace Common
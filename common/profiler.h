@@ -0,0 +1,153 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/mutex.h"
+#include "common/path.h"
+#include "common/singleton.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_profiler Frame profiler
+ * @ingroup common
+ *
+ * @brief API for measuring the time spent per frame in zones of the code.
+ * @{
+ */
+
+class DumpFile;
+
+/**
+ * Measures how much time per frame is spent in named zones of the code.
+ *
+ * Zones are marked with PROFILE_ZONE(). While the profiler is disabled, a
+ * zone only costs the check of a flag. A frame ends with each call of
+ * OSystem::updateScreen().
+ *
+ * While the overlay is shown, the average frame time and the time spent in
+ * each zone per frame are displayed on the OSD. The time of the main thread
+ * which is not spent in any zone is shown as the engine's time. The total
+ * of the memory counters and the largest ones are displayed below.
+ *
+ * If the "profiler_trace" configuration key is set when the overlay is
+ * shown, every zone is also written to that file in the Trace Event Format
+ * of Chrome, which can be viewed with chrome://tracing or Perfetto.
+ */
+class Profiler : public Singleton<Profiler> {
+public:
+	/** The threads zones are measured on. Each one is a track in the trace. */
+	enum Thread {
+		kThreadMain = 0,
+		kThreadAudio = 1
+	};
+
+	enum {
+		kMaxZones = 16,         /**< Maximum number of different zones */
+		kReportInterval = 500,  /**< Time between two updates of the overlay (in milliseconds) */
+		kMaxMemoryLines = 4     /**< Maximum number of memory counters shown on the overlay */
+	};
+
+	Profiler();
+	~Profiler();
+
+	/** Whether zones are measured at all. */
+	static bool isEnabled() { return _enabled; }
+
+	/** Current time in microseconds, as used for the zones. */
+	static uint64 getTime();
+
+	/** Show or hide the overlay, and start or stop the trace with it. */
+	void toggleOverlay();
+	bool isOverlayShown() const { return _overlayShown; }
+
+	/** Add the time spent in a zone. May be called from any thread. */
+	void addZone(const char *name, Thread thread, uint64 start, uint64 end);
+
+	/** End the current frame. Called by the backends when updating the screen. */
+	void endFrame();
+
+private:
+	struct Zone {
+		const char *name;
+		Thread thread;
+		uint64 micros;
+	};
+
+	bool startTrace(const Path &filename);
+	void stopTrace();
+	void writeTraceEvent(const char *name, Thread thread, uint64 start, uint64 duration);
+	void report(uint64 now);
+
+	static bool _enabled;
+
+	Mutex _mutex;
+	Zone _zones[kMaxZones];
+	uint _numZones;
+
+	bool _overlayShown;
+	uint64 _reportStart;
+	uint _frames;
+
+	DumpFile *_trace;
+	uint64 _traceStart;
+};
+
+/**
+ * Adds the time from its construction to its destruction to a zone of the
+ * profiler, if it is enabled.
+ */
+class ProfilerZone {
+public:
+	ProfilerZone(const char *name, Profiler::Thread thread = Profiler::kThreadMain) :
+		_name(name), _thread(thread), _start(Profiler::isEnabled() ? Profiler::getTime() : 0) {}
+
+	~ProfilerZone() {
+		if (_start)
+			Profiler::instance().addZone(_name, _thread, _start, Profiler::getTime());
+	}
+
+private:
+	const char *_name;
+	Profiler::Thread _thread;
+	uint64 _start;
+};
+
+#define PROFILER_ZONE_CONCAT_(a, b) a##b
+#define PROFILER_ZONE_CONCAT(a, b) PROFILER_ZONE_CONCAT_(a, b)
+
+/**
+ * Measure the rest of the current scope as a zone of the main thread.
+ *
+ * @param name A string literal naming the zone, e.g. "Render".
+ */
+#define PROFILE_ZONE(name) Common::ProfilerZone PROFILER_ZONE_CONCAT(profilerZone, __LINE__)(name)
+
+/** @} */
+
+} // End of namespace Common
+
+/** Shortcut for accessing the frame profiler. */
+#define ProfMan		Common::Profiler::instance()
+
+#endif
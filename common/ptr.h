@@ -723,6 +723,12 @@ public:
 	 */
 	PointerType get() const { return _pointer; }
 
+	/**
+	 * Returns the shared pointer owning the object, which is empty unless
+	 * this DisposablePtr was constructed from a SharedPtr.
+	 */
+	const SharedPtr<T> &getShared() const { return _shared; }
+
 	template <class T2, class DL2>
 	friend class DisposablePtr;
 
@@ -22,6 +22,7 @@
 #ifndef COMMON_SAVEFILE_H
 #define COMMON_SAVEFILE_H
 
+#include "common/array.h"
 #include "common/noncopyable.h"
 #include "common/scummsys.h"
 #include "common/stream.h"
@@ -201,6 +202,36 @@ public:
 	 */
 	virtual OutSaveFile *openForSaving(const String &name, bool compress = true) = 0;
 
+	/**
+	 * Open the save file with the specified @p name for saving in the
+	 * background.
+	 *
+	 * The returned file keeps the data in memory. Once it is finalized,
+	 * the data is compressed and written on a worker thread, so that the
+	 * caller doesn't have to wait for the disk. Opening the same save file
+	 * again waits for the write to finish, and checkPendingSaves() reports
+	 * whether it succeeded.
+	 *
+	 * The default implementation saves synchronously.
+	 *
+	 * @param name      Name of the save file.
+	 * @param compress  Whether to compress the resulting save file (default) or not.
+	 *
+	 * @return Pointer to an OutSaveFile, or NULL if an error occurred.
+	 */
+	virtual OutSaveFile *openForSavingAsync(const String &name, bool compress = true) { return openForSaving(name, compress); }
+
+	/**
+	 * Check for save files opened with openForSavingAsync() which have
+	 * been written since the last call.
+	 *
+	 * @param wait  Whether to block until all pending save files are written.
+	 *
+	 * @return False if one of them could not be written, true otherwise.
+	 *         The error is available through getError().
+	 */
+	virtual bool checkPendingSaves(bool wait = false) { return true; }
+
 	/**
 	 * Open the file with the specified @p name in the given directory for loading.
 	 *
@@ -276,6 +307,31 @@ public:
 	 * @return true if the file exists. false otherwise.
 	 */
 	virtual bool exists(const String &name) = 0;
+
+	/**
+	 * Retrieve the metadata stored for a save file with setMetaData().
+	 *
+	 * The metadata of a save file is dropped when it is saved again or
+	 * removed, so it always describes the current contents of the file.
+	 *
+	 * @param name  Name of the save file.
+	 * @param data  Receives the metadata.
+	 *
+	 * @return True if there is metadata for the save file, false otherwise.
+	 */
+	virtual bool getMetaData(const String &name, Array<byte> &data) { return false; }
+
+	/**
+	 * Store metadata for a save file, usually what is needed to list it,
+	 * so that the file doesn't have to be opened for that next time.
+	 *
+	 * The default implementation doesn't store anything.
+	 *
+	 * @param name  Name of the save file.
+	 * @param data  The metadata.
+	 * @param size  Size of the metadata in bytes.
+	 */
+	virtual void setMetaData(const String &name, const byte *data, uint32 size) {}
 };
 
 /** @} */
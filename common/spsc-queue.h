@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_SPSC_QUEUE_H
+#define COMMON_SPSC_QUEUE_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+#include <atomic>
+
+namespace Common {
+
+/**
+ * @defgroup common_spsc_queue Lock-free queue
+ * @ingroup common
+ *
+ * @brief Fixed-size queue for passing data between two threads.
+ *
+ * @{
+ */
+
+/**
+ * Fixed size, lock-free queue with a single producer and a single consumer.
+ *
+ * push() must only ever be called from one thread at a time, and so must
+ * pop(); the two can run concurrently without any locking. Code with
+ * several producers has to serialize them itself.
+ *
+ * @tparam T         Type of the items. It is copied in and out of the queue.
+ * @tparam MAX_SIZE  Number of items the queue can hold. Must be a power of two.
+ */
+template<class T, uint MAX_SIZE>
+class SPSCQueue : NonCopyable {
+	STATIC_ASSERT((MAX_SIZE & (MAX_SIZE - 1)) == 0, SPSCQueue_size_must_be_a_power_of_two);
+
+public:
+	typedef uint size_type;
+
+	SPSCQueue() : _head(0), _tail(0) {}
+
+	/**
+	 * Add an item to the queue. Only call this from the producer.
+	 *
+	 * @return False if the queue is full, in which case nothing is added.
+	 */
+	bool push(const T &x) {
+		const uint32 head = _head.load(std::memory_order_relaxed);
+		if (head - _tail.load(std::memory_order_acquire) == MAX_SIZE)
+			return false;
+
+		_items[head % MAX_SIZE] = x;
+		_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Remove the oldest item from the queue. Only call this from the consumer.
+	 *
+	 * @return False if the queue is empty, in which case @p x is unchanged.
+	 */
+	bool pop(T &x) {
+		const uint32 tail = _tail.load(std::memory_order_relaxed);
+		if (_head.load(std::memory_order_acquire) == tail)
+			return false;
+
+		x = _items[tail % MAX_SIZE];
+		_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Return the number of queued items. When called while the other thread
+	 * is active, the result is only a snapshot.
+	 */
+	size_type size() const {
+		const uint32 tail = _tail.load(std::memory_order_acquire);
+		return _head.load(std::memory_order_acquire) - tail;
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+private:
+	T _items[MAX_SIZE];
+	std::atomic<uint32> _head; ///< Index of the next item to push, written by the producer only.
+	std::atomic<uint32> _tail; ///< Index of the next item to pop, written by the consumer only.
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -124,6 +124,17 @@ uint32 MemoryReadStream::read(void *dataPtr, uint32 dataSize) {
 	return dataSize;
 }
 
+MemoryReadStream *MemoryReadStream::createSlice(uint32 begin, uint32 end) const {
+	assert(begin <= end && end <= _size);
+
+	const SharedPtr<const byte> &shared = _ptrOrig.getShared();
+	if (!shared)
+		return nullptr;
+
+	const byte *start = _ptr - _pos;
+	return new MemoryReadStream(shared, (uint32)(start - shared.get()) + begin, end - begin);
+}
+
 bool MemoryReadStream::seek(int64 offs, int whence) {
 	// Pre-Condition
 	assert(_pos <= _size);
@@ -136,7 +147,8 @@ bool MemoryReadStream::seek(int64 offs, int whence) {
 	case SEEK_SET:
 		// Fall through
 	default:
-		_ptr = _ptrOrig.get() + offs;
+		// _ptr - _pos is the start of the data, which may be a slice of _ptrOrig
+		_ptr += offs - _pos;
 		_pos = offs;
 		break;
 
@@ -251,6 +263,20 @@ uint32 SubReadStream::read(void *dataPtr, uint32 dataSize) {
 	return dataSize;
 }
 
+SeekableReadStream *createSliceReadStream(SeekableReadStream *parentStream, uint32 begin, uint32 end, DisposeAfterUse::Flag disposeParentStream) {
+	MemoryReadStream *memoryStream = dynamic_cast<MemoryReadStream *>(parentStream);
+	if (memoryStream) {
+		MemoryReadStream *slice = memoryStream->createSlice(begin, end);
+		if (slice) {
+			if (disposeParentStream)
+				delete parentStream;
+			return slice;
+		}
+	}
+
+	return new SeekableSubReadStream(parentStream, begin, end, disposeParentStream);
+}
+
 SeekableSubReadStream::SeekableSubReadStream(SeekableReadStream *parentStream, uint32 begin, uint32 end, DisposeAfterUse::Flag disposeParentStream)
 	: SubReadStream(parentStream, end, disposeParentStream),
 	_parentStream(parentStream),
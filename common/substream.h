@@ -152,6 +152,17 @@ protected:
 	Common::Mutex &_mutex;
 };
 
+/**
+ * Create a stream for the bytes from @p begin to @p end of @p parentStream.
+ *
+ * If the parent stream is a MemoryReadStream over a shared buffer, like the
+ * streams returned by FSNode::createMappedReadStream(), this returns a slice
+ * of that buffer: reading it neither copies the data into a new buffer nor
+ * seeks the parent stream, and the slice keeps the buffer alive on its own.
+ * Otherwise this returns a SeekableSubReadStream.
+ */
+SeekableReadStream *createSliceReadStream(SeekableReadStream *parentStream, uint32 begin, uint32 end, DisposeAfterUse::Flag disposeParentStream = DisposeAfterUse::NO);
+
 /** @} */
 
 } // End of namespace Common
@@ -24,7 +24,9 @@
 #include "common/system.h"
 #include "common/events.h"
 #include "common/fs.h"
+#include "common/jobsystem.h"
 #include "common/file.h"
+#include "common/rect.h"
 #include "common/savefile.h"
 #include "common/str.h"
 #include "common/taskbar.h"
@@ -56,6 +58,7 @@ OSystem::OSystem() {
 #if defined(USE_SYSDIALOGS)
 	_dialogManager = nullptr;
 #endif
+	_jobSystem = nullptr;
 	_fsFactory = nullptr;
 	_dlcStore = nullptr;
 	_backendInitialized = false;
@@ -92,6 +95,9 @@ OSystem::~OSystem() {
 	delete _savefileManager;
 	_savefileManager = nullptr;
 
+	delete _jobSystem;
+	_jobSystem = nullptr;
+
 	delete _fsFactory;
 	_fsFactory = nullptr;
 
@@ -218,6 +224,16 @@ bool OSystem::setStretchMode(const char *name) {
 	return false;
 }
 
+void OSystem::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) {
+	const uint bytesPerPixel = getScreenFormat().bytesPerPixel;
+
+	for (uint i = 0; i < count; ++i) {
+		const Common::Rect &r = rects[i];
+		copyRectToScreen((const byte *)buf + r.top * pitch + r.left * bytesPerPixel, pitch,
+		                 r.left, r.top, r.width(), r.height());
+	}
+}
+
 void OSystem::fatalError() {
 	quit();
 	exit(1);
@@ -259,6 +275,12 @@ Common::TimerManager *OSystem::getTimerManager() {
 	return _timerManager;
 }
 
+Common::JobSystem *OSystem::getJobSystem() {
+	if (!_jobSystem)
+		_jobSystem = new Common::JobSystem();
+	return _jobSystem;
+}
+
 Common::SaveFileManager *OSystem::getSavefileManager() {
 	return _savefileManager;
 }
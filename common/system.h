@@ -72,6 +72,7 @@ class TimerManager;
 class SeekableReadStream;
 class WriteStream;
 class HardwareInputSet;
+class JobSystem;
 class Keymap;
 class KeymapperDefaultBindings;
 
@@ -257,6 +258,15 @@ protected:
 	Common::DialogManager *_dialogManager;
 #endif
 
+	/**
+	 * No default value is provided for _jobSystem by OSystem.
+	 * However, getJobSystem() creates a single-threaded job system
+	 * if none has been set by the backend.
+	 *
+	 * @note _jobSystem is deleted by the OSystem destructor.
+	 */
+	Common::JobSystem *_jobSystem;
+
 	/**
 	 * No default value is provided for _fsFactory by OSystem.
 	 *
@@ -1209,6 +1219,29 @@ public:
 	 */
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) = 0;
 
+	/**
+	 * Blit several bitmaps to the virtual screen at once.
+	 *
+	 * This behaves like calling copyRectToScreen for each rectangle, but
+	 * lets backends take their locks and do their bookkeeping once for the
+	 * whole batch. Unlike copyRectToScreen, @p buf is the top-left corner of
+	 * a full screen sized source, and every rectangle is read from the same
+	 * position within it that it is copied to.
+	 *
+	 * The default implementation calls copyRectToScreen for each rectangle.
+	 *
+	 * @param buf    Buffer containing the graphics data source.
+	 * @param pitch  Pitch of the buffer (number of bytes in a scanline).
+	 * @param rects  Destination rectangles.
+	 * @param count  Number of rectangles in @p rects.
+	 *
+	 * @note Every rectangle has to satisfy the same requirements as the
+	 *       destination rectangle of copyRectToScreen.
+	 *
+	 * @see copyRectToScreen
+	 */
+	virtual void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count);
+
 	/**
 	 * Lock the active screen framebuffer and return a Graphics::Surface
 	 * representing it.
@@ -1505,9 +1538,28 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get a timestamp in microseconds, for measuring short durations.
+	 *
+	 * The starting point is arbitrary and the value is never recorded by
+	 * the event recorder. The default implementation only has millisecond
+	 * resolution.
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
+	/**
+	 * Sleep until an event is available or the specified amount of
+	 * milliseconds has passed, whichever comes first.
+	 *
+	 * This lets idle loops sleep for longer without making the input lag.
+	 * The events themselves still have to be read with the event manager.
+	 * The default implementation sleeps for the whole time.
+	 */
+	virtual void waitForEvent(uint msecs) { delayMillis(msecs); }
+
 	/**
 	 * Get the current time and date, in the local timezone.
 	 *
@@ -1594,6 +1646,25 @@ public:
 
 
 
+	/** @defgroup common_system_jobs Job system
+	 *  @ingroup common_system
+	 *  @{
+	 */
+
+	/**
+	 * Return the job system singleton.
+	 *
+	 * Backends without thread support get a job system that runs
+	 * all jobs on the calling thread.
+	 *
+	 * For more information, see @ref JobSystem.
+	 */
+	virtual Common::JobSystem *getJobSystem();
+
+	/** @} */
+
+
+
 	/** @defgroup common_system_sound Sound
 	 *  @ingroup common_system
 	 *  @{
@@ -22,6 +22,8 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_exit
 
 #include "common/textconsole.h"
+#include "common/asynclog.h"
+#include "common/debug-channels.h"
 #include "common/system.h"
 #include "common/str.h"
 
@@ -89,6 +91,10 @@ void NORETURN_PRE error(const char *s, ...) {
 	buf_output[STRINGBUFLEN - 1] = '\0';
 	Common::strcat_s(buf_output, "!\n");
 
+	// Write out the queued debug output leading to the error first
+	if (Common::DebugManager::hasInstance() && DebugMan.getAsyncLog())
+		DebugMan.getAsyncLog()->flush();
+
 	if (g_system)
 		g_system->logMessage(LogMessageType::kError, buf_output);
 	// TODO: Think of a good fallback in case we do not have
@@ -143,17 +143,17 @@ U32String TranslationManager::getTranslation(const char *message, const char *co
 			}
 			// Find the context we want
 			if (context == nullptr || *context == '\0' || leftIndex == rightIndex)
-				return _currentTranslationMessages[leftIndex].msgstr;
+				return getMessageString(_currentTranslationMessages[leftIndex]);
 			// We could use again binary search, but there should be only a small number of contexts.
 			while (rightIndex > leftIndex) {
-				compareResult = strcmp(context, _currentTranslationMessages[rightIndex].msgctxt.c_str());
+				compareResult = strcmp(context, getMessageContext(_currentTranslationMessages[rightIndex]));
 				if (compareResult == 0)
-					return _currentTranslationMessages[rightIndex].msgstr;
+					return getMessageString(_currentTranslationMessages[rightIndex]);
 				else if (compareResult > 0)
 					break;
 				--rightIndex;
 			}
-			return _currentTranslationMessages[leftIndex].msgstr;
+			return getMessageString(_currentTranslationMessages[leftIndex]);
 		} else if (compareResult < 0)
 			rightIndex = midIndex - 1;
 		else
@@ -324,6 +324,7 @@ void TranslationManager::loadTranslationsInfoDat(const Common::String &name) {
 
 void TranslationManager::loadLanguageDat(int index) {
 	_currentTranslationMessages.clear();
+	_currentTranslationData.clear();
 	_currentCharset.clear();
 	// Sanity check
 	if (index < 0 || index >= (int)_langs.size()) {
@@ -336,9 +337,6 @@ void TranslationManager::loadLanguageDat(int index) {
 	if (!openTranslationsFile(in))
 		return;
 
-	char buf[1024];
-	int len;
-
 	// Get number of translations
 	int nbTranslations = in.readUint16BE();
 	if (nbTranslations != (int)_langs.size()) {
@@ -354,35 +352,63 @@ void TranslationManager::loadLanguageDat(int index) {
 	for (int i = 0; i < index + 2; ++i)
 		skipSize += in.readUint32BE();
 
+	// Get the size of the block we want to read
+	const uint32 blockSize = in.readUint32BE();
+
 	// We also need to skip the remaining block sizes
-	skipSize += 4 * (nbTranslations - index);	// 4 because block sizes are written in Uint32BE in the .dat file.
+	skipSize += 4 * (nbTranslations - index - 1);	// 4 because block sizes are written in Uint32BE in the .dat file.
 
 	// Seek to start of block we want to read
 	in.seek(skipSize, SEEK_CUR);
 
+	// Read the whole block at once. The strings are only decoded when they
+	// are looked up, which saves both the time to decode all of them here and
+	// the memory of keeping them as UTF-32. An additional zero byte at the
+	// end serves as the empty context.
+	_currentTranslationData.resize(blockSize + 1);
+	if (in.read(_currentTranslationData.begin(), blockSize) != blockSize || blockSize < 2) {
+		warning("The 'translations.dat' file is truncated. GUI translation will not be available");
+		_currentTranslationData.clear();
+		return;
+	}
+	_currentTranslationData[blockSize] = '\0';
+
+	const byte *const data = (const byte *)_currentTranslationData.begin();
+	const uint32 emptyContext = blockSize;
+
 	// Read number of translated messages
-	int nbMessages = in.readUint16BE();
+	int nbMessages = READ_BE_UINT16(data);
 	_currentTranslationMessages.resize(nbMessages);
 
-	_currentCharset = "UTF-32";
-
-	// Read messages
-	for (int i = 0; i < nbMessages; ++i) {
-		_currentTranslationMessages[i].msgid = in.readUint16BE();
-		len = in.readUint16BE();
-		String msg;
-		while (len > 0) {
-			in.read(buf, len > 256 ? 256 : len);
-			msg += String(buf, len > 256 ? 256 : len - 1);
-			len -= 256;
-		}
-		_currentTranslationMessages[i].msgstr = msg.decode();
-		len = in.readUint16BE();
-		if (len > 0) {
-			in.read(buf, len);
-			_currentTranslationMessages[i].msgctxt = String(buf, len - 1);
-		}
+	// Index the messages
+	uint32 pos = 2;
+	int i;
+	for (i = 0; i < nbMessages; ++i) {
+		PoMessageEntry &entry = _currentTranslationMessages[i];
+		if (pos + 4 > blockSize)
+			break;
+		entry.msgid = READ_BE_UINT16(data + pos);
+		uint len = READ_BE_UINT16(data + pos + 2);
+		entry.msgstr = pos + 4;
+		pos += 4 + len;
+
+		if (len == 0 || pos + 2 > blockSize || data[pos - 1] != '\0')
+			break;
+		len = READ_BE_UINT16(data + pos);
+		entry.msgctxt = len > 0 ? pos + 2 : emptyContext;
+		pos += 2 + len;
+
+		if (pos > blockSize || (len > 0 && data[pos - 1] != '\0'))
+			break;
+	}
+	if (i != nbMessages || pos != blockSize) {
+		warning("The 'translations.dat' file is corrupted. GUI translation will not be available");
+		_currentTranslationMessages.clear();
+		_currentTranslationData.clear();
+		return;
 	}
+
+	_currentCharset = "UTF-32";
 }
 
 bool TranslationManager::checkHeader(File &in) {
@@ -76,9 +76,9 @@ typedef Array<TLanguage> TLangArray;
  */
 struct PoMessageEntry {
 	int msgid;         /*!< ID of the message. */
-	String msgctxt;    /*!< Context of the message. It can be empty.
-							Can be used to solve ambiguities. */
-	U32String msgstr;  /*!< Message string. */
+	uint32 msgctxt;    /*!< Offset of the context of the message in the message data.
+							It can be empty. Can be used to solve ambiguities. */
+	uint32 msgstr;     /*!< Offset of the UTF-8 message string in the message data. */
 };
 
 /**
@@ -239,11 +239,22 @@ private:
 	 */
 	bool checkHeader(File &in);
 
+	/**
+	 * Return the context of the given message of the current language.
+	 */
+	const char *getMessageContext(const PoMessageEntry &entry) const { return &_currentTranslationData[entry.msgctxt]; }
+
+	/**
+	 * Decode the translated string of the given message of the current language.
+	 */
+	U32String getMessageString(const PoMessageEntry &entry) const { return U32String(&_currentTranslationData[entry.msgstr]); }
+
 	StringArray _langs;
 	U32StringArray _langNames;
 
 	StringArray _messageIds;
 	Array<PoMessageEntry> _currentTranslationMessages;
+	Array<char> _currentTranslationData; /*!< Messages of the current language as they are stored in the file. */
 	String _currentCharset;
 	int _currentLang;
 	Common::String _translationsFileName;
@@ -0,0 +1,157 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Implementation of the XXH64 algorithm by Yann Collet, as described in
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+
+#include "common/xxhash.h"
+#include "common/endian.h"
+#include "common/stream.h"
+
+namespace Common {
+
+static const uint64 kPrime1 = 0x9E3779B185EBCA87ULL;
+static const uint64 kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64 kPrime3 = 0x165667B19E3779F9ULL;
+static const uint64 kPrime4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64 kPrime5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64 rotl64(uint64 x, int n) {
+	return (x << n) | (x >> (64 - n));
+}
+
+static inline uint64 round64(uint64 acc, uint64 input) {
+	acc += input * kPrime2;
+	return rotl64(acc, 31) * kPrime1;
+}
+
+static inline uint64 mergeRound64(uint64 acc, uint64 value) {
+	acc ^= round64(0, value);
+	return acc * kPrime1 + kPrime4;
+}
+
+XXHash64::XXHash64(uint64 seed) : _seed(seed), _total(0), _buffered(0) {
+	_acc[0] = seed + kPrime1 + kPrime2;
+	_acc[1] = seed + kPrime2;
+	_acc[2] = seed;
+	_acc[3] = seed - kPrime1;
+}
+
+void XXHash64::update(const void *data, uint32 size) {
+	const byte *input = (const byte *)data;
+	_total += size;
+
+	// Complete the stripe of 32 bytes left over from the previous call
+	if (_buffered) {
+		const uint32 fill = MIN<uint32>(32 - _buffered, size);
+		memcpy(_buffer + _buffered, input, fill);
+		_buffered += fill;
+		input += fill;
+		size -= fill;
+
+		if (_buffered < 32)
+			return;
+
+		for (int i = 0; i < 4; i++)
+			_acc[i] = round64(_acc[i], READ_LE_UINT64(_buffer + i * 8));
+		_buffered = 0;
+	}
+
+	uint64 acc0 = _acc[0], acc1 = _acc[1], acc2 = _acc[2], acc3 = _acc[3];
+	for (; size >= 32; size -= 32, input += 32) {
+		acc0 = round64(acc0, READ_LE_UINT64(input));
+		acc1 = round64(acc1, READ_LE_UINT64(input + 8));
+		acc2 = round64(acc2, READ_LE_UINT64(input + 16));
+		acc3 = round64(acc3, READ_LE_UINT64(input + 24));
+	}
+	_acc[0] = acc0;
+	_acc[1] = acc1;
+	_acc[2] = acc2;
+	_acc[3] = acc3;
+
+	memcpy(_buffer, input, size);
+	_buffered = size;
+}
+
+uint64 XXHash64::finish() const {
+	uint64 hash;
+	if (_total >= 32) {
+		hash = rotl64(_acc[0], 1) + rotl64(_acc[1], 7) + rotl64(_acc[2], 12) + rotl64(_acc[3], 18);
+		for (int i = 0; i < 4; i++)
+			hash = mergeRound64(hash, _acc[i]);
+	} else {
+		hash = _seed + kPrime5;
+	}
+
+	hash += _total;
+
+	const byte *input = _buffer;
+	uint32 size = _buffered;
+	for (; size >= 8; size -= 8, input += 8)
+		hash = rotl64(hash ^ round64(0, READ_LE_UINT64(input)), 27) * kPrime1 + kPrime4;
+
+	if (size >= 4) {
+		hash = rotl64(hash ^ (READ_LE_UINT32(input) * kPrime1), 23) * kPrime2 + kPrime3;
+		size -= 4;
+		input += 4;
+	}
+
+	for (; size > 0; size--, input++)
+		hash = rotl64(hash ^ (*input * kPrime5), 11) * kPrime1;
+
+	hash ^= hash >> 33;
+	hash *= kPrime2;
+	hash ^= hash >> 29;
+	hash *= kPrime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+uint64 computeXXHash64(const void *data, uint32 size, uint64 seed) {
+	XXHash64 hash(seed);
+	hash.update(data, size);
+	return hash.finish();
+}
+
+uint64 computeStreamXXHash64(ReadStream &stream, uint32 length) {
+	XXHash64 hash;
+	byte buf[4096];
+	bool restricted = (length != 0);
+	uint32 readlen = (!restricted || sizeof(buf) <= length) ? sizeof(buf) : length;
+	uint32 i;
+
+	while ((i = stream.read(buf, readlen)) > 0) {
+		hash.update(buf, i);
+
+		if (restricted) {
+			length -= i;
+			if (length == 0)
+				break;
+
+			if (sizeof(buf) > length)
+				readlen = length;
+		}
+	}
+
+	return hash.finish();
+}
+
+} // End of namespace Common
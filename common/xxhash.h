@@ -0,0 +1,89 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_XXHASH_H
+#define COMMON_XXHASH_H
+
+#include "common/scummsys.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_xxhash xxHash checksum
+ * @ingroup common
+ *
+ * @brief API for computing the 64-bit xxHash checksum.
+ *
+ * @{
+ */
+
+class ReadStream;
+
+/**
+ * Incremental computation of the 64-bit xxHash (XXH64) of some data.
+ *
+ * XXH64 is not a cryptographic hash, but it is several times faster than
+ * MD5, which makes it a better choice for checking the integrity of large
+ * files or buffers where the checksums are not compared with MD5s known
+ * from elsewhere.
+ */
+class XXHash64 {
+public:
+	explicit XXHash64(uint64 seed = 0);
+
+	/** Add data to hash. */
+	void update(const void *data, uint32 size);
+
+	/** Return the hash of all the data added so far. */
+	uint64 finish() const;
+
+private:
+	uint64 _acc[4];
+	uint64 _seed;
+	uint64 _total;
+	byte _buffer[32];
+	uint32 _buffered;
+};
+
+/**
+ * Compute the XXH64 checksum of a block of memory.
+ * @param[in] data	the data to hash
+ * @param[in] size	the size of the data
+ * @param[in] seed	the seed of the hash
+ * @return the checksum
+ */
+uint64 computeXXHash64(const void *data, uint32 size, uint64 seed = 0);
+
+/**
+ * Compute the XXH64 checksum of the content of the given ReadStream.
+ * If length is set to a positive value, then only the first length
+ * bytes of the stream are used to compute the checksum.
+ * @param[in] stream	the stream of whose data the checksum is computed
+ * @param[in] length	the number of bytes for which to compute the checksum; 0 means all
+ * @return the checksum
+ */
+uint64 computeStreamXXHash64(ReadStream &stream, uint32 length = 0);
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -256,8 +256,11 @@ DetectedGames AdvancedMetaEngineDetection::detectGames(const Common::FSList &fsl
 	// Compose a hashmap of all files in fslist.
 	composeFileHashMap(allFiles, fslist, (_maxScanDepth == 0 ? 1 : _maxScanDepth));
 
-	// Run the detector on this
-	ADDetectedGames matches = detectGame(fslist.begin()->getParent(), allFiles, Common::UNK_LANG, Common::kPlatformUnknown, "", skipADFlags, skipIncomplete);
+	// Run the detector on this, unless none of the detection entries can
+	// match. The fallback detector still gets to look at the files.
+	ADDetectedGames matches;
+	if (mayContainKnownGames(fslist))
+		matches = detectGame(fslist.begin()->getParent(), allFiles, Common::UNK_LANG, Common::kPlatformUnknown, "", skipADFlags, skipIncomplete);
 
 	cleanupPirated(matches);
 
@@ -413,6 +416,7 @@ Common::Error AdvancedMetaEngineDetection::createInstance(OSystem *syst, Engine
 
 	// Detection is done, no need to keep archives in memory anymore
 	ADCacheMan.clearArchives();
+	ADCacheMan.savePersistentCache();
 
 	// If the GUI options were updated, we catch this here and update them in the users config
 	// file transparently.
@@ -517,6 +521,109 @@ namespace Common {
 	DECLARE_SINGLETON(AdvancedDetectorCacheManager);
 }
 
+// Bump this whenever the way MD5s are computed changes
+#define PERSISTENT_CACHE_HEADER "ScummVM detection MD5 cache 1"
+
+// Above this, entries of files not seen during this session are dropped
+static const uint kMaxPersistentCacheEntries = 20000;
+
+Common::Path AdvancedDetectorCacheManager::getPersistentCachePath() {
+	Common::Path configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+
+	return configFile.getParent().appendComponent("detection-md5.cache");
+}
+
+void AdvancedDetectorCacheManager::loadPersistentCache() {
+	persistentLoaded = true;
+
+	Common::FSNode node(getPersistentCachePath());
+	Common::ScopedPtr<Common::SeekableReadStream> stream(node.exists() ? node.createReadStream() : nullptr);
+	if (!stream || stream->readLine() != PERSISTENT_CACHE_HEADER)
+		return;
+
+	// Each line holds the MD5, its size, the file size and time and the key
+	while (!stream->eos() && !stream->err()) {
+		Common::String line = stream->readLine();
+		Common::StringTokenizer tok(line, "\t");
+
+		PersistentEntry entry;
+		entry.md5 = tok.nextToken();
+		entry.size = (int64)tok.nextToken().asUint64();
+		entry.fileSize = (int64)tok.nextToken().asUint64();
+		entry.fileTime = (int64)tok.nextToken().asUint64();
+		entry.used = false;
+
+		Common::String key = tok.nextToken();
+		if (key.empty() || !tok.empty())
+			continue;
+
+		persistentHashMap.setVal(key, entry);
+	}
+
+	debugC(2, kDebugGlobalDetection, "Loaded %d entries from the persistent MD5 cache", persistentHashMap.size());
+}
+
+bool AdvancedDetectorCacheManager::getPersistentMD5(const Common::String &key, int64 fileSize, int64 fileTime, Common::String &md5, int64 &size) {
+	if (!persistentLoaded)
+		loadPersistentCache();
+
+	PersistentHashMap::iterator entry = persistentHashMap.find(key);
+	if (entry == persistentHashMap.end() || entry->_value.fileSize != fileSize || entry->_value.fileTime != fileTime)
+		return false;
+
+	entry->_value.used = true;
+	md5 = entry->_value.md5;
+	size = entry->_value.size;
+	return true;
+}
+
+void AdvancedDetectorCacheManager::setPersistentMD5(const Common::String &key, int64 fileSize, int64 fileTime, const Common::String &md5, int64 size) {
+	if (!persistentLoaded)
+		loadPersistentCache();
+
+	PersistentEntry &entry = persistentHashMap.getOrCreateVal(key);
+	entry.fileSize = fileSize;
+	entry.fileTime = fileTime;
+	entry.md5 = md5;
+	entry.size = size;
+	entry.used = true;
+	persistentDirty = true;
+}
+
+void AdvancedDetectorCacheManager::savePersistentCache() {
+	if (!persistentDirty)
+		return;
+
+	persistentDirty = false;
+
+	if (persistentHashMap.size() > kMaxPersistentCacheEntries) {
+		PersistentHashMap::iterator entry = persistentHashMap.begin();
+		while (entry != persistentHashMap.end()) {
+			PersistentHashMap::iterator next = entry;
+			++next;
+			if (!entry->_value.used)
+				persistentHashMap.erase(entry);
+			entry = next;
+		}
+	}
+
+	Common::FSNode node(getPersistentCachePath());
+	Common::ScopedPtr<Common::WriteStream> stream(node.createWriteStream());
+	if (!stream) {
+		debugC(2, kDebugGlobalDetection, "Could not write the persistent MD5 cache");
+		return;
+	}
+
+	stream->writeString(PERSISTENT_CACHE_HEADER "\n");
+	for (PersistentHashMap::const_iterator entry = persistentHashMap.begin(); entry != persistentHashMap.end(); ++entry) {
+		stream->writeString(Common::String::format("%s\t%lld\t%lld\t%lld\t%s\n", entry->_value.md5.c_str(),
+			(long long)entry->_value.size, (long long)entry->_value.fileSize, (long long)entry->_value.fileTime, entry->_key.c_str()));
+	}
+	stream->finalize();
+}
+
 
 static MD5Properties gameFileToMD5Props(const ADGameFileDescription *fileEntry, uint32 gameFlags) {
 	MD5Properties ret = kMD5Head;
@@ -581,12 +688,18 @@ Common::String md5PropToGameFile(MD5Properties flags) {
 
 static bool getFilePropertiesIntern(uint md5Bytes, const AdvancedMetaEngine::FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps);
 
-bool AdvancedMetaEngineDetection::getFileProperties(const FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps) const {
+static Common::String md5CacheName(MD5Properties md5prop, const Common::Path &fname, uint md5Bytes) {
 	Common::String hashname = md5PropToCachePrefix(md5prop);
 		hashname += ':';
 		hashname += fname.toString('/');
 		hashname += ':';
-		hashname += Common::String::format("%d", _md5Bytes);
+		hashname += Common::String::format("%d", md5Bytes);
+
+	return hashname;
+}
+
+bool AdvancedMetaEngineDetection::getFileProperties(const FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps) const {
+	Common::String hashname = md5CacheName(md5prop, fname, _md5Bytes);
 
 	if (ADCacheMan.containsMD5(hashname)) {
 		fileProps.md5 = ADCacheMan.getMD5(hashname);
@@ -594,16 +707,144 @@ bool AdvancedMetaEngineDetection::getFileProperties(const FileMap &allFiles, MD5
 		return true;
 	}
 
+	// Files on disk, or inside an archive on disk, can also be found in the
+	// persistent cache under their absolute path. Mac forks are skipped, as
+	// they may be stored in other files than the one matched.
+	Common::String persistentKey;
+	int64 fileSize, fileTime;
+	if (!(md5prop & (kMD5MacResFork | kMD5MacDataFork))) {
+		Common::Path diskName(fname);
+		if (md5prop & kMD5Archive) {
+			Common::StringTokenizer tok(fname.toString(), ":");
+			tok.nextToken();
+			diskName = Common::Path(tok.nextToken());
+		}
+
+		if (allFiles.contains(diskName) && allFiles[diskName].getFileStats(fileSize, fileTime)) {
+			persistentKey = hashname;
+			persistentKey += ':';
+			persistentKey += allFiles[diskName].getPath().toString(Common::Path::kNativeSeparator);
+
+			if (ADCacheMan.getPersistentMD5(persistentKey, fileSize, fileTime, fileProps.md5, fileProps.size)) {
+				fileProps.md5prop = (MD5Properties)(md5prop & kMD5Tail);
+				ADCacheMan.setMD5(hashname, fileProps.md5);
+				ADCacheMan.setSize(hashname, fileProps.size);
+				return true;
+			}
+		}
+	}
+
 	bool res = getFilePropertiesIntern(_md5Bytes, allFiles, md5prop, fname, fileProps);
 
 	if (res) {
 		ADCacheMan.setMD5(hashname, fileProps.md5);
 		ADCacheMan.setSize(hashname, fileProps.size);
+
+		if (!persistentKey.empty())
+			ADCacheMan.setPersistentMD5(persistentKey, fileSize, fileTime, fileProps.md5, fileProps.size);
 	}
 
 	return res;
 }
 
+namespace {
+
+struct PrefetchedFile {
+	Common::String hashname;
+	Common::String persistentKey;
+	Common::FSNode node;
+	bool tail;
+	int64 fileSize;
+	int64 fileTime;
+};
+
+} // End of anonymous namespace
+
+void AdvancedMetaEngineDetection::prefetchFileProperties(const FileMap &allFiles) const {
+	// Only plain files on disk are hashed here. Mac forks and archive
+	// members are left to getFileProperties().
+	Common::Array<PrefetchedFile> pending;
+	Common::HashMap<Common::String, bool> seen;
+
+	for (const byte *descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize) {
+		const ADGameDescription *g = (const ADGameDescription *)descPtr;
+
+		for (const ADGameFileDescription *fileDesc = g->filesDescriptions; fileDesc->fileName; fileDesc++) {
+			MD5Properties md5prop = gameFileToMD5Props(fileDesc, g->flags);
+			if (md5prop & (kMD5MacResFork | kMD5MacDataFork | kMD5Archive))
+				continue;
+
+			Common::Path fname(fileDesc->fileName);
+			if (!allFiles.contains(fname))
+				continue;
+
+			Common::String hashname = md5CacheName(md5prop, fname, _md5Bytes);
+			if (seen.contains(hashname) || ADCacheMan.containsMD5(hashname))
+				continue;
+			seen[hashname] = true;
+
+			PrefetchedFile file;
+			file.hashname = hashname;
+			file.node = allFiles[fname];
+			file.tail = (md5prop & kMD5Tail) != 0;
+
+			if (file.node.getFileStats(file.fileSize, file.fileTime)) {
+				file.persistentKey = hashname;
+				file.persistentKey += ':';
+				file.persistentKey += file.node.getPath().toString(Common::Path::kNativeSeparator);
+
+				Common::String md5;
+				int64 size;
+				if (ADCacheMan.getPersistentMD5(file.persistentKey, file.fileSize, file.fileTime, md5, size)) {
+					ADCacheMan.setMD5(hashname, md5);
+					ADCacheMan.setSize(hashname, size);
+					continue;
+				}
+			}
+
+			pending.push_back(file);
+		}
+	}
+
+	// Open a limited number of files at a time
+	const uint kMaxOpenFiles = 16;
+
+	for (uint first = 0; first < pending.size(); first += kMaxOpenFiles) {
+		const uint count = MIN<uint>(kMaxOpenFiles, pending.size() - first);
+		Common::File *files[kMaxOpenFiles];
+		Common::String md5s[kMaxOpenFiles];
+
+		for (uint i = 0; i < count; i++) {
+			files[i] = new Common::File();
+			if (!files[i]->open(pending[first + i].node)) {
+				delete files[i];
+				files[i] = nullptr;
+				continue;
+			}
+
+			if (pending[first + i].tail && files[i]->size() > _md5Bytes)
+				files[i]->seek(-(int64)_md5Bytes, SEEK_END);
+		}
+
+		Common::computeStreamsMD5AsString((Common::ReadStream *const *)files, md5s, count, _md5Bytes);
+
+		for (uint i = 0; i < count; i++) {
+			if (!files[i])
+				continue;
+
+			const PrefetchedFile &file = pending[first + i];
+			const int64 size = files[i]->size();
+			ADCacheMan.setMD5(file.hashname, md5s[i]);
+			ADCacheMan.setSize(file.hashname, size);
+
+			if (!file.persistentKey.empty())
+				ADCacheMan.setPersistentMD5(file.persistentKey, file.fileSize, file.fileTime, md5s[i], size);
+
+			delete files[i];
+		}
+	}
+}
+
 bool AdvancedMetaEngine::getFilePropertiesExtern(uint md5Bytes, const FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps) const {
 	return getFilePropertiesIntern(md5Bytes, allFiles, md5prop, fname, fileProps);
 }
@@ -774,6 +1015,7 @@ ADDetectedGames AdvancedMetaEngineDetection::detectGame(const Common::FSNode &pa
 	debugC(3, kDebugGlobalDetection, "Starting detection for engine '%s' in dir '%s'", getName(), parent.getPath().toString(Common::Path::kNativeSeparator).c_str());
 
 	preprocessDescriptions();
+	prefetchFileProperties(allFiles);
 
 	// Check which files are included in some ADGameDescription *and* whether
 	// they are present. Compute MD5s and file sizes for the available files.
@@ -1018,6 +1260,7 @@ AdvancedMetaEngineDetection::AdvancedMetaEngineDetection(const void *descs, uint
 	_fullPathGlobsDepth = 5;
 
 	_hashMapsInited = false;
+	_useFingerprints = true;
 
 	for (auto f = grayList; *f; f++)
 		_grayListMap.setVal(*f, true);
@@ -1077,6 +1320,8 @@ void AdvancedMetaEngineDetection::preprocessDescriptions() {
 			}
 		}
 
+		addFingerprint(g);
+
 		// Check if the detection entry have only files from the blacklist
 		if (isEntryGrayListed(g)) {
 			debug(0, "WARNING: Detection entry for '%s:%s' contains only blacklisted names. Add more files to the entry (%s)",
@@ -1090,6 +1335,68 @@ void AdvancedMetaEngineDetection::preprocessDescriptions() {
 #endif
 }
 
+void AdvancedMetaEngineDetection::addFingerprint(const ADGameDescription *g) {
+	// An entry only matches when all of its files are present, so its first
+	// file is enough to tell whether it could be in a directory
+	const ADGameFileDescription *fileDesc = g->filesDescriptions;
+	if (!fileDesc->fileName) {
+		_useFingerprints = false;
+		return;
+	}
+
+	Common::String fname = fileDesc->fileName;
+	MD5Properties md5prop = gameFileToMD5Props(fileDesc, g->flags);
+
+	if (md5prop & kMD5Archive) {
+		Common::StringTokenizer tok(fname, ":");
+		tok.nextToken();
+		fname = tok.nextToken();
+	}
+
+	// Files in subdirectories are found through the directory globs
+	if (fname.contains('/'))
+		return;
+
+	if (fname.empty() || fname.contains(':')) {
+		_useFingerprints = false;
+		return;
+	}
+
+	_fingerprintMap.setVal(fname, true);
+
+	// Resource forks may be stored next to the file. Keep this in sync
+	// with MacResManager::open().
+	if (md5prop & (kMD5MacResFork | kMD5MacDataFork)) {
+		_fingerprintMap.setVal(fname + ".rsrc", true);
+		_fingerprintMap.setVal(fname + ".bin", true);
+		_fingerprintMap.setVal("._" + fname, true);
+		_fingerprintMap.setVal("__MACOSX", true);
+	}
+}
+
+bool AdvancedMetaEngineDetection::mayContainKnownGames(const Common::FSList &fslist) const {
+	if (!_useFingerprints)
+		return true;
+
+	for (Common::FSList::const_iterator file = fslist.begin(); file != fslist.end(); ++file) {
+		Common::String efname = Common::punycode_encodefilename(file->getName());
+
+		if (file->isDirectory()) {
+			if (_globsMap.contains(efname) || _fingerprintMap.contains(efname))
+				return true;
+			continue;
+		}
+
+		if (efname.lastChar() == '.')
+			efname.deleteLastChar();
+
+		if (_fingerprintMap.contains(efname))
+			return true;
+	}
+
+	return false;
+}
+
 Common::StringArray AdvancedMetaEngineDetection::getPathsFromEntry(const ADGameDescription *g) {
 	Common::StringArray result;
 	Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> unique;
@@ -424,12 +424,23 @@ private:
 	void preprocessDescriptions();
 	bool isEntryGrayListed(const ADGameDescription *g) const;
 	void detectClashes() const;
+	void addFingerprint(const ADGameDescription *g);
+	bool mayContainKnownGames(const Common::FSList &fslist) const;
 
 private:
 	Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _grayListMap;
 	Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _globsMap;
 	bool _hashMapsInited;
 
+	/**
+	 * Names of top level files or directories, one of which has to be present
+	 * for any of the detection entries to match. Only used while
+	 * _useFingerprints is set, which is not the case when some entries cannot
+	 * be summarized this way.
+	 */
+	Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _fingerprintMap;
+	bool _useFingerprints;
+
 protected:
 	/**
 	 * Detect games in the specified directory.
@@ -469,6 +480,13 @@ protected:
 	 */
 	void composeFileHashMap(FileMap &allFiles, const Common::FSList &fslist, int depth, const Common::Path &parentName = Common::Path()) const;
 
+	/**
+	 * Compute the MD5s of the files on disk named by the game descriptions,
+	 * several files at a time, and store them in the cache where
+	 * getFileProperties() finds them.
+	 */
+	void prefetchFileProperties(const FileMap &allFiles) const;
+
 	/** Get the properties (size and MD5) of this file. */
 	bool getFileProperties(const FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps) const;
 
@@ -572,6 +590,12 @@ protected:
 
 /**
  * Singleton Cache Storage for Computed MD5s and Open Archives
+ *
+ * Besides the per-run cache, which is cleared before each detection, the
+ * MD5s of files on disk are kept in a persistent cache stored next to the
+ * config file, so that detecting an unchanged game again does not need to
+ * read it. Its entries are tied to the size and the modification time of
+ * the file they were computed from.
  */
 class AdvancedDetectorCacheManager : public Common::Singleton<AdvancedDetectorCacheManager> {
 public:
@@ -612,7 +636,23 @@ public:
 		return archiveHashMap.getValOrDefault(node.getPath(), nullptr);
 	}
 
-	AdvancedDetectorCacheManager() {
+	/**
+	 * Look up the MD5 of a file in the persistent cache.
+	 *
+	 * @param key       Absolute path of the file along with the way its MD5 was computed.
+	 * @param fileSize  Current size of the file on disk.
+	 * @param fileTime  Current modification time of the file on disk.
+	 * @param md5       The MD5 is stored here.
+	 * @param size      The size of the hashed data is stored here.
+	 * @return True if there is an entry for the current version of the file.
+	 */
+	bool getPersistentMD5(const Common::String &key, int64 fileSize, int64 fileTime, Common::String &md5, int64 &size);
+	void setPersistentMD5(const Common::String &key, int64 fileSize, int64 fileTime, const Common::String &md5, int64 size);
+
+	/** Write the persistent cache to disk if it was modified since it was loaded. */
+	void savePersistentCache();
+
+	AdvancedDetectorCacheManager() : persistentLoaded(false), persistentDirty(false) {
 		clear();
 	}
 
@@ -638,6 +678,22 @@ private:
 	FileHashMap md5HashMap;
 	SizeHashMap sizeHashMap;
 	ArchiveHashMap archiveHashMap;
+
+	struct PersistentEntry {
+		int64 fileSize;
+		int64 fileTime;
+		Common::String md5;
+		int64 size;
+		bool used;
+	};
+
+	typedef Common::HashMap<Common::String, PersistentEntry> PersistentHashMap;
+	PersistentHashMap persistentHashMap;
+	bool persistentLoaded;
+	bool persistentDirty;
+
+	void loadPersistentCache();
+	static Common::Path getPersistentCachePath();
 };
 
 /** Convenience shortcut for accessing the MD5CacheManager. */
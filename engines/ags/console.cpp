@@ -25,6 +25,7 @@
 #include "ags/shared/ac/sprite_cache.h"
 #include "ags/shared/gfx/allegro_bitmap.h"
 #include "ags/shared/script/cc_common.h"
+#include "ags/engine/script/script_profiler.h"
 #include "image/png.h"
 
 namespace AGS {
@@ -33,8 +34,11 @@ AGSConsole::AGSConsole(AGSEngine *vm) : GUI::Debugger(), _vm(vm), _logOutputTarg
 	registerCmd("ags_debug_groups_list",   WRAP_METHOD(AGSConsole, Cmd_listDebugGroups));
 	registerCmd("ags_debug_groups_set",  WRAP_METHOD(AGSConsole, Cmd_setDebugGroupLevel));
 	registerCmd("ags_set_script_dump", WRAP_METHOD(AGSConsole, Cmd_SetScriptDump));
+	registerCmd("ags_set_script_fast_dispatch", WRAP_METHOD(AGSConsole, Cmd_SetScriptFastDispatch));
+	registerCmd("ags_script_profile", WRAP_METHOD(AGSConsole, Cmd_scriptProfile));
 	registerCmd("ags_sprite_info",   WRAP_METHOD(AGSConsole, Cmd_getSpriteInfo));
 	registerCmd("ags_sprite_dump",  WRAP_METHOD(AGSConsole, Cmd_dumpSprite));
+	registerCmd("ags_sprite_cache", WRAP_METHOD(AGSConsole, Cmd_spriteCache));
 
 	_logOutputTarget = new LogOutputTarget();
 	_agsDebuggerOutput = _GP(DbgMgr).RegisterOutput("ScummVMLog", _logOutputTarget, AGS3::AGS::Shared::kDbgMsg_None);
@@ -184,6 +188,59 @@ bool AGSConsole::Cmd_SetScriptDump(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_SetScriptFastDispatch(int argc, const char **argv) {
+	if (argc != 2) {
+		debugPrintf("Usage: %s [on|off]\n", argv[0]);
+		debugPrintf("Currently %s\n", AGS3::ccGetOption(SCOPT_NOFASTDISPATCH) ? "off" : "on");
+		return true;
+	}
+
+	// When off, the script VM decodes every instruction as it runs it
+	if (strcmp(argv[1], "on") == 0 || strcmp(argv[1], "true") == 0)
+		AGS3::ccSetOption(SCOPT_NOFASTDISPATCH, 0);
+	else
+		AGS3::ccSetOption(SCOPT_NOFASTDISPATCH, 1);
+	return true;
+}
+
+bool AGSConsole::Cmd_scriptProfile(int argc, const char **argv) {
+	AGS3::ScriptProfiler &profiler = _GP(scriptProfiler);
+	int count = 20;
+	if (argc == 2) {
+		if (strcmp(argv[1], "on") == 0) {
+			profiler.SetEnabled(true);
+			debugPrintf("Script profiling enabled\n");
+			return true;
+		} else if (strcmp(argv[1], "off") == 0) {
+			profiler.SetEnabled(false);
+			debugPrintf("Script profiling disabled\n");
+			return true;
+		} else if (strcmp(argv[1], "reset") == 0) {
+			profiler.Reset();
+			debugPrintf("Script profile reset\n");
+			return true;
+		}
+		count = atoi(argv[1]);
+	}
+	if (argc > 2 || count <= 0) {
+		debugPrintf("Usage: %s [on | off | reset | <count>]\n", argv[0]);
+		debugPrintf("Without arguments, shows the 20 functions which took most time\n");
+		return true;
+	}
+
+	AGS3::std::vector<const AGS3::ScriptProfiler::Entry *> entries;
+	profiler.GetEntries(entries);
+	debugPrintf("Script profiling is %s, total time %u ms\n", profiler.IsEnabled() ? "on" : "off",
+	            (uint)(profiler.GetTotalTime() / 1000));
+	debugPrintf("%8s %10s %10s  %s\n", "calls", "incl. us", "excl. us", "function");
+	for (size_t i = 0; i < entries.size() && (int)i < count; ++i) {
+		const AGS3::ScriptProfiler::Entry &e = *entries[i];
+		debugPrintf("%8u %10u %10u  %s%s\n", e.Calls, (uint)e.InclusiveTime, (uint)e.ExclusiveTime,
+		            e.Name.GetCStr(), e.Native ? " (native)" : "");
+	}
+	return true;
+}
+
 bool AGSConsole::Cmd_getSpriteInfo(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Usage: %s SpriteNumber\n", argv[0]);
@@ -244,6 +301,33 @@ bool AGSConsole::Cmd_dumpSprite(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_spriteCache(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset") != 0)) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	if (argc == 2) {
+		_GP(spriteset).ResetStats();
+		debugPrintf("Sprite cache statistics reset\n");
+		return true;
+	}
+
+	const AGS3::AGS::Shared::SpriteCache::Stats &stats = _GP(spriteset).GetStats();
+	debugPrintf("Bitmaps: %u / %u KB (%u KB locked)\n",
+	            (uint)(_GP(spriteset).GetCacheSize() / 1024), (uint)(_GP(spriteset).GetMaxCacheSize() / 1024),
+	            (uint)(_GP(spriteset).GetLockedSize() / 1024));
+	debugPrintf("  hits %u, misses %u, evictions %u, prefetched %u\n",
+	            (uint)stats.Hits, (uint)stats.Misses, (uint)stats.Evictions, (uint)stats.Prefetches);
+
+	const AGS3::AGS::Shared::SpriteCache::Stats &comprStats = _GP(spriteset).GetCompressedStats();
+	debugPrintf("Compressed data: %u sprites, %u / %u KB\n", (uint)_GP(spriteset).GetCompressedCacheCount(),
+	            (uint)(_GP(spriteset).GetCompressedCacheSize() / 1024), (uint)(_GP(spriteset).GetMaxCompressedCacheSize() / 1024));
+	debugPrintf("  hits %u, misses %u, evictions %u\n",
+	            (uint)comprStats.Hits, (uint)comprStats.Misses, (uint)comprStats.Evictions);
+	return true;
+}
+
 LogOutputTarget::LogOutputTarget() {
 }
 
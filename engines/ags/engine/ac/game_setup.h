@@ -89,6 +89,7 @@ struct GameSetup {
 	bool  RenderAtScreenRes; // render sprites at screen resolution, as opposed to native one
 	int   Supersampling;
 	size_t SpriteCacheSize = 0u;
+	int   CompressedSpriteCacheSize = -1; // in bytes, 0 disables, -1 keeps the default
 	bool  clear_cache_on_room_change; // for low-end devices: clear resource caches on room change
 	bool  load_latest_save; // load latest saved game on launch
 	ScreenRotation rotation;
@@ -399,6 +399,38 @@ static void reset_temp_room() {
 }
 
 // forchar = playerchar on NewRoom, or NULL if restore saved game
+static void add_view_loop_sprites(std::vector<sprkey_t> &sprites, int view, int loop) {
+	if (view < 0 || view >= _GP(game).numviews)
+		return;
+	const ViewStruct &vs = _GP(views)[view];
+	if (loop < 0 || loop >= vs.numLoops)
+		return;
+	const ViewLoopNew &vl = vs.loops[loop];
+	for (int i = 0; i < vl.numFrames; ++i)
+		sprites.push_back(vl.frames[i].pic);
+}
+
+// Starts decoding the sprites of the characters and objects which are
+// going to be drawn first in the new room, while the room is getting ready
+static void prefetch_room_sprites() {
+	std::vector<sprkey_t> sprites;
+	for (int i = 0; i < _GP(game).numcharacters; ++i) {
+		const CharacterInfo &chr = _GP(game).chars[i];
+		if ((chr.room != _G(displayed_room)) || !chr.on)
+			continue;
+		add_view_loop_sprites(sprites, chr.view, chr.loop);
+	}
+	for (size_t i = 0; i < _G(croom)->numobj; ++i) {
+		const RoomObject &obj = _G(objs)[i];
+		if (!obj.on)
+			continue;
+		sprites.push_back(obj.num);
+		if (obj.view != RoomObject::NoView)
+			add_view_loop_sprites(sprites, obj.view, obj.loop);
+	}
+	_GP(spriteset).PrefetchSprites(sprites);
+}
+
 void load_new_room(int newnum, CharacterInfo *forchar) {
 
 	debug_script_log("Loading room %d", newnum);
@@ -816,6 +848,8 @@ void load_new_room(int newnum, CharacterInfo *forchar) {
 	}
 	_G(color_map) = nullptr;
 
+	prefetch_room_sprites();
+
 	_G(our_eip) = 209;
 	generate_light_table();
 	update_music_volume();
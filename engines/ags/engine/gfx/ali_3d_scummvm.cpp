@@ -246,21 +246,30 @@ int ScummVMRendererGraphicsDriver::GetCompatibleBitmapFormat(int color_depth) {
 }
 
 IDriverDependantBitmap *ScummVMRendererGraphicsDriver::CreateDDB(int width, int height, int color_depth, bool opaque) {
-	return new ALSoftwareBitmap(width, height, color_depth, opaque);
+	ALSoftwareBitmap *ddb = new ALSoftwareBitmap(width, height, color_depth, opaque);
+	ddb->_version = ++_ddbVersion;
+	return ddb;
 }
 
 IDriverDependantBitmap *ScummVMRendererGraphicsDriver::CreateDDBFromBitmap(Bitmap *bitmap, bool hasAlpha, bool opaque) {
-	return new ALSoftwareBitmap(bitmap, opaque, hasAlpha);
+	ALSoftwareBitmap *ddb = new ALSoftwareBitmap(bitmap, opaque, hasAlpha);
+	ddb->_version = ++_ddbVersion;
+	return ddb;
 }
 
 IDriverDependantBitmap *ScummVMRendererGraphicsDriver::CreateRenderTargetDDB(int width, int height, int color_depth, bool opaque) {
-	return new ALSoftwareBitmap(width, height, color_depth, opaque);
+	ALSoftwareBitmap *ddb = new ALSoftwareBitmap(width, height, color_depth, opaque);
+	ddb->_version = ++_ddbVersion;
+	return ddb;
 }
 
 void ScummVMRendererGraphicsDriver::UpdateDDBFromBitmap(IDriverDependantBitmap *bitmapToUpdate, Bitmap *bitmap, bool hasAlpha) {
 	ALSoftwareBitmap *alSwBmp = (ALSoftwareBitmap *)bitmapToUpdate;
 	alSwBmp->_bmp = bitmap;
 	alSwBmp->_hasAlpha = hasAlpha;
+	// The bitmap is referenced rather than copied, so this call is how we learn
+	// that its pixels were changed, same as hardware renderers do
+	alSwBmp->_version = ++_ddbVersion;
 }
 
 void ScummVMRendererGraphicsDriver::DestroyDDB(IDriverDependantBitmap *bitmap) {
@@ -317,6 +326,7 @@ void ScummVMRendererGraphicsDriver::InitSpriteBatch(size_t index, const SpriteBa
 			(batch.Surface->GetSubOffset() != viewport.GetLT())) {
 			batch.Surface.reset(BitmapHelper::CreateSubBitmap(parent_surf, viewport));
 		}
+		batch.CacheValid = false;
 		batch.Opaque = true;
 		batch.IsParentRegion = true;
 		// Because we sub-bitmap to viewport, render offsets should account for that
@@ -328,7 +338,11 @@ void ScummVMRendererGraphicsDriver::InitSpriteBatch(size_t index, const SpriteBa
 	else {
 		if (!batch.Surface || batch.IsParentRegion || (batch.Surface->GetSize() != Size(src_w, src_h))) {
 			batch.Surface.reset(new Bitmap(src_w, src_h, _srcColorDepth));
+			batch.CacheValid = false;
 		}
+		// Sprites are drawn with the transform's offset
+		if (batch.Transform.X != transform.X || batch.Transform.Y != transform.Y)
+			batch.CacheValid = false;
 		batch.Opaque = false;
 		batch.IsParentRegion = false;
 	}
@@ -395,9 +409,10 @@ void ScummVMRendererGraphicsDriver::RenderToBackBuffer() {
 	for (size_t cur_bat = 0u, last_bat = 0u, cur_spr = 0u; last_bat <= last_batch_to_rend;) {
 		// Test if we are entering this batch (and not continuing after coming back from nested)
 		if (cur_spr <= _spriteBatchRange[cur_bat].first) {
-			const auto &batch = _spriteBatches[cur_bat];
+			auto &batch = _spriteBatches[cur_bat];
+			batch.UseCache = TestBatchCache(batch, cur_bat);
 			// Prepare the transparent surface
-			if (batch.Surface && !batch.Opaque)
+			if (batch.Surface && !batch.Opaque && !batch.UseCache)
 				batch.Surface->ClearTransparent();
 		}
 
@@ -412,7 +427,10 @@ void ScummVMRendererGraphicsDriver::RenderToBackBuffer() {
 
 			_rendSpriteBatch = batch.ID;
 			parent_surf->SetClip(viewport); // CHECKME: this is not exactly correct?
-			if (surface && !batch.IsParentRegion) {
+			if (batch.UseCache) {
+				// Surface already has these sprites drawn from the last frame
+				cur_spr = _spriteBatchRange[cur_bat].second;
+			} else if (surface && !batch.IsParentRegion) {
 				_stageVirtualScreen = surface;
 				cur_spr = RenderSpriteBatch(batch, cur_spr, surface, transform.X, transform.Y);
 			} else {
@@ -455,6 +473,49 @@ void ScummVMRendererGraphicsDriver::RenderToBackBuffer() {
 	ClearDrawLists();
 }
 
+bool ScummVMRendererGraphicsDriver::TestBatchCache(ALSpriteBatch &batch, size_t index) {
+	// Only the batches that own an intermediate surface may keep it between frames:
+	// the parent regions are overdrawn by other batches, and the prepared surfaces
+	// are updated by the engine. Nested batches would draw on our surface too.
+	const auto &range = _spriteBatchRange[index];
+	if (!batch.Surface || batch.IsParentRegion || batch.Opaque ||
+		((index + 1 < _spriteBatchDesc.size()) && (_spriteBatchDesc[index + 1].Parent == index))) {
+		batch.CacheValid = false;
+		return false;
+	}
+
+	bool matches = batch.CacheValid && (batch.CachedSprites.size() == range.second - range.first);
+	bool can_cache = true;
+	batch.CachedSprites.resize(range.second - range.first);
+	for (size_t i = range.first; i < range.second; ++i) {
+		const auto &sprite = _spriteList[i];
+		ALCachedSpriteState state;
+		state.Ddb = sprite.ddb;
+		if (sprite.ddb == nullptr) {
+			// Plugin callbacks may draw anything
+			can_cache = false;
+			break;
+		} else if (sprite.ddb == reinterpret_cast<ALSoftwareBitmap *>(DRAWENTRY_TINT)) {
+			state.X = _tint_red;
+			state.Y = _tint_green;
+			state.Alpha = _tint_blue;
+		} else {
+			state.Version = sprite.ddb->_version;
+			state.X = sprite.x;
+			state.Y = sprite.y;
+			state.Alpha = sprite.ddb->_alpha;
+		}
+		auto &cached = batch.CachedSprites[i - range.first];
+		if (cached != state) {
+			cached = state;
+			matches = false;
+		}
+	}
+
+	batch.CacheValid = can_cache;
+	return can_cache && matches;
+}
+
 size_t ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &batch, size_t from, Bitmap *surface, int surf_offx, int surf_offy) {
 	for (; (from < _spriteList.size()) && (_spriteList[from].node == batch.ID); ++from) {
 		const auto &sprite = _spriteList[from];
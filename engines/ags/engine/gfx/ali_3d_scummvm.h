@@ -78,6 +78,9 @@ public:
 	void SetTint(int /*red*/, int /*green*/, int /*blue*/, int /*tintSaturation*/) override {}
 
 	Bitmap *_bmp = nullptr;
+	// Stamp of the last bitmap assignment, given by the renderer;
+	// unique over all the bitmaps, used to tell when a cached batch is outdated.
+	uint32_t _version = 0u;
 	bool _flipped = false;
 	int _stretchToWidth = 0, _stretchToHeight = 0;
 	int _alpha = 255;
@@ -137,6 +140,21 @@ private:
 
 
 typedef SpriteDrawListEntry<ALSoftwareBitmap> ALDrawListEntry;
+// Describes one draw list entry as it was rendered on a cached batch surface
+struct ALCachedSpriteState {
+	const ALSoftwareBitmap *Ddb = nullptr;
+	uint32_t Version = 0u;
+	int X = 0, Y = 0;
+	int Alpha = 0;
+
+	bool operator==(const ALCachedSpriteState &other) const {
+		return Ddb == other.Ddb && Version == other.Version &&
+			X == other.X && Y == other.Y && Alpha == other.Alpha;
+	}
+	bool operator!=(const ALCachedSpriteState &other) const {
+		return !(*this == other);
+	}
+};
 // Software renderer's sprite batch
 struct ALSpriteBatch {
 	uint32_t ID = 0u;
@@ -151,6 +169,12 @@ struct ALSpriteBatch {
 	bool IsParentRegion = false;
 	// Tells whether the surface is treated as opaque or transparent
 	bool Opaque = false;
+	// Sprites which were last rendered on the intermediate surface;
+	// if they did not change, the surface is reused instead of being redrawn.
+	std::vector<ALCachedSpriteState> CachedSprites;
+	bool CacheValid = false;
+	// Whether the surface kept from the previous frame is used in this one
+	bool UseCache = false;
 };
 typedef std::vector<ALSpriteBatch> ALSpriteBatches;
 
@@ -277,6 +301,8 @@ private:
 	ALSpriteBatches _spriteBatches;
 	// List of sprites to render
 	std::vector<ALDrawListEntry> _spriteList;
+	// Last stamp given to a software bitmap
+	uint32_t _ddbVersion = 0u;
 
 	void InitSpriteBatch(size_t index, const SpriteBatchDesc &desc) override;
 	void ResetAllBatches() override;
@@ -288,6 +314,9 @@ private:
 	void ReleaseDisplayMode();
 	// Renders single sprite batch on the precreated surface
 	size_t RenderSpriteBatch(const ALSpriteBatch &batch, size_t from, Shared::Bitmap *surface, int surf_offx, int surf_offy);
+	// Tests whether the batch's surface still has this frame's sprites drawn
+	// on it from the previous frame, and records the current sprites otherwise
+	bool TestBatchCache(ALSpriteBatch &batch, size_t index);
 
 	void highcolor_fade_in(Bitmap *vs, void(*draw_callback)(), int speed, int targetColourRed, int targetColourGreen, int targetColourBlue);
 	void highcolor_fade_out(Bitmap *vs, void(*draw_callback)(), int speed, int targetColourRed, int targetColourGreen, int targetColourBlue);
@@ -331,6 +331,9 @@ void apply_config(const ConfigTree &cfg) {
 		int cache_size_kb = CfgReadInt(cfg, "misc", "cachemax", DEFAULTCACHESIZE_KB);
 		if (cache_size_kb > 0)
 			_GP(usetup).SpriteCacheSize = cache_size_kb * 1024;
+		int compr_cache_size_kb = CfgReadInt(cfg, "misc", "compressedcachemax", DEFAULTCOMPRCACHESIZE_KB);
+		if (compr_cache_size_kb >= 0)
+			_GP(usetup).CompressedSpriteCacheSize = compr_cache_size_kb * 1024;
 
 		// Mouse options
 		_GP(usetup).mouse_auto_lock = CfgReadBoolInt(cfg, "mouse", "auto_lock");
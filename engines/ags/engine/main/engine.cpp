@@ -525,6 +525,8 @@ int engine_init_sprites() {
 
 	if (_GP(usetup).SpriteCacheSize > 0)
 		_GP(spriteset).SetMaxCacheSize(_GP(usetup).SpriteCacheSize);
+	if (_GP(usetup).CompressedSpriteCacheSize >= 0)
+		_GP(spriteset).SetMaxCompressedCacheSize(_GP(usetup).CompressedSpriteCacheSize);
 	return 0;
 }
 
@@ -81,6 +81,10 @@ static bool play_video(Video::VideoDecoder *decoder, const char *name, int flags
 
 	update_polled_stuff();
 
+	// Decode a few frames ahead on the worker threads, so that slow frames
+	// don't make the video stutter
+	decoder->setDecodeAhead(4);
+
 	decoder->start();
 	while (!SHOULD_QUIT && !decoder->endOfVideo()) {
 		if (decoder->needsUpdate()) {
@@ -29,6 +29,7 @@
 #include "ags/engine/debugging/debug_log.h"
 #include "ags/shared/debugging/out.h"
 #include "ags/engine/script/script.h"
+#include "ags/engine/script/script_profiler.h"
 #include "ags/engine/script/script_runtime.h"
 #include "ags/engine/script/system_imports.h"
 #include "ags/shared/util/bbop.h"
@@ -425,6 +426,13 @@ int ccInstance::CallScriptFunction(const char *funcname, int32_t numargs, const
 	line_number = callStackLineNumber[callStackSize];\
 	_G(currentline) = line_number
 
+// Super-instructions made by DecodeCode() from common pairs of instructions
+enum ScriptFusedOp {
+	kFusedOp_LitToRegPush = CC_NUM_SCCMDS, // LITTOREG + PUSHREG
+	kFusedOp_ReadLocal,                    // LOADSPOFFS + MEMREAD
+	kFusedOp_CompareJump                   // ISEQUAL..LTE + JZ/JNZ
+};
+
 #define MAXNEST 50  // number of recursive function calls allowed
 int ccInstance::Run(int32_t curpc) {
 	pc = curpc;
@@ -451,6 +459,26 @@ int ccInstance::Run(int32_t curpc) {
 	unsigned loopIterations = 0u;      // any loop iterations (needed for timeout test)
 	unsigned loopCheckIterations = 0u; // loop iterations accumulated only if check is enabled
 
+	// The pre-decoded code is skipped when dumping instructions, and may be
+	// disabled to run the reference decoder below
+	const ScriptDecodedCode *decoded = nullptr;
+	if (!write_debug_dump && (ccGetOption(SCOPT_NOFASTDISPATCH) == 0))
+		decoded = codeInst->GetDecodedCode();
+	const ScriptDecodedOp *dop = nullptr;
+
+	// Calls left open by an error or an abort are closed when leaving Run()
+	ScriptProfiler *profiler = _GP(scriptProfiler).IsEnabled() ? &_GP(scriptProfiler) : nullptr;
+	struct ProfilerGuard {
+		ScriptProfiler *Profiler;
+		size_t Depth;
+		~ProfilerGuard() {
+			if (Profiler)
+				Profiler->Unwind(Depth);
+		}
+	} profilerGuard = { profiler, profiler ? profiler->GetDepth() : 0u };
+	if (profiler)
+		profiler->EnterScript(codeInst, curpc);
+
 	const auto timeout = std::chrono::milliseconds(_G(timeoutCheckMs));
 	// NOTE: removed timeout_abort check for now: was working *logically* wrong;
 	//const auto timeout_abort = std::chrono::milliseconds(_G(timeoutAbortMs));
@@ -460,58 +488,20 @@ int ccInstance::Run(int32_t curpc) {
 		if (_G(abort_engine))
 			return -1;
 
-		/*
-		if (!codeInst->ReadOperation(codeOp, pc))
-		{
-		    return -1;
-		}
-		*/
-		/* ReadOperation */
-		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
-
-		if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
-			cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
-			return -1;
-		}
-
-		codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
-		if (pc + codeOp.ArgCount >= codeInst->codesize) {
-			cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
-			return -1;
-		}
-
-		int pc_at = pc + 1;
-		for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
-			char fixup = codeInst->code_fixups[pc_at];
-			if (fixup > 0) {
-				// could be relative pointer or import address
-				/*
-				if (!FixupArgument(code[pc], fixup, codeOp.Args[i]))
-				{
-				    return -1;
-				}
-				*/
-				/* FixupArgument */
-				//=====================================================================
-				switch (fixup) {
-				case FIXUP_GLOBALDATA: {
-					ScriptVariable *gl_var = (ScriptVariable *)codeInst->code[pc_at];
-					codeOp.Args[i].SetGlobalVar(&gl_var->RValue);
-				}
-				break;
-				case FIXUP_FUNCTION:
-					// originally commented -- CHECKME: could this be used in very old versions of AGS?
-					//      code[fixup] += (long)&code[0];
-					// This is a program counter value, presumably will be used as SCMD_CALL argument
-					codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
-					break;
-				case FIXUP_STRING:
-					codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + codeInst->code[pc_at]);
-					break;
-				case FIXUP_IMPORT: {
+		dop = nullptr;
+		if (decoded && ((uint32_t)pc < decoded->OpIndex.size()) && (decoded->OpIndex[pc] >= 0)) {
+			dop = &decoded->Ops[decoded->OpIndex[pc]];
+			codeOp.Instruction.Code         = dop->Code;
+			codeOp.Instruction.InstanceId   = dop->InstanceId;
+			codeOp.ArgCount                 = dop->ArgCount;
+			// Only stack offsets and imports are left to fix up
+			for (int i = 0; dop->DynamicArgs && (i < dop->ArgCount); ++i) {
+				if ((dop->DynamicArgs & (1 << i)) == 0)
+					continue;
+				const int pc_at = pc + 1 + i;
+				if (codeInst->code_fixups[pc_at] == FIXUP_STACK) {
+					codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
+				} else {
 					const ScriptImport *import = _GP(simp).getByIndex(static_cast<uint32_t>(codeInst->code[pc_at]));
 					if (import) {
 						codeOp.Args[i] = import->Value;
@@ -520,28 +510,92 @@ int ccInstance::Run(int32_t curpc) {
 						return -1;
 					}
 				}
-				break;
-				case FIXUP_STACK:
-					codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
+			}
+		} else {
+			// Reference decoder, used when there's no pre-decoded instruction
+			/*
+			if (!codeInst->ReadOperation(codeOp, pc))
+			{
+			    return -1;
+			}
+			*/
+			/* ReadOperation */
+			//=====================================================================
+			codeOp.Instruction.Code         = codeInst->code[pc];
+			codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+			codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
+
+			if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
+				cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
+				return -1;
+			}
+
+			codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
+			if (pc + codeOp.ArgCount >= codeInst->codesize) {
+				cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
+				return -1;
+			}
+
+			int pc_at = pc + 1;
+			for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
+				char fixup = codeInst->code_fixups[pc_at];
+				if (fixup > 0) {
+					// could be relative pointer or import address
+					/*
+					if (!FixupArgument(code[pc], fixup, codeOp.Args[i]))
+					{
+					    return -1;
+					}
+					*/
+					/* FixupArgument */
+					//=====================================================================
+					switch (fixup) {
+					case FIXUP_GLOBALDATA: {
+						ScriptVariable *gl_var = (ScriptVariable *)codeInst->code[pc_at];
+						codeOp.Args[i].SetGlobalVar(&gl_var->RValue);
+					}
 					break;
-				default:
-					cc_error("internal fixup type error: %d", fixup);
-					return -1;
+					case FIXUP_FUNCTION:
+						// originally commented -- CHECKME: could this be used in very old versions of AGS?
+						//      code[fixup] += (long)&code[0];
+						// This is a program counter value, presumably will be used as SCMD_CALL argument
+						codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
+						break;
+					case FIXUP_STRING:
+						codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + codeInst->code[pc_at]);
+						break;
+					case FIXUP_IMPORT: {
+						const ScriptImport *import = _GP(simp).getByIndex(static_cast<uint32_t>(codeInst->code[pc_at]));
+						if (import) {
+							codeOp.Args[i] = import->Value;
+						} else {
+							cc_error("cannot resolve import, key = %ld", codeInst->code[pc_at]);
+							return -1;
+						}
+					}
+					break;
+					case FIXUP_STACK:
+						codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
+						break;
+					default:
+						cc_error("internal fixup type error: %d", fixup);
+						return -1;
+					}
+					/* End FixupArgument */
+					//=====================================================================
+				} else {
+					// should be a numeric literal (int32 or float)
+					codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
 				}
-				/* End FixupArgument */
-				//=====================================================================
-			} else {
-				// should be a numeric literal (int32 or float)
-				codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
 			}
+			/* End ReadOperation */
+			//=====================================================================
 		}
-		/* End ReadOperation */
-		//=====================================================================
 
 		// save the arguments for quick access
-		RuntimeScriptValue &arg1 = codeOp.Args[0];
-		RuntimeScriptValue &arg2 = codeOp.Args[1];
-		RuntimeScriptValue &arg3 = codeOp.Args[2];
+		const RuntimeScriptValue &arg1 = (dop && !(dop->DynamicArgs & 1)) ? dop->Args[0] : codeOp.Args[0];
+		const RuntimeScriptValue &arg2 = (dop && !(dop->DynamicArgs & 2)) ? dop->Args[1] : codeOp.Args[1];
+		const RuntimeScriptValue &arg3 = (dop && !(dop->DynamicArgs & 4)) ? dop->Args[2] : codeOp.Args[2];
 		RuntimeScriptValue &reg1 =
 		    registers[arg1.IValue >= 0 && arg1.IValue < CC_NUM_REGISTERS ? arg1.IValue : 0];
 		RuntimeScriptValue &reg2 =
@@ -633,6 +687,8 @@ int ccInstance::Run(int32_t curpc) {
 			ASSERT_STACK_SIZE(1);
 			RuntimeScriptValue rval = PopValueFromStack();
 			curnest--;
+			if (profiler)
+				profiler->Leave();
 			pc = rval.IValue;
 			if (pc == 0) {
 				returnValue = registers[SREG_AX].IValue;
@@ -749,6 +805,8 @@ int ccInstance::Run(int32_t curpc) {
 			curnest++;
 			thisbase[curnest] = 0;
 			funcstart[curnest] = pc;
+			if (profiler)
+				profiler->EnterScript(codeInst, pc);
 			continue; // continue so that the PC doesn't get overwritten
 		case SCMD_MEMREADB:
 			// Take the data address from reg[MAR] and copy byte to reg[arg1]
@@ -1020,6 +1078,8 @@ int ccInstance::Run(int32_t curpc) {
 
 			RuntimeScriptValue return_value;
 
+			if (profiler)
+				profiler->EnterNative(reg1);
 			if (reg1.Type == kScValPluginFunction) {
 				_GP(GlobalReturnValue).Invalidate();
 				NumberPtr fnResult;
@@ -1061,6 +1121,8 @@ int ccInstance::Run(int32_t curpc) {
 			} else {
 				cc_error("invalid pointer type for function call: %d", reg1.Type);
 			}
+			if (profiler)
+				profiler->Leave();
 
 			if (cc_has_error() || _G(abort_engine)) {
 				return -1;
@@ -1233,6 +1295,45 @@ int ccInstance::Run(int32_t curpc) {
 			if (loopIterationCheckDisabled == 0)
 				loopIterationCheckDisabled++;
 			break;
+		// Fused pairs of instructions, see DecodeCode();
+		// these leave pc and ArgCount at the second instruction
+		case kFusedOp_LitToRegPush: {
+			const ScriptDecodedOp &push = decoded->Ops[decoded->OpIndex[dop->Next]];
+			reg1 = arg2;
+			ASSERT_STACK_SPACE_AVAILABLE(1);
+			PushValueToStack(registers[push.Args[0].IValue]);
+			pc = dop->Next;
+			codeOp.ArgCount = push.ArgCount;
+			break;
+		}
+		case kFusedOp_ReadLocal: {
+			const ScriptDecodedOp &read = decoded->Ops[decoded->OpIndex[dop->Next]];
+			registers[SREG_MAR] = GetStackPtrOffsetRw(arg1.IValue);
+			if (cc_has_error()) {
+				return -1;
+			}
+			registers[read.Args[0].IValue] = registers[SREG_MAR].ReadValue();
+			pc = dop->Next;
+			codeOp.ArgCount = read.ArgCount;
+			break;
+		}
+		case kFusedOp_CompareJump: {
+			const ScriptDecodedOp &jump = decoded->Ops[decoded->OpIndex[dop->Next]];
+			switch (dop->FusedCode) {
+			case SCMD_ISEQUAL: reg1.SetInt32AsBool(reg1 == reg2); break;
+			case SCMD_NOTEQUAL: reg1.SetInt32AsBool(reg1 != reg2); break;
+			case SCMD_GREATER: reg1.SetInt32AsBool(reg1.IValue > reg2.IValue); break;
+			case SCMD_LESSTHAN: reg1.SetInt32AsBool(reg1.IValue < reg2.IValue); break;
+			case SCMD_GTE: reg1.SetInt32AsBool(reg1.IValue >= reg2.IValue); break;
+			case SCMD_LTE: reg1.SetInt32AsBool(reg1.IValue <= reg2.IValue); break;
+			default: break;
+			}
+			pc = dop->Next;
+			codeOp.ArgCount = jump.ArgCount;
+			if (registers[SREG_AX].IsNull() == (jump.Code == SCMD_JZ))
+				pc += jump.Args[0].IValue;
+			break;
+		}
 		default:
 			cc_error("instruction %d is not implemented", codeOp.Instruction.Code);
 			return -1;
@@ -1427,7 +1528,9 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		decoded_code = joined->decoded_code;
 	} else {
+		decoded_code.reset(new ScriptDecodedCode());
 		if (!CreateGlobalVars(scri.get())) {
 			return false;
 		}
@@ -1491,6 +1594,8 @@ void ccInstance::Free() {
 		_G(loadedInstances)[loadedInstanceId] = nullptr;
 
 	if ((flags & INSTF_SHAREDATA) == 0) {
+		if (code && _G(scriptProfiler))
+			_G(scriptProfiler)->ForgetCode(code);
 		nullfree(globaldata);
 		nullfree(code);
 	}
@@ -1512,6 +1617,7 @@ void ccInstance::Free() {
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	decoded_code.reset();
 }
 
 bool ccInstance::ResolveScriptImports(const ccScript *scri) {
@@ -1717,9 +1823,116 @@ bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 		if (import->InstancePtr != nullptr && (code[fixup + 1] & INSTANCE_ID_REMOVEMASK) == SCMD_CALLEXT)
 			code[fixup + 1] = SCMD_CALLAS | (import->InstancePtr->loadedInstanceId << INSTANCE_ID_SHIFT);
 	}
+	// The code has changed, decode it again on the next run
+	if (decoded_code)
+		*decoded_code = ScriptDecodedCode();
 	return true;
 }
 
+const ScriptDecodedCode *ccInstance::GetDecodedCode() {
+	if (!decoded_code)
+		return nullptr;
+	if (!decoded_code->Decoded)
+		DecodeCode(*decoded_code);
+	return decoded_code.get();
+}
+
+static bool IsValidRegisterArg(const ScriptDecodedOp &op, int arg) {
+	return ((op.DynamicArgs & (1 << arg)) == 0) &&
+		(op.Args[arg].IValue >= 0) && (op.Args[arg].IValue < CC_NUM_REGISTERS);
+}
+
+void ccInstance::DecodeCode(ScriptDecodedCode &dc) const {
+	dc.Decoded = true;
+	dc.OpIndex.resize(codesize, -1);
+	dc.Ops.clear();
+	std::vector<int32_t> op_pcs;
+
+	// Decode the instructions in order; if anything unexpected is met,
+	// the rest of the code will be read by the reference decoder in Run()
+	for (int32_t at = 0; at < codesize;) {
+		ScriptDecodedOp op;
+		const intptr_t instr = code[at];
+		op.Code = instr & INSTANCE_ID_REMOVEMASK;
+		op.InstanceId = (instr >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+		if (op.Code < 0 || op.Code >= CC_NUM_SCCMDS)
+			break;
+		op.ArgCount = (*g_commands)[op.Code].ArgCount;
+		if (at + op.ArgCount >= codesize)
+			break;
+
+		bool valid = true;
+		for (int i = 0; i < op.ArgCount; ++i) {
+			const int32_t pc_at = at + 1 + i;
+			switch (code_fixups[pc_at]) {
+			case 0:
+			case FIXUP_FUNCTION:
+				op.Args[i].SetInt32((int32_t)code[pc_at]);
+				break;
+			case FIXUP_GLOBALDATA:
+				op.Args[i].SetGlobalVar(&((ScriptVariable *)code[pc_at])->RValue);
+				break;
+			case FIXUP_STRING:
+				op.Args[i].SetStringLiteral(&strings[0] + code[pc_at]);
+				break;
+			case FIXUP_STACK:
+			case FIXUP_IMPORT:
+				// depend on the stack pointer and on the currently registered imports
+				op.DynamicArgs |= (1 << i);
+				break;
+			default:
+				valid = false;
+				break;
+			}
+		}
+		if (!valid)
+			break;
+
+		dc.OpIndex[at] = dc.Ops.size();
+		dc.Ops.push_back(op);
+		op_pcs.push_back(at);
+		at += op.ArgCount + 1;
+	}
+
+	// Fuse the common pairs; the second instruction keeps its own entry,
+	// in case there's a jump to it
+	for (size_t i = 0; i + 1 < dc.Ops.size(); ++i) {
+		ScriptDecodedOp &first = dc.Ops[i];
+		const ScriptDecodedOp &second = dc.Ops[i + 1];
+		if (first.DynamicArgs || second.DynamicArgs)
+			continue;
+		int32_t fused = 0;
+		switch (first.Code) {
+		case SCMD_LITTOREG:
+			if ((second.Code == SCMD_PUSHREG) && IsValidRegisterArg(first, 0) && IsValidRegisterArg(second, 0))
+				fused = kFusedOp_LitToRegPush;
+			break;
+		case SCMD_LOADSPOFFS:
+			if ((second.Code == SCMD_MEMREAD) && IsValidRegisterArg(second, 0))
+				fused = kFusedOp_ReadLocal;
+			break;
+		case SCMD_ISEQUAL:
+		case SCMD_NOTEQUAL:
+		case SCMD_GREATER:
+		case SCMD_LESSTHAN:
+		case SCMD_GTE:
+		case SCMD_LTE:
+			if (((second.Code == SCMD_JZ) || (second.Code == SCMD_JNZ)) &&
+				IsValidRegisterArg(first, 0) && IsValidRegisterArg(first, 1))
+				fused = kFusedOp_CompareJump;
+			break;
+		default:
+			break;
+		}
+		if (fused) {
+			first.FusedCode = first.Code;
+			first.Code = fused;
+			first.Next = op_pcs[i + 1];
+			++i; // the second instruction can't start another pair
+		}
+	}
+}
+
 /*
 bool ccInstance::ReadOperation(ScriptOperation &op, int32_t at_pc)
 {
@@ -69,6 +69,25 @@ struct ScriptOperation {
 	int                 ArgCount;
 };
 
+// Instruction with its arguments decoded ahead of running the script;
+// arguments which depend on the run time state are fixed up when it runs
+struct ScriptDecodedOp {
+	int32_t             Code = 0;       // instruction code, or one of the fused codes
+	int32_t             InstanceId = 0;
+	int32_t             ArgCount = 0;   // argument count of the (first) instruction
+	int32_t             FusedCode = 0;  // code of the first instruction of a fused pair
+	int32_t             Next = -1;      // pc of the second instruction of a fused pair
+	uint32_t            DynamicArgs = 0;// mask of arguments to fix up at run time
+	RuntimeScriptValue  Args[MAX_SCMD_ARGS];
+};
+
+// Pre-decoded form of the instance's byte-code, shared with its forks
+struct ScriptDecodedCode {
+	bool                          Decoded = false;
+	std::vector<int32_t>          OpIndex; // index in Ops for each code position, or -1
+	std::vector<ScriptDecodedOp>  Ops;
+};
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -100,6 +119,7 @@ struct ccInstance {
 public:
 	typedef std::unordered_map<int32_t, ScriptVariable> ScVarMap;
 	typedef std::shared_ptr<ScVarMap>                   PScVarMap;
+	typedef std::shared_ptr<ScriptDecodedCode>          PDecodedCode;
 public:
 	int32_t flags;
 	PScVarMap globalvars;
@@ -139,6 +159,8 @@ public:
 	int  numimports;
 
 	char *code_fixups;
+	// pre-decoded byte-code, made on the first run
+	PDecodedCode decoded_code;
 
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
@@ -189,6 +211,9 @@ private:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(const ccScript *scri);
+	// Returns the pre-decoded byte-code, decoding it if necessary
+	const ScriptDecodedCode *GetDecodedCode();
+	void    DecodeCode(ScriptDecodedCode &dc) const;
 	//bool    ReadOperation(ScriptOperation &op, int32_t at_pc);
 
 	// Begin executing script starting from the given bytecode index
@@ -0,0 +1,153 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/system.h"
+#include "ags/engine/script/script_profiler.h"
+#include "ags/engine/script/cc_instance.h"
+#include "ags/engine/script/runtime_script_value.h"
+#include "ags/engine/script/system_imports.h"
+#include "ags/shared/script/cc_script.h"
+#include "ags/lib/std/algorithm.h"
+#include "ags/globals.h"
+
+namespace AGS3 {
+
+using namespace AGS::Shared;
+
+void ScriptProfiler::SetEnabled(bool on) {
+	_enabled = on;
+	_stack.clear();
+}
+
+void ScriptProfiler::Reset() {
+	_entries.clear();
+	_addresses.clear();
+	_codes.clear();
+	_stack.clear();
+	_totalTime = 0;
+}
+
+ScriptProfiler::Entry *ScriptProfiler::FindEntry(const String &name, bool native) {
+	Entry &entry = _entries[name];
+	if (entry.Name.IsEmpty()) {
+		entry.Name = name;
+		entry.Native = native;
+	}
+	return &entry;
+}
+
+void ScriptProfiler::EnterScript(const ccInstance *inst, int32_t pc) {
+	const void *addr = &inst->code[pc];
+	AddressMap::iterator it = _addresses.find(addr);
+	if (it != _addresses.end()) {
+		Enter(it->_value);
+		return;
+	}
+
+	// Resolve the function name once, from the script's exports
+	const ccScript *scri = inst->instanceof.get();
+	String name;
+	for (int i = 0; i < scri->numexports; ++i) {
+		const int32_t etype = (scri->export_addr[i] >> 24L) & 0x000ff;
+		const int32_t eaddr = (scri->export_addr[i] & 0x00ffffff);
+		if (etype == EXPORT_FUNCTION && eaddr == pc) {
+			name = String::FromFormat("%s: %s", scri->GetSectionName(pc), scri->exports[i]);
+			break;
+		}
+	}
+	if (name.IsEmpty())
+		name = String::FromFormat("%s: function at %d", scri->GetSectionName(pc), pc);
+
+	Entry *entry = FindEntry(name, false);
+	_addresses[addr] = entry;
+	_codes[addr] = inst->code;
+	Enter(entry);
+}
+
+void ScriptProfiler::EnterNative(const RuntimeScriptValue &fn) {
+	const void *addr = fn.Ptr;
+	AddressMap::iterator it = _addresses.find(addr);
+	if (it != _addresses.end()) {
+		Enter(it->_value);
+		return;
+	}
+
+	String name = _GP(simp).findName(fn);
+	if (name.IsEmpty())
+		name = String::FromFormat("native function %p", addr);
+	Entry *entry = FindEntry(name, true);
+	_addresses[addr] = entry;
+	Enter(entry);
+}
+
+void ScriptProfiler::Enter(Entry *entry) {
+	entry->Calls++;
+	Frame frame;
+	frame.Func = entry;
+	frame.StartTime = g_system->getMicros();
+	frame.ChildTime = 0;
+	_stack.push_back(frame);
+}
+
+void ScriptProfiler::Leave() {
+	if (_stack.empty())
+		return;
+	const Frame frame = _stack.back();
+	_stack.pop_back();
+	const uint64 elapsed = g_system->getMicros() - frame.StartTime;
+	// NOTE: recursive calls add their time to the inclusive time again
+	frame.Func->InclusiveTime += elapsed;
+	frame.Func->ExclusiveTime += elapsed - MIN(frame.ChildTime, elapsed);
+	if (_stack.empty())
+		_totalTime += elapsed;
+	else
+		_stack.back().ChildTime += elapsed;
+}
+
+void ScriptProfiler::Unwind(size_t depth) {
+	while (_stack.size() > depth)
+		Leave();
+}
+
+void ScriptProfiler::ForgetCode(const intptr_t *code) {
+	std::vector<const void *> addrs;
+	for (CodeMap::const_iterator it = _codes.begin(); it != _codes.end(); ++it) {
+		if (it->_value == code)
+			addrs.push_back(it->_key);
+	}
+	for (const void *addr : addrs) {
+		_addresses.erase(addr);
+		_codes.erase(addr);
+	}
+}
+
+static bool CompareEntries(const ScriptProfiler::Entry *a, const ScriptProfiler::Entry *b) {
+	return a->ExclusiveTime > b->ExclusiveTime;
+}
+
+void ScriptProfiler::GetEntries(std::vector<const Entry *> &entries) const {
+	entries.clear();
+	for (EntryMap::const_iterator it = _entries.begin(); it != _entries.end(); ++it)
+		entries.push_back(&it->_value);
+	std::sort(entries.begin(), entries.end(), CompareEntries);
+}
+
+} // namespace AGS3
@@ -0,0 +1,104 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+//=============================================================================
+//
+// Aggregated timing of the script functions and of the engine's script API
+// functions called by them.
+//
+//=============================================================================
+
+#ifndef AGS_ENGINE_SCRIPT_SCRIPT_PROFILER_H
+#define AGS_ENGINE_SCRIPT_SCRIPT_PROFILER_H
+
+#include "common/hashmap.h"
+#include "ags/lib/std/vector.h"
+#include "ags/shared/util/string.h"
+#include "ags/shared/util/string_types.h"
+
+namespace AGS3 {
+
+struct ccInstance;
+struct RuntimeScriptValue;
+
+class ScriptProfiler {
+public:
+	struct Entry {
+		AGS::Shared::String Name;
+		bool     Native = false;      // engine or plugin function
+		uint32_t Calls = 0;
+		uint64   InclusiveTime = 0;   // in microseconds, including the called functions
+		uint64   ExclusiveTime = 0;   // in microseconds, spent in this function only
+	};
+
+	bool IsEnabled() const { return _enabled; }
+	void SetEnabled(bool on);
+	// Clears the collected timings
+	void Reset();
+
+	// Registers a call to the script function starting at the given pc
+	void EnterScript(const ccInstance *inst, int32_t pc);
+	// Registers a call to the engine or plugin function
+	void EnterNative(const RuntimeScriptValue &fn);
+	// Registers return from the last entered function
+	void Leave();
+	// Returns from all the functions entered after the given call depth
+	void Unwind(size_t depth);
+	size_t GetDepth() const { return _stack.size(); }
+	// Forgets the function addresses in the byte-code, which is being deleted
+	void ForgetCode(const intptr_t *code);
+
+	// Gets all the entries, sorted by descending exclusive time
+	void GetEntries(std::vector<const Entry *> &entries) const;
+	uint64 GetTotalTime() const { return _totalTime; }
+
+private:
+	struct Frame {
+		Entry *Func;
+		uint64 StartTime;
+		uint64 ChildTime;
+	};
+
+	void Enter(Entry *entry);
+	Entry *FindEntry(const AGS::Shared::String &name, bool native);
+
+	struct Address_Hash {
+		uint operator()(const void *addr) const {
+			const uint64 val = (uint64)(uintptr)addr;
+			return (uint)(val ^ (val >> 32));
+		}
+	};
+
+	typedef Common::HashMap<AGS::Shared::String, Entry> EntryMap;
+	typedef Common::HashMap<const void *, Entry *, Address_Hash> AddressMap;
+	typedef Common::HashMap<const void *, const intptr_t *, Address_Hash> CodeMap;
+
+	bool _enabled = false;
+	EntryMap _entries;        // by function name
+	AddressMap _addresses;    // code address or native function pointer to entry
+	CodeMap _codes;           // script function address to the byte-code containing it
+	std::vector<Frame> _stack;
+	uint64 _totalTime = 0;    // time spent in the top level calls
+};
+
+} // namespace AGS3
+
+#endif
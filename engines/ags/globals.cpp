@@ -92,6 +92,7 @@
 #include "ags/engine/script/executing_script.h"
 #include "ags/engine/script/non_blocking_script_function.h"
 #include "ags/engine/script/script.h"
+#include "ags/engine/script/script_profiler.h"
 #include "ags/engine/script/system_imports.h"
 #include "ags/lib/std/limits.h"
 #include "ags/plugins/ags_plugin.h"
@@ -365,6 +366,7 @@ Globals::Globals() {
 	// script_runtime.cpp globals
 	Common::fill(_loadedInstances, _loadedInstances + MAX_LOADED_INSTANCES,
 	             (ccInstance *)nullptr);
+	_scriptProfiler = new ScriptProfiler();
 
 	// system_imports.cpp globals
 	_simp = new SystemImports();
@@ -610,6 +612,10 @@ Globals::~Globals() {
 	delete _moduleInstFork;
 	delete _moduleRepExecAddr;
 
+	// script_runtime.cpp globals
+	delete _scriptProfiler;
+	_scriptProfiler = nullptr;
+
 	// system_imports.cpp globals
 	delete _simp;
 	delete _simp_for_plugin;
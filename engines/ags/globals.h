@@ -173,6 +173,7 @@ struct ScriptPosition;
 struct ScriptRegion;
 struct ScriptString;
 struct ScriptSystem;
+class ScriptProfiler;
 struct SOUNDCLIP;
 struct SpeechLipSyncLine;
 struct SpriteListEntry;
@@ -1303,6 +1304,7 @@ public:
 	// after which the interpreter will abort
 	unsigned _maxWhileLoops = 0u;
 	ccInstance *_loadedInstances[MAX_LOADED_INSTANCES];
+	ScriptProfiler *_scriptProfiler;
 
 	/**@}*/
 
@@ -58,6 +58,44 @@ void rotate_scale_coordinates(fixed w, fixed h,
 	ys[br] = ys[tr] + ys[bl] - ys[tl];
 }
 
+/* draw_scanline:
+ *  Draws one scanline of parallelogram_map() when the sprite and the bitmap
+ *  share a pixel format. Reads and writes the surfaces directly instead of
+ *  going through getpixel() and putpixel() for every pixel, but keeps their
+ *  behaviour for coordinates that fall outside either surface.
+ */
+template<typename PixelType>
+static void draw_scanline(BITMAP *bmp, const BITMAP *spr, int y, int x1, int x2,
+						  fixed spr_x, fixed spr_y, fixed spr_dx, fixed spr_dy,
+						  uint32 transColor, uint32 alphaMask) {
+	Graphics::ManagedSurface &dst = **bmp;
+	const Graphics::ManagedSurface &src = **spr;
+	if (y < 0 || y >= dst.h)
+		return;
+	if (x1 < 0) {
+		spr_x += spr_dx * -x1;
+		spr_y += spr_dy * -x1;
+		x1 = 0;
+	}
+	if (x2 >= dst.w)
+		x2 = dst.w - 1;
+
+	PixelType *dstPtr = (PixelType *)dst.getBasePtr(x1, y);
+	const byte *srcPixels = (const byte *)src.getPixels();
+	const int srcPitch = src.pitch;
+	for (int x = x1; x <= x2; ++x, ++dstPtr) {
+		const int sx = spr_x >> 16, sy = spr_y >> 16;
+		spr_x += spr_dx;
+		spr_y += spr_dy;
+		// getpixel() returns -1 outside of the sprite
+		uint32 c = 0xffffffff;
+		if (sx >= 0 && sy >= 0 && sx < src.w && sy < src.h)
+			c = ((const PixelType *)(srcPixels + sy * srcPitch))[sx];
+		if ((c & alphaMask) != transColor)
+			*dstPtr = (PixelType)c;
+	}
+}
+
 /* parallelogram_map:
  *  Worker routine for drawing rotated and/or scaled and/or flipped sprites:
  *  It actually maps the sprite to any parallelogram-shaped area of the
@@ -335,18 +373,32 @@ void parallelogram_map(BITMAP *bmp, const BITMAP *spr, fixed xs[4], fixed ys[4])
 			// draw scanline
 			int r_bmp_x_i = (r_bmp_x_rounded >> 16);
 			int l_bmp_x_i = (l_bmp_x_rounded >> 16);
-			for (; l_bmp_x_i <= r_bmp_x_i; ++l_bmp_x_i) {
-				uint32 c = (uint32)getpixel(spr, l_spr_x_rounded >> 16, l_spr_y_rounded >> 16);
-				if ((c & alphaMask) != transColor) {
-					if (!sameFormat) {
+			if (sameFormat) {
+				switch (bmp->format.bytesPerPixel) {
+				case 1:
+					draw_scanline<uint8>(bmp, spr, bmp_y_i, l_bmp_x_i, r_bmp_x_i, l_spr_x_rounded, l_spr_y_rounded, spr_dx, spr_dy, transColor, alphaMask);
+					break;
+				case 2:
+					draw_scanline<uint16>(bmp, spr, bmp_y_i, l_bmp_x_i, r_bmp_x_i, l_spr_x_rounded, l_spr_y_rounded, spr_dx, spr_dy, transColor, alphaMask);
+					break;
+				case 4:
+					draw_scanline<uint32>(bmp, spr, bmp_y_i, l_bmp_x_i, r_bmp_x_i, l_spr_x_rounded, l_spr_y_rounded, spr_dx, spr_dy, transColor, alphaMask);
+					break;
+				default:
+					break;
+				}
+			} else {
+				for (; l_bmp_x_i <= r_bmp_x_i; ++l_bmp_x_i) {
+					uint32 c = (uint32)getpixel(spr, l_spr_x_rounded >> 16, l_spr_y_rounded >> 16);
+					if ((c & alphaMask) != transColor) {
 						uint8 a, r, g, b;
 						spr->format.colorToARGB(c, a, r, g, b);
 						c = bmp->format.ARGBToColor(a, r, g, b);
+						putpixel(bmp, l_bmp_x_i, bmp_y_i, c);
 					}
-					putpixel(bmp, l_bmp_x_i, bmp_y_i, c);
+					l_spr_x_rounded += spr_dx;
+					l_spr_y_rounded += spr_dy;
 				}
-				l_spr_x_rounded += spr_dx;
-				l_spr_y_rounded += spr_dy;
 			}
 		}
 		// I'm not going to apoligize for this label and its gotos.
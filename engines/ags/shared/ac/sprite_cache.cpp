@@ -62,7 +62,10 @@ namespace Shared {
 
 SpriteCache::SpriteCache(std::vector<SpriteInfo> &sprInfos)
 	: _sprInfos(sprInfos), _maxCacheSize(DEFAULTCACHESIZE_KB * 1024u),
-	_cacheSize(0u), _lockedSize(0u) {
+	_cacheSize(0u), _lockedSize(0u), _cacheCounter("AGS sprite cache"),
+	_maxCompressedSize(DEFAULTCOMPRCACHESIZE_KB * 1024u), _compressedSize(0u),
+	_compressedCounter("AGS compressed sprites"),
+	_prefetchPending(false) {
 }
 
 SpriteCache::~SpriteCache() {
@@ -90,7 +93,30 @@ void SpriteCache::SetMaxCacheSize(size_t size) {
 	_maxCacheSize = size;
 }
 
+size_t SpriteCache::GetCompressedCacheSize() const {
+	return _compressedSize;
+}
+
+size_t SpriteCache::GetMaxCompressedCacheSize() const {
+	return _maxCompressedSize;
+}
+
+size_t SpriteCache::GetCompressedCacheCount() const {
+	return _compressed.size();
+}
+
+void SpriteCache::SetMaxCompressedCacheSize(size_t size) {
+	_maxCompressedSize = size;
+	FreeCompressedMem(0);
+}
+
+void SpriteCache::ResetStats() {
+	_stats = Stats();
+	_compressedStats = Stats();
+}
+
 void SpriteCache::Reset() {
+	CancelPrefetch();
 	_file.Close();
 	// TODO: find out if it's safe to simply always delete _spriteData.Image with array element
 	for (size_t i = 0; i < _spriteData.size(); ++i) {
@@ -102,7 +128,9 @@ void SpriteCache::Reset() {
 	_spriteData.clear();
 	_mru.clear();
 	_cacheSize = 0;
+	_cacheCounter.set(0);
 	_lockedSize = 0;
+	ClearCompressed();
 }
 
 bool SpriteCache::SetSprite(sprkey_t index, Bitmap *sprite, int flags) {
@@ -210,7 +238,13 @@ Bitmap *SpriteCache::operator [] (sprkey_t index) {
 	if (_spriteData[index].IsExternalSprite() || _spriteData[index].IsLocked())
 		return _spriteData[index].Image;
 
+	// Collect the prefetched sprites when either this one or all are ready
+	if (_prefetchPending && (((_spriteData[index].Flags & SPRCACHEFLAG_PREFETCH) != 0) ||
+			g_system->getJobSystem()->isDone(_prefetchGroup)))
+		FinishPrefetch();
+
 	if (_spriteData[index].Image) {
+		_stats.Hits++;
 		// Move to the beginning of the MRU list
 		_mru.splice(_mru.begin(), _mru, _spriteData[index].MruIt);
 	} else {
@@ -257,8 +291,10 @@ void SpriteCache::DisposeOldest() {
 	// NOTE: locked sprites may still occur in MRU list
 	if (!_spriteData[sprnum].IsLocked()) {
 		_cacheSize -= _spriteData[sprnum].Size;
+		_cacheCounter.set(_cacheSize);
 		delete _spriteData[*it].Image;
 		_spriteData[sprnum].Image = nullptr;
+		_stats.Evictions++;
 		SprCacheLog("DisposeOldest: disposed %d, size now %d KB", sprnum, _cacheSize / 1024);
 	}
 	// Remove from the mru list
@@ -278,14 +314,164 @@ void SpriteCache::DisposeAll() {
 		}
 	}
 	_cacheSize = _lockedSize;
+	_cacheCounter.set(_cacheSize);
 	_mru.clear();
 }
 
+void SpriteCache::FreeCompressedMem(size_t space) {
+	while (!_compressedMru.empty() && (_compressedSize + space > _maxCompressedSize)) {
+		auto it = std::prev(_compressedMru.end());
+		const auto sprnum = *it;
+		_compressedSize -= _compressed[sprnum].Data.size();
+		_compressedCounter.set(_compressedSize);
+		_compressed.erase(sprnum);
+		_compressedMru.erase(it);
+		_compressedStats.Evictions++;
+	}
+}
+
+void SpriteCache::ClearCompressed() {
+	_compressed.clear();
+	_compressedMru.clear();
+	_compressedSize = 0;
+	_compressedCounter.set(0);
+}
+
+HError SpriteCache::LoadSpriteImage(sprkey_t index, Bitmap *&image) {
+	if (_maxCompressedSize == 0)
+		return _file.LoadSprite(index, image);
+
+	auto found = _compressed.find(index);
+	if (found != _compressed.end()) {
+		_compressedStats.Hits++;
+		CompressedSprite &spr = found->_value;
+		_compressedMru.splice(_compressedMru.begin(), _compressedMru, spr.MruIt);
+		return _file.LoadSprite(index, spr.Hdr, spr.Data, image);
+	}
+
+	_compressedStats.Misses++;
+	SpriteDatHeader hdr;
+	std::vector<uint8_t> data;
+	HError err = _file.LoadRawData(index, hdr, data);
+	if (!err) {
+		image = nullptr;
+		return err;
+	}
+	err = _file.LoadSprite(index, hdr, data, image);
+	if (image)
+		StoreCompressed(index, hdr, data);
+	return err;
+}
+
+void SpriteCache::StoreCompressed(sprkey_t index, const SpriteDatHeader &hdr, std::vector<uint8_t> &data) {
+	// Only keep the data which is cheaper to hold than the bitmap;
+	// uncompressed sprites are as fast to read from the file.
+	if ((hdr.Compress == kSprCompress_None) || (data.size() > _maxCompressedSize) ||
+			_compressed.contains(index))
+		return;
+	FreeCompressedMem(data.size());
+	CompressedSprite &spr = _compressed[index];
+	spr.Hdr = hdr;
+	spr.Data = std::move(data);
+	spr.MruIt = _compressedMru.insert(_compressedMru.begin(), index);
+	_compressedSize += spr.Data.size();
+	_compressedCounter.set(_compressedSize);
+}
+
+void SpriteCache::PrefetchSprites(const std::vector<sprkey_t> &indexes) {
+	Common::JobSystem *jobs = g_system->getJobSystem();
+	if (jobs->getWorkerCount() == 0)
+		return; // without workers this would only move the decoding earlier
+	if (_prefetchPending)
+		FinishPrefetch();
+
+	// Don't let the prefetched sprites push each other out of the cache
+	size_t budget = (_maxCacheSize - _lockedSize) / 2;
+	for (sprkey_t index : indexes) {
+		if (index < 0 || (size_t)index >= _spriteData.size())
+			continue;
+		SpriteData &spr = _spriteData[index];
+		if (!spr.IsAssetSprite() || spr.Image ||
+				(spr.Flags & (SPRCACHEFLAG_REMAPPED | SPRCACHEFLAG_PREFETCH)) != 0)
+			continue;
+
+		// The file is read here, only the decoding is left to the worker
+		PrefetchItem item;
+		item.Index = index;
+		auto found = _compressed.find(index);
+		if (found != _compressed.end()) {
+			item.Hdr = found->_value.Hdr;
+			item.Data = found->_value.Data;
+		} else if (!_file.LoadRawData(index, item.Hdr, item.Data)) {
+			continue;
+		}
+		if (item.Hdr.BPP == 0 || item.Data.empty())
+			continue;
+		const size_t size = item.Hdr.Width * item.Hdr.Height * item.Hdr.BPP;
+		if (size > budget)
+			break;
+		budget -= size;
+		spr.Flags |= SPRCACHEFLAG_PREFETCH;
+		_prefetchItems.push_back(std::move(item));
+	}
+
+	if (_prefetchItems.empty())
+		return;
+	SprCacheLog("PrefetchSprites: decoding %zu sprites", _prefetchItems.size());
+	_prefetchPending = true;
+	jobs->submit(_prefetchGroup, PrefetchProc, this);
+}
+
+void SpriteCache::PrefetchProc(void *refCon) {
+	SpriteCache *cache = (SpriteCache *)refCon;
+	for (PrefetchItem &item : cache->_prefetchItems)
+		cache->_file.LoadSprite(item.Index, item.Hdr, item.Data, item.Image);
+}
+
+void SpriteCache::FinishPrefetch() {
+	g_system->getJobSystem()->wait(_prefetchGroup);
+	_prefetchPending = false;
+
+	for (PrefetchItem &item : _prefetchItems) {
+		const sprkey_t index = item.Index;
+		SpriteData &spr = _spriteData[index];
+		// The slot may have been changed while the job was running
+		const bool wanted = ((spr.Flags & SPRCACHEFLAG_PREFETCH) != 0) && spr.IsAssetSprite() &&
+			!spr.Image && ((spr.Flags & SPRCACHEFLAG_REMAPPED) == 0);
+		spr.Flags &= ~SPRCACHEFLAG_PREFETCH;
+		if (!wanted || !item.Image) {
+			delete item.Image;
+			continue;
+		}
+		StoreCompressed(index, item.Hdr, item.Data);
+		InitSpriteImage(index, item.Image);
+		spr.MruIt = _mru.insert(_mru.begin(), index);
+		_stats.Prefetches++;
+	}
+	_prefetchItems.clear();
+}
+
+void SpriteCache::CancelPrefetch() {
+	if (!_prefetchPending)
+		return;
+	g_system->getJobSystem()->wait(_prefetchGroup);
+	_prefetchPending = false;
+
+	for (PrefetchItem &item : _prefetchItems) {
+		if ((size_t)item.Index < _spriteData.size())
+			_spriteData[item.Index].Flags &= ~SPRCACHEFLAG_PREFETCH;
+		delete item.Image;
+	}
+	_prefetchItems.clear();
+}
+
 void SpriteCache::Precache(sprkey_t index) {
 	if (index < 0 || (size_t)index >= _spriteData.size())
 		return;
 	if (!_spriteData[index].IsAssetSprite())
 		return; // cannot precache a non-asset sprite
+	if (_prefetchPending)
+		FinishPrefetch();
 
 	soff_t sprSize = 0;
 
@@ -316,9 +502,10 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 	if (index < 0 || (size_t)index >= _spriteData.size())
 		return 0;
 
+	_stats.Misses++;
 	sprkey_t load_index = GetDataIndex(index);
 	Bitmap *image;
-	HError err = _file.LoadSprite(load_index, image);
+	HError err = LoadSpriteImage(load_index, image);
 	if (!image) {
 		Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Warn,
 			"LoadSprite: failed to load sprite %d:\n%s\n - remapping to sprite 0.", index,
@@ -326,7 +513,10 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 		RemapSpriteToSprite0(index);
 		return 0;
 	}
+	return InitSpriteImage(index, image);
+}
 
+size_t SpriteCache::InitSpriteImage(sprkey_t index, Bitmap *image) {
 	// update the stored width/height
 	_sprInfos[index].Width = image->GetWidth();
 	_sprInfos[index].Height = image->GetHeight();
@@ -351,6 +541,7 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 	FreeMem(size);
 	_spriteData[index].Size = size;
 	_cacheSize += size;
+	_cacheCounter.set(_cacheSize);
 	SprCacheLog("Loaded %d, size now %zu KB", index, _cacheSize / 1024);
 	return size;
 }
@@ -407,7 +598,9 @@ HError SpriteCache::InitFile(const String &filename, const String &sprindex_file
 }
 
 void SpriteCache::DetachFile() {
+	CancelPrefetch();
 	_file.Close();
+	ClearCompressed();
 }
 
 } // namespace Shared
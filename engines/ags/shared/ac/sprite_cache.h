@@ -44,6 +44,9 @@
 #include "ags/lib/std/memory.h"
 #include "ags/lib/std/vector.h"
 #include "ags/lib/std/list.h"
+#include "ags/lib/std/map.h"
+#include "common/jobsystem.h"
+#include "common/memusage.h"
 #include "ags/shared/ac/sprite_file.h"
 #include "ags/shared/core/platform.h"
 #include "ags/shared/util/error.h"
@@ -70,6 +73,8 @@ struct SpriteInfo;
 #define SPRCACHEFLAG_REMAPPED       0x02
 // Locked sprites are ones that should not be freed when out of cache space.
 #define SPRCACHEFLAG_LOCKED         0x04
+// Tells that the sprite is being decoded by a prefetch job.
+#define SPRCACHEFLAG_PREFETCH       0x08
 
 // Max size of the sprite cache, in bytes
 #if AGS_PLATFORM_OS_ANDROID || AGS_PLATFORM_OS_IOS
@@ -78,6 +83,9 @@ struct SpriteInfo;
 #define DEFAULTCACHESIZE_KB (128 * 1024)
 #endif
 
+// Max size of the cache of compressed sprite data, in bytes
+#define DEFAULTCOMPRCACHESIZE_KB (DEFAULTCACHESIZE_KB / 4)
+
 struct SpriteInfo;
 
 namespace AGS {
@@ -89,6 +97,14 @@ public:
 	static const sprkey_t MAX_SPRITE_INDEX = INT32_MAX - 1;
 	static const size_t   MAX_SPRITE_SLOTS = INT32_MAX;
 
+	// Lookup statistics of one cache tier
+	struct Stats {
+		size_t Hits = 0;
+		size_t Misses = 0;
+		size_t Evictions = 0;
+		size_t Prefetches = 0;
+	};
+
 	SpriteCache(std::vector<SpriteInfo> &sprInfos);
 	~SpriteCache();
 
@@ -143,6 +159,22 @@ public:
 	void        SubstituteBitmap(sprkey_t index, Shared::Bitmap *);
 	// Sets max cache size in bytes
 	void        SetMaxCacheSize(size_t size);
+	// Returns current size of the compressed sprite data cache, in bytes
+	size_t      GetCompressedCacheSize() const;
+	// Returns maximal size limit of the compressed sprite data cache, in bytes
+	size_t      GetMaxCompressedCacheSize() const;
+	// Sets max compressed sprite data cache size in bytes; 0 disables it
+	void        SetMaxCompressedCacheSize(size_t size);
+	// Returns number of sprites held in the compressed sprite data cache
+	size_t      GetCompressedCacheCount() const;
+	// Gets lookup statistics of the bitmap cache and the compressed data cache
+	const Stats &GetStats() const { return _stats; }
+	const Stats &GetCompressedStats() const { return _compressedStats; }
+	void        ResetStats();
+
+	// Starts decoding the given sprites on a job system worker, so that
+	// they are already in cache when they are drawn for the first time
+	void        PrefetchSprites(const std::vector<sprkey_t> &indexes);
 
 	// Loads (if it's not in cache yet) and returns bitmap by the sprite index
 	Shared::Bitmap *operator[](sprkey_t index);
@@ -150,6 +182,22 @@ public:
 private:
 	// Load sprite from game resource
 	size_t      LoadSprite(sprkey_t index);
+	// Puts the loaded sprite image to the slot, converting it for the engine
+	size_t      InitSpriteImage(sprkey_t index, Shared::Bitmap *image);
+	// Creates the bitmap of a sprite from the file, using the compressed
+	// data cache when possible
+	HError      LoadSpriteImage(sprkey_t index, Shared::Bitmap *&image);
+	// Keep disposing oldest compressed data until that cache has at least the given free space
+	void        FreeCompressedMem(size_t space);
+	// Deletes all compressed sprite data
+	void        ClearCompressed();
+	// Keeps the compressed sprite data if it fits, takes the contents of the vector
+	void        StoreCompressed(sprkey_t index, const SpriteDatHeader &hdr, std::vector<uint8_t> &data);
+	// Waits for the prefetch job and puts the decoded sprites into the cache
+	void        FinishPrefetch();
+	// Waits for the prefetch job and drops its results
+	void        CancelPrefetch();
+	static void PrefetchProc(void *refCon);
 	// Gets the index of a sprite which data is used for the given slot;
 	// in case of remapped sprite this will return the one given sprite is remapped to
 	sprkey_t    GetDataIndex(sprkey_t index);
@@ -188,12 +236,44 @@ private:
 	size_t _maxCacheSize;  // cache size limit
 	size_t _lockedSize;    // size in bytes of currently locked images
 	size_t _cacheSize;     // size in bytes of currently cached images
+	Common::MemoryCounter _cacheCounter; // reports _cacheSize to the mem_usage command
 
 	// MRU list: the way to track which sprites were used recently.
 	// When clearing up space for new sprites, cache first deletes the sprites
 	// that were last time used long ago.
 	std::list<sprkey_t> _mru;
 
+	// Second tier of the cache: compressed data of recently loaded sprites,
+	// as read from the sprite file. When a bitmap was disposed, it can be
+	// decoded from here again without reading the file.
+	struct CompressedSprite {
+		SpriteDatHeader Hdr;
+		std::vector<uint8_t> Data;
+		std::list<sprkey_t>::iterator MruIt;
+	};
+
+	std::unordered_map<sprkey_t, CompressedSprite> _compressed;
+	std::list<sprkey_t> _compressedMru;
+	size_t _maxCompressedSize; // compressed data cache size limit
+	size_t _compressedSize;    // size in bytes of compressed data
+	Common::MemoryCounter _compressedCounter; // reports _compressedSize to the mem_usage command
+
+	Stats _stats;
+	Stats _compressedStats;
+
+	// Sprites which data was read by PrefetchSprites, and which are decoded
+	// on a worker. While the job is pending, it owns the items.
+	struct PrefetchItem {
+		sprkey_t Index = 0;
+		SpriteDatHeader Hdr;
+		std::vector<uint8_t> Data;
+		Shared::Bitmap *Image = nullptr;
+	};
+
+	Common::JobGroup _prefetchGroup;
+	bool _prefetchPending;
+	std::vector<PrefetchItem> _prefetchItems;
+
 	// Initialize the empty sprite slot
 	void        InitNullSpriteParams(sprkey_t index);
 };
@@ -370,6 +370,21 @@ HError SpriteFile::LoadSprite(sprkey_t index, Shared::Bitmap *&sprite) {
 	SpriteDatHeader hdr;
 	ReadSprHeader(hdr, _stream.get(), _version, _compress);
 	if (hdr.BPP == 0) return HError::None(); // empty slot, this is normal
+	HError err = ReadSprite(_stream.get(), index, hdr, sprite);
+	if (sprite)
+		_curPos = index + 1; // mark correct pos
+	return err;
+}
+
+HError SpriteFile::LoadSprite(sprkey_t index, const SpriteDatHeader &hdr, const std::vector<uint8_t> &data, Bitmap *&sprite) const {
+	sprite = nullptr;
+	if (hdr.BPP == 0 || data.empty()) return HError::None(); // empty slot, this is normal
+	MemoryStream mems(&data[0], data.size());
+	return ReadSprite(&mems, index, hdr, sprite);
+}
+
+HError SpriteFile::ReadSprite(Stream *in, sprkey_t index, const SpriteDatHeader &hdr, Bitmap *&sprite) const {
+	sprite = nullptr;
 	int bpp = hdr.BPP, w = hdr.Width, h = hdr.Height;
 	Bitmap *image = BitmapHelper::CreateBitmap(w, h, bpp * 8);
 	if (image == nullptr) {
@@ -384,11 +399,11 @@ HError SpriteFile::LoadSprite(sprkey_t index, Shared::Bitmap *&sprite) {
 	if (pal_bpp > 0) { // read palette if format assumes one
 		switch (pal_bpp) {
 		case 2: for (uint32_t i = 0; i < hdr.PalCount; ++i) {
-			palette[i] = _stream->ReadInt16();
+			palette[i] = in->ReadInt16();
 		}
 			  break;
 		case 4: for (uint32_t i = 0; i < hdr.PalCount; ++i) {
-			palette[i] = _stream->ReadInt32();
+			palette[i] = in->ReadInt32();
 		}
 			  break;
 		default: assert(0); break;
@@ -399,16 +414,16 @@ HError SpriteFile::LoadSprite(sprkey_t index, Shared::Bitmap *&sprite) {
 	// (Optional) Decompress the image data into the temp buffer
 	size_t in_data_size =
 		((_version >= kSprfVersion_StorageFormats) || _compress != kSprCompress_None) ?
-		(uint32_t)_stream->ReadInt32() : (w * h * bpp);
+		(uint32_t)in->ReadInt32() : (w * h * bpp);
 	if (hdr.Compress != kSprCompress_None) {
 		if (in_data_size == 0) {
 			delete image;
 			return new Error(String::FromFormat("LoadSprite: bad compressed data for sprite %d.", index));
 		}
 		switch (hdr.Compress) {
-		case kSprCompress_RLE: rle_decompress(im_data.Buf, im_data.Size, im_data.BPP, _stream.get());
+		case kSprCompress_RLE: rle_decompress(im_data.Buf, im_data.Size, im_data.BPP, in);
 			break;
-		case kSprCompress_LZW: lzw_decompress(im_data.Buf, im_data.Size, im_data.BPP, _stream.get(), in_data_size);
+		case kSprCompress_LZW: lzw_decompress(im_data.Buf, im_data.Size, im_data.BPP, in, in_data_size);
 			break;
 		default: assert(!"Unsupported compression type!"); break;
 		}
@@ -417,12 +432,12 @@ HError SpriteFile::LoadSprite(sprkey_t index, Shared::Bitmap *&sprite) {
 	// Otherwise (no compression) read directly
 	else {
 		switch (im_data.BPP) {
-		case 1: _stream->Read(im_data.Buf, im_data.Size);
+		case 1: in->Read(im_data.Buf, im_data.Size);
 			break;
-		case 2: _stream->ReadArrayOfInt16(
+		case 2: in->ReadArrayOfInt16(
 			reinterpret_cast<int16_t *>(im_data.Buf), im_data.Size / sizeof(int16_t));
 			break;
-		case 4: _stream->ReadArrayOfInt32(
+		case 4: in->ReadArrayOfInt32(
 			reinterpret_cast<int32_t *>(im_data.Buf), im_data.Size / sizeof(int32_t));
 			break;
 		default: assert(0); break;
@@ -434,7 +449,6 @@ HError SpriteFile::LoadSprite(sprkey_t index, Shared::Bitmap *&sprite) {
 	}
 
 	sprite = image;
-	_curPos = index + 1; // mark correct pos
 	return HError::None();
 }
 
@@ -151,12 +151,16 @@ public:
 
 	// Loads an image data and creates a ready bitmap
 	HError      LoadSprite(sprkey_t index, Bitmap *&sprite);
+	// Creates a ready bitmap from the raw sprite element data, as returned by LoadRawData
+	HError      LoadSprite(sprkey_t index, const SpriteDatHeader &hdr, const std::vector<uint8_t> &data, Bitmap *&sprite) const;
 	// Loads a raw sprite element data into the buffer, stores header info separately
 	HError      LoadRawData(sprkey_t index, SpriteDatHeader &hdr, std::vector<uint8_t> &data);
 
 private:
 	// Seek stream to sprite
 	void        SeekToSprite(sprkey_t index);
+	// Reads the sprite element data that follows the header, and creates a ready bitmap
+	HError      ReadSprite(Stream *in, sprkey_t index, const SpriteDatHeader &hdr, Bitmap *&sprite) const;
 
 	// Internal sprite reference
 	struct SpriteRef {
@@ -37,6 +37,7 @@ namespace AGS3 {
 #define SCOPT_LEFTTORIGHT 0x40   // left-to-right operator precedance
 #define SCOPT_OLDSTRINGS  0x80   // allow old-style strings
 #define SCOPT_UTF8        0x100  // UTF-8 text mode
+#define SCOPT_NOFASTDISPATCH 0x200 // run the byte-code without pre-decoding it
 
 extern void ccSetOption(int, int);
 extern int ccGetOption(int);
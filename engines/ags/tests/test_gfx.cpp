@@ -39,11 +39,14 @@ namespace AGS3 {
 namespace GfxDef = AGS::Shared::GfxDef;
 using namespace AGS::Shared;
 
-void Test_GfxSpeed(bool enableSimd, size_t blenderModeStart, size_t blenderModeEnd) {
+// Times the blitting routines with the given set of SIMD backends enabled
+void Test_GfxSpeed(uint simdFlags, size_t blenderModeStart, size_t blenderModeEnd) {
 	uint oldSimdFlags = _G(simd_flags);
-	if (!enableSimd) _G(simd_flags) = AGS3::Globals::SIMD_NONE;
-	if (enableSimd) debug("SIMD optimizations: true\n");
-	else debug("SIMD optmizations: false\n");
+	_G(simd_flags) = simdFlags;
+	debug("SIMD optimizations: %s%s%s%s\n", simdFlags == AGS3::Globals::SIMD_NONE ? "none" : "",
+		(simdFlags & AGS3::Globals::SIMD_NEON) ? "NEON " : "",
+		(simdFlags & AGS3::Globals::SIMD_SSE2) ? "SSE2 " : "",
+		(simdFlags & AGS3::Globals::SIMD_AVX2) ? "AVX2" : "");
 	Bitmap *benchgfx32 = BitmapHelper::CreateBitmap(100, 100, 32);
 	Bitmap *benchgfx16 = BitmapHelper::CreateBitmapCopy(benchgfx32, 16);
 	Bitmap *benchgfx8 = BitmapHelper::CreateBitmap(100, 100, 8);
@@ -51,11 +54,13 @@ void Test_GfxSpeed(bool enableSimd, size_t blenderModeStart, size_t blenderModeE
 	Bitmap *dest16 = BitmapHelper::CreateBitmap(100, 100, 16);
 	Bitmap *dest8 = BitmapHelper::CreateBitmap(100, 100, 8);
 	int benchRuns[] = {1000, 10000, 100000};
-	int blenderModes[] = {kRgbToRgbBlender, kSourceAlphaBlender, kArgbToArgbBlender, kOpaqueBlenderMode, kTintLightBlenderMode};
-	//const char *modeNames[] = {"RGB to RGB", "Source Alpha", "ARGB to ARGB", "Opaque", "Tint with Light"};
+	int blenderModes[] = {kSourceAlphaBlender, kArgbToArgbBlender, kArgbToRgbBlender, kRgbToArgbBlender, kRgbToRgbBlender,
+		kAlphaPreservedBlenderMode, kOpaqueBlenderMode, kAdditiveBlenderMode, kTintBlenderMode, kTintLightBlenderMode};
+	//const char *modeNames[] = {"Source Alpha", "ARGB to ARGB", "ARGB to RGB", "RGB to ARGB", "RGB to RGB", "Alpha Preserved", "Opaque", "Additive", "Tint", "Tint with Light"};
 	Bitmap *destinations[] = {dest32, dest16, dest8};
 	Bitmap *graphics[] = {benchgfx32, benchgfx16, benchgfx8};
 	uint64 time = 0, numIters = 0, timeNotStretched = 0, numItersNotStretched = 0, timeCommon = 0, numItersCommon = 0;
+	uint64 timeTinted = 0, numItersTinted = 0, timeRotated = 0, numItersRotated = 0;
 	//int bpps[] = {32, 16, 8};
 	if (blenderModeEnd >= sizeof(blenderModes) / sizeof(blenderModes[0])) blenderModeEnd = (sizeof(blenderModes) / sizeof(blenderModes[0])) - 1;
 	for (int dest = 0; dest < 3; dest++) {
@@ -76,6 +81,10 @@ void Test_GfxSpeed(bool enableSimd, size_t blenderModeStart, size_t blenderModeE
 						timeCommon += end - start;
 						numItersCommon += benchRuns[runs];
 					}
+					if (mode == kAdditiveBlenderMode || mode == kTintBlenderMode || mode == kTintLightBlenderMode) {
+						timeTinted += end - start;
+						numItersTinted += benchRuns[runs];
+					}
 					time += end - start;
 					//if (runs == 2) debug("exec time (mills): %u\n\n", end - start);
 					//if (runs == 2) debug("Dest: %d bpp, Gfx: %d bpp, Blender: %s, Stretched: true, Iters: %d\n", bpps[dest], bpps[gfx], modeNames[mode], benchRuns[runs]);
@@ -88,12 +97,24 @@ void Test_GfxSpeed(bool enableSimd, size_t blenderModeStart, size_t blenderModeE
 					//if (runs == 2) debug("exec time (mills): %u\n\n", end - start);
 				}
 			}
+			// Rotation does not blend, so it only depends on the pixel formats
+			for (int runs = 0; (size_t)runs < sizeof(benchRuns) / sizeof(int); runs++) {
+				uint32 start = std::chrono::high_resolution_clock::now();
+				for (int i = 0; i < benchRuns[runs]; i++)
+					destinations[dest]->RotateBlt(graphics[gfx], 50, 50, itofix(i % 256));
+				uint32 end = std::chrono::high_resolution_clock::now();
+				timeRotated += end - start;
+				numItersRotated += benchRuns[runs];
+			}
 		}
 	}
 
 	debug("Over all blender modes, pixel formats, and stretching sizes (%f) avg millis per call.", (double)time / (double)numIters);
 	debug("Over all blender modes, pixel formats, but only unstretched (%f) avg millis per call.", (double)timeNotStretched / (double)numItersNotStretched);
 	debug("Over most common blender modes, all pixel formats, but only unstretched (%f) avg millis per call.", (double)timeCommon / (double)numItersCommon);
+	if (numItersTinted)
+		debug("Over additive and tint blender modes, all pixel formats, but only unstretched (%f) avg millis per call.", (double)timeTinted / (double)numItersTinted);
+	debug("Over all pixel formats, rotated (%f) avg millis per call.", (double)timeRotated / (double)numItersRotated);
 	
 	delete benchgfx32;
 	delete benchgfx16;
@@ -102,7 +123,7 @@ void Test_GfxSpeed(bool enableSimd, size_t blenderModeStart, size_t blenderModeE
 	delete dest16;
 	delete dest8;
 
-	if (!enableSimd) _G(simd_flags) = oldSimdFlags;
+	_G(simd_flags) = oldSimdFlags;
 }
 
 void Test_BlenderModes() {
@@ -268,8 +289,13 @@ void Test_Gfx() {
 #if (defined(SCUMMVM_AVX2) || defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)) && defined(SLOW_TESTS)
 	Test_BlenderModes();
 	// This could take a LONG time
-	Test_GfxSpeed(true, kSourceAlphaBlender, kTintLightBlenderMode);
-	Test_GfxSpeed(false, kSourceAlphaBlender, kTintLightBlenderMode);
+	// Compare every available backend against each other and the plain C++ blenders
+	const uint simdBackends[] = {AGS3::Globals::SIMD_AVX2, AGS3::Globals::SIMD_SSE2, AGS3::Globals::SIMD_NEON};
+	for (size_t i = 0; i < ARRAYSIZE(simdBackends); i++) {
+		if (_G(simd_flags) & simdBackends[i])
+			Test_GfxSpeed(simdBackends[i], kSourceAlphaBlender, kTintLightBlenderMode);
+	}
+	Test_GfxSpeed(AGS3::Globals::SIMD_NONE, kSourceAlphaBlender, kTintLightBlenderMode);
 #endif
 }
 
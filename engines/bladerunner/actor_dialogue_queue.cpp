@@ -166,6 +166,13 @@ void ActorDialogueQueue::tick() {
 				} else {
 					_animationModePrevious = -1;
 				}
+
+				for (uint i = 0; i < _entries.size(); ++i) {
+					if (_entries[i].isNotPause) {
+						_vm->_audioSpeech->prefetchSpeech(_entries[i].actorId, _entries[i].sentenceId);
+						break;
+					}
+				}
 			} else if (firstEntry.isPause) {
 				_isPause = true;
 				_delayMillis = firstEntry.delayMillis;
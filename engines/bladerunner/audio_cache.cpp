@@ -25,9 +25,9 @@
 
 namespace BladeRunner {
 
-AudioCache::AudioCache() :
+AudioCache::AudioCache(uint32 maxSize) :
 	_totalSize(0),
-	_maxSize(2457600),
+	_maxSize(maxSize),
 	_accessCounter(0) {}
 
 AudioCache::~AudioCache() {
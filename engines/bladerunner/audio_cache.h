@@ -47,7 +47,7 @@ class AudioCache {
 	uint32 _accessCounter;
 
 public:
-	AudioCache();
+	AudioCache(uint32 maxSize = 2457600);
 	~AudioCache();
 
 	bool  canAllocate(uint32 size) const;
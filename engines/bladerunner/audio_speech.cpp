@@ -56,6 +56,7 @@ AudioSpeech::AudioSpeech(BladeRunnerEngine *vm) {
 	_speechVolumeFactorOriginalEngine = BLADERUNNER_ORIGINAL_SETTINGS ? 50 : 100;
 	_isActive = false;
 	_data = new byte[kBufferSize];
+	_prefetchData = new byte[kBufferSize];
 	_channel = -1;
 }
 
@@ -65,6 +66,7 @@ AudioSpeech::~AudioSpeech() {
 		// wait for the mixer to finish
 	}
 
+	delete[] _prefetchData;
 	delete[] _data;
 }
 
@@ -77,25 +79,11 @@ bool AudioSpeech::playSpeech(const Common::String &name, int pan) {
 	// Audio cache is not usable as hash function is producing collision for speech lines.
 	// It was not used in the original game either
 
-	Common::ScopedPtr<Common::SeekableReadStream> r(_vm->getResourceStream(_vm->_enhancedEdition ? ("audio/" + name) : name));
-
-	if (!r) {
-		warning("AudioSpeech::playSpeech: AUD resource \"%s\" not found", name.c_str());
-		return false;
-	}
-
-	if (r->size() > kBufferSize) {
-		warning("AudioSpeech::playSpeech: AUD larger than buffer size (%d > %d)", (int)r->size(), kBufferSize);
-		return false;
-	}
-
-	if (isPlaying()) {
-		stopSpeech();
-	}
-
-	r->read(_data, r->size());
-	if (r->err()) {
-		warning("AudioSpeech::playSpeech: Error reading resource \"%s\"", name.c_str());
+	if (!_prefetchName.empty() && _prefetchName.equals(name)) {
+		// The stream of the previous line is gone after stopSpeech(), so its buffer can be reused
+		SWAP(_data, _prefetchData);
+		_prefetchName.clear();
+	} else if (!readSpeech(name, _data)) {
 		return false;
 	}
 
@@ -120,6 +108,41 @@ bool AudioSpeech::playSpeech(const Common::String &name, int pan) {
 	return true;
 }
 
+// Read the line sentenceId of actorId ahead, so that it can be played
+// without waiting for its resource, e.g. when queued in a dialogue
+void AudioSpeech::prefetchSpeech(int actorId, int sentenceId) {
+	Common::String name = Common::String::format("%02d-%04d%s.AUD", actorId, sentenceId, _vm->_languageCode.c_str());
+	if (_prefetchName.equals(name)) {
+		return;
+	}
+
+	_prefetchName.clear();
+	if (readSpeech(name, _prefetchData)) {
+		_prefetchName = name;
+	}
+}
+
+bool AudioSpeech::readSpeech(const Common::String &name, byte *data) {
+	Common::ScopedPtr<Common::SeekableReadStream> r(_vm->getResourceStream(_vm->_enhancedEdition ? ("audio/" + name) : name));
+
+	if (!r) {
+		warning("AudioSpeech::readSpeech: AUD resource \"%s\" not found", name.c_str());
+		return false;
+	}
+
+	if (r->size() > kBufferSize) {
+		warning("AudioSpeech::readSpeech: AUD larger than buffer size (%d > %d)", (int)r->size(), kBufferSize);
+		return false;
+	}
+
+	r->read(data, r->size());
+	if (r->err()) {
+		warning("AudioSpeech::readSpeech: Error reading resource \"%s\"", name.c_str());
+		return false;
+	}
+	return true;
+}
+
 void AudioSpeech::stopSpeech() {
 	//Common::StackLock lock(_mutex);
 	if (_channel != -1) {
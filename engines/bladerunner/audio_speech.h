@@ -42,6 +42,10 @@ class AudioSpeech {
 	int   _channel;
 	byte *_data;
 
+	// The next line of a dialogue, read in while the current one is playing
+	Common::String _prefetchName;
+	byte          *_prefetchData;
+
 public:
 	AudioSpeech(BladeRunnerEngine *vm);
 	~AudioSpeech();
@@ -52,6 +56,8 @@ public:
 
 	bool playSpeechLine(int actorId, int sentenceId, int volume, int a4, int priority);
 
+	void prefetchSpeech(int actorId, int sentenceId);
+
 #if BLADERUNNER_ORIGINAL_SETTINGS
 	void setVolume(int volume);
 	int getVolume() const;
@@ -59,6 +65,8 @@ public:
 	void playSample();
 
 private:
+	bool readSpeech(const Common::String &name, byte *data);
+
 	void ended();
 	static void mixerChannelEnded(int channel, void *data);
 };
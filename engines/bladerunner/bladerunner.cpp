@@ -716,7 +716,12 @@ bool BladeRunnerEngine::startup(bool hasSavegames) {
 
 		_items = new Items(this);
 
-		_audioCache = new AudioCache();
+		// The size of the cache of the original game can be raised, in KB
+		if (ConfMan.hasKey("audio_cache_size") && ConfMan.getInt("audio_cache_size") > 0) {
+			_audioCache = new AudioCache(ConfMan.getInt("audio_cache_size") * 1024);
+		} else {
+			_audioCache = new AudioCache();
+		}
 
 		_chapters = new Chapters(this);
 		if (!_chapters)
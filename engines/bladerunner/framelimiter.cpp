@@ -22,53 +22,22 @@
 #include "bladerunner/framelimiter.h"
 
 #include "bladerunner/bladerunner.h"
-#include "bladerunner/time.h"
-
-#include "common/debug.h"
-#include "common/system.h"
 
 namespace BladeRunner {
 
-Framelimiter::Framelimiter(BladeRunnerEngine *vm, uint fps) {
-	_vm = vm;
-
-	reset();
+// TODO: when vsync will be supported, use it
+Framelimiter::Framelimiter(BladeRunnerEngine *vm, uint fps) :
+	_vm(vm),
+	_limiter(vm->_system, fps, false) {
 
-	if (fps > 0) {
-		_enabled = true;
-		_speedLimitMs = 1000 / fps;
-	} else {
-		_enabled = false;
-	}
-
-	_timeFrameStart = _vm->_time->currentSystem();
+	// Some systems sleep too imprecisely for a smooth framerate
+	_limiter.setSleeping(!_vm->_noDelayMillisFramelimiter);
+	_limiter.startFrame();
 }
 
 void Framelimiter::wait() {
-	// TODO: when vsync will be supported, use it
-
-	if (!_enabled) {
-		return;
-	}
-
-	uint32 timeNow = _vm->_time->currentSystem();
-	uint32 frameDuration = timeNow - _timeFrameStart;
-	if (frameDuration < _speedLimitMs) {
-		uint32 waittime = _speedLimitMs - frameDuration;
-		if (_vm->_noDelayMillisFramelimiter) {
-			while (_vm->_time->currentSystem() - timeNow < waittime) { }
-		} else {
-			_vm->_system->delayMillis(waittime);
-		}
-		timeNow += waittime;
-	}
-	// debug("frametime %i ms", timeNow - _timeFrameStart);
-	// using _vm->_time->currentSystem() here is slower and causes some shutters
-	_timeFrameStart = timeNow;
-}
-
-void Framelimiter::reset() {
-	_timeFrameStart = 0u;
+	_limiter.delayBeforeSwap();
+	_limiter.startFrame();
 }
 
 } // End of namespace BladeRunner
@@ -24,6 +24,8 @@
 
 #include "bladerunner/bladerunner.h"
 
+#include "graphics/framelimiter.h"
+
 namespace BladeRunner {
 
 class BladeRunnerEngine;
@@ -34,19 +36,12 @@ class Framelimiter {
 private:
 	BladeRunnerEngine *_vm;
 
-	bool   _enabled;
-	uint32 _speedLimitMs;
-
-	uint32 _timeFrameStart;
+	Graphics::FrameLimiter _limiter;
 
 public:
 	Framelimiter(BladeRunnerEngine *vm, uint fps = 60);
 
 	void wait();
-
-private:
-	void reset();
-
 };
 
 } // End of namespace BladeRunner
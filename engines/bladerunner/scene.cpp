@@ -117,6 +117,7 @@ bool Scene::open(int setId, int sceneId, bool isLoadingGame) {
 	}
 
 	_vqaPlayer = new VQAPlayer(_vm, &_vm->_surfaceBack, vqaName);
+	_vqaPlayer->enableFrameCache();
 
 	if (!_vm->_sceneScript->open(sceneName)) {
 		return false;
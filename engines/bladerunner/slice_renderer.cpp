@@ -27,8 +27,10 @@
 #include "bladerunner/set_effects.h"
 #include "bladerunner/slice_animations.h"
 
+#include "common/jobsystem.h"
 #include "common/memstream.h"
 #include "common/rect.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace BladeRunner {
@@ -60,6 +62,7 @@ SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
 	_endSlice          = 0.0f;
 	_m13               = 0;
 	_m23               = 0;
+	_linesSurface      = nullptr;
 
 	_shadowPolygonDefault[ 0] = Vector3( 16.0f,  96.0f, 0.0f);
 	_shadowPolygonDefault[ 1] = Vector3( 16.0f, 160.0f, 0.0f);
@@ -444,6 +447,12 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 
 	uint16 *zBufferLinePtr = zbuffer + BladeRunnerEngine::kOriginalGameWidth * frameY;
 
+	// The lights and the set effects are evaluated incrementally, so the
+	// parameters of the lines are worked out in order first. Each line then
+	// only touches its own row of the surface and of the z-buffer, so they
+	// can be drawn in parallel.
+	_lines.clear();
+
 	while (sliceLineIterator._currentY <= sliceLineIterator._endY) {
 		_m13 = sliceLineIterator._sliceMatrix(0, 2);
 		_m23 = sliceLineIterator._sliceMatrix(1, 2);
@@ -468,13 +477,32 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 		_setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
 
 		if (frameY >= 0 && frameY < surface.h) {
-			drawSlice((int)sliceLine, true, frameY, surface, zBufferLinePtr);
+			SliceLine line;
+			line.slice          = (int)sliceLine;
+			line.y              = frameY;
+			line.m13            = _m13;
+			line.m23            = _m23;
+			line.setEffectColor = _setEffectColor;
+			line.lightsColor    = _lightsColor;
+			line.zbufferLine    = zBufferLinePtr;
+			_lines.push_back(line);
 		}
 
 		sliceLineIterator.advance();
 		++frameY;
 		zBufferLinePtr += BladeRunnerEngine::kOriginalGameWidth;
 	}
+
+	_linesSurface = &surface;
+	g_system->getJobSystem()->parallelFor(_lines.size(), drawLinesProc, this, 16);
+	_linesSurface = nullptr;
+}
+
+void SliceRenderer::drawLinesProc(uint32 begin, uint32 end, void *refCon) {
+	const SliceRenderer *renderer = (const SliceRenderer *)refCon;
+	for (uint32 i = begin; i < end; ++i) {
+		renderer->drawSlice(renderer->_lines[i], true, *renderer->_linesSurface);
+	}
 }
 
 void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screenX, int screenY, float facing, float scale, Graphics::Surface &surface) {
@@ -530,20 +558,35 @@ void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screen
 	while (currentSlice < _frameSliceCount) {
 		if (currentY >= 0 && currentY < surface.h) {
 			memset(lineZbuffer, 0xFF, BladeRunnerEngine::kOriginalGameWidth * 2);
-			drawSlice(currentSlice, false, currentY, surface, lineZbuffer);
+
+			SliceLine line;
+			line.slice       = (int)currentSlice;
+			line.y           = currentY;
+			line.m13         = _m13;
+			line.m23         = _m23;
+			line.zbufferLine = lineZbuffer;
+			drawSlice(line, false, surface);
 			currentSlice += sliceStep;
 			--currentY;
 		}
 	}
 }
 
-void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine) {
+void SliceRenderer::drawSlice(const SliceLine &line, bool advanced, Graphics::Surface &surface) const {
+	const int slice = line.slice;
+	const int y = line.y;
+	uint16 *zbufferLine = line.zbufferLine;
+
 	if (slice < 0 || (uint32)slice >= _frameSliceCount) {
 		return;
 	}
 
 	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
 
+	// Only the row y of the surface is written
+	byte *dstLine = (byte *)surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+	const int bytesPerPixel = surface.format.bytesPerPixel;
+
 	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
 
 	uint32 polyOffset = READ_LE_UINT32(p);
@@ -561,15 +604,15 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 			continue;
 
 		uint32 lastVertex = vertexCount - 1;
-		int lastVertexX = MAX((_m11lookup[p[3 * lastVertex]] + _m12lookup[p[3 * lastVertex + 1]] + _m13) / 65536, 0);
+		int lastVertexX = MAX((_m11lookup[p[3 * lastVertex]] + _m12lookup[p[3 * lastVertex + 1]] + line.m13) / 65536, 0);
 
 		int previousVertexX = lastVertexX;
 
 		while (vertexCount--) {
-			int vertexX = CLIP<int32>((_m11lookup[p[0]] + _m12lookup[p[1]] + _m13) / 65536, 0, BladeRunnerEngine::kOriginalGameWidth);
+			int vertexX = CLIP<int32>((_m11lookup[p[0]] + _m12lookup[p[1]] + line.m13) / 65536, 0, BladeRunnerEngine::kOriginalGameWidth);
 
 			if (vertexX > previousVertexX) {
-				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + _m23) / 64;
+				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + line.m23) / 64;
 
 				if (vertexZ >= 0 && vertexZ < 65536) {
 					uint32 outColor = palette.value[p[2]];
@@ -578,9 +621,9 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 						_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
 
 						Color256 color = palette.color[p[2]];
-						color.r = ((int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536) + aescColor.r;
-						color.g = ((int)(_setEffectColor.g + _lightsColor.g * color.g) / 65536) + aescColor.g;
-						color.b = ((int)(_setEffectColor.b + _lightsColor.b * color.b) / 65536) + aescColor.b;
+						color.r = ((int)(line.setEffectColor.r + line.lightsColor.r * color.r) / 65536) + aescColor.r;
+						color.g = ((int)(line.setEffectColor.g + line.lightsColor.g * color.g) / 65536) + aescColor.g;
+						color.b = ((int)(line.setEffectColor.b + line.lightsColor.b * color.b) / 65536) + aescColor.b;
 						// We need to convert from 5 bits per channel (r,g,b) to 8 bits
 						outColor = _pixelFormat.RGBToColor(Color::get8BitColorFrom5Bit(color.r), Color::get8BitColorFrom5Bit(color.g), Color::get8BitColorFrom5Bit(color.b));
 					}
@@ -589,7 +632,7 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 						if (vertexZ < zbufferLine[x]) {
 							zbufferLine[x] = (uint16)vertexZ;
 
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
+							void *dstPtr = dstLine + CLIP(x, 0, surface.w - 1) * bytesPerPixel;
 							drawPixel(surface, dstPtr, outColor);
 						}
 					}
@@ -27,6 +27,7 @@
 #include "bladerunner/view.h"
 #include "bladerunner/matrix.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 #include "graphics/surface.h"
@@ -43,6 +44,17 @@ class Lights;
 class SetEffects;
 
 class SliceRenderer {
+	// The parameters of one screen line of a frame, which is drawn by drawSlice()
+	struct SliceLine {
+		int     slice;
+		int     y;
+		int     m13;
+		int     m23;
+		Color   setEffectColor;
+		Color   lightsColor;
+		uint16 *zbufferLine;
+	};
+
 	BladeRunnerEngine *_vm;
 
 	int       _animation;
@@ -90,6 +102,10 @@ class SliceRenderer {
 
 	Graphics::PixelFormat _pixelFormat;
 
+	// The lines of the frame being drawn by drawInWorld()
+	Common::Array<SliceLine> _lines;
+	Graphics::Surface       *_linesSurface;
+
 public:
 	SliceRenderer(BladeRunnerEngine *vm);
 	~SliceRenderer();
@@ -113,7 +129,8 @@ private:
 	Matrix3x2 calculateFacingRotationMatrix();
 	void loadFrame(int animation, int frame);
 
-	void drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine);
+	void drawSlice(const SliceLine &line, bool advanced, Graphics::Surface &surface) const;
+	static void drawLinesProc(uint32 begin, uint32 end, void *refCon);
 	void drawShadowInWorld(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 	void drawShadowPolygon(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 };
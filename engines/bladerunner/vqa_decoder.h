@@ -75,6 +75,8 @@ public:
 	void                        decodeLights(Lights *lights);
 
 	uint16 numFrames() const { return _header.numFrames; }
+	uint16 width() const { return _header.width; }
+	uint16 height() const { return _header.height; }
 	uint8  frameRate() const { return _header.frameRate; }
 
 	uint16 offsetX() const { return _header.offsetX; }
@@ -112,6 +112,11 @@ void VQAPlayer::close() {
 	_vm->_mixer->stopHandle(_soundHandle);
 	delete _s;
 	_s = nullptr;
+	clearFrameCache();
+}
+
+void VQAPlayer::enableFrameCache() {
+	_frameCacheEnabled = true;
 }
 
 bool VQAPlayer::loadVQPTable(const Common::String &vqpResName) {
@@ -275,8 +280,23 @@ int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics:
 
 	} else if (advanceFrame) {
 		_frame = _frameNext;
-		_decoder.readFrame(_frameNext, kVQAReadVideo);
-		_decoder.decodeVideoFrame(customSurface != nullptr ? customSurface : _surface, _frameNext);
+
+		CachedFrame *cachedFrame = customSurface == nullptr ? getCachedFrame(_frameNext, true) : nullptr;
+		if (cachedFrame != nullptr && cachedFrame->surface.getPixels() != nullptr) {
+			// Only the z-buffer, view, lights and effects are still read
+			_decoder.readFrame(_frameNext, kVQAReadCustom);
+			_surface->copyRectToSurface(cachedFrame->surface, _decoder.offsetX(), _decoder.offsetY(), Common::Rect(cachedFrame->surface.w, cachedFrame->surface.h));
+		} else {
+			_decoder.readFrame(_frameNext, kVQAReadVideo);
+			_decoder.decodeVideoFrame(customSurface != nullptr ? customSurface : _surface, _frameNext);
+
+			if (cachedFrame != nullptr) {
+				Common::Rect rect(_decoder.offsetX(), _decoder.offsetY(), _decoder.offsetX() + _decoder.width(), _decoder.offsetY() + _decoder.height());
+				rect.clip(Common::Rect(_surface->w, _surface->h));
+				cachedFrame->surface.create(rect.width(), rect.height(), _surface->format);
+				cachedFrame->surface.copyRectToSurface(*_surface, 0, 0, rect);
+			}
+		}
 
 		int maxAllowedAudioPreloadedFrames = kMaxAudioPreloadedFrames;
 		if (_frameEnd - _frameNext < kMaxAudioPreloadedFrames - 1) {
@@ -352,7 +372,13 @@ int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics:
 	}
 
 	if (result < 0 && forceDraw && _frame != -1) {
-		_decoder.decodeVideoFrame(customSurface != nullptr ? customSurface : _surface, _frame, true);
+		// The vector pointers of a cached frame were not read
+		CachedFrame *cachedFrame = customSurface == nullptr ? getCachedFrame(_frame, false) : nullptr;
+		if (cachedFrame != nullptr && cachedFrame->surface.getPixels() != nullptr) {
+			_surface->copyRectToSurface(cachedFrame->surface, _decoder.offsetX(), _decoder.offsetY(), Common::Rect(cachedFrame->surface.w, cachedFrame->surface.h));
+		} else {
+			_decoder.decodeVideoFrame(customSurface != nullptr ? customSurface : _surface, _frame, true);
+		}
 		result = _frame;
 	}
 	return result; // Note: result here could be negative.
@@ -361,7 +387,16 @@ int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics:
 }
 
 void VQAPlayer::updateZBuffer(ZBuffer *zbuffer) {
-	_decoder.decodeZBuffer(zbuffer);
+	CachedFrame *cachedFrame = getCachedFrame(_frame, false);
+	if (cachedFrame != nullptr && cachedFrame->zbuffer != nullptr) {
+		zbuffer->setBackground(cachedFrame->zbuffer);
+	} else {
+		_decoder.decodeZBuffer(zbuffer);
+		if (cachedFrame != nullptr) {
+			cachedFrame->zbuffer = new uint16[BladeRunnerEngine::kOriginalGameWidth * BladeRunnerEngine::kOriginalGameHeight];
+			zbuffer->getBackground(cachedFrame->zbuffer);
+		}
+	}
 #if !BLADERUNNER_ORIGINAL_BUGS
 	if (_specialPS15GlitchFix) {
 		// The glitch (bad z-buffer, value zero (0))
@@ -494,6 +529,56 @@ int VQAPlayer::getQueuedAudioFrames() const {
 	return _audioStream->numQueuedStreams();
 }
 
+VQAPlayer::CachedFrame *VQAPlayer::getCachedFrame(int frame, bool create) {
+	// Only the frames of a loop that is played forever are worth keeping.
+	// The codebooks of the old VQAs are built up while playing, so their
+	// frames can not be skipped.
+	if (!_frameCacheEnabled || _decoder._oldV2VQA || frame < 0 || _repeatsCount != -1 || _frameEndQueued != -1 || frame < _frameBeginNext || frame > _frameEnd) {
+		return nullptr;
+	}
+
+	if (_frameBeginNext != _frameCacheBegin || _frameEnd != _frameCacheEnd) {
+		if (!create) {
+			return nullptr;
+		}
+
+		clearFrameCache();
+		_frameCacheBegin = _frameBeginNext;
+		_frameCacheEnd   = _frameEnd;
+
+		uint32 frameCount = _frameCacheEnd - _frameCacheBegin + 1;
+		uint32 frameSize  = _decoder.width() * _decoder.height() * _surface->format.bytesPerPixel
+		                  + BladeRunnerEngine::kOriginalGameWidth * BladeRunnerEngine::kOriginalGameHeight * sizeof(uint16);
+		_frameCacheFits = frameCount * frameSize <= kFrameCacheBudget;
+		if (_frameCacheFits) {
+			_frameCache.resize(frameCount);
+			for (uint32 i = 0; i < frameCount; ++i) {
+				_frameCache[i] = nullptr;
+			}
+		}
+	}
+
+	if (!_frameCacheFits) {
+		return nullptr;
+	}
+
+	CachedFrame *&cachedFrame = _frameCache[frame - _frameCacheBegin];
+	if (cachedFrame == nullptr && create) {
+		cachedFrame = new CachedFrame();
+	}
+	return cachedFrame;
+}
+
+void VQAPlayer::clearFrameCache() {
+	for (uint i = 0; i < _frameCache.size(); ++i) {
+		delete _frameCache[i];
+	}
+	_frameCache.clear();
+	_frameCacheFits  = false;
+	_frameCacheBegin = -1;
+	_frameCacheEnd   = -1;
+}
+
 // Adds another audio "frame" to the queue of the audio stream
 void VQAPlayer::queueAudioFrame(Audio::AudioStream *audioStream) {
 	if (audioStream == nullptr) {
@@ -27,6 +27,8 @@
 #include "audio/audiostream.h"
 #include "audio/mixer.h"
 
+#include "common/array.h"
+
 #include "graphics/surface.h"
 
 namespace BladeRunner {
@@ -55,9 +57,22 @@ class VQAPlayer {
 
 	static const uint32  kVqaFrameTimeDiff             = 4000; // 60 * 1000 / 15
 	static const int     kMaxAudioPreloadedFrames      = 15;
+	static const uint32  kFrameCacheBudget             = 64 * 1024 * 1024;
 	// Use speech sound type as in original engine
 	static const Audio::Mixer::SoundType kVQASoundType = Audio::Mixer::kSpeechSoundType;
 
+	// A decoded frame of the loop being played, see enableFrameCache()
+	struct CachedFrame {
+		Graphics::Surface  surface;
+		uint16            *zbuffer;
+
+		CachedFrame() : zbuffer(nullptr) {}
+		~CachedFrame() {
+			surface.free();
+			delete[] zbuffer;
+		}
+	};
+
 	int _frame;
 	int _frameNext;
 	int _frameBeginNext; // The frame to begin from, after current playing loop ends.
@@ -92,6 +107,12 @@ class VQAPlayer {
 	void (*_callbackLoopEnded)(void *, int frame, int loopId);
 	void  *_callbackData;
 
+	bool                          _frameCacheEnabled;
+	bool                          _frameCacheFits;
+	int                           _frameCacheBegin;
+	int                           _frameCacheEnd;
+	Common::Array<CachedFrame *>  _frameCache;
+
 public:
 
 	VQAPlayer(BladeRunnerEngine *vm, Graphics::Surface *surface, const Common::String &name)
@@ -118,7 +139,11 @@ public:
 		  _specialPS15GlitchFix(false),
 		  _specialUG18DoNotRepeatLastLoop(false),
 		  _callbackLoopEnded(nullptr),
-		  _callbackData(nullptr) { }
+		  _callbackData(nullptr),
+		  _frameCacheEnabled(false),
+		  _frameCacheFits(false),
+		  _frameCacheBegin(-1),
+		  _frameCacheEnd(-1) { }
 
 	~VQAPlayer() {
 		close();
@@ -129,6 +154,12 @@ public:
 
 	bool loadVQPTable(const Common::String& vqpResName);
 
+	// Keep the decoded frames and z-buffers of a loop that is repeated forever,
+	// as long as they fit into kFrameCacheBudget, instead of decoding them again
+	// on every repetition. Only meant for the set backgrounds, which are decoded
+	// into a surface nothing else draws into.
+	void enableFrameCache();
+
 	int  update(bool forceDraw = false, bool advanceFrame = true, bool useTime = true, Graphics::Surface *customSurface = nullptr);
 	void updateZBuffer(ZBuffer *zbuffer);
 	void updateView(View *view);
@@ -152,6 +183,9 @@ public:
 
 private:
 	void queueAudioFrame(Audio::AudioStream *audioStream);
+
+	CachedFrame *getCachedFrame(int frame, bool create);
+	void clearFrameCache();
 };
 
 } // End of namespace BladeRunner
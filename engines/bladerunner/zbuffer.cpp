@@ -178,6 +178,20 @@ uint16 *ZBuffer::getData() const {
 	return _zbuf2;
 }
 
+void ZBuffer::getBackground(uint16 *data) const {
+	memcpy(data, _zbuf1, 2 * _width * _height);
+}
+
+void ZBuffer::setBackground(const uint16 *data) {
+	if (_disabled) {
+		return;
+	}
+
+	resetUpdates();
+	memcpy(_zbuf1, data, 2 * _width * _height);
+	memcpy(_zbuf2, data, 2 * _width * _height);
+}
+
 #if !BLADERUNNER_ORIGINAL_BUGS
 void ZBuffer::setDataZbufExplicit(int x, int y, uint16 overidingVal) {
 	assert(x >= 0 && x < _width);
@@ -67,6 +67,10 @@ public:
 	uint16 *getData() const;
 	uint16 getZValue(int x, int y) const;
 
+	// Copy the decoded background depths, without the marked updates
+	void getBackground(uint16 *data) const;
+	void setBackground(const uint16 *data);
+
 #if !BLADERUNNER_ORIGINAL_BUGS
 	void setDataZbufExplicit(int x, int y, uint16 overidingVal);
 #endif // BLADERUNNER_ORIGINAL_BUGS
@@ -170,6 +170,14 @@ const Stxt *Cast::getStxt(int castId) {
 
 	if (_loadedStxts->contains(castId)) {
 		result = _loadedStxts->getVal(castId);
+	} else if (_stxtResources.contains(castId)) {
+		Common::SeekableReadStreamEndian *r = _castArchive->getResource(MKTAG('S','T','X','T'), _stxtResources[castId]);
+		if (r) {
+			result = new Stxt(this, *r);
+			delete r;
+		}
+		_loadedStxts->setVal(castId, result);
+		_stxtResources.erase(castId);
 	}
 	return result;
 }
@@ -605,10 +613,9 @@ void Cast::loadCast() {
 	_loadedStxts = new Common::HashMap<int, const Stxt *>();
 
 	for (auto &iterator : stxt) {
-		_loadedStxts->setVal(iterator - _castIDoffset,
-				 new Stxt(this, *(r = _castArchive->getResource(MKTAG('S','T','X','T'), iterator))));
+		// The text itself is only parsed when it is requested
+		_stxtResources.setVal(iterator - _castIDoffset, iterator);
 		debugC(3, kDebugText, "STXT: id %d", iterator - _castIDoffset);
-		delete r;
 
 		// Try to load movie script, it starts with a comment
 		if (_version < kFileVer400) {
@@ -663,6 +670,7 @@ Common::String Cast::getVideoPath(int castId) {
 		res = directory + g_director->_dirSeparator + filename;
 	} else {
 		Video::QuickTimeDecoder qt;
+		qt.setHeaderOnly(true);
 		qt.loadStream(videoData);
 		videoData = nullptr;
 		res = qt.getAliasPath();
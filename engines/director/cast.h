@@ -144,6 +144,8 @@ public:
 
 	Common::HashMap<int, CastMember *> *_loadedCast;
 	Common::HashMap<int, const Stxt *> *_loadedStxts;
+	// STXT resource ids of the text members, parsed on first use by getStxt()
+	Common::HashMap<int, uint16> _stxtResources;
 	uint16 _castIDoffset;
 	uint16 _castArrayStart;
 	uint16 _castArrayEnd;
@@ -43,8 +43,6 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableRe
 	_type = kCastBitmap;
 	_picture = nullptr;
 	_ditheredImg = nullptr;
-	_matte = nullptr;
-	_noMatte = false;
 	_bytes = 0;
 	_pitch = 0;
 	_flags2 = 0;
@@ -157,8 +155,6 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableRe
 BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Image::ImageDecoder *img, uint8 flags1)
 	: CastMember(cast, castId) {
 	_type = kCastBitmap;
-	_matte = nullptr;
-	_noMatte = false;
 	_bytes = 0;
 	if (img != nullptr) {
 		_picture = new Picture(*img);
@@ -185,8 +181,7 @@ BitmapCastMember::~BitmapCastMember() {
 		delete _ditheredImg;
 	}
 
-	if (_matte)
-		delete _matte;
+	clearMattes();
 }
 
 Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel *channel, SpriteType spriteType) {
@@ -210,6 +205,9 @@ Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel
 	// colourspace transformations (e.g. palette remapping or dithering).
 	// We also want to make sure that
 	if (isModified() || (((srcBpp == 1) || (srcBpp > 1 && dstBpp == 1)) && !previouslyDithered)) {
+		// Mattes are traced from the image we are about to replace
+		clearMattes();
+
 		if (_ditheredImg) {
 			_ditheredImg->free();
 			delete _ditheredImg;
@@ -408,8 +406,6 @@ void BitmapCastMember::createMatte(Common::Rect &bbox) {
 		bbox
 	);
 
-	_noMatte = true;
-
 	// Searching white color in the corners
 	uint32 whiteColor = 0;
 	bool colorFound = false;
@@ -433,43 +429,62 @@ void BitmapCastMember::createMatte(Common::Rect &bbox) {
 		colorFound = true;
 	}
 
+	Matte matte;
+	matte.width = bbox.width();
+	matte.height = bbox.height();
+	matte.fill = nullptr;
+
 	if (!colorFound) {
 		debugC(1, kDebugImages, "BitmapCastMember::createMatte(): No white color for matte image");
 	} else {
-		delete _matte;
-
-		_matte = new Graphics::FloodFill(&tmp, whiteColor, 0, true);
+		matte.fill = new Graphics::FloodFill(&tmp, whiteColor, 0, true);
 
 		for (int yy = 0; yy < tmp.h; yy++) {
-			_matte->addSeed(0, yy);
-			_matte->addSeed(tmp.w - 1, yy);
+			matte.fill->addSeed(0, yy);
+			matte.fill->addSeed(tmp.w - 1, yy);
 		}
 
 		for (int xx = 0; xx < tmp.w; xx++) {
-			_matte->addSeed(xx, 0);
-			_matte->addSeed(xx, tmp.h - 1);
+			matte.fill->addSeed(xx, 0);
+			matte.fill->addSeed(xx, tmp.h - 1);
 		}
 
-		_matte->fillMask();
-		_noMatte = false;
+		matte.fill->fillMask();
 	}
 
 	tmp.free();
+
+	for (uint i = 0; i < _mattes.size(); i++) {
+		if (_mattes[i].width == matte.width && _mattes[i].height == matte.height) {
+			delete _mattes[i].fill;
+			_mattes.remove_at(i);
+			break;
+		}
+	}
+	if (_mattes.size() >= kMaxMattes) {
+		delete _mattes[0].fill;
+		_mattes.remove_at(0);
+	}
+	_mattes.push_back(matte);
+}
+
+void BitmapCastMember::clearMattes() {
+	for (auto &matte : _mattes)
+		delete matte.fill;
+	_mattes.clear();
 }
 
 Graphics::Surface *BitmapCastMember::getMatte(Common::Rect &bbox) {
-	// Lazy loading of mattes
-	if (!_matte && !_noMatte) {
-		createMatte(bbox);
+	// Lazy loading of mattes, one per size the image is drawn at
+	for (auto &matte : _mattes) {
+		if (matte.width == bbox.width() && matte.height == bbox.height())
+			return matte.fill ? matte.fill->getMask() : nullptr;
 	}
 
-	// check for the scale matte
-	Graphics::Surface *surface = _matte ? _matte->getMask() : nullptr;
-	if (surface && (surface->w != bbox.width() || surface->h != bbox.height())) {
-		createMatte(bbox);
-	}
+	createMatte(bbox);
 
-	return _matte ? _matte->getMask() : nullptr;
+	const Matte &matte = _mattes.back();
+	return matte.fill ? matte.fill->getMask() : nullptr;
 }
 
 Common::String BitmapCastMember::formatInfo() {
@@ -625,6 +640,8 @@ void BitmapCastMember::unload() {
 	delete _ditheredImg;
 	_ditheredImg = nullptr;
 
+	clearMattes();
+
 	_loaded = false;
 }
 
@@ -646,6 +663,7 @@ void BitmapCastMember::setPicture(PictureReference &picture) {
 	// Force redither
 	delete _ditheredImg;
 	_ditheredImg = nullptr;
+	clearMattes();
 
 	// Make sure we get redrawn
 	setModified(true);
@@ -655,6 +673,7 @@ void BitmapCastMember::setPicture(PictureReference &picture) {
 void BitmapCastMember::setPicture(Image::ImageDecoder &image, bool adjustSize) {
 	delete _picture;
 	_picture = new Picture(image);
+	clearMattes();
 	if (adjustSize) {
 		auto surf = image.getSurface();
 		_size = surf->pitch * surf->h + _picture->getPaletteSize();
@@ -40,6 +40,7 @@ public:
 	bool isModified() override;
 	void createMatte(Common::Rect &bbox);
 	Graphics::Surface *getMatte(Common::Rect &bbox);
+	void clearMattes();
 	Graphics::Surface *getDitherImg();
 
 	bool hasField(int field) override;
@@ -60,7 +61,16 @@ public:
 
 	Picture *_picture = nullptr;
 	Graphics::Surface *_ditheredImg;
-	Graphics::FloodFill *_matte;
+
+	// Mattes of the image at the sizes it is drawn at, shared by every channel
+	// showing this member. Null when the image has no white to flood fill.
+	struct Matte {
+		int16 width;
+		int16 height;
+		Graphics::FloodFill *fill;
+	};
+	Common::Array<Matte> _mattes; // least recently created first
+	static const uint kMaxMattes = 4;
 
 	uint16 _pitch;
 	uint16 _regX;
@@ -73,7 +83,6 @@ public:
 	uint8 _bitsPerPixel;
 
 	uint32 _tag;
-	bool _noMatte;
 	bool _external;
 };
 
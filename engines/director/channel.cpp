@@ -63,11 +63,15 @@ Channel::Channel(Score *sc, Sprite *sp, int priority) {
 	_visible = true;
 	_dirty = true;
 
+	_inkCacheState = kInkCacheEmpty;
+	_inkCache = nullptr;
+	_inkCacheMask = nullptr;
+
 	if (_sprite)
 		_sprite->updateEditable();
 }
 
-Channel::Channel(const Channel &channel) {
+Channel::Channel(const Channel &channel) : _inkCache(nullptr), _inkCacheMask(nullptr) {
 	*this = channel;
 }
 
@@ -94,6 +98,9 @@ Channel& Channel::operator=(const Channel &channel) {
 	_visible = channel._visible;
 	_dirty = channel._dirty;
 
+	// The cache is tied to our own widget
+	invalidateInkCache();
+
 	return *this;
 }
 
@@ -110,6 +117,8 @@ Channel::~Channel() {
 		delete _mask;
 	if (_sprite)
 		delete _sprite;
+
+	invalidateInkCache();
 }
 
 DirectorPlotData Channel::getPlotData() {
@@ -203,6 +212,143 @@ const Graphics::Surface *Channel::getMask(bool forceMatte) {
 	return nullptr;
 }
 
+void Channel::invalidateInkCache() {
+	delete _inkCache;
+	_inkCache = nullptr;
+	delete _inkCacheMask;
+	_inkCacheMask = nullptr;
+	_inkCacheKey = InkCacheKey();
+	_inkCacheState = kInkCacheEmpty;
+}
+
+bool Channel::inkBlitCached(DirectorPlotData &pd, const Common::Rect &bbox) {
+	// Only bitmap widgets keep their pixels for as long as they exist
+	if (!pd.srf || pd.ms || pd.alpha || _sprite->_spriteType != kBitmapSprite ||
+			!_sprite->_cast || _sprite->_cast->_type != kCastBitmap || hasSubChannels())
+		return false;
+
+	switch (pd.ink) {
+	case kInkTypeCopy:
+		// Plain copies are a stock blit already
+		if (!pd.applyColor)
+			return false;
+		break;
+	case kInkTypeMatte:
+	case kInkTypeMask:
+	case kInkTypeBlend:
+	case kInkTypeNotCopy:
+	case kInkTypeBackgndTrans:
+	case kInkTypeTransparent:
+	case kInkTypeNotTrans:
+	case kInkTypeGhost:
+	case kInkTypeNotGhost:
+		break;
+	default:
+		return false;
+	}
+
+	InkCacheKey key;
+	key.srf = pd.srf;
+	key.bbox = bbox;
+	key.ink = pd.ink;
+	key.foreColor = pd.foreColor;
+	key.backColor = pd.backColor;
+	key.applyColor = pd.applyColor;
+	key.oneBitImage = pd.oneBitImage;
+
+	if (!(key == _inkCacheKey)) {
+		// Wait for the sprite to be drawn again unchanged before spending
+		// the memory, moving or animated sprites would not benefit
+		invalidateInkCache();
+		_inkCacheKey = key;
+		return false;
+	}
+
+	if (_inkCacheState == kInkCacheUncacheable)
+		return false;
+	if (_inkCacheState == kInkCacheEmpty && !buildInkCache(pd, bbox)) {
+		_inkCacheState = kInkCacheUncacheable;
+		return false;
+	}
+	_inkCacheState = kInkCacheValid;
+
+	const Common::Rect &destRect = pd.destRect;
+	const int offX = destRect.left - bbox.left;
+	const int offY = destRect.top - bbox.top;
+	for (int i = 0; i < destRect.height(); i++) {
+		const byte *msk = (const byte *)_inkCacheMask->getBasePtr(offX, offY + i);
+		if (pd.d->_wm->_pixelformat.bytesPerPixel == 1) {
+			const byte *src = (const byte *)_inkCache->getBasePtr(offX, offY + i);
+			byte *dst = (byte *)pd.dst->getBasePtr(destRect.left, destRect.top + i);
+			for (int j = 0; j < destRect.width(); j++) {
+				if (msk[j])
+					dst[j] = src[j];
+			}
+		} else {
+			const uint32 *src = (const uint32 *)_inkCache->getBasePtr(offX, offY + i);
+			uint32 *dst = (uint32 *)pd.dst->getBasePtr(destRect.left, destRect.top + i);
+			for (int j = 0; j < destRect.width(); j++) {
+				if (msk[j])
+					dst[j] = src[j];
+			}
+		}
+	}
+
+	return true;
+}
+
+bool Channel::buildInkCache(DirectorPlotData &pd, const Common::Rect &bbox) {
+	// Draw the sprite over two backgrounds with complementary bits. A pixel
+	// left untouched on both was not drawn, a pixel with the same value on both
+	// does not depend on the background. Anything else does, and since the
+	// cached inks are bitwise, two backgrounds are enough to tell.
+	const Graphics::PixelFormat &format = pd.d->_wm->_pixelformat;
+	const uint32 ones = format.bytesPerPixel == 1 ? 0xff : 0xffffffff;
+	const Common::Rect rect(bbox.width(), bbox.height());
+	const Graphics::Surface *mask = getMask();
+
+	Graphics::ManagedSurface *back[2];
+	for (int i = 0; i < 2; i++) {
+		back[i] = new Graphics::ManagedSurface(rect.width(), rect.height(), format);
+		back[i]->fillRect(rect, i ? ones : 0);
+
+		DirectorPlotData tmp(pd);
+		tmp.oneBitImage = pd.oneBitImage;
+		tmp.dst = back[i];
+		tmp.destRect = rect;
+		Common::Rect srcRect(rect);
+		tmp.inkBlitSurface(srcRect, mask);
+	}
+
+	_inkCacheMask = new Graphics::ManagedSurface(rect.width(), rect.height(), Graphics::PixelFormat::createFormatCLUT8());
+	bool cacheable = true;
+	for (int y = 0; y < rect.height() && cacheable; y++) {
+		byte *msk = (byte *)_inkCacheMask->getBasePtr(0, y);
+		for (int x = 0; x < rect.width(); x++) {
+			uint32 a = back[0]->getPixel(x, y), b = back[1]->getPixel(x, y);
+			if (a == 0 && b == ones) {
+				msk[x] = 0;
+			} else if (a == b) {
+				msk[x] = 1;
+			} else {
+				cacheable = false;
+				break;
+			}
+		}
+	}
+
+	delete back[1];
+	if (!cacheable) {
+		delete back[0];
+		delete _inkCacheMask;
+		_inkCacheMask = nullptr;
+		return false;
+	}
+	_inkCache = back[0];
+
+	return true;
+}
+
 // TODO: eliminate this function when we got the correct method to deal with sprite size
 // since we didn't handle sprites very well for text cast members. thus we don't replace our text castmembers when only size changes
 // for explicitly changing, we have isModified to check
@@ -635,6 +781,7 @@ void Channel::replaceWidget(CastMemberID previousCastId, bool force) {
 			delete _widget;
 		_widget = nullptr;
 	}
+	invalidateInkCache();
 
 	if (_sprite && _sprite->_cast) {
 		// use sprite type to guide us how to draw the cast
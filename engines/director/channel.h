@@ -35,6 +35,7 @@ namespace Director {
 class Sprite;
 class Cursor;
 class Score;
+struct DirectorPlotData;
 
 class Channel {
 public:
@@ -71,6 +72,9 @@ public:
 
 	bool isTrail();
 
+	bool inkBlitCached(DirectorPlotData &pd, const Common::Rect &bbox);
+	void invalidateInkCache();
+
 	void updateGlobalAttr();
 
 	bool canKeepWidget(CastMemberID castId);
@@ -114,6 +118,38 @@ public:
 private:
 	Graphics::ManagedSurface *getSurface();
 	Score *_score;
+
+	// Result of the ink applied to the whole sprite, for the inks which either
+	// replace a pixel with a colour depending on the sprite only, or keep it.
+	// Redrawing a part of an unchanged sprite is then a masked copy.
+	struct InkCacheKey {
+		const Graphics::ManagedSurface *srf = nullptr;
+		Common::Rect bbox;
+		InkType ink = kInkTypeCopy;
+		uint32 foreColor = 0;
+		uint32 backColor = 0;
+		bool applyColor = false;
+		bool oneBitImage = false;
+
+		bool operator==(const InkCacheKey &other) const {
+			return srf == other.srf && bbox == other.bbox && ink == other.ink &&
+				foreColor == other.foreColor && backColor == other.backColor &&
+				applyColor == other.applyColor && oneBitImage == other.oneBitImage;
+		}
+	};
+
+	enum InkCacheState {
+		kInkCacheEmpty,      // sprite was drawn once with _inkCacheKey
+		kInkCacheValid,
+		kInkCacheUncacheable // the ink depends on the pixels below
+	};
+
+	bool buildInkCache(DirectorPlotData &pd, const Common::Rect &bbox);
+
+	InkCacheKey _inkCacheKey;
+	InkCacheState _inkCacheState;
+	Graphics::ManagedSurface *_inkCache;
+	Graphics::ManagedSurface *_inkCacheMask; // 1 byte per pixel, set where the sprite is drawn
 };
 
 } // End of namespace Director
@@ -106,6 +106,8 @@ Debugger::Debugger(): GUI::Debugger() {
 	registerCmd("draw", WRAP_METHOD(Debugger, cmdDraw));
 	registerCmd("forceredraw", WRAP_METHOD(Debugger, cmdForceRedraw));
 
+	registerCmd("profile", WRAP_METHOD(Debugger, cmdProfile));
+
 	_nextFrame = false;
 	_nextFrameCounter = 0;
 	_nextMovie = false;
@@ -127,6 +129,7 @@ Debugger::Debugger(): GUI::Debugger() {
 	_bpCheckEntityRead = false;
 	_bpCheckEntityWrite = false;
 	_bpCheckEvent = false;
+	_profiling = false;
 }
 
 Debugger::~Debugger() {
@@ -195,9 +198,101 @@ bool Debugger::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("GFX:\n");
 	debugPrintf(" draw [cast|frame|off] - Draws debug outlines for cast or frame number\n");
+	debugPrintf("\n");
+	debugPrintf("Profiling:\n");
+	debugPrintf(" profile [on|off|reset] - Starts, stops or clears the Lingo profiler\n");
+	debugPrintf(" profile [handlers|builtins|entities] [n] - Lists the n most expensive handlers, builtins or \"the\" entities\n");
+	return true;
+}
+
+bool Debugger::cmdProfile(int argc, const char **argv) {
+	if (argc < 2) {
+		debugPrintf("Lingo profiler is %s\n", _profiling ? "on" : "off");
+		debugPrintf("Usage: %s [on|off|reset|handlers|builtins|entities] [n]\n", argv[0]);
+		return true;
+	}
+
+	Common::String cmd(argv[1]);
+	uint count = (argc > 2) ? atoi(argv[2]) : 20;
+	if (cmd.equalsIgnoreCase("on")) {
+		_profiling = true;
+		debugPrintf("Lingo profiler started\n");
+	} else if (cmd.equalsIgnoreCase("off")) {
+		_profiling = false;
+		_profHandlerStack.clear();
+		_profBuiltinStack.clear();
+		debugPrintf("Lingo profiler stopped\n");
+	} else if (cmd.equalsIgnoreCase("reset")) {
+		_profHandlers.clear();
+		_profBuiltins.clear();
+		_profEntities.clear();
+		_profHandlerStack.clear();
+		_profBuiltinStack.clear();
+		debugPrintf("Lingo profiler cleared\n");
+	} else if (cmd.equalsIgnoreCase("handlers")) {
+		profileReport(_profHandlers, "Handlers by exclusive time", count);
+	} else if (cmd.equalsIgnoreCase("builtins")) {
+		profileReport(_profBuiltins, "Builtins by time", count);
+	} else if (cmd.equalsIgnoreCase("entities")) {
+		Common::Array<EntityProfileEntry *> list;
+		for (auto &it : _profEntities)
+			list.push_back(&it._value);
+		Common::sort(list.begin(), list.end(), [](const EntityProfileEntry *a, const EntityProfileEntry *b) {
+			return a->reads + a->writes > b->reads + b->writes;
+		});
+		debugPrintf("\"the\" entities by accesses:\n");
+		debugPrintf("%10s %10s  %s\n", "reads", "writes", "entity");
+		for (uint i = 0; i < list.size() && i < count; i++) {
+			const EntityProfileEntry *entry = list[i];
+			debugPrintf("%10u %10u  %s %s\n", entry->reads, entry->writes,
+				g_lingo->entity2str(entry->entity), entry->field ? g_lingo->field2str(entry->field) : "");
+		}
+	} else {
+		debugPrintf("Unknown profiler command: %s\n", argv[1]);
+	}
 	return true;
 }
 
+void Debugger::profileReport(Common::HashMap<Common::String, ProfileEntry> &entries, const char *title, uint count) {
+	Common::Array<ProfileEntry *> list;
+	for (auto &it : entries)
+		list.push_back(&it._value);
+	Common::sort(list.begin(), list.end(), [](const ProfileEntry *a, const ProfileEntry *b) {
+		return a->exclusiveTime > b->exclusiveTime;
+	});
+
+	debugPrintf("%s:\n", title);
+	debugPrintf("%10s %12s %12s  %s\n", "calls", "incl. (ms)", "excl. (ms)", "name");
+	for (uint i = 0; i < list.size() && i < count; i++) {
+		const ProfileEntry *entry = list[i];
+		debugPrintf("%10u %12.3f %12.3f  %s\n", entry->calls, entry->inclusiveTime / 1000.0,
+			entry->exclusiveTime / 1000.0, entry->name.c_str());
+	}
+}
+
+void Debugger::profileEnter(Common::Array<ProfileFrame> &stack, ProfileEntry &entry) {
+	ProfileFrame frame;
+	frame.entry = &entry;
+	frame.startTime = g_system->getMicros();
+	frame.childTime = 0;
+	entry.calls++;
+	stack.push_back(frame);
+}
+
+void Debugger::profileLeave(Common::Array<ProfileFrame> &stack) {
+	// Frames entered before the profiler was started are not tracked
+	if (stack.empty())
+		return;
+
+	const ProfileFrame frame = stack.back();
+	stack.pop_back();
+	const uint64 elapsed = g_system->getMicros() - frame.startTime;
+	frame.entry->inclusiveTime += elapsed;
+	frame.entry->exclusiveTime += elapsed - MIN(frame.childTime, elapsed);
+	if (!stack.empty())
+		stack.back().childTime += elapsed;
+}
+
 Common::String Breakpoint::format() {
 	Common::String result = Common::String::format("Breakpoint %d, ", id);
 	switch (type) {
@@ -1195,6 +1290,16 @@ void Debugger::pushContextHook() {
 	if (_finish)
 		_finishCounter++;
 	bpUpdateState();
+	if (_profiling) {
+		CFrame *frame = g_lingo->_state->callstack.back();
+		ScriptContext *ctx = frame->sp.ctx;
+		Common::String name = Common::String::format("%d:%s", ctx ? ctx->_id : 0,
+			frame->sp.name ? frame->sp.name->c_str() : "<unknown>");
+		ProfileEntry &entry = _profHandlers[name];
+		if (entry.name.empty())
+			entry.name = name;
+		profileEnter(_profHandlerStack, entry);
+	}
 }
 
 void Debugger::popContextHook() {
@@ -1203,6 +1308,8 @@ void Debugger::popContextHook() {
 	if (_finish)
 		_finishCounter--;
 	bpUpdateState();
+	if (_profiling)
+		profileLeave(_profHandlerStack);
 }
 
 void Debugger::builtinHook(const Symbol &funcSym) {
@@ -1221,6 +1328,19 @@ void Debugger::builtinHook(const Symbol &funcSym) {
 		}
 	}
 	bpTest(builtinMatch);
+	if (_profiling) {
+		ProfileEntry &entry = _profBuiltins[*funcSym.name];
+		if (entry.name.empty())
+			entry.name = *funcSym.name;
+		profileEnter(_profBuiltinStack, entry);
+	}
+}
+
+void Debugger::builtinDoneHook(const Symbol &funcSym) {
+	if (!funcSym.name)
+		return;
+	if (_profiling)
+		profileLeave(_profBuiltinStack);
 }
 
 void Debugger::varReadHook(const Common::String &name) {
@@ -1258,6 +1378,12 @@ void Debugger::varWriteHook(const Common::String &name) {
 }
 
 void Debugger::entityReadHook(int entity, int field) {
+	if (_profiling) {
+		EntityProfileEntry &entry = _profEntities[(entity << 16) | (field & 0xffff)];
+		entry.entity = entity;
+		entry.field = field;
+		entry.reads++;
+	}
 	if (_bpCheckEntityRead) {
 		for (auto &it : _breakpoints) {
 			if (it.type == kBreakpointEntity && it.varRead && it.entity == entity && it.field == field) {
@@ -1273,6 +1399,12 @@ void Debugger::entityReadHook(int entity, int field) {
 }
 
 void Debugger::entityWriteHook(int entity, int field) {
+	if (_profiling) {
+		EntityProfileEntry &entry = _profEntities[(entity << 16) | (field & 0xffff)];
+		entry.entity = entity;
+		entry.field = field;
+		entry.writes++;
+	}
 	if (_bpCheckEntityWrite) {
 		for (auto &it : _breakpoints) {
 			if (it.type == kBreakpointEntity && it.varWrite && it.entity == entity && it.field == field) {
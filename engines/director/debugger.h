@@ -24,6 +24,7 @@
 
 #include "common/array.h"
 #include "common/file.h"
+#include "common/hashmap.h"
 #include "common/str.h"
 #include "gui/debugger.h"
 
@@ -74,6 +75,7 @@ public:
 	void pushContextHook();
 	void popContextHook();
 	void builtinHook(const Symbol &funcSym);
+	void builtinDoneHook(const Symbol &funcSym);
 	void varReadHook(const Common::String &varName);
 	void varWriteHook(const Common::String &varName);
 	void entityReadHook(int entity, int field);
@@ -116,6 +118,7 @@ private:
 
 	bool cmdDraw(int argc, const char **argv);
 	bool cmdForceRedraw(int argc, const char **argv);
+	bool cmdProfile(int argc, const char **argv);
 
 	void bpUpdateState();
 	void bpTest(bool forceCheck = false);
@@ -154,6 +157,39 @@ private:
 	bool _bpCheckEntityRead;
 	bool _bpCheckEntityWrite;
 	bool _bpCheckEvent;
+
+	// Lingo profiler
+	struct ProfileEntry {
+		Common::String name;
+		uint32 calls = 0;
+		uint64 inclusiveTime = 0;	// in microseconds
+		uint64 exclusiveTime = 0;
+	};
+
+	struct ProfileFrame {
+		ProfileEntry *entry;
+		uint64 startTime;
+		uint64 childTime;
+	};
+
+	struct EntityProfileEntry {
+		int entity = 0;
+		int field = 0;
+		uint32 reads = 0;
+		uint32 writes = 0;
+	};
+
+	void profileReport(Common::HashMap<Common::String, ProfileEntry> &entries, const char *title, uint count);
+	void profileEnter(Common::Array<ProfileFrame> &stack, ProfileEntry &entry);
+	void profileLeave(Common::Array<ProfileFrame> &stack);
+
+	bool _profiling;
+	Common::HashMap<Common::String, ProfileEntry> _profHandlers;
+	Common::HashMap<Common::String, ProfileEntry> _profBuiltins;
+	Common::HashMap<uint32, EntityProfileEntry> _profEntities;
+	// Builtins can push handler frames which outlive them, so they get their own stack
+	Common::Array<ProfileFrame> _profHandlerStack;
+	Common::Array<ProfileFrame> _profBuiltinStack;
 };
 
 
@@ -51,6 +51,10 @@ void Frame::reset() {
 		Sprite *sp = new Sprite(this);
 		_sprites[i] = sp;
 	}
+
+	_spriteChanged.resize(_sprites.size());
+	for (uint16 i = 0; i < _spriteChanged.size(); i++)
+		_spriteChanged[i] = true;
 }
 
 Frame::Frame(const Frame &frame) {
@@ -87,6 +91,10 @@ Frame::Frame(const Frame &frame) {
 	for (uint16 i = 0; i <= _numChannels; i++) {
 		_sprites[i] = new Sprite(*frame._sprites[i]);
 	}
+
+	_spriteChanged.resize(_sprites.size());
+	for (uint16 i = 0; i < _spriteChanged.size(); i++)
+		_spriteChanged[i] = true;
 }
 
 Frame::~Frame() {
@@ -273,6 +281,7 @@ void Frame::readSpriteD2(Common::MemoryReadStreamEndian &stream, uint16 offset,
 	debugC(3, kDebugLoading, "Frame::readSpriteD2(): sprite: %d offset: %d size: %d, field: %d", spritePosition, offset, size, fieldPosition);
 
 	Sprite &sprite = *_sprites[spritePosition + 1];
+	_spriteChanged[spritePosition + 1] = true;
 
 	if (sprite._puppet) {
 		stream.skip(size);
@@ -548,6 +557,7 @@ void Frame::readSpriteD4(Common::MemoryReadStreamEndian &stream, uint16 offset,
 	debugC(3, kDebugLoading, "Frame::readSpriteD4(): sprite: %d offset: %d size: %d, field: %d", spritePosition, offset, size, fieldPosition);
 
 	Sprite &sprite = *_sprites[spritePosition + 1];
+	_spriteChanged[spritePosition + 1] = true;
 
 	if (sprite._puppet) {
 		stream.skip(size);
@@ -811,6 +821,7 @@ void Frame::readSpriteD5(Common::MemoryReadStreamEndian &stream, uint16 offset,
 	debugC(3, kDebugLoading, "Frame::readSpriteD5(): sprite: %d offset: %d size: %d, field: %d", spritePosition, offset, size, fieldPosition);
 
 	Sprite &sprite = *_sprites[spritePosition + 1];
+	_spriteChanged[spritePosition + 1] = true;
 
 	if (sprite._puppet) {
 		stream.skip(size);
@@ -969,6 +980,7 @@ void Frame::readSpriteD6(Common::MemoryReadStreamEndian &stream, uint16 offset,
 	debugC(3, kDebugLoading, "Frame::readSpriteD6(): sprite: %d offset: %d size: %d, field: %d", spritePosition, offset, size, fieldPosition);
 
 	Sprite &sprite = *_sprites[spritePosition + 1];
+	_spriteChanged[spritePosition + 1] = true;
 
 	if (sprite._puppet) {
 		stream.skip(size);
@@ -190,6 +190,8 @@ public:
 	int _numChannels;
 	MainChannels _mainChannels;
 	Common::Array<Sprite *> _sprites;
+	// Channels modified by the score stream since the last frame checkpoint
+	Common::Array<bool> _spriteChanged;
 	Score *_score;
 	DirectorEngine *_vm;
 };
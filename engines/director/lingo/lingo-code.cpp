@@ -1693,6 +1693,7 @@ void LC::call(const Symbol &funcSym, int nargs, bool allowRetVal) {
 		} else {
 			(*funcSym.u.bltin)(nargs);
 		}
+		g_debugger->builtinDoneHook(funcSym);
 
 		uint stackSize = g_lingo->_stack.size();
 
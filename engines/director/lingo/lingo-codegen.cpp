@@ -108,6 +108,58 @@ LingoCompiler::LingoCompiler() {
 	_refMode = false;
 
 	_hadError = false;
+
+	_parseCacheSize = 0;
+}
+
+LingoCompiler::~LingoCompiler() {
+	clearParseCache();
+}
+
+void LingoCompiler::clearParseCache() {
+	for (auto &it : _parseCache)
+		delete it._value;
+	_parseCache.clear();
+	_parseCacheOrder.clear();
+	_parseCacheSize = 0;
+}
+
+bool LingoCompiler::parseCached(const Common::String &code) {
+	// The parser debug output is expected to show up on every parse
+	if (debugChannelSet(-1, kDebugParse)) {
+		parse(code.c_str());
+		return false;
+	}
+
+	ScriptNode *cached = _parseCache.getValOrDefault(code, nullptr);
+	if (cached) {
+		debugC(3, kDebugCompile, "LingoCompiler::parseCached(): Reusing the parse tree of %d bytes", code.size());
+		_assemblyAST = cached;
+		return true;
+	}
+
+	parse(code.c_str());
+	if (!_assemblyAST || code.size() > kParseCacheBudget)
+		return false;
+
+	while (_parseCacheSize + code.size() > kParseCacheBudget && !_parseCacheOrder.empty())
+		uncacheParse(_parseCacheOrder.front());
+	_parseCache[code] = static_cast<ScriptNode *>(_assemblyAST);
+	_parseCacheOrder.push_back(code);
+	_parseCacheSize += code.size();
+	return true;
+}
+
+void LingoCompiler::uncacheParse(const Common::String &code) {
+	ScriptNode *cached = _parseCache.getValOrDefault(code, nullptr);
+	if (!cached)
+		return;
+	if (_assemblyAST == cached)
+		_assemblyAST = nullptr;
+	delete cached;
+	_parseCache.erase(code);
+	_parseCacheOrder.remove(code);
+	_parseCacheSize -= code.size();
 }
 
 ScriptContext *LingoCompiler::compileAnonymous(const Common::U32String &code, uint32 preprocFlags) {
@@ -135,10 +187,10 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 	mainContext->_methodNames = prescanMethods(codePrep);
 
 	Common::String codeNorm = codePrep.encode(Common::kUtf8);
-	const char *utf8Code = codeNorm.c_str();
 
-	// Parse the Lingo and build an AST
-	parse(utf8Code);
+	// Parse the Lingo and build an AST, or take the one built the last time
+	// this exact code was loaded. The cache owns the trees it holds.
+	bool astCached = parseCached(codeNorm);
 	// If it doesn't work, and we have kLPPTrimGarbage enabled,
 	// have another try with the input trimmed to the last valid character.
 	if (!_assemblyAST && (preprocFlags & kLPPTrimGarbage)) {
@@ -153,8 +205,7 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 		_linenumber = _colnumber = 1;
 		_hadError = false;
 		codeNorm = codeNorm.substr(0, _bytenumber - 1) + "\n";
-		utf8Code = codeNorm.c_str();
-		parse(utf8Code);
+		astCached = parseCached(codeNorm);
 	}
 	if (!_assemblyAST) {
 		delete _assemblyContext;
@@ -170,7 +221,11 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 		delete _assemblyContext;
 		delete _currentAssembly;
 		delete _methodVars;
-		delete _assemblyAST;
+		if (astCached)
+			uncacheParse(codeNorm);
+		else
+			delete _assemblyAST;
+		_assemblyAST = nullptr;
 		_assemblyId = -1;
 		return nullptr;
 	}
@@ -248,7 +303,8 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 	delete _methodVars;
 	_methodVars = nullptr;
 	_currentAssembly = nullptr;
-	delete _assemblyAST;
+	if (!astCached)
+		delete _assemblyAST;
 	_assemblyAST = nullptr;
 	_assemblyContext = nullptr;
 	_assemblyArchive = nullptr;
@@ -430,6 +486,9 @@ void LingoCompiler::updateLoopJumps(uint nextTargetPos, uint exitTargetPos) {
 		WRITE_UINT32(&jmpOffset, exitTargetPos - exitRepeatPos);
 		(*_currentAssembly)[exitRepeatPos + 1] = jmpOffset;
 	}
+	// The tree may be compiled again from the parse cache
+	_currentLoop->nextRepeats.clear();
+	_currentLoop->exitRepeats.clear();
 }
 
 /* ScriptNode */
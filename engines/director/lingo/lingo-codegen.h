@@ -30,7 +30,7 @@ namespace Director {
 class LingoCompiler : NodeVisitor {
 public:
 	LingoCompiler();
-	virtual ~LingoCompiler() {}
+	virtual ~LingoCompiler();
 
 	ScriptContext *compileAnonymous(const Common::U32String &code, uint32 preprocFlags = 0);
 	ScriptContext *compileLingo(const Common::U32String &code, LingoArchive *archive, ScriptType type, CastMemberID id, const Common::String &scriptName, bool anonyomous = false, uint32 preprocFlags = kLPPNone);
@@ -52,6 +52,7 @@ public:
 	void registerFactory(Common::String &s);
 	void registerMethodVar(const Common::String &name, VarType type = kVarGeneric);
 	void updateLoopJumps(uint nextTargetPos, uint exitTargetPos);
+	void clearParseCache();
 
 	LingoArchive *_assemblyArchive;
 	ScriptContext *_assemblyContext;
@@ -71,6 +72,20 @@ public:
 
 	bool _hadError;
 
+private:
+	// Parsed scripts, keyed by their preprocessed text. Parsing only depends
+	// on the text, while code generation has side effects on the archive and
+	// the globals, so the trees are kept and the code is generated anew on
+	// every load. This saves most of the time on movie switches in projectors.
+	Common::HashMap<Common::String, ScriptNode *> _parseCache;
+	Common::List<Common::String> _parseCacheOrder;	// oldest first
+	uint32 _parseCacheSize;
+
+	static const uint32 kParseCacheBudget = 4 * 1024 * 1024;	// in bytes of source text
+
+	bool parseCached(const Common::String &code);
+	void uncacheParse(const Common::String &code);
+
 public:
 	virtual bool visitScriptNode(ScriptNode *node);
 	virtual bool visitFactoryNode(FactoryNode *node);
@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/rational.h"
 #include "common/memstream.h"
+#include "common/ptr.h"
 #include "common/punycode.h"
 #include "common/substream.h"
 
@@ -51,6 +52,14 @@
 
 namespace Director {
 
+struct FrameCheckpoint {
+	uint32 frameNum;
+	uint32 streamPos;
+	MainChannels mainChannels;
+	// Channels which didn't change since the previous checkpoint share its sprite
+	Common::Array<Common::SharedPtr<Sprite> > sprites;
+};
+
 #include "director/palette-fade.h"
 
 Score::Score(Movie *movie) {
@@ -104,6 +113,9 @@ Score::~Score() {
 	if (_currentFrame) {
 		delete _currentFrame;
 	}
+
+	for (auto &it : _frameCheckpoints)
+		delete it;
 }
 
 void Score::setPuppetTempo(int16 puppetTempo) {
@@ -368,6 +380,9 @@ void Score::update() {
 				processFrozenScripts();
 			}
 
+			if (!_prefetchQueue.empty())
+				prefetchCastMember();
+
 			return;
 		}
 	}
@@ -1452,7 +1467,18 @@ void Score::loadFrames(Common::SeekableReadStreamEndian &stream, uint16 version)
 
 	// Calculate number of frames and their positions
 	// numOfFrames in the header is often incorrect
-	for (_numFrames = 1; loadFrame(_numFrames, false); _numFrames++) { }
+	// While at it, note the cast members of the first frames for prefetching.
+	// "prefetch_frames" sets how many frames to look at, 0 disables it.
+	int prefetchFrames = ConfMan.hasKey("prefetch_frames") ? ConfMan.getInt("prefetch_frames") : kPrefetchFrames;
+	Common::HashMap<CastMemberID, bool> queued;
+	for (_numFrames = 1; loadFrame(_numFrames, false); _numFrames++) {
+		// Members of the first frame get loaded right away anyway
+		if ((int)_numFrames <= prefetchFrames)
+			queuePrefetch(queued, _numFrames > 1);
+
+		if (_numFrames % kFrameCheckpointInterval == 0)
+			addFrameCheckpoint();
+	}
 
 	debugC(1, kDebugLoading, "Score::loadFrames(): Calculated, total number of frames %d!", _numFrames);
 
@@ -1478,6 +1504,9 @@ bool Score::loadFrame(int frameNum, bool loadCast) {
 
 		// Reset position to start
 		_framesStream->seek(_firstFramePosition);
+
+		// ...or to the closest snapshot before the target frame
+		sourceFrame = restoreFrameCheckpoint(targetFrame - 1);
 	}
 
 	debugC(7, kDebugLoading, "****** Source frame %d to Destination frame %d, current offset %ld", sourceFrame, targetFrame, _framesStream->pos());
@@ -1502,6 +1531,45 @@ bool Score::loadFrame(int frameNum, bool loadCast) {
 	return true;
 }
 
+void Score::addFrameCheckpoint() {
+	FrameCheckpoint *prev = _frameCheckpoints.empty() ? nullptr : _frameCheckpoints.back();
+	FrameCheckpoint *checkpoint = new FrameCheckpoint;
+
+	checkpoint->frameNum = _curFrameNumber;
+	checkpoint->streamPos = _framesStream->pos();
+	checkpoint->mainChannels = _currentFrame->_mainChannels;
+	checkpoint->sprites.resize(_currentFrame->_sprites.size());
+
+	for (uint16 i = 0; i < _currentFrame->_sprites.size(); i++) {
+		if (prev && !_currentFrame->_spriteChanged[i])
+			checkpoint->sprites[i] = prev->sprites[i];
+		else
+			checkpoint->sprites[i] = Common::SharedPtr<Sprite>(new Sprite(*_currentFrame->_sprites[i]));
+		_currentFrame->_spriteChanged[i] = false;
+	}
+
+	debugC(7, kDebugLoading, "Score::addFrameCheckpoint(): frame %d at offset %d", checkpoint->frameNum, checkpoint->streamPos);
+	_frameCheckpoints.push_back(checkpoint);
+}
+
+int Score::restoreFrameCheckpoint(int frameNum) {
+	int index = frameNum / kFrameCheckpointInterval - 1;
+	if (index < 0 || _frameCheckpoints.empty())
+		return 0;
+
+	FrameCheckpoint *checkpoint = _frameCheckpoints[MIN(index, (int)_frameCheckpoints.size() - 1)];
+
+	_currentFrame->_mainChannels = checkpoint->mainChannels;
+	for (uint16 i = 0; i < _currentFrame->_sprites.size(); i++) {
+		*_currentFrame->_sprites[i] = *checkpoint->sprites[i];
+		_currentFrame->_sprites[i]->_frame = _currentFrame;
+	}
+	_framesStream->seek(checkpoint->streamPos);
+
+	debugC(7, kDebugLoading, "****** Restored checkpoint of frame %d, offset %d", checkpoint->frameNum, checkpoint->streamPos);
+	return checkpoint->frameNum;
+}
+
 bool Score::readOneFrame() {
 	uint16 channelSize;
 	uint16 channelOffset;
@@ -1572,6 +1640,26 @@ Frame *Score::getFrameData(int frameNum){
 	return nullptr;
 }
 
+void Score::queuePrefetch(Common::HashMap<CastMemberID, bool> &queued, bool push) {
+	for (uint16 j = 0; j < _currentFrame->_sprites.size(); j++) {
+		CastMemberID castId = _currentFrame->_sprites[j]->_castId;
+		if (castId.member == 0 || queued.contains(castId))
+			continue;
+		queued[castId] = true;
+		if (push)
+			_prefetchQueue.push(castId);
+	}
+}
+
+void Score::prefetchCastMember() {
+	// Archives can't be read from several threads, so instead of a
+	// background job one member is loaded per idle tick of the main loop.
+	// Looking the member up loads it.
+	CastMemberID castId = _prefetchQueue.pop();
+	debugC(5, kDebugLoading, "Score::prefetchCastMember(): Loading %s", castId.asString().c_str());
+	_movie->getCastMember(castId);
+}
+
 void Score::setSpriteCasts() {
 	// Update sprite cache of cast pointers/info
 	for (uint16 j = 0; j < _currentFrame->_sprites.size(); j++) {
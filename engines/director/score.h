@@ -22,6 +22,8 @@
 #ifndef DIRECTOR_SCORE_H
 #define DIRECTOR_SCORE_H
 
+#include "common/queue.h"
+
 #include "director/cursor.h"
 
 namespace Graphics {
@@ -52,6 +54,12 @@ class Channel;
 class Sprite;
 class CastMember;
 class AudioDecoder;
+struct FrameCheckpoint;
+
+// Number of score frames whose cast members are loaded ahead of time
+const int kPrefetchFrames = 10;
+// Interval of the frame state snapshots used to jump back in the score
+const int kFrameCheckpointInterval = 50;
 
 enum RenderMode {
 	kRenderModeNormal,
@@ -146,6 +154,12 @@ private:
 	bool processImmediateFrameScript(Common::String s, int id);
 	bool processFrozenScripts();
 
+	void addFrameCheckpoint();
+	int restoreFrameCheckpoint(int frameNum);
+
+	void queuePrefetch(Common::HashMap<CastMemberID, bool> &queued, bool push);
+	void prefetchCastMember();
+
 public:
 	Common::Array<Channel *> _channels;
 	Common::SortedArray<Label *> *_labels;
@@ -165,6 +179,9 @@ public:
 	uint _firstFramePosition;
 	uint _framesStreamSize;
 	Common::MemoryReadStreamEndian *_framesStream;
+	// State of every kFrameCheckpointInterval-th frame, so that going back
+	// doesn't have to replay the score from the first frame
+	Common::Array<FrameCheckpoint *> _frameCheckpoints;
 
 	byte _currentFrameRate;
 
@@ -198,6 +215,10 @@ private:
 	DirectorSound *_soundManager;
 
 	int _previousBuildBotBuild = -1;
+
+	// Cast members used by the first frames of the score, loaded while
+	// waiting for the next frame so that they don't stall playback
+	Common::Queue<CastMemberID> _prefetchQueue;
 };
 
 } // End of namespace Director
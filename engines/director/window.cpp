@@ -307,7 +307,8 @@ void Window::inkBlitFrom(Channel *channel, Common::Rect destRect, Graphics::Mana
 	if (pd.ms) {
 		pd.inkBlitShape(srcRect);
 	} else if (pd.srf) {
-		pd.inkBlitSurface(srcRect, channel->getMask());
+		if (!channel->inkBlitCached(pd, srcRect))
+			pd.inkBlitSurface(srcRect, channel->getMask());
 	} else {
 		if (debugChannelSet(kDebugImages, 4)) {
 			CastType castType = channel->_sprite->_cast ? channel->_sprite->_cast->_type : kCastTypeNull;
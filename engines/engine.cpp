@@ -579,6 +579,12 @@ void Engine::handleAutoSave() {
 	if (!g_eventRec.processAutosave())
 		return;
 #endif
+	// Autosaves are written in the background, check whether the last one made it
+	if (!_saveFileMan->checkPendingSaves()) {
+		g_system->displayMessageOnOSD(_("Error occurred making autosave"));
+		_lastAutosaveState.clear();
+	}
+
 	const int diff = _system->getMillis() - _lastAutosaveTime;
 
 	if (_autosaveInterval != 0 && diff > (_autosaveInterval * 1000)) {
@@ -880,6 +886,13 @@ bool Engine::canLoadGameStateCurrently(Common::U32String *msg) {
 }
 
 Common::Error Engine::saveGameState(int slot, const Common::String &desc, bool isAutosave) {
+	if (isAutosave)
+		return saveAutosaveState(slot, desc);
+
+	// The autosave is replaced by a regular save
+	if (slot == getAutosaveSlot())
+		_lastAutosaveState.clear();
+
 	Common::OutSaveFile *saveFile = _saveFileMan->openForSaving(getSaveStateName(slot));
 
 	if (!saveFile)
@@ -896,6 +909,35 @@ Common::Error Engine::saveGameState(int slot, const Common::String &desc, bool i
 	return result;
 }
 
+Common::Error Engine::saveAutosaveState(int slot, const Common::String &desc) {
+	// The game state is collected first, so that it can be compared with
+	// the one of the last autosave
+	Common::MemoryWriteStreamDynamic state(DisposeAfterUse::YES);
+	Common::Error result = saveGameStream(&state, true);
+	if (result.getCode() != Common::kNoError)
+		return result;
+
+	const Common::String filename = getSaveStateName(slot);
+	if (state.size() && state.size() == _lastAutosaveState.size() &&
+		!memcmp(state.getData(), &_lastAutosaveState[0], state.size()) && _saveFileMan->exists(filename)) {
+		// Nothing happened since the last autosave, so it can be kept
+		return Common::kNoError;
+	}
+
+	// Autosaves shouldn't make the game wait for the disk
+	Common::OutSaveFile *saveFile = _saveFileMan->openForSavingAsync(filename);
+	if (!saveFile)
+		return Common::kWritingFailed;
+
+	saveFile->write(state.getData(), state.size());
+	getMetaEngine()->appendExtendedSave(saveFile, getTotalPlayTime(), desc, true);
+	saveFile->finalize();
+	delete saveFile;
+
+	_lastAutosaveState = Common::Array<byte>(state.getData(), state.size());
+	return result;
+}
+
 Common::Error Engine::saveGameStream(Common::WriteStream *stream, bool isAutosave) {
 	// Default to returning an error when not implemented
 	return Common::kWritingFailed;
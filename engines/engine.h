@@ -23,6 +23,7 @@
 #define ENGINES_ENGINE_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/str.h"
 #include "common/language.h"
 #include "common/platform.h"
@@ -229,6 +230,12 @@ private:
 	 */
 	bool _autoSaving;
 
+	/**
+	 * Game state written by the last autosave, so that an autosave of an
+	 * unchanged game doesn't have to be written again.
+	 */
+	Common::Array<byte> _lastAutosaveState;
+
 	/**
 	 * Optional debugger for the engine.
 	 */
@@ -667,6 +674,13 @@ protected:
 	 * Syncs the engine's mixer using the default volume syncing behavior.
 	 */
 	void defaultSyncSoundSettings();
+
+private:
+	/**
+	 * Write an autosave for saveGameState() in the background, unless the
+	 * game state is the same as in the last one.
+	 */
+	Common::Error saveAutosaveState(int slot, const Common::String &desc);
 };
 
 
@@ -525,7 +525,82 @@ bool Renderer::computeScreenViewport() {
 	return true;
 }
 
-void Renderer::renderPyramid(const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates, Common::Array<uint8> *colours, int type) {
+bool ObjectGeometry::matches(int type_, const Math::Vector3d &origin_, const Math::Vector3d &size_, const Common::Array<uint16> *ordinates_) const {
+	if (type != type_ || origin != origin_ || size != size_)
+		return false;
+	if (!ordinates_)
+		return ordinates.empty();
+	return ordinates == *ordinates_;
+}
+
+Common::Array<Math::Vector3d> &ObjectGeometry::addFace(uint colour) {
+	faces.push_back(Face());
+	faces.back().colour = colour;
+	return faces.back().vertices;
+}
+
+void Renderer::updateGeometry(ObjectGeometry &geometry, int type, const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates) {
+	if (geometry.matches(type, origin, size, ordinates))
+		return;
+
+	geometry.type = type;
+	geometry.origin = origin;
+	geometry.size = size;
+	geometry.ordinates.clear();
+	if (ordinates)
+		geometry.ordinates = *ordinates;
+	geometry.faces.clear();
+	geometry.polygonOffset = false;
+
+	switch (type) {
+	case kCubeType:
+		buildCube(geometry, origin, size);
+		break;
+	case kRectangleType:
+		buildRectangle(geometry, origin, size);
+		break;
+	case kEastPyramidType:
+	case kWestPyramidType:
+	case kUpPyramidType:
+	case kDownPyramidType:
+	case kNorthPyramidType:
+	case kSouthPyramidType:
+		buildPyramid(geometry, origin, size, ordinates, type);
+		break;
+	default:
+		buildPolygon(geometry, origin, size, ordinates);
+		break;
+	}
+}
+
+void Renderer::renderGeometry(const ObjectGeometry &geometry, Common::Array<uint8> *colours) {
+	byte *stipple = nullptr;
+	uint8 r1, g1, b1, r2, g2, b2;
+
+	if (geometry.polygonOffset)
+		polygonOffset(true);
+
+	for (uint i = 0; i < geometry.faces.size(); i++) {
+		const ObjectGeometry::Face &face = geometry.faces[i];
+		if (!getRGBAt((*colours)[face.colour], r1, g1, b1, r2, g2, b2, stipple))
+			continue;
+
+		setStippleData(stipple);
+		useColor(r1, g1, b1);
+		renderFace(face.vertices);
+		if (r1 != r2 || g1 != g2 || b1 != b2) {
+			useStipple(true);
+			useColor(r2, g2, b2);
+			renderFace(face.vertices);
+			useStipple(false);
+		}
+	}
+
+	if (geometry.polygonOffset)
+		polygonOffset(false);
+}
+
+void Renderer::buildPyramid(ObjectGeometry &geometry, const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates, int type) {
 	Math::Vector3d vertices[8] = { origin, origin, origin, origin, origin, origin, origin, origin };
 	switch (type) {
 	default:
@@ -600,234 +675,64 @@ void Renderer::renderPyramid(const Math::Vector3d &origin, const Math::Vector3d
 		break;
 	}
 
-	Common::Array<Math::Vector3d> face;
-	byte *stipple = nullptr;
-	uint8 r1, g1, b1, r2, g2, b2;
-	if (getRGBAt((*colours)[0], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-
-		face.push_back(vertices[4]);
-		face.push_back(vertices[5]);
-		face.push_back(vertices[1]);
-		face.push_back(vertices[0]);
+	// The corners of each face, one face per colour
+	static const int faceCorners[6][4] = {
+		{ 4, 5, 1, 0 },
+		{ 5, 6, 2, 1 },
+		{ 6, 7, 3, 2 },
+		{ 7, 4, 0, 3 },
+		{ 0, 1, 2, 3 },
+		{ 7, 6, 5, 4 }
+	};
 
-		renderFace(face);
-
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-
-		face.clear();
-	}
-
-	if (getRGBAt((*colours)[1], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-
-		face.push_back(vertices[5]);
-		face.push_back(vertices[6]);
-		face.push_back(vertices[2]);
-		face.push_back(vertices[1]);
-
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-
-		face.clear();
-	}
-
-	if (getRGBAt((*colours)[2], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-
-		face.push_back(vertices[6]);
-		face.push_back(vertices[7]);
-		face.push_back(vertices[3]);
-		face.push_back(vertices[2]);
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-
-		face.clear();
-	}
-
-	if (getRGBAt((*colours)[3], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-
-		face.push_back(vertices[7]);
-		face.push_back(vertices[4]);
-		face.push_back(vertices[0]);
-		face.push_back(vertices[3]);
-
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-
-		face.clear();
-	}
-
-	if (getRGBAt((*colours)[4], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-
-		face.push_back(vertices[0]);
-		face.push_back(vertices[1]);
-		face.push_back(vertices[2]);
-		face.push_back(vertices[3]);
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-
-		face.clear();
-	}
-
-	if (getRGBAt((*colours)[5], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-
-		face.push_back(vertices[7]);
-		face.push_back(vertices[6]);
-		face.push_back(vertices[5]);
-		face.push_back(vertices[4]);
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
+	for (uint i = 0; i < 6; i++) {
+		Common::Array<Math::Vector3d> &face = geometry.addFace(i);
+		for (uint j = 0; j < 4; j++)
+			face.push_back(vertices[faceCorners[i][j]]);
 	}
 }
 
-void Renderer::renderCube(const Math::Vector3d &origin, const Math::Vector3d &size, Common::Array<uint8> *colours) {
-	byte *stipple = nullptr;
-	uint8 r1, g1, b1, r2, g2, b2;
-	Common::Array<Math::Vector3d> face;
-
-	if (getRGBAt((*colours)[0], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		face.push_back(origin);
-		face.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z()));
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-	}
-
-	if (getRGBAt((*colours)[1], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		face.clear();
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z()));
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-	}
-
-	if (getRGBAt((*colours)[2], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		face.clear();
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z()));
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-	}
-
-	if (getRGBAt((*colours)[3], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		face.clear();
-		face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z()));
-		face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z()));
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-	}
-
-	if (getRGBAt((*colours)[4], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		face.clear();
-		face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z()));
-		face.push_back(origin);
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-	}
-
-	if (getRGBAt((*colours)[5], r1, g1, b1, r2, g2, b2, stipple)) {
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		face.clear();
-		face.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
-		face.push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z() + size.z()));
-		renderFace(face);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(face);
-			useStipple(false);
-		}
-	}
+void Renderer::buildCube(ObjectGeometry &geometry, const Math::Vector3d &origin, const Math::Vector3d &size) {
+	Common::Array<Math::Vector3d> *face;
+
+	face = &geometry.addFace(0);
+	face->push_back(origin);
+	face->push_back(Math::Vector3d(origin.x(), origin.y(), origin.z() + size.z()));
+	face->push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z() + size.z()));
+	face->push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z()));
+
+	face = &geometry.addFace(1);
+	face->push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z()));
+	face->push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
+	face->push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z() + size.z()));
+	face->push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z()));
+
+	face = &geometry.addFace(2);
+	face->push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z()));
+	face->push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z() + size.z()));
+	face->push_back(Math::Vector3d(origin.x(), origin.y(), origin.z() + size.z()));
+	face->push_back(Math::Vector3d(origin.x(), origin.y(), origin.z()));
+
+	face = &geometry.addFace(3);
+	face->push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z()));
+	face->push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z() + size.z()));
+	face->push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
+	face->push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z()));
+
+	face = &geometry.addFace(4);
+	face->push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z()));
+	face->push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z()));
+	face->push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z()));
+	face->push_back(origin);
+
+	face = &geometry.addFace(5);
+	face->push_back(Math::Vector3d(origin.x(), origin.y(), origin.z() + size.z()));
+	face->push_back(Math::Vector3d(origin.x() + size.x(), origin.y(), origin.z() + size.z()));
+	face->push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
+	face->push_back(Math::Vector3d(origin.x(), origin.y() + size.y(), origin.z() + size.z()));
 }
 
-void Renderer::renderRectangle(const Math::Vector3d &origin, const Math::Vector3d &originalSize, Common::Array<uint8> *colours) {
+void Renderer::buildRectangle(ObjectGeometry &geometry, const Math::Vector3d &origin, const Math::Vector3d &originalSize) {
 
 	Math::Vector3d size = originalSize;
 	if (size.x() > 0 && size.y() > 0 && size.z() > 0) {
@@ -855,127 +760,81 @@ void Renderer::renderRectangle(const Math::Vector3d &origin, const Math::Vector3
 			error("Invalid size!");
 	}
 
-	polygonOffset(true);
+	geometry.polygonOffset = true;
 
 	float dx, dy, dz;
-	uint8 r1, g1, b1, r2, g2, b2;
-	byte *stipple = nullptr;
 	Common::Array<Math::Vector3d> vertices;
-	for (int i = 0; i < 2; i++) {
-
-		// debug("rec color: %d", (*colours)[i]);
-		if (getRGBAt((*colours)[i], r1, g1, b1, r2, g2, b2, stipple)) {
-			setStippleData(stipple);
-			useColor(r1, g1, b1);
-			vertices.clear();
-			vertices.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z()));
-
-			dx = dy = dz = 0.0;
-			if (size.x() == 0) {
-				dy = size.y();
-			} else if (size.y() == 0) {
-				dx = size.x();
-			} else if (size.z() == 0) {
-				dx = size.x();
-			}
+	vertices.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z()));
 
-			vertices.push_back(Math::Vector3d(origin.x() + dx, origin.y() + dy, origin.z() + dz));
-			vertices.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
-			vertices.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z()));
-
-			dx = dy = dz = 0.0;
-			if (size.x() == 0) {
-				dz = size.z();
-			} else if (size.y() == 0) {
-				dz = size.z();
-			} else if (size.z() == 0) {
-				dy = size.y();
-			}
+	dx = dy = dz = 0.0;
+	if (size.x() == 0) {
+		dy = size.y();
+	} else if (size.y() == 0) {
+		dx = size.x();
+	} else if (size.z() == 0) {
+		dx = size.x();
+	}
 
-			vertices.push_back(Math::Vector3d(origin.x() + dx, origin.y() + dy, origin.z() + dz));
-			vertices.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
-			renderFace(vertices);
-			if (r1 != r2 || g1 != g2 || b1 != b2) {
-				useStipple(true);
-				useColor(r2, g2, b2);
-				renderFace(vertices);
-				useStipple(false);
-			}
-		}
+	vertices.push_back(Math::Vector3d(origin.x() + dx, origin.y() + dy, origin.z() + dz));
+	vertices.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
+	vertices.push_back(Math::Vector3d(origin.x(), origin.y(), origin.z()));
+
+	dx = dy = dz = 0.0;
+	if (size.x() == 0) {
+		dz = size.z();
+	} else if (size.y() == 0) {
+		dz = size.z();
+	} else if (size.z() == 0) {
+		dy = size.y();
 	}
-	polygonOffset(false);
+
+	vertices.push_back(Math::Vector3d(origin.x() + dx, origin.y() + dy, origin.z() + dz));
+	vertices.push_back(Math::Vector3d(origin.x() + size.x(), origin.y() + size.y(), origin.z() + size.z()));
+
+	// Both sides use the same vertices
+	geometry.addFace(0) = vertices;
+	geometry.addFace(1) = vertices;
 }
 
-void Renderer::renderPolygon(const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates, Common::Array<uint8> *colours) {
-	uint8 r1, g1, b1, r2, g2, b2;
-	byte *stipple = nullptr;
+void Renderer::buildPolygon(ObjectGeometry &geometry, const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates) {
 	if (ordinates->size() % 3 > 0 && ordinates->size() > 0)
 		error("Invalid polygon with size %f %f %f and ordinates %d", size.x(), size.y(), size.z(), ordinates->size());
 
-	Common::Array<Math::Vector3d> vertices;
-	polygonOffset(true);
+	geometry.polygonOffset = true;
 
-	if (ordinates->size() == 6) {                 // Line
-		assert(getRGBAt((*colours)[0], r1, g1, b1, r2, g2, b2, stipple)); // It will never return false?
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		for (uint i = 0; i < ordinates->size(); i = i + 3)
-			vertices.push_back(Math::Vector3d((*ordinates)[i], (*ordinates)[i + 1], (*ordinates)[i + 2]));
-		renderFace(vertices);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(vertices);
-			useStipple(false);
-		}
+	// The front face, then the back face with the vertices in reverse order.
+	// A polygon with two vertices is a line.
+	Common::Array<Math::Vector3d> &front = geometry.addFace(0);
+	for (uint i = 0; i < ordinates->size(); i = i + 3)
+		front.push_back(Math::Vector3d((*ordinates)[i], (*ordinates)[i + 1], (*ordinates)[i + 2]));
 
-		vertices.clear();
-		assert(getRGBAt((*colours)[1], r1, g1, b1, r2, g2, b2, stipple)); // It will never return false?
-		setStippleData(stipple);
-		useColor(r1, g1, b1);
-		for (int i = ordinates->size(); i > 0; i = i - 3)
-			vertices.push_back(Math::Vector3d((*ordinates)[i - 3], (*ordinates)[i - 2], (*ordinates)[i - 1]));
-		renderFace(vertices);
-		if (r1 != r2 || g1 != g2 || b1 != b2) {
-			useStipple(true);
-			useColor(r2, g2, b2);
-			renderFace(vertices);
-			useStipple(false);
-		}
+	Common::Array<Math::Vector3d> &back = geometry.addFace(1);
+	for (int i = ordinates->size(); i > 0; i = i - 3)
+		back.push_back(Math::Vector3d((*ordinates)[i - 3], (*ordinates)[i - 2], (*ordinates)[i - 1]));
+}
 
-	} else {
-		if (getRGBAt((*colours)[0], r1, g1, b1, r2, g2, b2, stipple)) {
-			setStippleData(stipple);
-			useColor(r1, g1, b1);
-			for (uint i = 0; i < ordinates->size(); i = i + 3) {
-				vertices.push_back(Math::Vector3d((*ordinates)[i], (*ordinates)[i + 1], (*ordinates)[i + 2]));
-			}
-			renderFace(vertices);
-			if (r1 != r2 || g1 != g2 || b1 != b2) {
-				useStipple(true);
-				useColor(r2, g2, b2);
-				renderFace(vertices);
-				useStipple(false);
-			}
-		}
-		vertices.clear();
-		if (getRGBAt((*colours)[1], r1, g1, b1, r2, g2, b2, stipple)) {
-			setStippleData(stipple);
-			useColor(r1, g1, b1);
-			for (int i = ordinates->size(); i > 0; i = i - 3) {
-				vertices.push_back(Math::Vector3d((*ordinates)[i - 3], (*ordinates)[i - 2], (*ordinates)[i - 1]));
-			}
-			renderFace(vertices);
-			if (r1 != r2 || g1 != g2 || b1 != b2) {
-				useStipple(true);
-				useColor(r2, g2, b2);
-				renderFace(vertices);
-				useStipple(false);
-			}
-		}
-	}
+void Renderer::renderPyramid(const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates, Common::Array<uint8> *colours, int type) {
+	ObjectGeometry geometry;
+	updateGeometry(geometry, type, origin, size, ordinates);
+	renderGeometry(geometry, colours);
+}
 
-	polygonOffset(false);
+void Renderer::renderCube(const Math::Vector3d &origin, const Math::Vector3d &size, Common::Array<uint8> *colours) {
+	ObjectGeometry geometry;
+	updateGeometry(geometry, kCubeType, origin, size, nullptr);
+	renderGeometry(geometry, colours);
+}
+
+void Renderer::renderRectangle(const Math::Vector3d &origin, const Math::Vector3d &size, Common::Array<uint8> *colours) {
+	ObjectGeometry geometry;
+	updateGeometry(geometry, kRectangleType, origin, size, nullptr);
+	renderGeometry(geometry, colours);
+}
+
+void Renderer::renderPolygon(const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates, Common::Array<uint8> *colours) {
+	ObjectGeometry geometry;
+	updateGeometry(geometry, kTriangleType, origin, size, ordinates);
+	renderGeometry(geometry, colours);
 }
 
 void Renderer::drawBackground(uint8 color) {
@@ -41,6 +41,35 @@ typedef Common::HashMap<int, int> ColorReMap;
 
 class Renderer;
 
+/**
+ * The faces of an object, built from its type, origin, size and ordinates.
+ *
+ * Most objects of an area never move, so GeometricObject keeps its geometry
+ * between frames and the renderer only builds it again when the object
+ * changes. The colours are looked up whenever the faces are drawn, since
+ * they depend on the palette and on the colour remaps of the area.
+ */
+struct ObjectGeometry {
+	struct Face {
+		uint colour; ///< Index of the face in the colours of the object
+		Common::Array<Math::Vector3d> vertices;
+	};
+
+	ObjectGeometry() : type(-1), polygonOffset(false) {}
+
+	/** Check whether the geometry was built from these parameters. */
+	bool matches(int type_, const Math::Vector3d &origin_, const Math::Vector3d &size_, const Common::Array<uint16> *ordinates_) const;
+	Common::Array<Math::Vector3d> &addFace(uint colour);
+
+	int type;
+	Math::Vector3d origin;
+	Math::Vector3d size;
+	Common::Array<uint16> ordinates;
+
+	bool polygonOffset;
+	Common::Array<Face> faces;
+};
+
 class Texture {
 public:
 	Texture(){ _width = 0; _height = 0; };
@@ -94,6 +123,10 @@ public:
 	virtual void renderPyramid(const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates, Common::Array<uint8> *colours, int type);
 	virtual void renderFace(const Common::Array<Math::Vector3d> &vertices) = 0;
 
+	/** Build @p geometry again, unless it was built from the same parameters. */
+	void updateGeometry(ObjectGeometry &geometry, int type, const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates);
+	void renderGeometry(const ObjectGeometry &geometry, Common::Array<uint8> *colours);
+
 	void setColorRemaps(ColorReMap *colorRemaps);
 	virtual void clear(uint8 r, uint8 g, uint8 b, bool ignoreViewport = false) = 0;
 	virtual void drawFloor(uint8 color) = 0;
@@ -167,6 +200,12 @@ protected:
 	Math::Frustum _frustum;
 
 	Math::Matrix4 makeProjectionMatrix(float fov, float nearClipPlane, float farClipPlane) const;
+
+private:
+	void buildCube(ObjectGeometry &geometry, const Math::Vector3d &origin, const Math::Vector3d &size);
+	void buildRectangle(ObjectGeometry &geometry, const Math::Vector3d &origin, const Math::Vector3d &size);
+	void buildPolygon(ObjectGeometry &geometry, const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates);
+	void buildPyramid(ObjectGeometry &geometry, const Math::Vector3d &origin, const Math::Vector3d &size, const Common::Array<uint16> *ordinates, int type);
 };
 
 Graphics::RendererType determinateRenderType();
@@ -413,18 +413,19 @@ bool GeometricObject::collides(const Math::AABB &boundingBox_) {
 }
 
 void GeometricObject::draw(Renderer *gfx) {
-	if (this->getType() == kCubeType) {
-		gfx->renderCube(_origin, _size, _colours);
-	} else if (this->getType() == kRectangleType) {
-		gfx->renderRectangle(_origin, _size, _colours);
+	if (this->getType() == kCubeType || this->getType() == kRectangleType) {
+		gfx->updateGeometry(_geometry, this->getType(), _origin, _size, nullptr);
 	} else if (isPyramid(this->getType())) {
-		gfx->renderPyramid(_origin, _size, _ordinates, _colours, this->getType());
+		gfx->updateGeometry(_geometry, this->getType(), _origin, _size, _ordinates);
 	} else if (this->isPlanar() && _type <= 14) {
 		if (this->getType() == kTriangleType)
 			assert(_ordinates->size() == 9);
 
-		gfx->renderPolygon(_origin, _size, _ordinates, _colours);
-	}
+		gfx->updateGeometry(_geometry, this->getType(), _origin, _size, _ordinates);
+	} else
+		return;
+
+	gfx->renderGeometry(_geometry, _colours);
 }
 
 } // End of namespace Freescape
@@ -68,6 +68,9 @@ private:
 	Common::Array<uint8> *_colours;
 	Common::Array<uint16> *_ordinates;
 	Common::Array<uint16> *_initialOrdinates;
+
+	// The faces drawn in the last frame
+	ObjectGeometry _geometry;
 };
 
 } // End of namespace Freescape
@@ -22,6 +22,7 @@
 #include "glk/events.h"
 #include "glk/conf.h"
 #include "glk/glk.h"
+#include "glk/replay.h"
 #include "glk/screen.h"
 #include "glk/selection.h"
 #include "glk/sound.h"
@@ -124,7 +125,8 @@ void Events::getEvent(event_t *event, bool polled) {
 	if (!polled) {
 		while (!g_vm->shouldQuit() && _currentEvent->type == evtype_None && !isTimerExpired()) {
 			pollEvents();
-			g_system->delayMillis(10);
+			if (!g_vm->_replay || !g_vm->_replay->feedInput())
+				g_system->delayMillis(10);
 
 			dispatchEvent(*_currentEvent, polled);
 		}
@@ -24,6 +24,7 @@
 #include "common/debug-channels.h"
 #include "common/events.h"
 #include "common/file.h"
+#include "common/fs.h"
 #include "common/language.h"
 #include "engines/util.h"
 #include "graphics/scaler.h"
@@ -34,6 +35,7 @@
 #include "glk/debugger.h"
 #include "glk/events.h"
 #include "glk/picture.h"
+#include "glk/replay.h"
 #include "glk/screen.h"
 #include "glk/selection.h"
 #include "glk/sound.h"
@@ -47,7 +49,7 @@ GlkEngine *g_vm;
 
 GlkEngine::GlkEngine(OSystem *syst, const GlkGameDescription &gameDesc) :
 		_gameDescription(gameDesc), Engine(syst), _random("Glk"), _quitFlag(false), _blorb(nullptr),
-		_clipboard(nullptr), _conf(nullptr),_events(nullptr), _pictures(nullptr), _screen(nullptr),
+		_clipboard(nullptr), _conf(nullptr),_events(nullptr), _pictures(nullptr), _replay(nullptr), _screen(nullptr),
 		_selection(nullptr), _sounds(nullptr), _streams(nullptr), _windows(nullptr),
 		_copySelect(false), _terminated(false), _pcSpeaker(nullptr), _loadSaveSlot(-1),
 		gli_register_obj(nullptr), gli_unregister_obj(nullptr), gli_register_arr(nullptr),
@@ -62,6 +64,7 @@ GlkEngine::~GlkEngine() {
 	delete _events;
 	delete _pcSpeaker;
 	delete _pictures;
+	delete _replay;
 	delete _screen;
 	delete _selection;
 	delete _sounds;
@@ -89,6 +92,15 @@ void GlkEngine::initialize() {
 	_streams = new Streams();
 	_windows = new Windows(_screen);
 
+	// Play back a transcript of commands, to measure the speed of the interpreter
+	if (ConfMan.hasKey("glk_replay")) {
+		Common::SeekableReadStream *stream = Common::FSNode(ConfMan.getPath("glk_replay")).createReadStream();
+		if (stream)
+			_replay = new Replay(stream);
+		else
+			warning("Could not open the replay transcript");
+	}
+
 	// Setup mixer
 	syncSoundSettings();
 }
@@ -40,6 +40,7 @@ class Blorb;
 class Conf;
 class Events;
 class Pictures;
+class Replay;
 class Screen;
 class Selection;
 class Sounds;
@@ -118,6 +119,7 @@ public:
 	Conf *_conf;
 	Events *_events;
 	Pictures *_pictures;
+	Replay *_replay;
 	Screen *_screen;
 	Selection *_selection;
 	Streams *_streams;
@@ -154,6 +156,12 @@ public:
 	 */
 	virtual InterpreterType getInterpreterType() const = 0;
 
+	/**
+	 * Returns the number of instructions the interpreter has executed, for the
+	 * interpreters that count them
+	 */
+	virtual uint64 getInstructionCount() const { return 0; }
+
 	/**
 	 * Returns the game's Id
 	 */
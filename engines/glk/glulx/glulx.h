@@ -72,6 +72,7 @@ private:
 	uint endmem;
 	uint protectstart, protectend;
 	uint prevpc;
+	uint64 instruction_count;
 
 	/**@}*/
 
@@ -145,6 +146,11 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * The decoded instructions in ROM, indexed by the low bits of their address
+	 */
+	decodedinst_t *decodedinst_cache;
+
 	/**@}*/
 
 	/**
@@ -410,6 +416,13 @@ public:
 		return INTERPRETER_GLULX;
 	}
 
+	/**
+	 * Returns the number of instructions executed
+	 */
+	uint64 getInstructionCount() const override {
+		return instruction_count;
+	}
+
 	/**
 	 * Loads Quetzal chunks from the passed savegame
 	 */
@@ -543,13 +556,30 @@ public:
 	const operandlist_t *lookup_operandlist(uint opcode);
 
 	/**
-	 * Read the list of operands of an instruction, and put the values in args. This assumes
-	 * that the PC is at the beginning of the operand mode list (right after an opcode number.)
-	 * Upon return, the PC will be at the beginning of the next instruction.
-	 *
-	 * This also assumes that args points at an allocated array of MAX_OPERANDS oparg_t structures.
-	*/
-	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
+	 * Read the opcode number and the operand modes of the instruction at the PC. Upon return,
+	 * the PC will be at the beginning of the next instruction.
+	 */
+	void decode_instruction(decodedinst_t *inst);
+
+	/**
+	 * Read the list of operand modes of an instruction, with their constants and addresses.
+	 * This assumes that the PC is at the beginning of the operand mode list (right after an
+	 * opcode number.) Upon return, the PC will be at the beginning of the next instruction.
+	 */
+	void decode_operands(decodedinst_t *inst, const operandlist_t *oplist);
+
+	/**
+	 * Load the operand values of a decoded instruction into args. This assumes that args
+	 * points at an allocated array of MAX_OPERANDS oparg_t structures.
+	 */
+	void load_operands(oparg_t *opargs, const decodedinst_t *inst);
+
+	/**
+	 * Decode the instruction at the PC, or look it up in the cache of decoded instructions if
+	 * it's in ROM. Instructions in RAM get decoded into scratch. Upon return, the PC will be
+	 * at the beginning of the next instruction.
+	 */
+	const decodedinst_t *fetch_instruction(decodedinst_t *scratch);
 
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
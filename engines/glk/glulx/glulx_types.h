@@ -351,6 +351,26 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * Represents an instruction with its opcode and operand modes decoded, so that executing it again
+ * doesn't need to read them from memory. Only instructions in ROM are kept decoded, as ROM
+ * can't be written to.
+ */
+struct decodedinst_struct {
+	uint addr;                      ///< Address of the instruction, or 0xFFFFFFFF for an unused entry
+	uint nextpc;                    ///< Address of the following instruction
+	uint opcode;
+	const operandlist_t *oplist;
+	byte modes[MAX_OPERANDS];       ///< Addressing mode of each operand
+	uint operands[MAX_OPERANDS];    ///< Constant value, address or locals offset of each operand
+};
+typedef decodedinst_struct decodedinst_t;
+
+/**
+ * Number of entries of the decoded instruction cache. Must be a power of two.
+ */
+#define DECODEDINST_CACHE_SIZE (8192)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
@@ -66,6 +66,14 @@ static const operandlist_t list_LLSS = { 4, 4, &array_LLSS[0] };
 void Glulx::init_operands() {
 	for (int ix = 0; ix < 0x80; ix++)
 		fast_operandlist[ix] = lookup_operandlist(ix);
+
+	if (!decodedinst_cache) {
+		decodedinst_cache = (decodedinst_t *)glulx_malloc(DECODEDINST_CACHE_SIZE * sizeof(decodedinst_t));
+		if (!decodedinst_cache)
+			fatal_error("Unable to allocate the decoded instruction cache.");
+	}
+	/* No entry matches an address until it has been filled. */
+	memset(decodedinst_cache, 0xFF, DECODEDINST_CACHE_SIZE * sizeof(decodedinst_t));
 }
 
 const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
@@ -279,22 +287,83 @@ const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
 	}
 }
 
-void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
+void Glulx::decode_instruction(decodedinst_t *inst) {
+	uint opcode;
+
+	inst->addr = pc;
+
+	/* Fetch the opcode number. */
+	opcode = Mem1(pc);
+	pc++;
+	if (opcode & 0x80) {
+		/* More than one-byte opcode. */
+		if (opcode & 0x40) {
+			/* Four-byte opcode */
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(pc);
+			pc++;
+			opcode = (opcode << 8) | Mem1(pc);
+			pc++;
+			opcode = (opcode << 8) | Mem1(pc);
+			pc++;
+		} else {
+			/* Two-byte opcode */
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(pc);
+			pc++;
+		}
+	}
+
+	/* Fetch the structure that describes how the operands for this
+	   opcode are arranged. This is a pointer to an immutable,
+	   static object. */
+	inst->opcode = opcode;
+	if (opcode < 0x80)
+		inst->oplist = fast_operandlist[opcode];
+	else
+		inst->oplist = lookup_operandlist(opcode);
+
+	if (!inst->oplist)
+		fatal_error_i("Encountered unknown opcode.", opcode);
+
+	decode_operands(inst, inst->oplist);
+	inst->nextpc = pc;
+}
+
+const decodedinst_t *Glulx::fetch_instruction(decodedinst_t *scratch) {
+	decodedinst_t *inst;
+
+	if (pc >= ramstart || !decodedinst_cache) {
+		decode_instruction(scratch);
+		return scratch;
+	}
+
+	inst = &decodedinst_cache[pc & (DECODEDINST_CACHE_SIZE - 1)];
+	if (inst->addr == pc) {
+		pc = inst->nextpc;
+		return inst;
+	}
+
+	decode_instruction(inst);
+
+	/* An instruction reaching into RAM can't be kept, as that part may change. */
+	if (pc > ramstart)
+		inst->addr = 0xFFFFFFFF;
+	return inst;
+}
+
+void Glulx::decode_operands(decodedinst_t *inst, const operandlist_t *oplist) {
 	int ix;
-	oparg_t *curarg;
 	int numops = oplist->num_ops;
-	int argsize = oplist->arg_size;
 	uint modeaddr = pc;
 	int modeval = 0;
 
+	inst->oplist = oplist;
 	pc += (numops + 1) / 2;
 
-	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
+	for (ix = 0; ix < numops; ix++) {
 		int mode;
-		uint value;
-		uint addr;
-
-		curarg->desttype = 0;
+		uint value = 0;
 
 		if ((ix & 1) == 0) {
 			modeval = Mem1(modeaddr);
@@ -304,9 +373,97 @@ void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
 			modeaddr++;
 		}
 
+		switch (mode) {
+
+		case 0: /* constant zero, or discard value */
+		case 8: /* pop off stack, or push on stack */
+			break;
+
+		case 1: /* one-byte constant */
+			/* Sign-extend from 8 bits to 32 */
+			value = (int)(signed char)(Mem1(pc));
+			pc++;
+			break;
+
+		case 2: /* two-byte constant */
+			/* Sign-extend the first byte from 8 bits to 32; the subsequent
+			   byte must not be sign-extended. */
+			value = (int)(signed char)(Mem1(pc));
+			pc++;
+			value = (value << 8) | (uint)(Mem1(pc));
+			pc++;
+			break;
+
+		case 3: /* four-byte constant */
+			/* Bytes must not be sign-extended. */
+			value = Mem4(pc);
+			pc += 4;
+			break;
+
+		case 15: /* main memory RAM, four-byte address */
+			value = Mem4(pc) + ramstart;
+			pc += 4;
+			break;
+
+		case 14: /* main memory RAM, two-byte address */
+			value = (uint)Mem2(pc) + ramstart;
+			pc += 2;
+			break;
+
+		case 13: /* main memory RAM, one-byte address */
+			value = (uint)(Mem1(pc)) + ramstart;
+			pc++;
+			break;
+
+		case 7: /* main memory, four-byte address */
+		case 11: /* locals, four-byte address */
+			value = Mem4(pc);
+			pc += 4;
+			break;
+
+		case 6: /* main memory, two-byte address */
+		case 10: /* locals, two-byte address */
+			value = (uint)Mem2(pc);
+			pc += 2;
+			break;
+
+		case 5: /* main memory, one-byte address */
+		case 9: /* locals, one-byte address */
+			value = (uint)(Mem1(pc));
+			pc++;
+			break;
+
+		default:
+			if (oplist->formlist[ix] == modeform_Load)
+				fatal_error("Unknown addressing mode in load operand.");
+			else
+				fatal_error("Unknown addressing mode in store operand.");
+		}
+
+		if (oplist->formlist[ix] == modeform_Store && mode >= 1 && mode <= 3)
+			fatal_error("Constant addressing mode in store operand.");
+
+		inst->modes[ix] = mode;
+		inst->operands[ix] = value;
+	}
+}
+
+void Glulx::load_operands(oparg_t *args, const decodedinst_t *inst) {
+	int ix;
+	oparg_t *curarg;
+	const operandlist_t *oplist = inst->oplist;
+	int numops = oplist->num_ops;
+	int argsize = oplist->arg_size;
+
+	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
+		uint value;
+		uint addr = inst->operands[ix];
+
+		curarg->desttype = 0;
+
 		if (oplist->formlist[ix] == modeform_Load) {
 
-			switch (mode) {
+			switch (inst->modes[ix]) {
 
 			case 8: /* pop off stack */
 				if (stackptr < valstackbase + 4) {
@@ -317,65 +474,18 @@ void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
 				break;
 
 			case 0: /* constant zero */
-				value = 0;
-				break;
-
 			case 1: /* one-byte constant */
-				/* Sign-extend from 8 bits to 32 */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				break;
-
 			case 2: /* two-byte constant */
-				/* Sign-extend the first byte from 8 bits to 32; the subsequent
-				   byte must not be sign-extended. */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				value = (value << 8) | (uint)(Mem1(pc));
-				pc++;
-				break;
-
 			case 3: /* four-byte constant */
-				/* Bytes must not be sign-extended. */
-				value = Mem4(pc);
-				pc += 4;
+				value = addr;
 				break;
 
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto MainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto MainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto MainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto MainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto MainMemAddr;
-
 			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-MainMemAddr:
-				/* cases 5, 6, 7, 13, 14, 15 all wind up here. */
+			case 6: /* main memory, two-byte address */
+			case 7: /* main memory, four-byte address */
+			case 13: /* main memory RAM, one-byte address */
+			case 14: /* main memory RAM, two-byte address */
+			case 15: /* main memory RAM, four-byte address */
 				if (argsize == 4) {
 					value = Mem4(addr);
 				} else if (argsize == 2) {
@@ -385,27 +495,11 @@ MainMemAddr:
 				}
 				break;
 
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto LocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto LocalsAddr;
-
-			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-LocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
+			default: /* locals, cases 9, 10 and 11 */
+				/* It's illegal for addr to not be four-byte aligned, but we
+				   don't check this explicitly. A "strict mode" interpreter
+				   probably should. It's also illegal for addr to be less than
+				   zero or greater than the size of the locals segment. */
 				addr += localsbase;
 				if (argsize == 4) {
 					value = Stk4(addr);
@@ -415,16 +509,12 @@ LocalsAddr:
 					value = Stk1(addr);
 				}
 				break;
-
-			default:
-				value = 0;
-				fatal_error("Unknown addressing mode in load operand.");
 			}
 
 			curarg->value = value;
 
 		} else { /* modeform_Store */
-			switch (mode) {
+			switch (inst->modes[ix]) {
 
 			case 0: /* discard value */
 				curarg->desttype = 0;
@@ -436,66 +526,9 @@ LocalsAddr:
 				curarg->value = 0;
 				break;
 
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto WrMainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrMainMemAddr:
-				/* cases 5, 6, 7 all wind up here. */
-				curarg->desttype = 1;
-				curarg->value = addr;
-				break;
-
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrLocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrLocalsAddr;
-
 			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrLocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
+			case 10: /* locals, two-byte address */
+			case 11: /* locals, four-byte address */
 				curarg->desttype = 2;
 				/* We don't add localsbase here; the store address for desttype 2
 				   is relative to the current locals segment, not an absolute
@@ -503,14 +536,10 @@ WrLocalsAddr:
 				curarg->value = addr;
 				break;
 
-			case 1:
-			case 2:
-			case 3:
-				fatal_error("Constant addressing mode in store operand.");
+			default: /* main memory, cases 5, 6, 7, 13, 14 and 15 */
+				curarg->desttype = 1;
+				curarg->value = addr;
 				break;
-
-			default:
-				fatal_error("Unknown addressing mode in store operand.");
 			}
 		}
 	}
@@ -114,6 +114,10 @@ void Glulx::finalize_vm() {
 		glulx_free(stack);
 		stack = nullptr;
 	}
+	if (decodedinst_cache) {
+		glulx_free(decodedinst_cache);
+		decodedinst_cache = nullptr;
+	}
 
 	final_serial();
 }
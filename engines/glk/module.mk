@@ -14,6 +14,7 @@ MODULE_OBJS := \
 	picture.o \
 	quetzal.o \
 	raw_decoder.o \
+	replay.o \
 	screen.o \
 	selection.o \
 	sound.o \
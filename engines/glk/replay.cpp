@@ -0,0 +1,107 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "glk/replay.h"
+#include "glk/glk.h"
+#include "glk/windows.h"
+#include "common/debug.h"
+#include "common/system.h"
+#include "common/ustr.h"
+
+namespace Glk {
+
+Replay::Replay(Common::SeekableReadStream *stream) : _stream(stream), _turnRunning(false),
+		_turnStart(0), _turnTime(0), _longestTurn(0), _turns(0) {
+	_startTime = g_system->getMillis();
+	_startInstructions = g_vm->getInstructionCount();
+}
+
+Replay::~Replay() {
+	delete _stream;
+}
+
+bool Replay::feedInput() {
+	Windows &windows = *g_vm->_windows;
+
+	if (_turnRunning)
+		endTurn();
+
+	// Page through [more] prompts
+	if (Windows::_moreFocus) {
+		windows.inputHandleKey(keycode_PageDown);
+		return true;
+	}
+
+	bool lineRequest = false, charRequest = false;
+	for (Windows::iterator i = windows.begin(); i != windows.end(); ++i) {
+		lineRequest |= (*i)->_lineRequest || (*i)->_lineRequestUni;
+		charRequest |= (*i)->_charRequest || (*i)->_charRequestUni;
+	}
+
+	if (lineRequest) {
+		if (_stream->eos() || _stream->pos() >= _stream->size()) {
+			report();
+			g_vm->quitGame();
+			return false;
+		}
+
+		Common::U32String command = _stream->readLine().decode(Common::kUtf8);
+
+		// Leave scrollback, in case it was entered, then type the command
+		windows.inputHandleKey(keycode_End);
+		for (uint i = 0; i < command.size(); ++i)
+			windows.inputHandleKey(command[i]);
+
+		_turnStart = g_system->getMillis();
+		_turnRunning = true;
+		windows.inputHandleKey(keycode_Return);
+		return true;
+	} else if (charRequest) {
+		// Key presses don't use up commands
+		windows.inputHandleKey(keycode_Return);
+		return true;
+	}
+
+	return false;
+}
+
+void Replay::endTurn() {
+	const uint32 time = g_system->getMillis() - _turnStart;
+
+	_turnTime += time;
+	_longestTurn = MAX(_longestTurn, time);
+	++_turns;
+	_turnRunning = false;
+}
+
+void Replay::report() {
+	const uint32 totalTime = g_system->getMillis() - _startTime;
+	const uint64 instructions = g_vm->getInstructionCount() - _startInstructions;
+
+	debug("Replay: %u commands in %u ms", _turns, totalTime);
+	if (_turns)
+		debug("Replay: %u ms per command on average, %u ms for the longest", _turnTime / _turns, _longestTurn);
+	if (instructions && totalTime)
+		debug("Replay: %llu instructions, %llu per second", (unsigned long long)instructions,
+			(unsigned long long)(instructions * 1000 / totalTime));
+}
+
+} // End of namespace Glk
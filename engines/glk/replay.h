@@ -0,0 +1,76 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GLK_REPLAY_H
+#define GLK_REPLAY_H
+
+#include "common/stream.h"
+
+namespace Glk {
+
+/**
+ * Plays back a transcript of commands, one per line, as the line input of the game, and reports
+ * how long the interpreter took for each of them. This allows to measure the speed of the
+ * interpreters without playing. It is enabled by setting the glk_replay option of a game
+ * to the transcript file. The game quits once all commands have been played back.
+ */
+class Replay {
+private:
+	Common::SeekableReadStream *_stream;
+	bool _turnRunning;
+	uint32 _startTime;
+	uint32 _turnStart;
+	uint32 _turnTime;
+	uint32 _longestTurn;
+	uint _turns;
+	uint64 _startInstructions;
+private:
+	/**
+	 * Finishes the timing of the current turn
+	 */
+	void endTurn();
+
+	/**
+	 * Prints the statistics of the whole replay
+	 */
+	void report();
+public:
+	/**
+	 * Constructor
+	 */
+	Replay(Common::SeekableReadStream *stream);
+
+	/**
+	 * Destructor
+	 */
+	~Replay();
+
+	/**
+	 * Passes input to the windows that are waiting for it: the next command for line input,
+	 * and a key press for character input and [more] prompts.
+	 * @returns		True if input was passed
+	 */
+	bool feedInput();
+};
+
+} // End of namespace Glk
+
+#endif
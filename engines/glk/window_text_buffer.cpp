@@ -240,7 +240,9 @@ void TextBufferWindow::touchScroll() {
 	g_vm->_selection->clearSelection();
 	_windows->repaint(_bbox);
 
-	for (int i = 0; i < _scrollMax; i++)
+	// Only the visible rows are drawn, the others get touched once they are scrolled into view
+	const int end = MIN(_scrollMax, _scrollPos + _height);
+	for (int i = _scrollPos; i < end; i++)
 		_lines[i]._dirty = true;
 }
 
@@ -856,12 +858,13 @@ void TextBufferWindow::redraw() {
 		if (selrow)
 			_lines[i]._dirty = true;
 
-		TextBufferRow ln(_lines[i]);
-
 		// skip if we can
-		if (!ln._dirty && !ln._repaint && !Windows::_forceRedraw && _scrollPos == 0)
+		if (!_lines[i]._dirty && !_lines[i]._repaint && !Windows::_forceRedraw && _scrollPos == 0)
 			continue;
 
+		// the row is copied, as the selection gets drawn by changing its attributes
+		TextBufferRow ln(_lines[i]);
+
 		// repaint previously selected lines if needed
 		if (ln._repaint && !Windows::_forceRedraw)
 			_windows->redrawRect(Rect(x0 / GLI_SUBPIX, y,
@@ -1531,8 +1534,15 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_scrollMax++;
 
 	if (_scrollMax > _scrollBack - 1
-			|| _lastSeen > _scrollBack - 1)
-		scrollResize();
+			|| _lastSeen > _scrollBack - 1) {
+		if (_scrollBack < SCROLLBACK_MAX) {
+			scrollResize();
+		} else {
+			// the history is full, so the oldest line gets dropped
+			_scrollMax = MIN(_scrollMax, _scrollBack - 1);
+			_lastSeen = MIN(_lastSeen, _scrollBack - 1);
+		}
+	}
 
 	if (_lastSeen >= _height)
 		_scrollPos++;
@@ -1549,11 +1559,19 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._len = _numChars;
 	_lines[0]._newLine = forced;
 
-	for (int i = _scrollBack - 1; i > 0; i--) {
-		memcpy(&_lines[i], &_lines[i - 1], sizeof(TextBufferRow));
-		if (i < _height)
-			touch(i);
-	}
+	// the oldest row becomes the new line
+	TextBufferRow &oldest = _lines[_scrollBack - 1];
+	if (oldest._lPic)
+		oldest._lPic->decrement();
+	if (oldest._rPic)
+		oldest._rPic->decrement();
+
+	_lines.rotate();
+	_chars = _lines[0]._chars;
+	_attrs = _lines[0]._attrs;
+
+	for (int i = 1; i < _height && i < _scrollBack; i++)
+		touch(i);
 
 	if (_radjn)
 		_radjn--;
@@ -1586,29 +1604,12 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 }
 
 void TextBufferWindow::scrollResize() {
-	int i;
-
-	_lines.clear();
+	// the rows get moved, but keep their text
 	_lines.resize(_scrollBack + SCROLLBACK);
 
 	_chars = _lines[0]._chars;
 	_attrs = _lines[0]._attrs;
 
-	for (i = _scrollBack; i < (_scrollBack + SCROLLBACK); i++) {
-		_lines[i]._dirty = false;
-		_lines[i]._repaint = false;
-		_lines[i]._lm = 0;
-		_lines[i]._rm = 0;
-		_lines[i]._lPic = nullptr;
-		_lines[i]._rPic = nullptr;
-		_lines[i]._lHyper = 0;
-		_lines[i]._rHyper = 0;
-		_lines[i]._len = 0;
-		_lines[i]._newLine = 0;
-		*(_lines[i]._chars) = 0;
-		_lines[i]._attrs->clear();
-	}
-
 	_scrollBack += SCROLLBACK;
 }
 
@@ -1651,4 +1652,20 @@ TextBufferWindow::TextBufferRow::TextBufferRow() : _len(0), _newLine(0), _dirty(
 	Common::fill(&_chars[0], &_chars[TBLINELEN], 0);
 }
 
+/*--------------------------------------------------------------------------*/
+
+void TextBufferWindow::TextBufferRows::resize(uint newSize) {
+	// bring the rows back in order, so that the new ones are added after the oldest
+	if (_first) {
+		Common::Array<TextBufferRow> rows;
+		rows.reserve(MAX(newSize, _rows.size()));
+		for (uint i = 0; i < _rows.size(); i++)
+			rows.push_back(_rows[(_first + i) % _rows.size()]);
+		_rows.swap(rows);
+		_first = 0;
+	}
+
+	_rows.resize(newSize);
+}
+
 } // End of namespace Glk
@@ -52,7 +52,42 @@ class TextBufferWindow : public TextWindow, Speech {
 		 */
 		TextBufferRow();
 	};
-	typedef Common::Array<TextBufferRow> TextBufferRows;
+
+	/**
+	 * The rows of the window, with the newest row first. The rows are kept in a ring,
+	 * so that starting a new line reuses the oldest row instead of moving all others.
+	 */
+	class TextBufferRows {
+	private:
+		Common::Array<TextBufferRow> _rows;
+		uint _first;
+	public:
+		TextBufferRows() : _first(0) {}
+
+		uint size() const {
+			return _rows.size();
+		}
+
+		TextBufferRow &operator[](int idx) {
+			return _rows[(_first + idx) % _rows.size()];
+		}
+
+		const TextBufferRow &operator[](int idx) const {
+			return _rows[(_first + idx) % _rows.size()];
+		}
+
+		/**
+		 * Resizes the rows, keeping the existing ones
+		 */
+		void resize(uint newSize);
+
+		/**
+		 * Turns the oldest row into the first one
+		 */
+		void rotate() {
+			_first = (_first + _rows.size() - 1) % _rows.size();
+		}
+	};
 private:
 	PropFontInfo &_font;
 private:
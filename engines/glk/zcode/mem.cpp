@@ -29,7 +29,7 @@ namespace ZCode {
 
 Mem::Mem() : story_fp(nullptr), story_size(0), first_undo(nullptr), last_undo(nullptr),
 		curr_undo(nullptr), undo_mem(nullptr), zmp(nullptr), pcp(nullptr), prev_zmp(nullptr),
-		undo_diff(nullptr), undo_count(0), reserve_mem(0) {
+		undo_diff(nullptr), undo_count(0), reserve_mem(0), text_tables_start(0), text_tables_end(0) {
 }
 
 void Mem::initialize() {
@@ -142,6 +142,9 @@ void Mem::restart_header(void) {
 
 	int i;
 
+	// The whole dynamic memory gets reset on restarting and restoring
+	textTablesChanged();
+
 	SET_BYTE(H_CONFIG, h_config);
 	SET_WORD(H_FLAGS, h_flags);
 
@@ -192,6 +195,9 @@ void Mem::storeb(zword addr, zbyte value) {
 	if (addr >= h_dynamic_size)
 		runtimeError(ERR_STORE_RANGE);
 
+	if (addr >= text_tables_start && addr < text_tables_end)
+		textTablesChanged();
+
 	if (addr == H_FLAGS + 1) {
 		// flags register is modified
 
@@ -66,6 +66,12 @@ protected:
 	zbyte *undo_mem, *prev_zmp, *undo_diff;
 	int undo_count;
 	int reserve_mem;
+
+	/**
+	 * The range of dynamic memory holding the abbreviations, the alphabet and the
+	 * Unicode translation table, which are needed to decode text
+	 */
+	uint text_tables_start, text_tables_end;
 private:
 	/**
 	 * Handles setting the story file, parsing it if it's a Blorb file
@@ -127,6 +133,11 @@ protected:
 	 */
 	virtual void flagsChanged(zbyte value) = 0;
 
+	/**
+	 * Called when memory that is used to decode text may have changed
+	 */
+	virtual void textTablesChanged() = 0;
+
 	/**
 	 * Close the story file and deallocate memory.
 	 */
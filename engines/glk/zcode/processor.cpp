@@ -133,8 +133,8 @@ Opcode Processor::ext_opcodes[64] = {
 
 Processor::Processor(OSystem *syst, const GlkGameDescription &gameDesc) :
 		GlkInterface(syst, gameDesc),
-		_finished(0), _sp(nullptr), _fp(nullptr), _frameCount(0),
-		zargc(0), _decoded(nullptr), _encoded(nullptr), _resolution(0),
+		_finished(0), _instructionCount(0), _sp(nullptr), _fp(nullptr), _frameCount(0),
+		zargc(0), _decoded(nullptr), _encoded(nullptr), _resolution(0), _textRecord(nullptr), _decodedTextsStale(false),
 		_randomInterval(0), _randomCtr(0), first_restart(true), script_valid(false),
 		_bufPos(0), _locked(false), _prevC('\0'), script_width(0),
 		sfp(nullptr), rfp(nullptr), pfp(nullptr), ostream_screen(true), ostream_script(false),
@@ -197,6 +197,8 @@ void Processor::initialize() {
 		op0_opcodes[9] = &Processor::z_catch;
 		op1_opcodes[15] = &Processor::z_call_n;
 	}
+
+	find_text_tables();
 }
 
 void Processor::load_operand(zbyte type) {
@@ -247,6 +249,7 @@ void Processor::interpret() {
 		zbyte opcode;
 		CODE_BYTE(opcode);
 		zargc = 0;
+		++_instructionCount;
 
 		if (opcode < 0x80) {
 			// 2OP opcodes
@@ -25,6 +25,7 @@
 #include "glk/zcode/mem.h"
 #include "glk/zcode/glk_interface.h"
 #include "glk/zcode/frotz_types.h"
+#include "common/hashmap.h"
 #include "common/stack.h"
 
 namespace Glk {
@@ -59,6 +60,7 @@ private:
 	Common::Array<Opcode> op1_opcodes;
 
 	int _finished;
+	uint64 _instructionCount;
 	zword zargs[8];
 	int zargc;
 	uint _randomInterval;
@@ -76,6 +78,19 @@ private:
 	static zchar ZSCII_TO_LATIN1[];
 	zchar *_decoded, *_encoded;
 	int _resolution;
+
+	/**
+	 * A string in static memory, decoded to the characters it prints
+	 */
+	struct DecodedText {
+		Common::Array<zchar> _chars;
+		uint _length;		///< Length of the encoded string, used to skip strings at the PC
+
+		DecodedText() : _length(0) {}
+	};
+	Common::HashMap<uint, DecodedText> _decodedTexts;
+	Common::Array<zchar> *_textRecord;
+	bool _decodedTextsStale;
 	int _errorCount[ERR_NUM_ERRORS];
 
 	// Buffer related fields
@@ -618,6 +633,25 @@ protected:
 	 */
 	void decode_text(string_type st, zword addr);
 
+	/**
+	 * Print a string in static memory, which is only decoded the first time it gets printed.
+	 * key is the byte address of the string.
+	 */
+	void print_decoded_text(string_type st, zword addr, uint key);
+
+	/**
+	 * Find the part of dynamic memory that is used to decode strings, so that the decoded
+	 * strings can be dropped once it gets written to.
+	 */
+	void find_text_tables();
+
+	/**
+	 * Drop all decoded strings, once the string being printed is done
+	 */
+	void textTablesChanged() override {
+		_decodedTextsStale = true;
+	}
+
 	/**
 	 * Print a signed 16bit number.
 	 */
@@ -1714,6 +1748,11 @@ public:
 	 */
 	void interpret();
 
+	/**
+	 * Returns the number of instructions executed
+	 */
+	uint64 getInstructionCount() const override { return _instructionCount; }
+
 	/**
 	 * \defgroup Memory access methods
 	 * @{
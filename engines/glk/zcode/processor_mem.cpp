@@ -102,6 +102,7 @@ int Processor::restore_undo(void) {
 
 	// undo possible
 	memcpy(zmp, prev_zmp, h_dynamic_size);
+	textTablesChanged();
 	SET_PC(curr_undo->pc);
 	_sp = _stack + STACK_SIZE - curr_undo->stack_size;
 	_fp = _stack + curr_undo->frame_offset;
@@ -593,6 +593,7 @@ void Processor::z_restore() {
 			strid_t f = glk_stream_open_file(ref, filemode_Read);
 
 			glk_get_buffer_stream(f, (char *)zmp + zargs[0], zargs[1]);
+			textTablesChanged();
 
 			glk_stream_close(f);
 			success = true;
@@ -286,7 +286,88 @@ void Processor::encode_text(int padding) {
 	delete[]  zchars;
 }
 
-#define outchar(c)	if (st == VOCABULARY) *ptr++=c; else print_char(c)
+// Marks a new line in decoded strings, as it is not the same as printing ZC_RETURN
+static const zchar DECODED_NEW_LINE = 0xFFFFFFFF;
+
+void Processor::find_text_tables() {
+	uint start = h_dynamic_size;
+	uint end = 0;
+
+	if (h_version >= V2 && h_abbreviations != 0) {
+		const int count = (h_version >= V3) ? 96 : 32;
+		start = MIN<uint>(start, h_abbreviations);
+		end = MAX<uint>(end, h_abbreviations + 2 * count);
+
+		// The abbreviated strings themselves may be in dynamic memory as well
+		for (int i = 0; i < count; i++) {
+			zword abbr_addr;
+			LOW_WORD(h_abbreviations + 2 * i, abbr_addr);
+
+			uint byte_addr = (uint)abbr_addr << 1;
+			if (byte_addr >= h_dynamic_size)
+				continue;
+
+			start = MIN(start, byte_addr);
+			zword code;
+			do {
+				HIGH_WORD(byte_addr, code);
+				byte_addr += 2;
+			} while (!(code & 0x8000) && byte_addr < h_dynamic_size);
+			end = MAX(end, byte_addr);
+		}
+	}
+
+	if (h_alphabet != 0) {
+		start = MIN<uint>(start, h_alphabet);
+		end = MAX<uint>(end, h_alphabet + 26 * 3);
+	}
+
+	if (hx_unicode_table != 0) {
+		zbyte N;
+		LOW_BYTE(hx_unicode_table, N);
+		start = MIN<uint>(start, hx_unicode_table);
+		end = MAX<uint>(end, hx_unicode_table + 1 + 2 * N);
+	}
+
+	text_tables_start = start;
+	text_tables_end = end;
+}
+
+void Processor::print_decoded_text(enum string_type st, zword addr, uint key) {
+	DecodedText *text;
+
+	if (_decodedTextsStale) {
+		_decodedTexts.clear();
+		_decodedTextsStale = false;
+	}
+
+	if (_decodedTexts.contains(key)) {
+		text = &_decodedTexts[key];
+
+		if (st == EMBEDDED_STRING)
+			SET_PC(getPC() + text->_length);
+	} else {
+		text = &_decodedTexts[key];
+
+		const uint pc = getPC();
+		_textRecord = &text->_chars;
+		decode_text(st, addr);
+		_textRecord = nullptr;
+
+		if (st == EMBEDDED_STRING)
+			text->_length = getPC() - pc;
+	}
+
+	for (uint i = 0; i < text->_chars.size(); i++) {
+		if (text->_chars[i] == DECODED_NEW_LINE)
+			new_line();
+		else
+			print_char(text->_chars[i]);
+	}
+}
+
+#define outchar(c)	if (st == VOCABULARY) *ptr++=c; else if (_textRecord) _textRecord->push_back(c); else print_char(c)
+#define outnewline()	if (_textRecord) _textRecord->push_back(DECODED_NEW_LINE); else new_line()
 
 void Processor::decode_text(enum string_type st, zword addr) {
 	zchar *ptr = nullptr;
@@ -324,6 +405,17 @@ void Processor::decode_text(enum string_type st, zword addr) {
 			runtimeError(ERR_ILL_PRINT_ADDR);
 	}
 
+	// Strings in static memory never change, so they only need to be decoded once
+	if (!_textRecord) {
+		if (st == HIGH_STRING && (uint)byte_addr >= h_dynamic_size && (uint)byte_addr < story_size) {
+			print_decoded_text(st, addr, byte_addr);
+			return;
+		} else if (st == EMBEDDED_STRING && getPC() >= h_dynamic_size) {
+			print_decoded_text(st, addr, getPC());
+			return;
+		}
+	}
+
 	// Loop until a 16bit word has the highest bit set
 	if (st == VOCABULARY)
 		ptr = _decoded;
@@ -356,11 +448,13 @@ void Processor::decode_text(enum string_type st, zword addr) {
 				if (shift_state == 2 && c == 6)
 					status = 2;
 
-				else if (h_version == V1 && c == 1)
-					new_line();
+				else if (h_version == V1 && c == 1) {
+					outnewline();
+				}
 
-				else if (h_version >= V2 && shift_state == 2 && c == 7)
-					new_line();
+				else if (h_version >= V2 && shift_state == 2 && c == 7) {
+					outnewline();
+				}
 
 				else if (c >= 6)
 					outchar(alphabet(shift_state, c - 6));
@@ -440,6 +534,7 @@ void Processor::decode_text(enum string_type st, zword addr) {
 }
 
 #undef outchar
+#undef outnewline
 
 void Processor::print_num(zword value) {
 	int i;
@@ -2306,7 +2306,7 @@ const Math::Matrix4 Actor::getFinalMatrix() const {
 		EMICostume *cost = static_cast<EMICostume *>(attachedActor->getCurrentCostume());
 		if (cost && cost->_emiSkel && cost->_emiSkel->_obj) {
 			Joint *j = cost->_emiSkel->_obj->getJointNamed(_attachedJoint);
-			m = m * j->_finalMatrix;
+			m = m * cost->_emiSkel->_obj->getFinalMatrix(j);
 		}
 	}
 
@@ -2487,9 +2487,10 @@ void Actor::attachToActor(Actor *parent, const char *joint) {
 		newRot = newRot.inverse() * j->_finalQuat;
 
 		// Get the final position coordinates
-		_pos = _pos - j->_finalMatrix.getPosition();
-		j->_finalMatrix.transpose();
-		j->_finalMatrix.transform(&_pos, true);
+		Math::Matrix4 &finalMatrix = cost->_emiSkel->_obj->getFinalMatrix(j);
+		_pos = _pos - finalMatrix.getPosition();
+		finalMatrix.transpose();
+		finalMatrix.transform(&_pos, true);
 	}
 
 	// Get the final rotation euler coordinates
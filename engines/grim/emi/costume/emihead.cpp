@@ -55,7 +55,7 @@ void EMIHead::lookAt(bool entering, const Math::Vector3d &point, float rate, con
 	Math::Quaternion lookAtQuat; // Note: Identity if not looking at anything.
 
 	if (entering) {
-		Math::Matrix4 jointToWorld = _cost->getOwner()->getFinalMatrix() * joint->_finalMatrix;
+		Math::Matrix4 jointToWorld = _cost->getOwner()->getFinalMatrix() * _cost->_emiSkel->_obj->getFinalMatrix(joint);
 		Math::Vector3d jointWorldPos = jointToWorld.getPosition();
 		Math::Matrix4 worldToJoint = jointToWorld;
 		worldToJoint.invertAffineOrthonormal();
@@ -114,7 +114,8 @@ void EMIHead::lookAt(bool entering, const Math::Vector3d &point, float rate, con
 	}
 
 	if (_headRot != Math::Quaternion()) { // If not identity..
-		joint->_animMatrix = joint->_animMatrix * _headRot.toMatrix();
+		Math::Matrix4 &animMatrix = _cost->_emiSkel->_obj->getAnimMatrix(joint);
+		animMatrix = animMatrix * _headRot.toMatrix();
 		joint->_animQuat = joint->_animQuat * _headRot;
 		_cost->_emiSkel->_obj->commitAnim();
 	}
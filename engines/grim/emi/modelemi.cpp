@@ -217,6 +217,7 @@ void EMIModel::setSkeleton(Skeleton *skel) {
 		return;
 	}
 	_skeleton = skel;
+	_skinnedPose = 0;
 	if (!skel || !_numBoneInfos) {
 		return;
 	}
@@ -231,6 +232,12 @@ void EMIModel::prepareForRender() {
 	if (!_skeleton || !_vertexBoneInfo)
 		return;
 
+	// Models are drawn more than once per frame, e.g. for shadows, and
+	// actors often stand still, so only skin again if the pose changed
+	if (_skinnedPose == _skeleton->_poseCounter)
+		return;
+	_skinnedPose = _skeleton->_poseCounter;
+
 	for (int i = 0; i < _numVertices; i++) {
 		_drawVertices[i].set(0.0f, 0.0f, 0.0f);
 		_drawNormals[i].set(0.0f, 0.0f, 0.0f);
@@ -243,7 +250,7 @@ void EMIModel::prepareForRender() {
 		}
 
 		int jointIndex = _vertexBoneInfo[i];
-		const Math::Matrix4 &jointMatrix = _skeleton->_joints[jointIndex]._finalMatrix;
+		const Math::Matrix4 &jointMatrix = _skeleton->_finalMatrices[jointIndex];
 		const Math::Matrix4 &bindPose = _skeleton->_joints[jointIndex]._absMatrix;
 
 		Math::Vector3d vert = _vertices[boneVert];
@@ -444,6 +451,7 @@ EMIModel::EMIModel(const Common::String &filename, Common::SeekableReadStream *d
 	_numBoneInfos = 0;
 	_vertexBoneInfo = nullptr;
 	_skeleton = nullptr;
+	_skinnedPose = 0;
 	_radius = 0;
 	_center = new Math::Vector3d();
 	_boxData = new Math::Vector3d();
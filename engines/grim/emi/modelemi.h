@@ -106,6 +106,7 @@ public:
 	Material **_mats;
 
 	Skeleton *_skeleton;
+	uint32 _skinnedPose; // Skeleton pose _drawVertices were computed for, 0 if none
 
 	int _numBones;
 
@@ -22,6 +22,7 @@
 #include "common/stream.h"
 
 #include "math/vector3d.h"
+#include "math/kernels.h"
 #include "math/vector4d.h"
 #include "math/quat.h"
 
@@ -35,7 +36,8 @@ namespace Grim {
 #define TRANSLATE_OP 3
 
 Skeleton::Skeleton(const Common::String &filename, Common::SeekableReadStream *data) :
-		_numJoints(0), _joints(nullptr), _animLayers(nullptr) {
+		_numJoints(0), _joints(nullptr), _poseCounter(0), _animMatrices(nullptr),
+		_finalMatrices(nullptr), _parentIndices(nullptr), _animLayers(nullptr) {
 	loadSkeleton(data);
 }
 
@@ -45,11 +47,17 @@ Skeleton::~Skeleton() {
 	}
 	delete[] _animLayers;
 	delete[] _joints;
+	delete[] _animMatrices;
+	delete[] _finalMatrices;
+	delete[] _parentIndices;
 }
 
 void Skeleton::loadSkeleton(Common::SeekableReadStream *data) {
 	_numJoints = data->readUint32LE();
 	_joints = new Joint[_numJoints];
+	_animMatrices = new Math::Matrix4[_numJoints];
+	_finalMatrices = new Math::Matrix4[_numJoints];
+	_parentIndices = new int[_numJoints];
 
 	char inString[32];
 
@@ -62,7 +70,9 @@ void Skeleton::loadSkeleton(Common::SeekableReadStream *data) {
 		_joints[i]._trans.readFromStream(data);
 		_joints[i]._quat.readFromStream(data);
 
+		// Only joints read before are found, so parents precede their children
 		_joints[i]._parentIndex = findJointIndex(_joints[i]._parent);
+		_parentIndices[i] = _joints[i]._parentIndex;
 
 		_jointsMap[_joints[i]._name] = i;
 	}
@@ -94,6 +104,13 @@ void Skeleton::initBones() {
 	for (int i = 0; i < MAX_ANIMATION_LAYERS; ++i) {
 		_animLayers[i]._jointAnims = new JointAnimation[_numJoints];
 	}
+
+	_remainingRotWeights.resize(_numJoints);
+	_remainingTransWeights.resize(_numJoints);
+	_slerpFrom.resize(_numJoints);
+	_slerpTo.resize(_numJoints);
+	_slerpWeights.resize(_numJoints);
+	_slerpJoints.resize(_numJoints);
 }
 
 void Skeleton::resetAnim() {
@@ -108,7 +125,7 @@ void Skeleton::resetAnim() {
 		}
 	}
 	for (int i = 0; i < _numJoints; ++i) {
-		_joints[i]._animMatrix = _joints[i]._relMatrix;
+		_animMatrices[i] = _joints[i]._relMatrix;
 		_joints[i]._animQuat = _joints[i]._quat;
 	}
 }
@@ -132,32 +149,50 @@ void Skeleton::animate() {
 	// layer will get as much weight as it wants, while the next highest priority will get the
 	// amount that remains and so on.
 	for (int i = 0; i < _numJoints; ++i) {
-		float remainingTransWeight = 1.0f;
-		float remainingRotWeight = 1.0f;
+		_remainingRotWeights[i] = 1.0f;
+		_remainingTransWeights[i] = 1.0f;
+	}
 
-		for (int j = MAX_ANIMATION_LAYERS - 1; j >= 0; --j) {
-			AnimationLayer &layer = _animLayers[j];
+	for (int j = MAX_ANIMATION_LAYERS - 1; j >= 0; --j) {
+		AnimationLayer &layer = _animLayers[j];
+
+		// The rotations of all joints in the layer are interpolated in one batch. The
+		// translation only changes the position, which the rotation keeps, so it can
+		// be applied first.
+		uint numSlerps = 0;
+		for (int i = 0; i < _numJoints; ++i) {
 			JointAnimation &jointAnim = layer._jointAnims[i];
 
-			if (remainingRotWeight > 0.0f && jointAnim._rotWeight != 0.0f) {
-				Math::Vector3d pos = _joints[i]._animMatrix.getPosition();
-				_joints[i]._animQuat = _joints[i]._animQuat.slerpQuat(_joints[i]._animQuat * jointAnim._quat, remainingRotWeight);
-				_joints[i]._animQuat.toMatrix(_joints[i]._animMatrix);
-				_joints[i]._animMatrix.setPosition(pos);
+			if (_remainingRotWeights[i] > 0.0f && jointAnim._rotWeight != 0.0f) {
+				_slerpJoints[numSlerps] = i;
+				_slerpFrom[numSlerps] = _joints[i]._animQuat;
+				_slerpTo[numSlerps] = jointAnim._quat;
+				_slerpWeights[numSlerps] = _remainingRotWeights[i];
+				++numSlerps;
 
-				remainingRotWeight *= 1.0f - jointAnim._rotWeight;
+				_remainingRotWeights[i] *= 1.0f - jointAnim._rotWeight;
 			}
 
-			if (remainingTransWeight > 0.0f && jointAnim._transWeight != 0.0f) {
-				Math::Vector3d pos = _joints[i]._animMatrix.getPosition();
+			if (_remainingTransWeights[i] > 0.0f && jointAnim._transWeight != 0.0f) {
+				Math::Vector3d pos = _animMatrices[i].getPosition();
 				Math::Vector3d delta = jointAnim._pos;
-				_joints[i]._animMatrix.setPosition(pos + delta * remainingTransWeight);
+				_animMatrices[i].setPosition(pos + delta * _remainingTransWeights[i]);
 
-				remainingTransWeight *= 1.0f - jointAnim._transWeight;
+				_remainingTransWeights[i] *= 1.0f - jointAnim._transWeight;
 			}
+		}
 
-			if (remainingRotWeight <= 0.0f && remainingTransWeight <= 0.0f)
-				break;
+		if (numSlerps == 0)
+			continue;
+
+		Math::multiplyQuaternions(&_slerpTo[0], &_slerpFrom[0], &_slerpTo[0], numSlerps);
+		Math::slerpQuaternions(&_slerpFrom[0], &_slerpFrom[0], &_slerpTo[0], &_slerpWeights[0], numSlerps);
+		for (uint k = 0; k < numSlerps; ++k) {
+			int i = _slerpJoints[k];
+			Math::Vector3d pos = _animMatrices[i].getPosition();
+			_joints[i]._animQuat = _slerpFrom[k];
+			_joints[i]._animQuat.toMatrix(_animMatrices[i]);
+			_animMatrices[i].setPosition(pos);
 		}
 	}
 
@@ -172,13 +207,13 @@ void Skeleton::removeAnimation(AnimationStateEmi *anim) {
 }
 
 void Skeleton::commitAnim() {
+	++_poseCounter;
+	Math::composeHierarchy(_finalMatrices, _animMatrices, _parentIndices, _numJoints);
 	for (int m = 0; m < _numJoints; ++m) {
 		const Joint *parent = getParentJoint(&_joints[m]);
 		if (parent) {
-			_joints[m]._finalMatrix = parent->_finalMatrix * _joints[m]._animMatrix;
 			_joints[m]._finalQuat = parent->_finalQuat * _joints[m]._animQuat;
 		} else {
-			_joints[m]._finalMatrix = _joints[m]._animMatrix;
 			_joints[m]._finalQuat = _joints[m]._animQuat;
 		}
 	}
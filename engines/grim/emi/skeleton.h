@@ -22,6 +22,7 @@
 #ifndef GRIM_SKELETON_H
 #define GRIM_SKELETON_H
 
+#include "common/array.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
 
@@ -48,9 +49,7 @@ struct Joint {
 	int _parentIndex;
 	Math::Matrix4 _absMatrix;
 	Math::Matrix4 _relMatrix;
-	Math::Matrix4 _animMatrix;
 	Math::Quaternion _animQuat;
-	Math::Matrix4 _finalMatrix;
 	Math::Quaternion _finalQuat;
 };
 
@@ -77,6 +76,13 @@ public:
 
 	int _numJoints;
 	Joint *_joints;
+	uint32 _poseCounter; // Incremented each time the final joint matrices change
+
+	// The animated transforms of the joints are kept in arrays of their own,
+	// so that they can be composed in one go
+	Math::Matrix4 *_animMatrices;
+	Math::Matrix4 *_finalMatrices;
+	int *_parentIndices;
 
 	typedef Common::HashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> JointMap;
 	JointMap _jointsMap;
@@ -92,10 +98,20 @@ public:
 	Joint *getJointNamed(const Common::String &name) const;
 	Joint *getParentJoint(const Joint *j) const;
 	int getJointIndex(const Joint *j) const;
+	Math::Matrix4 &getAnimMatrix(const Joint *j) const { return _animMatrices[getJointIndex(j)]; }
+	Math::Matrix4 &getFinalMatrix(const Joint *j) const { return _finalMatrices[getJointIndex(j)]; }
 	AnimationLayer* getLayer(int priority) const;
 private:
 	AnimationLayer *_animLayers;
 	Common::List<AnimationStateEmi*> _activeAnims;
+
+	// Scratch space for blending the animation layers
+	Common::Array<float> _remainingRotWeights;
+	Common::Array<float> _remainingTransWeights;
+	Common::Array<Math::Quaternion> _slerpFrom;
+	Common::Array<Math::Quaternion> _slerpTo;
+	Common::Array<float> _slerpWeights;
+	Common::Array<int> _slerpJoints;
 };
 
 } // end of namespace Grim
@@ -119,8 +119,7 @@ struct EMIModelUserData {
 	OpenGL::Shader *_shaderLights;
 	uint32 _texCoordsVBO;
 	uint32 _colorMapVBO;
-	uint32 _verticesVBO;
-	uint32 _normalsVBO;
+	uint32 _skinnedVBO; // Skinned positions followed by skinned normals
 };
 
 struct ModelUserData {
@@ -1044,10 +1043,13 @@ void GfxOpenGLS::translateViewpointFinish() {
 
 void GfxOpenGLS::updateEMIModel(const EMIModel* model) {
 	const EMIModelUserData *mud = (const EMIModelUserData *)model->_userData;
-	glBindBuffer(GL_ARRAY_BUFFER, mud->_verticesVBO);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, model->_numVertices * 3 * sizeof(float), model->_drawVertices);
-	glBindBuffer(GL_ARRAY_BUFFER, mud->_normalsVBO);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, model->_numVertices * 3 * sizeof(float), model->_drawNormals);
+	const GLsizeiptr size = model->_numVertices * 3 * sizeof(float);
+	glBindBuffer(GL_ARRAY_BUFFER, mud->_skinnedVBO);
+	// Orphan the previous contents so that the driver does not have to
+	// wait for draws still using them
+	glBufferData(GL_ARRAY_BUFFER, 2 * size, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, model->_drawVertices);
+	glBufferSubData(GL_ARRAY_BUFFER, size, size, model->_drawNormals);
 }
 
 void GfxOpenGLS::drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face) {
@@ -2088,24 +2090,24 @@ void GfxOpenGLS::renderZBitmaps(bool render) {
 void GfxOpenGLS::createEMIModel(EMIModel *model) {
 	EMIModelUserData *mud = new EMIModelUserData;
 	model->_userData = mud;
-	mud->_verticesVBO = OpenGL::Shader::createBuffer(GL_ARRAY_BUFFER, model->_numVertices * 3 * sizeof(float), model->_vertices, GL_STREAM_DRAW);
-
-	mud->_normalsVBO = OpenGL::Shader::createBuffer(GL_ARRAY_BUFFER, model->_numVertices * 3 * sizeof(float), model->_normals, GL_STREAM_DRAW);
+	const uint32 normalsOffset = model->_numVertices * 3 * sizeof(float);
+	mud->_skinnedVBO = OpenGL::Shader::createBuffer(GL_ARRAY_BUFFER, 2 * normalsOffset, nullptr, GL_STREAM_DRAW);
+	updateEMIModel(model);
 
 	mud->_texCoordsVBO = OpenGL::Shader::createBuffer(GL_ARRAY_BUFFER, model->_numVertices * 2 * sizeof(float), model->_texVerts, GL_STATIC_DRAW);
 
 	mud->_colorMapVBO = OpenGL::Shader::createBuffer(GL_ARRAY_BUFFER, model->_numVertices * 4 * sizeof(byte), model->_colorMap, GL_STATIC_DRAW);
 
 	OpenGL::Shader * actorShader = _actorProgram->clone();
-	actorShader->enableVertexAttribute("position", mud->_verticesVBO, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
-	actorShader->enableVertexAttribute("normal", mud->_normalsVBO, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
+	actorShader->enableVertexAttribute("position", mud->_skinnedVBO, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
+	actorShader->enableVertexAttribute("normal", mud->_skinnedVBO, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), normalsOffset);
 	actorShader->enableVertexAttribute("texcoord", mud->_texCoordsVBO, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), 0);
 	actorShader->enableVertexAttribute("color", mud->_colorMapVBO, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4 * sizeof(byte), 0);
 	mud->_shader = actorShader;
 
 	actorShader = _actorLightsProgram->clone();
-	actorShader->enableVertexAttribute("position", mud->_verticesVBO, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
-	actorShader->enableVertexAttribute("normal", mud->_normalsVBO, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
+	actorShader->enableVertexAttribute("position", mud->_skinnedVBO, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
+	actorShader->enableVertexAttribute("normal", mud->_skinnedVBO, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), normalsOffset);
 	actorShader->enableVertexAttribute("texcoord", mud->_texCoordsVBO, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), 0);
 	actorShader->enableVertexAttribute("color", mud->_colorMapVBO, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4 * sizeof(byte), 0);
 	mud->_shaderLights = actorShader;
@@ -2128,12 +2130,12 @@ void GfxOpenGLS::destroyEMIModel(EMIModel *model) {
 	EMIModelUserData *mud = static_cast<EMIModelUserData *>(model->_userData);
 
 	if (mud) {
-		OpenGL::Shader::freeBuffer(mud->_verticesVBO);
-		OpenGL::Shader::freeBuffer(mud->_normalsVBO);
+		OpenGL::Shader::freeBuffer(mud->_skinnedVBO);
 		OpenGL::Shader::freeBuffer(mud->_texCoordsVBO);
 		OpenGL::Shader::freeBuffer(mud->_colorMapVBO);
 
 		delete mud->_shader;
+		delete mud->_shaderLights;
 		delete mud;
 	}
 
@@ -2206,7 +2208,9 @@ void GfxOpenGLS::destroyMesh(const Mesh *mesh) {
 	if (!mud)
 		return;
 
+	OpenGL::Shader::freeBuffer(mud->_meshInfoVBO);
 	delete mud->_shader;
+	delete mud->_shaderLights;
 	delete mud;
 }
 
@@ -63,9 +63,10 @@ bool Lab::open(const Common::Path &filename, bool keepStream) {
 	}
 	if (result && keepStream) {
 		file->seek(0, SEEK_SET);
-		byte *data = static_cast<byte*>(malloc(sizeof(byte) * file->size()));
+		byte *data = new byte[file->size()];
 		file->read(data, file->size());
-		_stream = new Common::MemoryReadStream(data, file->size(), DisposeAfterUse::YES);
+		// Share the buffer, so that members are slices of it instead of copies
+		_stream = new Common::MemoryReadStream(Common::SharedPtr<byte>(data, Common::ArrayDeleter<byte>()), file->size());
 	}
 	delete file;
 
@@ -176,10 +177,7 @@ Common::SeekableReadStream *Lab::createReadStreamForMember(const Common::Path &p
 		file->open(_labFileName);
 		return new Common::SeekableSubReadStream(file, i->_offset, i->_offset + i->_len, DisposeAfterUse::YES);
 	} else {
-		byte *data = static_cast<byte*>(malloc(sizeof(byte) * i->_len));
-		_stream->seek(i->_offset, SEEK_SET);
-		_stream->read(data, i->_len);
-		return new Common::MemoryReadStream(data, i->_len, DisposeAfterUse::YES);
+		return _stream->createSlice(i->_offset, i->_offset + i->_len);
 	}
 }
 
@@ -26,6 +26,7 @@
 
 namespace Common {
 	class File;
+	class MemoryReadStream;
 }
 
 namespace Grim {
@@ -65,7 +66,7 @@ private:
 	typedef Common::SharedPtr<LabEntry> LabEntryPtr;
 	typedef Common::HashMap<Common::Path, LabEntryPtr, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> LabMap;
 	LabMap _entries;
-	Common::SeekableReadStream *_stream;
+	Common::MemoryReadStream *_stream;
 };
 
 } // end of namespace Grim
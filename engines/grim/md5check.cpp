@@ -20,7 +20,9 @@
  */
 
 #include "common/file.h"
+#include "common/jobsystem.h"
 #include "common/md5.h"
+#include "common/system.h"
 #include "common/translation.h"
 
 #include "gui/error.h"
@@ -585,7 +587,11 @@ bool MD5Check::advanceCheck(int *pos, int *total) {
 		return false;
 	}
 
-	const MD5Sum &sum = (*_files)[_iterator++];
+	// Check as many files at once as there are threads to hash them
+	const uint32 first = _iterator;
+	const uint32 count = MIN<uint32>(g_system->getJobSystem()->getWorkerCount() + 1, _files->size() - first);
+
+	_iterator += count;
 	if (pos) {
 		*pos = _iterator;
 	}
@@ -596,9 +602,29 @@ bool MD5Check::advanceCheck(int *pos, int *total) {
 		_iterator = -1;
 	}
 
-	Common::File file;
-	if (file.open(sum.filename)) {
-		Common::String md5 = Common::computeStreamMD5AsString(file);
+	Common::Array<Common::File *> files(count);
+	Common::Array<Common::String> md5s(count);
+	for (uint32 i = 0; i < count; i++) {
+		files[i] = new Common::File();
+		if (!files[i]->open((*_files)[first + i].filename)) {
+			delete files[i];
+			files[i] = nullptr;
+		}
+	}
+
+	Common::computeStreamsMD5AsString((Common::ReadStream *const *)files.data(), md5s.data(), count);
+
+	bool ok = true;
+	for (uint32 i = 0; i < count; i++) {
+		ok = checkResult((*_files)[first + i], files[i] != nullptr, md5s[i]) && ok;
+		delete files[i];
+	}
+
+	return ok;
+}
+
+bool MD5Check::checkResult(const MD5Sum &sum, bool opened, const Common::String &md5) {
+	if (opened) {
 		if (!checkMD5(sum, md5.c_str())) {
 			warning("'%s' may be corrupted. MD5: '%s'", sum.filename, md5.c_str());
 			GUI::displayErrorDialog(Common::U32String::format(_("The game data file %s may be corrupted.\nIf you are sure it is "
@@ -23,6 +23,7 @@
 #define GRIM_MD5CHECK_H
 
 #include "common/array.h"
+#include "common/str.h"
 
 namespace Grim {
 
@@ -44,6 +45,7 @@ private:
 		int numSums;
 	};
 	static bool checkMD5(const MD5Sum &sums, const char *md5);
+	static bool checkResult(const MD5Sum &sum, bool opened, const Common::String &md5);
 
 	static bool _initted;
 	static Common::Array<MD5Sum> *_files;
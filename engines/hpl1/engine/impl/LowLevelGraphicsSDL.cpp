@@ -103,6 +103,7 @@ cLowLevelGraphicsSDL::cLowLevelGraphicsSDL() {
 #endif
 
 	Common::fill(mpCurrentTexture, mpCurrentTexture + MAX_TEXTUREUNITS, nullptr);
+	invalidateStateCache();
 
 	mbClearColor = true;
 	mbClearDepth = true;
@@ -210,6 +211,7 @@ void cLowLevelGraphicsSDL::SetupGL() {
 	GL_CHECK(glLoadIdentity());
 	GL_CHECK(glMatrixMode(GL_PROJECTION));
 	GL_CHECK(glLoadIdentity());
+	invalidateStateCache();
 
 	/////  BEGIN BATCH ARRAY STUFF ///////////////
 
@@ -474,7 +476,7 @@ void cLowLevelGraphicsSDL::ScaleMatrix(eMatrix aMtxType, const cVector3f &avScal
 //-----------------------------------------------------------------------
 
 void cLowLevelGraphicsSDL::SetOrthoProjection(const cVector2f &avSize, float afMin, float afMax) {
-	GL_CHECK(glMatrixMode(GL_PROJECTION));
+	SetMatrixMode(eMatrix_Projection);
 	GL_CHECK(glLoadIdentity());
 	GL_CHECK(glOrtho(0, avSize.x, avSize.y, 0, afMin, afMax));
 }
@@ -625,6 +627,20 @@ void cLowLevelGraphicsSDL::SwapBuffers() {
 	applyGammaCorrection();
 	GL_CHECK(glFlush());
 	g_system->updateScreen();
+	invalidateStateCache();
+}
+
+void cLowLevelGraphicsSDL::invalidateStateCache() {
+	_depthTestActive = -1;
+	_depthWriteActive = -1;
+	_depthFunc = -1;
+	_alphaTestActive = -1;
+	_cullActive = -1;
+	_blendActive = -1;
+	_blendSrc = -1;
+	_blendDst = -1;
+	_colorMask = -1;
+	_matrixMode = -1;
 }
 
 //-----------------------------------------------------------------------
@@ -753,18 +769,28 @@ void cLowLevelGraphicsSDL::SetClearStencilActive(bool abX) {
 //-----------------------------------------------------------------------
 
 void cLowLevelGraphicsSDL::SetColorWriteActive(bool abR, bool abG, bool abB, bool abA) {
+	const int mask = (abR ? 1 : 0) | (abG ? 2 : 0) | (abB ? 4 : 0) | (abA ? 8 : 0);
+	if (mask == _colorMask)
+		return;
+	_colorMask = mask;
 	glColorMask(abR, abG, abB, abA);
 }
 
 //-----------------------------------------------------------------------
 
 void cLowLevelGraphicsSDL::SetDepthWriteActive(bool abX) {
+	if ((int)abX == _depthWriteActive)
+		return;
+	_depthWriteActive = abX;
 	glDepthMask(abX);
 }
 
 //-----------------------------------------------------------------------
 
 void cLowLevelGraphicsSDL::SetDepthTestActive(bool abX) {
+	if ((int)abX == _depthTestActive)
+		return;
+	_depthTestActive = abX;
 	if (abX)
 		glEnable(GL_DEPTH_TEST);
 	else
@@ -775,12 +801,18 @@ void cLowLevelGraphicsSDL::SetDepthTestActive(bool abX) {
 //-----------------------------------------------------------------------
 
 void cLowLevelGraphicsSDL::SetDepthTestFunc(eDepthTestFunc aFunc) {
+	if ((int)aFunc == _depthFunc)
+		return;
+	_depthFunc = aFunc;
 	GL_CHECK(glDepthFunc(GetGLDepthTestFuncEnum(aFunc)));
 }
 
 //-----------------------------------------------------------------------
 
 void cLowLevelGraphicsSDL::SetAlphaTestActive(bool abX) {
+	if ((int)abX == _alphaTestActive)
+		return;
+	_alphaTestActive = abX;
 	if (abX)
 		glEnable(GL_ALPHA_TEST);
 	else
@@ -880,6 +912,9 @@ void cLowLevelGraphicsSDL::SetStencilTwoSide(bool abX) {
 //-----------------------------------------------------------------------
 
 void cLowLevelGraphicsSDL::SetCullActive(bool abX) {
+	if ((int)abX == _cullActive)
+		return;
+	_cullActive = abX;
 	if (abX)
 		glEnable(GL_CULL_FACE);
 	else
@@ -915,6 +950,9 @@ void cLowLevelGraphicsSDL::SetScissorRect(const cRect2l &aRect) {
 //-----------------------------------------------------------------------
 
 void cLowLevelGraphicsSDL::SetBlendActive(bool abX) {
+	if ((int)abX == _blendActive)
+		return;
+	_blendActive = abX;
 	if (abX)
 		glEnable(GL_BLEND);
 	else
@@ -925,6 +963,10 @@ void cLowLevelGraphicsSDL::SetBlendActive(bool abX) {
 //-----------------------------------------------------------------------
 
 void cLowLevelGraphicsSDL::SetBlendFunc(eBlendFunc aSrcFactor, eBlendFunc aDestFactor) {
+	if ((int)aSrcFactor == _blendSrc && (int)aDestFactor == _blendDst)
+		return;
+	_blendSrc = aSrcFactor;
+	_blendDst = aDestFactor;
 	GL_CHECK(glBlendFunc(GetGLBlendEnum(aSrcFactor), GetGLBlendEnum(aDestFactor)));
 }
 
@@ -932,6 +974,9 @@ void cLowLevelGraphicsSDL::SetBlendFunc(eBlendFunc aSrcFactor, eBlendFunc aDestF
 
 void cLowLevelGraphicsSDL::SetBlendFuncSeparate(eBlendFunc aSrcFactorColor, eBlendFunc aDestFactorColor,
 												eBlendFunc aSrcFactorAlpha, eBlendFunc aDestFactorAlpha) {
+	// The alpha factors are not cached
+	_blendSrc = -1;
+	_blendDst = -1;
 	if (GetCaps(eGraphicCaps_GL_BlendFunctionSeparate)) {
 
 		glBlendFuncSeparate(GetGLBlendEnum(aSrcFactorColor),
@@ -1792,6 +1837,9 @@ GLenum cLowLevelGraphicsSDL::GetGLStencilOpEnum(eStencilOp type) {
 //-----------------------------------------------------------------------
 
 void cLowLevelGraphicsSDL::SetMatrixMode(eMatrix type) {
+	if ((int)type == _matrixMode)
+		return;
+	_matrixMode = type;
 	switch (type) {
 	case eMatrix_ModelView:
 		GL_CHECK(glMatrixMode(GL_MODELVIEW));
@@ -274,6 +274,23 @@ private:
 	iTexture *_screenBuffer;
 	iGpuProgram *_gammaCorrectionProgram;
 
+	// Last GL state set through this class, so that the render states of
+	// consecutive objects do not send the same values to the driver again.
+	// -1 stands for a state that is not known.
+	int _depthTestActive;
+	int _depthWriteActive;
+	int _depthFunc;
+	int _alphaTestActive;
+	int _cullActive;
+	int _blendActive;
+	int _blendSrc;
+	int _blendDst;
+	int _colorMask;
+	int _matrixMode;
+
+	// Forget the cached state, e.g. after the backend drew to the screen
+	void invalidateStateCache();
+
 	// CG Compiler Variables
 	// CGcontext mCG_Context;
 
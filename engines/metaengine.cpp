@@ -25,6 +25,7 @@
 #include "backends/keymapper/keymap.h"
 #include "backends/keymapper/standard-actions.h"
 
+#include "common/memstream.h"
 #include "common/savefile.h"
 #include "common/system.h"
 #include "common/translation.h"
@@ -371,9 +372,25 @@ SaveStateList MetaEngine::listSaves(const char *target) const {
 		int slotNum = atoi(slotStr);
 
 		if (slotNum >= 0 && slotNum <= getMaximumSaveSlot()) {
-			SaveStateDescriptor desc = querySaveMetaInfos(target, slotNum);
+			// Try the metadata index of the save file manager first, so that
+			// the save doesn't have to be opened and decompressed
+			SaveStateDescriptor desc;
+			Common::Array<byte> metaData;
+			if (saveFileMan->getMetaData(*file, metaData) && !metaData.empty()) {
+				Common::MemoryReadStream stream(&metaData[0], metaData.size());
+				if (desc.loadInfos(stream) && desc.getSaveSlot() == slotNum) {
+					saveList.push_back(desc);
+					continue;
+				}
+			}
+
+			desc = querySaveMetaInfos(target, slotNum);
 			if (desc.getSaveSlot() != -1) {
 				saveList.push_back(desc);
+
+				Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
+				desc.saveInfos(stream);
+				saveFileMan->setMetaData(*file, stream.getData(), stream.size());
 			}
 		}
 	}
@@ -67,7 +67,7 @@ void MohawkSurface::convertToTrueColor() {
 	_surface = surface;
 }
 
-GraphicsManager::GraphicsManager() {
+GraphicsManager::GraphicsManager() : _cacheUseCounter(0) {
 }
 
 GraphicsManager::~GraphicsManager() {
@@ -84,17 +84,44 @@ void GraphicsManager::clearCache() {
 	}
 
 	_cache.clear();
+	_cacheLastUse.clear();
 	_subImageCache.clear();
 }
 
+void GraphicsManager::trimCache(uint32 maxBytes) {
+	uint32 size = 0;
+	for (Common::HashMap<uint16, MohawkSurface *>::iterator it = _cache.begin(); it != _cache.end(); it++) {
+		const Graphics::Surface *surface = it->_value->getSurface();
+		size += surface->pitch * surface->h;
+	}
+
+	while (size > maxBytes) {
+		// Evict the image that was used the longest time ago
+		uint16 oldestId = 0;
+		uint32 oldestUse = 0xFFFFFFFF;
+		for (Common::HashMap<uint16, uint32>::iterator it = _cacheLastUse.begin(); it != _cacheLastUse.end(); it++) {
+			if (it->_value < oldestUse) {
+				oldestId = it->_key;
+				oldestUse = it->_value;
+			}
+		}
+
+		const Graphics::Surface *surface = _cache[oldestId]->getSurface();
+		size -= surface->pitch * surface->h;
+
+		delete _cache[oldestId];
+		_cache.erase(oldestId);
+		_cacheLastUse.erase(oldestId);
+	}
+}
+
 MohawkSurface *GraphicsManager::findImage(uint16 id) {
 	if (!_cache.contains(id))
 		_cache[id] = decodeImage(id);
 
-	// TODO: Probably would be nice to limit the size of the cache
-	// Currently, this can't get large because it is freed on every
-	// card/stack change in Myst/Riven so I'm not worried about it.
-	// Doesn't mean this shouldn't be done in the future.
+	// The cache is freed on every stack change, and on every card change
+	// unless the engine trims it with trimCache() instead
+	_cacheLastUse[id] = ++_cacheUseCounter;
 
 	return _cache[id];
 }
@@ -227,6 +254,7 @@ void GraphicsManager::addImageToCache(uint16 id, MohawkSurface *surface) {
 		error("Image %d already in cache", id);
 
 	_cache[id] = surface;
+	_cacheLastUse[id] = ++_cacheUseCounter;
 }
 
 } // End of namespace Mohawk
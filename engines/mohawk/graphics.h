@@ -73,6 +73,10 @@ public:
 	// Free all surfaces in the cache
 	void clearCache();
 
+	// Free the least recently used surfaces of the cache until
+	// the remaining ones take at most maxBytes
+	void trimCache(uint32 maxBytes);
+
 	// findImage will search the cache to find the image.
 	// If not found, it will call decodeImage to get a new one.
 	MohawkSurface *findImage(uint16 id);
@@ -98,6 +102,8 @@ protected:
 private:
 	// An image cache that stores images until clearCache() is called
 	Common::HashMap<uint16, MohawkSurface *> _cache;
+	Common::HashMap<uint16, uint32> _cacheLastUse;
+	uint32 _cacheUseCounter;
 	Common::HashMap<uint16, Common::Array<MohawkSurface *> > _subImageCache;
 };
 
@@ -76,6 +76,12 @@ MODULE_OBJS += \
 	riven_stacks/pspit.o \
 	riven_stacks/rspit.o \
 	riven_stacks/tspit.o
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	riven_graphics_sse2.o
+$(MODULE)/riven_graphics_sse2.o: CXXFLAGS += -msse2
+endif
 endif
 
 # This module can be built as a plugin
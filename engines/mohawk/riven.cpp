@@ -613,9 +613,9 @@ static const RivenSpecialChange rivenSpecialChange[] = {
 void MohawkEngine_Riven::changeToCard(uint16 dest) {
 	debug (1, "Changing to card %d", dest);
 
-	// Clear the graphics cache (images typically aren't used
-	// on different cards).
-	_gfx->clearCache();
+	// Only keep the most recently used images in the graphics cache, as
+	// exploring often goes back and forth between the same cards
+	_gfx->trimCache(kRivenImageCacheSize);
 
 	if (!isGameVariant(GF_DEMO)) {
 		for (byte i = 0; i < ARRAYSIZE(rivenSpecialChange); i++)
@@ -266,11 +266,17 @@ public:
 			TransitionEffect(system, mainScreen, effectScreen, type, duration, rect) {
 
 		_timeBased = false;
+
+		_blendRow = blendRowRGB565;
+#ifdef SCUMMVM_SSE2
+		if (_system->hasFeature(OSystem::kFeatureCpuSSE2))
+			_blendRow = blendRowRGB565SSE2;
+#endif
 	}
 
 	bool drawFrame(uint32 elapsed) override {
-		assert(_mainScreen->format.bytesPerPixel == 2);
-		assert(_effectScreen->format.bytesPerPixel == 2);
+		assert(_mainScreen->format == Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		assert(_effectScreen->format == _mainScreen->format);
 
 		if (elapsed == _duration) {
 			_effectScreen->copyRectToSurface(*_mainScreen, 0, 0, Common::Rect(_mainScreen->w, _mainScreen->h));
@@ -278,35 +284,45 @@ public:
 			return true; // The transition is complete
 		} else {
 			Graphics::Surface *screen = _system->lockScreen();
+			assert(screen->format == _mainScreen->format);
 
 			uint alpha = elapsed * 255 / _duration;
 			for (int y = 0; y < _mainScreen->h; y++) {
-				uint16 *src1 = (uint16 *) _mainScreen->getBasePtr(0, y);
-				uint16 *src2 = (uint16 *) _effectScreen->getBasePtr(0, y);
+				const uint16 *src1 = (const uint16 *) _mainScreen->getBasePtr(0, y);
+				const uint16 *src2 = (const uint16 *) _effectScreen->getBasePtr(0, y);
 				uint16 *dst = (uint16 *) screen->getBasePtr(0, y);
-				for (int x = 0; x < _mainScreen->w; x++) {
-					uint8 r1, g1, b1, r2, g2, b2;
-					_mainScreen->format.colorToRGB(*src1++, r1, g1, b1);
-					_effectScreen->format.colorToRGB(*src2++, r2, g2, b2);
-
-					uint r = r1 * alpha + r2 * (255 - alpha);
-					uint g = g1 * alpha + g2 * (255 - alpha);
-					uint b = b1 * alpha + b2 * (255 - alpha);
-
-					r /= 255;
-					g /= 255;
-					b /= 255;
-
-					*dst++ = (uint16) screen->format.RGBToColor(r, g, b);
-				}
+				_blendRow(dst, src1, src2, _mainScreen->w, alpha);
 			}
 
 			_system->unlockScreen();
 			return false;
 		}
 	}
+
+private:
+	void (*_blendRow)(uint16 *dst, const uint16 *src1, const uint16 *src2, uint width, uint alpha);
 };
 
+void blendRowRGB565(uint16 *dst, const uint16 *src1, const uint16 *src2, uint width, uint alpha) {
+	for (uint x = 0; x < width; x++) {
+		// Expand the components to 8 bits like PixelFormat::colorToRGB
+		uint r1 = (src1[x] >> 11) & 0x1F, g1 = (src1[x] >> 5) & 0x3F, b1 = src1[x] & 0x1F;
+		uint r2 = (src2[x] >> 11) & 0x1F, g2 = (src2[x] >> 5) & 0x3F, b2 = src2[x] & 0x1F;
+		r1 = (r1 << 3) | (r1 >> 2);
+		g1 = (g1 << 2) | (g1 >> 4);
+		b1 = (b1 << 3) | (b1 >> 2);
+		r2 = (r2 << 3) | (r2 >> 2);
+		g2 = (g2 << 2) | (g2 >> 4);
+		b2 = (b2 << 3) | (b2 >> 2);
+
+		uint r = (r1 * alpha + r2 * (255 - alpha)) / 255;
+		uint g = (g1 * alpha + g2 * (255 - alpha)) / 255;
+		uint b = (b1 * alpha + b2 * (255 - alpha)) / 255;
+
+		dst[x] = (uint16) (((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+	}
+}
+
 RivenGraphics::RivenGraphics(MohawkEngine_Riven* vm) :
 		GraphicsManager(),
 		_vm(vm),
@@ -370,11 +386,13 @@ void RivenGraphics::copyImageToScreen(uint16 image, uint32 left, uint32 top, uin
 	beginScreenUpdate();
 
 	// Clip the width to fit on the screen. Fixes some images.
-	if (left + surface->w > 608)
-		surface->w = 608 - left;
+	// The cached image itself is left untouched, as it may be drawn again.
+	uint16 width = surface->w;
+	if (left + width > 608)
+		width = 608 - left;
 
 	for (uint16 i = 0; i < surface->h; i++)
-		memcpy(_mainScreen->getBasePtr(left, i + top), surface->getBasePtr(0, i), surface->w * surface->format.bytesPerPixel);
+		memcpy(_mainScreen->getBasePtr(left, i + top), surface->getBasePtr(0, i), width * surface->format.bytesPerPixel);
 
 	_dirtyScreen = true;
 	applyScreenUpdate();
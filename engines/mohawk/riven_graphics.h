@@ -58,6 +58,20 @@ enum RivenCreditsImageNumber {
 	kRivenCreditsLastImage   = 320
 };
 
+/**
+ * Size of the decoded images kept in the cache across card changes,
+ * enough for about 16 full card images of 608x392 pixels
+ */
+static const uint32 kRivenImageCacheSize = 8 * 1024 * 1024;
+
+/**
+ * Blend two rows of RGB565 pixels, weighting the first one with alpha / 255
+ */
+void blendRowRGB565(uint16 *dst, const uint16 *src1, const uint16 *src2, uint width, uint alpha);
+#ifdef SCUMMVM_SSE2
+void blendRowRGB565SSE2(uint16 *dst, const uint16 *src1, const uint16 *src2, uint width, uint alpha);
+#endif
+
 class RivenGraphics : public GraphicsManager {
 public:
 	explicit RivenGraphics(MohawkEngine_Riven *vm);
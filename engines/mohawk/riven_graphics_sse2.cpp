@@ -0,0 +1,71 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "mohawk/riven_graphics.h"
+
+namespace Mohawk {
+
+namespace {
+
+// Expand a component of the given bit depth to 8 bits
+template<int bits>
+static inline __m128i expand(__m128i c) {
+	return _mm_or_si128(_mm_slli_epi16(c, 8 - bits), _mm_srli_epi16(c, 2 * bits - 8));
+}
+
+// (c1 * alpha + c2 * (255 - alpha)) / 255, using the exact division
+// x / 255 == (x + 1 + (x >> 8)) >> 8 for the 16 bit range of the sum
+static inline __m128i blend(__m128i c1, __m128i c2, __m128i alpha, __m128i invAlpha) {
+	const __m128i x = _mm_add_epi16(_mm_mullo_epi16(c1, alpha), _mm_mullo_epi16(c2, invAlpha));
+	return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+} // End of anonymous namespace
+
+void blendRowRGB565SSE2(uint16 *dst, const uint16 *src1, const uint16 *src2, uint width, uint alpha) {
+	const __m128i a = _mm_set1_epi16(alpha);
+	const __m128i ia = _mm_set1_epi16(255 - alpha);
+	const __m128i mask5 = _mm_set1_epi16(0x1F);
+	const __m128i mask6 = _mm_set1_epi16(0x3F);
+
+	uint x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const __m128i p1 = _mm_loadu_si128((const __m128i *)(src1 + x));
+		const __m128i p2 = _mm_loadu_si128((const __m128i *)(src2 + x));
+
+		const __m128i r = blend(expand<5>(_mm_srli_epi16(p1, 11)), expand<5>(_mm_srli_epi16(p2, 11)), a, ia);
+		const __m128i g = blend(expand<6>(_mm_and_si128(_mm_srli_epi16(p1, 5), mask6)),
+		                        expand<6>(_mm_and_si128(_mm_srli_epi16(p2, 5), mask6)), a, ia);
+		const __m128i b = blend(expand<5>(_mm_and_si128(p1, mask5)), expand<5>(_mm_and_si128(p2, mask5)), a, ia);
+
+		const __m128i rgb = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(r, 3), 11),
+		                                              _mm_slli_epi16(_mm_srli_epi16(g, 2), 5)),
+		                                 _mm_srli_epi16(b, 3));
+		_mm_storeu_si128((__m128i *)(dst + x), rgb);
+	}
+
+	if (x < width)
+		blendRowRGB565(dst + x, src1 + x, src2 + x, width - x, alpha);
+}
+
+} // End of namespace Mohawk
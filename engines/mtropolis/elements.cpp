@@ -1548,6 +1548,19 @@ Common::Rect MToonElement::getRelativeCollisionRect() const {
 	colRect.translate(_rect.left, _rect.top);
 	return colRect;
 }
+
+Common::Rect MToonElement::getAbsoluteRenderRect() const {
+	Common::Rect renderRect = VisualElement::getAbsoluteRenderRect();
+
+	// Frames are drawn at their own offset, which may be outside of the element rect
+	if (_metadata && _cel >= 1 && static_cast<uint>(_cel) <= _metadata->frames.size()) {
+		Common::Rect frameRect = _metadata->frames[_cel - 1].rect;
+		frameRect.translate(_cachedAbsoluteOrigin.x, _cachedAbsoluteOrigin.y);
+		renderRect.extend(frameRect);
+	}
+
+	return renderRect;
+}
 #ifdef MTROPOLIS_DEBUG_ENABLE
 void MToonElement::debugInspect(IDebugInspectionReport *report) const {
 	VisualElement::debugInspect(report);
@@ -229,6 +229,7 @@ public:
 	bool isMouseCollisionAtPoint(int32 relativeX, int32 relativeY) const override;
 
 	Common::Rect getRelativeCollisionRect() const override;
+	Common::Rect getAbsoluteRenderRect() const override;
 
 #ifdef MTROPOLIS_DEBUG_ENABLE
 	const char *debugGetTypeName() const override { return "mToon Element"; }
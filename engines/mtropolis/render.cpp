@@ -42,6 +42,7 @@ struct OrderedDitherGenerator<TNumber, 1> {
 struct RenderItem {
 	VisualElement *element;
 	size_t sceneStackDepth;
+	Common::Rect rect;
 };
 
 template<class TNumber, int TResolution>
@@ -139,12 +140,17 @@ void Window::resizeWindow(int32 width, int32 height) {
 	Graphics::PixelFormat pixFmt = _surface->format;
 	_surface.reset();
 	_surface.reset(new Graphics::ManagedSurface(width, height, pixFmt));
+	_drawnElements.clear();
 }
 
 const Common::SharedPtr<Graphics::ManagedSurface> &Window::getSurface() const {
 	return _surface;
 }
 
+Common::Array<Window::DrawnElement> &Window::getDrawnElements() {
+	return _drawnElements;
+}
+
 const Graphics::PixelFormat& Window::getPixelFormat() const {
 	return _surface->format;
 }
@@ -236,6 +242,7 @@ static void recursiveCollectDrawElementsAndUpdateOrigins(const Common::Point &pa
 			RenderItem item;
 			item.element = visualElement;
 			item.sceneStackDepth = sceneStackDepth;
+			item.rect = visualElement->getAbsoluteRenderRect();
 
 			if (visualElement->isVisible()) {
 				if (visualElement->isDirectToScreen())
@@ -270,6 +277,94 @@ static void renderDirectElement(const RenderItem &item, Window *mainWindow) {
 	renderNormalElement(item, mainWindow);	// Meh
 }
 
+static void addDirtyRect(Common::Array<Common::Rect> &dirtyRects, Common::Rect rect) {
+	if (rect.isEmpty())
+		return;
+
+	// Merge overlapping rects, a merged rect may then overlap another one
+	for (uint i = 0; i < dirtyRects.size();) {
+		if (dirtyRects[i].intersects(rect)) {
+			rect.extend(dirtyRects[i]);
+			dirtyRects.remove_at(i);
+			i = 0;
+		} else {
+			i++;
+		}
+	}
+
+	dirtyRects.push_back(rect);
+}
+
+static void collectDirtyRects(const Common::Array<RenderItem> &bucket, Common::HashMap<const VisualElement *, Common::Rect> &drawnRects, Common::Array<Common::Rect> &dirtyRects) {
+	for (const RenderItem &item : bucket) {
+		Common::HashMap<const VisualElement *, Common::Rect>::iterator drawnIt = drawnRects.find(item.element);
+
+		if (drawnIt == drawnRects.end()) {
+			addDirtyRect(dirtyRects, item.rect);
+			continue;
+		}
+
+		// Elements can also move on screen because of their parent
+		if (item.element->needsRender() || drawnIt->_value != item.rect) {
+			addDirtyRect(dirtyRects, drawnIt->_value);
+			addDirtyRect(dirtyRects, item.rect);
+		}
+
+		drawnRects.erase(drawnIt);
+	}
+}
+
+static void renderDirtyRect(const Common::Rect &dirtyRect, const Common::Array<RenderItem> &normalBucket, const Common::Array<RenderItem> &directBucket, Window *mainWindow) {
+	Graphics::ManagedSurface &surface = *mainWindow->getSurface();
+
+	// Elements overlapping the dirty rect are drawn whole, so save what is
+	// around the dirty rect and put it back afterwards.
+	Common::Rect drawnRect = dirtyRect;
+	for (const RenderItem &item : normalBucket) {
+		if (item.rect.intersects(dirtyRect))
+			drawnRect.extend(item.rect);
+	}
+	for (const RenderItem &item : directBucket) {
+		if (item.rect.intersects(dirtyRect))
+			drawnRect.extend(item.rect);
+	}
+	drawnRect.clip(Common::Rect(surface.w, surface.h));
+
+	Graphics::Surface saved;
+	if (drawnRect != dirtyRect) {
+		saved.create(drawnRect.width(), drawnRect.height(), surface.format);
+		saved.copyRectToSurface(*surface.surfacePtr(), 0, 0, drawnRect);
+	}
+
+	for (const RenderItem &item : normalBucket) {
+		if (item.rect.intersects(dirtyRect))
+			item.element->render(mainWindow);
+	}
+	for (const RenderItem &item : directBucket) {
+		if (item.rect.intersects(dirtyRect))
+			item.element->render(mainWindow);
+	}
+
+	if (drawnRect != dirtyRect) {
+		const Common::Rect strips[4] = {
+			Common::Rect(drawnRect.left, drawnRect.top, drawnRect.right, dirtyRect.top),
+			Common::Rect(drawnRect.left, dirtyRect.bottom, drawnRect.right, drawnRect.bottom),
+			Common::Rect(drawnRect.left, dirtyRect.top, dirtyRect.left, dirtyRect.bottom),
+			Common::Rect(dirtyRect.right, dirtyRect.top, drawnRect.right, dirtyRect.bottom)
+		};
+
+		for (const Common::Rect &strip : strips) {
+			if (strip.isValidRect() && !strip.isEmpty()) {
+				Common::Rect srcRect = strip;
+				srcRect.translate(-drawnRect.left, -drawnRect.top);
+				surface.copyRectToSurface(saved, strip.left, strip.top, srcRect);
+			}
+		}
+
+		saved.free();
+	}
+}
+
 void renderProject(Runtime *runtime, Window *mainWindow, bool *outSkipped) {
 	bool sceneChanged = runtime->isSceneGraphDirty();
 
@@ -288,25 +383,40 @@ void renderProject(Runtime *runtime, Window *mainWindow, bool *outSkipped) {
 	Common::sort(normalBucket.begin(), normalBucket.end(), renderItemLess);
 	Common::sort(directBucket.begin(), directBucket.end(), renderItemLess);
 
-	if (!sceneChanged) {
-		for (Common::Array<RenderItem>::const_iterator it = normalBucket.begin(), itEnd = normalBucket.end(); it != itEnd; ++it) {
-			if (it->element->needsRender()) {
-				sceneChanged = true;
-				break;
-			}
-		}
-	}
+	Common::Array<Window::DrawnElement> &drawnElements = mainWindow->getDrawnElements();
 
-	if (!sceneChanged) {
-		for (Common::Array<RenderItem>::const_iterator it = directBucket.begin(), itEnd = directBucket.end(); it != itEnd; ++it) {
-			if (it->element->needsRender()) {
-				sceneChanged = true;
-				break;
-			}
+	// Post effects and structural changes, like elements being hidden, affect
+	// the whole window. Otherwise only the areas of the elements which changed
+	// since the last frame are redrawn.
+	bool fullRender = sceneChanged || drawnElements.empty() || !runtime->getPostEffects().empty();
+
+	Common::Array<Common::Rect> dirtyRects;
+	if (!fullRender) {
+		Common::HashMap<const VisualElement *, Common::Rect> drawnRects;
+		for (const Window::DrawnElement &drawn : drawnElements)
+			drawnRects[drawn.element] = drawn.rect;
+
+		collectDirtyRects(normalBucket, drawnRects, dirtyRects);
+		collectDirtyRects(directBucket, drawnRects, dirtyRects);
+
+		// Elements which are not drawn anymore
+		for (const auto &drawn : drawnRects)
+			addDirtyRect(dirtyRects, drawn._value);
+
+		const Common::Rect windowRect(mainWindow->getWidth(), mainWindow->getHeight());
+		uint32 dirtyArea = 0;
+		for (Common::Rect &dirtyRect : dirtyRects) {
+			dirtyRect.clip(windowRect);
+			if (dirtyRect.isValidRect())
+				dirtyArea += dirtyRect.width() * dirtyRect.height();
 		}
+
+		// At this point redrawing everything is cheaper than saving and restoring the surroundings
+		if (dirtyArea * 2 > static_cast<uint32>(windowRect.width() * windowRect.height()))
+			fullRender = true;
 	}
 
-	if (sceneChanged) {
+	if (fullRender) {
 		if (outSkipped)
 			*outSkipped = false;
 
@@ -318,11 +428,38 @@ void renderProject(Runtime *runtime, Window *mainWindow, bool *outSkipped) {
 
 		for (const IPostEffect *postEffect : runtime->getPostEffects())
 			postEffect->renderPostEffect(*mainWindow->getSurface());
+	} else if (!dirtyRects.empty()) {
+		if (outSkipped)
+			*outSkipped = false;
+
+		for (const Common::Rect &dirtyRect : dirtyRects) {
+			if (dirtyRect.isValidRect() && !dirtyRect.isEmpty())
+				renderDirtyRect(dirtyRect, normalBucket, directBucket, mainWindow);
+		}
+
+		for (const RenderItem &item : normalBucket)
+			item.element->finalizeRender();
+		for (const RenderItem &item : directBucket)
+			item.element->finalizeRender();
 	} else {
 		if (outSkipped)
 			*outSkipped = true;
 	}
 
+	drawnElements.clear();
+	for (const RenderItem &item : normalBucket) {
+		Window::DrawnElement drawn;
+		drawn.element = item.element;
+		drawn.rect = item.rect;
+		drawnElements.push_back(drawn);
+	}
+	for (const RenderItem &item : directBucket) {
+		Window::DrawnElement drawn;
+		drawn.element = item.element;
+		drawn.rect = item.rect;
+		drawnElements.push_back(drawn);
+	}
+
 	runtime->clearSceneGraphDirty();
 }
 
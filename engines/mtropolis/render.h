@@ -22,8 +22,10 @@
 #ifndef MTROPOLIS_RENDER_H
 #define MTROPOLIS_RENDER_H
 
+#include "common/array.h"
 #include "common/events.h"
 #include "common/ptr.h"
+#include "common/rect.h"
 #include "common/scummsys.h"
 
 #include "graphics/pixelformat.h"
@@ -42,6 +44,7 @@ namespace MTropolis {
 class CursorGraphic;
 class Runtime;
 class Project;
+class VisualElement;
 struct SceneTransitionEffect;
 
 enum TextAlignment {
@@ -127,6 +130,15 @@ public:
 	virtual void onKeyboardEvent(const Common::EventType evtType, bool repeat, const Common::KeyState &keyEvt);
 	virtual void onAction(Actions::Action action);
 
+	// Elements drawn by the last Render::renderProject call and the area
+	// they covered, used to only redraw what changed in the next frame
+	struct DrawnElement {
+		const VisualElement *element;
+		Common::Rect rect;
+	};
+
+	Common::Array<DrawnElement> &getDrawnElements();
+
 protected:
 	int32 _x;
 	int32 _y;
@@ -137,6 +149,8 @@ protected:
 
 	Common::SharedPtr<Graphics::ManagedSurface> _surface;
 	Common::SharedPtr<CursorGraphic> _cursor;
+
+	Common::Array<DrawnElement> _drawnElements;
 };
 
 namespace Render {
@@ -4640,6 +4640,11 @@ bool Runtime::runFrame() {
 		break;
 	}
 
+	const VThreadStats &vthreadStats = _vthread->getStats();
+	if (vthreadStats.tasksPushed > 0)
+		debug(5, "VThread: %u tasks pushed, %u run, %u stack reallocations, peak stack %u bytes", static_cast<uint>(vthreadStats.tasksPushed), static_cast<uint>(vthreadStats.tasksRun), static_cast<uint>(vthreadStats.reallocations), static_cast<uint>(vthreadStats.peakStackSize));
+	_vthread->resetStats();
+
 #ifdef MTROPOLIS_DEBUG_ENABLE
 	if (_debugger)
 		_debugger->runFrame(realMSec);
@@ -8556,6 +8561,10 @@ void VisualElement::setCachedAbsoluteOrigin(const Common::Point &absOrigin) {
 	_cachedAbsoluteOrigin = absOrigin;
 }
 
+Common::Rect VisualElement::getAbsoluteRenderRect() const {
+	return Common::Rect(_cachedAbsoluteOrigin.x, _cachedAbsoluteOrigin.y, _cachedAbsoluteOrigin.x + _rect.width(), _cachedAbsoluteOrigin.y + _rect.height());
+}
+
 void VisualElement::setDragMotionProperties(const Common::SharedPtr<DragMotionProperties> &dragProps) {
 	_dragProps = dragProps;
 }
@@ -2789,6 +2789,9 @@ public:
 	const Common::Point &getCachedAbsoluteOrigin() const;
 	void setCachedAbsoluteOrigin(const Common::Point &absOrigin);
 
+	// Window area that render() may draw to, based on the cached absolute origin
+	virtual Common::Rect getAbsoluteRenderRect() const;
+
 	void setDragMotionProperties(const Common::SharedPtr<DragMotionProperties> &dragProps);
 	const Common::SharedPtr<DragMotionProperties> &getDragMotionProperties() const;
 
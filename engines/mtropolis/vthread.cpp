@@ -38,7 +38,10 @@ void VThreadTaskData::debugInspect(IDebugInspectionReport *report) const {
 }
 #endif
 
-VThread::VThread() : _faultID(nullptr), _stackUnalignedBase(nullptr), _stackAlignedBase(nullptr), /* _size(0), */_alignment(1), _used(0) {
+VThreadStats::VThreadStats() : tasksPushed(0), tasksRun(0), reallocations(0), peakStackSize(0) {
+}
+
+VThread::VThread() : _faultID(nullptr), _stackUnalignedBase(nullptr), _stackAlignedBase(nullptr), _size(0), _alignment(1), _used(0) {
 }
 
 VThread::~VThread() {
@@ -63,6 +66,7 @@ VThreadState VThread::step() {
 		static_cast<VThreadStackFrame *>(framePtr)->~VThreadStackFrame();
 		if (isHandling) {
 			_faultID = nullptr;
+			_stats.tasksRun++;
 			VThreadState state = data->destructAndRunTask();
 			if (state != kVThreadReturn)
 				return state;
@@ -78,6 +82,14 @@ bool VThread::hasTasks() const {
 	return _used > 0;
 }
 
+const VThreadStats &VThread::getStats() const {
+	return _stats;
+}
+
+void VThread::resetStats() {
+	_stats = VThreadStats();
+}
+
 void VThread::reserveFrame(size_t size, size_t alignment, void *&outFramePtr, void *&outUnadjustedDataPtr, size_t &outPrevFrameOffset) {
 	const size_t frameAlignment = alignof(VThreadStackFrame);
 	const size_t frameAlignmentMask = frameAlignment - 1;
@@ -108,15 +120,23 @@ void VThread::reserveFrame(size_t size, size_t alignment, void *&outFramePtr, vo
 	if (_used > 0)
 		offsetOfPrevFrame = _used - sizeof(VThreadStackFrame);
 
-	if (offsetOfEndOfFrame > _used)
+	if (offsetOfEndOfFrame > _size)
 		needToReallocate = true;
 
 	if (needToReallocate) {
 		size_t maxAlignment = alignment;
 		if (maxAlignment < frameAlignment)
 			maxAlignment = frameAlignment;
+		if (maxAlignment < _alignment)
+			maxAlignment = _alignment;
+
+		size_t newSize = _size * 2;
+		if (newSize < kMinStackSize)
+			newSize = kMinStackSize;
+		if (newSize < offsetOfEndOfFrame)
+			newSize = offsetOfEndOfFrame;
 
-		void *unalignedBase = malloc(offsetOfEndOfFrame + maxAlignment - 1);
+		void *unalignedBase = malloc(newSize + maxAlignment - 1);
 		size_t alignPadding = maxAlignment - (reinterpret_cast<uintptr>(unalignedBase) % maxAlignment);
 		if (alignPadding == maxAlignment)
 			alignPadding = 0;
@@ -166,12 +186,20 @@ void VThread::reserveFrame(size_t size, size_t alignment, void *&outFramePtr, vo
 
 		_stackUnalignedBase = unalignedBase;
 		_stackAlignedBase = alignedBase;
+		_size = newSize;
+		_alignment = maxAlignment;
+
+		_stats.reallocations++;
 	}
 
 	VThreadStackFrame *newFrame = reinterpret_cast<VThreadStackFrame *>(static_cast<char *>(_stackAlignedBase) + offsetOfFrame);
 	void *newData = static_cast<char *>(_stackAlignedBase) + offsetOfData;
 	_used = offsetOfEndOfFrame;
 
+	_stats.tasksPushed++;
+	if (_used > _stats.peakStackSize)
+		_stats.peakStackSize = _used;
+
 	outFramePtr = newFrame;
 	outUnadjustedDataPtr = newData;
 	outPrevFrameOffset = offsetOfPrevFrame;
@@ -118,6 +118,15 @@ private:
 	TData _data;
 };
 
+struct VThreadStats {
+	VThreadStats();
+
+	uint32 tasksPushed;
+	uint32 tasksRun;
+	uint32 reallocations;
+	size_t peakStackSize;
+};
+
 class VThread {
 
 public:
@@ -140,6 +149,9 @@ public:
 
 	bool hasTasks() const;
 
+	const VThreadStats &getStats() const;
+	void resetStats();
+
 private:
 	template<typename TClass, typename TData>
 	TData *pushTaskWithFaultHandler(const VThreadFaultIdentifier *faultID, const char *name, TClass *obj, VThreadState (TClass::*method)(const TData &data));
@@ -152,10 +164,14 @@ private:
 
 	void *_stackUnalignedBase;
 	void *_stackAlignedBase;
-	//size_t _size;
+	size_t _size;
 	size_t _alignment;
 	size_t _used;
 	VThreadFaultIdentifier *_faultID;
+	VThreadStats _stats;
+
+	// Minimum stack capacity, the stack is kept between frames and grows geometrically
+	static const size_t kMinStackSize = 4096;
 };
 
 template<typename TClass, typename TData>
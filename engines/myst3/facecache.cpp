@@ -0,0 +1,224 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "engines/myst3/facecache.h"
+#include "engines/myst3/database.h"
+#include "engines/myst3/gfx.h"
+#include "engines/myst3/myst3.h"
+#include "engines/myst3/state.h"
+
+#include "common/algorithm.h"
+#include "common/debug.h"
+#include "common/system.h"
+
+#include "graphics/surface.h"
+
+namespace Myst3 {
+
+FaceCache::FaceCache(Myst3Engine *vm) :
+		_vm(vm),
+		_prefetchPending(false) {
+}
+
+FaceCache::~FaceCache() {
+	if (_prefetchPending) {
+		g_system->getJobSystem()->wait(_prefetchGroup);
+		finishPrefetch("");
+	}
+
+	for (EntryList::iterator it = _entries.begin(); it != _entries.end(); ++it)
+		freeEntry(*it);
+}
+
+Common::String FaceCache::getKey(uint16 nodeID, uint16 faceID) const {
+	Common::String room = _vm->_db->getRoomName(_vm->_state->getLocationRoom(), _vm->_state->getLocationAge());
+	return Common::String::format("%s-%d-%d", room.c_str(), nodeID, faceID);
+}
+
+bool FaceCache::contains(const Common::String &key) const {
+	for (EntryList::const_iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->key == key)
+			return true;
+	}
+
+	return false;
+}
+
+void FaceCache::freeEntry(Entry &entry) {
+	entry.bitmap->free();
+	delete entry.bitmap;
+	delete entry.texture;
+}
+
+bool FaceCache::take(const Common::String &key, Graphics::Surface *&bitmap, Texture *&texture) {
+	finishPrefetch(key);
+
+	for (EntryList::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->key == key) {
+			bitmap = it->bitmap;
+			texture = it->texture;
+			_entries.erase(it);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FaceCache::store(const Common::String &key, Graphics::Surface *bitmap, Texture *texture) {
+	for (EntryList::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->key == key) {
+			freeEntry(*it);
+			_entries.erase(it);
+			break;
+		}
+	}
+
+	Entry entry;
+	entry.key = key;
+	entry.bitmap = bitmap;
+	entry.texture = texture;
+	_entries.push_front(entry);
+
+	while (_entries.size() > kMaxEntries) {
+		freeEntry(_entries.back());
+		_entries.pop_back();
+	}
+}
+
+void FaceCache::prefetchNeighbours() {
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (jobSystem->getWorkerCount() == 0)
+		return;
+
+	if (_prefetchPending) {
+		jobSystem->wait(_prefetchGroup);
+		finishPrefetch("");
+	}
+
+	GameState *state = _vm->_state;
+	uint16 currentNode = state->getLocationNode();
+	NodePtr nodeData = _vm->_db->getNodeData(currentNode, state->getLocationRoom(), state->getLocationAge());
+	if (!nodeData)
+		return;
+
+	// Look for the nodes the hotspots of the current node move to
+	Common::Array<uint16> neighbours;
+	for (uint i = 0; i < nodeData->hotspots.size() && neighbours.size() < kMaxPrefetchNodes; i++) {
+		const Common::Array<Opcode> &script = nodeData->hotspots[i].script;
+
+		for (uint j = 0; j < script.size() && neighbours.size() < kMaxPrefetchNodes; j++) {
+			const Opcode &opcode = script[j];
+
+			// goToNodeTransition, goToNodeTrans2 and goToNodeTrans1
+			if (opcode.op < 136 || opcode.op > 138 || opcode.args.empty())
+				continue;
+
+			int32 node = state->valueOrVarValue(opcode.args[0]);
+			if (node <= 0 || node == currentNode || Common::find(neighbours.begin(), neighbours.end(), node) != neighbours.end())
+				continue;
+
+			neighbours.push_back(node);
+		}
+	}
+
+	// The archives can only be read from the main thread,
+	// the jobs only decode the JPEG data
+	for (uint i = 0; i < neighbours.size(); i++) {
+		for (uint face = 1; face <= 6; face++) {
+			Common::String key = getKey(neighbours[i], face);
+			if (contains(key))
+				continue;
+
+			ResourceDescription desc = _vm->getFileDescription("", neighbours[i], face, Archive::kCubeFace);
+			if (!desc.isValid())
+				break; // Not a cube node
+
+			PrefetchItem item;
+			item.key = key;
+			item.data = desc.getData();
+			item.bitmap = nullptr;
+			_prefetchItems.push_back(item);
+		}
+	}
+
+	if (_prefetchItems.empty())
+		return;
+
+	debugC(kDebugNode, "Prefetching %d faces of %d nodes", _prefetchItems.size(), neighbours.size());
+
+	_prefetchPending = true;
+	for (uint i = 0; i < _prefetchItems.size(); i++)
+		jobSystem->submit(_prefetchGroup, prefetchProc, &_prefetchItems[i]);
+}
+
+void FaceCache::prefetchProc(void *refCon) {
+	PrefetchItem *item = (PrefetchItem *)refCon;
+	item->bitmap = Myst3Engine::decodeJpeg(item->data);
+}
+
+void FaceCache::finishPrefetch(const Common::String &key) {
+	if (!_prefetchPending)
+		return;
+
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (!jobSystem->isDone(_prefetchGroup)) {
+		uint i = 0;
+		while (i < _prefetchItems.size() && _prefetchItems[i].key != key)
+			i++;
+		if (i == _prefetchItems.size())
+			return;
+
+		jobSystem->wait(_prefetchGroup);
+	}
+
+	_prefetchPending = false;
+
+	for (uint i = 0; i < _prefetchItems.size(); i++) {
+		PrefetchItem &item = _prefetchItems[i];
+		delete item.data;
+
+		if (!item.bitmap)
+			continue;
+
+		// The face may have been stored by a node while the job was running
+		if (contains(item.key)) {
+			item.bitmap->free();
+			delete item.bitmap;
+			continue;
+		}
+
+		Entry entry;
+		entry.key = item.key;
+		entry.bitmap = item.bitmap;
+		entry.texture = nullptr;
+		_entries.push_front(entry);
+	}
+
+	_prefetchItems.clear();
+
+	while (_entries.size() > kMaxEntries) {
+		freeEntry(_entries.back());
+		_entries.pop_back();
+	}
+}
+
+} // End of namespace Myst3
@@ -0,0 +1,124 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MYST3_FACECACHE_H
+#define MYST3_FACECACHE_H
+
+#include "common/array.h"
+#include "common/jobsystem.h"
+#include "common/list.h"
+#include "common/str.h"
+
+namespace Common {
+class SeekableReadStream;
+}
+
+namespace Graphics {
+struct Surface;
+}
+
+namespace Myst3 {
+
+class Myst3Engine;
+class Texture;
+
+/**
+ * Keeps the decoded bitmaps and the textures of recently seen cube faces,
+ * so that going back and forth between nodes does not decode and upload the
+ * same faces every step.
+ *
+ * Faces are handed out to a node when it is loaded and given back when it
+ * is unloaded, if they were not modified in between. The faces of the nodes
+ * reachable from the current one are decoded ahead of time on the worker
+ * threads of the job system.
+ */
+class FaceCache {
+public:
+	FaceCache(Myst3Engine *vm);
+	~FaceCache();
+
+	/** Build the key of a face of a node in the current room */
+	Common::String getKey(uint16 nodeID, uint16 faceID) const;
+
+	/**
+	 * Take a face out of the cache, giving its ownership to the caller
+	 *
+	 * @param texture set to the texture of the face with its pixels already
+	 *                uploaded, or to nullptr if it still has to be created
+	 * @return false if the face is not in the cache
+	 */
+	bool take(const Common::String &key, Graphics::Surface *&bitmap, Texture *&texture);
+
+	/**
+	 * Give a face to the cache, which takes its ownership
+	 *
+	 * @param texture may be nullptr, when the texture was never uploaded
+	 */
+	void store(const Common::String &key, Graphics::Surface *bitmap, Texture *texture);
+
+	/**
+	 * Start decoding the cube faces of the nodes the current node
+	 * leads to, according to its hotspot scripts
+	 */
+	void prefetchNeighbours();
+
+private:
+	struct Entry {
+		Common::String key;
+		Graphics::Surface *bitmap;
+		Texture *texture;
+	};
+
+	// A face read from the archives that is decoded by a job
+	struct PrefetchItem {
+		Common::String key;
+		Common::SeekableReadStream *data;
+		Graphics::Surface *bitmap;
+	};
+
+	typedef Common::List<Entry> EntryList;
+
+	static const uint kMaxEntries = 36;    // Six nodes worth of faces
+	static const uint kMaxPrefetchNodes = 4; // Decoding more would evict the faces of the previous nodes
+
+	Myst3Engine *_vm;
+
+	EntryList _entries; // Most recently used first
+
+	Common::JobGroup _prefetchGroup;
+	bool _prefetchPending;
+	Common::Array<PrefetchItem> _prefetchItems;
+
+	bool contains(const Common::String &key) const;
+	void freeEntry(Entry &entry);
+
+	static void prefetchProc(void *refCon);
+
+	/**
+	 * Move the faces decoded by the prefetch jobs into the cache.
+	 * Waits for the jobs if @p key is one of the faces being decoded.
+	 */
+	void finishPrefetch(const Common::String &key);
+};
+
+} // End of namespace Myst3
+
+#endif // MYST3_FACECACHE_H
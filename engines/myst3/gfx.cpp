@@ -72,6 +72,7 @@ Renderer::Renderer(OSystem *system)
 		for (uint j = 0; j < 4; j++) {
 			_cubeFacesAABB[i].expand(Math::Vector3d(cubeVertices[5 * (4 * i + j) + 2], cubeVertices[5 * (4 * i + j) + 3], cubeVertices[5 * (4 * i + j) + 4]));
 		}
+		_cubeFacesVisible[i] = true;
 	}
 }
 
@@ -165,6 +166,7 @@ void Renderer::setupCameraPerspective(float pitch, float heading, float fov) {
 	_mvpMatrix = proj * model;
 
 	_frustum.setup(_mvpMatrix);
+	_frustum.isInside(_cubeFacesAABB, ARRAYSIZE(_cubeFacesAABB), _cubeFacesVisible);
 
 	_mvpMatrix.transpose();
 }
@@ -172,7 +174,7 @@ void Renderer::setupCameraPerspective(float pitch, float heading, float fov) {
 bool Renderer::isCubeFaceVisible(uint face) {
 	assert(face < 6);
 
-	return _frustum.isInside(_cubeFacesAABB[face]);
+	return _cubeFacesVisible[face];
 }
 
 void Renderer::flipVertical(Graphics::Surface *s) {
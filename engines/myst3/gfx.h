@@ -187,6 +187,7 @@ protected:
 
 	static const float cubeVertices[5 * 6 * 4];
 	Math::AABB _cubeFacesAABB[6];
+	bool _cubeFacesVisible[6]; // Updated when the camera is set up
 
 	Common::Rect getFontCharacterRect(uint8 character);
 
@@ -37,6 +37,7 @@
 #include "engines/myst3/console.h"
 #include "engines/myst3/database.h"
 #include "engines/myst3/effects.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/myst3.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/nodeframe.h"
@@ -63,7 +64,7 @@ namespace Myst3 {
 
 Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 		Engine(syst), _system(syst), _gameDescription(version),
-		_db(nullptr), _scriptEngine(nullptr),
+		_db(nullptr), _faceCache(nullptr), _scriptEngine(nullptr),
 		_state(nullptr), _node(nullptr), _scene(nullptr), _archiveNode(nullptr),
 		_cursor(nullptr), _inventory(nullptr), _gfx(nullptr), _menu(nullptr),
 		_rnd(nullptr), _sound(nullptr), _ambient(nullptr),
@@ -113,6 +114,7 @@ Myst3Engine::~Myst3Engine() {
 	delete _cursor;
 	delete _scene;
 	delete _archiveNode;
+	delete _faceCache;
 	delete _db;
 	delete _scriptEngine;
 	delete _state;
@@ -163,6 +165,7 @@ Common::Error Myst3Engine::run() {
 	setDebugger(new Console(this));
 	_scriptEngine = new Script(this);
 	_db = new Database(getPlatform(), getGameLanguage(), getGameLocalizationType());
+	_faceCache = new FaceCache(this);
 	_state = new GameState(getPlatform(), _db);
 	_scene = new Scene(this);
 	if (getPlatform() == Common::kPlatformXbox) {
@@ -870,6 +873,9 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 	_shakeEffect = ShakeEffect::create(this);
 	_rotationEffect = RotationEffect::create(this);
 
+	if (_state->getViewType() == kCube)
+		_faceCache->prefetchNeighbours();
+
 	// WORKAROUND: In Narayan, the scripts in node NACH 9 test on var 39
 	// without first reinitializing it leading to Saavedro not always giving
 	// Releeshan to the player when he is trapped between both shields.
@@ -1393,13 +1399,21 @@ Graphics::Surface *Myst3Engine::loadTexture(uint16 id) {
 
 Graphics::Surface *Myst3Engine::decodeJpeg(const ResourceDescription *jpegDesc) {
 	Common::SeekableReadStream *jpegStream = jpegDesc->getData();
+	Graphics::Surface *surface = decodeJpeg(jpegStream);
+	delete jpegStream;
+
+	if (!surface)
+		error("Could not decode Myst III JPEG");
 
+	return surface;
+}
+
+Graphics::Surface *Myst3Engine::decodeJpeg(Common::SeekableReadStream *jpegStream) {
 	Image::JPEGDecoder jpeg;
 	jpeg.setOutputPixelFormat(Texture::getRGBAPixelFormat());
 
 	if (!jpeg.loadStream(*jpegStream))
-		error("Could not decode Myst III JPEG");
-	delete jpegStream;
+		return nullptr;
 
 	const Graphics::Surface *bitmap = jpeg.getSurface();
 	assert(bitmap->format == Texture::getRGBAPixelFormat());
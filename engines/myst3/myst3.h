@@ -66,6 +66,7 @@ class HotSpot;
 class Cursor;
 class Inventory;
 class Database;
+class FaceCache;
 class Scene;
 class Script;
 class SpotItemFace;
@@ -100,6 +101,7 @@ public:
 	Renderer *_gfx;
 	Menu *_menu;
 	Database *_db;
+	FaceCache *_faceCache;
 	Sound *_sound;
 	Ambient *_ambient;
 
@@ -132,6 +134,8 @@ public:
 
 	Graphics::Surface *loadTexture(uint16 id);
 	static Graphics::Surface *decodeJpeg(const ResourceDescription *jpegDesc);
+	/** Decode a JPEG image, returns nullptr on failure. Safe to use from job threads. */
+	static Graphics::Surface *decodeJpeg(Common::SeekableReadStream *jpegStream);
 
 	void goToNode(uint16 nodeID, TransitionType transition);
 	void loadNode(uint16 nodeID, uint32 roomID = 0, uint32 ageID = 0);
@@ -21,6 +21,7 @@
 
 #include "engines/myst3/database.h"
 #include "engines/myst3/effects.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/node.h"
 #include "engines/myst3/myst3.h"
 #include "engines/myst3/state.h"
@@ -44,16 +45,43 @@ void Face::setTextureFromJPEG(const ResourceDescription *jpegDesc) {
 	addTextureDirtyRect(Common::Rect(_bitmap->w, _bitmap->h));
 }
 
+void Face::setTextureFromCubeFace(uint16 nodeID, uint16 faceID) {
+	assert(_is3D);
+
+	_cacheKey = _vm->_faceCache->getKey(nodeID, faceID);
+
+	if (_vm->_faceCache->take(_cacheKey, _bitmap, _texture)) {
+		if (_texture) {
+			_textureDirty = false;
+		} else {
+			_texture = _vm->_gfx->createTexture3D(_bitmap);
+			addTextureDirtyRect(Common::Rect(_bitmap->w, _bitmap->h));
+		}
+	} else {
+		ResourceDescription jpegDesc = _vm->getFileDescription("", nodeID, faceID, Archive::kCubeFace);
+
+		if (!jpegDesc.isValid())
+			error("Face %d does not exist", nodeID);
+
+		setTextureFromJPEG(&jpegDesc);
+	}
+
+	_pristine = true;
+}
+
 Face::Face(Myst3Engine *vm, bool is3D) :
 		_vm(vm),
 		_is3D(is3D),
 		_textureDirty(true),
+		_pristine(false),
 		_texture(nullptr),
 		_bitmap(nullptr),
 		_finalBitmap(nullptr) {
 }
 
 void Face::addTextureDirtyRect(const Common::Rect &rect) {
+	_pristine = false;
+
 	if (!_textureDirty) {
 		_textureDirtyRect = rect;
 	} else {
@@ -75,6 +103,17 @@ void Face::uploadTexture() {
 }
 
 Face::~Face() {
+	if (_pristine) {
+		// A texture that was never uploaded has no pixels to reuse
+		if (_textureDirty) {
+			delete _texture;
+			_texture = nullptr;
+		}
+
+		_vm->_faceCache->store(_cacheKey, _bitmap, _texture);
+		return;
+	}
+
 	_bitmap->free();
 	delete _bitmap;
 	_bitmap = nullptr;
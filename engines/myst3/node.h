@@ -48,6 +48,12 @@ public:
 
 	void setTextureFromJPEG(const ResourceDescription *jpegDesc);
 
+	/**
+	 * Load a face of a cube node, reusing its bitmap and texture
+	 * from the face cache when they are available
+	 */
+	void setTextureFromCubeFace(uint16 nodeID, uint16 faceID);
+
 	void addTextureDirtyRect(const Common::Rect &rect);
 	bool isTextureDirty() { return _textureDirty; }
 
@@ -57,6 +63,11 @@ private:
 	bool _textureDirty;
 	Common::Rect _textureDirtyRect;
 
+	// Faces that were not modified since they were loaded
+	// are given back to the face cache when deleted
+	Common::String _cacheKey;
+	bool _pristine;
+
 	Myst3Engine *_vm;
 	bool _is3D;
 };
@@ -89,6 +89,51 @@ enum {
 	kHashMapSize = 1024
 };
 
+CifCache::~CifCache() {
+	for (auto &entry : _entries) {
+		delete[] entry.data;
+	}
+}
+
+Common::SeekableReadStream *CifCache::createReadStream(const CifTree *tree, const Common::Path &name) {
+	for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->tree == tree && it->name.equalsIgnoreCase(name)) {
+			byte *buf = new byte[it->size];
+			memcpy(buf, it->data, it->size);
+			Common::SeekableReadStream *stream = new Common::MemoryReadStream(buf, it->size, DisposeAfterUse::YES);
+
+			// Move to the front
+			_entries.push_front(*it);
+			_entries.erase(it);
+			return stream;
+		}
+	}
+
+	return nullptr;
+}
+
+void CifCache::add(const CifTree *tree, const Common::Path &name, const byte *data, uint32 size) {
+	if (size > _maxSize) {
+		return;
+	}
+
+	while (_size + size > _maxSize) {
+		_size -= _entries.back().size;
+		delete[] _entries.back().data;
+		_entries.pop_back();
+	}
+
+	Entry entry;
+	entry.tree = tree;
+	entry.name = name;
+	entry.data = new byte[size];
+	entry.size = size;
+	memcpy(entry.data, data, size);
+
+	_entries.push_front(entry);
+	_size += size;
+}
+
 CifFile::CifFile(Common::SeekableReadStream *stream, const Common::Path &name) {
 	assert(stream);
 	_stream = stream;
@@ -179,6 +224,7 @@ bool CifFile::sync(Common::Serializer &ser) {
 
 CifTree::CifTree(Common::SeekableReadStream *stream, const Common::Path &name) :
 		_stream(stream),
+		_cache(nullptr),
 		_name(name) {}
 
 CifTree::~CifTree() {
@@ -215,6 +261,14 @@ Common::SeekableReadStream *CifTree::createReadStreamForMember(const Common::Pat
 	}
 
 	const CifInfo &info = _fileMap[path];
+
+	if (info.comp == CifInfo::kResCompression && _cache) {
+		Common::SeekableReadStream *cached = _cache->createReadStream(this, info.name);
+		if (cached) {
+			return cached;
+		}
+	}
+
 	byte *buf = new byte[info.size];
 
 	bool success = true;
@@ -226,6 +280,10 @@ Common::SeekableReadStream *CifTree::createReadStreamForMember(const Common::Pat
 			Common::SeekableSubReadStream read(_stream, info.dataOffset, info.dataOffset + info.compressedSize);
 			Decompressor dec;
 			success = dec.decompress(read, write);
+
+			if (success && _cache) {
+				_cache->add(this, info.name, buf, info.size);
+			}
 		} else {
 			success = false;
 		}
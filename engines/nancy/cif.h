@@ -25,6 +25,7 @@
 #include "common/archive.h"
 #include "common/rect.h"
 #include "common/hashmap.h"
+#include "common/list.h"
 
 namespace Common {
 class SeekableReadStream;
@@ -58,6 +59,35 @@ struct CifInfo {
 	uint32 dataOffset;
 };
 
+class CifTree;
+
+// Keeps the decompressed data of recently read ciftree files, up to a maximum number of bytes.
+// Decompression is slow, and the same scene and image files get read over and over again.
+// Shared by all loaded ciftrees.
+class CifCache {
+public:
+	CifCache(uint32 maxSize) : _size(0), _maxSize(maxSize) {}
+	~CifCache();
+
+	// Returns a stream with a copy of the cached data, or nullptr if the file is not in the cache
+	Common::SeekableReadStream *createReadStream(const CifTree *tree, const Common::Path &name);
+
+	// Adds a copy of the data of a file, making room by dropping the least recently used files
+	void add(const CifTree *tree, const Common::Path &name, const byte *data, uint32 size);
+
+private:
+	struct Entry {
+		const CifTree *tree;
+		Common::Path name;
+		byte *data;
+		uint32 size;
+	};
+
+	Common::List<Entry> _entries; // Most recently used first
+	uint32 _size;
+	uint32 _maxSize;
+};
+
 // Wrapper for a single file. Exclusively used for scene IFFs, though it can contain anything.
 class CifFile {
 private:
@@ -81,7 +111,7 @@ private:
 class CifTree : public Common::Archive {
 protected:
 friend class ResourceManager;
-	CifTree() : _stream(nullptr) {}
+	CifTree() : _stream(nullptr), _cache(nullptr) {}
 	CifTree(Common::SeekableReadStream *stream, const Common::Path &name);
 	virtual ~CifTree();
 
@@ -106,6 +136,7 @@ private:
 
 	Common::Path _name;
 	Common::SeekableReadStream *_stream;
+	CifCache *_cache;
 	Common::HashMap<Common::Path, CifInfo, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> _fileMap;
 	Common::Array<CifInfo> _writeFileMap;
 };
@@ -98,6 +98,8 @@ NancyEngine::~NancyEngine() {
 	for (auto &data : _engineData) {
 		delete data._value;
 	}
+
+	delete _resource;
 }
 
 NancyEngine *NancyEngine::create(GameType type, OSystem *syst, const NancyGameDescription *gd) {
@@ -35,6 +35,15 @@ static char treePrefix[] = "_tree_";
 
 namespace Nancy {
 
+ResourceManager::~ResourceManager() {
+	// The ciftrees use the cache, so they must not outlive it
+	for (uint i = 0; i < _cifTreeNames.size(); ++i) {
+		Common::String upper = _cifTreeNames[i];
+		upper.toUppercase();
+		SearchMan.remove(treePrefix + upper);
+	}
+}
+
 bool ResourceManager::loadImage(const Common::Path &name, Graphics::ManagedSurface &surf, const Common::String &treeName, Common::Rect *outSrc, Common::Rect *outDest) {
 	// Detect and load autotext surfaces
 	Common::String baseName(name.baseName());
@@ -193,12 +202,27 @@ IFF *ResourceManager::loadIFF(const Common::Path &name) {
 	return nullptr;
 }
 
+void ResourceManager::prefetch(const Common::Path &name) {
+	for (uint i = 0; i < _cifTreeNames.size(); ++i) {
+		Common::String upper = _cifTreeNames[i];
+		upper.toUppercase();
+		const CifTree *tree = (const CifTree *)SearchMan.getArchive(treePrefix + upper);
+		if (tree->hasFile(name)) {
+			// Reading the file puts it into the cache
+			delete tree->createReadStreamForMember(name);
+			return;
+		}
+	}
+}
+
 bool ResourceManager::readCifTree(const Common::String &name, const Common::String &ext, int priority) {
 	CifTree *tree = CifTree::makeCifTreeArchive(name, ext);
 	if (!tree) {
 		return false;
 	}
 
+	tree->_cache = &_cifCache;
+
 	// Add a prefix to avoid clashes with the ciftree folder present in some games.
 	// Also, set the name itself to uppercase since SearchMan is case-sensitive.
 	// Final name to look up is _tree_TREENAME
@@ -222,6 +246,8 @@ PatchTree *ResourceManager::readPatchTree(Common::SeekableReadStream *stream, co
 		return nullptr;
 	}
 
+	tree->_cache = &_cifCache;
+
 	Common::String upper = name;
 	upper.toUppercase();
 	SearchMan.add(treePrefix + upper, tree, priority, true);
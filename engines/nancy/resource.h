@@ -37,7 +37,7 @@ class ResourceManager {
 	friend class NancyConsole;
 	friend class NancyEngine;
 public:
-	ResourceManager() {}
+	ResourceManager() : _cifCache(8 * 1024 * 1024) {}
 	~ResourceManager();
 
 	// Load an image resource. Can be either external .bmp file, or raw image data embedded inside a ciftree
@@ -48,6 +48,9 @@ public:
 	// Loads a single IFF file. These can either be inside standalone .cif files, or embedded inside a ciftree
 	IFF *loadIFF(const Common::Path &name);
 
+	// Decompresses a file inside the ciftrees ahead of time, so that it can be loaded quickly later
+	void prefetch(const Common::Path &name);
+
 	// Load a new ciftree
 	bool readCifTree(const Common::String &name, const Common::String &ext, int priority);
 	PatchTree *readPatchTree(Common::SeekableReadStream *stream, const Common::String &name, int priority);
@@ -69,6 +72,7 @@ private:
 
 private:
 	Common::Array<Common::String> _cifTreeNames;
+	CifCache _cifCache;
 };
 
 } // End of namespace Nancy
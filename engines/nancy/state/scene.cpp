@@ -32,6 +32,8 @@
 #include "engines/nancy/util.h"
 #include "engines/nancy/resource.h"
 
+#include "engines/nancy/action/navigationrecords.h"
+
 #include "engines/nancy/state/scene.h"
 #include "engines/nancy/state/map.h"
 
@@ -900,6 +902,14 @@ void Scene::load(bool fromSaveFile) {
 		++numRecords;
 	}
 
+	// Scene files are compressed, so get the scenes that can be reached from here ready ahead of time
+	for (auto *record : _actionManager.getActionRecords()) {
+		Action::SceneChange *sceneChange = dynamic_cast<Action::SceneChange *>(record);
+		if (sceneChange && sceneChange->_sceneChange.sceneID != kNoScene && sceneChange->_sceneChange.sceneID != _sceneState.currentScene.sceneID) {
+			g_nancy->_resource->prefetch(Common::Path(Common::String::format("S%u", sceneChange->_sceneChange.sceneID)));
+		}
+	}
+
 	if (_sceneState.currentScene.paletteID == -1) {
 		_sceneState.currentScene.paletteID = 0;
 	}
@@ -24,6 +24,7 @@
 #include "engines/metaengine.h"
 #include "graphics/surface.h"
 #include "common/config-manager.h"
+#include "common/stream.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 
@@ -111,3 +112,46 @@ bool SaveStateDescriptor::isValid() const
 {
 	return _slot >= 0 && !_description.empty();
 }
+
+static const byte kSaveInfosVersion = 1;
+
+static void writeInfosString(Common::WriteStream &stream, const Common::String &str) {
+	stream.writeUint32LE(str.size());
+	stream.writeString(str);
+}
+
+static Common::String readInfosString(Common::ReadStream &stream) {
+	return stream.readString(0, stream.readUint32LE());
+}
+
+void SaveStateDescriptor::saveInfos(Common::WriteStream &stream) const {
+	stream.writeByte(kSaveInfosVersion);
+	stream.writeSint32LE(_slot);
+	writeInfosString(stream, _description.encode());
+	stream.writeByte(_isDeletable);
+	stream.writeByte(_isWriteProtected);
+	writeInfosString(stream, _saveDate);
+	writeInfosString(stream, _saveTime);
+	writeInfosString(stream, _playTime);
+	stream.writeUint32LE(_playTimeMSecs);
+	stream.writeByte(_saveType);
+}
+
+bool SaveStateDescriptor::loadInfos(Common::ReadStream &stream) {
+	if (stream.readByte() != kSaveInfosVersion)
+		return false;
+
+	_slot = stream.readSint32LE();
+	_description = readInfosString(stream).decode();
+	_isDeletable = stream.readByte();
+	_isWriteProtected = stream.readByte();
+	_isLocked = false;
+	_saveDate = readInfosString(stream);
+	_saveTime = readInfosString(stream);
+	_playTime = readInfosString(stream);
+	_playTimeMSecs = stream.readUint32LE();
+	_saveType = (SaveType)stream.readByte();
+	_thumbnail.reset();
+
+	return !stream.eos() && !stream.err();
+}
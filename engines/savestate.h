@@ -29,6 +29,11 @@
 
 class MetaEngine;
 
+namespace Common {
+class ReadStream;
+class WriteStream;
+}
+
 namespace Graphics {
 struct Surface;
 }
@@ -225,6 +230,19 @@ public:
 	 * Returns true if this entry is valid
 	 */
 	bool isValid() const;
+
+	/**
+	 * Write everything but the thumbnail and the locked state to the
+	 * stream, for example to keep it in the save file metadata index.
+	 */
+	void saveInfos(Common::WriteStream &stream) const;
+
+	/**
+	 * Read what was written by saveInfos().
+	 *
+	 * @return False if the stream doesn't contain a descriptor.
+	 */
+	bool loadInfos(Common::ReadStream &stream);
 private:
 	/**
 	 * The saveslot id, as it would be passed to the "-x" command line switch.
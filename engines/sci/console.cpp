@@ -54,6 +54,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
@@ -117,6 +118,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	registerCmd("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
 	registerCmd("integrity_dump",	WRAP_METHOD(Console, cmdResourceIntegrityDump));
@@ -150,6 +152,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
 	// Segments
 	registerCmd("segment_table",		WRAP_METHOD(Console, cmdPrintSegmentTable));
 	registerCmd("segtable",			WRAP_METHOD(Console, cmdPrintSegmentTable));	// alias
@@ -157,6 +160,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("seginfo",			WRAP_METHOD(Console, cmdSegmentInfo));			// alias
 	registerCmd("segment_kill",		WRAP_METHOD(Console, cmdKillSegment));
 	registerCmd("segkill",			WRAP_METHOD(Console, cmdKillSegment));			// alias
+	registerCmd("selector_cache",		WRAP_METHOD(Console, cmdSelectorCache));
 	// Garbage collection
 	registerCmd("gc",					WRAP_METHOD(Console, cmdGCInvoke));
 	registerCmd("gc_objects",			WRAP_METHOD(Console, cmdGCObjects));
@@ -183,6 +187,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("dissect_script",		WRAP_METHOD(Console, cmdDissectScript));
 	registerCmd("backtrace",			WRAP_METHOD(Console, cmdBacktrace));
 	registerCmd("bt",					WRAP_METHOD(Console, cmdBacktrace));	// alias
+	registerCmd("vm_profile",			WRAP_METHOD(Console, cmdVMProfile));
 	registerCmd("trace",				WRAP_METHOD(Console, cmdTrace));
 	registerCmd("t",					WRAP_METHOD(Console, cmdTrace));		// alias
 	registerCmd("s",					WRAP_METHOD(Console, cmdTrace));		// alias
@@ -357,6 +362,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_types - Shows the valid resource types\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
+	debugPrintf(" resource_cache - Shows resource cache statistics, or sets its size\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	debugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
 	debugPrintf(" integrity_dump - Dumps integrity data about resources in the current game to disk\n");
@@ -386,11 +392,13 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
+	debugPrintf(" cel_cache - Shows cel cache statistics (SCI2+)\n");
 	debugPrintf("\n");
 	debugPrintf("Segments:\n");
 	debugPrintf(" segment_table / segtable - Lists all segments\n");
 	debugPrintf(" segment_info / seginfo - Provides information on the specified segment\n");
 	debugPrintf(" segment_kill / segkill - Deletes the specified segment\n");
+	debugPrintf(" selector_cache - Shows selector lookup cache statistics\n");
 	debugPrintf("\n");
 	debugPrintf("Garbage collection:\n");
 	debugPrintf(" gc - Invokes the garbage collector\n");
@@ -418,6 +426,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" registers / reg - Shows the current register values\n");
 	debugPrintf(" dissect_script - Examines a script\n");
 	debugPrintf(" backtrace / bt - Dumps the send/self/super/call/calle/callb stack\n");
+	debugPrintf(" vm_profile - Profiles script methods and kernel calls\n");
 	debugPrintf(" trace / t / s - Executes one operation (no parameters) or several operations (specified as a parameter) \n");
 	debugPrintf(" stepover / p - Executes one operation, skips over call/send\n");
 	debugPrintf(" step_ret / pret - Steps forward until ret is called on the current execution stack level.\n");
@@ -1134,6 +1143,32 @@ bool Console::cmdAllocList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		resMan->resetLRUStats();
+		debugPrintf("Resource cache statistics reset\n");
+		return true;
+	} else if (argc == 2 && Common::isDigit(argv[1][0])) {
+		resMan->setMaxMemoryLRU(atoi(argv[1]) * 1024);
+		debugPrintf("Resource cache size set to %d KB\n", resMan->getMaxMemoryLRU() / 1024);
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Shows resource cache statistics, resets them, or sets the cache size.\n");
+		debugPrintf("Usage: %s [reset | <size in KB>]\n", argv[0]);
+		debugPrintf("The size can be set permanently with the sci_resource_cache_size option.\n");
+		return true;
+	}
+
+	const ResourceManager::LRUStats &stats = resMan->getLRUStats();
+	debugPrintf("Resource cache: %u resources, %d of %d KB, %d KB locked\n", resMan->getNumLRU(),
+		resMan->getMemoryLRU() / 1024, resMan->getMaxMemoryLRU() / 1024, resMan->getMemoryLocked() / 1024);
+	debugPrintf("Hits: %u, misses: %u, evictions: %u (%u uncompressed first)\n",
+		stats.hits, stats.misses, stats.evictions, stats.cheapEvictions);
+	return true;
+}
+
 bool Console::cmdDissectScript(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Examines a script\n");
@@ -2411,6 +2446,33 @@ bool Console::cmdShowSavedBits(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdCelCache(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	CelCache *const cache = CelObj::getCache();
+	if (!cache) {
+		debugPrintf("This SCI version does not have a cel cache\n");
+		return true;
+	}
+
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		cache->resetStats();
+		debugPrintf("Cel cache statistics reset\n");
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Shows cel cache statistics.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const CelCache::Stats &stats = cache->getStats();
+	debugPrintf("Cel cache: %u cels, %u of %u KB\n", cache->getCount(), cache->getSize() / 1024, cache->getBudget() / 1024);
+	debugPrintf("Hits: %u, misses: %u, evictions: %u\n", stats.hits, stats.misses, stats.evictions);
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 
 bool Console::cmdParseGrammar(int argc, const char **argv) {
 	debugPrintf("Parse grammar, in strict GNF:\n");
@@ -2826,6 +2888,25 @@ bool Console::cmdIsSample(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdSelectorCache(int argc, const char **argv) {
+	SegManager *segMan = _engine->_gamestate->_segMan;
+
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		segMan->resetSelectorCacheStats();
+		debugPrintf("Selector cache statistics reset\n");
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Shows selector lookup cache statistics.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const SegManager::SelectorCacheStats &stats = segMan->getSelectorCacheStats();
+	debugPrintf("Selector lookups: %u, hits: %u, misses: %u\n", stats.hits + stats.misses, stats.hits, stats.misses);
+	debugPrintf("Invalidations: %u\n", stats.invalidations);
+	return true;
+}
+
 bool Console::cmdGCInvoke(int argc, const char **argv) {
 	debugPrintf("Performing garbage collection...\n");
 	run_gc(_engine->_gamestate);
@@ -3623,6 +3704,71 @@ bool Console::cmdBacktrace(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdVMProfile(int argc, const char **argv) {
+	VMProfiler &profiler = _debugState.profiler;
+
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		profiler.reset();
+		profiler.setEnabled(true);
+		debugPrintf("VM profiling enabled\n");
+		return true;
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		profiler.setEnabled(false);
+		debugPrintf("VM profiling disabled\n");
+		return true;
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		profiler.reset();
+		debugPrintf("VM profile reset\n");
+		return true;
+	} else if (argc > 2 || (argc == 2 && atoi(argv[1]) <= 0)) {
+		debugPrintf("Counts the instructions and measures the time spent in each script method\n");
+		debugPrintf("and kernel function, and shows the most expensive ones.\n");
+		debugPrintf("Usage: %s [on | off | reset | <count>]\n", argv[0]);
+		debugPrintf("Shows the top 20 entries of each kind if no count is given.\n");
+		return true;
+	}
+
+	const uint count = argc == 2 ? atoi(argv[1]) : 20;
+	const uint64 totalTime = profiler.getTotalTime();
+	debugPrintf("VM profiling is %s, %u ms recorded\n", profiler.isEnabled() ? "on" : "off", (uint)(totalTime / 1000));
+
+	VMProfiler::EntryList methods;
+	profiler.getMethods(methods);
+
+	Common::HashMap<int, VMProfiler::Entry> scripts;
+	for (uint i = 0; i < methods.size(); ++i) {
+		VMProfiler::Entry &script = scripts.getOrCreateVal(methods[i]->script);
+		script.script = methods[i]->script;
+		script.instructions += methods[i]->instructions;
+		script.time += methods[i]->time;
+	}
+
+	VMProfiler::EntryList scriptList;
+	for (Common::HashMap<int, VMProfiler::Entry>::const_iterator i = scripts.begin(); i != scripts.end(); ++i)
+		scriptList.push_back(&i->_value);
+	Common::sort(scriptList.begin(), scriptList.end(), VMProfiler::compareEntries);
+
+	debugPrintf("\nScripts:\n");
+	debugPrintf("  script  instructions       ms\n");
+	for (uint i = 0; i < scriptList.size() && i < count; ++i)
+		debugPrintf("  %6d  %12u  %7u\n", scriptList[i]->script, scriptList[i]->instructions, (uint)(scriptList[i]->time / 1000));
+
+	debugPrintf("\nMethods:\n");
+	debugPrintf("  script  instructions       ms  method\n");
+	for (uint i = 0; i < methods.size() && i < count; ++i)
+		debugPrintf("  %6d  %12u  %7u  %s\n", methods[i]->script, methods[i]->instructions, (uint)(methods[i]->time / 1000), methods[i]->name.c_str());
+
+	VMProfiler::EntryList kernelCalls;
+	profiler.getKernelCalls(kernelCalls);
+
+	debugPrintf("\nKernel calls:\n");
+	debugPrintf("         calls       ms  function\n");
+	for (uint i = 0; i < kernelCalls.size() && i < count; ++i)
+		debugPrintf("  %12u  %7u  %s\n", kernelCalls[i]->calls, (uint)(kernelCalls[i]->time / 1000), kernelCalls[i]->name.c_str());
+
+	return true;
+}
+
 bool Console::cmdTrace(int argc, const char **argv) {
 	if (argc == 2 && atoi(argv[1]) > 0)
 		_debugState.runningStep = atoi(argv[1]) - 1;
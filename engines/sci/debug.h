@@ -22,11 +22,17 @@
 #ifndef SCI_DEBUG_H
 #define SCI_DEBUG_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/list.h"
+#include "common/str.h"
 #include "sci/engine/vm_types.h"	// for StackPtr
 
 namespace Sci {
 
+struct ExecStack;
+class SegManager;
+
 // These types are used both as identifiers and as elements of bitfields
 enum BreakpointType {
 	/**
@@ -71,6 +77,99 @@ enum DebugSeeking {
 	kDebugSeekStepOver = 5      // Step forward until we reach same stack-level again
 };
 
+/**
+ * Aggregate profile of the script VM. While enabled, each executed instruction
+ * and the wall time between two frame switches is charged to the script method
+ * that was running, and kernel calls are counted and timed separately. Time
+ * spent inside a kernel call is not charged to the calling method, except for
+ * any script code the kernel function runs itself.
+ */
+class VMProfiler {
+public:
+	struct Entry {
+		Common::String name;
+		int script;          ///< Script number, or -1 for kernel functions
+		uint32 instructions;
+		uint32 calls;        ///< Only counted for kernel functions
+		uint64 time;         ///< Wall time in microseconds
+	};
+
+	typedef Common::Array<const Entry *> EntryList;
+
+	VMProfiler();
+
+	bool isEnabled() const { return _enabled; }
+	void setEnabled(bool enabled);
+
+	/**
+	 * Clears all counters. Entries are kept, so that pointers held by
+	 * kernel calls in progress stay valid.
+	 */
+	void reset();
+
+	/**
+	 * Charges the following instructions to the method executing in the
+	 * given frame.
+	 */
+	void enterFrame(SegManager *segMan, const ExecStack &xs, int scriptNr);
+	void countInstruction() { if (_current) _current->instructions++; }
+
+	/**
+	 * Charges the following time to a kernel function. Returns the entry
+	 * that was charged before, which must be passed to leave().
+	 */
+	Entry *enterKernel(int kernelCallNr, int kernelSubCallNr);
+
+	/**
+	 * Charges the following time to the given entry again, after a kernel
+	 * call or a nested VM has finished. Time is not charged anywhere while
+	 * the entry is null.
+	 */
+	void leave(Entry *caller) { charge(caller); }
+	Entry *getCurrent() const { return _current; }
+
+	/** Returns all entries with a non-zero count, most expensive first. */
+	void getMethods(EntryList &list) const;
+	void getKernelCalls(EntryList &list) const;
+	uint64 getTotalTime() const { return _totalTime; }
+
+	/** Orders entries by time, then by instructions and calls, descending. */
+	static bool compareEntries(const Entry *a, const Entry *b);
+
+private:
+	struct MethodKey {
+		int script;
+		int selector;
+		int exportId;
+		int localCallOffset;
+		const char *objectName; ///< Shared by all clones of an object
+
+		bool operator==(const MethodKey &other) const {
+			return script == other.script && selector == other.selector && exportId == other.exportId &&
+				localCallOffset == other.localCallOffset && objectName == other.objectName;
+		}
+	};
+
+	struct MethodKey_Hash {
+		uint operator()(const MethodKey &key) const {
+			return (key.script * 0x9E3779B1) ^ (key.selector * 0x85EBCA77) ^ (key.exportId << 16) ^
+				key.localCallOffset ^ (uint)(size_t)key.objectName;
+		}
+	};
+
+	typedef Common::HashMap<MethodKey, Entry, MethodKey_Hash> MethodMap;
+	typedef Common::HashMap<uint32, Entry> KernelCallMap;
+
+	bool _enabled;
+	Entry *_current;
+	uint64 _lastTime;
+	uint64 _totalTime;
+	MethodMap _methods;
+	KernelCallMap _kernelCalls;
+
+	void charge(Entry *next);
+};
+
 struct DebugState {
 	bool debugging;
 	bool breakpointWasHit;
@@ -83,6 +182,7 @@ struct DebugState {
 	StackPtr old_sp;
 	Common::List<Breakpoint> _breakpoints;   //< List of breakpoints
 	int _activeBreakpointTypes;  //< Bit mask specifying which types of breakpoints are active
+	VMProfiler profiler;
 
 	void updateActiveBreakpointTypes();
 };
@@ -178,6 +178,19 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
+void run_scheduled_gc(EngineState *s) {
+	// A full collection marks the whole heap, which takes a while with the
+	// large heaps of long SCI32 sessions. If nothing has been allocated and no
+	// script has been disposed of since the last one, the heap cannot have
+	// grown, so the collection is put off until something is allocated.
+	if (!s->_segMan->getGCEvents()) {
+		debugC(kDebugLevelGC, "[GC] Nothing allocated since the last run, skipping");
+		return;
+	}
+
+	run_gc(s);
+}
+
 void run_gc(EngineState *s) {
 	SegManager *segMan = s->_segMan;
 
@@ -225,6 +238,8 @@ void run_gc(EngineState *s) {
 
 	delete activeRefs;
 
+	segMan->resetGCEvents();
+
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
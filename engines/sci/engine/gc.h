@@ -54,6 +54,15 @@ AddrSet *findAllActiveReferences(EngineState *s);
  */
 void run_gc(EngineState *s);
 
+/**
+ * Runs garbage collection when it is due from the kernel call countdown.
+ * It is skipped while nothing has been allocated since the previous one, as
+ * the heap cannot have grown; explicit collections through run_gc() always
+ * scan the whole heap.
+ * @param s The state in which we should gc
+ */
+void run_scheduled_gc(EngineState *s);
+
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
 	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
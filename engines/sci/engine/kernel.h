@@ -342,6 +342,13 @@ reg_t kSort(EngineState *s, int argc, reg_t *argv);
 reg_t kStrEnd(EngineState *s, int argc, reg_t *argv);
 reg_t kMemory(EngineState *s, int argc, reg_t *argv);
 reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv);
+
+/**
+ * Frees the visibility graphs kept by kAvoidPath for recently seen polygon
+ * sets.
+ */
+void clearAvoidPathCache();
+
 reg_t kParse(EngineState *s, int argc, reg_t *argv);
 reg_t kSaid(EngineState *s, int argc, reg_t *argv);
 reg_t kStrCpy(EngineState *s, int argc, reg_t *argv);
@@ -116,10 +116,20 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Position in PathfindingState::vertex_index
+	int index;
+
+	// A* set membership
+	bool inOpenSet;
+	bool inClosedSet;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = nullptr;
+		index = -1;
+		inOpenSet = false;
+		inClosedSet = false;
 	}
 };
 
@@ -241,6 +251,31 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+/**
+ * Visibility between the polygon vertices of a pathfinding query. It only
+ * depends on the polygons, so it is kept for later queries on the same
+ * polygon set. Rows are filled in as A* expands the vertices.
+ */
+struct VisibilityGraph {
+	uint32 hash;
+	Common::Array<Common::Point> points;
+	Common::Array<uint> polygonSizes;
+
+	uint size;
+	Common::Array<byte> rowComputed;
+	Common::Array<byte> visible; // size * size
+
+	bool matches(uint32 hash_, const Common::Array<Common::Point> &points_, const Common::Array<uint> &polygonSizes_) const {
+		return hash == hash_ && points == points_ && polygonSizes == polygonSizes_;
+	}
+};
+
+#define VISIBILITY_GRAPH_CACHE_SIZE 8
+#define VISIBILITY_GRAPH_MAX_SIZE 1024
+
+// Most recently used first
+static VisibilityGraph *visibilityGraphs[VISIBILITY_GRAPH_CACHE_SIZE];
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
@@ -262,6 +297,15 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Cached visibility between the polygon vertices, or NULL if the start or
+	// end point split a polygon edge
+	VisibilityGraph *_graph;
+
+	// The start and end points, if they are not polygon vertices, are the
+	// first vertices of vertex_index. Their visibility is computed per query.
+	int _extraCount;
+	Common::Array<byte> _extraVisible[2];
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = nullptr;
 		vertex_end = nullptr;
@@ -269,6 +313,8 @@ struct PathfindingState {
 		_prependPoint = nullptr;
 		_appendPoint = nullptr;
 		vertices = 0;
+		_graph = nullptr;
+		_extraCount = 0;
 	}
 
 	~PathfindingState() {
@@ -698,6 +744,66 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Determines whether a vertex can be seen from another one. The test is
+ * symmetric in both vertices.
+ * @param s				the pathfinding state
+ * @param vertex_cur	the vertex to look from
+ * @param vertex		the vertex to look at
+ * @return true if the line between both vertices does not cross a polygon
+ */
+static bool vertex_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	// Check for intersecting edges
+	for (int j = 0; j < s->vertices; j++) {
+		Vertex *edge = s->vertex_index[j];
+		if (VERTEX_HAS_EDGES(edge)) {
+			if (between(vertex_cur->v, vertex->v, edge->v)) {
+				// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+				if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
+					return false;
+
+				// This edge won't properly intersect, so we continue
+				continue;
+			}
+
+			if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Determines whether a vertex can be seen from another one, using and filling
+ * in the cached visibility graph.
+ */
+static bool cached_vertex_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	if (vertex == vertex_cur)
+		return false;
+
+	if (vertex_cur->index < s->_extraCount)
+		return s->_extraVisible[vertex_cur->index][vertex->index];
+	if (vertex->index < s->_extraCount)
+		return s->_extraVisible[vertex->index][vertex_cur->index];
+
+	VisibilityGraph *graph = s->_graph;
+	const uint row = vertex_cur->index - s->_extraCount;
+	byte *visible = &graph->visible[row * graph->size];
+
+	if (!graph->rowComputed[row]) {
+		for (uint i = 0; i < graph->size; i++)
+			visible[i] = vertex_visible(s, vertex_cur, s->vertex_index[s->_extraCount + i]);
+		graph->rowComputed[row] = 1;
+	}
+
+	return visible[vertex->index - s->_extraCount];
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -710,30 +816,7 @@ static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
-			continue;
-
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
-
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
-			}
-		}
-
-		if (j == s->vertices)
+		if (s->_graph ? cached_vertex_visible(s, vertex_cur, vertex) : vertex_visible(s, vertex_cur, vertex))
 			visVerts->push_front(vertex);
 	}
 
@@ -1117,13 +1200,16 @@ static Common::Point *fixup_end_point(PathfindingState *s, const Common::Point &
  * the new vertex
  * Parameters: (PathfindingState *) s: The pathfinding state
  *             (const Common::Point &) v: The point to merge
+ *             (bool &) splitEdge: Set if an edge was split
  * Returns   : (Vertex *) The vertex corresponding to v
  */
-static Vertex *merge_point(PathfindingState *s, const Common::Point &v) {
+static Vertex *merge_point(PathfindingState *s, const Common::Point &v, bool &splitEdge) {
 	Vertex *vertex;
 	Vertex *v_new;
 	Polygon *polygon;
 
+	splitEdge = false;
+
 	// Check for already existing vertex
 	for (PolygonList::iterator it = s->polygons.begin(); it != s->polygons.end(); ++it) {
 		polygon = *it;
@@ -1146,6 +1232,7 @@ static Vertex *merge_point(PathfindingState *s, const Common::Point &v) {
 				if (between(vertex->v, next->v, v)) {
 					// Split edge by adding vertex
 					polygon->vertices.insertAfter(vertex, v_new);
+					splitEdge = true;
 					return v_new;
 				}
 			}
@@ -1160,6 +1247,69 @@ static Vertex *merge_point(PathfindingState *s, const Common::Point &v) {
 	return v_new;
 }
 
+/**
+ * Finds or creates the cached visibility graph for the current polygon set
+ * Parameters: (PathfindingState *) s: The pathfinding state
+ * Returns   : (VisibilityGraph *) The graph, or NULL if the set is too large
+ */
+static VisibilityGraph *find_visibility_graph(PathfindingState *s) {
+	Common::Array<Common::Point> points;
+	Common::Array<uint> polygonSizes;
+	uint32 hash = 2166136261u;
+
+	for (PolygonList::iterator it = s->polygons.begin(); it != s->polygons.end(); ++it) {
+		Vertex *vertex;
+		uint size = 0;
+
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			points.push_back(vertex->v);
+			hash = (hash ^ (uint16)vertex->v.x) * 16777619u;
+			hash = (hash ^ (uint16)vertex->v.y) * 16777619u;
+			size++;
+		}
+
+		polygonSizes.push_back(size);
+		hash = (hash ^ size) * 16777619u;
+	}
+
+	if (points.size() > VISIBILITY_GRAPH_MAX_SIZE)
+		return nullptr;
+
+	int i;
+	for (i = 0; i < VISIBILITY_GRAPH_CACHE_SIZE - 1 && visibilityGraphs[i]; i++) {
+		if (visibilityGraphs[i]->matches(hash, points, polygonSizes))
+			break;
+	}
+
+	VisibilityGraph *graph = visibilityGraphs[i];
+	if (!graph || !graph->matches(hash, points, polygonSizes)) {
+		delete graph;
+		graph = new VisibilityGraph();
+		graph->hash = hash;
+		graph->points = points;
+		graph->polygonSizes = polygonSizes;
+		graph->size = points.size();
+		graph->rowComputed.resize(graph->size);
+		graph->visible.resize(graph->size * graph->size);
+		for (uint j = 0; j < graph->size; j++)
+			graph->rowComputed[j] = 0;
+	}
+
+	// Move to the front
+	for (; i > 0; i--)
+		visibilityGraphs[i] = visibilityGraphs[i - 1];
+	visibilityGraphs[0] = graph;
+
+	return graph;
+}
+
+void clearAvoidPathCache() {
+	for (int i = 0; i < VISIBILITY_GRAPH_CACHE_SIZE; i++) {
+		delete visibilityGraphs[i];
+		visibilityGraphs[i] = nullptr;
+	}
+}
+
 /**
  * Converts an SCI polygon into a Polygon
  * Parameters: (EngineState *) s: The game state
@@ -1326,13 +1476,22 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	// The visibility between polygon vertices stays the same when the start
+	// and end points are merged in, unless they split an edge
+	VisibilityGraph *graph = find_visibility_graph(pf_s);
+	const uint polygonCount = pf_s->polygons.size();
+	bool splitStartEdge, splitEndEdge;
+
 	// Merge start and end points into polygon set
-	pf_s->vertex_start = merge_point(pf_s, *new_start);
-	pf_s->vertex_end = merge_point(pf_s, *new_end);
+	pf_s->vertex_start = merge_point(pf_s, *new_start, splitStartEdge);
+	pf_s->vertex_end = merge_point(pf_s, *new_end, splitEndEdge);
 
 	delete new_start;
 	delete new_end;
 
+	if (!splitStartEdge && !splitEndEdge)
+		pf_s->_graph = graph;
+
 	// Allocate and build vertex index
 	pf_s->vertex_index = (Vertex**)malloc(sizeof(Vertex *) * (count + 2));
 
@@ -1343,12 +1502,27 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		Vertex *vertex;
 
 		CLIST_FOREACH(vertex, &polygon->vertices) {
+			vertex->index = count;
 			pf_s->vertex_index[count++] = vertex;
 		}
 	}
 
 	pf_s->vertices = count;
 
+	if (pf_s->_graph) {
+		// Single-vertex polygons for the start and end points were added
+		// in front of the others
+		pf_s->_extraCount = pf_s->polygons.size() - polygonCount;
+		assert(pf_s->_extraCount <= 2 && (uint)(count - pf_s->_extraCount) == pf_s->_graph->size);
+
+		for (int i = 0; i < pf_s->_extraCount; i++) {
+			Vertex *extra = pf_s->vertex_index[i];
+			pf_s->_extraVisible[i].resize(count);
+			for (int j = 0; j < count; j++)
+				pf_s->_extraVisible[i][j] = vertex_visible(pf_s, extra, pf_s->vertex_index[j]);
+		}
+	}
+
 	return pf_s;
 }
 
@@ -1360,13 +1534,12 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
  * Parameters: (PathfindingState *) s: The pathfinding state
  */
 static void AStar(PathfindingState *s) {
-	// Vertices of which the shortest path is known
-	VertexList closedSet;
-
-	// The remaining vertices
+	// The remaining vertices. Vertices of which the shortest path is known
+	// are flagged with inClosedSet.
 	VertexList openSet;
 
 	openSet.push_front(s->vertex_start);
+	s->vertex_start->inOpenSet = true;
 	s->vertex_start->costG = 0;
 	s->vertex_start->costF = (uint32)sqrt((float)s->vertex_start->v.sqrDist(s->vertex_end->v));
 
@@ -1392,7 +1565,8 @@ static void AStar(PathfindingState *s) {
 			break;
 
 		// Move vertex from set open to set closed
-		closedSet.push_front(vertex_min);
+		vertex_min->inClosedSet = true;
+		vertex_min->inOpenSet = false;
 		openSet.erase(vertex_min_it);
 
 		VertexList *visVerts = visible_vertices(s, vertex_min);
@@ -1401,11 +1575,13 @@ static void AStar(PathfindingState *s) {
 			uint32 new_dist;
 			Vertex *vertex = *it;
 
-			if (closedSet.contains(vertex))
+			if (vertex->inClosedSet)
 				continue;
 
-			if (!openSet.contains(vertex))
+			if (!vertex->inOpenSet) {
 				openSet.push_front(vertex);
+				vertex->inOpenSet = true;
+			}
 
 			new_dist = vertex_min->costG + (uint32)sqrt((float)vertex_min->v.sqrDist(vertex->v));
 
@@ -1628,7 +1804,7 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 			return output;
 		}
 
-		// Apply Dijkstra
+		// Find the shortest path
 		AStar(p);
 
 		output = output_path(p, s);
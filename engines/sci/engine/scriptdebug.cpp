@@ -30,6 +30,7 @@
 #include "sci/engine/scriptdebug.h"
 
 #include "common/algorithm.h"
+#include "common/system.h"
 
 namespace Sci {
 
@@ -69,6 +70,116 @@ const char *opcodeNames[] = {
 };
 #endif	// REDUCE_MEMORY_USAGE
 
+VMProfiler::VMProfiler() : _enabled(false), _current(nullptr), _lastTime(0), _totalTime(0) {
+}
+
+void VMProfiler::setEnabled(bool enabled) {
+	if (_enabled == enabled)
+		return;
+
+	if (!enabled)
+		charge(nullptr);
+	_enabled = enabled;
+	_current = nullptr;
+	_lastTime = g_system->getMicros();
+}
+
+void VMProfiler::reset() {
+	for (MethodMap::iterator i = _methods.begin(); i != _methods.end(); ++i) {
+		i->_value.instructions = 0;
+		i->_value.time = 0;
+	}
+	for (KernelCallMap::iterator i = _kernelCalls.begin(); i != _kernelCalls.end(); ++i) {
+		i->_value.calls = 0;
+		i->_value.time = 0;
+	}
+	_totalTime = 0;
+	_lastTime = g_system->getMicros();
+}
+
+void VMProfiler::charge(Entry *next) {
+	const uint64 now = g_system->getMicros();
+	if (_current) {
+		_current->time += now - _lastTime;
+		_totalTime += now - _lastTime;
+	}
+	_lastTime = now;
+	_current = next;
+}
+
+void VMProfiler::enterFrame(SegManager *segMan, const ExecStack &xs, int scriptNr) {
+	MethodKey key;
+	key.script = scriptNr;
+	key.selector = xs.debugSelector;
+	key.exportId = xs.debugExportId;
+	key.localCallOffset = xs.debugLocalCallOffset;
+	key.objectName = xs.debugSelector != -1 ? segMan->getObjectName(xs.sendp) : nullptr;
+
+	MethodMap::iterator i = _methods.find(key);
+	if (i == _methods.end()) {
+		Entry &entry = _methods[key];
+		if (xs.debugSelector != -1)
+			entry.name = Common::String::format("%s::%s", key.objectName, g_sci->getKernel()->getSelectorName(xs.debugSelector).c_str());
+		else if (xs.debugExportId != -1)
+			entry.name = Common::String::format("export %d", xs.debugExportId);
+		else
+			entry.name = Common::String::format("call %x", xs.debugLocalCallOffset);
+		entry.script = scriptNr;
+		entry.instructions = 0;
+		entry.calls = 0;
+		entry.time = 0;
+		charge(&entry);
+	} else {
+		charge(&i->_value);
+	}
+}
+
+VMProfiler::Entry *VMProfiler::enterKernel(int kernelCallNr, int kernelSubCallNr) {
+	const uint32 key = kernelCallNr << 16 | (kernelSubCallNr + 1);
+
+	Entry *caller = _current;
+	KernelCallMap::iterator i = _kernelCalls.find(key);
+	Entry *entry;
+	if (i == _kernelCalls.end()) {
+		entry = &_kernelCalls[key];
+		entry->name = "k" + (kernelSubCallNr == -1 ? g_sci->getKernel()->getKernelName(kernelCallNr) : g_sci->getKernel()->getKernelName(kernelCallNr, kernelSubCallNr));
+		entry->script = -1;
+		entry->instructions = 0;
+		entry->calls = 0;
+		entry->time = 0;
+	} else {
+		entry = &i->_value;
+	}
+
+	entry->calls++;
+	charge(entry);
+	return caller;
+}
+
+bool VMProfiler::compareEntries(const Entry *a, const Entry *b) {
+	if (a->time != b->time)
+		return a->time > b->time;
+	return a->instructions + a->calls > b->instructions + b->calls;
+}
+
+void VMProfiler::getMethods(EntryList &list) const {
+	list.clear();
+	for (MethodMap::const_iterator i = _methods.begin(); i != _methods.end(); ++i) {
+		if (i->_value.instructions || i->_value.time)
+			list.push_back(&i->_value);
+	}
+	Common::sort(list.begin(), list.end(), compareEntries);
+}
+
+void VMProfiler::getKernelCalls(EntryList &list) const {
+	list.clear();
+	for (KernelCallMap::const_iterator i = _kernelCalls.begin(); i != _kernelCalls.end(); ++i) {
+		if (i->_value.calls)
+			list.push_back(&i->_value);
+	}
+	Common::sort(list.begin(), list.end(), compareEntries);
+}
+
 void DebugState::updateActiveBreakpointTypes() {
 	int type = 0;
 	for (Common::List<Breakpoint>::iterator bp = _breakpoints.begin(); bp != _breakpoints.end(); ++bp) {
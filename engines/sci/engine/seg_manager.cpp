@@ -39,6 +39,13 @@ SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
 	_nodesSegId = 0;
 	_hunksSegId = 0;
 
+	// Collect at the first opportunity
+	_gcEvents = 1;
+
+	memset(_selectorCache, 0, sizeof(_selectorCache));
+	_selectorCacheGeneration = 1;
+	resetSelectorCacheStats();
+
 	_saveDirPtr = NULL_REG;
 	_parserPtr = NULL_REG;
 
@@ -71,6 +78,11 @@ void SegManager::resetSegMan() {
 	_nodesSegId = 0;
 	_hunksSegId = 0;
 
+	// Restored games always get a collection at the first opportunity
+	_gcEvents = 1;
+
+	invalidateSelectorCache();
+
 #ifdef ENABLE_SCI32
 	_arraysSegId = 0;
 	_bitmapSegId = 0;
@@ -113,6 +125,8 @@ SegmentId SegManager::allocSegment(SegmentObj *mobj) {
 	if (!mobj)
 		error("SegManager: invalid mobj");
 
+	_gcEvents++;
+
 	// Find a free segment
 	SegmentId id = findFreeSegment();
 
@@ -178,6 +192,9 @@ void SegManager::deallocate(SegmentId seg) {
 		}
 	}
 
+	if (mobj->getType() == SEG_TYPE_SCRIPT || mobj->getType() == SEG_TYPE_CLONES)
+		invalidateSelectorCache();
+
 	delete mobj;
 	_heap[actualSegment] = nullptr;
 }
@@ -248,6 +265,44 @@ SegmentObj *SegManager::getSegment(SegmentId seg, SegmentType type) const {
 	return (actualSegmentType == type) ? _heap[actualSegment] : nullptr;
 }
 
+bool SegManager::findCachedSelector(reg_t obj, Selector selectorId, SelectorType &type, int &varIndex, reg_t &func) {
+	const SelectorCacheEntry &entry = _selectorCache[selectorCacheIndex(obj, selectorId)];
+	if (entry.generation != _selectorCacheGeneration || entry.obj != obj || entry.selector != selectorId) {
+		_selectorCacheStats.misses++;
+		return false;
+	}
+
+	_selectorCacheStats.hits++;
+	type = entry.type;
+	varIndex = entry.varIndex;
+	func = entry.func;
+	return true;
+}
+
+void SegManager::cacheSelector(reg_t obj, Selector selectorId, SelectorType type, int varIndex, reg_t func) {
+	SelectorCacheEntry &entry = _selectorCache[selectorCacheIndex(obj, selectorId)];
+	entry.obj = obj;
+	entry.selector = selectorId;
+	entry.generation = _selectorCacheGeneration;
+	entry.type = type;
+	entry.varIndex = varIndex;
+	entry.func = func;
+}
+
+void SegManager::invalidateSelectorCache() {
+	_selectorCacheStats.invalidations++;
+	if (++_selectorCacheGeneration == 0) {
+		memset(_selectorCache, 0, sizeof(_selectorCache));
+		_selectorCacheGeneration = 1;
+	}
+}
+
+void SegManager::resetSelectorCacheStats() {
+	_selectorCacheStats.hits = 0;
+	_selectorCacheStats.misses = 0;
+	_selectorCacheStats.invalidations = 0;
+}
+
 Object *SegManager::getObject(reg_t pos) const {
 	SegmentObj *mobj = getSegmentObj(pos.getSegment());
 	Object *obj = nullptr;
@@ -459,6 +514,7 @@ reg_t SegManager::allocateHunkEntry(const char *hunk_type, int size) {
 	}
 
 	int offset = table->allocEntry();
+	_gcEvents++;
 
 	reg_t addr = make_reg(_hunksSegId, offset);
 	Hunk &h = table->at(offset);
@@ -492,6 +548,7 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 	}
 
 	int offset = table->allocEntry();
+	_gcEvents++;
 
 	*addr = make_reg(_clonesSegId, offset);
 	return &table->at(offset);
@@ -508,6 +565,7 @@ List *SegManager::allocateList(reg_t *addr) {
 	}
 
 	int offset = table->allocEntry();
+	_gcEvents++;
 
 	*addr = make_reg(_listsSegId, offset);
 	return &table->at(offset);
@@ -524,6 +582,7 @@ Node *SegManager::allocateNode(reg_t *addr) {
 	}
 
 	int offset = table->allocEntry();
+	_gcEvents++;
 
 	*addr = make_reg(_nodesSegId, offset);
 	return &table->at(offset);
@@ -950,6 +1009,7 @@ SciArray *SegManager::allocateArray(SciArrayType type, uint16 size, reg_t *addr)
 	}
 
 	int offset = table->allocEntry();
+	_gcEvents++;
 
 	*addr = make_reg(_arraysSegId, offset);
 
@@ -1006,6 +1066,7 @@ SciBitmap *SegManager::allocateBitmap(reg_t *addr, const int16 width, const int1
 	}
 
 	int offset = table->allocEntry();
+	_gcEvents++;
 
 	*addr = make_reg(_bitmapSegId, offset);
 	SciBitmap &bitmap = table->at(offset);
@@ -1099,7 +1160,19 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 		scr = allocateScript(scriptNum, segmentId);
 	}
 
+	invalidateSelectorCache();
+
 	scr->load(scriptNum, _resMan, _scriptPatcher, applyScriptPatches);
+
+	// Room scripts are loaded once the new room number has been set, and
+	// share their number with the pic of the room and often with some of its
+	// views and sounds. Start decompressing those while the room initializes.
+	const EngineState *s = g_sci->getEngineState();
+	Script *script000 = getScriptIfLoaded(getScriptSegment(0));
+	if (scriptNum != 0 && s && script000 && s->variables[VAR_GLOBAL] == script000->getLocalsBegin() &&
+		scriptNum == s->currentRoomNumber())
+		_resMan->prefetchRoom(scriptNum);
+
 	scr->initializeLocals(this);
 	scr->initializeClasses(this);
 	scr->initializeObjects(this, segmentId, applyScriptPatches);
@@ -1107,6 +1180,10 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 	g_sci->_guestAdditions->instantiateScriptHook(*scr);
 #endif
 
+	// Lookups made while the objects were set up may have seen them half
+	// initialized
+	invalidateSelectorCache();
+
 	return segmentId;
 }
 
@@ -1137,6 +1214,7 @@ void SegManager::uninstantiateScript(int script_nr) {
 	if (!scr->getLockers()) {
 		// The actual script deletion seems to be done by SCI scripts themselves
 		scr->markDeleted();
+		_gcEvents++;
 		debugC(kDebugLevelScripts, "Unloaded script 0x%x.", script_nr);
 	}
 }
@@ -60,6 +60,18 @@ public:
 
 	void resetSegMan();
 
+	/**
+	 * Returns the number of segments and collectable objects allocated, and of
+	 * scripts marked for deletion, since the last garbage collection. When it
+	 * is zero, the garbage in the heap cannot have grown since then either.
+	 */
+	uint32 getGCEvents() const { return _gcEvents; }
+
+	/**
+	 * Called by the garbage collector after a collection.
+	 */
+	void resetGCEvents() { _gcEvents = 0; }
+
 	void saveLoadWithSerializer(Common::Serializer &ser) override;
 
 	// 1. Scripts
@@ -396,6 +408,34 @@ public:
 	 */
 	bool isObject(reg_t obj) const { return getObject(obj) != NULL; }
 
+	/**
+	 * Cache of lookupSelector() results, indexed by object address and
+	 * selector. Lookups otherwise walk the variable selectors of the class and
+	 * the method tables of all superclasses on every send.
+	 */
+	struct SelectorCacheStats {
+		uint32 hits;
+		uint32 misses;
+		uint32 invalidations;
+	};
+
+	/**
+	 * Looks up a cached selector. Returns false if it is not cached.
+	 */
+	bool findCachedSelector(reg_t obj, Selector selectorId, SelectorType &type, int &varIndex, reg_t &func);
+
+	void cacheSelector(reg_t obj, Selector selectorId, SelectorType type, int varIndex, reg_t func);
+
+	/**
+	 * Drops all cached selectors. Called whenever an object may have moved or
+	 * changed class: when scripts are loaded or freed, and when clones are
+	 * freed.
+	 */
+	void invalidateSelectorCache();
+
+	const SelectorCacheStats &getSelectorCacheStats() const { return _selectorCacheStats; }
+	void resetSelectorCacheStats();
+
 	// TODO: document this
 	bool isHeapObject(reg_t pos) const;
 
@@ -469,6 +509,26 @@ private:
 	ResourceManager *_resMan;
 	ScriptPatcher *_scriptPatcher;
 
+	uint32 _gcEvents; ///< Allocations and script deletions since the last garbage collection
+
+	struct SelectorCacheEntry {
+		reg_t obj;
+		Selector selector;
+		uint32 generation;
+		SelectorType type;
+		int varIndex;
+		reg_t func;
+	};
+
+	static const uint kSelectorCacheSize = 4096;
+	SelectorCacheEntry _selectorCache[kSelectorCacheSize];
+	uint32 _selectorCacheGeneration; ///< Entries from older generations are invalid
+	SelectorCacheStats _selectorCacheStats;
+
+	static uint selectorCacheIndex(reg_t obj, Selector selectorId) {
+		return ((obj.getSegment() * 0x9E3779B1) ^ (obj.getOffset() * 0x85EBCA77) ^ (selectorId * 0xC2B2AE3D)) >> 20 & (kSelectorCacheSize - 1);
+	}
+
 	SegmentId _clonesSegId; ///< ID of the (a) clones segment
 	SegmentId _listsSegId; ///< ID of the (a) list segment
 	SegmentId _nodesSegId; ///< ID of the (a) node segment
@@ -124,6 +124,7 @@ void CloneTable::freeAtAddress(SegManager *segMan, reg_t addr) {
 #endif
 
 	freeEntry(addr.getOffset());
+	segMan->invalidateSelectorCache();
 }
 
 
@@ -333,6 +333,18 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 	if (oldScriptHeader)
 		selectorId &= ~1;
 
+	SelectorType type;
+	reg_t func;
+	if (segMan->findCachedSelector(obj_location, selectorId, type, index, func)) {
+		if (type == kSelectorVariable && varp) {
+			varp->obj = obj_location;
+			varp->varindex = index;
+		} else if (type == kSelectorMethod && fptr) {
+			*fptr = func;
+		}
+		return type;
+	}
+
 	if (!obj) {
 		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x", PRINT_REG(obj_location));
 	}
@@ -345,6 +357,7 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 			varp->obj = obj_location;
 			varp->varindex = index;
 		}
+		segMan->cacheSelector(obj_location, selectorId, kSelectorVariable, index, NULL_REG);
 		return kSelectorVariable;
 	} else {
 		// Check if it's a method, with recursive lookup in superclasses
@@ -354,12 +367,14 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 				if (fptr)
 					*fptr = obj->getFunction(index);
 
+				segMan->cacheSelector(obj_location, selectorId, kSelectorMethod, -1, obj->getFunction(index));
 				return kSelectorMethod;
 			} else {
 				obj = segMan->getObject(obj->getSuperClassSelector());
 			}
 		}
 
+		segMan->cacheSelector(obj_location, selectorId, kSelectorNone, -1, NULL_REG);
 		return kSelectorNone;
 	}
 
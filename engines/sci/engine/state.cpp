@@ -76,6 +76,7 @@ EngineState::EngineState(SegManager *segMan) :
 
 EngineState::~EngineState() {
 	delete _msgState;
+	clearAvoidPathCache();
 }
 
 void EngineState::reset(bool isRestoring) {
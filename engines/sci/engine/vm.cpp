@@ -314,6 +314,7 @@ static void addKernelCallToExecStack(EngineState *s, int kernelCallNr, int kerne
 
 static void callKernelFunc(EngineState *s, int kernelCallNr, int argc) {
 	Kernel *kernel = g_sci->getKernel();
+	VMProfiler &profiler = g_sci->_debugState.profiler;
 
 	if (kernelCallNr >= (int)kernel->_kernelFuncs.size())
 		error("Invalid kernel function 0x%x requested", kernelCallNr);
@@ -350,7 +351,13 @@ static void callKernelFunc(EngineState *s, int kernelCallNr, int argc) {
 	if (!kernelCall.subFunctionCount) {
 		argv[-1] = make_reg(0, argc); // The first argument is argc
 		addKernelCallToExecStack(s, kernelCallNr, -1, argc, argv);
-		s->r_acc = kernelCall.function(s, argc, argv);
+		if (profiler.isEnabled()) {
+			VMProfiler::Entry *caller = profiler.enterKernel(kernelCallNr, -1);
+			s->r_acc = kernelCall.function(s, argc, argv);
+			profiler.leave(caller);
+		} else {
+			s->r_acc = kernelCall.function(s, argc, argv);
+		}
 
 		if (g_sci->checkKernelBreakpoint(kernelCall.name))
 			logKernelCall(&kernelCall, nullptr, s, argc, argv, s->r_acc);
@@ -415,7 +422,13 @@ static void callKernelFunc(EngineState *s, int kernelCallNr, int argc) {
 			error("[VM] k%s: subfunction ID %d requested, but not available", kernelCall.name, subId);
 		argv[-1] = make_reg(0, argc); // The first argument is argc
 		addKernelCallToExecStack(s, kernelCallNr, subId, argc, argv);
-		s->r_acc = kernelSubCall.function(s, argc, argv);
+		if (profiler.isEnabled()) {
+			VMProfiler::Entry *caller = profiler.enterKernel(kernelCallNr, subId);
+			s->r_acc = kernelSubCall.function(s, argc, argv);
+			profiler.leave(caller);
+		} else {
+			s->r_acc = kernelSubCall.function(s, argc, argv);
+		}
 
 		if (g_sci->checkKernelBreakpoint(kernelSubCall.name))
 			logKernelCall(&kernelCall, &kernelSubCall, s, argc, argv, s->r_acc);
@@ -565,6 +578,9 @@ void run_vm(EngineState *s) {
 
 	s->_executionStackPosChanged = true; // Force initialization
 
+	VMProfiler &profiler = g_sci->_debugState.profiler;
+	VMProfiler::Entry *const profilerCaller = profiler.getCurrent();
+
 #ifdef ABORT_ON_INFINITE_LOOP
 	byte prevOpcode = 0xFF;
 #endif
@@ -576,8 +592,11 @@ void run_vm(EngineState *s) {
 		g_sci->_debugState.old_pc_offset = s->xs->addr.pc.getOffset();
 		g_sci->_debugState.old_sp = s->xs->sp;
 
-		if (s->abortScriptProcessing != kAbortNone)
+		if (s->abortScriptProcessing != kAbortNone) {
+			if (profiler.isEnabled())
+				profiler.leave(profilerCaller);
 			return; // Stop processing
+		}
 
 		if (s->_executionStackPosChanged) {
 			scr = s->_segMan->getScriptIfLoaded(s->xs->addr.pc.getSegment());
@@ -599,6 +618,9 @@ void run_vm(EngineState *s) {
 			}
 			s->variables[VAR_TEMP] = s->xs->fp;
 			s->variables[VAR_PARAM] = s->xs->variables_argp;
+
+			if (profiler.isEnabled())
+				profiler.enterFrame(s->_segMan, *s->xs, scr->getScriptNumber());
 		}
 
 		g_sci->checkAddressBreakpoint(s->xs->addr.pc);
@@ -624,6 +646,8 @@ void run_vm(EngineState *s) {
 		byte extOpcode;
 		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
 		const byte opcode = extOpcode >> 1;
+		if (profiler.isEnabled())
+			profiler.countInstruction();
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
 #ifdef ABORT_ON_INFINITE_LOOP
@@ -850,7 +874,7 @@ void run_vm(EngineState *s) {
 			// Run the garbage collector, if needed
 			if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				run_scheduled_gc(s);
 			}
 
 			// Call kernel function
@@ -877,8 +901,11 @@ void run_vm(EngineState *s) {
 			s->_executionStackPosChanged = true;
 
 			// If a game is being loaded, stop processing
-			if (s->abortScriptProcessing != kAbortNone)
+			if (s->abortScriptProcessing != kAbortNone) {
+				if (profiler.isEnabled())
+					profiler.leave(profilerCaller);
 				return; // Stop processing
+			}
 
 			break;
 		}
@@ -923,6 +950,8 @@ void run_vm(EngineState *s) {
 					s->_executionStack.pop_back();
 
 					s->_executionStackPosChanged = true;
+					if (profiler.isEnabled())
+						profiler.leave(profilerCaller);
 					return; // "Hard" return
 				}
 
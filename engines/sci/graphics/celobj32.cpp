@@ -33,6 +33,7 @@
 #include "graphics/larryScale.h"
 #include "common/config-manager.h"
 #include "common/gui_options.h"
+#include "common/system.h"
 
 namespace Sci {
 #pragma mark CelScaler
@@ -85,12 +86,18 @@ const CelScalerTable &CelScaler::getScalerTable(const Ratio &scaleX, const Ratio
 #pragma mark CelObj
 bool CelObj::_drawBlackLines = false;
 
+static void selectCelRowProcs();
+
 void CelObj::init() {
 	CelObj::deinit();
 	_drawBlackLines = false;
-	_nextCacheId = 1;
 	_scaler = new CelScaler();
-	_cache = new CelCache(100);
+	selectCelRowProcs();
+
+	uint32 budget = CelCache::kDefaultBudget;
+	if (ConfMan.hasKey("sci_cel_cache_size"))
+		budget = (uint32)MAX(ConfMan.getInt("sci_cel_cache_size"), 0) * 1024;
+	_cache = new CelCache(budget);
 }
 
 void CelObj::deinit() {
@@ -148,6 +155,18 @@ struct SCALER_NoScale {
 			return *_row++;
 		}
 	}
+
+	/**
+	 * Returns the next `width` source pixels of an unmirrored row so they can
+	 * be drawn as a span.
+	 */
+	inline const byte *readRow(const int16 width) {
+		assert(!FLIP);
+		const byte *row = _row;
+		_row += width;
+		assert(_row <= _rowEdge);
+		return row;
+	}
 };
 
 template<bool FLIP, typename READER>
@@ -351,32 +370,47 @@ public:
 struct READER_Compressed {
 private:
 	const SciSpan<const byte> _resource;
+	const byte *const _decodedPixels;
 	byte _buffer[kCelScalerTableSize];
 	uint32 _controlOffset;
 	uint32 _dataOffset;
 	uint32 _uncompressedDataOffset;
 	int16 _y;
+	const int16 _sourceWidth;
 	const int16 _sourceHeight;
 	const uint8 _skipColor;
 	const int16 _maxWidth;
 
 public:
 	READER_Compressed(const CelObj &celObj, const int16 maxWidth) :
-	_resource(celObj.getResPointer()),
+	// Decoded cels are read without going through the resource manager so
+	// that they can be drawn from job system workers
+	_resource(celObj._decodedPixels ? SciSpan<const byte>() : celObj.getResPointer()),
+	_decodedPixels(celObj._decodedPixels.get()),
+	_controlOffset(0),
+	_dataOffset(0),
+	_uncompressedDataOffset(0),
 	_y(-1),
+	_sourceWidth(celObj._width),
 	_sourceHeight(celObj._height),
 	_skipColor(celObj._skipColor),
 	_maxWidth(maxWidth) {
 		assert(maxWidth <= celObj._width);
 
-		const SciSpan<const byte> celHeader = _resource.subspan(celObj._celHeaderOffset);
-		_dataOffset = celHeader.getUint32SEAt(24);
-		_uncompressedDataOffset = celHeader.getUint32SEAt(28);
-		_controlOffset = celHeader.getUint32SEAt(32);
+		if (!_decodedPixels) {
+			const SciSpan<const byte> celHeader = _resource.subspan(celObj._celHeaderOffset);
+			_dataOffset = celHeader.getUint32SEAt(24);
+			_uncompressedDataOffset = celHeader.getUint32SEAt(28);
+			_controlOffset = celHeader.getUint32SEAt(32);
+		}
 	}
 
 	inline const byte *getRow(const int16 y) {
 		assert(y >= 0 && y < _sourceHeight);
+		if (_decodedPixels) {
+			return _decodedPixels + y * _sourceWidth;
+		}
+
 		if (y != _y) {
 			// compressed data segment for row
 			const uint32 rowOffset = _resource.getUint32SEAt(_controlOffset + y * sizeof(uint32));
@@ -516,7 +550,11 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 	const Common::Point &scaledPosition = screenItem._scaledPosition;
 	const Ratio &scaleX = screenItem._ratioX;
 	const Ratio &scaleY = screenItem._ratioY;
-	_drawBlackLines = screenItem._drawBlackLines;
+	// The flag is only written when set so that concurrent draws of other
+	// screen items do not race on it; it is always false between draws
+	if (screenItem._drawBlackLines) {
+		_drawBlackLines = true;
+	}
 
 	if (_remap) {
 		// In SSCI, this check was `g_Remap_numActiveRemaps && _remap`, but
@@ -599,7 +637,9 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 		}
 	}
 
-	_drawBlackLines = false;
+	if (screenItem._drawBlackLines) {
+		_drawBlackLines = false;
+	}
 }
 
 void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, bool mirrorX) {
@@ -607,6 +647,12 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 	draw(target, screenItem, targetRect);
 }
 
+bool CelObj::canDrawConcurrently(const ScreenItem &screenItem) const {
+	// Scaled draws share the scaler tables and views and pics are otherwise
+	// read from the resource manager
+	return screenItem._ratioX.isOne() && screenItem._ratioY.isOne() && !screenItem._drawBlackLines && _decodedPixels;
+}
+
 void CelObj::draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const bool mirrorX) {
 	_drawMirrored = mirrorX;
 	Ratio square;
@@ -686,47 +732,185 @@ void CelObj::submitPalette() const {
 #pragma mark -
 #pragma mark CelObj - Caching
 
-int CelObj::_nextCacheId = 1;
 CelCache *CelObj::_cache = nullptr;
 
-int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
-	*nextInsertIndex = -1;
-	int oldestId = _nextCacheId + 1;
-	int oldestIndex = 0;
-
-	for (int i = 0, len = _cache->size(); i < len; ++i) {
-		CelCacheEntry &entry = (*_cache)[i];
+void CelObj::putCopyInCache() {
+	if (_cache->getBudget() == 0) {
+		return;
+	}
 
-		if (entry.celObj == nullptr) {
-			if (*nextInsertIndex == -1) {
-				*nextInsertIndex = i;
-			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
-		} else if (oldestId > entry.id) {
-			oldestId = entry.id;
-			oldestIndex = i;
+	// Cels which would take up a large part of the cache on their own keep
+	// being decoded on every draw instead
+	uint32 size = sizeof(*this);
+	const uint32 pixelsSize = _width * _height;
+	if (_compressionType == kCelCompressionRLE && size + pixelsSize <= _cache->getBudget() / 4) {
+		byte *pixels = new byte[pixelsSize];
+		READER_Compressed reader(*this, _width);
+		for (int16 y = 0; y < _height; ++y) {
+			memcpy(pixels + y * _width, reader.getRow(y), _width);
 		}
+		_decodedPixels = Common::SharedPtr<byte>(pixels, Common::ArrayDeleter<byte>());
+		size += pixelsSize;
 	}
 
-	if (*nextInsertIndex == -1) {
-		*nextInsertIndex = oldestIndex;
+	_cache->insert(duplicate(), size);
+}
+
+CelCache::CelCache(const uint32 budget) : _budget(budget), _size(0) {
+	resetStats();
+}
+
+CelCache::~CelCache() {
+	shrink(0);
+}
+
+uint CelCache::InfoHash::operator()(const CelInfo32 &info) const {
+	// The color is not part of the equivalence criteria, see CelInfo32
+	return (info.type << 28) ^ (info.resourceId << 12) ^ (info.loopNo << 8) ^ info.celNo ^
+		(info.bitmap.getSegment() << 16) ^ info.bitmap.getOffset();
+}
+
+const CelObj *CelCache::find(const CelInfo32 &info) {
+	EntryMap::iterator i = _map.find(info);
+	if (i == _map.end()) {
+		++_stats.misses;
+		return nullptr;
+	}
+
+	++_stats.hits;
+	EntryList::iterator it = i->_value;
+	if (it != _entries.begin()) {
+		_entries.push_front(*it);
+		_entries.erase(it);
+		i->_value = _entries.begin();
+	}
+	return _entries.front().celObj;
+}
+
+void CelCache::insert(CelObj *celObj, const uint32 size) {
+	EntryMap::iterator i = _map.find(celObj->_info);
+	if (i != _map.end()) {
+		remove(i->_value);
+	}
+
+	shrink(_budget > size ? _budget - size : 0);
+
+	Entry entry;
+	entry.celObj = celObj;
+	entry.size = size;
+	_entries.push_front(entry);
+	_map[celObj->_info] = _entries.begin();
+	_size += size;
+}
+
+void CelCache::setBudget(const uint32 budget) {
+	_budget = budget;
+	shrink(_budget);
+}
+
+void CelCache::resetStats() {
+	_stats.hits = 0;
+	_stats.misses = 0;
+	_stats.evictions = 0;
+}
+
+void CelCache::remove(EntryList::iterator it) {
+	_map.erase(it->celObj->_info);
+	_size -= it->size;
+	delete it->celObj;
+	_entries.erase(it);
+}
+
+void CelCache::shrink(const uint32 budget) {
+	while (_size > budget && !_entries.empty()) {
+		remove(--_entries.end());
+		++_stats.evictions;
 	}
+}
+
+#pragma mark -
+#pragma mark CelObj - Row drawing
 
-	return -1;
+static void drawCelRowSkipGeneric(byte *target, const byte *source, const int16 width, const uint8 skipColor, const uint16 endColor, const bool isMacSource) {
+	for (int16 x = 0; x < width; ++x) {
+		const byte pixel = source[x];
+		if (pixel != skipColor && pixel < endColor) {
+			target[x] = translateMacColor(isMacSource, pixel);
+		}
+	}
 }
 
-void CelObj::putCopyInCache(const int cacheIndex) const {
-	if (cacheIndex == -1) {
-		error("Invalid cache index");
+static void drawCelRowCopyGeneric(byte *target, const byte *source, const int16 width, const bool isMacSource) {
+	if (!isMacSource) {
+		memcpy(target, source, width);
+		return;
+	}
+
+	for (int16 x = 0; x < width; ++x) {
+		target[x] = translateMacColor(true, source[x]);
 	}
+}
+
+static CelRowSkipProc drawCelRowSkip = drawCelRowSkipGeneric;
+static CelRowCopyProc drawCelRowCopy = drawCelRowCopyGeneric;
+
+/** Pick the SIMD row drawing loops supported by the CPU, if any. */
+static void selectCelRowProcs() {
+	drawCelRowSkip = drawCelRowSkipGeneric;
+	drawCelRowCopy = drawCelRowCopyGeneric;
 
-	CelCacheEntry &entry = (*_cache)[cacheIndex];
-	entry.celObj.reset(duplicate());
-	entry.id = ++_nextCacheId;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+		drawCelRowSkip = drawCelRowSkipNEON;
+		drawCelRowCopy = drawCelRowCopyNEON;
+		return;
+	}
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		drawCelRowSkip = drawCelRowSkipSSE2;
+		drawCelRowCopy = drawCelRowCopySSE2;
+		return;
+	}
+#endif
 }
 
+/**
+ * Draws one row of a cel, one pixel at a time through the mapper.
+ */
+template<typename MAPPER, typename SCALER>
+struct ROW_RENDERER {
+	static inline void draw(MAPPER &mapper, SCALER &scaler, byte *targetPixel, const int16 width, const uint8 skipColor, const bool isMacSource) {
+		for (int16 x = 0; x < width; ++x) {
+			mapper.draw(targetPixel++, scaler.read(), skipColor, isMacSource);
+		}
+	}
+};
+
+// Unscaled, unmirrored rows without remapping read their source pixels
+// contiguously, so they are drawn as whole spans.
+
+template<typename READER>
+struct ROW_RENDERER<MAPPER_NoMD, SCALER_NoScale<false, READER> > {
+	static inline void draw(MAPPER_NoMD &, SCALER_NoScale<false, READER> &scaler, byte *targetPixel, const int16 width, const uint8 skipColor, const bool isMacSource) {
+		drawCelRowSkip(targetPixel, scaler.readRow(width), width, skipColor, 256, isMacSource);
+	}
+};
+
+template<typename READER>
+struct ROW_RENDERER<MAPPER_NoMDNoSkip, SCALER_NoScale<false, READER> > {
+	static inline void draw(MAPPER_NoMDNoSkip &, SCALER_NoScale<false, READER> &scaler, byte *targetPixel, const int16 width, const uint8, const bool isMacSource) {
+		drawCelRowCopy(targetPixel, scaler.readRow(width), width, isMacSource);
+	}
+};
+
+template<typename READER>
+struct ROW_RENDERER<MAPPER_NoMap, SCALER_NoScale<false, READER> > {
+	static inline void draw(MAPPER_NoMap &, SCALER_NoScale<false, READER> &scaler, byte *targetPixel, const int16 width, const uint8 skipColor, const bool isMacSource) {
+		drawCelRowSkip(targetPixel, scaler.readRow(width), width, skipColor, g_sci->_gfxRemap32->getStartColor(), isMacSource);
+	}
+};
+
 #pragma mark -
 #pragma mark CelObj - Drawing
 
@@ -758,11 +942,9 @@ struct RENDERER {
 
 			_scaler.setTarget(targetRect.left, targetRect.top + y);
 
-			for (int16 x = 0; x < targetWidth; ++x) {
-				_mapper.draw(targetPixel++, _scaler.read(), _skipColor, _isMacSource);
-			}
+			ROW_RENDERER<MAPPER, SCALER>::draw(_mapper, _scaler, targetPixel, targetWidth, _skipColor, _isMacSource);
 
-			targetPixel += skipStride;
+			targetPixel += targetWidth + skipStride;
 		}
 	}
 };
@@ -971,16 +1153,13 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 	_compressionType = kCelCompressionInvalid;
 	_transparent = true;
 
-	int cacheInsertIndex;
-	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
-	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
-		const CelObjView *const cachedCelObj = dynamic_cast<CelObjView *>(entry.celObj.get());
+	const CelObj *const cached = _cache->find(_info);
+	if (cached != nullptr) {
+		const CelObjView *const cachedCelObj = dynamic_cast<const CelObjView *>(cached);
 		if (cachedCelObj == nullptr) {
-			error("Expected a CelObjView in cache slot %d", cacheIndex);
+			error("Expected a CelObjView in cache for %s", _info.toString().c_str());
 		}
 		*this = *cachedCelObj;
-		entry.id = ++_nextCacheId;
 		return;
 	}
 
@@ -1078,7 +1257,7 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 		_remap = analyzeForRemap();
 	}
 
-	putCopyInCache(cacheInsertIndex);
+	putCopyInCache();
 }
 
 bool CelObjView::analyzeUncompressedForRemap() const {
@@ -1179,16 +1358,13 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 	_transparent = true;
 	_remap = false;
 
-	int cacheInsertIndex;
-	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
-	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
-		const CelObjPic *const cachedCelObj = dynamic_cast<CelObjPic *>(entry.celObj.get());
+	const CelObj *const cached = _cache->find(_info);
+	if (cached != nullptr) {
+		const CelObjPic *const cachedCelObj = dynamic_cast<const CelObjPic *>(cached);
 		if (cachedCelObj == nullptr) {
-			error("Expected a CelObjPic in cache slot %d", cacheIndex);
+			error("Expected a CelObjPic in cache for %s", _info.toString().c_str());
 		}
 		*this = *cachedCelObj;
-		entry.id = ++_nextCacheId;
 		return;
 	}
 
@@ -1252,7 +1428,7 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 		}
 	}
 
-	putCopyInCache(cacheInsertIndex);
+	putCopyInCache();
 }
 
 bool CelObjPic::analyzeUncompressedForSkip() const {
@@ -1327,6 +1503,12 @@ CelObjMem *CelObjMem::duplicate() const {
 	return new CelObjMem(*this);
 }
 
+bool CelObjMem::canDrawConcurrently(const ScreenItem &screenItem) const {
+	// Bitmaps are looked up in the segment manager, which is not modified
+	// while a frame is drawn
+	return screenItem._ratioX.isOne() && screenItem._ratioY.isOne() && !screenItem._drawBlackLines;
+}
+
 const SciSpan<const byte> CelObjMem::getResPointer() const {
 	SciBitmap &bitmap = *g_sci->getEngineState()->_segMan->lookupBitmap(_info.bitmap);
 	return SciSpan<const byte>(bitmap.getRawData(), bitmap.getRawSize(), Common::String::format("bitmap %04x:%04x", PRINT_REG(_info.bitmap)));
@@ -22,6 +22,9 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/ptr.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
@@ -105,7 +108,7 @@ struct CelInfo32 {
 
 	// This is the equivalence criteria used by CelObj::searchCache in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -115,7 +118,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -136,17 +139,82 @@ struct CelInfo32 {
 };
 
 class CelObj;
-struct CelCacheEntry {
+
+/**
+ * A cache of initialised cel objects, indexed by their CelInfo32. Entries are
+ * accounted by the memory they hold, including the pixels of compressed cels
+ * which are kept decompressed, and the least recently used entries are
+ * dropped once the total exceeds the budget.
+ *
+ * SSCI uses a fixed array of 100 entries instead, which is far too small for
+ * the high resolution games.
+ */
+class CelCache {
+public:
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+	};
+
 	/**
-	 * A monotonically increasing cache ID used to identify the least recently
-	 * used item in the cache for replacement.
+	 * The default budget, in bytes. It can be changed with the
+	 * "sci_cel_cache_size" configuration key, in kilobytes.
 	 */
-	int id;
-	Common::ScopedPtr<CelObj> celObj;
-	CelCacheEntry() : id(0) {}
-};
+#ifdef REDUCE_MEMORY_USAGE
+	static const uint32 kDefaultBudget = 2 * 1024 * 1024;
+#else
+	static const uint32 kDefaultBudget = 16 * 1024 * 1024;
+#endif
+
+	CelCache(uint32 budget);
+	~CelCache();
 
-typedef Common::Array<CelCacheEntry> CelCache;
+	/**
+	 * Returns the cached cel object with the given info, or null.
+	 */
+	const CelObj *find(const CelInfo32 &info);
+
+	/**
+	 * Takes ownership of the given cel object, which accounts for `size`
+	 * bytes, replacing any entry with the same info.
+	 */
+	void insert(CelObj *celObj, uint32 size);
+
+	void setBudget(uint32 budget);
+	uint32 getBudget() const { return _budget; }
+	uint32 getSize() const { return _size; }
+	uint getCount() const { return _entries.size(); }
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
+private:
+	struct Entry {
+		CelObj *celObj;
+		uint32 size;
+	};
+
+	struct InfoHash {
+		uint operator()(const CelInfo32 &info) const;
+	};
+
+	struct InfoEqual {
+		bool operator()(const CelInfo32 &a, const CelInfo32 &b) const { return a == b; }
+	};
+
+	typedef Common::List<Entry> EntryList;
+	typedef Common::HashMap<CelInfo32, EntryList::iterator, InfoHash, InfoEqual> EntryMap;
+
+	EntryList _entries; // most recently used first
+	EntryMap _map;
+	uint32 _budget;
+	uint32 _size;
+	Stats _stats;
+
+	void remove(EntryList::iterator it);
+	void shrink(uint32 budget);
+};
 
 #pragma mark -
 #pragma mark CelScaler
@@ -320,6 +388,12 @@ public:
 	 */
 	CelCompressionType _compressionType;
 
+	/**
+	 * For RLE compressed cels which went through the cel cache, the
+	 * decompressed pixel data, shared with the copy in the cache.
+	 */
+	Common::SharedPtr<byte> _decodedPixels;
+
 	/**
 	 * Whether or not this cel contains remap pixels.
 	 */
@@ -386,6 +460,14 @@ public:
 	 */
 	void drawTo(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio &scaleX, const Ratio &scaleY) const;
 
+	/**
+	 * Returns whether the cel can be drawn for the given screen item from a
+	 * job system worker, concurrently with draws to other parts of the
+	 * buffer. This requires an unscaled draw whose pixels do not have to be
+	 * fetched through the resource manager.
+	 */
+	virtual bool canDrawConcurrently(const ScreenItem &screenItem) const;
+
 	/**
 	 * Creates a copy of this cel on the free store and returns a pointer to the
 	 * new object. The new cel will point to a shared copy of bitmap/resource
@@ -449,13 +531,13 @@ private:
 
 #pragma mark -
 #pragma mark CelObj - Caching
-protected:
+public:
 	/**
-	 * A monotonically increasing cache ID used to identify the least recently
-	 * used item in the cache for replacement.
+	 * Returns the cache of cel objects, for debugging.
 	 */
-	static int _nextCacheId;
+	static CelCache *getCache() { return _cache; }
 
+protected:
 	/**
 	 * A cache of cel objects used to avoid reinitialisation overhead for cels
 	 * with the same CelInfo32.
@@ -463,17 +545,10 @@ protected:
 	static CelCache *_cache;
 
 	/**
-	 * Searches the cel cache for a CelObj matching the provided CelInfo32. If
-	 * not found, -1 is returned. `nextInsertIndex` will receive the index of
-	 * the oldest item in the cache, which can be used to replace the oldest
-	 * item with a newer item.
+	 * Puts a copy of this CelObj into the cache. RLE compressed pixel data is
+	 * decompressed first, so that it can be drawn without decoding it again.
 	 */
-	int searchCache(const CelInfo32 &celInfo, int *nextInsertIndex) const;
-
-	/**
-	 * Puts a copy of this CelObj into the cache at the given cache index.
-	 */
-	void putCopyInCache(int index) const;
+	void putCopyInCache();
 };
 
 #pragma mark -
@@ -573,6 +648,7 @@ public:
 	CelObjMem(const reg_t bitmap);
 	~CelObjMem() override {};
 
+	bool canDrawConcurrently(const ScreenItem &screenItem) const override;
 	CelObjMem *duplicate() const override;
 	const SciSpan<const byte> getResPointer() const override;
 };
@@ -597,10 +673,35 @@ public:
 	void draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, const bool mirrorX) override;
 	void draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const bool mirrorX) override;
 
+	bool canDrawConcurrently(const ScreenItem &) const override { return true; }
 	CelObjColor *duplicate() const override;
 	const SciSpan<const byte> getResPointer() const override;
 };
 
+#pragma mark -
+#pragma mark CelObj - Row drawing
+
+/**
+ * Draws `width` unscaled, unmirrored cel pixels from `source` into `target`,
+ * leaving target pixels alone where the source pixel is `skipColor` or is not
+ * below `endColor`.
+ */
+typedef void (*CelRowSkipProc)(byte *target, const byte *source, const int16 width, const uint8 skipColor, const uint16 endColor, const bool isMacSource);
+
+/**
+ * Copies `width` unscaled, unmirrored cel pixels without transparency.
+ */
+typedef void (*CelRowCopyProc)(byte *target, const byte *source, const int16 width, const bool isMacSource);
+
+#ifdef SCUMMVM_SSE2
+void drawCelRowSkipSSE2(byte *target, const byte *source, const int16 width, const uint8 skipColor, const uint16 endColor, const bool isMacSource);
+void drawCelRowCopySSE2(byte *target, const byte *source, const int16 width, const bool isMacSource);
+#endif
+#ifdef SCUMMVM_NEON
+void drawCelRowSkipNEON(byte *target, const byte *source, const int16 width, const uint8 skipColor, const uint16 endColor, const bool isMacSource);
+void drawCelRowCopyNEON(byte *target, const byte *source, const int16 width, const bool isMacSource);
+#endif
+
 } // End of namespace Sci
 
 #endif // SCI_GRAPHICS_CELOBJ32_H
@@ -0,0 +1,84 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <arm_neon.h>
+
+#include "sci/graphics/celobj32.h"
+
+namespace Sci {
+
+void drawCelRowSkipNEON(byte *target, const byte *source, const int16 width, const uint8 skipColor, const uint16 endColor, const bool isMacSource) {
+	if (endColor == 0) {
+		return;
+	}
+
+	const uint8 lastColor = endColor > 255 ? 255 : endColor - 1;
+	const uint8x16_t skip = vdupq_n_u8(skipColor);
+	const uint8x16_t last = vdupq_n_u8(lastColor);
+	const uint8x16_t black = vdupq_n_u8(0);
+	const uint8x16_t white = vdupq_n_u8(255);
+
+	int16 x = 0;
+	for (; x + 16 <= width; x += 16) {
+		uint8x16_t pixels = vld1q_u8(source + x);
+		const uint8x16_t dst = vld1q_u8(target + x);
+
+		// Draw where the pixel is not the skip color and not above the last
+		// drawable color
+		const uint8x16_t draw = vbicq_u8(vcleq_u8(pixels, last), vceqq_u8(pixels, skip));
+
+		if (isMacSource) {
+			const uint8x16_t swap = vorrq_u8(vceqq_u8(pixels, black), vceqq_u8(pixels, white));
+			pixels = veorq_u8(pixels, swap);
+		}
+
+		vst1q_u8(target + x, vbslq_u8(draw, pixels, dst));
+	}
+	for (; x < width; ++x) {
+		const byte pixel = source[x];
+		if (pixel != skipColor && pixel <= lastColor) {
+			target[x] = (isMacSource && (pixel == 0 || pixel == 255)) ? pixel ^ 0xFF : pixel;
+		}
+	}
+}
+
+void drawCelRowCopyNEON(byte *target, const byte *source, const int16 width, const bool isMacSource) {
+	if (!isMacSource) {
+		memcpy(target, source, width);
+		return;
+	}
+
+	const uint8x16_t black = vdupq_n_u8(0);
+	const uint8x16_t white = vdupq_n_u8(255);
+
+	int16 x = 0;
+	for (; x + 16 <= width; x += 16) {
+		const uint8x16_t pixels = vld1q_u8(source + x);
+		const uint8x16_t swap = vorrq_u8(vceqq_u8(pixels, black), vceqq_u8(pixels, white));
+		vst1q_u8(target + x, veorq_u8(pixels, swap));
+	}
+	for (; x < width; ++x) {
+		const byte pixel = source[x];
+		target[x] = (pixel == 0 || pixel == 255) ? pixel ^ 0xFF : pixel;
+	}
+}
+
+} // End of namespace Sci
@@ -0,0 +1,85 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "sci/graphics/celobj32.h"
+
+namespace Sci {
+
+void drawCelRowSkipSSE2(byte *target, const byte *source, const int16 width, const uint8 skipColor, const uint16 endColor, const bool isMacSource) {
+	if (endColor == 0) {
+		return;
+	}
+
+	const uint8 lastColor = endColor > 255 ? 255 : endColor - 1;
+	const __m128i skip = _mm_set1_epi8((char)skipColor);
+	const __m128i last = _mm_set1_epi8((char)lastColor);
+	const __m128i black = _mm_setzero_si128();
+	const __m128i white = _mm_set1_epi8(-1);
+
+	int16 x = 0;
+	for (; x + 16 <= width; x += 16) {
+		__m128i pixels = _mm_loadu_si128((const __m128i *)(source + x));
+		const __m128i dst = _mm_loadu_si128((const __m128i *)(target + x));
+
+		// Keep the target where the pixel is the skip color or above the
+		// last drawable color
+		const __m128i inRange = _mm_cmpeq_epi8(_mm_min_epu8(pixels, last), pixels);
+		const __m128i keep = _mm_or_si128(_mm_cmpeq_epi8(pixels, skip), _mm_andnot_si128(inRange, white));
+
+		if (isMacSource) {
+			const __m128i swap = _mm_or_si128(_mm_cmpeq_epi8(pixels, black), _mm_cmpeq_epi8(pixels, white));
+			pixels = _mm_xor_si128(pixels, swap);
+		}
+
+		_mm_storeu_si128((__m128i *)(target + x), _mm_or_si128(_mm_and_si128(keep, dst), _mm_andnot_si128(keep, pixels)));
+	}
+	for (; x < width; ++x) {
+		const byte pixel = source[x];
+		if (pixel != skipColor && pixel <= lastColor) {
+			target[x] = (isMacSource && (pixel == 0 || pixel == 255)) ? pixel ^ 0xFF : pixel;
+		}
+	}
+}
+
+void drawCelRowCopySSE2(byte *target, const byte *source, const int16 width, const bool isMacSource) {
+	if (!isMacSource) {
+		memcpy(target, source, width);
+		return;
+	}
+
+	const __m128i black = _mm_setzero_si128();
+	const __m128i white = _mm_set1_epi8(-1);
+
+	int16 x = 0;
+	for (; x + 16 <= width; x += 16) {
+		const __m128i pixels = _mm_loadu_si128((const __m128i *)(source + x));
+		const __m128i swap = _mm_or_si128(_mm_cmpeq_epi8(pixels, black), _mm_cmpeq_epi8(pixels, white));
+		_mm_storeu_si128((__m128i *)(target + x), _mm_xor_si128(pixels, swap));
+	}
+	for (; x < width; ++x) {
+		const byte pixel = source[x];
+		target[x] = (pixel == 0 || pixel == 255) ? pixel ^ 0xFF : pixel;
+	}
+}
+
+} // End of namespace Sci
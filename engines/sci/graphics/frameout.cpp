@@ -22,6 +22,9 @@
 #include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/events.h"
+#include "common/hash-ptr.h"
+#include "common/hashmap.h"
+#include "common/jobsystem.h"
 #include "common/keyboard.h"
 #include "common/list.h"
 #include "common/str.h"
@@ -506,10 +509,7 @@ void GfxFrameout::frameOut(const bool shouldShowBits, const Common::Rect &eraseR
 
 	_remapOccurred = _palette->updateForFrame();
 
-	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
-		drawEraseList(eraseLists[i], *_planes[i]);
-		drawScreenItemList(_screenItemLists[i]);
-	}
+	drawLists(eraseLists, _screenItemLists);
 
 	if (robotIsActive) {
 		robotPlayer.frameAlmostVisible();
@@ -656,6 +656,7 @@ void GfxFrameout::resetHardware() {
 	updateMousePositionForRendering();
 	_showList.add(Common::Rect(_currentBuffer.w, _currentBuffer.h));
 	g_system->getPaletteManager()->setPalette(_palette->getHardwarePalette(), 0, 256);
+	_palette->invalidateBackendPalette();
 	showBits();
 }
 #endif
@@ -1010,6 +1011,177 @@ void GfxFrameout::drawScreenItemList(const DrawList &screenItemList) {
 	}
 }
 
+/**
+ * Below this number of erase and draw operations in a frame, splitting them
+ * into regions costs more than drawing them on the main thread.
+ */
+static const uint kMinConcurrentDrawOps = 8;
+
+static uint findRegionRoot(Common::Array<uint> &parent, uint i) {
+	while (parent[i] != i) {
+		parent[i] = parent[parent[i]];
+		i = parent[i];
+	}
+	return i;
+}
+
+static void mergeRegions(Common::Array<uint> &parent, uint a, uint b) {
+	a = findRegionRoot(parent, a);
+	b = findRegionRoot(parent, b);
+	if (a != b) {
+		parent[MAX(a, b)] = MIN(a, b);
+	}
+}
+
+void GfxFrameout::drawLists(const EraseListList &eraseLists, const ScreenItemListList &drawLists) {
+	uint opCount = 0;
+	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+		if (_planes[i]->_type == kPlaneTypeColored) {
+			opCount += eraseLists[i].size();
+		}
+		opCount += drawLists[i].size();
+	}
+
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (jobSystem->getWorkerCount() == 0 || opCount < kMinConcurrentDrawOps) {
+		for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+			drawEraseList(eraseLists[i], *_planes[i]);
+			drawScreenItemList(drawLists[i]);
+		}
+		return;
+	}
+
+	Common::Array<DrawOp> ops;
+	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+		if (_planes[i]->_type == kPlaneTypeColored) {
+			const RectList &eraseList = eraseLists[i];
+			for (RectList::size_type j = 0; j < eraseList.size(); ++j) {
+				const DrawOp op = { eraseList[j], _planes[i], nullptr };
+				ops.push_back(op);
+			}
+		}
+
+		const DrawList &drawList = drawLists[i];
+		for (DrawList::size_type j = 0; j < drawList.size(); ++j) {
+			const DrawOp op = { &drawList[j]->rect, nullptr, drawList[j] };
+			ops.push_back(op);
+		}
+	}
+
+	// Operations touching the same pixels, directly or through a chain of
+	// overlaps, have to stay in order. Draws of the same cel are kept together
+	// too since drawing sets the cel's mirroring.
+	Common::Array<uint> parent(ops.size());
+	Common::Array<uint> byLeft(ops.size());
+	Common::HashMap<const CelObj *, uint> firstCelOp;
+	for (uint i = 0; i < ops.size(); ++i) {
+		parent[i] = i;
+		byLeft[i] = i;
+
+		if (ops[i].drawItem) {
+			const CelObj *celObj = ops[i].drawItem->screenItem->_celObj.get();
+			if (firstCelOp.contains(celObj)) {
+				mergeRegions(parent, i, firstCelOp[celObj]);
+			} else {
+				firstCelOp[celObj] = i;
+			}
+		}
+	}
+
+	// Sweep the rects from left to right, so each one is only compared with
+	// the rects which are not entirely to its left
+	Common::sort(byLeft.begin(), byLeft.end(), [&ops](uint a, uint b) {
+		return ops[a].rect->left < ops[b].rect->left;
+	});
+
+	Common::Array<uint> active;
+	for (uint i = 0; i < byLeft.size(); ++i) {
+		const Common::Rect &rect = *ops[byLeft[i]].rect;
+
+		uint kept = 0;
+		for (uint j = 0; j < active.size(); ++j) {
+			const Common::Rect &other = *ops[active[j]].rect;
+			if (other.right <= rect.left) {
+				continue;
+			}
+
+			active[kept++] = active[j];
+			if (rect.intersects(other)) {
+				mergeRegions(parent, byLeft[i], active[j]);
+			}
+		}
+		active.resize(kept);
+		active.push_back(byLeft[i]);
+	}
+
+	// Roots always come before the rest of their region, so regions are
+	// created and filled in operation order
+	Common::Array<DrawRegion> concurrentRegions, mainRegions;
+	Common::Array<int> regionIndex(ops.size(), -1);
+	Common::Array<bool> regionIsConcurrent;
+	for (uint i = 0; i < ops.size(); ++i) {
+		const uint root = findRegionRoot(parent, i);
+		if (root == i) {
+			regionIndex[i] = regionIsConcurrent.size();
+			regionIsConcurrent.push_back(true);
+		} else {
+			regionIndex[i] = regionIndex[root];
+		}
+
+		const DrawItem *drawItem = ops[i].drawItem;
+		if (drawItem && !drawItem->screenItem->_celObj->canDrawConcurrently(*drawItem->screenItem)) {
+			regionIsConcurrent[regionIndex[i]] = false;
+		}
+	}
+
+	Common::Array<DrawRegion> regions(regionIsConcurrent.size());
+	for (uint i = 0; i < ops.size(); ++i) {
+		regions[regionIndex[i]].push_back(i);
+	}
+	for (uint i = 0; i < regions.size(); ++i) {
+		if (regionIsConcurrent[i]) {
+			concurrentRegions.push_back(regions[i]);
+		} else {
+			mainRegions.push_back(regions[i]);
+		}
+	}
+
+	for (uint i = 0; i < ops.size(); ++i) {
+		mergeToShowList(*ops[i].rect, _showList, _overdrawThreshold);
+	}
+
+	if (concurrentRegions.size() > 1) {
+		DrawRegionsJob job = { this, &ops, &concurrentRegions };
+		jobSystem->parallelFor(concurrentRegions.size(), drawRegionsProc, &job);
+	} else if (concurrentRegions.size() == 1) {
+		drawRegion(ops, concurrentRegions[0]);
+	}
+
+	for (uint i = 0; i < mainRegions.size(); ++i) {
+		drawRegion(ops, mainRegions[i]);
+	}
+}
+
+void GfxFrameout::drawRegion(const Common::Array<DrawOp> &ops, const DrawRegion &region) {
+	for (uint i = 0; i < region.size(); ++i) {
+		const DrawOp &op = ops[region[i]];
+		if (op.erasePlane) {
+			_currentBuffer.fillRect(*op.rect, op.erasePlane->_back);
+		} else {
+			const ScreenItem &screenItem = *op.drawItem->screenItem;
+			CelObj &celObj = *screenItem._celObj;
+			celObj.draw(_currentBuffer, screenItem, op.drawItem->rect, screenItem._mirrorX ^ celObj._mirrorX);
+		}
+	}
+}
+
+void GfxFrameout::drawRegionsProc(uint32 begin, uint32 end, void *refCon) {
+	const DrawRegionsJob &job = *(const DrawRegionsJob *)refCon;
+	for (uint32 i = begin; i < end; ++i) {
+		job.frameout->drawRegion(*job.ops, (*job.regions)[i]);
+	}
+}
+
 void GfxFrameout::mergeToShowList(const Common::Rect &drawRect, RectList &showList, const int overdrawThreshold) {
 	RectList mergeList;
 	Common::Rect merged;
@@ -374,6 +374,42 @@ private:
 	 */
 	void drawScreenItemList(const DrawList &screenItemList);
 
+	/**
+	 * A single erase or draw operation from the per-plane lists, in the order
+	 * SSCI would perform it.
+	 */
+	struct DrawOp {
+		const Common::Rect *rect;
+		const Plane *erasePlane; // filled with its back color if set
+		const DrawItem *drawItem; // drawn otherwise
+	};
+
+	typedef Common::Array<uint> DrawRegion;
+
+	struct DrawRegionsJob {
+		GfxFrameout *frameout;
+		const Common::Array<DrawOp> *ops;
+		const Common::Array<DrawRegion> *regions;
+	};
+
+	/**
+	 * Runs the erase and draw lists of every plane. When the job system has
+	 * workers and the frame has enough operations to make it worthwhile,
+	 * the operations are split into regions of transitively
+	 * overlapping rects and regions whose cels can be drawn off the main
+	 * thread are rendered concurrently. Operations within a region keep
+	 * their original order, so the result is the same as drawing the lists
+	 * one after another.
+	 */
+	void drawLists(const EraseListList &eraseLists, const ScreenItemListList &drawLists);
+
+	/**
+	 * Performs the given operations from `ops` in order.
+	 */
+	void drawRegion(const Common::Array<DrawOp> &ops, const DrawRegion &region);
+
+	static void drawRegionsProc(uint32 begin, uint32 end, void *refCon);
+
 	/**
 	 * Adds a new rectangle to the list of regions to write out to the hardware.
 	 * The provided rect may be merged into an existing rectangle to reduce the
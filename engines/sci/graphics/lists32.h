@@ -223,7 +223,14 @@ public:
 		}
 	}
 
-	void operator=(StablePointerDynamicArray &other) {
+	StablePointerDynamicArray(StablePointerDynamicArray &&other) {
+		_items.swap(other._items);
+	}
+
+	StablePointerDynamicArray &operator=(const StablePointerDynamicArray &other) {
+		if (this == &other)
+			return *this;
+
 		clear();
 		for (size_type i = 0; i < other.size(); ++i) {
 			if (other._items[i] == nullptr) {
@@ -232,6 +239,17 @@ public:
 				_items.push_back(new T(*other._items[i]));
 			}
 		}
+		return *this;
+	}
+
+	StablePointerDynamicArray &operator=(StablePointerDynamicArray &&other) {
+		if (this == &other)
+			return *this;
+
+		// The moved-from array takes our items and frees them
+		_items.swap(other._items);
+		other.clear();
+		return *this;
 	}
 
 	T *const &operator[](size_type index) const {
@@ -365,6 +365,8 @@ static const uint8 gammaTables[GfxPalette32::numGammaTables][256] = {
 #ifdef USE_RGB_COLOR
 	_hardwarePalette(),
 #endif
+	_backendPalette(),
+	_backendPaletteValid(false),
 	_currentPalette(),
 	_sourcePalette(),
 	_nextPalette(),
@@ -551,7 +553,27 @@ void GfxPalette32::updateHardware() {
 	// playback, attempting to send the palette to OSystem is illegal and will
 	// result in a crash
 	if (g_system->getScreenFormat().bytesPerPixel == 1) {
-		g_system->getPaletteManager()->setPalette(bpal, 0, 256);
+		// Cycling and varying usually touch only a few colors, so only send
+		// the range of entries that changed since the last update
+		int first = 0;
+		int last = 255;
+		if (_backendPaletteValid) {
+			while (first <= last && !memcmp(bpal + first * 3, _backendPalette + first * 3, 3)) {
+				++first;
+			}
+			while (last > first && !memcmp(bpal + last * 3, _backendPalette + last * 3, 3)) {
+				--last;
+			}
+		}
+
+		if (first <= last) {
+			const int numColors = last - first + 1;
+			g_system->getPaletteManager()->setPalette(bpal + first * 3, first, numColors);
+			memcpy(_backendPalette + first * 3, bpal + first * 3, numColors * 3);
+		}
+		_backendPaletteValid = true;
+	} else {
+		_backendPaletteValid = false;
 	}
 
 	_gammaChanged = false;
@@ -302,6 +302,13 @@ public:
 	 */
 	void updateHardware();
 
+	/**
+	 * Forces the next call to `updateHardware` to send the whole palette to
+	 * the backend. Must be called by anything that changes the backend
+	 * palette without going through `updateHardware`.
+	 */
+	void invalidateBackendPalette() { _backendPaletteValid = false; }
+
 private:
 	ResourceManager *_resMan;
 
@@ -325,6 +332,18 @@ private:
 	uint8 _hardwarePalette[256 * 3];
 #endif
 
+	/**
+	 * The palette that was last sent to the backend. Only the entries that
+	 * differ from it are sent again, which lets backends without a CPU-side
+	 * palette conversion skip most of the work for palette cycling.
+	 */
+	uint8 _backendPalette[256 * 3];
+
+	/**
+	 * Whether `_backendPalette` matches the palette of the backend.
+	 */
+	bool _backendPaletteValid;
+
 	/**
 	 * The currently displayed palette.
 	 */
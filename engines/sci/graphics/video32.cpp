@@ -247,6 +247,7 @@ void VideoPlayer::submitPalette(const uint8 palette[256 * 3]) const {
 
 	assert(palette);
 	g_system->getPaletteManager()->setPalette(palette, 0, 256);
+	g_sci->_gfxPalette32->invalidateBackendPalette();
 
 	// KQ7 1.x has videos encoded using Microsoft Video 1 where palette 0 is
 	// white and 255 is black, which is basically the opposite of DOS/Win SCI
@@ -513,6 +514,7 @@ AVIPlayer::IOStatus AVIPlayer::close() {
 		// videos, which replace palette entry 0 with white
 		const uint8 black[3] = { 0, 0, 0 };
 		g_system->getPaletteManager()->setPalette(black, 0, 1);
+		g_sci->_gfxPalette32->invalidateBackendPalette();
 	}
 
 	g_system->fillScreen(0);
@@ -109,6 +109,18 @@ MODULE_OBJS += \
 	sound/audio32.o \
 	sound/decoders/sol.o \
 	video/robot_decoder.o
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	graphics/celobj32_neon.o
+$(MODULE)/graphics/celobj32_neon.o: CXXFLAGS += $(NEON_CXXFLAGS)
+endif
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	graphics/celobj32_sse2.o
+$(MODULE)/graphics/celobj32_sse2.o: CXXFLAGS += -msse2
+endif
 endif
 
 # This module can be built as a plugin
@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
@@ -207,6 +208,7 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_fileOffset = 0;
 	_status = kResStatusNoMalloc;
 	_lockers = 0;
+	_compressed = false;
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
@@ -1003,13 +1005,17 @@ void ResourceManager::freeResourceSources() {
 }
 
 ResourceManager::ResourceManager(const bool detectionMode) :
-	_detectionMode(detectionMode) {}
+	_detectionMode(detectionMode), _lockedCounter("SCI resources (locked)"), _lruCounter("SCI resources (LRU)"),
+	_prefetchPending(false), _prefetchBudget(0) {}
 
 void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
 	_memoryLRU = 0;
+	_lockedCounter.set(0);
+	_lruCounter.set(0);
 	_LRU.clear();
+	resetLRUStats();
 	_resMap.clear();
 	_audioMapSCI1 = nullptr;
 #ifdef ENABLE_SCI32
@@ -1083,6 +1089,11 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	// Ports with little memory can lower the budget, while desktops can
+	// keep most of a game in memory
+	if (ConfMan.hasKey("sci_resource_cache_size"))
+		_maxMemoryLRU = MAX(ConfMan.getInt("sci_resource_cache_size"), 0) * 1024;
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1109,6 +1120,11 @@ void ResourceManager::init() {
 }
 
 ResourceManager::~ResourceManager() {
+	if (_prefetchPending) {
+		g_system->getJobSystem()->wait(_prefetchGroup);
+		finishPrefetch(nullptr);
+	}
+
 	// freeing resources
 	ResourceMap::iterator itr = _resMap.begin();
 	while (itr != _resMap.end()) {
@@ -1131,6 +1147,7 @@ void ResourceManager::removeFromLRU(Resource *res) {
 	}
 	_LRU.remove(res);
 	_memoryLRU -= res->size();
+	_lruCounter.remove(res->size());
 	res->_status = kResStatusAllocated;
 }
 
@@ -1141,6 +1158,7 @@ void ResourceManager::addToLRU(Resource *res) {
 	}
 	_LRU.push_front(res);
 	_memoryLRU += res->size();
+	_lruCounter.add(res->size());
 #ifdef SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
 	      res->_id.toString().c_str(), res->size,
@@ -1152,7 +1170,21 @@ void ResourceManager::addToLRU(Resource *res) {
 void ResourceManager::freeOldResources() {
 	while (_maxMemoryLRU < _memoryLRU) {
 		assert(!_LRU.empty());
-		Resource *goner = _LRU.back();
+
+		// Prefer freeing one of the oldest resources that can be read back
+		// without decompressing it
+		Common::List<Resource *>::iterator it = _LRU.reverse_begin();
+		Resource *goner = *it;
+		for (uint i = 0; i < kLRUEvictionWindow && it != _LRU.end(); ++i, --it) {
+			if (!(*it)->_compressed) {
+				if (i)
+					_lruStats.cheapEvictions++;
+				goner = *it;
+				break;
+			}
+		}
+
+		_lruStats.evictions++;
 		removeFromLRU(goner);
 		goner->unalloc();
 #ifdef SCI_VERBOSE_RESMAN
@@ -1197,9 +1229,17 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return nullptr;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (_prefetchPending)
+		finishPrefetch(retval);
+
+	if (retval->_status == kResStatusNoMalloc) {
+		_lruStats.misses++;
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+	} else {
+		_lruStats.hits++;
+	}
+
+	if (retval->_status == kResStatusEnqueued)
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
@@ -1217,6 +1257,7 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 			retval->_status = kResStatusLocked;
 			retval->_lockers = 0;
 			_memoryLocked += retval->_size;
+			_lockedCounter.add(retval->_size);
 		}
 		retval->_lockers++;
 	} else if (retval->_status != kResStatusLocked) { // Don't lock it
@@ -1232,6 +1273,161 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	}
 }
 
+void ResourceManager::prefetchRoom(uint16 roomNumber) {
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (jobSystem->getWorkerCount() == 0)
+		return;
+
+	if (_prefetchPending) {
+		jobSystem->wait(_prefetchGroup);
+		finishPrefetch(nullptr);
+	}
+
+	static const ResourceType types[] = {
+		kResourceTypePic, kResourceTypeView, kResourceTypePalette, kResourceTypeSound
+	};
+
+	for (int i = 0; i < ARRAYSIZE(types); ++i) {
+		const Resource *res = testResource(ResourceId(types[i], roomNumber));
+
+		// Only resources that are read straight from a volume can be
+		// decompressed without going through the volume file cache
+		if (!res || res->_status != kResStatusNoMalloc || res->_source->getSourceType() != kSourceVolume)
+			continue;
+
+		PrefetchItem item;
+		item.id = res->_id;
+		item.source = res->_source;
+		item.fileOffset = res->_fileOffset;
+		item.stream = nullptr;
+		item.data = nullptr;
+		item.size = 0;
+
+		for (uint j = 0; j < _prefetchItems.size(); ++j) {
+			if (_prefetchItems[j].source == item.source) {
+				item.stream = _prefetchItems[j].stream;
+				break;
+			}
+		}
+
+		if (!item.stream) {
+			if (item.source->_resourceFile) {
+				item.stream = item.source->_resourceFile->createReadStream();
+			} else {
+				Common::File *file = new Common::File();
+				if (file->open(item.source->getLocationName()))
+					item.stream = file;
+				else
+					delete file;
+			}
+			if (!item.stream)
+				continue;
+			_prefetchStreams.push_back(item.stream);
+		}
+
+		_prefetchItems.push_back(item);
+	}
+
+	if (_prefetchItems.empty())
+		return;
+
+	// Anything beyond the LRU size would only push out the first resources
+	// again
+	_prefetchBudget = _maxMemoryLRU / 2;
+	_prefetchPending = true;
+	jobSystem->submit(_prefetchGroup, prefetchProc, this);
+}
+
+void ResourceManager::prefetchProc(void *refCon) {
+	((ResourceManager *)refCon)->prefetch();
+}
+
+void ResourceManager::prefetch() {
+	uint32 total = 0;
+	for (uint i = 0; i < _prefetchItems.size() && total < _prefetchBudget; ++i) {
+		PrefetchItem &item = _prefetchItems[i];
+
+		Resource res(this, item.id);
+		res._source = item.source;
+		res._fileOffset = item.fileOffset;
+
+		item.stream->seek(item.fileOffset, SEEK_SET);
+		if (res.decompress(_volVersion, item.stream) || res._id != item.id)
+			continue;
+
+		item.data = const_cast<byte *>(res._data);
+		item.size = res._size;
+		item.compressed = res._compressed;
+		total += res._size;
+
+		// The data now belongs to the item
+		res._data = nullptr;
+		res._source = nullptr;
+	}
+}
+
+void ResourceManager::finishPrefetch(const Resource *res) {
+	if (!_prefetchPending)
+		return;
+
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (!jobSystem->isDone(_prefetchGroup)) {
+		if (!res || res->_status != kResStatusNoMalloc)
+			return;
+
+		uint i = 0;
+		while (i < _prefetchItems.size() && _prefetchItems[i].id != res->_id)
+			++i;
+		if (i == _prefetchItems.size())
+			return;
+
+		jobSystem->wait(_prefetchGroup);
+	}
+
+	_prefetchPending = false;
+
+	for (uint i = 0; i < _prefetchItems.size(); ++i) {
+		PrefetchItem &item = _prefetchItems[i];
+		if (!item.data)
+			continue;
+
+		// The resource may have been loaded or replaced while the job was
+		// running
+		Resource *target = testResource(item.id);
+		if (!target || target->_status != kResStatusNoMalloc || target->_source != item.source || target->_fileOffset != item.fileOffset) {
+			delete[] item.data;
+			continue;
+		}
+
+		target->_data = item.data;
+		target->_size = item.size;
+		target->_compressed = item.compressed;
+		target->_status = kResStatusAllocated;
+		if (_patcher)
+			_patcher->applyPatch(*target);
+		addToLRU(target);
+	}
+
+	for (uint i = 0; i < _prefetchStreams.size(); ++i)
+		delete _prefetchStreams[i];
+	_prefetchItems.clear();
+	_prefetchStreams.clear();
+
+	freeOldResources();
+}
+
+void ResourceManager::setMaxMemoryLRU(int bytes) {
+	_maxMemoryLRU = bytes;
+	freeOldResources();
+}
+
+void ResourceManager::resetLRUStats() {
+	_lruStats.hits = 0;
+	_lruStats.misses = 0;
+	_lruStats.evictions = 0;
+	_lruStats.cheapEvictions = 0;
+}
+
 void ResourceManager::unlockResource(Resource *res) {
 	assert(res);
 
@@ -1243,6 +1439,7 @@ void ResourceManager::unlockResource(Resource *res) {
 	if (!--res->_lockers) { // No more lockers?
 		res->_status = kResStatusAllocated;
 		_memoryLocked -= res->size();
+		_lockedCounter.remove(res->size());
 		addToLRU(res);
 	}
 
@@ -2399,6 +2596,7 @@ int Resource::decompress(ResVersion volVersion, Common::SeekableReadStream *file
 	byte *ptr = new byte[_size];
 	_data = ptr;
 	_status = kResStatusAllocated;
+	_compressed = compression != kCompNone;
 	errorNum = ptr ? dec->unpack(file, ptr, szPacked, _size) : SCI_ERROR_RESOURCE_TOO_BIG;
 	if (errorNum) {
 		unalloc();
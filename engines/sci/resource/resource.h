@@ -25,6 +25,8 @@
 #include "common/str.h"
 #include "common/list.h"
 #include "common/hashmap.h"
+#include "common/jobsystem.h"
+#include "common/memusage.h"
 
 #include "sci/graphics/helpers.h"		// for ViewType
 #include "sci/resource/decompressor.h"
@@ -309,6 +311,7 @@ protected:
 	int32 _fileOffset; /**< Offset in file */
 	ResourceStatus _status;
 	uint16 _lockers; /**< Number of places where this resource was locked */
+	bool _compressed; /**< Whether reloading the resource requires decompression */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
@@ -374,6 +377,34 @@ public:
 	 */
 	Resource *findResource(ResourceId id, bool lock);
 
+	/**
+	 * Starts reading and decompressing the pic, view, palette and sound
+	 * resources that share the number of a room on a worker thread, ahead of
+	 * the room scripts loading them. Does nothing if the job system has no
+	 * workers.
+	 * @param roomNumber	The number of the room that is being loaded
+	 */
+	void prefetchRoom(uint16 roomNumber);
+
+	struct LRUStats {
+		uint32 hits;      ///< Lookups of resources that were in memory
+		uint32 misses;    ///< Lookups that had to load the resource
+		uint32 evictions; ///< Resources freed to stay within the budget
+		uint32 cheapEvictions; ///< Evictions of uncompressed resources ahead of older ones
+	};
+
+	/**
+	 * Sets the number of bytes of unlocked resources to keep in memory, and
+	 * frees resources until the new budget is met.
+	 */
+	void setMaxMemoryLRU(int bytes);
+	int getMaxMemoryLRU() const { return _maxMemoryLRU; }
+	int getMemoryLRU() const { return _memoryLRU; }
+	int getMemoryLocked() const { return _memoryLocked; }
+	uint getNumLRU() const { return _LRU.size(); }
+	const LRUStats &getLRUStats() const { return _lruStats; }
+	void resetLRUStats();
+
 	/**
 	 * Unlocks a previously locked resource.
 	 * @param res	The resource to free
@@ -500,7 +531,17 @@ protected:
 	SourcesList _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
+	Common::MemoryCounter _lockedCounter; ///< Reports _memoryLocked to the mem_usage command
+	Common::MemoryCounter _lruCounter;    ///< Reports _memoryLRU to the mem_usage command
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	LRUStats _lruStats;
+
+	/**
+	 * Number of resources at the old end of the LRU list that are searched
+	 * for an uncompressed resource to free first, as those only cost a read
+	 * to load again.
+	 */
+	static const uint kLRUEvictionWindow = 8;
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -508,6 +549,34 @@ protected:
 	ResVersion _mapVersion; ///< resource.map version
 	bool _isSci2Mac;
 
+	// Resources being decompressed by a prefetch job. The job only works on
+	// copies of the resource locations and its own volume streams; results
+	// are moved into the LRU on the main thread.
+	struct PrefetchItem {
+		ResourceId id;
+		ResourceSource *source;
+		int32 fileOffset;
+		Common::SeekableReadStream *stream; ///< Owned by _prefetchStreams
+		byte *data;
+		uint32 size;
+		bool compressed;
+	};
+
+	Common::JobGroup _prefetchGroup;
+	bool _prefetchPending;
+	Common::Array<PrefetchItem> _prefetchItems;
+	Common::Array<Common::SeekableReadStream *> _prefetchStreams;
+	uint32 _prefetchBudget; ///< Maximum number of bytes decompressed by a job
+
+	static void prefetchProc(void *refCon);
+	void prefetch();
+
+	/**
+	 * Moves finished prefetched resources into the LRU. Waits for the job if
+	 * it is still running and the given resource is part of it.
+	 */
+	void finishPrefetch(const Resource *res);
+
 	/**
 	 * Add a path to the resource manager's list of sources.
 	 * @return a pointer to the added source structure, or NULL if an error occurred.
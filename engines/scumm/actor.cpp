@@ -146,6 +146,8 @@ void Actor::initActor(int mode) {
 		_top = _bottom = 0;
 		_needRedraw = false;
 		_needBgReset = false;
+		_drawnStateValid = false;
+		_drawnStateHash = 0;
 		_costumeNeedsInit = false;
 		_visible = false;
 		_flip = false;
@@ -2406,17 +2408,49 @@ void Actor::drawActorCostume(bool hitTestMode) {
 	prepareDrawActorCostume(bcr);
 
 	// If the actor is partially hidden, redraw it next frame.
+	bool partial = false;
 	if (bcr->drawCostume(_vm->_virtscr[kMainVirtScreen], _vm->_gdi->_numStrips, this, _drawToBackBuf) & 1) {
 		_needRedraw = (_vm->_game.version <= 6);
+		partial = true;
 	}
 
 	if (!hitTestMode) {
 		// Record the vertical extent of the drawn actor
 		_top = bcr->_drawTop;
 		_bottom = bcr->_drawBottom;
+
+		_drawnStateHash = getDrawStateHash(_vm->_actorDrawSeed);
+		_drawnStateValid = !partial;
 	}
 }
 
+static uint32 hashDrawState(uint32 hash, const void *data, uint size) {
+	const byte *ptr = (const byte *)data;
+
+	// FNV-1a
+	while (size--)
+		hash = (hash ^ *ptr++) * 16777619;
+	return hash;
+}
+
+uint32 Actor::getDrawStateHash(uint32 seed) {
+	const int32 state[] = {
+		_costume, _pos.x, _pos.y, _elevation, _scalex, _scaley, _boxscale,
+		_facing, _shadowMode, _forceClip, _walkbox, _vm->getMaskFromBox(_walkbox),
+		isInClass(kObjectClassNeverClip), (int32)_width, _drawToBackBuf
+	};
+
+	uint32 hash = hashDrawState(seed, state, sizeof(state));
+	hash = hashDrawState(hash, _palette, sizeof(_palette));
+	hash = hashDrawState(hash, &_cost.stopped, sizeof(_cost.stopped));
+	hash = hashDrawState(hash, _cost.animType, sizeof(_cost.animType));
+	hash = hashDrawState(hash, _cost.curpos, sizeof(_cost.curpos));
+	hash = hashDrawState(hash, _cost.start, sizeof(_cost.start));
+	hash = hashDrawState(hash, _cost.end, sizeof(_cost.end));
+	hash = hashDrawState(hash, _cost.frame, sizeof(_cost.frame));
+	return hash;
+}
+
 
 void Actor::prepareDrawActorCostume(BaseCostumeRenderer *bcr) {
 
@@ -2821,12 +2855,21 @@ void ScummEngine::redrawAllActors() {
 void ScummEngine::setActorRedrawFlags() {
 	int i, j;
 
+	// Actor draw states are not tracked for v0, which times its frames by the
+	// number of limbs drawn, nor for HE games, which also draw actors into
+	// the background and through auxiliary blocks.
+	const bool trackDrawState = (_game.version >= 1 && _game.heversion == 0);
+	if (trackDrawState)
+		_actorDrawSeed = getActorDrawSeed();
+
 	// Redraw all actors if a full redraw was requested.
 	// Also redraw all actors in COMI (see bug #1825 for details).
 	if (_fullRedraw || _game.version == 8 || (VAR_REDRAW_ALL_ACTORS != 0xFF && VAR(VAR_REDRAW_ALL_ACTORS) != 0)) {
 		for (j = 1; j < _numActors; j++) {
 			_actors[j]->_needRedraw = true;
 		}
+	} else if (trackDrawState) {
+		setChangedActorRedrawFlags();
 	} else {
 		if (_game.heversion >= 72) {
 			for (j = 1; j < _numActors; j++) {
@@ -2848,6 +2891,66 @@ void ScummEngine::setActorRedrawFlags() {
 	}
 }
 
+uint32 ScummEngine::getActorDrawSeed() const {
+	const int32 state[] = {
+		_currentRoom, _screenStartStrip, _virtscr[kMainVirtScreen].xstart,
+		_virtscr[kMainVirtScreen].topline, getCurrentLights(), _gdi->_numZBuffer
+	};
+
+	uint32 hash = hashDrawState(2166136261U, state, sizeof(state));
+	hash = hashDrawState(hash, _roomPalette, sizeof(_roomPalette));
+	if (_shadowPalette)
+		hash = hashDrawState(hash, _shadowPalette, _shadowPaletteSize);
+	return hash;
+}
+
+// Finer grained variant of the strip check in setActorRedrawFlags(). An
+// actor is drawn again only if its own drawing state changed, or if the
+// background under it is going to be restored: a strip that is dirty, or
+// shared with an actor whose background gets reset. Idle actors that merely
+// share strips with each other are left alone.
+void ScummEngine::setChangedActorRedrawFlags() {
+	int i, j;
+
+	// A redraw request that would draw exactly the same pixels again, e.g.
+	// an animation step landing on the same frame, can be dropped
+	for (j = 1; j < _numActors; j++) {
+		Actor *a = _actors[j];
+		if (a->_needRedraw && a->_drawnStateValid && !a->_needBgReset && a->isInCurrentRoom() &&
+			a->getDrawStateHash(_actorDrawSeed) == a->_drawnStateHash)
+			a->_needRedraw = false;
+	}
+
+	// Restoring the background under one actor wipes whatever other actors
+	// drew into the same strips, so keep going until no more actors join
+	bool changed;
+	do {
+		changed = false;
+		for (i = 0; i < _gdi->_numStrips; i++) {
+			int strip = _screenStartStrip + i;
+			if (!testGfxAnyUsageBits(strip))
+				continue;
+
+			bool restored = testGfxUsageBit(strip, USAGE_BIT_DIRTY) || testGfxUsageBit(strip, USAGE_BIT_RESTORED);
+			for (j = 1; j < _numActors && !restored; j++) {
+				if (testGfxUsageBit(strip, j) &&
+					((_actors[j]->_top != 0x7fffffff && _actors[j]->_needRedraw) || _actors[j]->_needBgReset))
+					restored = true;
+			}
+
+			if (!restored)
+				continue;
+
+			for (j = 1; j < _numActors; j++) {
+				if (testGfxUsageBit(strip, j) && !_actors[j]->_needRedraw) {
+					_actors[j]->_needRedraw = true;
+					changed = true;
+				}
+			}
+		}
+	} while (changed);
+}
+
 void ScummEngine::resetActorBgs() {
 	int i, j;
 
@@ -2862,6 +2965,7 @@ void ScummEngine::resetActorBgs() {
 			if (testGfxUsageBit(strip, j) &&
 				((_actors[j]->_top != 0x7fffffff && _actors[j]->_needRedraw) || _actors[j]->_needBgReset)) {
 				clearGfxUsageBit(strip, j);
+				_actors[j]->_drawnStateValid = false;
 				if ((_actors[j]->_bottom - _actors[j]->_top) >= 0)
 					_gdi->resetBackground(_actors[j]->_top, _actors[j]->_bottom, i);
 			}
@@ -117,6 +117,10 @@ public:
 	byte _talkStopFrame;
 
 	bool _needRedraw, _needBgReset, _visible;
+	// Whether the pixels of the last costume draw are still on screen, and
+	// a hash of the state that draw depended on
+	bool _drawnStateValid;
+	uint32 _drawnStateHash;
 	byte _shadowMode;
 	bool _flip;
 	byte _frame;
@@ -225,6 +229,7 @@ public:
 	virtual void turnToDirection(int newdir);
 	virtual void walkActor();
 	void drawActorCostume(bool hitTestMode = false);
+	uint32 getDrawStateHash(uint32 seed);
 	virtual void prepareDrawActorCostume(BaseCostumeRenderer *bcr);
 	virtual void animateCostume();
 	virtual void setActorCostume(int c);
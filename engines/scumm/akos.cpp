@@ -281,6 +281,8 @@ void AkosRenderer::setCostume(int costume, int shadow) {
 	const byte *akos = _vm->getResourceAddress(rtCostume, costume);
 	assert(akos);
 
+	_costume = costume;
+
 	_akhd = (const AkosHeader *)_vm->findResourceData(MKTAG('A','K','H','D'), akos);
 	_akof = (const AkosOffset *)_vm->findResourceData(MKTAG('A','K','O','F'), akos);
 	_akci = _vm->findResourceData(MKTAG('A','K','C','I'), akos);
@@ -604,6 +606,152 @@ void AkosRenderer::byleRLEDecode(ByleRLEData &dataBlock) {
 	} while (true);
 }
 
+void AkosRenderer::flushCostumeCache(int costume) {
+	CostumeCelSpansMap::iterator it = _celSpansCache.find(costume);
+	if (it == _celSpansCache.end())
+		return;
+
+	for (CelSpansMap::const_iterator cel = it->_value.begin(); cel != it->_value.end(); ++cel)
+		_celSpansCacheSize -= cel->_value.colors.size() + cel->_value.spans.size() * sizeof(CelSpans::Span) + cel->_value.columns.size() * sizeof(uint32);
+	_celSpansCache.erase(it);
+}
+
+/**
+ * Return the opaque spans of the cel at _srcPtr, decoding and caching them
+ * the first time the cel is drawn.
+ */
+const AkosRenderer::CelSpans *AkosRenderer::getCelSpans(const ByleRLEData &compData) {
+	if (_costume < 0 || _width <= 0 || _height <= 0)
+		return nullptr;
+
+	CelSpansMap &cels = _celSpansCache[_costume];
+	const uint32 offset = _srcPtr - _akcd;
+
+	CelSpansMap::iterator it = cels.find(offset);
+	if (it != cels.end()) {
+		if (it->_value.width == _width && it->_value.height == _height)
+			return &it->_value;
+		return nullptr;
+	}
+
+	// Decode the whole cel, using the same run format as byleRLEDecode()
+	CelSpans cel;
+	cel.width = _width;
+	cel.height = _height;
+	cel.columns.resize(_width + 1);
+
+	const byte *src = _srcPtr;
+	byte len = 0;
+	byte color = 0;
+	for (int x = 0; x < _width; x++) {
+		cel.columns[x] = cel.spans.size();
+		for (int y = 0; y < _height; y++) {
+			if (!len) {
+				len = *src++;
+				color = len >> compData.shr;
+				len &= compData.mask;
+				if (!len)
+					len = *src++;
+			}
+			len--;
+
+			if (!color)
+				continue;
+
+			if (cel.spans.size() > cel.columns[x] && cel.spans.back().start + cel.spans.back().length == y) {
+				cel.spans.back().length++;
+			} else {
+				CelSpans::Span span;
+				span.start = y;
+				span.length = 1;
+				span.offset = cel.colors.size();
+				cel.spans.push_back(span);
+			}
+			cel.colors.push_back(color);
+		}
+	}
+	cel.columns[_width] = cel.spans.size();
+
+	const uint32 size = cel.colors.size() + cel.spans.size() * sizeof(CelSpans::Span) + cel.columns.size() * sizeof(uint32);
+	if (size > kCelSpansCacheMaxSize)
+		return nullptr;
+
+	if (_celSpansCacheSize + size > kCelSpansCacheMaxSize) {
+		_celSpansCache.clear();
+		_celSpansCacheSize = 0;
+	}
+
+	_celSpansCacheSize += size;
+	CelSpansMap &costumeCels = _celSpansCache[_costume];
+	costumeCels[offset] = cel;
+	return &costumeCels[offset];
+}
+
+/**
+ * Equivalent of byleRLEDecode() for unscaled cels, which skips over the
+ * transparent pixels of each column using the cached opaque spans.
+ */
+void AkosRenderer::byleRLEDrawSpans(ByleRLEData &compData, const CelSpans &cel, int column) {
+	const int maskOffset = _vm->_virtscr[kMainVirtScreen].xstart & 7;
+
+	do {
+		if (compData.x >= 0 && compData.x < compData.boundsRect.right) {
+			const byte maskbit = revBitMask(compData.x & 7);
+			const byte *mask = _vm->getMaskBuffer(compData.x - maskOffset, compData.y, _zbuf);
+
+			for (uint32 i = cel.columns[column]; i < cel.columns[column + 1]; i++) {
+				const CelSpans::Span &span = cel.spans[i];
+				const int top = MAX<int>(span.start, compData.boundsRect.top - compData.y);
+				const int bottom = MIN<int>(span.start + span.length, compData.boundsRect.bottom - compData.y);
+
+				const byte *colors = &cel.colors[span.offset + top - span.start];
+				for (int y = top; y < bottom; y++) {
+					const byte color = *colors++;
+
+					if (mask[y * _numStrips] & maskbit)
+						continue;
+
+					byte *dst = compData.destPtr + y * _out.pitch;
+					uint16 pcolor = _palette[color];
+					if (_shadowMode == 1) {
+						if (pcolor == 13)
+							pcolor = _shadowTable[*dst];
+					} else if (_shadowMode == 2) {
+						error("AkosRenderer::byleRLEDrawSpans(): shadowMode 2 not implemented."); // TODO
+					} else if (_shadowMode == 3) {
+						if (_vm->_game.features & GF_16BIT_COLOR) {
+							uint16 srcColor = (pcolor >> 1) & 0x7DEF;
+							uint16 dstColor = (READ_UINT16(dst) >> 1) & 0x7DEF;
+							pcolor = srcColor + dstColor;
+						} else if (_vm->_game.heversion >= 90) {
+							pcolor = (pcolor << 8) + *dst;
+							pcolor = _xmap[pcolor];
+						} else if (pcolor < 8) {
+							pcolor = (pcolor << 8) + *dst;
+							pcolor = _shadowTable[pcolor];
+						}
+					}
+
+					if (_vm->_bytesPerPixel == 2) {
+						WRITE_UINT16(dst, pcolor);
+					} else {
+						*dst = pcolor;
+					}
+				}
+			}
+		}
+
+		if (!--compData.skipWidth)
+			return;
+
+		column++;
+		compData.x += compData.scaleXStep;
+		if (compData.x < 0 || compData.x >= compData.boundsRect.right)
+			return;
+		compData.destPtr += compData.scaleXStep * _vm->_bytesPerPixel;
+	} while (true);
+}
+
 const byte bigCostumeScaleTable[768] = {
 	0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0,
 	0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
@@ -867,13 +1015,21 @@ byte AkosRenderer::paintCelByleRLE(int xMoveCur, int yMoveCur) {
 
 	compData.repLen = 0;
 
+	// Unscaled cels are drawn from their cached opaque spans, costumes drawn
+	// for hit testing or scaled still go through the RLE decoder.
+	const CelSpans *celSpans = (!actorIsScaled && !_actorHitMode) ? getCelSpans(compData) : nullptr;
+	int firstColumn = 0;
+
 	if (_mirror) {
 		if (!actorIsScaled)
 			linesToSkip = compData.boundsRect.left - compData.x;
 
 		if (linesToSkip > 0) {
 			compData.skipWidth -= linesToSkip;
-			skipCelLines(compData, linesToSkip);
+			if (celSpans)
+				firstColumn = linesToSkip;
+			else
+				skipCelLines(compData, linesToSkip);
 			compData.x = compData.boundsRect.left;
 		} else {
 			linesToSkip = rect.right - compData.boundsRect.right;
@@ -888,7 +1044,10 @@ byte AkosRenderer::paintCelByleRLE(int xMoveCur, int yMoveCur) {
 			linesToSkip = rect.right - compData.boundsRect.right + 1;
 		if (linesToSkip > 0) {
 			compData.skipWidth -= linesToSkip;
-			skipCelLines(compData, linesToSkip)	;
+			if (celSpans)
+				firstColumn = linesToSkip;
+			else
+				skipCelLines(compData, linesToSkip);
 			compData.x = compData.boundsRect.right - 1;
 		} else {
 			linesToSkip = (compData.boundsRect.left -1) - rect.left;
@@ -924,7 +1083,10 @@ byte AkosRenderer::paintCelByleRLE(int xMoveCur, int yMoveCur) {
 	compData.height = _out.h;
 	compData.destPtr = (byte *)_out.getBasePtr(compData.x, compData.y);
 
-	byleRLEDecode(compData);
+	if (celSpans)
+		byleRLEDrawSpans(compData, *celSpans, firstColumn);
+	else
+		byleRLEDecode(compData);
 
 	return drawFlag;
 }
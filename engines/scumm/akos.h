@@ -22,6 +22,9 @@
 #ifndef SCUMM_AKOS_H
 #define SCUMM_AKOS_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
+
 #include "scumm/base-costume.h"
 
 namespace Scumm {
@@ -89,6 +92,35 @@ protected:
 	const byte *_rgbs;  // Raw costume RGB colors (HE specific)
 	const uint8 *_xmap; // shadow color table (HE specific)
 
+	int _costume;
+
+	/**
+	 * A ByleRLE cel decoded into the runs of opaque pixels of each of its
+	 * columns. Only the colour indices are kept, the palette and shadow
+	 * tables are still applied when the cel is drawn.
+	 */
+	struct CelSpans {
+		struct Span {
+			uint16 start;
+			uint16 length;
+			uint32 offset;
+		};
+
+		int width;
+		int height;
+		Common::Array<uint32> columns; // width + 1 indices into spans
+		Common::Array<Span> spans;
+		Common::Array<byte> colors;
+	};
+
+	typedef Common::HashMap<uint32, CelSpans> CelSpansMap;
+	typedef Common::HashMap<int, CelSpansMap> CostumeCelSpansMap;
+
+	CostumeCelSpansMap _celSpansCache;
+	uint32 _celSpansCacheSize;
+
+	/** Upper bound for the memory used by the decoded cels of all costumes. */
+	static const uint32 kCelSpansCacheMaxSize = 2 * 1024 * 1024;
 
 public:
 	AkosRenderer(ScummEngine *scumm) : BaseCostumeRenderer(scumm) {
@@ -102,6 +134,8 @@ public:
 		_akct = nullptr;
 		_rgbs = nullptr;
 		_xmap = nullptr;
+		_costume = -1;
+		_celSpansCacheSize = 0;
 		_actorHitMode = false;
 	}
 
@@ -112,12 +146,15 @@ public:
 	void setPalette(uint16 *_palette) override;
 	void setFacing(const Actor *a) override;
 	void setCostume(int costume, int shadow) override;
+	void flushCostumeCache(int costume) override;
 
 protected:
 	byte drawLimb(const Actor *a, int limb) override;
 
 	byte paintCelByleRLE(int xMoveCur, int yMoveCur);
 	void byleRLEDecode(ByleRLEData &v1);
+	const CelSpans *getCelSpans(const ByleRLEData &compData);
+	void byleRLEDrawSpans(ByleRLEData &compData, const CelSpans &cel, int column);
 	byte paintCelCDATRLE(int xMoveCur, int yMoveCur);
 	byte paintCelMajMin(int xMoveCur, int yMoveCur);
 	byte paintCelTRLE(int xMoveCur, int yMoveCur);
@@ -149,6 +149,11 @@ public:
 	virtual void setFacing(const Actor *a) = 0;
 	virtual void setCostume(int costume, int shadow) = 0;
 
+	/**
+	 * Called when the given costume resource is unloaded, so any data the
+	 * renderer derived from it can be dropped.
+	 */
+	virtual void flushCostumeCache(int costume) {}
 
 	byte drawCostume(const VirtScreen &vs, int numStrips, const Actor *a, bool drawToBackBuf);
 
@@ -583,7 +583,42 @@ bool ScummEngine::checkXYInBoxBounds(int boxnum, int x, int y) {
 	return true;
 }
 
+void ScummEngine::invalidateBoxCache() {
+	if (_boxCache) {
+		_boxCache->coordsValid = false;
+		_boxCache->nextBoxValid = false;
+	}
+}
+
+BoxCache *ScummEngine::getBoxCache() {
+	if (!_boxCache)
+		_boxCache = new BoxCache();
+
+	if (!_boxCache->coordsValid) {
+		if (!getResourceAddress(rtMatrix, 2))
+			return nullptr;
+
+		_boxCache->numBoxes = getNumBoxes();
+		_boxCache->coords.resize(_boxCache->numBoxes);
+		for (int i = 0; i < _boxCache->numBoxes; i++)
+			_boxCache->coords[i] = decodeBoxCoordinates(i);
+		_boxCache->coordsValid = true;
+	}
+
+	return _boxCache;
+}
+
 BoxCoords ScummEngine::getBoxCoordinates(int boxnum) {
+	// Out of range box numbers go through getBoxBaseAddr() directly,
+	// so that its workarounds keep applying to them.
+	const BoxCache *cache = getBoxCache();
+	if (cache && boxnum >= 0 && boxnum < cache->numBoxes)
+		return cache->coords[boxnum];
+
+	return decodeBoxCoordinates(boxnum);
+}
+
+BoxCoords ScummEngine::decodeBoxCoordinates(int boxnum) {
 	BoxCoords tmp, *box = &tmp;
 	Box *bp = getBoxBaseAddr(boxnum);
 	assert(bp);
@@ -728,9 +763,7 @@ byte *ScummEngine::getBoxConnectionBase(int box) {
  */
 int ScummEngine::getNextBox(byte from, byte to) {
 	const byte *boxm;
-	byte i;
 	const int numOfBoxes = getNumBoxes();
-	int dest = -1;
 
 	if (from == to)
 		return to;
@@ -766,6 +799,21 @@ int ScummEngine::getNextBox(byte from, byte to) {
 		return (int8)boxm[to];
 	}
 
+	// WORKAROUND #2: In addition to the truncation check below, we have to
+	// add this special case to fix the scene in Indy3 where Indy meets
+	// Hitler in Berlin. See bug #1017 and also bug #1052.
+	if ((_game.id == GID_INDY3) && _roomResource == 46 && from == 1 && to == 0)
+		return 0;
+
+	BoxCache *cache = getBoxCache();
+	assert(cache);
+	if (!cache->nextBoxValid)
+		decodeNextBoxMatrix(boxm, numOfBoxes);
+
+	return cache->nextBox[from * numOfBoxes + to];
+}
+
+void ScummEngine::decodeNextBoxMatrix(const byte *boxm, int numOfBoxes) {
 	// WORKAROUND #1: It seems that in some cases, the box matrix is corrupt
 	// (more precisely, is too short) in the datafiles already. In
 	// particular this seems to be the case in room 46 of Indy3 EGA (see
@@ -778,31 +826,30 @@ int ScummEngine::getNextBox(byte from, byte to) {
 	// As a workaround, we add a check for the end of the box matrix
 	// resource, and abort the search once we reach the end.
 	const byte *end = boxm + getResourceSize(rtMatrix, 1);
-
-	// WORKAROUND #2: In addition to the above, we have to add this special
-	// case to fix the scene in Indy3 where Indy meets Hitler in Berlin.
-	// See bug #1017 and also bug #1052.
-	if ((_game.id == GID_INDY3) && _roomResource == 46 && from == 1 && to == 0)
-		return 0;
-
-	// Skip up to the matrix data for box 'from'
-	for (i = 0; i < from && boxm < end; i++) {
-		while (boxm < end && *boxm != 0xFF)
+	bool truncated = false;
+
+	// Each row is a list of (first box, last box, next box) triplets,
+	// terminated by 0xFF. A later triplet overrides an earlier one.
+	_boxCache->nextBox.resize(numOfBoxes * numOfBoxes);
+	for (int from = 0; from < numOfBoxes; from++) {
+		int8 *row = &_boxCache->nextBox[from * numOfBoxes];
+		memset(row, -1, numOfBoxes);
+
+		while (boxm < end && boxm[0] != 0xFF) {
+			for (int to = boxm[0]; to <= boxm[1] && to < numOfBoxes; to++)
+				row[to] = (int8)boxm[2];
 			boxm += 3;
-		boxm++;
-	}
+		}
 
-	// Now search for the entry for box 'to'
-	while (boxm < end && boxm[0] != 0xFF) {
-		if (boxm[0] <= to && to <= boxm[1])
-			dest = (int8)boxm[2];
-		boxm += 3;
+		if (boxm >= end)
+			truncated = true;
+		boxm++;
 	}
 
-	if (boxm >= end)
+	if (truncated)
 		debug(0, "The box matrix apparently is truncated (room %d)", _roomResource);
 
-	return dest;
+	_boxCache->nextBoxValid = true;
 }
 
 /*
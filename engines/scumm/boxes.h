@@ -22,6 +22,7 @@
 #ifndef SCUMM_BOXES_H
 #define SCUMM_BOXES_H
 
+#include "common/array.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -48,6 +49,26 @@ struct BoxCoords {			/* Box coordinates */
 	Common::Point lr;
 };
 
+/**
+ * Walkbox data decoded from the current box resources. Actor routing
+ * queries the coordinates and the next-box matrix many times per frame,
+ * so both are decoded once and dropped whenever either of the rtMatrix
+ * resources is freed or replaced.
+ */
+struct BoxCache {
+	int numBoxes;
+	bool coordsValid;
+	bool nextBoxValid;
+
+	Common::Array<BoxCoords> coords;
+
+	// numBoxes * numBoxes entries, indexed by from * numBoxes + to;
+	// only used for v3+ games, where the matrix is run-length encoded.
+	Common::Array<int8> nextBox;
+
+	BoxCache() : numBoxes(0), coordsValid(false), nextBoxValid(false) {}
+};
+
 int getClosestPtOnBox(const BoxCoords &box, int x, int y, int16& outX, int16& outY);
 
 } // End of namespace Scumm
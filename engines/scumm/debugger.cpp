@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/debug-channels.h"
 #include "common/file.h"
 #include "common/str.h"
@@ -111,6 +112,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 #endif
 
 	registerCmd("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
+	registerCmd("profile",   WRAP_METHOD(ScummDebugger, Cmd_Profile));
 }
 
 void ScummDebugger::preEnter() {
@@ -297,6 +299,9 @@ bool ScummDebugger::Cmd_DiMuse(int argc, const char **argv) {
 		} else if (!strcmp(argv[1], "groups") || !strcmp(argv[1], "vols")) {
 			_vm->_imuseDigital->listGroups();
 			return true;
+		} else if (!strcmp(argv[1], "bundleCache")) {
+			_vm->_imuseDigital->listBundleCache(argc > 2 && !strcmp(argv[2], "reset"));
+			return true;
 		} else if (!strcmp(argv[1], "getParam")) {
 			if (argc > 3) {
 				int result = _vm->_imuseDigital->diMUSEGetParam(atoi(argv[2]), strtol(argv[3], NULL, 16));
@@ -356,6 +361,7 @@ bool ScummDebugger::Cmd_DiMuse(int argc, const char **argv) {
 	debugPrintf("\thook <soundId> <hookId>          - Set hookId for a sound\n");
 	debugPrintf("\tlist|tracks                      - Display info for every virtual audio track\n");
 	debugPrintf("\tgroups|vols                      - Show volume groups info\n");
+	debugPrintf("\tbundleCache [reset]              - Show bundle block cache statistics\n");
 	debugPrintf("\tgetParam <soundId> <param>       - Get parameter info from a sound\n");
 	debugPrintf("\tsetParam <soundId> <param> <val> - Set parameter value for a sound (dangerous!)\n");
 	debugPrintf("\n");
@@ -1414,4 +1420,115 @@ bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	return false;
 }
 
+bool ScummDebugger::Cmd_Profile(int argc, const char **argv) {
+	ScriptProfile &profile = _vm->_scriptProfile;
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "on")) {
+			profile.reset();
+			profile.enabled = true;
+			debugPrintf("Script profiling enabled\n");
+		} else if (!strcmp(argv[1], "off")) {
+			profile.enabled = false;
+			debugPrintf("Script profiling disabled\n");
+		} else if (!strcmp(argv[1], "reset")) {
+			profile.reset();
+			debugPrintf("Script profiling counters reset\n");
+		} else if (!strcmp(argv[1], "dump") && argc > 2) {
+			Common::DumpFile out;
+			if (!out.open(Common::Path(argv[2], Common::Path::kNativeSeparator), true)) {
+				debugPrintf("Could not open '%s' for writing\n", argv[2]);
+				return true;
+			}
+			printProfile(&out, 0);
+			out.finalize();
+			debugPrintf("Script profile written to '%s'\n", argv[2]);
+		} else {
+			debugPrintf("Usage: %s [on|off|reset|dump <filename>]\n", argv[0]);
+		}
+		return true;
+	}
+
+	if (!profile.enabled) {
+		debugPrintf("Script profiling is disabled, use '%s on' to enable it\n", argv[0]);
+		return true;
+	}
+
+	printProfile(nullptr, 15);
+	return true;
+}
+
+namespace {
+
+struct OpcodeTimeLess {
+	const ScriptProfile &_profile;
+	OpcodeTimeLess(const ScriptProfile &profile) : _profile(profile) {}
+	bool operator()(int a, int b) const {
+		return _profile.opcodeMicros[a] > _profile.opcodeMicros[b];
+	}
+};
+
+struct ScriptTimeLess {
+	bool operator()(const ScriptProfile::ScriptStatsMap::const_iterator &a, const ScriptProfile::ScriptStatsMap::const_iterator &b) const {
+		return a->_value.micros > b->_value.micros;
+	}
+};
+
+} // End of anonymous namespace
+
+// Prints the opcodes and scripts which took the most time, at most limit of
+// each unless it is 0. The full tables go to out if given, else the console.
+void ScummDebugger::printProfile(Common::WriteStream *out, uint limit) {
+	static const char *const whereNames[] = { "inventory", "room", "global", "local", "object" };
+	const ScriptProfile &profile = _vm->_scriptProfile;
+
+	Common::Array<int> opcodes;
+	uint64 totalMicros = 0;
+	for (int i = 0; i < 256; i++) {
+		if (profile.opcodeCount[i]) {
+			opcodes.push_back(i);
+			totalMicros += profile.opcodeMicros[i];
+		}
+	}
+	Common::sort(opcodes.begin(), opcodes.end(), OpcodeTimeLess(profile));
+
+	Common::Array<ScriptProfile::ScriptStatsMap::const_iterator> scripts;
+	for (ScriptProfile::ScriptStatsMap::const_iterator i = profile.scripts.begin(); i != profile.scripts.end(); ++i)
+		scripts.push_back(i);
+	Common::sort(scripts.begin(), scripts.end(), ScriptTimeLess());
+
+	Common::Array<Common::String> lines;
+	lines.push_back(Common::String::format("Script time: %u ms in %u opcodes, %u scripts",
+		(uint32)(totalMicros / 1000), opcodes.size(), scripts.size()));
+
+	lines.push_back("Opcodes:");
+	lines.push_back("  op  name                              count          us    us/call");
+	for (uint i = 0; i < opcodes.size() && (!limit || i < limit); i++) {
+		const int op = opcodes[i];
+		const uint32 count = profile.opcodeCount[op];
+		lines.push_back(Common::String::format("  %02X  %-30s %10u %11u %10u", op, _vm->getOpcodeDesc(op),
+			count, (uint32)profile.opcodeMicros[op], (uint32)(profile.opcodeMicros[op] / count)));
+	}
+
+	lines.push_back("Scripts:");
+	lines.push_back("  type       room  number    runs    opcodes          us");
+	for (uint i = 0; i < scripts.size() && (!limit || i < limit); i++) {
+		const uint32 key = scripts[i]->_key;
+		const ScriptProfile::ScriptStats &stats = scripts[i]->_value;
+		const uint where = key >> 28;
+		lines.push_back(Common::String::format("  %-9s %5u %7u %7u %10u %11u",
+			where < ARRAYSIZE(whereNames) ? whereNames[where] : "?", (key >> 16) & 0xFFF, key & 0xFFFF,
+			stats.runs, stats.opcodes, (uint32)stats.micros));
+	}
+
+	for (uint i = 0; i < lines.size(); i++) {
+		if (out) {
+			out->writeString(lines[i]);
+			out->writeByte('\n');
+		} else {
+			debugPrintf("%s\n", lines[i].c_str());
+		}
+	}
+}
+
 } // End of namespace Scumm
@@ -75,6 +75,9 @@ private:
 	bool Cmd_DiMuse(int argc, const char **argv);
 
 	bool Cmd_ResetCursors(int argc, const char **argv);
+	bool Cmd_Profile(int argc, const char **argv);
+
+	void printProfile(Common::WriteStream *out, uint limit);
 
 	void printBox(int box);
 	void drawBox(int box, int color);
@@ -54,6 +54,35 @@ static void copy8Col(byte *dst, int dstPitch, const byte *src, int height, uint8
 #endif
 static void clear8Col(byte *dst, int dstPitch, int height, uint8 bitDepth);
 
+typedef void (*CompositeTextProc)(byte *dst, const byte *src, const byte *text, int width, int height, int srcPitch, int textPitch);
+typedef void (*CompositeText16Proc)(byte *dst, const byte *src, const byte *text, const uint16 *palette, int width, int height, int srcPitch, int textPitch);
+
+static CompositeTextProc compositeText = nullptr;
+static CompositeText16Proc compositeText16 = nullptr;
+static bool compositeProcsSelected = false;
+
+/** Pick the SIMD text compositing loops supported by the CPU, if any. */
+static void selectCompositeProcs() {
+	if (compositeProcsSelected)
+		return;
+	compositeProcsSelected = true;
+
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+		compositeText = compositeTextNEON;
+		compositeText16 = compositeText16NEON;
+		return;
+	}
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		compositeText = compositeTextSSE2;
+		compositeText16 = compositeText16SSE2;
+		return;
+	}
+#endif
+}
+
 struct StripTable {
 	int offsets[160];
 	int run[160];
@@ -217,7 +246,9 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_vertStripNextInc = 0;
 	_zbufferDisabled = false;
 	_objectMode = false;
+	_stripOpaque = false;
 	_distaff = false;
+	resetStripCache();
 }
 
 Gdi::~Gdi() {
@@ -284,9 +315,12 @@ void Gdi::init() {
 		// the backbuf (thus we have to treat the right border separately).
 		_numStrips += 1;
 	}
+
+	resetStripCache();
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	resetStripCache();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -689,6 +723,8 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 		assert(IS_ALIGNED(text, 4));
 		assert(0 == (width & 3));
 
+		selectCompositeProcs();
+
 #ifndef DISABLE_TOWNS_DUAL_LAYER_MODE
 		if (_game.platform == Common::kPlatformFMTowns) {
 			towns_drawStripToScreen(vs, x, y, x, top, width, height);
@@ -696,7 +732,10 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 		} else
 #endif
 		// Compose the text over the game graphics
-		if (_outputPixelFormat.bytesPerPixel == 2) {
+		if (_outputPixelFormat.bytesPerPixel == 2 && compositeText16 && vs->format.bytesPerPixel == 2) {
+			compositeText16(_compositeBuf, (const byte *)src, (const byte *)text, _game.heversion != 0 ? nullptr : _16BitPalette,
+				width * m, height * m, width * m * 2 + vsPitch, _textSurface.pitch);
+		} else if (_outputPixelFormat.bytesPerPixel == 2) {
 			const byte *srcPtr = (const byte *)src;
 			const byte *textPtr = (byte *)_textSurface.getBasePtr(x * m, y * m);
 			byte *dstPtr = _compositeBuf;
@@ -721,35 +760,39 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 #ifdef USE_ARM_GFX_ASM
 			asmDrawStripToScreen(height, width, text, src, _compositeBuf, vs->pitch, width, _textSurface.pitch);
 #else
-			// We blit four pixels at a time, for improved performance.
-			const uint32 *src32 = (const uint32 *)src;
-			uint32 *dst32 = (uint32 *)_compositeBuf;
-
-			vsPitch >>= 2;
-
-			const uint32 *text32 = (const uint32 *)text;
-			const int textPitch = (_textSurface.pitch - width * m) >> 2;
-			for (int h = height * m; h > 0; --h) {
-				for (int w = width * m; w > 0; w -= 4) {
-					uint32 temp = *text32++;
-
-					// Generate a byte mask for those text pixels (bytes) with
-					// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
-					// in mask will be either equal to 0x00 or 0xFF.
-					// Doing it this way avoids branches and bytewise operations,
-					// at the cost of readability ;).
-					uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
-					mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
-					mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
-
-					// The following line is equivalent to this code:
-					//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
-					// However, some compilers can generate somewhat better
-					// machine code for this equivalent statement:
-					*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
+			if (compositeText) {
+				compositeText(_compositeBuf, (const byte *)src, (const byte *)text, width * m, height * m, width * m + vsPitch, _textSurface.pitch);
+			} else {
+				// We blit four pixels at a time, for improved performance.
+				const uint32 *src32 = (const uint32 *)src;
+				uint32 *dst32 = (uint32 *)_compositeBuf;
+
+				vsPitch >>= 2;
+
+				const uint32 *text32 = (const uint32 *)text;
+				const int textPitch = (_textSurface.pitch - width * m) >> 2;
+				for (int h = height * m; h > 0; --h) {
+					for (int w = width * m; w > 0; w -= 4) {
+						uint32 temp = *text32++;
+
+						// Generate a byte mask for those text pixels (bytes) with
+						// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
+						// in mask will be either equal to 0x00 or 0xFF.
+						// Doing it this way avoids branches and bytewise operations,
+						// at the cost of readability ;).
+						uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
+						mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
+						mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
+
+						// The following line is equivalent to this code:
+						//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
+						// However, some compilers can generate somewhat better
+						// machine code for this equivalent statement:
+						*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
+					}
+					src32 += vsPitch;
+					text32 += textPitch;
 				}
-				src32 += vsPitch;
-				text32 += textPitch;
 			}
 #endif
 		}
@@ -2121,6 +2164,8 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		limit = numstrip;
 	if (limit > _numStrips - sx)
 		limit = _numStrips - sx;
+	const bool useStripCache = prepareStripCache(ptr, vs, y, height, numzbuf, flag);
+
 	for (int k = 0; k < limit; ++k, ++stripnr, ++sx, ++x) {
 		if (y < vs->tdirty[sx])
 			vs->tdirty[sx] = y;
@@ -2135,7 +2180,14 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		const bool cachedStrip = useStripCache && stripnr < _stripCache.numStrips && _stripCache.valid[stripnr];
+		if (cachedStrip) {
+			restoreCachedStrip(dstPtr, vs, x, y, height, stripnr, numzbuf, zplane_list);
+			transpStrip = false;
+		} else {
+			_stripOpaque = false;
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		}
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
@@ -2149,7 +2201,12 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		if (!cachedStrip) {
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+
+			if (useStripCache && _stripOpaque && stripnr < _stripCache.numStrips)
+				storeCachedStrip(dstPtr, vs, x, y, height, stripnr, numzbuf, zplane_list);
+		}
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
@@ -2177,6 +2234,99 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	}
 }
 
+void Gdi::resetStripCache() {
+	_stripCache.image = nullptr;
+	_stripCache.height = 0;
+	_stripCache.numZBuffer = 0;
+	_stripCache.bytesPerPixel = 0;
+	_stripCache.numStrips = 0;
+	_stripCache.stripSize = 0;
+	_stripCache.disabled = false;
+	memset(_stripCache.palette, 0, sizeof(_stripCache.palette));
+	_stripCache.data.clear();
+	_stripCache.valid.clear();
+}
+
+/**
+ * Check whether the strips of the given drawBitmap() call can be served from
+ * (and stored in) the strip cache, resetting the cache if it was filled from
+ * a different image, screen layout or room palette.
+ */
+bool Gdi::prepareStripCache(const byte *ptr, VirtScreen *vs, int y, int height, int numzbuf, byte flag) {
+	// Only room backgrounds are cached. Objects are drawn with flags or at
+	// varying heights, and their strips are rarely redrawn unchanged.
+	if (_objectMode || flag != 0 || vs->number != kMainVirtScreen || y != 0 || height != vs->h)
+		return false;
+
+	// Indy4 Amiga switches the palette map inside drawStrip(), which a cache
+	// hit would skip.
+	if (_vm->_game.platform == Common::kPlatformAmiga && _vm->_game.id == GID_INDY4)
+		return false;
+
+	if (_stripCache.image != ptr || _stripCache.height != height || _stripCache.numZBuffer != numzbuf ||
+		_stripCache.bytesPerPixel != vs->format.bytesPerPixel ||
+		memcmp(_stripCache.palette, _vm->_roomPalette, sizeof(_stripCache.palette)) != 0) {
+		resetStripCache();
+
+		_stripCache.image = ptr;
+		_stripCache.height = height;
+		_stripCache.numZBuffer = numzbuf;
+		_stripCache.bytesPerPixel = vs->format.bytesPerPixel;
+		_stripCache.numStrips = _vm->_roomWidth / 8;
+		_stripCache.stripSize = height * (8 * vs->format.bytesPerPixel + MAX(numzbuf - 1, 0));
+		memcpy(_stripCache.palette, _vm->_roomPalette, sizeof(_stripCache.palette));
+
+		if (_stripCache.numStrips <= 0 || _stripCache.numStrips * _stripCache.stripSize > kStripCacheMaxSize) {
+			_stripCache.disabled = true;
+		} else {
+			_stripCache.data.resize(_stripCache.numStrips * _stripCache.stripSize);
+			_stripCache.valid.resize(_stripCache.numStrips);
+			for (int i = 0; i < _stripCache.numStrips; i++)
+				_stripCache.valid[i] = false;
+		}
+	}
+
+	return !_stripCache.disabled;
+}
+
+void Gdi::storeCachedStrip(const byte *dstPtr, VirtScreen *vs, int x, int y, int height,
+						int stripnr, int numzbuf, const byte *zplane_list[9]) {
+	const int rowSize = 8 * vs->format.bytesPerPixel;
+	byte *cache = &_stripCache.data[stripnr * _stripCache.stripSize];
+
+	for (int h = 0; h < height; h++, cache += rowSize, dstPtr += vs->pitch)
+		memcpy(cache, dstPtr, rowSize);
+
+	// decodeMask() leaves the planes without data untouched, so only the
+	// ones it actually wrote are kept.
+	for (int i = 1; i < numzbuf; i++, cache += height) {
+		if (!zplane_list[i])
+			continue;
+		const byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; h++)
+			cache[h] = mask_ptr[h * _numStrips];
+	}
+
+	_stripCache.valid[stripnr] = true;
+}
+
+void Gdi::restoreCachedStrip(byte *dstPtr, VirtScreen *vs, int x, int y, int height,
+						int stripnr, int numzbuf, const byte *zplane_list[9]) {
+	const int rowSize = 8 * vs->format.bytesPerPixel;
+	const byte *cache = &_stripCache.data[stripnr * _stripCache.stripSize];
+
+	for (int h = 0; h < height; h++, cache += rowSize, dstPtr += vs->pitch)
+		memcpy(dstPtr, cache, rowSize);
+
+	for (int i = 1; i < numzbuf; i++, cache += height) {
+		if (!zplane_list[i])
+			continue;
+		byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; h++)
+			mask_ptr[h * _numStrips] = cache[h];
+	}
+}
+
 bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr) {
 	// Do some input verification and make sure the strip/strip offset
@@ -2654,6 +2804,7 @@ bool Gdi::decompressBitmap(byte *dst, int dstPitch, const byte *src, int numLine
 
 	if (_vm->_game.features & GF_16COLOR) {
 		drawStripEGA(dst, dstPitch, src, numLinesToProcess);
+		_stripOpaque = true;
 		return false;
 	}
 
@@ -2790,6 +2941,9 @@ bool Gdi::decompressBitmap(byte *dst, int dstPitch, const byte *src, int numLine
 		error("Gdi::decompressBitmap: default case %d", code);
 	}
 
+	// BMCOMP_TPIX256 skips transparent pixels without reporting it
+	_stripOpaque = !transpStrip && code != BMCOMP_TPIX256;
+
 	return transpStrip;
 }
 
@@ -23,6 +23,7 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
@@ -295,6 +296,20 @@ struct StripTable;
 #define CHARSET_MASK_TRANSPARENCY	 0xFD
 #define CHARSET_MASK_TRANSPARENCY_32 0xFDFDFDFD
 
+/**
+ * SIMD versions of the loops in ScummEngine::drawStripToScreen() which
+ * composite the text surface over the game graphics. The width is given in
+ * pixels, the pitches in bytes, and the destination rows are packed.
+ */
+#ifdef SCUMMVM_SSE2
+void compositeTextSSE2(byte *dst, const byte *src, const byte *text, int width, int height, int srcPitch, int textPitch);
+void compositeText16SSE2(byte *dst, const byte *src, const byte *text, const uint16 *palette, int width, int height, int srcPitch, int textPitch);
+#endif
+#ifdef SCUMMVM_NEON
+void compositeTextNEON(byte *dst, const byte *src, const byte *text, int width, int height, int srcPitch, int textPitch);
+void compositeText16NEON(byte *dst, const byte *src, const byte *text, const uint16 *palette, int width, int height, int srcPitch, int textPitch);
+#endif
+
 class Gdi {
 protected:
 	ScummEngine *_vm;
@@ -310,6 +325,31 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/** Flag set by decompressBitmap() when the strip it decoded overwrote every pixel. */
+	bool _stripOpaque;
+
+	/**
+	 * Decoded room background strips and their z-plane masks, so that redrawing
+	 * a strip while scrolling becomes a copy instead of a decode. Only opaque,
+	 * full height strips drawn to the main virtual screen are kept, and the
+	 * cache is dropped whenever the room, its image or the room palette changes.
+	 */
+	struct StripCache {
+		const byte *image;
+		int height;
+		int numZBuffer;
+		int bytesPerPixel;
+		int numStrips;
+		int stripSize;
+		bool disabled;
+		byte palette[256];
+		Common::Array<byte> data;
+		Common::Array<bool> valid;
+	} _stripCache;
+
+	/** Upper bound for the memory used by the strip cache of a single room. */
+	static const int kStripCacheMaxSize = 4 * 1024 * 1024;
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -357,6 +397,14 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip);
 
+	/* Strip cache */
+	void resetStripCache();
+	bool prepareStripCache(const byte *ptr, VirtScreen *vs, int y, int height, int numzbuf, byte flag);
+	void storeCachedStrip(const byte *dstPtr, VirtScreen *vs, int x, int y, int height,
+	                int stripnr, int numzbuf, const byte *zplane_list[9]);
+	void restoreCachedStrip(byte *dstPtr, VirtScreen *vs, int x, int y, int height,
+	                int stripnr, int numzbuf, const byte *zplane_list[9]);
+
 public:
 	Gdi(ScummEngine *vm);
 	virtual ~Gdi();
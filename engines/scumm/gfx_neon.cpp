@@ -0,0 +1,87 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <arm_neon.h>
+
+#include "common/endian.h"
+#include "common/textconsole.h"
+
+#include "scumm/scumm.h"
+#include "scumm/gfx.h"
+
+namespace Scumm {
+
+void compositeTextNEON(byte *dst, const byte *src, const byte *text, int width, int height, int srcPitch, int textPitch) {
+	const uint8x16_t transparent = vdupq_n_u8(CHARSET_MASK_TRANSPARENCY);
+
+	for (; height > 0; --height) {
+		int w = 0;
+		for (; w + 16 <= width; w += 16) {
+			const uint8x16_t t = vld1q_u8(text + w);
+			const uint8x16_t s = vld1q_u8(src + w);
+			vst1q_u8(dst + w, vbslq_u8(vceqq_u8(t, transparent), s, t));
+		}
+		for (; w < width; ++w)
+			dst[w] = (text[w] == CHARSET_MASK_TRANSPARENCY) ? src[w] : text[w];
+
+		dst += width;
+		src += srcPitch;
+		text += textPitch;
+	}
+}
+
+void compositeText16NEON(byte *dst, const byte *src, const byte *text, const uint16 *palette, int width, int height, int srcPitch, int textPitch) {
+	const uint8x16_t transparent = vdupq_n_u8(CHARSET_MASK_TRANSPARENCY);
+
+	for (; height > 0; --height) {
+		int w = 0;
+		for (; w + 8 <= width; w += 8) {
+			// Text is rare, so blocks without any are copied straight over
+			// and the others are handled one pixel at a time.
+			const uint8x8_t t = vld1_u8(text + w);
+			if (vget_lane_u64(vreinterpret_u64_u8(vceq_u8(t, vget_low_u8(transparent))), 0) == ~(uint64)0) {
+				vst1q_u8(dst + w * 2, vld1q_u8(src + w * 2));
+				continue;
+			}
+			for (int i = w; i < w + 8; ++i) {
+				if (text[i] == CHARSET_MASK_TRANSPARENCY)
+					WRITE_UINT16(dst + i * 2, READ_UINT16(src + i * 2));
+				else if (!palette)
+					error("16Bit Color HE Game using old charset");
+				else
+					WRITE_UINT16(dst + i * 2, palette[text[i]]);
+			}
+		}
+		for (; w < width; ++w) {
+			if (text[w] == CHARSET_MASK_TRANSPARENCY)
+				WRITE_UINT16(dst + w * 2, READ_UINT16(src + w * 2));
+			else if (!palette)
+				error("16Bit Color HE Game using old charset");
+			else
+				WRITE_UINT16(dst + w * 2, palette[text[w]]);
+		}
+
+		dst += width * 2;
+		src += srcPitch;
+		text += textPitch;
+	}
+}
+
+} // End of namespace Scumm
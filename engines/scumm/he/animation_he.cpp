@@ -70,8 +70,10 @@ int MoviePlayer::load(const Common::Path &filename, int flags, int image) {
 		return -1;
 	}
 
-	// Ensure that Bink will use our PixelFormat
-	_video->setOutputPixelFormat(g_system->getScreenFormat());
+	// Ensure that Bink will use our PixelFormat. Palette based videos stay
+	// in CLUT8, since copyFrameToBuffer() maps them through the HE palettes.
+	if (!_video->getPixelFormat().isCLUT8())
+		_video->setOutputPixelFormat(g_system->getScreenFormat());
 
 	_video->start();
 
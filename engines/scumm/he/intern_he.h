@@ -288,6 +288,8 @@ public:
 
 	Wiz *_wiz;
 
+	void flushWizCache(ResId idx) override { _wiz->flushWizCache(idx); }
+
 	virtual int setupStringArray(int size);
 
 protected:
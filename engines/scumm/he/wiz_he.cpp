@@ -34,12 +34,36 @@
 
 namespace Scumm {
 
+static void (*blendWizSpan16)(uint8 *dst, const uint8 *src, int count) = nullptr;
+static bool wizSpanProcsSelected = false;
+
+/** Pick the SIMD span compositing loops supported by the CPU, if any. */
+static void selectWizSpanProcs() {
+	if (wizSpanProcsSelected)
+		return;
+	wizSpanProcsSelected = true;
+
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+		blendWizSpan16 = blendWizSpan16NEON;
+		return;
+	}
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		blendWizSpan16 = blendWizSpan16SSE2;
+		return;
+	}
+#endif
+}
+
 Wiz::Wiz(ScummEngine_v71he *vm) : _vm(vm) {
 	_imagesNum = 0;
 	memset(&_images, 0, sizeof(_images));
 	memset(&_polygons, 0, sizeof(_polygons));
 	_cursorImage = false;
 	_rectOverrideEnabled = false;
+	_decodedImagesSize = 0;
 }
 
 void Wiz::clearWizBuffer() {
@@ -1580,7 +1604,8 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 		y1 = 0;
 		width = rScreen.width();
 		height = rScreen.height();
-	} else {
+	} else if (mask || !drawDecodedImage(dst, resNum, dataPtr, dstPitch, dstType, cw, ch, x1, y1,
+			state, &rScreen, flags, palPtr, _vm->_bytesPerPixel, xmapPtr)) {
 		drawWizImageEx(dst, dataPtr, mask, dstPitch, dstType, cw, ch, x1, y1, width, height,
 			state, &rScreen, flags, palPtr, transColor, _vm->_bytesPerPixel, xmapPtr, conditionBits);
 	}
@@ -1654,6 +1679,217 @@ void Wiz::drawWizImageEx(uint8 *dst, uint8 *dataPtr, uint8 *maskPtr, int dstPitc
 	}
 }
 
+void Wiz::flushWizCache(int resNum) {
+	Common::HashMap<int, DecodedImageStates>::iterator states = _decodedImages.find(resNum);
+	if (states == _decodedImages.end())
+		return;
+
+	for (DecodedImageStates::iterator it = states->_value.begin(); it != states->_value.end(); ++it)
+		_decodedImagesSize -= it->_value.pixels.size() + it->_value.spans.size() * sizeof(DecodedImage::Span) + it->_value.rows.size() * sizeof(uint32);
+	_decodedImages.erase(states);
+}
+
+const Wiz::DecodedImage *Wiz::getDecodedImage(int resNum, int state, uint8 *dataPtr, uint32 comp, int width, int height) {
+	DecodedImageStates &states = _decodedImages.getOrCreateVal(resNum);
+	DecodedImageStates::iterator it = states.find(state);
+	if (it != states.end())
+		return &it->_value;
+
+	const uint8 *src = _vm->findWrappedBlock(MKTAG('W','I','Z','D'), dataPtr, state, 0);
+	assert(src);
+
+	DecodedImage &image = states.getOrCreateVal(state);
+	image.width = width;
+	image.height = height;
+	image.pixelSize = (comp == 5) ? 2 : 1;
+	image.rows.resize(height + 1);
+
+	// Same line format as in decompressWizImage(), but decoded in full:
+	// odd codes skip pixels, codes with bit 1 set repeat one color and
+	// the others are followed by a literal run of colors.
+	const int pixelSize = image.pixelSize;
+	for (int y = 0; y < height; y++) {
+		image.rows[y] = image.spans.size();
+		const uint16 lineSize = READ_LE_UINT16(src);
+		src += 2;
+		const uint8 *srcNext = src + lineSize;
+
+		int x = 0;
+		while (lineSize != 0 && x < width) {
+			uint8 code = *src++;
+			if (code & 1) {
+				x += code >> 1;
+				continue;
+			}
+
+			const int count = (code >> 2) + 1;
+			const int visible = MIN(count, width - x);
+			const uint32 offset = image.pixels.size();
+			image.pixels.resize(offset + visible * pixelSize);
+			uint8 *pixels = image.pixels.data() + offset;
+			if (code & 2) {
+				for (int i = 0; i < visible; i++)
+					memcpy(pixels + i * pixelSize, src, pixelSize);
+				src += pixelSize;
+			} else {
+				memcpy(pixels, src, visible * pixelSize);
+				src += count * pixelSize;
+			}
+
+			// Runs following each other without a skip in between end up
+			// next to each other in the pixel buffer as well, so merge them.
+			if (image.spans.size() > image.rows[y] && image.spans.back().start + image.spans.back().length == x) {
+				image.spans.back().length += visible;
+			} else {
+				DecodedImage::Span span;
+				span.start = x;
+				span.length = visible;
+				span.offset = offset;
+				image.spans.push_back(span);
+			}
+			x += visible;
+		}
+		src = srcNext;
+	}
+	image.rows[height] = image.spans.size();
+
+	const uint32 size = image.pixels.size() + image.spans.size() * sizeof(DecodedImage::Span) + image.rows.size() * sizeof(uint32);
+	if (_decodedImagesSize + size > kDecodedImagesMaxSize) {
+		_decodedImages.clear();
+		_decodedImagesSize = 0;
+		if (size > kDecodedImagesMaxSize)
+			return nullptr;
+
+		// Clearing the cache invalidated 'image', so start over with an
+		// empty cache.
+		return getDecodedImage(resNum, state, dataPtr, comp, width, height);
+	}
+	_decodedImagesSize += size;
+
+	return &image;
+}
+
+template<int type>
+void Wiz::drawDecodedSpan(uint8 *dst, int dstInc, int dstType, const uint8 *src, int count, uint8 pixelSize, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+#ifdef USE_RGB_COLOR
+	if (pixelSize == 2) {
+		// 16-bit colors are stored little endian, which on little endian
+		// hosts is also what writeColor() ends up writing for any target.
+#ifdef SCUMM_LITTLE_ENDIAN
+		if (dstInc == 2 && type == kWizCopy) {
+			memcpy(dst, src, count * 2);
+			return;
+		}
+		if (dstInc == 2 && type == kWizXMap && blendWizSpan16) {
+			blendWizSpan16(dst, src, count);
+			return;
+		}
+#endif
+		while (count--) {
+			write16BitColor<type>(dst, src, dstType, xmapPtr);
+			src += 2;
+			dst += dstInc;
+		}
+		return;
+	}
+#endif
+
+	if (dstInc == 1 && type == kWizCopy) {
+		memcpy(dst, src, count);
+		return;
+	}
+	while (count--) {
+		write8BitColor<type>(dst, src, dstType, palPtr, xmapPtr, bitDepth);
+		src++;
+		dst += dstInc;
+	}
+}
+
+bool Wiz::drawDecodedImage(uint8 *dst, int resNum, uint8 *dataPtr, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int state, const Common::Rect *rect, int flags, const uint8 *palPtr, uint8 bitDepth, const uint8 *xmapPtr) {
+	const uint8 *wizh = _vm->findWrappedBlock(MKTAG('W','I','Z','H'), dataPtr, state, 0);
+	assert(wizh);
+	const uint32 comp = READ_LE_UINT32(wizh + 0x0);
+	const int srcw = READ_LE_UINT32(wizh + 0x4);
+	const int srch = READ_LE_UINT32(wizh + 0x8);
+
+	if (comp == 1) {
+		if (flags & (kWIFZPlaneOn | kWIFZPlaneOff))
+			return false;
+#ifdef USE_RGB_COLOR
+	} else if (comp == 5) {
+		bitDepth = 2;
+		palPtr = nullptr;
+#endif
+	} else {
+		return false;
+	}
+	if (srcw <= 0 || srch <= 0 || srcw > 0xFFFF)
+		return false;
+
+	const DecodedImage *image = getDecodedImage(resNum, state, dataPtr, comp, srcw, srch);
+	if (!image)
+		return false;
+
+	// Clip and flip the same way as copyWizImage() and copy16BitWizImage()
+	Common::Rect r1, r2;
+	if (!calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, r1, r2))
+		return true;
+	if (flags & kWIFFlipY) {
+		const int dy = (srcy < 0) ? srcy : (srch - r1.height());
+		r1.translate(0, dy);
+	}
+	if (flags & kWIFFlipX) {
+		const int dx = (srcx < 0) ? srcx : (srcw - r1.width());
+		r1.translate(dx, 0);
+	}
+	const int w = r1.width();
+	const int h = r1.height();
+	if (w <= 0 || h <= 0)
+		return true;
+
+	// Flipping an image that is also clipped by the clip box can move the
+	// source rectangle outside of the image. Leave that to the RLE decoders,
+	// which read whatever follows the image data.
+	if (r1.left < 0 || r1.top < 0 || r1.right > srcw || r1.bottom > srch)
+		return false;
+
+	selectWizSpanProcs();
+
+	uint8 *dstRow = dst + r2.top * dstPitch + r2.left * bitDepth;
+	if (flags & kWIFFlipY) {
+		dstRow += (h - 1) * dstPitch;
+		dstPitch = -dstPitch;
+	}
+	const int dstInc = (flags & kWIFFlipX) ? -bitDepth : bitDepth;
+	const uint8 pixelSize = image->pixelSize;
+
+	for (int y = r1.top; y < r1.bottom; y++, dstRow += dstPitch) {
+		for (uint32 i = image->rows[y]; i < image->rows[y + 1]; i++) {
+			const DecodedImage::Span &span = image->spans[i];
+			if (span.start >= r1.right)
+				break;
+			const int x0 = MAX<int>(span.start, r1.left);
+			const int x1 = MIN<int>(span.start + span.length, r1.right);
+			if (x0 >= x1)
+				continue;
+
+			const uint8 *src = image->pixels.data() + span.offset + (x0 - span.start) * pixelSize;
+			const int col = (flags & kWIFFlipX) ? (w - 1 - (x0 - r1.left)) : (x0 - r1.left);
+			uint8 *dstPtr = dstRow + col * bitDepth;
+
+			// A flipped run is written right to left from its last pixel
+			if (xmapPtr)
+				drawDecodedSpan<kWizXMap>(dstPtr, dstInc, dstType, src, x1 - x0, pixelSize, palPtr, xmapPtr, bitDepth);
+			else if (palPtr)
+				drawDecodedSpan<kWizRMap>(dstPtr, dstInc, dstType, src, x1 - x0, pixelSize, palPtr, nullptr, bitDepth);
+			else
+				drawDecodedSpan<kWizCopy>(dstPtr, dstInc, dstType, src, x1 - x0, pixelSize, nullptr, nullptr, bitDepth);
+		}
+	}
+
+	return true;
+}
+
 #ifdef USE_RGB_COLOR
 
 void Wiz::copyCompositeWizImage(uint8 *dst, uint8 *wizPtr, uint8 *compositeInfoBlockPtr, uint8 *maskPtr, int dstPitch, int dstType,
@@ -22,6 +22,8 @@
 #if !defined(SCUMM_HE_WIZ_HE_H) && defined(ENABLE_HE)
 #define SCUMM_HE_WIZ_HE_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -331,10 +333,50 @@ public:
 	void computeWizHistogram(uint32 *histogram, const uint8 *data, const Common::Rect& rCapt);
 	void computeRawWizHistogram(uint32 *histogram, const uint8 *data, int srcPitch, const Common::Rect& rCapt);
 
+	void flushWizCache(int resNum);
+
 private:
 	ScummEngine_v71he *_vm;
+
+	/**
+	 * An RLE compressed image state (compression types 1 and 5) decoded
+	 * into runs of opaque pixels. The pixels keep their on-disk format,
+	 * i.e. palette indices or little endian 16-bit colors, so that they
+	 * can be drawn with the same color writers as the RLE decoders use.
+	 */
+	struct DecodedImage {
+		struct Span {
+			uint16 start;
+			uint16 length;
+			uint32 offset;
+		};
+
+		int width;
+		int height;
+		uint8 pixelSize;
+		Common::Array<uint32> rows;	// first span of each row, plus one end marker
+		Common::Array<Span> spans;
+		Common::Array<uint8> pixels;
+	};
+
+	typedef Common::HashMap<int, DecodedImage> DecodedImageStates;
+	Common::HashMap<int, DecodedImageStates> _decodedImages;
+	uint32 _decodedImagesSize;
+
+	static const uint32 kDecodedImagesMaxSize = 4 * 1024 * 1024;
+
+	const DecodedImage *getDecodedImage(int resNum, int state, uint8 *dataPtr, uint32 comp, int width, int height);
+	bool drawDecodedImage(uint8 *dst, int resNum, uint8 *dataPtr, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int state, const Common::Rect *rect, int flags, const uint8 *palPtr, uint8 bitDepth, const uint8 *xmapPtr);
+	template<int type> static void drawDecodedSpan(uint8 *dst, int dstInc, int dstType, const uint8 *src, int count, uint8 pixelSize, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 };
 
+#ifdef SCUMMVM_SSE2
+void blendWizSpan16SSE2(uint8 *dst, const uint8 *src, int count);
+#endif
+#ifdef SCUMMVM_NEON
+void blendWizSpan16NEON(uint8 *dst, const uint8 *src, int count);
+#endif
+
 } // End of namespace Scumm
 
 #endif
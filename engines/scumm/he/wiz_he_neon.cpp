@@ -0,0 +1,52 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef ENABLE_HE
+
+#include <arm_neon.h>
+
+#include "common/endian.h"
+
+#include "scumm/scumm.h"
+#include "scumm/he/wiz_he.h"
+
+namespace Scumm {
+
+void blendWizSpan16NEON(uint8 *dst, const uint8 *src, int count) {
+	const uint16x8_t mask = vdupq_n_u16(0x7DEF);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const uint16x8_t s = vreinterpretq_u16_u8(vld1q_u8(src + i * 2));
+		const uint16x8_t d = vreinterpretq_u16_u8(vld1q_u8(dst + i * 2));
+		const uint16x8_t blend = vaddq_u16(vandq_u16(vshrq_n_u16(s, 1), mask), vandq_u16(vshrq_n_u16(d, 1), mask));
+		vst1q_u8(dst + i * 2, vreinterpretq_u8_u16(blend));
+	}
+	for (; i < count; i++) {
+		const uint16 srcColor = (READ_LE_UINT16(src + i * 2) >> 1) & 0x7DEF;
+		const uint16 dstColor = (READ_UINT16(dst + i * 2) >> 1) & 0x7DEF;
+		WRITE_UINT16(dst + i * 2, srcColor + dstColor);
+	}
+}
+
+} // End of namespace Scumm
+
+#endif // ENABLE_HE
@@ -0,0 +1,52 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef ENABLE_HE
+
+#include <emmintrin.h>
+
+#include "common/endian.h"
+
+#include "scumm/scumm.h"
+#include "scumm/he/wiz_he.h"
+
+namespace Scumm {
+
+void blendWizSpan16SSE2(uint8 *dst, const uint8 *src, int count) {
+	const __m128i mask = _mm_set1_epi16(0x7DEF);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)(src + i * 2));
+		const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i * 2));
+		const __m128i blend = _mm_add_epi16(_mm_and_si128(_mm_srli_epi16(s, 1), mask), _mm_and_si128(_mm_srli_epi16(d, 1), mask));
+		_mm_storeu_si128((__m128i *)(dst + i * 2), blend);
+	}
+	for (; i < count; i++) {
+		const uint16 srcColor = (READ_LE_UINT16(src + i * 2) >> 1) & 0x7DEF;
+		const uint16 dstColor = (READ_UINT16(dst + i * 2) >> 1) & 0x7DEF;
+		WRITE_UINT16(dst + i * 2, srcColor + dstColor);
+	}
+}
+
+} // End of namespace Scumm
+
+#endif // ENABLE_HE
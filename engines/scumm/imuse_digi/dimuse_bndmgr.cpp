@@ -21,6 +21,8 @@
 
 
 #include "common/scummsys.h"
+#include "common/config-manager.h"
+#include "common/system.h"
 #include "scumm/scumm.h"
 #include "scumm/util.h"
 #include "scumm/file.h"
@@ -37,15 +39,107 @@ BundleDirCache::BundleDirCache(const ScummEngine *vm) : _vm(vm) {
 		_bundleDirCache[fileId].isCompressed = false;
 		_bundleDirCache[fileId].indexTable = nullptr;
 	}
+	_blockCacheSize = 0;
+	resetBlockCacheStats();
 }
 
 BundleDirCache::~BundleDirCache() {
+	clearBlockCache();
 	for (int fileId = 0; fileId < ARRAYSIZE(_bundleDirCache); fileId++) {
 		free(_bundleDirCache[fileId].bundleTable);
 		free(_bundleDirCache[fileId].indexTable);
 	}
 }
 
+bool BundleDirCache::getBlock(int slot, int32 sample, int32 block, byte *dst, int32 &size) {
+	Common::StackLock lock(_blockMutex);
+
+	BlockKey key = { slot, sample, block };
+	BlockMap::iterator i = _blockMap.find(key);
+	if (i == _blockMap.end()) {
+		_blockStats.misses++;
+		return false;
+	}
+
+	_blockStats.hits++;
+	BlockList::iterator it = i->_value;
+	memcpy(dst, it->data, it->size);
+	size = it->size;
+	if (it != _blocks.begin()) {
+		_blocks.push_front(*it);
+		_blocks.erase(it);
+		i->_value = _blocks.begin();
+	}
+	return true;
+}
+
+void BundleDirCache::storeBlock(int slot, int32 sample, int32 block, const byte *src, int32 size) {
+	if (size <= 0 || (uint32)size > kBlockCacheBudget)
+		return;
+
+	Common::StackLock lock(_blockMutex);
+
+	BlockKey key = { slot, sample, block };
+	if (_blockMap.contains(key))
+		return;
+
+	shrinkBlockCache(kBlockCacheBudget - size);
+
+	CachedBlock entry;
+	entry.key = key;
+	entry.data = (byte *)malloc(size);
+	assert(entry.data);
+	memcpy(entry.data, src, size);
+	entry.size = size;
+	_blocks.push_front(entry);
+	_blockMap[key] = _blocks.begin();
+	_blockCacheSize += size;
+}
+
+void BundleDirCache::shrinkBlockCache(uint32 budget) {
+	while (_blockCacheSize > budget && !_blocks.empty()) {
+		CachedBlock &entry = _blocks.back();
+		_blockCacheSize -= entry.size;
+		_blockMap.erase(entry.key);
+		free(entry.data);
+		_blocks.pop_back();
+		_blockStats.evictions++;
+	}
+}
+
+void BundleDirCache::clearBlockCache() {
+	Common::StackLock lock(_blockMutex);
+
+	for (BlockList::iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+		free(it->data);
+	_blocks.clear();
+	_blockMap.clear();
+	_blockCacheSize = 0;
+}
+
+void BundleDirCache::resetBlockCacheStats() {
+	Common::StackLock lock(_blockMutex);
+
+	_blockStats.hits = 0;
+	_blockStats.misses = 0;
+	_blockStats.evictions = 0;
+}
+
+BundleDirCache::BlockCacheStats BundleDirCache::getBlockCacheStats() {
+	Common::StackLock lock(_blockMutex);
+	return _blockStats;
+}
+
+uint32 BundleDirCache::getBlockCacheSize() {
+	Common::StackLock lock(_blockMutex);
+	return _blockCacheSize;
+}
+
+uint BundleDirCache::getNumCachedBlocks() {
+	Common::StackLock lock(_blockMutex);
+	return _blockMap.size();
+}
+
 BundleDirCache::AudioTable *BundleDirCache::getTable(int slot) {
 	return _bundleDirCache[slot].bundleTable;
 }
@@ -146,16 +240,38 @@ BundleMgr::BundleMgr(const ScummEngine *vm, BundleDirCache *cache) {
 	_lastBlockDecompressedSize = 0;
 	_curSampleId = -1;
 	_fileBundleId = -1;
+	_bundleSlot = -1;
 	_file = new ScummFile(vm);
 	_compInputBuff = nullptr;
+
+	// Bundle blocks hold up to DIMUSE_BUN_CHUNK_SIZE bytes of decompressed
+	// audio; the lead time is converted assuming the highest rate that is
+	// streamed, 22050 Hz 16-bit stereo.
+	_jobSystem = g_system->getJobSystem();
+	_prefetchPending = false;
+	_prefetchSlots = 0;
+	if (_jobSystem->getWorkerCount() > 0) {
+		const int leadBytes = CLIP(ConfMan.getInt("dimuse_prefetch_ms"), 0, 10000) * (22050 * 4 / 1000);
+		_prefetchSlots = (leadBytes + DIMUSE_BUN_CHUNK_SIZE - 1) / DIMUSE_BUN_CHUNK_SIZE;
+	}
+	_prefetchBuff = nullptr;
+	_prefetchBlock = nullptr;
+	_prefetchSize = nullptr;
+	_prefetchSampleIndex = -1;
+	_prefetchFirst = _prefetchLast = 0;
 }
 
 BundleMgr::~BundleMgr() {
 	close();
 	delete _file;
+	free(_prefetchBuff);
+	free(_prefetchBlock);
+	free(_prefetchSize);
 }
 
 Common::SeekableReadStream *BundleMgr::getFile(const char *filename, int32 &offset, int32 &size) {
+	waitForPrefetch();
+
 	BundleDirCache::IndexNode target;
 	Common::strlcpy(target.filename, filename, sizeof(target.filename));
 	BundleDirCache::IndexNode *found = (BundleDirCache::IndexNode *)bsearch(&target, _indexTable, _numFiles,
@@ -185,6 +301,7 @@ bool BundleMgr::open(const char *filename, bool &isCompressed, bool errorFlag) {
 
 	int slot = _cache->matchFile(filename);
 	assert(slot != -1);
+	_bundleSlot = slot;
 	isCompressed = _cache->isSndDataExtComp(slot);
 	_numFiles = _cache->getNumFiles(slot);
 	assert(_numFiles);
@@ -202,6 +319,10 @@ bool BundleMgr::open(const char *filename, bool &isCompressed, bool errorFlag) {
 }
 
 void BundleMgr::close() {
+	waitForPrefetch();
+	for (int i = 0; i < _prefetchSlots && _prefetchBlock; i++)
+		_prefetchBlock[i] = -1;
+
 	if (_file->isOpen()) {
 		_file->close();
 		_bundleTable = nullptr;
@@ -257,6 +378,85 @@ bool BundleMgr::loadCompTable(int32 index) {
 	return true;
 }
 
+void BundleMgr::prefetchProc(void *refCon) {
+	((BundleMgr *)refCon)->prefetch();
+}
+
+void BundleMgr::prefetch() {
+	for (int i = _prefetchFirst; i < _prefetchLast; i++) {
+		const int slot = i % _prefetchSlots;
+		if (_prefetchBlock[slot] == i)
+			continue;
+
+		_prefetchBlock[slot] = -1;
+		byte *dst = _prefetchBuff + slot * DIMUSE_BUN_CHUNK_SIZE;
+		if (_cache->getBlock(_bundleSlot, _prefetchSampleIndex, i, dst, _prefetchSize[slot])) {
+			_prefetchBlock[slot] = i;
+			continue;
+		}
+
+		// CMI hack: one more zero byte at the end of input buffer
+		_compInputBuff[_compTable[i].size] = 0;
+		_file->seek(_bundleTable[_prefetchSampleIndex].offset + _compTable[i].offset, SEEK_SET);
+		_file->read(_compInputBuff, _compTable[i].size);
+
+		// Oversized blocks are left to readFile(), which errors out on them
+		const int32 outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, dst, _compTable[i].size);
+		if (outputSize > DIMUSE_BUN_CHUNK_SIZE)
+			break;
+		_prefetchBlock[slot] = i;
+		_prefetchSize[slot] = outputSize;
+		_cache->storeBlock(_bundleSlot, _prefetchSampleIndex, i, dst, outputSize);
+	}
+}
+
+void BundleMgr::requestPrefetch(int sampleIndex, int firstBlock) {
+	if (_prefetchSlots == 0 || _prefetchPending)
+		return;
+
+	const int lastBlock = MIN(firstBlock + _prefetchSlots, _numCompItems);
+	int block = firstBlock;
+	while (block < lastBlock && _prefetchBlock && _prefetchBlock[block % _prefetchSlots] == block)
+		block++;
+	if (block >= lastBlock)
+		return;
+
+	if (!_prefetchBuff) {
+		_prefetchBuff = (byte *)malloc(_prefetchSlots * DIMUSE_BUN_CHUNK_SIZE);
+		_prefetchBlock = (int32 *)malloc(_prefetchSlots * sizeof(int32));
+		_prefetchSize = (int32 *)malloc(_prefetchSlots * sizeof(int32));
+		assert(_prefetchBuff && _prefetchBlock && _prefetchSize);
+		for (int i = 0; i < _prefetchSlots; i++)
+			_prefetchBlock[i] = -1;
+	}
+
+	_prefetchSampleIndex = sampleIndex;
+	_prefetchFirst = block;
+	_prefetchLast = lastBlock;
+	_prefetchPending = true;
+	_jobSystem->submit(_prefetchGroup, prefetchProc, this);
+}
+
+void BundleMgr::waitForPrefetch() {
+	if (_prefetchPending) {
+		_jobSystem->wait(_prefetchGroup);
+		_prefetchPending = false;
+	}
+}
+
+bool BundleMgr::readPrefetchedBlock(int block) {
+	if (!_prefetchBlock)
+		return false;
+
+	const int slot = block % _prefetchSlots;
+	if (_prefetchBlock[slot] != block)
+		return false;
+
+	memcpy(_compOutputBuff, _prefetchBuff + slot * DIMUSE_BUN_CHUNK_SIZE, _prefetchSize[slot]);
+	_outputSize = _prefetchSize[slot];
+	return true;
+}
+
 int32 BundleMgr::seekFile(int32 offset, int mode) {
 	// We don't actually seek the file, but instead try to find that the specified offset exists
 	// within the decompressed blocks, and save that offset in _curDecompressedFilePos
@@ -314,6 +514,9 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 			return 0;
 		}
 
+		// Any read ahead job has to be done before _file is touched again
+		waitForPrefetch();
+
 		if (_curSampleId == -1)
 			_curSampleId = found->index;
 
@@ -349,7 +552,11 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 		skip = (_curDecompressedFilePos + headerSize) % DIMUSE_BUN_CHUNK_SIZE; // Excess length after the last block
 
 		for (i = firstBlock; i <= lastBlock; i++) {
-			if (_lastBlock != i) {
+			if (_lastBlock != i && readPrefetchedBlock(i)) {
+				_lastBlock = i;
+			} else if (_lastBlock != i && _cache->getBlock(_bundleSlot, found->index, i, _compOutputBuff, _outputSize)) {
+				_lastBlock = i;
+			} else if (_lastBlock != i) {
 				// CMI hack: one more zero byte at the end of input buffer
 				_compInputBuff[_compTable[i].size] = 0;
 				_file->seek(_bundleTable[found->index].offset + _compTable[i].offset, SEEK_SET);
@@ -359,6 +566,7 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 				if (_outputSize > DIMUSE_BUN_CHUNK_SIZE) {
 					error("_outputSize: %d", _outputSize);
 				}
+				_cache->storeBlock(_bundleSlot, found->index, i, _compOutputBuff, _outputSize);
 				_lastBlock = i;
 			}
 
@@ -391,6 +599,9 @@ int32 BundleMgr::readFile(const char *name, int32 size, byte **comp_final, bool
 		}
 		_curDecompressedFilePos += finalSize;
 
+		// Decompress the blocks needed next while the stream plays this one
+		requestPrefetch(found->index, _lastBlock + 1);
+
 		return finalSize;
 	}
 
@@ -24,6 +24,10 @@
 
 #include "common/scummsys.h"
 #include "common/file.h"
+#include "common/hashmap.h"
+#include "common/jobsystem.h"
+#include "common/list.h"
+#include "common/mutex.h"
 #include "scumm/imuse_digi/dimuse_defs.h"
 
 namespace Scumm {
@@ -43,6 +47,12 @@ public:
 		int32 index;
 	};
 
+	struct BlockCacheStats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+	};
+
 private:
 
 	struct FileDirCache {
@@ -54,6 +64,45 @@ private:
 	} _bundleDirCache[4];
 
 	const ScummEngine *_vm;
+
+	// Recently decompressed blocks, shared by every BundleMgr of the engine
+	// so that looping music and repeated speech are not decoded again.
+	// Accessed from the sound timer, the main thread and prefetch jobs.
+	struct BlockKey {
+		int slot;
+		int32 sample;
+		int32 block;
+
+		bool operator==(const BlockKey &other) const {
+			return slot == other.slot && sample == other.sample && block == other.block;
+		}
+	};
+
+	struct BlockKey_Hash {
+		uint operator()(const BlockKey &key) const {
+			return (key.slot * 0x9E3779B1) ^ (key.sample * 0x85EBCA77) ^ key.block;
+		}
+	};
+
+	struct CachedBlock {
+		BlockKey key;
+		byte *data;
+		int32 size;
+	};
+
+	typedef Common::List<CachedBlock> BlockList;
+	typedef Common::HashMap<BlockKey, BlockList::iterator, BlockKey_Hash> BlockMap;
+
+	static const uint32 kBlockCacheBudget = 2 * 1024 * 1024;
+
+	Common::Mutex _blockMutex;
+	BlockList _blocks;          // most recently used first
+	BlockMap _blockMap;
+	uint32 _blockCacheSize;
+	BlockCacheStats _blockStats;
+
+	void shrinkBlockCache(uint32 budget);
+
 public:
 	BundleDirCache(const ScummEngine *vm);
 	~BundleDirCache();
@@ -63,6 +112,14 @@ public:
 	IndexNode *getIndexTable(int slot);
 	int32 getNumFiles(int slot);
 	bool isSndDataExtComp(int slot);
+
+	bool getBlock(int slot, int32 sample, int32 block, byte *dst, int32 &size);
+	void storeBlock(int slot, int32 sample, int32 block, const byte *src, int32 size);
+	void clearBlockCache();
+	void resetBlockCacheStats();
+	BlockCacheStats getBlockCacheStats();
+	uint32 getBlockCacheSize();
+	uint getNumCachedBlocks();
 };
 
 class BundleMgr {
@@ -88,12 +145,31 @@ private:
 	bool _compTableLoaded;
 	bool _isUncompressed;
 	int _fileBundleId;
+	int _bundleSlot;
 	byte _compOutputBuff[0x2000];
 	byte *_compInputBuff;
 	int _outputSize;
 	int _lastBlock;
 	bool loadCompTable(int32 index);
 
+	// Blocks decompressed ahead of the read position on a job system
+	// worker. While a job is pending it owns _file and _compInputBuff.
+	Common::JobSystem *_jobSystem;
+	Common::JobGroup _prefetchGroup;
+	bool _prefetchPending;
+	int _prefetchSlots;      // number of blocks to read ahead, 0 if disabled
+	byte *_prefetchBuff;     // _prefetchSlots blocks of DIMUSE_BUN_CHUNK_SIZE bytes
+	int32 *_prefetchBlock;   // block held by each slot (block % _prefetchSlots), or -1
+	int32 *_prefetchSize;    // decompressed size of each slot's block
+	int _prefetchSampleIndex;
+	int _prefetchFirst, _prefetchLast;
+
+	static void prefetchProc(void *refCon);
+	void prefetch();
+	void requestPrefetch(int sampleIndex, int firstBlock);
+	void waitForPrefetch();
+	bool readPrefetchedBlock(int block);
+
 public:
 
 	BundleMgr(const ScummEngine *vm, BundleDirCache *_cache);
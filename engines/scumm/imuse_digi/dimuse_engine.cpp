@@ -1119,4 +1119,20 @@ void IMuseDigital::listGroups() {
 	_vm->getDebugger()->debugPrintf("\tMUSICEFF: %3d\n\n", _groupsHandler->getGroupVol(DIMUSE_GROUP_MUSICEFF));
 }
 
+void IMuseDigital::listBundleCache(bool reset) {
+	BundleDirCache *cache = _filesHandler->getSoundMgr()->getBundleDirCache();
+	BundleDirCache::BlockCacheStats stats = cache->getBlockCacheStats();
+
+	_vm->getDebugger()->debugPrintf("Decompressed bundle block cache:\n");
+	_vm->getDebugger()->debugPrintf("\tBlocks:    %u (%u KB)\n", cache->getNumCachedBlocks(), cache->getBlockCacheSize() / 1024);
+	_vm->getDebugger()->debugPrintf("\tHits:      %u\n", stats.hits);
+	_vm->getDebugger()->debugPrintf("\tMisses:    %u\n", stats.misses);
+	_vm->getDebugger()->debugPrintf("\tEvictions: %u\n\n", stats.evictions);
+
+	if (reset) {
+		cache->resetBlockCacheStats();
+		_vm->getDebugger()->debugPrintf("Statistics have been reset.\n\n");
+	}
+}
+
 } // End of namespace Scumm
@@ -68,6 +68,7 @@ public:
 	void setCurrentFtSpeechFile(const char *fileName, ScummFile *file, uint32 offset, uint32 size);
 	void closeSoundImmediatelyById(int soundId);
 	void saveLoad(Common::Serializer &ser);
+	ImuseDigiSndMgr *getSoundMgr() { return _sound; }
 };
 
 } // End of namespace Scumm
@@ -89,6 +89,7 @@ public:
 	SoundDesc *findSoundById(int soundId);
 	SoundDesc *getSounds();
 	void scheduleSoundForDeallocation(int soundId);
+	BundleDirCache *getBundleDirCache() { return _cacheBundleDir; }
 
 };
 
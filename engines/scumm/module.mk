@@ -139,6 +139,18 @@ MODULE_OBJS += \
 	gfxARM.o
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	gfx_neon.o
+$(MODULE)/gfx_neon.o: CXXFLAGS += $(NEON_CXXFLAGS)
+endif
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	gfx_sse2.o
+$(MODULE)/gfx_sse2.o: CXXFLAGS += -msse2
+endif
+
 ifdef ENABLE_HE
 MODULE_OBJS += \
 	he/animation_he.o \
@@ -173,6 +185,18 @@ MODULE_OBJS += \
 	he/moonbase/moonbase.o \
 	he/moonbase/moonbase_fow.o
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	he/wiz_he_neon.o
+$(MODULE)/he/wiz_he_neon.o: CXXFLAGS += $(NEON_CXXFLAGS)
+endif
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	he/wiz_he_sse2.o
+$(MODULE)/he/wiz_he_sse2.o: CXXFLAGS += -msse2
+endif
+
 ifdef USE_ENET
 MODULE_OBJS += \
 	dialog-createsession.o \
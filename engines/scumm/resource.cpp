@@ -27,6 +27,7 @@
 #include "common/config-manager.h"
 #endif
 
+#include "scumm/base-costume.h"
 #include "scumm/charset.h"
 #include "scumm/dialogs.h"
 #include "scumm/file.h"
@@ -866,6 +867,7 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 	}
 
 	_allocatedSize += size;
+	_memoryCounter.add(size);
 
 	_types[type][idx]._address = ptr;
 	_types[type][idx]._size = size;
@@ -906,7 +908,7 @@ ResourceManager::ResTypeData::ResTypeData() {
 ResourceManager::ResTypeData::~ResTypeData() {
 }
 
-ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
+ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm), _memoryCounter("SCUMM resources") {
 	_allocatedSize = 0;
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
@@ -937,7 +939,15 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 	if (ptr != nullptr) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
 		_allocatedSize -= _types[type][idx]._size;
+		_memoryCounter.remove(_types[type][idx]._size);
 		_types[type][idx].nuke();
+
+		if (type == rtCostume && _vm->_costumeRenderer)
+			_vm->_costumeRenderer->flushCostumeCache(idx);
+		else if (type == rtMatrix)
+			_vm->invalidateBoxCache();
+		else if (type == rtImage)
+			_vm->flushWizCache(idx);
 	}
 }
 
@@ -1031,6 +1041,9 @@ void ResourceManager::setModified(ResType type, ResId idx) {
 	if (!validateResource("Modified", type, idx))
 		return;
 	_types[type][idx].setModified();
+
+	if (type == rtImage)
+		_vm->flushWizCache(idx);
 }
 
 void ResourceManager::setOffHeap(ResType type, ResId idx) {
@@ -23,6 +23,7 @@
 #define SCUMM_RESOURCE_H
 
 #include "common/array.h"
+#include "common/memusage.h"
 #include "scumm/scumm.h"	// for ResType
 
 namespace Scumm {
@@ -172,6 +173,7 @@ public:
 
 protected:
 	uint32 _allocatedSize;
+	Common::MemoryCounter _memoryCounter; ///< Reports _allocatedSize to the mem_usage command
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
 
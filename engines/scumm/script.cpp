@@ -331,6 +331,9 @@ void ScummEngine::runScriptNested(int script) {
 
 	vm.numNestedScripts++;
 
+	if (_scriptProfile.enabled)
+		_scriptProfile.scripts[getScriptProfileKey(vm.slot[script])].runs++;
+
 	_currentScript = script;
 	getScriptBaseAddress();
 	resetScriptPointer();
@@ -482,7 +485,10 @@ void ScummEngine::executeScript() {
 			debugN("\n");
 		}
 
-		executeOpcode(_opcode);
+		if (_scriptProfile.enabled)
+			executeOpcodeProfiled(_opcode);
+		else
+			executeOpcode(_opcode);
 
 	}
 }
@@ -495,6 +501,39 @@ void ScummEngine::executeOpcode(byte i) {
 	}
 }
 
+uint32 ScummEngine::getScriptProfileKey(const ScriptSlot &slot) const {
+	const bool roomScript = (slot.where == WIO_LOCAL || slot.where == WIO_ROOM);
+	return ScriptProfile::makeKey(slot.where, slot.number, roomScript ? _roomResource : 0);
+}
+
+void ScummEngine::executeOpcodeProfiled(byte i) {
+	// The opcode may start scripts which run nested, or stop the current
+	// one, so the script it belongs to is looked up beforehand.
+	const uint32 key = getScriptProfileKey(vm.slot[_currentScript]);
+	const uint64 nestedBase = _scriptProfile.elapsedMicros;
+	const uint64 start = _system->getMicros();
+
+	executeOpcode(i);
+
+	const uint64 elapsed = _system->getMicros() - start;
+	if (!_scriptProfile.enabled)
+		return;
+
+	// Every opcode adds its inclusive time on top of the value it found,
+	// replacing what its nested opcodes added. The difference is therefore
+	// the time of the scripts this opcode ran nested.
+	const uint64 nested = (_scriptProfile.elapsedMicros > nestedBase) ? _scriptProfile.elapsedMicros - nestedBase : 0;
+	const uint64 self = (elapsed > nested) ? elapsed - nested : 0;
+	_scriptProfile.elapsedMicros = nestedBase + elapsed;
+
+	_scriptProfile.opcodeCount[i]++;
+	_scriptProfile.opcodeMicros[i] += self;
+
+	ScriptProfile::ScriptStats &stats = _scriptProfile.scripts[key];
+	stats.opcodes++;
+	stats.micros += self;
+}
+
 const char *ScummEngine::getOpcodeDesc(byte i) {
 #ifndef REDUCE_MEMORY_USAGE
 	return _opcodes[i].desc;
@@ -23,6 +23,7 @@
 #define SCUMM_SCRIPT_H
 
 #include "common/func.h"
+#include "common/hashmap.h"
 
 namespace Scumm {
 
@@ -103,6 +104,41 @@ struct NestedScript {
 	uint8 slot;
 };
 
+/**
+ * Opcode and script execution statistics, collected while enabled through
+ * the "profile" debugger command. Times are exclusive: the time spent in a
+ * script started from an opcode is accounted to the opcodes of that script.
+ */
+struct ScriptProfile {
+	struct ScriptStats {
+		uint32 runs;
+		uint32 opcodes;
+		uint64 micros;
+	};
+
+	typedef Common::HashMap<uint32, ScriptStats> ScriptStatsMap;
+
+	bool enabled;
+	uint32 opcodeCount[256];
+	uint64 opcodeMicros[256];
+	ScriptStatsMap scripts;
+	uint64 elapsedMicros;	// inclusive time of all completed opcodes, see executeOpcodeProfiled()
+
+	ScriptProfile() : enabled(false) { reset(); }
+
+	void reset() {
+		memset(opcodeCount, 0, sizeof(opcodeCount));
+		memset(opcodeMicros, 0, sizeof(opcodeMicros));
+		scripts.clear();
+		elapsedMicros = 0;
+	}
+
+	/** Room is only set for scripts whose number is unique within a room. */
+	static uint32 makeKey(byte where, uint16 number, int room) {
+		return (where << 28) | ((room & 0xFFF) << 16) | number;
+	}
+};
+
 enum {
 	/**
 	 * The maximal number of cutscenes that can be active
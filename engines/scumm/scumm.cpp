@@ -39,6 +39,7 @@
 #include "graphics/macgui/macfontmanager.h"
 
 #include "scumm/akos.h"
+#include "scumm/boxes.h"
 #include "scumm/charset.h"
 #include "scumm/costume.h"
 #include "scumm/debugger.h"
@@ -492,6 +493,7 @@ ScummEngine::~ScummEngine() {
 #endif
 
 	delete _res;
+	delete _boxCache;
 	delete _gdi;
 }
 
@@ -1562,6 +1564,10 @@ void ScummEngine_v7::setupScumm(const Common::Path &macResourceFile) {
 
 	ScummEngine::setupScumm(macResourceFile);
 
+	// Read by the bundle managers when they are created, including the one
+	// used for the check below
+	ConfMan.registerDefault("dimuse_prefetch_ms", 500);
+
 	// Check if we are dealing with old resource files compressed with the ScummVM tools
 	bool filesAreCompressed = false;
 
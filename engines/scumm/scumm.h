@@ -101,6 +101,7 @@ class Localizer;
 class GlyphRenderer_v7;
 
 struct Box;
+struct BoxCache;
 struct BoxCoords;
 struct FindObjectInRoom;
 
@@ -564,6 +565,7 @@ public:
 
 protected:
 	VirtualMachineState vm;
+	ScriptProfile _scriptProfile;
 
 	bool _oldSoundsPaused = false;
 
@@ -985,6 +987,8 @@ protected:
 
 	virtual void setupOpcodes() = 0;
 	void executeOpcode(byte i);
+	void executeOpcodeProfiled(byte i);
+	uint32 getScriptProfileKey(const ScriptSlot &slot) const;
 	const char *getOpcodeDesc(byte i);
 
 	void initializeLocals(int slot, int *vars);
@@ -1096,6 +1100,9 @@ public:
 	byte *getStringAddressVar(int i);
 	void ensureResourceLoaded(ResType type, ResId idx);
 
+	/** Drop anything decoded from image resource 'idx', see Wiz::flushWizCache(). */
+	virtual void flushWizCache(ResId idx) {}
+
 protected:
 	Common::Mutex _resourceAccessMutex; // Used in getResourceSize(), getResourceAddress() and findResource()
 										// to avoid race conditions between the audio thread of Digital iMUSE
@@ -1237,6 +1244,8 @@ protected:
 	void playActorSounds();
 	void redrawAllActors();
 	void setActorRedrawFlags();
+	void setChangedActorRedrawFlags();
+	uint32 getActorDrawSeed() const;
 	void putActors();
 	void showActors();
 	void resetV1ActorTalkColor();
@@ -1488,6 +1497,7 @@ protected:
 public:
 	byte _roomPalette[256];
 	byte *_shadowPalette = nullptr;
+	uint32 _actorDrawSeed = 0;
 	bool _skipDrawObject = 0;
 	int _voiceMode = 0;
 
@@ -1538,6 +1548,7 @@ public:
 
 	byte getNumBoxes();
 	byte *getBoxMatrixBaseAddr();
+	void invalidateBoxCache();
 	byte *getBoxConnectionBase(int box);
 
 	int getNextBox(byte from, byte to);
@@ -1573,6 +1584,12 @@ protected:
 	void createBoxMatrix();
 	virtual bool areBoxesNeighbors(int i, int j);
 
+	// Decoded walkbox data, see BoxCache in boxes.h
+	BoxCache *_boxCache = nullptr;
+	BoxCache *getBoxCache();
+	BoxCoords decodeBoxCoordinates(int boxnum);
+	void decodeNextBoxMatrix(const byte *boxm, int numOfBoxes);
+
 	/* String class */
 public:
 	CharsetRenderer *_charset = nullptr;
@@ -234,29 +234,9 @@ void SmushDeltaBlocksDecoder::makeTable(int pitch, int index) {
 	}
 }
 
-#if defined(SCUMM_NEED_ALIGNMENT)
-
-#define DECLARE_LITERAL_TEMP(v) \
-	byte v
-
-#define READ_LITERAL_PIXEL(src, v) \
-	v = *src++
-
-#define WRITE_4X1_LINE(dst, v)  \
-	do {                        \
-		int j;                  \
-		for (j = 0; j < 4; j++) \
-			(dst)[j] = v;       \
-	} while (0)
-
-#define COPY_4X1_LINE(dst, src)  \
-	do {                         \
-		int j;                   \
-		for (j = 0; j < 4; j++)  \
-			(dst)[j] = (src)[j]; \
-	} while (0)
-
-#else /* SCUMM_NEED_ALIGNMENT */
+// READ_UINT32() and WRITE_UINT32() map to single unaligned loads and stores
+// wherever the compiler can express them, and to bytewise accesses on the
+// remaining platforms which need aligned memory accesses.
 
 #define DECLARE_LITERAL_TEMP(v) \
 	uint32 v
@@ -268,12 +248,10 @@ void SmushDeltaBlocksDecoder::makeTable(int pitch, int index) {
 	} while (0)
 
 #define WRITE_4X1_LINE(dst, v) \
-	*(uint32 *)(dst) = v
-
-#define COPY_4X1_LINE(dst, src)               \
-	*(uint32 *)(dst) = *(const uint32 *)(src)
+	WRITE_UINT32(dst, v)
 
-#endif /* SCUMM_NEED_ALIGNMENT */
+#define COPY_4X1_LINE(dst, src) \
+	WRITE_UINT32(dst, READ_UINT32(src))
 
 /* Fill a 4x4 pixel block with a literal pixel value */
 
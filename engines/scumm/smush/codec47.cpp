@@ -28,32 +28,21 @@
 
 namespace Scumm {
 
-#if defined(SCUMM_NEED_ALIGNMENT)
+// READ_UINT*() and WRITE_UINT*() map to single unaligned loads and stores
+// wherever the compiler can express them, and to bytewise accesses on the
+// remaining platforms which need aligned memory accesses.
+
+#define COPY_8X1_LINE(dst, src) \
+	WRITE_UINT64(dst, READ_UINT64(src))
 
 #define COPY_4X1_LINE(dst, src) \
-	do {                        \
-		(dst)[0] = (src)[0];    \
-		(dst)[1] = (src)[1];    \
-		(dst)[2] = (src)[2];    \
-		(dst)[3] = (src)[3];    \
-	} while (0)
+	WRITE_UINT32(dst, READ_UINT32(src))
 
 #define COPY_2X1_LINE(dst, src) \
-	do {                        \
-		(dst)[0] = (src)[0];    \
-		(dst)[1] = (src)[1];    \
-	} while (0)
-
+	WRITE_UINT16(dst, READ_UINT16(src))
 
-#else /* SCUMM_NEED_ALIGNMENT */
-
-#define COPY_4X1_LINE(dst, src)               \
-	*(uint32 *)(dst) = *(const uint32 *)(src)
-
-#define COPY_2X1_LINE(dst, src)               \
-	*(uint16 *)(dst) = *(const uint16 *)(src)
-
-#endif
+#define FILL_8X1_LINE(dst, val) \
+	WRITE_UINT64(dst, (uint64)(val) * 0x0101010101010101ULL)
 
 #define FILL_4X1_LINE(dst, val) \
 	do {                        \
@@ -463,8 +452,7 @@ void SmushDeltaGlyphsDecoder::level1(byte *d_dst) {
 	if (code < MOTION_OFFSET_TABLE_SIZE) {
 		tmp = _table[code] + _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp);
 			d_dst += _dPitch;
 		}
 	} else if (code == PROCESS_SUBBLOCKS) {
@@ -478,8 +466,7 @@ void SmushDeltaGlyphsDecoder::level1(byte *d_dst) {
 	} else if (code == FILL_SINGLE_COLOR) {
 		byte t = *_dSrc++;
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _dPitch;
 		}
 	} else if (code == DRAW_GLYPH) {
@@ -502,15 +489,13 @@ void SmushDeltaGlyphsDecoder::level1(byte *d_dst) {
 	} else if (code == COPY_PREV_BUFFER) {
 		tmp = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp);
 			d_dst += _dPitch;
 		}
 	} else {
 		byte t = _paramPtr[code];
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _dPitch;
 		}
 	}
@@ -90,12 +90,14 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 	_shader->setUniform("modelViewMatrix", modelViewMatrix);
 	_shader->setUniform("projectionMatrix", projectionMatrix);
 	_shader->setUniform("normalMatrix", normalMatrix.getRotation());
-	setBoneRotationArrayUniform(_shader, "boneRotation");
-	setBonePositionArrayUniform(_shader, "bonePosition");
+	// The vertices are skinned by the shaders, only the bone
+	// transforms have to be sent each frame
+	packBoneTransforms();
+	setBoneArrayUniforms(_shader);
 	setLightArrayUniform(lights);
 
-	Common::Array<Face *> faces = _model->getFaces();
-	Common::Array<Material *> mats = _model->getMaterials();
+	const Common::Array<Face *> &faces = _model->getFaces();
+	const Common::Array<Material *> &mats = _model->getMaterials();
 
 	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
 		// For each face draw its vertices from the VBO, indexed by the EBO
@@ -134,8 +136,7 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 		mvp.transpose();
 		_shadowShader->setUniform("mvp", mvp);
 
-		setBoneRotationArrayUniform(_shadowShader, "boneRotation");
-		setBonePositionArrayUniform(_shadowShader, "bonePosition");
+		setBoneArrayUniforms(_shadowShader);
 
 		Math::Matrix4 modelInverse = model;
 		modelInverse.inverse();
@@ -213,51 +214,69 @@ GLuint OpenGLSActorRenderer::createFaceEBO(const Face *face) {
 	return OpenGL::Shader::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * face->vertexIndices.size(), &face->vertexIndices[0]);
 }
 
-void OpenGLSActorRenderer::setBonePositionArrayUniform(OpenGL::Shader *shader, const char *uniform) {
+void OpenGLSActorRenderer::packBoneTransforms() {
 	const Common::Array<BoneNode *> &bones = _model->getBones();
 
-	GLint pos = shader->getUniformLocation(uniform);
-	if (pos == -1) {
-		error("No uniform named '%s'", uniform);
-	}
-
-	float *positions = new float[3 * bones.size()];
-	float *positionsPtr = positions;
+	// The arrays keep their storage from one frame to the next
+	_bonePositions.resize(3 * bones.size());
+	_boneRotations.resize(4 * bones.size());
 
+	float *positionsPtr = _bonePositions.data();
+	float *rotationsPtr = _boneRotations.data();
 	for (uint i = 0; i < bones.size(); i++) {
 		*positionsPtr++ = bones[i]->_animPos.x();
 		*positionsPtr++ = bones[i]->_animPos.y();
 		*positionsPtr++ = bones[i]->_animPos.z();
-	}
 
-	glUniform3fv(pos, bones.size(), positions);
-	delete[] positions;
+		*rotationsPtr++ = bones[i]->_animRot.x();
+		*rotationsPtr++ = bones[i]->_animRot.y();
+		*rotationsPtr++ = bones[i]->_animRot.z();
+		*rotationsPtr++ = bones[i]->_animRot.w();
+	}
 }
 
-void OpenGLSActorRenderer::setBoneRotationArrayUniform(OpenGL::Shader *shader, const char *uniform) {
-	const Common::Array<BoneNode *> &bones = _model->getBones();
+void OpenGLSActorRenderer::setBoneArrayUniforms(OpenGL::Shader *shader) {
+	GLint pos = shader->getUniformLocation("bonePosition");
+	if (pos == -1) {
+		error("No uniform named 'bonePosition'");
+	}
 
-	GLint rot = shader->getUniformLocation(uniform);
+	GLint rot = shader->getUniformLocation("boneRotation");
 	if (rot == -1) {
-		error("No uniform named '%s'", uniform);
+		error("No uniform named 'boneRotation'");
 	}
 
-	float *rotations = new float[4 * bones.size()];
-	float *rotationsPtr = rotations;
+	uint boneCount = _bonePositions.size() / 3;
+	glUniform3fv(pos, boneCount, _bonePositions.data());
+	glUniform4fv(rot, boneCount, _boneRotations.data());
+}
 
-	for (uint i = 0; i < bones.size(); i++) {
-		*rotationsPtr++ =  bones[i]->_animRot.x();
-		*rotationsPtr++ =  bones[i]->_animRot.y();
-		*rotationsPtr++ =  bones[i]->_animRot.z();
-		*rotationsPtr++ =  bones[i]->_animRot.w();
+namespace {
+
+/** Names of the light uniforms, built once instead of every frame */
+struct LightUniformNames {
+	static const uint maxLights = 10;
+
+	Common::String position[maxLights];
+	Common::String direction[maxLights];
+	Common::String color[maxLights];
+	Common::String params[maxLights];
+
+	LightUniformNames() {
+		for (uint i = 0; i < maxLights; i++) {
+			position[i] = Common::String::format("lights[%d].position", i);
+			direction[i] = Common::String::format("lights[%d].direction", i);
+			color[i] = Common::String::format("lights[%d].color", i);
+			params[i] = Common::String::format("lights[%d].params", i);
+		}
 	}
+};
 
-	glUniform4fv(rot, bones.size(), rotations);
-	delete[] rotations;
-}
+} // End of anonymous namespace
 
 void OpenGLSActorRenderer::setLightArrayUniform(const LightEntryArray &lights) {
-	static const uint maxLights = 10;
+	static const LightUniformNames names;
+	static const uint maxLights = LightUniformNames::maxLights;
 
 	assert(lights.size() >= 1);
 	assert(lights.size() <= maxLights);
@@ -287,9 +306,9 @@ void OpenGLSActorRenderer::setLightArrayUniform(const LightEntryArray &lights) {
 		Math::Vector3d eyeDirection = viewMatrixRot * worldDirection;
 		eyeDirection.normalize();
 
-		_shader->setUniform(Common::String::format("lights[%d].position", i).c_str(), eyePosition);
-		_shader->setUniform(Common::String::format("lights[%d].direction", i).c_str(), eyeDirection);
-		_shader->setUniform(Common::String::format("lights[%d].color", i).c_str(), l->color);
+		_shader->setUniform(names.position[i].c_str(), eyePosition);
+		_shader->setUniform(names.direction[i].c_str(), eyeDirection);
+		_shader->setUniform(names.color[i].c_str(), l->color);
 
 		Math::Vector4d params;
 		params.x() = l->falloffNear;
@@ -297,12 +316,12 @@ void OpenGLSActorRenderer::setLightArrayUniform(const LightEntryArray &lights) {
 		params.z() = l->innerConeAngle.getCosine();
 		params.w() = l->outerConeAngle.getCosine();
 
-		_shader->setUniform(Common::String::format("lights[%d].params", i).c_str(), params);
+		_shader->setUniform(names.params[i].c_str(), params);
 	}
 
 	for (uint i = lights.size() - 1; i < maxLights; i++) {
 		// Make sure unused lights are disabled
-		_shader->setUniform(Common::String::format("lights[%d].position", i).c_str(), Math::Vector4d());
+		_shader->setUniform(names.position[i].c_str(), Math::Vector4d());
 	}
 }
 
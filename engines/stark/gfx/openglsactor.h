@@ -25,6 +25,7 @@
 #include "engines/stark/gfx/renderentry.h"
 #include "engines/stark/visual/actor.h"
 
+#include "common/array.h"
 #include "common/hashmap.h"
 #include "common/hash-ptr.h"
 
@@ -57,12 +58,16 @@ protected:
 	GLuint _faceVBO;
 	FaceBufferMap _faceEBO;
 
+	// Bone transforms of the current frame, as sent to the shaders
+	Common::Array<float> _bonePositions;
+	Common::Array<float> _boneRotations;
+
 	void clearVertices();
 	void uploadVertices();
 	GLuint createModelVBO(const Model *model);
 	GLuint createFaceEBO(const Face *face);
-	void setBonePositionArrayUniform(OpenGL::Shader *shader, const char *uniform);
-	void setBoneRotationArrayUniform(OpenGL::Shader *shader, const char *uniform);
+	void packBoneTransforms();
+	void setBoneArrayUniforms(OpenGL::Shader *shader);
 	void setLightArrayUniform(const LightEntryArray &lights);
 
 	void setShadowUniform(const LightEntryArray &lights, const Math::Vector3d &actorPosition, Math::Matrix3 worldToModelRot);
@@ -212,21 +212,21 @@ void ImageStill::initVisual() {
 		return; // No file to load
 	}
 
-	Common::ReadStream *xmgStream = StarkArchiveLoader->getFile(_filename, _archiveName);
+	ArchiveReadStream *xmgStream = StarkArchiveLoader->getFile(_filename, _archiveName);
 
 	VisualImageXMG *visual = new VisualImageXMG(StarkGfx);
 
 	if (StarkSettings->isAssetsModEnabled() && StarkGfx->supportsModdedAssets() && loadPNGOverride(visual)) {
 		visual->readOriginalSize(xmgStream);
+		delete xmgStream;
 	} else {
-		visual->load(xmgStream);
+		// May be decoded in the background while the archive is being loaded
+		StarkArchiveLoader->loadImage(visual, xmgStream);
 	}
 
 	visual->setHotSpot(_hotspot);
 
 	_visual = visual;
-
-	delete xmgStream;
 }
 
 bool ImageStill::loadPNGOverride(VisualImageXMG *visual) const {
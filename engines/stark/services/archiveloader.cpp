@@ -24,6 +24,9 @@
 #include "engines/stark/formats/xrc.h"
 #include "engines/stark/resources/level.h"
 #include "engines/stark/resources/location.h"
+#include "engines/stark/visual/image.h"
+
+#include "common/system.h"
 
 namespace Stark {
 
@@ -48,6 +51,10 @@ void ArchiveLoader::LoadedArchive::importResources() {
 	_root = Formats::XRCReader::importTree(&_xarc);
 }
 
+ArchiveLoader::ArchiveLoader() :
+		_importing(false) {
+}
+
 ArchiveLoader::~ArchiveLoader() {
 	for (LoadedArchiveList::iterator it = _archives.begin(); it != _archives.end(); it++) {
 		delete *it;
@@ -63,11 +70,56 @@ bool ArchiveLoader::load(const Common::Path &archiveName) {
 	LoadedArchive *archive = new LoadedArchive(archiveName);
 	_archives.push_back(archive);
 
+	_importing = true;
 	archive->importResources();
+	_importing = false;
+
+	finishImageDecoding();
 
 	return true;
 }
 
+void ArchiveLoader::loadImage(VisualImageXMG *visual, ArchiveReadStream *stream) {
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (!_importing || jobSystem->getWorkerCount() == 0) {
+		visual->load(stream);
+		delete stream;
+		return;
+	}
+
+	// Only the decoding is done by the job, the archive file
+	// is read from here
+	ImageDecodeJob *job = new ImageDecodeJob();
+	job->visual = visual;
+	job->stream = stream->readStream(stream->size());
+	delete stream;
+
+	_imageJobs.push_back(job);
+	jobSystem->submit(_imageJobGroup, decodeImageProc, job);
+}
+
+void ArchiveLoader::decodeImageProc(void *refCon) {
+	ImageDecodeJob *job = (ImageDecodeJob *)refCon;
+	job->visual->decode(job->stream);
+}
+
+void ArchiveLoader::finishImageDecoding() {
+	if (_imageJobs.empty()) {
+		return;
+	}
+
+	g_system->getJobSystem()->wait(_imageJobGroup);
+
+	// The renderer can only be used from the main thread
+	for (uint i = 0; i < _imageJobs.size(); i++) {
+		_imageJobs[i]->visual->createBitmap();
+		delete _imageJobs[i]->stream;
+		delete _imageJobs[i];
+	}
+
+	_imageJobs.clear();
+}
+
 void ArchiveLoader::unloadUnused() {
 	for (LoadedArchiveList::iterator it = _archives.begin(); it != _archives.end(); it++) {
 		if (!(*it)->isInUse()) {
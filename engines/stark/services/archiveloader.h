@@ -22,6 +22,7 @@
 #ifndef STARK_SERVICES_ARCHIVE_LOADER_H
 #define STARK_SERVICES_ARCHIVE_LOADER_H
 
+#include "common/jobsystem.h"
 #include "common/list.h"
 #include "common/str.h"
 #include "common/substream.h"
@@ -40,6 +41,8 @@ class Level;
 class Location;
 }
 
+class VisualImageXMG;
+
 /**
  * A read stream with helper functions to read usual data types
  */
@@ -64,6 +67,7 @@ public:
 class ArchiveLoader {
 
 public:
+	ArchiveLoader();
 	~ArchiveLoader();
 
 	/** Load a Xarc archive, and add it to the managed archives list */
@@ -89,6 +93,15 @@ public:
 	Common::SeekableReadStream *getExternalFile(const Common::Path &fileName, const Common::Path &archiveName) const;
 	Common::Path getExternalFilePath(const Common::Path &fileName, const Common::Path &archiveName) const;
 
+	/**
+	 * Load a XMG image, and take ownership of the stream
+	 *
+	 * While an archive is being loaded, the image is decoded on a worker
+	 * thread, and its bitmap is created once all the resources of the
+	 * archive have been read.
+	 */
+	void loadImage(VisualImageXMG *visual, ArchiveReadStream *stream);
+
 private:
 	class LoadedArchive {
 	public:
@@ -114,10 +127,24 @@ private:
 
 	typedef Common::List<LoadedArchive *> LoadedArchiveList;
 
+	struct ImageDecodeJob {
+		VisualImageXMG *visual;
+		Common::SeekableReadStream *stream;
+	};
+
 	bool hasArchive(const Common::Path &archiveName) const;
 	LoadedArchive *findArchive(const Common::Path &archiveName) const;
 
+	static void decodeImageProc(void *refCon);
+
+	/** Wait for the image decoding jobs and create the bitmaps of the images */
+	void finishImageDecoding();
+
 	LoadedArchiveList _archives;
+
+	bool _importing;
+	Common::JobGroup _imageJobGroup;
+	Common::Array<ImageDecodeJob *> _imageJobs;
 };
 
 template <class T>
@@ -57,17 +57,27 @@ void VisualImageXMG::setHotSpot(const Common::Point &hotspot) {
 }
 
 void VisualImageXMG::load(Common::ReadStream *stream) {
+	decode(stream);
+	createBitmap();
+}
+
+void VisualImageXMG::decode(Common::ReadStream *stream) {
 	assert(!_surface && !_bitmap);
 
 	// Decode the XMG
 	_surface = Formats::XMGDecoder::decode(stream);
-	_bitmap = _gfx->createBitmap(_surface);
-	_bitmap->setSamplingFilter(StarkSettings->getImageSamplingFilter());
 
 	_originalWidth  = _surface->w;
 	_originalHeight = _surface->h;
 }
 
+void VisualImageXMG::createBitmap() {
+	assert(_surface && !_bitmap);
+
+	_bitmap = _gfx->createBitmap(_surface);
+	_bitmap->setSamplingFilter(StarkSettings->getImageSamplingFilter());
+}
+
 void VisualImageXMG::readOriginalSize(Common::ReadStream *stream) {
 	Formats::XMGDecoder::readSize(stream, _originalWidth, _originalHeight);
 }
@@ -77,21 +87,18 @@ bool VisualImageXMG::loadPNG(Common::SeekableReadStream *stream) {
 
 	// Decode the XMG
 	Image::PNGDecoder pngDecoder;
+	pngDecoder.setOutputPixelFormat(Gfx::Driver::getRGBAPixelFormat());
 	if (!pngDecoder.loadStream(*stream)) {
 		return false;
 	}
 
-	if (pngDecoder.getPalette()) {
-		warning("Indexed colors PNG images are not supported");
-		return false;
-	}
-
 	if (StarkSettings->shouldPreMultiplyReplacementPNGs()) {
 		// We can do alpha pre-multiplication when loading for
 		// convenience when testing modded graphics.
 		_surface = multiplyColorWithAlpha(pngDecoder.getSurface());
 	} else {
-		_surface = pngDecoder.getSurface()->convertTo(Gfx::Driver::getRGBAPixelFormat());
+		_surface = new Graphics::Surface();
+		_surface->copyFrom(*pngDecoder.getSurface());
 	}
 
 	_bitmap = _gfx->createBitmap(_surface);
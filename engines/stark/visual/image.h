@@ -54,6 +54,18 @@ public:
 	 */
 	void load(Common::ReadStream *stream);
 
+	/**
+	 * Decode the pixel data from a XMG image, without creating the bitmap
+	 *
+	 * Does not use the renderer, so can be called from a worker thread.
+	 * createBitmap must be called from the main thread before the image
+	 * can be rendered.
+	 */
+	void decode(Common::ReadStream *stream);
+
+	/** Create the bitmap used for rendering from the decoded pixel data */
+	void createBitmap();
+
 	/**
 	 * Load the size from an XMG image
 	 */
@@ -46,15 +46,20 @@ namespace Sword25 {
 
 void RenderObjectQueue::add(RenderObject *renderObject) {
 	push_back(RenderObjectQueueItem(renderObject, renderObject->getBbox(), renderObject->getVersion()));
+	if (!_items.contains(renderObject))
+		_items[renderObject] = &back();
 }
 
-bool RenderObjectQueue::exists(const RenderObjectQueueItem &renderObjectQueueItem) {
-	for (RenderObjectQueue::iterator it = begin(); it != end(); ++it)
-		if ((*it)._renderObject == renderObjectQueueItem._renderObject &&
-			(*it)._version == renderObjectQueueItem._version &&
-			(*it)._bbox == renderObjectQueueItem._bbox)
-			return true;
-	return false;
+void RenderObjectQueue::clear() {
+	Common::List<RenderObjectQueueItem>::clear();
+	_items.clear();
+}
+
+bool RenderObjectQueue::exists(const RenderObjectQueueItem &renderObjectQueueItem) const {
+	Common::HashMap<RenderObject *, const RenderObjectQueueItem *>::const_iterator it = _items.find(renderObjectQueueItem._renderObject);
+	return it != _items.end() &&
+		it->_value->_version == renderObjectQueueItem._version &&
+		it->_value->_bbox == renderObjectQueueItem._bbox;
 }
 
 RenderObjectManager::RenderObjectManager(int width, int height, int framebufferCount) :
@@ -41,6 +41,8 @@
 #ifndef SWORD25_RENDEROBJECTMANAGER_H
 #define SWORD25_RENDEROBJECTMANAGER_H
 
+#include "common/hashmap.h"
+#include "common/hash-ptr.h"
 #include "common/rect.h"
 #include "sword25/kernel/common.h"
 #include "sword25/gfx/renderobjectptr.h"
@@ -64,9 +66,14 @@ struct RenderObjectQueueItem {
 };
 
 class RenderObjectQueue : public Common::List<RenderObjectQueueItem> {
+private:
+	// The items by their object, so that the queues of two frames can be compared
+	// without going through the whole queue for every object
+	Common::HashMap<RenderObject *, const RenderObjectQueueItem *> _items;
 public:
 	void add(RenderObject *renderObject);
-	bool exists(const RenderObjectQueueItem &renderObjectQueueItem);
+	void clear();
+	bool exists(const RenderObjectQueueItem &renderObjectQueueItem) const;
 };
 
 /**
@@ -91,10 +91,20 @@ Common::String PackageManager::ensureSpeechLang(const Common::String &fileName)
 	return newFileName;
 }
 
+Common::ArchiveMemberPtr PackageManager::getArchiveMember(const Common::String &fileName) {
+	MemberCache::const_iterator cached = _memberCache.find(fileName);
+	if (cached != _memberCache.end())
+		return cached->_value;
+
+	Common::ArchiveMemberPtr member = findArchiveMember(fileName);
+	_memberCache[fileName] = member;
+	return member;
+}
+
 /**
  * Scans through the archive list for a specified file
  */
-Common::ArchiveMemberPtr PackageManager::getArchiveMember(const Common::String &fileName) {
+Common::ArchiveMemberPtr PackageManager::findArchiveMember(const Common::String &fileName) {
 	Common::String fileName2 = ensureSpeechLang(fileName);
 	// Loop through checking each archive
 	Common::List<ArchiveEntry *>::iterator i;
@@ -110,9 +120,9 @@ Common::ArchiveMemberPtr PackageManager::getArchiveMember(const Common::String &
 		// Construct relative path
 		Common::Path resPath(&fileName2.c_str()[(*i)->_mountPath.size()]);
 
-		if (archiveFolder->hasFile(resPath)) {
-			return archiveFolder->getMember(resPath);
-		}
+		Common::ArchiveMemberPtr member = archiveFolder->getMember(resPath);
+		if (member)
+			return member;
 	}
 
 	return Common::ArchiveMemberPtr();
@@ -127,14 +137,18 @@ bool PackageManager::loadPackage(const Common::Path &fileName, const Common::Str
 		return false;
 	} else {
 		debugC(kDebugResource, "Package '%s' mounted as '%s'.", fileName.toString(Common::Path::kNativeSeparator).c_str(), mountPosition.c_str());
-		Common::ArchiveMemberList files;
-		zipFile->listMembers(files);
-		debug(3, "Capacity %d", files.size());
-
-		for (Common::ArchiveMemberList::iterator it = files.begin(); it != files.end(); ++it)
-			debug(3, "%s", (*it)->getName().c_str());
+		// Listing the contents of the package takes a while, so only do it when it gets printed
+		if (debugLevelSet(3)) {
+			Common::ArchiveMemberList files;
+			zipFile->listMembers(files);
+			debug(3, "Capacity %d", files.size());
+
+			for (Common::ArchiveMemberList::iterator it = files.begin(); it != files.end(); ++it)
+				debug(3, "%s", (*it)->getName().c_str());
+		}
 
 		_archiveList.push_front(new ArchiveEntry(zipFile, mountPosition));
+		_memberCache.clear();
 
 		return true;
 	}
@@ -149,11 +163,14 @@ bool PackageManager::loadDirectoryAsPackage(const Common::Path &directoryName, c
 	} else {
 		debugC(kDebugResource, "Directory '%s' mounted as '%s'.", directoryName.toString(Common::Path::kNativeSeparator).c_str(), mountPosition.c_str());
 
-		Common::ArchiveMemberList files;
-		folderArchive->listMembers(files);
-		debug(0, "Capacity %d", files.size());
+		if (debugLevelSet(3)) {
+			Common::ArchiveMemberList files;
+			folderArchive->listMembers(files);
+			debug(3, "Capacity %d", files.size());
+		}
 
 		_archiveList.push_front(new ArchiveEntry(folderArchive, mountPosition));
+		_memberCache.clear();
 
 		return true;
 	}
@@ -235,7 +252,9 @@ bool PackageManager::fileExists(const Common::String &fileName) {
 		// To get around this, change to detecting one of the files in the folder
 		bool exists = getArchiveMember(normalizePath(fileName2 + "/APO0001.ogg", _currentDirectory));
 		if (!exists && _useEnglishSpeech) {
+			// The speech files are looked up in a different folder from now on
 			_useEnglishSpeech = false;
+			_memberCache.clear();
 			warning("English speech not found");
 		}
 		return exists;
@@ -49,6 +49,7 @@
 #include "common/archive.h"
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
 #include "common/str.h"
 
 #include "sword25/kernel/common.h"
@@ -92,7 +93,16 @@ private:
 	bool _useEnglishSpeech;
 	Common::String ensureSpeechLang(const Common::String &fileName);
 
+	typedef Common::HashMap<Common::String, Common::ArchiveMemberPtr> MemberCache;
+	/**
+	 * The results of getArchiveMember(), including the files that were not found. The same
+	 * files get looked up over and over again by the scripts, and each lookup would otherwise
+	 * go through all mounted packages. Cleared whenever the mounted packages change.
+	 */
+	MemberCache _memberCache;
+
 	Common::ArchiveMemberPtr getArchiveMember(const Common::String &fileName);
+	Common::ArchiveMemberPtr findArchiveMember(const Common::String &fileName);
 
 public:
 	PackageManager(Kernel *pKernel);
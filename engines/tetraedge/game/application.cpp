@@ -365,6 +365,9 @@ bool Application::run() {
 		game->scene().updateScroll();
 		g_engine->getSoundManager()->update();
 		performRender();
+		// Collect the garbage of the game scripts a little every frame, so
+		// that the full collections do not stall the game
+		game->luaContext().stepGarbageCollector(1000);
 		if (game->_returnToMainMenu) {
 			game->leave(true);
 			if (!game->luaShowOwnerError()) {
@@ -20,6 +20,7 @@
  */
 
 #include "common/file.h"
+#include "common/system.h"
 #include "image/png.h"
 #include "graphics/surface.h"
 #include "graphics/managed_surface.h"
@@ -32,6 +33,9 @@ TeImagesSequence::TeImagesSequence() : _width(0), _height(0), _curFrame(0), _fra
 }
 
 TeImagesSequence::~TeImagesSequence() {
+	for (uint i = 0; i < kPrefetchFrames; i++)
+		releaseSlot(_prefetch[i]);
+
 	for (auto surf : _cachedSurfaces) {
 		if (surf)
 			delete surf;
@@ -118,6 +122,86 @@ bool TeImagesSequence::load(const Common::FSNode &directory) {
 }
 
 
+void TeImagesSequence::decodeFrameProc(void *refCon) {
+	PrefetchSlot *slot = (PrefetchSlot *)refCon;
+
+	slot->decoder = new Image::PNGDecoder();
+	if (!slot->decoder->loadStream(*slot->stream)) {
+		delete slot->decoder;
+		slot->decoder = nullptr;
+	}
+
+	delete slot->stream;
+	slot->stream = nullptr;
+}
+
+void TeImagesSequence::releaseSlot(PrefetchSlot &slot) {
+	if (slot.frame < 0)
+		return;
+
+	g_system->getJobSystem()->wait(slot.group);
+	delete slot.decoder;
+	slot.decoder = nullptr;
+	slot.frame = -1;
+}
+
+void TeImagesSequence::prefetchFrames(uint current) {
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (jobSystem->getWorkerCount() == 0)
+		return;
+
+	// Drop the frames that were skipped or already shown
+	for (uint i = 0; i < kPrefetchFrames; i++) {
+		PrefetchSlot &slot = _prefetch[i];
+		if (slot.frame < 0)
+			continue;
+
+		uint ahead = (slot.frame + _files.size() - current) % _files.size();
+		if (ahead == 0 || ahead > kPrefetchFrames)
+			releaseSlot(slot);
+	}
+
+	// Decode the next frames, wrapping around for looping animations
+	for (uint n = 1; n <= kPrefetchFrames && n < _files.size(); n++) {
+		const int frame = (current + n) % _files.size();
+		if (_cachedSurfaces[frame])
+			continue;
+
+		PrefetchSlot *freeSlot = nullptr;
+		bool queued = false;
+		for (uint i = 0; i < kPrefetchFrames; i++) {
+			if (_prefetch[i].frame == frame)
+				queued = true;
+			else if (_prefetch[i].frame < 0 && !freeSlot)
+				freeSlot = &_prefetch[i];
+		}
+		if (queued || !freeSlot)
+			continue;
+
+		// The file is opened here, only reading and decoding it is left
+		// to the job
+		freeSlot->stream = _files[frame].createReadStream();
+		if (!freeSlot->stream)
+			continue;
+
+		freeSlot->frame = frame;
+		jobSystem->submit(freeSlot->group, decodeFrameProc, freeSlot);
+	}
+}
+
+bool TeImagesSequence::decodeFrame(uint i, Image::PNGDecoder &png) {
+	Common::SeekableReadStream *stream = _files[i].createReadStream();
+	if (!stream)
+		error("Open %s failed.. it was ok before?", _files[i].getName().c_str());
+
+	bool result = png.loadStream(*stream);
+	if (!result)
+		warning("Image sequence failed to load png %s", _files[i].getName().c_str());
+
+	delete stream;
+	return result;
+}
+
 bool TeImagesSequence::update(uint i, TeImage &imgout) {
 	_curFrame = i;
 
@@ -125,25 +209,34 @@ bool TeImagesSequence::update(uint i, TeImage &imgout) {
 		return false;
 
 	if (_cachedSurfaces[i] == nullptr) {
-		Common::SeekableReadStream *stream = _files[i].createReadStream();
-		if (!stream)
-			error("Open %s failed.. it was ok before?", _files[i].getName().c_str());
+		PrefetchSlot *slot = nullptr;
+		for (uint j = 0; j < kPrefetchFrames; j++) {
+			if (_prefetch[j].frame == (int)i) {
+				slot = &_prefetch[j];
+				g_system->getJobSystem()->wait(slot->group);
+				break;
+			}
+		}
 
+		// Fall back to decoding the frame here if it was not prefetched
 		Image::PNGDecoder png;
-		if (!png.loadStream(*stream)) {
-			warning("Image sequence failed to load png %s", _files[i].getName().c_str());
-			delete stream;
-			return false;
+		const Image::PNGDecoder *decoder = slot ? slot->decoder : nullptr;
+		if (!decoder) {
+			if (!decodeFrame(i, png))
+				return false;
+			decoder = &png;
 		}
 
-		const Graphics::Surface *surf = png.getSurface();
+		const Graphics::Surface *surf = decoder->getSurface();
 		assert(surf);
 
 		imgout.setAccessName(_files[i].getPath());
 
 		if (imgout.w == surf->w && imgout.h == surf->h && imgout.format == surf->format) {
 			imgout.copyFrom(*surf);
-			delete stream;
+			if (slot)
+				releaseSlot(*slot);
+			prefetchFrames(i);
 			return true;
 		}
 	} else {
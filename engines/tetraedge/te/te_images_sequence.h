@@ -22,14 +22,23 @@
 #ifndef TETRAEDGE_TE_TE_IMAGES_SEQUENCE_H
 #define TETRAEDGE_TE_TE_IMAGES_SEQUENCE_H
 
+#include "common/jobsystem.h"
 #include "common/str.h"
 #include "tetraedge/te/te_i_codec.h"
 
+namespace Common {
+class SeekableReadStream;
+}
+
 namespace Graphics {
 struct Surface;
 class ManagedSurface;
 }
 
+namespace Image {
+class PNGDecoder;
+}
+
 namespace Tetraedge {
 
 class TeImagesSequence : public TeICodec {
@@ -60,6 +69,25 @@ public:
 	static bool matchExtension(const Common::String &extn);
 
 private:
+	/** A frame decoded ahead of time by a job */
+	struct PrefetchSlot {
+		PrefetchSlot() : frame(-1), stream(nullptr), decoder(nullptr) {}
+
+		int frame; // -1 when the slot is free
+		Common::SeekableReadStream *stream;
+		Image::PNGDecoder *decoder; // nullptr if decoding failed
+		Common::JobGroup group;
+	};
+
+	static const uint kPrefetchFrames = 3;
+
+	bool decodeFrame(uint i, Image::PNGDecoder &png);
+	static void decodeFrameProc(void *refCon);
+	void prefetchFrames(uint current);
+	void releaseSlot(PrefetchSlot &slot);
+
+	PrefetchSlot _prefetch[kPrefetchFrames];
+
 	float _frameRate;
 	uint _width;
 	uint _height;
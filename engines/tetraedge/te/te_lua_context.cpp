@@ -24,6 +24,7 @@
 #include "common/lua/lua.h"
 #include "common/lua/lualib.h"
 #include "common/lua/lauxlib.h"
+#include "common/lua/scummvm_alloc.h"
 
 #include "tetraedge/te/te_lua_context.h"
 
@@ -50,13 +51,20 @@ static void luaDebugHook(lua_State *L, lua_Debug *ar) {
 
 
 TeLuaContext::TeLuaContext() : _luaState(nullptr) {
-	_luaState = lua_open();
-	luaL_openlibs(_luaState);
-	lua_atpanic(_luaState, luaPanicFunction);
+	_allocator = new Lua::LuaAllocator();
+	_luaState = newState();
 }
 
 TeLuaContext::~TeLuaContext() {
 	destroy();
+	delete _allocator;
+}
+
+lua_State *TeLuaContext::newState() {
+	lua_State *state = _allocator->newState();
+	luaL_openlibs(state);
+	lua_atpanic(state, luaPanicFunction);
+	return state;
 }
 
 void TeLuaContext::addBindings(void(*fn)(lua_State *)) {
@@ -64,20 +72,25 @@ void TeLuaContext::addBindings(void(*fn)(lua_State *)) {
 }
 
 void TeLuaContext::create() {
-	_luaState = lua_open();
-	luaL_openlibs(_luaState);
-	lua_atpanic(_luaState, luaPanicFunction);
+	_luaState = newState();
 #ifdef TETRAEDGE_LUA_DEBUG
 	lua_sethook(_luaState, luaDebugHook, LUA_MASKCALL | LUA_MASKLINE, 0);
 #endif
 }
 
 void TeLuaContext::destroy() {
-	if (_luaState)
+	if (_luaState) {
+		_allocator->printReport(_luaState, "TeLuaContext");
 		lua_close(_luaState);
+	}
 	_luaState = nullptr;
 }
 
+void TeLuaContext::stepGarbageCollector(uint32 budgetMicros) {
+	if (_luaState)
+		_allocator->stepGarbageCollector(_luaState, budgetMicros);
+}
+
 TeVariant TeLuaContext::global(const Common::String &name) {
 	lua_getglobal(_luaState, name.c_str());
 	TeVariant retval;
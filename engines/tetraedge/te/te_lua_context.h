@@ -30,6 +30,10 @@
 
 struct lua_State;
 
+namespace Lua {
+class LuaAllocator;
+}
+
 namespace Tetraedge {
 
 class TeLuaGUI;
@@ -71,10 +75,16 @@ public:
 
 	void setInRegistry(const Common::String &name, TeLuaGUI *gui);
 
+	/** Run incremental garbage collection for at most about budgetMicros. */
+	void stepGarbageCollector(uint32 budgetMicros);
+
 	Common::Error syncState(Common::Serializer &s);
 
 private:
+	lua_State *newState();
+
 	lua_State *_luaState;
+	Lua::LuaAllocator *_allocator;
 };
 
 } // end namespace Tetraedge
@@ -53,16 +53,29 @@ bool TePng::load(const Common::FSNode &node) {
 	return true;
 }
 
+static void copyRow(const Graphics::Surface &row, int y, int height, void *refCon) {
+	Graphics::Surface *surface = (Graphics::Surface *)refCon;
+	if (y == 0)
+		surface->create(row.w, height, row.format);
+
+	surface->copyRectToSurface(row, 0, y, Common::Rect(row.w, 1));
+}
+
 bool TePng::load(Common::SeekableReadStream &stream) {
 	if (_loadedSurface)
 		delete _loadedSurface;
 	_loadedSurface = nullptr;
 
+	// Decode straight into our own surface in the texture format
 	Image::PNGDecoder png;
-	if (!png.loadStream(stream))
+	png.setOutputPixelFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24));
+	_loadedSurface = new Graphics::Surface();
+	if (!png.loadStreamRows(stream, copyRow, _loadedSurface)) {
+		_loadedSurface->free();
+		delete _loadedSurface;
+		_loadedSurface = nullptr;
 		return false;
-
-	_loadedSurface = png.getSurface()->convertTo(Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24));
+	}
 
 	_height = _loadedSurface->h;
 
@@ -173,6 +173,15 @@ void TeRendererOpenGL::renderTransparentMeshes() {
 
 	TeMaterial lastMaterial;
 	TeMatrix4x4 lastMatrix;
+	TeCamera *lastCamera = nullptr;
+
+	// The properties are sorted by depth, so consecutive ones often share
+	// their camera and matrix, e.g. for the widgets of a 2D layout. Only
+	// send the state that changes between two draws.
+	glMatrixMode(GL_MODELVIEW);
+	_matrixMode = MM_GL_MODELVIEW;
+	glPushMatrix();
+	_matriciesStacks[_matrixMode].pushMatrix();
 
 	int vertsDrawn = 0;
 	for (uint i = 0; i < _transparentMeshProps.size(); i++) {
@@ -182,14 +191,19 @@ void TeRendererOpenGL::renderTransparentMeshes() {
 
 		const TeMaterial &material = meshProperties._material;
 
-		meshProperties._camera->applyProjection();
-		glMatrixMode(GL_MODELVIEW);
-		_matrixMode = MM_GL_MODELVIEW;
-		glPushMatrix();
-		_matriciesStacks[_matrixMode].pushMatrix();
-		_matriciesStacks[_matrixMode].loadMatrix(meshProperties._matrix);
-		glPushMatrix();
-		loadCurrentMatrixToGL();
+		if (meshProperties._camera != lastCamera) {
+			meshProperties._camera->applyProjection();
+			_matrixMode = MM_GL_MODELVIEW;
+		} else {
+			setCurrentCamera(meshProperties._camera);
+		}
+		if (meshProperties._camera != lastCamera || meshProperties._matrix != lastMatrix) {
+			_matriciesStacks[_matrixMode].loadMatrix(meshProperties._matrix);
+			loadCurrentMatrixToGL();
+			lastMatrix = meshProperties._matrix;
+		}
+		lastCamera = meshProperties._camera;
+
 		if (material._texture) {
 			glEnable(GL_TEXTURE_2D);
 			_textureEnabled = true;
@@ -229,11 +243,14 @@ void TeRendererOpenGL::renderTransparentMeshes() {
 			glDisable(GL_TEXTURE_2D);
 			_textureEnabled = false;
 		}
-		glPopMatrix();
-		glPopMatrix();
-		_matriciesStacks[_matrixMode].popMatrix();
 		TeCamera::restore();
 	}
+
+	glMatrixMode(GL_MODELVIEW);
+	_matrixMode = MM_GL_MODELVIEW;
+	glPopMatrix();
+	_matriciesStacks[_matrixMode].popMatrix();
+
 	glDisableClientState(GL_VERTEX_ARRAY);
 	glDisableClientState(GL_NORMAL_ARRAY);
 	glDisableClientState(GL_COLOR_ARRAY);
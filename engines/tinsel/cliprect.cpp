@@ -28,6 +28,9 @@
 
 namespace Tinsel {
 
+// Largest area, in pixels, that merging two separate clipping rectangles may add
+#define CLIP_MERGE_SLACK	(32 * 32)
+
 /**
  * Resets the clipping rectangle allocator.
  */
@@ -95,6 +98,25 @@ static bool LooseIntersectRectangle(const Common::Rect &pSrc1, const Common::Rec
 	return pDest.isValidRect();
 }
 
+/**
+ * Check if it is worth merging two rectangles that do not touch.
+ * Every clipping rectangle means another pass over all the objects
+ * of all the playfields, so two rectangles are merged when their
+ * union only adds a small area that would be redrawn needlessly.
+ * @param pSrc1			a source rectangle
+ * @param pSrc2			a source rectangle
+ */
+static bool CheapUnionRectangle(const Common::Rect &pSrc1, const Common::Rect &pSrc2) {
+	Common::Rect pUnion;
+
+	UnionRectangle(pUnion, pSrc1, pSrc2);
+
+	const int32 wasted = pUnion.width() * pUnion.height()
+		- pSrc1.width() * pSrc1.height() - pSrc2.width() * pSrc2.height();
+
+	return wasted <= CLIP_MERGE_SLACK;
+}
+
 /**
  * Adds velocities and creates clipping rectangles for all the
  * objects that have moved on the specified object list.
@@ -165,8 +187,9 @@ void FindMovingObjects(OBJECT **pObjList, Common::Point *pWin, Common::Rect *pCl
 }
 
 /**
- * Merges any clipping rectangles that overlap to try and reduce
- * the total number of clip rectangles.
+ * Merges any clipping rectangles that overlap, or that are close
+ * enough to each other, to try and reduce the total number of clip
+ * rectangles.
  */
 void MergeClipRect() {
 	RectList &s_rectList = _vm->_clipRects;
@@ -180,9 +203,10 @@ void MergeClipRect() {
 		rInner = rOuter;
 		while (++rInner != s_rectList.end()) {
 
-			if (LooseIntersectRectangle(*rOuter, *rInner)) {
-				// these two rectangles overlap or
-				// are next to each other - merge them
+			if (LooseIntersectRectangle(*rOuter, *rInner) ||
+					CheapUnionRectangle(*rOuter, *rInner)) {
+				// these two rectangles overlap, are next to
+				// each other or close enough - merge them
 
 				UnionRectangle(*rOuter, *rOuter, *rInner);
 
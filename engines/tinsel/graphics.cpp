@@ -33,6 +33,8 @@ namespace Tinsel {
 
 //----------------- LOCAL DEFINES --------------------
 
+#define MAX_UNWOUND_IMAGES	256	// images whose decompressed block indexes are kept
+
 extern uint8 g_transPalette[MAX_COLORS];
 
 //----------------- SUPPORT FUNCTIONS ---------------------
@@ -148,6 +150,36 @@ uint8* psxSaturnPJCRLEUnwinder(uint16 imageWidth, uint16 imageHeight, uint8 *src
 	return destinationBuffer;
 }
 
+/**
+ * Returns the decompressed block indexes of a PSX/Saturn image.
+ * Images are drawn once for every clipping rectangle they touch, so the
+ * indexes are only decompressed the first time and kept afterwards.
+ */
+static uint8 *psxSaturnUnwoundIndexes(SCNHANDLE hBits, uint16 imageWidth, uint16 imageHeight, uint8 *srcIdx) {
+	Common::HashMap<SCNHANDLE, uint8 *> &unwound = _vm->_unwoundIndexes;
+
+	Common::HashMap<SCNHANDLE, uint8 *>::iterator i = unwound.find(hBits);
+	if (i != unwound.end())
+		return i->_value;
+
+	// Start over when too many images were drawn, such as after
+	// a few scene changes
+	if (unwound.size() >= MAX_UNWOUND_IMAGES)
+		FreeUnwoundIndexes();
+
+	uint8 *indexes = psxSaturnPJCRLEUnwinder(imageWidth, imageHeight, srcIdx);
+	unwound[hBits] = indexes;
+	return indexes;
+}
+
+void FreeUnwoundIndexes() {
+	Common::HashMap<SCNHANDLE, uint8 *> &unwound = _vm->_unwoundIndexes;
+
+	for (Common::HashMap<SCNHANDLE, uint8 *>::iterator i = unwound.begin(); i != unwound.end(); ++i)
+		free(i->_value);
+	unwound.clear();
+}
+
 /**
  * Straight rendering of uncompressed data
  */
@@ -1108,7 +1140,6 @@ void DrawObject(DRAWOBJECT *pObj) {
 	byte psxMapperTable[16];
 
 	bool psxFourBitClut = false; // Used by Tinsel PSX, true if an image using a 4bit CLUT is rendered
-	bool psxSaturnRLEindex = false; // Used by Tinsel PSX/Saturn, true if an image is using PJCRLE compressed indexes
 	uint32 psxSkipBytes = 0; // Used by Tinsel PSX, number of bytes to skip before counting indexes for image tiles
 
 	if ((pObj->width <= 0) || (pObj->height <= 0))
@@ -1140,12 +1171,10 @@ void DrawObject(DRAWOBJECT *pObj) {
 						psxSkipBytes = 0;
 						switch (indexType) {
 							case 0xDD: // Normal uncompressed indexes
-								psxSaturnRLEindex = false;
 								srcPtr += sizeof(uint16); // Get to the beginning of index data
 								break;
 							case 0xCC: // PJCRLE compressed indexes
-								psxSaturnRLEindex = true;
-								srcPtr = psxSaturnPJCRLEUnwinder(pObj->width, pObj->height, srcPtr + sizeof(uint16));
+								srcPtr = psxSaturnUnwoundIndexes(pObj->hBits, pObj->width, pObj->height, srcPtr + sizeof(uint16));
 								break;
 							default:
 								error("Unknown PSX/Saturn index type 0x%.2X", indexType);
@@ -1159,12 +1188,10 @@ void DrawObject(DRAWOBJECT *pObj) {
 						psxSkipBytes = READ_32(p + sizeof(uint32) * 5) << 4; // Fetch number of bytes we have to skip
 						switch (indexType) {
 							case 0xDD: // Normal uncompressed indexes
-								psxSaturnRLEindex = false;
 								srcPtr += sizeof(uint16) * 17; // Skip image type and clut, and get to beginning of index data
 								break;
 							case 0xCC: // PJCRLE compressed indexes
-								psxSaturnRLEindex = true;
-								srcPtr = psxSaturnPJCRLEUnwinder(pObj->width, pObj->height, srcPtr + sizeof(uint16) * 17);
+								srcPtr = psxSaturnUnwoundIndexes(pObj->hBits, pObj->width, pObj->height, srcPtr + sizeof(uint16) * 17);
 								break;
 							default:
 								error("Unknown PSX index type 0x%.2X", indexType);
@@ -1262,11 +1289,6 @@ void DrawObject(DRAWOBJECT *pObj) {
 			error("Unknown drawing type %d", typeId);
 		}
 	}
-
-	// If we were using Discworld PSX/Saturn, free the memory allocated
-	// for decompressed block indexes.
-	if ((TinselV1PSX || TinselV1Saturn) && psxSaturnRLEindex)
-		free(srcPtr);
 }
 
 } // End of namespace Tinsel
@@ -64,6 +64,9 @@ struct DRAWOBJECT {
 void ClearScreen();
 void DrawObject(DRAWOBJECT *pObj);
 
+// frees the decompressed PSX/Saturn block indexes kept by DrawObject()
+void FreeUnwoundIndexes();
+
 // called to update a rectangle on the video screen from a video page
 void UpdateScreenRect(const Common::Rect &pClip);
 
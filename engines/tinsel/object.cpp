@@ -174,7 +174,7 @@ void InsertObject(OBJECT **pObjList, OBJECT *pInsObj) {
 			break;
 		} else if (pInsObj->zPos == pObj->zPos) {
 			// Z values are the same - sort on Y
-			if (fracToDouble(pInsObj->yPos) <= fracToDouble(pObj->yPos)) {
+			if (pInsObj->yPos <= pObj->yPos) {
 				// object Y is lower than or same as list Y - insert here
 				break;
 			}
@@ -242,48 +242,28 @@ void DelObject(OBJECT **pObjList, OBJECT *pDelObj) {
 
 /**
  * Sort the specified object list in Z Y order.
+ * Objects rarely change their Z or Y position between frames, so the list
+ * is walked once and only the objects that are out of order are moved back
+ * into the already sorted part of the list before it.
  * @param pObjList			List to sort
  */
 void SortObjectList(OBJECT **pObjList) {
 	OBJECT *pPrev, *pObj;	// object list traversal pointers
-	OBJECT head;		// temporary head of list - because pObjList is not usually a OBJECT
 
-	// put at head of list
-	head.pNext = *pObjList;
-
-	// set head of list dummy OBJ Z Y values to lowest possible
-	head.yPos = intToFrac(MIN_INT16);
-	head.zPos = MIN_INT;
-
-	for (pPrev = &head, pObj = head.pNext; pObj != NULL; pPrev = pObj, pObj = pObj->pNext) {
-		// check Z order
-		if (pObj->zPos < pPrev->zPos) {
-			// object Z is lower than previous Z
+	if (*pObjList == nullptr)
+		return;
 
+	for (pPrev = *pObjList, pObj = pPrev->pNext; pObj != NULL; pObj = pPrev->pNext) {
+		// check Z order, then Y order for the same Z values
+		if (pObj->zPos < pPrev->zPos ||
+				(pObj->zPos == pPrev->zPos && pObj->yPos < pPrev->yPos)) {
 			// remove object from list
 			pPrev->pNext = pObj->pNext;
 
-			// re-insert object on list
+			// re-insert object on the sorted part of the list
 			InsertObject(pObjList, pObj);
-
-			// back to beginning of list
-			pPrev = &head;
-			pObj  = head.pNext;
-		} else if (pObj->zPos == pPrev->zPos) {
-			// Z values are the same - sort on Y
-			if (fracToDouble(pObj->yPos) < fracToDouble(pPrev->yPos)) {
-				// object Y is lower than previous Y
-
-				// remove object from list
-				pPrev->pNext = pObj->pNext;
-
-				// re-insert object on list
-				InsertObject(pObjList, pObj);
-
-				// back to beginning of list
-				pPrev = &head;
-				pObj  = head.pNext;
-			}
+		} else {
+			pPrev = pObj;
 		}
 	}
 }
@@ -951,6 +951,7 @@ TinselEngine::~TinselEngine() {
 	delete _midiMusic;
 	delete _pcmMusic;
 	_screenSurface.free();
+	FreeUnwoundIndexes();
 	FreeSaveScenes();
 	FreeTextBuffer();
 	FreeObjectList();
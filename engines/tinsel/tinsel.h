@@ -26,6 +26,7 @@
 #include "common/system.h"
 #include "common/error.h"
 #include "common/events.h"
+#include "common/hashmap.h"
 #include "common/keyboard.h"
 #include "common/random.h"
 #include "common/util.h"
@@ -195,6 +196,9 @@ public:
 	/** List of all clip rectangles. */
 	RectList _clipRects;
 
+	/** Decompressed PSX/Saturn block indexes of the images drawn so far. */
+	Common::HashMap<SCNHANDLE, uint8 *> _unwoundIndexes;
+
 private:
 	void NextGameCycle();
 	void CreateConstProcesses();
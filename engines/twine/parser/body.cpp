@@ -25,7 +25,10 @@
 
 namespace TwinE {
 
+uint32 BodyData::_lastLoadId = 0;
+
 void BodyData::reset() {
+	_loadId = ++_lastLoadId;
 	_vertices.clear();
 	_bones.clear();
 	_normals.clear();
@@ -50,6 +50,9 @@ private:
 
 	BoneFrame _boneStates[560];
 
+	static uint32 _lastLoadId;
+	uint32 _loadId = 0;
+
 protected:
 	void reset() override;
 
@@ -63,6 +66,13 @@ public:
 		return animated;
 	}
 
+	/**
+	 * @brief Identifies the loaded body, to tell it from a different body loaded into the same object later on
+	 */
+	inline uint32 getLoadId() const {
+		return _loadId;
+	}
+
 	inline uint getNumBones() const {
 		return _bones.size();
 	}
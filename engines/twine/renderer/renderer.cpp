@@ -828,7 +828,6 @@ void Renderer::svgaPolyCopper(int16 vtop, int16 Ymax, uint16 color) const {
 	int16 xMin, xMax;
 	int16 y = vtop;
 	byte *pDestLine = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, y);
-	byte *pDest;
 	int16 *pVerticG = &_tabVerticG[y];
 	int16 *pVerticD = &_tabVerticD[y];
 	int32 sens = 1;
@@ -836,10 +835,8 @@ void Renderer::svgaPolyCopper(int16 vtop, int16 Ymax, uint16 color) const {
 	for (; y <= Ymax; y++) {
 		xMin = *pVerticG++;
 		xMax = *pVerticD++;
-		pDest = pDestLine + xMin;
-
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (byte)color;
+		if (xMin <= xMax) {
+			memset(pDestLine + xMin, (byte)color, xMax - xMin + 1);
 		}
 
 		color += sens;
@@ -859,7 +856,6 @@ void Renderer::svgaPolyBopper(int16 vtop, int16 Ymax, uint16 color) const {
 	int16 xMin, xMax;
 	int16 y = vtop;
 	byte *pDestLine = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, y);
-	byte *pDest;
 	int16 *pVerticG = &_tabVerticG[y];
 	int16 *pVerticD = &_tabVerticD[y];
 	int32 sens = 1;
@@ -868,10 +864,8 @@ void Renderer::svgaPolyBopper(int16 vtop, int16 Ymax, uint16 color) const {
 	for (; y <= Ymax; y++) {
 		xMin = *pVerticG++;
 		xMax = *pVerticD++;
-		pDest = pDestLine + xMin;
-
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (byte)color;
+		if (xMin <= xMax) {
+			memset(pDestLine + xMin, (byte)color, xMax - xMin + 1);
 		}
 
 		line--;
@@ -895,17 +889,14 @@ void Renderer::svgaPolyTriste(int16 vtop, int16 Ymax, uint16 color) const {
 	int16 xMin, xMax;
 	int16 y = vtop;
 	byte *pDestLine = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	byte *pDest;
 	int16 *pVerticG = &_tabVerticG[y];
 	int16 *pVerticD = &_tabVerticD[y];
 
 	for (; y <= Ymax; y++) {
 		xMin = *pVerticG++;
 		xMax = *pVerticD++;
-		pDest = pDestLine + xMin;
-
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (byte)color;
+		if (xMin <= xMax) {
+			memset(pDestLine + xMin, (byte)color, xMax - xMin + 1);
 		}
 
 		pDestLine += screenWidth;
@@ -1162,7 +1153,6 @@ void Renderer::svgaPolyTriche(int16 vtop, int16 Ymax, uint16 color) const {
 	int16 xMin, xMax;
 	int16 y = vtop;
 	byte *pDestLine = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, y);
-	byte *pDest;
 	int16 *pVerticG = &_tabVerticG[y];
 	int16 *pVerticD = &_tabVerticD[y];
 	int16 *pCoulG = &_tabCoulG[y];
@@ -1170,11 +1160,9 @@ void Renderer::svgaPolyTriche(int16 vtop, int16 Ymax, uint16 color) const {
 	for (; y <= Ymax; y++) {
 		xMin = *pVerticG++;
 		xMax = *pVerticD++;
-		pDest = pDestLine + xMin;
-
 		color = (*pCoulG++) >> 8;
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (byte)color;
+		if (xMin <= xMax) {
+			memset(pDestLine + xMin, (byte)color, xMax - xMin + 1);
 		}
 
 		pDestLine += screenWidth;
@@ -1537,10 +1525,49 @@ bool Renderer::renderObjectIso(const BodyData &bodyData, RenderCommand **renderC
 	return true;
 }
 
-void Renderer::animModel(ModelData *modelData, const BodyData &bodyData, RenderCommand *renderCmds, const IVec3 &angleVec, const IVec3 &poswr, Common::Rect &modelRect) {
-	const int32 numVertices = bodyData.getNumVertices();
-	const int32 numBones = bodyData.getNumBones();
+Renderer::TransformCache &Renderer::getTransformCache(const BodyData &bodyData) {
+	for (int i = 0; i < NUM_TRANSFORM_CACHES; ++i) {
+		if (_transformCaches[i].bodyData == &bodyData) {
+			return _transformCaches[i];
+		}
+	}
+	TransformCache &cache = _transformCaches[_nextTransformCache];
+	_nextTransformCache = (_nextTransformCache + 1) % NUM_TRANSFORM_CACHES;
+	cache.bodyData = nullptr;
+	return cache;
+}
+
+bool Renderer::isTransformCacheValid(const TransformCache &cache, const BodyData &bodyData, const IVec3 &angleVec) const {
+	if (cache.bodyData != &bodyData || cache.loadId != bodyData.getLoadId()) {
+		return false;
+	}
+	if (memcmp(&cache.angle, &angleVec, sizeof(angleVec)) != 0 ||
+		memcmp(&cache.matrixWorld, &_matrixWorld, sizeof(_matrixWorld)) != 0 ||
+		memcmp(&cache.normalLight, &_normalLight, sizeof(_normalLight)) != 0) {
+		return false;
+	}
+	return cache.boneStates.empty() || memcmp(cache.boneStates.data(), bodyData.getBoneState(0), cache.boneStates.size() * sizeof(BoneFrame)) == 0;
+}
+
+void Renderer::storeTransformCache(TransformCache &cache, const ModelData *modelData, const BodyData &bodyData, const IVec3 &angleVec) {
+	const uint numBones = bodyData.getNumBones();
+	cache.bodyData = &bodyData;
+	cache.loadId = bodyData.getLoadId();
+	cache.angle = angleVec;
+	cache.matrixWorld = _matrixWorld;
+	cache.normalLight = _normalLight;
+	cache.boneStates.assign(bodyData.getBoneState(0), bodyData.getBoneState(0) + numBones);
+	cache.computedPoints.assign(modelData->computedPoints, modelData->computedPoints + bodyData.getNumVertices());
+	cache.normals.assign(modelData->normalTable, modelData->normalTable + bodyData.getNormals().size());
+}
+
+void Renderer::loadTransformCache(const TransformCache &cache, ModelData *modelData) const {
+	memcpy(modelData->computedPoints, cache.computedPoints.data(), cache.computedPoints.size() * sizeof(I16Vec3));
+	memcpy(modelData->normalTable, cache.normals.data(), cache.normals.size() * sizeof(int16));
+}
 
+void Renderer::animBones(ModelData *modelData, const BodyData &bodyData, const IVec3 &angleVec) {
+	const int32 numBones = bodyData.getNumBones();
 	const Common::Array<BodyVertex> &vertices = bodyData.getVertices();
 
 	IMatrix3x3 *modelMatrix = &_matricesTable[0];
@@ -1571,8 +1598,70 @@ void Renderer::animModel(ModelData *modelData, const BodyData &bodyData, RenderC
 			++boneIdx;
 		} while (--numOfPrimitives);
 	}
+}
+
+void Renderer::animNormals(ModelData *modelData, const BodyData &bodyData) {
+	const int32 numBones = bodyData.getNumBones();
+	int32 numOfPrimitives;
+	int32 numNormals = (int32)bodyData.getNormals().size();
+
+	if (numNormals) { // process normal data
+		uint16 *currentShadeDestination = (uint16 *)modelData->normalTable;
+		IMatrix3x3 *lightMatrix = &_matricesTable[0];
+
+		numOfPrimitives = numBones;
+
+		int16 shadeIndex = 0;
+		int16 boneIdx = 0;
+		do { // for each element
+			numNormals = bodyData.getBone(boneIdx).numNormals;
+
+			if (numNormals) {
+				const IMatrix3x3 matrix = *lightMatrix * _normalLight;
+
+				for (int32 i = 0; i < numNormals; ++i) { // for each normal
+					const BodyNormal &normalPtr = bodyData.getNormal(shadeIndex);
+
+					const int32 x = (int32)normalPtr.x;
+					const int32 y = (int32)normalPtr.y;
+					const int32 z = (int32)normalPtr.z;
+
+					int32 intensity = 0;
+					intensity += matrix.row1.x * x + matrix.row1.y * y + matrix.row1.z * z;
+					intensity += matrix.row2.x * x + matrix.row2.y * y + matrix.row2.z * z;
+					intensity += matrix.row3.x * x + matrix.row3.y * y + matrix.row3.z * z;
+
+					if (intensity > 0) {
+						intensity >>= 14;
+						intensity /= normalPtr.prenormalizedRange;
+					} else {
+						intensity = 0;
+					}
+
+					*currentShadeDestination++ = (uint16)intensity;
+					++shadeIndex;
+				};
+			}
+
+			++boneIdx;
+			++lightMatrix;
+		} while (--numOfPrimitives);
+	}
+}
 
-	numOfPrimitives = numVertices;
+void Renderer::animModel(ModelData *modelData, const BodyData &bodyData, RenderCommand *renderCmds, const IVec3 &angleVec, const IVec3 &poswr, Common::Rect &modelRect) {
+	const int32 numVertices = bodyData.getNumVertices();
+
+	TransformCache &cache = getTransformCache(bodyData);
+	if (isTransformCacheValid(cache, bodyData, angleVec)) {
+		loadTransformCache(cache, modelData);
+	} else {
+		animBones(modelData, bodyData, angleVec);
+		animNormals(modelData, bodyData);
+		storeTransformCache(cache, modelData, bodyData, angleVec);
+	}
+
+	int32 numOfPrimitives = numVertices;
 
 	const I16Vec3 *pointPtr = &modelData->computedPoints[0];
 	I16Vec3 *pointPtrDest = &modelData->flattenPoints[0];
@@ -1645,51 +1734,6 @@ void Renderer::animModel(ModelData *modelData, const BodyData &bodyData, RenderC
 
 		} while (--numOfPrimitives);
 	}
-
-	int32 numNormals = (int32)bodyData.getNormals().size();
-
-	if (numNormals) { // process normal data
-		uint16 *currentShadeDestination = (uint16 *)modelData->normalTable;
-		IMatrix3x3 *lightMatrix = &_matricesTable[0];
-
-		numOfPrimitives = numBones;
-
-		int16 shadeIndex = 0;
-		int16 boneIdx = 0;
-		do { // for each element
-			numNormals = bodyData.getBone(boneIdx).numNormals;
-
-			if (numNormals) {
-				const IMatrix3x3 matrix = *lightMatrix * _normalLight;
-
-				for (int32 i = 0; i < numNormals; ++i) { // for each normal
-					const BodyNormal &normalPtr = bodyData.getNormal(shadeIndex);
-
-					const int32 x = (int32)normalPtr.x;
-					const int32 y = (int32)normalPtr.y;
-					const int32 z = (int32)normalPtr.z;
-
-					int32 intensity = 0;
-					intensity += matrix.row1.x * x + matrix.row1.y * y + matrix.row1.z * z;
-					intensity += matrix.row2.x * x + matrix.row2.y * y + matrix.row2.z * z;
-					intensity += matrix.row3.x * x + matrix.row3.y * y + matrix.row3.z * z;
-
-					if (intensity > 0) {
-						intensity >>= 14;
-						intensity /= normalPtr.prenormalizedRange;
-					} else {
-						intensity = 0;
-					}
-
-					*currentShadeDestination++ = (uint16)intensity;
-					++shadeIndex;
-				};
-			}
-
-			++boneIdx;
-			++lightMatrix;
-		} while (--numOfPrimitives);
-	}
 }
 
 bool Renderer::affObjetIso(int32 x, int32 y, int32 z, int32 alpha, int32 beta, int32 gamma, const BodyData &bodyData, Common::Rect &modelRect) {
@@ -149,6 +149,33 @@ private:
 
 	ModelData _modelData;
 
+	/**
+	 * @brief The bone transforms and normal intensities of the last rendering of a body.
+	 *
+	 * They only depend on the pose and the orientation of the body, and on the world
+	 * and light rotations. Bodies that are not moving (or played back frame by frame
+	 * at a lower rate than the screen) reuse them instead of transforming all vertices again.
+	 */
+	struct TransformCache {
+		const BodyData *bodyData = nullptr;
+		uint32 loadId = 0;
+		IVec3 angle;
+		IMatrix3x3 matrixWorld;
+		IVec3 normalLight;
+		Common::Array<BoneFrame> boneStates;
+		Common::Array<I16Vec3> computedPoints;
+		Common::Array<int16> normals;
+	};
+
+	static const int NUM_TRANSFORM_CACHES = 16;
+	TransformCache _transformCaches[NUM_TRANSFORM_CACHES];
+	int _nextTransformCache = 0;
+
+	TransformCache &getTransformCache(const BodyData &bodyData);
+	bool isTransformCacheValid(const TransformCache &cache, const BodyData &bodyData, const IVec3 &angleVec) const;
+	void storeTransformCache(TransformCache &cache, const ModelData *modelData, const BodyData &bodyData, const IVec3 &angleVec);
+	void loadTransformCache(const TransformCache &cache, ModelData *modelData) const;
+
 	// AnimNuage
 	void animModel(ModelData *modelData, const BodyData &bodyData, RenderCommand *renderCmds, const IVec3 &angleVec, const IVec3 &renderPos, Common::Rect &modelRect);
 	bool computeSphere(int32 x, int32 y, int32 radius, int &vtop, int &vbottom);
@@ -162,6 +189,8 @@ private:
 	void processRotatedElement(IMatrix3x3 *targetMatrix, const Common::Array<BodyVertex>& vertices, int32 rotX, int32 rotY, int32 rotZ, const BodyBone &bone, ModelData *modelData);
 	void transRotList(const Common::Array<BodyVertex>& vertices, int32 firstPoint, int32 numPoints, I16Vec3 *destPoints, const IMatrix3x3 *translationMatrix, const IVec3 &angleVec, const IVec3 &destPos);
 	void translateGroup(IMatrix3x3 *targetMatrix, const Common::Array<BodyVertex>& vertices, int32 rotX, int32 rotY, int32 rotZ, const BodyBone &bone, ModelData *modelData);
+	void animBones(ModelData *modelData, const BodyData &bodyData, const IVec3 &angleVec);
+	void animNormals(ModelData *modelData, const BodyData &bodyData);
 	IVec3 rot(const IMatrix3x3 &matrix, int32 x, int32 y, int32 z);
 
 	IVec3 _cameraPos;
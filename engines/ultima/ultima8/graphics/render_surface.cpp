@@ -633,40 +633,31 @@ void inline paintLogic(uint8 *pixels, int32 pitch,
 		dstRect.bottom = clipWindow.bottom;
 	}
 
-	const int srcStep = sizeof(uint8);
-	int dstStep = sizeof(uintX);
-
-	if (mirrored) {
-		x = dstRect.right - 1;
-		y = dstRect.top;
-		dstStep = -dstStep;
-	} else {
-		x = dstRect.left;
-		y = dstRect.top;
-	}
-
-	const int w = srcRect.width();
-	const int h = srcRect.height();
-	const int srcDelta = src.pitch - (w * srcStep);
-	const int dstDelta = pitch - (w * dstStep);
-
-	const uint8 keycolor = frame->_keycolor;
-	const uint8 *srcPixels = reinterpret_cast<const uint8 *>(src.getBasePtr(srcRect.left, srcRect.top));
-	uint8 *dstPixels = reinterpret_cast<uint8 *>(pixels + x * sizeof(uintX) + pitch * y);
+	if (srcRect.isEmpty())
+		return;
 
-	for (int i = 0; i < h; i++) {
-		for (int j = 0; j < w; j++) {
-			const uint8 color = *srcPixels;
-			if (color != keycolor) {
-				uintX *dstpix = reinterpret_cast<uintX *>(dstPixels);
-				*dstpix = static_cast<uintX>(map[color]);
+	// Only the opaque spans of the frame are copied, so the key color does
+	// not have to be checked for every pixel
+	for (int sy = srcRect.top; sy < srcRect.bottom; sy++) {
+		const uint8 *srcPixels = reinterpret_cast<const uint8 *>(src.getBasePtr(0, sy));
+		uintX *dstPixels = reinterpret_cast<uintX *>(pixels + pitch * (dstRect.top + sy - srcRect.top));
+
+		uint count;
+		const ShapeFrame::Span *span = frame->getSpans(sy, count);
+		for (; count > 0; span++, count--) {
+			const int left = MAX<int>(span->_x, srcRect.left);
+			const int right = MIN<int>(span->_x + span->_length, srcRect.right);
+
+			if (mirrored) {
+				uintX *dstpix = dstPixels + dstRect.right - 1 - (left - srcRect.left);
+				for (int sx = left; sx < right; sx++)
+					*dstpix-- = static_cast<uintX>(map[srcPixels[sx]]);
+			} else {
+				uintX *dstpix = dstPixels + dstRect.left + (left - srcRect.left);
+				for (int sx = left; sx < right; sx++)
+					*dstpix++ = static_cast<uintX>(map[srcPixels[sx]]);
 			}
-			srcPixels += srcStep;
-			dstPixels += dstStep;
 		}
-
-		srcPixels += srcDelta;
-		dstPixels += dstDelta;
 	}
 }
 
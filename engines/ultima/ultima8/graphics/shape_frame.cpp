@@ -41,6 +41,8 @@ ShapeFrame::ShapeFrame(const RawShapeFrame *rawframe) :
 			_keycolor++;
 		}
 	}
+
+	loadSpans();
 }
 
 ShapeFrame::~ShapeFrame() {
@@ -89,6 +91,32 @@ bool ShapeFrame::load(const RawShapeFrame *rawframe, uint8 keycolor) {
 	return result;
 }
 
+void ShapeFrame::loadSpans() {
+	_spans.clear();
+	_rowSpans.resize(_surface.h + 1);
+
+	for (int y = 0; y < _surface.h; y++) {
+		_rowSpans[y] = _spans.size();
+
+		const uint8 *pixels = reinterpret_cast<const uint8 *>(_surface.getBasePtr(0, y));
+		int x = 0;
+		while (x < _surface.w) {
+			while (x < _surface.w && pixels[x] == _keycolor)
+				x++;
+			if (x == _surface.w)
+				break;
+
+			Span span;
+			span._x = x;
+			while (x < _surface.w && pixels[x] != _keycolor)
+				x++;
+			span._length = x - span._x;
+			_spans.push_back(span);
+		}
+	}
+	_rowSpans[_surface.h] = _spans.size();
+}
+
 // Checks to see if the frame has a pixel at the point
 bool ShapeFrame::hasPoint(int x, int y) const {
 	// Add the offset
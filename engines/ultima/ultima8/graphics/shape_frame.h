@@ -22,6 +22,7 @@
 #ifndef ULTIMA8_GRAPHICS_SHAPEFRAME_H
 #define ULTIMA8_GRAPHICS_SHAPEFRAME_H
 
+#include "common/array.h"
 #include "graphics/surface.h"
 
 namespace Ultima {
@@ -48,9 +49,29 @@ public:
 
 	const Graphics::Surface &getSurface() const { return _surface; }
 
+	/** A run of pixels of a row which are not the key color */
+	struct Span {
+		int16 _x;
+		int16 _length;
+	};
+
+	/**
+	 * Get the opaque runs of pixels of a row, from left to right
+	 * @param y the row
+	 * @param count set to the number of spans of the row
+	 * @return the first span of the row
+	 */
+	const Span *getSpans(int y, uint &count) const {
+		count = _rowSpans[y + 1] - _rowSpans[y];
+		return _spans.data() + _rowSpans[y];
+	}
+
 private:
 	Graphics::Surface _surface;
 
+	Common::Array<Span> _spans;
+	Common::Array<uint32> _rowSpans; // Index of the first span of each row, and the span count at the end
+
 	/**
 	 * Load the pixel data from the raw shape rle data using key color for transparency
 	 * @param rawframe the raw shape to load rle data
@@ -58,6 +79,9 @@ private:
 	 * @return false if the keycolor is found in the raw shape frame data
 	*/
 	bool load(const RawShapeFrame *rawframe, uint8 keycolor);
+
+	/** Find the spans of the loaded pixel data */
+	void loadSpans();
 };
 
 } // End of namespace Ultima8
@@ -52,7 +52,8 @@ const int INT_MAX_VALUE = 0x7fffffff;
 const int INT_MIN_VALUE = -INT_MAX_VALUE - 1;
 
 CurrentMap::CurrentMap() : _currentMap(0), _eggHatcher(0),
-	  _fastXMin(-1), _fastYMin(-1), _fastXMax(-1), _fastYMax(-1) {
+	  _fastXMin(-1), _fastYMin(-1), _fastXMax(-1), _fastYMax(-1),
+	  _maxFootpad(-1), _searchCount(0), _searchChunkCount(0) {
 	for (unsigned int i = 0; i < MAP_NUM_CHUNKS; i++) {
 		memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
@@ -557,6 +558,50 @@ inline void CurrentMap::clipMapChunks(int &minx, int &maxx, int &miny, int &maxy
 	maxy = CLIP(maxy, 0, MAP_NUM_CHUNKS - 1);
 }
 
+void CurrentMap::getSearchChunks(int32 minx, int32 maxx, int32 miny, int32 maxy, bool footpads,
+								 int &cminx, int &cmaxx, int &cminy, int &cmaxy) const {
+	// Items are stored in the chunk of their location, and their footpads
+	// extend from there towards lower x and y. Only the chunks of items which
+	// can reach the area, or touch it, have to be searched.
+	const int32 reach = footpads ? getMaxFootpad() : 0;
+
+	cminx = (minx - 1) / _mapChunkSize;
+	cmaxx = (maxx + reach + 1) / _mapChunkSize;
+	cminy = (miny - 1) / _mapChunkSize;
+	cmaxy = (maxy + reach + 1) / _mapChunkSize;
+	clipMapChunks(cminx, cmaxx, cminy, cmaxy);
+
+	_searchCount++;
+	_searchChunkCount += (cmaxx - cminx + 1) * (cmaxy - cminy + 1);
+}
+
+int32 CurrentMap::getMaxFootpad() const {
+	if (_maxFootpad < 0) {
+		MainShapeArchive *shapes = GameData::get_instance()->getMainShapes();
+		_maxFootpad = 0;
+		for (uint32 shape = 0; shape < shapes->getCount(); shape++) {
+			const ShapeInfo *si = shapes->getShapeInfo(shape);
+			if (!si)
+				continue;
+
+			int32 xd, yd, zd;
+			si->getFootpadWorld(xd, yd, zd, 0);
+			_maxFootpad = MAX(_maxFootpad, MAX(xd, yd));
+		}
+
+		// Searches always went one chunk further, so larger footpads were
+		// never found before either
+		_maxFootpad = MIN<int32>(_maxFootpad, _mapChunkSize - 1);
+	}
+	return _maxFootpad;
+}
+
+void CurrentMap::mapStats() const {
+	g_debugger->debugPrintf("Item searches: %u, ", _searchCount);
+	g_debugger->debugPrintf("chunks per search: %.2f\n", _searchCount ? (float)_searchChunkCount / _searchCount : 0.0f);
+	g_debugger->debugPrintf("Max footpad  : %d\n", getMaxFootpad());
+}
+
 void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 							uint32 scriptsize, const Item *check, uint16 range,
 							bool recurse, int32 x, int32 y) const {
@@ -580,11 +625,9 @@ void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 	//
 	const Box searchrange(x + range, y + range, 0, xd + range * 2 + 1, yd + range * 2 + 1, INT_MAX_VALUE);
 
-	int minx = ((x - xd - range) / _mapChunkSize) - 1;
-	int maxx = ((x + range) / _mapChunkSize) + 1;
-	int miny = ((y - yd - range) / _mapChunkSize) - 1;
-	int maxy = ((y + range) / _mapChunkSize) + 1;
-	clipMapChunks(minx, maxx, miny, maxy);
+	int minx, maxx, miny, maxy;
+	getSearchChunks(x - xd - range - 1, x + range, y - yd - range - 1, y + range, false,
+	                minx, maxx, miny, maxy);
 
 	//
 	// NOTE: Iteration order of chunks here is important for
@@ -638,11 +681,8 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 	check->getFootpadWorld(xd, yd, zd);
 	const Box searchrange(x, y, z, xd, yd, zd);
 
-	int minx = ((x - xd) / _mapChunkSize) - 1;
-	int maxx = (x / _mapChunkSize) + 1;
-	int miny = ((y - yd) / _mapChunkSize) - 1;
-	int maxy = (y / _mapChunkSize) + 1;
-	clipMapChunks(minx, maxx, miny, maxy);
+	int minx, maxx, miny, maxy;
+	getSearchChunks(x - xd, x, y - yd, y, true, minx, maxx, miny, maxy);
 
 	for (int cy = miny; cy <= maxy; cy++) {
 		for (int cx = minx; cx <= maxx; cx++) {
@@ -737,11 +777,9 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 	int32 midx = target._x - target._xd / 2;
 	int32 midy = target._y - target._yd / 2;
 
-	int minx = ((target._x - target._xd) / _mapChunkSize) - 1;
-	int maxx = (target._x / _mapChunkSize) + 1;
-	int miny = ((target._y - target._yd) / _mapChunkSize) - 1;
-	int maxy = (target._y / _mapChunkSize) + 1;
-	clipMapChunks(minx, maxx, miny, maxy);
+	int minx, maxx, miny, maxy;
+	getSearchChunks(target._x - target._xd, target._x, target._y - target._yd, target._y, true,
+	                minx, maxx, miny, maxy);
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
@@ -851,11 +889,8 @@ bool CurrentMap::scanForValidPosition(int32 x, int32 y, int32 z, const Item *ite
 	// next, we'll loop over all objects in the area, and mark the areas
 	// overlapped and supported by each object
 
-	int minx = ((x - xd) / _mapChunkSize) - 1;
-	int maxx = (x / _mapChunkSize) + 1;
-	int miny = ((y - yd) / _mapChunkSize) - 1;
-	int maxy = (y / _mapChunkSize) + 1;
-	clipMapChunks(minx, maxx, miny, maxy);
+	int minx, maxx, miny, maxy;
+	getSearchChunks(x - xd, x, y - yd, y, true, minx, maxx, miny, maxy);
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
@@ -993,27 +1028,10 @@ bool CurrentMap::sweepTest(const int32 start[3], const int32 end[3],
 						   Std::list<SweepItem> *hit) const {
 	const uint32 blockflagmask = (ShapeInfo::SI_SOLID | ShapeInfo::SI_DAMAGING | ShapeInfo::SI_LAND);
 
-	int minx = ((start[0] - dims[0]) / _mapChunkSize) - 1;
-	int maxx = (start[0] / _mapChunkSize) + 1;
-	int miny = ((start[1] - dims[1]) / _mapChunkSize) - 1;
-	int maxy = (start[1] / _mapChunkSize) + 1;
-
-	{
-		int dminx = ((end[0] - dims[0]) / _mapChunkSize) - 1;
-		int dmaxx = (end[0] / _mapChunkSize) + 1;
-		int dminy = ((end[1] - dims[1]) / _mapChunkSize) - 1;
-		int dmaxy = (end[1] / _mapChunkSize) + 1;
-		if (dminx < minx)
-			minx = dminx;
-		if (dmaxx > maxx)
-			maxx = dmaxx;
-		if (dminy < miny)
-			miny = dminy;
-		if (dmaxy > maxy)
-			maxy = dmaxy;
-	}
-
-	clipMapChunks(minx, maxx, miny, maxy);
+	int minx, maxx, miny, maxy;
+	getSearchChunks(MIN(start[0], end[0]) - dims[0], MAX(start[0], end[0]),
+	                MIN(start[1], end[1]) - dims[1], MAX(start[1], end[1]), true,
+	                minx, maxx, miny, maxy);
 
 	// Get velocity, extents, and centre of item
 	int32 vel[3];
@@ -183,6 +183,9 @@ public:
 	void save(Common::WriteStream *ws);
 	bool load(Common::ReadStream *rs, uint32 version);
 
+	//! Print the statistics of the item searches
+	void mapStats() const;
+
 	INTRINSIC(I_canExistAt);
 	INTRINSIC(I_canExistAtPoint);
 
@@ -193,6 +196,15 @@ private:
 	//! clip the given map chunk numbers to iterate over them safely
 	static void clipMapChunks(int &minx, int &maxx, int &miny, int &maxy);
 
+	//! Get the map chunks holding the items which may touch the area from
+	//! (minx, miny) to (maxx, maxy). If footpads is false, only the items
+	//! located in the area are wanted.
+	void getSearchChunks(int32 minx, int32 maxx, int32 miny, int32 maxy, bool footpads,
+	                     int &cminx, int &cmaxx, int &cminy, int &cmaxy) const;
+
+	//! The largest footpad of any shape, limited to the chunk size
+	int32 getMaxFootpad() const;
+
 	Map *_currentMap;
 
 	// item lists. Lots of them :-)
@@ -207,6 +219,12 @@ private:
 
 	int _mapChunkSize;
 
+	mutable int32 _maxFootpad;
+
+	// Statistics of the item searches
+	mutable uint32 _searchCount;
+	mutable uint32 _searchChunkCount;
+
 	//! Items that are "targetable" in Crusader. It might be faster to store
 	//! this in a more fancy data structure, but this works fine.
 	ObjId _targets[MAP_NUM_TARGET_ITEMS];
@@ -48,7 +48,7 @@ static const uint32 HIGHLIGHT_COLOR = TEX32_PACK_RGBA(0xFF, 0xFF, 0x00, 0x1F);
 ItemSorter::ItemSorter(int capacity) :
 	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
 	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
-	_sortLimit(0), _sortLimitChanged(false) {
+	_sortLimit(0), _sortLimitChanged(false), _reusing(false), _reused(0) {
 	int i = capacity;
 	while (i--) {
 		SortItem *next = _itemsUnused;
@@ -76,9 +76,40 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, int32 camx, int32 camy
 	// Get the _shapes, if required
 	if (!_shapes) _shapes = GameData::get_instance()->getMainShapes();
 
+	// Screenspace bounding box bottom x coord (RNB x coord)
+	int32 camSx = (camx - camy) / 4;
+	// Screenspace bounding box bottom extent  (RNB y coord)
+	int32 camSy = (camx + camy) / 8 - camz;
+
+	// The sorted list only stays valid for the same view
+	_reusing = clipWindow == _clipWindow && camSx == _camSx && camSy == _camSy;
+	_reused = 0;
+#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
+	// The occlusion of groups is only worked out when painting
+	_reusing = false;
+#endif
+
 	// Set the clip window, and reset the item list
 	_clipWindow = clipWindow;
+	_painted = nullptr;
+
+	if (_reusing) {
+		for (SortItem *si = _items; si != nullptr; si = si->_next)
+			si->_order = -1;
+	} else {
+		ClearList();
+	}
 
+	if (camSx != _camSx || camSy != _camSy) {
+		_camSx = camSx;
+		_camSy = camSy;
+
+		// Reset sort limit debugging on camera move
+		_sortLimit = 0;
+	}
+}
+
+void ItemSorter::ClearList() {
 	if (_itemsTail) {
 		_itemsTail->_next = _itemsUnused;
 		_itemsUnused = _items;
@@ -86,24 +117,82 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, int32 camx, int32 camy
 
 	_items = nullptr;
 	_itemsTail = nullptr;
-	_painted = nullptr;
+	_added.clear();
+}
 
-	// Screenspace bounding box bottom x coord (RNB x coord)
-	int32 camSx = (camx - camy) / 4;
-	// Screenspace bounding box bottom extent  (RNB y coord)
-	int32 camSy = (camx + camy) / 8 - camz;
+void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 frame_num, uint32 flags, uint32 ext_flags, uint16 itemNum) {
+	if (_reusing) {
+		if (ReuseItem(x, y, z, shapeNum, frame_num, flags, ext_flags, itemNum))
+			return;
+		StopReusing();
+	}
 
-	if (camSx != _camSx || camSy != _camSy) {
-		_camSx = camSx;
-		_camSy = camSy;
+	AddedItem added;
+	added._x = x;
+	added._y = y;
+	added._z = z;
+	added._shapeNum = shapeNum;
+	added._frame = frame_num;
+	added._flags = flags;
+	added._extFlags = ext_flags;
+	added._itemNum = itemNum;
+	added._item = SortNewItem(x, y, z, shapeNum, frame_num, flags, ext_flags, itemNum);
+	_added.push_back(added);
+}
 
-		// Reset sort limit debugging on camera move
-		_sortLimit = 0;
+bool ItemSorter::ReuseItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 frame_num, uint32 flags, uint32 ext_flags, uint16 itemNum) {
+	if (_reused == _added.size())
+		return false;
+
+	AddedItem &added = _added[_reused];
+	if (added._x != x || added._y != y || added._z != z ||
+		added._shapeNum != shapeNum || added._flags != flags ||
+		added._extFlags != ext_flags || added._itemNum != itemNum)
+		return false;
+
+	if (added._frame != frame_num) {
+		// A new frame of an animation keeps the order as long as it covers
+		// the same screen area, which is all overlap and occlusion look at
+		SortItem *si = added._item;
+		if (!si)
+			return false;
+
+		const ShapeFrame *oldFrame = si->_shape->getFrame(si->_frame);
+		const ShapeFrame *frame = si->_shape->getFrame(frame_num);
+		if (!frame || frame->_width != oldFrame->_width || frame->_height != oldFrame->_height ||
+			frame->_xoff != oldFrame->_xoff || frame->_yoff != oldFrame->_yoff)
+			return false;
+
+		// The frame number only breaks ties between otherwise equal items
+		if ((si->_prev && !si->_prev->listLessThan(*si) && !si->listLessThan(*si->_prev)) ||
+			(si->_next && !si->_next->listLessThan(*si) && !si->listLessThan(*si->_next)))
+			return false;
+
+		si->_frame = frame_num;
+		added._frame = frame_num;
 	}
+
+	_reused++;
+	return true;
 }
 
-void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 frame_num, uint32 flags, uint32 ext_flags, uint16 itemNum) {
+void ItemSorter::StopReusing() {
+	// Sort the items added so far again, the same as in a new list
+	Common::Array<AddedItem> added;
+	added.swap(_added);
+	added.resize(_reused);
+
+	ClearList();
+	_reusing = false;
 
+	for (uint i = 0; i < added.size(); i++) {
+		AddedItem &a = added[i];
+		a._item = SortNewItem(a._x, a._y, a._z, a._shapeNum, a._frame, a._flags, a._extFlags, a._itemNum);
+		_added.push_back(a);
+	}
+}
+
+SortItem *ItemSorter::SortNewItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 frame_num, uint32 flags, uint32 ext_flags, uint16 itemNum) {
 	// First thing, get a SortItem to use (first of unused)
 	if (!_itemsUnused)
 		_itemsUnused = new SortItem();
@@ -123,7 +212,7 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 			last_invalid_frame = si->_frame;
 			last_invalid_shape = si->_shapeNum;
 		}
-		return;
+		return nullptr;
 	}
 
 	si->_flags = flags;
@@ -154,7 +243,7 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	// Do Clipping here
 	if (!_clipWindow.intersects(si->_sr)) {
 		// Clipped away entirely - don't add to the list.
-		return;
+		return nullptr;
 	}
 
 #ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
@@ -267,6 +356,8 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 		si->_prev = _itemsTail;
 		_itemsTail = si;
 	}
+
+	return si;
 }
 
 void ItemSorter::AddItem(const Item *add) {
@@ -277,6 +368,10 @@ void ItemSorter::AddItem(const Item *add) {
 }
 
 void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool showFootpads) {
+	// Items of the previous list which were not added again
+	if (_reusing && _reused != _added.size())
+		StopReusing();
+
 	if (_sortLimit) {
 		// Clear the surface when debugging the sorter
 		uint32 color = TEX32_PACK_RGB(0, 0, 0);
@@ -509,6 +604,9 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *it;
 	SortItem *selected;
 
+	if (_reusing && _reused != _added.size())
+		StopReusing();
+
 	if (!_painted) { // If no painted item found, we need to sort the items
 		it = _items;
 		_painted = nullptr;
@@ -22,6 +22,7 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
 #include "ultima/ultima8/misc/rect.h"
 
 namespace Ultima {
@@ -33,6 +34,17 @@ class RenderSurface;
 struct SortItem;
 
 class ItemSorter {
+	//! The arguments of an AddItem() call, and the item added to the list
+	struct AddedItem {
+		int32       _x, _y, _z;
+		uint32      _shapeNum;
+		uint32      _frame;
+		uint32      _flags;
+		uint32      _extFlags;
+		uint16      _itemNum;
+		SortItem    *_item;          // nullptr if not in the list
+	};
+
 	MainShapeArchive    *_shapes;
 	Rect        _clipWindow;
 
@@ -45,6 +57,13 @@ class ItemSorter {
 	int32       _sortLimit;
 	bool        _sortLimitChanged;
 
+	// The items added since BeginDisplayList(). While the items of the
+	// previous display list are added again in the same order, the list is
+	// kept instead of being sorted again.
+	Common::Array<AddedItem> _added;
+	bool        _reusing;
+	uint        _reused;
+
 public:
 	ItemSorter(int capacity);
 	~ItemSorter();
@@ -69,6 +88,11 @@ public:
 	void IncSortLimit(int count);
 
 private:
+	SortItem *SortNewItem(int32 x, int32 y, int32 z, uint32 shape_num, uint32 frame_num, uint32 item_flags, uint32 ext_flags, uint16 item_num);
+	bool ReuseItem(int32 x, int32 y, int32 z, uint32 shape_num, uint32 frame_num, uint32 item_flags, uint32 ext_flags, uint16 item_num);
+	void StopReusing();
+	void ClearList();
+
 	bool PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootpad);
 };
 
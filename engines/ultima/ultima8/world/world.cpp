@@ -354,6 +354,9 @@ void World::worldStats() const {
 	} else {
 		g_debugger->debugPrintf("missing (null)\n");
 	}
+
+	if (_currentMap)
+		_currentMap->mapStats();
 }
 
 void World::save(Common::WriteStream *ws) {
@@ -99,6 +99,8 @@ void AdScene::setDefaults() {
 	_sceneGeometry = nullptr;
 #endif
 	_pfPointsNum = 0;
+	_pfCacheTilesX = _pfCacheTilesY = 0;
+	_pfCacheSignature = 0;
 	_persistentState = false;
 	_persistentStateSprites = true;
 
@@ -214,6 +216,7 @@ void AdScene::cleanup() {
 	}
 	_pfPath.clear();
 	_pfPointsNum = 0;
+	clearPathfindingCache();
 
 	for (uint32 i = 0; i < _objects.size(); i++) {
 		_gameRef->unregisterObject(_objects[i]);
@@ -243,6 +246,8 @@ bool AdScene::getPath(const BasePoint &source, const BasePoint &target, AdPath *
 		_pfTargetPath->reset();
 		_pfTargetPath->setReady(false);
 
+		validatePathfindingCache();
+
 		// prepare working path
 		pfPointsStart();
 
@@ -376,27 +381,39 @@ uint32 AdScene::getAlphaAt(int x, int y, bool colorCheck) {
 
 //////////////////////////////////////////////////////////////////////////
 bool AdScene::isBlockedAt(int x, int y, bool checkFreeObjects, BaseObject *requester) {
-	bool ret = true;
+	if (checkFreeObjects && isBlockedByObjectsAt(x, y, requester)) {
+		return true;
+	}
 
-	if (checkFreeObjects) {
-		for (uint32 i = 0; i < _objects.size(); i++) {
-			if (_objects[i]->_active && _objects[i] != requester && _objects[i]->_currentBlockRegion) {
-				if (_objects[i]->_currentBlockRegion->pointInRegion(x, y)) {
-					return true;
-				}
+	return isBlockedByRegionsAt(x, y);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool AdScene::isBlockedByObjectsAt(int x, int y, BaseObject *requester) {
+	for (uint32 i = 0; i < _objects.size(); i++) {
+		if (_objects[i]->_active && _objects[i] != requester && _objects[i]->_currentBlockRegion) {
+			if (_objects[i]->_currentBlockRegion->pointInRegion(x, y)) {
+				return true;
 			}
 		}
-		AdGame *adGame = (AdGame *)_gameRef;
-		for (uint32 i = 0; i < adGame->_objects.size(); i++) {
-			if (adGame->_objects[i]->_active && adGame->_objects[i] != requester && adGame->_objects[i]->_currentBlockRegion) {
-				if (adGame->_objects[i]->_currentBlockRegion->pointInRegion(x, y)) {
-					return true;
-				}
+	}
+	AdGame *adGame = (AdGame *)_gameRef;
+	for (uint32 i = 0; i < adGame->_objects.size(); i++) {
+		if (adGame->_objects[i]->_active && adGame->_objects[i] != requester && adGame->_objects[i]->_currentBlockRegion) {
+			if (adGame->_objects[i]->_currentBlockRegion->pointInRegion(x, y)) {
+				return true;
 			}
 		}
 	}
+	return false;
+}
 
 
+//////////////////////////////////////////////////////////////////////////
+bool AdScene::isBlockedByRegionsAt(int x, int y) {
+	bool ret = true;
+
 	if (_mainLayer) {
 		for (uint32 i = 0; i < _mainLayer->_nodes.size(); i++) {
 			AdSceneNode *node = _mainLayer->_nodes[i];
@@ -485,7 +502,7 @@ int AdScene::getPointsDist(const BasePoint &p1, const BasePoint &p2, BaseObject
 		y = y1;
 
 		for (xCount = x1; xCount < x2; xCount++) {
-			if (isBlockedAt(xCount, (int)y, true, requester)) {
+			if (isPathBlockedAt(xCount, (int)y, requester)) {
 				return -1;
 			}
 			y += yStep;
@@ -500,7 +517,7 @@ int AdScene::getPointsDist(const BasePoint &p1, const BasePoint &p2, BaseObject
 		x = x1;
 
 		for (yCount = y1; yCount < y2; yCount++) {
-			if (isBlockedAt((int)x, yCount, true, requester)) {
+			if (isPathBlockedAt((int)x, yCount, requester)) {
 				return -1;
 			}
 			x += xStep;
@@ -510,6 +527,101 @@ int AdScene::getPointsDist(const BasePoint &p1, const BasePoint &p2, BaseObject
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+bool AdScene::isPathBlockedAt(int x, int y, BaseObject *requester) {
+	// Blocking objects move around, so they are always checked directly
+	if (isBlockedByObjectsAt(x, y, requester)) {
+		return true;
+	}
+
+	if (x < 0 || y < 0 || x >= _pfCacheTilesX * kPfCacheTileSize || y >= _pfCacheTilesY * kPfCacheTileSize) {
+		return isBlockedByRegionsAt(x, y);
+	}
+
+	byte *&tile = _pfCacheTiles[(y / kPfCacheTileSize) * _pfCacheTilesX + x / kPfCacheTileSize];
+	if (!tile) {
+		tile = new byte[kPfCacheTileSize * kPfCacheTileSize];
+		memset(tile, kPfCacheUnknown, kPfCacheTileSize * kPfCacheTileSize);
+	}
+
+	byte &state = tile[(y % kPfCacheTileSize) * kPfCacheTileSize + x % kPfCacheTileSize];
+	if (state == kPfCacheUnknown) {
+		state = isBlockedByRegionsAt(x, y) ? kPfCacheBlocked : kPfCacheWalkable;
+	}
+	return state == kPfCacheBlocked;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 AdScene::getRegionsSignature() {
+	if (!_mainLayer) {
+		return 0;
+	}
+
+	// Anything isBlockedByRegionsAt() depends on
+	uint32 hash = 2166136261u;
+	const auto mix = [&hash](uint32 value) {
+		hash = (hash ^ value) * 16777619u;
+	};
+
+	mix(_mainLayer->_width);
+	mix(_mainLayer->_height);
+	for (uint32 i = 0; i < _mainLayer->_nodes.size(); i++) {
+		AdSceneNode *node = _mainLayer->_nodes[i];
+		if (node->_type != OBJECT_REGION) {
+			continue;
+		}
+
+		AdRegion *region = node->_region;
+		mix((uint32)(uintptr)region);
+		mix(region->_active | (region->isBlocked() << 1) | (region->hasDecoration() << 2));
+		mix(region->_points.size());
+		for (uint32 j = 0; j < region->_points.size(); j++) {
+			mix(region->_points[j]->x);
+			mix(region->_points[j]->y);
+		}
+	}
+	return hash;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void AdScene::validatePathfindingCache() {
+	uint32 signature = getRegionsSignature();
+	if (signature == _pfCacheSignature && !_pfCacheTiles.empty()) {
+		return;
+	}
+
+	clearPathfindingCache();
+	if (!_mainLayer) {
+		return;
+	}
+
+	_pfCacheSignature = signature;
+	_pfCacheTilesX = (_mainLayer->_width + kPfCacheTileSize - 1) / kPfCacheTileSize;
+	_pfCacheTilesY = (_mainLayer->_height + kPfCacheTileSize - 1) / kPfCacheTileSize;
+	if (_pfCacheTilesX <= 0 || _pfCacheTilesY <= 0) {
+		_pfCacheTilesX = _pfCacheTilesY = 0;
+		return;
+	}
+	_pfCacheTiles.resize(_pfCacheTilesX * _pfCacheTilesY);
+	for (uint32 i = 0; i < _pfCacheTiles.size(); i++) {
+		_pfCacheTiles[i] = nullptr;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void AdScene::clearPathfindingCache() {
+	for (uint32 i = 0; i < _pfCacheTiles.size(); i++) {
+		delete[] _pfCacheTiles[i];
+	}
+	_pfCacheTiles.clear();
+	_pfCacheTilesX = _pfCacheTilesY = 0;
+	_pfCacheSignature = 0;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 void AdScene::pathFinderStep() {
 	int i;
@@ -569,6 +681,10 @@ bool AdScene::initLoop() {
 	}
 #else
 	uint32 start = _gameRef->_currentTime;
+	if (!_pfReady) {
+		// Regions may have changed since the last slice
+		validatePathfindingCache();
+	}
 	while (!_pfReady && g_system->getMillis() - start <= _pfMaxTime) {
 		pathFinderStep();
 	}
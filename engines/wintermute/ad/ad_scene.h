@@ -200,6 +200,30 @@ private:
 	BaseObject *_pfRequester;
 	BaseArray<AdPathPoint *> _pfPath;
 
+	/**
+	 * Blocking state of the main layer's regions, filled in lazily by the
+	 * pathfinder, which tests the same pixels over and over while walking
+	 * the lines between waypoints. The pixels are stored in tiles allocated
+	 * on first use, and dropped whenever the regions change.
+	 */
+	enum {
+		kPfCacheTileSize = 64,
+		kPfCacheUnknown = 0,
+		kPfCacheWalkable = 1,
+		kPfCacheBlocked = 2
+	};
+	BaseArray<byte *> _pfCacheTiles;
+	int32 _pfCacheTilesX;
+	int32 _pfCacheTilesY;
+	uint32 _pfCacheSignature;
+
+	bool isBlockedByObjectsAt(int x, int y, BaseObject *requester);
+	bool isBlockedByRegionsAt(int x, int y);
+	bool isPathBlockedAt(int x, int y, BaseObject *requester);
+	uint32 getRegionsSignature();
+	void validatePathfindingCache();
+	void clearPathfindingCache();
+
 	int32 _offsetTop;
 	int32 _offsetLeft;
 
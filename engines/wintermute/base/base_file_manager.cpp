@@ -58,6 +58,9 @@ BaseFileManager::BaseFileManager(Common::Language lang, bool detectionMode) {
 	_detectionMode = detectionMode;
 	_language = lang;
 	_resources = nullptr;
+	// Games ship dozens of packages, so look members up in one merged
+	// index instead of asking every package in turn
+	_packages.setUseMemberIndex(true);
 	initResources();
 	initPaths();
 	registerPackages();
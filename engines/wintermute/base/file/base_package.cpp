@@ -30,6 +30,7 @@
 #include "engines/wintermute/base/file/base_file_entry.h"
 #include "engines/wintermute/base/file/dcpackage.h"
 #include "engines/wintermute/wintermute.h"
+#include "common/bufferedstream.h"
 #include "common/file.h"
 #include "common/stream.h"
 #include "common/debug.h"
@@ -117,6 +118,8 @@ PackageSet::PackageSet(Common::FSNode file, const Common::String &filename, bool
 	if (!stream) {
 		return;
 	}
+	// The directory is parsed with lots of tiny reads, read it in larger chunks
+	stream = Common::wrapBufferedSeekableReadStream(stream, 16384, DisposeAfterUse::YES);
 	if (searchSignature) {
 		uint32 offset;
 		if (!findPackageSignature(stream, &offset)) {
@@ -198,6 +201,7 @@ PackageSet::PackageSet(Common::FSNode file, const Common::String &filename, bool
 			upcName.toUppercase();
 			delete[] name;
 			name = nullptr;
+			Common::Path path(upcName, '\\');
 
 			offset = stream->readUint32LE();
 			offset += absoluteOffset;
@@ -209,7 +213,7 @@ PackageSet::PackageSet(Common::FSNode file, const Common::String &filename, bool
 				/* timeDate1 = */ stream->readUint32LE();
 				/* timeDate2 = */ stream->readUint32LE();
 			}
-			_filesIter = _files.find(upcName);
+			_filesIter = _files.find(path);
 			if (_filesIter == _files.end()) {
 				BaseFileEntry *fileEntry = new BaseFileEntry();
 				fileEntry->_package = pkg;
@@ -217,9 +221,9 @@ PackageSet::PackageSet(Common::FSNode file, const Common::String &filename, bool
 				fileEntry->_length = length;
 				fileEntry->_compressedLength = compLength;
 				fileEntry->_flags = flags;
-				fileEntry->_filename = upcName;
+				fileEntry->_filename = path;
 
-				_files[upcName] = Common::ArchiveMemberPtr(fileEntry);
+				_files[path] = Common::ArchiveMemberPtr(fileEntry);
 			} else {
 				// current package has higher priority than the registered
 				// TODO: This cast might be a bit ugly.
@@ -247,17 +251,12 @@ PackageSet::~PackageSet() {
 }
 
 bool PackageSet::hasFile(const Common::Path &path) const {
-	Common::String name = path.toString();
-	Common::String upcName = name;
-	upcName.toUppercase();
-	Common::HashMap<Common::String, Common::ArchiveMemberPtr>::const_iterator it;
-	it = _files.find(upcName.c_str());
-	return (it != _files.end());
+	return _files.contains(path);
 }
 
 int PackageSet::listMembers(Common::ArchiveMemberList &list) const {
-	Common::HashMap<Common::String, Common::ArchiveMemberPtr>::const_iterator it = _files.begin();
-	Common::HashMap<Common::String, Common::ArchiveMemberPtr>::const_iterator end = _files.end();
+	FileMap::const_iterator it = _files.begin();
+	FileMap::const_iterator end = _files.end();
 	int count = 0;
 	for (; it != end; ++it) {
 		const Common::ArchiveMemberPtr ptr(it->_value);
@@ -268,20 +267,15 @@ int PackageSet::listMembers(Common::ArchiveMemberList &list) const {
 }
 
 const Common::ArchiveMemberPtr PackageSet::getMember(const Common::Path &path) const {
-	Common::String name = path.toString();
-	Common::String upcName = name;
-	upcName.toUppercase();
-	Common::HashMap<Common::String, Common::ArchiveMemberPtr>::const_iterator it;
-	it = _files.find(upcName.c_str());
+	FileMap::const_iterator it = _files.find(path);
+	if (it == _files.end()) {
+		return Common::ArchiveMemberPtr();
+	}
 	return Common::ArchiveMemberPtr(it->_value);
 }
 
 Common::SeekableReadStream *PackageSet::createReadStreamForMember(const Common::Path &path) const {
-	Common::String name = path.toString();
-	Common::String upcName = name;
-	upcName.toUppercase();
-	Common::HashMap<Common::String, Common::ArchiveMemberPtr>::const_iterator it;
-	it = _files.find(upcName.c_str());
+	FileMap::const_iterator it = _files.find(path);
 	if (it != _files.end()) {
 		return it->_value->createReadStream();
 	}
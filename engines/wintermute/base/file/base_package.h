@@ -83,8 +83,10 @@ private:
 	byte _priority;
 	uint32 _version;
 	Common::Array<BasePackage *> _packages;
-	Common::HashMap<Common::String, Common::ArchiveMemberPtr> _files;
-	Common::HashMap<Common::String, Common::ArchiveMemberPtr>::iterator _filesIter;
+	// Keyed by the path of the member, with '\\' separators as stored in the package
+	typedef Common::HashMap<Common::Path, Common::ArchiveMemberPtr, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> FileMap;
+	FileMap _files;
+	FileMap::iterator _filesIter;
 };
 
 } // End of namespace Wintermute
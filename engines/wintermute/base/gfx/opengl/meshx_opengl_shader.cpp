@@ -135,16 +135,12 @@ bool XMeshOpenGLShader::renderFlatShadowModel() {
 	return true;
 }
 
-bool XMeshOpenGLShader::update(FrameNode *parentFrame) {
-	XMesh::update(parentFrame);
-
+void XMeshOpenGLShader::uploadVertices() {
 	float *vertexData = _skinMesh->_mesh->_vertexData;
 	uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
 
 	glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
 	glBufferSubData(GL_ARRAY_BUFFER, 0, 4 * XSkinMeshLoader::kVertexComponentCount * vertexCount, vertexData);
-
-	return true;
 }
 
 } // namespace Wintermute
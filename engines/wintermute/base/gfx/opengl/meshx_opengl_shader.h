@@ -44,7 +44,7 @@ public:
 	bool loadFromXData(const Common::String &filename, XFileData *xobj, Common::Array<MaterialReference> &materialReferences) override;
 	bool render(XModel *model) override;
 	bool renderFlatShadowModel() override;
-	bool update(FrameNode *parentFrame) override;
+	void uploadVertices() override;
 
 protected:
 	GLuint _vertexBuffer;
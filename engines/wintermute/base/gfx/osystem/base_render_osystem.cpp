@@ -40,6 +40,8 @@
 #include "common/config-manager.h"
 
 #define DIRTY_RECT_LIMIT 800
+// Past this many separate dirty regions, they are merged into their bounds
+#define DIRTY_RECT_MAX_COUNT 16
 
 namespace Wintermute {
 
@@ -57,7 +59,6 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -74,8 +75,7 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		it = _renderQueue.erase(it);
 		delete ticket;
 	}
-
-	delete _dirtyRect;
+	_ticketMap.clear();
 
 	_renderSurface->free();
 	delete _renderSurface;
@@ -158,8 +158,7 @@ bool BaseRenderOSystem::forcedFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -199,8 +198,7 @@ bool BaseRenderOSystem::flip() {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
 		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
@@ -304,29 +302,54 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
 		RenderQueueIterator it = _lastFrameIter;
 		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
-					drawFromQueuedTicket(it);
-				}
-				return;
-			}
+		// Most tickets come in the same order as last frame, so try the next one first.
+		if (it == _renderQueue.end() || !(**it == compare) || !(*it)->_isValid) {
+			it = findQueuedTicket(compare);
+		}
+		if (it != _renderQueue.end()) {
+			drawFromQueuedTicket(it);
+			return;
 		}
 	}
 	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
-	if (!_disableDirtyRects) {
-		drawFromTicket(ticket);
-	} else {
-		ticket->_wantsDraw = true;
-		_renderQueue.push_back(ticket);
-		drawFromSurface(ticket);
+	drawFromTicket(ticket);
+}
+
+BaseRenderOSystem::RenderQueueIterator BaseRenderOSystem::findQueuedTicket(const RenderTicket &compare) {
+	TicketMap::iterator bucket = _ticketMap.find(compare.getHash());
+	if (bucket == _ticketMap.end()) {
+		return _renderQueue.end();
+	}
+
+	const Common::Array<RenderQueueIterator> &tickets = bucket->_value;
+	for (uint i = 0; i < tickets.size(); i++) {
+		RenderTicket *ticket = *tickets[i];
+		if (!ticket->_wantsDraw && ticket->_isValid && *ticket == compare) {
+			return tickets[i];
+		}
+	}
+	return _renderQueue.end();
+}
+
+void BaseRenderOSystem::addTicketToMap(const RenderQueueIterator &ticket) {
+	_ticketMap[(*ticket)->getHash()].push_back(ticket);
+}
+
+void BaseRenderOSystem::removeTicketFromMap(const RenderQueueIterator &ticket) {
+	TicketMap::iterator bucket = _ticketMap.find((*ticket)->getHash());
+	if (bucket == _ticketMap.end()) {
+		return;
+	}
+
+	Common::Array<RenderQueueIterator> &tickets = bucket->_value;
+	for (uint i = 0; i < tickets.size(); i++) {
+		if (tickets[i] == ticket) {
+			tickets.remove_at(i);
+			break;
+		}
+	}
+	if (tickets.empty()) {
+		_ticketMap.erase(bucket);
 	}
 }
 
@@ -362,6 +385,7 @@ void BaseRenderOSystem::drawFromTicket(RenderTicket *renderTicket) {
 		--_lastFrameIter;
 		addDirtyRect(renderTicket->_dstRect);
 	}
+	addTicketToMap(_lastFrameIter);
 }
 
 void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket) {
@@ -371,10 +395,10 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 
 	++_lastFrameIter;
 	// Not in the same order?
-	if (*_lastFrameIter != renderTicket) {
+	if (_lastFrameIter == _renderQueue.end() || *_lastFrameIter != renderTicket) {
 		--_lastFrameIter;
 		// Remove the ticket from the list
-		assert(*_lastFrameIter != renderTicket);
+		removeTicketFromMap(ticket);
 		_renderQueue.erase(ticket);
 		// Is not in order, so readd it as if it was a new ticket
 		drawFromTicket(renderTicket);
@@ -382,12 +406,32 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 }
 
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	if (!rect.intersects(_renderRect)) {
+		return;
+	}
+	Common::Rect newRect(rect);
+	newRect.clip(_renderRect);
+
+	// Merge with the regions it overlaps, the merged rect may then overlap others.
+	for (uint i = 0; i < _dirtyRects.size();) {
+		if (_dirtyRects[i].intersects(newRect)) {
+			newRect.extend(_dirtyRects[i]);
+			_dirtyRects.remove_at(i);
+			i = 0;
+		} else {
+			i++;
+		}
+	}
+	_dirtyRects.push_back(newRect);
+
+	if (_dirtyRects.size() > DIRTY_RECT_MAX_COUNT) {
+		Common::Rect bounds(_dirtyRects[0]);
+		for (uint i = 1; i < _dirtyRects.size(); i++) {
+			bounds.extend(_dirtyRects[i]);
+		}
+		_dirtyRects.clear();
+		_dirtyRects.push_back(bounds);
 	}
-	_dirtyRect->clip(_renderRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -400,45 +444,69 @@ void BaseRenderOSystem::drawTickets() {
 		if ((*it)->_wantsDraw == false) {
 			RenderTicket *ticket = *it;
 			addDirtyRect((*it)->_dstRect);
+			removeTicketFromMap(it);
 			it = _renderQueue.erase(it);
 			delete ticket;
 		} else {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
-		it = _renderQueue.begin();
-		while (it != _renderQueue.end()) {
-			RenderTicket *ticket = *it;
-			ticket->_wantsDraw = false;
-			++it;
+
+	if (!_dirtyRects.empty()) {
+		_lastFrameIter = _renderQueue.end();
+		for (uint i = 0; i < _dirtyRects.size(); i++) {
+			drawDirtyRect(_dirtyRects[i]);
 		}
+	}
+
+	// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
+	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		(*it)->_wantsDraw = false;
+	}
+
+	if (_dirtyRects.empty()) {
 		return;
 	}
 
 	it = _renderQueue.begin();
-	_lastFrameIter = _renderQueue.end();
+	// Clean out the old tickets
+	while (it != _renderQueue.end()) {
+		if ((*it)->_isValid == false) {
+			RenderTicket *ticket = *it;
+			addDirtyRect((*it)->_dstRect);
+			removeTicketFromMap(it);
+			it = _renderQueue.erase(it);
+			delete ticket;
+		} else {
+			++it;
+		}
+	}
+
+}
+
+void BaseRenderOSystem::drawDirtyRect(const Common::Rect &dirtyRect) {
+	RenderQueueIterator it = _renderQueue.begin();
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
 	// the background color. Typical use-case: Fullscreen FMVs.
 	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
+	if (it != _renderQueue.end() && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
 		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
+		if (dirtyRect != (*it)->_dstRect) {
 			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+			_renderSurface->fillRect(dirtyRect, _clearColor);
 		}
 		// Otherwise Do NOT fill.
 	} else {
 		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		_renderSurface->fillRect(dirtyRect, _clearColor);
 	}
 	for (; it != _renderQueue.end(); ++it) {
 		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
+		if (ticket->_dstRect.intersects(dirtyRect)) {
 			// dstClip is the area we want redrawn.
 			Common::Rect dstClip(ticket->_dstRect);
 			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
+			dstClip.clip(dirtyRect);
 			// we need to keep track of the position to redraw the dirty rect
 			Common::Rect pos(dstClip);
 			int16 offsetX = ticket->_dstRect.left;
@@ -449,24 +517,8 @@ void BaseRenderOSystem::drawTickets() {
 			drawFromSurface(ticket, &pos, &dstClip);
 			_needsFlip = true;
 		}
-		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
-		ticket->_wantsDraw = false;
 	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-
-	it = _renderQueue.begin();
-	// Clean out the old tickets
-	while (it != _renderQueue.end()) {
-		if ((*it)->_isValid == false) {
-			RenderTicket *ticket = *it;
-			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
-		} else {
-			++it;
-		}
-	}
-
+	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(dirtyRect.left, dirtyRect.top), _renderSurface->pitch, dirtyRect.left, dirtyRect.top, dirtyRect.width(), dirtyRect.height());
 }
 
 // Replacement for SDL2's SDL_RenderCopy
@@ -588,6 +640,7 @@ void BaseRenderOSystem::endSaveLoad() {
 		it = _renderQueue.erase(it);
 		delete ticket;
 	}
+	_ticketMap.clear();
 	// HACK: After a save the buffer will be drawn before the scripts get to update it,
 	// so just skip this single frame.
 	_skipThisFrame = true;
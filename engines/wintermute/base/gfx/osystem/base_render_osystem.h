@@ -32,6 +32,8 @@
 
 #include "common/rect.h"
 #include "common/list.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 
 #include "graphics/surface.h"
 #include "graphics/transform_struct.h"
@@ -53,6 +55,9 @@ class RenderTicket;
  * they came before, on, or after the drawNum they had last frame. Everything else
  * being equal, this information is then used to check whether the draw order changed,
  * which will then create a need for redrawing, as we draw with an alpha-channel here.
+ * Tickets are looked up by the hash of their draw arguments, so a ticket that moved
+ * in the queue is still found, and only the bounds of tickets that were added, removed
+ * or reordered are marked dirty. Separate dirty regions are redrawn separately.
  *
  * There is also a draw path that draws without tickets, for debugging purposes,
  * as well as to accommodate situations with large enough amounts of draw calls,
@@ -122,6 +127,18 @@ private:
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
+	/**
+	 * Find a ticket from last frame that has not been drawn yet this frame
+	 * and matches the draw arguments of compare.
+	 * @return iterator to the ticket, or the end of the render queue.
+	 */
+	RenderQueueIterator findQueuedTicket(const RenderTicket &compare);
+	void addTicketToMap(const RenderQueueIterator &ticket);
+	void removeTicketFromMap(const RenderQueueIterator &ticket);
+	/**
+	 * Draw the tickets intersecting a dirty rect.
+	 */
+	void drawDirtyRect(const Common::Rect &dirtyRect);
 	/**
 	 * Traverse the tickets that are dirty, and draw them
 	 */
@@ -130,8 +147,11 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	typedef Common::HashMap<uint32, Common::Array<RenderQueueIterator> > TicketMap;
+
+	Common::Array<Common::Rect> _dirtyRects;
 	Common::List<RenderTicket *> _renderQueue;
+	TicketMap _ticketMap;
 
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
@@ -44,6 +44,18 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 	        _isValid(true),
 	        _wantsDraw(true),
 	        _transform(transform) {
+	_hash = (uint32)(uintptr)owner;
+	const int32 values[] = {
+		_srcRect.left, _srcRect.top, _srcRect.right, _srcRect.bottom,
+		_dstRect.left, _dstRect.top, _dstRect.right, _dstRect.bottom,
+		_transform._angle, _transform._flip, _transform._zoom.x, _transform._zoom.y,
+		_transform._offset.x, _transform._offset.y, _transform._alphaDisable, (int32)_transform._rgbaMod,
+		_transform._blendMode, _transform._numTimesX, _transform._numTimesY
+	};
+	for (uint i = 0; i < ARRAYSIZE(values); i++) {
+		_hash = (_hash ^ (uint32)values[i]) * 16777619;
+	}
+
 	if (surf) {
 		_surface = new Graphics::Surface();
 		_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
@@ -51,7 +51,7 @@ class BaseSurfaceOSystem;
 class RenderTicket {
 public:
 	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform);
-	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()) {}
+	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()), _hash(0) {}
 	~RenderTicket();
 	const Graphics::Surface *getSurface() const { return _surface; }
 	// Non-dirty-rects:
@@ -69,9 +69,15 @@ public:
 	BaseSurfaceOSystem *_owner;
 	bool operator==(const RenderTicket &a) const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
+	/**
+	 * Hash of the draw arguments compared by operator==, used to find
+	 * the matching ticket of the previous frame without walking the queue.
+	 */
+	uint32 getHash() const { return _hash; }
 private:
 	Graphics::Surface *_surface;
 	Common::Rect _srcRect;
+	uint32 _hash;
 };
 
 } // End of namespace Wintermute
@@ -321,6 +321,18 @@ bool FrameNode::updateMeshes() {
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+void FrameNode::collectMeshes(BaseArray<XMesh *> &meshes, BaseArray<FrameNode *> &frames) {
+	for (uint32 i = 0; i < _meshes.size(); i++) {
+		meshes.add(_meshes[i]);
+		frames.add(this);
+	}
+
+	for (uint32 i = 0; i < _frames.size(); i++) {
+		_frames[i]->collectMeshes(meshes, frames);
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool FrameNode::resetMatrices() {
 	_transformationMatrix = _originalMatrix;
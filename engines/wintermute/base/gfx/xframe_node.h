@@ -50,6 +50,10 @@ public:
 
 	bool updateMatrices(Math::Matrix4 &parentMat);
 	bool updateMeshes();
+	/**
+	 * Append the meshes of this frame and its children, along with the frame owning each of them.
+	 */
+	void collectMeshes(BaseArray<XMesh *> &meshes, BaseArray<FrameNode *> &frames);
 	bool resetMatrices();
 	bool render(XModel *model);
 	bool renderFlatShadowModel();
@@ -80,7 +80,7 @@ bool XMesh::findBones(FrameNode *rootFrame) {
 	if (!_skinnedMesh) {
 		return true;
 	}
-	auto skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	const auto &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
 
 	_boneMatrices.resize(skinWeightsList.size());
 
@@ -99,23 +99,42 @@ bool XMesh::findBones(FrameNode *rootFrame) {
 
 //////////////////////////////////////////////////////////////////////////
 bool XMesh::update(FrameNode *parentFrame) {
+	if (!updateVertices(parentFrame)) {
+		return false;
+	}
+
+	uploadVertices();
+	return true;
+}
+
+// Add weight * (matrix * (v,1)) to dst, matrix is stored row major
+static inline void addWeightedTransform(float *dst, const float *m, const float *v, float weight) {
+	float x = v[0], y = v[1], z = v[2];
+	dst[0] += (m[0] * x + m[1] * y + m[2] * z + m[3]) * weight;
+	dst[1] += (m[4] * x + m[5] * y + m[6] * z + m[7]) * weight;
+	dst[2] += (m[8] * x + m[9] * y + m[10] * z + m[11]) * weight;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool XMesh::updateVertices(FrameNode *parentFrame) {
 	float *vertexData = _skinMesh->_mesh->_vertexData;
 	if (vertexData == nullptr) {
 		return false;
 	}
 
-	float *vertexPositionData = _skinMesh->_mesh->_vertexPositionData;
-	float *vertexNormalData = _skinMesh->_mesh->_vertexNormalData;
+	const float *vertexPositionData = _skinMesh->_mesh->_vertexPositionData;
+	const float *vertexNormalData = _skinMesh->_mesh->_vertexNormalData;
 	uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
-	auto skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	const auto &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+
+	const uint32 stride = XSkinMeshLoader::kVertexComponentCount;
 
 	// update skinned mesh
 	if (_skinnedMesh) {
-		BaseArray<Math::Matrix4> finalBoneMatrices;
-		finalBoneMatrices.resize(_boneMatrices.size());
+		_finalBoneMatrices.resize(_boneMatrices.size());
 
 		for (uint i = 0; i < skinWeightsList.size(); ++i) {
-			finalBoneMatrices[i] = *_boneMatrices[i] * skinWeightsList[i]._offsetMatrix;
+			_finalBoneMatrices[i] = *_boneMatrices[i] * skinWeightsList[i]._offsetMatrix;
 		}
 
 		// the new vertex coordinates are the weighted sum of the product
@@ -123,7 +142,7 @@ bool XMesh::update(FrameNode *parentFrame) {
 		// to be able too add the weighted summands together, we reset everything to zero first
 		for (uint32 i = 0; i < vertexCount; ++i) {
 			for (int j = 0; j < 3; ++j) {
-				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] = 0.0f;
+				vertexData[i * stride + XSkinMeshLoader::kPositionOffset + j] = 0.0f;
 			}
 		}
 
@@ -132,55 +151,47 @@ bool XMesh::update(FrameNode *parentFrame) {
 			// of the bone transformation with the coordinates of the static pose,
 			// weighted by the weight for the particular vertex
 			// repeating this procedure for all bones gives the new pose
-			for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
-				uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
-				Math::Vector3d pos;
-				pos.setData(vertexPositionData + vertexIndex * 3);
-				finalBoneMatrices[boneIndex].transform(&pos, true);
-				pos *= skinWeightsList[boneIndex]._vertexWeights[i];
-
-				for (uint j = 0; j < 3; ++j) {
-					vertexData[vertexIndex * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] += pos.getData()[j];
-				}
+			const float *m = _finalBoneMatrices[boneIndex].getData();
+			const auto &vertexIndices = skinWeightsList[boneIndex]._vertexIndices;
+			const auto &vertexWeights = skinWeightsList[boneIndex]._vertexWeights;
+			for (uint i = 0; i < vertexIndices.size(); ++i) {
+				uint32 vertexIndex = vertexIndices[i];
+				addWeightedTransform(vertexData + vertexIndex * stride + XSkinMeshLoader::kPositionOffset,
+				                     m, vertexPositionData + vertexIndex * 3, vertexWeights[i]);
 			}
 		}
 
 		// now we have to update the vertex normals as well, so prepare the bone transformations
 		for (uint i = 0; i < skinWeightsList.size(); ++i) {
-			finalBoneMatrices[i].transpose();
-			finalBoneMatrices[i].inverse();
+			_finalBoneMatrices[i].transpose();
+			_finalBoneMatrices[i].inverse();
 		}
 
 		// reset so we can form the weighted sums
 		for (uint32 i = 0; i < vertexCount; ++i) {
 			for (int j = 0; j < 3; ++j) {
-				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kNormalOffset + j] = 0.0f;
+				vertexData[i * stride + XSkinMeshLoader::kNormalOffset + j] = 0.0f;
 			}
 		}
 
 		for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
-			for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
-				uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
-				Math::Vector3d pos;
-				pos.setData(vertexNormalData + vertexIndex * 3);
-				finalBoneMatrices[boneIndex].transform(&pos, true);
-				pos *= skinWeightsList[boneIndex]._vertexWeights[i];
-
-				for (uint j = 0; j < 3; ++j) {
-					vertexData[vertexIndex * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kNormalOffset + j] += pos.getData()[j];
-				}
+			const float *m = _finalBoneMatrices[boneIndex].getData();
+			const auto &vertexIndices = skinWeightsList[boneIndex]._vertexIndices;
+			const auto &vertexWeights = skinWeightsList[boneIndex]._vertexWeights;
+			for (uint i = 0; i < vertexIndices.size(); ++i) {
+				uint32 vertexIndex = vertexIndices[i];
+				addWeightedTransform(vertexData + vertexIndex * stride + XSkinMeshLoader::kNormalOffset,
+				                     m, vertexNormalData + vertexIndex * 3, vertexWeights[i]);
 			}
 		}
 
 	//updateNormals();
 	} else { // update static
+		const float *m = parentFrame->getCombinedMatrix()->getData();
 		for (uint32 i = 0; i < vertexCount; ++i) {
-			Math::Vector3d pos(vertexPositionData + 3 * i);
-			parentFrame->getCombinedMatrix()->transform(&pos, true);
-
-			for (uint j = 0; j < 3; ++j) {
-				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] = pos.getData()[j];
-			}
+			float *dst = vertexData + i * stride + XSkinMeshLoader::kPositionOffset;
+			dst[0] = dst[1] = dst[2] = 0.0f;
+			addWeightedTransform(dst, m, vertexPositionData + 3 * i, 1.0f);
 		}
 	}
 
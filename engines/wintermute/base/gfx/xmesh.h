@@ -54,6 +54,17 @@ public:
 	virtual bool loadFromXData(const Common::String &filename, XFileData *xobj, Common::Array<MaterialReference> &materialReferences);
 	bool findBones(FrameNode *rootFrame);
 	virtual bool update(FrameNode *parentFrame);
+	/**
+	 * Compute the skinned or transformed vertices and the bounding box.
+	 * Only this mesh is touched, so several meshes can be updated on
+	 * worker threads at the same time.
+	 */
+	bool updateVertices(FrameNode *parentFrame);
+	/**
+	 * Hand the vertices computed by updateVertices() over to the renderer.
+	 * Must be called on the main thread.
+	 */
+	virtual void uploadVertices() {}
 	virtual bool render(XModel *model) = 0;
 	virtual bool renderFlatShadowModel() = 0;
 	bool updateShadowVol(ShadowVolume *shadow, Math::Matrix4 &modelMat, const Math::Vector3d &light, float extrusionDepth);
@@ -83,6 +94,8 @@ protected:
 	SkinMeshHelper *_skinMesh;
 
 	BaseArray<Math::Matrix4 *> _boneMatrices;
+	// Scratch space for the skinning matrices, kept between updates
+	BaseArray<Math::Matrix4> _finalBoneMatrices;
 
 	Common::Array<uint32> _adjacency;
 
@@ -26,6 +26,8 @@
  */
 
 #include "common/compression/deflate.h"
+#include "common/jobsystem.h"
+#include "common/system.h"
 
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/base/base_game.h"
@@ -374,12 +376,48 @@ bool XModel::update() {
 		tempMat.setToIdentity();
 		_rootFrame->updateMatrices(tempMat);
 
-		return _rootFrame->updateMeshes();
+		return updateMeshes();
 	} else {
 		return false;
 	}
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool XModel::updateMeshes() {
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (jobSystem->getWorkerCount() == 0) {
+		return _rootFrame->updateMeshes();
+	}
+
+	_updateMeshes.clear();
+	_updateFrames.clear();
+	_rootFrame->collectMeshes(_updateMeshes, _updateFrames);
+	if (_updateMeshes.size() < 2) {
+		return _rootFrame->updateMeshes();
+	}
+
+	// Skinning only touches the data of each mesh, so the meshes are
+	// skinned in parallel, and handed to the renderer afterwards.
+	_updateResults.resize(_updateMeshes.size());
+	jobSystem->parallelFor(_updateMeshes.size(), updateMeshRange, this);
+
+	for (uint32 i = 0; i < _updateMeshes.size(); i++) {
+		if (!_updateResults[i]) {
+			return false;
+		}
+		_updateMeshes[i]->uploadVertices();
+	}
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void XModel::updateMeshRange(uint32 begin, uint32 end, void *refCon) {
+	XModel *model = static_cast<XModel *>(refCon);
+	for (uint32 i = begin; i < end; i++) {
+		model->_updateResults[i] = model->_updateMeshes[i]->updateVertices(model->_updateFrames[i]);
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool XModel::playAnim(int channel, const Common::String &name, uint32 transitionTime, bool forceReset, uint32 stopTransitionTime) {
 	if (channel < 0 || channel >= X_NUM_ANIMATION_CHANNELS) {
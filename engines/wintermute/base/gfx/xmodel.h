@@ -47,6 +47,7 @@ class FrameNode;
 class Material;
 class ShadowVolume;
 class XFileData;
+class XMesh;
 
 struct MaterialReference {
 	Common::String _name;
@@ -191,6 +192,13 @@ private:
 
 	void updateBoundingRect();
 	void static inline updateRect(Rect32 *rc, int32 x, int32 y);
+	bool updateMeshes();
+	static void updateMeshRange(uint32 begin, uint32 end, void *refCon);
+
+	// Meshes being updated by updateMeshes(), kept between frames
+	BaseArray<XMesh *> _updateMeshes;
+	BaseArray<FrameNode *> _updateFrames;
+	BaseArray<bool> _updateResults;
 	Rect32 _drawingViewport;
 	Math::Matrix4 _lastViewMat;
 	Math::Matrix4 _lastProjMat;
@@ -34,6 +34,8 @@
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/utils/utils.h"
 
+#include "common/algorithm.h"
+
 namespace Wintermute {
 
 IMPLEMENT_PERSISTENT(ScEngine, true)
@@ -351,12 +353,14 @@ bool ScEngine::tick() {
 		// time sliced script
 		if (_scripts[i]->_timeSlice > 0) {
 			uint32 startTime = g_system->getMillis();
+			uint32 instructions = 0;
 			while (_scripts[i]->_state == SCRIPT_RUNNING && g_system->getMillis() - startTime < _scripts[i]->_timeSlice) {
 				_currentScript = _scripts[i];
 				_scripts[i]->executeInstruction();
+				instructions++;
 			}
 			if (_isProfiling && _scripts[i]->_filename) {
-				addScriptTime(_scripts[i]->_filename, g_system->getMillis() - startTime);
+				addScriptTime(_scripts[i], g_system->getMillis() - startTime, instructions);
 			}
 		}
 
@@ -368,12 +372,14 @@ bool ScEngine::tick() {
 				startTime = g_system->getMillis();
 			}
 
+			uint32 instructions = 0;
 			while (_scripts[i]->_state == SCRIPT_RUNNING) {
 				_currentScript = _scripts[i];
 				_scripts[i]->executeInstruction();
+				instructions++;
 			}
 			if (isProfiling && _scripts[i]->_filename) {
-				addScriptTime(_scripts[i]->_filename, g_system->getMillis() - startTime);
+				addScriptTime(_scripts[i], g_system->getMillis() - startTime, instructions);
 			}
 		}
 		_currentScript = nullptr;
@@ -582,14 +588,57 @@ bool ScEngine::clearGlobals(bool includingNatives) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-void ScEngine::addScriptTime(const char *filename, uint32 time) {
+void ScEngine::addScriptTime(ScScript *script, uint32 time, uint32 instructions) {
 	if (!_isProfiling) {
 		return;
 	}
 
-	AnsiString fileName = filename;
-	fileName.toLowercase();
-	_scriptTimes[fileName] += time;
+	AnsiString name = script->_filename;
+	name.toLowercase();
+	if (script->_thread && script->_threadEvent) {
+		name += (script->_methodThread ? "." : ":");
+		name += script->_threadEvent;
+	}
+
+	ScriptProfile &profile = _scriptTimes[name];
+	profile._time += time;
+	profile._instructions += instructions;
+	profile._runs++;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::getProfilingStats(Common::Array<ScriptProfile> &stats) const {
+	stats.clear();
+	stats.reserve(_scriptTimes.size());
+
+	for (ScriptTimes::const_iterator it = _scriptTimes.begin(); it != _scriptTimes.end(); ++it) {
+		stats.push_back(it->_value);
+		stats.back()._name = it->_key;
+	}
+
+	Common::sort(stats.begin(), stats.end(), [](const ScriptProfile &a, const ScriptProfile &b) {
+		if (a._time != b._time) {
+			return a._time > b._time;
+		}
+		return a._instructions > b._instructions;
+	});
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 ScEngine::getProfilingDuration() const {
+	if (!_isProfiling) {
+		return 0;
+	}
+	return g_system->getMillis() - _profilingStartTime;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::resetProfiling() {
+	_scriptTimes.clear();
+	_profilingStartTime = g_system->getMillis();
 }
 
 
@@ -600,9 +649,7 @@ void ScEngine::enableProfiling() {
 	}
 
 	// destroy old data, if any
-	_scriptTimes.clear();
-
-	_profilingStartTime = g_system->getMillis();
+	resetProfiling();
 	_isProfiling = true;
 }
 
@@ -620,27 +667,18 @@ void ScEngine::disableProfiling() {
 
 //////////////////////////////////////////////////////////////////////////
 void ScEngine::dumpStats() {
-	error("DumpStats not ported to ScummVM yet");
-	/*  uint32 totalTime = g_system->getMillis() - _profilingStartTime;
-
-	    typedef std::vector <std::pair<uint32, std::string> > TimeVector;
-	    TimeVector times;
+	uint32 totalTime = getProfilingDuration();
 
-	    ScriptTimes::iterator it;
-	    for (it = _scriptTimes.begin(); it != _scriptTimes.end(); ++it) {
-	        times.push_back(std::pair<uint32, std::string> (it->_value, it->_key));
-	    }
-	    std::sort(times.begin(), times.end());
+	Common::Array<ScriptProfile> stats;
+	getProfilingStats(stats);
 
+	_gameRef->LOG(0, "***** Script profiling information: *****");
+	_gameRef->LOG(0, "  %-40s %fs", "Total execution time", (float)totalTime / 1000);
 
-	    TimeVector::reverse_iterator tit;
-
-	    _gameRef->LOG(0, "***** Script profiling information: *****");
-	    _gameRef->LOG(0, "  %-40s %fs", "Total execution time", (float)totalTime / 1000);
-
-	    for (tit = times.rbegin(); tit != times.rend(); ++tit) {
-	        _gameRef->LOG(0, "  %-40s %fs (%f%%)", tit->second.c_str(), (float)tit->first / 1000, (float)tit->first / (float)totalTime * 100);
-	    }*/
+	for (uint32 i = 0; i < stats.size(); i++) {
+		_gameRef->LOG(0, "  %-40s %fs (%f%%), %u instructions in %u runs", stats[i]._name.c_str(), (float)stats[i]._time / 1000,
+		              totalTime ? (float)stats[i]._time / (float)totalTime * 100 : 0.0f, stats[i]._instructions, stats[i]._runs);
+	}
 }
 
 } // End of namespace Wintermute
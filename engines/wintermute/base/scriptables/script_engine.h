@@ -102,7 +102,26 @@ public:
 		return _isProfiling;
 	}
 
-	void addScriptTime(const char *filename, uint32 Time);
+	struct ScriptProfile {
+		Common::String _name;
+		uint32 _time;
+		uint32 _instructions;
+		uint32 _runs;
+
+		ScriptProfile() : _time(0), _instructions(0), _runs(0) {}
+	};
+
+	/**
+	 * Account a time slice of a script, keyed by its file name and,
+	 * for event and method threads, the name of the handler.
+	 */
+	void addScriptTime(ScScript *script, uint32 time, uint32 instructions);
+	/**
+	 * Get the profiling data collected so far, most expensive scripts first.
+	 */
+	void getProfilingStats(Common::Array<ScriptProfile> &stats) const;
+	uint32 getProfilingDuration() const;
+	void resetProfiling();
 	void dumpStats();
 
 private:
@@ -111,7 +130,7 @@ private:
 	bool _isProfiling;
 	uint32 _profilingStartTime;
 
-	typedef Common::HashMap<Common::String, uint32> ScriptTimes;
+	typedef Common::HashMap<Common::String, ScriptProfile> ScriptTimes;
 	ScriptTimes _scriptTimes;
 
 };
@@ -115,27 +115,32 @@ ScValue *ScStack::getAt(int index) {
 void ScStack::correctParams(uint32 expectedParams) {
 	uint32 nuParams = (uint32)pop()->getInt();
 
+	// Values are moved between the parameters and the unused part
+	// above the stack pointer, so that nothing is reallocated.
 	if (expectedParams < nuParams) { // too many params
 		while (expectedParams < nuParams) {
 			//Pop();
-			delete _values[_sP - expectedParams];
+			ScValue *val = _values[_sP - expectedParams];
 			_values.remove_at(_sP - expectedParams);
+			val->cleanup();
+			_values.add(val);
 			nuParams--;
 			_sP--;
 		}
 	} else if (expectedParams > nuParams) { // need more params
 		while (expectedParams > nuParams) {
 			//Push(null_val);
-			ScValue *nullVal = new ScValue(_gameRef);
-			nullVal->setNULL();
-			_values.insert_at(_sP - nuParams + 1, nullVal);
-			nuParams++;
-			_sP++;
-
+			ScValue *nullVal;
 			if ((int32)_values.size() > _sP + 1) {
-				delete _values[_values.size() - 1];
+				nullVal = _values[_values.size() - 1];
 				_values.remove_at(_values.size() - 1);
+				nullVal->cleanup();
+			} else {
+				nullVal = new ScValue(_gameRef);
 			}
+			_values.insert_at(_sP - nuParams + 1, nullVal);
+			nuParams++;
+			_sP++;
 		}
 	}
 }
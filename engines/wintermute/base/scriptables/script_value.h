@@ -82,6 +82,11 @@ public:
 	bool isObject();
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
 	ScValue *getProp(const char *name);
+	/**
+	 * Look up a property stored on this value itself, without asking natives.
+	 * Unlike propExists() followed by getProp(), this costs a single lookup.
+	 */
+	ScValue *findProp(const Common::String &name);
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
 private:
@@ -35,6 +35,7 @@ Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("help", WRAP_METHOD(Console, Cmd_Help));
+	registerCmd(PROFILE_CMD, WRAP_METHOD(Console, Cmd_Profile));
 	// Actual (script) debugger commands
 	registerCmd(STEP_CMD, WRAP_METHOD(Console, Cmd_Step));
 	registerCmd(CONTINUE_CMD, WRAP_METHOD(Console, Cmd_Continue));
@@ -98,6 +99,8 @@ void Console::printUsage(const Common::String &command) {
 		debugPrintf("Usage: %s <name> to print value of <name>\n", command.c_str());
 	} else if (command.equals(SET_CMD)) {
 		debugPrintf("Usage: %s <name> = <value> to set <name> to <value>\n", command.c_str());
+	} else if (command.equals(PROFILE_CMD)) {
+		debugPrintf("Usage: %s [on|off|reset|<count>] to control script profiling or print the <count> most expensive entries\n", command.c_str());
 	} else {
 		debugPrintf("No help about this command, sorry.\n");
 	}
@@ -291,6 +294,42 @@ bool Console::Cmd_Set(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_Profile(int argc, const char **argv) {
+	if (argc > 2) {
+		printUsage(argv[0]);
+		return true;
+	}
+
+	Common::String arg = argc == 2 ? argv[1] : "";
+	if (arg == "on") {
+		CONTROLLER->setProfiling(true);
+		debugPrintf("Script profiling enabled\n");
+		return true;
+	} else if (arg == "off") {
+		CONTROLLER->setProfiling(false);
+		debugPrintf("Script profiling disabled, statistics were written to the log\n");
+		return true;
+	} else if (arg == "reset") {
+		CONTROLLER->resetProfiling();
+		return true;
+	}
+
+	if (!CONTROLLER->isProfiling()) {
+		debugPrintf("Script profiling is off, use \"%s on\" to enable it\n", argv[0]);
+		return true;
+	}
+
+	uint count = arg.empty() ? 20 : atoi(arg.c_str());
+	uint32 duration;
+	Common::Array<ProfileEntry> entries = CONTROLLER->getProfile(duration);
+	debugPrintf("%u ms profiled\n", duration);
+	debugPrintf("%-40s %10s %12s %8s\n", "Script", "ms", "instructions", "runs");
+	for (uint i = 0; i < entries.size() && i < count; i++) {
+		debugPrintf("%-40s %10u %12u %8u\n", entries[i]._name.c_str(), entries[i]._time, entries[i]._instructions, entries[i]._runs);
+	}
+	return true;
+}
+
 bool Console::Cmd_ShowFps(int argc, const char **argv) {
 	if (argc == 2) {
 		if (Common::String(argv[1]) == "true") {
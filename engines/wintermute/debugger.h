@@ -52,6 +52,7 @@
 #define PRINT_CMD "print"
 #define SET_PATH_CMD "set_path"
 #define TOP_CMD "top"
+#define PROFILE_CMD "profile"
 
 namespace Wintermute {
 class WintermuteEngine;
@@ -69,6 +70,10 @@ public:
 	bool Cmd_Help(int argc, const char **argv);
 	bool Cmd_ShowFps(int argc, const char **argv);
 	bool Cmd_DumpFile(int argc, const char **argv);
+	/**
+	 * Collect and print time spent per script and event/method handler
+	 */
+	bool Cmd_Profile(int argc, const char **argv);
 
 #if EXTENDED_DEBUGGER_ENABLED
 	/**
@@ -258,6 +258,43 @@ void DebuggerController::showFps(bool show) {
 	_engine->_game->setShowFPS(show);
 }
 
+void DebuggerController::setProfiling(bool enable) {
+	assert(SCENGINE);
+	if (enable) {
+		SCENGINE->enableProfiling();
+	} else {
+		SCENGINE->disableProfiling();
+	}
+}
+
+bool DebuggerController::isProfiling() const {
+	assert(SCENGINE);
+	return SCENGINE->getIsProfiling();
+}
+
+void DebuggerController::resetProfiling() {
+	assert(SCENGINE);
+	SCENGINE->resetProfiling();
+}
+
+Common::Array<ProfileEntry> DebuggerController::getProfile(uint32 &duration) const {
+	assert(SCENGINE);
+	Common::Array<ScEngine::ScriptProfile> stats;
+	SCENGINE->getProfilingStats(stats);
+	duration = SCENGINE->getProfilingDuration();
+
+	Common::Array<ProfileEntry> entries;
+	for (uint i = 0; i < stats.size(); i++) {
+		ProfileEntry entry;
+		entry._name = stats[i]._name;
+		entry._time = stats[i]._time;
+		entry._instructions = stats[i]._instructions;
+		entry._runs = stats[i]._runs;
+		entries.push_back(entry);
+	}
+	return entries;
+}
+
 Common::Array<BreakpointInfo> DebuggerController::getBreakpoints() const {
 	assert(SCENGINE);
 	Common::Array<BreakpointInfo> breakpoints;
@@ -56,6 +56,13 @@ struct TopEntry {
 	int breakpointInfo;
 };
 
+struct ProfileEntry {
+	Common::String _name;
+	uint32 _time;
+	uint32 _instructions;
+	uint32 _runs;
+};
+
 class DebuggerController : public ScriptMonitor {
 	SourceListingProvider *_sourceListingProvider;
 	const WintermuteEngine *_engine;
@@ -105,6 +112,16 @@ public:
 	Common::Path getSourcePath() const;
 	Listing *getListing(Error* &err);
 	void showFps(bool show);
+	/**
+	 * @brief start or stop collecting script execution times.
+	 */
+	void setProfiling(bool enable);
+	bool isProfiling() const;
+	void resetProfiling();
+	/**
+	 * @brief get the time spent per script and event/method handler, most expensive first.
+	 */
+	Common::Array<ProfileEntry> getProfile(uint32 &duration) const;
 	/**
 	 * Inherited from ScriptMonitor
 	 */
@@ -294,6 +294,29 @@ public:
 	 */
 	virtual void setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2) = 0;
 
+	/**
+	 * Colors kept by the renderer between draw steps. Steps which do not
+	 * set a color use the one left behind by the previous step.
+	 */
+	struct ColorState {
+		uint32 fgColor, bgColor, bevelColor;
+		uint32 gradientStart, gradientEnd;
+		int gradientBytes[3];
+
+		bool operator==(const ColorState &other) const {
+			return fgColor == other.fgColor && bgColor == other.bgColor && bevelColor == other.bevelColor &&
+			       gradientStart == other.gradientStart && gradientEnd == other.gradientEnd &&
+			       gradientBytes[0] == other.gradientBytes[0] && gradientBytes[1] == other.gradientBytes[1] &&
+			       gradientBytes[2] == other.gradientBytes[2];
+		}
+	};
+
+	/**
+	 * Save and restore the current colors of the renderer.
+	 */
+	virtual ColorState getColorState() const = 0;
+	virtual void setColorState(const ColorState &state) = 0;
+
 	/**
 	 * Sets the active drawing surface. All drawing from this
 	 * point on will be done on that surface.
@@ -0,0 +1,106 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+#include <arm_neon.h>
+
+#include "graphics/VectorRendererSpec.h"
+
+namespace Graphics {
+
+class VectorRendererImpl_NEON {
+public:
+	typedef VectorRendererKernels::Format Format;
+
+	static void blendFill16(void *first, int count, uint32 color, uint8 alpha, const Format &format) {
+		uint16 *ptr = (uint16 *)first;
+		const uint32 invAlpha = 256 - alpha;
+		uint32 srcAlpha[4];
+		uint16x8_t src[4], max[4];
+		int16x8_t shiftLeft[4], shiftRight[4];
+
+		// Channels which aren't present have a zero mask and source, so
+		// they don't change the result
+		for (int i = 0; i < 4; i++) {
+			srcAlpha[i] = ((color >> format.shift[i]) & format.max[i]) * alpha;
+			src[i] = vdupq_n_u16(srcAlpha[i]);
+			max[i] = vdupq_n_u16(format.max[i]);
+			shiftLeft[i] = vdupq_n_s16(format.shift[i]);
+			shiftRight[i] = vdupq_n_s16(-format.shift[i]);
+		}
+		const uint16x8_t inv = vdupq_n_u16(invAlpha);
+
+		for (; count >= 8; count -= 8, ptr += 8) {
+			const uint16x8_t dst = vld1q_u16(ptr);
+			uint16x8_t result = vdupq_n_u16(0);
+			for (int i = 0; i < 4; i++) {
+				uint16x8_t c = vandq_u16(vshlq_u16(dst, shiftRight[i]), max[i]);
+				c = vshrq_n_u16(vmlaq_u16(src[i], c, inv), 8);
+				result = vorrq_u16(result, vshlq_u16(c, shiftLeft[i]));
+			}
+			vst1q_u16(ptr, result);
+		}
+
+		for (; count > 0; count--, ptr++)
+			*ptr = VectorRendererKernels::blendPixel(*ptr, srcAlpha, invAlpha, format);
+	}
+
+	static void blendFill32(void *first, int count, uint32 color, uint8 alpha, const Format &format) {
+		uint32 *ptr = (uint32 *)first;
+		const uint32 invAlpha = 256 - alpha;
+		uint32 srcAlpha[4];
+		uint32x4_t src[4], max[4];
+		int32x4_t shiftLeft[4], shiftRight[4];
+
+		for (int i = 0; i < 4; i++) {
+			srcAlpha[i] = ((color >> format.shift[i]) & format.max[i]) * alpha;
+			src[i] = vdupq_n_u32(srcAlpha[i]);
+			max[i] = vdupq_n_u32(format.max[i]);
+			shiftLeft[i] = vdupq_n_s32(format.shift[i]);
+			shiftRight[i] = vdupq_n_s32(-format.shift[i]);
+		}
+		const uint32x4_t inv = vdupq_n_u32(invAlpha);
+
+		for (; count >= 4; count -= 4, ptr += 4) {
+			const uint32x4_t dst = vld1q_u32(ptr);
+			uint32x4_t result = vdupq_n_u32(0);
+			for (int i = 0; i < 4; i++) {
+				uint32x4_t c = vandq_u32(vshlq_u32(dst, shiftRight[i]), max[i]);
+				c = vshrq_n_u32(vmlaq_u32(src[i], c, inv), 8);
+				result = vorrq_u32(result, vshlq_u32(c, shiftLeft[i]));
+			}
+			vst1q_u32(ptr, result);
+		}
+
+		for (; count > 0; count--, ptr++)
+			*ptr = VectorRendererKernels::blendPixel(*ptr, srcAlpha, invAlpha, format);
+	}
+};
+
+const VectorRendererKernels VectorRendererKernels::kernelsNEON = {
+	VectorRendererImpl_NEON::blendFill16,
+	VectorRendererImpl_NEON::blendFill32
+};
+
+} // end of namespace Graphics
+#endif // SCUMMVM_NEON
@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include <immintrin.h>
+
+#include "graphics/VectorRendererSpec.h"
+
+namespace Graphics {
+
+class VectorRendererImpl_SSE2 {
+public:
+	typedef VectorRendererKernels::Format Format;
+
+	static void blendFill16(void *first, int count, uint32 color, uint8 alpha, const Format &format) {
+		uint16 *ptr = (uint16 *)first;
+		const uint32 invAlpha = 256 - alpha;
+		uint32 srcAlpha[4];
+		__m128i src[4], max[4], shift[4];
+
+		// Channels which aren't present have a zero mask and source, so
+		// they don't change the result
+		for (int i = 0; i < 4; i++) {
+			srcAlpha[i] = ((color >> format.shift[i]) & format.max[i]) * alpha;
+			src[i] = _mm_set1_epi16(srcAlpha[i]);
+			max[i] = _mm_set1_epi16(format.max[i]);
+			shift[i] = _mm_cvtsi32_si128(format.shift[i]);
+		}
+		const __m128i inv = _mm_set1_epi16(invAlpha);
+
+		for (; count >= 8; count -= 8, ptr += 8) {
+			const __m128i dst = _mm_loadu_si128((const __m128i *)ptr);
+			__m128i result = _mm_setzero_si128();
+			for (int i = 0; i < 4; i++) {
+				__m128i c = _mm_and_si128(_mm_srl_epi16(dst, shift[i]), max[i]);
+				c = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(c, inv), src[i]), 8);
+				result = _mm_or_si128(result, _mm_sll_epi16(c, shift[i]));
+			}
+			_mm_storeu_si128((__m128i *)ptr, result);
+		}
+
+		for (; count > 0; count--, ptr++)
+			*ptr = VectorRendererKernels::blendPixel(*ptr, srcAlpha, invAlpha, format);
+	}
+
+	static void blendFill32(void *first, int count, uint32 color, uint8 alpha, const Format &format) {
+		uint32 *ptr = (uint32 *)first;
+		const uint32 invAlpha = 256 - alpha;
+		uint32 srcAlpha[4];
+		__m128i src[4], max[4], shift[4];
+
+		for (int i = 0; i < 4; i++) {
+			srcAlpha[i] = ((color >> format.shift[i]) & format.max[i]) * alpha;
+			src[i] = _mm_set1_epi32(srcAlpha[i]);
+			max[i] = _mm_set1_epi32(format.max[i]);
+			shift[i] = _mm_cvtsi32_si128(format.shift[i]);
+		}
+		const __m128i inv = _mm_set1_epi32(invAlpha);
+
+		for (; count >= 4; count -= 4, ptr += 4) {
+			const __m128i dst = _mm_loadu_si128((const __m128i *)ptr);
+			__m128i result = _mm_setzero_si128();
+			for (int i = 0; i < 4; i++) {
+				// The channel and the inverse alpha fit in the low half of
+				// each lane, so a 16-bit multiply gives the 32-bit product
+				__m128i c = _mm_and_si128(_mm_srl_epi32(dst, shift[i]), max[i]);
+				c = _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(c, inv), src[i]), 8);
+				result = _mm_or_si128(result, _mm_sll_epi32(c, shift[i]));
+			}
+			_mm_storeu_si128((__m128i *)ptr, result);
+		}
+
+		for (; count > 0; count--, ptr++)
+			*ptr = VectorRendererKernels::blendPixel(*ptr, srcAlpha, invAlpha, format);
+	}
+};
+
+const VectorRendererKernels VectorRendererKernels::kernelsSSE2 = {
+	VectorRendererImpl_SSE2::blendFill16,
+	VectorRendererImpl_SSE2::blendFill32
+};
+
+} // end of namespace Graphics
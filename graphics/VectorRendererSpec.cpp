@@ -475,6 +475,29 @@ void colorFillClip(PixelType *first, PixelType *last, PixelType color, int realX
 		Common::memset32((uint32 *)first, color, count);
 }
 
+/**
+ * Fills several pixels in a row with a pattern of two colors alternating
+ * between even and odd columns.
+ *
+ * @param first Pointer to the first pixel to fill.
+ * @param last Pointer to the last pixel to fill.
+ * @param x Column of the first pixel.
+ * @param colors Colors of the even and the odd columns.
+ */
+template<typename PixelType>
+void ditherFill(PixelType *first, PixelType *last, int x, const PixelType colors[2]) {
+	if ((x & 1) && first < last)
+		*first++ = colors[1];
+
+	for (; last - first >= 2; first += 2) {
+		first[0] = colors[0];
+		first[1] = colors[1];
+	}
+
+	if (first < last)
+		*first = colors[0];
+}
+
 /**
  * Fills several pixels in a column with a given color.
  *
@@ -524,6 +547,28 @@ void colorVFillClip(PixelType *first, PixelType *last, int pitch, PixelType colo
 }
 
 
+const VectorRendererKernels *VectorRendererKernels::kernels = nullptr;
+bool VectorRendererKernels::kernelsSelected = false;
+
+const VectorRendererKernels *VectorRendererKernels::getKernels() {
+	// If no kernels have been selected yet, detect and select
+	if (!kernelsSelected) {
+		// The CPU features can't be queried without a backend
+		if (!g_system)
+			return nullptr;
+
+		kernelsSelected = true;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) kernels = &kernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) kernels = &kernelsSSE2;
+#endif
+	}
+
+	return kernels;
+}
+
 VectorRenderer *createRenderer(int mode) {
 #ifdef DISABLE_FANCY_THEMES
 	assert(mode == GUI::ThemeEngine::kGfxStandard);
@@ -570,6 +615,23 @@ VectorRendererSpec(PixelFormat format) :
 
 	_fgColor = _bgColor = _bevelColor = 0;
 	_gradientStart = _gradientEnd = 0;
+	_gradientBytes[0] = _gradientBytes[1] = _gradientBytes[2] = 0;
+
+	const uint8 shifts[4] = { format.rShift, format.gShift, format.bShift, format.aShift };
+	const uint8 losses[4] = { format.rLoss, format.gLoss, format.bLoss, format.aLoss };
+	for (int i = 0; i < 4; i++) {
+		_kernelFormat.shift[i] = shifts[i];
+		_kernelFormat.max[i] = 0xFF >> losses[i];
+	}
+
+	// The 32bpp code blends the alpha channel towards 0xFF, which is only
+	// the maximum value when it has 8 bits
+	_blendFillKernel = nullptr;
+	const VectorRendererKernels *kernels = VectorRendererKernels::getKernels();
+	if (kernels && sizeof(PixelType) == 2)
+		_blendFillKernel = kernels->blendFill16;
+	else if (kernels && sizeof(PixelType) == 4 && (format.aLoss == 0 || format.aLoss == 8))
+		_blendFillKernel = kernels->blendFill32;
 }
 
 /****************************
@@ -593,6 +655,32 @@ setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2) {
 	}
 }
 
+template<typename PixelType>
+VectorRenderer::ColorState VectorRendererSpec<PixelType>::
+getColorState() const {
+	ColorState state;
+	state.fgColor = _fgColor;
+	state.bgColor = _bgColor;
+	state.bevelColor = _bevelColor;
+	state.gradientStart = _gradientStart;
+	state.gradientEnd = _gradientEnd;
+	for (int i = 0; i < 3; ++i)
+		state.gradientBytes[i] = _gradientBytes[i];
+	return state;
+}
+
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+setColorState(const ColorState &state) {
+	_fgColor = state.fgColor;
+	_bgColor = state.bgColor;
+	_bevelColor = state.bevelColor;
+	_gradientStart = state.gradientStart;
+	_gradientEnd = state.gradientEnd;
+	for (int i = 0; i < 3; ++i)
+		_gradientBytes[i] = state.gradientBytes[i];
+}
+
 template<typename PixelType>
 inline PixelType VectorRendererSpec<PixelType>::
 calcGradient(uint32 pos, uint32 max) {
@@ -659,16 +747,12 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	} else if (grad == 3 && ox) {
 		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		// The pattern of a row only depends on the column parity
+		const PixelType colors[2] = {
+			((grad == 2 || grad == 3) && ox) ? _gradCache[curGrad + 1] : _gradCache[curGrad],
+			(ox || grad == 3) ? _gradCache[curGrad + 1] : _gradCache[curGrad]
+		};
+		ditherFill<PixelType>(ptr, ptr + width, x, colors);
 	}
 }
 
@@ -701,17 +785,16 @@ gradientFillClip(PixelType *ptr, int width, int x, int y, int realX, int realY)
 	} else if (grad == 3 && ox) {
 		colorFillClip<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1], realX, realY, _clippingArea);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			if (realX + j - x < _clippingArea.left || realX + j - x >= _clippingArea.right) continue;
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		// The pattern of a row only depends on the column parity
+		const PixelType colors[2] = {
+			((grad == 2 || grad == 3) && ox) ? _gradCache[curGrad + 1] : _gradCache[curGrad],
+			(ox || grad == 3) ? _gradCache[curGrad + 1] : _gradCache[curGrad]
+		};
+
+		int left = MAX<int>(realX, _clippingArea.left) - realX;
+		int right = MIN<int>(realX + width, _clippingArea.right) - realX;
+		if (left < right)
+			ditherFill<PixelType>(ptr + left, ptr + right, x + left, colors);
 	}
 }
 
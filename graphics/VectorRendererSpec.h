@@ -35,6 +35,54 @@ namespace Graphics {
  * @{
  */
 
+/**
+ * SIMD versions of the span operations of VectorRendererSpec. They give the
+ * same results as the per pixel code.
+ */
+struct VectorRendererKernels {
+	/**
+	 * Layout of the pixels, with the channels in the order red, green, blue
+	 * and alpha. A maximum value of 0 means that the channel isn't present.
+	 */
+	struct Format {
+		uint8 shift[4];
+		uint16 max[4];
+	};
+
+	typedef void (*BlendFillFunc)(void *first, int count, uint32 color, uint8 alpha, const Format &format);
+
+	/**
+	 * Per pixel version of the kernels, used for the pixels left over. The
+	 * blend dst + (src - dst) * alpha / 256 is computed unsigned, as
+	 * (dst * (256 - alpha) + src * alpha) / 256.
+	 *
+	 * @param srcAlpha Source channels multiplied by alpha.
+	 */
+	static inline uint32 blendPixel(uint32 dst, const uint32 srcAlpha[4], uint32 invAlpha, const Format &format) {
+		uint32 result = 0;
+		for (int i = 0; i < 4; i++) {
+			uint32 c = (dst >> format.shift[i]) & format.max[i];
+			result |= ((c * invAlpha + srcAlpha[i]) >> 8) << format.shift[i];
+		}
+		return result;
+	}
+
+	BlendFillFunc blendFill16; /**< Same as VectorRendererSpec<uint16>::blendFill(), color must include the alpha mask */
+	BlendFillFunc blendFill32; /**< Same as VectorRendererSpec<uint32>::blendFill(), color must include the alpha mask */
+
+#ifdef SCUMMVM_NEON
+	static const VectorRendererKernels kernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	static const VectorRendererKernels kernelsSSE2;
+#endif
+
+	static const VectorRendererKernels *kernels;
+	static bool kernelsSelected;
+
+	static const VectorRendererKernels *getKernels();
+};
+
 /**
  * VectorRendererSpec: Specialized Vector Renderer Class
  *
@@ -83,6 +131,9 @@ public:
 	void setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2) override;
 	void setClippingRect(const Common::Rect &clippingArea) override { _clippingArea = clippingArea; }
 
+	ColorState getColorState() const override;
+	void setColorState(const ColorState &state) override;
+
 	void copyFrame(OSystem *sys, const Common::Rect &r) override;
 	void copyWholeFrame(OSystem *sys) override { copyFrame(sys, Common::Rect(0, 0, _activeSurface->w, _activeSurface->h)); }
 
@@ -287,20 +338,23 @@ protected:
 	 * @param alpha Alpha intensity of the pixel (0-255)
 	 */
 	inline void blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
+		if (_blendFillKernel && alpha != 0xff && last - first >= kMinKernelSpan) {
+			_blendFillKernel(first, last - first, color | _alphaMask, alpha, _kernelFormat);
+			return;
+		}
+
 		while (first < last)
 			blendPixelPtr(first++, color, alpha);
 	}
 
 	inline void blendFillClip(PixelType *first, PixelType *last, PixelType color, uint8 alpha, int realX, int realY) {
-		if (_clippingArea.top <= realY && realY < _clippingArea.bottom) {
-			while (first < last) {
-				if (_clippingArea.left <= realX && realX < _clippingArea.right)
-					blendPixelPtr(first++, color, alpha);
-				else
-					++first;
-				++realX;
-			}
-		}
+		if (realY < _clippingArea.top || realY >= _clippingArea.bottom)
+			return;
+
+		int left = MAX<int>(realX, _clippingArea.left);
+		int right = MIN<int>(realX + (last - first), _clippingArea.right);
+		if (left < right)
+			blendFill(first + (left - realX), first + (right - realX), color, alpha);
 	}
 
 	void darkenFill(PixelType *first, PixelType *last);
@@ -321,6 +375,12 @@ protected:
 	Common::Array<int> _gradIndexes;
 
 	PixelType _bevelColor;
+
+	/** Spans shorter than this are blended by the per pixel code */
+	static const int kMinKernelSpan = 8;
+
+	VectorRendererKernels::BlendFillFunc _blendFillKernel;
+	VectorRendererKernels::Format _kernelFormat;
 };
 
 
@@ -30,6 +30,7 @@ struct Point;
 }
 
 class BlendBlitUnfilteredTestSuite;
+class GraphicsBenchmarkSuite;
 
 namespace Graphics {
 
@@ -291,7 +292,29 @@ private:
 
 	typedef void(*BlitFunc)(Args &, const TSpriteBlendMode &, const AlphaType &);
 	static BlitFunc blitFunc;
+
+	/**
+	 * Blits with at least this many destination pixels are split into bands
+	 * of rows, which are blitted on the job system workers.
+	 */
+	static const uint kParallelMinPixels = 256 * 256;
+	static const uint kParallelMinRows = 16;
+
+	struct BandJob {
+		const Args *args;
+		TSpriteBlendMode blendMode;
+		AlphaType alphaType;
+	};
+
+	/**
+	 * Blit the destination rows [begin, end) of the blit described by args.
+	 * Bands of rows are independent, so blitting all of them in any order
+	 * gives the same result as blitting the whole area at once.
+	 */
+	static void blitRows(const Args &args, uint begin, uint end, const TSpriteBlendMode &blendMode, const AlphaType &alphaType);
+	static void blitBandProc(uint32 begin, uint32 end, void *refCon);
 	friend class ::BlendBlitUnfilteredTestSuite;
+	friend class ::GraphicsBenchmarkSuite;
 	friend class BlendBlitImpl_Default;
 	friend class BlendBlitImpl_NEON;
 	friend class BlendBlitImpl_SSE2;
@@ -372,6 +395,100 @@ public:
 
 }; // End of class BlendBlit
 
+// This is a class so that we can declare certain things as private
+class CrossBlit {
+private:
+	/**
+	 * Component layout used by the conversion kernels, in A, R, G, B order.
+	 *
+	 * Each source component is extracted with srcShift / srcMask, widened
+	 * to 8 bits with (v << expandLeft) | (v >> expandRight) and stored with
+	 * dstLoss / dstShift. Components missing from the source have a zero
+	 * mask; their contribution to the result is precomputed in base.
+	 */
+	struct Args {
+		uint32 srcMask[4];
+		uint8 srcShift[4];
+		uint8 expandLeft[4], expandRight[4];
+		uint8 dstLoss[4], dstShift[4];
+		uint32 base;
+
+		Args(const PixelFormat &dstFmt, const PixelFormat &srcFmt);
+	};
+
+	// Conversions to a larger pixel size go from the last pixel of a row
+	// to the first, convert32To32 goes from the first to the last, which
+	// is the order crossBlit uses. Every chunk of source pixels is read
+	// before the matching destination pixels are written, so in place
+	// conversions keep working.
+	typedef void(*MapRowFunc)(byte *dst, const byte *src, const uint w, const uint32 *map);
+	typedef void(*ConvertRowFunc)(byte *dst, const byte *src, const uint w, const Args &args);
+
+	struct Kernels {
+		MapRowFunc map8To16;
+		MapRowFunc map8To32;
+		ConvertRowFunc convert16To32;
+		ConvertRowFunc convert32To32;
+	};
+
+	static const Kernels kernelsGeneric;
+#ifdef SCUMMVM_NEON
+	static const Kernels kernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	static const Kernels kernelsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	static const Kernels kernelsAVX2;
+#endif
+	static const Kernels *kernels;
+
+	static const Kernels &getKernels();
+	static bool isSupported(const PixelFormat &srcFmt);
+
+	static inline uint32 convertPixel(uint32 color, const Args &args) {
+		uint32 result = args.base;
+		for (int i = 0; i < 4; i++) {
+			const uint32 v = (color >> args.srcShift[i]) & args.srcMask[i];
+			const uint32 c = (v << args.expandLeft[i]) | (v >> args.expandRight[i]);
+			result |= (c >> args.dstLoss[i]) << args.dstShift[i];
+		}
+		return result;
+	}
+
+	friend class ::BlendBlitUnfilteredTestSuite;
+	friend class ::GraphicsBenchmarkSuite;
+	friend class CrossBlitImpl_Default;
+	friend class CrossBlitImpl_NEON;
+	friend class CrossBlitImpl_SSE2;
+	friend class CrossBlitImpl_AVX2;
+
+public:
+	/**
+	 * Convert a 16bpp or 32bpp rectangle to 32bpp with the fastest
+	 * kernel available on this CPU.
+	 *
+	 * @return false if the formats are not handled by the kernels, in
+	 *         which case nothing has been written.
+	 */
+	static bool convert(byte *dst, const byte *src,
+						const uint dstPitch, const uint srcPitch,
+						const uint w, const uint h,
+						const PixelFormat &dstFmt, const PixelFormat &srcFmt);
+
+	/**
+	 * Convert a CLUT8 rectangle to 16bpp or 32bpp through a map with the
+	 * fastest kernel available on this CPU.
+	 *
+	 * @return false if bytesPerPixel is not handled by the kernels, in
+	 *         which case nothing has been written.
+	 */
+	static bool map(byte *dst, const byte *src,
+					const uint dstPitch, const uint srcPitch,
+					const uint w, const uint h,
+					const uint bytesPerPixel, const uint32 *map);
+}; // End of class CrossBlit
+
 /** @} */
 } // End of namespace Graphics
 
@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/jobsystem.h"
 #include "common/system.h"
 #include "graphics/blit.h"
 #include "graphics/pixelformat.h"
@@ -235,7 +236,47 @@ void BlendBlit::blit(byte *dst, const byte *src,
 	}
 	
 	Args args(dst, src, dstPitch, srcPitch, posX, posY, width, height, scaleX, scaleY, scaleXsrcOff, scaleYsrcOff, colorMod, flipping);
+
+	// Large blits are split into bands of rows, unless the source and the
+	// destination overlap, since the result would then depend on the order
+	// in which the rows are drawn
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	if (jobSystem->getWorkerCount() > 0 && width * height >= kParallelMinPixels && height >= 2 * kParallelMinRows) {
+		const bool doScale = scaleX != SCALE_THRESHOLD || scaleY != SCALE_THRESHOLD;
+		const uint srcRows = doScale ? (scaleYsrcOff + height * scaleY) / SCALE_THRESHOLD + 2 : height;
+		const byte *srcFirst = (args.inoStep < 0 ? args.ino - srcRows * srcPitch : args.ino - srcPitch);
+		const byte *srcLast = srcFirst + (srcRows + 2) * srcPitch;
+		const byte *dstFirst = args.outo;
+		const byte *dstLast = dstFirst + height * dstPitch;
+
+		if (srcLast <= dstFirst || dstLast <= srcFirst) {
+			BandJob job = { &args, blendMode, alphaType };
+			jobSystem->parallelFor(height, blitBandProc, &job, kParallelMinRows);
+			return;
+		}
+	}
+
 	blitFunc(args, blendMode, alphaType);
 }
 
+void BlendBlit::blitRows(const Args &args, uint begin, uint end, const TSpriteBlendMode &blendMode, const AlphaType &alphaType) {
+	Args band = args;
+	band.outo += begin * band.dstPitch;
+	band.height = end - begin;
+
+	// Same test as blitT, for whether the rows are found by stepping the
+	// source pointer, or from the vertical scale counter
+	if (band.scaleX == SCALE_THRESHOLD && band.scaleY == SCALE_THRESHOLD)
+		band.ino += (int)begin * band.inoStep;
+	else
+		band.scaleYoff += (int)begin * band.scaleY;
+
+	blitFunc(band, blendMode, alphaType);
+}
+
+void BlendBlit::blitBandProc(uint32 begin, uint32 end, void *refCon) {
+	const BandJob *job = (const BandJob *)refCon;
+	blitRows(*job->args, begin, end, job->blendMode, job->alphaType);
+}
+
 } // End of namespace Graphics
@@ -299,4 +299,106 @@ void BlendBlit::blitAVX2(Args &args, const TSpriteBlendMode &blendMode, const Al
 	blitT<BlendBlitImpl_AVX2>(args, blendMode, alphaType);
 }
 
+class CrossBlitImpl_AVX2 {
+	friend class CrossBlit;
+
+	struct Consts {
+		__m256i mask[4];
+		__m128i srcShift[4], expandLeft[4], expandRight[4], dstLoss[4], dstShift[4];
+		__m256i base;
+		int count;
+
+		Consts(const CrossBlit::Args &args) : base(_mm256_set1_epi32(args.base)), count(0) {
+			// Only keep the components present in the source
+			for (int i = 0; i < 4; i++) {
+				if (!args.srcMask[i])
+					continue;
+				mask[count] = _mm256_set1_epi32(args.srcMask[i]);
+				srcShift[count] = _mm_cvtsi32_si128(args.srcShift[i]);
+				expandLeft[count] = _mm_cvtsi32_si128(args.expandLeft[i]);
+				expandRight[count] = _mm_cvtsi32_si128(args.expandRight[i]);
+				dstLoss[count] = _mm_cvtsi32_si128(args.dstLoss[i]);
+				dstShift[count] = _mm_cvtsi32_si128(args.dstShift[i]);
+				count++;
+			}
+		}
+	};
+
+	static inline __m256i convertPixels(__m256i src, const Consts &k) {
+		__m256i result = k.base;
+		for (int i = 0; i < k.count; i++) {
+			__m256i v = _mm256_and_si256(_mm256_srl_epi32(src, k.srcShift[i]), k.mask[i]);
+			v = _mm256_or_si256(_mm256_sll_epi32(v, k.expandLeft[i]), _mm256_srl_epi32(v, k.expandRight[i]));
+			result = _mm256_or_si256(result, _mm256_sll_epi32(_mm256_srl_epi32(v, k.dstLoss[i]), k.dstShift[i]));
+		}
+		return result;
+	}
+
+	static void map8To16(byte *dst, const byte *src, const uint w, const uint32 *map) {
+		uint16 *d = (uint16 *)dst;
+		uint i = w;
+		while (i >= 16) {
+			i -= 16;
+			const __m128i indices = _mm_loadu_si128((const __m128i *)(src + i));
+			__m256i lo = _mm256_i32gather_epi32((const int *)map, _mm256_cvtepu8_epi32(indices), 4);
+			__m256i hi = _mm256_i32gather_epi32((const int *)map, _mm256_cvtepu8_epi32(_mm_srli_si128(indices, 8)), 4);
+			// Keep the low 16 bits only, so that packing doesn't saturate
+			lo = _mm256_and_si256(lo, _mm256_set1_epi32(0xFFFF));
+			hi = _mm256_and_si256(hi, _mm256_set1_epi32(0xFFFF));
+			const __m256i pixels = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+			_mm256_storeu_si256((__m256i *)(d + i), pixels);
+		}
+		while (i-- > 0)
+			d[i] = map[src[i]];
+	}
+
+	static void map8To32(byte *dst, const byte *src, const uint w, const uint32 *map) {
+		uint32 *d = (uint32 *)dst;
+		uint i = w;
+		while (i >= 8) {
+			i -= 8;
+			const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + i)));
+			_mm256_storeu_si256((__m256i *)(d + i), _mm256_i32gather_epi32((const int *)map, indices, 4));
+		}
+		while (i-- > 0)
+			d[i] = map[src[i]];
+	}
+
+	static void convert16To32(byte *dst, const byte *src, const uint w, const CrossBlit::Args &args) {
+		const Consts k(args);
+		const uint16 *s = (const uint16 *)src;
+		uint32 *d = (uint32 *)dst;
+		uint i = w;
+		while (i >= 16) {
+			i -= 16;
+			const __m256i lo = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(s + i)));
+			const __m256i hi = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(s + i + 8)));
+			_mm256_storeu_si256((__m256i *)(d + i), convertPixels(lo, k));
+			_mm256_storeu_si256((__m256i *)(d + i + 8), convertPixels(hi, k));
+		}
+		while (i-- > 0)
+			d[i] = CrossBlit::convertPixel(s[i], args);
+	}
+
+	static void convert32To32(byte *dst, const byte *src, const uint w, const CrossBlit::Args &args) {
+		const Consts k(args);
+		const uint32 *s = (const uint32 *)src;
+		uint32 *d = (uint32 *)dst;
+		uint i = 0;
+		for (; i + 8 <= w; i += 8) {
+			const __m256i pixels = _mm256_loadu_si256((const __m256i *)(s + i));
+			_mm256_storeu_si256((__m256i *)(d + i), convertPixels(pixels, k));
+		}
+		for (; i < w; i++)
+			d[i] = CrossBlit::convertPixel(s[i], args);
+	}
+}; // End of class CrossBlitImpl_AVX2
+
+const CrossBlit::Kernels CrossBlit::kernelsAVX2 = {
+	CrossBlitImpl_AVX2::map8To16,
+	CrossBlitImpl_AVX2::map8To32,
+	CrossBlitImpl_AVX2::convert16To32,
+	CrossBlitImpl_AVX2::convert32To32
+};
+
 } // End of namespace Graphics
@@ -298,5 +298,109 @@ void BlendBlit::blitNEON(Args &args, const TSpriteBlendMode &blendMode, const Al
 	blitT<BlendBlitImpl_NEON>(args, blendMode, alphaType);
 }
 
+class CrossBlitImpl_NEON {
+	friend class CrossBlit;
+
+	struct Consts {
+		uint32x4_t mask[4];
+		int32x4_t srcShift[4], expandLeft[4], expandRight[4], dstLoss[4], dstShift[4];
+		uint32x4_t base;
+		int count;
+
+		Consts(const CrossBlit::Args &args) : base(vdupq_n_u32(args.base)), count(0) {
+			// Only keep the components present in the source. Negative
+			// shift counts shift to the right.
+			for (int i = 0; i < 4; i++) {
+				if (!args.srcMask[i])
+					continue;
+				mask[count] = vdupq_n_u32(args.srcMask[i]);
+				srcShift[count] = vdupq_n_s32(-(int)args.srcShift[i]);
+				expandLeft[count] = vdupq_n_s32(args.expandLeft[i]);
+				expandRight[count] = vdupq_n_s32(-(int)args.expandRight[i]);
+				dstLoss[count] = vdupq_n_s32(-(int)args.dstLoss[i]);
+				dstShift[count] = vdupq_n_s32(args.dstShift[i]);
+				count++;
+			}
+		}
+	};
+
+	static inline uint32x4_t convertPixels(uint32x4_t src, const Consts &k) {
+		uint32x4_t result = k.base;
+		for (int i = 0; i < k.count; i++) {
+			uint32x4_t v = vandq_u32(vshlq_u32(src, k.srcShift[i]), k.mask[i]);
+			v = vorrq_u32(vshlq_u32(v, k.expandLeft[i]), vshlq_u32(v, k.expandRight[i]));
+			result = vorrq_u32(result, vshlq_u32(vshlq_u32(v, k.dstLoss[i]), k.dstShift[i]));
+		}
+		return result;
+	}
+
+	static inline uint32x4_t lookup4(const byte *src, const uint32 *map) {
+		uint32x4_t pixels = vdupq_n_u32(map[src[0]]);
+		pixels = vsetq_lane_u32(map[src[1]], pixels, 1);
+		pixels = vsetq_lane_u32(map[src[2]], pixels, 2);
+		pixels = vsetq_lane_u32(map[src[3]], pixels, 3);
+		return pixels;
+	}
+
+	static void map8To16(byte *dst, const byte *src, const uint w, const uint32 *map) {
+		uint16 *d = (uint16 *)dst;
+		uint i = w;
+		while (i >= 8) {
+			i -= 8;
+			const uint32x4_t lo = lookup4(src + i, map);
+			const uint32x4_t hi = lookup4(src + i + 4, map);
+			vst1q_u16(d + i, vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+		}
+		while (i-- > 0)
+			d[i] = map[src[i]];
+	}
+
+	static void map8To32(byte *dst, const byte *src, const uint w, const uint32 *map) {
+		uint32 *d = (uint32 *)dst;
+		uint i = w;
+		while (i >= 4) {
+			i -= 4;
+			vst1q_u32(d + i, lookup4(src + i, map));
+		}
+		while (i-- > 0)
+			d[i] = map[src[i]];
+	}
+
+	static void convert16To32(byte *dst, const byte *src, const uint w, const CrossBlit::Args &args) {
+		const Consts k(args);
+		const uint16 *s = (const uint16 *)src;
+		uint32 *d = (uint32 *)dst;
+		uint i = w;
+		while (i >= 8) {
+			i -= 8;
+			const uint16x8_t pixels = vld1q_u16(s + i);
+			const uint32x4_t lo = convertPixels(vmovl_u16(vget_low_u16(pixels)), k);
+			const uint32x4_t hi = convertPixels(vmovl_u16(vget_high_u16(pixels)), k);
+			vst1q_u32(d + i, lo);
+			vst1q_u32(d + i + 4, hi);
+		}
+		while (i-- > 0)
+			d[i] = CrossBlit::convertPixel(s[i], args);
+	}
+
+	static void convert32To32(byte *dst, const byte *src, const uint w, const CrossBlit::Args &args) {
+		const Consts k(args);
+		const uint32 *s = (const uint32 *)src;
+		uint32 *d = (uint32 *)dst;
+		uint i = 0;
+		for (; i + 4 <= w; i += 4)
+			vst1q_u32(d + i, convertPixels(vld1q_u32(s + i), k));
+		for (; i < w; i++)
+			d[i] = CrossBlit::convertPixel(s[i], args);
+	}
+}; // End of class CrossBlitImpl_NEON
+
+const CrossBlit::Kernels CrossBlit::kernelsNEON = {
+	CrossBlitImpl_NEON::map8To16,
+	CrossBlitImpl_NEON::map8To32,
+	CrossBlitImpl_NEON::convert16To32,
+	CrossBlitImpl_NEON::convert32To32
+};
+
 } // end of namespace Graphics
 #endif // SCUMMVM_NEON
@@ -300,4 +300,107 @@ void BlendBlit::blitSSE2(Args &args, const TSpriteBlendMode &blendMode, const Al
 	blitT<BlendBlitImpl_SSE2>(args, blendMode, alphaType);
 }
 
+class CrossBlitImpl_SSE2 {
+	friend class CrossBlit;
+
+	struct Consts {
+		__m128i mask[4], srcShift[4], expandLeft[4], expandRight[4], dstLoss[4], dstShift[4];
+		__m128i base;
+		int count;
+
+		Consts(const CrossBlit::Args &args) : base(_mm_set1_epi32(args.base)), count(0) {
+			// Only keep the components present in the source
+			for (int i = 0; i < 4; i++) {
+				if (!args.srcMask[i])
+					continue;
+				mask[count] = _mm_set1_epi32(args.srcMask[i]);
+				srcShift[count] = _mm_cvtsi32_si128(args.srcShift[i]);
+				expandLeft[count] = _mm_cvtsi32_si128(args.expandLeft[i]);
+				expandRight[count] = _mm_cvtsi32_si128(args.expandRight[i]);
+				dstLoss[count] = _mm_cvtsi32_si128(args.dstLoss[i]);
+				dstShift[count] = _mm_cvtsi32_si128(args.dstShift[i]);
+				count++;
+			}
+		}
+	};
+
+	static inline __m128i convertPixels(__m128i src, const Consts &k) {
+		__m128i result = k.base;
+		for (int i = 0; i < k.count; i++) {
+			__m128i v = _mm_and_si128(_mm_srl_epi32(src, k.srcShift[i]), k.mask[i]);
+			v = _mm_or_si128(_mm_sll_epi32(v, k.expandLeft[i]), _mm_srl_epi32(v, k.expandRight[i]));
+			result = _mm_or_si128(result, _mm_sll_epi32(_mm_srl_epi32(v, k.dstLoss[i]), k.dstShift[i]));
+		}
+		return result;
+	}
+
+	static inline __m128i lookup4(const byte *src, const uint32 *map) {
+		return _mm_set_epi32(map[src[3]], map[src[2]], map[src[1]], map[src[0]]);
+	}
+
+	static void map8To16(byte *dst, const byte *src, const uint w, const uint32 *map) {
+		uint16 *d = (uint16 *)dst;
+		uint i = w;
+		while (i >= 8) {
+			i -= 8;
+			// Sign extend the low 16 bits, so that packing doesn't saturate
+			__m128i lo = lookup4(src + i, map);
+			__m128i hi = lookup4(src + i + 4, map);
+			lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+			hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+			_mm_storeu_si128((__m128i *)(d + i), _mm_packs_epi32(lo, hi));
+		}
+		while (i-- > 0)
+			d[i] = map[src[i]];
+	}
+
+	static void map8To32(byte *dst, const byte *src, const uint w, const uint32 *map) {
+		uint32 *d = (uint32 *)dst;
+		uint i = w;
+		while (i >= 4) {
+			i -= 4;
+			_mm_storeu_si128((__m128i *)(d + i), lookup4(src + i, map));
+		}
+		while (i-- > 0)
+			d[i] = map[src[i]];
+	}
+
+	static void convert16To32(byte *dst, const byte *src, const uint w, const CrossBlit::Args &args) {
+		const Consts k(args);
+		const uint16 *s = (const uint16 *)src;
+		uint32 *d = (uint32 *)dst;
+		uint i = w;
+		while (i >= 8) {
+			i -= 8;
+			const __m128i pixels = _mm_loadu_si128((const __m128i *)(s + i));
+			const __m128i lo = convertPixels(_mm_unpacklo_epi16(pixels, _mm_setzero_si128()), k);
+			const __m128i hi = convertPixels(_mm_unpackhi_epi16(pixels, _mm_setzero_si128()), k);
+			_mm_storeu_si128((__m128i *)(d + i), lo);
+			_mm_storeu_si128((__m128i *)(d + i + 4), hi);
+		}
+		while (i-- > 0)
+			d[i] = CrossBlit::convertPixel(s[i], args);
+	}
+
+	static void convert32To32(byte *dst, const byte *src, const uint w, const CrossBlit::Args &args) {
+		const Consts k(args);
+		const uint32 *s = (const uint32 *)src;
+		uint32 *d = (uint32 *)dst;
+		uint i = 0;
+		for (; i + 4 <= w; i += 4) {
+			const __m128i pixels = _mm_loadu_si128((const __m128i *)(s + i));
+			_mm_storeu_si128((__m128i *)(d + i), convertPixels(pixels, k));
+		}
+		for (; i < w; i++)
+			d[i] = CrossBlit::convertPixel(s[i], args);
+	}
+}; // End of class CrossBlitImpl_SSE2
+
+const CrossBlit::Kernels CrossBlit::kernelsSSE2 = {
+	CrossBlitImpl_SSE2::map8To16,
+	CrossBlitImpl_SSE2::map8To32,
+	CrossBlitImpl_SSE2::convert16To32,
+	CrossBlitImpl_SSE2::convert32To32
+};
+
 } // End of namespace Graphics
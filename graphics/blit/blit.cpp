@@ -22,6 +22,7 @@
 #include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 #include "common/endian.h"
+#include "common/system.h"
 
 namespace Graphics {
 
@@ -281,6 +282,10 @@ bool crossBlit(byte *dst, const byte *src,
 		return true;
 	}
 
+	// Use the vectorized kernels for the common conversions
+	if (CrossBlit::convert(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt))
+		return true;
+
 	// Faster, but larger, to provide optimized handling for each case.
 	const uint srcDelta = (srcPitch - w * srcFmt.bytesPerPixel);
 	const uint dstDelta = (dstPitch - w * dstFmt.bytesPerPixel);
@@ -491,6 +496,10 @@ bool crossBlitMap(byte *dst, const byte *src,
 	if (!bytesPerPixel)
 		return false;
 
+	// Use the vectorized kernels for the common conversions
+	if (CrossBlit::map(dst, src, dstPitch, srcPitch, w, h, bytesPerPixel, map))
+		return true;
+
 	// Faster, but larger, to provide optimized handling for each case.
 	const uint srcDelta = (srcPitch - w);
 	const uint dstDelta = (dstPitch - w * bytesPerPixel);
@@ -627,4 +636,141 @@ bool crossMaskBlitMap(byte *dst, const byte *src, const byte *mask,
 	return true;
 }
 
+CrossBlit::Args::Args(const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	const uint8 srcBits[4]   = { srcFmt.aBits(), srcFmt.rBits(), srcFmt.gBits(), srcFmt.bBits() };
+	const uint8 srcShifts[4] = { srcFmt.aShift,  srcFmt.rShift,  srcFmt.gShift,  srcFmt.bShift  };
+	const uint8 dstLosses[4] = { dstFmt.aLoss,   dstFmt.rLoss,   dstFmt.gLoss,   dstFmt.bLoss   };
+	const uint8 dstShifts[4] = { dstFmt.aShift,  dstFmt.rShift,  dstFmt.gShift,  dstFmt.bShift  };
+
+	base = 0;
+	for (int i = 0; i < 4; i++) {
+		dstLoss[i] = dstLosses[i];
+		dstShift[i] = dstShifts[i];
+
+		if (srcBits[i] == 0) {
+			srcMask[i] = 0;
+			srcShift[i] = expandLeft[i] = expandRight[i] = 0;
+			// A source without alpha is fully opaque, see PixelFormat::colorToARGB
+			if (i == 0)
+				base = (0xFF >> dstLoss[i]) << dstShift[i];
+		} else {
+			srcMask[i] = (1 << srcBits[i]) - 1;
+			srcShift[i] = srcShifts[i];
+			expandLeft[i] = 8 - srcBits[i];
+			expandRight[i] = 2 * srcBits[i] - 8;
+		}
+	}
+}
+
+// The kernels replicate the high bits of each component, which matches
+// PixelFormat::expand for components of 4 to 8 bits.
+bool CrossBlit::isSupported(const PixelFormat &srcFmt) {
+	const uint8 srcBits[4] = { srcFmt.aBits(), srcFmt.rBits(), srcFmt.gBits(), srcFmt.bBits() };
+	for (int i = 0; i < 4; i++) {
+		if (srcBits[i] != 0 && srcBits[i] < 4)
+			return false;
+	}
+	return true;
+}
+
+class CrossBlitImpl_Default {
+	friend class CrossBlit;
+
+	template<typename DstColor>
+	static void mapRow(byte *dst, const byte *src, const uint w, const uint32 *map) {
+		DstColor *d = (DstColor *)dst;
+		for (uint i = w; i-- > 0;)
+			d[i] = map[src[i]];
+	}
+
+	static void convert16To32(byte *dst, const byte *src, const uint w, const CrossBlit::Args &args) {
+		const uint16 *s = (const uint16 *)src;
+		uint32 *d = (uint32 *)dst;
+		for (uint i = w; i-- > 0;)
+			d[i] = CrossBlit::convertPixel(s[i], args);
+	}
+
+	static void convert32To32(byte *dst, const byte *src, const uint w, const CrossBlit::Args &args) {
+		const uint32 *s = (const uint32 *)src;
+		uint32 *d = (uint32 *)dst;
+		for (uint i = 0; i < w; i++)
+			d[i] = CrossBlit::convertPixel(s[i], args);
+	}
+}; // End of class CrossBlitImpl_Default
+
+const CrossBlit::Kernels CrossBlit::kernelsGeneric = {
+	CrossBlitImpl_Default::mapRow<uint16>,
+	CrossBlitImpl_Default::mapRow<uint32>,
+	CrossBlitImpl_Default::convert16To32,
+	CrossBlitImpl_Default::convert32To32
+};
+
+// Initialize this to nullptr at the start
+const CrossBlit::Kernels *CrossBlit::kernels = nullptr;
+
+const CrossBlit::Kernels &CrossBlit::getKernels() {
+	// If no kernels have been selected yet, detect and select
+	if (!kernels) {
+		// The CPU features can't be queried without a backend
+		if (!g_system)
+			return kernelsGeneric;
+
+		kernels = &kernelsGeneric;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) kernels = &kernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) kernels = &kernelsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) kernels = &kernelsAVX2;
+#endif
+	}
+
+	return *kernels;
+}
+
+bool CrossBlit::convert(byte *dst, const byte *src,
+						const uint dstPitch, const uint srcPitch,
+						const uint w, const uint h,
+						const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	if (dstFmt.bytesPerPixel != 4 || !isSupported(srcFmt))
+		return false;
+
+	const Kernels &k = getKernels();
+	const Args args(dstFmt, srcFmt);
+
+	if (srcFmt.bytesPerPixel == 2) {
+		// Go from the bottom up so that in place conversion works,
+		// see crossBlit.
+		for (uint y = h; y-- > 0;)
+			k.convert16To32(dst + y * dstPitch, src + y * srcPitch, w, args);
+	} else if (srcFmt.bytesPerPixel == 4) {
+		for (uint y = 0; y < h; y++)
+			k.convert32To32(dst + y * dstPitch, src + y * srcPitch, w, args);
+	} else {
+		return false;
+	}
+	return true;
+}
+
+bool CrossBlit::map(byte *dst, const byte *src,
+					const uint dstPitch, const uint srcPitch,
+					const uint w, const uint h,
+					const uint bytesPerPixel, const uint32 *map) {
+	MapRowFunc func;
+	if (bytesPerPixel == 2)
+		func = getKernels().map8To16;
+	else if (bytesPerPixel == 4)
+		func = getKernels().map8To32;
+	else
+		return false;
+
+	// Go from the bottom up so that in place conversion works,
+	// see crossBlitMap.
+	for (uint y = h; y-- > 0;)
+		func(dst + y * dstPitch, src + y * srcPitch, w, map);
+	return true;
+}
+
 } // End of namespace Graphics
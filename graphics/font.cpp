@@ -27,6 +27,52 @@
 
 namespace Graphics {
 
+template<class StringType>
+struct WordWrapCacheEntry {
+	StringType str;
+	int maxWidth;
+	int initWidth;
+	uint32 mode;
+	Common::Array<StringType> lines;
+	int width;
+};
+
+/**
+ * Keeps the last few word wrapping results of a font. GUI widgets and
+ * engines usually wrap the same text on every redraw.
+ */
+struct WordWrapCache {
+	enum {
+		kSize = 16
+	};
+
+	Common::Array<WordWrapCacheEntry<Common::String> > entries;
+	Common::Array<WordWrapCacheEntry<Common::U32String> > entriesU32;
+	uint next;
+	uint nextU32;
+
+	WordWrapCache() : next(0), nextU32(0) {}
+
+	Common::Array<WordWrapCacheEntry<Common::String> > &getEntries(const Common::String &) { return entries; }
+	Common::Array<WordWrapCacheEntry<Common::U32String> > &getEntries(const Common::U32String &) { return entriesU32; }
+	uint &getNext(const Common::String &) { return next; }
+	uint &getNext(const Common::U32String &) { return nextU32; }
+};
+
+Font::~Font() {
+	delete _wordWrapCache;
+}
+
+Font &Font::operator=(const Font &) {
+	invalidateLayoutCache();
+	return *this;
+}
+
+void Font::invalidateLayoutCache() const {
+	delete _wordWrapCache;
+	_wordWrapCache = nullptr;
+}
+
 int Font::getFontAscent() const {
 	return -1;
 }
@@ -489,12 +535,50 @@ void Font::drawString(ManagedSurface *dst, const Common::U32String &str, int x,
 	}
 }
 
+template<class StringType>
+int wordWrapTextCached(const Font &font, WordWrapCache *&cache, const StringType &str, int maxWidth, Common::Array<StringType> &lines, int initWidth, uint32 mode) {
+	// Even width wrapping may clear the lines passed in, leave that case alone
+	if ((mode & kWordWrapEvenWidthLines) && !lines.empty())
+		return wordWrapTextImpl(font, str, maxWidth, lines, initWidth, mode);
+
+	if (!cache)
+		cache = new WordWrapCache();
+
+	Common::Array<WordWrapCacheEntry<StringType> > &entries = cache->getEntries(str);
+	for (uint i = 0; i < entries.size(); ++i) {
+		const WordWrapCacheEntry<StringType> &entry = entries[i];
+		if (entry.maxWidth == maxWidth && entry.initWidth == initWidth && entry.mode == mode && entry.str == str) {
+			lines.push_back(entry.lines);
+			return entry.width;
+		}
+	}
+
+	// Replace the oldest entry once the cache is full
+	uint &next = cache->getNext(str);
+	if (entries.size() < WordWrapCache::kSize) {
+		entries.resize(entries.size() + 1);
+		next = entries.size() - 1;
+	}
+	WordWrapCacheEntry<StringType> &entry = entries[next];
+	next = (next + 1) % WordWrapCache::kSize;
+
+	entry.str = str;
+	entry.maxWidth = maxWidth;
+	entry.initWidth = initWidth;
+	entry.mode = mode;
+	entry.lines.clear();
+	entry.width = wordWrapTextImpl(font, str, maxWidth, entry.lines, initWidth, mode);
+
+	lines.push_back(entry.lines);
+	return entry.width;
+}
+
 int Font::wordWrapText(const Common::String &str, int maxWidth, Common::Array<Common::String> &lines, int initWidth, uint32 mode) const {
-	return wordWrapTextImpl(*this, str, maxWidth, lines, initWidth, mode);
+	return wordWrapTextCached(*this, _wordWrapCache, str, maxWidth, lines, initWidth, mode);
 }
 
 int Font::wordWrapText(const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, int initWidth, uint32 mode) const {
-	return wordWrapTextImpl(*this, str, maxWidth, lines, initWidth, mode);
+	return wordWrapTextCached(*this, _wordWrapCache, str, maxWidth, lines, initWidth, mode);
 }
 
 TextAlign convertTextAlignH(TextAlign alignH, bool rtl) {
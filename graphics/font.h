@@ -43,6 +43,7 @@ namespace Graphics {
 
 struct Surface;
 class ManagedSurface;
+struct WordWrapCache;
 
 /** Text alignment modes. */
 enum TextAlign {
@@ -81,8 +82,11 @@ TextAlign convertTextAlignH(TextAlign alignH, bool rtl);
  */
 class Font {
 public:
-	Font() {}
-	virtual ~Font() {}
+	Font() : _wordWrapCache(nullptr) {}
+	Font(const Font &) : _wordWrapCache(nullptr) {}
+	virtual ~Font();
+
+	Font &operator=(const Font &);
 
 	/**
 	 * Return the height of the font.
@@ -270,6 +274,15 @@ public:
 	/** @overload */
 	int wordWrapText(const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, int initWidth = 0, uint32 mode = kWordWrapOnExplicitNewLines) const;
 
+	/**
+	 * Forget the results of previous wordWrapText calls.
+	 *
+	 * The most recent word wrapping results are reused when the same text is
+	 * wrapped again with the same parameters. Fonts whose glyph metrics
+	 * can change after creation must call this whenever they do.
+	 */
+	void invalidateLayoutCache() const;
+
 	/**
 	 * Scales the single gylph at @p chr the given the @p scale and the pointer @p grayScaleMap to the grayscale array. It fills @p scaleSurface surface 
 	 * and then we draw the character on @p scaleSurface surface. The @p scaleSUrface is magnified to grayScale array and then we change the @p scaleSurface using the 
@@ -290,6 +303,8 @@ public:
 	 */
 	void scaleSingleGlyph(Surface *scaleSurface, int *grayScaleMap, int grayScaleMapSize, int width, int height, int xOffset, int yOffset, int grayLevel, int chr, int srcheight, int srcwidth, float scale) const;
 
+private:
+	mutable WordWrapCache *_wordWrapCache;
 };
 /** @} */
 } // End of namespace Graphics
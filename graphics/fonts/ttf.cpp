@@ -38,6 +38,7 @@
 #include "common/stream.h"
 #include "common/memstream.h"
 #include "common/hashmap.h"
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/compression/unzip.h"
 
@@ -171,8 +172,26 @@ private:
 	int _width, _height;
 	int _ascent, _descent;
 
+	// Glyph bitmaps are packed row by row into shared atlas pages instead
+	// of each owning a surface. Pages filled while loading are kept for the
+	// lifetime of the font; pages filled by late caching are dropped, least
+	// recently used first, once there are more than kMaxAtlasPages of them.
+	struct AtlasPage {
+		Surface surface;
+		int x, y, rowHeight;
+		uint32 lastUse;
+		bool pinned;
+		Common::Array<uint32> chars;
+	};
+
+	enum {
+		kAtlasPageSize = 256,
+		kMaxAtlasPages = 16
+	};
+
 	struct Glyph {
-		Surface image;
+		Surface image; // view into an atlas page
+		AtlasPage *page;
 		int xOffset, yOffset;
 		int advance;
 		FT_UInt slot;
@@ -184,6 +203,18 @@ private:
 	bool _allowLateCaching;
 	void assureCached(uint32 chr) const;
 
+	mutable Common::Array<AtlasPage *> _atlas;
+	mutable uint32 _atlasClock;
+	bool _pinAtlasPages;
+	bool allocateGlyphImage(Glyph &glyph, int w, int h) const;
+	void evictAtlasPage() const;
+
+	// The string drawing code asks for the same character several times in
+	// a row, so remember the last lookup.
+	mutable uint32 _lastChr;
+	mutable const Glyph *_lastGlyph;
+	const Glyph *findGlyph(uint32 chr) const;
+
 	Common::SeekableReadStream *readTTFTable(FT_ULong tag) const;
 
 	int computePointSize(int size, TTFSizeMode sizeMode) const;
@@ -203,7 +234,8 @@ private:
 TTFFont::TTFFont()
 	: _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
 	  _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
-	  _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false) {
+	  _hasKerning(false), _allowLateCaching(false), _atlasClock(0), _pinAtlasPages(false), _lastChr(0), _lastGlyph(nullptr),
+	  _fakeBold(false), _fakeItalic(false) {
 }
 
 TTFFont::~TTFFont() {
@@ -213,8 +245,11 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
+		for (uint i = 0; i < _atlas.size(); ++i) {
+			_atlas[i]->surface.free();
+			delete _atlas[i];
+		}
+		_atlas.clear();
 
 		_initialized = false;
 	}
@@ -367,6 +402,10 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 		_loadFlags |= FT_LOAD_NO_BITMAP;
 	}
 
+	// Glyphs cached while loading are not necessarily cached again on
+	// demand, so their pages are never evicted.
+	_pinAtlasPages = true;
+
 	if (!mapping) {
 		// Allow loading of all unicode characters.
 		_allowLateCaching = true;
@@ -400,6 +439,9 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 		}
 	}
 
+	_pinAtlasPages = false;
+	_lastGlyph = nullptr;
+
 	if (_glyphs.size() == 0) {
 		g_ttf.closeFont(_face);
 
@@ -553,34 +595,31 @@ int TTFFont::getMaxCharWidth() const {
 }
 
 int TTFFont::getCharWidth(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyph = findGlyph(chr);
+	if (!glyph)
 		return 0;
 	else
-		return glyphEntry->_value.advance;
+		return glyph->advance;
 }
 
 int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 	if (!_hasKerning)
 		return 0;
 
-	assureCached(left);
-	assureCached(right);
-
 	FT_UInt leftGlyph, rightGlyph;
-	GlyphCache::const_iterator glyphEntry;
+	const Glyph *glyph;
 
-	glyphEntry = _glyphs.find(left);
-	if (glyphEntry != _glyphs.end()) {
-		leftGlyph = glyphEntry->_value.slot;
+	// Only keep the slot, caching the right glyph may evict the left one.
+	glyph = findGlyph(left);
+	if (glyph) {
+		leftGlyph = glyph->slot;
 	} else {
 		return 0;
 	}
 
-	glyphEntry = _glyphs.find(right);
-	if (glyphEntry != _glyphs.end()) {
-		rightGlyph = glyphEntry->_value.slot;
+	glyph = findGlyph(right);
+	if (glyph) {
+		rightGlyph = glyph->slot;
 	} else {
 		return 0;
 	}
@@ -594,14 +633,13 @@ int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 }
 
 Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end()) {
+	const Glyph *glyph = findGlyph(chr);
+	if (!glyph) {
 		return Common::Rect();
 	} else {
-		const int xOffset = glyphEntry->_value.xOffset;
-		const int yOffset = glyphEntry->_value.yOffset;
-		const Graphics::Surface &image = glyphEntry->_value.image;
+		const int xOffset = glyph->xOffset;
+		const int yOffset = glyph->yOffset;
+		const Graphics::Surface &image = glyph->image;
 		return Common::Rect(xOffset, yOffset, xOffset + image.w, yOffset + image.h);
 	}
 }
@@ -674,12 +712,11 @@ void TTFFont::drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 col
 
 void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 		const uint32 *transparentColor) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyphPtr = findGlyph(chr);
+	if (!glyphPtr)
 		return;
 
-	const Glyph &glyph = glyphEntry->_value;
+	const Glyph &glyph = *glyphPtr;
 
 	x += glyph.xOffset;
 	y += glyph.yOffset;
@@ -813,7 +850,8 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 
 
-	glyph.image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
+	if (!allocateGlyphImage(glyph, bitmap->width, bitmap->rows))
+		return false;
 
 	const uint8 *src = bitmap->buffer;
 	int srcPitch = bitmap->pitch;
@@ -828,6 +866,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	case FT_PIXEL_MODE_MONO:
 		for (int y = 0; y < (int)bitmap->rows; ++y) {
 			const uint8 *curSrc = src;
+			uint8 *curDst = dst;
 			uint8 mask = 0;
 
 			for (int x = 0; x < (int)bitmap->width; ++x) {
@@ -835,12 +874,13 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 					mask = *curSrc++;
 
 				if (mask & 0x80)
-					*dst = 255;
+					*curDst = 255;
 
 				mask <<= 1;
-				++dst;
+				++curDst;
 			}
 
+			dst += glyph.image.pitch;
 			src += srcPitch;
 		}
 		break;
@@ -855,7 +895,6 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 
 	default:
 		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
-		glyph.image.free();
 		return false;
 	}
 
@@ -876,7 +915,87 @@ void TTFFont::assureCached(uint32 chr) const {
 	Glyph newGlyph;
 	if (cacheGlyph(newGlyph, chr)) {
 		_glyphs[chr] = newGlyph;
+		if (newGlyph.page)
+			newGlyph.page->chars.push_back(chr);
+	}
+}
+
+const TTFFont::Glyph *TTFFont::findGlyph(uint32 chr) const {
+	if (_lastGlyph && _lastChr == chr)
+		return _lastGlyph;
+
+	assureCached(chr);
+	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
+	if (glyphEntry == _glyphs.end())
+		return nullptr;
+
+	const Glyph *glyph = &glyphEntry->_value;
+	if (glyph->page)
+		glyph->page->lastUse = ++_atlasClock;
+
+	_lastChr = chr;
+	_lastGlyph = glyph;
+	return glyph;
+}
+
+bool TTFFont::allocateGlyphImage(Glyph &glyph, int w, int h) const {
+	glyph.page = nullptr;
+	glyph.image = Surface();
+	if (!w || !h)
+		return true;
+
+	AtlasPage *page = _atlas.empty() ? nullptr : _atlas.back();
+	if (page) {
+		// Start a new row when the glyph does not fit into the current one
+		if (page->x + w > page->surface.w) {
+			page->x = 0;
+			page->y += page->rowHeight;
+			page->rowHeight = 0;
+		}
+		if (page->x + w > page->surface.w || page->y + h > page->surface.h)
+			page = nullptr;
+	}
+
+	if (!page) {
+		evictAtlasPage();
+
+		page = new AtlasPage();
+		page->surface.create(MAX<int>(w, kAtlasPageSize), MAX<int>(h, kAtlasPageSize), PixelFormat::createFormatCLUT8());
+		page->x = page->y = page->rowHeight = 0;
+		page->lastUse = _atlasClock;
+		page->pinned = _pinAtlasPages;
+		_atlas.push_back(page);
+	}
+
+	glyph.page = page;
+	glyph.image = page->surface.getSubArea(Common::Rect(page->x, page->y, page->x + w, page->y + h));
+	page->x += w;
+	page->rowHeight = MAX(page->rowHeight, h);
+	return true;
+}
+
+void TTFFont::evictAtlasPage() const {
+	uint evictable = 0;
+	int oldest = -1;
+	for (uint i = 0; i < _atlas.size(); ++i) {
+		if (_atlas[i]->pinned)
+			continue;
+		++evictable;
+		if (oldest < 0 || _atlas[i]->lastUse < _atlas[oldest]->lastUse)
+			oldest = i;
 	}
+
+	if (evictable < kMaxAtlasPages)
+		return;
+
+	AtlasPage *page = _atlas[oldest];
+	for (uint i = 0; i < page->chars.size(); ++i)
+		_glyphs.erase(page->chars[i]);
+	_lastGlyph = nullptr;
+
+	page->surface.free();
+	delete page;
+	_atlas.remove_at(oldest);
 }
 
 Font *loadTTFFont(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode, uint dpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
@@ -21,51 +21,105 @@
 
 #include "graphics/framelimiter.h"
 
+#include "common/debug.h"
 #include "common/util.h"
 
 namespace Graphics {
 
-FrameLimiter::FrameLimiter(OSystem *system, const uint framerate) :
+FrameLimiter::FrameLimiter(OSystem *system, const uint framerate, const bool deferToVSync) :
 		_system(system),
-		_speedLimitMs(0),
+		_enabled(framerate != 0),
+		_deferToVSync(deferToVSync),
+		_sleeping(true),
+		_frameDurationUs(0),
 		_startFrameTime(0),
-		_lastFrameDurationMs(_speedLimitMs) {
-	// The frame limiter is disabled when vsync is enabled.
-	_enabled = !_system->getFeatureState(OSystem::kFeatureVSync) && framerate != 0;
-
+		_lastDeadline(0),
+		_sleepOvershootUs(1000),
+		_lastFrameDurationMs(0) {
 	if (_enabled) {
-		_speedLimitMs = 1000 / CLIP<uint>(framerate, 0, 100);
+		_frameDurationUs = 1000000 / CLIP<uint>(framerate, 1, 1000);
+		_lastFrameDurationMs = _frameDurationUs / 1000;
 	}
+	resetFrameDurations();
 }
 
 void FrameLimiter::startFrame() {
-	uint currentTime = _system->getMillis();
+	uint64 currentTime = _system->getMicros();
 
 	if (_startFrameTime != 0) {
-		_lastFrameDurationMs = currentTime - _startFrameTime;
+		uint64 duration = currentTime - _startFrameTime;
+		_lastFrameDurationMs = duration / 1000;
+		_frameDurations[MIN<uint64>(_lastFrameDurationMs, kHistogramSize - 1)]++;
 	}
 
 	_startFrameTime = currentTime;
 }
 
 void FrameLimiter::delayBeforeSwap() {
-	uint endFrameTime = _system->getMillis();
-	uint frameDuration = endFrameTime - _startFrameTime;
+	// The frame limiter is disabled when vsync is enabled.
+	if (!_enabled || (_deferToVSync && _system->getFeatureState(OSystem::kFeatureVSync))) {
+		_lastDeadline = 0;
+		return;
+	}
 
-	if (_enabled && frameDuration < _speedLimitMs) {
-		_system->delayMillis(_speedLimitMs - frameDuration);
+	// Frames are due one frame duration after the previous one was, rather
+	// than after this one started, so that the time spent swapping and
+	// the imprecise wakeups don't add up
+	uint64 now = _system->getMicros();
+	uint64 deadline = (_lastDeadline ? _lastDeadline : _startFrameTime) + _frameDurationUs;
+	if (now >= deadline) {
+		// Don't try to catch up when more than a whole frame late
+		_lastDeadline = (now - deadline > _frameDurationUs) ? now : deadline;
+		return;
 	}
+
+	// Sleep for as long as the system doesn't oversleep the deadline,
+	// and wait for the rest
+	uint64 remaining = deadline - now;
+	if (_sleeping && remaining > _sleepOvershootUs + 1000) {
+		uint sleepMs = (remaining - _sleepOvershootUs) / 1000;
+		_system->delayMillis(sleepMs);
+
+		uint64 slept = _system->getMicros() - now;
+		uint64 overshoot = slept > sleepMs * 1000 ? slept - sleepMs * 1000 : 0;
+		// Quickly follow an increase, slowly decay otherwise
+		_sleepOvershootUs = MAX(overshoot, _sleepOvershootUs - _sleepOvershootUs / 8);
+	}
+	while (_system->getMicros() < deadline) {
+	}
+
+	_lastDeadline = deadline;
 }
 
 void FrameLimiter::pause(bool pause) {
 	if (!pause) {
 		// Make sure the frame duration value is consistent when resuming
 		_startFrameTime = 0;
+		_lastDeadline = 0;
 	}
 }
 
+void FrameLimiter::setSleeping(bool sleeping) {
+	_sleeping = sleeping;
+}
+
 uint FrameLimiter::getLastFrameDuration() const {
 	return _lastFrameDurationMs;
 }
 
+uint32 FrameLimiter::getFrameDurationCount(uint durationMs) const {
+	return _frameDurations[MIN(durationMs, kHistogramSize - 1)];
+}
+
+void FrameLimiter::resetFrameDurations() {
+	memset(_frameDurations, 0, sizeof(_frameDurations));
+}
+
+void FrameLimiter::printFrameDurations() const {
+	for (uint i = 0; i < kHistogramSize; i++) {
+		if (_frameDurations[i])
+			debug("%s%u ms: %u frames", i == kHistogramSize - 1 ? ">= " : "", i, _frameDurations[i]);
+	}
+}
+
 } // End of namespace Graphics
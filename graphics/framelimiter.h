@@ -33,24 +33,55 @@ namespace Graphics {
  * by delaying until all of the timeslot allocated to the frame
  * is consumed.
  * Allows to curb CPU usage and have a stable framerate.
+ *
+ * The frames are scheduled in microseconds. Most of the delay is slept,
+ * and the last part, for which sleeping isn't precise enough, is spent
+ * busy waiting.
  */
 class FrameLimiter {
 public:
-	FrameLimiter(OSystem *system, const uint framerate);
+	/** Number of one millisecond buckets the frame durations are counted in. */
+	static const uint kHistogramSize = 64;
+
+	/**
+	 * @param deferToVSync  Don't limit the framerate while vsync is enabled,
+	 *                      as waiting for the swap already does.
+	 */
+	FrameLimiter(OSystem *system, const uint framerate, const bool deferToVSync = true);
 
 	void startFrame();
 	void delayBeforeSwap();
 
 	void pause(bool pause);
 
+	/** When disabled, the whole delay is spent busy waiting instead of sleeping. */
+	void setSleeping(bool sleeping);
+
 	uint getLastFrameDuration() const;
+
+	/**
+	 * Return how many frames took the given amount of milliseconds.
+	 *
+	 * The last bucket counts all frames taking that long or longer.
+	 */
+	uint32 getFrameDurationCount(uint durationMs) const;
+	void resetFrameDurations();
+
+	/** Print the counts of the frame durations, for debugging uneven frame pacing. */
+	void printFrameDurations() const;
+
 private:
 	OSystem *_system;
 
 	bool _enabled;
-	uint _speedLimitMs;
-	uint _startFrameTime;
+	bool _deferToVSync;
+	bool _sleeping;
+	uint64 _frameDurationUs;
+	uint64 _startFrameTime;
+	uint64 _lastDeadline;
+	uint64 _sleepOvershootUs;
 	uint _lastFrameDurationMs;
+	uint32 _frameDurations[kHistogramSize];
 };
 
 } // End of namespace Graphics
@@ -1393,4 +1393,88 @@ void MacTextCanvas::debugPrint(const char *prefix) {
 	D(8, "[done]");
 }
 
+bool MacTextCanvas::getRenderKey(Common::String &key) {
+	if (!_surface)
+		return false;
+
+	key = Common::String::format("%dx%d %d %d %d %d %d %u %d", _surface->w, _surface->h, _maxWidth, _textMaxWidth,
+		(int)_textAlignment, _textShadow, (int)_wm->_language, _tbgcolor, (int)_text.size());
+
+	for (uint i = 0; i < _text.size(); i++) {
+		if (!_text[i].picfname.empty() || _text[i].tableSurface)
+			return false;
+
+		key += Common::String::format("|%d %d %d", _text[i].y, getAlignOffset(i) + _text[i].indent + _text[i].firstLineIndent, _text[i].chunks.size());
+
+		for (uint j = 0; j < _text[i].chunks.size(); j++) {
+			MacFontRun &chunk = _text[i].chunks[j];
+
+			// Fonts are owned by the font manager, so the pointer identifies them
+			key += Common::String::format(";%p %u %d:", (const void *)chunk.getFont(), chunk.fgcolor, chunk.text.size());
+			key += chunk.text.encode();
+		}
+	}
+
+	return true;
+}
+
+bool MacTextRenderCache::restore(const Common::String &key, MacTextCanvas &canvas) {
+	if (!_index.contains(key))
+		return false;
+
+	EntryList::iterator it = _index[key];
+	Entry *entry = *it;
+
+	canvas._surface->copyRectToSurface(entry->surface, 0, 0, Common::Rect(entry->surface.w, entry->surface.h));
+	if (canvas._textShadow)
+		canvas._shadowSurface->copyRectToSurface(entry->shadowSurface, 0, 0, Common::Rect(entry->shadowSurface.w, entry->shadowSurface.h));
+
+	_entries.erase(it);
+	_entries.push_front(entry);
+	_index[key] = _entries.begin();
+
+	return true;
+}
+
+void MacTextRenderCache::store(const Common::String &key, MacTextCanvas &canvas) {
+	uint32 size = canvas._surface->pitch * canvas._surface->h;
+	if (canvas._textShadow)
+		size += canvas._shadowSurface->pitch * canvas._shadowSurface->h;
+
+	if (size > kBudget / 4 || _index.contains(key))
+		return;
+
+	while (_size + size > kBudget && !_entries.empty()) {
+		Entry *old = _entries.back();
+		_entries.pop_back();
+		_index.erase(old->key);
+		_size -= old->surface.pitch * old->surface.h + old->shadowSurface.pitch * old->shadowSurface.h;
+		old->surface.free();
+		old->shadowSurface.free();
+		delete old;
+	}
+
+	Entry *entry = new Entry;
+	entry->key = key;
+	entry->surface.copyFrom(canvas._surface->rawSurface());
+	if (canvas._textShadow)
+		entry->shadowSurface.copyFrom(canvas._shadowSurface->rawSurface());
+
+	_entries.push_front(entry);
+	_index[key] = _entries.begin();
+	_size += size;
+}
+
+void MacTextRenderCache::clear() {
+	for (auto &entry : _entries) {
+		entry->surface.free();
+		entry->shadowSurface.free();
+		delete entry;
+	}
+
+	_entries.clear();
+	_index.clear();
+	_size = 0;
+}
+
 } // End of namespace Graphics
@@ -22,6 +22,9 @@
 #ifndef GRAPHICS_MACGUI_MACTEXTCANVAS_H
 #define GRAPHICS_MACGUI_MACTEXTCANVAS_H
 
+#include "common/hashmap.h"
+#include "common/list.h"
+
 #include "graphics/macgui/macwindowmanager.h"
 
 namespace Graphics {
@@ -162,11 +165,49 @@ public:
 
 	void debugPrint(const char *prefix = nullptr);
 
+	/**
+	 * Builds a key describing everything render() depends on, for
+	 * looking the rendered surface up in the MacTextRenderCache.
+	 *
+	 * @return false if the text contains images or tables, which are not cached
+	 */
+	bool getRenderKey(Common::String &key);
+
 private:
 	void processTable(int line, int maxWidth);
 	void parsePicExt(const Common::U32String &ext, uint16 &w, uint16 &h, int defpercent);
 };
 
+/**
+ * Recently rendered text canvases, shared by all MacText widgets of a
+ * window manager, so that widgets showing the same text with the same
+ * layout don't draw it glyph by glyph again.
+ */
+class MacTextRenderCache {
+public:
+	MacTextRenderCache() : _size(0) {}
+	~MacTextRenderCache() { clear(); }
+
+	bool restore(const Common::String &key, MacTextCanvas &canvas);
+	void store(const Common::String &key, MacTextCanvas &canvas);
+	void clear();
+
+private:
+	struct Entry {
+		Common::String key;
+		Surface surface;
+		Surface shadowSurface;
+	};
+
+	typedef Common::List<Entry *> EntryList;
+
+	static const uint32 kBudget = 4 * 1024 * 1024;
+
+	EntryList _entries;	// most recently used first
+	Common::HashMap<Common::String, EntryList::iterator> _index;
+	uint32 _size;
+};
+
 struct MacTextTableRow {
 	Common::Array<MacTextCanvas> cells;
 	int heght = -1;
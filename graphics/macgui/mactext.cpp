@@ -560,11 +560,24 @@ void MacText::setDefaultFormatting(uint16 fontId, byte textSlant, uint16 fontSiz
 
 void MacText::render() {
 	if (_fullRefresh) {
-		_canvas._surface->clear(_canvas._tbgcolor);
-		if (_canvas._textShadow)
-			_canvas._shadowSurface->clear(_canvas._tbgcolor);
+		// Widgets showing the same text share the rendered result
+		Common::String key;
+		bool cacheable = false;
+		if (!_canvas._text.empty()) {
+			_canvas.reallocSurface();
+			cacheable = _canvas.getRenderKey(key);
+		}
 
-		_canvas.render(0, _canvas._text.size());
+		if (!cacheable || !_wm->_textRenderCache->restore(key, _canvas)) {
+			_canvas._surface->clear(_canvas._tbgcolor);
+			if (_canvas._textShadow)
+				_canvas._shadowSurface->clear(_canvas._tbgcolor);
+
+			_canvas.render(0, _canvas._text.size());
+
+			if (cacheable)
+				_wm->_textRenderCache->store(key, _canvas);
+		}
 
 		_fullRefresh = false;
 
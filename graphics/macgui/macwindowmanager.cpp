@@ -32,6 +32,7 @@
 #include "graphics/macgui/macwindow.h"
 #include "graphics/macgui/mactextwindow.h"
 #include "graphics/macgui/macmenu.h"
+#include "graphics/macgui/mactext-canvas.h"
 
 #include "image/bmp.h"
 
@@ -222,6 +223,7 @@ MacWindowManager::MacWindowManager(uint32 mode, MacPatterns *patterns, Common::L
 	_paletteLookup.setPalette(_palette, _paletteSize);
 
 	_fontMan = new MacFontManager(mode, language);
+	_textRenderCache = new MacTextRenderCache();
 
 	if (!(mode & kWMModeNoCursorOverride)) {
 		_cursor = nullptr;
@@ -252,6 +254,7 @@ MacWindowManager::~MacWindowManager() {
 		free(_palette);
 
 	delete _fontMan;
+	delete _textRenderCache;
 	delete _screenCopy;
 
 	delete _desktop;
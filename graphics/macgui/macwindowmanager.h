@@ -109,6 +109,7 @@ class MacWidget;
 class MacFont;
 
 class MacFontManager;
+class MacTextRenderCache;
 
 typedef Common::Array<byte *> MacPatterns;
 
@@ -395,6 +396,7 @@ public:
 
 public:
 	MacFontManager *_fontMan;
+	MacTextRenderCache *_textRenderCache;
 	uint32 _mode;
 	Common::Language _language;
 
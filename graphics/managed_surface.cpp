@@ -22,6 +22,7 @@
 #include "graphics/managed_surface.h"
 #include "graphics/blit.h"
 #include "common/algorithm.h"
+#include "common/array.h"
 #include "common/textconsole.h"
 #include "common/endian.h"
 
@@ -29,16 +30,38 @@ namespace Graphics {
 
 const int SCALE_THRESHOLD = 0x100;
 
+/**
+ * Number of transparent blits from a surface with the same transparent
+ * color before its opaque runs are computed
+ */
+const uint TRANSPARENT_SPANS_MIN_BLITS = 2;
+
+struct ManagedSurface::TransparentSpans {
+	uint32 transColor;
+	uint blitCount;  ///< Blits with transColor since the pixels last changed
+	bool built;
+	bool valid;      ///< Set if every pixel is either copied unchanged or skipped
+
+	/** Start and end column of the runs */
+	Common::Array<uint16> runs;
+	/** Index in runs of the first run of each row, and the end of the last row */
+	Common::Array<uint> rowStarts;
+
+	TransparentSpans() : transColor(0), blitCount(0), built(false), valid(false) {}
+};
+
 ManagedSurface::ManagedSurface() :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
-		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
+		_disposeAfterUse(DisposeAfterUse::NO), _pixelsRefCount(nullptr), _pixelsExposed(false),
+		_transparentSpans(nullptr), _owner(nullptr),
 		_transparentColor(0),_transparentColorSet(false), _paletteSet(false) {
 	memset(_palette, 0, sizeof(_palette));
 }
 
 ManagedSurface::ManagedSurface(const ManagedSurface &surf) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
-		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
+		_disposeAfterUse(DisposeAfterUse::NO), _pixelsRefCount(nullptr), _pixelsExposed(false),
+		_transparentSpans(nullptr), _owner(nullptr),
 		_transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
 	memset(_palette, 0, sizeof(_palette));
 	*this = surf;
@@ -46,7 +69,8 @@ ManagedSurface::ManagedSurface(const ManagedSurface &surf) :
 
 ManagedSurface::ManagedSurface(int width, int height) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
-		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
+		_disposeAfterUse(DisposeAfterUse::NO), _pixelsRefCount(nullptr), _pixelsExposed(false),
+		_transparentSpans(nullptr), _owner(nullptr),
 		_transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
 	memset(_palette, 0, sizeof(_palette));
 	create(width, height);
@@ -54,7 +78,8 @@ ManagedSurface::ManagedSurface(int width, int height) :
 
 ManagedSurface::ManagedSurface(int width, int height, const Graphics::PixelFormat &pixelFormat) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
-		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
+		_disposeAfterUse(DisposeAfterUse::NO), _pixelsRefCount(nullptr), _pixelsExposed(false),
+		_transparentSpans(nullptr), _owner(nullptr),
 		_transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
 	memset(_palette, 0, sizeof(_palette));
 	create(width, height, pixelFormat);
@@ -62,7 +87,8 @@ ManagedSurface::ManagedSurface(int width, int height, const Graphics::PixelForma
 
 ManagedSurface::ManagedSurface(ManagedSurface &surf, const Common::Rect &bounds) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
-		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
+		_disposeAfterUse(DisposeAfterUse::NO), _pixelsRefCount(nullptr), _pixelsExposed(false),
+		_transparentSpans(nullptr), _owner(nullptr),
 		_transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
 	memset(_palette, 0, sizeof(_palette));
 	create(surf, bounds);
@@ -70,7 +96,9 @@ ManagedSurface::ManagedSurface(ManagedSurface &surf, const Common::Rect &bounds)
 
 ManagedSurface::ManagedSurface(Surface *surf, DisposeAfterUse::Flag disposeAfterUse) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
-		_owner(nullptr), _transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
+		_pixelsRefCount(nullptr), _pixelsExposed(false),
+		_transparentSpans(nullptr), _owner(nullptr),
+		_transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
 	if (!surf) {
 		_disposeAfterUse = DisposeAfterUse::YES;
 
@@ -86,6 +114,9 @@ ManagedSurface::ManagedSurface(Surface *surf, DisposeAfterUse::Flag disposeAfter
 		_innerSurface.format = surf->format;
 		_innerSurface.setPixels(surf->getPixels());
 
+		// The caller may still have pointers to the pixels
+		_pixelsExposed = true;
+
 		delete surf;
 	} else {
 		copyFrom(*surf);
@@ -94,7 +125,9 @@ ManagedSurface::ManagedSurface(Surface *surf, DisposeAfterUse::Flag disposeAfter
 
 ManagedSurface::ManagedSurface(const Surface *surf) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
-		_owner(nullptr), _transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
+		_pixelsRefCount(nullptr), _pixelsExposed(false),
+		_transparentSpans(nullptr), _owner(nullptr),
+		_transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
 	if (!surf)  {
 		_disposeAfterUse = DisposeAfterUse::YES;
 
@@ -110,14 +143,20 @@ ManagedSurface::~ManagedSurface() {
 }
 
 ManagedSurface &ManagedSurface::operator=(const ManagedSurface &surf) {
+	if (&surf == this)
+		return *this;
+
 	// Free any current surface
 	free();
 
-	if (surf._disposeAfterUse == DisposeAfterUse::YES) {
+	if (surf._disposeAfterUse == DisposeAfterUse::YES && !surf._pixelsExposed && surf.getPixels()) {
+		// Share the pixels until one of the surfaces is changed
+		sharePixels(surf);
+	} else if (surf._disposeAfterUse == DisposeAfterUse::YES) {
 		// Create a new surface and copy the pixels from the source surface
 		create(surf.w, surf.h, surf.format);
 		Common::copy((const byte *)surf.getPixels(), (const byte *)surf.getPixels() +
-			surf.w * surf.h * surf.format.bytesPerPixel, (byte *)this->getPixels());
+			surf.w * surf.h * surf.format.bytesPerPixel, (byte *)_innerSurface.getPixels());
 	} else {
 		// Source isn't managed, so simply copy its fields
 		_owner = surf._owner;
@@ -144,6 +183,160 @@ void ManagedSurface::setPixels(void *newPixels) {
 	_innerSurface.setPixels(newPixels);
 }
 
+void ManagedSurface::unshare() {
+	assert(_pixelsRefCount && _disposeAfterUse == DisposeAfterUse::YES);
+
+	if (*_pixelsRefCount > 1) {
+		--*_pixelsRefCount;
+
+		Surface shared = _innerSurface;
+		_innerSurface = Surface();
+		_innerSurface.copyFrom(shared);
+	} else {
+		delete _pixelsRefCount;
+	}
+
+	_pixelsRefCount = nullptr;
+}
+
+void ManagedSurface::sharePixels(const ManagedSurface &surf) {
+	assert(surf._disposeAfterUse == DisposeAfterUse::YES && !surf._pixelsExposed);
+
+	if (!surf._pixelsRefCount)
+		surf._pixelsRefCount = new uint(1);
+	++*surf._pixelsRefCount;
+
+	_innerSurface = surf._innerSurface;
+	_pixelsRefCount = surf._pixelsRefCount;
+	_disposeAfterUse = DisposeAfterUse::YES;
+	markAllDirty();
+}
+
+/**
+ * Compute the runs of pixels that transBlit() copies unchanged, for an
+ * unscaled blit to a surface of the same format, without mask, palette
+ * remapping, override color or source alpha.
+ *
+ * @return False if some pixels are neither copied unchanged nor skipped.
+ */
+template<typename T>
+static bool buildTransparentSpans(const Surface &src, T transColor, Common::Array<uint16> &runs, Common::Array<uint> &rowStarts) {
+	// Same tests as transBlit() and transBlitPixel()
+	byte rst = 0, gst = 0, bst = 0;
+	bool isSrcTrans32 = src.format.aBits() != 0 && transColor != (uint32)-1 && transColor > 0;
+	if (isSrcTrans32)
+		src.format.colorToRGB(transColor, rst, gst, bst);
+
+	for (int y = 0; y < src.h; ++y) {
+		rowStarts.push_back(runs.size());
+
+		const T *srcLine = (const T *)src.getBasePtr(0, y);
+		int runStart = -1;
+		for (int x = 0; x <= src.w; ++x) {
+			bool copied = false;
+			if (x < src.w) {
+				const T srcVal = srcLine[x];
+				byte a, r, g, b;
+				if (isSrcTrans32) {
+					src.format.colorToRGB(srcVal, r, g, b);
+					copied = !(rst == r && gst == g && bst == b);
+				} else {
+					copied = srcVal != transColor;
+				}
+
+				if (copied && sizeof(T) != 1) {
+					src.format.colorToARGB(srcVal, a, r, g, b);
+					if (a == 0)
+						copied = false;
+					else if (a != 0xff || src.format.ARGBToColor(0xff, r, g, b) != srcVal)
+						return false;
+				}
+			}
+
+			if (copied && runStart < 0) {
+				runStart = x;
+			} else if (!copied && runStart >= 0) {
+				runs.push_back(runStart);
+				runs.push_back(x);
+				runStart = -1;
+			}
+		}
+	}
+
+	rowStarts.push_back(runs.size());
+	return true;
+}
+
+const ManagedSurface::TransparentSpans *ManagedSurface::getTransparentSpans(uint32 transColor) const {
+	// Pixels changed through a pointer, or by their owner, can't be tracked
+	if (_disposeAfterUse != DisposeAfterUse::YES || _pixelsExposed || empty())
+		return nullptr;
+
+	if (!_transparentSpans)
+		_transparentSpans = new TransparentSpans();
+
+	TransparentSpans &spans = *_transparentSpans;
+	if (spans.transColor != transColor) {
+		spans.transColor = transColor;
+		spans.blitCount = 0;
+		spans.built = false;
+		spans.runs.clear();
+		spans.rowStarts.clear();
+	}
+
+	if (!spans.built) {
+		if (++spans.blitCount < TRANSPARENT_SPANS_MIN_BLITS)
+			return nullptr;
+
+		spans.built = true;
+		if (format.bytesPerPixel == 1)
+			spans.valid = buildTransparentSpans<uint8>(_innerSurface, transColor, spans.runs, spans.rowStarts);
+		else if (format.bytesPerPixel == 2)
+			spans.valid = buildTransparentSpans<uint16>(_innerSurface, transColor, spans.runs, spans.rowStarts);
+		else if (format.bytesPerPixel == 4)
+			spans.valid = buildTransparentSpans<uint32>(_innerSurface, transColor, spans.runs, spans.rowStarts);
+		else
+			spans.valid = false;
+
+		if (!spans.valid) {
+			spans.runs.clear();
+			spans.rowStarts.clear();
+		}
+	}
+
+	return spans.valid ? &spans : nullptr;
+}
+
+void ManagedSurface::clearTransparentSpans() {
+	delete _transparentSpans;
+	_transparentSpans = nullptr;
+}
+
+/**
+ * Copy the opaque runs of the source area to the destination.
+ */
+static void transBlitSpans(const Surface &src, const Common::Rect &srcRect, Surface &dest, const Common::Point &destPos,
+		const Common::Array<uint16> &runs, const Common::Array<uint> &rowStarts) {
+	const int bpp = src.format.bytesPerPixel;
+
+	// Source columns that end up inside the destination
+	const int left = MAX<int>(srcRect.left, srcRect.left - destPos.x);
+	const int right = MIN<int>(srcRect.right, srcRect.left + dest.w - destPos.x);
+
+	for (int y = srcRect.top; y < srcRect.bottom; ++y) {
+		const int destY = destPos.y + y - srcRect.top;
+		if (destY < 0 || destY >= dest.h)
+			continue;
+
+		for (uint i = rowStarts[y]; i < rowStarts[y + 1]; i += 2) {
+			const int start = MAX<int>(runs[i], left);
+			const int end = MIN<int>(runs[i + 1], right);
+			if (start < end)
+				memcpy(dest.getBasePtr(destPos.x + start - srcRect.left, destY), src.getBasePtr(start, y), (end - start) * bpp);
+		}
+	}
+}
+
 void ManagedSurface::create(int16 width, int16 height) {
 	create(width, height, PixelFormat::createFormatCLUT8());
 }
@@ -165,6 +358,7 @@ void ManagedSurface::create(ManagedSurface &surf, const Common::Rect &bounds) {
 	free();
 
 	_offsetFromOwner = Common::Point(bounds.left, bounds.top);
+	// This surface writes to the pixels of its owner
 	_innerSurface.setPixels(surf.getBasePtr(bounds.left, bounds.top));
 	_innerSurface.pitch = surf.pitch;
 	_innerSurface.format = surf.format;
@@ -181,9 +375,21 @@ void ManagedSurface::create(ManagedSurface &surf, const Common::Rect &bounds) {
 }
 
 void ManagedSurface::free() {
-	if (_disposeAfterUse == DisposeAfterUse::YES)
-		_innerSurface.free();
+	if (_disposeAfterUse == DisposeAfterUse::YES) {
+		if (_pixelsRefCount && *_pixelsRefCount > 1) {
+			// Other copies still use the pixels
+			--*_pixelsRefCount;
+			_innerSurface = Surface();
+		} else {
+			delete _pixelsRefCount;
+			_innerSurface.free();
+		}
+	}
 
+	_pixelsRefCount = nullptr;
+	_pixelsExposed = false;
+	if (_transparentSpans)
+		clearTransparentSpans();
 	_disposeAfterUse = DisposeAfterUse::NO;
 	_owner = nullptr;
 	_offsetFromOwner = Common::Point(0, 0);
@@ -192,15 +398,23 @@ void ManagedSurface::free() {
 }
 
 void ManagedSurface::copyFrom(const ManagedSurface &surf) {
+	if (&surf == this)
+		return;
+
 	// Surface::copyFrom frees pixel pointer so let's free up ManagedSurface to be coherent
 	free();
 
-	// Copy the surface
-	_innerSurface.copyFrom(surf._innerSurface);
-	markAllDirty();
+	if (surf._disposeAfterUse == DisposeAfterUse::YES && !surf._pixelsExposed && surf.getPixels()) {
+		// Share the pixels until one of the surfaces is changed
+		sharePixels(surf);
+	} else {
+		// Copy the surface
+		_innerSurface.copyFrom(surf._innerSurface);
+		markAllDirty();
 
-	// Pixels data is now owned by us
-	_disposeAfterUse = DisposeAfterUse::YES;
+		// Pixels data is now owned by us
+		_disposeAfterUse = DisposeAfterUse::YES;
+	}
 
 	// Copy miscellaneous properties
 	_transparentColorSet = surf._transparentColorSet;
@@ -283,6 +497,8 @@ void ManagedSurface::blitFromInner(const Surface &src, const Common::Rect &srcRe
 	if (!srcRect.isValidRect())
 		return;
 
+	prepareWrite();
+
 	// Copy format so compiler can optimize better.
 	// This should allow it to do some loop optimizations and condition hoisting as it can tell nothing
 	// inside of the loop will clobber the format.
@@ -309,7 +525,7 @@ void ManagedSurface::blitFromInner(const Surface &src, const Common::Rect &srcRe
 		if (destY < 0 || destY >= h)
 			continue;
 		const byte *srcP = (const byte *)src.getBasePtr(srcRect.left, scaleYCtr / SCALE_THRESHOLD + srcRect.top);
-		byte *destP = (byte *)getBasePtr(destRect.left, destY);
+		byte *destP = (byte *)_innerSurface.getBasePtr(destRect.left, destY);
 
 		// For paletted format, assume the palette is the same and there is no transparency.
 		// We can thus do a straight copy of the pixels.
@@ -504,6 +720,21 @@ void ManagedSurface::transBlitFrom(const ManagedSurface &src, const Common::Rect
 	const byte *srcPalette = src._paletteSet ? src._palette : nullptr;
 	const byte *dstPalette = _paletteSet ? _palette : nullptr;
 
+	// Unchanged sprites blitted often are drawn by copying their opaque runs
+	prepareWrite();
+	if (&src != this && !flipped && !mask && !maskOnly && !overrideColor && srcAlpha == 0xff &&
+			!(srcPalette && dstPalette) && src.format == format &&
+			srcRect.width() == destRect.width() && srcRect.height() == destRect.height() &&
+			!srcRect.isEmpty() && Common::Rect(src.w, src.h).contains(srcRect)) {
+		const TransparentSpans *spans = src.getTransparentSpans(transColor);
+		if (spans) {
+			transBlitSpans(src._innerSurface, srcRect, _innerSurface, Common::Point(destRect.left, destRect.top),
+				spans->runs, spans->rowStarts);
+			addDirtyRect(destRect);
+			return;
+		}
+	}
+
 	transBlitFromInner(src._innerSurface, srcRect, destRect, transColor, flipped, overrideColor,
 		srcAlpha, srcPalette, dstPalette, mask, maskOnly);
 }
@@ -610,7 +841,7 @@ void transBlitPixel<byte, byte>(byte srcVal, byte &destVal, const Graphics::Pixe
 }
 
 template<typename TSRC, typename TDEST>
-void transBlit(const Surface &src, const Common::Rect &srcRect, ManagedSurface &dest, const Common::Rect &destRect,
+void transBlit(const Surface &src, const Common::Rect &srcRect, const ManagedSurface &dest, Surface &destPixels, const Common::Rect &destRect,
 		TSRC transColor, bool flipped, uint32 overrideColor, uint32 srcAlpha, const byte *srcPalette,
 		const byte *dstPalette, const Surface *mask, bool maskOnly) {
 	int scaleX = SCALE_THRESHOLD * srcRect.width() / destRect.width();
@@ -643,7 +874,7 @@ void transBlit(const Surface &src, const Common::Rect &srcRect, ManagedSurface &
 		if (mask)
 			mskLine = (const TSRC *)mask->getBasePtr(srcRect.left, scaleYCtr / SCALE_THRESHOLD + srcRect.top);
 
-		TDEST *destLine = (TDEST *)dest.getBasePtr(destRect.left, destY);
+		TDEST *destLine = (TDEST *)destPixels.getBasePtr(destRect.left, destY);
 
 		// Loop through drawing the pixels of the row
 		for (int destX = destRect.left, xCtr = 0, scaleXCtr = 0; destX < destRect.right; ++destX, ++xCtr, scaleXCtr += scaleX) {
@@ -698,7 +929,7 @@ void transBlit(const Surface &src, const Common::Rect &srcRect, ManagedSurface &
 
 #define HANDLE_BLIT(SRC_BYTES, DEST_BYTES, SRC_TYPE, DEST_TYPE) \
 	if (src.format.bytesPerPixel == SRC_BYTES && format.bytesPerPixel == DEST_BYTES) \
-		transBlit<SRC_TYPE, DEST_TYPE>(src, srcRect, *this, destRect, transColor, flipped, overrideColor, srcAlpha, srcPalette, dstPalette, mask, maskOnly); \
+		transBlit<SRC_TYPE, DEST_TYPE>(src, srcRect, *this, _innerSurface, destRect, transColor, flipped, overrideColor, srcAlpha, srcPalette, dstPalette, mask, maskOnly); \
 	else
 
 void ManagedSurface::transBlitFromInner(const Surface &src, const Common::Rect &srcRect,
@@ -712,6 +943,8 @@ void ManagedSurface::transBlitFromInner(const Surface &src, const Common::Rect &
 			error("Surface::transBlitFrom: mask dimensions do not match src");
 	}
 
+	prepareWrite();
+
 	HANDLE_BLIT(1, 1, uint8,  uint8)
 	HANDLE_BLIT(1, 2, uint8,  uint16)
 	HANDLE_BLIT(1, 4, uint8,  uint32)
@@ -737,7 +970,8 @@ Common::Rect ManagedSurface::blendBlitTo(ManagedSurface &target,
 										 const int width, const int height,
 										 const TSpriteBlendMode blend,
 										 const AlphaType alphaType) {
-	return blendBlitTo(*target.surfacePtr(), posX, posY, flipping, srcRect, colorMod, width, height, blend, alphaType);
+	target.prepareWrite();
+	return blendBlitTo(target._innerSurface, posX, posY, flipping, srcRect, colorMod, width, height, blend, alphaType);
 }
 Common::Rect ManagedSurface::blendBlitTo(Surface &target,
 										 const int posX, const int posY,
@@ -801,7 +1035,7 @@ Common::Rect ManagedSurface::blendBlitTo(Surface &target,
 	if (!dstArea.isEmpty() && !srcArea.isEmpty()) {
 		BlendBlit::blit(
 			(byte *)target.getBasePtr(0, 0),
-			(const byte *)getBasePtr(srcArea.left, srcArea.top),
+			(const byte *)_innerSurface.getBasePtr(srcArea.left, srcArea.top),
 			target.pitch, pitch,
 			dstArea.left, dstArea.top,
 			dstArea.width(), dstArea.height(),
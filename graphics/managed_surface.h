@@ -59,6 +59,28 @@ private:
 	 */
 	DisposeAfterUse::Flag _disposeAfterUse;
 
+	/**
+	 * If set, the pixels are shared with copies of this surface, which all
+	 * point to the same reference count. They're copied before being changed.
+	 */
+	mutable uint *_pixelsRefCount;
+
+	/**
+	 * Set when a pointer the caller could write the pixels through has been
+	 * handed out. Such pixels are never shared, since the writes couldn't
+	 * be noticed.
+	 */
+	bool _pixelsExposed;
+
+	struct TransparentSpans;
+
+	/**
+	 * Runs of pixels copied unchanged when this surface is the source of a
+	 * transparent blit. It's built after a few blits with the same
+	 * transparent color, and dropped when the pixels change.
+	 */
+	mutable TransparentSpans *_transparentSpans;
+
 	/**
 	 * If this managed surface represents a subsection of another managed surface,
 	 * store the owning surface.
@@ -96,6 +118,46 @@ protected:
 	void transBlitFromInner(const Surface &src, const Common::Rect &srcRect,
 		const Common::Rect &destRect, uint32 transColor, bool flipped, uint32 overrideColor,
 		uint32 srcAlpha, const byte *srcPalette, const byte *dstPalette, const Surface *mask, bool maskOnly);
+
+	/**
+	 * Prepare the pixels for being changed: give this surface its own copy
+	 * if they are shared, and drop the data computed from them.
+	 */
+	void prepareWrite() {
+		if (_pixelsRefCount)
+			unshare();
+		if (_transparentSpans)
+			clearTransparentSpans();
+	}
+
+	/**
+	 * Same as prepareWrite(), for when a pointer to the pixels is handed out.
+	 */
+	void exposePixels() {
+		prepareWrite();
+		_pixelsExposed = true;
+	}
+
+	/**
+	 * Copy the shared pixels of the surface.
+	 */
+	void unshare();
+
+	/**
+	 * Make this surface use the same pixels as the given owning surface.
+	 */
+	void sharePixels(const ManagedSurface &surf);
+
+	/**
+	 * Return the opaque runs of this surface for a transparent blit with the
+	 * given transparent color, or nullptr if they aren't available.
+	 */
+	const TransparentSpans *getTransparentSpans(uint32 transColor) const;
+
+	/**
+	 * Drop the opaque runs of the surface.
+	 */
+	void clearTransparentSpans();
 public:
 	/**
 	 * Clip the given source bounds so the passed destBounds will be entirely on-screen.
@@ -119,8 +181,8 @@ public:
 	 * Create a managed surface from another one.
 	 *
 	 * If the source surface is maintaining its own surface data, then
-	 * this surface will create its own surface of the same size and copy
-	 * the contents from the source surface.
+	 * this surface will share it until either surface is changed, when the
+	 * changed one gets its own copy.
 	 */
 	ManagedSurface(const ManagedSurface &surf);
 
@@ -174,12 +236,16 @@ public:
 	 * for any affected area
 	 */
 	const Surface &rawSurface() const { return _innerSurface; }
-	Surface *surfacePtr() { return &_innerSurface; }
+	Surface *surfacePtr() {
+		exposePixels();
+		return &_innerSurface;
+	}
 
 	/**
 	 * Reassign one managed surface to another one.
 	 *
-	 * @note If the source has a managed surface, it will be duplicated.
+	 * @note If the source has a managed surface, it will be shared until
+	 * either surface is changed.
 	 */
 	ManagedSurface &operator=(const ManagedSurface &surf);
 
@@ -213,6 +279,7 @@ public:
 	 * @param pixel The value of the pixel.
 	 */
 	inline void setPixel(int x, int y, uint32 pixel) {
+		prepareWrite();
 		return _innerSurface.setPixel(x, y, pixel);
 	}
 
@@ -237,13 +304,17 @@ public:
 	 * @return Pointer to the pixel.
 	 */
 	inline void *getBasePtr(int x, int y) {
+		exposePixels();
 		return _innerSurface.getBasePtr(x, y);
 	}
 
 	/**
 	 * Get a reference to the pixel data.
 	 */
-	inline void *getPixels() { return _innerSurface.getPixels(); }
+	inline void *getPixels() {
+		exposePixels();
+		return _innerSurface.getPixels();
+	}
 	/** @overload */
 	inline const void *getPixels() const { return _innerSurface.getPixels(); }
 
@@ -582,6 +653,7 @@ public:
 	 * The pixel format of the buffer must match the pixel format of the surface.
 	 */
 	void copyRectToSurface(const void *buffer, int srcPitch, int destX, int destY, int width, int height) {
+		prepareWrite();
 		_innerSurface.copyRectToSurface(buffer, srcPitch, destX, destY, width, height);
 	}
 
@@ -591,6 +663,7 @@ public:
 	 * The pixel format of the buffer must match the pixel format of the surface.
 	 */
 	void copyRectToSurface(const Graphics::Surface &srcSurface, int destX, int destY, const Common::Rect subRect) {
+		prepareWrite();
 		_innerSurface.copyRectToSurface(srcSurface, destX, destY, subRect);
 	}
 
@@ -600,6 +673,7 @@ public:
 	 * The pixel format of the buffer must match the pixel format of the surface.
 	 */
 	void copyRectToSurfaceWithKey(const void *buffer, int srcPitch, int destX, int destY, int width, int height, uint32 key) {
+		prepareWrite();
 		_innerSurface.copyRectToSurfaceWithKey(buffer, srcPitch, destX, destY, width, height, key);
 	}
 
@@ -609,6 +683,7 @@ public:
 	 * The pixel format of the buffer must match the pixel format of the surface.
 	 */
 	void copyRectToSurfaceWithKey(const Graphics::Surface &srcSurface, int destX, int destY, const Common::Rect subRect, uint32 key) {
+		prepareWrite();
 		_innerSurface.copyRectToSurfaceWithKey(srcSurface, destX, destY, subRect, key);
 	}
 
@@ -628,6 +703,7 @@ public:
 	 * Draw a line.
 	 */
 	void drawLine(int x0, int y0, int x1, int y1, uint32 color) {
+		prepareWrite();
 		_innerSurface.drawLine(x0, y0, x1, y1, color);
 		addDirtyRect(Common::Rect(MIN(x0, x1), MIN(y0, y1), MAX(x0, x1 + 1), MAX(y0, y1 + 1)));
 	}
@@ -636,6 +712,7 @@ public:
 	 * Draw a thick line.
 	 */
 	void drawThickLine(int x0, int y0, int x1, int y1, int penX, int penY, uint32 color) {
+		prepareWrite();
 		_innerSurface.drawThickLine(x0, y0, x1, y1, penX, penY, color);
 		addDirtyRect(Common::Rect(MIN(x0, x1 + penX), MIN(y0, y1 + penY), MAX(x0, x1 + penX), MAX(y0, y1 + penY)));
 	}
@@ -644,6 +721,7 @@ public:
 	 * Draw a horizontal line.
 	 */
 	void hLine(int x, int y, int x2, uint32 color) {
+		prepareWrite();
 		_innerSurface.hLine(x, y, x2, color);
 		addDirtyRect(Common::Rect(x, y, x2 + 1, y + 1));
 	}
@@ -652,6 +730,7 @@ public:
 	 * Draw a vertical line.
 	 */
 	void vLine(int x, int y, int y2, uint32 color) {
+		prepareWrite();
 		_innerSurface.vLine(x, y, y2, color);
 		addDirtyRect(Common::Rect(x, y, x + 1, y2 + 1));
 	}
@@ -660,6 +739,7 @@ public:
 	 * Fill a rect with a given color.
 	 */
 	void fillRect(Common::Rect r, uint32 color) {
+		prepareWrite();
 		_innerSurface.fillRect(r, color);
 		addDirtyRect(r);
 	}
@@ -668,6 +748,7 @@ public:
 	 * Draw a frame around a specified rect.
 	 */
 	void frameRect(const Common::Rect &r, uint32 color) {
+		prepareWrite();
 		_innerSurface.frameRect(r, color);
 		addDirtyRect(r);
 	}
@@ -678,6 +759,7 @@ public:
 	 */
 	Surface getSubArea(const Common::Rect &area) {
 		addDirtyRect(area);
+		exposePixels();
 		return _innerSurface.getSubArea(area);
 	}
 
@@ -691,6 +773,7 @@ public:
 	 * @param dstFormat  The desired format.
 	 */
 	void convertToInPlace(const PixelFormat &dstFormat) {
+		prepareWrite();
 		_innerSurface.convertToInPlace(dstFormat);
 	}
 
@@ -707,6 +790,7 @@ public:
 	 * @param paletteCount  The number of colors in the palette.
 	 */
 	void convertToInPlace(const PixelFormat &dstFormat, const byte *palette, byte paletteStart, uint16 paletteCount) {
+		prepareWrite();
 		_innerSurface.convertToInPlace(dstFormat, palette, paletteStart, paletteCount);
 	}
 
@@ -94,6 +94,17 @@ MODULE_OBJS += \
 	tinygl/ztriangle.o \
 	tinygl/zblit.o \
 	tinygl/zdirtyrect.o
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	tinygl/ztriangle-neon.o
+$(MODULE)/tinygl/ztriangle-neon.o: CXXFLAGS += $(NEON_CXXFLAGS)
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	tinygl/ztriangle-sse2.o
+$(MODULE)/tinygl/ztriangle-sse2.o: CXXFLAGS += -msse2
+endif
 endif
 
 ifdef USE_ASPECT
@@ -117,6 +128,12 @@ MODULE_OBJS += \
 	scaler/Normal2xARM.o
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	scaler/scale2x-sse2.o
+$(MODULE)/scaler/scale2x-sse2.o: CXXFLAGS += -msse2
+endif
+
 ifdef USE_HQ_SCALERS
 MODULE_OBJS += \
 	scaler/hq.o
@@ -127,6 +144,22 @@ MODULE_OBJS += \
 	scaler/hq3x_i386.o
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	scaler/hq-neon.o
+$(MODULE)/scaler/hq-neon.o: CXXFLAGS += $(NEON_CXXFLAGS)
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	scaler/hq-sse2.o
+$(MODULE)/scaler/hq-sse2.o: CXXFLAGS += -msse2
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	scaler/hq-avx2.o
+$(MODULE)/scaler/hq-avx2.o: CXXFLAGS += -mavx2
+endif
+
 endif
 
 ifdef USE_EDGE_SCALERS
@@ -157,5 +190,32 @@ MODULE_OBJS += \
 $(MODULE)/blit/blit-avx2.o: CXXFLAGS += -mavx2
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	yuv_to_rgb-neon.o
+$(MODULE)/yuv_to_rgb-neon.o: CXXFLAGS += $(NEON_CXXFLAGS)
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	yuv_to_rgb-sse2.o
+$(MODULE)/yuv_to_rgb-sse2.o: CXXFLAGS += -msse2
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	yuv_to_rgb-avx2.o
+$(MODULE)/yuv_to_rgb-avx2.o: CXXFLAGS += -mavx2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	VectorRendererSpec-neon.o
+$(MODULE)/VectorRendererSpec-neon.o: CXXFLAGS += $(NEON_CXXFLAGS)
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	VectorRendererSpec-sse2.o
+$(MODULE)/VectorRendererSpec-sse2.o: CXXFLAGS += -msse2
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
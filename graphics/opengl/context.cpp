@@ -67,6 +67,8 @@ void Context::reset() {
 	packedPixelsSupported = false;
 	packedDepthStencilSupported = false;
 	unpackSubImageSupported = false;
+	pixelBufferObjectSupported = false;
+	bufferStorageSupported = false;
 	OESDepth24 = false;
 	textureEdgeClampSupported = false;
 	textureBorderClampSupported = false;
@@ -175,6 +177,7 @@ void Context::initialize(ContextType contextType) {
 	bool ARBFragmentShader = false;
 	bool EXTFramebufferMultisample = false;
 	bool EXTFramebufferBlit = false;
+	bool ARBBufferStorage = false;
 
 	Common::StringTokenizer tokenizer(extString, " ");
 	while (!tokenizer.empty()) {
@@ -200,6 +203,10 @@ void Context::initialize(ContextType contextType) {
 			packedDepthStencilSupported = true;
 		} else if (token == "GL_EXT_unpack_subimage") {
 			unpackSubImageSupported = true;
+		} else if (token == "GL_ARB_pixel_buffer_object") {
+			pixelBufferObjectSupported = true;
+		} else if (token == "GL_ARB_buffer_storage") {
+			ARBBufferStorage = true;
 		} else if (token == "GL_EXT_framebuffer_multisample") {
 			EXTFramebufferMultisample = true;
 		} else if (token == "GL_EXT_framebuffer_blit") {
@@ -248,6 +255,12 @@ void Context::initialize(ContextType contextType) {
 		// No border clamping in GLES2
 		textureMirrorRepeatSupported = true;
 		// TODO: textureMaxLevelSupported with GLES3
+
+		// GLES3 adds unpack sub-image and pixel buffer object support
+		if (isGLVersionOrHigher(3, 0)) {
+			unpackSubImageSupported = true;
+			pixelBufferObjectSupported = true;
+		}
 		debug(5, "OpenGL: GLES2 context initialized");
 	} else if (type == kContextGLES) {
 		// GLES doesn't support shaders natively
@@ -307,6 +320,15 @@ void Context::initialize(ContextType contextType) {
 		if (isGLVersionOrHigher(1, 4)) {
 			textureMirrorRepeatSupported = true;
 		}
+		// OpenGL 2.1 adds pixel buffer object support
+		if (isGLVersionOrHigher(2, 1)) {
+			pixelBufferObjectSupported = true;
+		}
+		// Persistent mapping needs glMapBufferRange and fences (OpenGL 3.2)
+		// and OpenGL 4.4 or GL_ARB_buffer_storage
+		if (isGLVersionOrHigher(3, 2) && (isGLVersionOrHigher(4, 4) || ARBBufferStorage)) {
+			bufferStorageSupported = true;
+		}
 		debug(5, "OpenGL: GL context initialized");
 	} else {
 		warning("OpenGL: Unknown context initialized");
@@ -332,6 +354,8 @@ void Context::initialize(ContextType contextType) {
 	debug(5, "OpenGL: Packed pixels support: %d", packedPixelsSupported);
 	debug(5, "OpenGL: Packed depth stencil support: %d", packedDepthStencilSupported);
 	debug(5, "OpenGL: Unpack subimage support: %d", unpackSubImageSupported);
+	debug(5, "OpenGL: Pixel buffer object support: %d", pixelBufferObjectSupported);
+	debug(5, "OpenGL: Buffer storage support: %d", bufferStorageSupported);
 	debug(5, "OpenGL: OpenGL ES depth 24 support: %d", OESDepth24);
 	debug(5, "OpenGL: Texture edge clamping support: %d", textureEdgeClampSupported);
 	debug(5, "OpenGL: Texture border clamping support: %d", textureBorderClampSupported);
@@ -105,6 +105,12 @@ public:
 	/** Whether specifying a pitch when uploading to textures is available or not */
 	bool unpackSubImageSupported;
 
+	/** Whether textures can be uploaded from pixel buffer objects or not */
+	bool pixelBufferObjectSupported;
+
+	/** Whether persistently mapped buffers and fences are available or not */
+	bool bufferStorageSupported;
+
 	/** Whether depth component 24 is supported or not */
 	bool OESDepth24;
 
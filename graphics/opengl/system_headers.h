@@ -58,6 +58,15 @@
 
 	#include "graphics/opengl/glad.h"
 
+	// The bundled GLAD loader is generated without GL_ARB_buffer_storage
+	#ifndef GL_MAP_PERSISTENT_BIT
+		#define GL_MAP_PERSISTENT_BIT 0x0040
+	#endif
+
+	#ifndef GL_MAP_COHERENT_BIT
+		#define GL_MAP_COHERENT_BIT 0x0080
+	#endif
+
 #elif USE_FORCED_GLES2
 
 	#define GL_GLEXT_PROTOTYPES
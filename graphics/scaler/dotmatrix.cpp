@@ -34,6 +34,7 @@ DotMatrixScaler::DotMatrixScaler(const Graphics::PixelFormat &format) : Scaler(f
 		lookup16[3] = lookup16[5] = lookup16[7] =
 			lookup16[9] = lookup16[13] =
 			lookup16[15] = lookup16[16] = format.RGBToColor(0, 0, 0);
+		_kernel = ScalerKernelTable<Kernel>(&DotMatrixScaler::scaleIntern<uint16>).select();
 	} else {
 		uint32 *lookup32 = (uint32 *)lookup;
 		lookup32[0] = lookup32[10] = format.ARGBToColor(0, 0, 63, 0);
@@ -44,16 +45,13 @@ DotMatrixScaler::DotMatrixScaler(const Graphics::PixelFormat &format) : Scaler(f
 		lookup32[3] = lookup32[5] = lookup32[7] =
 			lookup32[9] = lookup32[13] =
 			lookup32[15] = lookup32[16] = format.ARGBToColor(0, 0, 0, 0);
+		_kernel = ScalerKernelTable<Kernel>(&DotMatrixScaler::scaleIntern<uint32>).select();
 	}
 }
 
 void DotMatrixScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) {
-	if (_format.bytesPerPixel == 2) {
-		scaleIntern<uint16>(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
-	} else {
-		scaleIntern<uint32>(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
-	}
+	(this->*_kernel)(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
 }
 
 uint DotMatrixScaler::increaseFactor() {
@@ -32,8 +32,12 @@ protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
 private:
+	typedef void (DotMatrixScaler::*Kernel)(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+			uint32 dstPitch, int width, int height, int x, int y);
+
 	// Allocate enough for 32bpp formats
 	uint32 lookup[17];
+	Kernel _kernel;
 	template<typename Pixel>
 	void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 			uint32 dstPitch, int width, int height, int x, int y);
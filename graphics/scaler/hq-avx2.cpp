@@ -0,0 +1,63 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include <immintrin.h>
+
+#include "graphics/scaler/hq.h"
+
+/**
+ * Set bit @p bit in the lanes where the YUV values of @p a and @p b differ by
+ * more than the thresholds of diffYUV(), i.e. 0x30 in Y, 7 in U and 6 in V.
+ */
+static FORCEINLINE __m256i diffYUV_AVX2(__m256i a, __m256i b, int bit) {
+	const __m256i thresholds = _mm256_set1_epi32(0x00300706);
+	__m256i diff = _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a));
+	__m256i same = _mm256_cmpeq_epi32(_mm256_subs_epu8(diff, thresholds), _mm256_setzero_si256());
+	return _mm256_andnot_si256(same, _mm256_set1_epi32(bit));
+}
+
+void HQScaler::computePatternsAVX2(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int count) {
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m256i yuv5 = _mm256_loadu_si256((const __m256i *)(yuv + i + 1));
+		__m256i pattern;
+		pattern = diffYUV_AVX2(yuv5, _mm256_loadu_si256((const __m256i *)(yuvAbove + i)), 0x0001);
+		pattern = _mm256_or_si256(pattern, diffYUV_AVX2(yuv5, _mm256_loadu_si256((const __m256i *)(yuvAbove + i + 1)), 0x0002));
+		pattern = _mm256_or_si256(pattern, diffYUV_AVX2(yuv5, _mm256_loadu_si256((const __m256i *)(yuvAbove + i + 2)), 0x0004));
+		pattern = _mm256_or_si256(pattern, diffYUV_AVX2(yuv5, _mm256_loadu_si256((const __m256i *)(yuv + i)), 0x0008));
+		pattern = _mm256_or_si256(pattern, diffYUV_AVX2(yuv5, _mm256_loadu_si256((const __m256i *)(yuv + i + 2)), 0x0010));
+		pattern = _mm256_or_si256(pattern, diffYUV_AVX2(yuv5, _mm256_loadu_si256((const __m256i *)(yuvBelow + i)), 0x0020));
+		pattern = _mm256_or_si256(pattern, diffYUV_AVX2(yuv5, _mm256_loadu_si256((const __m256i *)(yuvBelow + i + 1)), 0x0040));
+		pattern = _mm256_or_si256(pattern, diffYUV_AVX2(yuv5, _mm256_loadu_si256((const __m256i *)(yuvBelow + i + 2)), 0x0080));
+
+		// Narrow the eight 32-bit patterns down to bytes. The packs work
+		// within each 128-bit half, so the halves are merged afterwards.
+		__m128i lo = _mm256_castsi256_si128(pattern);
+		__m128i hi = _mm256_extracti128_si256(pattern, 1);
+		__m128i packed = _mm_packs_epi32(lo, hi);
+		packed = _mm_packus_epi16(packed, packed);
+		_mm_storel_epi64((__m128i *)(patterns + i), packed);
+	}
+
+	if (i < count)
+		computePatternsGeneric(yuvAbove + i, yuv + i, yuvBelow + i, patterns + i, count - i);
+}
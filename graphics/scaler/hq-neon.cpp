@@ -0,0 +1,64 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+#include <arm_neon.h>
+
+#include "graphics/scaler/hq.h"
+
+/**
+ * Set bit @p bit in the lanes where the YUV values of @p a and @p b differ by
+ * more than the thresholds of diffYUV(), i.e. 0x30 in Y, 7 in U and 6 in V.
+ */
+static FORCEINLINE uint32x4_t diffYUV_NEON(uint32x4_t a, uint32x4_t b, uint32 bit) {
+	const uint8x16_t thresholds = vreinterpretq_u8_u32(vdupq_n_u32(0x00300706));
+	uint8x16_t over = vcgtq_u8(vabdq_u8(vreinterpretq_u8_u32(a), vreinterpretq_u8_u32(b)), thresholds);
+	uint32x4_t differ = vtstq_u32(vreinterpretq_u32_u8(over), vreinterpretq_u32_u8(over));
+	return vandq_u32(differ, vdupq_n_u32(bit));
+}
+
+void HQScaler::computePatternsNEON(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int count) {
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const uint32x4_t yuv5 = vld1q_u32(yuv + i + 1);
+		uint32x4_t pattern;
+		pattern = diffYUV_NEON(yuv5, vld1q_u32(yuvAbove + i), 0x0001);
+		pattern = vorrq_u32(pattern, diffYUV_NEON(yuv5, vld1q_u32(yuvAbove + i + 1), 0x0002));
+		pattern = vorrq_u32(pattern, diffYUV_NEON(yuv5, vld1q_u32(yuvAbove + i + 2), 0x0004));
+		pattern = vorrq_u32(pattern, diffYUV_NEON(yuv5, vld1q_u32(yuv + i), 0x0008));
+		pattern = vorrq_u32(pattern, diffYUV_NEON(yuv5, vld1q_u32(yuv + i + 2), 0x0010));
+		pattern = vorrq_u32(pattern, diffYUV_NEON(yuv5, vld1q_u32(yuvBelow + i), 0x0020));
+		pattern = vorrq_u32(pattern, diffYUV_NEON(yuv5, vld1q_u32(yuvBelow + i + 1), 0x0040));
+		pattern = vorrq_u32(pattern, diffYUV_NEON(yuv5, vld1q_u32(yuvBelow + i + 2), 0x0080));
+
+		// Narrow the four 32-bit patterns down to bytes
+		uint16x4_t narrow = vmovn_u32(pattern);
+		uint8x8_t bytes = vmovn_u16(vcombine_u16(narrow, narrow));
+		vst1_lane_u32((uint32 *)(patterns + i), vreinterpret_u32_u8(bytes), 0);
+	}
+
+	if (i < count)
+		computePatternsGeneric(yuvAbove + i, yuv + i, yuvBelow + i, patterns + i, count - i);
+}
+
+#endif
@@ -0,0 +1,60 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include <immintrin.h>
+
+#include "graphics/scaler/hq.h"
+
+/**
+ * Set bit @p bit in the lanes where the YUV values of @p a and @p b differ by
+ * more than the thresholds of diffYUV(), i.e. 0x30 in Y, 7 in U and 6 in V.
+ */
+static FORCEINLINE __m128i diffYUV_SSE2(__m128i a, __m128i b, int bit) {
+	const __m128i thresholds = _mm_set1_epi32(0x00300706);
+	__m128i diff = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+	__m128i same = _mm_cmpeq_epi32(_mm_subs_epu8(diff, thresholds), _mm_setzero_si128());
+	return _mm_andnot_si128(same, _mm_set1_epi32(bit));
+}
+
+void HQScaler::computePatternsSSE2(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int count) {
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128i yuv5 = _mm_loadu_si128((const __m128i *)(yuv + i + 1));
+		__m128i pattern;
+		pattern = diffYUV_SSE2(yuv5, _mm_loadu_si128((const __m128i *)(yuvAbove + i)), 0x0001);
+		pattern = _mm_or_si128(pattern, diffYUV_SSE2(yuv5, _mm_loadu_si128((const __m128i *)(yuvAbove + i + 1)), 0x0002));
+		pattern = _mm_or_si128(pattern, diffYUV_SSE2(yuv5, _mm_loadu_si128((const __m128i *)(yuvAbove + i + 2)), 0x0004));
+		pattern = _mm_or_si128(pattern, diffYUV_SSE2(yuv5, _mm_loadu_si128((const __m128i *)(yuv + i)), 0x0008));
+		pattern = _mm_or_si128(pattern, diffYUV_SSE2(yuv5, _mm_loadu_si128((const __m128i *)(yuv + i + 2)), 0x0010));
+		pattern = _mm_or_si128(pattern, diffYUV_SSE2(yuv5, _mm_loadu_si128((const __m128i *)(yuvBelow + i)), 0x0020));
+		pattern = _mm_or_si128(pattern, diffYUV_SSE2(yuv5, _mm_loadu_si128((const __m128i *)(yuvBelow + i + 1)), 0x0040));
+		pattern = _mm_or_si128(pattern, diffYUV_SSE2(yuv5, _mm_loadu_si128((const __m128i *)(yuvBelow + i + 2)), 0x0080));
+
+		// Narrow the four 32-bit patterns down to bytes
+		pattern = _mm_packs_epi32(pattern, pattern);
+		pattern = _mm_packus_epi16(pattern, pattern);
+		*(uint32 *)(patterns + i) = (uint32)_mm_cvtsi128_si32(pattern);
+	}
+
+	if (i < count)
+		computePatternsGeneric(yuvAbove + i, yuv + i, yuvBelow + i, patterns + i, count - i);
+}
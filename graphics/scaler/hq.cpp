@@ -193,15 +193,62 @@ static inline uint32 ConvertYUV(uint32 x, const uint32 *RGBtoYUV) {
 	return RGBtoYUV[r | g | b];
 }
 
+/**
+ * Number of pixels for which the neighbourhood patterns are computed at once.
+ */
+enum {
+	kPatternChunkSize = 256
+};
+
+/**
+ * Compute the YUV values of the three source lines around a run of
+ * @p count pixels starting at @p p, and derive from them the
+ * pattern of the run: which of its eight neighbours differ from a pixel.
+ */
+template<typename ColorMask>
+static inline void computePatterns(const typename ColorMask::PixelType *p, uint32 nextlineSrc, int count,
+                                   uint32 yuvLines[3][kPatternChunkSize + 2], uint8 *patterns,
+                                   const uint32 *RGBtoYUV, HQScaler::PatternFunc patternFunc) {
+	typedef typename ColorMask::PixelType Pixel;
+
+	for (int line = 0; line < 3; ++line) {
+		const Pixel *w = p - 1 + (line - 1) * (int)nextlineSrc;
+		uint32 *yuv = yuvLines[line];
+		for (int i = 0; i < count + 2; ++i)
+			yuv[i] = sizeof(Pixel) == 2 ? RGBtoYUV[w[i]] : ConvertYUV<ColorMask>(w[i], RGBtoYUV);
+	}
+
+	patternFunc(yuvLines[0], yuvLines[1], yuvLines[2], patterns, count);
+}
+
+void HQScaler::computePatternsGeneric(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int count) {
+	for (int i = 0; i < count; ++i) {
+		const int yuv5 = yuv[i + 1];
+		int pattern = 0;
+		if (diffYUV(yuv5, yuvAbove[i]))     pattern |= 0x0001;
+		if (diffYUV(yuv5, yuvAbove[i + 1])) pattern |= 0x0002;
+		if (diffYUV(yuv5, yuvAbove[i + 2])) pattern |= 0x0004;
+		if (diffYUV(yuv5, yuv[i]))          pattern |= 0x0008;
+		if (diffYUV(yuv5, yuv[i + 2]))      pattern |= 0x0010;
+		if (diffYUV(yuv5, yuvBelow[i]))     pattern |= 0x0020;
+		if (diffYUV(yuv5, yuvBelow[i + 1])) pattern |= 0x0040;
+		if (diffYUV(yuv5, yuvBelow[i + 2])) pattern |= 0x0080;
+		patterns[i] = pattern;
+	}
+}
+
 /*
  * The HQ2x high quality 2x graphics filter.
  * Original author Maxim Stepin (https://web.archive.org/web/20090204033742/http://www.hiend3d.com/hq2x.html).
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
 template<typename ColorMask>
-static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV) {
+static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV, HQScaler::PatternFunc patternFunc) {
 	typedef typename ColorMask::PixelType Pixel;
 
+	uint32 yuvLines[3][kPatternChunkSize + 2];
+	uint8 patterns[kPatternChunkSize];
+
 	int w1, w2, w3, w4, w5, w6, w7, w8, w9;
 
 	const uint32 nextlineSrc = srcPitch / sizeof(Pixel);
@@ -231,23 +278,21 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		w8 = *(p + nextlineSrc);
 
 		int tmpWidth = width;
+		int chunkPos = kPatternChunkSize;
 		while (tmpWidth--) {
+			if (chunkPos == kPatternChunkSize) {
+				computePatterns<ColorMask>(p, nextlineSrc, MIN(tmpWidth + 1, (int)kPatternChunkSize),
+				                           yuvLines, patterns, RGBtoYUV, patternFunc);
+				chunkPos = 0;
+			}
+
 			p++;
 
 			w3 = *(p - nextlineSrc);
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = patterns[chunkPos++];
 
 			switch (pattern) {
 			case 0:
@@ -2116,9 +2161,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
 template<typename ColorMask>
-static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV) {
+static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV, HQScaler::PatternFunc patternFunc) {
 	typedef typename ColorMask::PixelType Pixel;
 
+	uint32 yuvLines[3][kPatternChunkSize + 2];
+	uint8 patterns[kPatternChunkSize];
+
 	int  w1, w2, w3, w4, w5, w6, w7, w8, w9;
 
 	const uint32 nextlineSrc = srcPitch / sizeof(Pixel);
@@ -2149,23 +2197,21 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		w8 = *(p + nextlineSrc);
 
 		int tmpWidth = width;
+		int chunkPos = kPatternChunkSize;
 		while (tmpWidth--) {
+			if (chunkPos == kPatternChunkSize) {
+				computePatterns<ColorMask>(p, nextlineSrc, MIN(tmpWidth + 1, (int)kPatternChunkSize),
+				                           yuvLines, patterns, RGBtoYUV, patternFunc);
+				chunkPos = 0;
+			}
+
 			p++;
 
 			w3 = *(p - nextlineSrc);
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = patterns[chunkPos++];
 
 			switch (pattern) {
 			case 0:
@@ -4954,6 +5000,18 @@ HQScaler::HQScaler(const Graphics::PixelFormat &format) : Scaler(format),
 	_RGBtoYUV(nullptr) {
 	_factor = 2;
 
+	ScalerKernelTable<PatternFunc> patternFuncs(computePatternsGeneric);
+#ifdef SCUMMVM_NEON
+	patternFuncs.set(kScalerKernelNEON, computePatternsNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+	patternFuncs.set(kScalerKernelSSE2, computePatternsSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+	patternFuncs.set(kScalerKernelAVX2, computePatternsAVX2);
+#endif
+	_patternFunc = patternFuncs.select();
+
 	if (format.bytesPerPixel == 2) {
 		initLUT(format);
 	} else {
@@ -4987,19 +5045,19 @@ void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 void HQScaler::HQ2x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	if (_format.gLoss == 2)
 		HQ2x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _patternFunc);
 	else
 		HQ2x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _patternFunc);
 }
 
 void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	if (_format.gLoss == 2)
 		HQ3x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _patternFunc);
 	else
 		HQ3x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _patternFunc);
 }
 #endif
 
@@ -5007,15 +5065,15 @@ void HQScaler::HQ2x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 	if (_format.aLoss == 0) {
 		if (_format.aShift == 0) {
 			HQ2x_implementation<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, _patternFunc);
 		} else {
 			HQ2x_implementation<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, _patternFunc);
 		}
 	} else {
 		assert((_format.rMax() | _format.gMax() | _format.bMax()) <= 0xffffff);
 		HQ2x_implementation<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _patternFunc);
 	}
 }
 
@@ -5023,15 +5081,15 @@ void HQScaler::HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 	if (_format.aLoss == 0) {
 		if (_format.aShift == 0) {
 			HQ3x_implementation<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, _patternFunc);
 		} else {
 			HQ3x_implementation<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, _patternFunc);
 		}
 	} else {
 		assert((_format.rMax() | _format.gMax() | _format.bMax()) <= 0xffffff);
 		HQ3x_implementation<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _patternFunc);
 	}
 }
 
@@ -29,6 +29,14 @@ struct hqx_parameters;
 
 class HQScaler : public Scaler {
 public:
+	/**
+	 * Compute the neighbourhood patterns of @p count pixels from the YUV
+	 * values of their line and of the lines above and below. Each line
+	 * holds count + 2 values, starting with the left neighbour of the
+	 * first pixel.
+	 */
+	typedef void (*PatternFunc)(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int count);
+
 	HQScaler(const Graphics::PixelFormat &format);
 	~HQScaler();
 	uint increaseFactor() override;
@@ -43,7 +51,19 @@ protected:
 	inline void HQ2x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height);
 	inline void HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height);
 
+	static void computePatternsGeneric(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int count);
+#ifdef SCUMMVM_NEON
+	static void computePatternsNEON(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int count);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void computePatternsSSE2(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int count);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void computePatternsAVX2(const uint32 *yuvAbove, const uint32 *yuv, const uint32 *yuvBelow, uint8 *patterns, int count);
+#endif
+
 	uint32 *_RGBtoYUV;
+	PatternFunc _patternFunc;
 #ifdef USE_NASM
 	hqx_parameters *_hqx_params;
 #endif
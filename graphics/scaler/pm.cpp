@@ -185,19 +185,27 @@ void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dst
 
 }
 
-void PMScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
-							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) {
-	if (_format.bytesPerPixel == 2) {
-		if (_format.gLoss == 2)
-			::scaleIntern<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+PMScaler::PMScaler(const Graphics::PixelFormat &format) : Scaler(format) {
+	_factor = 2;
+
+	Kernel generic;
+	if (format.bytesPerPixel == 2) {
+		if (format.gLoss == 2)
+			generic = ::scaleIntern<Graphics::ColorMasks<565> >;
 		else
-			::scaleIntern<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+			generic = ::scaleIntern<Graphics::ColorMasks<555> >;
 	} else {
-		if (_format.aLoss == 0)
-			::scaleIntern<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+		if (format.aLoss == 0)
+			generic = ::scaleIntern<Graphics::ColorMasks<8888> >;
 		else
-			::scaleIntern<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+			generic = ::scaleIntern<Graphics::ColorMasks<888> >;
 	}
+	_kernel = ScalerKernelTable<Kernel>(generic).select();
+}
+
+void PMScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
+							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) {
+	_kernel(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
 }
 
 uint PMScaler::increaseFactor() {
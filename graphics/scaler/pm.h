@@ -25,12 +25,17 @@
 
 class PMScaler : public Scaler {
 public:
-	PMScaler(const Graphics::PixelFormat &format) : Scaler(format) { _factor = 2; }
+	PMScaler(const Graphics::PixelFormat &format);
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
 protected:
+	typedef void (*Kernel)(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+			uint32 dstPitch, int width, int height);
+
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
+
+	Kernel _kernel;
 };
 
 #endif
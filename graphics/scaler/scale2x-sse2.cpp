@@ -0,0 +1,130 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * This file contains an SSE2 implementation of the Scale2x effect.
+ *
+ * You can find a high-level description of the effect at:
+ *
+ * https://www.scale2x.it
+ */
+
+#include "common/scummsys.h"
+#include <immintrin.h>
+
+#include "graphics/scaler/scale2x.h"
+
+namespace {
+
+template<typename Pixel>
+struct SSE2Ops;
+
+template<>
+struct SSE2Ops<scale2x_uint8> {
+	static FORCEINLINE __m128i cmpeq(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+	static FORCEINLINE __m128i unpacklo(__m128i a, __m128i b) { return _mm_unpacklo_epi8(a, b); }
+	static FORCEINLINE __m128i unpackhi(__m128i a, __m128i b) { return _mm_unpackhi_epi8(a, b); }
+	static FORCEINLINE void scaleDef(scale2x_uint8 *dst0, scale2x_uint8 *dst1, const scale2x_uint8 *src0, const scale2x_uint8 *src1, const scale2x_uint8 *src2, unsigned count) {
+		scale2x_8_def(dst0, dst1, src0, src1, src2, count);
+	}
+};
+
+template<>
+struct SSE2Ops<scale2x_uint16> {
+	static FORCEINLINE __m128i cmpeq(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+	static FORCEINLINE __m128i unpacklo(__m128i a, __m128i b) { return _mm_unpacklo_epi16(a, b); }
+	static FORCEINLINE __m128i unpackhi(__m128i a, __m128i b) { return _mm_unpackhi_epi16(a, b); }
+	static FORCEINLINE void scaleDef(scale2x_uint16 *dst0, scale2x_uint16 *dst1, const scale2x_uint16 *src0, const scale2x_uint16 *src1, const scale2x_uint16 *src2, unsigned count) {
+		scale2x_16_def(dst0, dst1, src0, src1, src2, count);
+	}
+};
+
+template<>
+struct SSE2Ops<scale2x_uint32> {
+	static FORCEINLINE __m128i cmpeq(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+	static FORCEINLINE __m128i unpacklo(__m128i a, __m128i b) { return _mm_unpacklo_epi32(a, b); }
+	static FORCEINLINE __m128i unpackhi(__m128i a, __m128i b) { return _mm_unpackhi_epi32(a, b); }
+	static FORCEINLINE void scaleDef(scale2x_uint32 *dst0, scale2x_uint32 *dst1, const scale2x_uint32 *src0, const scale2x_uint32 *src1, const scale2x_uint32 *src2, unsigned count) {
+		scale2x_32_def(dst0, dst1, src0, src1, src2, count);
+	}
+};
+
+static FORCEINLINE __m128i select(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/**
+ * Scale a row of pixels by a factor of 2, with the same result as
+ * scale2x_*_def(). Both destination rows are computed at once, so every
+ * source vector is only loaded once.
+ */
+template<typename Pixel>
+static inline void scale2x_sse2(Pixel *dst0, Pixel *dst1, const Pixel *src0, const Pixel *src1, const Pixel *src2, unsigned count) {
+	typedef SSE2Ops<Pixel> Ops;
+	const unsigned pixelsPerVector = sizeof(__m128i) / sizeof(Pixel);
+
+	while (count >= pixelsPerVector) {
+		//      B
+		//    D E F
+		//      H
+		const __m128i b = _mm_loadu_si128((const __m128i *)src0);
+		const __m128i d = _mm_loadu_si128((const __m128i *)(src1 - 1));
+		const __m128i e = _mm_loadu_si128((const __m128i *)src1);
+		const __m128i f = _mm_loadu_si128((const __m128i *)(src1 + 1));
+		const __m128i h = _mm_loadu_si128((const __m128i *)src2);
+
+		const __m128i active = _mm_andnot_si128(_mm_or_si128(Ops::cmpeq(b, h), Ops::cmpeq(d, f)), _mm_set1_epi32(-1));
+
+		const __m128i e0 = select(_mm_and_si128(active, Ops::cmpeq(d, b)), b, e);
+		const __m128i e1 = select(_mm_and_si128(active, Ops::cmpeq(f, b)), b, e);
+		const __m128i e2 = select(_mm_and_si128(active, Ops::cmpeq(d, h)), h, e);
+		const __m128i e3 = select(_mm_and_si128(active, Ops::cmpeq(f, h)), h, e);
+
+		_mm_storeu_si128((__m128i *)dst0, Ops::unpacklo(e0, e1));
+		_mm_storeu_si128((__m128i *)(dst0 + pixelsPerVector), Ops::unpackhi(e0, e1));
+		_mm_storeu_si128((__m128i *)dst1, Ops::unpacklo(e2, e3));
+		_mm_storeu_si128((__m128i *)(dst1 + pixelsPerVector), Ops::unpackhi(e2, e3));
+
+		src0 += pixelsPerVector;
+		src1 += pixelsPerVector;
+		src2 += pixelsPerVector;
+		dst0 += 2 * pixelsPerVector;
+		dst1 += 2 * pixelsPerVector;
+		count -= pixelsPerVector;
+	}
+
+	if (count)
+		Ops::scaleDef(dst0, dst1, src0, src1, src2, count);
+}
+
+} // End of anonymous namespace
+
+void scale2x_8_sse2(scale2x_uint8* dst0, scale2x_uint8* dst1, const scale2x_uint8* src0, const scale2x_uint8* src1, const scale2x_uint8* src2, unsigned count) {
+	scale2x_sse2<scale2x_uint8>(dst0, dst1, src0, src1, src2, count);
+}
+
+void scale2x_16_sse2(scale2x_uint16* dst0, scale2x_uint16* dst1, const scale2x_uint16* src0, const scale2x_uint16* src1, const scale2x_uint16* src2, unsigned count) {
+	scale2x_sse2<scale2x_uint16>(dst0, dst1, src0, src1, src2, count);
+}
+
+void scale2x_32_sse2(scale2x_uint32* dst0, scale2x_uint32* dst1, const scale2x_uint32* src0, const scale2x_uint32* src1, const scale2x_uint32* src2, unsigned count) {
+	scale2x_sse2<scale2x_uint32>(dst0, dst1, src0, src1, src2, count);
+}
@@ -40,49 +40,111 @@
 #include "graphics/scaler/scale3x.h"
 #include "graphics/scaler/scalebit.h"
 
-#define DST(bits, num)	(scale2x_uint ## bits *)dst ## num
-#define SRC(bits, num)	(const scale2x_uint ## bits *)src ## num
+/**
+ * Adapt a typed Scale2x row kernel to the generic Scale2xRowFunc signature.
+ */
+template<typename Pixel, void (*Kernel)(Pixel *, Pixel *, const Pixel *, const Pixel *, const Pixel *, unsigned)>
+static void scale2xRow(void* dst0, void* dst1, const void* src0, const void* src1, const void* src2, unsigned count) {
+	Kernel((Pixel *)dst0, (Pixel *)dst1, (const Pixel *)src0, (const Pixel *)src1, (const Pixel *)src2, count);
+}
 
 /**
- * Apply the Scale2x effect on a group of rows. Used internally.
+ * Pick the fastest Scale2x row kernel the CPU supports for the given
+ * number of bytes per pixel.
  */
-static inline void stage_scale2x(void* dst0, void* dst1, const void* src0, const void* src1, const void* src2, unsigned pixel, unsigned pixel_per_row) {
+static Scale2xRowFunc selectScale2xRow(unsigned pixel) {
 	switch (pixel) {
+	case 1: {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+		ScalerKernelTable<Scale2xRowFunc> kernels(scale2xRow<scale2x_uint8, scale2x_8_mmx>);
+#elif defined(USE_ARM_SCALER_ASM)
+		ScalerKernelTable<Scale2xRowFunc> kernels(scale2xRow<scale2x_uint8, scale2x_8_arm>);
+#else
+		ScalerKernelTable<Scale2xRowFunc> kernels(scale2xRow<scale2x_uint8, scale2x_8_def>);
+#endif
+#ifdef SCUMMVM_SSE2
+		kernels.set(kScalerKernelSSE2, scale2xRow<scale2x_uint8, scale2x_8_sse2>);
+#endif
+		return kernels.select();
+	}
+	case 2: {
 #if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
-	case 1: scale2x_8_mmx( DST( 8,0), DST( 8,1), SRC( 8,0), SRC( 8,1), SRC( 8,2), pixel_per_row); break;
-	case 2: scale2x_16_mmx(DST(16,0), DST(16,1), SRC(16,0), SRC(16,1), SRC(16,2), pixel_per_row); break;
-	case 4: scale2x_32_mmx(DST(32,0), DST(32,1), SRC(32,0), SRC(32,1), SRC(32,2), pixel_per_row); break;
+		ScalerKernelTable<Scale2xRowFunc> kernels(scale2xRow<scale2x_uint16, scale2x_16_mmx>);
 #elif defined(USE_ARM_SCALER_ASM)
-	case 1: scale2x_8_arm( DST( 8,0), DST( 8,1), SRC( 8,0), SRC( 8,1), SRC( 8,2), pixel_per_row); break;
-	case 2: scale2x_16_arm(DST(16,0), DST(16,1), SRC(16,0), SRC(16,1), SRC(16,2), pixel_per_row); break;
-	case 4: scale2x_32_arm(DST(32,0), DST(32,1), SRC(32,0), SRC(32,1), SRC(32,2), pixel_per_row); break;
+		ScalerKernelTable<Scale2xRowFunc> kernels(scale2xRow<scale2x_uint16, scale2x_16_arm>);
 #else
-	case 1: scale2x_8_def( DST( 8,0), DST( 8,1), SRC( 8,0), SRC( 8,1), SRC( 8,2), pixel_per_row); break;
-	case 2: scale2x_16_def(DST(16,0), DST(16,1), SRC(16,0), SRC(16,1), SRC(16,2), pixel_per_row); break;
-	case 4: scale2x_32_def(DST(32,0), DST(32,1), SRC(32,0), SRC(32,1), SRC(32,2), pixel_per_row); break;
+		ScalerKernelTable<Scale2xRowFunc> kernels(scale2xRow<scale2x_uint16, scale2x_16_def>);
 #endif
-	default: break;
+#ifdef SCUMMVM_SSE2
+		kernels.set(kScalerKernelSSE2, scale2xRow<scale2x_uint16, scale2x_16_sse2>);
+#endif
+		return kernels.select();
+	}
+	case 4: {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+		ScalerKernelTable<Scale2xRowFunc> kernels(scale2xRow<scale2x_uint32, scale2x_32_mmx>);
+#elif defined(USE_ARM_SCALER_ASM)
+		ScalerKernelTable<Scale2xRowFunc> kernels(scale2xRow<scale2x_uint32, scale2x_32_arm>);
+#else
+		ScalerKernelTable<Scale2xRowFunc> kernels(scale2xRow<scale2x_uint32, scale2x_32_def>);
+#endif
+#ifdef SCUMMVM_SSE2
+		kernels.set(kScalerKernelSSE2, scale2xRow<scale2x_uint32, scale2x_32_sse2>);
+#endif
+		return kernels.select();
+	}
+	default:
+		return nullptr;
 	}
 }
 
 /**
- * Apply the Scale3x effect on a group of rows. Used internally.
+ * Apply the Scale2x effect on a group of rows. Used internally.
+ */
+static inline void stage_scale2x(void* dst0, void* dst1, const void* src0, const void* src1, const void* src2, Scale2xRowFunc row, unsigned pixel_per_row) {
+	if (row)
+		row(dst0, dst1, src0, src1, src2, pixel_per_row);
+}
+
+/**
+ * Adapt a typed Scale3x row kernel to the generic Scale3xRowFunc signature.
  */
-static inline void stage_scale3x(void* dst0, void* dst1, void* dst2, const void* src0, const void* src1, const void* src2, unsigned pixel, unsigned pixel_per_row) {
+template<typename Pixel, void (*Kernel)(Pixel *, Pixel *, Pixel *, const Pixel *, const Pixel *, const Pixel *, unsigned)>
+static void scale3xRow(void* dst0, void* dst1, void* dst2, const void* src0, const void* src1, const void* src2, unsigned count) {
+	Kernel((Pixel *)dst0, (Pixel *)dst1, (Pixel *)dst2, (const Pixel *)src0, (const Pixel *)src1, (const Pixel *)src2, count);
+}
+
+/**
+ * Pick the fastest Scale3x row kernel the CPU supports for the given
+ * number of bytes per pixel. Only the C kernels exist for now.
+ */
+static Scale3xRowFunc selectScale3xRow(unsigned pixel) {
 	switch (pixel) {
-	case 1: scale3x_8_def( DST( 8,0), DST( 8,1), DST( 8,2), SRC( 8,0), SRC( 8,1), SRC( 8,2), pixel_per_row); break;
-	case 2: scale3x_16_def(DST(16,0), DST(16,1), DST(16,2), SRC(16,0), SRC(16,1), SRC(16,2), pixel_per_row); break;
-	case 4: scale3x_32_def(DST(32,0), DST(32,1), DST(32,2), SRC(32,0), SRC(32,1), SRC(32,2), pixel_per_row); break;
-	default: break;
+	case 1:
+		return ScalerKernelTable<Scale3xRowFunc>(scale3xRow<scale3x_uint8, scale3x_8_def>).select();
+	case 2:
+		return ScalerKernelTable<Scale3xRowFunc>(scale3xRow<scale3x_uint16, scale3x_16_def>).select();
+	case 4:
+		return ScalerKernelTable<Scale3xRowFunc>(scale3xRow<scale3x_uint32, scale3x_32_def>).select();
+	default:
+		return nullptr;
 	}
 }
 
+/**
+ * Apply the Scale3x effect on a group of rows. Used internally.
+ */
+static inline void stage_scale3x(void* dst0, void* dst1, void* dst2, const void* src0, const void* src1, const void* src2, Scale3xRowFunc row, unsigned pixel_per_row) {
+	if (row)
+		row(dst0, dst1, dst2, src0, src1, src2, pixel_per_row);
+}
+
 /**
  * Apply the Scale4x effect on a group of rows. Used internally.
  */
-static inline void stage_scale4x(void* dst0, void* dst1, void* dst2, void* dst3, const void* src0, const void* src1, const void* src2, const void* src3, unsigned pixel, unsigned pixel_per_row) {
-	stage_scale2x(dst0, dst1, src0, src1, src2, pixel, 2 * pixel_per_row);
-	stage_scale2x(dst2, dst3, src1, src2, src3, pixel, 2 * pixel_per_row);
+static inline void stage_scale4x(void* dst0, void* dst1, void* dst2, void* dst3, const void* src0, const void* src1, const void* src2, const void* src3, Scale2xRowFunc row, unsigned pixel_per_row) {
+	stage_scale2x(dst0, dst1, src0, src1, src2, row, 2 * pixel_per_row);
+	stage_scale2x(dst2, dst3, src1, src2, src3, row, 2 * pixel_per_row);
 }
 
 #define SCDST(i) (dst+(i)*dst_slice)
@@ -103,7 +165,7 @@ static inline void stage_scale4x(void* dst0, void* dst1, void* dst2, void* dst3,
  * @param width Horizontal size in pixels of the source bitmap.
  * @param height Vertical size in pixels of the source bitmap.
  */
-static void scale2x(void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height) {
+static void scale2x(void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, Scale2xRowFunc row, unsigned width, unsigned height) {
 	unsigned char* dst = (unsigned char*)void_dst;
 	const unsigned char* src = (const unsigned char*)void_src;
 	unsigned count;
@@ -113,7 +175,7 @@ static void scale2x(void* void_dst, unsigned dst_slice, const void* void_src, un
 	count = height;
 
 	while (count) {
-		stage_scale2x(SCDST(0), SCDST(1), SCSRC(0), SCSRC(1), SCSRC(2), pixel, width);
+		stage_scale2x(SCDST(0), SCDST(1), SCSRC(0), SCSRC(1), SCSRC(2), row, width);
 
 		dst = SCDST(2);
 		src = SCSRC(1);
@@ -140,7 +202,7 @@ static void scale2x(void* void_dst, unsigned dst_slice, const void* void_src, un
  * @param width Horizontal size in pixels of the source bitmap.
  * @param height Vertical size in pixels of the source bitmap.
  */
-static void scale3x(void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height) {
+static void scale3x(void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, Scale3xRowFunc row, unsigned width, unsigned height) {
 	unsigned char* dst = (unsigned char*)void_dst;
 	const unsigned char* src = (const unsigned char*)void_src;
 	unsigned count;
@@ -150,7 +212,7 @@ static void scale3x(void* void_dst, unsigned dst_slice, const void* void_src, un
 	count = height;
 
 	while (count) {
-		stage_scale3x(SCDST(0), SCDST(1), SCDST(2), SCSRC(0), SCSRC(1), SCSRC(2), pixel, width);
+		stage_scale3x(SCDST(0), SCDST(1), SCDST(2), SCSRC(0), SCSRC(1), SCSRC(2), row, width);
 
 		dst = SCDST(3);
 		src = SCSRC(1);
@@ -180,7 +242,7 @@ static void scale3x(void* void_dst, unsigned dst_slice, const void* void_src, un
  * @param width Horizontal size in pixels of the source bitmap.
  * @param height Vertical size in pixels of the source bitmap.
  */
-static void scale4x_buf(void* void_dst, unsigned dst_slice, void* void_mid, unsigned mid_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height) {
+static void scale4x_buf(void* void_dst, unsigned dst_slice, void* void_mid, unsigned mid_slice, const void* void_src, unsigned src_slice, Scale2xRowFunc row, unsigned width, unsigned height) {
 	unsigned char* dst = (unsigned char*)void_dst;
 	const unsigned char* src = (const unsigned char*)void_src;
 	unsigned count;
@@ -198,13 +260,13 @@ static void scale4x_buf(void* void_dst, unsigned dst_slice, void* void_mid, unsi
 	mid[4] = mid[3] + mid_slice;
 	mid[5] = mid[4] + mid_slice;
 
-	stage_scale2x(SCMID(0), SCMID(1), SCSRC(0), SCSRC(1), SCSRC(2), pixel, width);
-	stage_scale2x(SCMID(2), SCMID(3), SCSRC(1), SCSRC(2), SCSRC(3), pixel, width);
+	stage_scale2x(SCMID(0), SCMID(1), SCSRC(0), SCSRC(1), SCSRC(2), row, width);
+	stage_scale2x(SCMID(2), SCMID(3), SCSRC(1), SCSRC(2), SCSRC(3), row, width);
 	while (count) {
 		unsigned char* tmp;
 
-		stage_scale2x(SCMID(4), SCMID(5), SCSRC(2), SCSRC(3), SCSRC(4), pixel, width);
-		stage_scale4x(SCDST(0), SCDST(1), SCDST(2), SCDST(3), SCMID(1), SCMID(2), SCMID(3), SCMID(4), pixel, width);
+		stage_scale2x(SCMID(4), SCMID(5), SCSRC(2), SCSRC(3), SCSRC(4), row, width);
+		stage_scale4x(SCDST(0), SCDST(1), SCDST(2), SCDST(3), SCMID(1), SCMID(2), SCMID(3), SCMID(4), row, width);
 
 		dst = SCDST(4);
 		src = SCSRC(1);
@@ -242,7 +304,7 @@ static void scale4x_buf(void* void_dst, unsigned dst_slice, void* void_mid, unsi
  * @param width Horizontal size in pixels of the source bitmap.
  * @param height Vertical size in pixels of the source bitmap.
  */
-static void scale4x(void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height) {
+static void scale4x(void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, Scale2xRowFunc row, unsigned pixel, unsigned width, unsigned height) {
 	unsigned mid_slice;
 	void* mid;
 
@@ -261,7 +323,7 @@ static void scale4x(void* void_dst, unsigned dst_slice, const void* void_src, un
 		return;
 #endif
 
-	scale4x_buf(void_dst, dst_slice, mid, mid_slice, void_src, src_slice, pixel, width, height);
+	scale4x_buf(void_dst, dst_slice, mid, mid_slice, void_src, src_slice, row, width, height);
 
 #if !defined(HAVE_ALLOCA)
 	free(mid);
@@ -328,6 +390,8 @@ int scale_precondition(unsigned scale, unsigned pixel, unsigned width, unsigned
  * Apply the Scale effect on a bitmap.
  * This function is simply a common interface for ::scale2x(), ::scale3x() and ::scale4x().
  * @param scale Scale factor. 2, 3 or 4.
+ * @param scale2xRow Scale2x row kernel, used by the factors 2 and 4.
+ * @param scale3xRow Scale3x row kernel, used by the factor 3.
  * @param void_dst Pointer at the first pixel of the destination bitmap.
  * @param dst_slice Size in bytes of a destination bitmap row.
  * @param void_src Pointer at the first pixel of the source bitmap.
@@ -336,29 +400,35 @@ int scale_precondition(unsigned scale, unsigned pixel, unsigned width, unsigned
  * @param width Horizontal size in pixels of the source bitmap.
  * @param height Vertical size in pixels of the source bitmap.
  */
-void scale(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height)
+void scale(unsigned scale, Scale2xRowFunc scale2xRow, Scale3xRowFunc scale3xRow, void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height)
 {
 	switch (scale) {
 	case 2:
-		scale2x(void_dst, dst_slice, void_src, src_slice, pixel, width, height);
+		scale2x(void_dst, dst_slice, void_src, src_slice, scale2xRow, width, height);
 		break;
 	case 3:
-		scale3x(void_dst, dst_slice, void_src, src_slice, pixel, width, height);
+		scale3x(void_dst, dst_slice, void_src, src_slice, scale3xRow, width, height);
 		break;
 	case 4:
-		scale4x(void_dst, dst_slice, void_src, src_slice, pixel, width, height);
+		scale4x(void_dst, dst_slice, void_src, src_slice, scale2xRow, pixel, width, height);
 		break;
 	default:
 		break;
 	}
 }
 
+AdvMameScaler::AdvMameScaler(const Graphics::PixelFormat &format) : Scaler(format) {
+	_factor = 2;
+	_scale2xRow = selectScale2xRow(format.bytesPerPixel);
+	_scale3xRow = selectScale3xRow(format.bytesPerPixel);
+}
+
 void AdvMameScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) {
 	if (_factor != 4)
-		::scale(_factor, dstPtr, dstPitch, srcPtr - srcPitch, srcPitch, _format.bytesPerPixel, width, height);
+		::scale(_factor, _scale2xRow, _scale3xRow, dstPtr, dstPitch, srcPtr - srcPitch, srcPitch, _format.bytesPerPixel, width, height);
 	else
-		::scale(_factor, dstPtr, dstPitch, srcPtr - srcPitch * 2, srcPitch, _format.bytesPerPixel, width, height);
+		::scale(_factor, _scale2xRow, _scale3xRow, dstPtr, dstPitch, srcPtr - srcPitch * 2, srcPitch, _format.bytesPerPixel, width, height);
 }
 
 uint AdvMameScaler::increaseFactor() {
@@ -39,17 +39,30 @@
 
 #include "graphics/scalerplugin.h"
 
+/**
+ * Scale2x kernel for a row of pixels, see scale2x_8_def().
+ */
+typedef void (*Scale2xRowFunc)(void* dst0, void* dst1, const void* src0, const void* src1, const void* src2, unsigned count);
+
+/**
+ * Scale3x kernel for a row of pixels, see scale3x_8_def().
+ */
+typedef void (*Scale3xRowFunc)(void* dst0, void* dst1, void* dst2, const void* src0, const void* src1, const void* src2, unsigned count);
+
 int scale_precondition(unsigned scale, unsigned pixel, unsigned width, unsigned height);
-void scale(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height);
+void scale(unsigned scale, Scale2xRowFunc scale2xRow, Scale3xRowFunc scale3xRow, void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height);
 
 class AdvMameScaler : public Scaler {
 public:
-	AdvMameScaler(const Graphics::PixelFormat &format) : Scaler(format) { _factor = 2; }
+	AdvMameScaler(const Graphics::PixelFormat &format);
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
+
+	Scale2xRowFunc _scale2xRow;
+	Scale3xRowFunc _scale3xRow;
 };
 
 #endif
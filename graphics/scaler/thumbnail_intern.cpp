@@ -20,6 +20,7 @@
  */
 
 #include "common/endian.h"
+#include "common/jobsystem.h"
 #include "common/scummsys.h"
 #include "common/system.h"
 
@@ -75,19 +76,51 @@ void createThumbnail_4(const uint8 *src, uint32 srcPitch, uint8 *dstPtr, uint32
 	}
 }
 
+// Rows are handed to the job system in slices of at least this many
+static const uint32 kParallelMinRows = 16;
+
+struct ReduceJob {
+	const Graphics::Surface *in;
+	Graphics::Surface *out;
+};
+
+template<typename ColorMask, int factor>
+static void reduceRowsProc(uint32 begin, uint32 end, void *refCon) {
+	const ReduceJob *job = (const ReduceJob *)refCon;
+
+	const uint8 *src = (const uint8 *)job->in->getBasePtr(0, begin * factor);
+	uint8 *dst = (uint8 *)job->out->getBasePtr(0, begin);
+	const int height = (end - begin) * factor;
+	if (factor == 4)
+		createThumbnail_4<ColorMask>(src, job->in->pitch, dst, job->out->pitch, job->in->w, height);
+	else
+		createThumbnail_2<ColorMask>(src, job->in->pitch, dst, job->out->pitch, job->in->w, height);
+}
+
+/**
+ * Average blocks of factor x factor pixels of the input, replacing it by a
+ * surface of a factor smaller size. The rows are reduced on the job system,
+ * since this is where most of the time goes for large screens.
+ */
+template<typename ColorMask, int factor>
+static void reduceThumbnail(Graphics::Surface &in) {
+	Graphics::Surface reduced;
+	reduced.create(in.w / factor, in.h / factor, in.format);
+
+	ReduceJob job = { &in, &reduced };
+	g_system->getJobSystem()->parallelFor(reduced.h, reduceRowsProc<ColorMask, factor>, &job, kParallelMinRows);
+
+	in.free();
+	in = reduced;
+}
+
 template<typename ColorMask>
 static void scaleThumbnail(Graphics::Surface &in, Graphics::Surface &out) {
-	while (in.w / out.w >= 4 || in.h / out.h >= 4) {
-		createThumbnail_4<ColorMask>((const uint8 *)in.getPixels(), in.pitch, (uint8 *)in.getPixels(), in.pitch, in.w, in.h);
-		in.w /= 4;
-		in.h /= 4;
-	}
+	while (in.w / out.w >= 4 || in.h / out.h >= 4)
+		reduceThumbnail<ColorMask, 4>(in);
 
-	while (in.w / out.w >= 2 || in.h / out.h >= 2) {
-		createThumbnail_2<ColorMask>((const uint8 *)in.getPixels(), in.pitch, (uint8 *)in.getPixels(), in.pitch, in.w, in.h);
-		in.w /= 2;
-		in.h /= 2;
-	}
+	while (in.w / out.w >= 2 || in.h / out.h >= 2)
+		reduceThumbnail<ColorMask, 2>(in);
 
 	if ((in.w == out.w && in.h < out.h) || (in.w < out.w && in.h == out.h)) {
 		// In this case we simply center the input surface in the output
@@ -161,6 +194,63 @@ static void scaleThumbnail(Graphics::Surface &in, Graphics::Surface &out) {
 }
 
 
+struct ConvertJob {
+	const Graphics::Surface *in;
+	Graphics::PixelFormat inFormat;
+	const uint16 *palette;
+	Graphics::Surface *out;
+};
+
+static void convertRowsProc(uint32 begin, uint32 end, void *refCon) {
+	const ConvertJob *job = (const ConvertJob *)refCon;
+	const Graphics::PixelFormat &inFormat = job->inFormat;
+	const Graphics::PixelFormat &outFormat = job->out->format;
+	const int w = job->in->w;
+
+	for (uint32 y = begin; y < end; ++y) {
+		const uint8 *src = (const uint8 *)job->in->getBasePtr(0, y);
+		uint16 *dst = (uint16 *)job->out->getBasePtr(0, y);
+		byte r, g, b;
+
+		if (inFormat.bytesPerPixel == 1) {
+			for (int x = 0; x < w; ++x)
+				dst[x] = job->palette[src[x]];
+		} else if (inFormat == outFormat) {
+			memcpy(dst, src, w * 2);
+		} else if (inFormat.bytesPerPixel == 2) {
+			for (int x = 0; x < w; ++x) {
+				inFormat.colorToRGB(READ_UINT16(src + x * 2), r, g, b);
+				dst[x] = outFormat.RGBToColor(r, g, b);
+			}
+		} else {
+			for (int x = 0; x < w; ++x) {
+				inFormat.colorToRGB(READ_UINT32(src + x * 4), r, g, b);
+				dst[x] = outFormat.RGBToColor(r, g, b);
+			}
+		}
+	}
+}
+
+/**
+ * Converts a surface to RGB565, on the job system for large surfaces.
+ *
+ * @param out       the surface to store the data in, of the size of @p in
+ * @param in        the surface to convert
+ * @param inFormat  the format of @p in, which may be CLUT8
+ * @param palette   the palette of a CLUT8 surface
+ */
+static void convertTo565(Graphics::Surface &out, const Graphics::Surface &in, const Graphics::PixelFormat &inFormat, const byte *palette) {
+	// A CLUT8 surface only has 256 colors to convert
+	uint16 palette565[256];
+	if (inFormat.bytesPerPixel == 1) {
+		for (int i = 0; i < 256; ++i)
+			palette565[i] = out.format.RGBToColor(palette[i * 3 + 0], palette[i * 3 + 1], palette[i * 3 + 2]);
+	}
+
+	ConvertJob job = { &in, inFormat, palette565, &out };
+	g_system->getJobSystem()->parallelFor(in.h, convertRowsProc, &job, kParallelMinRows);
+}
+
 /**
  * Copies the current screen contents to a new surface, using RGB565 format.
  * WARNING: surf->free() must be called by the user to avoid leaking.
@@ -180,35 +270,11 @@ static bool grabScreen565(Graphics::Surface *surf) {
 
 	surf->create(screen->w, screen->h, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
 
-	byte *palette = 0;
-	if (screenFormat.bytesPerPixel == 1) {
-		palette = new byte[256 * 3];
-		assert(palette);
+	byte palette[256 * 3];
+	if (screenFormat.bytesPerPixel == 1)
 		g_system->getPaletteManager()->grabPalette(palette, 0, 256);
-	}
 
-	for (int y = 0; y < screen->h; ++y) {
-		for (int x = 0; x < screen->w; ++x) {
-			byte r = 0, g = 0, b = 0;
-
-			if (screenFormat.bytesPerPixel == 1) {
-				uint8 pixel = *(uint8 *)screen->getBasePtr(x, y);
-				r = palette[pixel * 3 + 0];
-				g = palette[pixel * 3 + 1];
-				b = palette[pixel * 3 + 2];
-			} else if (screenFormat.bytesPerPixel == 2) {
-				uint16 col = READ_UINT16(screen->getBasePtr(x, y));
-				screenFormat.colorToRGB(col, r, g, b);
-			} else if (screenFormat.bytesPerPixel == 4) {
-				uint32 col = READ_UINT32(screen->getBasePtr(x, y));
-				screenFormat.colorToRGB(col, r, g, b);
-			}
-
-			*((uint16 *)surf->getBasePtr(x, y)) = surf->format.RGBToColor(r, g, b);
-		}
-	}
-
-	delete[] palette;
+	convertTo565(*surf, *screen, screenFormat, palette);
 
 	g_system->unlockScreen();
 	return true;
@@ -246,16 +312,9 @@ bool createThumbnail(Graphics::Surface *surf, const uint8 *pixels, int w, int h,
 	Graphics::Surface screen;
 	screen.create(w, h, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
 
-	for (int y = 0; y < screen.h; ++y) {
-		for (int x = 0; x < screen.w; ++x) {
-			byte r, g, b;
-			r = palette[pixels[y * w + x] * 3];
-			g = palette[pixels[y * w + x] * 3 + 1];
-			b = palette[pixels[y * w + x] * 3 + 2];
-
-			*((uint16 *)screen.getBasePtr(x, y)) = screen.format.RGBToColor(r, g, b);
-		}
-	}
+	Graphics::Surface in;
+	in.init(w, h, w, const_cast<uint8 *>(pixels), Graphics::PixelFormat::createFormatCLUT8());
+	convertTo565(screen, in, in.format, palette);
 
 	return createThumbnail(*surf, screen);
 }
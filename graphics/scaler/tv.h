@@ -25,15 +25,20 @@
 
 class TVScaler : public Scaler {
 public:
-	TVScaler(const Graphics::PixelFormat &format) : Scaler(format) { _factor = 2; }
+	TVScaler(const Graphics::PixelFormat &format);
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
 private:
+	typedef void (TVScaler::*Kernel)(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+			uint32 dstPitch, int width, int height);
+
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
 	template<typename ColorMask>
 	void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 			uint32 dstPitch, int width, int height);
+
+	Kernel _kernel;
 };
 
 
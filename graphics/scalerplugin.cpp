@@ -20,6 +20,8 @@
 
 #include "graphics/scalerplugin.h"
 
+#include "common/system.h"
+
 namespace {
 /**
  * Trivial 'scaler' - in fact it doesn't do any scaling but just copies the
@@ -42,6 +44,25 @@ void Normal1x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPit
 }
 } // End of anonymous namespace
 
+bool isScalerKernelSupported(ScalerKernelVariant variant) {
+	// The CPU features can't be queried without a backend
+	if (!g_system)
+		return variant == kScalerKernelGeneric;
+
+	switch (variant) {
+	case kScalerKernelGeneric:
+		return true;
+	case kScalerKernelNEON:
+		return g_system->hasFeature(OSystem::kFeatureCpuNEON);
+	case kScalerKernelSSE2:
+		return g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+	case kScalerKernelAVX2:
+		return g_system->hasFeature(OSystem::kFeatureCpuAVX2);
+	default:
+		return false;
+	}
+}
+
 void Scaler::scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	                           uint32 dstPitch, int width, int height, int x, int y) {
 	if (_factor == 1) {
@@ -25,6 +25,57 @@
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
+/**
+ * CPU specific flavours of a scaler kernel, from the most portable one
+ * to the most specialised one.
+ */
+enum ScalerKernelVariant {
+	kScalerKernelGeneric,
+	kScalerKernelNEON,
+	kScalerKernelSSE2,
+	kScalerKernelAVX2,
+	kScalerKernelVariantCount
+};
+
+/**
+ * Check whether the host CPU can run kernels of the given variant.
+ */
+bool isScalerKernelSupported(ScalerKernelVariant variant);
+
+/**
+ * Dispatch table holding the implementations of a scaler kernel for the
+ * various instruction sets. Scalers fill one when they are created and keep
+ * the function returned by select(), so that SIMD versions of a kernel can
+ * be added without port specific code in the scaler itself.
+ */
+template<typename Func>
+class ScalerKernelTable {
+public:
+	explicit ScalerKernelTable(Func generic) {
+		for (int i = 0; i < kScalerKernelVariantCount; ++i)
+			_funcs[i] = nullptr;
+		_funcs[kScalerKernelGeneric] = generic;
+	}
+
+	/** Register the implementation of a variant. */
+	ScalerKernelTable &set(ScalerKernelVariant variant, Func func) {
+		_funcs[variant] = func;
+		return *this;
+	}
+
+	/** Return the most specialised implementation the CPU supports. */
+	Func select() const {
+		for (int i = kScalerKernelVariantCount - 1; i > kScalerKernelGeneric; --i) {
+			if (_funcs[i] && isScalerKernelSupported((ScalerKernelVariant)i))
+				return _funcs[i];
+		}
+		return _funcs[kScalerKernelGeneric];
+	}
+
+private:
+	Func _funcs[kScalerKernelVariantCount];
+};
+
 class Scaler {
 public:
 	Scaler(const Graphics::PixelFormat &format) : _format(format) {}
@@ -26,15 +26,18 @@
 
 namespace Graphics {
 
-Screen::Screen(): ManagedSurface() {
+Screen::Screen(): ManagedSurface(),
+		_mergeCost(SCREEN_DEFAULT_MERGE_COST), _lastUpdateRects(0), _lastUpdatePixels(0) {
 	create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 }
 
-Screen::Screen(int width, int height): ManagedSurface() {
+Screen::Screen(int width, int height): ManagedSurface(),
+		_mergeCost(SCREEN_DEFAULT_MERGE_COST), _lastUpdateRects(0), _lastUpdatePixels(0) {
 	create(width, height);
 }
 
-Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface() {
+Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface(),
+		_mergeCost(SCREEN_DEFAULT_MERGE_COST), _lastUpdateRects(0), _lastUpdatePixels(0) {
 	create(width, height, pixelFormat);
 }
 
@@ -42,14 +45,19 @@ void Screen::update() {
 	// Merge the dirty rects
 	mergeDirtyRects();
 
-	// Loop through copying dirty areas to the physical screen
+	// Copy all the dirty areas to the physical screen in a single batch
+	Common::Array<Common::Rect> rects;
+	rects.reserve(_dirtyRects.size());
+	_lastUpdatePixels = 0;
 	Common::List<Common::Rect>::iterator i;
 	for (i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
-		const Common::Rect &r = *i;
-		const byte *srcP = (const byte *)getBasePtr(r.left, r.top);
-		g_system->copyRectToScreen(srcP, pitch, r.left, r.top,
-			r.width(), r.height());
+		rects.push_back(*i);
+		_lastUpdatePixels += i->width() * i->height();
 	}
+	_lastUpdateRects = rects.size();
+
+	if (!rects.empty())
+		g_system->copyRectsToScreen(getBasePtr(0, 0), pitch, rects.data(), rects.size());
 
 	// Signal the physical screen to update
 	updateScreen();
@@ -77,24 +85,45 @@ void Screen::makeAllDirty() {
 
 void Screen::mergeDirtyRects() {
 	Common::List<Common::Rect>::iterator rOuter, rInner;
+	bool merged;
+
+	// A grown rect may now be worth merging with one it was already checked
+	// against, so keep going until a whole pass merges nothing
+	do {
+		merged = false;
 
-	// Process the dirty rect list to find any rects to merge
-	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
-		rInner = rOuter;
-		while (++rInner != _dirtyRects.end()) {
+		// Process the dirty rect list to find any rects to merge
+		for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
+			rInner = rOuter;
+			while (++rInner != _dirtyRects.end()) {
 
-			if ((*rOuter).intersects(*rInner)) {
-				// These two rectangles overlap, so merge them
-				unionRectangle(*rOuter, *rOuter, *rInner);
+				if (shouldMergeRects(*rOuter, *rInner)) {
+					// These two rectangles are cheaper as one, so merge them
+					unionRectangle(*rOuter, *rOuter, *rInner);
 
-				// remove the inner rect from the list
-				_dirtyRects.erase(rInner);
+					// remove the inner rect from the list
+					_dirtyRects.erase(rInner);
 
-				// move back to beginning of list
-				rInner = rOuter;
+					// move back to beginning of list
+					rInner = rOuter;
+					merged = true;
+				}
 			}
 		}
-	}
+	} while (merged);
+}
+
+bool Screen::shouldMergeRects(const Common::Rect &r1, const Common::Rect &r2) const {
+	if (r1.intersects(r2))
+		return true;
+
+	// The rects are disjoint, so the union wastes whatever it covers beyond them
+	Common::Rect u = r1;
+	u.extend(r2);
+	uint32 unionArea = (uint32)u.width() * u.height();
+	uint32 areas = (uint32)r1.width() * r1.height() + (uint32)r2.width() * r2.height();
+
+	return unionArea - areas <= _mergeCost;
 }
 
 bool Screen::unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2) {
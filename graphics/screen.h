@@ -41,6 +41,11 @@ namespace Graphics {
 #define PALETTE_COUNT 256
 #define PALETTE_SIZE (256 * 3)
 
+/**
+ * Default overhead of a copyRectToScreen call, in pixels
+ */
+#define SCREEN_DEFAULT_MERGE_COST 1024
+
 /**
  * Implements a specialised surface that represents the screen.
  * It keeps track of any areas of itself that are updated by drawing
@@ -53,12 +58,29 @@ protected:
 	 * List of affected areas of the screen
 	 */
 	Common::List<Common::Rect> _dirtyRects;
+
+	/**
+	 * Overhead of a single copyRectToScreen call, expressed in pixels
+	 */
+	uint _mergeCost;
+
+	/**
+	 * Number of rects and pixels copied to the screen by the last update
+	 */
+	uint _lastUpdateRects, _lastUpdatePixels;
 protected:
 	/**
-	 * Merges together overlapping dirty areas of the screen
+	 * Merges together dirty areas of the screen. Overlapping areas are always
+	 * merged, other ones when their bounding box wastes no more pixels than
+	 * the merge cost
 	 */
 	void mergeDirtyRects();
 
+	/**
+	 * Returns true if two dirty areas are cheaper to copy as one rectangle
+	 */
+	bool shouldMergeRects(const Common::Rect &r1, const Common::Rect &r2) const;
+
 	/**
 	 * Returns the union of two dirty area rectangles
 	 */
@@ -73,6 +95,28 @@ public:
 	 */
 	bool isDirty() const { return !_dirtyRects.empty(); }
 
+	/**
+	 * Sets how many pixels a separate copy to the screen is considered to
+	 * cost. Higher values produce fewer, larger updates; 0 only merges
+	 * areas that overlap or touch
+	 */
+	void setMergeCost(uint pixels) { _mergeCost = pixels; }
+
+	/**
+	 * Returns the current merge cost, in pixels
+	 */
+	uint getMergeCost() const { return _mergeCost; }
+
+	/**
+	 * Returns the number of rectangles copied to the screen by the last update
+	 */
+	uint getLastUpdateRectCount() const { return _lastUpdateRects; }
+
+	/**
+	 * Returns the number of pixels copied to the screen by the last update
+	 */
+	uint getLastUpdatePixelCount() const { return _lastUpdatePixels; }
+
 	/**
 	 * Marks the whole screen as dirty. This forces the next call to update
 	 * to copy the entire screen contents
@@ -21,6 +21,8 @@
 #include "graphics/svg.h"
 
 #include "common/endian.h"
+#include "common/file.h"
+#include "common/list.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
 #include "graphics/pixelformat.h"
@@ -37,6 +39,27 @@
 
 namespace Graphics {
 
+#define SVG_CACHE_TAG      MKTAG('S', 'V', 'G', 'C')
+#define SVG_CACHE_VERSION  1
+
+struct SVGCacheEntry {
+	Common::String name;
+	ManagedSurface *surface;
+};
+
+typedef Common::List<SVGCacheEntry> SVGCache;
+
+/** Maximum memory used by the cached images, in bytes */
+static const uint kSVGCacheMaxSize = 16 * 1024 * 1024;
+
+/** Cached images, the most recently used first */
+static SVGCache *g_svgCache = nullptr;
+static uint g_svgCacheSize = 0;
+
+static uint getSurfaceSize(const ManagedSurface &surf) {
+	return surf.pitch * surf.h;
+}
+
 SVGBitmap::SVGBitmap(Common::SeekableReadStream *in, int dw, int dh)
 	: ManagedSurface(dw, dh, PIXELFORMAT) {
 	if (dw == 0 || dh == 0)
@@ -68,4 +91,116 @@ SVGBitmap::SVGBitmap(Common::SeekableReadStream *in, int dw, int dh)
 	nsvgDelete(svg);
 }
 
+ManagedSurface *SVGBitmap::createFromCache(const Common::String &name, int dw, int dh) {
+	if (!g_svgCache)
+		return nullptr;
+
+	for (SVGCache::iterator i = g_svgCache->begin(); i != g_svgCache->end(); ++i) {
+		if (i->surface->w != dw || i->surface->h != dh || i->name != name)
+			continue;
+
+		// Move the entry to the front, to evict it last
+		if (i != g_svgCache->begin()) {
+			SVGCacheEntry entry = *i;
+			g_svgCache->erase(i);
+			g_svgCache->push_front(entry);
+		}
+
+		ManagedSurface *surf = new ManagedSurface();
+		surf->copyFrom(*g_svgCache->front().surface);
+		return surf;
+	}
+
+	return nullptr;
+}
+
+void SVGBitmap::addToCache(const Common::String &name, const ManagedSurface &surf) {
+	const uint size = getSurfaceSize(surf);
+	if (size == 0 || size > kSVGCacheMaxSize / 4)
+		return;
+
+	if (!g_svgCache)
+		g_svgCache = new SVGCache();
+
+	// Replace an older image with the same name and size
+	for (SVGCache::iterator i = g_svgCache->begin(); i != g_svgCache->end(); ++i) {
+		if (i->surface->w == surf.w && i->surface->h == surf.h && i->name == name) {
+			g_svgCacheSize -= getSurfaceSize(*i->surface);
+			delete i->surface;
+			g_svgCache->erase(i);
+			break;
+		}
+	}
+
+	while (!g_svgCache->empty() && g_svgCacheSize + size > kSVGCacheMaxSize) {
+		g_svgCacheSize -= getSurfaceSize(*g_svgCache->back().surface);
+		delete g_svgCache->back().surface;
+		g_svgCache->pop_back();
+	}
+
+	SVGCacheEntry entry;
+	entry.name = name;
+	entry.surface = new ManagedSurface();
+	entry.surface->copyFrom(surf);
+	g_svgCache->push_front(entry);
+	g_svgCacheSize += size;
+}
+
+void SVGBitmap::clearCache() {
+	if (!g_svgCache)
+		return;
+
+	for (SVGCache::iterator i = g_svgCache->begin(); i != g_svgCache->end(); ++i)
+		delete i->surface;
+
+	delete g_svgCache;
+	g_svgCache = nullptr;
+	g_svgCacheSize = 0;
+}
+
+ManagedSurface *SVGBitmap::loadCacheFile(Common::SeekableReadStream &stream, int dw, int dh) {
+	if (stream.readUint32BE() != SVG_CACHE_TAG)
+		return nullptr;
+	if (stream.readUint32BE() != SVG_CACHE_VERSION)
+		return nullptr;
+
+	const int w = stream.readUint16BE();
+	const int h = stream.readUint16BE();
+	if (stream.err() || w != dw || h != dh)
+		return nullptr;
+
+	// The pixel format keeps the bytes of each pixel in RGBA order on all
+	// platforms, so the rows can be stored as they are
+	ManagedSurface *surf = new ManagedSurface(w, h, PIXELFORMAT);
+	for (int y = 0; y < h; ++y) {
+		if (stream.read(surf->getBasePtr(0, y), w * 4) != (uint32)(w * 4)) {
+			delete surf;
+			return nullptr;
+		}
+	}
+
+	return surf;
+}
+
+bool SVGBitmap::saveCacheFile(const ManagedSurface &surf, const Common::Path &filename) {
+	if (surf.format != PIXELFORMAT)
+		return false;
+
+	Common::DumpFile cacheFile;
+	if (!cacheFile.open(filename)) {
+		warning("SVGBitmap::saveCacheFile: Couldn't open file '%s' for writing", filename.toString(Common::Path::kNativeSeparator).c_str());
+		return false;
+	}
+
+	cacheFile.writeUint32BE(SVG_CACHE_TAG);
+	cacheFile.writeUint32BE(SVG_CACHE_VERSION);
+	cacheFile.writeUint16BE(surf.w);
+	cacheFile.writeUint16BE(surf.h);
+
+	for (int y = 0; y < surf.h; ++y)
+		cacheFile.write(surf.getBasePtr(0, y), surf.w * 4);
+
+	return !cacheFile.err();
+}
+
 } // end of namespace Graphics
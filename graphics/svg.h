@@ -24,7 +24,9 @@
 #include "graphics/managed_surface.h"
 
 namespace Common {
+class Path;
 class SeekableReadStream;
+class String;
 }
 
 namespace Graphics {
@@ -35,6 +37,36 @@ namespace Graphics {
 class SVGBitmap : public ManagedSurface {
 public:
 	SVGBitmap(Common::SeekableReadStream *in, int dw, int dh);
+
+	/**
+	 * Returns a copy of an image stored with addToCache() under the same
+	 * name and size, or nullptr if there is none. The caller owns the
+	 * returned surface.
+	 */
+	static ManagedSurface *createFromCache(const Common::String &name, int dw, int dh);
+
+	/**
+	 * Keeps a copy of a rasterized image in memory, so that loading it again
+	 * at the same size doesn't need to rasterize it. The least recently used
+	 * images are dropped when the cache grows over its size limit.
+	 */
+	static void addToCache(const Common::String &name, const ManagedSurface &surf);
+
+	/**
+	 * Frees all the images kept by addToCache().
+	 */
+	static void clearCache();
+
+	/**
+	 * Loads an image written by saveCacheFile(). Returns nullptr if the file
+	 * is not valid or doesn't have the requested size.
+	 */
+	static ManagedSurface *loadCacheFile(Common::SeekableReadStream &stream, int dw, int dh);
+
+	/**
+	 * Writes a rasterized image to a file, to be loaded by loadCacheFile().
+	 */
+	static bool saveCacheFile(const ManagedSurface &surf, const Common::Path &filename);
 };
 
 } // end of namespace Graphics
@@ -377,6 +377,29 @@ void GLContext::gl_draw_triangle_select(GLContext *c, GLVertex *p0, GLVertex *p1
 
 int count_triangles, count_triangles_textured, count_pixels;
 
+// Pick the mipmap level closest to the triangle's footprint. The ratio of
+// texels covered to pixels drawn is the square of the minification factor,
+// so every level down divides it by four. The level is chosen once per
+// triangle as the rasterizer has no per-pixel derivatives.
+static const TexelBuffer *selectMipmap(const GLTexture *t, const GLVertex *p0, const GLVertex *p1, const GLVertex *p2) {
+	const TexelBuffer *pixmap = t->images[0].pixmap;
+	if (!t->images[1].pixmap)
+		return pixmap;
+
+	float screenArea = (float)((p1->zp.x - p0->zp.x) * (p2->zp.y - p0->zp.y) -
+				(p2->zp.x - p0->zp.x) * (p1->zp.y - p0->zp.y));
+	float texelArea = ((p1->tex_coord.X - p0->tex_coord.X) * (p2->tex_coord.Y - p0->tex_coord.Y) -
+				(p2->tex_coord.X - p0->tex_coord.X) * (p1->tex_coord.Y - p0->tex_coord.Y)) *
+				pixmap->getWidth() * pixmap->getHeight();
+	float ratio = ABS(texelArea) / MAX(ABS(screenArea), 1.0f);
+	int level = 0;
+	while (ratio >= 2.0f && level + 1 < MAX_TEXTURE_LEVELS && t->images[level + 1].pixmap) {
+		ratio *= 0.25f;
+		level++;
+	}
+	return t->images[level].pixmap;
+}
+
 void GLContext::gl_draw_triangle_fill(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p2) {
 	if (c->_profilingEnabled) {
 		int norm;
@@ -399,7 +422,7 @@ void GLContext::gl_draw_triangle_fill(GLContext *c, GLVertex *p0, GLVertex *p1,
 		if (c->_profilingEnabled) {
 			count_triangles_textured++;
 		}
-		c->fb->setTexture(c->current_texture->images[0].pixmap, c->texture_wrap_s, c->texture_wrap_t);
+		c->fb->setTexture(selectMipmap(c->current_texture, p0, p1, p2), c->texture_wrap_s, c->texture_wrap_t);
 		if (c->current_shade_model == TGL_SMOOTH) {
 			c->fb->fillTriangleTextureMappingPerspectiveSmooth(&p0->zp, &p1->zp, &p2->zp);
 		} else {
@@ -328,6 +328,7 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 	tglLoadIdentity();
 
 	matrix_model_projection_updated = 1;
+	vertex_transform_version = 0;
 
 	// opengl 1.1 arrays
 	client_states = 0;
@@ -360,6 +361,7 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 void GLContext::deinit() {
 	disposeDrawCallLists();
 	disposeResources();
+	disposeRasterizationTiles();
 
 	specbuf_cleanup();
 	for (int i = 0; i < 3; i++)
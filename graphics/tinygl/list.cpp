@@ -68,6 +68,10 @@ void GLContext::delete_list(int list) {
 		pb = pb1;
 	}
 
+	for (int i = 0; i < l->vertex_cache_count; i++)
+		gl_free(l->vertex_caches[i].vertices);
+	gl_free(l->vertex_caches);
+
 	gl_free(l);
 	shared_state.lists[list] = nullptr;
 }
@@ -164,9 +168,96 @@ void GLContext::glopNextBuffer(GLParam *) {
 	assert(0);
 }
 
+// Run the body of the index-th glBegin/glEnd block of a list, p pointing
+// just past its OP_Begin, and return where execution should resume. Without
+// lighting and fog a vertex only depends on the model-projection, texture
+// and viewport transforms and on the current attributes, so when those
+// match the previous call the cached vertices are used instead. Matrices
+// reloaded with the same values every frame do not count as a change. Blocks
+// holding anything but vertex and attribute ops are never cached.
+GLParam *GLContext::gl_call_list_block(GLList *l, int index, GLParam *p) {
+	if (lighting_enabled || fog_enabled || color_material_enabled)
+		return p;
+
+	if (index >= l->vertex_cache_count) {
+		l->vertex_caches = (GLVertexCache *)gl_realloc(l->vertex_caches, sizeof(GLVertexCache) * (index + 1));
+		for (int i = l->vertex_cache_count; i <= index; i++) {
+			l->vertex_caches[i].vertices = nullptr;
+			l->vertex_caches[i].vertex_count = 0;
+			l->vertex_caches[i].uncacheable = false;
+		}
+		l->vertex_cache_count = index + 1;
+	}
+	GLVertexCache *vc = &l->vertex_caches[index];
+	if (vc->uncacheable)
+		return p;
+
+	if (vc->vertices &&
+	    vc->transform_version == vertex_transform_version &&
+	    vc->texture_2d_enabled == texture_2d_enabled &&
+	    vc->apply_texture_matrix == apply_texture_matrix &&
+	    (!apply_texture_matrix || memcmp(vc->texture._m, matrix_stack_ptr[2]->_m, sizeof(vc->texture._m)) == 0) &&
+	    vc->color == current_color &&
+	    vc->normal == current_normal &&
+	    vc->tex_coord == current_tex_coord &&
+	    vc->edge_flag == current_edge_flag) {
+		p = vc->end_op;
+		// Issue the draw call straight from the cache rather than copying the
+		// vertices into the context array first.
+		GLVertex *contextVertices = vertex;
+		vertex = vc->vertices;
+		vertex_n = vertex_cnt = vc->vertex_count;
+		glopEnd(p);
+		vertex = contextVertices;
+		current_color = vc->end_color;
+		current_normal = vc->end_normal;
+		current_tex_coord = vc->end_tex_coord;
+		current_edge_flag = vc->end_edge_flag;
+		return p + op_table_size[OP_End];
+	}
+
+	vc->transform_version = vertex_transform_version;
+	vc->apply_texture_matrix = apply_texture_matrix;
+	vc->texture = *matrix_stack_ptr[2];
+	vc->texture_2d_enabled = texture_2d_enabled;
+	vc->color = current_color;
+	vc->normal = current_normal;
+	vc->tex_coord = current_tex_coord;
+	vc->edge_flag = current_edge_flag;
+
+	while (1) {
+		int op = p[0].op;
+		if (op == OP_End)
+			break;
+		if (op == OP_NextBuffer) {
+			p = (GLParam *)p[1].p;
+			continue;
+		}
+		if (op != OP_Vertex && op != OP_Color && op != OP_Normal && op != OP_TexCoord && op != OP_EdgeFlag) {
+			gl_free(vc->vertices);
+			vc->vertices = nullptr;
+			vc->uncacheable = true;
+			return p;
+		}
+		op_table_func[op](this, p);
+		p += op_table_size[op];
+	}
+
+	vc->vertices = (GLVertex *)gl_realloc(vc->vertices, sizeof(GLVertex) * MAX(vertex_n, 1));
+	memcpy(vc->vertices, vertex, sizeof(GLVertex) * vertex_n);
+	vc->vertex_count = vertex_n;
+	vc->end_op = p;
+	vc->end_color = current_color;
+	vc->end_normal = current_normal;
+	vc->end_tex_coord = current_tex_coord;
+	vc->end_edge_flag = current_edge_flag;
+	return p;
+}
+
 void GLContext::glopCallList(GLParam *p) {
 	uint list = p[1].ui;
 	GLList *l = find_list(list);
+	int block = 0;
 
 	if (!l)
 		error("list %d not defined", list);
@@ -181,6 +272,8 @@ void GLContext::glopCallList(GLParam *p) {
 		} else {
 			op_table_func[op](this, p);
 			p += op_table_size[op];
+			if (op == OP_Begin)
+				p = gl_call_list_block(l, block++, p);
 		}
 	}
 }
@@ -37,6 +37,9 @@ public:
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const;
 
+	uint getWidth() const { return _width; }
+	uint getHeight() const { return _height; }
+
 protected:
 	virtual void getARGBAt(
 		uint pixel,
@@ -30,6 +30,7 @@
 #include "common/endian.h"
 
 #include "graphics/tinygl/zgl.h"
+#include "graphics/tinygl/pixelbuffer.h"
 
 namespace TinyGL {
 
@@ -105,6 +106,77 @@ void GLContext::glopBindTexture(GLParam *p) {
 	current_texture = t;
 }
 
+static TexelBuffer *createTexelBuffer(uint filter, byte *pixels, const Graphics::PixelFormat &pf, uint format, uint type, uint width, uint height, uint textureSize) {
+	switch (filter) {
+	case TGL_LINEAR_MIPMAP_NEAREST:
+	case TGL_LINEAR_MIPMAP_LINEAR:
+	case TGL_LINEAR:
+		return createBilinearTexelBuffer(
+			pixels, pf,
+			format, type,
+			width, height,
+			textureSize
+		);
+	default:
+		return createNearestTexelBuffer(
+			pixels, pf,
+			format, type,
+			width, height,
+			textureSize
+		);
+	}
+}
+
+static void freeMipmaps(GLTexture *t) {
+	for (int i = 1; i < MAX_TEXTURE_LEVELS; i++) {
+		GLImage *im = &t->images[i];
+		if (im->pixmap) {
+			delete im->pixmap;
+			im->pixmap = nullptr;
+		}
+	}
+}
+
+// Build levels 1 and up from level 0 by repeated 2x2 box filtering. The
+// reduction is done on 8-bit ARGB so that 16-bit formats do not lose
+// precision at every level, and each level is converted back to the
+// upload format so it goes through the same texel buffer as level 0.
+static void generateMipmaps(GLTexture *t, uint filter, byte *pixels, const Graphics::PixelFormat &pf, uint format, uint type, int width, int height, uint textureSize) {
+	const Graphics::PixelBuffer src(pf, pixels);
+	byte *argb = (byte *)gl_malloc(width * height * 4);
+	for (int i = 0; i < width * height; i++)
+		src.getARGBAt(i, argb[i * 4 + 0], argb[i * 4 + 1], argb[i * 4 + 2], argb[i * 4 + 3]);
+
+	byte *levelPixels = (byte *)gl_malloc(MAX(width >> 1, 1) * MAX(height >> 1, 1) * pf.bytesPerPixel);
+	Graphics::PixelBuffer dst(pf, levelPixels);
+	for (int level = 1; level < MAX_TEXTURE_LEVELS && (width > 1 || height > 1); level++) {
+		int levelWidth = MAX(width >> 1, 1);
+		int levelHeight = MAX(height >> 1, 1);
+		// Reduce in place: the output index never overtakes the inputs still to be read.
+		for (int y = 0; y < levelHeight; y++) {
+			const byte *row0 = argb + (y * 2) * width * 4;
+			const byte *row1 = argb + MIN(y * 2 + 1, height - 1) * width * 4;
+			for (int x = 0; x < levelWidth; x++) {
+				int x0 = x * 2 * 4;
+				int x1 = MIN(x * 2 + 1, width - 1) * 4;
+				byte *out = argb + (y * levelWidth + x) * 4;
+				for (int c = 0; c < 4; c++)
+					out[c] = (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2;
+				dst.setPixelAt(y * levelWidth + x, out[0], out[1], out[2], out[3]);
+			}
+		}
+		width = levelWidth;
+		height = levelHeight;
+
+		GLImage *im = &t->images[level];
+		im->xsize = textureSize;
+		im->ysize = textureSize;
+		im->pixmap = createTexelBuffer(filter, levelPixels, pf, format, type, width, height, textureSize);
+	}
+	gl_free(levelPixels);
+	gl_free(argb);
+}
+
 void GLContext::glopTexImage2D(GLParam *p) {
 	int target = p[1].i;
 	int level = p[2].i;
@@ -136,6 +208,8 @@ void GLContext::glopTexImage2D(GLParam *p) {
 		delete im->pixmap;
 		im->pixmap = nullptr;
 	}
+	if (level == 0)
+		freeMipmaps(current_texture);
 	if (pixels) {
 		uint filter;
 		Graphics::PixelFormat pf;
@@ -156,25 +230,18 @@ void GLContext::glopTexImage2D(GLParam *p) {
 			filter = texture_mag_filter;
 		else
 			filter = texture_min_filter;
-		switch (filter) {
-		case TGL_LINEAR_MIPMAP_NEAREST:
-		case TGL_LINEAR_MIPMAP_LINEAR:
-		case TGL_LINEAR:
-			im->pixmap = createBilinearTexelBuffer(
-				pixels, pf,
-				format, type,
-				width, height,
-				_textureSize
-			);
-			break;
-		default:
-			im->pixmap = createNearestTexelBuffer(
-				pixels, pf,
-				format, type,
-				width, height,
-				_textureSize
-			);
-			break;
+		im->pixmap = createTexelBuffer(filter, pixels, pf, format, type, width, height, _textureSize);
+		if (level == 0) {
+			switch (texture_min_filter) {
+			case TGL_NEAREST_MIPMAP_NEAREST:
+			case TGL_NEAREST_MIPMAP_LINEAR:
+			case TGL_LINEAR_MIPMAP_NEAREST:
+			case TGL_LINEAR_MIPMAP_LINEAR:
+				generateMipmaps(current_texture, texture_min_filter, pixels, pf, format, type, width, height, _textureSize);
+				break;
+			default:
+				break;
+			}
 		}
 	}
 }
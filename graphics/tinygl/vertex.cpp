@@ -104,7 +104,11 @@ void GLContext::glopBegin(GLParam *p) {
 			matrix_model_view_inv.transpose();
 		} else {
 			// precompute projection matrix
-			matrix_model_projection = (*matrix_stack_ptr[1]) * (*matrix_stack_ptr[0]);
+			Matrix4 model_projection = (*matrix_stack_ptr[1]) * (*matrix_stack_ptr[0]);
+			if (memcmp(model_projection._m, matrix_model_projection._m, sizeof(model_projection._m)) != 0) {
+				matrix_model_projection = model_projection;
+				vertex_transform_version++;
+			}
 			// test to accelerate computation
 			matrix_model_projection_no_w_transform = 0;
 			if (matrix_model_projection._m[3][0] == 0.0 && matrix_model_projection._m[3][1] == 0.0 && matrix_model_projection._m[3][2] == 0.0)
@@ -120,6 +124,7 @@ void GLContext::glopBegin(GLParam *p) {
 	if (viewport.updated) {
 		gl_eval_viewport();
 		viewport.updated = 0;
+		vertex_transform_version++;
 	}
 	// triangle drawing functions
 	if (render_mode == TGL_SELECT) {
@@ -30,6 +30,7 @@
 #include "common/scummsys.h"
 #include "common/endian.h"
 #include "common/memory.h"
+#include "common/system.h"
 
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zgl.h"
@@ -53,18 +54,78 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 	_offscreenBuffer.pbuf = _pbuf;
 	_offscreenBuffer.zbuf = _zbuf;
 
+	_ownsBuffers = true;
+
 	_currentTexture = nullptr;
 
 	_enableScissor = false;
+
+	_spanKernels = getSpanKernels();
+}
+
+FrameBuffer::FrameBuffer(const FrameBuffer &other) {
+	shareBuffers(other);
 }
 
 FrameBuffer::~FrameBuffer() {
+	if (!_ownsBuffers)
+		return;
+
 	gl_free(_pbuf);
 	gl_free(_zbuf);
 	if (_sbuf)
 		gl_free(_sbuf);
 }
 
+void FrameBuffer::shareBuffers(const FrameBuffer &other) {
+	*this = other;
+	_ownsBuffers = false;
+}
+
+const FrameBuffer::SpanKernels *FrameBuffer::spanKernels = nullptr;
+bool FrameBuffer::spanKernelsSelected = false;
+
+const FrameBuffer::SpanKernels *FrameBuffer::getSpanKernels() {
+	// If no kernels have been selected yet, detect and select
+	if (!spanKernelsSelected) {
+		// The CPU features can't be queried without a backend
+		if (!g_system)
+			return nullptr;
+
+		spanKernelsSelected = true;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) spanKernels = &spanKernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) spanKernels = &spanKernelsSSE2;
+#endif
+	}
+
+	return spanKernels;
+}
+
+const FrameBuffer::SpanKernels *FrameBuffer::setupSpanState(SpanState &state, bool depthWrite, bool alphaTest) const {
+	// The kernels write whole 16 or 32 bit pixels
+	if (!_spanKernels || (_pbufBpp != 2 && _pbufBpp != 4))
+		return nullptr;
+
+	state.depthFunc = _depthFunc;
+	state.depthWrite = depthWrite;
+	state.alphaTest = alphaTest;
+	state.alphaFunc = _alphaTestFunc;
+	state.alphaRefVal = _alphaTestRefVal;
+	state.bytesPerPixel = _pbufBpp;
+	state.aLoss = _pbufFormat.aLoss;
+	state.rLoss = _pbufFormat.rLoss;
+	state.gLoss = _pbufFormat.gLoss;
+	state.bLoss = _pbufFormat.bLoss;
+	state.aShift = _pbufFormat.aShift;
+	state.rShift = _pbufFormat.rShift;
+	state.gShift = _pbufFormat.gShift;
+	state.bShift = _pbufFormat.bShift;
+	return _spanKernels;
+}
+
 Buffer *FrameBuffer::genOffscreenBuffer() {
 	Buffer *buf = (Buffer *)gl_malloc(sizeof(Buffer));
 	buf->pbuf = (byte *)gl_zalloc(_pbufHeight * _pbufPitch);
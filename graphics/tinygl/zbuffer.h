@@ -104,8 +104,13 @@ struct ZBufferPoint {
 
 struct FrameBuffer {
 	FrameBuffer(int width, int height, const Graphics::PixelFormat &format, bool enableStencilBuffer);
+	// Create a frame buffer drawing into the buffers of another one.
+	explicit FrameBuffer(const FrameBuffer &other);
 	~FrameBuffer();
 
+	// Take over the buffers and the state of another frame buffer, without owning the buffers.
+	void shareBuffers(const FrameBuffer &other);
+
 	Graphics::PixelFormat getPixelFormat() {
 		return _pbufFormat;
 	}
@@ -146,6 +151,9 @@ struct FrameBuffer {
 
 private:
 
+	// Only used by shareBuffers(), as it does not care about buffer ownership.
+	FrameBuffer &operator=(const FrameBuffer &other) = default;
+
 	FORCEINLINE void setPixelAt(int pixel, uint32 value) {
 		switch (_pbufBpp) {
 		case 2:
@@ -660,6 +668,53 @@ public:
 		_fogColorB = colorB;
 	}
 
+	/** The state used by the span kernels, set up once per triangle */
+	struct SpanState {
+		int depthFunc;
+		bool depthWrite;
+		bool alphaTest;
+		int alphaFunc;
+		int alphaRefVal;
+		int bytesPerPixel;
+		byte aLoss, rLoss, gLoss, bLoss;
+		byte aShift, rShift, gShift, bShift;
+	};
+
+	/** The interpolated values at the first pixel of a span */
+	struct SpanValues {
+		uint z, r, g, b, a;
+		int dzdx, drdx, dgdx, dbdx, dadx;
+	};
+
+	typedef uint (*TestDepthFunc)(const uint *pz, uint z, int dzdx, int count, const SpanState &state);
+	typedef void (*FillDepthFunc)(uint *pz, uint z, int dzdx, int count, const SpanState &state);
+	typedef void (*FillColorFunc)(byte *pp, uint *pz, int count, const SpanValues &values, const SpanState &state);
+	typedef void (*WriteTexelsFunc)(byte *pp, uint *pz, int count, uint mask, const uint32 *texels, const SpanValues &values, const SpanState &state);
+
+	/**
+	 * SIMD versions of the inner loops of fillTriangle(), for spans without
+	 * stencil test, blending or fog. They give the same results as the
+	 * per pixel code.
+	 */
+	struct SpanKernels {
+		TestDepthFunc testDepth;     /**< Returns the depth test results of up to 8 pixels as a bit mask */
+		FillDepthFunc fillDepth;     /**< Depth tests and writes a span */
+		FillColorFunc fillColor;     /**< Draws a flat or smooth shaded span */
+		WriteTexelsFunc writeTexels; /**< Lights and writes up to 8 fetched texels, for the pixels in the mask */
+	};
+
+#ifdef SCUMMVM_NEON
+	static const SpanKernels spanKernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	static const SpanKernels spanKernelsSSE2;
+#endif
+
+	static const SpanKernels *spanKernels;
+	static bool spanKernelsSelected;
+
+	static const SpanKernels *getSpanKernels();
+
 private:
 
 	/**
@@ -706,6 +761,15 @@ private:
 	template <bool kInterpRGB, bool kInterpZ, bool kInterpST, bool kInterpSTZ, bool kSmoothMode>
 	void fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint *p2);
 
+	const SpanKernels *setupSpanState(SpanState &state, bool depthWrite, bool alphaTest) const;
+
+	FORCEINLINE bool isSpanInScissor(int x1, int x2) const {
+		return x1 >= _clipRectangle.left && x2 < _clipRectangle.right;
+	}
+
+	void putTexels(int fbOffset, uint *pz, int count, const TexelBuffer *texture, int s, int t, int dsdx, int dtdx,
+	               const SpanValues &values, const SpanKernels *kernels, const SpanState &state);
+
 public:
 
 	void fillTriangleTextureMappingPerspectiveSmooth(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint *p2);
@@ -750,6 +814,7 @@ private:
 
 	uint *_zbuf;
 	byte *_sbuf;
+	bool _ownsBuffers;
 
 	bool _enableStencil;
 	int _textureSize;
@@ -784,6 +849,8 @@ private:
 	float _fogColorR;
 	float _fogColorG;
 	float _fogColorB;
+
+	const SpanKernels *_spanKernels;
 };
 
 // memory.c
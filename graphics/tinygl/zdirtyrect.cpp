@@ -24,10 +24,17 @@
 #include "graphics/tinygl/gl.h"
 
 #include "common/debug.h"
+#include "common/jobsystem.h"
 #include "common/math.h"
+#include "common/system.h"
 
 namespace TinyGL {
 
+enum {
+	kRasterizationTilesPerThread = 2,
+	kMinRasterizationTileHeight = 16
+};
+
 void GLContext::issueDrawCall(DrawCall *drawCall) {
 	if (_enableDirtyRectangles && drawCall->getDirtyRegion().isEmpty())
 		return;
@@ -188,20 +195,14 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 	}
 
 	if (!rectangles.empty()) {
+		Common::List<Common::Rect> clipRectangles;
 		for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
 			dirtyAreas.push_back((*itRect).rectangle);
+			clipRectangles.push_back((*itRect).rectangle);
 		}
 
 		// Execute draw calls.
-		for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
-			Common::Rect drawCallRegion = (*it)->getDirtyRegion();
-			for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
-				Common::Rect dirtyRegion = (*itRect).rectangle;
-				if (dirtyRegion.intersects(drawCallRegion)) {
-					(*it)->execute(dirtyRegion, true);
-				}
-			}
-		}
+		executeDrawCalls(clipRectangles);
 
 		if (_debugRectsEnabled) {
 			// Draw debug rectangles.
@@ -240,8 +241,9 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 
 	dirtyAreas.push_back(Common::Rect(fb->getPixelBufferWidth(), fb->getPixelBufferHeight()));
 
+	executeDrawCalls(Common::List<Common::Rect>());
+
 	for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
-		(*it)->execute(true);
 		delete *it;
 	}
 
@@ -252,6 +254,173 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 	_drawCallAllocator[_currentAllocatorIndex].reset();
 }
 
+// Execute a draw call on the calling thread, clipped to the given rectangles
+// or not at all if there are none.
+static void executeDrawCall(const DrawCall &drawCall, const Common::List<Common::Rect> &clipRectangles) {
+	if (clipRectangles.empty()) {
+		drawCall.execute(true);
+		return;
+	}
+
+	Common::Rect drawCallRegion = drawCall.getDirtyRegion();
+	for (Common::List<Common::Rect>::const_iterator it = clipRectangles.begin(); it != clipRectangles.end(); ++it) {
+		if ((*it).intersects(drawCallRegion)) {
+			drawCall.execute(*it, true);
+		}
+	}
+}
+
+struct RasterizationBatch {
+	GLContext *context;
+	const Common::List<Common::Rect> *clipRectangles;
+	Common::Array<const DrawCall *> drawCalls;
+};
+
+static void rasterizeTiles(uint32 begin, uint32 end, void *refCon) {
+	const RasterizationBatch *batch = (const RasterizationBatch *)refCon;
+	const Common::List<Common::Rect> &clipRectangles = *batch->clipRectangles;
+
+	for (uint32 i = begin; i < end; i++) {
+		RasterizationTile &tile = *batch->context->_rasterizationTiles[i];
+
+		// The draw calls are replayed in their original order within each tile,
+		// so overlapping primitives still blend and depth test as before.
+		for (uint j = 0; j < batch->drawCalls.size(); j++) {
+			const DrawCall &drawCall = *batch->drawCalls[j];
+
+			if (clipRectangles.empty()) {
+				drawCall.executeTile(tile, tile.rect);
+				continue;
+			}
+
+			Common::Rect drawCallRegion = drawCall.getDirtyRegion();
+			for (Common::List<Common::Rect>::const_iterator it = clipRectangles.begin(); it != clipRectangles.end(); ++it) {
+				if (!(*it).intersects(drawCallRegion)) {
+					continue;
+				}
+
+				Common::Rect clippingRectangle = (*it).findIntersectingRect(tile.rect);
+				if (!clippingRectangle.isEmpty()) {
+					drawCall.executeTile(tile, clippingRectangle);
+				}
+			}
+		}
+	}
+}
+
+static void rasterizeBatch(RasterizationBatch &batch) {
+	if (batch.drawCalls.empty()) {
+		return;
+	}
+
+	Common::Array<RasterizationTile *> &tiles = batch.context->_rasterizationTiles;
+	for (uint i = 0; i < tiles.size(); i++) {
+		tiles[i]->sync(batch.context);
+	}
+
+	g_system->getJobSystem()->parallelFor(tiles.size(), rasterizeTiles, &batch);
+	batch.drawCalls.clear();
+}
+
+void GLContext::executeDrawCalls(const Common::List<Common::Rect> &clipRectangles) {
+	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+
+	if (!setupRasterizationTiles()) {
+		for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
+			executeDrawCall(**it, clipRectangles);
+		}
+		return;
+	}
+
+	// Blits go through the global context, so they are executed on this
+	// thread in between batches of the other draw calls.
+	RasterizationBatch batch;
+	batch.context = this;
+	batch.clipRectangles = &clipRectangles;
+
+	for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
+		if ((*it)->getType() == DrawCall::DrawCall_Blitting) {
+			rasterizeBatch(batch);
+			executeDrawCall(**it, clipRectangles);
+		} else {
+			batch.drawCalls.push_back(*it);
+		}
+	}
+
+	rasterizeBatch(batch);
+}
+
+bool GLContext::setupRasterizationTiles() {
+	const uint workerCount = g_system->getJobSystem()->getWorkerCount();
+	const int width = fb->getPixelBufferWidth();
+	const int height = fb->getPixelBufferHeight();
+
+	// Selection records hits in a shared buffer, in the order of the primitives.
+	uint tileCount = 0;
+	if (workerCount > 0 && render_mode == TGL_RENDER) {
+		tileCount = MIN<uint>((workerCount + 1) * kRasterizationTilesPerThread, height / kMinRasterizationTileHeight);
+	}
+
+	if (tileCount < 2) {
+		disposeRasterizationTiles();
+		return false;
+	}
+
+	if (_rasterizationTiles.size() == tileCount && _rasterizationTiles.back()->rect.right == width) {
+		return true;
+	}
+
+	disposeRasterizationTiles();
+	for (uint i = 0; i < tileCount; i++) {
+		_rasterizationTiles.push_back(new RasterizationTile(Common::Rect(0, height * i / tileCount, width, height * (i + 1) / tileCount)));
+	}
+	return true;
+}
+
+void GLContext::disposeRasterizationTiles() {
+	for (uint i = 0; i < _rasterizationTiles.size(); i++) {
+		delete _rasterizationTiles[i];
+	}
+	_rasterizationTiles.clear();
+}
+
+RasterizationTile::RasterizationTile(const Common::Rect &r)
+	: context(new GLContext()), fb(nullptr), rect(r), vertices(nullptr), vertexCapacity(0) {
+}
+
+RasterizationTile::~RasterizationTile() {
+	delete context;
+	delete fb;
+	gl_free(vertices);
+}
+
+void RasterizationTile::sync(const GLContext *c) {
+	if (fb) {
+		fb->shareBuffers(*c->fb);
+	} else {
+		fb = new FrameBuffer(*c->fb);
+	}
+
+	// Everything else used by the rasterizer is part of the draw call state.
+	context->fb = fb;
+	context->renderRect = c->renderRect;
+	context->current_cull_face = c->current_cull_face;
+	context->render_mode = c->render_mode;
+	context->vertex_n = c->vertex_n;
+	context->_textureSize = c->_textureSize;
+	context->_profilingEnabled = c->_profilingEnabled;
+}
+
+GLVertex *RasterizationTile::copyVertices(const GLVertex *src, int count) {
+	if (count > vertexCapacity) {
+		gl_free(vertices);
+		vertices = (GLVertex *)gl_malloc(count * sizeof(GLVertex));
+		vertexCapacity = count;
+	}
+	memcpy(vertices, src, count * sizeof(GLVertex));
+	return vertices;
+}
+
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas) {
 	GLContext *c = gl_get_context();
 	if (c->_enableDirtyRectangles) {
@@ -294,7 +463,7 @@ RasterizationDrawCall::RasterizationDrawCall() : DrawCall(DrawCall_Rasterization
 	_drawTriangleFront = c->draw_triangle_front;
 	_drawTriangleBack = c->draw_triangle_back;
 	memcpy(_vertex, c->vertex, sizeof(GLVertex) * _vertexCount);
-	_state = captureState();
+	_state = captureState(c);
 	if (c->_enableDirtyRectangles) {
 		computeDirtyRegion();
 	}
@@ -334,18 +503,20 @@ void RasterizationDrawCall::computeDirtyRegion() {
 }
 
 void RasterizationDrawCall::execute(bool restoreState) const {
-	GLContext *c = gl_get_context();
+	rasterize(gl_get_context(), _vertex, restoreState);
+}
 
+void RasterizationDrawCall::rasterize(GLContext *c, GLVertex *vertex, bool restoreState) const {
 	RasterizationDrawCall::RasterizationState backupState;
 	if (restoreState) {
-		backupState = captureState();
+		backupState = captureState(c);
 	}
-	applyState(_state);
+	applyState(c, _state);
 
 	GLVertex *prevVertex = c->vertex;
 	int prevVertexCount = c->vertex_cnt;
 
-	c->vertex = _vertex;
+	c->vertex = vertex;
 	c->vertex_cnt = _vertexCount;
 	c->draw_triangle_front = (gl_draw_triangle_func)_drawTriangleFront;
 	c->draw_triangle_back = (gl_draw_triangle_func)_drawTriangleBack;
@@ -429,13 +600,12 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 	c->vertex_cnt = prevVertexCount;
 
 	if (restoreState) {
-		applyState(backupState);
+		applyState(c, backupState);
 	}
 }
 
-RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState() const {
+RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState(GLContext *c) const {
 	RasterizationState state;
-	GLContext *c = gl_get_context();
 	state.enableBlending = c->blending_enabled;
 	state.sfactor = c->source_blending_factor;
 	state.dfactor = c->destination_blending_factor;
@@ -484,8 +654,7 @@ RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState()
 	return state;
 }
 
-void RasterizationDrawCall::applyState(const RasterizationDrawCall::RasterizationState &state) const {
-	GLContext *c = gl_get_context();
+void RasterizationDrawCall::applyState(GLContext *c, const RasterizationDrawCall::RasterizationState &state) const {
 	c->fb->enableBlending(state.enableBlending);
 	c->fb->setBlendingFactors(state.sfactor, state.dfactor);
 	c->fb->enableAlphaTest(state.alphaTestEnabled);
@@ -553,6 +722,15 @@ void RasterizationDrawCall::execute(const Common::Rect &clippingRectangle, bool
 	c->fb->resetScissorRectangle();
 }
 
+void RasterizationDrawCall::executeTile(RasterizationTile &tile, const Common::Rect &clippingRectangle) const {
+	// The rasterizer modifies the vertices, every tile needs its own copy.
+	GLVertex *vertex = tile.copyVertices(_vertex, _vertexCount);
+
+	tile.fb->setScissorRectangle(clippingRectangle);
+	rasterize(tile.context, vertex, false);
+	tile.fb->resetScissorRectangle();
+}
+
 bool RasterizationDrawCall::operator==(const RasterizationDrawCall &other) const {
 	if (_vertexCount == other._vertexCount &&
 		_drawTriangleFront == other._drawTriangleFront &&
@@ -708,6 +886,14 @@ void ClearBufferDrawCall::execute(const Common::Rect &clippingRectangle, bool re
 	                   _clearStencilBuffer, _stencilValue);
 }
 
+void ClearBufferDrawCall::executeTile(RasterizationTile &tile, const Common::Rect &clippingRectangle) const {
+	// The dirty region is only known with dirty rectangles, clears always cover the whole frame.
+	Common::Rect clearRect = clippingRectangle.findIntersectingRect(tile.context->renderRect);
+	tile.fb->clearRegion(clearRect.left, clearRect.top, clearRect.width(), clearRect.height(),
+	                     _clearZBuffer, _zValue, _clearColorBuffer, _rValue, _gValue, _bValue,
+	                     _clearStencilBuffer, _stencilValue);
+}
+
 bool ClearBufferDrawCall::operator==(const ClearBufferDrawCall &other) const {
 	return
 		_clearZBuffer == other._clearZBuffer &&
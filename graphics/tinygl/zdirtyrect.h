@@ -37,6 +37,28 @@ void *allocateFrame(int size);
 struct GLContext;
 struct GLVertex;
 struct GLTexture;
+struct FrameBuffer;
+
+// A horizontal band of the frame buffer, rasterized on its own thread.
+// The context and frame buffer are private to the band, but draw into the
+// same pixel, depth and stencil buffers as the main context.
+struct RasterizationTile {
+	RasterizationTile(const Common::Rect &r);
+	~RasterizationTile();
+
+	// Take over the frame buffer and the state not captured by draw calls.
+	void sync(const GLContext *c);
+
+	// Private copy of the vertices of a draw call, as the rasterizer writes to them.
+	GLVertex *copyVertices(const GLVertex *src, int count);
+
+	GLContext *context;
+	FrameBuffer *fb;
+	Common::Rect rect;
+
+	GLVertex *vertices;
+	int vertexCapacity;
+};
 
 class DrawCall {
 public:
@@ -55,6 +77,8 @@ public:
 	}
 	virtual void execute(bool restoreState) const = 0;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const = 0;
+	// Execute the draw call on a worker thread, only supported by clear and rasterization calls.
+	virtual void executeTile(RasterizationTile &tile, const Common::Rect &clippingRectangle) const { }
 	DrawCallType getType() const { return _type; }
 	virtual const Common::Rect getDirtyRegion() const { return _dirtyRegion; }
 protected:
@@ -70,6 +94,7 @@ public:
 	bool operator==(const ClearBufferDrawCall &other) const;
 	virtual void execute(bool restoreState) const;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const;
+	virtual void executeTile(RasterizationTile &tile, const Common::Rect &clippingRectangle) const;
 
 	void *operator new(size_t size) {
 		return Internal::allocateFrame(size);
@@ -89,6 +114,7 @@ public:
 	bool operator==(const RasterizationDrawCall &other) const;
 	virtual void execute(bool restoreState) const;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const;
+	virtual void executeTile(RasterizationTile &tile, const Common::Rect &clippingRectangle) const;
 
 	void *operator new(size_t size) {
 		return Internal::allocateFrame(size);
@@ -97,6 +123,7 @@ public:
 	void operator delete(void *p) { }
 private:
 	void computeDirtyRegion();
+	void rasterize(GLContext *c, GLVertex *vertex, bool restoreState) const;
 	typedef void (*gl_draw_triangle_func_ptr)(GLContext *c, TinyGL::GLVertex *p0, TinyGL::GLVertex *p1, TinyGL::GLVertex *p2);
 	int _vertexCount;
 	GLVertex *_vertex;
@@ -150,8 +177,8 @@ private:
 
 	RasterizationState _state;
 
-	RasterizationState captureState() const;
-	void applyState(const RasterizationState &state) const;
+	RasterizationState captureState(GLContext *c) const;
+	void applyState(GLContext *c, const RasterizationState &state) const;
 };
 
 // Encapsulate a blit call: it might execute either a color buffer or z buffer blit.
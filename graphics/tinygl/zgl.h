@@ -159,6 +159,9 @@ struct GLParamBuffer {
 
 struct GLList {
 	GLParamBuffer *first_op_buffer;
+	// one entry per glBegin/glEnd block, in list order
+	struct GLVertexCache *vertex_caches;
+	int vertex_cache_count;
 	// TODO: extensions for a hash table or a better allocating scheme
 };
 
@@ -194,6 +197,27 @@ struct GLVertex {
 	}
 };
 
+// Post-transform vertices of a display list glBegin/glEnd block, with the
+// state they were computed from and the current vertex attributes the block
+// leaves behind. Calling the list again under the same state copies these
+// instead of transforming every vertex again.
+struct GLVertexCache {
+	uint transform_version;
+	int apply_texture_matrix;
+	Matrix4 texture;
+	int texture_2d_enabled;
+	Vector4 color, normal, tex_coord;
+	int edge_flag;
+
+	Vector4 end_color, end_normal, end_tex_coord;
+	int end_edge_flag;
+
+	GLVertex *vertices;
+	int vertex_count;
+	GLParam *end_op;
+	bool uncacheable;
+};
+
 struct GLImage {
 	TexelBuffer *pixmap;
 	int xsize, ysize;
@@ -341,6 +365,8 @@ struct GLContext {
 	int matrix_model_projection_updated;
 	int matrix_model_projection_no_w_transform;
 	int apply_texture_matrix;
+	// bumped when the model-projection matrix or the viewport actually change
+	uint vertex_transform_version;
 
 	// viewport
 	GLViewport viewport;
@@ -463,6 +489,9 @@ struct GLContext {
 	bool _debugRectsEnabled;
 	bool _profilingEnabled;
 
+	// Bands of the frame buffer rasterized in parallel
+	Common::Array<RasterizationTile *> _rasterizationTiles;
+
 	void gl_vertex_transform(GLVertex *v);
 	void gl_calc_fog_factor(GLVertex *v);
 
@@ -520,6 +549,10 @@ public:
 	void presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas);
 	void presentBufferSimple(Common::List<Common::Rect> &dirtyAreas);
 
+	void executeDrawCalls(const Common::List<Common::Rect> &clipRectangles);
+	bool setupRasterizationTiles();
+	void disposeRasterizationTiles();
+
 	void debugDrawRectangle(Common::Rect rect, int r, int g, int b);
 
 	GLSpecBuf *specbuf_get_buffer(const int shininess_i, const float shininess);
@@ -531,6 +564,7 @@ public:
 	GLList *alloc_list(int list);
 	GLList *find_list(uint list);
 	void delete_list(int list);
+	GLParam *gl_call_list_block(GLList *l, int index, GLParam *p);
 	void gl_NewList(TGLuint list, TGLenum mode);
 	void gl_EndList();
 	TGLboolean gl_IsList(TGLuint list);
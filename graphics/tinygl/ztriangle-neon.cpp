@@ -0,0 +1,259 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+#include <arm_neon.h>
+
+#include "graphics/tinygl/zbuffer.h"
+
+namespace TinyGL {
+
+class SpanImpl_NEON {
+public:
+	typedef FrameBuffer::SpanState SpanState;
+	typedef FrameBuffer::SpanValues SpanValues;
+
+	// zDst func zSrc, as in FrameBuffer::compareDepth()
+	static FORCEINLINE uint32x4_t testDepth4(uint32x4_t zDst, uint32x4_t zSrc, int func) {
+		switch (func) {
+		case TGL_LESS:
+			return vcltq_u32(zDst, zSrc);
+		case TGL_EQUAL:
+			return vceqq_u32(zDst, zSrc);
+		case TGL_LEQUAL:
+			return vcleq_u32(zDst, zSrc);
+		case TGL_GREATER:
+			return vcgtq_u32(zDst, zSrc);
+		case TGL_NOTEQUAL:
+			return vmvnq_u32(vceqq_u32(zDst, zSrc));
+		case TGL_GEQUAL:
+			return vcgeq_u32(zDst, zSrc);
+		case TGL_ALWAYS:
+			return vdupq_n_u32(0xffffffff);
+		default:
+			return vdupq_n_u32(0);
+		}
+	}
+
+	// aSrc func ref, as in FrameBuffer::checkAlphaTest()
+	static FORCEINLINE uint32x4_t testAlpha4(uint32x4_t aSrc, int ref, int func) {
+		const int32x4_t a = vreinterpretq_s32_u32(aSrc);
+		const int32x4_t r = vdupq_n_s32(ref);
+		switch (func) {
+		case TGL_LESS:
+			return vcltq_s32(a, r);
+		case TGL_EQUAL:
+			return vceqq_s32(a, r);
+		case TGL_LEQUAL:
+			return vcleq_s32(a, r);
+		case TGL_GREATER:
+			return vcgtq_s32(a, r);
+		case TGL_NOTEQUAL:
+			return vmvnq_u32(vceqq_s32(a, r));
+		case TGL_GEQUAL:
+			return vcgeq_s32(a, r);
+		case TGL_ALWAYS:
+			return vdupq_n_u32(0xffffffff);
+		default:
+			return vdupq_n_u32(0);
+		}
+	}
+
+	static FORCEINLINE uint bits(uint32x4_t mask) {
+		static const uint32 lanes[4] = { 1, 2, 4, 8 };
+		const uint32x4_t b = vandq_u32(mask, vld1q_u32(lanes));
+		const uint32x2_t sum = vadd_u32(vget_low_u32(b), vget_high_u32(b));
+		return vget_lane_u32(vpadd_u32(sum, sum), 0);
+	}
+
+	static FORCEINLINE uint32x4_t laneMask(int count) {
+		static const uint32 lanes[4] = { 0, 1, 2, 3 };
+		return vcltq_u32(vld1q_u32(lanes), vdupq_n_u32(count));
+	}
+
+	static FORCEINLINE uint32x4_t bitMask(uint mask) {
+		static const uint32 lanes[4] = { 1, 2, 4, 8 };
+		return vtstq_u32(vdupq_n_u32(mask), vld1q_u32(lanes));
+	}
+
+	static FORCEINLINE uint32x4_t interpolate(uint value, int delta) {
+		const uint d = delta;
+		const uint32 lanes[4] = { value, value + d, value + d * 2, value + d * 3 };
+		return vld1q_u32(lanes);
+	}
+
+	// The last group of a span may be shorter than four pixels
+	static FORCEINLINE uint32x4_t load32(const void *src, int count) {
+		if (count >= 4)
+			return vld1q_u32((const uint32 *)src);
+
+		uint32 tmp[4] = { 0, 0, 0, 0 };
+		memcpy(tmp, src, count * sizeof(uint32));
+		return vld1q_u32(tmp);
+	}
+
+	static FORCEINLINE void store32(void *dst, uint32x4_t value, uint32x4_t mask, int count) {
+		value = vbslq_u32(mask, value, load32(dst, count));
+		if (count >= 4) {
+			vst1q_u32((uint32 *)dst, value);
+		} else {
+			uint32 tmp[4];
+			vst1q_u32(tmp, value);
+			memcpy(dst, tmp, count * sizeof(uint32));
+		}
+	}
+
+	static FORCEINLINE void store16(void *dst, uint32x4_t value, uint32x4_t mask, int count) {
+		uint16 tmp[4] = { 0, 0, 0, 0 };
+		const uint16 *src = (const uint16 *)dst;
+		if (count < 4) {
+			memcpy(tmp, dst, count * sizeof(uint16));
+			src = tmp;
+		}
+		const uint16x4_t pixels = vbsl_u16(vmovn_u32(mask), vmovn_u32(value), vld1_u16(src));
+		if (count >= 4) {
+			vst1_u16((uint16 *)dst, pixels);
+		} else {
+			vst1_u16(tmp, pixels);
+			memcpy(dst, tmp, count * sizeof(uint16));
+		}
+	}
+
+	// FrameBuffer::writePixel() takes the depth as a float
+	static FORCEINLINE uint32x4_t depthAsFloat(uint32x4_t z) {
+		return vcvtq_u32_f32(vcvtq_f32_u32(z));
+	}
+
+	static FORCEINLINE uint32x4_t channel(uint32x4_t value) {
+		return vandq_u32(vshrq_n_u32(value, 8), vdupq_n_u32(0xff));
+	}
+
+	static FORCEINLINE uint32x4_t packChannel(uint32x4_t value, byte loss, byte shift) {
+		return vshlq_u32(vshlq_u32(value, vdupq_n_s32(-loss)), vdupq_n_s32(shift));
+	}
+
+	// Alpha test, then depth and colour writes as in FrameBuffer::writePixel()
+	static FORCEINLINE void writePixels(byte *pp, uint *pz, int count, uint32x4_t mask, uint32x4_t z,
+	                                    uint32x4_t a, uint32x4_t r, uint32x4_t g, uint32x4_t b, const SpanState &state) {
+		if (state.alphaTest)
+			mask = vandq_u32(mask, testAlpha4(a, state.alphaRefVal, state.alphaFunc));
+		if (!bits(mask))
+			return;
+
+		if (state.depthWrite)
+			store32(pz, depthAsFloat(z), mask, count);
+
+		uint32x4_t color = vorrq_u32(
+			vorrq_u32(packChannel(a, state.aLoss, state.aShift), packChannel(r, state.rLoss, state.rShift)),
+			vorrq_u32(packChannel(g, state.gLoss, state.gShift), packChannel(b, state.bLoss, state.bShift)));
+		if (state.bytesPerPixel == 4)
+			store32(pp, color, mask, count);
+		else
+			store16(pp, color, mask, count);
+	}
+
+	static uint testDepth(const uint *pz, uint z, int dzdx, int count, const SpanState &state) {
+		const uint32x4_t step = vdupq_n_u32((uint)dzdx * 4);
+		uint32x4_t zv = interpolate(z, dzdx);
+		uint result = 0;
+		for (int i = 0; i < count; i += 4) {
+			uint32x4_t mask = vandq_u32(testDepth4(load32(pz + i, count - i), zv, state.depthFunc), laneMask(count - i));
+			result |= bits(mask) << i;
+			zv = vaddq_u32(zv, step);
+		}
+		return result;
+	}
+
+	static void fillDepth(uint *pz, uint z, int dzdx, int count, const SpanState &state) {
+		if (!state.depthWrite)
+			return;
+
+		const uint32x4_t step = vdupq_n_u32((uint)dzdx * 4);
+		uint32x4_t zv = interpolate(z, dzdx);
+		for (; count > 0; count -= 4, pz += 4) {
+			uint32x4_t mask = testDepth4(load32(pz, count), zv, state.depthFunc);
+			store32(pz, zv, mask, count);
+			zv = vaddq_u32(zv, step);
+		}
+	}
+
+	static void fillColor(byte *pp, uint *pz, int count, const SpanValues &values, const SpanState &state) {
+		const int pixelStep = state.bytesPerPixel * 4;
+		const uint32x4_t zStep = vdupq_n_u32((uint)values.dzdx * 4);
+		const uint32x4_t rStep = vdupq_n_u32((uint)values.drdx * 4);
+		const uint32x4_t gStep = vdupq_n_u32((uint)values.dgdx * 4);
+		const uint32x4_t bStep = vdupq_n_u32((uint)values.dbdx * 4);
+		const uint32x4_t aStep = vdupq_n_u32((uint)values.dadx * 4);
+		uint32x4_t z = interpolate(values.z, values.dzdx);
+		uint32x4_t r = interpolate(values.r, values.drdx);
+		uint32x4_t g = interpolate(values.g, values.dgdx);
+		uint32x4_t b = interpolate(values.b, values.dbdx);
+		uint32x4_t a = interpolate(values.a, values.dadx);
+
+		for (; count > 0; count -= 4, pp += pixelStep, pz += 4) {
+			uint32x4_t mask = testDepth4(load32(pz, count), z, state.depthFunc);
+			if (count < 4)
+				mask = vandq_u32(mask, laneMask(count));
+			writePixels(pp, pz, count, mask, z, channel(a), channel(r), channel(g), channel(b), state);
+
+			z = vaddq_u32(z, zStep);
+			r = vaddq_u32(r, rStep);
+			g = vaddq_u32(g, gStep);
+			b = vaddq_u32(b, bStep);
+			a = vaddq_u32(a, aStep);
+		}
+	}
+
+	// Texels are modulated with the lighting as in FrameBuffer::putPixelTexture()
+	static FORCEINLINE uint32x4_t modulate(uint32x4_t texel, uint32x4_t light) {
+		light = vandq_u32(vshrq_n_u32(light, 8), vdupq_n_u32(0xffff));
+		return vandq_u32(vshrq_n_u32(vmulq_u32(texel, light), 8), vdupq_n_u32(0xff));
+	}
+
+	static void writeTexels(byte *pp, uint *pz, int count, uint mask, const uint32 *texels, const SpanValues &values, const SpanState &state) {
+		const uint32x4_t byteMask = vdupq_n_u32(0xff);
+		for (int i = 0; i < count; i += 4) {
+			const uint col = i;
+			const uint lanes = (mask >> i) & 0xf;
+			if (lanes) {
+				uint32x4_t texel = vld1q_u32(texels + i);
+				uint32x4_t a = modulate(vshrq_n_u32(texel, 24), interpolate(values.a + (uint)values.dadx * col, values.dadx));
+				uint32x4_t r = modulate(vandq_u32(vshrq_n_u32(texel, 16), byteMask), interpolate(values.r + (uint)values.drdx * col, values.drdx));
+				uint32x4_t g = modulate(vandq_u32(vshrq_n_u32(texel, 8), byteMask), interpolate(values.g + (uint)values.dgdx * col, values.dgdx));
+				uint32x4_t b = modulate(vandq_u32(texel, byteMask), interpolate(values.b + (uint)values.dbdx * col, values.dbdx));
+				uint32x4_t z = interpolate(values.z + (uint)values.dzdx * col, values.dzdx);
+				writePixels(pp + i * state.bytesPerPixel, pz + i, count - i, bitMask(lanes), z, a, r, g, b, state);
+			}
+		}
+	}
+};
+
+const FrameBuffer::SpanKernels FrameBuffer::spanKernelsNEON = {
+	SpanImpl_NEON::testDepth,
+	SpanImpl_NEON::fillDepth,
+	SpanImpl_NEON::fillColor,
+	SpanImpl_NEON::writeTexels
+};
+
+} // end of namespace TinyGL
+#endif // SCUMMVM_NEON
@@ -0,0 +1,241 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include <immintrin.h>
+
+#include "graphics/tinygl/zbuffer.h"
+
+namespace TinyGL {
+
+class SpanImpl_SSE2 {
+public:
+	typedef FrameBuffer::SpanState SpanState;
+	typedef FrameBuffer::SpanValues SpanValues;
+
+	// a func b, on signed lanes
+	static FORCEINLINE __m128i compare(__m128i a, __m128i b, int func) {
+		const __m128i ones = _mm_set1_epi32(-1);
+		switch (func) {
+		case TGL_LESS:
+			return _mm_cmplt_epi32(a, b);
+		case TGL_EQUAL:
+			return _mm_cmpeq_epi32(a, b);
+		case TGL_LEQUAL:
+			return _mm_xor_si128(_mm_cmpgt_epi32(a, b), ones);
+		case TGL_GREATER:
+			return _mm_cmpgt_epi32(a, b);
+		case TGL_NOTEQUAL:
+			return _mm_xor_si128(_mm_cmpeq_epi32(a, b), ones);
+		case TGL_GEQUAL:
+			return _mm_xor_si128(_mm_cmplt_epi32(a, b), ones);
+		case TGL_ALWAYS:
+			return ones;
+		default:
+			return _mm_setzero_si128();
+		}
+	}
+
+	// Same as FrameBuffer::compareDepth(), which compares unsigned values
+	static FORCEINLINE __m128i testDepth4(__m128i zDst, __m128i zSrc, int func) {
+		const __m128i bias = _mm_set1_epi32((int)0x80000000);
+		return compare(_mm_xor_si128(zDst, bias), _mm_xor_si128(zSrc, bias), func);
+	}
+
+	static FORCEINLINE __m128i laneMask(int count) {
+		return _mm_cmpgt_epi32(_mm_set1_epi32(count), _mm_setr_epi32(0, 1, 2, 3));
+	}
+
+	static FORCEINLINE __m128i bitMask(uint bits) {
+		const __m128i lanes = _mm_setr_epi32(1, 2, 4, 8);
+		return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(bits), lanes), lanes);
+	}
+
+	static FORCEINLINE __m128i interpolate(uint value, int delta) {
+		const uint d = delta;
+		return _mm_setr_epi32(value, value + d, value + d * 2, value + d * 3);
+	}
+
+	// The last group of a span may be shorter than four pixels
+	static FORCEINLINE __m128i load32(const void *src, int count) {
+		if (count >= 4)
+			return _mm_loadu_si128((const __m128i *)src);
+
+		uint32 tmp[4] = { 0, 0, 0, 0 };
+		memcpy(tmp, src, count * sizeof(uint32));
+		return _mm_loadu_si128((const __m128i *)tmp);
+	}
+
+	static FORCEINLINE void store32(void *dst, __m128i value, __m128i mask, int count) {
+		value = _mm_or_si128(_mm_and_si128(mask, value), _mm_andnot_si128(mask, load32(dst, count)));
+		if (count >= 4) {
+			_mm_storeu_si128((__m128i *)dst, value);
+		} else {
+			uint32 tmp[4];
+			_mm_storeu_si128((__m128i *)tmp, value);
+			memcpy(dst, tmp, count * sizeof(uint32));
+		}
+	}
+
+	static FORCEINLINE void store16(void *dst, __m128i value, __m128i mask, int count) {
+		value = _mm_srai_epi32(_mm_slli_epi32(value, 16), 16);
+		value = _mm_packs_epi32(value, value);
+		mask = _mm_packs_epi32(mask, mask);
+
+		uint16 tmp[4] = { 0, 0, 0, 0 };
+		const void *src = dst;
+		if (count < 4) {
+			memcpy(tmp, dst, count * sizeof(uint16));
+			src = tmp;
+		}
+		value = _mm_or_si128(_mm_and_si128(mask, value), _mm_andnot_si128(mask, _mm_loadl_epi64((const __m128i *)src)));
+		if (count >= 4) {
+			_mm_storel_epi64((__m128i *)dst, value);
+		} else {
+			_mm_storel_epi64((__m128i *)tmp, value);
+			memcpy(dst, tmp, count * sizeof(uint16));
+		}
+	}
+
+	// FrameBuffer::writePixel() takes the depth as a float
+	static FORCEINLINE __m128i depthAsFloat(__m128i z) {
+		if (!_mm_movemask_ps(_mm_castsi128_ps(z)))
+			return _mm_cvttps_epi32(_mm_cvtepi32_ps(z));
+
+		uint32 lanes[4];
+		_mm_storeu_si128((__m128i *)lanes, z);
+		for (int i = 0; i < 4; i++)
+			lanes[i] = (uint)(float)lanes[i];
+		return _mm_loadu_si128((const __m128i *)lanes);
+	}
+
+	static FORCEINLINE __m128i channel(__m128i value) {
+		return _mm_and_si128(_mm_srli_epi32(value, 8), _mm_set1_epi32(0xff));
+	}
+
+	static FORCEINLINE __m128i packChannel(__m128i value, byte loss, byte shift) {
+		return _mm_sll_epi32(_mm_srl_epi32(value, _mm_cvtsi32_si128(loss)), _mm_cvtsi32_si128(shift));
+	}
+
+	// Alpha test, then depth and colour writes as in FrameBuffer::writePixel()
+	static FORCEINLINE void writePixels(byte *pp, uint *pz, int count, __m128i mask, __m128i z,
+	                               __m128i a, __m128i r, __m128i g, __m128i b, const SpanState &state) {
+		if (state.alphaTest)
+			mask = _mm_and_si128(mask, compare(a, _mm_set1_epi32(state.alphaRefVal), state.alphaFunc));
+		if (!_mm_movemask_ps(_mm_castsi128_ps(mask)))
+			return;
+
+		if (state.depthWrite)
+			store32(pz, depthAsFloat(z), mask, count);
+
+		__m128i color = _mm_or_si128(
+			_mm_or_si128(packChannel(a, state.aLoss, state.aShift), packChannel(r, state.rLoss, state.rShift)),
+			_mm_or_si128(packChannel(g, state.gLoss, state.gShift), packChannel(b, state.bLoss, state.bShift)));
+		if (state.bytesPerPixel == 4)
+			store32(pp, color, mask, count);
+		else
+			store16(pp, color, mask, count);
+	}
+
+	static uint testDepth(const uint *pz, uint z, int dzdx, int count, const SpanState &state) {
+		const __m128i step = _mm_set1_epi32((uint)dzdx * 4);
+		__m128i zv = interpolate(z, dzdx);
+		uint result = 0;
+		for (int i = 0; i < count; i += 4) {
+			__m128i mask = _mm_and_si128(testDepth4(load32(pz + i, count - i), zv, state.depthFunc), laneMask(count - i));
+			result |= _mm_movemask_ps(_mm_castsi128_ps(mask)) << i;
+			zv = _mm_add_epi32(zv, step);
+		}
+		return result;
+	}
+
+	static void fillDepth(uint *pz, uint z, int dzdx, int count, const SpanState &state) {
+		if (!state.depthWrite)
+			return;
+
+		const __m128i step = _mm_set1_epi32((uint)dzdx * 4);
+		__m128i zv = interpolate(z, dzdx);
+		for (; count > 0; count -= 4, pz += 4) {
+			__m128i mask = testDepth4(load32(pz, count), zv, state.depthFunc);
+			store32(pz, zv, mask, count);
+			zv = _mm_add_epi32(zv, step);
+		}
+	}
+
+	static void fillColor(byte *pp, uint *pz, int count, const SpanValues &values, const SpanState &state) {
+		const int pixelStep = state.bytesPerPixel * 4;
+		const __m128i zStep = _mm_set1_epi32((uint)values.dzdx * 4);
+		const __m128i rStep = _mm_set1_epi32((uint)values.drdx * 4);
+		const __m128i gStep = _mm_set1_epi32((uint)values.dgdx * 4);
+		const __m128i bStep = _mm_set1_epi32((uint)values.dbdx * 4);
+		const __m128i aStep = _mm_set1_epi32((uint)values.dadx * 4);
+		__m128i z = interpolate(values.z, values.dzdx);
+		__m128i r = interpolate(values.r, values.drdx);
+		__m128i g = interpolate(values.g, values.dgdx);
+		__m128i b = interpolate(values.b, values.dbdx);
+		__m128i a = interpolate(values.a, values.dadx);
+
+		for (; count > 0; count -= 4, pp += pixelStep, pz += 4) {
+			__m128i mask = testDepth4(load32(pz, count), z, state.depthFunc);
+			if (count < 4)
+				mask = _mm_and_si128(mask, laneMask(count));
+			writePixels(pp, pz, count, mask, z, channel(a), channel(r), channel(g), channel(b), state);
+
+			z = _mm_add_epi32(z, zStep);
+			r = _mm_add_epi32(r, rStep);
+			g = _mm_add_epi32(g, gStep);
+			b = _mm_add_epi32(b, bStep);
+			a = _mm_add_epi32(a, aStep);
+		}
+	}
+
+	// Texels are modulated with the lighting as in FrameBuffer::putPixelTexture()
+	static FORCEINLINE __m128i modulate(__m128i texel, __m128i light) {
+		light = _mm_and_si128(_mm_srli_epi32(light, 8), _mm_set1_epi32(0xffff));
+		return _mm_srli_epi32(_mm_mullo_epi16(texel, light), 8);
+	}
+
+	static void writeTexels(byte *pp, uint *pz, int count, uint mask, const uint32 *texels, const SpanValues &values, const SpanState &state) {
+		const __m128i byteMask = _mm_set1_epi32(0xff);
+		for (int i = 0; i < count; i += 4) {
+			const uint col = i;
+			const uint bits = (mask >> i) & 0xf;
+			if (bits) {
+				__m128i texel = _mm_loadu_si128((const __m128i *)(texels + i));
+				__m128i a = modulate(_mm_srli_epi32(texel, 24), interpolate(values.a + (uint)values.dadx * col, values.dadx));
+				__m128i r = modulate(_mm_and_si128(_mm_srli_epi32(texel, 16), byteMask), interpolate(values.r + (uint)values.drdx * col, values.drdx));
+				__m128i g = modulate(_mm_and_si128(_mm_srli_epi32(texel, 8), byteMask), interpolate(values.g + (uint)values.dgdx * col, values.dgdx));
+				__m128i b = modulate(_mm_and_si128(texel, byteMask), interpolate(values.b + (uint)values.dbdx * col, values.dbdx));
+				__m128i z = interpolate(values.z + (uint)values.dzdx * col, values.dzdx);
+				writePixels(pp + i * state.bytesPerPixel, pz + i, count - i, bitMask(bits), z, a, r, g, b, state);
+			}
+		}
+	}
+};
+
+const FrameBuffer::SpanKernels FrameBuffer::spanKernelsSSE2 = {
+	SpanImpl_SSE2::testDepth,
+	SpanImpl_SSE2::fillDepth,
+	SpanImpl_SSE2::fillColor,
+	SpanImpl_SSE2::writeTexels
+};
+
+} // end of namespace TinyGL
@@ -157,6 +157,30 @@ void FrameBuffer::putPixelDepth(uint *pz, byte *ps, int _a, int x, int y, uint &
 	z += dzdx;
 }
 
+void FrameBuffer::putTexels(int fbOffset, uint *pz, int count, const TexelBuffer *texture, int s, int t, int dsdx, int dtdx,
+                            const SpanValues &values, const SpanKernels *kernels, const SpanState &state) {
+	uint mask = kernels->testDepth(pz, values.z, values.dzdx, count, state);
+	if (!mask) {
+		return;
+	}
+
+	// Only the texels of visible pixels are fetched
+	uint32 texels[NB_INTERP];
+	for (int i = 0; i < count; i++) {
+		if (mask & (1 << i)) {
+			uint8 c_a, c_r, c_g, c_b;
+			texture->getARGBAt(_wrapS, _wrapT, s, t, c_a, c_r, c_g, c_b);
+			texels[i] = (c_a << 24) | (c_r << 16) | (c_g << 8) | c_b;
+		} else {
+			texels[i] = 0;
+		}
+		s += dsdx;
+		t += dtdx;
+	}
+
+	kernels->writeTexels(_pbuf + fbOffset * _pbufBpp, pz, count, mask, texels, values, state);
+}
+
 template <bool kInterpRGB, bool kInterpZ, bool kInterpST, bool kInterpSTZ, bool kSmoothMode,
           bool kDepthWrite, bool kFogMode, bool kAlphaTestEnabled, bool kEnableScissor,
           bool kBlendingEnabled, bool kStencilEnabled, bool kDepthTestEnabled>
@@ -325,6 +349,13 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		ndtzdx = NB_INTERP * dtzdx;
 	}
 
+	// The span kernels handle the depth test, but not the stencil buffer
+	SpanState spanState;
+	const SpanKernels *kernels = nullptr;
+	if (kInterpZ && kDepthTestEnabled && !kStencilEnabled && (!kInterpRGB || (!kBlendingEnabled && !kFogMode))) {
+		kernels = setupSpanState(spanState, kDepthWrite, kAlphaTestEnabled);
+	}
+
 	if (fz0 > 0) {
 		l1 = p0;
 		l2 = p2;
@@ -423,8 +454,15 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 
 		// we draw all the scan line of the part
 		while (nb_lines > 0) {
+			// nothing left to draw below the scissor rectangle
+			if (kEnableScissor && y >= _clipRectangle.bottom) {
+				return;
+			}
+
 			int x = x1;
-			if (!kInterpRGB) {
+			if (kEnableScissor && y < _clipRectangle.top) {
+				// only the edges need to be stepped above the scissor rectangle
+			} else if (!kInterpRGB) {
 				int n;
 				uint *pz;
 				byte *ps = nullptr;
@@ -437,6 +475,10 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				if (kernels && (!kEnableScissor || isSpanInScissor(x1, x1 + n))) {
+					kernels->fillDepth(pz, z, dzdx, n + 1, spanState);
+					n = -1;
+				}
 				while (n >= 3) {
 					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
 					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 1, x, y, z, dzdx);
@@ -483,6 +525,14 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				if (kernels && (!kEnableScissor || isSpanInScissor(x1, x1 + n))) {
+					const SpanValues values = {
+						z, r, g, b, a,
+						dzdx, kSmoothMode ? drdx : 0, kSmoothMode ? dgdx : 0, kSmoothMode ? dbdx : 0, kSmoothMode ? dadx : 0
+					};
+					kernels->fillColor(_pbuf + pp * _pbufBpp, pz, n + 1, values, spanState);
+					n = -1;
+				}
 				while (n >= 3) {
 					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
 					                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
@@ -545,6 +595,7 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				g = g1;
 				b = b1;
 				a = a1;
+				const bool useSpanKernels = kernels && (!kEnableScissor || isSpanInScissor(x1, x1 + n));
 				while (n >= (NB_INTERP - 1)) {
 					{
 						float ss, tt;
@@ -557,9 +608,24 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						fz += fndzdx;
 						zinv = (float)(1.0 / fz);
 					}
-					for (int _a = 0; _a < NB_INTERP; _a++) {
-						putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-						               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					if (useSpanKernels) {
+						const SpanValues values = {
+							z, r, g, b, a,
+							dzdx, kSmoothMode ? drdx : 0, kSmoothMode ? dgdx : 0, kSmoothMode ? dbdx : 0, kSmoothMode ? dadx : 0
+						};
+						putTexels(pp, pz, NB_INTERP, texture, s, t, dsdx, dtdx, values, kernels, spanState);
+						z += (uint)dzdx * NB_INTERP;
+						if (kSmoothMode) {
+							r += (uint)drdx * NB_INTERP;
+							g += (uint)dgdx * NB_INTERP;
+							b += (uint)dbdx * NB_INTERP;
+							a += (uint)dadx * NB_INTERP;
+						}
+					} else {
+						for (int _a = 0; _a < NB_INTERP; _a++) {
+							putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+							               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						}
 					}
 					pp += NB_INTERP;
 					if (kInterpZ) {
@@ -584,6 +650,15 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 					dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
 				}
 
+				if (useSpanKernels && n >= 0) {
+					const SpanValues values = {
+						z, r, g, b, a,
+						dzdx, kSmoothMode ? drdx : 0, kSmoothMode ? dgdx : 0, kSmoothMode ? dbdx : 0, kSmoothMode ? dadx : 0
+					};
+					putTexels(pp, pz, n + 1, texture, s, t, dsdx, dtdx, values, kernels, spanState);
+					n = -1;
+				}
+
 				while (n >= 0) {
 					putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
 					               (pp, texture, _wrapS, _wrapT, pz, ps, 0, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
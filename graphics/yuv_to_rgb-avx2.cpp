@@ -0,0 +1,244 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include <immintrin.h>
+
+#include "graphics/yuv_to_rgb.h"
+
+namespace Graphics {
+
+class YUVToRGBImpl_AVX2 {
+public:
+	typedef YUVToRGBManager::RowArgs RowArgs;
+
+	// The destination format, unpacked once per row
+	struct Params {
+		// 16bpp pixels are built with shifts
+		__m128i rLoss, gLoss, bLoss;
+		__m128i rShift, gShift, bShift;
+		__m256i alpha16;
+		// 32bpp pixels are interleaved from bytes, with a constant byte
+		// where none of the channels go
+		int order[4];
+		__m256i alphaByte;
+
+		Params(const RowArgs &args) {
+			rLoss = _mm_cvtsi32_si128(args.rLoss);
+			gLoss = _mm_cvtsi32_si128(args.gLoss);
+			bLoss = _mm_cvtsi32_si128(args.bLoss);
+			rShift = _mm_cvtsi32_si128(args.rShift);
+			gShift = _mm_cvtsi32_si128(args.gShift);
+			bShift = _mm_cvtsi32_si128(args.bShift);
+			alpha16 = _mm256_set1_epi16((short)args.alpha);
+
+			order[0] = order[1] = order[2] = order[3] = 3;
+			alphaByte = _mm256_setzero_si256();
+			if (args.bytesPerPixel == 4) {
+				int alphaPos = 0 + 1 + 2 + 3 - args.rShift / 8 - args.gShift / 8 - args.bShift / 8;
+				order[args.rShift / 8] = 0;
+				order[args.gShift / 8] = 1;
+				order[args.bShift / 8] = 2;
+				alphaByte = _mm256_set1_epi8((char)(args.alpha >> (alphaPos * 8)));
+			}
+		}
+	};
+
+	static FORCEINLINE __m256i applySign(__m256i x, __m256i sign) {
+		return _mm256_sub_epi16(_mm256_xor_si256(x, sign), sign);
+	}
+
+	// Compute the offsets added to the luma for 16 chroma samples,
+	// zero extended to 16 bits
+	static FORCEINLINE void chromaOffsets(__m256i u, __m256i v, __m256i &rOff, __m256i &gOff, __m256i &bOff) {
+		const __m256i cr = _mm256_sub_epi16(v, _mm256_set1_epi16(128));
+		const __m256i cb = _mm256_sub_epi16(u, _mm256_set1_epi16(128));
+		const __m256i crSign = _mm256_srai_epi16(cr, 15);
+		const __m256i cbSign = _mm256_srai_epi16(cb, 15);
+		const __m256i crAbs = _mm256_slli_epi16(_mm256_abs_epi16(cr), 1);
+		const __m256i cbAbs = _mm256_slli_epi16(_mm256_abs_epi16(cb), 1);
+
+		rOff = applySign(_mm256_mulhi_epu16(crAbs, _mm256_set1_epi16((short)YUVToRGBManager::kCrToR)), crSign);
+		gOff = _mm256_sub_epi16(_mm256_setzero_si256(),
+		       _mm256_add_epi16(applySign(_mm256_mulhi_epu16(crAbs, _mm256_set1_epi16((short)YUVToRGBManager::kCrToG)), crSign),
+		                        applySign(_mm256_mulhi_epu16(cbAbs, _mm256_set1_epi16((short)YUVToRGBManager::kCbToG)), cbSign)));
+		bOff = applySign(_mm256_mulhi_epu16(cbAbs, _mm256_set1_epi16((short)YUVToRGBManager::kCbToB)), cbSign);
+	}
+
+	// Clamp a channel to [0, 255], or stretch [16, 235] to it as
+	// (c - 16) * 255 / 219 for ITU luminance
+	template<bool itu>
+	static FORCEINLINE __m256i clampChannel(__m256i c) {
+		if (!itu)
+			return _mm256_min_epi16(_mm256_max_epi16(c, _mm256_setzero_si256()), _mm256_set1_epi16(255));
+
+		c = _mm256_sub_epi16(_mm256_min_epi16(_mm256_max_epi16(c, _mm256_set1_epi16(16)), _mm256_set1_epi16(235)), _mm256_set1_epi16(16));
+		return _mm256_mulhi_epu16(_mm256_slli_epi16(c, 1), _mm256_set1_epi16((short)YUVToRGBManager::kITUScale));
+	}
+
+	// Pack two halves of a channel into bytes. The saturation takes care of
+	// the clamping for full range luminance.
+	template<bool itu>
+	static FORCEINLINE __m256i packChannel(__m256i lo, __m256i hi) {
+		if (itu)
+			return _mm256_packus_epi16(clampChannel<true>(lo), clampChannel<true>(hi));
+		return _mm256_packus_epi16(lo, hi);
+	}
+
+	// Write 32 pixels. The luma is given as bytes and the offsets as the
+	// unpacked low and high halves of each 128-bit lane, which is also the
+	// order the pixels are produced in.
+	template<typename PixelInt, bool itu>
+	static FORCEINLINE void writePixels(byte *dst, __m256i y, const __m256i *rOff, const __m256i *gOff, const __m256i *bOff, const Params &p) {
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i yLo = _mm256_unpacklo_epi8(y, zero);
+		const __m256i yHi = _mm256_unpackhi_epi8(y, zero);
+
+		if (sizeof(PixelInt) == 2) {
+			__m256i pix[2];
+			for (int i = 0; i < 2; i++) {
+				const __m256i yHalf = i ? yHi : yLo;
+				__m256i r = _mm256_srl_epi16(clampChannel<itu>(_mm256_add_epi16(yHalf, rOff[i])), p.rLoss);
+				__m256i g = _mm256_srl_epi16(clampChannel<itu>(_mm256_add_epi16(yHalf, gOff[i])), p.gLoss);
+				__m256i b = _mm256_srl_epi16(clampChannel<itu>(_mm256_add_epi16(yHalf, bOff[i])), p.bLoss);
+				pix[i] = _mm256_or_si256(_mm256_or_si256(p.alpha16, _mm256_sll_epi16(r, p.rShift)),
+				                         _mm256_or_si256(_mm256_sll_epi16(g, p.gShift), _mm256_sll_epi16(b, p.bShift)));
+			}
+			_mm256_storeu_si256((__m256i *)dst, _mm256_permute2x128_si256(pix[0], pix[1], 0x20));
+			_mm256_storeu_si256((__m256i *)(dst + 32), _mm256_permute2x128_si256(pix[0], pix[1], 0x31));
+		} else {
+			__m256i channels[4];
+			channels[0] = packChannel<itu>(_mm256_add_epi16(yLo, rOff[0]), _mm256_add_epi16(yHi, rOff[1]));
+			channels[1] = packChannel<itu>(_mm256_add_epi16(yLo, gOff[0]), _mm256_add_epi16(yHi, gOff[1]));
+			channels[2] = packChannel<itu>(_mm256_add_epi16(yLo, bOff[0]), _mm256_add_epi16(yHi, bOff[1]));
+			channels[3] = p.alphaByte;
+
+			const __m256i b0 = channels[p.order[0]];
+			const __m256i b1 = channels[p.order[1]];
+			const __m256i b2 = channels[p.order[2]];
+			const __m256i b3 = channels[p.order[3]];
+			const __m256i lo01 = _mm256_unpacklo_epi8(b0, b1), hi01 = _mm256_unpackhi_epi8(b0, b1);
+			const __m256i lo23 = _mm256_unpacklo_epi8(b2, b3), hi23 = _mm256_unpackhi_epi8(b2, b3);
+			const __m256i p0 = _mm256_unpacklo_epi16(lo01, lo23), p1 = _mm256_unpackhi_epi16(lo01, lo23);
+			const __m256i p2 = _mm256_unpacklo_epi16(hi01, hi23), p3 = _mm256_unpackhi_epi16(hi01, hi23);
+			_mm256_storeu_si256((__m256i *)dst, _mm256_permute2x128_si256(p0, p1, 0x20));
+			_mm256_storeu_si256((__m256i *)(dst + 32), _mm256_permute2x128_si256(p2, p3, 0x20));
+			_mm256_storeu_si256((__m256i *)(dst + 64), _mm256_permute2x128_si256(p0, p1, 0x31));
+			_mm256_storeu_si256((__m256i *)(dst + 96), _mm256_permute2x128_si256(p2, p3, 0x31));
+		}
+	}
+
+	template<typename PixelInt, bool itu>
+	static void convert444RowT(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const RowArgs &args) {
+		const Params p(args);
+		const __m256i zero = _mm256_setzero_si256();
+		int x = 0;
+
+		for (; x + 32 <= width; x += 32) {
+			const __m256i u = _mm256_loadu_si256((const __m256i *)(uSrc + x));
+			const __m256i v = _mm256_loadu_si256((const __m256i *)(vSrc + x));
+			__m256i rOff[2], gOff[2], bOff[2];
+			chromaOffsets(_mm256_unpacklo_epi8(u, zero), _mm256_unpacklo_epi8(v, zero), rOff[0], gOff[0], bOff[0]);
+			chromaOffsets(_mm256_unpackhi_epi8(u, zero), _mm256_unpackhi_epi8(v, zero), rOff[1], gOff[1], bOff[1]);
+			writePixels<PixelInt, itu>(dst + x * sizeof(PixelInt), _mm256_loadu_si256((const __m256i *)(ySrc + x)), rOff, gOff, bOff, p);
+		}
+
+		for (; x < width; x++)
+			YUVToRGBManager::putPixel<PixelInt>(dst + x * sizeof(PixelInt), ySrc[x], uSrc[x], vSrc[x], args);
+	}
+
+	// Convert one or two rows sharing a row of 422 chroma
+	template<typename PixelInt, bool itu, int rows>
+	static void convert422RowsT(byte *dst, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc, int width, const RowArgs &args) {
+		const Params p(args);
+		int x = 0;
+
+		for (; x + 32 <= width; x += 32) {
+			__m256i r, g, b;
+			chromaOffsets(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(uSrc + x / 2))),
+			              _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(vSrc + x / 2))), r, g, b);
+
+			// Each chroma sample covers two pixels
+			const __m256i rOff[2] = { _mm256_unpacklo_epi16(r, r), _mm256_unpackhi_epi16(r, r) };
+			const __m256i gOff[2] = { _mm256_unpacklo_epi16(g, g), _mm256_unpackhi_epi16(g, g) };
+			const __m256i bOff[2] = { _mm256_unpacklo_epi16(b, b), _mm256_unpackhi_epi16(b, b) };
+			writePixels<PixelInt, itu>(dst + x * sizeof(PixelInt), _mm256_loadu_si256((const __m256i *)(ySrc + x)), rOff, gOff, bOff, p);
+			if (rows == 2)
+				writePixels<PixelInt, itu>(dst + dstPitch + x * sizeof(PixelInt), _mm256_loadu_si256((const __m256i *)(ySrc + yPitch + x)), rOff, gOff, bOff, p);
+		}
+
+		for (; x < width; x++) {
+			YUVToRGBManager::putPixel<PixelInt>(dst + x * sizeof(PixelInt), ySrc[x], uSrc[x / 2], vSrc[x / 2], args);
+			if (rows == 2)
+				YUVToRGBManager::putPixel<PixelInt>(dst + dstPitch + x * sizeof(PixelInt), ySrc[yPitch + x], uSrc[x / 2], vSrc[x / 2], args);
+		}
+	}
+
+	static void convert444Row(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const RowArgs &args) {
+		if (args.bytesPerPixel == 2) {
+			if (args.itu)
+				convert444RowT<uint16, true>(dst, ySrc, uSrc, vSrc, width, args);
+			else
+				convert444RowT<uint16, false>(dst, ySrc, uSrc, vSrc, width, args);
+		} else {
+			if (args.itu)
+				convert444RowT<uint32, true>(dst, ySrc, uSrc, vSrc, width, args);
+			else
+				convert444RowT<uint32, false>(dst, ySrc, uSrc, vSrc, width, args);
+		}
+	}
+
+	static void convert422Row(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const RowArgs &args) {
+		if (args.bytesPerPixel == 2) {
+			if (args.itu)
+				convert422RowsT<uint16, true, 1>(dst, 0, ySrc, 0, uSrc, vSrc, width, args);
+			else
+				convert422RowsT<uint16, false, 1>(dst, 0, ySrc, 0, uSrc, vSrc, width, args);
+		} else {
+			if (args.itu)
+				convert422RowsT<uint32, true, 1>(dst, 0, ySrc, 0, uSrc, vSrc, width, args);
+			else
+				convert422RowsT<uint32, false, 1>(dst, 0, ySrc, 0, uSrc, vSrc, width, args);
+		}
+	}
+
+	static void convert420Rows(byte *dst, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc, int width, const RowArgs &args) {
+		if (args.bytesPerPixel == 2) {
+			if (args.itu)
+				convert422RowsT<uint16, true, 2>(dst, dstPitch, ySrc, yPitch, uSrc, vSrc, width, args);
+			else
+				convert422RowsT<uint16, false, 2>(dst, dstPitch, ySrc, yPitch, uSrc, vSrc, width, args);
+		} else {
+			if (args.itu)
+				convert422RowsT<uint32, true, 2>(dst, dstPitch, ySrc, yPitch, uSrc, vSrc, width, args);
+			else
+				convert422RowsT<uint32, false, 2>(dst, dstPitch, ySrc, yPitch, uSrc, vSrc, width, args);
+		}
+	}
+};
+
+const YUVToRGBManager::Kernels YUVToRGBManager::kernelsAVX2 = {
+	YUVToRGBImpl_AVX2::convert444Row,
+	YUVToRGBImpl_AVX2::convert422Row,
+	YUVToRGBImpl_AVX2::convert420Rows
+};
+
+} // End of namespace Graphics
@@ -0,0 +1,245 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+#include <arm_neon.h>
+
+#include "graphics/yuv_to_rgb.h"
+
+namespace Graphics {
+
+class YUVToRGBImpl_NEON {
+public:
+	typedef YUVToRGBManager::RowArgs RowArgs;
+
+	// The destination format, unpacked once per row
+	struct Params {
+		// 16bpp pixels are built with shifts, negative counts shift right
+		int16x8_t rLoss, gLoss, bLoss;
+		int16x8_t rShift, gShift, bShift;
+		uint16x8_t alpha16;
+		// 32bpp pixels are interleaved from bytes, with a constant byte
+		// where none of the channels go
+		int order[4];
+		uint8x16_t alphaByte;
+
+		Params(const RowArgs &args) {
+			rLoss = vdupq_n_s16(-args.rLoss);
+			gLoss = vdupq_n_s16(-args.gLoss);
+			bLoss = vdupq_n_s16(-args.bLoss);
+			rShift = vdupq_n_s16(args.rShift);
+			gShift = vdupq_n_s16(args.gShift);
+			bShift = vdupq_n_s16(args.bShift);
+			alpha16 = vdupq_n_u16((uint16)args.alpha);
+
+			order[0] = order[1] = order[2] = order[3] = 3;
+			alphaByte = vdupq_n_u8(0);
+			if (args.bytesPerPixel == 4) {
+				int alphaPos = 0 + 1 + 2 + 3 - args.rShift / 8 - args.gShift / 8 - args.bShift / 8;
+				order[args.rShift / 8] = 0;
+				order[args.gShift / 8] = 1;
+				order[args.bShift / 8] = 2;
+				alphaByte = vdupq_n_u8((uint8)(args.alpha >> (alphaPos * 8)));
+			}
+		}
+	};
+
+	static FORCEINLINE int16x8_t applySign(int16x8_t x, int16x8_t sign) {
+		return vsubq_s16(veorq_s16(x, sign), sign);
+	}
+
+	// Multiply and drop 15 fractional bits
+	static FORCEINLINE int16x8_t mulShift15(int16x8_t x, uint16 k) {
+		const uint16x8_t ux = vreinterpretq_u16_s16(x);
+		uint32x4_t lo = vmull_n_u16(vget_low_u16(ux), k);
+		uint32x4_t hi = vmull_n_u16(vget_high_u16(ux), k);
+		return vreinterpretq_s16_u16(vcombine_u16(vshrn_n_u32(lo, 15), vshrn_n_u32(hi, 15)));
+	}
+
+	// Compute the offsets added to the luma for 8 chroma samples
+	static FORCEINLINE void chromaOffsets(uint8x8_t u, uint8x8_t v, int16x8_t &rOff, int16x8_t &gOff, int16x8_t &bOff) {
+		const int16x8_t cr = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), vdupq_n_s16(128));
+		const int16x8_t cb = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u)), vdupq_n_s16(128));
+		const int16x8_t crSign = vshrq_n_s16(cr, 15);
+		const int16x8_t cbSign = vshrq_n_s16(cb, 15);
+		const int16x8_t crAbs = vabsq_s16(cr);
+		const int16x8_t cbAbs = vabsq_s16(cb);
+
+		rOff = applySign(mulShift15(crAbs, YUVToRGBManager::kCrToR), crSign);
+		gOff = vnegq_s16(vaddq_s16(applySign(mulShift15(crAbs, YUVToRGBManager::kCrToG), crSign),
+		                           applySign(mulShift15(cbAbs, YUVToRGBManager::kCbToG), cbSign)));
+		bOff = applySign(mulShift15(cbAbs, YUVToRGBManager::kCbToB), cbSign);
+	}
+
+	// Clamp a channel to [0, 255], or stretch [16, 235] to it as
+	// (c - 16) * 255 / 219 for ITU luminance
+	template<bool itu>
+	static FORCEINLINE int16x8_t clampChannel(int16x8_t c) {
+		if (!itu)
+			return vminq_s16(vmaxq_s16(c, vdupq_n_s16(0)), vdupq_n_s16(255));
+
+		c = vsubq_s16(vminq_s16(vmaxq_s16(c, vdupq_n_s16(16)), vdupq_n_s16(235)), vdupq_n_s16(16));
+		const uint16x8_t c2 = vreinterpretq_u16_s16(vshlq_n_s16(c, 1));
+		uint32x4_t lo = vmull_n_u16(vget_low_u16(c2), YUVToRGBManager::kITUScale);
+		uint32x4_t hi = vmull_n_u16(vget_high_u16(c2), YUVToRGBManager::kITUScale);
+		return vreinterpretq_s16_u16(vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16)));
+	}
+
+	// Pack two halves of a channel into bytes. The saturation takes care of
+	// the clamping for full range luminance.
+	template<bool itu>
+	static FORCEINLINE uint8x16_t packChannel(int16x8_t lo, int16x8_t hi) {
+		if (itu) {
+			lo = clampChannel<true>(lo);
+			hi = clampChannel<true>(hi);
+		}
+		return vcombine_u8(vqmovun_s16(lo), vqmovun_s16(hi));
+	}
+
+	// Write 16 pixels; the luma is given as bytes, the offsets as two halves
+	template<typename PixelInt, bool itu>
+	static FORCEINLINE void writePixels(byte *dst, uint8x16_t y, const int16x8_t *rOff, const int16x8_t *gOff, const int16x8_t *bOff, const Params &p) {
+		const int16x8_t yLo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y)));
+		const int16x8_t yHi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y)));
+
+		if (sizeof(PixelInt) == 2) {
+			for (int i = 0; i < 2; i++) {
+				const int16x8_t yHalf = i ? yHi : yLo;
+				uint16x8_t r = vshlq_u16(vreinterpretq_u16_s16(clampChannel<itu>(vaddq_s16(yHalf, rOff[i]))), p.rLoss);
+				uint16x8_t g = vshlq_u16(vreinterpretq_u16_s16(clampChannel<itu>(vaddq_s16(yHalf, gOff[i]))), p.gLoss);
+				uint16x8_t b = vshlq_u16(vreinterpretq_u16_s16(clampChannel<itu>(vaddq_s16(yHalf, bOff[i]))), p.bLoss);
+				uint16x8_t pix = vorrq_u16(vorrq_u16(p.alpha16, vshlq_u16(r, p.rShift)),
+				                           vorrq_u16(vshlq_u16(g, p.gShift), vshlq_u16(b, p.bShift)));
+				vst1q_u8(dst + i * 16, vreinterpretq_u8_u16(pix));
+			}
+		} else {
+			uint8x16_t channels[4];
+			channels[0] = packChannel<itu>(vaddq_s16(yLo, rOff[0]), vaddq_s16(yHi, rOff[1]));
+			channels[1] = packChannel<itu>(vaddq_s16(yLo, gOff[0]), vaddq_s16(yHi, gOff[1]));
+			channels[2] = packChannel<itu>(vaddq_s16(yLo, bOff[0]), vaddq_s16(yHi, bOff[1]));
+			channels[3] = p.alphaByte;
+
+			uint8x16x4_t pix;
+			pix.val[0] = channels[p.order[0]];
+			pix.val[1] = channels[p.order[1]];
+			pix.val[2] = channels[p.order[2]];
+			pix.val[3] = channels[p.order[3]];
+			vst4q_u8(dst, pix);
+		}
+	}
+
+	template<typename PixelInt, bool itu>
+	static void convert444RowT(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const RowArgs &args) {
+		const Params p(args);
+		int x = 0;
+
+		for (; x + 16 <= width; x += 16) {
+			const uint8x16_t u = vld1q_u8(uSrc + x);
+			const uint8x16_t v = vld1q_u8(vSrc + x);
+			int16x8_t rOff[2], gOff[2], bOff[2];
+			chromaOffsets(vget_low_u8(u), vget_low_u8(v), rOff[0], gOff[0], bOff[0]);
+			chromaOffsets(vget_high_u8(u), vget_high_u8(v), rOff[1], gOff[1], bOff[1]);
+			writePixels<PixelInt, itu>(dst + x * sizeof(PixelInt), vld1q_u8(ySrc + x), rOff, gOff, bOff, p);
+		}
+
+		for (; x < width; x++)
+			YUVToRGBManager::putPixel<PixelInt>(dst + x * sizeof(PixelInt), ySrc[x], uSrc[x], vSrc[x], args);
+	}
+
+	// Convert one or two rows sharing a row of 422 chroma
+	template<typename PixelInt, bool itu, int rows>
+	static void convert422RowsT(byte *dst, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc, int width, const RowArgs &args) {
+		const Params p(args);
+		int x = 0;
+
+		for (; x + 16 <= width; x += 16) {
+			int16x8_t r, g, b;
+			chromaOffsets(vld1_u8(uSrc + x / 2), vld1_u8(vSrc + x / 2), r, g, b);
+
+			// Each chroma sample covers two pixels
+			const int16x8x2_t rDup = vzipq_s16(r, r);
+			const int16x8x2_t gDup = vzipq_s16(g, g);
+			const int16x8x2_t bDup = vzipq_s16(b, b);
+			writePixels<PixelInt, itu>(dst + x * sizeof(PixelInt), vld1q_u8(ySrc + x), rDup.val, gDup.val, bDup.val, p);
+			if (rows == 2)
+				writePixels<PixelInt, itu>(dst + dstPitch + x * sizeof(PixelInt), vld1q_u8(ySrc + yPitch + x), rDup.val, gDup.val, bDup.val, p);
+		}
+
+		for (; x < width; x++) {
+			YUVToRGBManager::putPixel<PixelInt>(dst + x * sizeof(PixelInt), ySrc[x], uSrc[x / 2], vSrc[x / 2], args);
+			if (rows == 2)
+				YUVToRGBManager::putPixel<PixelInt>(dst + dstPitch + x * sizeof(PixelInt), ySrc[yPitch + x], uSrc[x / 2], vSrc[x / 2], args);
+		}
+	}
+
+	static void convert444Row(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const RowArgs &args) {
+		if (args.bytesPerPixel == 2) {
+			if (args.itu)
+				convert444RowT<uint16, true>(dst, ySrc, uSrc, vSrc, width, args);
+			else
+				convert444RowT<uint16, false>(dst, ySrc, uSrc, vSrc, width, args);
+		} else {
+			if (args.itu)
+				convert444RowT<uint32, true>(dst, ySrc, uSrc, vSrc, width, args);
+			else
+				convert444RowT<uint32, false>(dst, ySrc, uSrc, vSrc, width, args);
+		}
+	}
+
+	static void convert422Row(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const RowArgs &args) {
+		if (args.bytesPerPixel == 2) {
+			if (args.itu)
+				convert422RowsT<uint16, true, 1>(dst, 0, ySrc, 0, uSrc, vSrc, width, args);
+			else
+				convert422RowsT<uint16, false, 1>(dst, 0, ySrc, 0, uSrc, vSrc, width, args);
+		} else {
+			if (args.itu)
+				convert422RowsT<uint32, true, 1>(dst, 0, ySrc, 0, uSrc, vSrc, width, args);
+			else
+				convert422RowsT<uint32, false, 1>(dst, 0, ySrc, 0, uSrc, vSrc, width, args);
+		}
+	}
+
+	static void convert420Rows(byte *dst, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc, int width, const RowArgs &args) {
+		if (args.bytesPerPixel == 2) {
+			if (args.itu)
+				convert422RowsT<uint16, true, 2>(dst, dstPitch, ySrc, yPitch, uSrc, vSrc, width, args);
+			else
+				convert422RowsT<uint16, false, 2>(dst, dstPitch, ySrc, yPitch, uSrc, vSrc, width, args);
+		} else {
+			if (args.itu)
+				convert422RowsT<uint32, true, 2>(dst, dstPitch, ySrc, yPitch, uSrc, vSrc, width, args);
+			else
+				convert422RowsT<uint32, false, 2>(dst, dstPitch, ySrc, yPitch, uSrc, vSrc, width, args);
+		}
+	}
+};
+
+const YUVToRGBManager::Kernels YUVToRGBManager::kernelsNEON = {
+	YUVToRGBImpl_NEON::convert444Row,
+	YUVToRGBImpl_NEON::convert422Row,
+	YUVToRGBImpl_NEON::convert420Rows
+};
+
+} // End of namespace Graphics
+#endif // SCUMMVM_NEON
@@ -82,6 +82,7 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/system.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
@@ -202,6 +203,57 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+void YUVToRGBManager::getRowArgs(RowArgs &args, const YUVToRGBLookup *lookup) {
+	const Graphics::PixelFormat &format = lookup->getFormat();
+
+	args.rgbToPix = lookup->getRGBToPix();
+	args.colorTab = _colorTab;
+	args.alpha = format.ARGBToColor(255, 0, 0, 0);
+	args.bytesPerPixel = format.bytesPerPixel;
+	args.itu = lookup->getScale() == kScaleITU;
+	args.rLoss = format.rLoss;
+	args.gLoss = format.gLoss;
+	args.bLoss = format.bLoss;
+	args.rShift = format.rShift;
+	args.gShift = format.gShift;
+	args.bShift = format.bShift;
+}
+
+bool YUVToRGBManager::isSupported(const Graphics::PixelFormat &format) {
+	if (format.bytesPerPixel == 2)
+		return true;
+
+	// 32bpp pixels are interleaved from whole bytes
+	return format.bytesPerPixel == 4 &&
+	       format.rLoss == 0 && format.gLoss == 0 && format.bLoss == 0 &&
+	       (format.rShift & 7) == 0 && (format.gShift & 7) == 0 && (format.bShift & 7) == 0;
+}
+
+const YUVToRGBManager::Kernels *YUVToRGBManager::kernels = nullptr;
+bool YUVToRGBManager::kernelsSelected = false;
+
+const YUVToRGBManager::Kernels *YUVToRGBManager::getKernels() {
+	// If no kernels have been selected yet, detect and select
+	if (!kernelsSelected) {
+		// The CPU features can't be queried without a backend
+		if (!g_system)
+			return nullptr;
+
+		kernelsSelected = true;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) kernels = &kernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) kernels = &kernelsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) kernels = &kernelsAVX2;
+#endif
+	}
+
+	return kernels;
+}
+
 #define PUT_PIXEL(s, d) \
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
@@ -245,6 +297,22 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	const Kernels *simd = isSupported(dst->format) ? getKernels() : nullptr;
+	if (simd) {
+		RowArgs args;
+		getRowArgs(args, lookup);
+
+		byte *dstPtr = (byte *)dst->getPixels();
+		for (int h = 0; h < yHeight; h++) {
+			simd->convert444Row(dstPtr, ySrc, uSrc, vSrc, yWidth, args);
+			dstPtr += dst->pitch;
+			ySrc += yPitch;
+			uSrc += uvPitch;
+			vSrc += uvPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -297,6 +365,22 @@ void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	const Kernels *simd = isSupported(dst->format) ? getKernels() : nullptr;
+	if (simd) {
+		RowArgs args;
+		getRowArgs(args, lookup);
+
+		byte *dstPtr = (byte *)dst->getPixels();
+		for (int h = 0; h < yHeight; h++) {
+			simd->convert422Row(dstPtr, ySrc, uSrc, vSrc, yWidth, args);
+			dstPtr += dst->pitch;
+			ySrc += yPitch;
+			uSrc += uvPitch;
+			vSrc += uvPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV422ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -353,6 +437,23 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	const Kernels *simd = isSupported(dst->format) ? getKernels() : nullptr;
+	if (simd) {
+		RowArgs args;
+		getRowArgs(args, lookup);
+
+		// Each chroma row is shared by two luma rows
+		byte *dstPtr = (byte *)dst->getPixels();
+		for (int h = 0; h < yHeight; h += 2) {
+			simd->convert420Rows(dstPtr, dst->pitch, ySrc, yPitch, uSrc, vSrc, yWidth, args);
+			dstPtr += dst->pitch * 2;
+			ySrc += yPitch * 2;
+			uSrc += uvPitch;
+			vSrc += uvPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -492,6 +593,26 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 #undef DO_INTERPOLATION
 #undef DO_YUV410_PIXEL
 
+/**
+ * Expand one row of YUV410 chroma to full resolution, giving the same values
+ * as the bilinear interpolation in convertYUV410ToRGB.
+ */
+static void interpolateYUV410Row(byte *dst, const byte *src, int uvPitch, int yWidth, int yDiff) {
+	int quarterWidth = yWidth >> 2;
+
+	for (int x = 0; x < quarterWidth; x++) {
+		// Interpolate vertically first, then between the two columns
+		int left = src[x] * (4 - yDiff) + src[x + uvPitch] * yDiff;
+		int right = src[x + 1] * (4 - yDiff) + src[x + uvPitch + 1] * yDiff;
+
+		dst[0] = (left * 4) >> 4;
+		dst[1] = (left * 3 + right) >> 4;
+		dst[2] = (left * 2 + right * 2) >> 4;
+		dst[3] = (left + right * 3) >> 4;
+		dst += 4;
+	}
+}
+
 void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
@@ -502,6 +623,27 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	const Kernels *simd = isSupported(dst->format) ? getKernels() : nullptr;
+	if (simd) {
+		byte *chroma = (byte *)malloc(yWidth * 2);
+		if (chroma) {
+			RowArgs args;
+			getRowArgs(args, lookup);
+
+			byte *dstPtr = (byte *)dst->getPixels();
+			for (int y = 0; y < yHeight; y++) {
+				interpolateYUV410Row(chroma, uSrc + (y >> 2) * uvPitch, uvPitch, yWidth, y & 3);
+				interpolateYUV410Row(chroma + yWidth, vSrc + (y >> 2) * uvPitch, uvPitch, yWidth, y & 3);
+				simd->convert444Row(dstPtr, ySrc, chroma, chroma + yWidth, yWidth, args);
+				dstPtr += dst->pitch;
+				ySrc += yPitch;
+			}
+
+			free(chroma);
+			return;
+		}
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
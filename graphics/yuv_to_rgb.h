@@ -41,6 +41,8 @@
 #include "common/singleton.h"
 #include "graphics/surface.h"
 
+class YUVToRGBTestSuite;
+
 namespace Graphics {
 
 class YUVToRGBLookup;
@@ -135,12 +137,79 @@ public:
 	 */
 	void convert410(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Parameters shared by the SIMD row conversion kernels.
+	 *
+	 * The lookup tables are used for the pixels left over at the end of a
+	 * row; the rest describes the destination format.
+	 */
+	struct RowArgs {
+		const uint32 *rgbToPix;
+		const int16 *colorTab;
+		uint32 alpha;
+		int bytesPerPixel;
+		bool itu;
+		byte rLoss, gLoss, bLoss;
+		byte rShift, gShift, bShift;
+	};
+
+	typedef void (*ConvertRowFunc)(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width, const RowArgs &args);
+	typedef void (*ConvertRowPairFunc)(byte *dst, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc, int width, const RowArgs &args);
+
+	struct Kernels {
+		ConvertRowFunc convert444Row;      /**< One chroma sample per pixel */
+		ConvertRowFunc convert422Row;      /**< One chroma sample per two pixels, width must be even */
+		ConvertRowPairFunc convert420Rows; /**< Two rows sharing one 422 chroma row */
+	};
+
+#ifdef SCUMMVM_NEON
+	static const Kernels kernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	static const Kernels kernelsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	static const Kernels kernelsAVX2;
+#endif
+
+	/**
+	 * Multipliers for the chroma offsets, with 15 fractional bits. Applied to
+	 * the absolute chroma value they give exactly the truncated values
+	 * stored in the colour table. The high half of the product of the
+	 * doubled value and the multiplier drops the fraction.
+	 */
+	enum {
+		kCrToR = 45901,
+		kCrToG = 23386,
+		kCbToG = 11283,
+		kCbToB = 58110,
+		/** Multiplier giving (c - 16) * 255 / 219 from the doubled (c - 16) */
+		kITUScale = 38155
+	};
+
+	/** Whether the SIMD kernels can write pixels of this format */
+	static bool isSupported(const Graphics::PixelFormat &format);
+
+	template<typename PixelInt>
+	static inline void putPixel(byte *dst, byte y, byte u, byte v, const RowArgs &args) {
+		const int16 *colorTab = args.colorTab;
+		const uint32 *L = &args.rgbToPix[y];
+		*((PixelInt *)dst) = L[colorTab[v]] | L[colorTab[256 + v] + colorTab[512 + u]] | L[colorTab[768 + u]];
+	}
+
 private:
 	friend class Common::Singleton<SingletonBaseType>;
+	friend class ::YUVToRGBTestSuite;
 	YUVToRGBManager();
 	~YUVToRGBManager();
 
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale, bool alphaMode = false);
+	void getRowArgs(RowArgs &args, const YUVToRGBLookup *lookup);
+
+	/** The selected SIMD kernels, or nullptr to use the lookup tables only */
+	static const Kernels *kernels;
+	static bool kernelsSelected;
+	static const Kernels *getKernels();
 
 	YUVToRGBLookup *_lookup;
 	int16 _colorTab[4 * 256]; // 2048 bytes
@@ -31,6 +31,7 @@ DECLARE_SINGLETON(GUI::EventRecorder);
 #include "common/debug-channels.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/mixer/mixer.h"
+#include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/md5.h"
 #include "gui/gui-manager.h"
@@ -57,6 +58,10 @@ EventRecorder::EventRecorder() {
 	_needRedraw = false;
 	_processingMillis = false;
 	_fastPlayback = false;
+	_benchmark = false;
+	_benchmarkStart = 0;
+	_lastFrameTime = 0;
+	_benchmarkReplayStart = 0;
 	_lastTimeDate.tm_sec = 0;
 	_lastTimeDate.tm_min = 0;
 	_lastTimeDate.tm_hour = 0;
@@ -89,6 +94,7 @@ void EventRecorder::deinit() {
 		return;
 	}
 	setFileHeader();
+	reportBenchmark();
 	_needRedraw = false;
 	_initialized = false;
 	_recordMode = kPassthrough;
@@ -161,7 +167,7 @@ void EventRecorder::processTimeAndDate(TimeDate &td, bool skipRecord) {
 			_recordFile->writeEvent(timeDateEvent);
 		}
 
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextPlaybackEvent();
 	}
 	if (_recordMode == kRecorderPlaybackPause)
 		td = _lastTimeDate;
@@ -218,7 +224,7 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 			_recordFile->writeEvent(timerEvent);
 		}
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextPlaybackEvent();
 		_timerManager->handler();
 		_controlPanel->setReplayedTime(_fakeTimer);
 		_processingMillis = false;
@@ -244,6 +250,13 @@ void EventRecorder::processScreenUpdate() {
 		return;
 	}
 
+	if (_benchmark && _recordMode == kRecorderPlayback) {
+		const uint64 now = g_system->getMicros();
+		if (_lastFrameTime)
+			_frameTimes.push_back((uint32)MIN<uint64>(now - _lastFrameTime, 0xFFFFFFFF));
+		_lastFrameTime = now;
+	}
+
 	Common::RecorderEvent screenUpdateEvent;
 	switch (_recordMode) {
 	case kRecorderRecord:
@@ -260,7 +273,7 @@ void EventRecorder::processScreenUpdate() {
 		if (_nextEvent.recordedtype != Common::kRecorderEventTypeScreenUpdate) {
 			int numSkipped = 0;
 			while (true) {
-				_nextEvent = _playbackFile->getNextEvent();
+				_nextEvent = getNextPlaybackEvent();
 				numSkipped += 1;
 				if (_nextEvent.recordedtype == Common::kRecorderEventTypeScreenUpdate) {
 					warning("Skipped %d events to get to the next screen update at %d", numSkipped, _nextEvent.time);
@@ -271,7 +284,7 @@ void EventRecorder::processScreenUpdate() {
 		_processingMillis = true;
 		_fakeTimer = _nextEvent.time;
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextPlaybackEvent();
 		if (_recordMode == kRecorderUpdate) {
 			// write event to the updated file and update screenshot if necessary
 			screenUpdateEvent.recordedtype = Common::kRecorderEventTypeScreenUpdate;
@@ -308,7 +321,7 @@ bool EventRecorder::pollEvent(Common::Event &ev) {
 	}
 
 	ev = _nextEvent;
-	_nextEvent = _playbackFile->getNextEvent();
+	_nextEvent = getNextPlaybackEvent();
 	switch (ev.type) {
 	case Common::EVENT_MOUSEMOVE:
 	case Common::EVENT_LBUTTONDOWN:
@@ -380,7 +393,43 @@ Common::String EventRecorder::generateRecordFileName(const Common::String &targe
 }
 
 
-void EventRecorder::init(const Common::String &recordFileName, RecordMode mode) {
+Common::RecorderEvent EventRecorder::getNextPlaybackEvent() {
+	// Reading past the end of the recording quits, report before that
+	if (!_playbackFile->hasNextEvent())
+		reportBenchmark();
+
+	return _playbackFile->getNextEvent();
+}
+
+void EventRecorder::reportBenchmark() {
+	if (!_benchmark)
+		return;
+	_benchmark = false;
+
+	const uint64 totalTime = g_system->getMicros() - _benchmarkStart;
+	const uint32 replayedTime = _fakeTimer - _benchmarkReplayStart;
+	const uint frames = _frameTimes.size();
+	if (frames == 0) {
+		debug("benchmark:frames=0 real_ms=%u replayed_ms=%u", (uint)(totalTime / 1000), replayedTime);
+		return;
+	}
+
+	uint64 frameSum = 0;
+	for (uint i = 0; i < frames; i++)
+		frameSum += _frameTimes[i];
+
+	Common::sort(_frameTimes.begin(), _frameTimes.end());
+	debug("benchmark:frames=%u real_ms=%u replayed_ms=%u speedup=%.2f fps=%.1f avg_ms=%.3f min_ms=%.3f median_ms=%.3f p95_ms=%.3f p99_ms=%.3f max_ms=%.3f",
+		frames, (uint)(totalTime / 1000), replayedTime, totalTime ? replayedTime * 1000.0 / totalTime : 0.0,
+		frameSum ? frames * 1000000.0 / frameSum : 0.0, frameSum / 1000.0 / frames,
+		_frameTimes[0] / 1000.0, _frameTimes[frames / 2] / 1000.0,
+		_frameTimes[frames * 95 / 100] / 1000.0, _frameTimes[frames * 99 / 100] / 1000.0,
+		_frameTimes[frames - 1] / 1000.0);
+
+	_frameTimes.clear();
+}
+
+void EventRecorder::init(const Common::String &recordFileName, RecordMode mode, bool benchmark) {
 	_fakeMixerManager = new NullMixerManager();
 	_fakeMixerManager->init();
 	_fakeMixerManager->suspendAudio();
@@ -415,7 +464,7 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	}
 	if ((_recordMode == kRecorderPlayback) || (_recordMode == kRecorderUpdate)) {
 		applyPlaybackSettings();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextPlaybackEvent();
 	}
 	if ((_recordMode == kRecorderRecord) || (_recordMode == kRecorderUpdate)) {
 		getConfig();
@@ -425,6 +474,16 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	switchTimerManagers();
 	_needRedraw = true;
 	_initialized = true;
+
+	if (benchmark && _recordMode == kRecorderPlayback) {
+		// Replay as fast as possible and measure the time of each frame
+		_benchmark = true;
+		_fastPlayback = true;
+		_frameTimes.clear();
+		_lastFrameTime = 0;
+		_benchmarkReplayStart = _fakeTimer;
+		_benchmarkStart = g_system->getMicros();
+	}
 }
 
 
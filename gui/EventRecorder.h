@@ -77,7 +77,13 @@ public:
 		kRecorderUpdate = 4			/**< kRecorderUpdate, playback existing recording and update all hashes */
 	};
 
-	void init(const Common::String &recordFileName, RecordMode mode);
+	/**
+	 * Start recording or playing back.
+	 *
+	 * @param benchmark  For playback, replay the recording as fast as possible
+	 *                   and report statistics about the frame times at its end.
+	 */
+	void init(const Common::String &recordFileName, RecordMode mode, bool benchmark = false);
 	void deinit();
 	bool processDelayMillis();
 	uint32 getRandomSeed(const Common::String &name);
@@ -228,6 +234,12 @@ private:
 	bool checkGameHash(const ADGameDescription *desc);
 
 	void checkForKeyCode(const Common::Event &event);
+
+	/** Read the next event of the recording being played back. */
+	Common::RecorderEvent getNextPlaybackEvent();
+	/** Print the statistics of a benchmark run, if this is one. */
+	void reportBenchmark();
+
 	/**
 	 * @return false because we don't want to remap the given event again. This already happened on
 	 * recording the event. We record the custom events already, not the raw backend events.
@@ -247,6 +259,11 @@ private:
 	volatile RecordMode _recordMode;
 	Common::String _recordFileName;
 	bool _fastPlayback;
+	bool _benchmark;
+	uint64 _benchmarkStart;
+	uint64 _lastFrameTime;
+	uint32 _benchmarkReplayStart;
+	Common::Array<uint32> _frameTimes;	/**< Real time of each replayed frame, in microseconds */
 	bool _needRedraw;
 	bool _processingMillis;
 };
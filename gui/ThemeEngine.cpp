@@ -96,6 +96,35 @@ struct WidgetDrawData {
 	void calcBackgroundOffset();
 };
 
+/**
+ * Result of drawing a DrawData descriptor, together with the pixels it was
+ * drawn on top of.
+ */
+struct CachedDrawData {
+	DrawData _type;
+	int16 _width, _height;
+	uint32 _dynamic;
+
+	Graphics::VectorRenderer::ColorState _colorsBefore;
+	Graphics::VectorRenderer::ColorState _colorsAfter;
+
+	Graphics::Surface _background;
+	Graphics::Surface _result;
+
+	~CachedDrawData() {
+		_background.free();
+		_result.free();
+	}
+
+	uint32 getSize() const {
+		return 2 * _result.h * _result.pitch;
+	}
+};
+
+enum {
+	kDrawDataCacheMaxSize = 8 * 1024 * 1024 ///< Maximum size in bytes of all the pre-rendered DrawData results
+};
+
 /**********************************************************
  *  Data definitions for theme engine elements
  *********************************************************/
@@ -189,7 +218,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(nullptr), _vectorRenderer(nullptr),
 	_layerToDraw(kDrawLayerBackground), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
 	_font(nullptr), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
-	_cursor(nullptr), _scaleFactor(1.0f) {
+	_cursor(nullptr), _scaleFactor(1.0f), _drawDataCacheSize(0) {
 
 	_baseWidth = 640;	// Default sane values
 	_baseHeight = 480;
@@ -303,6 +332,8 @@ const char *ThemeEngine::findModeConfigName(GraphicsMode mode) {
 
 
 void ThemeEngine::setBaseResolution(int w, int h, float s) {
+	clearDrawDataCache();
+
 	_baseWidth = w;
 	_baseHeight = h;
 	_scaleFactor = s;
@@ -454,6 +485,8 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_screen.free();
 	_screen.create(width, height, _overlayFormat);
 
+	clearDrawDataCache();
+
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
@@ -498,6 +531,8 @@ void ThemeEngine::restoreBackground(Common::Rect r) {
  * Theme elements management
  *********************************************************/
 void ThemeEngine::addDrawStep(const Common::String &drawDataId, const Graphics::DrawStep &step) {
+	clearDrawDataCache();
+
 	DrawData id = parseDrawDataId(drawDataId);
 
 	assert(id != kDDNone && _widgets[id] != nullptr);
@@ -639,6 +674,16 @@ bool ThemeEngine::addTextColor(TextColor colorId, int r, int g, int b) {
 	return true;
 }
 
+#ifdef USE_PNG
+static void copyPNGRow(const Graphics::Surface &row, int y, int height, void *refCon) {
+	Graphics::ManagedSurface *surf = (Graphics::ManagedSurface *)refCon;
+	if (y == 0)
+		surf->create(row.w, height, row.format);
+
+	surf->copyRectToSurface(row, 0, y, Common::Rect(row.w, 1));
+}
+#endif
+
 bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String &scalablefile, int width, int height) {
 	// Nothing has to be done if the bitmap already has been loaded.
 	Graphics::ManagedSurface *surf = _bitmaps[filename];
@@ -647,13 +692,48 @@ bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String
 	}
 
 	if (!scalablefile.empty()) {
+		const int renderWidth = width * _scaleFactor;
+		const int renderHeight = height * _scaleFactor;
+		const Common::String cacheName = _themeId + "/" + scalablefile;
+		const Common::String cacheFilename = genCacheFilename(scalablefile, Common::String::format("%dx%d.scc", renderWidth, renderHeight));
+
+		// Prefer an earlier rasterization, from memory or from a cache file
+		surf = Graphics::SVGBitmap::createFromCache(cacheName, renderWidth, renderHeight);
+		if (!surf && !cacheFilename.empty()) {
+			Common::ArchiveMemberList cacheMembers;
+			_themeFiles.listMatchingMembers(cacheMembers, Common::Path(cacheFilename, '/'));
+			for (Common::ArchiveMemberList::const_iterator i = cacheMembers.begin(), end = cacheMembers.end(); i != end && !surf; ++i) {
+				Common::SeekableReadStream *stream = (*i)->createReadStream();
+				if (stream) {
+					surf = Graphics::SVGBitmap::loadCacheFile(*stream, renderWidth, renderHeight);
+					delete stream;
+				}
+			}
+
+			if (surf)
+				Graphics::SVGBitmap::addToCache(cacheName, *surf);
+		}
+
+		if (surf) {
+			_bitmaps[filename] = surf;
+			return true;
+		}
+
 		Common::ArchiveMemberList members;
 		_themeFiles.listMatchingMembers(members, Common::Path(scalablefile, '/'));
 		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
 			Common::SeekableReadStream *stream = (*i)->createReadStream();
 			if (stream) {
-				_bitmaps[filename] = new Graphics::SVGBitmap(stream, width * _scaleFactor, height * _scaleFactor);
+				surf = new Graphics::SVGBitmap(stream, renderWidth, renderHeight);
 				delete stream;
+
+				Graphics::SVGBitmap::addToCache(cacheName, *surf);
+				if (!cacheFilename.empty() && ConfMan.getBool("gui_svg_cache_files")) {
+					if (!Graphics::SVGBitmap::saveCacheFile(*surf, Common::Path(cacheFilename, '/')))
+						warning("Couldn't create cache file for image '%s'", scalablefile.c_str());
+				}
+
+				_bitmaps[filename] = surf;
 				return true;
 			}
 		}
@@ -667,11 +747,23 @@ bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String
 		// Maybe it is PNG?
 #ifdef USE_PNG
 		Image::PNGDecoder decoder;
+		// When the decoder can output the overlay format, the rows are
+		// copied straight into our surface
+		const bool decodeRows = decoder.setOutputPixelFormat(_overlayFormat);
 		Common::ArchiveMemberList members;
 		_themeFiles.listMatchingMembers(members, Common::Path(filename, '/'));
 		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
 			Common::SeekableReadStream *stream = (*i)->createReadStream();
 			if (stream) {
+				if (decodeRows) {
+					surf = new Graphics::ManagedSurface();
+					if (!decoder.loadStreamRows(*stream, copyPNGRow, surf))
+						error("Error decoding PNG");
+
+					delete stream;
+					break;
+				}
+
 				if (!decoder.loadStream(*stream))
 					error("Error decoding PNG");
 
@@ -778,6 +870,8 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 }
 
 void ThemeEngine::unloadTheme() {
+	clearDrawDataCache();
+
 	if (!_themeOk)
 		return;
 
@@ -927,7 +1021,15 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		extendedRect.bottom += drawData->_shadowOffset - drawData->_backgroundOffset;
 	}
 
+	// Only elements which are drawn completely, and far enough from the
+	// screen edges not to have their shadows cut, are drawn the same way
+	// at any position.
+	Common::Rect safeRect = extendedRect;
+	safeRect.grow(kDirtyRectangleThreshold);
+	bool cacheable = area == r && Common::Rect(_screen.w, _screen.h).contains(safeRect);
+
 	if (!_clip.isEmpty()) {
+		cacheable = cacheable && _clip.contains(extendedRect);
 		extendedRect.clip(_clip);
 	}
 
@@ -940,15 +1042,86 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
-			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
-		}
+		drawDDSteps(type, drawData, area, extendedRect, dynamic, cacheable);
 
 		addDirtyRect(extendedRect);
 	}
 }
 
+void ThemeEngine::drawDDSteps(DrawData type, const WidgetDrawData *drawData, const Common::Rect &area,
+                              const Common::Rect &extendedRect, uint32 dynamic, bool cacheable) {
+	Graphics::Surface *surface = _vectorRenderer->getActiveSurface()->surfacePtr();
+	const uint32 size = 2 * extendedRect.width() * extendedRect.height() * surface->format.bytesPerPixel;
+	if (size > kDrawDataCacheMaxSize / 4)
+		cacheable = false;
+
+	Graphics::Surface dst;
+	Graphics::VectorRenderer::ColorState colors;
+	if (cacheable) {
+		dst = surface->getSubArea(extendedRect);
+		colors = _vectorRenderer->getColorState();
+
+		const uint rowSize = dst.w * dst.format.bytesPerPixel;
+		for (Common::List<CachedDrawData *>::iterator i = _drawDataCache.begin(); i != _drawDataCache.end(); ++i) {
+			CachedDrawData *cached = *i;
+			if (cached->_type != type || cached->_width != area.width() || cached->_height != area.height() ||
+			    cached->_dynamic != dynamic || !(cached->_colorsBefore == colors))
+				continue;
+
+			bool sameBackground = true;
+			for (int y = 0; y < dst.h && sameBackground; ++y)
+				sameBackground = !memcmp(dst.getBasePtr(0, y), cached->_background.getBasePtr(0, y), rowSize);
+			if (!sameBackground)
+				continue;
+
+			dst.copyRectToSurface(cached->_result, 0, 0, Common::Rect(cached->_result.w, cached->_result.h));
+			_vectorRenderer->setColorState(cached->_colorsAfter);
+
+			_drawDataCache.erase(i);
+			_drawDataCache.push_front(cached);
+			return;
+		}
+	}
+
+	CachedDrawData *cached = nullptr;
+	if (cacheable) {
+		cached = new CachedDrawData();
+		cached->_type = type;
+		cached->_width = area.width();
+		cached->_height = area.height();
+		cached->_dynamic = dynamic;
+		cached->_colorsBefore = colors;
+		cached->_background.copyFrom(dst);
+	}
+
+	Common::List<Graphics::DrawStep>::const_iterator step;
+	for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+		_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+	}
+
+	if (!cached)
+		return;
+
+	cached->_colorsAfter = _vectorRenderer->getColorState();
+	cached->_result.copyFrom(dst);
+
+	while (!_drawDataCache.empty() && _drawDataCacheSize + cached->getSize() > kDrawDataCacheMaxSize) {
+		_drawDataCacheSize -= _drawDataCache.back()->getSize();
+		delete _drawDataCache.back();
+		_drawDataCache.pop_back();
+	}
+
+	_drawDataCache.push_front(cached);
+	_drawDataCacheSize += cached->getSize();
+}
+
+void ThemeEngine::clearDrawDataCache() {
+	for (Common::List<CachedDrawData *>::iterator i = _drawDataCache.begin(); i != _drawDataCache.end(); ++i)
+		delete *i;
+	_drawDataCache.clear();
+	_drawDataCacheSize = 0;
+}
+
 void ThemeEngine::drawDDText(TextData type, TextColor color, const Common::Rect &r, const Common::U32String &text,
 	bool restoreBg, bool ellipsis, Graphics::TextAlign alignH, TextAlignVertical alignV,
 	int deltax, const Common::Rect &drawableTextArea) {
@@ -1813,7 +1986,7 @@ const Graphics::Font *ThemeEngine::loadFont(const Common::String &filename, cons
 	return font;
 }
 
-Common::String ThemeEngine::genCacheFilename(const Common::String &filename) const {
+Common::String ThemeEngine::genCacheFilename(const Common::String &filename, const Common::String &extension) const {
 	Common::String cacheName(filename);
 	for (int i = cacheName.size() - 1; i >= 0; --i) {
 		if (cacheName[i] == '.') {
@@ -1821,7 +1994,7 @@ Common::String ThemeEngine::genCacheFilename(const Common::String &filename) con
 				cacheName.deleteLastChar();
 			}
 
-			cacheName += "fcc";
+			cacheName += extension;
 			return cacheName;
 		}
 	}
@@ -48,6 +48,7 @@ class VectorRenderer;
 namespace GUI {
 
 struct WidgetDrawData;
+struct CachedDrawData;
 struct TextDrawData;
 class Dialog;
 class GuiObject;
@@ -517,6 +518,9 @@ public:
 	 */
 	void addDirtyRect(Common::Rect r);
 
+	/** Returns whether anything was drawn since the screen was last updated. */
+	bool isScreenDirty() const { return !_dirtyScreen.empty(); }
+
 
 	/**
 	 * Returns the DrawData enumeration value that represents the given string
@@ -695,7 +699,11 @@ protected:
 
 	const Graphics::Font *loadScalableFont(const Common::String &filename, const int pointsize, Common::String &name);
 	const Graphics::Font *loadFont(const Common::String &filename, Common::String &name);
-	Common::String genCacheFilename(const Common::String &filename) const;
+	/**
+	 * Generate the name of the cache file of a theme file, by replacing its
+	 * extension.
+	 */
+	Common::String genCacheFilename(const Common::String &filename, const Common::String &extension = "fcc") const;
 	const Graphics::Font *loadFont(const Common::String &filename, const Common::String &scalableFilename, const int pointsize, const bool makeLocalizedFont);
 
 	/**
@@ -718,6 +726,20 @@ protected:
 	                TextAlignVertical alignV = kTextAlignVTop, int deltax = 0,
 	                const Common::Rect &drawableTextArea = Common::Rect(0, 0, 0, 0));
 
+	/**
+	 * Draws the steps of a DrawData descriptor, reusing the pixels of an
+	 * earlier identical draw when possible.
+	 *
+	 * A draw is identical when it has the same type, size, dynamic data and
+	 * renderer colors, and when the pixels below it are the same, so the
+	 * cached result is exactly what the steps would produce.
+	 */
+	void drawDDSteps(DrawData type, const WidgetDrawData *drawData, const Common::Rect &area,
+	                 const Common::Rect &extendedRect, uint32 dynamic, bool cacheable);
+
+	/** Drops all the pre-rendered DrawData results. */
+	void clearDrawDataCache();
+
 	/**
 	 * DEBUG: Draws a white square and writes some text next to it.
 	 */
@@ -788,6 +810,10 @@ protected:
 	 */
 	WidgetDrawData *_widgets[kDrawDataMAX];
 
+	/** Recently drawn DrawData results, most recently used first. */
+	Common::List<CachedDrawData *> _drawDataCache;
+	uint32 _drawDataCacheSize; ///< Size in bytes of all the cached surfaces
+
 	/** Array of all the text fonts that can be drawn. */
 	TextDrawData *_texts[kTextDataMAX];
 
@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/memusage.h"
 #include "common/system.h"
 
 #ifndef DISABLE_MD5
@@ -36,6 +37,8 @@
 
 #include "engines/engine.h"
 
+#include "audio/mixer.h"
+
 #include "gui/debugger.h"
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 	#include "gui/console.h"
@@ -81,6 +84,9 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+
+	registerCmd("mixer_stats",		WRAP_METHOD(Debugger, cmdMixerStats));
+	registerCmd("mem_usage",		WRAP_METHOD(Debugger, cmdMemUsage));
 }
 
 Debugger::~Debugger() {
@@ -841,6 +847,122 @@ bool Debugger::cmdExecFile(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdMixerStats(int argc, const char **argv) {
+	Audio::Mixer *mixer = g_system->getMixer();
+	if (!mixer) {
+		debugPrintf("There is no mixer\n");
+		return true;
+	}
+
+	bool osd = false;
+	if (argc > 1) {
+		if (!strcmp(argv[1], "on")) {
+			mixer->resetStats();
+			mixer->setProfiling(true);
+			debugPrintf("Mixer profiling enabled\n");
+			return true;
+		} else if (!strcmp(argv[1], "off")) {
+			mixer->setProfiling(false);
+			debugPrintf("Mixer profiling disabled\n");
+			return true;
+		} else if (!strcmp(argv[1], "reset")) {
+			mixer->resetStats();
+			debugPrintf("Mixer profiling counters reset\n");
+			return true;
+		} else if (!strcmp(argv[1], "osd")) {
+			osd = true;
+		} else {
+			debugPrintf("Usage: %s [on|off|reset|osd]\n", argv[0]);
+			return true;
+		}
+	}
+
+	if (!mixer->isProfiling()) {
+		debugPrintf("Mixer profiling is disabled, use '%s on' to enable it\n", argv[0]);
+		return true;
+	}
+
+	Audio::Mixer::Stats stats;
+	mixer->getStats(stats);
+
+	const uint32 average = stats.callbacks ? (uint32)(stats.callbackMicros / stats.callbacks) : 0;
+	const Common::String summary = Common::String::format("Mixer: %u callbacks, %u us average, %u us max, %u underruns",
+		stats.callbacks, average, stats.maxCallbackMicros, stats.underruns);
+
+	if (osd) {
+		// Show the summary over the game screen once the debugger is closed
+		g_system->displayMessageOnOSD(Common::U32String(summary));
+		return true;
+	}
+
+	debugPrintf("%s\n", summary.c_str());
+	debugPrintf("Callback time relative to the audio produced:\n");
+	static const char *const bucketNames[Audio::Mixer::Stats::kHistogramBuckets] = {
+		"< 10%", "< 25%", "< 50%", "< 75%", "< 100%", ">= 100%"
+	};
+	for (int i = 0; i < Audio::Mixer::Stats::kHistogramBuckets; i++)
+		debugPrintf("  %-8s %u\n", bucketNames[i], stats.histogram[i]);
+
+	static const char *const typeNames[] = { "plain", "music", "sfx", "speech" };
+	debugPrintf("Time per sound type:\n");
+	for (int i = 0; i < ARRAYSIZE(typeNames); i++)
+		debugPrintf("  %-8s %u ms\n", typeNames[i], (uint32)(stats.typeMicros[i] / 1000));
+
+	debugPrintf("Channels:\n");
+	if (stats.channels.empty())
+		debugPrintf("  none\n");
+	for (uint i = 0; i < stats.channels.size(); i++) {
+		const Audio::Mixer::ChannelStats &channel = stats.channels[i];
+		const uint32 channelAverage = channel.mixCalls ? (uint32)(channel.mixMicros / channel.mixCalls) : 0;
+		debugPrintf("  id %d, %s, %u Hz %s: %u calls, %u us average, %u ms total, %u starved\n",
+			channel.id, typeNames[channel.type], channel.rate, channel.stereo ? "stereo" : "mono",
+			channel.mixCalls, channelAverage, (uint32)(channel.mixMicros / 1000), channel.starved);
+	}
+
+	return true;
+}
+
+bool Debugger::cmdMemUsage(int argc, const char **argv) {
+	bool osd = false;
+	if (argc > 1) {
+		if (!strcmp(argv[1], "reset")) {
+			MemUsageMan.resetPeaks();
+			debugPrintf("Memory usage peaks reset\n");
+			return true;
+		} else if (!strcmp(argv[1], "osd")) {
+			osd = true;
+		} else {
+			debugPrintf("Usage: %s [reset|osd]\n", argv[0]);
+			return true;
+		}
+	}
+
+	Common::Array<Common::MemoryUsage::Entry> entries;
+	MemUsageMan.getEntries(entries);
+
+	const Common::String summary = Common::String::format("Memory: %s in %u counters",
+		Common::MemoryUsage::formatSize(MemUsageMan.getTotal()).c_str(), entries.size());
+
+	if (osd) {
+		// Show the summary over the game screen once the debugger is closed
+		g_system->displayMessageOnOSD(Common::U32String(summary));
+		return true;
+	}
+
+	debugPrintf("%s\n", summary.c_str());
+	for (uint i = 0; i < entries.size(); i++) {
+		const Common::MemoryUsage::Entry &entry = entries[i];
+		debugPrintf("  %-32s %12s, peak %12s", entry.name,
+			Common::MemoryUsage::formatSize(entry.bytes).c_str(),
+			Common::MemoryUsage::formatSize(entry.peak).c_str());
+		if (entry.counters > 1)
+			debugPrintf(" (%u instances)", entry.counters);
+		debugPrintf("\n");
+	}
+
+	return true;
+}
+
 bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("debugflag_disable [<flag> | all]\n");
@@ -38,6 +38,7 @@
 
 #include "graphics/cursorman.h"
 #include "graphics/macgui/macwindowmanager.h"
+#include "graphics/svg.h"
 
 namespace Common {
 DECLARE_SINGLETON(GUI::GuiManager);
@@ -49,12 +50,14 @@ enum {
 	kDoubleClickDelay = 500, // milliseconds
 	kCursorAnimateDelay = 250,
 	kTooltipDelay = 1250,
-	kTooltipSameWidgetDelay = 7000
+	kTooltipSameWidgetDelay = 7000,
+	kIdleDelay = 1000, // without events or drawing, before the frames get longer
+	kIdleFrameDuration = 50
 };
 
 // Constructor
 GuiManager::GuiManager() : CommandSender(nullptr), _redrawStatus(kRedrawDisabled), _stateIsSaved(false),
-	_cursorAnimateCounter(0), _cursorAnimateTimer(0) {
+	_cursorAnimateCounter(0), _cursorAnimateTimer(0), _lastActivityTime(0) {
 	_theme = nullptr;
 	_useStdCursor = false;
 
@@ -106,6 +109,8 @@ GuiManager::GuiManager() : CommandSender(nullptr), _redrawStatus(kRedrawDisabled
 GuiManager::~GuiManager() {
 	delete _theme;
 	delete _wm;
+
+	Graphics::SVGBitmap::clearCache();
 }
 
 void GuiManager::initIconsSet() {
@@ -114,6 +119,9 @@ void GuiManager::initIconsSet() {
 	_iconsSet.clear();
 
 	_iconsSetChanged = Common::generateZipSet(_iconsSet, "gui-icons.dat", "gui-icons*.dat");
+
+	// The cached images may come from the previous set
+	Graphics::SVGBitmap::clearCache();
 }
 
 void GuiManager::computeScaleFactor() {
@@ -482,6 +490,8 @@ void GuiManager::redraw() {
 		redrawInternal();
 	}
 
+	if (_theme->isScreenDirty())
+		_lastActivityTime = _system->getMillis(true);
 	_theme->updateScreen();
 	_redrawStatus = kRedrawDisabled;
 }
@@ -561,6 +571,8 @@ void GuiManager::runLoop() {
 		Common::Event event;
 
 		while (eventMan->pollEvent(event)) {
+			_lastActivityTime = frameStartTime;
+
 			// We will need to check whether the screen changed while polling
 			// for an event here. While we do send EVENT_SCREEN_CHANGED
 			// whenever this happens we still cannot be sure that we get such
@@ -655,13 +667,21 @@ void GuiManager::runLoop() {
 		redraw();
 
 		// Delay until the allocated frame time is elapsed to match the target frame rate.
+		// When nothing happened for a while, the frames get longer so that an idle GUI doesn't
+		// keep the CPU busy, but any input wakes it up early.
 		// In case we have vsync enabled, we should rely on vsync to do take care about frame times.
 		// With vsync enabled, we currently have to force a frame time of 1ms since otherwise
 		// CPU usage will skyrocket on one thread as soon as no updateScreen(); calls happening.
-		if (g_system->getFeatureState(OSystem::kFeatureVSync)) {
+		uint32 frameEndTime = _system->getMillis(true);
+		if (frameEndTime - _lastActivityTime > (uint32)kIdleDelay) {
+			uint32 actualFrameDuration = frameEndTime - frameStartTime;
+			if (actualFrameDuration < (uint32)kIdleFrameDuration) {
+				_system->waitForEvent(kIdleFrameDuration - actualFrameDuration);
+			}
+		} else if (g_system->getFeatureState(OSystem::kFeatureVSync)) {
 			_system->delayMillis(1);
 		} else {
-			uint32 actualFrameDuration = _system->getMillis(true) - frameStartTime;
+			uint32 actualFrameDuration = frameEndTime - frameStartTime;
 			if (actualFrameDuration < targetFrameDuration) {
 				_system->delayMillis(targetFrameDuration - actualFrameDuration);
 			}
@@ -215,6 +215,9 @@ protected:
 	uint32	_cursorAnimateTimer;
 	byte	_cursor[2048];
 
+	// time of the last event or drawing, to slow down when idle
+	uint32	_lastActivityTime;
+
 	// delayed deletion of GuiObject
 	struct GuiObjectTrashItem {
 		GuiObject* object;
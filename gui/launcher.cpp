@@ -1002,6 +1002,8 @@ public:
 
 	LauncherDisplayType getType() const override { return kLauncherDisplayGrid; }
 
+	void handleTickle() override;
+
 protected:
 	void updateListing() override;
 	void groupEntries(const Common::Array<LauncherEntry> &metadata);
@@ -1571,13 +1573,13 @@ void LauncherGrid::updateListing() {
 		Common::String platform;
 		Common::String extra;
 		Common::String path;
-		bool valid_path = false;
 		iter->domain->tryGetVal("engineid", engineid);
 		iter->domain->tryGetVal("language", language);
 		iter->domain->tryGetVal("platform", platform);
 		iter->domain->tryGetVal("extra", extra);
-		valid_path = (!iter->domain->tryGetVal("path", path) || !Common::FSNode(Common::Path::fromConfig(path)).isDirectory()) ? false : true;
-		gridList.push_back(GridItemInfo(k++, engineid, gameid, iter->description, iter->title, extra, Common::parseLanguage(language), Common::parsePlatform(platform), valid_path));
+		iter->domain->tryGetVal("path", path);
+		// The game path is checked by the grid once the entry becomes visible
+		gridList.push_back(GridItemInfo(k++, engineid, gameid, iter->description, iter->title, extra, Common::parseLanguage(language), Common::parsePlatform(platform), path));
 		_domains.push_back(iter->key);
 	}
 
@@ -1596,6 +1598,12 @@ void LauncherGrid::updateListing() {
 	_grid->loadClosedGroups(Common::U32String(groupingModes[_groupBy].name));
 }
 
+void LauncherGrid::handleTickle() {
+	_grid->handleTickle();
+
+	LauncherDialog::handleTickle();
+}
+
 void LauncherGrid::updateButtons() {
 	bool enable = (_grid->getSelected() >= 0);
 
@@ -899,6 +899,7 @@ void SaveLoadChooserGrid::handleMouseWheel(int x, int y, int direction) {
 
 void SaveLoadChooserGrid::updateSaveList() {
 	SaveLoadChooserDialog::updateSaveList();
+	_metaInfos.clear();
 	updateSaves();
 	g_gui.scheduleTopDialogRedraw();
 }
@@ -907,6 +908,7 @@ void SaveLoadChooserGrid::open() {
 	SaveLoadChooserDialog::open();
 
 	listSaves();
+	_metaInfos.clear();
 	_resultString.clear();
 
 	// Load information to restore the last page the user had open.
@@ -1083,6 +1085,37 @@ void SaveLoadChooserGrid::close() {
 
 	SaveLoadChooserDialog::close();
 	hideButtons();
+	_pendingMetaInfos.clear();
+	_metaInfos.clear();
+}
+
+void SaveLoadChooserGrid::handleTickle() {
+	loadPendingMetaInfos();
+
+	SaveLoadChooserDialog::handleTickle();
+}
+
+void SaveLoadChooserGrid::loadPendingMetaInfos() {
+	// Query as many saves as fit into a few milliseconds, so that the
+	// dialog stays responsive on slow storage.
+	const uint32 deadline = g_system->getMillis() + 10;
+
+	while (!_pendingMetaInfos.empty()) {
+		const uint i = _pendingMetaInfos.front();
+		_pendingMetaInfos.remove_at(0);
+
+		const int saveSlot = _saveList[i].getSaveSlot();
+		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot);
+		_metaInfos[saveSlot] = desc;
+		if (desc.getSaveSlot() >= 0 && !desc.getDescription().empty())
+			_saveList[i] = desc;
+
+		updateSlotButton(i - _curPage * _entriesPerPage, i, desc, true);
+		g_gui.scheduleTopDialogRedraw();
+
+		if (g_system->getMillis() >= deadline)
+			break;
+	}
 }
 
 int SaveLoadChooserGrid::runIntern() {
@@ -1133,6 +1166,7 @@ void SaveLoadChooserGrid::destroyButtons() {
 	}
 
 	_buttons.clear();
+	_pendingMetaInfos.clear();
 }
 
 void SaveLoadChooserGrid::hideButtons() {
@@ -1144,63 +1178,20 @@ void SaveLoadChooserGrid::hideButtons() {
 
 void SaveLoadChooserGrid::updateSaves() {
 	hideButtons();
-
-	bool isWriteProtected = false;
+	_pendingMetaInfos.clear();
 
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
-		const uint saveSlot = _saveList[i].getSaveSlot();
+		const int saveSlot = _saveList[i].getSaveSlot();
 
-		SaveStateDescriptor desc =  (_saveList[i].getLocked() ? _saveList[i] : _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot));
-		if (!_saveList[i].getLocked() && desc.getSaveSlot() >= 0 && !desc.getDescription().empty())
-			_saveList[i] = desc;
-		SlotButton &curButton = _buttons[curNum];
-		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
+		if (_saveList[i].getLocked()) {
+			updateSlotButton(curNum, i, _saveList[i], true);
+		} else if (_metaInfos.contains(saveSlot)) {
+			updateSlotButton(curNum, i, _metaInfos[saveSlot], true);
 		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+			// Show what listSaves() returned until the meta infos are loaded
+			updateSlotButton(curNum, i, _saveList[i], false);
+			_pendingMetaInfos.push_back(i);
 		}
-		curButton.description->setLabel(Common::U32String(Common::String::format("%d. ", saveSlot)) + _saveList[i].getDescription());
-
-		Common::U32String tooltip(_("Name: "));
-		tooltip += _saveList[i].getDescription();
-
-		if (_saveDateSupport) {
-			const Common::U32String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip +=  _("Date: ") + saveDate;
-			}
-
-			const Common::U32String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip += _("Time: ") + saveTime;
-			}
-		}
-
-		if (_playTimeSupport) {
-			const Common::U32String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip += _("Playtime: ") + playTime;
-			}
-		}
-
-		curButton.button->setTooltip(tooltip);
-
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		// We also disable and description the button if slot is locked
-		isWriteProtected = desc.getWriteProtectedFlag() ||
-			_saveList[i].getWriteProtectedFlag();
-		if ((_saveMode && isWriteProtected) || desc.getLocked()) {
-			curButton.button->setEnabled(false);
-		} else {
-			curButton.button->setEnabled(true);
-		}
-		curButton.description->setEnabled(!desc.getLocked());
 	}
 
 	const uint numPages = (_entriesPerPage != 0 && !_saveList.empty()) ? ((_saveList.size() + _entriesPerPage - 1) / _entriesPerPage) : 1;
@@ -1217,6 +1208,61 @@ void SaveLoadChooserGrid::updateSaves() {
 		_nextButton->setEnabled(false);
 }
 
+void SaveLoadChooserGrid::updateSlotButton(uint buttonNum, uint saveNum, const SaveStateDescriptor &desc, bool metaInfoLoaded) {
+	const int saveSlot = _saveList[saveNum].getSaveSlot();
+
+	SlotButton &curButton = _buttons[buttonNum];
+	curButton.setVisible(true);
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		curButton.button->setGfx(desc.getThumbnail());
+	} else {
+		curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	curButton.description->setLabel(Common::U32String(Common::String::format("%d. ", saveSlot)) + _saveList[saveNum].getDescription());
+
+	Common::U32String tooltip(_("Name: "));
+	tooltip += _saveList[saveNum].getDescription();
+
+	if (_saveDateSupport) {
+		const Common::U32String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip +=  _("Date: ") + saveDate;
+		}
+
+		const Common::U32String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
+
+	if (_playTimeSupport) {
+		const Common::U32String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip += _("Playtime: ") + playTime;
+		}
+	}
+
+	curButton.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected.
+	// TODO: Maybe we should not display it at all then?
+	// We also disable and description the button if slot is locked
+	// Until the meta infos are loaded we do not know whether the slot is
+	// write protected, so it cannot be overwritten yet.
+	const bool isWriteProtected = desc.getWriteProtectedFlag() ||
+		_saveList[saveNum].getWriteProtectedFlag() || !metaInfoLoaded;
+	if ((_saveMode && isWriteProtected) || desc.getLocked()) {
+		curButton.button->setEnabled(false);
+	} else {
+		curButton.button->setEnabled(true);
+	}
+	curButton.description->setEnabled(!desc.getLocked());
+}
+
 SavenameDialog::SavenameDialog()
 	: Dialog("SavenameDialog") {
 	_title = new StaticTextWidget(this, "SavenameDialog.DescriptionText", Common::String());
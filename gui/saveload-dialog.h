@@ -216,6 +216,8 @@ public:
 	SaveLoadChooserType getType() const override { return kSaveLoadDialogGrid; }
 
 	void close() override;
+
+	void handleTickle() override;
 protected:
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
 	void handleMouseWheel(int x, int y, int direction) override;
@@ -256,6 +258,15 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlotButton(uint buttonNum, uint saveNum, const SaveStateDescriptor &desc, bool metaInfoLoaded);
+
+	/**
+	 * Meta infos are queried from the engine while the dialog is idle,
+	 * since engines may need to open and decode every save for them.
+	 */
+	Common::HashMap<int, SaveStateDescriptor> _metaInfos; ///< Meta infos queried so far, by save slot
+	Common::Array<uint> _pendingMetaInfos;                ///< Entries of _saveList on the current page still to query
+	void loadPendingMetaInfos();
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
@@ -21,6 +21,7 @@
 
 #include "common/system.h"
 #include "common/file.h"
+#include "common/fs.h"
 #include "common/language.h"
 #include "common/platform.h"
 #include "common/tokenizer.h"
@@ -33,6 +34,11 @@
 
 namespace GUI {
 
+enum {
+	kThumbnailsPerTick = 4,                       ///< Thumbnails loaded at once while the launcher is idle
+	kMaxThumbnailCacheSize = 32 * 1024 * 1024     ///< Bytes of thumbnails kept around for entries which are not visible
+};
+
 GridItemWidget::GridItemWidget(GridWidget *boss)
 	: ContainerWidget(boss, 0, 0, 0, 0), CommandSender(boss) {
 
@@ -374,11 +380,17 @@ Graphics::ManagedSurface *loadSurfaceFromFile(const Common::String &name, int re
 		error("No PNG support compiled");
 #endif
 	} else if (name.hasSuffix(".svg")) {
+		const Common::String cacheName = "icons/" + name;
+		surf = Graphics::SVGBitmap::createFromCache(cacheName, renderWidth, renderHeight);
+		if (surf)
+			return surf;
+
 		g_gui.lockIconsSet();
 		if (g_gui.getIconsSet().hasFile(path)) {
 			Common::SeekableReadStream *stream = g_gui.getIconsSet().createReadStreamForMember(path);
 			surf = new Graphics::SVGBitmap(stream, renderWidth, renderHeight);
 			delete stream;
+			Graphics::SVGBitmap::addToCache(cacheName, *surf);
 		} else {
 			debug(5, "GridWidget: Cannot read file '%s'", name.c_str());
 		}
@@ -434,6 +446,7 @@ GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 
 	_selectedEntry = nullptr;
 	_isGridInvalid = true;
+	_thumbnailsPending = false;
 }
 
 GridWidget::~GridWidget() {
@@ -447,6 +460,7 @@ GridWidget::~GridWidget() {
 	_headerEntryList.clear();
 	_sortedEntryList.clear();
 	_visibleEntryList.clear();
+	_searchIndex.clear();
 }
 
 template<typename T>
@@ -493,8 +507,15 @@ void GridWidget::setEntryList(Common::Array<GridItemInfo> *list) {
 	_isGridInvalid = true;
 	_selectedEntry = nullptr;
 
+	_searchIndex.clear();
+	_dataEntryList.reserve(list->size());
+	_searchIndex.reserve(list->size());
 	for (Common::Array<GridItemInfo>::iterator entryIter = list->begin(); entryIter != list->end(); ++entryIter) {
 		_dataEntryList.push_back(*entryIter);
+
+		Common::U32String title(entryIter->title);
+		title.toLowercase();
+		_searchIndex.push_back(title);
 	}
 	// TODO: Remove this below, add drawWidget(), that should do the drawing
 	if (!_gridItems.empty()) {
@@ -573,14 +594,12 @@ void GridWidget::sortGroups() {
 		// as substrings, ignoring case.
 
 		Common::U32StringTokenizer tok(_filter);
-		Common::U32String tmp;
 		int n = 0;
 
 		_sortedEntryList.clear();
 
 		for (GridItemInfo *i = _dataEntryList.begin(); i != _dataEntryList.end(); ++i, ++n) {
-			tmp = i->title;
-			tmp.toLowercase();
+			const Common::U32String &tmp = _searchIndex[n];
 			bool matches = true;
 			tok.reset();
 			while (!tok.empty()) {
@@ -681,42 +700,89 @@ void GridWidget::setGroupHeaderFormat(const Common::U32String &prefix, const Com
 }
 
 void GridWidget::reloadThumbnails() {
+	// Only the first few thumbnails are loaded right away, the rest follows
+	// in handleTickle() so that opening and scrolling the grid stays fast.
+	trimThumbnails();
+	_thumbnailsPending = loadPendingThumbnails(kThumbnailsPerTick);
+}
+
+bool GridWidget::loadPendingThumbnails(uint maxCount) {
+	for (uint k = 0; k < _visibleEntryList.size(); ++k) {
+		const GridItemInfo *entry = _visibleEntryList[k];
+		if (entry->thumbPath.empty() || _loadedSurfaces.contains(entry->thumbPath))
+			continue;
+
+		if (!maxCount)
+			return true;
+		--maxCount;
+
+		if (loadThumbnail(entry) && k < _gridItems.size())
+			_gridItems[k]->update();
+	}
+	return false;
+}
+
+bool GridWidget::loadThumbnail(const GridItemInfo *entry) {
 	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
 	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
-	for (Common::Array<GridItemInfo *>::iterator iter = _visibleEntryList.begin(); iter != _visibleEntryList.end(); ++iter) {
-		GridItemInfo *entry = *iter;
-		if (entry->thumbPath.empty())
-			continue;
 
-		if (!_loadedSurfaces.contains(entry->thumbPath)) {
-			_loadedSurfaces[entry->thumbPath] = nullptr;
-			Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
-			Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
-			if (!surf) {
-				path = Common::String::format("icons/%s.png", entry->engineid.c_str());
-				if (!_loadedSurfaces.contains(path)) {
-					surf = loadSurfaceFromFile(path);
-				} else {
-					const Graphics::ManagedSurface *scSurf = _loadedSurfaces[path];
-					_loadedSurfaces[entry->thumbPath] = new Graphics::ManagedSurface(*scSurf);
-				}
-			}
+	_loadedSurfaces[entry->thumbPath] = nullptr;
+	Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
+	Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
+	if (!surf) {
+		path = Common::String::format("icons/%s.png", entry->engineid.c_str());
+		if (!_loadedSurfaces.contains(path)) {
+			surf = loadSurfaceFromFile(path);
+		} else {
+			const Graphics::ManagedSurface *scSurf = _loadedSurfaces[path];
+			if (scSurf)
+				_loadedSurfaces[entry->thumbPath] = new Graphics::ManagedSurface(*scSurf);
+		}
+	}
 
-			if (surf) {
-				const Graphics::ManagedSurface *scSurf(scaleGfx(surf, thumbnailWidth, thumbnailHeight, true));
-				_loadedSurfaces[entry->thumbPath] = scSurf;
+	if (surf) {
+		const Graphics::ManagedSurface *scSurf(scaleGfx(surf, thumbnailWidth, thumbnailHeight, true));
+		_loadedSurfaces[entry->thumbPath] = scSurf;
 
-				if (path != entry->thumbPath) {
-					_loadedSurfaces[path] = new Graphics::ManagedSurface(*scSurf);
-				}
+		if (path != entry->thumbPath) {
+			_loadedSurfaces[path] = new Graphics::ManagedSurface(*scSurf);
+		}
 
-				if (surf != scSurf) {
-					surf->free();
-					delete surf;
-				}
-			}
+		if (surf != scSurf) {
+			surf->free();
+			delete surf;
 		}
 	}
+
+	return _loadedSurfaces[entry->thumbPath] != nullptr;
+}
+
+void GridWidget::trimThumbnails() {
+	uint32 size = 0;
+	for (Common::HashMap<Common::String, const Graphics::ManagedSurface *>::const_iterator i = _loadedSurfaces.begin(); i != _loadedSurfaces.end(); ++i) {
+		if (i->_value)
+			size += i->_value->pitch * i->_value->h;
+	}
+
+	if (size <= kMaxThumbnailCacheSize)
+		return;
+
+	// Drop everything which is not on screen. Missing thumbnails are kept,
+	// so that we do not look for them again.
+	Common::HashMap<Common::String, bool> visible;
+	for (Common::Array<GridItemInfo *>::const_iterator i = _visibleEntryList.begin(); i != _visibleEntryList.end(); ++i)
+		visible[(*i)->thumbPath] = true;
+
+	Common::StringArray unused;
+	for (Common::HashMap<Common::String, const Graphics::ManagedSurface *>::const_iterator i = _loadedSurfaces.begin(); i != _loadedSurfaces.end(); ++i) {
+		if (i->_value && !visible.contains(i->_key))
+			unused.push_back(i->_key);
+	}
+
+	for (Common::StringArray::const_iterator i = unused.begin(); i != unused.end(); ++i) {
+		delete _loadedSurfaces[*i];
+		_loadedSurfaces.erase(*i);
+	}
 }
 
 void GridWidget::loadFlagIcons() {
@@ -830,6 +896,14 @@ void GridWidget::updateGrid() {
 void GridWidget::assignEntriesToItems() {
 	// Assign entries from _visibleEntries to each GridItem in _gridItems
 
+	for (Common::Array<GridItemInfo *>::iterator i = _visibleEntryList.begin(); i != _visibleEntryList.end(); ++i) {
+		GridItemInfo *entry = *i;
+		if (!entry->validEntryChecked) {
+			entry->validEntry = !entry->gamePath.empty() && Common::FSNode(Common::Path::fromConfig(entry->gamePath)).isDirectory();
+			entry->validEntryChecked = true;
+		}
+	}
+
 	// In case we have less ContainerWidgets than the number of visible entries
 	if (_visibleEntryList.size() > _gridItems.size()) {
 		for (uint l = _gridItems.size(); l < _visibleEntryList.size(); ++l) {
@@ -895,6 +969,11 @@ void GridWidget::handleCommand(CommandSender *sender, uint32 cmd, uint32 data) {
 	}
 }
 
+void GridWidget::handleTickle() {
+	if (_thumbnailsPending)
+		_thumbnailsPending = loadPendingThumbnails(kThumbnailsPerTick);
+}
+
 void GridWidget::calcInnerHeight() {
 	int row = 0;
 	int col = 0;
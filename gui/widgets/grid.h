@@ -49,6 +49,8 @@ enum {
 /* GridItemInfo */
 struct GridItemInfo {
 	bool		isHeader, validEntry;
+	// Checking the game path is slow, so it is only done for visible entries
+	bool		validEntryChecked;
 	int 		entryID;
 	Common::String 		engineid;
 	Common::String 		gameid;
@@ -56,6 +58,7 @@ struct GridItemInfo {
 	Common::String		description;
 	Common::String		extra;
 	Common::String 		thumbPath;
+	Common::String		gamePath;
 	// Generic attribute value, may be any piece of metadata
 	Common::String		attribute;
 	Common::Language	language;
@@ -65,12 +68,20 @@ struct GridItemInfo {
 
 	GridItemInfo(int id, const Common::String &eid, const Common::String &gid, const Common::String &t,
 		const Common::String &d, const Common::String &e, Common::Language l, Common::Platform p, bool v)
-		: entryID(id), gameid(gid), engineid(eid), title(t), description(d), extra(e), language(l), platform(p), validEntry(v), isHeader(false) {
+		: entryID(id), gameid(gid), engineid(eid), title(t), description(d), extra(e), language(l), platform(p), validEntry(v),
+		  validEntryChecked(true), isHeader(false) {
+		thumbPath = Common::String::format("icons/%s-%s.png", engineid.c_str(), gameid.c_str());
+	}
+
+	GridItemInfo(int id, const Common::String &eid, const Common::String &gid, const Common::String &t,
+		const Common::String &d, const Common::String &e, Common::Language l, Common::Platform p, const Common::String &path)
+		: entryID(id), gameid(gid), engineid(eid), title(t), description(d), extra(e), gamePath(path), language(l), platform(p),
+		  validEntry(false), validEntryChecked(false), isHeader(false) {
 		thumbPath = Common::String::format("icons/%s-%s.png", engineid.c_str(), gameid.c_str());
 	}
 
 	GridItemInfo(const Common::String &groupHeader, int groupID) : title(groupHeader), description(groupHeader),
-		isHeader(true), validEntry(true), entryID(groupID), language(Common::UNK_LANG), platform(Common::kPlatformUnknown) {
+		isHeader(true), validEntry(true), validEntryChecked(true), entryID(groupID), language(Common::UNK_LANG), platform(Common::kPlatformUnknown) {
 		thumbPath = Common::String("");
 	}
 };
@@ -109,6 +120,9 @@ protected:
 	Common::Array<GridItemInfo>			_headerEntryList;
 	Common::Array<GridItemInfo *>		_sortedEntryList;
 	Common::Array<GridItemInfo *>		_visibleEntryList;
+	// Lowercase titles of _dataEntryList, used for filtering
+	Common::Array<Common::U32String>	_searchIndex;
+	bool								_thumbnailsPending;
 
 	Common::String							_groupingAttribute;
 	Common::HashMap<Common::U32String, int>	_groupValueIndex;
@@ -194,6 +208,10 @@ public:
 	void saveClosedGroups(const Common::U32String &groupName);
 
 	void reloadThumbnails();
+	/// Load at most maxCount missing thumbnails of the visible entries. Returns true if some are still missing.
+	bool loadPendingThumbnails(uint maxCount);
+	bool loadThumbnail(const GridItemInfo *entry);
+	void trimThumbnails();
 	void loadFlagIcons();
 	void loadPlatformIcons();
 	void loadExtraIcons();
@@ -213,6 +231,7 @@ public:
 
 	void handleMouseWheel(int x, int y, int direction) override;
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
+	void handleTickle() override;
 	void reflowLayout() override;
 
 	bool wantsFocus() override { return true; }
@@ -324,6 +324,8 @@ void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, const byte *c
 					mask  = 0x80000000;
 				}
 
+				frame.dirtyBlocks.set((y / 4) * (frame.surface->w / 4) + x / 4);
+
 				if ((chunkID & 0x02) || (~flag & mask)) {
 					if ((stream.pos() - startPos + 1) > (int32)chunkSize)
 						return;
@@ -426,8 +428,11 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 	if (!_curFrame.surface) {
 		_curFrame.surface = new Graphics::Surface();
 		_curFrame.surface->create(_curFrame.width, _curFrame.height, _pixelFormat);
+		_curFrame.dirtyBlocks.set_size((_curFrame.width / 4) * (_curFrame.height / 4));
 	}
 
+	_curFrame.dirtyBlocks.clear();
+
 	_y = 0;
 
 	for (uint16 i = 0; i < _curFrame.stripCount; i++) {
@@ -490,6 +495,7 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 				break;
 			default:
 				warning("Unknown Cinepak chunk ID %02x", chunkID);
+				updateDirtyRects();
 				return _curFrame.surface;
 			}
 
@@ -500,9 +506,41 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 		_y = _curFrame.strips[i].rect.bottom;
 	}
 
+	updateDirtyRects();
 	return _curFrame.surface;
 }
 
+void CinepakDecoder::updateDirtyRects() {
+	_dirtyRects.clear();
+
+	uint blockWidth = _curFrame.surface->w / 4;
+	uint blockHeight = _curFrame.surface->h / 4;
+
+	// One rect for each run of written blocks on a row of blocks, merged
+	// with the one from the row above when they line up
+	for (uint y = 0; y < blockHeight; y++) {
+		uint x = 0;
+
+		while (x < blockWidth) {
+			if (!_curFrame.dirtyBlocks.get(y * blockWidth + x)) {
+				x++;
+				continue;
+			}
+
+			uint x0 = x;
+			while (x < blockWidth && _curFrame.dirtyBlocks.get(y * blockWidth + x))
+				x++;
+
+			Common::Rect rect(x0 * 4, y * 4, x * 4, y * 4 + 4);
+
+			if (!_dirtyRects.empty() && _dirtyRects.back().left == rect.left && _dirtyRects.back().right == rect.right && _dirtyRects.back().bottom == rect.top)
+				_dirtyRects.back().bottom = rect.bottom;
+			else
+				_dirtyRects.push_back(rect);
+		}
+	}
+}
+
 void CinepakDecoder::initializeCodebook(uint16 strip, byte codebookType) {
 	CinepakCodebook *codebook = (codebookType == 1) ? _curFrame.strips[strip].v1_codebook : _curFrame.strips[strip].v4_codebook;
 
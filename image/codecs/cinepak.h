@@ -23,6 +23,7 @@
 #define IMAGE_CODECS_CINEPAK_H
 
 #include "common/scummsys.h"
+#include "common/bitarray.h"
 #include "common/rect.h"
 #include "graphics/pixelformat.h"
 
@@ -57,6 +58,7 @@ struct CinepakFrame {
 	CinepakStrip *strips;
 
 	Graphics::Surface *surface;
+	Common::BitArray dirtyBlocks; // The 4x4 blocks written by this frame
 };
 
 /**
@@ -73,6 +75,7 @@ public:
 	~CinepakDecoder() override;
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) override;
+	const Common::List<Common::Rect> *getDirtyRects() const override { return &_dirtyRects; }
 	Graphics::PixelFormat getPixelFormat() const override { return _pixelFormat; }
 	bool setOutputPixelFormat(const Graphics::PixelFormat &format) override;
 
@@ -94,6 +97,9 @@ private:
 	byte *_colorMap;
 	DitherType _ditherType;
 
+	Common::List<Common::Rect> _dirtyRects;
+
+	void updateDirtyRects();
 	void initializeCodebook(uint16 strip, byte codebookType);
 	void loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize);
 	void decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
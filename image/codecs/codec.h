@@ -22,6 +22,8 @@
 #ifndef IMAGE_CODECS_CODEC_H
 #define IMAGE_CODECS_CODEC_H
 
+#include "common/list.h"
+#include "common/rect.h"
 #include "graphics/surface.h"
 #include "graphics/pixelformat.h"
 
@@ -79,6 +81,14 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) = 0;
 
+	/**
+	 * Get the areas of the surface which the last decodeFrame() call changed.
+	 *
+	 * Returns nullptr if the codec does not keep track of them, in which
+	 * case the whole surface has to be considered changed.
+	 */
+	virtual const Common::List<Common::Rect> *getDirtyRects() const { return nullptr; }
+
 	/**
 	 * Get the format that the surface returned from decodeImage() will
 	 * be in.
@@ -0,0 +1,87 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include <emmintrin.h>
+
+#include "image/codecs/indeo/indeo.h"
+
+namespace Image {
+namespace Indeo {
+
+namespace {
+
+// Load eight coefficients, sign extended to 32 bits
+static inline void load(const int16 *src, __m128i &lo, __m128i &hi) {
+	const __m128i v = _mm_loadu_si128((const __m128i *)src);
+	lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+	hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+}
+
+// (v + 2) >> 2 plus the bias of 128, saturated to 16 bits
+static inline __m128i bias(__m128i lo, __m128i hi) {
+	const __m128i k = _mm_set1_epi32(2);
+	const __m128i b = _mm_set1_epi32(128);
+
+	lo = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(lo, k), 2), b);
+	hi = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(hi, k), 2), b);
+	return _mm_packs_epi32(lo, hi);
+}
+
+} // End of anonymous namespace
+
+void IndeoDecoderBase::recomposeHaarRowSSE2(const int16 *b0Ptr, const int16 *b1Ptr,
+		const int16 *b2Ptr, const int16 *b3Ptr, uint8 *dst, int dstPitch, int count) {
+	int indx = 0;
+
+	for (; indx + 8 <= count; indx += 8) {
+		__m128i b0l, b0h, b1l, b1h, b2l, b2h, b3l, b3h;
+		load(b0Ptr + indx, b0l, b0h);
+		load(b1Ptr + indx, b1l, b1h);
+		load(b2Ptr + indx, b2l, b2h);
+		load(b3Ptr + indx, b3l, b3h);
+
+		// The same sums as the C version, sharing the common terms
+		const __m128i s01l = _mm_add_epi32(b0l, b1l), s01h = _mm_add_epi32(b0h, b1h);
+		const __m128i d01l = _mm_sub_epi32(b0l, b1l), d01h = _mm_sub_epi32(b0h, b1h);
+		const __m128i s23l = _mm_add_epi32(b2l, b3l), s23h = _mm_add_epi32(b2h, b3h);
+		const __m128i d23l = _mm_sub_epi32(b2l, b3l), d23h = _mm_sub_epi32(b2h, b3h);
+
+		const __m128i p0 = bias(_mm_add_epi32(s01l, s23l), _mm_add_epi32(s01h, s23h));
+		const __m128i p1 = bias(_mm_sub_epi32(s01l, s23l), _mm_sub_epi32(s01h, s23h));
+		const __m128i p2 = bias(_mm_add_epi32(d01l, d23l), _mm_add_epi32(d01h, d23h));
+		const __m128i p3 = bias(_mm_sub_epi32(d01l, d23l), _mm_sub_epi32(d01h, d23h));
+
+		// Interleave the pixel pairs and clip them to 8 bits
+		_mm_storeu_si128((__m128i *)(dst + indx * 2),
+			_mm_packus_epi16(_mm_unpacklo_epi16(p0, p1), _mm_unpackhi_epi16(p0, p1)));
+		_mm_storeu_si128((__m128i *)(dst + dstPitch + indx * 2),
+			_mm_packus_epi16(_mm_unpacklo_epi16(p2, p3), _mm_unpackhi_epi16(p2, p3)));
+	}
+
+	if (indx < count)
+		recomposeHaarRow(b0Ptr + indx, b1Ptr + indx, b2Ptr + indx, b3Ptr + indx,
+			dst + indx * 2, dstPitch, count - indx);
+}
+
+} // End of namespace Indeo
+} // End of namespace Image
@@ -29,6 +29,7 @@
 #include "graphics/yuv_to_rgb.h"
 #include "common/system.h"
 #include "common/algorithm.h"
+#include "common/jobsystem.h"
 #include "common/rect.h"
 #include "common/textconsole.h"
 #include "common/util.h"
@@ -474,6 +475,12 @@ IndeoDecoderBase::IndeoDecoderBase(uint16 width, uint16 height, uint bitsPerPixe
 		_pixelFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 
 	_ctx._bRefBuf = 3; // buffer 2 is used for scalability mode
+
+	_recomposeHaarRow = recomposeHaarRow;
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		_recomposeHaarRow = recomposeHaarRowSSE2;
+#endif
 }
 
 IndeoDecoderBase::~IndeoDecoderBase() {
@@ -530,6 +537,7 @@ int IndeoDecoderBase::decodeIndeoFrame() {
 
 	if (isNonNullFrame()) {
 		_ctx._bufInvalid[_ctx._dstBuf] = 1;
+		_tileJobs.clear();
 		for (int p = 0; p < 3; p++) {
 			for (int b = 0; b < _ctx._planes[p]._numBands; b++) {
 				result = decode_band(&_ctx._planes[p]._bands[b]);
@@ -539,6 +547,10 @@ int IndeoDecoderBase::decodeIndeoFrame() {
 				}
 			}
 		}
+
+		result = decodeTiles();
+		if (result < 0)
+			return result;
 		_ctx._bufInvalid[_ctx._dstBuf] = 0;
 	} else {
 		if (_ctx._isScalable)
@@ -565,17 +577,9 @@ int IndeoDecoderBase::decodeIndeoFrame() {
 	if ((result = frame->getBuffer(0)) < 0)
 		return result;
 
-	if (_ctx._isScalable) {
-		if (_ctx._isIndeo4)
-			recomposeHaar(&_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
-		else
-			recompose53(&_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
-	} else {
-		outputPlane(&_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
-	}
-
-	outputPlane(&_ctx._planes[2], frame->_data[1], frame->_linesize[1]);
-	outputPlane(&_ctx._planes[1], frame->_data[2], frame->_linesize[2]);
+	// The planes are independent, so they are output in parallel
+	OutputPlanesJob job = { this, frame };
+	g_system->getJobSystem()->parallelFor(3, outputPlanesProc, &job);
 
 	// Merge the planes into the final surface
 	YUVToRGBMan.convert410(_surface, Graphics::YUVToRGBManager::kScaleITU,
@@ -641,9 +645,11 @@ int IndeoDecoderBase::decode_band(IVIBandDesc *band) {
 		return -1;
 	}
 
-	band->_rvMap = &_ctx._rvmapTabs[band->_rvmapSel];
+	// Apply the corrections to a copy of the selected rvmap table, as the
+	// blocks of several bands may be decoded at the same time
+	band->_rvMapCopy = _ctx._rvmapTabs[band->_rvmapSel];
+	band->_rvMap = &band->_rvMapCopy;
 
-	// apply corrections to the selected rvmap table if present
 	for (int i = 0; i < band->_numCorr; i++) {
 		int idx1 = band->_corr[i * 2];
 		int idx2 = band->_corr[i * 2 + 1];
@@ -684,40 +690,90 @@ int IndeoDecoderBase::decode_band(IVIBandDesc *band) {
 			if (result < 0)
 				break;
 
-			result = decodeBlocks(_ctx._gb, band, tile);
-			if (result < 0) {
-				warning("Corrupted tile data encountered!");
-				break;
-			}
-
-			if ((((int)_ctx._gb->pos() - pos) >> 3) != tile->_dataSize) {
+			// The blocks are decoded later by decodeTiles(), so skip
+			// to the next tile
+			TileJob job;
+			job._band = band;
+			job._tile = tile;
+			job._blocksPos = _ctx._gb->pos();
+			// The blocks end byte aligned, which may be up to 7 bits past
+			// the given data size when a preceding tile was empty
+			job._endPos = (pos + (tile->_dataSize << 3) + 7) & ~7;
+			job._result = 0;
+
+			if (job._endPos < job._blocksPos || job._endPos > _ctx._gb->size()) {
 				warning("Tile _dataSize mismatch!");
 				result = -1;
 				break;
 			}
 
+			_tileJobs.push_back(job);
+			_ctx._gb->skip(job._endPos - job._blocksPos);
+
 			pos += tile->_dataSize << 3; // skip to next tile
 		}
 	}
 
-	// restore the selected rvmap table by applying its corrections in
-	// reverse order
-	for (int i = band->_numCorr - 1; i >= 0; i--) {
-		int idx1 = band->_corr[i * 2];
-		int idx2 = band->_corr[i * 2 + 1];
-		SWAP(band->_rvMap->_runtab[idx1], band->_rvMap->_runtab[idx2]);
-		SWAP(band->_rvMap->_valtab[idx1], band->_rvMap->_valtab[idx2]);
-		if (idx1 == band->_rvMap->_eobSym || idx2 == band->_rvMap->_eobSym)
-			band->_rvMap->_eobSym ^= idx1 ^ idx2;
-		if (idx1 == band->_rvMap->_escSym || idx2 == band->_rvMap->_escSym)
-			band->_rvMap->_escSym ^= idx1 ^ idx2;
-	}
-
 	_ctx._gb->align();
 
 	return result;
 }
 
+void IndeoDecoderBase::decodeTilesProc(uint32 begin, uint32 end, void *refCon) {
+	IndeoDecoderBase *decoder = (IndeoDecoderBase *)refCon;
+
+	for (uint32 i = begin; i < end; i++) {
+		TileJob &job = decoder->_tileJobs[i];
+
+		// Each tile gets its own bit reader, starting at the byte of its
+		// block data and reaching up to the end of the frame like the
+		// one of the context
+		const uint32 startByte = job._blocksPos >> 3;
+		GetBits gb(decoder->_ctx._frameData + startByte, decoder->_ctx._frameSize - startByte);
+		gb.skip(job._blocksPos & 7);
+
+		job._result = decoder->decodeBlocks(&gb, job._band, job._tile);
+		if (job._result >= 0 && gb.pos() + (startByte << 3) != job._endPos)
+			job._result = -2;
+	}
+}
+
+int IndeoDecoderBase::decodeTiles() {
+	g_system->getJobSystem()->parallelFor(_tileJobs.size(), decodeTilesProc, this);
+
+	for (uint i = 0; i < _tileJobs.size(); i++) {
+		if (_tileJobs[i]._result == -2) {
+			warning("Tile _dataSize mismatch!");
+			return -1;
+		} else if (_tileJobs[i]._result < 0) {
+			warning("Corrupted tile data encountered!");
+			return _tileJobs[i]._result;
+		}
+	}
+
+	return 0;
+}
+
+void IndeoDecoderBase::outputPlanesProc(uint32 begin, uint32 end, void *refCon) {
+	OutputPlanesJob *job = (OutputPlanesJob *)refCon;
+	IndeoDecoderBase *decoder = job->_decoder;
+	AVFrame *frame = job->_frame;
+
+	for (uint32 p = begin; p < end; p++) {
+		// The U and V planes are swapped in the frame
+		const int dstPlane = (p == 0) ? 0 : 3 - p;
+
+		if (p == 0 && decoder->_ctx._isScalable) {
+			if (decoder->_ctx._isIndeo4)
+				decoder->recomposeHaar(&decoder->_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
+			else
+				decoder->recompose53(&decoder->_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
+		} else {
+			decoder->outputPlane(&decoder->_ctx._planes[p], frame->_data[dstPlane], frame->_linesize[dstPlane]);
+		}
+	}
+}
+
 void IndeoDecoderBase::recomposeHaar(const IVIPlaneDesc *_plane,
 		uint8 *dst, const int dstPitch) {
 
@@ -730,26 +786,10 @@ void IndeoDecoderBase::recomposeHaar(const IVIPlaneDesc *_plane,
 	const short *b2Ptr = _plane->_bands[2]._buf;
 	const short *b3Ptr = _plane->_bands[3]._buf;
 
+	const int count = (_plane->_width + 1) / 2;
+
 	for (int y = 0; y < _plane->_height; y += 2) {
-		for (int x = 0, indx = 0; x < _plane->_width; x += 2, indx++) {
-			// load coefficients
-			int b0 = b0Ptr[indx]; //should be: b0 = (_numBands > 0) ? b0Ptr[indx] : 0;
-			int b1 = b1Ptr[indx]; //should be: b1 = (_numBands > 1) ? b1Ptr[indx] : 0;
-			int b2 = b2Ptr[indx]; //should be: b2 = (_numBands > 2) ? b2Ptr[indx] : 0;
-			int b3 = b3Ptr[indx]; //should be: b3 = (_numBands > 3) ? b3Ptr[indx] : 0;
-
-							   // haar wavelet recomposition
-			int p0 = (b0 + b1 + b2 + b3 + 2) >> 2;
-			int p1 = (b0 + b1 - b2 - b3 + 2) >> 2;
-			int p2 = (b0 - b1 + b2 - b3 + 2) >> 2;
-			int p3 = (b0 - b1 - b2 + b3 + 2) >> 2;
-
-			// bias, convert and output four pixels
-			dst[x] = avClipUint8(p0 + 128);
-			dst[x + 1] = avClipUint8(p1 + 128);
-			dst[dstPitch + x] = avClipUint8(p2 + 128);
-			dst[dstPitch + x + 1] = avClipUint8(p3 + 128);
-		}// for x
+		_recomposeHaarRow(b0Ptr, b1Ptr, b2Ptr, b3Ptr, dst, dstPitch, count);
 
 		dst += dstPitch << 1;
 
@@ -760,6 +800,29 @@ void IndeoDecoderBase::recomposeHaar(const IVIPlaneDesc *_plane,
 	}// for y
 }
 
+void IndeoDecoderBase::recomposeHaarRow(const int16 *b0Ptr, const int16 *b1Ptr,
+		const int16 *b2Ptr, const int16 *b3Ptr, uint8 *dst, int dstPitch, int count) {
+	for (int indx = 0, x = 0; indx < count; indx++, x += 2) {
+		// load coefficients
+		int b0 = b0Ptr[indx]; //should be: b0 = (_numBands > 0) ? b0Ptr[indx] : 0;
+		int b1 = b1Ptr[indx]; //should be: b1 = (_numBands > 1) ? b1Ptr[indx] : 0;
+		int b2 = b2Ptr[indx]; //should be: b2 = (_numBands > 2) ? b2Ptr[indx] : 0;
+		int b3 = b3Ptr[indx]; //should be: b3 = (_numBands > 3) ? b3Ptr[indx] : 0;
+
+		// haar wavelet recomposition
+		int p0 = (b0 + b1 + b2 + b3 + 2) >> 2;
+		int p1 = (b0 + b1 - b2 - b3 + 2) >> 2;
+		int p2 = (b0 - b1 + b2 - b3 + 2) >> 2;
+		int p3 = (b0 - b1 - b2 + b3 + 2) >> 2;
+
+		// bias, convert and output four pixels
+		dst[x] = avClipUint8(p0 + 128);
+		dst[x + 1] = avClipUint8(p1 + 128);
+		dst[dstPitch + x] = avClipUint8(p2 + 128);
+		dst[dstPitch + x + 1] = avClipUint8(p3 + 128);
+	}// for x
+}
+
 void IndeoDecoderBase::recompose53(const IVIPlaneDesc *_plane,
 		uint8 *dst, const int dstPitch) {
 	int32 p0, p1, p2, p3, tmp0, tmp1, tmp2;
@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/array.h"
 #include "common/scummsys.h"
 #include "graphics/surface.h"
 #include "image/codecs/codec.h"
@@ -229,6 +230,7 @@ struct IVIBandDesc {
 	uint8			_corr[61 * 2];	///< rvmap correction pairs
 	int				_rvmapSel;		///< rvmap table selector
 	RVMapDesc *		_rvMap;			///< ptr to the RLE table for this band
+	RVMapDesc		_rvMapCopy;		///< selected RLE table with the corrections of this band applied
 	int				_numTiles;		///< number of tiles in this band
 	IVITile *		_tiles;			///< array of tile descriptors
 	InvTransformPtr *_invTransform;
@@ -434,6 +436,39 @@ private:
 
 class IndeoDecoderBase : public Codec {
 private:
+	/**
+	 *  Block data of a coded tile, found while parsing the bands of a frame
+	 */
+	struct TileJob {
+		IVIBandDesc *_band;
+		IVITile *_tile;
+		uint32 _blocksPos;	///< bit position of the block data in the frame
+		uint32 _endPos;		///< bit position of the end of the tile data
+		int _result;		///< result code of decodeBlocks, -2 on a size mismatch
+	};
+
+	struct OutputPlanesJob {
+		IndeoDecoderBase *_decoder;
+		AVFrame *_frame;
+	};
+
+	typedef void (*RecomposeHaarRowProc)(const int16 *b0Ptr, const int16 *b1Ptr,
+		const int16 *b2Ptr, const int16 *b3Ptr, uint8 *dst, int dstPitch, int count);
+
+	Common::Array<TileJob> _tileJobs;
+	RecomposeHaarRowProc _recomposeHaarRow;
+
+	/**
+	 *  Decode the block data of the tiles queued by decode_band, spreading
+	 *  them over the job system workers.
+	 *
+	 *  @returns        result code: 0 = OK, -1 = error
+	 */
+	int decodeTiles();
+
+	static void decodeTilesProc(uint32 begin, uint32 end, void *refCon);
+	static void outputPlanesProc(uint32 begin, uint32 end, void *refCon);
+
 	/**
 	 *  Decode an Indeo 4 or 5 band.
 	 *
@@ -451,6 +486,21 @@ private:
 	 */
 	void recomposeHaar(const IVIPlaneDesc *plane, uint8 *dst, const int dstPitch);
 
+	/**
+	 *  Recompose two output lines from one line of each of the four bands
+	 *
+	 *  @param[in]  b0Ptr .. b3Ptr	Coefficients of the bands
+	 *  @param[out] dst			Pointer to the first of the two destination lines
+	 *  @param[in]  dstPitch	Pitch of the destination buffer
+	 *  @param[in]  count		Number of coefficients in each band line
+	 */
+	static void recomposeHaarRow(const int16 *b0Ptr, const int16 *b1Ptr,
+		const int16 *b2Ptr, const int16 *b3Ptr, uint8 *dst, int dstPitch, int count);
+#ifdef SCUMMVM_SSE2
+	static void recomposeHaarRowSSE2(const int16 *b0Ptr, const int16 *b1Ptr,
+		const int16 *b2Ptr, const int16 *b3Ptr, uint8 *dst, int dstPitch, int count);
+#endif
+
 	/**
 	 *  5/3 wavelet recomposition filter for Indeo5
 	 *
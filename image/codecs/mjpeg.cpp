@@ -45,14 +45,11 @@ MJPEGDecoder::MJPEGDecoder() : Codec() {
 	if (_pixelFormat.bytesPerPixel == 1)
 		_pixelFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 
-	_surface = 0;
+	_jpeg = nullptr;
 }
 
 MJPEGDecoder::~MJPEGDecoder() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
-	}
+	delete _jpeg;
 }
 
 // Header to be inserted
@@ -203,25 +200,23 @@ const Graphics::Surface *MJPEGDecoder::decodeFrame(Common::SeekableReadStream &s
 	stream.read(data + dataOffset, stream.size() - inputSkip);
 
 	Common::MemoryReadStream convertedStream(data, outputSize, DisposeAfterUse::YES);
-	JPEGDecoder jpeg;
-	jpeg.setOutputPixelFormat(_pixelFormat);
 
-	if (!jpeg.loadStream(convertedStream)) {
+	// The decoder is kept around so the frame can be handed out as decoded,
+	// rather than being copied into a surface of our own
+	if (!_jpeg)
+		_jpeg = new JPEGDecoder();
+
+	_jpeg->setOutputPixelFormat(_pixelFormat);
+
+	if (!_jpeg->loadStream(convertedStream)) {
 		warning("Failed to decode MJPEG frame");
 		return 0;
 	}
 
-	if (_surface) {
-		_surface->free();
-		delete _surface;
-	}
-
-	_surface = new Graphics::Surface();
-	_surface->copyFrom(*jpeg.getSurface());
-
-	assert(_surface->format == _pixelFormat);
+	const Graphics::Surface *surface = _jpeg->getSurface();
+	assert(surface->format == _pixelFormat);
 
-	return _surface;
+	return surface;
 }
 
 } // End of namespace Image
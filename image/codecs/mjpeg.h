@@ -35,6 +35,8 @@ struct Surface;
 
 namespace Image {
 
+class JPEGDecoder;
+
 /**
  * Motion JPEG decoder.
  *
@@ -51,7 +53,7 @@ public:
 
 private:
 	Graphics::PixelFormat _pixelFormat;
-	Graphics::Surface *_surface;
+	JPEGDecoder *_jpeg;
 };
 
 } // End of namespace Image
@@ -39,15 +39,32 @@ MSRLEDecoder::~MSRLEDecoder() {
 }
 
 const Graphics::Surface *MSRLEDecoder::decodeFrame(Common::SeekableReadStream &stream) {
+	Common::Rect dirtyRect;
+
 	if (_bitsPerPixel == 8) {
-		decode8(stream);
+		decode8(stream, dirtyRect);
 	} else
 		error("Unhandled %d bit Microsoft RLE encoding", _bitsPerPixel);
 
+	// Delta frames skip over the parts which didn't change
+	_dirtyRects.clear();
+	dirtyRect.clip(_surface->w, _surface->h);
+	if (!dirtyRect.isEmpty())
+		_dirtyRects.push_back(dirtyRect);
+
 	return _surface;
 }
 
-void MSRLEDecoder::decode8(Common::SeekableReadStream &stream) {
+static void extendDirtyRect(Common::Rect &dirtyRect, int x, int y, int width) {
+	Common::Rect rect(x, y, x + width, y + 1);
+
+	if (dirtyRect.isEmpty())
+		dirtyRect = rect;
+	else
+		dirtyRect.extend(rect);
+}
+
+void MSRLEDecoder::decode8(Common::SeekableReadStream &stream, Common::Rect &dirtyRect) {
 
 	int x = 0;
 	int y = _surface->h - 1;
@@ -107,6 +124,8 @@ void MSRLEDecoder::decode8(Common::SeekableReadStream &stream) {
 					continue;
 				}
 
+				extendDirtyRect(dirtyRect, x, y, value);
+
 				for (int i = 0; i < value; i++)
 					*output++ = stream.readByte();
 
@@ -126,6 +145,8 @@ void MSRLEDecoder::decode8(Common::SeekableReadStream &stream) {
 			if (output + count > output_end)
 				continue;
 
+			extendDirtyRect(dirtyRect, x, y, count);
+
 			for (int i = 0; i < count; i++, x++)
 				*output++ = value;
 		}
@@ -37,14 +37,16 @@ public:
 	~MSRLEDecoder() override;
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) override;
+	const Common::List<Common::Rect> *getDirtyRects() const override { return &_dirtyRects; }
 	Graphics::PixelFormat getPixelFormat() const override { return Graphics::PixelFormat::createFormatCLUT8(); }
 
 private:
 	byte _bitsPerPixel;
 
 	Graphics::Surface *_surface;
+	Common::List<Common::Rect> _dirtyRects;
 
-	void decode8(Common::SeekableReadStream &stream);
+	void decode8(Common::SeekableReadStream &stream, Common::Rect &dirtyRect);
 };
 
 } // End of namespace Image
@@ -422,8 +422,12 @@ void QTRLEDecoder::decode32(Common::SeekableReadStream &stream, uint32 rowPtr, u
 }
 
 const Graphics::Surface *QTRLEDecoder::decodeFrame(Common::SeekableReadStream &stream) {
-	if (!_surface)
+	_dirtyRects.clear();
+
+	if (!_surface) {
 		createSurface();
+		_dirtyRects.push_back(Common::Rect(_width, _height));
+	}
 
 	uint16 startLine = 0;
 	uint16 height = _height;
@@ -451,6 +455,10 @@ const Graphics::Surface *QTRLEDecoder::decodeFrame(Common::SeekableReadStream &s
 
 	uint32 rowPtr = _paddedWidth * startLine;
 
+	// Only the lines from the header are touched
+	if (_dirtyRects.empty() && startLine < _height)
+		_dirtyRects.push_back(Common::Rect(0, startLine, _width, MIN<uint32>(startLine + height, _height)));
+
 	switch (_bitsPerPixel) {
 	case 1:
 	case 33:
@@ -38,6 +38,7 @@ public:
 	~QTRLEDecoder() override;
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) override;
+	const Common::List<Common::Rect> *getDirtyRects() const override { return &_dirtyRects; }
 	Graphics::PixelFormat getPixelFormat() const override;
 
 	bool containsPalette() const override { return _ditherPalette != 0; }
@@ -54,6 +55,7 @@ private:
 	byte *_ditherPalette;
 	bool _dirtyPalette;
 	byte *_colorMap;
+	Common::List<Common::Rect> _dirtyRects;
 
 	void createSurface();
 
@@ -30,6 +30,7 @@
 #include "common/stream.h"
 #include "common/textconsole.h"
 #include "common/util.h"
+#include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 
 #ifdef USE_JPEG
@@ -282,22 +283,24 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// Actually start decompressing the image
 	jpeg_start_decompress(&cinfo);
 
-	// Allocate buffers for the output data
+	// Allocate buffers for the output data. The surface is always created
+	// in the final format, so formats which libjpeg can't output directly
+	// are converted one scanline at a time.
+	Graphics::PixelFormat scanlineFormat;
 	switch (_colorSpace) {
-	case kColorSpaceRGB: {
-		Graphics::PixelFormat outputPixelFormat;
+	case kColorSpaceRGB:
 		if (cinfo.out_color_space == JCS_RGB) {
-			outputPixelFormat = getByteOrderRgbPixelFormat();
+			scanlineFormat = getByteOrderRgbPixelFormat();
 		} else {
-			outputPixelFormat = _requestedPixelFormat;
+			scanlineFormat = _requestedPixelFormat;
 		}
-		_surface.create(cinfo.output_width, cinfo.output_height, outputPixelFormat);
+		_surface.create(cinfo.output_width, cinfo.output_height, _requestedPixelFormat);
 		break;
-	}
 	case kColorSpaceYUV:
 		// We use YUV with 3 bytes per pixel otherwise.
 		// This is pretty ugly since our PixelFormat cannot express YUV...
-		_surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0));
+		scanlineFormat = Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0);
+		_surface.create(cinfo.output_width, cinfo.output_height, scanlineFormat);
 		break;
 	default:
 		break;
@@ -307,28 +310,32 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		assert(_surface.format.bytesPerPixel == 4);
 	}
 
-	// Allocate buffer for one scanline
-	JDIMENSION pitch = cinfo.output_width * _surface.format.bytesPerPixel;
-	assert(_surface.pitch >= (int)pitch);
-	JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
+	if (scanlineFormat == _surface.format) {
+		// Let libjpeg write straight into the surface
+		while (cinfo.output_scanline < cinfo.output_height) {
+			JSAMPROW row = (JSAMPROW)_surface.getBasePtr(0, cinfo.output_scanline);
+			jpeg_read_scanlines(&cinfo, &row, 1);
+		}
+	} else {
+		// Allocate buffer for one scanline
+		JDIMENSION pitch = cinfo.output_width * scanlineFormat.bytesPerPixel;
+		JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
 
-	// Go through the image data scanline by scanline
-	while (cinfo.output_scanline < cinfo.output_height) {
-		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
+		// Go through the image data scanline by scanline
+		while (cinfo.output_scanline < cinfo.output_height) {
+			byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
 
-		jpeg_read_scanlines(&cinfo, buffer, 1);
+			jpeg_read_scanlines(&cinfo, buffer, 1);
 
-		memcpy(dst, buffer[0], pitch);
+			Graphics::crossBlit(dst, buffer[0], _surface.pitch, pitch, cinfo.output_width, 1,
+			                    _surface.format, scanlineFormat);
+		}
 	}
 
 	// We are done with decompressing, thus free all the data
 	jpeg_finish_decompress(&cinfo);
 	jpeg_destroy_decompress(&cinfo);
 
-	if (_colorSpace == kColorSpaceRGB && _surface.format != _requestedPixelFormat) {
-		_surface.convertToInPlace(_requestedPixelFormat); // Slow path
-	}
-
 	return true;
 #else
 	return false;
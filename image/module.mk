@@ -43,5 +43,11 @@ MODULE_OBJS += \
 	codecs/mpeg.o
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	codecs/indeo/indeo-sse2.o
+$(MODULE)/codecs/indeo/indeo-sse2.o: CXXFLAGS += -msse2
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
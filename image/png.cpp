@@ -30,6 +30,7 @@
 
 #include "image/png.h"
 
+#include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
@@ -46,7 +47,8 @@ PNGDecoder::PNGDecoder() :
 		_skipSignature(false),
 		_keepTransparencyPaletted(false),
 		_hasTransparentColor(false),
-		_transparentColor(0) {
+		_transparentColor(0),
+		_outputPixelFormat() {
 }
 
 PNGDecoder::~PNGDecoder() {
@@ -61,6 +63,7 @@ void PNGDecoder::destroy() {
 	}
 	delete[] _palette;
 	_palette = NULL;
+	_paletteColorCount = 0;
 	_hasTransparentColor = false;
 }
 
@@ -102,6 +105,71 @@ void pngFlushStream(png_structp pngPtr) {
 }
 #endif
 
+bool PNGDecoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		return false;
+
+	_outputPixelFormat = format;
+	return true;
+}
+
+#ifdef USE_PNG
+/**
+ * Check whether libpng can write 8-bit RGB(A) pixels straight in the given
+ * format, and which byte order transforms that needs.
+ */
+static bool getPNGByteOrder(const Graphics::PixelFormat &format, bool &bgr, bool &alphaFirst) {
+	if (format.bytesPerPixel != 4 || format.rLoss || format.gLoss || format.bLoss || (format.aLoss != 0 && format.aLoss != 8))
+		return false;
+	if ((format.rShift | format.gShift | format.bShift | (format.aLoss ? 0 : format.aShift)) & 7)
+		return false;
+
+#ifdef SCUMM_BIG_ENDIAN
+	const int r = 3 - format.rShift / 8, g = 3 - format.gShift / 8, b = 3 - format.bShift / 8;
+	int a = 3 - format.aShift / 8;
+#else
+	const int r = format.rShift / 8, g = format.gShift / 8, b = format.bShift / 8;
+	int a = format.aShift / 8;
+#endif
+	// Without alpha, the filler goes into the unused byte
+	if (format.aLoss)
+		a = 6 - r - g - b;
+	if (((1 << r) | (1 << g) | (1 << b) | (1 << a)) != 0xF)
+		return false;
+
+	alphaFirst = (a == 0);
+	if (g != (alphaFirst ? 2 : 1))
+		return false;
+
+	bgr = (b < r);
+	return true;
+}
+
+static void convertPNGRow(byte *dst, const byte *src, int width, const Graphics::PixelFormat &dstFormat, const Graphics::PixelFormat &srcFormat, const uint32 *palette) {
+	if (palette) {
+		if (dstFormat.bytesPerPixel == 2) {
+			for (int x = 0; x < width; x++)
+				((uint16 *)dst)[x] = palette[src[x]];
+		} else {
+			for (int x = 0; x < width; x++)
+				((uint32 *)dst)[x] = palette[src[x]];
+		}
+	} else if (dstFormat == srcFormat) {
+		memcpy(dst, src, width * dstFormat.bytesPerPixel);
+	} else {
+		Graphics::crossBlit(dst, src, width * dstFormat.bytesPerPixel, width * srcFormat.bytesPerPixel, width, 1, dstFormat, srcFormat);
+	}
+}
+#endif
+
+bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
+	return decode(stream, nullptr, nullptr);
+}
+
+bool PNGDecoder::loadStreamRows(Common::SeekableReadStream &stream, RowProc proc, void *refCon) {
+	return decode(stream, proc, refCon);
+}
+
 /*
  * This code is based on Broken Sword 2.5 engine
  *
@@ -111,7 +179,7 @@ void pngFlushStream(png_structp pngPtr) {
  *
  */
 
-bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
+bool PNGDecoder::decode(Common::SeekableReadStream &stream, RowProc proc, void *refCon) {
 #ifdef USE_PNG
 	destroy();
 
@@ -160,13 +228,13 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	width = w;
 	height = h;
 
-	// Allocate memory for the final image data.
-	// To keep memory framentation low this happens before allocating memory for temporary image data.
-	_outputSurface = new Graphics::Surface();
+	// The format libpng writes the rows in, and the one they are output in
+	Graphics::PixelFormat srcFormat, dstFormat;
 
-	// Images of all color formats except PNG_COLOR_TYPE_PALETTE
-	// will be transformed into ARGB images
-	if (colorType == PNG_COLOR_TYPE_PALETTE && (_keepTransparencyPaletted || !png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS))) {
+	// Paletted images are kept paletted, unless they have several
+	// transparent colors or another output format was requested. In
+	// these cases, the palette is converted to the output format.
+	if (colorType == PNG_COLOR_TYPE_PALETTE && (_outputPixelFormat.bytesPerPixel || _keepTransparencyPaletted || !png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS))) {
 		int numPalette = 0;
 		png_colorp palette = NULL;
 		png_bytep trans = nullptr;
@@ -177,60 +245,53 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
 			return false;
 		}
-		_paletteColorCount = numPalette;
-		_palette = new byte[_paletteColorCount * 3];
-		for (int i = 0; i < _paletteColorCount; i++) {
-			_palette[(i * 3)] = palette[i].red;
-			_palette[(i * 3) + 1] = palette[i].green;
-			_palette[(i * 3) + 2] = palette[i].blue;
-		}
 
 		if (png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS)) {
 			png_color_16p transColor;
 			png_get_tRNS(pngPtr, infoPtr, &trans, &numTrans, &transColor);
+		}
+
+		srcFormat = Graphics::PixelFormat::createFormatCLUT8();
+
+		if (!_outputPixelFormat.bytesPerPixel && numTrans <= 1) {
+			_paletteColorCount = numPalette;
+			_palette = new byte[_paletteColorCount * 3];
+			for (int i = 0; i < _paletteColorCount; i++) {
+				_palette[(i * 3)] = palette[i].red;
+				_palette[(i * 3) + 1] = palette[i].green;
+				_palette[(i * 3) + 2] = palette[i].blue;
+			}
 
 			if (numTrans == 1) {
 				// For a single transparency color, the alpha should be fully transparent
 				assert(*trans == 0);
 				_hasTransparentColor = true;
 				_transparentColor = 0;
-			} else {
-				// Multiple alphas are being specified for the palette, so we can't use
-				// _transparentColor, and will instead need to build an RGBA surface
-				assert(numTrans > 1);
-				hasRgbaPalette = true;
 			}
-		}
 
-		_outputSurface->create(width, height,
-			hasRgbaPalette ? getByteOrderRgbaPixelFormat(true) : Graphics::PixelFormat::createFormatCLUT8());
-		png_set_packing(pngPtr);
+			dstFormat = srcFormat;
+		} else {
+			// Multiple alphas may be specified for the palette, so we can't use
+			// _transparentColor, and will instead build an RGBA surface
+			dstFormat = _outputPixelFormat.bytesPerPixel ? _outputPixelFormat : getByteOrderRgbaPixelFormat(true);
+			hasRgbaPalette = true;
 
-		if (hasRgbaPalette) {
-			// Build up the RGBA palette using the transparency alphas
 			Common::fill(&rgbaPalette[0], &rgbaPalette[256], 0);
-			for (int i = 0; i < _paletteColorCount; ++i) {
+			for (int i = 0; i < numPalette; ++i) {
 				byte a = (i < numTrans) ? trans[i] : 0xff;
-				rgbaPalette[i] = _outputSurface->format.ARGBToColor(
+				rgbaPalette[i] = dstFormat.ARGBToColor(
 					a, palette[i].red, palette[i].green, palette[i].blue);
 			}
-
-			// We won't be needing a separate palette
-			_paletteColorCount = 0;
-			delete[] _palette;
-			_palette = nullptr;
 		}
+
+		png_set_packing(pngPtr);
 	} else {
- 		bool isAlpha = (colorType & PNG_COLOR_MASK_ALPHA);
+		bool isAlpha = (colorType & PNG_COLOR_MASK_ALPHA);
 		if (png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS)) {
- 			isAlpha = true;
+			isAlpha = true;
 			png_set_expand(pngPtr);
 		}
 
-		_outputSurface->create(width, height, getByteOrderRgbaPixelFormat(isAlpha));
-		if (!_outputSurface->getPixels()) {
-			error("Could not allocate memory for output image.");
-		}
 		if (bitDepth == 16)
 			png_set_strip_16(pngPtr);
 		if (bitDepth < 8)
@@ -239,8 +300,23 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			colorType == PNG_COLOR_TYPE_GRAY_ALPHA)
 			png_set_gray_to_rgb(pngPtr);
 
+		// Let libpng reorder the channels when it can write the output
+		// format, and otherwise convert from RGBA row by row
+		dstFormat = _outputPixelFormat.bytesPerPixel ? _outputPixelFormat : getByteOrderRgbaPixelFormat(isAlpha);
+
+		bool bgr = false, alphaFirst = false;
+		if (getPNGByteOrder(dstFormat, bgr, alphaFirst)) {
+			srcFormat = dstFormat;
+			if (bgr)
+				png_set_bgr(pngPtr);
+			if (alphaFirst)
+				png_set_swap_alpha(pngPtr);
+		} else {
+			srcFormat = getByteOrderRgbaPixelFormat(isAlpha);
+		}
+
 		if (colorType != PNG_COLOR_TYPE_RGB_ALPHA)
-			png_set_filler(pngPtr, 0xff, PNG_FILLER_AFTER);
+			png_set_filler(pngPtr, 0xff, alphaFirst ? PNG_FILLER_BEFORE : PNG_FILLER_AFTER);
 	}
 
 	// After the transformations have been registered, the image data is read again.
@@ -250,29 +326,57 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	width = w;
 	height = h;
 
-	if (hasRgbaPalette) {
-		// Build up the RGBA surface from paletted rows
-		png_bytep rowPtr = new byte[width];
-		if (!rowPtr)
-			error("Could not allocate memory for row.");
+	// Allocate memory for the final image data.
+	// To keep memory framentation low this happens before allocating memory for temporary image data.
+	Graphics::Surface rowSurface;
+	if (proc) {
+		rowSurface.create(width, 1, dstFormat);
+	} else {
+		_outputSurface = new Graphics::Surface();
+		_outputSurface->create(width, height, dstFormat);
+		if (!_outputSurface->getPixels()) {
+			error("Could not allocate memory for output image.");
+		}
+	}
 
-		for (int yp = 0; yp < height; ++yp) {
-			png_read_row(pngPtr, rowPtr, nullptr);
-			uint32 *destRowP = (uint32 *)_outputSurface->getBasePtr(0, yp);
+	// Rows which need no conversion are read straight into the surface
+	const bool readToSurface = !proc && !hasRgbaPalette && srcFormat == dstFormat;
+	const uint32 *rowPalette = hasRgbaPalette ? rgbaPalette : nullptr;
 
-			for (int xp = 0; xp < width; ++xp)
-				destRowP[xp] = rgbaPalette[rowPtr[xp]];
+	if (interlaceType == PNG_INTERLACE_NONE) {
+		// PNGs without interlacing can simply be read row by row.
+		byte *rowPtr = nullptr;
+		if (!readToSurface) {
+			rowPtr = new byte[width * srcFormat.bytesPerPixel];
+			if (!rowPtr)
+				error("Could not allocate memory for row.");
 		}
 
-		delete[] rowPtr;
-	} else  if (interlaceType == PNG_INTERLACE_NONE) {
-		// PNGs without interlacing can simply be read row by row.
 		for (int i = 0; i < height; i++) {
-			png_read_row(pngPtr, (png_bytep)_outputSurface->getBasePtr(0, i), NULL);
+			if (readToSurface) {
+				png_read_row(pngPtr, (png_bytep)_outputSurface->getBasePtr(0, i), NULL);
+				continue;
+			}
+
+			png_read_row(pngPtr, rowPtr, NULL);
+
+			byte *dst = proc ? (byte *)rowSurface.getPixels() : (byte *)_outputSurface->getBasePtr(0, i);
+			convertPNGRow(dst, rowPtr, width, dstFormat, srcFormat, rowPalette);
+			if (proc)
+				proc(rowSurface, i, height, refCon);
 		}
+
+		delete[] rowPtr;
 	} else {
 		// PNGs with interlacing require us to allocate an auxillary
-		// buffer with pointers to all row starts.
+		// buffer with pointers to all row starts, as rows are only
+		// complete after the last pass.
+		Graphics::Surface image;
+		Graphics::Surface *target = _outputSurface;
+		if (!readToSurface) {
+			image.create(width, height, srcFormat);
+			target = &image;
+		}
 
 		// Allocate row pointer buffer
 		png_bytep *rowPtr = new png_bytep[height];
@@ -282,15 +386,28 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 		// Initialize row pointers
 		for (int i = 0; i < height; i++)
-			rowPtr[i] = (png_bytep)_outputSurface->getBasePtr(0, i);
+			rowPtr[i] = (png_bytep)target->getBasePtr(0, i);
 
 		// Read image data
 		png_read_image(pngPtr, rowPtr);
 
 		// Free row pointer buffer
 		delete[] rowPtr;
+
+		if (!readToSurface) {
+			for (int i = 0; i < height; i++) {
+				byte *dst = proc ? (byte *)rowSurface.getPixels() : (byte *)_outputSurface->getBasePtr(0, i);
+				convertPNGRow(dst, (const byte *)image.getBasePtr(0, i), width, dstFormat, srcFormat, rowPalette);
+				if (proc)
+					proc(rowSurface, i, height, refCon);
+			}
+
+			image.free();
+		}
 	}
 
+	rowSurface.free();
+
 	// Read additional data at the end.
 	png_read_end(pngPtr, NULL);
 
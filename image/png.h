@@ -67,8 +67,47 @@ public:
 	uint32 getTransparentColor() const override { return _transparentColor; }
 	void setSkipSignature(bool skip) { _skipSignature = skip; }
 	void setKeepTransparencyPaletted(bool keep) { _keepTransparencyPaletted = keep; }
+
+	/**
+	 * Request the pixel format of the decoded image, which has to have 2 or
+	 * 4 bytes per pixel.
+	 *
+	 * The conversion happens while decoding: libpng writes the rows straight
+	 * in 32-bit formats with 8-bit channels, and they are converted one at
+	 * a time for the others. Paletted images are converted as well, so
+	 * there is no palette afterwards.
+	 *
+	 * By default, paletted images stay paletted and the others are
+	 * decoded in RGB(A) byte order.
+	 *
+	 * @return Whether the format is supported.
+	 */
+	bool setOutputPixelFormat(const Graphics::PixelFormat &format);
+
+	/**
+	 * Callback receiving a decoded row of the image.
+	 *
+	 * @param row     Surface with the single row, in the output pixel format.
+	 * @param y       Index of the row. The rows come in order from the top.
+	 * @param height  Height of the image.
+	 * @param refCon  Arbitrary void pointer passed to loadStreamRows().
+	 */
+	typedef void (*RowProc)(const Graphics::Surface &row, int y, int height, void *refCon);
+
+	/**
+	 * Load an image and hand it to a callback row by row, instead of
+	 * keeping it in a surface. This saves a copy when the caller stores the
+	 * image in a buffer of its own.
+	 *
+	 * The palette and transparent color are set before the first row,
+	 * while getSurface() returns nullptr afterwards. Interlaced images are
+	 * still decoded into a temporary surface first.
+	 */
+	bool loadStreamRows(Common::SeekableReadStream &stream, RowProc proc, void *refCon);
+
 private:
 	Graphics::PixelFormat getByteOrderRgbaPixelFormat(bool isAlpha) const;
+	bool decode(Common::SeekableReadStream &stream, RowProc proc, void *refCon);
 
 	byte *_palette;
 	uint16 _paletteColorCount;
@@ -81,6 +120,9 @@ private:
 	bool _hasTransparentColor;
 	uint32 _transparentColor;
 
+	// Requested output format, or bytesPerPixel 0 for the default
+	Graphics::PixelFormat _outputPixelFormat;
+
 	Graphics::Surface *_outputSurface;
 };
 
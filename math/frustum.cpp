@@ -20,6 +20,7 @@
  */
 
 #include "math/frustum.h"
+#include "math/kernels.h"
 
 namespace Math {
 
@@ -89,6 +90,10 @@ bool Frustum::isInside(const Math::AABB &aabb) const {
 	return true;
 }
 
+void Frustum::isInside(const Math::AABB *aabbs, uint count, bool *inside) const {
+	cullBoxes(inside, aabbs, count, _planes, ARRAYSIZE(_planes));
+}
+
 bool Frustum::isTriangleInside(const Math::Vector3d &v0, const Math::Vector3d &v1, const Math::Vector3d &v2) const {
 	for (int i = 0; i < 6; ++i) {
 		const Plane &plane = _planes[i];
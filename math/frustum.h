@@ -35,6 +35,8 @@ public:
 
 	void setup(const Math::Matrix4 &matrix);
 	bool isInside(const Math::AABB &aabb) const;
+	/** Check @p count boxes at once, storing whether each is inside in @p inside. */
+	void isInside(const Math::AABB *aabbs, uint count, bool *inside) const;
 	bool isTriangleInside(const Math::Vector3d &v0, const Math::Vector3d &v1, const Math::Vector3d &v2) const;
 
 private:
@@ -0,0 +1,150 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/system.h"
+
+#include "math/kernels.h"
+
+namespace Math {
+
+// The kernels treat matrices and quaternions as plain arrays of floats
+STATIC_ASSERT(sizeof(Matrix4) == 16 * sizeof(float), Matrix4_is_not_packed);
+STATIC_ASSERT(sizeof(Quaternion) == 4 * sizeof(float), Quaternion_is_not_packed);
+STATIC_ASSERT(sizeof(Vector3d) == 3 * sizeof(float), Vector3d_is_not_packed);
+
+void transformPointsGeneric(Vector3d *dst, const Vector3d *src, const Matrix4 &matrix, uint count, bool translate) {
+	for (uint i = 0; i < count; i++) {
+		dst[i] = src[i];
+		matrix.transform(&dst[i], translate);
+	}
+}
+
+void multiplyMatricesGeneric(Matrix4 *dst, const Matrix4 *lhs, const Matrix4 *rhs, uint count) {
+	for (uint i = 0; i < count; i++)
+		dst[i] = lhs[i] * rhs[i];
+}
+
+void composeHierarchyGeneric(Matrix4 *world, const Matrix4 *local, const int *parents, uint count) {
+	for (uint i = 0; i < count; i++) {
+		if (parents[i] >= 0)
+			world[i] = world[parents[i]] * local[i];
+		else
+			world[i] = local[i];
+	}
+}
+
+void multiplyQuaternionsGeneric(Quaternion *dst, const Quaternion *lhs, const Quaternion *rhs, uint count) {
+	for (uint i = 0; i < count; i++)
+		dst[i] = lhs[i] * rhs[i];
+}
+
+void slerpQuaternionsGeneric(Quaternion *dst, const Quaternion *from, const Quaternion *to, const float *t, uint count) {
+	for (uint i = 0; i < count; i++)
+		dst[i] = from[i].slerpQuat(to[i], t[i]);
+}
+
+void cullBoxesGeneric(bool *inside, const AABB *boxes, uint count, const Plane *planes, uint numPlanes) {
+	for (uint i = 0; i < count; i++) {
+		const Vector3d min = boxes[i].getMin();
+		const Vector3d max = boxes[i].getMax();
+
+		inside[i] = true;
+		for (uint j = 0; j < numPlanes; j++) {
+			const Plane &plane = planes[j];
+			Vector3d positive = min;
+
+			if (plane._normal.x() >= 0.0f)
+				positive.x() = max.x();
+			if (plane._normal.y() >= 0.0f)
+				positive.y() = max.y();
+			if (plane._normal.z() >= 0.0f)
+				positive.z() = max.z();
+
+			if (plane.getSignedDistance(positive) < 0.0f) {
+				inside[i] = false;
+				break;
+			}
+		}
+	}
+}
+
+namespace {
+
+struct Kernels {
+	TransformPointsFunc transformPoints;
+	MultiplyMatricesFunc multiplyMatrices;
+	ComposeHierarchyFunc composeHierarchy;
+	MultiplyQuaternionsFunc multiplyQuaternions;
+	SlerpQuaternionsFunc slerpQuaternions;
+	CullBoxesFunc cullBoxes;
+
+	Kernels() {
+		transformPoints = transformPointsGeneric;
+		multiplyMatrices = multiplyMatricesGeneric;
+		composeHierarchy = composeHierarchyGeneric;
+		multiplyQuaternions = multiplyQuaternionsGeneric;
+		slerpQuaternions = slerpQuaternionsGeneric;
+		cullBoxes = cullBoxesGeneric;
+#ifdef SCUMMVM_SSE2
+		if (g_system && g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+			transformPoints = transformPointsSSE2;
+			multiplyMatrices = multiplyMatricesSSE2;
+			composeHierarchy = composeHierarchySSE2;
+			multiplyQuaternions = multiplyQuaternionsSSE2;
+			slerpQuaternions = slerpQuaternionsSSE2;
+			cullBoxes = cullBoxesSSE2;
+		}
+#endif
+	}
+};
+
+const Kernels &getKernels() {
+	static const Kernels kernels;
+	return kernels;
+}
+
+} // End of anonymous namespace
+
+void transformPoints(Vector3d *dst, const Vector3d *src, const Matrix4 &matrix, uint count, bool translate) {
+	getKernels().transformPoints(dst, src, matrix, count, translate);
+}
+
+void multiplyMatrices(Matrix4 *dst, const Matrix4 *lhs, const Matrix4 *rhs, uint count) {
+	getKernels().multiplyMatrices(dst, lhs, rhs, count);
+}
+
+void composeHierarchy(Matrix4 *world, const Matrix4 *local, const int *parents, uint count) {
+	getKernels().composeHierarchy(world, local, parents, count);
+}
+
+void multiplyQuaternions(Quaternion *dst, const Quaternion *lhs, const Quaternion *rhs, uint count) {
+	getKernels().multiplyQuaternions(dst, lhs, rhs, count);
+}
+
+void slerpQuaternions(Quaternion *dst, const Quaternion *from, const Quaternion *to, const float *t, uint count) {
+	getKernels().slerpQuaternions(dst, from, to, t, count);
+}
+
+void cullBoxes(bool *inside, const AABB *boxes, uint count, const Plane *planes, uint numPlanes) {
+	getKernels().cullBoxes(inside, boxes, count, planes, numPlanes);
+}
+
+} // End of namespace Math
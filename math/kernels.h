@@ -0,0 +1,120 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MATH_KERNELS_H
+#define MATH_KERNELS_H
+
+#include "common/scummsys.h"
+
+#include "math/aabb.h"
+#include "math/matrix4.h"
+#include "math/plane.h"
+#include "math/quat.h"
+
+namespace Math {
+
+/**
+ * @defgroup math_kernels Batch kernels
+ * @ingroup math
+ *
+ * @brief Operations on arrays of vectors, matrices, quaternions and
+ * bounding boxes, as needed to animate, transform and cull 3D models.
+ *
+ * Working on whole arrays lets the kernels use vector instructions when the
+ * CPU supports them. The entry points pick the best implementation for the
+ * running CPU; the variants are exposed so that they can be tested against
+ * the generic ones. Unless noted otherwise, all variants give exactly the
+ * same results as the scalar operations they replace.
+ * @{
+ */
+
+/**
+ * Transform @p count points, so that dst[i] is src[i] after
+ * matrix.transform(&src[i], translate). @p dst may be the same array as @p src.
+ */
+void transformPoints(Vector3d *dst, const Vector3d *src, const Matrix4 &matrix, uint count, bool translate);
+
+/**
+ * Multiply @p count pairs of matrices, so that dst[i] = lhs[i] * rhs[i].
+ * @p dst may be the same array as @p lhs or @p rhs.
+ */
+void multiplyMatrices(Matrix4 *dst, const Matrix4 *lhs, const Matrix4 *rhs, uint count);
+
+/**
+ * Compose the local transforms of a hierarchy of @p count joints, so that
+ * world[i] = world[parents[i]] * local[i], or local[i] for a joint without
+ * parent (parents[i] < 0). Joints are composed in order, so each parent must
+ * come before its children.
+ */
+void composeHierarchy(Matrix4 *world, const Matrix4 *local, const int *parents, uint count);
+
+/**
+ * Multiply @p count pairs of quaternions, so that dst[i] = lhs[i] * rhs[i].
+ * @p dst may be the same array as @p lhs or @p rhs.
+ */
+void multiplyQuaternions(Quaternion *dst, const Quaternion *lhs, const Quaternion *rhs, uint count);
+
+/**
+ * Interpolate @p count pairs of quaternions, so that
+ * dst[i] = from[i].slerpQuat(to[i], t[i]). @p dst may be the same array as
+ * @p from or @p to.
+ *
+ * The vectorized variants approximate the trigonometric functions, with an
+ * error below 1e-6 for weights between 0 and 1.
+ */
+void slerpQuaternions(Quaternion *dst, const Quaternion *from, const Quaternion *to, const float *t, uint count);
+
+/**
+ * Check whether @p count boxes are at least partly in front of all of the
+ * @p numPlanes planes, e.g. inside a frustum, and store the results in
+ * @p inside. A box counts as outside if its corner furthest along the normal
+ * of a plane is behind it, as in Frustum::isInside().
+ */
+void cullBoxes(bool *inside, const AABB *boxes, uint count, const Plane *planes, uint numPlanes);
+
+typedef void (*TransformPointsFunc)(Vector3d *dst, const Vector3d *src, const Matrix4 &matrix, uint count, bool translate);
+typedef void (*MultiplyMatricesFunc)(Matrix4 *dst, const Matrix4 *lhs, const Matrix4 *rhs, uint count);
+typedef void (*ComposeHierarchyFunc)(Matrix4 *world, const Matrix4 *local, const int *parents, uint count);
+typedef void (*MultiplyQuaternionsFunc)(Quaternion *dst, const Quaternion *lhs, const Quaternion *rhs, uint count);
+typedef void (*SlerpQuaternionsFunc)(Quaternion *dst, const Quaternion *from, const Quaternion *to, const float *t, uint count);
+typedef void (*CullBoxesFunc)(bool *inside, const AABB *boxes, uint count, const Plane *planes, uint numPlanes);
+
+void transformPointsGeneric(Vector3d *dst, const Vector3d *src, const Matrix4 &matrix, uint count, bool translate);
+void multiplyMatricesGeneric(Matrix4 *dst, const Matrix4 *lhs, const Matrix4 *rhs, uint count);
+void composeHierarchyGeneric(Matrix4 *world, const Matrix4 *local, const int *parents, uint count);
+void multiplyQuaternionsGeneric(Quaternion *dst, const Quaternion *lhs, const Quaternion *rhs, uint count);
+void slerpQuaternionsGeneric(Quaternion *dst, const Quaternion *from, const Quaternion *to, const float *t, uint count);
+void cullBoxesGeneric(bool *inside, const AABB *boxes, uint count, const Plane *planes, uint numPlanes);
+
+#ifdef SCUMMVM_SSE2
+void transformPointsSSE2(Vector3d *dst, const Vector3d *src, const Matrix4 &matrix, uint count, bool translate);
+void multiplyMatricesSSE2(Matrix4 *dst, const Matrix4 *lhs, const Matrix4 *rhs, uint count);
+void composeHierarchySSE2(Matrix4 *world, const Matrix4 *local, const int *parents, uint count);
+void multiplyQuaternionsSSE2(Quaternion *dst, const Quaternion *lhs, const Quaternion *rhs, uint count);
+void slerpQuaternionsSSE2(Quaternion *dst, const Quaternion *from, const Quaternion *to, const float *t, uint count);
+void cullBoxesSSE2(bool *inside, const AABB *boxes, uint count, const Plane *planes, uint numPlanes);
+#endif
+
+/** @} */
+
+} // End of namespace Math
+
+#endif
@@ -0,0 +1,255 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include <immintrin.h>
+
+#include "math/kernels.h"
+
+namespace Math {
+
+namespace {
+
+/**
+ * Multiply two row-major 4x4 matrices. The products are summed in the same
+ * order as Matrix4::operator*, so that the results are identical. @p r may
+ * point to @p a or @p b.
+ */
+static inline void multiply(float *r, const float *a, const float *b) {
+	const __m128 b0 = _mm_loadu_ps(b + 0);
+	const __m128 b1 = _mm_loadu_ps(b + 4);
+	const __m128 b2 = _mm_loadu_ps(b + 8);
+	const __m128 b3 = _mm_loadu_ps(b + 12);
+
+	for (int i = 0; i < 16; i += 4) {
+		__m128 row = _mm_mul_ps(_mm_set1_ps(a[i + 0]), b0);
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 1]), b1));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 2]), b2));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 3]), b3));
+		_mm_storeu_ps(r + i, row);
+	}
+}
+
+/** Evaluate acos(x) for four values between 0 and 1 (Abramowitz and Stegun 4.4.46). */
+static inline __m128 acos01(__m128 x) {
+	__m128 p = _mm_set1_ps(-0.0012624911f);
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(0.0066700901f));
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(-0.0170881256f));
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(0.0308918810f));
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(-0.0501743046f));
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(0.0889789874f));
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(-0.2145988016f));
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(1.5707963050f));
+	return _mm_mul_ps(p, _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), x)));
+}
+
+/** Evaluate sin(x) for four values between 0 and pi/2. */
+static inline __m128 sin0pi2(__m128 x) {
+	const __m128 x2 = _mm_mul_ps(x, x);
+	__m128 p = _mm_set1_ps(-1.0f / 39916800.0f);
+	p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(1.0f / 362880.0f));
+	p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(-1.0f / 5040.0f));
+	p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(1.0f / 120.0f));
+	p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(-1.0f / 6.0f));
+	p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(1.0f));
+	return _mm_mul_ps(p, x);
+}
+
+static inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/** Load four quaternions and transpose them, so that each vector holds the same component of all four. */
+static inline void loadQuaternions(const Quaternion *q, __m128 &x, __m128 &y, __m128 &z, __m128 &w) {
+	x = _mm_loadu_ps(q[0].getData());
+	y = _mm_loadu_ps(q[1].getData());
+	z = _mm_loadu_ps(q[2].getData());
+	w = _mm_loadu_ps(q[3].getData());
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+}
+
+static inline void storeQuaternions(Quaternion *q, __m128 x, __m128 y, __m128 z, __m128 w) {
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+	_mm_storeu_ps(q[0].getData(), x);
+	_mm_storeu_ps(q[1].getData(), y);
+	_mm_storeu_ps(q[2].getData(), z);
+	_mm_storeu_ps(q[3].getData(), w);
+}
+
+/** Load one component of four boxes, taking it from the maximum or the minimum corner. */
+static inline __m128 loadBoxComponent(const AABB *boxes, int component, bool fromMax) {
+	float v[4];
+	for (int i = 0; i < 4; i++)
+		v[i] = fromMax ? boxes[i].getMax().getValue(component) : boxes[i].getMin().getValue(component);
+	return _mm_loadu_ps(v);
+}
+
+} // End of anonymous namespace
+
+void transformPointsSSE2(Vector3d *dst, const Vector3d *src, const Matrix4 &matrix, uint count, bool translate) {
+	const float *m = matrix.getData();
+
+	// The columns of the matrix, so that a point is transformed with one
+	// broadcast coordinate per column. The products are summed as in
+	// Matrix4::transform(), starting from zero.
+	__m128 c0 = _mm_loadu_ps(m + 0);
+	__m128 c1 = _mm_loadu_ps(m + 4);
+	__m128 c2 = _mm_loadu_ps(m + 8);
+	__m128 c3 = _mm_loadu_ps(m + 12);
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+	const __m128 w = _mm_set1_ps(translate ? 1.f : 0.f);
+	const __m128 wc3 = _mm_mul_ps(c3, w);
+
+	for (uint i = 0; i < count; i++) {
+		const float *p = src[i].getData();
+		__m128 r = _mm_add_ps(_mm_setzero_ps(), _mm_mul_ps(c0, _mm_set1_ps(p[0])));
+		r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(p[1])));
+		r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(p[2])));
+		r = _mm_add_ps(r, wc3);
+
+		float *d = dst[i].getData();
+		_mm_storel_pi((__m64 *)d, r);
+		_mm_store_ss(d + 2, _mm_movehl_ps(r, r));
+	}
+}
+
+void multiplyMatricesSSE2(Matrix4 *dst, const Matrix4 *lhs, const Matrix4 *rhs, uint count) {
+	for (uint i = 0; i < count; i++)
+		multiply(dst[i].getData(), lhs[i].getData(), rhs[i].getData());
+}
+
+void composeHierarchySSE2(Matrix4 *world, const Matrix4 *local, const int *parents, uint count) {
+	for (uint i = 0; i < count; i++) {
+		if (parents[i] >= 0)
+			multiply(world[i].getData(), world[parents[i]].getData(), local[i].getData());
+		else
+			world[i] = local[i];
+	}
+}
+
+void multiplyQuaternionsSSE2(Quaternion *dst, const Quaternion *lhs, const Quaternion *rhs, uint count) {
+	uint i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z, w, ox, oy, oz, ow;
+		loadQuaternions(lhs + i, x, y, z, w);
+		loadQuaternions(rhs + i, ox, oy, oz, ow);
+
+		// Summed in the same order as Quaternion::operator*()
+		__m128 rx = _mm_add_ps(_mm_mul_ps(w, ox), _mm_mul_ps(x, ow));
+		rx = _mm_sub_ps(_mm_add_ps(rx, _mm_mul_ps(y, oz)), _mm_mul_ps(z, oy));
+		__m128 ry = _mm_sub_ps(_mm_mul_ps(w, oy), _mm_mul_ps(x, oz));
+		ry = _mm_add_ps(_mm_add_ps(ry, _mm_mul_ps(y, ow)), _mm_mul_ps(z, ox));
+		__m128 rz = _mm_add_ps(_mm_mul_ps(w, oz), _mm_mul_ps(x, oy));
+		rz = _mm_add_ps(_mm_sub_ps(rz, _mm_mul_ps(y, ox)), _mm_mul_ps(z, ow));
+		__m128 rw = _mm_sub_ps(_mm_mul_ps(w, ow), _mm_mul_ps(x, ox));
+		rw = _mm_sub_ps(_mm_sub_ps(rw, _mm_mul_ps(y, oy)), _mm_mul_ps(z, oz));
+
+		storeQuaternions(dst + i, rx, ry, rz, rw);
+	}
+
+	multiplyQuaternionsGeneric(dst + i, lhs + i, rhs + i, count - i);
+}
+
+void slerpQuaternionsSSE2(Quaternion *dst, const Quaternion *from, const Quaternion *to, const float *t, uint count) {
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+
+	uint i = 0;
+	// Four interpolations at a time, with the components transposed so that
+	// each vector holds the same component of four quaternions
+	for (; i + 4 <= count; i += 4) {
+		const __m128 weight = _mm_loadu_ps(t + i);
+
+		// The approximation of sin() only covers the range needed for weights between 0 and 1
+		if (_mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(weight, zero), _mm_cmpgt_ps(weight, one))) != 0) {
+			slerpQuaternionsGeneric(dst + i, from + i, to + i, t + i, 4);
+			continue;
+		}
+
+		__m128 fx, fy, fz, fw, tx, ty, tz, tw;
+		loadQuaternions(from + i, fx, fy, fz, fw);
+		loadQuaternions(to + i, tx, ty, tz, tw);
+
+		// Summed in the same order as Quaternion::dotProduct()
+		__m128 angle = _mm_mul_ps(fx, tx);
+		angle = _mm_add_ps(angle, _mm_mul_ps(fy, ty));
+		angle = _mm_add_ps(angle, _mm_mul_ps(fz, tz));
+		angle = _mm_add_ps(angle, _mm_mul_ps(fw, tw));
+
+		// Make sure the rotation is the short one
+		const __m128 flip = _mm_and_ps(_mm_cmplt_ps(angle, zero), signMask);
+		angle = _mm_xor_ps(angle, flip);
+
+		// Spherical interpolation, unless the quaternions are too close
+		const __m128 spherical = _mm_cmplt_ps(angle, _mm_set1_ps(1.0f - 1E-6f));
+		const __m128 theta = acos01(_mm_and_ps(spherical, angle));
+		const __m128 invSineTheta = _mm_div_ps(one, select(spherical, sin0pi2(theta), one));
+		const __m128 invWeight = _mm_sub_ps(one, weight);
+
+		__m128 scale0 = _mm_mul_ps(sin0pi2(_mm_mul_ps(invWeight, theta)), invSineTheta);
+		__m128 scale1 = _mm_mul_ps(sin0pi2(_mm_mul_ps(weight, theta)), invSineTheta);
+		scale0 = select(spherical, scale0, invWeight);
+		scale1 = _mm_xor_ps(select(spherical, scale1, weight), flip);
+
+		storeQuaternions(dst + i,
+		                 _mm_add_ps(_mm_mul_ps(fx, scale0), _mm_mul_ps(tx, scale1)),
+		                 _mm_add_ps(_mm_mul_ps(fy, scale0), _mm_mul_ps(ty, scale1)),
+		                 _mm_add_ps(_mm_mul_ps(fz, scale0), _mm_mul_ps(tz, scale1)),
+		                 _mm_add_ps(_mm_mul_ps(fw, scale0), _mm_mul_ps(tw, scale1)));
+	}
+
+	slerpQuaternionsGeneric(dst + i, from + i, to + i, t + i, count - i);
+}
+
+void cullBoxesSSE2(bool *inside, const AABB *boxes, uint count, const Plane *planes, uint numPlanes) {
+	const __m128 zero = _mm_setzero_ps();
+
+	uint i = 0;
+	// Four boxes at a time against each plane
+	for (; i + 4 <= count; i += 4) {
+		__m128 outside = zero;
+		for (uint j = 0; j < numPlanes; j++) {
+			const Plane &plane = planes[j];
+
+			// The corner furthest along the normal, summed as in Plane::getSignedDistance()
+			const __m128 px = loadBoxComponent(boxes + i, 0, plane._normal.x() >= 0.0f);
+			const __m128 py = loadBoxComponent(boxes + i, 1, plane._normal.y() >= 0.0f);
+			const __m128 pz = loadBoxComponent(boxes + i, 2, plane._normal.z() >= 0.0f);
+			__m128 dist = _mm_mul_ps(_mm_set1_ps(plane._normal.x()), px);
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane._normal.y()), py));
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane._normal.z()), pz));
+			dist = _mm_add_ps(dist, _mm_set1_ps(plane._d));
+
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, zero));
+			if (_mm_movemask_ps(outside) == 0xf)
+				break;
+		}
+
+		const int mask = _mm_movemask_ps(outside);
+		for (int k = 0; k < 4; k++)
+			inside[i + k] = (mask & (1 << k)) == 0;
+	}
+
+	cullBoxesGeneric(inside + i, boxes + i, count - i, planes, numPlanes);
+}
+
+} // End of namespace Math
@@ -8,6 +8,7 @@ MODULE_OBJS := \
 	fft.o \
 	frustum.o \
 	glmath.o \
+	kernels.o \
 	line2d.o \
 	line3d.o \
 	matrix3.o \
@@ -24,5 +25,11 @@ MODULE_OBJS := \
 	vector3d.o \
 	vector4d.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	kernels_sse2.o
+$(MODULE)/kernels_sse2.o: CXXFLAGS += -msse2
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
@@ -0,0 +1,106 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer_intern.h"
+#include "audio/softsynth/fmtowns_pc98/towns_pc98_fmsynth.h"
+
+#include "common/debug.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class FMTownsTestSuite : public CxxTest::TestSuite
+{
+	static const int kRate = 44100;
+	static const uint kBufferLength = 512;
+
+	class TestSynth : public TownsPC98_FmSynth {
+	public:
+		TestSynth(Audio::Mixer *mixer, EmuType type) : TownsPC98_FmSynth(mixer, type) {}
+
+	protected:
+		void timerCallbackA() override {}
+		void timerCallbackB() override {}
+	};
+
+	// Plays notes with all algorithms on all channels and, if there are
+	// any, a tone on the SSG channels, and returns a checksum of the output
+	static uint32 playNotes(TownsPC98_FmSynth::EmuType type, uint rounds) {
+		Audio::MixerImpl mixer(kRate);
+		mixer.setReady(true);
+		TestSynth synth(&mixer, type);
+		synth.init();
+
+		uint32 checksum = 0;
+		const int numChan = (type == TownsPC98_FmSynth::kType26) ? 3 : 6;
+		for (uint round = 0; round < rounds; round++) {
+			for (int ch = 0; ch < numChan; ch++) {
+				const uint8 part = ch / 3;
+				const uint8 c = ch % 3;
+				for (int op = 0; op < 4; op++) {
+					const uint8 r = c + op * 4;
+					synth.writeReg(part, 0x30 + r, ((ch + op) & 7) << 4 | ((round + op) & 0x0f));
+					synth.writeReg(part, 0x40 + r, op == 3 ? 0x08 : 0x18 + ch * 4);
+					synth.writeReg(part, 0x50 + r, 0x1f - op - ((round & 1) << 3));
+					synth.writeReg(part, 0x60 + r, 0x08 + ch);
+					synth.writeReg(part, 0x70 + r, 0x04 + op);
+					synth.writeReg(part, 0x80 + r, 0x37 + op * 0x10);
+					synth.writeReg(part, 0x90 + r, (round & 2) ? 0x08 | (op & 7) : 0);
+				}
+				synth.writeReg(part, 0xb0 + c, ((ch + round) & 7) << 3 | ((ch + round) & 7));
+				synth.writeReg(part, 0xb4 + c, 0xc0 >> (ch & 1) >> (round & 1));
+				synth.writeReg(part, 0xa4 + c, 0x18 + (round & 0x7) + ch);
+				synth.writeReg(part, 0xa0 + c, (round * 37 + ch * 50) & 0xff);
+				synth.writeReg(0, 0x28, 0xf0 | (part << 2) | c);
+			}
+
+			synth.writeReg(0, 0x00, (round * 29) & 0xff);
+			synth.writeReg(0, 0x01, round & 0x0f);
+			synth.writeReg(0, 0x07, 0x3e);
+			synth.writeReg(0, 0x08, (round & 4) ? 0x0c : 0x00);
+
+			int16 buffer[kBufferLength * 2];
+			for (int block = 0; block < 20; block++) {
+				synth.readBuffer(buffer, kBufferLength * 2);
+				for (uint i = 0; i < kBufferLength * 2; i++)
+					checksum = checksum * 31 + (uint16)buffer[i];
+			}
+
+			// Release some of the notes
+			if (round % 3 == 0) {
+				for (int ch = 0; ch < numChan; ch++)
+					synth.writeReg(0, 0x28, ((ch / 3) << 2) | (ch % 3));
+			}
+		}
+
+		return checksum;
+	}
+
+public:
+	void test_output() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The mixer and the synth need mutexes
+		Common::install_null_g_system();
+
+		// Changes to the emulator must not change what it sounds like
+		TS_ASSERT_EQUALS(playNotes(TownsPC98_FmSynth::kTypeTowns, 12), 3308142303u);
+		TS_ASSERT_EQUALS(playNotes(TownsPC98_FmSynth::kType26, 12), 3792569244u);
+		TS_ASSERT_EQUALS(playNotes(TownsPC98_FmSynth::kType86, 12), 1066170011u);
+#endif
+	}
+
+	void test_benchmark() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const uint rounds = 50;
+		const uint samples = rounds * 20 * kBufferLength;
+		static const char *const names[] = { "FM-Towns", "PC-98 type 26", "PC-98 type 86" };
+		for (int type = 0; type < 3; type++) {
+			uint32 start = g_system->getMillis();
+			playNotes((TownsPC98_FmSynth::EmuType)type, rounds);
+			uint32 time = MAX<uint32>(g_system->getMillis() - start, 1);
+			debug("%s FM synth: %u samples in %u ms, %u samples per second\n", names[type], samples, time, (uint)((uint64)samples * 1000 / time));
+		}
+#endif
+	}
+};
@@ -0,0 +1,166 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/opl/dbopl.h"
+#include "audio/softsynth/opl/mame.h"
+#include "audio/softsynth/opl/nuked.h"
+
+#include "common/debug.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class OPLTestSuite : public CxxTest::TestSuite
+{
+	static const int kRate = 44100;
+	static const uint kBufferLength = 512;
+
+	// Plays notes with various instruments on all nine channels, calling
+	// generate() between the register writes
+	template<class Write, class Generate>
+	static void playNotes(Write write, Generate generate, uint rounds) {
+		static const byte offsets[9] = { 0, 1, 2, 8, 9, 10, 16, 17, 18 };
+
+		write(0x01, 0x20);
+		for (uint round = 0; round < rounds; round++) {
+			for (uint ch = 0; ch < 9; ch++) {
+				const byte op = offsets[ch];
+				write(0x20 + op, 0x21 | ((round & 1) << 7) | ((ch & 1) << 6));
+				write(0x23 + op, 0x21 | ((round & 2) << 4));
+				write(0x40 + op, 0x10 + ch);
+				write(0x43 + op, 0x00);
+				write(0x60 + op, 0xf2 - ch);
+				write(0x63 + op, 0xf4);
+				write(0x80 + op, 0x77);
+				write(0x83 + op, 0x37 + ch);
+				write(0xe0 + op, ch & 3);
+				write(0xe3 + op, (ch + round) & 3);
+				write(0xc0 + ch, (ch & 1) | ((ch % 7) << 1));
+				write(0xa0 + ch, (round * 37 + ch * 50) & 0xff);
+				write(0xb0 + ch, 0x20 | ((ch + round) & 0x1f));
+			}
+			write(0xbd, (round & 4) ? 0xc0 : 0x00);
+
+			generate(20);
+
+			// Release some of the notes
+			if (round % 3 == 0) {
+				for (uint ch = 0; ch < 9; ch++)
+					write(0xb0 + ch, 0);
+			}
+		}
+	}
+
+#ifndef DISABLE_DOSBOX_OPL
+	struct DOSBoxWrite {
+		OPL::DOSBox::DBOPL::Chip *chip;
+		void operator()(uint reg, byte val) const { chip->WriteReg(reg, val); }
+	};
+
+	struct DOSBoxGenerate {
+		OPL::DOSBox::DBOPL::Chip *chip;
+		uint32 *checksum;
+		void operator()(uint blocks) const {
+			int32 buffer[kBufferLength];
+			for (uint i = 0; i < blocks; i++) {
+				chip->GenerateBlock2(kBufferLength, buffer);
+				for (uint j = 0; j < kBufferLength; j++)
+					*checksum = *checksum * 31 + (uint32)buffer[j];
+			}
+		}
+	};
+
+	static uint32 playDOSBox(uint rounds) {
+		OPL::DOSBox::DBOPL::InitTables();
+		OPL::DOSBox::DBOPL::Chip chip;
+		chip.Setup(kRate);
+
+		uint32 checksum = 0;
+		DOSBoxWrite write = { &chip };
+		DOSBoxGenerate generate = { &chip, &checksum };
+		playNotes(write, generate, rounds);
+		return checksum;
+	}
+#endif
+
+	struct MAMEWrite {
+		OPL::MAME::FM_OPL *opl;
+		void operator()(uint reg, byte val) const { OPL::MAME::OPLWriteReg(opl, reg, val); }
+	};
+
+	struct MAMEGenerate {
+		OPL::MAME::FM_OPL *opl;
+		void operator()(uint blocks) const {
+			int16 buffer[kBufferLength];
+			for (uint i = 0; i < blocks; i++)
+				OPL::MAME::YM3812UpdateOne(opl, buffer, kBufferLength);
+		}
+	};
+
+#ifndef DISABLE_NUKED_OPL
+	struct NukedWrite {
+		OPL::NUKED::opl3_chip *chip;
+		void operator()(uint reg, byte val) const { OPL::NUKED::OPL3_WriteReg(chip, reg, val); }
+	};
+
+	struct NukedGenerate {
+		OPL::NUKED::opl3_chip *chip;
+		void operator()(uint blocks) const {
+			int16 buffer[kBufferLength * 2];
+			for (uint i = 0; i < blocks; i++)
+				OPL::NUKED::OPL3_GenerateStream(chip, buffer, kBufferLength);
+		}
+	};
+#endif
+
+public:
+	void test_dosbox_output() {
+#ifndef DISABLE_DOSBOX_OPL
+		// Changes to the emulator must not change what it sounds like
+		TS_ASSERT_EQUALS(playDOSBox(24), 3564291025u);
+#endif
+	}
+
+	void test_benchmark() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+		const uint rounds = 100;
+		const uint samples = rounds * 20 * kBufferLength;
+		uint32 start, time;
+
+#ifndef DISABLE_DOSBOX_OPL
+		start = g_system->getMillis();
+		playDOSBox(rounds);
+		time = MAX<uint32>(g_system->getMillis() - start, 1);
+		debug("DOSBox OPL: %u samples in %u ms, %u samples per second\n", samples, time, (uint)((uint64)samples * 1000 / time));
+#endif
+
+		OPL::MAME::FM_OPL *opl = OPL::MAME::makeAdLibOPL(kRate);
+		MAMEWrite mameWrite = { opl };
+		MAMEGenerate mameGenerate = { opl };
+		start = g_system->getMillis();
+		playNotes(mameWrite, mameGenerate, rounds);
+		time = MAX<uint32>(g_system->getMillis() - start, 1);
+		OPL::MAME::OPLDestroy(opl);
+		debug("MAME OPL: %u samples in %u ms, %u samples per second\n", samples, time, (uint)((uint64)samples * 1000 / time));
+
+#ifndef DISABLE_NUKED_OPL
+		OPL::NUKED::opl3_chip *chip = new OPL::NUKED::opl3_chip();
+		OPL::NUKED::OPL3_Reset(chip, kRate);
+		NukedWrite nukedWrite = { chip };
+		NukedGenerate nukedGenerate = { chip };
+		start = g_system->getMillis();
+		playNotes(nukedWrite, nukedGenerate, rounds);
+		time = MAX<uint32>(g_system->getMillis() - start, 1);
+		delete chip;
+		debug("Nuked OPL: %u samples in %u ms, %u samples per second\n", samples, time, (uint)((uint64)samples * 1000 / time));
+#endif
+#endif
+	}
+};
@@ -0,0 +1,67 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/prefetchingstream.h"
+
+#include "helper.h"
+#include "../null_osystem.h"
+
+class PrefetchingStreamTestSuite : public CxxTest::TestSuite
+{
+private:
+#if NULL_OSYSTEM_IS_AVAILABLE
+	void readTestTemplate(const bool isStereo, const uint msecs, const int chunkSize) {
+		// The stream decodes on the job system of g_system
+		Common::install_null_g_system();
+
+		const int sampleRate = 11025;
+		const int time = 2;
+		int16 *sine;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(sampleRate, time, &sine, false, isStereo);
+		Audio::PrefetchingAudioStream *prefetching = new Audio::PrefetchingAudioStream(s, msecs, DisposeAfterUse::YES);
+
+		TS_ASSERT_EQUALS(prefetching->isStereo(), isStereo);
+		TS_ASSERT_EQUALS(prefetching->getRate(), sampleRate);
+
+		const int totalSamples = sampleRate * time * (isStereo ? 2 : 1);
+		int16 *buffer = new int16[totalSamples + chunkSize];
+
+		// Read in small pieces, so that the ring buffer wraps around
+		int samples = 0;
+		while (!prefetching->endOfData()) {
+			const int read = prefetching->readBuffer(buffer + samples, chunkSize);
+			TS_ASSERT(read > 0);
+			if (read <= 0)
+				break;
+			samples += read;
+		}
+
+		TS_ASSERT_EQUALS(samples, totalSamples);
+		TS_ASSERT_EQUALS(memcmp(sine, buffer, sizeof(int16) * totalSamples), 0);
+		TS_ASSERT(prefetching->endOfStream());
+		TS_ASSERT_EQUALS(prefetching->readBuffer(buffer, chunkSize), 0);
+
+		delete[] sine;
+		delete[] buffer;
+		delete prefetching;
+	}
+#endif
+
+public:
+	void test_read_mono() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		readTestTemplate(false, 100, 300);
+#endif
+	}
+
+	void test_read_stereo() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		readTestTemplate(true, 100, 512);
+#endif
+	}
+
+	void test_read_bigger_than_buffer() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		readTestTemplate(false, 10, 5000);
+#endif
+	}
+};
@@ -0,0 +1,151 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "audio/decoders/raw.h"
+#include "audio/audiostream.h"
+#include "audio/rate_intern.h"
+
+#include "common/endian.h"
+#include "common/system.h"
+#include "../null_osystem.h"
+
+class RateTestSuite : public CxxTest::TestSuite
+{
+	template<bool inStereo, bool outStereo, bool reverseStereo>
+	void checkMixFrames(Audio::MixFramesFunc func, const char *name) {
+		// Odd frame counts, so that both the vector loops and the tails are used
+		const uint frames = 75;
+		Audio::st_sample_t in[frames * 2], expected[frames * 2], out[frames * 2];
+		Audio::st_sample_t base[frames * 2];
+
+		uint32 seed = 4711;
+		for (uint i = 0; i < frames * 2; i++) {
+			seed = seed * 1103515245 + 12345;
+			in[i] = (Audio::st_sample_t)(seed >> 16);
+			seed = seed * 1103515245 + 12345;
+			base[i] = (Audio::st_sample_t)(seed >> 16);
+		}
+		// Make sure clamping happens in both directions
+		in[0] = in[1] = base[0] = base[1] = 32767;
+		in[2] = in[3] = base[2] = base[3] = -32768;
+
+		const Audio::st_volume_t volumes[][2] = {
+			{ 256, 256 }, { 256, 0 }, { 0, 255 }, { 128, 77 }, { 1, 3 }, { 300, 1000 }
+		};
+
+		for (uint v = 0; v < ARRAYSIZE(volumes); v++) {
+			for (uint count = 0; count <= frames; count += 25) {
+				memcpy(expected, base, sizeof(base));
+				memcpy(out, base, sizeof(base));
+				Audio::mixFramesGeneric<inStereo, outStereo, reverseStereo>(expected, in, count, volumes[v][0], volumes[v][1]);
+				func(out, in, count, volumes[v][0], volumes[v][1]);
+				TSM_ASSERT(name, memcmp(out, expected, sizeof(out)) == 0);
+			}
+		}
+	}
+
+	template<bool inStereo, bool outStereo, bool reverseStereo>
+	void checkAllMixFrames() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkMixFrames<inStereo, outStereo, reverseStereo>(Audio::mixFramesSSE2<inStereo, outStereo, reverseStereo>, "SSE2");
+#endif
+#ifdef SCUMMVM_NEON
+		checkMixFrames<inStereo, outStereo, reverseStereo>(Audio::mixFramesNEON<inStereo, outStereo, reverseStereo>, "NEON");
+#endif
+	}
+
+	void checkSincFilter(Audio::SincFilterFunc func, const char *name) {
+		const uint count = 99;
+		Audio::st_sample_t in[400], expected[count * 2], out[count * 2];
+
+		uint32 seed = 1234;
+		for (uint i = 0; i < ARRAYSIZE(in); i++) {
+			seed = seed * 1103515245 + 12345;
+			in[i] = (Audio::st_sample_t)(seed >> 16);
+		}
+		// Full scale square waves overshoot, so the results get clamped
+		for (uint i = 0; i < 32; i++)
+			in[i] = (i & 4) ? 32767 : -32768;
+
+		const Audio::st_rate_t rates[][2] = {
+			{ 11025, 44100 }, { 22050, 48000 }, { 44100, 22050 }, { 8000, 8000 }
+		};
+
+		for (uint r = 0; r < ARRAYSIZE(rates); r++) {
+			const Audio::SincFilter filter(rates[r][0], rates[r][1]);
+			const uint64 step = ((uint64)rates[r][0] << 32) / rates[r][1];
+
+			memset(expected, 0, sizeof(expected));
+			memset(out, 0, sizeof(out));
+			Audio::sincFilterGeneric(expected, 2, in, count, 0x12345678, step, filter);
+			func(out, 2, in, count, 0x12345678, step, filter);
+			TSM_ASSERT(name, memcmp(out, expected, sizeof(out)) == 0);
+		}
+	}
+
+	public:
+	void test_mix_frames() {
+		checkAllMixFrames<true, true, true>();
+		checkAllMixFrames<true, true, false>();
+		checkAllMixFrames<true, false, false>();
+		checkAllMixFrames<false, true, false>();
+		checkAllMixFrames<false, false, false>();
+	}
+
+	void test_sinc_filter() {
+		checkSincFilter(Audio::sincFilterGeneric, "Generic");
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkSincFilter(Audio::sincFilterSSE2, "SSE2");
+#endif
+#ifdef SCUMMVM_NEON
+		checkSincFilter(Audio::sincFilterNEON, "NEON");
+#endif
+	}
+
+	void test_sinc_converter() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The filters are built on construction, and their cache needs mutexes
+		Common::install_null_g_system();
+
+		// A constant signal has to come out unchanged, at any ratio
+		const Audio::st_rate_t rates[][2] = {
+			{ 11025, 44100 }, { 22050, 44100 }, { 11025, 48000 }, { 48000, 44100 }, { 44100, 44100 }
+		};
+		const uint inFrames = 1000;
+
+		for (uint r = 0; r < ARRAYSIZE(rates); r++) {
+			byte *data = (byte *)malloc(inFrames * 2);
+			for (uint i = 0; i < inFrames; i++)
+				WRITE_LE_UINT16(data + i * 2, 1000);
+			Audio::AudioStream *stream = Audio::makeRawStream(data, inFrames * 2, rates[r][0], Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN);
+			Audio::RateConverter *converter = Audio::makeRateConverter(rates[r][0], rates[r][1], false, false, false, Audio::kRateConverterSinc);
+
+			const uint outFrames = (uint)((uint64)inFrames * rates[r][1] / rates[r][0]);
+			Audio::st_sample_t *out = new Audio::st_sample_t[outFrames + 64]();
+			uint total = 0;
+			while (!stream->endOfData() || converter->needsDraining()) {
+				const int res = converter->convert(*stream, out + total, MIN<uint>(100, outFrames + 64 - total), Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+				TS_ASSERT(res > 0);
+				if (res <= 0)
+					break;
+				total += res;
+			}
+
+			// Every input frame produces output, up to one frame of rounding
+			TS_ASSERT_LESS_THAN_EQUALS(outFrames, total + 1);
+			TS_ASSERT_LESS_THAN_EQUALS(total, outFrames + 1);
+
+			// Away from the edges, where the filter sees the surrounding silence
+			const uint margin = 8 * rates[r][1] / rates[r][0] + 1;
+			for (uint i = margin; i + margin < total; i++)
+				TS_ASSERT_EQUALS(out[i], 1000);
+
+			delete[] out;
+			delete converter;
+			delete stream;
+		}
+#endif
+	}
+};
@@ -0,0 +1,82 @@
+#include "test/bench/benchmark.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/rate.h"
+
+class AudioBenchmarkSuite : public CxxTest::TestSuite {
+	static const uint kOutputRate = 44100;
+	static const uint kOutputFrames = 8192;
+
+	// Endless noise, so that every run converts the same amount
+	class NoiseStream : public Audio::AudioStream {
+	public:
+		NoiseStream(int rate, bool stereo) : _rate(rate), _stereo(stereo), _seed(4711) {}
+
+		int readBuffer(int16 *buffer, const int numSamples) override {
+			for (int i = 0; i < numSamples; i++) {
+				_seed = _seed * 1103515245 + 12345;
+				buffer[i] = (int16)(_seed >> 16) / 4;
+			}
+			return numSamples;
+		}
+
+		bool isStereo() const override { return _stereo; }
+		int getRate() const override { return _rate; }
+		bool endOfData() const override { return false; }
+
+	private:
+		int _rate;
+		bool _stereo;
+		uint32 _seed;
+	};
+
+	struct Convert {
+		Audio::RateConverter *converter;
+		Audio::AudioStream *input;
+		Audio::st_sample_t *out;
+		void operator()() const {
+			memset(out, 0, kOutputFrames * 2 * sizeof(Audio::st_sample_t));
+			converter->convert(*input, out, kOutputFrames, 200, 180);
+		}
+	};
+
+	// Runs a converter created with the portable kernels, and one created
+	// with the kernels selected from the CPU features
+	void runConverter(const char *name, uint inRate, bool inStereo, Audio::RateConverterType type) {
+		Audio::st_sample_t *out = new Audio::st_sample_t[kOutputFrames * 2];
+		NoiseStream input(inRate, inStereo);
+
+		// The native one goes first, as the filter cache needs g_system
+		// for its mutex
+		Audio::RateConverter *converters[2];
+		converters[1] = Audio::makeRateConverter(inRate, kOutputRate, inStereo, true, false, type);
+		{
+			Benchmark::GenericKernels generic;
+			converters[0] = Audio::makeRateConverter(inRate, kOutputRate, inStereo, true, false, type);
+		}
+
+		for (int native = 0; native < 2; native++) {
+			// The throughput is the one of the output
+			Convert convert = { converters[native], &input, out };
+			Benchmark::run(name, native ? "native" : "generic", kOutputFrames * 2 * sizeof(Audio::st_sample_t), convert);
+			delete converters[native];
+		}
+
+		delete[] out;
+	}
+
+public:
+	void setUp() {
+		Benchmark::timer();
+	}
+
+	void test_rateConverter() {
+		runConverter("rate_copy_44100_stereo", 44100, true, Audio::kRateConverterDefault);
+		runConverter("rate_linear_22050_mono", 22050, false, Audio::kRateConverterDefault);
+		runConverter("rate_linear_11025_stereo", 11025, true, Audio::kRateConverterDefault);
+		runConverter("rate_sinc_22050_mono", 22050, false, Audio::kRateConverterSinc);
+		runConverter("rate_sinc_48000_stereo", 48000, true, Audio::kRateConverterSinc);
+	}
+};
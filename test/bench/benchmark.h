@@ -0,0 +1,109 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TEST_BENCH_BENCHMARK_H
+#define TEST_BENCH_BENCHMARK_H
+
+// The results are printed to the standard output. This header has to be
+// included by the suites before any other header of ScummVM.
+#define FORBIDDEN_SYMBOL_EXCEPTION_printf
+
+#include "common/scummsys.h"
+#include "common/system.h"
+
+#include "test/null_osystem.h"
+
+/**
+ * Helpers for the micro-benchmarks run with "make bench".
+ *
+ * Each benchmark prints one line of comma separated values, below the
+ * header line printed by the runner:
+ *
+ *    name,variant,runs,us_per_run,mb_per_s
+ *
+ * The variant names the kernels which were used: "generic" for the portable
+ * ones, "native" for the ones the code selects from the CPU features, or the
+ * instruction set when a specific one was picked. The throughput is the
+ * amount of input processed per second, or 0 where it doesn't apply.
+ */
+namespace Benchmark {
+
+enum {
+	kMinMicros = 250000     /**< Minimum time each benchmark is repeated for */
+};
+
+/**
+ * Install the test OSystem the first time, and return it. It also times the
+ * benchmarks while g_system is reset by GenericKernels.
+ */
+inline OSystem *timer() {
+	static OSystem *timer = nullptr;
+	if (!timer) {
+		Common::install_null_g_system();
+		timer = g_system;
+	}
+	return timer;
+}
+
+/**
+ * While an instance exists, g_system is reset, so that the code which
+ * selects its kernels from the CPU features picks the portable ones.
+ */
+class GenericKernels {
+public:
+	GenericKernels() : _system(g_system) { g_system = nullptr; }
+	~GenericKernels() { g_system = _system; }
+
+private:
+	OSystem *_system;
+};
+
+/**
+ * Call a function object repeatedly for at least kMinMicros, after one call
+ * to warm up the caches, and print the time per call.
+ *
+ * @param name         Name of the benchmark.
+ * @param variant      Name of the kernels used.
+ * @param bytesPerRun  Size of the input processed by each call, or 0.
+ * @param func         The function object to call.
+ */
+template<class Func>
+void run(const char *name, const char *variant, uint64 bytesPerRun, Func func) {
+	OSystem *system = timer();
+
+	func();
+
+	uint runs = 0;
+	uint64 elapsed;
+	const uint64 start = system->getMicros();
+	do {
+		func();
+		runs++;
+		elapsed = system->getMicros() - start;
+	} while (elapsed < kMinMicros);
+
+	// One byte per microsecond is one MB per second
+	printf("%s,%s,%u,%.3f,%.1f\n", name, variant, runs, (double)elapsed / runs, (double)bytesPerRun * runs / elapsed);
+}
+
+} // End of namespace Benchmark
+
+#endif
@@ -0,0 +1,266 @@
+#include "test/bench/benchmark.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/compression/deflate.h"
+#include "common/compression/unzip.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/str.h"
+
+class CommonBenchmarkSuite : public CxxTest::TestSuite {
+	static const uint kNumKeys = 10000;
+	static const uint32 kDataSize = 4 * 1024 * 1024;
+
+	typedef Common::HashMap<Common::String, uint> StringMap;
+	typedef Common::HashMap<uint32, uint> UIntMap;
+
+	struct StringMapInsert {
+		const Common::String *keys;
+		void operator()() const {
+			StringMap map;
+			for (uint i = 0; i < kNumKeys; i++)
+				map[keys[i]] = i;
+		}
+	};
+
+	struct StringMapLookup {
+		const Common::String *keys;
+		const StringMap *map;
+		uint *sum;
+		void operator()() const {
+			for (uint i = 0; i < kNumKeys; i++)
+				*sum += map->getValOrDefault(keys[i]);
+		}
+	};
+
+	struct UIntMapInsert {
+		void operator()() const {
+			UIntMap map;
+			for (uint i = 0; i < kNumKeys; i++)
+				map[i * 2654435761u] = i;
+		}
+	};
+
+	struct UIntMapLookup {
+		const UIntMap *map;
+		uint *sum;
+		void operator()() const {
+			for (uint i = 0; i < kNumKeys; i++)
+				*sum += map->getValOrDefault(i * 2654435761u);
+		}
+	};
+
+	struct StringAppend {
+		uint *sum;
+		void operator()() const {
+			Common::String str;
+			for (uint i = 0; i < kNumKeys; i++)
+				str += (char)('a' + i % 26);
+			*sum += str.size();
+		}
+	};
+
+	struct StringFormat {
+		uint *sum;
+		void operator()() const {
+			for (uint i = 0; i < kNumKeys; i++)
+				*sum += Common::String::format("%s %d: %08x", "value", i, i * 31).size();
+		}
+	};
+
+	struct StringCopy {
+		const Common::String *keys;
+		uint *sum;
+		void operator()() const {
+			for (uint i = 0; i < kNumKeys; i++) {
+				Common::String copy(keys[i]);
+				*sum += copy.size();
+			}
+		}
+	};
+
+	struct ComputeMD5 {
+		const byte *data;
+		void operator()() const {
+			Common::MemoryReadStream stream(data, kDataSize);
+			uint8 digest[16];
+			Common::computeStreamMD5(stream, digest);
+		}
+	};
+
+	struct Inflate {
+		const byte *compressed;
+		uint32 compressedSize;
+		byte *out;
+		void operator()() const {
+			Common::inflateZlibHeaderless(out, kDataSize, compressed, compressedSize);
+		}
+	};
+
+	// The archive caches the members, so it is opened for every run
+	struct Unzip {
+		const byte *zip;
+		uint32 zipSize;
+		byte *out;
+		void operator()() const {
+			Common::ScopedPtr<Common::Archive> archive(Common::makeZipArchive(new Common::MemoryReadStream(zip, zipSize)));
+			Common::ScopedPtr<Common::SeekableReadStream> stream(archive->createReadStreamForMember(Common::Path("data.bin")));
+			stream->read(out, kDataSize);
+		}
+	};
+
+	Common::String _keys[kNumKeys];
+	byte *_data;
+	byte *_out;
+	uint _sum;
+
+	// Returns a zip file with the data as its only member
+	static byte *makeZip(const byte *deflated, uint32 deflatedSize, uint32 crc, uint32 *zipSize) {
+		const char name[] = "data.bin";
+		const uint16 nameLength = sizeof(name) - 1;
+
+		Common::MemoryWriteStreamDynamic *zip = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		zip->writeUint32LE(0x04034b50);
+		zip->writeUint16LE(20);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(8);
+		zip->writeUint32LE(0);
+		zip->writeUint32LE(crc);
+		zip->writeUint32LE(deflatedSize);
+		zip->writeUint32LE(kDataSize);
+		zip->writeUint16LE(nameLength);
+		zip->writeUint16LE(0);
+		zip->write(name, nameLength);
+		zip->write(deflated, deflatedSize);
+
+		const uint32 centralDirOffset = zip->pos();
+		zip->writeUint32LE(0x02014b50);
+		zip->writeUint16LE(20);
+		zip->writeUint16LE(20);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(8);
+		zip->writeUint32LE(0);
+		zip->writeUint32LE(crc);
+		zip->writeUint32LE(deflatedSize);
+		zip->writeUint32LE(kDataSize);
+		zip->writeUint16LE(nameLength);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(0);
+		zip->writeUint32LE(0);
+		zip->writeUint32LE(0);
+		zip->write(name, nameLength);
+		const uint32 centralDirSize = zip->pos() - centralDirOffset;
+
+		zip->writeUint32LE(0x06054b50);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(1);
+		zip->writeUint16LE(1);
+		zip->writeUint32LE(centralDirSize);
+		zip->writeUint32LE(centralDirOffset);
+		zip->writeUint16LE(0);
+
+		byte *data = zip->getData();
+		*zipSize = zip->size();
+		delete zip;
+		return data;
+	}
+
+public:
+	void setUp() {
+		Benchmark::timer();
+
+		for (uint i = 0; i < kNumKeys; i++)
+			_keys[i] = Common::String::format("resource_%u.dat", i * 7919);
+
+		// Compressible, but not so much that the stream ends up in a few blocks
+		_data = new byte[kDataSize];
+		_out = new byte[kDataSize];
+		uint32 seed = 12345;
+		for (uint32 i = 0; i < kDataSize; i++) {
+			seed = seed * 1103515245 + 12345;
+			_data[i] = 'a' + ((seed >> 16) % 16);
+		}
+		_sum = 0;
+	}
+
+	void tearDown() {
+		delete[] _data;
+		delete[] _out;
+	}
+
+	void test_hashmap() {
+		StringMapInsert stringInsert = { _keys };
+		Benchmark::run("hashmap_string_insert_10k", "generic", 0, stringInsert);
+
+		StringMap stringMap;
+		for (uint i = 0; i < kNumKeys; i++)
+			stringMap[_keys[i]] = i;
+		StringMapLookup stringLookup = { _keys, &stringMap, &_sum };
+		Benchmark::run("hashmap_string_lookup_10k", "generic", 0, stringLookup);
+
+		UIntMapInsert uintInsert;
+		Benchmark::run("hashmap_uint_insert_10k", "generic", 0, uintInsert);
+
+		UIntMap uintMap;
+		for (uint i = 0; i < kNumKeys; i++)
+			uintMap[i * 2654435761u] = i;
+		UIntMapLookup uintLookup = { &uintMap, &_sum };
+		Benchmark::run("hashmap_uint_lookup_10k", "generic", 0, uintLookup);
+	}
+
+	void test_string() {
+		StringAppend append = { &_sum };
+		Benchmark::run("string_append_char_10k", "generic", 0, append);
+
+		StringFormat format = { &_sum };
+		Benchmark::run("string_format_10k", "generic", 0, format);
+
+		StringCopy copy = { _keys, &_sum };
+		Benchmark::run("string_copy_10k", "generic", 0, copy);
+	}
+
+	void test_md5() {
+		ComputeMD5 md5 = { _data };
+		Benchmark::run("md5_4m", "generic", kDataSize, md5);
+	}
+
+	void test_inflate() {
+		Common::MemoryWriteStreamDynamic *dynamic = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *gzip = Common::wrapCompressedWriteStream(dynamic);
+		gzip->write(_data, kDataSize);
+		gzip->finalize();
+		byte *compressed = dynamic->getData();
+		const uint32 compressedSize = dynamic->size();
+		delete gzip;
+
+		// Without zlib, the data is written as it is. Otherwise, the deflate
+		// stream follows the 10 bytes of the gzip header, and is followed by
+		// the CRC and the size of the data.
+		if (compressedSize > 18 && compressed[0] == 0x1f && compressed[1] == 0x8b) {
+			TS_ASSERT_EQUALS(compressed[3], 0);
+			const byte *deflated = compressed + 10;
+			const uint32 deflatedSize = compressedSize - 18;
+
+			Inflate inflate = { deflated, deflatedSize, _out };
+			Benchmark::run("inflate_4m", "generic", kDataSize, inflate);
+			TS_ASSERT(memcmp(_out, _data, kDataSize) == 0);
+
+			uint32 zipSize;
+			byte *zip = makeZip(deflated, deflatedSize, READ_LE_UINT32(compressed + compressedSize - 8), &zipSize);
+			Unzip unzip = { zip, zipSize, _out };
+			Benchmark::run("unzip_4m", "generic", kDataSize, unzip);
+			TS_ASSERT(memcmp(_out, _data, kDataSize) == 0);
+			free(zip);
+		}
+
+		free(compressed);
+	}
+};
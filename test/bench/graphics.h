@@ -0,0 +1,247 @@
+#include "test/bench/benchmark.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/blit.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+#include "graphics/scaler/normal.h"
+#ifdef USE_SCALERS
+#include "graphics/scaler/scalebit.h"
+#endif
+#ifdef USE_HQ_SCALERS
+#include "graphics/scaler/hq.h"
+#endif
+
+class GraphicsBenchmarkSuite : public CxxTest::TestSuite {
+	static const uint kWidth = 640;
+	static const uint kHeight = 480;
+	static const uint kScalerWidth = 320;
+	static const uint kScalerHeight = 200;
+
+	struct CrossBlit {
+		byte *dst;
+		const byte *src;
+		uint srcPitch;
+		Graphics::PixelFormat dstFmt, srcFmt;
+		void operator()() const {
+			Graphics::crossBlit(dst, src, kWidth * 4, srcPitch, kWidth, kHeight, dstFmt, srcFmt);
+		}
+	};
+
+	struct CrossBlitMap {
+		byte *dst;
+		const byte *src;
+		const uint32 *map;
+		void operator()() const {
+			Graphics::crossBlitMap(dst, src, kWidth * 4, kWidth, kWidth, kHeight, 4, map);
+		}
+	};
+
+	struct BlendBlit {
+		byte *dst;
+		const byte *src;
+		uint width, height;
+		int scale;
+		void operator()() const {
+			Graphics::BlendBlit::blit(dst, src, kWidth * 4, width * 4, 0, 0, kWidth, kHeight,
+				scale, scale, 0, 0, 0xffffffff, 0, Graphics::BLEND_NORMAL, Graphics::ALPHA_FULL);
+		}
+	};
+
+	struct Scale {
+		Scaler *scaler;
+		byte *dst;
+		const byte *src;
+		void operator()() const {
+			const uint factor = scaler->getFactor();
+			scaler->scale(src, kScalerWidth * 2, dst, kScalerWidth * 2 * factor, kScalerWidth, kScalerHeight, 0, 0);
+		}
+	};
+
+	struct ConvertYUV {
+		Graphics::Surface *dst;
+		const byte *y, *u, *v;
+		void operator()() const {
+			YUVToRGBMan.convert420(dst, Graphics::YUVToRGBManager::kScaleITU, y, u, v, kWidth, kHeight, kWidth, kWidth / 2);
+		}
+	};
+
+	static const Graphics::CrossBlit::Kernels *crossBlitKernels(int i, const char **name) {
+		switch (i) {
+		case 0:
+			*name = "generic";
+			return &Graphics::CrossBlit::kernelsGeneric;
+#ifdef SCUMMVM_NEON
+		case 1:
+			*name = "neon";
+			return g_system->hasFeature(OSystem::kFeatureCpuNEON) ? &Graphics::CrossBlit::kernelsNEON : nullptr;
+#endif
+#ifdef SCUMMVM_SSE2
+		case 2:
+			*name = "sse2";
+			return g_system->hasFeature(OSystem::kFeatureCpuSSE2) ? &Graphics::CrossBlit::kernelsSSE2 : nullptr;
+#endif
+#ifdef SCUMMVM_AVX2
+		case 3:
+			*name = "avx2";
+			return g_system->hasFeature(OSystem::kFeatureCpuAVX2) ? &Graphics::CrossBlit::kernelsAVX2 : nullptr;
+#endif
+		default:
+			return nullptr;
+		}
+	}
+
+	static Graphics::BlendBlit::BlitFunc blendBlitFunc(int i, const char **name) {
+		switch (i) {
+		case 0:
+			*name = "generic";
+			return Graphics::BlendBlit::blitGeneric;
+#ifdef SCUMMVM_NEON
+		case 1:
+			*name = "neon";
+			return g_system->hasFeature(OSystem::kFeatureCpuNEON) ? Graphics::BlendBlit::blitNEON : nullptr;
+#endif
+#ifdef SCUMMVM_SSE2
+		case 2:
+			*name = "sse2";
+			return g_system->hasFeature(OSystem::kFeatureCpuSSE2) ? Graphics::BlendBlit::blitSSE2 : nullptr;
+#endif
+#ifdef SCUMMVM_AVX2
+		case 3:
+			*name = "avx2";
+			return g_system->hasFeature(OSystem::kFeatureCpuAVX2) ? Graphics::BlendBlit::blitAVX2 : nullptr;
+#endif
+		default:
+			return nullptr;
+		}
+	}
+
+	// Runs a scaler created with the portable kernels, and one created with
+	// the kernels selected from the CPU features
+	template<class T>
+	void runScaler(const char *name, uint factor) {
+		for (int native = 0; native < 2; native++) {
+			T *scaler;
+			if (native) {
+				scaler = new T(_format16);
+			} else {
+				Benchmark::GenericKernels generic;
+				scaler = new T(_format16);
+			}
+			scaler->setFactor(factor);
+
+			// The scalers read the pixels around the rect as well
+			Scale scale = { scaler, _dst, _src + kScalerWidth * 2 * 4 + 16 };
+			Benchmark::run(name, native ? "native" : "generic", kScalerWidth * kScalerHeight * 2, scale);
+			delete scaler;
+		}
+	}
+
+	Graphics::PixelFormat _format16, _format32;
+	byte *_src;
+	byte *_dst;
+
+public:
+	void setUp() {
+		Benchmark::timer();
+
+		_format16 = Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		_format32 = Graphics::BlendBlit::getSupportedPixelFormat();
+
+		// Large enough for a 2x scaled source of 32 bit pixels
+		_src = new byte[kWidth * kHeight * 4 * 4];
+		_dst = new byte[kWidth * kHeight * 4 * 9];
+
+		// Noise with some flat areas, so that the scalers find both edges
+		// and runs of identical pixels
+		uint32 seed = 4711;
+		for (uint i = 0; i < kWidth * kHeight * 4 * 4; i++) {
+			if (i % 64 < 32)
+				seed = seed * 1103515245 + 12345;
+			_src[i] = seed >> 16;
+		}
+	}
+
+	void tearDown() {
+		delete[] _src;
+		delete[] _dst;
+	}
+
+	void test_crossBlit() {
+		const Graphics::PixelFormat rgba(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		const Graphics::PixelFormat abgr(4, 8, 8, 8, 8, 0, 8, 16, 24);
+
+		uint32 map[256];
+		for (uint i = 0; i < 256; i++)
+			map[i] = i * 0x01010101;
+
+		const char *name;
+		for (int i = 0; i < 4; i++) {
+			Graphics::CrossBlit::kernels = crossBlitKernels(i, &name);
+			if (!Graphics::CrossBlit::kernels)
+				continue;
+
+			CrossBlit from16 = { _dst, _src, kWidth * 2, rgba, _format16 };
+			Benchmark::run("crossblit_rgb565_to_rgba8888", name, kWidth * kHeight * 2, from16);
+
+			CrossBlit from32 = { _dst, _src, kWidth * 4, rgba, abgr };
+			Benchmark::run("crossblit_abgr8888_to_rgba8888", name, kWidth * kHeight * 4, from32);
+
+			CrossBlitMap fromClut8 = { _dst, _src, map };
+			Benchmark::run("crossblitmap_clut8_to_rgba8888", name, kWidth * kHeight, fromClut8);
+		}
+
+		// Select the kernels from the CPU features again
+		Graphics::CrossBlit::kernels = nullptr;
+	}
+
+	void test_blendBlit() {
+		const Graphics::BlendBlit::BlitFunc oldFunc = Graphics::BlendBlit::blitFunc;
+
+		const char *name;
+		for (int i = 0; i < 4; i++) {
+			Graphics::BlendBlit::blitFunc = blendBlitFunc(i, &name);
+			if (!Graphics::BlendBlit::blitFunc)
+				continue;
+
+			BlendBlit unscaled = { _dst, _src, kWidth, kHeight, Graphics::BlendBlit::SCALE_THRESHOLD };
+			Benchmark::run("blendblit_alpha", name, kWidth * kHeight * 4, unscaled);
+
+			// Upscaled by two from a quarter of the area
+			BlendBlit scaled = { _dst, _src, kWidth / 2, kHeight / 2, Graphics::BlendBlit::SCALE_THRESHOLD / 2 };
+			Benchmark::run("blendblit_alpha_scaled", name, kWidth * kHeight, scaled);
+		}
+
+		Graphics::BlendBlit::blitFunc = oldFunc;
+	}
+
+	void test_scalers() {
+		runScaler<NormalScaler>("scaler_normal2x_rgb565", 2);
+#ifdef USE_SCALERS
+		runScaler<AdvMameScaler>("scaler_advmame2x_rgb565", 2);
+		runScaler<AdvMameScaler>("scaler_advmame3x_rgb565", 3);
+#endif
+#ifdef USE_HQ_SCALERS
+		runScaler<HQScaler>("scaler_hq2x_rgb565", 2);
+		runScaler<HQScaler>("scaler_hq3x_rgb565", 3);
+#endif
+	}
+
+	void test_yuv() {
+		Graphics::Surface surface;
+		surface.init(kWidth, kHeight, kWidth * 4, _dst, _format32);
+
+		const byte *y = _src;
+		const byte *u = y + kWidth * kHeight;
+		const byte *v = u + kWidth * kHeight / 4;
+		ConvertYUV convert = { &surface, y, u, v };
+
+		{
+			Benchmark::GenericKernels generic;
+			Benchmark::run("yuv420_to_rgba8888", "generic", kWidth * kHeight * 3 / 2, convert);
+		}
+		Benchmark::run("yuv420_to_rgba8888", "native", kWidth * kHeight * 3 / 2, convert);
+	}
+};
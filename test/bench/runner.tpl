@@ -0,0 +1,28 @@
+// Runner for the benchmarks, see test/bench/benchmark.h. Unlike the test
+// runner, it doesn't print any progress, so that the output only consists
+// of the results and of the failures.
+
+#include <cxxtest/StdioPrinter.h>
+#include <stdio.h>
+
+namespace CxxTest {
+
+class BenchmarkPrinter : public StdioPrinter {
+public:
+	void enterWorld(const WorldDescription &) {}
+	void leaveTest(const TestDescription &) {}
+
+	void leaveWorld(const WorldDescription &desc) {
+		if (tracker().failedTests())
+			StdioPrinter::leaveWorld(desc);
+	}
+};
+
+} // End of namespace CxxTest
+
+int main() {
+	printf("name,variant,runs,us_per_run,mb_per_s\n");
+	return CxxTest::BenchmarkPrinter().run();
+}
+
+<CxxTest world>
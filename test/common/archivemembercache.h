@@ -0,0 +1,124 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/ptr.h"
+#include "common/stream.h"
+
+#include "../null_osystem.h"
+
+class ArchiveMemberCacheTestSuite : public CxxTest::TestSuite
+{
+	/**
+	 * Archive whose members are named after their size in bytes, and
+	 * which counts how often it had to produce their contents.
+	 */
+	class TestArchive : public Common::MemcachingCaseInsensitiveArchive {
+	public:
+		TestArchive() : _reads(0) {}
+
+		bool hasFile(const Common::Path &path) const override { return true; }
+		int listMembers(Common::ArchiveMemberList &list) const override { return 0; }
+		const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+			return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(path, *this));
+		}
+
+		Common::SharedArchiveContents readContentsForPath(const Common::Path &translatedPath) const override {
+			uint32 size = translatedPath.toString().asUint64();
+			byte *contents = new byte[size];
+			memset(contents, 0x5A, size);
+			_reads++;
+			return Common::SharedArchiveContents(contents, size);
+		}
+
+		mutable int _reads;
+	};
+
+	uint32 _oldBudget;
+
+	bool readMember(const TestArchive &archive, const char *name) {
+		Common::ScopedPtr<Common::SeekableReadStream> stream(archive.createReadStreamForMember(Common::Path(name)));
+		return stream && stream->size() == (int64)Common::String(name).asUint64() && stream->readByte() == 0x5A;
+	}
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The cache reports its size to a memory counter, which uses a mutex
+		Common::install_null_g_system();
+		_oldBudget = ArchiveMemberCacheMan.getBudget();
+		ArchiveMemberCacheMan.clear();
+		ArchiveMemberCacheMan.resetStats();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		ArchiveMemberCacheMan.clear();
+		ArchiveMemberCacheMan.setBudget(_oldBudget);
+#endif
+	}
+
+	void test_reuse_within_budget() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		ArchiveMemberCacheMan.setBudget(10000);
+		TestArchive archive;
+
+		TS_ASSERT(readMember(archive, "4000"));
+		TS_ASSERT(readMember(archive, "4000"));
+		TS_ASSERT_EQUALS(archive._reads, 1);
+		TS_ASSERT_EQUALS(ArchiveMemberCacheMan.getCachedSize(), 4000u);
+		TS_ASSERT_EQUALS(ArchiveMemberCacheMan.getStats().hits, 1u);
+		TS_ASSERT_EQUALS(ArchiveMemberCacheMan.getStats().misses, 1u);
+#endif
+	}
+
+	void test_evict_least_recently_used() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		ArchiveMemberCacheMan.setBudget(10000);
+		TestArchive archive;
+
+		TS_ASSERT(readMember(archive, "4000"));
+		TS_ASSERT(readMember(archive, "4001"));
+		TS_ASSERT(readMember(archive, "4000"));
+		// Pushes out 4001, which was used last before 4000
+		TS_ASSERT(readMember(archive, "4002"));
+		TS_ASSERT_EQUALS(archive._reads, 3);
+		TS_ASSERT_EQUALS(ArchiveMemberCacheMan.getStats().evictions, 1u);
+		TS_ASSERT_EQUALS(ArchiveMemberCacheMan.getCachedSize(), 8002u);
+
+		TS_ASSERT(readMember(archive, "4000"));
+		TS_ASSERT_EQUALS(archive._reads, 3);
+		TS_ASSERT(readMember(archive, "4001"));
+		TS_ASSERT_EQUALS(archive._reads, 4);
+#endif
+	}
+
+	void test_disabled() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		ArchiveMemberCacheMan.setBudget(0);
+		TestArchive archive;
+
+		TS_ASSERT(readMember(archive, "4000"));
+		TS_ASSERT(readMember(archive, "4000"));
+		TS_ASSERT_EQUALS(archive._reads, 2);
+		TS_ASSERT_EQUALS(ArchiveMemberCacheMan.getCachedSize(), 0u);
+
+		// Small members are kept by the archive itself
+		TS_ASSERT(readMember(archive, "100"));
+		TS_ASSERT(readMember(archive, "100"));
+		TS_ASSERT_EQUALS(archive._reads, 3);
+#endif
+	}
+
+	void test_archive_destruction() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		ArchiveMemberCacheMan.setBudget(10000);
+		{
+			TestArchive archive;
+			TS_ASSERT(readMember(archive, "4000"));
+			TS_ASSERT_EQUALS(ArchiveMemberCacheMan.getCachedSize(), 4000u);
+		}
+		TS_ASSERT_EQUALS(ArchiveMemberCacheMan.getCachedSize(), 0u);
+#endif
+	}
+};
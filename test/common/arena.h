@@ -0,0 +1,99 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/arena.h"
+
+class ArenaTestSuite : public CxxTest::TestSuite
+{
+	struct Point {
+		int x, y;
+		Point(int x_, int y_) : x(x_), y(y_) {}
+	};
+
+	public:
+	void test_empty() {
+		Common::Arena arena;
+		TS_ASSERT_EQUALS(arena.getCapacity(), 0U);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 0U);
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 0U);
+	}
+
+	void test_alignment() {
+		Common::Arena arena(256);
+		for (size_t alignment = 1; alignment <= 64; alignment *= 2) {
+			arena.allocate(1, 1);
+			void *ptr = arena.allocate(3, alignment);
+			TS_ASSERT_EQUALS((uintptr)ptr & (alignment - 1), 0U);
+		}
+
+		double *d = arena.allocateArray<double>(4);
+		TS_ASSERT_EQUALS((uintptr)d % alignof(double), 0U);
+	}
+
+	void test_create() {
+		Common::Arena arena;
+		Point *p = arena.create<Point>(3, 4);
+		TS_ASSERT_EQUALS(p->x, 3);
+		TS_ASSERT_EQUALS(p->y, 4);
+
+		char *str = arena.copyString("arena");
+		TS_ASSERT_EQUALS(Common::String(str), "arena");
+	}
+
+	void test_blocks() {
+		Common::Arena arena(128);
+		byte *a = (byte *)arena.allocate(100, 1);
+		byte *b = (byte *)arena.allocate(100, 1);
+		memset(a, 1, 100);
+		memset(b, 2, 100);
+		TS_ASSERT_EQUALS(arena.getCapacity(), 256U);
+		TS_ASSERT_EQUALS(a[99], 1);
+
+		// Oversized allocations get a block of their own
+		byte *big = (byte *)arena.allocate(1000, 1);
+		memset(big, 3, 1000);
+		TS_ASSERT_EQUALS(arena.getCapacity(), 256U + 1000U);
+		TS_ASSERT_EQUALS(b[0], 2);
+	}
+
+	void test_rewind() {
+		Common::Arena arena(128);
+		arena.allocate(64, 1);
+		const size_t used = arena.getUsedSize();
+		const Common::Arena::Marker marker = arena.mark();
+
+		byte *first = (byte *)arena.allocate(32, 1);
+		arena.allocate(100, 1);
+		arena.allocate(100, 1);
+		const size_t capacity = arena.getCapacity();
+
+		arena.rewind(marker);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), used);
+
+		// The released memory and blocks are reused
+		TS_ASSERT_EQUALS((byte *)arena.allocate(32, 1), first);
+		arena.allocate(100, 1);
+		arena.allocate(100, 1);
+		TS_ASSERT_EQUALS(arena.getCapacity(), capacity);
+
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 0U);
+		TS_ASSERT_EQUALS(arena.getCapacity(), capacity);
+
+		arena.freeMemory();
+		TS_ASSERT_EQUALS(arena.getCapacity(), 0U);
+	}
+
+	void test_scope() {
+		Common::Arena arena;
+		arena.allocate(16);
+		const size_t used = arena.getUsedSize();
+		{
+			Common::Arena::Scope scope(arena);
+			arena.allocate(100);
+			arena.create<Point>(1, 2);
+			TS_ASSERT(arena.getUsedSize() > used);
+		}
+		TS_ASSERT_EQUALS(arena.getUsedSize(), used);
+	}
+};
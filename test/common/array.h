@@ -4,6 +4,26 @@
 #include "common/noncopyable.h"
 #include "common/str.h"
 
+// Counts how often instances get copied and moved
+struct MoveCounter {
+	static int copies;
+	static int moves;
+
+	int value;
+
+	MoveCounter(int v = 0) : value(v) {}
+	MoveCounter(int a, int b) : value(a * b) {}
+	MoveCounter(const MoveCounter &other) : value(other.value) { copies++; }
+	MoveCounter(MoveCounter &&other) : value(other.value) { other.value = -1; moves++; }
+	MoveCounter &operator=(const MoveCounter &other) { value = other.value; copies++; return *this; }
+	MoveCounter &operator=(MoveCounter &&other) { value = other.value; other.value = -1; moves++; return *this; }
+
+	static void reset() { copies = moves = 0; }
+};
+
+int MoveCounter::copies = 0;
+int MoveCounter::moves = 0;
+
 class ArrayTestSuite : public CxxTest::TestSuite
 {
 	public:
@@ -458,6 +478,81 @@ class ArrayTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(array2[2], 17);
 	}
 
+	void test_emplace_back() {
+		Common::Array<MoveCounter> array;
+		MoveCounter::reset();
+
+		for (int i = 0; i < 100; i++)
+			TS_ASSERT_EQUALS(array.emplace_back(i, 2).value, i * 2);
+
+		// Growing the storage moves the existing elements
+		TS_ASSERT_EQUALS(MoveCounter::copies, 0);
+		TS_ASSERT_EQUALS(array.size(), 100u);
+		for (int i = 0; i < 100; i++)
+			TS_ASSERT_EQUALS(array[i].value, i * 2);
+
+		// Arguments referring to the array itself survive a reallocation
+		Common::Array<MoveCounter> array2;
+		array2.emplace_back(7);
+		for (int i = 1; i < 256; i++) {
+			// Fills the storage up before each reallocation
+			array2.emplace_back(array2[0]);
+			TS_ASSERT_EQUALS(array2[i].value, 7);
+		}
+		TS_ASSERT_EQUALS(array2.back().value, 7);
+		TS_ASSERT_EQUALS(array2[0].value, 7);
+	}
+
+	void test_push_back_move() {
+		Common::Array<MoveCounter> array;
+		MoveCounter::reset();
+
+		for (int i = 0; i < 50; i++) {
+			MoveCounter element(i);
+			array.push_back(Common::move(element));
+			TS_ASSERT_EQUALS(element.value, -1);
+		}
+		TS_ASSERT_EQUALS(MoveCounter::copies, 0);
+
+		// Inserting relocates the tail by moving it
+		MoveCounter::reset();
+		array.insert_at(0, MoveCounter(-5));
+		TS_ASSERT_EQUALS(MoveCounter::copies, 1);
+		TS_ASSERT_EQUALS(array[0].value, -5);
+		for (int i = 0; i < 50; i++)
+			TS_ASSERT_EQUALS(array[i + 1].value, i);
+
+		MoveCounter::reset();
+		array.reserve(1000);
+		TS_ASSERT_EQUALS(MoveCounter::copies, 0);
+		TS_ASSERT_EQUALS(array.size(), 51u);
+		TS_ASSERT_EQUALS(array[50].value, 49);
+	}
+
+	void test_resize_growth() {
+		Common::Array<int> array;
+		array.resize(5);
+
+		// Growing one element at a time does not reallocate every time
+		int reallocations = 0;
+		for (uint i = 6; i <= 1000; i++) {
+			const int *data = array.data();
+			array.resize(i);
+			array[i - 1] = i;
+			if (array.data() != data)
+				reallocations++;
+		}
+		TS_ASSERT_LESS_THAN(reallocations, 10);
+		TS_ASSERT_EQUALS(array.size(), 1000u);
+		TS_ASSERT_EQUALS(array[999], 1000);
+
+		// Resizing within the capacity keeps the storage
+		const int *data = array.data();
+		array.resize(10);
+		array.resize(500);
+		TS_ASSERT_EQUALS(array.data(), data);
+	}
+
 };
 
 struct ListElement {
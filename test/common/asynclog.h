@@ -0,0 +1,90 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/asynclog.h"
+#include "common/array.h"
+
+#include "../null_osystem.h"
+
+class CapturingAsyncLog : public Common::AsyncLog {
+public:
+	Common::Array<Common::String> _messages;
+	Common::Array<LogMessageType::Type> _types;
+
+protected:
+	void write(LogMessageType::Type type, const char *message) override {
+		_messages.push_back(message);
+		_types.push_back(type);
+	}
+};
+
+class AsyncLogTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The log creates a mutex through g_system
+		Common::install_null_g_system();
+#endif
+	}
+
+	void test_post_flush() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		CapturingAsyncLog log;
+
+		TS_ASSERT(log.post(LogMessageType::kDebug, "first\n"));
+		TS_ASSERT(log.post(LogMessageType::kInfo, ""));
+		TS_ASSERT(log.post(LogMessageType::kDebug, "third\n"));
+		TS_ASSERT(log._messages.empty());
+
+		log.flush();
+		TS_ASSERT_EQUALS(log._messages.size(), 3U);
+		TS_ASSERT_EQUALS(log._messages[0], "first\n");
+		TS_ASSERT_EQUALS(log._messages[1], "");
+		TS_ASSERT_EQUALS(log._messages[2], "third\n");
+		TS_ASSERT_EQUALS(log._types[1], LogMessageType::kInfo);
+
+		log.flush();
+		TS_ASSERT_EQUALS(log._messages.size(), 3U);
+#endif
+	}
+
+	void test_long_message() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		CapturingAsyncLog log;
+
+		// Spans several slots, and wraps around the ring a few times
+		Common::String message;
+		for (uint i = 0; i < Common::AsyncLog::kSlotTextSize * 3 + 5; i++)
+			message += (char)('a' + i % 26);
+
+		for (uint i = 0; i < Common::AsyncLog::kSlotCount; i++) {
+			TS_ASSERT(log.post(LogMessageType::kDebug, message.c_str()));
+			log.flush();
+		}
+
+		TS_ASSERT_EQUALS(log._messages.size(), Common::AsyncLog::kSlotCount);
+		TS_ASSERT_EQUALS(log._messages.back(), message);
+#endif
+	}
+
+	void test_full() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		CapturingAsyncLog log;
+
+		for (uint i = 0; i < Common::AsyncLog::kSlotCount; i++)
+			TS_ASSERT(log.post(LogMessageType::kDebug, "x"));
+		TS_ASSERT(!log.post(LogMessageType::kDebug, "dropped"));
+		TS_ASSERT(!log.post(LogMessageType::kDebug, "dropped"));
+		TS_ASSERT_EQUALS(log.getDroppedCount(), 2U);
+
+		log.flush();
+		TS_ASSERT_EQUALS(log._messages.size(), Common::AsyncLog::kSlotCount + 1);
+		TS_ASSERT_EQUALS(log._messages.back(), "2 log messages were dropped\n");
+		TS_ASSERT_EQUALS(log._types.back(), LogMessageType::kWarning);
+
+		// There is room again once flushed
+		TS_ASSERT(log.post(LogMessageType::kDebug, "y"));
+		log.flush();
+		TS_ASSERT_EQUALS(log._messages.back(), "y");
+#endif
+	}
+};
@@ -255,4 +255,41 @@ public:
 		tmpl_align_16<Common::MemoryReadStream, Common::BitStream16BELSB>();
 		tmpl_align_16<Common::BitStreamMemoryStream, Common::BitStreamMemory16BELSB>();
 	}
+
+private:
+	// Compares a bit stream on a memory stream with the one reading the
+	// values through a SeekableReadStream, long enough for the memory one
+	// to read 64 bits at a time, and up to its end
+	template<class BS, class BSM>
+	void tmpl_memory_layout() {
+		byte contents[64];
+		for (uint i = 0; i < sizeof(contents); i++)
+			contents[i] = i * 37 + 11;
+
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		Common::BitStreamMemoryStream bsms(contents, sizeof(contents));
+
+		BS bs(ms);
+		BSM bsm(bsms);
+		for (uint i = 0; !bs.eos(); i++) {
+			const uint n = 1 + (i * 7) % 32;
+			TS_ASSERT_EQUALS(bsm.peekBits(n), bs.peekBits(n));
+			TS_ASSERT_EQUALS(bsm.getBits(n), bs.getBits(n));
+			TS_ASSERT_EQUALS(bsm.pos(), bs.pos());
+		}
+		TS_ASSERT(bsm.eos());
+	}
+public:
+	void test_memory_layouts() {
+		tmpl_memory_layout<Common::BitStream8MSB, Common::BitStreamMemory8MSB>();
+		tmpl_memory_layout<Common::BitStream8LSB, Common::BitStreamMemory8LSB>();
+		tmpl_memory_layout<Common::BitStream16LEMSB, Common::BitStreamMemory16LEMSB>();
+		tmpl_memory_layout<Common::BitStream16LELSB, Common::BitStreamMemory16LELSB>();
+		tmpl_memory_layout<Common::BitStream16BEMSB, Common::BitStreamMemory16BEMSB>();
+		tmpl_memory_layout<Common::BitStream16BELSB, Common::BitStreamMemory16BELSB>();
+		tmpl_memory_layout<Common::BitStream32LEMSB, Common::BitStreamMemory32LEMSB>();
+		tmpl_memory_layout<Common::BitStream32LELSB, Common::BitStreamMemory32LELSB>();
+		tmpl_memory_layout<Common::BitStream32BEMSB, Common::BitStreamMemory32BEMSB>();
+		tmpl_memory_layout<Common::BitStream32BELSB, Common::BitStreamMemory32BELSB>();
+	}
 };
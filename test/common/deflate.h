@@ -0,0 +1,89 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/compression/deflate.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/scummsys.h"
+
+class DeflateTestSuite : public CxxTest::TestSuite {
+	static const uint32 kDataSize = 3 * 1024 * 1024 + 123;
+
+	byte *_data;
+	byte *_compressed;
+	uint32 _compressedSize;
+
+public:
+	void setUp() {
+		// Compressible, but not so much that the stream ends up in a few blocks
+		_data = new byte[kDataSize];
+		uint32 seed = 12345;
+		for (uint32 i = 0; i < kDataSize; i++) {
+			seed = seed * 1103515245 + 12345;
+			_data[i] = 'a' + ((seed >> 16) % 16);
+		}
+
+		Common::MemoryWriteStreamDynamic *dynamic = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *gzip = Common::wrapCompressedWriteStream(dynamic);
+		gzip->write(_data, kDataSize);
+		gzip->finalize();
+		_compressed = dynamic->getData();
+		_compressedSize = dynamic->size();
+		delete gzip;
+	}
+
+	void tearDown() {
+		delete[] _data;
+		free(_compressed);
+	}
+
+	bool checkAt(Common::SeekableReadStream &stream, uint32 pos, uint32 len) {
+		byte buffer[256];
+		if (!stream.seek(pos) || stream.pos() != pos)
+			return false;
+		if (stream.read(buffer, len) != len)
+			return false;
+		return memcmp(buffer, _data + pos, len) == 0;
+	}
+
+	void test_sequential_read() {
+		Common::ScopedPtr<Common::SeekableReadStream> stream(Common::wrapCompressedReadStream(new Common::MemoryReadStream(_compressed, _compressedSize)));
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), (int64)kDataSize);
+
+		byte *buffer = new byte[kDataSize];
+		TS_ASSERT_EQUALS(stream->read(buffer, kDataSize), kDataSize);
+		TS_ASSERT(memcmp(buffer, _data, kDataSize) == 0);
+		delete[] buffer;
+	}
+
+	void test_random_seeks() {
+		Common::ScopedPtr<Common::SeekableReadStream> stream(Common::wrapCompressedReadStream(new Common::MemoryReadStream(_compressed, _compressedSize)));
+		TS_ASSERT(stream);
+
+		// Backwards from the end, so that most seeks go back
+		TS_ASSERT(checkAt(*stream, kDataSize - 200, 200));
+		for (int i = 1; i <= 9; i++)
+			TS_ASSERT(checkAt(*stream, kDataSize - i * 333333, 256));
+
+		// Then all over the place
+		uint32 seed = 1;
+		for (int i = 0; i < 50; i++) {
+			seed = seed * 1103515245 + 12345;
+			TS_ASSERT(checkAt(*stream, (seed >> 8) % (kDataSize - 256), 256));
+		}
+
+		TS_ASSERT(checkAt(*stream, 0, 256));
+		TS_ASSERT(!stream->err());
+	}
+
+	void test_deflate_seeks() {
+		// Raw deflate data, as stored in ZIP files, behind the zlib header
+		Common::ScopedPtr<Common::SeekableReadStream> stream(Common::wrapDeflateReadStream(new Common::MemoryReadStream(_compressed + 10, _compressedSize - 18), DisposeAfterUse::YES, kDataSize));
+		TS_ASSERT(stream);
+
+		TS_ASSERT(checkAt(*stream, kDataSize - 256, 256));
+		TS_ASSERT(checkAt(*stream, 1000000, 256));
+		TS_ASSERT(checkAt(*stream, 2500000, 256));
+		TS_ASSERT(checkAt(*stream, 10, 256));
+	}
+};
@@ -0,0 +1,193 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flathashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/debug.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	typedef Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FlatStringMap;
+	typedef Common::FlatHashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FlatIndexMap;
+	typedef Common::HashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> IndexMap;
+
+	template<class Map>
+	static uint32 benchmark(const Common::Array<Common::String> &keys, uint iterations) {
+		const uint32 start = g_system->getMillis();
+		for (uint iter = 0; iter < iterations; iter++) {
+			Map map;
+			for (uint i = 0; i < keys.size(); i++)
+				map[keys[i]] = i;
+
+			uint sum = 0;
+			for (int pass = 0; pass < 4; pass++) {
+				for (uint i = 0; i < keys.size(); i++)
+					sum += map.getValOrDefault(keys[i]);
+			}
+			TS_ASSERT_EQUALS(sum, 4 * (keys.size() * (keys.size() - 1) / 2));
+		}
+		return g_system->getMillis() - start;
+	}
+
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		FlatStringMap container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		TS_ASSERT(container2.contains("FOO"));
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+		TS_ASSERT(!container2.contains("foo"));
+	}
+
+	void test_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT_EQUALS(container[1], 42);
+		container.erase(container.find(0));
+		TS_ASSERT_EQUALS(container.size(), 4U);
+		container.erase(1);
+		container.erase(2);
+		container.erase(container.find(3));
+		TS_ASSERT(!container.empty());
+		container.erase(4);
+		TS_ASSERT(container.empty());
+		TS_ASSERT(container.find(4) == container.end());
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container.setVal(2, 45);
+
+		const Common::FlatHashMap<int, int> &containerRef = container;
+		int val = 0;
+
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(0), 17);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(0, -10), 17);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17, -10), -10);
+		TS_ASSERT(containerRef.tryGetVal(2, val));
+		TS_ASSERT_EQUALS(val, 45);
+		TS_ASSERT(!containerRef.tryGetVal(3, val));
+	}
+
+	void test_collision() {
+		// Keys which share their home slot, erased in various orders
+		Common::FlatHashMap<int, int> h;
+		h[5] = 1;
+		h[32+5] = 2;
+		h[64+5] = 3;
+		h[6] = 4;
+		h[128+5] = 5;
+		h.erase(32+5);
+		TS_ASSERT_EQUALS(h[5], 1);
+		TS_ASSERT_EQUALS(h[64+5], 3);
+		TS_ASSERT_EQUALS(h[6], 4);
+		TS_ASSERT_EQUALS(h[128+5], 5);
+		h.erase(5);
+		TS_ASSERT(!h.contains(5));
+		TS_ASSERT(!h.contains(32+5));
+		TS_ASSERT_EQUALS(h[6], 4);
+		TS_ASSERT_EQUALS(h[64+5], 3);
+		TS_ASSERT_EQUALS(h[128+5], 5);
+		TS_ASSERT_EQUALS(h.size(), 3U);
+	}
+
+	void test_iterator_copy() {
+		Common::FlatHashMap<int, int> container;
+		for (int i = 0; i < 5; i++)
+			container[i] = i * 10;
+		container.erase(1);
+
+		Common::FlatHashMap<int, int> copy;
+		copy[100] = 1;
+		copy = container;
+		TS_ASSERT(!copy.contains(100));
+
+		int found = 0;
+		Common::FlatHashMap<int, int>::const_iterator j;
+		for (j = copy.begin(); j != copy.end(); ++j) {
+			const int key = j->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT_EQUALS(j->_value, key * 10);
+			TS_ASSERT(!(found & (1 << key)));
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4+1);
+	}
+
+	void test_against_hashmap() {
+		// Random inserts and erases, so that the table grows and nodes
+		// get shifted around in both directions
+		Common::FlatHashMap<uint, uint> flat;
+		Common::HashMap<uint, uint> reference;
+
+		uint32 seed = 1;
+		for (int i = 0; i < 20000; i++) {
+			seed = seed * 1103515245 + 12345;
+			const uint key = (seed >> 16) % 3000;
+			if (seed & 0x100) {
+				flat.erase(key);
+				reference.erase(key);
+			} else {
+				flat[key] = i;
+				reference[key] = i;
+			}
+		}
+
+		TS_ASSERT_EQUALS(flat.size(), reference.size());
+		for (Common::HashMap<uint, uint>::const_iterator i = reference.begin(); i != reference.end(); ++i)
+			TS_ASSERT_EQUALS(flat.getValOrDefault(i->_key, (uint)-1), i->_value);
+
+		uint count = 0;
+		for (Common::FlatHashMap<uint, uint>::const_iterator i = flat.begin(); i != flat.end(); ++i, ++count)
+			TS_ASSERT(reference.contains(i->_key));
+		TS_ASSERT_EQUALS(count, reference.size());
+	}
+
+	void test_benchmark() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+		Common::Array<Common::String> keys;
+		for (int i = 0; i < 2000; i++)
+			keys.push_back(Common::String::format("Selector_%d_name", i * 7919));
+
+		const uint iterations = 50;
+		const uint32 flatTime = benchmark<FlatIndexMap>(keys, iterations);
+		const uint32 hashTime = benchmark<IndexMap>(keys, iterations);
+
+		debug("HashMap insert and lookup time for %d keys, %d iterations (in milliseconds): %d\n", keys.size(), iterations, hashTime);
+		debug("FlatHashMap insert and lookup time for %d keys, %d iterations (in milliseconds): %d\n", keys.size(), iterations, flatTime);
+#endif
+	}
+};
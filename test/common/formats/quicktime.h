@@ -24,13 +24,39 @@ static const byte VALID_MHDR_DATA[] = { // a 'correct' quicktime file with a hea
 	0x0, 0x0, 0x0, 0x8, 0x6d, 0x64, 0x61, 0x74
 };
 
+static const byte VALID_STBL_DATA[] = { // a video track with sample tables
+	// size				'moov'
+	0x0, 0x0, 0x0, 0xc4, 0x6d, 0x6f, 0x6f, 0x76,
+	// size				'trak'					size				'mdia'
+	0x0, 0x0, 0x0, 0xbc, 0x74, 0x72, 0x61, 0x6b, 0x0, 0x0, 0x0, 0xb4, 0x6d, 0x64, 0x69, 0x61,
+	// size				'hdlr'					vers/flags	'mhlr'		'vide'		3 ignored values
+	0x0, 0x0, 0x0, 0x20, 0x68, 0x64, 0x6c, 0x72, 0,0,0,0, 0x6d, 0x68, 0x6c, 0x72, 0x76, 0x69, 0x64, 0x65, 0,0,0,0, 0,0,0,0, 0,0,0,0,
+	// size				'minf'					size				'stbl'
+	0x0, 0x0, 0x0, 0x8c, 0x6d, 0x69, 0x6e, 0x66, 0x0, 0x0, 0x0, 0x84, 0x73, 0x74, 0x62, 0x6c,
+	// size				'stts'					vers/flags	1 entry		3 samples of duration 10
+	0x0, 0x0, 0x0, 0x18, 0x73, 0x74, 0x74, 0x73, 0,0,0,0, 0,0,0,1, 0,0,0,3, 0,0,0,10,
+	// size				'stsc'					vers/flags	1 entry		first 1, count 3, id 1
+	0x0, 0x0, 0x0, 0x1c, 0x73, 0x74, 0x73, 0x63, 0,0,0,0, 0,0,0,1, 0,0,0,1, 0,0,0,3, 0,0,0,1,
+	// size				'stsz'					vers/flags	no fixed size, 3 samples of 5, 6 and 7 bytes
+	0x0, 0x0, 0x0, 0x20, 0x73, 0x74, 0x73, 0x7a, 0,0,0,0, 0,0,0,0, 0,0,0,3, 0,0,0,5, 0,0,0,6, 0,0,0,7,
+	// size				'stco'					vers/flags	1 chunk at 0x100
+	0x0, 0x0, 0x0, 0x14, 0x73, 0x74, 0x63, 0x6f, 0,0,0,0, 0,0,0,1, 0,0,1,0,
+	// size				'stss'					vers/flags	sample 2 is a keyframe
+	0x0, 0x0, 0x0, 0x14, 0x73, 0x74, 0x73, 0x73, 0,0,0,0, 0,0,0,1, 0,0,0,2,
+	// size				'mdat'
+	0x0, 0x0, 0x0, 0x8, 0x6d, 0x64, 0x61, 0x74
+};
+
 
 class QuickTimeTestParser : public Common::QuickTimeParser {
 public:
+	using Common::QuickTimeParser::Track;
+
 	uint32 getDuration() const { return _duration; }
 	const Common::Rational &getScaleFactorX() const { return _scaleFactorX; }
 	const Common::Rational &getScaleFactorY() const { return _scaleFactorY; }
 	const Common::Array<Track *> &getTracks() const { return _tracks; }
+	bool loadTables(Track *track) { return loadSampleTables(track); }
 
 	SampleDesc *readSampleDesc(Track *track, uint32 format, uint32 descSize) override {
 		return nullptr;
@@ -68,7 +94,7 @@ public:
 		Common::MemoryReadStream stream(VALID_MHDR_DATA, sizeof(VALID_MHDR_DATA));
 		bool result = parser.parseStream(&stream, DisposeAfterUse::NO);
 		TS_ASSERT(result);
-		TS_ASSERT_EQUALS(parser.getDuration(), 999*60 + 1);
+		TS_ASSERT_EQUALS(parser.getDuration(), 999u * 60 + 1);
 		TS_ASSERT_EQUALS(parser.getScaleFactorX(), Common::Rational(0x10000, 0x8000));
 		TS_ASSERT_EQUALS(parser.getScaleFactorY(), Common::Rational(0x10000, 0xa000));
 	}
@@ -80,4 +106,62 @@ public:
 		TS_ASSERT(!result);
 	}
 
+	void checkSampleTables(const QuickTimeTestParser &parser) {
+		const QuickTimeTestParser::Track *track = parser.getTracks()[0];
+		TS_ASSERT_EQUALS(track->chunkCount, 1u);
+		TS_ASSERT_EQUALS(track->chunkOffsets[0], 0x100u);
+		TS_ASSERT_EQUALS(track->sampleToChunkCount, 1u);
+		TS_ASSERT_EQUALS(track->sampleToChunk[0].first, 0u);
+		TS_ASSERT_EQUALS(track->sampleToChunk[0].count, 3u);
+		TS_ASSERT_EQUALS(track->sampleCount, 3u);
+		TS_ASSERT_EQUALS(track->sampleSizes[2], 7u);
+		TS_ASSERT_EQUALS(track->keyframeCount, 1u);
+		TS_ASSERT_EQUALS(track->keyframes[0], 1u);
+	}
+
+	void test_sampleTables() {
+		QuickTimeTestParser parser;
+		Common::MemoryReadStream stream(VALID_STBL_DATA, sizeof(VALID_STBL_DATA));
+		TS_ASSERT(parser.parseStream(&stream, DisposeAfterUse::NO));
+		TS_ASSERT_EQUALS(parser.getTracks().size(), 1u);
+		TS_ASSERT_EQUALS(parser.getTracks()[0]->frameCount, 3u);
+		checkSampleTables(parser);
+	}
+
+	void test_lazySampleTables() {
+		QuickTimeTestParser parser;
+		parser.setLazySampleTables(true);
+		Common::MemoryReadStream stream(VALID_STBL_DATA, sizeof(VALID_STBL_DATA));
+		TS_ASSERT(parser.parseStream(&stream, DisposeAfterUse::NO));
+		TS_ASSERT_EQUALS(parser.getTracks().size(), 1u);
+
+		QuickTimeTestParser::Track *track = parser.getTracks()[0];
+		TS_ASSERT_EQUALS(track->frameCount, 3u);
+		TS_ASSERT_EQUALS(track->chunkCount, 0u);
+		TS_ASSERT(!track->chunkOffsets);
+		TS_ASSERT(!track->sampleSizes);
+
+		stream.seek(5);
+		TS_ASSERT(parser.loadTables(track));
+		TS_ASSERT_EQUALS(stream.pos(), 5);
+		checkSampleTables(parser);
+
+		// Loading again is a no-op
+		TS_ASSERT(parser.loadTables(track));
+		checkSampleTables(parser);
+	}
+
+	void test_headerOnly() {
+		QuickTimeTestParser parser;
+		parser.setHeaderOnly(true);
+		Common::MemoryReadStream stream(VALID_STBL_DATA, sizeof(VALID_STBL_DATA));
+		TS_ASSERT(parser.parseStream(&stream, DisposeAfterUse::NO));
+		TS_ASSERT_EQUALS(parser.getTracks().size(), 1u);
+
+		QuickTimeTestParser::Track *track = parser.getTracks()[0];
+		TS_ASSERT_EQUALS(track->frameCount, 3u);
+		TS_ASSERT(!parser.loadTables(track));
+		TS_ASSERT_EQUALS(track->chunkCount, 0u);
+		TS_ASSERT(!track->chunkOffsets);
+	}
 };
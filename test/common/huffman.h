@@ -94,4 +94,54 @@ class HuffmanTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[5]);
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[6]);
 	}
+
+private:
+	/*
+	 * Codes of all lengths from 1 to 24 bits, so that the longer ones need
+	 * one and two subtables: symbol n < 24 has n ones followed by a zero,
+	 * symbol 24 has 24 ones.
+	 *
+	 * The symbols are written to the stream as it would hand out the bits,
+	 * and the codes are given as needed for the bit order of the stream.
+	 */
+	template<class BS, class MS>
+	void tmpl_long_codes() {
+		const uint32 codeCount = 25;
+		uint8 lengths[codeCount];
+		uint32 codes[codeCount];
+		for (uint32 i = 0; i < codeCount; i++) {
+			lengths[i] = MIN<uint8>(i + 1, 24);
+			const uint32 ones = (1 << MIN<uint32>(i, 24)) - 1;
+			codes[i] = BS::isMSB2LSB() ? ones << (lengths[i] - i) : ones;
+		}
+
+		const uint32 expected[] = {24, 0, 12, 8, 9, 1, 23, 2, 16, 0, 24, 5};
+		const uint count = ARRAYSIZE(expected);
+
+		byte input[64];
+		memset(input, 0, sizeof(input));
+		uint bitPos = 0;
+		for (uint i = 0; i < count; i++) {
+			for (uint j = 0; j < lengths[expected[i]]; j++, bitPos++) {
+				if (j < expected[i])
+					input[bitPos / 8] |= BS::isMSB2LSB() ? (0x80 >> (bitPos % 8)) : (1 << (bitPos % 8));
+			}
+		}
+
+		Common::Huffman<BS> h(0, codeCount, codes, lengths);
+
+		MS ms(input, sizeof(input));
+		BS bs(ms);
+
+		for (uint i = 0; i < count; i++)
+			TS_ASSERT_EQUALS(h.getSymbol(bs), expected[i]);
+		TS_ASSERT_EQUALS(bs.pos(), bitPos);
+	}
+public:
+	void test_long_codes() {
+		tmpl_long_codes<Common::BitStream8MSB, Common::MemoryReadStream>();
+		tmpl_long_codes<Common::BitStream8LSB, Common::MemoryReadStream>();
+		tmpl_long_codes<Common::BitStreamMemory8MSB, Common::BitStreamMemoryStream>();
+		tmpl_long_codes<Common::BitStreamMemory32LELSB, Common::BitStreamMemoryStream>();
+	}
 };
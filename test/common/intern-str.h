@@ -0,0 +1,55 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/intern-str.h"
+
+class InternedStringTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_empty() {
+		Common::InternedString str;
+		TS_ASSERT(str.empty());
+		TS_ASSERT_EQUALS(str.size(), 0U);
+		TS_ASSERT_EQUALS(str.toString(), "");
+		TS_ASSERT_EQUALS(str.hash(), Common::String().hash());
+		TS_ASSERT(str == Common::InternedString(""));
+	}
+
+	void test_intern() {
+		Common::InternedString a("intern_test_foo");
+		Common::InternedString b(Common::String("intern_test_") + "foo");
+		Common::InternedString c("intern_test_FOO");
+
+		TS_ASSERT(!a.empty());
+		TS_ASSERT(a == b);
+		TS_ASSERT(a != c);
+		TS_ASSERT_EQUALS(a.c_str(), b.c_str());
+		TS_ASSERT_EQUALS(a.toString(), "intern_test_foo");
+		TS_ASSERT(a == Common::String("intern_test_foo"));
+		TS_ASSERT_EQUALS(a.hash(), Common::String("intern_test_foo").hash());
+		TS_ASSERT_EQUALS(Common::Hash<Common::InternedString>()(c), c.toString().hash());
+	}
+
+	void test_try_get() {
+		Common::InternedString out;
+		const uint size = Common::InternedString::tableSize();
+		TS_ASSERT(!Common::InternedString::tryGet("intern_test_missing", out));
+		TS_ASSERT_EQUALS(Common::InternedString::tableSize(), size);
+
+		Common::InternedString a("intern_test_present");
+		TS_ASSERT_EQUALS(Common::InternedString::tableSize(), size + 1);
+		TS_ASSERT(Common::InternedString::tryGet("intern_test_present", out));
+		TS_ASSERT(out == a);
+
+		Common::InternedString b("intern_test_present");
+		TS_ASSERT_EQUALS(Common::InternedString::tableSize(), size + 1);
+	}
+
+	void test_hashmap_key() {
+		Common::HashMap<Common::InternedString, int> map;
+		map[Common::InternedString("intern_test_one")] = 1;
+		map[Common::InternedString("intern_test_two")] = 2;
+		TS_ASSERT_EQUALS(map[Common::InternedString("intern_test_one")], 1);
+		TS_ASSERT_EQUALS(map[Common::InternedString("intern_test_two")], 2);
+		TS_ASSERT_EQUALS(map.size(), 2U);
+	}
+};
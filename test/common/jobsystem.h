@@ -0,0 +1,186 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/jobsystem.h"
+#include "backends/jobs/default/default-jobs.h"
+
+#include "../threaded_jobsystem.h"
+
+#include <atomic>
+
+namespace {
+
+void incrementJob(void *refCon) {
+	(*(int *)refCon)++;
+}
+
+void fillRange(uint32 begin, uint32 end, void *refCon) {
+	int *values = (int *)refCon;
+	for (uint32 i = begin; i < end; ++i)
+		values[i] += (int)i;
+}
+
+struct BlockingJob {
+	std::atomic<bool> started;
+	std::atomic<bool> released;
+
+	BlockingJob() : started(false), released(false) {}
+
+	// Keeps a worker busy until released
+	static void run(void *refCon) {
+		BlockingJob *job = (BlockingJob *)refCon;
+		job->started = true;
+		while (!job->released) {
+		}
+	}
+
+	void waitUntilStarted() const {
+		while (!started) {
+		}
+	}
+};
+
+void incrementAtomicJob(void *refCon) {
+	(*(std::atomic<int> *)refCon)++;
+}
+
+struct RangeCheck {
+	std::atomic<int> visits[1000];
+	std::atomic<int> slices;
+};
+
+void checkRange(uint32 begin, uint32 end, void *refCon) {
+	RangeCheck *check = (RangeCheck *)refCon;
+	check->slices++;
+	for (uint32 i = begin; i < end; ++i)
+		check->visits[i]++;
+}
+
+} // End of anonymous namespace
+
+class JobSystemTestSuite : public CxxTest::TestSuite {
+public:
+	void test_submit_wait() {
+		Common::JobSystem jobs;
+		Common::JobGroup group;
+		int counter = 0;
+
+		for (int i = 0; i < 10; ++i)
+			jobs.submit(group, incrementJob, &counter);
+		jobs.wait(group);
+
+		TS_ASSERT(jobs.isDone(group));
+		TS_ASSERT_EQUALS(counter, 10);
+	}
+
+	void test_parallel_for() {
+		Common::JobSystem jobs;
+		int values[100] = { 0 };
+
+		jobs.parallelFor(100, fillRange, values, 7);
+		for (int i = 0; i < 100; ++i)
+			TS_ASSERT_EQUALS(values[i], i);
+
+		// Empty ranges must not call back at all
+		jobs.parallelFor(0, fillRange, nullptr);
+	}
+
+	void test_threaded_submit_wait() {
+#if THREADED_JOB_SYSTEM_IS_AVAILABLE
+		DefaultJobSystem *jobs = Common::create_threaded_job_system(3);
+		TS_ASSERT_EQUALS(jobs->getWorkerCount(), 3u);
+
+		Common::JobGroup group;
+		std::atomic<int> counter(0);
+
+		for (int i = 0; i < 100; ++i)
+			jobs->submit(group, incrementAtomicJob, &counter);
+		jobs->wait(group);
+
+		TS_ASSERT(jobs->isDone(group));
+		TS_ASSERT_EQUALS(counter.load(), 100);
+
+		// A worker that is busy keeps its group pending
+		BlockingJob blocker;
+		jobs->submit(group, BlockingJob::run, &blocker);
+		blocker.waitUntilStarted();
+		TS_ASSERT(!jobs->isDone(group));
+
+		blocker.released = true;
+		jobs->waitWithoutHelping(group);
+		TS_ASSERT(jobs->isDone(group));
+
+		delete jobs;
+#endif
+	}
+
+	void test_threaded_wait_steals() {
+#if THREADED_JOB_SYSTEM_IS_AVAILABLE
+		DefaultJobSystem *jobs = Common::create_threaded_job_system(1);
+
+		// Keep the only worker busy
+		Common::JobGroup blockerGroup;
+		BlockingJob blocker;
+		jobs->submit(blockerGroup, BlockingJob::run, &blocker);
+		blocker.waitUntilStarted();
+
+		// Waiting runs the queued job on this thread, or it would never return
+		Common::JobGroup group;
+		std::atomic<int> counter(0);
+		jobs->submit(group, incrementAtomicJob, &counter);
+		jobs->wait(group);
+		TS_ASSERT_EQUALS(counter.load(), 1);
+		TS_ASSERT(!jobs->isDone(blockerGroup));
+
+		blocker.released = true;
+		jobs->wait(blockerGroup);
+		TS_ASSERT(jobs->isDone(blockerGroup));
+
+		delete jobs;
+#endif
+	}
+
+	void test_threaded_parallel_for() {
+#if THREADED_JOB_SYSTEM_IS_AVAILABLE
+		DefaultJobSystem *jobs = Common::create_threaded_job_system(3);
+		RangeCheck *check = new RangeCheck();
+
+		const uint32 counts[] = { 1000, 10, 7, 1, 0 };
+		for (uint c = 0; c < ARRAYSIZE(counts); ++c) {
+			for (uint i = 0; i < ARRAYSIZE(check->visits); ++i)
+				check->visits[i] = 0;
+			check->slices = 0;
+
+			jobs->parallelFor(counts[c], checkRange, check, 7);
+
+			// Every item is run exactly once, in at most one slice per thread
+			for (uint32 i = 0; i < counts[c]; ++i)
+				TS_ASSERT_EQUALS(check->visits[i].load(), 1);
+			TS_ASSERT_LESS_THAN_EQUALS(check->slices.load(), 4);
+			TS_ASSERT_LESS_THAN_EQUALS(check->slices.load(), (int)(counts[c] + 6) / 7);
+		}
+
+		delete check;
+		delete jobs;
+#endif
+	}
+
+	void test_threaded_shutdown() {
+#if THREADED_JOB_SYSTEM_IS_AVAILABLE
+		DefaultJobSystem *jobs = Common::create_threaded_job_system(1);
+
+		Common::JobGroup group;
+		BlockingJob blocker;
+		std::atomic<int> counter(0);
+
+		jobs->submit(group, BlockingJob::run, &blocker);
+		blocker.waitUntilStarted();
+		for (int i = 0; i < 20; ++i)
+			jobs->submit(group, incrementAtomicJob, &counter);
+
+		// The workers finish the queued jobs before quitting
+		blocker.released = true;
+		delete jobs;
+		TS_ASSERT_EQUALS(counter.load(), 20);
+#endif
+	}
+};
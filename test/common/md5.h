@@ -47,4 +47,20 @@ class MD5TestSuite : public CxxTest::TestSuite {
 		}
 	}
 
+	void test_computeStreamsMD5AsString() {
+		Common::MemoryReadStream *streams[8];
+		for (int i = 0; i < 7; i++)
+			streams[i] = new Common::MemoryReadStream((const byte *)md5_test_string[i], strlen(md5_test_string[i]));
+		streams[7] = nullptr;
+
+		Common::String md5s[8];
+		Common::computeStreamsMD5AsString((Common::ReadStream *const *)streams, md5s, 8);
+
+		for (int i = 0; i < 7; i++) {
+			TS_ASSERT_EQUALS(md5s[i], md5_test_digest[i]);
+			delete streams[i];
+		}
+		TS_ASSERT(md5s[7].empty());
+	}
+
 };
@@ -1,6 +1,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "common/memstream.h"
+#include "common/substream.h"
 
 class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 	public:
@@ -104,4 +105,45 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		ms.seek(0, SEEK_SET);
 		TS_ASSERT(!ms.eos());
 	}
+
+	void test_slice() {
+		byte *contents = new byte[8];
+		for (int i = 0; i < 8; ++i)
+			contents[i] = i + 1;
+		Common::MemoryReadStream *ms = new Common::MemoryReadStream(Common::SharedPtr<byte>(contents, Common::ArrayDeleter<byte>()), 8);
+		ms->seek(5);
+
+		Common::MemoryReadStream *slice = ms->createSlice(2, 6);
+		TS_ASSERT(slice);
+		TS_ASSERT_EQUALS(ms->pos(), 5);
+
+		// The slice keeps the buffer alive on its own
+		delete ms;
+		TS_ASSERT_EQUALS(slice->size(), 4);
+		TS_ASSERT_EQUALS(slice->readUint16BE(), 0x0304);
+		slice->seek(1, SEEK_SET);
+		TS_ASSERT_EQUALS(slice->readByte(), 4);
+		slice->seek(-1, SEEK_END);
+		TS_ASSERT_EQUALS(slice->readByte(), 6);
+		TS_ASSERT(!slice->eos());
+		slice->readByte();
+		TS_ASSERT(slice->eos());
+
+		Common::MemoryReadStream *nested = slice->createSlice(1, 3);
+		TS_ASSERT_EQUALS(nested->readUint16BE(), 0x0405);
+		delete nested;
+		delete slice;
+	}
+
+	void test_slice_unshared() {
+		byte contents[] = { 1, 2, 3, 4 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		TS_ASSERT(!ms.createSlice(1, 3));
+
+		// Falls back to a substream of the parent
+		Common::SeekableReadStream *sub = Common::createSliceReadStream(&ms, 1, 3);
+		TS_ASSERT_EQUALS(sub->size(), 2);
+		TS_ASSERT_EQUALS(sub->readUint16BE(), 0x0203);
+		delete sub;
+	}
 };
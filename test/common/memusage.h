@@ -0,0 +1,103 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memusage.h"
+
+#include "../null_osystem.h"
+
+class MemoryUsageTestSuite : public CxxTest::TestSuite {
+#if NULL_OSYSTEM_IS_AVAILABLE
+	// Find the entry of a counter name, or return nullptr
+	static const Common::MemoryUsage::Entry *findEntry(const Common::Array<Common::MemoryUsage::Entry> &entries, const char *name) {
+		for (uint i = 0; i < entries.size(); i++) {
+			if (!strcmp(entries[i].name, name))
+				return &entries[i];
+		}
+		return nullptr;
+	}
+#endif
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The registry creates a mutex through g_system
+		Common::install_null_g_system();
+#endif
+	}
+
+	void test_counter() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::MemoryCounter counter("Test counter");
+		TS_ASSERT_EQUALS(counter.get(), 0u);
+
+		counter.add(1000);
+		counter.add(500);
+		counter.remove(700);
+		TS_ASSERT_EQUALS(counter.get(), 800u);
+		TS_ASSERT_EQUALS(counter.getPeak(), 1500u);
+
+		counter.set(200);
+		TS_ASSERT_EQUALS(counter.get(), 200u);
+		TS_ASSERT_EQUALS(counter.getPeak(), 1500u);
+
+		counter.resetPeak();
+		TS_ASSERT_EQUALS(counter.getPeak(), 200u);
+		counter.set(300);
+		TS_ASSERT_EQUALS(counter.getPeak(), 300u);
+#endif
+	}
+
+	void test_entries() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		const size_t total = MemUsageMan.getTotal();
+
+		Common::Array<Common::MemoryUsage::Entry> entries;
+		{
+			Common::MemoryCounter small("Test small");
+			Common::MemoryCounter big1("Test big");
+			Common::MemoryCounter big2("Test big");
+			small.add(10);
+			big1.add(3000);
+			big2.add(4000);
+			big2.remove(1000);
+
+			MemUsageMan.getEntries(entries);
+			TS_ASSERT_EQUALS(MemUsageMan.getTotal(), total + 6010);
+
+			// Counters sharing a name are summed up
+			const Common::MemoryUsage::Entry *big = findEntry(entries, "Test big");
+			TS_ASSERT(big);
+			if (big) {
+				TS_ASSERT_EQUALS(big->bytes, 6000u);
+				TS_ASSERT_EQUALS(big->peak, 7000u);
+				TS_ASSERT_EQUALS(big->counters, 2u);
+			}
+
+			const Common::MemoryUsage::Entry *smallEntry = findEntry(entries, "Test small");
+			TS_ASSERT(smallEntry);
+			TS_ASSERT(smallEntry > big);
+
+			// Sorted by decreasing size
+			for (uint i = 1; i < entries.size(); i++)
+				TS_ASSERT(entries[i - 1].bytes >= entries[i].bytes);
+
+			MemUsageMan.resetPeaks();
+			MemUsageMan.getEntries(entries);
+			big = findEntry(entries, "Test big");
+			TS_ASSERT(big && big->peak == 6000u);
+		}
+
+		// Destroyed counters are not reported anymore
+		MemUsageMan.getEntries(entries);
+		TS_ASSERT(!findEntry(entries, "Test big"));
+		TS_ASSERT(!findEntry(entries, "Test small"));
+		TS_ASSERT_EQUALS(MemUsageMan.getTotal(), total);
+#endif
+	}
+
+	void test_formatSize() {
+		TS_ASSERT_EQUALS(Common::MemoryUsage::formatSize(0), "0 B");
+		TS_ASSERT_EQUALS(Common::MemoryUsage::formatSize(1023), "1023 B");
+		TS_ASSERT_EQUALS(Common::MemoryUsage::formatSize(1536), "1.5 KB");
+		TS_ASSERT_EQUALS(Common::MemoryUsage::formatSize(3 * 1024 * 1024 / 2), "1.50 MB");
+	}
+};
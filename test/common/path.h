@@ -460,6 +460,54 @@ class PathTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_DIFFERS(p3.hash(), p4.hash());
 	}
 
+	void test_cache() {
+		Common::Path p("parent/dir/xn--Sound Manager 3.1  SoundLib-lba84k/Sound");
+		Common::Path p2("PARENT:DIR:Sound Manager 3.1 / SoundLib:SOUND", ':');
+
+		// Cached values give the same results as fresh ones
+		uint hash = p.hash();
+		uint hashMac = p.hashIgnoreCaseAndMac();
+		TS_ASSERT_EQUALS(p.hash(), hash);
+		TS_ASSERT_EQUALS(p.hashIgnoreCaseAndMac(), hashMac);
+		TS_ASSERT_EQUALS(p2.hashIgnoreCaseAndMac(), hashMac);
+		TS_ASSERT(p.equalsIgnoreCaseAndMac(p2));
+		TS_ASSERT(p2.equalsIgnoreCaseAndMac(p));
+
+		// Copies keep the cache, modifications drop it
+		Common::Path p3(p);
+		TS_ASSERT_EQUALS(p3.hash(), hash);
+		p3.joinInPlace("other");
+		TS_ASSERT_DIFFERS(p3.hash(), hash);
+		TS_ASSERT_DIFFERS(p3.hashIgnoreCaseAndMac(), hashMac);
+		TS_ASSERT(!p3.equalsIgnoreCaseAndMac(p2));
+		TS_ASSERT_EQUALS(p3.hash(), Common::Path(p3.toString()).hash());
+
+		p3 = p2;
+		TS_ASSERT(p3.equalsIgnoreCaseAndMac(p));
+		hash = p3.hash();
+		p3.toLowercase();
+		TS_ASSERT_DIFFERS(p3.hash(), hash);
+		TS_ASSERT_EQUALS(p3.hashIgnoreCaseAndMac(), hashMac);
+
+		Common::Path p4("a/b");
+		uint hashCase = p4.hashIgnoreCase();
+		TS_ASSERT(!p4.appendComponent("c").equalsIgnoreCase(p4));
+		TS_ASSERT_DIFFERS(p4.appendComponent("c").hashIgnoreCase(), hashCase);
+		p4.set("A/B");
+		TS_ASSERT_EQUALS(p4.hashIgnoreCase(), hashCase);
+		p4.clear();
+		TS_ASSERT_DIFFERS(p4.hashIgnoreCase(), hashCase);
+		TS_ASSERT(!p4.equalsIgnoreCaseAndMac(p2));
+
+		// Normalizing a normalized path returns it as is
+		Common::Path p5("/foo/./bar//baz/../");
+		Common::Path p6 = p5.normalize();
+		TS_ASSERT_EQUALS(p6.toString(), "/foo/bar");
+		TS_ASSERT_EQUALS(p6.normalize().toString(), "/foo/bar");
+		p6.appendInPlace("/../x");
+		TS_ASSERT_EQUALS(p6.normalize().toString(), "/foo/x");
+	}
+
 	void test_matchString() {
 		TS_ASSERT(Common::Path("").matchPattern(""));
 		TS_ASSERT(Common::Path("a").matchPattern("*"));
@@ -0,0 +1,145 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+
+class SearchSetTestSuite : public CxxTest::TestSuite
+{
+	/**
+	 * Archive whose members are one byte streams holding the given tag.
+	 * An opaque archive does not list its members.
+	 */
+	class TestArchive : public Common::Archive {
+	public:
+		TestArchive(byte tag, bool opaque = false) : _tag(tag), _opaque(opaque), _lookups(0) {}
+
+		void addFile(const char *name) { _files.push_back(Common::Path(name)); }
+
+		bool hasFile(const Common::Path &path) const override {
+			_lookups++;
+			for (uint i = 0; i < _files.size(); i++) {
+				if (_files[i].equalsIgnoreCase(path))
+					return true;
+			}
+			return false;
+		}
+
+		int listMembers(Common::ArchiveMemberList &list) const override {
+			if (_opaque)
+				return 0;
+			for (uint i = 0; i < _files.size(); i++)
+				list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_files[i], *this)));
+			return _files.size();
+		}
+
+		const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+			if (!hasFile(path))
+				return Common::ArchiveMemberPtr();
+			return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(path, *this));
+		}
+
+		Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+			if (!hasFile(path))
+				return nullptr;
+			return new Common::MemoryReadStream(&_tag, 1);
+		}
+
+		byte _tag;
+		bool _opaque;
+		mutable int _lookups;
+		Common::Array<Common::Path> _files;
+	};
+
+	static int readTag(const Common::SearchSet &set, const char *name) {
+		Common::SeekableReadStream *stream = set.createReadStreamForMember(Common::Path(name));
+		if (!stream)
+			return -1;
+		const int tag = stream->readByte();
+		delete stream;
+		return tag;
+	}
+
+	public:
+	void test_priority() {
+		bool useIndex[] = { false, true };
+		for (int i = 0; i < 2; i++) {
+			Common::SearchSet set;
+			set.setUseMemberIndex(useIndex[i]);
+
+			TestArchive *low = new TestArchive(1);
+			low->addFile("a.dat");
+			low->addFile("b.dat");
+			TestArchive *high = new TestArchive(2);
+			high->addFile("B.DAT");
+			TestArchive *same = new TestArchive(3);
+			same->addFile("a.dat");
+
+			set.add("low", low, 0);
+			set.add("high", high, 1);
+			TS_ASSERT_EQUALS(readTag(set, "a.dat"), 1);
+			TS_ASSERT_EQUALS(readTag(set, "b.dat"), 2);
+
+			// Insertion order breaks ties
+			set.add("same", same, 0);
+			TS_ASSERT_EQUALS(readTag(set, "a.dat"), 1);
+			TS_ASSERT(!set.hasFile(Common::Path("c.dat")));
+			TS_ASSERT_EQUALS(readTag(set, "c.dat"), -1);
+
+			set.setPriority("same", 2);
+			TS_ASSERT_EQUALS(readTag(set, "a.dat"), 3);
+
+			set.remove("same");
+			TS_ASSERT_EQUALS(readTag(set, "a.dat"), 1);
+
+			Common::Archive *container = nullptr;
+			TS_ASSERT(set.getMember(Common::Path("b.dat"), &container));
+			TS_ASSERT_EQUALS(container, high);
+		}
+	}
+
+	void test_index_lookups() {
+		Common::SearchSet set;
+		set.setUseMemberIndex(true);
+
+		TestArchive *archives[8];
+		for (int i = 0; i < 8; i++) {
+			archives[i] = new TestArchive(i);
+			archives[i]->addFile(Common::String::format("file%d.dat", i).c_str());
+			set.add(Common::String::format("arc%d", i), archives[i], i);
+		}
+
+		TS_ASSERT(set.hasFile(Common::Path("file0.dat")));
+		TS_ASSERT(!set.hasFile(Common::Path("missing.dat")));
+
+		// Only the archive holding the file got asked
+		for (int i = 1; i < 8; i++)
+			TS_ASSERT_EQUALS(archives[i]->_lookups, 0);
+		TS_ASSERT_EQUALS(archives[0]->_lookups, 1);
+	}
+
+	void test_index_unlisted() {
+		Common::SearchSet set;
+		set.setUseMemberIndex(true);
+
+		TestArchive *listed = new TestArchive(1);
+		listed->addFile("a.dat");
+		TestArchive *opaque = new TestArchive(2, true);
+		opaque->addFile("a.dat");
+		opaque->addFile("b.dat");
+
+		set.add("listed", listed, 0);
+		set.add("opaque", opaque, 1);
+		TS_ASSERT_EQUALS(readTag(set, "a.dat"), 2);
+		TS_ASSERT_EQUALS(readTag(set, "b.dat"), 2);
+
+		// Files added behind the back of the set are found after invalidating
+		listed->_files.clear();
+		listed->addFile("c.dat");
+		set.invalidateMemberIndex();
+		TS_ASSERT_EQUALS(readTag(set, "c.dat"), 1);
+
+		// A stale index entry falls back to searching every archive
+		listed->_files.clear();
+		TS_ASSERT(!set.hasFile(Common::Path("c.dat")));
+	}
+};
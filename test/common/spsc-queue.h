@@ -0,0 +1,67 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/spsc-queue.h"
+
+class SPSCQueueTestSuite : public CxxTest::TestSuite {
+public:
+	void test_empty() {
+		Common::SPSCQueue<int, 4> queue;
+		int x = 42;
+
+		TS_ASSERT(queue.empty());
+		TS_ASSERT_EQUALS(queue.size(), 0U);
+		TS_ASSERT(!queue.pop(x));
+		TS_ASSERT_EQUALS(x, 42);
+	}
+
+	void test_push_pop() {
+		Common::SPSCQueue<int, 4> queue;
+		int x;
+
+		TS_ASSERT(queue.push(1));
+		TS_ASSERT(queue.push(2));
+		TS_ASSERT(!queue.empty());
+		TS_ASSERT_EQUALS(queue.size(), 2U);
+
+		TS_ASSERT(queue.pop(x));
+		TS_ASSERT_EQUALS(x, 1);
+		TS_ASSERT(queue.pop(x));
+		TS_ASSERT_EQUALS(x, 2);
+		TS_ASSERT(queue.empty());
+	}
+
+	void test_full() {
+		Common::SPSCQueue<int, 4> queue;
+		int x;
+
+		for (int i = 0; i < 4; i++)
+			TS_ASSERT(queue.push(i));
+		TS_ASSERT(!queue.push(4));
+		TS_ASSERT_EQUALS(queue.size(), 4U);
+
+		TS_ASSERT(queue.pop(x));
+		TS_ASSERT_EQUALS(x, 0);
+		TS_ASSERT(queue.push(4));
+
+		for (int i = 1; i <= 4; i++) {
+			TS_ASSERT(queue.pop(x));
+			TS_ASSERT_EQUALS(x, i);
+		}
+		TS_ASSERT(queue.empty());
+	}
+
+	void test_wrap_around() {
+		Common::SPSCQueue<int, 8> queue;
+		int x;
+
+		// Keep the queue partially filled while the indices go round many times
+		for (int i = 0; i < 3; i++)
+			queue.push(i);
+		for (int i = 3; i < 1000; i++) {
+			TS_ASSERT(queue.push(i));
+			TS_ASSERT(queue.pop(x));
+			TS_ASSERT_EQUALS(x, i - 3);
+		}
+		TS_ASSERT_EQUALS(queue.size(), 3U);
+	}
+};
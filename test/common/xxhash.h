@@ -0,0 +1,36 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/xxhash.h"
+
+class XXHashTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_computeXXHash64() {
+		TS_ASSERT_EQUALS(Common::computeXXHash64("", 0), 0xEF46DB3751D8E999ULL);
+		TS_ASSERT_EQUALS(Common::computeXXHash64("abc", 3), 0x44BC2CF5AD770999ULL);
+		TS_ASSERT_EQUALS(Common::computeXXHash64("abc", 3, 1), 0xBEA9CA8199328908ULL);
+
+		const char *fox = "The quick brown fox jumps over the lazy dog";
+		TS_ASSERT_EQUALS(Common::computeXXHash64(fox, strlen(fox)), 0x0B242D361FDA71BCULL);
+	}
+
+	void test_incremental() {
+		byte data[1024];
+		for (int i = 0; i < 1024; i++)
+			data[i] = i & 0xFF;
+
+		TS_ASSERT_EQUALS(Common::computeXXHash64(data, sizeof(data)), 0x6F3914F18FE4DF57ULL);
+
+		// Feed the data in pieces that do not line up with the stripes
+		Common::XXHash64 hash;
+		for (uint32 pos = 0, size = 1; pos < sizeof(data); pos += size, size = size * 2 + 1)
+			hash.update(data + pos, MIN<uint32>(size, sizeof(data) - pos));
+		TS_ASSERT_EQUALS(hash.finish(), 0x6F3914F18FE4DF57ULL);
+
+		Common::MemoryReadStream stream(data, sizeof(data));
+		TS_ASSERT_EQUALS(Common::computeStreamXXHash64(stream), 0x6F3914F18FE4DF57ULL);
+
+		stream.seek(0);
+		TS_ASSERT_EQUALS(Common::computeStreamXXHash64(stream, 3), Common::computeXXHash64(data, 3));
+	}
+};
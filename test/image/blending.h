@@ -1025,4 +1025,104 @@ public:
 		(void)areSurfacesEqual;
 #endif
 	}
+
+	void test_cross_blit_kernels() {
+		const Graphics::CrossBlit::Kernels *kernels[4];
+		int numKernels = 0;
+		kernels[numKernels++] = &Graphics::CrossBlit::kernelsGeneric;
+#ifdef SCUMMVM_NEON
+		kernels[numKernels++] = &Graphics::CrossBlit::kernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			kernels[numKernels++] = &Graphics::CrossBlit::kernelsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			kernels[numKernels++] = &Graphics::CrossBlit::kernelsAVX2;
+#endif
+
+		const Graphics::PixelFormat srcFormats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0),
+		};
+		const Graphics::PixelFormat dstFormats[] = {
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0),
+		};
+
+		// Odd sizes, so that both the vector loops and the tails are used
+		const uint w = 37, h = 3;
+		byte src[w * h * 4], dst[w * h * 4], expected[w * h * 4];
+		uint32 map[256];
+		uint32 seed = 12345;
+		for (uint i = 0; i < sizeof(src); i++) {
+			seed = seed * 1103515245 + 12345;
+			src[i] = seed >> 16;
+		}
+		for (uint i = 0; i < ARRAYSIZE(map); i++) {
+			seed = seed * 1103515245 + 12345;
+			map[i] = seed ^ (seed << 16);
+		}
+
+		const Graphics::CrossBlit::Kernels *oldKernels = Graphics::CrossBlit::kernels;
+
+		for (int k = 0; k < numKernels; k++) {
+			Graphics::CrossBlit::kernels = kernels[k];
+
+			for (uint s = 0; s < ARRAYSIZE(srcFormats); s++) {
+			for (uint d = 0; d < ARRAYSIZE(dstFormats); d++) {
+				const Graphics::PixelFormat &srcFmt = srcFormats[s];
+				const Graphics::PixelFormat &dstFmt = dstFormats[d];
+				const uint srcPitch = w * srcFmt.bytesPerPixel;
+
+				for (uint i = 0; i < w * h; i++) {
+					uint32 color = srcFmt.bytesPerPixel == 2 ? READ_UINT16(src + i * 2) : READ_UINT32(src + i * 4);
+					uint8 a, r, g, b;
+					srcFmt.colorToARGB(color, a, r, g, b);
+					WRITE_UINT32(expected + i * 4, dstFmt.ARGBToColor(a, r, g, b));
+				}
+
+				memset(dst, 0, sizeof(dst));
+				Graphics::crossBlit(dst, src, w * 4, srcPitch, w, h, dstFmt, srcFmt);
+				TSM_ASSERT(Common::String::format("crossBlit kernels %d, format %d -> %d", k, s, d).c_str(),
+				           memcmp(dst, expected, w * h * 4) == 0);
+
+				// In place
+				memcpy(dst, src, srcPitch * h);
+				Graphics::crossBlit(dst, dst, w * 4, srcPitch, w, h, dstFmt, srcFmt);
+				TSM_ASSERT(Common::String::format("in place crossBlit kernels %d, format %d -> %d", k, s, d).c_str(),
+				           memcmp(dst, expected, w * h * 4) == 0);
+			}
+			}
+
+			for (uint bpp = 2; bpp <= 4; bpp += 2) {
+				for (uint i = 0; i < w * h; i++) {
+					if (bpp == 2)
+						WRITE_UINT16(expected + i * 2, map[src[i]]);
+					else
+						WRITE_UINT32(expected + i * 4, map[src[i]]);
+				}
+
+				memset(dst, 0, sizeof(dst));
+				Graphics::crossBlitMap(dst, src, w * bpp, w, w, h, bpp, map);
+				TSM_ASSERT(Common::String::format("crossBlitMap kernels %d, %d bpp", k, bpp).c_str(),
+				           memcmp(dst, expected, w * h * bpp) == 0);
+
+				// In place
+				memcpy(dst, src, w * h);
+				Graphics::crossBlitMap(dst, dst, w * bpp, w, w, h, bpp, map);
+				TSM_ASSERT(Common::String::format("in place crossBlitMap kernels %d, %d bpp", k, bpp).c_str(),
+				           memcmp(dst, expected, w * h * bpp) == 0);
+			}
+		}
+
+		Graphics::CrossBlit::kernels = oldKernels;
+	}
 };
@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "image/png.h"
+#include "graphics/surface.h"
+
+class PNGDecoderTestSuite : public CxxTest::TestSuite {
+#ifdef USE_PNG
+	Graphics::Surface _image;
+	Common::MemoryWriteStreamDynamic *_png;
+
+	static void copyRow(const Graphics::Surface &row, int y, int height, void *refCon) {
+		Graphics::Surface *dst = (Graphics::Surface *)refCon;
+		if (y == 0)
+			dst->create(row.w, height, row.format);
+		dst->copyRectToSurface(row, 0, y, Common::Rect(row.w, 1));
+	}
+
+	// Decode the test image in the given format and compare it with a
+	// conversion of the original
+	void checkFormat(const Graphics::PixelFormat &format, bool rows) {
+		Image::PNGDecoder decoder;
+		TS_ASSERT(decoder.setOutputPixelFormat(format));
+
+		Common::MemoryReadStream stream(_png->getData(), _png->size());
+		Graphics::Surface decoded;
+		const Graphics::Surface *surface = &decoded;
+		if (rows) {
+			TS_ASSERT(decoder.loadStreamRows(stream, copyRow, &decoded));
+			TS_ASSERT(!decoder.getSurface());
+		} else {
+			TS_ASSERT(decoder.loadStream(stream));
+			surface = decoder.getSurface();
+		}
+
+		Graphics::Surface *expected = _image.convertTo(format);
+		TS_ASSERT_EQUALS(surface->format, format);
+		TS_ASSERT_EQUALS(surface->w, expected->w);
+		TS_ASSERT_EQUALS(surface->h, expected->h);
+		// Compare the colors, as unused bits may differ
+		for (int y = 0; y < expected->h; y++) {
+			for (int x = 0; x < expected->w; x++) {
+				byte a1, r1, g1, b1, a2, r2, g2, b2;
+				format.colorToARGB(surface->getPixel(x, y), a1, r1, g1, b1);
+				format.colorToARGB(expected->getPixel(x, y), a2, r2, g2, b2);
+				TS_ASSERT(a1 == a2 && r1 == r2 && g1 == g2 && b1 == b2);
+			}
+		}
+
+		expected->free();
+		delete expected;
+		decoded.free();
+	}
+#endif
+
+public:
+	void setUp() {
+#ifdef USE_PNG
+		// The byte order RGBA format writePNG() takes as it is
+#ifdef SCUMM_LITTLE_ENDIAN
+		_image.create(13, 7, Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24));
+#else
+		_image.create(13, 7, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+#endif
+		for (int y = 0; y < _image.h; y++)
+			for (int x = 0; x < _image.w; x++)
+				_image.setPixel(x, y, _image.format.ARGBToColor((x * 37) & 0xFF, x * 19, y * 31, (x + y) * 11));
+
+		_png = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		Image::writePNG(*_png, _image);
+#endif
+	}
+
+	void tearDown() {
+#ifdef USE_PNG
+		_image.free();
+		delete _png;
+#endif
+	}
+
+	void test_default_format() {
+#ifdef USE_PNG
+		checkFormat(_image.format, false);
+#endif
+	}
+
+	void test_output_formats() {
+#ifdef USE_PNG
+		checkFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), false);
+		checkFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24), false);
+		checkFormat(Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0), false);
+		checkFormat(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), false);
+		checkFormat(Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0), false);
+
+		Image::PNGDecoder decoder;
+		TS_ASSERT(!decoder.setOutputPixelFormat(Graphics::PixelFormat::createFormatCLUT8()));
+#endif
+	}
+
+	void test_rows() {
+#ifdef USE_PNG
+		checkFormat(_image.format, true);
+		checkFormat(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), true);
+#endif
+	}
+};
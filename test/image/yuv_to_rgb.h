@@ -0,0 +1,113 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/str.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	typedef Graphics::YUVToRGBManager::Kernels Kernels;
+
+	enum {
+		kWidth = 76,   // Not a multiple of 16, so that the tails are used
+		kHeight = 8,
+		kPlaneSize = (kWidth + 1) * (kHeight + 1)
+	};
+
+	byte _y[kPlaneSize], _u[kPlaneSize], _v[kPlaneSize];
+
+	void fillPlanes() {
+		uint32 seed = 12345;
+		for (uint i = 0; i < kPlaneSize; i++) {
+			seed = seed * 1103515245 + 12345;
+			_y[i] = seed >> 16;
+			_u[i] = seed >> 24;
+			// Cover every chroma value at least once
+			_v[i] = i;
+		}
+	}
+
+	void convert(int mode, Graphics::Surface &dst, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		const int pitch = kWidth + 1;
+		switch (mode) {
+		case 0:
+			YUVToRGBMan.convert444(&dst, scale, _y, _u, _v, kWidth, kHeight, pitch, pitch);
+			break;
+		case 1:
+			YUVToRGBMan.convert422(&dst, scale, _y, _u, _v, kWidth, kHeight, pitch, pitch);
+			break;
+		case 2:
+			YUVToRGBMan.convert420(&dst, scale, _y, _u, _v, kWidth, kHeight, pitch, pitch);
+			break;
+		default:
+			YUVToRGBMan.convert410(&dst, scale, _y, _u, _v, kWidth, kHeight, pitch, pitch);
+			break;
+		}
+	}
+
+public:
+	void test_kernels_match_tables() {
+		const Kernels *kernels[3];
+		int numKernels = 0;
+#ifdef SCUMMVM_NEON
+		kernels[numKernels++] = &Graphics::YUVToRGBManager::kernelsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			kernels[numKernels++] = &Graphics::YUVToRGBManager::kernelsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			kernels[numKernels++] = &Graphics::YUVToRGBManager::kernelsAVX2;
+#endif
+
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0),
+		};
+		const Graphics::YUVToRGBManager::LuminanceScale scales[] = {
+			Graphics::YUVToRGBManager::kScaleFull,
+			Graphics::YUVToRGBManager::kScaleITU
+		};
+
+		fillPlanes();
+
+		const Kernels *oldKernels = Graphics::YUVToRGBManager::kernels;
+		bool oldSelected = Graphics::YUVToRGBManager::kernelsSelected;
+		Graphics::YUVToRGBManager::kernelsSelected = true;
+
+		for (uint f = 0; f < ARRAYSIZE(formats); f++) {
+		for (uint s = 0; s < ARRAYSIZE(scales); s++) {
+		for (int mode = 0; mode < 4; mode++) {
+			Graphics::Surface expected, actual;
+			expected.create(kWidth, kHeight, formats[f]);
+			actual.create(kWidth, kHeight, formats[f]);
+
+			Graphics::YUVToRGBManager::kernels = nullptr;
+			convert(mode, expected, scales[s]);
+
+			for (int k = 0; k < numKernels; k++) {
+				Graphics::YUVToRGBManager::kernels = kernels[k];
+				memset(actual.getPixels(), 0, actual.pitch * actual.h);
+				convert(mode, actual, scales[s]);
+				TSM_ASSERT(Common::String::format("kernels %d, format %d, scale %d, mode %d", k, f, s, mode).c_str(),
+				           memcmp(actual.getPixels(), expected.getPixels(), expected.pitch * expected.h) == 0);
+			}
+
+			expected.free();
+			actual.free();
+		}
+		}
+		}
+
+		Graphics::YUVToRGBManager::kernels = oldKernels;
+		Graphics::YUVToRGBManager::kernelsSelected = oldSelected;
+	}
+};
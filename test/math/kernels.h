@@ -0,0 +1,233 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "math/frustum.h"
+#include "math/glmath.h"
+#include "math/kernels.h"
+
+#include "common/system.h"
+
+class KernelsTestSuite : public CxxTest::TestSuite {
+	uint32 _seed;
+
+	float randomFloat(float min, float max) {
+		_seed = _seed * 1103515245 + 12345;
+		return min + (max - min) * ((_seed >> 8) & 0xffff) / 65535.0f;
+	}
+
+	Math::Matrix4 randomMatrix() {
+		Math::Matrix4 m;
+		for (int i = 0; i < 16; i++)
+			m.getData()[i] = randomFloat(-2.0f, 2.0f);
+		return m;
+	}
+
+	Math::Quaternion randomQuaternion() {
+		Math::Quaternion q(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f));
+		return q.normalize();
+	}
+
+	void checkTransformPoints(Math::TransformPointsFunc func, const char *name) {
+		const uint count = 11;
+		Math::Vector3d points[count], expected[count], out[count];
+		for (uint i = 0; i < count; i++)
+			points[i].set(randomFloat(-100.0f, 100.0f), randomFloat(-100.0f, 100.0f), randomFloat(-100.0f, 100.0f));
+		// Signed zeros have to survive as well
+		points[0].set(0.0f, -0.0f, 0.0f);
+		const Math::Matrix4 matrix = randomMatrix();
+
+		for (int translate = 0; translate < 2; translate++) {
+			Math::transformPointsGeneric(expected, points, matrix, count, translate);
+			func(out, points, matrix, count, translate);
+			TSM_ASSERT(name, memcmp(out, expected, sizeof(out)) == 0);
+		}
+
+		// In place
+		func(points, points, matrix, count, true);
+		TSM_ASSERT(name, memcmp(points, expected, sizeof(points)) == 0);
+	}
+
+	void checkMultiplyMatrices(Math::MultiplyMatricesFunc func, const char *name) {
+		const uint count = 7;
+		Math::Matrix4 lhs[count], rhs[count], expected[count], out[count];
+		for (uint i = 0; i < count; i++) {
+			lhs[i] = randomMatrix();
+			rhs[i] = randomMatrix();
+		}
+
+		Math::multiplyMatricesGeneric(expected, lhs, rhs, count);
+		func(out, lhs, rhs, count);
+		TSM_ASSERT(name, memcmp(out, expected, sizeof(out)) == 0);
+
+		// In place
+		func(lhs, lhs, rhs, count);
+		TSM_ASSERT(name, memcmp(lhs, expected, sizeof(lhs)) == 0);
+	}
+
+	void checkComposeHierarchy(Math::ComposeHierarchyFunc func, const char *name) {
+		const uint count = 9;
+		const int parents[count] = { -1, 0, 1, 1, 0, -1, 5, 3, 7 };
+		Math::Matrix4 local[count], expected[count], out[count];
+		for (uint i = 0; i < count; i++)
+			local[i] = randomMatrix();
+
+		Math::composeHierarchyGeneric(expected, local, parents, count);
+		func(out, local, parents, count);
+		TSM_ASSERT(name, memcmp(out, expected, sizeof(out)) == 0);
+	}
+
+	void checkMultiplyQuaternions(Math::MultiplyQuaternionsFunc func, const char *name) {
+		const uint count = 13;
+		Math::Quaternion lhs[count], rhs[count], expected[count], out[count];
+		for (uint i = 0; i < count; i++) {
+			lhs[i] = randomQuaternion();
+			rhs[i] = randomQuaternion();
+		}
+
+		Math::multiplyQuaternionsGeneric(expected, lhs, rhs, count);
+		func(out, lhs, rhs, count);
+		TSM_ASSERT(name, memcmp(out, expected, sizeof(out)) == 0);
+
+		// In place
+		func(rhs, lhs, rhs, count);
+		TSM_ASSERT(name, memcmp(rhs, expected, sizeof(rhs)) == 0);
+	}
+
+	void checkCullBoxes(Math::CullBoxesFunc func, const char *name) {
+		Math::Frustum frustum;
+		frustum.setup(Math::makeFrustumMatrix(-1.0f, 1.0f, -0.75f, 0.75f, 1.0f, 100.0f));
+
+		const uint count = 50;
+		Math::AABB boxes[count];
+		bool expected[count], out[count];
+		for (uint i = 0; i < count; i++) {
+			Math::Vector3d center(randomFloat(-60.0f, 60.0f), randomFloat(-60.0f, 60.0f), randomFloat(-120.0f, 20.0f));
+			Math::Vector3d size(randomFloat(0.0f, 10.0f), randomFloat(0.0f, 10.0f), randomFloat(0.0f, 10.0f));
+			boxes[i] = Math::AABB(center - size, center + size);
+			expected[i] = frustum.isInside(boxes[i]);
+		}
+
+		frustum.isInside(boxes, count, out);
+		TS_ASSERT(memcmp(out, expected, sizeof(out)) == 0);
+
+		// The frustum planes are private, so the kernels are checked with the
+		// planes of a box around the origin instead
+		Math::Plane planes[6];
+		for (int i = 0; i < 6; i++) {
+			planes[i]._normal.set(0.0f, 0.0f, 0.0f);
+			planes[i]._normal.getData()[i / 2] = (i & 1) ? -1.0f : 1.0f;
+			planes[i]._d = 30.0f;
+		}
+
+		Math::cullBoxesGeneric(expected, boxes, count, planes, 6);
+		func(out, boxes, count, planes, 6);
+		TSM_ASSERT(name, memcmp(out, expected, sizeof(out)) == 0);
+
+		uint numInside = 0;
+		for (uint i = 0; i < count; i++)
+			numInside += expected[i];
+		TS_ASSERT(numInside > 0 && numInside < count);
+	}
+
+	void checkSlerpQuaternions(Math::SlerpQuaternionsFunc func, const char *name) {
+		// Not a multiple of four, so that the tail is used as well
+		const uint count = 43;
+		Math::Quaternion from[count], to[count], expected[count], out[count];
+		float t[count];
+		for (uint i = 0; i < count; i++) {
+			from[i] = randomQuaternion();
+			to[i] = randomQuaternion();
+			t[i] = randomFloat(0.0f, 1.0f);
+		}
+		// Identical and opposite quaternions, and the extreme weights
+		to[1] = from[1];
+		to[2] = from[2] * -1.0f;
+		t[3] = 0.0f;
+		t[4] = 1.0f;
+		// A weight outside of [0, 1]
+		t[9] = 1.5f;
+
+		Math::slerpQuaternionsGeneric(expected, from, to, t, count);
+		func(out, from, to, t, count);
+		for (uint i = 0; i < count; i++) {
+			for (int j = 0; j < 4; j++)
+				TSM_ASSERT_DELTA(name, out[i].getData()[j], expected[i].getData()[j], 1e-6f);
+		}
+	}
+
+public:
+	void setUp() {
+		_seed = 4711;
+	}
+
+	void test_multiplyMatricesGeneric() {
+		Math::Matrix4 lhs = randomMatrix(), rhs = randomMatrix(), out;
+		Math::multiplyMatricesGeneric(&out, &lhs, &rhs, 1);
+		Math::Matrix4 expected = lhs * rhs;
+		TS_ASSERT(memcmp(&out, &expected, sizeof(out)) == 0);
+	}
+
+	void test_composeHierarchyGeneric() {
+		const int parents[3] = { -1, 0, 1 };
+		Math::Matrix4 local[3] = { randomMatrix(), randomMatrix(), randomMatrix() };
+		Math::Matrix4 world[3];
+		Math::composeHierarchyGeneric(world, local, parents, 3);
+
+		Math::Matrix4 expected = local[0] * local[1] * local[2];
+		TS_ASSERT(memcmp(&world[2], &expected, sizeof(expected)) == 0);
+	}
+
+	void test_transformPointsGeneric() {
+		const Math::Matrix4 matrix = randomMatrix();
+		Math::Vector3d point(1.0f, 2.0f, 3.0f), out;
+		Math::transformPointsGeneric(&out, &point, matrix, 1, true);
+		matrix.transform(&point, true);
+		TS_ASSERT(memcmp(&out, &point, sizeof(out)) == 0);
+	}
+
+	void test_cullBoxesGeneric() {
+		checkCullBoxes(Math::cullBoxesGeneric, "Generic");
+	}
+
+	void test_transformPoints() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkTransformPoints(Math::transformPointsSSE2, "SSE2");
+#endif
+	}
+
+	void test_multiplyMatrices() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkMultiplyMatrices(Math::multiplyMatricesSSE2, "SSE2");
+#endif
+	}
+
+	void test_composeHierarchy() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkComposeHierarchy(Math::composeHierarchySSE2, "SSE2");
+#endif
+	}
+
+	void test_multiplyQuaternions() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkMultiplyQuaternions(Math::multiplyQuaternionsSSE2, "SSE2");
+#endif
+	}
+
+	void test_cullBoxes() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkCullBoxes(Math::cullBoxesSSE2, "SSE2");
+#endif
+	}
+
+	void test_slerpQuaternions() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkSlerpQuaternions(Math::slerpQuaternionsSSE2, "SSE2");
+#endif
+	}
+};
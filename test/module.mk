@@ -1,15 +1,19 @@
 ######################################################################
 # Unit/regression tests, based on CxxTest.
-# Use the 'test' target to run them.
+# Use the 'test' target to run them, and the 'bench' target to run the
+# micro-benchmarks in BENCHES.
 # Edit TESTS and TESTLIBS to add more tests.
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/common/formats/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/common/formats/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h $(srcdir)/test/video/*.h
+BENCHES      := $(srcdir)/test/bench/*.h
 TEST_LIBS    :=
 
 ifdef POSIX
 TEST_LIBS += test/null_osystem.o \
+	test/threaded_jobsystem.o \
+	backends/jobs/default/default-jobs.o \
 	backends/fs/posix/posix-fs-factory.o \
 	backends/fs/posix/posix-fs.o \
 	backends/fs/posix/posix-iostream.o \
@@ -28,7 +32,8 @@ TEST_LIBS += test/null_osystem.o \
 	backends/platform/sdl/win32/win32_wrapper.o
 endif
 
-TEST_LIBS +=	audio/libaudio.a math/libmath.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
+# The libraries of common come last, since all the others depend on them
+TEST_LIBS +=	video/libvideo.a audio/libaudio.a math/libmath.a image/libimage.a graphics/libgraphics.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -79,9 +84,17 @@ test/runner.cpp: $(TESTS) $(srcdir)/test/module.mk
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+bench: test/bench-runner
+	./test/bench-runner
+test/bench-runner: test/bench-runner.cpp $(TEST_LIBS)
+	+$(QUIET_CXX)$(LD) $(TEST_CXXFLAGS) $(CPPFLAGS) $(TEST_CFLAGS) -o $@ test/bench-runner.cpp $(TEST_LIBS) $(TEST_LDFLAGS)
+test/bench-runner.cpp: $(BENCHES) $(srcdir)/test/bench/runner.tpl $(srcdir)/test/module.mk
+	@mkdir -p test
+	$(srcdir)/test/cxxtest/cxxtestgen.py --template=$(srcdir)/test/bench/runner.tpl --no-std --no-eh -o $@ $(BENCHES)
+
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat test/null_osystem.o
+	-$(RM) test/runner.cpp test/runner test/bench-runner.cpp test/bench-runner test/engine-data/encoding.dat test/null_osystem.o
 	-rmdir test/engine-data
 
 test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
@@ -90,4 +103,4 @@ test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
 
 copy-dat: test/engine-data/encoding.dat
 
-.PHONY: test clean-test copy-dat
+.PHONY: test bench clean-test copy-dat
@@ -1,7 +1,9 @@
 #define USE_NULL_DRIVER 1
 #define NULL_DRIVER_USE_FOR_TEST 1
+#include "instrset_detect.h"
 #include "null_osystem.h"
 #include "../backends/platform/null/null.cpp"
+#include "../common/jobsystem.h"
 
 //#define DISPLAY_ERROR_MESSAGES
 
@@ -15,6 +17,33 @@ void Common::install_null_g_system() {
 	g_system = OSystem_NULL_create(silenceLogs);
 }
 
+// There is no graphics manager to forward the queries to, but the CPU
+// features are needed for selecting the SIMD kernels
+bool OSystem_NULL::hasFeature(Feature f) {
+#ifdef SCUMMVM_NEON
+	if (f == kFeatureCpuNEON)
+		return true;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (f == kFeatureCpuSSE2)
+		return instrset_detect() >= 2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (f == kFeatureCpuAVX2)
+		return instrset_detect() >= 8;
+#endif
+	return false;
+}
+
+void OSystem_NULL::setJobSystem(Common::JobSystem *jobSystem) {
+	delete _jobSystem;
+	_jobSystem = jobSystem;
+}
+
+void Common::install_null_g_system_job_system(Common::JobSystem *jobSystem) {
+	dynamic_cast<OSystem_NULL *>(g_system)->setJobSystem(jobSystem);
+}
+
 bool BaseBackend::setScaler(const char *name, int factor) {
 	return false;
 }
@@ -2,7 +2,11 @@
 #define TEST_NULL_OSYSTEM 1
 namespace Common {
 #if defined(POSIX) || defined(WIN32)
+class JobSystem;
+
 void install_null_g_system();
+/** Make g_system use @p jobSystem, which it takes ownership of. */
+void install_null_g_system_job_system(JobSystem *jobSystem);
 #define NULL_OSYSTEM_IS_AVAILABLE 1
 #else
 #define NULL_OSYSTEM_IS_AVAILABLE 0
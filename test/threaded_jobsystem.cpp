@@ -0,0 +1,50 @@
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+#include "threaded_jobsystem.h"
+#include "../backends/jobs/default/default-jobs.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class ThreadedJobSystem : public DefaultJobSystem {
+public:
+	ThreadedJobSystem(uint workers) {
+		startWorkers(workers);
+	}
+
+	~ThreadedJobSystem() override {
+		stopWorkers();
+	}
+
+protected:
+	bool createWorkerThread(uint index) override {
+		_threads.push_back(std::thread(&ThreadedJobSystem::workerMain, this, index));
+		return true;
+	}
+
+	void joinWorkerThreads() override {
+		for (std::thread &thread : _threads)
+			thread.join();
+		_threads.clear();
+	}
+
+	void lock() override { _mutex.lock(); }
+	void unlock() override { _mutex.unlock(); }
+	void sleep() override { _cond.wait(_mutex); }
+	void wakeOne() override { _cond.notify_one(); }
+	void wakeAll() override { _cond.notify_all(); }
+
+private:
+	std::mutex _mutex;
+	std::condition_variable_any _cond;
+	std::vector<std::thread> _threads;
+};
+
+} // End of anonymous namespace
+
+DefaultJobSystem *Common::create_threaded_job_system(uint workers) {
+	return new ThreadedJobSystem(workers);
+}
@@ -0,0 +1,19 @@
+#ifndef TEST_THREADED_JOBSYSTEM
+#define TEST_THREADED_JOBSYSTEM 1
+#include "common/scummsys.h"
+
+class DefaultJobSystem;
+
+namespace Common {
+#if defined(POSIX)
+/**
+ * Create a DefaultJobSystem running @p workers threads, built on the
+ * threads of the C++ standard library.
+ */
+DefaultJobSystem *create_threaded_job_system(uint workers);
+#define THREADED_JOB_SYSTEM_IS_AVAILABLE 1
+#else
+#define THREADED_JOB_SYSTEM_IS_AVAILABLE 0
+#endif
+}
+#endif
@@ -0,0 +1,195 @@
+#include <cxxtest/TestSuite.h>
+
+#include "video/video_decoder.h"
+
+#include "common/jobsystem.h"
+#include "common/list.h"
+#include "graphics/surface.h"
+
+#include "../null_osystem.h"
+
+namespace {
+
+// Job system with a pretend worker, which only runs the jobs when asked to
+class ManualJobSystem : public Common::JobSystem {
+public:
+	uint getWorkerCount() const override { return 1; }
+
+	void submit(Common::JobGroup &group, JobProc proc, void *refCon) override {
+		Job job = { proc, refCon, &group };
+		_jobs.push_back(job);
+		pendingJobs(group)++;
+	}
+
+	void wait(Common::JobGroup &group) override { runJobs(); }
+	void waitWithoutHelping(Common::JobGroup &group) override { runJobs(); }
+	bool isDone(Common::JobGroup &group) override { return pendingJobs(group) == 0; }
+
+	// Run the queued jobs, and return how many there were
+	uint runJobs() {
+		uint count = 0;
+		while (!_jobs.empty()) {
+			Job job = _jobs.front();
+			_jobs.pop_front();
+			job.proc(job.refCon);
+			pendingJobs(*job.group)--;
+			count++;
+		}
+		return count;
+	}
+
+private:
+	struct Job {
+		JobProc proc;
+		void *refCon;
+		Common::JobGroup *group;
+	};
+
+	Common::List<Job> _jobs;
+};
+
+class CountingDecoder : public Video::VideoDecoder {
+public:
+	// Video track whose frames are filled with their number
+	class CountingVideoTrack : public FixedRateVideoTrack {
+	public:
+		CountingVideoTrack(int frameCount) : _frameCount(frameCount), _curFrame(-1), _decodedFrames(0) {
+			_surface.create(4, 1, Graphics::PixelFormat::createFormatCLUT8());
+		}
+
+		~CountingVideoTrack() override {
+			_surface.free();
+		}
+
+		uint16 getWidth() const override { return _surface.w; }
+		uint16 getHeight() const override { return _surface.h; }
+		Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
+		int getCurFrame() const override { return _curFrame; }
+		int getFrameCount() const override { return _frameCount; }
+
+		bool isSeekable() const override { return true; }
+
+		bool seek(const Audio::Timestamp &time) override {
+			_curFrame = (int)getFrameAtTime(time) - 1;
+			return true;
+		}
+
+		const Graphics::Surface *decodeNextFrame() override {
+			_curFrame++;
+			_decodedFrames++;
+			memset(_surface.getPixels(), _curFrame, _surface.w);
+			return &_surface;
+		}
+
+		int getDecodedFrames() const { return _decodedFrames; }
+
+	protected:
+		Common::Rational getFrameRate() const override { return 10; }
+
+	private:
+		Graphics::Surface _surface;
+		int _frameCount;
+		int _curFrame;
+		int _decodedFrames;
+	};
+
+	CountingDecoder(int frameCount) {
+		_track = new CountingVideoTrack(frameCount);
+		addTrack(_track);
+	}
+
+	~CountingDecoder() override {
+		close();
+	}
+
+	bool loadStream(Common::SeekableReadStream *stream) override { return false; }
+
+	CountingVideoTrack *getTrack() const { return _track; }
+
+private:
+	CountingVideoTrack *_track;
+};
+
+int getFrameNumber(const Graphics::Surface *frame) {
+	return frame ? *(const byte *)frame->getPixels() : -1;
+}
+
+} // End of anonymous namespace
+
+class VideoDecoderTestSuite : public CxxTest::TestSuite {
+public:
+	void test_decode_ahead() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		ManualJobSystem *jobs = new ManualJobSystem();
+		Common::install_null_g_system_job_system(jobs);
+
+		CountingDecoder decoder(10);
+		CountingDecoder::CountingVideoTrack *track = decoder.getTrack();
+		decoder.setDecodeAhead(3);
+
+		// The first frame is decoded right away, the next ones by the worker
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 0);
+		TS_ASSERT_EQUALS(track->getDecodedFrames(), 1);
+		TS_ASSERT_EQUALS(jobs->runJobs(), 1u);
+		TS_ASSERT_EQUALS(track->getDecodedFrames(), 4);
+
+		// The decoder reports the frame returned, not the track's
+		TS_ASSERT_EQUALS(track->getCurFrame(), 3);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 0);
+
+		for (int i = 1; i < 10; i++) {
+			TS_ASSERT(!decoder.endOfVideo());
+			TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), i);
+			TS_ASSERT_EQUALS(decoder.getCurFrame(), i);
+			jobs->runJobs();
+		}
+
+		TS_ASSERT(decoder.endOfVideo());
+		TS_ASSERT_EQUALS(track->getDecodedFrames(), 10);
+#endif
+	}
+
+	void test_decode_ahead_seek() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		ManualJobSystem *jobs = new ManualJobSystem();
+		Common::install_null_g_system_job_system(jobs);
+
+		CountingDecoder decoder(10);
+		decoder.setDecodeAhead(3);
+
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 0);
+		jobs->runJobs();
+
+		// Seeking drops the frames decoded ahead
+		TS_ASSERT(decoder.seekToFrame(6));
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 6);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 6);
+		jobs->runJobs();
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 7);
+
+		TS_ASSERT(decoder.rewind());
+		TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), 0);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 0);
+#endif
+	}
+
+	void test_no_workers() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// Without workers, the frames are decoded when asked for
+		Common::install_null_g_system();
+
+		CountingDecoder decoder(3);
+		CountingDecoder::CountingVideoTrack *track = decoder.getTrack();
+		decoder.setDecodeAhead(3);
+
+		for (int i = 0; i < 3; i++) {
+			TS_ASSERT_EQUALS(getFrameNumber(decoder.decodeNextFrame()), i);
+			TS_ASSERT_EQUALS(track->getDecodedFrames(), i + 1);
+		}
+
+		TS_ASSERT(decoder.endOfVideo());
+#endif
+	}
+};
@@ -950,6 +950,7 @@ AVIDecoder::AVIVideoTrack::AVIVideoTrack(int frameCount, const AVIStreamHeader &
 	_videoCodec = createCodec();
 	_lastFrame = 0;
 	_curFrame = -1;
+	_lastDecodedFrame = -1;
 	_reversed = false;
 
 	useInitialPalette();
@@ -962,8 +963,18 @@ AVIDecoder::AVIVideoTrack::~AVIVideoTrack() {
 
 void AVIDecoder::AVIVideoTrack::decodeFrame(Common::SeekableReadStream *stream) {
 	if (stream) {
-		if (_videoCodec)
+		if (_videoCodec) {
 			_lastFrame = _videoCodec->decodeFrame(*stream);
+
+			// The codec only knows what changed since the frame it decoded before
+			int frame = _reversed ? _curFrame - 1 : _curFrame + 1;
+			if (_reversed || frame == 0 || frame != _lastDecodedFrame + 1)
+				addDirtyRects(_dirtyRects, nullptr);
+			else
+				addDirtyRects(_dirtyRects, _videoCodec->getDirtyRects());
+
+			_lastDecodedFrame = frame;
+		}
 	} else {
 		// Empty frame
 		_lastFrame = 0;
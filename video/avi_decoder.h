@@ -217,6 +217,8 @@ protected:
 		int getFrameCount() const { return _frameCount; }
 		Common::String &getName() { return _vidsHeader.name; }
 		const Graphics::Surface *decodeNextFrame() { return _lastFrame; }
+		const Common::List<Common::Rect> *getDirtyRects() const { return &_dirtyRects; }
+		void clearDirtyRects() { _dirtyRects.clear(); }
 
 		const byte *getPalette() const;
 		bool hasDirtyPalette() const;
@@ -277,6 +279,8 @@ protected:
 
 		Image::Codec *_videoCodec;
 		const Graphics::Surface *_lastFrame;
+		Common::List<Common::Rect> _dirtyRects;
+		int _lastDecodedFrame;
 		Image::Codec *createCodec();
 	};
 
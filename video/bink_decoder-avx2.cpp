@@ -0,0 +1,167 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef USE_BINK
+
+#include <immintrin.h>
+
+#include "video/bink_decoder.h"
+
+namespace Video {
+
+namespace {
+
+static inline __m256i mul(__m256i a, int32 k) {
+	return _mm256_mullo_epi32(a, _mm256_set1_epi32(k));
+}
+
+// The same steps as IDCT_TRANSFORM in bink_decoder.cpp, on eight columns or rows at once
+static inline void transform(__m256i *d, const __m256i *s) {
+	const __m256i a0 = _mm256_add_epi32(s[0], s[4]);
+	const __m256i a1 = _mm256_sub_epi32(s[0], s[4]);
+	const __m256i a2 = _mm256_add_epi32(s[2], s[6]);
+	const __m256i a3 = _mm256_srai_epi32(mul(_mm256_sub_epi32(s[2], s[6]), 2896), 11);
+	const __m256i a4 = _mm256_add_epi32(s[5], s[3]);
+	const __m256i a5 = _mm256_sub_epi32(s[5], s[3]);
+	const __m256i a6 = _mm256_add_epi32(s[1], s[7]);
+	const __m256i a7 = _mm256_sub_epi32(s[1], s[7]);
+	const __m256i b0 = _mm256_add_epi32(a4, a6);
+	const __m256i b1 = _mm256_srai_epi32(mul(_mm256_add_epi32(a5, a7), 3784), 11);
+	const __m256i b2 = _mm256_add_epi32(_mm256_sub_epi32(_mm256_srai_epi32(mul(a5, -5352), 11), b0), b1);
+	const __m256i b3 = _mm256_sub_epi32(_mm256_srai_epi32(mul(_mm256_sub_epi32(a6, a4), 2896), 11), b2);
+	const __m256i b4 = _mm256_sub_epi32(_mm256_add_epi32(_mm256_srai_epi32(mul(a7, 2217), 11), b3), b1);
+
+	const __m256i a02p = _mm256_add_epi32(a0, a2);
+	const __m256i a02m = _mm256_sub_epi32(a0, a2);
+	const __m256i a132 = _mm256_sub_epi32(_mm256_add_epi32(a1, a3), a2);
+	const __m256i a132m = _mm256_add_epi32(_mm256_sub_epi32(a1, a3), a2);
+
+	d[0] = _mm256_add_epi32(a02p, b0);
+	d[1] = _mm256_add_epi32(a132, b2);
+	d[2] = _mm256_add_epi32(a132m, b3);
+	d[3] = _mm256_sub_epi32(a02m, b4);
+	d[4] = _mm256_add_epi32(a02m, b4);
+	d[5] = _mm256_sub_epi32(a132m, b3);
+	d[6] = _mm256_sub_epi32(a132, b2);
+	d[7] = _mm256_sub_epi32(a02p, b0);
+}
+
+static inline void transpose(__m256i *r) {
+	const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+	const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+	const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+	const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+	const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+	const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+	const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+	const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+	const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+	const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+	const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+	const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+	const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+	const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+	const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+	const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+	r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+	r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+	r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+	r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+	r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+	r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+	r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+	r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// Leaves the rows of the transformed block in rows
+static inline void transformBlock(__m256i *rows, const int32 *block) {
+	__m256i src[8];
+
+	for (int i = 0; i < 8; i++)
+		src[i] = _mm256_loadu_si256((const __m256i *)(block + 8 * i));
+	transform(rows, src);
+
+	transpose(rows);
+
+	const __m256i round = _mm256_set1_epi32(0x7F);
+	transform(src, rows);
+	for (int i = 0; i < 8; i++)
+		rows[i] = _mm256_srai_epi32(_mm256_add_epi32(src[i], round), 8);
+
+	transpose(rows);
+}
+
+// Keep the low byte of each value of two rows, like storing them to a byte does
+static inline __m128i packBytes(__m256i row0, __m256i row1) {
+	const __m256i mask = _mm256_set1_epi32(0xFF);
+	const __m256i words = _mm256_packs_epi32(_mm256_and_si256(row0, mask), _mm256_and_si256(row1, mask));
+	const __m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(words, words), _MM_SHUFFLE(3, 1, 2, 0));
+
+	// Row 0 in the low half, row 1 in the high half
+	return _mm_shuffle_epi32(_mm256_castsi256_si128(bytes), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+static void IDCT_AVX2(int32 *block) {
+	__m256i rows[8];
+	transformBlock(rows, block);
+
+	for (int i = 0; i < 8; i++)
+		_mm256_storeu_si256((__m256i *)(block + 8 * i), rows[i]);
+}
+
+static void IDCTPut_AVX2(byte *dest, uint32 pitch, int32 *block) {
+	__m256i rows[8];
+	transformBlock(rows, block);
+
+	for (int i = 0; i < 8; i += 2, dest += 2 * pitch) {
+		const __m128i bytes = packBytes(rows[i], rows[i + 1]);
+		_mm_storel_epi64((__m128i *)dest, bytes);
+		_mm_storel_epi64((__m128i *)(dest + pitch), _mm_unpackhi_epi64(bytes, bytes));
+	}
+}
+
+static void IDCTAdd_AVX2(byte *dest, uint32 pitch, int32 *block) {
+	__m256i rows[8];
+	transformBlock(rows, block);
+
+	for (int i = 0; i < 8; i += 2, dest += 2 * pitch) {
+		const __m128i old = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)dest), _mm_loadl_epi64((const __m128i *)(dest + pitch)));
+		const __m128i bytes = _mm_add_epi8(old, packBytes(rows[i], rows[i + 1]));
+		_mm_storel_epi64((__m128i *)dest, bytes);
+		_mm_storel_epi64((__m128i *)(dest + pitch), _mm_unpackhi_epi64(bytes, bytes));
+	}
+}
+
+} // End of anonymous namespace
+
+const BinkDecoder::BinkVideoTrack::IDCTKernels BinkDecoder::BinkVideoTrack::idctKernelsAVX2 = {
+	IDCT_AVX2,
+	IDCTPut_AVX2,
+	IDCTAdd_AVX2
+};
+
+} // End of namespace Video
+
+#endif // USE_BINK
@@ -0,0 +1,172 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef USE_BINK
+
+#include <emmintrin.h>
+
+#include "video/bink_decoder.h"
+
+namespace Video {
+
+namespace {
+
+// SSE2 has no 32-bit multiplication keeping the low half
+static inline __m128i mul(__m128i a, int32 k) {
+	const __m128i kk = _mm_set1_epi32(k);
+	__m128i even = _mm_mul_epu32(a, kk);
+	__m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), kk);
+
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// The same steps as IDCT_TRANSFORM in bink_decoder.cpp, on four columns or rows at once
+static inline void transform(__m128i *d, const __m128i *s) {
+	const __m128i a0 = _mm_add_epi32(s[0], s[4]);
+	const __m128i a1 = _mm_sub_epi32(s[0], s[4]);
+	const __m128i a2 = _mm_add_epi32(s[2], s[6]);
+	const __m128i a3 = _mm_srai_epi32(mul(_mm_sub_epi32(s[2], s[6]), 2896), 11);
+	const __m128i a4 = _mm_add_epi32(s[5], s[3]);
+	const __m128i a5 = _mm_sub_epi32(s[5], s[3]);
+	const __m128i a6 = _mm_add_epi32(s[1], s[7]);
+	const __m128i a7 = _mm_sub_epi32(s[1], s[7]);
+	const __m128i b0 = _mm_add_epi32(a4, a6);
+	const __m128i b1 = _mm_srai_epi32(mul(_mm_add_epi32(a5, a7), 3784), 11);
+	const __m128i b2 = _mm_add_epi32(_mm_sub_epi32(_mm_srai_epi32(mul(a5, -5352), 11), b0), b1);
+	const __m128i b3 = _mm_sub_epi32(_mm_srai_epi32(mul(_mm_sub_epi32(a6, a4), 2896), 11), b2);
+	const __m128i b4 = _mm_sub_epi32(_mm_add_epi32(_mm_srai_epi32(mul(a7, 2217), 11), b3), b1);
+
+	const __m128i a02p = _mm_add_epi32(a0, a2);
+	const __m128i a02m = _mm_sub_epi32(a0, a2);
+	const __m128i a132 = _mm_sub_epi32(_mm_add_epi32(a1, a3), a2);
+	const __m128i a132m = _mm_add_epi32(_mm_sub_epi32(a1, a3), a2);
+
+	d[0] = _mm_add_epi32(a02p, b0);
+	d[1] = _mm_add_epi32(a132, b2);
+	d[2] = _mm_add_epi32(a132m, b3);
+	d[3] = _mm_sub_epi32(a02m, b4);
+	d[4] = _mm_add_epi32(a02m, b4);
+	d[5] = _mm_sub_epi32(a132m, b3);
+	d[6] = _mm_sub_epi32(a132, b2);
+	d[7] = _mm_sub_epi32(a02p, b0);
+}
+
+static inline void transpose4(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) {
+	const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+// Transpose an 8x8 block held as the left and right halves of its rows
+static inline void transpose(__m128i *left, __m128i *right) {
+	transpose4(left[0], left[1], left[2], left[3]);
+	transpose4(left[4], left[5], left[6], left[7]);
+	transpose4(right[0], right[1], right[2], right[3]);
+	transpose4(right[4], right[5], right[6], right[7]);
+
+	for (int i = 0; i < 4; i++) {
+		const __m128i t = left[4 + i];
+		left[4 + i] = right[i];
+		right[i] = t;
+	}
+}
+
+// Leaves the rows of the transformed block in left and right
+static inline void transformBlock(__m128i *left, __m128i *right, const int32 *block) {
+	__m128i src[8];
+
+	for (int i = 0; i < 8; i++)
+		src[i] = _mm_loadu_si128((const __m128i *)(block + 8 * i));
+	transform(left, src);
+
+	for (int i = 0; i < 8; i++)
+		src[i] = _mm_loadu_si128((const __m128i *)(block + 8 * i + 4));
+	transform(right, src);
+
+	transpose(left, right);
+
+	const __m128i round = _mm_set1_epi32(0x7F);
+	__m128i t[8];
+	transform(t, left);
+	for (int i = 0; i < 8; i++)
+		left[i] = _mm_srai_epi32(_mm_add_epi32(t[i], round), 8);
+	transform(t, right);
+	for (int i = 0; i < 8; i++)
+		right[i] = _mm_srai_epi32(_mm_add_epi32(t[i], round), 8);
+
+	transpose(left, right);
+}
+
+// Keep the low byte of each value, like storing them to a byte does
+static inline __m128i packBytes(__m128i left, __m128i right) {
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	const __m128i words = _mm_packs_epi32(_mm_and_si128(left, mask), _mm_and_si128(right, mask));
+
+	return _mm_packus_epi16(words, words);
+}
+
+static void IDCT_SSE2(int32 *block) {
+	__m128i left[8], right[8];
+	transformBlock(left, right, block);
+
+	for (int i = 0; i < 8; i++) {
+		_mm_storeu_si128((__m128i *)(block + 8 * i), left[i]);
+		_mm_storeu_si128((__m128i *)(block + 8 * i + 4), right[i]);
+	}
+}
+
+static void IDCTPut_SSE2(byte *dest, uint32 pitch, int32 *block) {
+	__m128i left[8], right[8];
+	transformBlock(left, right, block);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		_mm_storel_epi64((__m128i *)dest, packBytes(left[i], right[i]));
+}
+
+static void IDCTAdd_SSE2(byte *dest, uint32 pitch, int32 *block) {
+	__m128i left[8], right[8];
+	transformBlock(left, right, block);
+
+	for (int i = 0; i < 8; i++, dest += pitch) {
+		const __m128i old = _mm_loadl_epi64((const __m128i *)dest);
+		_mm_storel_epi64((__m128i *)dest, _mm_add_epi8(old, packBytes(left[i], right[i])));
+	}
+}
+
+} // End of anonymous namespace
+
+const BinkDecoder::BinkVideoTrack::IDCTKernels BinkDecoder::BinkVideoTrack::idctKernelsSSE2 = {
+	IDCT_SSE2,
+	IDCTPut_SSE2,
+	IDCTAdd_SSE2
+};
+
+} // End of namespace Video
+
+#endif // USE_BINK
@@ -26,6 +26,7 @@
 #include "audio/audiostream.h"
 #include "audio/decoders/raw.h"
 
+#include "common/debug.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 #include "common/math.h"
@@ -35,6 +36,7 @@
 #include "common/str.h"
 #include "common/bitstream.h"
 #include "common/huffman.h"
+#include "common/jobsystem.h"
 #include "common/system.h"
 
 #include "graphics/yuv_to_rgb.h"
@@ -200,16 +202,23 @@ void BinkDecoder::readNextPacket() {
 		}
 	}
 
-	uint32 videoPacketStart = _bink->pos();
-	uint32 videoPacketEnd   = _bink->pos() + frameSize;
+	// Read the whole packet, so that its planes can be decoded in parallel
+	_videoPacket.resize(frameSize);
+	if (_bink->read(_videoPacket.data(), frameSize) != frameSize) {
+		// The file is truncated, so end the video at the last complete frame
+		warning("Bink video packet too short");
+		videoTrack->setCurFrame(videoTrack->getFrameCount() - 1);
+		return;
+	}
 
-	frame.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-			videoPacketStart, videoPacketEnd), DisposeAfterUse::YES);
+	frame.data = _videoPacket.data();
+	frame.bits = new Common::BitStreamMemory32LELSB(new Common::BitStreamMemoryStream(frame.data, frameSize), DisposeAfterUse::YES);
 
 	videoTrack->decodePacket(frame);
 
 	delete frame.bits;
 	frame.bits = 0;
+	frame.data = 0;
 }
 
 VideoDecoder::AudioTrack *BinkDecoder::getAudioTrack(int index) {
@@ -222,7 +231,7 @@ VideoDecoder::AudioTrack *BinkDecoder::getAudioTrack(int index) {
 	return (AudioTrack *)track;
 }
 
-BinkDecoder::VideoFrame::VideoFrame() : bits(0) {
+BinkDecoder::VideoFrame::VideoFrame() : data(0), bits(0) {
 }
 
 BinkDecoder::VideoFrame::~VideoFrame() {
@@ -243,29 +252,36 @@ BinkDecoder::AudioInfo::~AudioInfo() {
 }
 
 BinkDecoder::BinkVideoTrack::BinkVideoTrack(uint32 width, uint32 height, uint32 frameCount, const Common::Rational &frameRate, bool swapPlanes, bool hasAlpha, uint32 id) :
-		_frameCount(frameCount), _frameRate(frameRate), _swapPlanes(swapPlanes), _hasAlpha(hasAlpha), _id(id), _surface(nullptr) {
+		_frameCount(frameCount), _frameRate(frameRate), _swapPlanes(swapPlanes), _hasAlpha(hasAlpha), _id(id), _surface(nullptr),
+		_planeOffsetCandidates(0x3F), _planeOffsetFrames(0), _planeOffsetMode(-1) {
 	_curFrame = -1;
 
 	for (int i = 0; i < 16; i++)
 		_huffman[i] = 0;
 
-	for (int i = 0; i < kSourceMAX; i++) {
-		_bundles[i].countLength = 0;
+	for (int s = 0; s < 2; s++) {
+		BundleSet &set = _bundleSets[s];
 
-		_bundles[i].huffman.index = 0;
-		for (int j = 0; j < 16; j++)
-			_bundles[i].huffman.symbols[j] = j;
+		for (int i = 0; i < kSourceMAX; i++) {
+			set.bundles[i].countLength = 0;
 
-		_bundles[i].data     = 0;
-		_bundles[i].dataEnd  = 0;
-		_bundles[i].curDec   = 0;
-		_bundles[i].curPtr   = 0;
-	}
+			set.bundles[i].huffman.index = 0;
+			for (int j = 0; j < 16; j++)
+				set.bundles[i].huffman.symbols[j] = j;
 
-	for (int i = 0; i < 16; i++) {
-		_colHighHuffman[i].index = 0;
-		for (int j = 0; j < 16; j++)
-			_colHighHuffman[i].symbols[j] = j;
+			set.bundles[i].data     = 0;
+			set.bundles[i].dataEnd  = 0;
+			set.bundles[i].curDec   = 0;
+			set.bundles[i].curPtr   = 0;
+		}
+
+		for (int i = 0; i < 16; i++) {
+			set.colHighHuffman[i].index = 0;
+			for (int j = 0; j < 16; j++)
+				set.colHighHuffman[i].symbols[j] = j;
+		}
+
+		set.colLastVal = 0;
 	}
 
 	// Make the surface even-sized:
@@ -305,7 +321,18 @@ BinkDecoder::BinkVideoTrack::BinkVideoTrack(uint32 width, uint32 height, uint32
 	memset(_curPlanes[3], 255, _yBlockWidth  * 8 * _yBlockHeight  * 8);
 	memset(_oldPlanes[3], 255, _yBlockWidth  * 8 * _yBlockHeight  * 8);
 
-	initBundles();
+	_idct = &idctKernelsC;
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		_idct = &idctKernelsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+		_idct = &idctKernelsAVX2;
+#endif
+
+	// The second set of bundles is only allocated once it is needed
+	initBundles(_bundleSets[0]);
 	initHuffman();
 }
 
@@ -315,7 +342,8 @@ BinkDecoder::BinkVideoTrack::~BinkVideoTrack() {
 		delete[] _oldPlanes[i]; _oldPlanes[i] = 0;
 	}
 
-	deinitBundles();
+	deinitBundles(_bundleSets[0]);
+	deinitBundles(_bundleSets[1]);
 
 	for (int i = 0; i < 16; i++) {
 		delete _huffman[i];
@@ -463,21 +491,64 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 		if (_id == kBIKiID)
 			frame.bits->skip(32);
 
-		decodePlane(frame, 3, false);
+		decodePlane(frame, _bundleSets[0], 3, false);
 	}
 
+	uint32 planeOffsetPos = frame.bits->pos();
+	uint32 planeOffset = 0;
+
 	if (_id == kBIKiID)
-		frame.bits->skip(32);
+		planeOffset = frame.bits->getBits<32>();
+
+	// Hand the planes starting at the plane offset to a worker
+	PlaneJob job;
+	Common::JobGroup group;
+	Common::JobSystem *jobSystem = g_system->getJobSystem();
+	uint32 splitPos = 0;
+
+	if (_planeOffsetMode >= 0 && jobSystem->getWorkerCount() > 0) {
+		uint64 pos = getPlaneOffsetPos(_planeOffsetMode, planeOffsetPos, planeOffset);
+
+		if (pos > frame.bits->pos() && pos < frame.bits->size() && !(pos & 0x1F)) {
+			if (!_bundleSets[1].bundles[0].data)
+				initBundles(_bundleSets[1]);
+
+			splitPos = pos;
+			job.track = this;
+			job.firstPlane = 1 + _planeOffsetMode % 2;
+			job.video.data = frame.data + splitPos / 8;
+			job.video.bits = new Common::BitStreamMemory32LELSB(new Common::BitStreamMemoryStream(job.video.data,
+					frame.bits->size() / 8 - splitPos / 8), DisposeAfterUse::YES);
+			jobSystem->submit(group, decodePlanesProc, &job);
+		}
+	}
 
-	for (int i = 0; i < 3; i++) {
-		int planeIdx = ((i == 0) || !_swapPlanes) ? i : (i ^ 3);
+	uint32 planePos[3] = { 0, 0, 0 };
+
+	for (uint32 i = 0; i < (splitPos ? job.firstPlane : 3); i++) {
+		planePos[i] = frame.bits->pos();
 
-		decodePlane(frame, planeIdx, i != 0);
+		decodePlanes(frame, _bundleSets[0], i, i + 1);
 
 		if (frame.bits->pos() >= frame.bits->size())
 			break;
 	}
 
+	if (splitPos) {
+		jobSystem->wait(group);
+
+		if (frame.bits->pos() != splitPos) {
+			// Not where the plane offset said, so redo these planes
+			warning("Bink plane offset mismatch, decoding planes serially");
+			_planeOffsetMode = -1;
+
+			if (frame.bits->pos() < frame.bits->size())
+				decodePlanes(frame, _bundleSets[0], job.firstPlane, 3);
+		}
+	} else if (_id == kBIKiID && planePos[2]) {
+		checkPlaneOffset(planeOffsetPos, planeOffset, planePos);
+	}
+
 	// Convert the YUV data we have to our format
 	// The width used here is the surface-width, and not the video-width
 	// to allow for odd-sized videos.
@@ -498,7 +569,55 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 	_curFrame++;
 }
 
-void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, bool isChroma) {
+void BinkDecoder::BinkVideoTrack::decodePlanes(VideoFrame &video, BundleSet &set, uint32 first, uint32 end) {
+	for (uint32 i = first; i < end; i++) {
+		int planeIdx = ((i == 0) || !_swapPlanes) ? i : (i ^ 3);
+
+		decodePlane(video, set, planeIdx, i != 0);
+
+		if (video.bits->pos() >= video.bits->size())
+			break;
+	}
+}
+
+void BinkDecoder::BinkVideoTrack::decodePlanesProc(void *refCon) {
+	PlaneJob *job = (PlaneJob *)refCon;
+	job->track->decodePlanes(job->video, job->track->_bundleSets[1], job->firstPlane, 3);
+}
+
+uint64 BinkDecoder::BinkVideoTrack::getPlaneOffsetPos(int mode, uint32 offsetPos, uint32 offset) {
+	// A byte offset relative to the start of the packet, to the offset
+	// itself or to the Y plane, pointing to the second or the third plane
+	uint64 base = 0;
+	if (mode / 2 == 1)
+		base = offsetPos;
+	else if (mode / 2 == 2)
+		base = offsetPos + 32;
+
+	return base + (uint64)offset * 8;
+}
+
+void BinkDecoder::BinkVideoTrack::checkPlaneOffset(uint32 offsetPos, uint32 offset, const uint32 *planePos) {
+	static const uint32 kFramesToCheck = 4;
+
+	if (_planeOffsetFrames >= kFramesToCheck)
+		return;
+
+	for (int mode = 0; mode < 6; mode++)
+		if (getPlaneOffsetPos(mode, offsetPos, offset) != planePos[1 + mode % 2])
+			_planeOffsetCandidates &= ~(1 << mode);
+
+	if (!_planeOffsetCandidates)
+		_planeOffsetFrames = kFramesToCheck;
+	else if (++_planeOffsetFrames == kFramesToCheck) {
+		for (_planeOffsetMode = 0; !(_planeOffsetCandidates & (1 << _planeOffsetMode)); _planeOffsetMode++)
+			;
+
+		debug(1, "Bink: decoding planes in parallel, plane offset mode %d", _planeOffsetMode);
+	}
+}
+
+void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, BundleSet &set, int planeIdx, bool isChroma) {
 	uint32 blockWidth  = isChroma ? _uvBlockWidth  : _yBlockWidth;
 	uint32 blockHeight = isChroma ? _uvBlockHeight : _yBlockHeight;
 	uint32 width       = blockWidth  * 8;
@@ -507,6 +626,7 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 	DecodeContext ctx;
 
 	ctx.video     = &video;
+	ctx.bundles   = set.bundles;
 	ctx.planeIdx  = planeIdx;
 	ctx.destStart = _curPlanes[planeIdx];
 	ctx.destEnd   = _curPlanes[planeIdx] + width * height;
@@ -524,27 +644,27 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 	}
 
 	for (int i = 0; i < kSourceMAX; i++) {
-		_bundles[i].countLength = _bundles[i].countLengths[isChroma ? 1 : 0];
+		set.bundles[i].countLength = set.bundles[i].countLengths[isChroma ? 1 : 0];
 
-		readBundle(video, (Source) i);
+		readBundle(video, set, (Source) i);
 	}
 
 	for (ctx.blockY = 0; ctx.blockY < blockHeight; ctx.blockY++) {
-		readBlockTypes              (video, _bundles[kSourceBlockTypes]);
-		readBlockTypes              (video, _bundles[kSourceSubBlockTypes]);
-		readColors                  (video, _bundles[kSourceColors]);
-		readPatterns                (video, _bundles[kSourcePattern]);
-		readMotionValues            (video, _bundles[kSourceXOff]);
-		readMotionValues            (video, _bundles[kSourceYOff]);
-		readDCS<kDCStartBits, false>(video, _bundles[kSourceIntraDC]);
-		readDCS<kDCStartBits, true> (video, _bundles[kSourceInterDC]);
-		readRuns                    (video, _bundles[kSourceRun]);
+		readBlockTypes              (video, set.bundles[kSourceBlockTypes]);
+		readBlockTypes              (video, set.bundles[kSourceSubBlockTypes]);
+		readColors                  (video, set);
+		readPatterns                (video, set.bundles[kSourcePattern]);
+		readMotionValues            (video, set.bundles[kSourceXOff]);
+		readMotionValues            (video, set.bundles[kSourceYOff]);
+		readDCS<kDCStartBits, false>(video, set.bundles[kSourceIntraDC]);
+		readDCS<kDCStartBits, true> (video, set.bundles[kSourceInterDC]);
+		readRuns                    (video, set.bundles[kSourceRun]);
 
 		ctx.dest = ctx.destStart + 8 * ctx.blockY * ctx.pitch;
 		ctx.prev = ctx.prevStart + 8 * ctx.blockY * ctx.pitch;
 
 		for (ctx.blockX = 0; ctx.blockX < blockWidth; ctx.blockX++, ctx.dest += 8, ctx.prev += 8) {
-			BlockType blockType = (BlockType) getBundleValue(kSourceBlockTypes);
+			BlockType blockType = (BlockType) getBundleValue(ctx, kSourceBlockTypes);
 
 			// 16x16 block type on odd line means part of the already decoded block, so skip it
 			if ((ctx.blockY & 1) && (blockType == kBlockScaled)) {
@@ -598,19 +718,19 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 
 }
 
-void BinkDecoder::BinkVideoTrack::readBundle(VideoFrame &video, Source source) {
+void BinkDecoder::BinkVideoTrack::readBundle(VideoFrame &video, BundleSet &set, Source source) {
 	if (source == kSourceColors) {
 		for (int i = 0; i < 16; i++)
-			readHuffman(video, _colHighHuffman[i]);
+			readHuffman(video, set.colHighHuffman[i]);
 
-		_colLastVal = 0;
+		set.colLastVal = 0;
 	}
 
 	if ((source != kSourceIntraDC) && (source != kSourceInterDC))
-		readHuffman(video, _bundles[source].huffman);
+		readHuffman(video, set.bundles[source].huffman);
 
-	_bundles[source].curDec = _bundles[source].data;
-	_bundles[source].curPtr = _bundles[source].data;
+	set.bundles[source].curDec = set.bundles[source].data;
+	set.bundles[source].curPtr = set.bundles[source].data;
 }
 
 void BinkDecoder::BinkVideoTrack::readHuffman(VideoFrame &video, Huffman &huffman) {
@@ -687,14 +807,14 @@ void BinkDecoder::BinkVideoTrack::mergeHuffmanSymbols(VideoFrame &video, byte *d
 		*dst++ = *src2++;
 }
 
-void BinkDecoder::BinkVideoTrack::initBundles() {
+void BinkDecoder::BinkVideoTrack::initBundles(BundleSet &set) {
 	uint32 bw     = (_width + 7) >> 3;
 	uint32 bh     = (_height + 7) >> 3;
 	uint32 blocks = bw * bh;
 
 	for (int i = 0; i < kSourceMAX; i++) {
-		_bundles[i].data    = new byte[blocks * 64];
-		_bundles[i].dataEnd = _bundles[i].data + blocks * 64;
+		set.bundles[i].data    = new byte[blocks * 64];
+		set.bundles[i].dataEnd = set.bundles[i].data + blocks * 64;
 	}
 
 	uint32 cbw[2] = { (uint32)((_width + 7) >> 3), (uint32)((_width  + 15) >> 4) };
@@ -704,42 +824,44 @@ void BinkDecoder::BinkVideoTrack::initBundles() {
 	for (int i = 0; i < 2; i++) {
 		int width = MAX<uint32>(cw[i], 8);
 
-		_bundles[kSourceBlockTypes   ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
-		_bundles[kSourceSubBlockTypes].countLengths[i] = Common::intLog2(((width + 7) >> 4) + 511) + 1;
-		_bundles[kSourceColors       ].countLengths[i] = Common::intLog2((cbw[i])     * 64  + 511) + 1;
-		_bundles[kSourceIntraDC      ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
-		_bundles[kSourceInterDC      ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
-		_bundles[kSourceXOff         ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
-		_bundles[kSourceYOff         ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
-		_bundles[kSourcePattern      ].countLengths[i] = Common::intLog2((cbw[i]      << 3) + 511) + 1;
-		_bundles[kSourceRun          ].countLengths[i] = Common::intLog2((cbw[i])     * 48  + 511) + 1;
+		set.bundles[kSourceBlockTypes   ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
+		set.bundles[kSourceSubBlockTypes].countLengths[i] = Common::intLog2(((width + 7) >> 4) + 511) + 1;
+		set.bundles[kSourceColors       ].countLengths[i] = Common::intLog2((cbw[i])     * 64  + 511) + 1;
+		set.bundles[kSourceIntraDC      ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
+		set.bundles[kSourceInterDC      ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
+		set.bundles[kSourceXOff         ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
+		set.bundles[kSourceYOff         ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
+		set.bundles[kSourcePattern      ].countLengths[i] = Common::intLog2((cbw[i]      << 3) + 511) + 1;
+		set.bundles[kSourceRun          ].countLengths[i] = Common::intLog2((cbw[i])     * 48  + 511) + 1;
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::deinitBundles() {
+void BinkDecoder::BinkVideoTrack::deinitBundles(BundleSet &set) {
 	for (int i = 0; i < kSourceMAX; i++)
-		delete[] _bundles[i].data;
+		delete[] set.bundles[i].data;
 }
 
 void BinkDecoder::BinkVideoTrack::initHuffman() {
 	for (int i = 0; i < 16; i++)
-		_huffman[i] = new Common::Huffman<Common::BitStream32LELSB>(binkHuffmanLengths[i][15], 16, binkHuffmanCodes[i], binkHuffmanLengths[i]);
+		_huffman[i] = new Common::Huffman<Common::BitStreamMemory32LELSB>(binkHuffmanLengths[i][15], 16, binkHuffmanCodes[i], binkHuffmanLengths[i]);
 }
 
 byte BinkDecoder::BinkVideoTrack::getHuffmanSymbol(VideoFrame &video, Huffman &huffman) {
 	return huffman.symbols[_huffman[huffman.index]->getSymbol(*video.bits)];
 }
 
-int32 BinkDecoder::BinkVideoTrack::getBundleValue(Source source) {
+int32 BinkDecoder::BinkVideoTrack::getBundleValue(DecodeContext &ctx, Source source) {
+	Bundle &bundle = ctx.bundles[source];
+
 	if ((source < kSourceXOff) || (source == kSourceRun))
-		return *_bundles[source].curPtr++;
+		return *bundle.curPtr++;
 
 	if ((source == kSourceXOff) || (source == kSourceYOff))
-		return (int8) *_bundles[source].curPtr++;
+		return (int8) *bundle.curPtr++;
 
-	int16 ret = *((int16 *) _bundles[source].curPtr);
+	int16 ret = *((int16 *) bundle.curPtr);
 
-	_bundles[source].curPtr += 2;
+	bundle.curPtr += 2;
 
 	return ret;
 }
@@ -776,7 +898,7 @@ void BinkDecoder::BinkVideoTrack::blockScaledRun(DecodeContext &ctx) {
 
 	int i = 0;
 	do {
-		int run = getBundleValue(kSourceRun) + 1;
+		int run = getBundleValue(ctx, kSourceRun) + 1;
 
 		i += run;
 		if (i > 64)
@@ -784,7 +906,7 @@ void BinkDecoder::BinkVideoTrack::blockScaledRun(DecodeContext &ctx) {
 
 		if (ctx.video->bits->getBit()) {
 
-			byte v = getBundleValue(kSourceColors);
+			byte v = getBundleValue(ctx, kSourceColors);
 			for (int j = 0; j < run; j++, scan++)
 				ctx.dest[ctx.coordScaledMap1[*scan]] =
 				ctx.dest[ctx.coordScaledMap2[*scan]] =
@@ -796,7 +918,7 @@ void BinkDecoder::BinkVideoTrack::blockScaledRun(DecodeContext &ctx) {
 				ctx.dest[ctx.coordScaledMap1[*scan]] =
 				ctx.dest[ctx.coordScaledMap2[*scan]] =
 				ctx.dest[ctx.coordScaledMap3[*scan]] =
-				ctx.dest[ctx.coordScaledMap4[*scan]] = getBundleValue(kSourceColors);
+				ctx.dest[ctx.coordScaledMap4[*scan]] = getBundleValue(ctx, kSourceColors);
 
 	} while (i < 63);
 
@@ -804,14 +926,14 @@ void BinkDecoder::BinkVideoTrack::blockScaledRun(DecodeContext &ctx) {
 		ctx.dest[ctx.coordScaledMap1[*scan]] =
 		ctx.dest[ctx.coordScaledMap2[*scan]] =
 		ctx.dest[ctx.coordScaledMap3[*scan]] =
-		ctx.dest[ctx.coordScaledMap4[*scan]] = getBundleValue(kSourceColors);
+		ctx.dest[ctx.coordScaledMap4[*scan]] = getBundleValue(ctx, kSourceColors);
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledIntra(DecodeContext &ctx) {
 	int32 block[64];
 	memset(block, 0, 64 * sizeof(int32));
 
-	block[0] = getBundleValue(kSourceIntraDC);
+	block[0] = getBundleValue(ctx, kSourceIntraDC);
 
 	readDCTCoeffs(*ctx.video, block, true);
 
@@ -829,7 +951,7 @@ void BinkDecoder::BinkVideoTrack::blockScaledIntra(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledFill(DecodeContext &ctx) {
-	byte v = getBundleValue(kSourceColors);
+	byte v = getBundleValue(ctx, kSourceColors);
 
 	byte *dest = ctx.dest;
 	for (int i = 0; i < 16; i++, dest += ctx.pitch)
@@ -840,12 +962,12 @@ void BinkDecoder::BinkVideoTrack::blockScaledPattern(DecodeContext &ctx) {
 	byte col[2];
 
 	for (int i = 0; i < 2; i++)
-		col[i] = getBundleValue(kSourceColors);
+		col[i] = getBundleValue(ctx, kSourceColors);
 
 	byte *dest1 = ctx.dest;
 	byte *dest2 = ctx.dest + ctx.pitch;
 	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16) {
-		byte v = getBundleValue(kSourcePattern);
+		byte v = getBundleValue(ctx, kSourcePattern);
 
 		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2, v >>= 1)
 			dest1[0] = dest1[1] = dest2[0] = dest2[1] = col[v & 1];
@@ -858,17 +980,17 @@ void BinkDecoder::BinkVideoTrack::blockScaledRaw(DecodeContext &ctx) {
 	byte *dest1 = ctx.dest;
 	byte *dest2 = ctx.dest + ctx.pitch;
 	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16) {
-		memcpy(row, _bundles[kSourceColors].curPtr, 8);
+		memcpy(row, ctx.bundles[kSourceColors].curPtr, 8);
 
 		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
 			dest1[0] = dest1[1] = dest2[0] = dest2[1] = row[i];
 
-		_bundles[kSourceColors].curPtr += 8;
+		ctx.bundles[kSourceColors].curPtr += 8;
 	}
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaled(DecodeContext &ctx) {
-	BlockType blockType = (BlockType) getBundleValue(kSourceSubBlockTypes);
+	BlockType blockType = (BlockType) getBundleValue(ctx, kSourceSubBlockTypes);
 
 	switch (blockType) {
 	case kBlockRun:
@@ -896,8 +1018,8 @@ void BinkDecoder::BinkVideoTrack::blockScaled(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockMotion(DecodeContext &ctx) {
-	int8 xOff = getBundleValue(kSourceXOff);
-	int8 yOff = getBundleValue(kSourceYOff);
+	int8 xOff = getBundleValue(ctx, kSourceXOff);
+	int8 yOff = getBundleValue(ctx, kSourceYOff);
 
 	byte *dest = ctx.dest;
 	byte *prev = ctx.prev + yOff * ((int32) ctx.pitch) + xOff;
@@ -913,7 +1035,7 @@ void BinkDecoder::BinkVideoTrack::blockRun(DecodeContext &ctx) {
 
 	int i = 0;
 	do {
-		int run = getBundleValue(kSourceRun) + 1;
+		int run = getBundleValue(ctx, kSourceRun) + 1;
 
 		i += run;
 		if (i > 64)
@@ -921,18 +1043,18 @@ void BinkDecoder::BinkVideoTrack::blockRun(DecodeContext &ctx) {
 
 		if (ctx.video->bits->getBit()) {
 
-			byte v = getBundleValue(kSourceColors);
+			byte v = getBundleValue(ctx, kSourceColors);
 			for (int j = 0; j < run; j++)
 				ctx.dest[ctx.coordMap[*scan++]] = v;
 
 		} else
 			for (int j = 0; j < run; j++)
-				ctx.dest[ctx.coordMap[*scan++]] = getBundleValue(kSourceColors);
+				ctx.dest[ctx.coordMap[*scan++]] = getBundleValue(ctx, kSourceColors);
 
 	} while (i < 63);
 
 	if (i == 63)
-		ctx.dest[ctx.coordMap[*scan++]] = getBundleValue(kSourceColors);
+		ctx.dest[ctx.coordMap[*scan++]] = getBundleValue(ctx, kSourceColors);
 }
 
 void BinkDecoder::BinkVideoTrack::blockResidue(DecodeContext &ctx) {
@@ -956,7 +1078,7 @@ void BinkDecoder::BinkVideoTrack::blockIntra(DecodeContext &ctx) {
 	int32 block[64];
 	memset(block, 0, 64 * sizeof(int32));
 
-	block[0] = getBundleValue(kSourceIntraDC);
+	block[0] = getBundleValue(ctx, kSourceIntraDC);
 
 	readDCTCoeffs(*ctx.video, block, true);
 
@@ -964,7 +1086,7 @@ void BinkDecoder::BinkVideoTrack::blockIntra(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockFill(DecodeContext &ctx) {
-	byte v = getBundleValue(kSourceColors);
+	byte v = getBundleValue(ctx, kSourceColors);
 
 	byte *dest = ctx.dest;
 	for (int i = 0; i < 8; i++, dest += ctx.pitch)
@@ -977,7 +1099,7 @@ void BinkDecoder::BinkVideoTrack::blockInter(DecodeContext &ctx) {
 	int32 block[64];
 	memset(block, 0, 64 * sizeof(int32));
 
-	block[0] = getBundleValue(kSourceInterDC);
+	block[0] = getBundleValue(ctx, kSourceInterDC);
 
 	readDCTCoeffs(*ctx.video, block, false);
 
@@ -988,11 +1110,11 @@ void BinkDecoder::BinkVideoTrack::blockPattern(DecodeContext &ctx) {
 	byte col[2];
 
 	for (int i = 0; i < 2; i++)
-		col[i] = getBundleValue(kSourceColors);
+		col[i] = getBundleValue(ctx, kSourceColors);
 
 	byte *dest = ctx.dest;
 	for (int i = 0; i < 8; i++, dest += ctx.pitch - 8) {
-		byte v = getBundleValue(kSourcePattern);
+		byte v = getBundleValue(ctx, kSourcePattern);
 
 		for (int j = 0; j < 8; j++, v >>= 1)
 			*dest++ = col[v & 1];
@@ -1001,11 +1123,11 @@ void BinkDecoder::BinkVideoTrack::blockPattern(DecodeContext &ctx) {
 
 void BinkDecoder::BinkVideoTrack::blockRaw(DecodeContext &ctx) {
 	byte *dest = ctx.dest;
-	byte *data = _bundles[kSourceColors].curPtr;
+	byte *data = ctx.bundles[kSourceColors].curPtr;
 	for (int i = 0; i < 8; i++, dest += ctx.pitch, data += 8)
 		memcpy(dest, data, 8);
 
-	_bundles[kSourceColors].curPtr += 64;
+	ctx.bundles[kSourceColors].curPtr += 64;
 }
 
 void BinkDecoder::BinkVideoTrack::readRuns(VideoFrame &video, Bundle &bundle) {
@@ -1120,7 +1242,9 @@ void BinkDecoder::BinkVideoTrack::readPatterns(VideoFrame &video, Bundle &bundle
 }
 
 
-void BinkDecoder::BinkVideoTrack::readColors(VideoFrame &video, Bundle &bundle) {
+void BinkDecoder::BinkVideoTrack::readColors(VideoFrame &video, BundleSet &set) {
+	Bundle &bundle = set.bundles[kSourceColors];
+
 	uint32 n = readBundleCount(video, bundle);
 	if (n == 0)
 		return;
@@ -1130,11 +1254,11 @@ void BinkDecoder::BinkVideoTrack::readColors(VideoFrame &video, Bundle &bundle)
 		error("Too many color values");
 
 	if (video.bits->getBit()) {
-		_colLastVal = getHuffmanSymbol(video, _colHighHuffman[_colLastVal]);
+		set.colLastVal = getHuffmanSymbol(video, set.colHighHuffman[set.colLastVal]);
 
 		byte v;
 		v = getHuffmanSymbol(video, bundle.huffman);
-		v = (_colLastVal << 4) | v;
+		v = (set.colLastVal << 4) | v;
 
 		if (_id != kBIKiID) {
 			int sign = ((int8) v) >> 7;
@@ -1149,11 +1273,11 @@ void BinkDecoder::BinkVideoTrack::readColors(VideoFrame &video, Bundle &bundle)
 	}
 
 	while (bundle.curDec < decEnd) {
-		_colLastVal = getHuffmanSymbol(video, _colHighHuffman[_colLastVal]);
+		set.colLastVal = getHuffmanSymbol(video, set.colHighHuffman[set.colLastVal]);
 
 		byte v;
 		v = getHuffmanSymbol(video, bundle.huffman);
-		v = (_colLastVal << 4) | v;
+		v = (set.colLastVal << 4) | v;
 
 		if (_id != kBIKiID) {
 			int sign = ((int8) v) >> 7;
@@ -1461,7 +1585,7 @@ static inline void IDCTCol(int32 *dest, const int32 *src) {
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::IDCT(int32 *block) {
+static void IDCT_C(int32 *block) {
 	int i;
 	int32 temp[64];
 
@@ -1472,26 +1596,31 @@ void BinkDecoder::BinkVideoTrack::IDCT(int32 *block) {
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int32 *block) {
+static void IDCTAdd_C(byte *dest, uint32 pitch, int32 *block) {
 	int i, j;
 
-	IDCT(block);
-	byte *dest = ctx.dest;
-	for (i = 0; i < 8; i++, dest += ctx.pitch, block += 8)
+	IDCT_C(block);
+	for (i = 0; i < 8; i++, dest += pitch, block += 8)
 		for (j = 0; j < 8; j++)
 			 dest[j] += block[j];
 }
 
-void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int32 *block) {
+static void IDCTPut_C(byte *dest, uint32 pitch, int32 *block) {
 	int i;
 	int32 temp[64];
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
 	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
+		IDCT_ROW( (&dest[i*pitch]), (&temp[8*i]) );
 	}
 }
 
+const BinkDecoder::BinkVideoTrack::IDCTKernels BinkDecoder::BinkVideoTrack::idctKernelsC = {
+	IDCT_C,
+	IDCTPut_C,
+	IDCTAdd_C
+};
+
 BinkDecoder::BinkAudioTrack::BinkAudioTrack(BinkDecoder::AudioInfo &audio, Audio::Mixer::SoundType soundType) :
 		AudioTrack(soundType),
 		_audioInfo(&audio) {
@@ -139,7 +139,8 @@ private:
 		uint32 offset;
 		uint32 size;
 
-		Common::BitStream32LELSB *bits;
+		const byte *data; ///< The video packet, while it is decoded.
+		Common::BitStreamMemory32LELSB *bits;
 
 		VideoFrame();
 		~VideoFrame();
@@ -168,9 +169,12 @@ private:
 		Common::Rational getFrameRate() const override { return _frameRate; }
 
 	private:
+		struct Bundle;
+
 		/** A decoder state. */
 		struct DecodeContext {
 			VideoFrame *video;
+			Bundle *bundles;
 
 			uint32 planeIdx;
 
@@ -241,6 +245,23 @@ private:
 			byte *curPtr; ///< Pointer to the data that wasn't yet read.
 		};
 
+		/** The bundles for decoding a plane; planes decoded in parallel each need their own. */
+		struct BundleSet {
+			Bundle bundles[kSourceMAX]; ///< Bundles for decoding all data types.
+
+			/** Huffman codebooks to use for decoding high nibbles in color data types. */
+			Huffman colHighHuffman[16];
+			/** Value of the last decoded high nibble in color data types. */
+			int colLastVal;
+		};
+
+		/** The planes of a frame decoded on a worker thread. */
+		struct PlaneJob {
+			BinkVideoTrack *track;
+			VideoFrame video;
+			uint32 firstPlane;
+		};
+
 		int _curFrame;
 		int _frameCount;
 
@@ -258,14 +279,20 @@ private:
 
 		Common::Rational _frameRate;
 
-		Bundle _bundles[kSourceMAX]; ///< Bundles for decoding all data types.
+		/** Bundles for the main thread and for the planes decoded on a worker thread. */
+		BundleSet _bundleSets[2];
 
-		Common::Huffman<Common::BitStream32LELSB> *_huffman[16]; ///< The 16 Huffman codebooks used in Bink decoding.
+		Common::Huffman<Common::BitStreamMemory32LELSB> *_huffman[16]; ///< The 16 Huffman codebooks used in Bink decoding.
 
-		/** Huffman codebooks to use for decoding high nibbles in color data types. */
-		Huffman _colHighHuffman[16];
-		/** Value of the last decoded high nibble in color data types. */
-		int _colLastVal;
+		/**
+		 * Starting with BIKi, a 32-bit value in front of the Y plane appears
+		 * to locate one of the following planes, which allows decoding them
+		 * in parallel. What it is relative to is learned from the first
+		 * frames, see checkPlaneOffset().
+		 */
+		uint32 _planeOffsetCandidates;
+		uint32 _planeOffsetFrames; ///< Number of frames checked against _planeOffsetCandidates.
+		int _planeOffsetMode;      ///< The candidate confirmed by the first frames, or -1.
 
 		uint32 _yBlockWidth;   ///< Width of the Y plane in blocks
 		uint32 _yBlockHeight;  ///< Height of the Y plane in blocks
@@ -276,18 +303,27 @@ private:
 		byte *_oldPlanes[4]; ///< The 4 color planes, YUVA, last frame.
 
 		/** Initialize the bundles. */
-		void initBundles();
+		void initBundles(BundleSet &set);
 		/** Deinitialize the bundles. */
-		void deinitBundles();
+		void deinitBundles(BundleSet &set);
 
 		/** Initialize the Huffman decoders. */
 		void initHuffman();
 
 		/** Decode a plane. */
-		void decodePlane(VideoFrame &video, int planeIdx, bool isChroma);
+		void decodePlane(VideoFrame &video, BundleSet &set, int planeIdx, bool isChroma);
+
+		/** Decode the planes from the n-th one in bitstream order onwards. */
+		void decodePlanes(VideoFrame &video, BundleSet &set, uint32 first, uint32 end);
+		static void decodePlanesProc(void *refCon);
+
+		/** Return the bit position that candidate @p mode for the plane offset points to. */
+		static uint64 getPlaneOffsetPos(int mode, uint32 offsetPos, uint32 offset);
+		/** Drop the plane offset candidates not matching a frame which was decoded serially. */
+		void checkPlaneOffset(uint32 offsetPos, uint32 offset, const uint32 *planePos);
 
 		/** Read/Initialize a bundle for decoding a plane. */
-		void readBundle(VideoFrame &video, Source source);
+		void readBundle(VideoFrame &video, BundleSet &set, Source source);
 
 		/** Read the symbols for a Huffman code. */
 		void readHuffman(VideoFrame &video, Huffman &huffman);
@@ -298,7 +334,7 @@ private:
 		byte getHuffmanSymbol(VideoFrame &video, Huffman &huffman);
 
 		/** Get a direct value out of a bundle. */
-		int32 getBundleValue(Source source);
+		int32 getBundleValue(DecodeContext &ctx, Source source);
 		/** Read a count value out of a bundle. */
 		uint32 readBundleCount(VideoFrame &video, Bundle &bundle);
 
@@ -325,16 +361,33 @@ private:
 		void readMotionValues(VideoFrame &video, Bundle &bundle);
 		void readBlockTypes  (VideoFrame &video, Bundle &bundle);
 		void readPatterns    (VideoFrame &video, Bundle &bundle);
-		void readColors      (VideoFrame &video, Bundle &bundle);
+		void readColors      (VideoFrame &video, BundleSet &set);
 		template<int startBits, bool hasSign>
 		void readDCS         (VideoFrame &video, Bundle &bundle);
 		void readDCTCoeffs   (VideoFrame &video, int32 *block, bool isIntra);
 		void readResidue     (VideoFrame &video, int16 *block, int masksCount);
 
 		// Bink video IDCT
-		void IDCT(int32 *block);
-		void IDCTPut(DecodeContext &ctx, int32 *block);
-		void IDCTAdd(DecodeContext &ctx, int32 *block);
+		void IDCT(int32 *block) { _idct->idct(block); }
+		void IDCTPut(DecodeContext &ctx, int32 *block) { _idct->idctPut(ctx.dest, ctx.pitch, block); }
+		void IDCTAdd(DecodeContext &ctx, int32 *block) { _idct->idctAdd(ctx.dest, ctx.pitch, block); }
+
+		/** IDCT implementations, the SIMD ones are in bink_decoder-*.cpp. */
+		struct IDCTKernels {
+			void (*idct)(int32 *block);                             ///< Transform the block in place.
+			void (*idctPut)(byte *dest, uint32 pitch, int32 *block); ///< Transform the block into dest.
+			void (*idctAdd)(byte *dest, uint32 pitch, int32 *block); ///< Transform the block and add it to dest.
+		};
+
+		static const IDCTKernels idctKernelsC;
+#ifdef SCUMMVM_SSE2
+		static const IDCTKernels idctKernelsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		static const IDCTKernels idctKernelsAVX2;
+#endif
+
+		const IDCTKernels *_idct;
 	};
 
 	class BinkAudioTrack : public AudioTrack {
@@ -372,6 +425,7 @@ private:
 	};
 
 	Common::SeekableReadStream *_bink;
+	Common::Array<byte> _videoPacket; ///< Buffer for reading a video packet.
 
 	Common::Array<AudioInfo> _audioTracks; ///< All audio tracks.
 	Common::Array<VideoFrame> _frames;      ///< All video frames.
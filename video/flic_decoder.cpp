@@ -25,6 +25,7 @@
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "graphics/blit.h"
 #include "graphics/surface.h"
 
 namespace Video {
@@ -61,22 +62,6 @@ bool FlicDecoder::loadStream(Common::SeekableReadStream *stream) {
 	return true;
 }
 
-const Common::List<Common::Rect> *FlicDecoder::getDirtyRects() const {
-	const Track *track = getTrack(0);
-
-	if (track)
-		return ((const FlicVideoTrack *)track)->getDirtyRects();
-
-	return 0;
-}
-
-void FlicDecoder::clearDirtyRects() {
-	Track *track = getTrack(0);
-
-	if (track)
-		((FlicVideoTrack *)track)->clearDirtyRects();
-}
-
 void FlicDecoder::copyDirtyRectsToBuffer(uint8 *dst, uint pitch) {
 	Track *track = getTrack(0);
 
@@ -93,6 +78,9 @@ FlicDecoder::FlicVideoTrack::FlicVideoTrack(Common::SeekableReadStream *stream,
 	_palette = new byte[3 * 256]();
 	_dirtyPalette = false;
 
+	_outputSurface = nullptr;
+	_outputRedraw = false;
+
 	_curFrame = -1;
 	_nextFrameStartTime = 0;
 	_atRingFrame = false;
@@ -107,6 +95,11 @@ FlicDecoder::FlicVideoTrack::~FlicVideoTrack() {
 
 	_surface->free();
 	delete _surface;
+
+	if (_outputSurface) {
+		_outputSurface->free();
+		delete _outputSurface;
+	}
 }
 
 void FlicDecoder::FlicVideoTrack::readHeader() {
@@ -151,9 +144,29 @@ uint16 FlicDecoder::FlicVideoTrack::getHeight() const {
 }
 
 Graphics::PixelFormat FlicDecoder::FlicVideoTrack::getPixelFormat() const {
+	if (_outputSurface)
+		return _outputSurface->format;
+
 	return _surface->format;
 }
 
+bool FlicDecoder::FlicVideoTrack::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	if (_outputSurface) {
+		_outputSurface->free();
+		delete _outputSurface;
+		_outputSurface = nullptr;
+	}
+
+	// CLUT8 is what we decode to anyway
+	if (format.bytesPerPixel == 1)
+		return true;
+
+	_outputSurface = new Graphics::Surface();
+	_outputSurface->create(_surface->w, _surface->h, format);
+	_outputRedraw = true;
+	return true;
+}
+
 #define FLI_SETPAL            4
 #define FLI_SS2               7
 #define FLI_BLACK             13
@@ -165,6 +178,9 @@ Graphics::PixelFormat FlicDecoder::FlicVideoTrack::getPixelFormat() const {
 #define FLC_FILE_HEADER_SIZE  0x80
 
 const Graphics::Surface *FlicDecoder::FlicVideoTrack::decodeNextFrame() {
+	// Remember where the rects of this frame will start
+	Common::List<Common::Rect>::iterator lastRect = _dirtyRects.reverse_begin();
+
 	// Read chunk
 	/*uint32 frameSize = */ _fileStream->readUint32LE();
 	uint16 frameType = _fileStream->readUint16LE();
@@ -191,7 +207,7 @@ const Graphics::Surface *FlicDecoder::FlicVideoTrack::decodeNextFrame() {
 		_fileStream->seek(_offsetFrame2);
 	}
 
-	return _surface;
+	return convertFrame(lastRect);
 }
 
 void FlicDecoder::FlicVideoTrack::handleFrame() {
@@ -216,6 +232,13 @@ void FlicDecoder::FlicVideoTrack::handleFrame() {
 		delete _surface;
 		_surface = new Graphics::Surface();
 		_surface->create(newWidth, newHeight, Graphics::PixelFormat::createFormatCLUT8());
+
+		if (_outputSurface) {
+			Graphics::PixelFormat format = _outputSurface->format;
+			_outputSurface->free();
+			_outputSurface->create(newWidth, newHeight, format);
+			_outputRedraw = true;
+		}
 	}
 
 	// Read subchunks
@@ -229,6 +252,7 @@ void FlicDecoder::FlicVideoTrack::handleFrame() {
 		case FLI_SETPAL:
 			unpackPalette(data);
 			_dirtyPalette = true;
+			_outputRedraw = true;
 			break;
 		case FLI_SS2:
 			decodeDeltaFLC(data);
@@ -237,6 +261,7 @@ void FlicDecoder::FlicVideoTrack::handleFrame() {
 			_surface->fillRect(Common::Rect(0, 0, getWidth(), getHeight()), 0);
 			_dirtyRects.clear();
 			_dirtyRects.push_back(Common::Rect(0, 0, getWidth(), getHeight()));
+			_outputRedraw = true;
 			break;
 		case FLI_BRUN:
 			decodeByteRun(data);
@@ -267,12 +292,40 @@ void FlicDecoder::FlicVideoTrack::copyDirtyRectsToBuffer(uint8 *dst, uint pitch)
 	clearDirtyRects();
 }
 
+const Graphics::Surface *FlicDecoder::FlicVideoTrack::convertFrame(Common::List<Common::Rect>::iterator lastRect) {
+	if (!_outputSurface)
+		return _surface;
+
+	if (_outputRedraw) {
+		Graphics::convertPaletteToMap(_outputMap, _palette, 256, _outputSurface->format);
+		convertRect(Common::Rect(0, 0, getWidth(), getHeight()));
+		_outputRedraw = false;
+		return _outputSurface;
+	}
+
+	// Nothing cleared the list, so the rects of this frame follow the old last one
+	Common::List<Common::Rect>::iterator it = _dirtyRects.begin();
+	if (lastRect != _dirtyRects.end())
+		it = ++lastRect;
+
+	for (; it != _dirtyRects.end(); ++it)
+		convertRect(*it);
+
+	return _outputSurface;
+}
+
+void FlicDecoder::FlicVideoTrack::convertRect(const Common::Rect &rect) {
+	Graphics::crossBlitMap((byte *)_outputSurface->getBasePtr(rect.left, rect.top), (const byte *)_surface->getBasePtr(rect.left, rect.top),
+			_outputSurface->pitch, _surface->pitch, rect.width(), rect.height(), _outputSurface->format.bytesPerPixel, _outputMap);
+}
+
 void FlicDecoder::FlicVideoTrack::copyFrame(uint8 *data) {
 	memcpy((byte *)_surface->getPixels(), data, getWidth() * getHeight());
 
 	// Redraw
 	_dirtyRects.clear();
 	_dirtyRects.push_back(Common::Rect(0, 0, getWidth(), getHeight()));
+	_outputRedraw = true;
 }
 
 void FlicDecoder::FlicVideoTrack::decodeByteRun(uint8 *data) {
@@ -296,6 +349,7 @@ void FlicDecoder::FlicVideoTrack::decodeByteRun(uint8 *data) {
 	// Redraw
 	_dirtyRects.clear();
 	_dirtyRects.push_back(Common::Rect(0, 0, getWidth(), getHeight()));
+	_outputRedraw = true;
 }
 
 #define OP_PACKETCOUNT   0
@@ -53,8 +53,6 @@ public:
 
 	virtual bool loadStream(Common::SeekableReadStream *stream);
 
-	const Common::List<Common::Rect> *getDirtyRects() const;
-	void clearDirtyRects();
 	void copyDirtyRectsToBuffer(uint8 *dst, uint pitch);
 
 protected:
@@ -72,13 +70,14 @@ protected:
 		uint16 getWidth() const;
 		uint16 getHeight() const;
 		Graphics::PixelFormat getPixelFormat() const;
+		bool setOutputPixelFormat(const Graphics::PixelFormat &format);
 		int getCurFrame() const { return _curFrame; }
 		int getFrameCount() const { return _frameCount; }
 		uint32 getNextFrameStartTime() const { return _nextFrameStartTime; }
 		virtual const Graphics::Surface *decodeNextFrame();
 		virtual void handleFrame();
 		const byte *getPalette() const { _dirtyPalette = false; return _palette; }
-		bool hasDirtyPalette() const { return _dirtyPalette; }
+		bool hasDirtyPalette() const { return _dirtyPalette && !_outputSurface; }
 
 		const Common::List<Common::Rect> *getDirtyRects() const { return &_dirtyRects; }
 		void clearDirtyRects() { _dirtyRects.clear(); }
@@ -102,6 +101,15 @@ protected:
 
 		Common::List<Common::Rect> _dirtyRects;
 
+		// The frame in the output pixel format, if one was set. Only the
+		// dirty rects are converted, unless the whole frame needs redrawing.
+		Graphics::Surface *_outputSurface;
+		uint32 _outputMap[256];
+		bool _outputRedraw;
+
+		const Graphics::Surface *convertFrame(Common::List<Common::Rect>::iterator lastRect);
+		void convertRect(const Common::Rect &rect);
+
 		void copyFrame(uint8 *data);
 		void decodeByteRun(uint8 *data);
 		void decodeDeltaFLC(uint8 *data);
@@ -19,6 +19,17 @@ MODULE_OBJS := \
 ifdef USE_BINK
 MODULE_OBJS += \
 	bink_decoder.o
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	bink_decoder-sse2.o
+$(MODULE)/bink_decoder-sse2.o: CXXFLAGS += -msse2
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	bink_decoder-avx2.o
+$(MODULE)/bink_decoder-avx2.o: CXXFLAGS += -mavx2
+endif
 endif
 
 ifdef USE_THEORADEC
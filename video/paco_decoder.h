@@ -52,8 +52,6 @@ public:
 
 	virtual bool loadStream(Common::SeekableReadStream *stream) override;
 
-	const Common::List<Common::Rect> *getDirtyRects() const;
-	void clearDirtyRects();
 	void copyDirtyRectsToBuffer(uint8 *dst, uint pitch);
 	const byte *getPalette();
 	virtual void readNextPacket() override;
@@ -80,8 +78,8 @@ protected:
 		const byte *getPalette() const override;
 		bool hasDirtyPalette() const override { return _dirtyPalette; }
 
-		const Common::List<Common::Rect> *getDirtyRects() const { return &_dirtyRects; }
-		void clearDirtyRects() { _dirtyRects.clear(); }
+		const Common::List<Common::Rect> *getDirtyRects() const override { return &_dirtyRects; }
+		void clearDirtyRects() override { _dirtyRects.clear(); }
 		void copyDirtyRectsToBuffer(uint8 *dst, uint pitch);
 		Common::Rational getFrameRate() const override { return Common::Rational(_frameRate, 1); }
 
@@ -51,6 +51,9 @@ QuickTimeDecoder::QuickTimeDecoder() {
 	_scaledSurface = 0;
 	_width = _height = 0;
 	_enableEditListBoundsCheckQuirk = false;
+
+	// The sample tables are read once a track needs its first frame
+	setLazySampleTables(true);
 }
 
 QuickTimeDecoder::~QuickTimeDecoder() {
@@ -219,6 +222,20 @@ void QuickTimeDecoder::init() {
 
 	// Initialize all the video tracks
 	const Common::Array<Common::QuickTimeParser::Track *> &tracks = Common::QuickTimeParser::_tracks;
+
+	if (_headerOnly) {
+		// Without sample tables there's nothing to play, only report the dimensions
+		for (uint32 i = 0; i < tracks.size(); i++) {
+			if (tracks[i]->codecType == CODEC_TYPE_VIDEO) {
+				_width = (Common::Rational(tracks[i]->width) / tracks[i]->scaleFactorX / _scaleFactorX).toInt();
+				_height = (Common::Rational(tracks[i]->height) / tracks[i]->scaleFactorY / _scaleFactorY).toInt();
+				break;
+			}
+		}
+
+		return;
+	}
+
 	for (uint32 i = 0; i < tracks.size(); i++) {
 		if (tracks[i]->codecType == CODEC_TYPE_VIDEO) {
 			for (uint32 j = 0; j < tracks[i]->sampleDescs.size(); j++)
@@ -300,6 +317,8 @@ QuickTimeDecoder::VideoTrackHandler::VideoTrackHandler(QuickTimeDecoder *decoder
 	_curEdit = 0;
 	_curFrame = -1;
 	_delayedFrameToBufferTo = -1;
+	_lastDecodedFrame = -1;
+	_lastDescId = 0;
 	enterNewEditListEntry(true, true); // might set _curFrame
 
 	_durationOverride = -1;
@@ -676,6 +695,9 @@ Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePac
 	int32 actualChunk = -1;
 	uint32 sampleToChunkIndex = 0;
 
+	if (!_decoder->loadSampleTables(_parent))
+		return nullptr;
+
 	for (uint32 i = 0; i < _parent->chunkCount; i++) {
 		if (sampleToChunkIndex < _parent->sampleToChunkCount && i >= _parent->sampleToChunk[sampleToChunkIndex].first)
 			sampleToChunkIndex++;
@@ -730,6 +752,8 @@ uint32 QuickTimeDecoder::VideoTrackHandler::getCurFrameDuration() {
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::findKeyFrame(uint32 frame) const {
+	_decoder->loadSampleTables(_parent);
+
 	for (int i = _parent->keyframeCount - 1; i >= 0; i--)
 		if (_parent->keyframes[i] <= frame)
 			return _parent->keyframes[i];
@@ -837,6 +861,15 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 	const Graphics::Surface *frame = entry->_videoCodec->decodeFrame(*frameData);
 	delete frameData;
 
+	// The codec only knows what changed since the frame it decoded before
+	if (_curFrame == 0 || _curFrame != _lastDecodedFrame + 1 || descId != _lastDescId)
+		addDirtyRects(_dirtyRects, nullptr);
+	else
+		addDirtyRects(_dirtyRects, entry->_videoCodec->getDirtyRects());
+
+	_lastDecodedFrame = _curFrame;
+	_lastDescId = descId;
+
 	// Update the palette
 	if (entry->_videoCodec->containsPalette()) {
 		// The codec itself contains a palette
@@ -857,6 +890,14 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 	return frame;
 }
 
+const Common::List<Common::Rect> *QuickTimeDecoder::VideoTrackHandler::getDirtyRects() const {
+	// The rects would need scaling as well
+	if (_parent->scaleFactorX != 1 || _parent->scaleFactorY != 1 || _decoder->_scaleFactorX != 1 || _decoder->_scaleFactorY != 1)
+		return nullptr;
+
+	return &_dirtyRects;
+}
+
 uint32 QuickTimeDecoder::VideoTrackHandler::getRateAdjustedFrameTime() const {
 	// Figure out what time the next frame is at taking the edit list rate into account,
 	// unless this is an empty edit, in which case the rate isn't applicable.
@@ -144,6 +144,8 @@ private:
 		Audio::Timestamp getFrameTime(uint frame) const;
 		const byte *getPalette() const;
 		bool hasDirtyPalette() const { return _curPalette; }
+		const Common::List<Common::Rect> *getDirtyRects() const;
+		void clearDirtyRects() { _dirtyRects.clear(); }
 		bool setReverse(bool reverse);
 		bool isReversed() const { return _reversed; }
 		bool canDither() const;
@@ -165,6 +167,11 @@ private:
 		mutable bool _dirtyPalette;
 		bool _reversed;
 
+		// Changed areas of the frame, as reported by the codecs
+		Common::List<Common::Rect> _dirtyRects;
+		int32 _lastDecodedFrame;
+		uint32 _lastDescId;
+
 		// Forced dithering of frames
 		byte *_forcedDitherPalette;
 		byte *_ditherTable;
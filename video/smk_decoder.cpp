@@ -33,6 +33,8 @@
 #include "common/system.h"
 #include "common/textconsole.h"
 
+#include "graphics/blit.h"
+
 #include "audio/audiostream.h"
 #include "audio/mixer.h"
 #include "audio/decoders/raw.h"
@@ -600,12 +602,20 @@ SmackerDecoder::SmackerVideoTrack::SmackerVideoTrack(uint32 width, uint32 height
 	_dirtyPalette = false;
 	_MMapTree = _MClrTree = _FullTree = _TypeTree = 0;
 	memset(_palette, 0, 3 * 256);
+	_outputSurface = nullptr;
+	_outputRedraw = false;
+	_lastDecodedFrame = -1;
 }
 
 SmackerDecoder::SmackerVideoTrack::~SmackerVideoTrack() {
 	_surface->free();
 	delete _surface;
 
+	if (_outputSurface) {
+		_outputSurface->free();
+		delete _outputSurface;
+	}
+
 	delete _MMapTree;
 	delete _MClrTree;
 	delete _FullTree;
@@ -621,9 +631,29 @@ uint16 SmackerDecoder::SmackerVideoTrack::getHeight() const {
 }
 
 Graphics::PixelFormat SmackerDecoder::SmackerVideoTrack::getPixelFormat() const {
+	if (_outputSurface)
+		return _outputSurface->format;
+
 	return _surface->format;
 }
 
+bool SmackerDecoder::SmackerVideoTrack::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	if (_outputSurface) {
+		_outputSurface->free();
+		delete _outputSurface;
+		_outputSurface = nullptr;
+	}
+
+	// CLUT8 is what we decode to anyway
+	if (format.bytesPerPixel == 1)
+		return true;
+
+	_outputSurface = new Graphics::Surface();
+	_outputSurface->create(_surface->w, _surface->h, format);
+	_outputRedraw = true;
+	return true;
+}
+
 void SmackerDecoder::SmackerVideoTrack::readTrees(SmackerBitStream &bs, uint32 mMapSize, uint32 mClrSize, uint32 fullSize, uint32 typeSize) {
 	_MMapTree = new BigHuffmanTree(bs, mMapSize);
 	_MClrTree = new BigHuffmanTree(bs, mClrSize);
@@ -778,6 +808,92 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(SmackerBitStream &bs) {
 			break;
 		}
 	}
+
+	updateDirtyRects();
+	convertFrame();
+}
+
+void SmackerDecoder::SmackerVideoTrack::updateDirtyRects() {
+	// The first frame, or one after skipped frames, has nothing shown to be relative to
+	bool skipped = _curFrame == 0 || _curFrame != _lastDecodedFrame + 1;
+	_lastDecodedFrame = _curFrame;
+
+	if (skipped) {
+		addDirtyRects(_dirtyRects, nullptr);
+		return;
+	}
+
+	uint doubleY = (_flags & 6) ? 2 : 1;
+
+	uint bw = getWidth() / 4;
+	uint bh = getHeight() / doubleY / 4;
+
+	// One rect for each run of dirty blocks on a row of blocks, merged
+	// with the one from the row above when they line up
+	Common::List<Common::Rect> rects;
+
+	for (uint y = 0; y < bh; y++) {
+		uint x = 0;
+
+		while (x < bw) {
+			if (!_dirtyBlocks.get(x + y * bw)) {
+				x++;
+				continue;
+			}
+
+			uint x0 = x;
+			while (x < bw && _dirtyBlocks.get(x + y * bw))
+				x++;
+
+			Common::Rect rect(x0 * 4, y * 4 * doubleY, x * 4, (y + 1) * 4 * doubleY);
+
+			if (!rects.empty() && rects.back().left == rect.left && rects.back().right == rect.right && rects.back().bottom == rect.top)
+				rects.back().bottom = rect.bottom;
+			else
+				rects.push_back(rect);
+		}
+	}
+
+	addDirtyRects(_dirtyRects, &rects);
+}
+
+void SmackerDecoder::SmackerVideoTrack::convertFrame() {
+	if (!_outputSurface)
+		return;
+
+	const uint bpp = _outputSurface->format.bytesPerPixel;
+
+	if (_outputRedraw) {
+		Graphics::convertPaletteToMap(_outputMap, _palette, 256, _outputSurface->format);
+		Graphics::crossBlitMap((byte *)_outputSurface->getPixels(), (const byte *)_surface->getPixels(),
+				_outputSurface->pitch, _surface->pitch, _surface->w, _surface->h, bpp, _outputMap);
+		_outputRedraw = false;
+		return;
+	}
+
+	uint doubleY = (_flags & 6) ? 2 : 1;
+
+	uint bw = getWidth() / 4;
+	uint bh = getHeight() / doubleY / 4;
+
+	// Convert each run of dirty blocks on a row of blocks in one go
+	for (uint y = 0; y < bh; y++) {
+		uint x = 0;
+
+		while (x < bw) {
+			if (!_dirtyBlocks.get(x + y * bw)) {
+				x++;
+				continue;
+			}
+
+			uint x0 = x;
+			while (x < bw && _dirtyBlocks.get(x + y * bw))
+				x++;
+
+			Graphics::crossBlitMap((byte *)_outputSurface->getBasePtr(x0 * 4, y * 4 * doubleY), (const byte *)_surface->getBasePtr(x0 * 4, y * 4 * doubleY),
+					_outputSurface->pitch, _surface->pitch, (x - x0) * 4, 4 * doubleY, bpp, _outputMap);
+		}
+	}
 }
 
 void SmackerDecoder::SmackerVideoTrack::unpackPalette(Common::SeekableReadStream *stream) {
@@ -830,6 +946,7 @@ void SmackerDecoder::SmackerVideoTrack::unpackPalette(Common::SeekableReadStream
 	free(chunk);
 
 	_dirtyPalette = true;
+	_outputRedraw = true;
 }
 
 SmackerDecoder::SmackerAudioTrack::SmackerAudioTrack(const AudioInfo &audioInfo, Audio::Mixer::SoundType soundType) :
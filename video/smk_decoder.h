@@ -99,11 +99,12 @@ protected:
 		uint16 getWidth() const;
 		uint16 getHeight() const;
 		Graphics::PixelFormat getPixelFormat() const;
+		bool setOutputPixelFormat(const Graphics::PixelFormat &format);
 		int getCurFrame() const { return _curFrame; }
 		int getFrameCount() const { return _frameCount; }
-		const Graphics::Surface *decodeNextFrame() { return _surface; }
+		const Graphics::Surface *decodeNextFrame() { return _outputSurface ? _outputSurface : _surface; }
 		const byte *getPalette() const { _dirtyPalette = false; return _palette; }
-		bool hasDirtyPalette() const { return _dirtyPalette; }
+		bool hasDirtyPalette() const { return _dirtyPalette && !_outputSurface; }
 
 		void readTrees(SmackerBitStream &bs, uint32 mMapSize, uint32 mClrSize, uint32 fullSize, uint32 typeSize);
 		void increaseCurFrame() { _curFrame++; }
@@ -113,6 +114,8 @@ protected:
 		Common::Rational getFrameRate() const { return _frameRate; }
 
 		const Common::Rect *getNextDirtyRect();
+		const Common::List<Common::Rect> *getDirtyRects() const { return &_dirtyRects; }
+		void clearDirtyRects() { _dirtyRects.clear(); }
 
 	protected:
 		Graphics::Surface *_surface;
@@ -134,6 +137,18 @@ protected:
 
 		Common::BitArray _dirtyBlocks;
 		Common::Rect _lastDirtyRect;
+		Common::List<Common::Rect> _dirtyRects;
+		int _lastDecodedFrame;
+
+		void updateDirtyRects();
+
+		// The frame in the output pixel format, if one was set. Only the
+		// dirty blocks are converted, unless the palette changed.
+		Graphics::Surface *_outputSurface;
+		uint32 _outputMap[256];
+		bool _outputRedraw;
+
+		void convertFrame();
 
 		// Possible runs of blocks
 		static uint getBlockRun(int index) { return (index <= 58) ? index + 1 : 128 << (index - 59); }
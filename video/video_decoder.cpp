@@ -26,12 +26,81 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/jobsystem.h"
+#include "common/mutex.h"
 #include "common/system.h"
 
 #include "graphics/palette.h"
+#include "graphics/surface.h"
+
+#include <atomic>
 
 namespace Video {
 
+struct VideoDecoder::DecodedFrame {
+	Graphics::Surface surface;
+	bool hasSurface;
+	bool dirtyPalette;
+	byte palette[256 * 3];
+
+	// State of the track after decoding the frame
+	int curFrame;
+	bool endOfTrack;
+	uint32 nextFrameStartTime;
+};
+
+struct VideoDecoder::DecodeAheadState {
+	DecodeAheadState() : frames(0), size(0), readPos(0), writePos(0), returned(false), trackEnded(false),
+		curFrame(-1), endOfTrack(false), nextFrameStartTime(0), pending(false) {}
+
+	~DecodeAheadState() {
+		for (uint32 i = 0; i < size; i++)
+			frames[i].surface.free();
+
+		delete[] frames;
+	}
+
+	DecodedFrame *frames;
+	uint32 size;
+	std::atomic<uint32> readPos, writePos;
+	bool returned;
+
+	/** Whether the track had ended after the last frame decoded ahead. */
+	bool trackEnded;
+
+	// State of the track as of the frame last returned
+	int curFrame;
+	bool endOfTrack;
+	uint32 nextFrameStartTime;
+	byte palette[256 * 3];
+
+	Common::JobGroup group;
+	bool pending;
+
+	/**
+	 * Held by the worker while it decodes a frame, which may update any
+	 * track, and by the queries looking at the other tracks.
+	 */
+	Common::Mutex mutex;
+};
+
+/** Locks the mutex of the decode-ahead state while frames are decoded ahead. */
+class VideoDecoder::DecodeAheadLock {
+public:
+	DecodeAheadLock(const VideoDecoder *decoder) : _mutex(decoder->_aheadTrack ? &decoder->_ahead->mutex : nullptr) {
+		if (_mutex)
+			_mutex->lock();
+	}
+
+	~DecodeAheadLock() {
+		if (_mutex)
+			_mutex->unlock();
+	}
+
+private:
+	Common::Mutex *_mutex;
+};
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -49,9 +118,19 @@ VideoDecoder::VideoDecoder() {
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
+	_decodeAhead = 0;
+	_aheadTrack = 0;
+	_ahead = 0;
+}
+
+VideoDecoder::~VideoDecoder() {
+	stopDecodeAhead();
+	delete _ahead;
 }
 
 void VideoDecoder::close() {
+	stopDecodeAhead();
+
 	if (isPlaying())
 		stop();
 
@@ -115,6 +194,8 @@ bool VideoDecoder::needsUpdate() const {
 }
 
 void VideoDecoder::pauseVideo(bool pause) {
+	waitForDecodeAhead();
+
 	if (pause) {
 		_pauseLevel++;
 
@@ -206,6 +287,9 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
 
+	if (_aheadTrack || _decodeAhead)
+		return decodeNextFrameAhead();
+
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -231,6 +315,17 @@ bool VideoDecoder::setReverse(bool reverse) {
 	if (reverse && hasAudio())
 		return false;
 
+	// The track is past the frames decoded ahead, so it can't be turned
+	// around until they have been returned
+	if (_aheadTrack) {
+		waitForDecodeAhead();
+
+		if (getDecodedAheadCount() > (_ahead->returned ? 1 : 0))
+			return !reverse;
+
+		stopDecodeAhead();
+	}
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
@@ -250,12 +345,41 @@ const byte *VideoDecoder::getPalette() {
 	return _palette;
 }
 
+const Common::List<Common::Rect> *VideoDecoder::getDirtyRects() const {
+	// The track is already busy with the frames after this one
+	if (_aheadTrack)
+		return nullptr;
+
+	const VideoTrack *videoTrack = nullptr;
+
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo) {
+			// Several tracks make up the frame
+			if (videoTrack)
+				return nullptr;
+
+			videoTrack = (const VideoTrack *)*it;
+		}
+	}
+
+	return videoTrack ? videoTrack->getDirtyRects() : nullptr;
+}
+
+void VideoDecoder::clearDirtyRects() {
+	if (_aheadTrack)
+		return;
+
+	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++)
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
+			((VideoTrack *)*it)->clearDirtyRects();
+}
+
 int VideoDecoder::getCurFrame() const {
 	int32 frame = -1;
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)*it)->getCurFrame() + 1;
+			frame += getTrackCurFrame((const VideoTrack *)*it) + 1;
 
 	return frame;
 }
@@ -278,6 +402,9 @@ uint32 VideoDecoder::getTime() const {
 		return MAX<int>((_playbackRate * (_pauseStartTime - _startTime)).toInt(), 0);
 
 	if (useAudioSync()) {
+		// The worker decoding ahead may be feeding the audio tracks
+		DecodeAheadLock lock(this);
+
 		for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 			if ((*it)->getTrackType() == Track::kTrackTypeAudio && !(*it)->endOfTrack()) {
 				uint32 time = (((const AudioTrack *)*it)->getRunningTime() * _playbackRate).toInt();
@@ -292,13 +419,17 @@ uint32 VideoDecoder::getTime() const {
 }
 
 uint32 VideoDecoder::getTimeToNextFrame() const {
-	if (endOfVideo() || _needsUpdate || !_nextVideoTrack)
+	const VideoTrack *nextVideoTrack = _nextVideoTrack;
+	if (_aheadTrack)
+		nextVideoTrack = _ahead->endOfTrack ? 0 : _aheadTrack;
+
+	if (endOfVideo() || _needsUpdate || !nextVideoTrack)
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = getTrackNextFrameStartTime(nextVideoTrack);
 
-	if (_nextVideoTrack->isReversed()) {
+	if (nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
 		if (nextFrameStartTime >= currentTime)
 			return 0;
@@ -314,11 +445,14 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 }
 
 bool VideoDecoder::endOfVideo() const {
+	// The worker decoding ahead may be updating the other tracks
+	DecodeAheadLock lock(this);
+
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		const Track *track = *it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && getTrackNextFrameStartTime((const VideoTrack *)track) >= (uint)_endTime.msecs();
+		bool endReached = trackEnded(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return false;
 	}
@@ -341,6 +475,8 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	stopDecodeAhead();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -375,6 +511,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	stopDecodeAhead();
+
 	// Stop all tracks so they can be seeked
 	if (isPlaying())
 		stopAudio();
@@ -441,6 +579,8 @@ void VideoDecoder::stop() {
 	if (!isPlaying())
 		return;
 
+	waitForDecodeAhead();
+
 	// Stop audio here so we don't have it affect getTime()
 	stopAudio();
 
@@ -473,6 +613,8 @@ void VideoDecoder::setRate(const Common::Rational &rate) {
 		return;
 	}
 
+	waitForDecodeAhead();
+
 	Common::Rational targetRate = rate;
 
 	if (hasAudio()) {
@@ -592,6 +734,31 @@ Audio::Timestamp VideoDecoder::VideoTrack::getFrameTime(uint frame) const {
 	return Audio::Timestamp().addFrames(-1);
 }
 
+void VideoDecoder::VideoTrack::addDirtyRects(Common::List<Common::Rect> &dirtyRects, const Common::List<Common::Rect> *rects) const {
+	// Past this, copying the whole frame is likely cheaper anyway
+	static const uint kMaxDirtyRects = 64;
+
+	const Common::Rect frameRect(getWidth(), getHeight());
+
+	// Everything is dirty already
+	if (!dirtyRects.empty() && dirtyRects.front() == frameRect)
+		return;
+
+	if (!rects || dirtyRects.size() + rects->size() > kMaxDirtyRects) {
+		dirtyRects.clear();
+		dirtyRects.push_back(frameRect);
+		return;
+	}
+
+	for (Common::List<Common::Rect>::const_iterator it = rects->begin(); it != rects->end(); ++it) {
+		Common::Rect rect = *it;
+		rect.clip(frameRect);
+
+		if (!rect.isEmpty())
+			dirtyRects.push_back(rect);
+	}
+}
+
 uint32 VideoDecoder::FixedRateVideoTrack::getNextFrameStartTime() const {
 	if (endOfTrack() || getCurFrame() < 0)
 		return 0;
@@ -785,6 +952,8 @@ bool VideoDecoder::StreamFileAudioTrack::loadFromFile(const Common::Path &baseNa
 }
 
 void VideoDecoder::addTrack(Track *track, bool isExternal) {
+	waitForDecodeAhead();
+
 	_tracks.push_back(track);
 
 	if (isExternal)
@@ -878,6 +1047,8 @@ uint VideoDecoder::getAudioTrackCount() const {
 }
 
 void VideoDecoder::setEndTime(const Audio::Timestamp &endTime) {
+	waitForDecodeAhead();
+
 	Audio::Timestamp startTime = 0;
 
 	if (isPlaying()) {
@@ -1008,8 +1179,8 @@ bool VideoDecoder::hasFramesLeft() const {
 
 		const VideoTrack *track = (const VideoTrack *)*it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && getTrackNextFrameStartTime(track) >= (uint)_endTime.msecs();
+		bool endReached = trackEnded(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return true;
 	}
@@ -1026,6 +1197,8 @@ bool VideoDecoder::hasAudio() const {
 }
 
 void VideoDecoder::eraseTrack(Track *track) {
+	waitForDecodeAhead();
+
 	for (uint idx = 0; idx < _externalTracks.size(); ++idx) {
 		if (_externalTracks[idx] == track)
 			_externalTracks.remove_at(idx);
@@ -1042,4 +1215,199 @@ void VideoDecoder::eraseTrack(Track *track) {
 	}
 }
 
+void VideoDecoder::decodeAheadProc(void *refCon) {
+	VideoDecoder *decoder = (VideoDecoder *)refCon;
+	decoder->decodeAhead(decoder->_ahead->size);
+}
+
+void VideoDecoder::decodeAhead(uint32 maxFrames) {
+	for (; maxFrames > 0 && !_ahead->trackEnded; maxFrames--) {
+		// Acquire the release of the frames returned by decodeNextFrame()
+		const uint32 writePos = _ahead->writePos.load(std::memory_order_relaxed);
+		if (writePos - _ahead->readPos.load(std::memory_order_acquire) >= _ahead->size)
+			break;
+
+		DecodedFrame &decoded = _ahead->frames[writePos % _ahead->size];
+
+		{
+			Common::StackLock lock(_ahead->mutex);
+
+			readNextPacket();
+			const Graphics::Surface *frame = _aheadTrack->decodeNextFrame();
+
+			decoded.hasSurface = frame != 0;
+			if (frame) {
+				if (decoded.surface.w != frame->w || decoded.surface.h != frame->h || decoded.surface.format != frame->format) {
+					decoded.surface.free();
+					decoded.surface.create(frame->w, frame->h, frame->format);
+				}
+
+				decoded.surface.copyRectToSurface(frame->getPixels(), frame->pitch, 0, 0, frame->w, frame->h);
+			}
+
+			decoded.dirtyPalette = _aheadTrack->hasDirtyPalette();
+			if (decoded.dirtyPalette)
+				memcpy(decoded.palette, _aheadTrack->getPalette(), sizeof(decoded.palette));
+
+			decoded.curFrame = _aheadTrack->getCurFrame();
+			decoded.endOfTrack = _aheadTrack->endOfTrack();
+			decoded.nextFrameStartTime = _aheadTrack->getNextFrameStartTime();
+		}
+
+		_ahead->trackEnded = decoded.endOfTrack;
+		_ahead->writePos.store(writePos + 1, std::memory_order_release);
+	}
+}
+
+void VideoDecoder::requestDecodeAhead() {
+	if (_ahead->pending) {
+		if (!g_system->getJobSystem()->isDone(_ahead->group))
+			return;
+		_ahead->pending = false;
+	}
+
+	// Let the queue run empty when the number of frames has changed
+	if (_ahead->trackEnded || _ahead->size != _decodeAhead + 1 || getDecodedAheadCount() >= _ahead->size)
+		return;
+
+	_ahead->pending = true;
+	g_system->getJobSystem()->submit(_ahead->group, decodeAheadProc, this);
+}
+
+void VideoDecoder::waitForDecodeAhead() {
+	if (_ahead && _ahead->pending) {
+		g_system->getJobSystem()->wait(_ahead->group);
+		_ahead->pending = false;
+	}
+}
+
+void VideoDecoder::stopDecodeAhead() {
+	waitForDecodeAhead();
+
+	if (!_aheadTrack)
+		return;
+
+	_aheadTrack = 0;
+	_ahead->readPos = 0;
+	_ahead->writePos = 0;
+	_ahead->returned = false;
+
+	// The worker doesn't keep this up to date
+	findNextVideoTrack();
+}
+
+uint32 VideoDecoder::getDecodedAheadCount() const {
+	return _ahead->writePos.load(std::memory_order_acquire) - _ahead->readPos.load(std::memory_order_relaxed);
+}
+
+const Graphics::Surface *VideoDecoder::decodeNextFrameAhead() {
+	// The frame returned last time may be reused from now on
+	if (_aheadTrack && _ahead->returned) {
+		_ahead->readPos.store(_ahead->readPos.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		_ahead->returned = false;
+	}
+
+	if (_aheadTrack && getDecodedAheadCount() == 0) {
+		waitForDecodeAhead();
+
+		// Once the queue has run empty, the track is back in sync with
+		// what was returned, and decoding ahead may be reconfigured
+		if (getDecodedAheadCount() == 0 && (_ahead->trackEnded || _ahead->size != _decodeAhead + 1))
+			stopDecodeAhead();
+	}
+
+	if (!_aheadTrack) {
+		VideoTrack *videoTrack = 0;
+		uint videoTrackCount = 0;
+
+		for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+			if ((*it)->getTrackType() == Track::kTrackTypeVideo) {
+				videoTrack = (VideoTrack *)*it;
+				videoTrackCount++;
+			}
+		}
+
+		Common::JobSystem *jobSystem = g_system->getJobSystem();
+
+		if (!_decodeAhead || videoTrackCount != 1 || videoTrack->isReversed() || videoTrack->endOfTrack() ||
+				!jobSystem || jobSystem->getWorkerCount() == 0) {
+			// Decode synchronously, like decodeNextFrame() does
+			readNextPacket();
+
+			if (!_nextVideoTrack)
+				return 0;
+
+			const Graphics::Surface *frame = _nextVideoTrack->decodeNextFrame();
+
+			if (_nextVideoTrack->hasDirtyPalette()) {
+				_palette = _nextVideoTrack->getPalette();
+				_dirtyPalette = true;
+			}
+
+			findNextVideoTrack();
+			return frame;
+		}
+
+		if (!_ahead)
+			_ahead = new DecodeAheadState();
+
+		if (_ahead->size != _decodeAhead + 1) {
+			for (uint32 i = 0; i < _ahead->size; i++)
+				_ahead->frames[i].surface.free();
+
+			delete[] _ahead->frames;
+			_ahead->size = _decodeAhead + 1;
+			_ahead->frames = new DecodedFrame[_ahead->size];
+		}
+
+		_aheadTrack = videoTrack;
+		_ahead->trackEnded = false;
+		_ahead->curFrame = videoTrack->getCurFrame();
+		_ahead->endOfTrack = false;
+		_ahead->nextFrameStartTime = videoTrack->getNextFrameStartTime();
+	}
+
+	// The worker has fallen behind, so decode the next frame ourselves
+	if (getDecodedAheadCount() == 0)
+		decodeAhead(1);
+
+	const DecodedFrame &decoded = _ahead->frames[_ahead->readPos.load(std::memory_order_relaxed) % _ahead->size];
+	_ahead->returned = true;
+
+	_ahead->curFrame = decoded.curFrame;
+	_ahead->endOfTrack = decoded.endOfTrack;
+	_ahead->nextFrameStartTime = decoded.nextFrameStartTime;
+
+	if (decoded.dirtyPalette) {
+		memcpy(_ahead->palette, decoded.palette, sizeof(_ahead->palette));
+		_palette = _ahead->palette;
+		_dirtyPalette = true;
+	}
+
+	requestDecodeAhead();
+
+	return decoded.hasSurface ? &decoded.surface : 0;
+}
+
+bool VideoDecoder::trackEnded(const Track *track) const {
+	if (_aheadTrack && track == _aheadTrack)
+		return _ahead->endOfTrack;
+
+	return track->endOfTrack();
+}
+
+int VideoDecoder::getTrackCurFrame(const VideoTrack *track) const {
+	if (_aheadTrack && track == _aheadTrack)
+		return _ahead->curFrame;
+
+	return track->getCurFrame();
+}
+
+uint32 VideoDecoder::getTrackNextFrameStartTime(const VideoTrack *track) const {
+	if (_aheadTrack && track == _aheadTrack)
+		return _ahead->nextFrameStartTime;
+
+	return track->getNextFrameStartTime();
+}
+
 } // End of namespace Video
@@ -25,8 +25,10 @@
 #include "audio/mixer.h"
 #include "audio/timestamp.h"	// TODO: Move this to common/ ?
 #include "common/array.h"
+#include "common/list.h"
 #include "common/path.h"
 #include "common/rational.h"
+#include "common/rect.h"
 #include "common/str.h"
 #include "graphics/pixelformat.h"
 
@@ -52,7 +54,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -324,6 +326,23 @@ public:
 	 */
 	bool hasDirtyPalette() const { return _dirtyPalette; }
 
+	/**
+	 * Get the areas of the frame which changed since clearDirtyRects() was
+	 * last called.
+	 *
+	 * This allows only copying the changed parts of each frame to the
+	 * screen. If nullptr is returned, the video does not keep track of
+	 * them (or has more than one video track) and the whole frame has to
+	 * be considered changed.
+	 */
+	const Common::List<Common::Rect> *getDirtyRects() const;
+
+	/**
+	 * Forget the areas returned by getDirtyRects(), usually after copying
+	 * them to the screen.
+	 */
+	void clearDirtyRects();
+
 	/**
 	 * Return the time (in ms) until the next frame should be displayed.
 	 */
@@ -387,6 +406,10 @@ public:
 	/**
 	 * Set the default high color format for videos that convert from YUV.
 	 *
+	 * Palette based videos which support it convert their frames to this
+	 * format as well, in which case they no longer report a dirty palette.
+	 * Passing a CLUT8 format keeps them at 8bpp.
+	 *
 	 * This should be called after loadStream(), but before a decodeNextFrame()
 	 * call. This is enforced.
 	 *
@@ -395,6 +418,36 @@ public:
 	 */
 	bool setOutputPixelFormat(const Graphics::PixelFormat &format);
 
+	/**
+	 * Decode frames ahead of time on the job system's worker threads.
+	 *
+	 * decodeNextFrame() then hands out frames which were already decoded
+	 * and only waits for the worker (or decodes by itself) when the worker
+	 * has fallen behind. Each frame is copied out of the track, so that the
+	 * track can carry on with the next ones.
+	 *
+	 * Decoding ahead is only used for videos with a single video track
+	 * played forward, and only on ports with worker threads; otherwise
+	 * frames are decoded synchronously as usual. Seeking and rewinding drop
+	 * the frames decoded ahead, and setReverse() fails while there are any.
+	 * A new number of frames takes effect once the frames already decoded
+	 * ahead have been returned.
+	 *
+	 * readNextPacket() and the video track's decodeNextFrame() run on a
+	 * worker thread in this mode. endOfVideo() and getTime(), which look at
+	 * the other tracks, are serialized with them. Anything else they use
+	 * must not be modified by the thread playing the video.
+	 *
+	 * @param frames The maximum number of frames to decode ahead, 0 to disable
+	 */
+	void setDecodeAhead(uint frames) { _decodeAhead = frames; }
+
+	/**
+	 * Get the number of frames decoded ahead of time.
+	 * @see setDecodeAhead()
+	 */
+	uint getDecodeAhead() const { return _decodeAhead; }
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -622,6 +675,22 @@ protected:
 		 */
 		virtual bool hasDirtyPalette() const { return false; }
 
+		/**
+		 * Get the areas of the frame changed since clearDirtyRects() was
+		 * last called.
+		 *
+		 * By default, this returns nullptr, which means the track does not
+		 * keep track of them and the whole frame has to be redrawn.
+		 *
+		 * @see VideoDecoder::getDirtyRects()
+		 */
+		virtual const Common::List<Common::Rect> *getDirtyRects() const { return nullptr; }
+
+		/**
+		 * Forget the areas returned by getDirtyRects().
+		 */
+		virtual void clearDirtyRects() {}
+
 		/**
 		 * Get the time the given frame should be shown.
 		 *
@@ -654,6 +723,14 @@ protected:
 		 * Activate dithering mode with a palette
 		 */
 		virtual void setDither(const byte *palette) {}
+
+	protected:
+		/**
+		 * Add the areas changed by a newly decoded frame to a list of
+		 * dirty rects. Passing nullptr as rects marks the whole frame as
+		 * changed, which is also done once the list grows too long.
+		 */
+		void addDirtyRects(Common::List<Common::Rect> &dirtyRects, const Common::List<Common::Rect> *rects) const;
 	};
 
 	/**
@@ -979,6 +1056,44 @@ private:
 	bool _canSetDither;
 	bool _canSetDefaultFormat;
 
+	// Decoding ahead, see setDecodeAhead()
+	struct DecodedFrame;
+	struct DecodeAheadState;
+	class DecodeAheadLock;
+
+	static void decodeAheadProc(void *refCon);
+
+	/** Decode up to @p maxFrames frames into the free part of the queue. */
+	void decodeAhead(uint32 maxFrames);
+
+	/** Start decoding ahead in the background, unless it already runs. */
+	void requestDecodeAhead();
+
+	/** Wait for the background decoding to finish, if there is one. */
+	void waitForDecodeAhead();
+
+	/** Drop the frames decoded ahead and go back to decoding synchronously. */
+	void stopDecodeAhead();
+
+	/** decodeNextFrame() for when frames are decoded ahead. */
+	const Graphics::Surface *decodeNextFrameAhead();
+
+	/** Number of decoded frames in the queue, including the one last returned. */
+	uint32 getDecodedAheadCount() const;
+
+	/**
+	 * Query the state of a track as of the frame last returned by
+	 * decodeNextFrame(), which isn't the state of the track itself
+	 * while decoding ahead.
+	 */
+	bool trackEnded(const Track *track) const;
+	int getTrackCurFrame(const VideoTrack *track) const;
+	uint32 getTrackNextFrameStartTime(const VideoTrack *track) const;
+
+	uint _decodeAhead;
+	VideoTrack *_aheadTrack; ///< The track decoded ahead, or 0 when decoding synchronously
+	DecodeAheadState *_ahead; ///< Created the first time frames are decoded ahead
+
 protected:
 	// Internal helper functions
 	void stopAudio();